@@ -9,6 +9,7 @@
 #include <kernel.h>
 #include <soc.h>
 #include <kernel_structs.h>
+#include <string.h>
 
 #include "arm_core_mpu_dev.h"
 #include <linker/linker-defs.h>
@@ -46,6 +47,62 @@ LOG_MODULE_REGISTER(mpu);
 #define _MPU_DYNAMIC_REGIONS_AREA_SIZE ((u32_t)&__kernel_ram_end - \
 		_MPU_DYNAMIC_REGIONS_AREA_START)
 
+/* Copy of the dynamic MPU regions last handed to the MPU driver, so that
+ * switching between threads with the very same memory map (e.g. threads
+ * of one memory domain without stack regions of their own) leaves the
+ * MPU alone. DYN_REGIONS_INVALID forces the next configuration through.
+ */
+#define DYN_REGIONS_INVALID 0xFFU
+
+static struct k_mem_partition dyn_regions_cache[_MAX_DYNAMIC_MPU_REGIONS_NUM];
+static u8_t dyn_regions_cache_num = DYN_REGIONS_INVALID;
+
+#if defined(CONFIG_MPU_DYNAMIC_REGIONS_STATS)
+static struct z_arm_mpu_stats mpu_stats;
+
+void z_arm_mpu_stats_get(struct z_arm_mpu_stats *stats)
+{
+	*stats = mpu_stats;
+}
+#endif /* CONFIG_MPU_DYNAMIC_REGIONS_STATS */
+
+static inline void dyn_regions_cache_invalidate(void)
+{
+	dyn_regions_cache_num = DYN_REGIONS_INVALID;
+}
+
+/* Update the cache with the given regions, returns false if they were
+ * already the ones programmed
+ */
+static bool dyn_regions_cache_update(struct k_mem_partition *regions[],
+				     u8_t regions_num)
+{
+	bool changed = regions_num != dyn_regions_cache_num;
+
+	for (int i = 0; i < regions_num; i++) {
+		struct k_mem_partition *cached = &dyn_regions_cache[i];
+
+		if (!changed && (cached->start != regions[i]->start ||
+				 cached->size != regions[i]->size ||
+				 memcmp(&cached->attr, &regions[i]->attr,
+					sizeof(cached->attr)) != 0)) {
+			changed = true;
+		}
+		*cached = *regions[i];
+	}
+	dyn_regions_cache_num = regions_num;
+
+#if defined(CONFIG_MPU_DYNAMIC_REGIONS_STATS)
+	if (changed) {
+		mpu_stats.programmed++;
+	} else {
+		mpu_stats.skipped++;
+	}
+#endif /* CONFIG_MPU_DYNAMIC_REGIONS_STATS */
+
+	return changed;
+}
+
 /**
  * @brief Use the HW-specific MPU driver to program
  *        the static MPU regions.
@@ -252,6 +309,10 @@ void z_arch_configure_dynamic_mpu_regions(struct k_thread *thread)
 	region_num++;
 #endif /* CONFIG_MPU_STACK_GUARD */
 
+	if (!dyn_regions_cache_update(dynamic_regions, region_num)) {
+		return;
+	}
+
 	/* Configure the dynamic MPU regions */
 	arm_core_mpu_configure_dynamic_mpu_regions(
 		(const struct k_mem_partition **)dynamic_regions,
@@ -319,6 +380,8 @@ void z_arch_mem_domain_destroy(struct k_mem_domain *domain)
 	 */
 	k_mem_partition_attr_t reset_attr = K_MEM_PARTITION_P_RW_U_NA;
 
+	dyn_regions_cache_invalidate();
+
 	for (i = 0; i < CONFIG_MAX_DOMAIN_PARTITIONS; i++) {
 		partition = domain->partitions[i];
 		if (partition.size == 0U) {
@@ -352,6 +415,7 @@ void z_arch_mem_domain_partition_remove(struct k_mem_domain *domain,
 		return;
 	}
 
+	dyn_regions_cache_invalidate();
 	arm_core_mpu_mem_partition_config_update(
 		&domain->partitions[partition_id], &reset_attr);
 }
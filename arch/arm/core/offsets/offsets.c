@@ -40,6 +40,11 @@ GEN_OFFSET_SYM(_thread_arch_t, priv_stack_start);
 GEN_OFFSET_SYM(_thread_arch_t, preempt_float);
 #endif
 
+#if defined(CONFIG_FP_SHARING_STATS)
+GEN_OFFSET_SYM(_thread_arch_t, fp_saves);
+GEN_OFFSET_SYM(_thread_arch_t, fp_restores);
+#endif
+
 GEN_OFFSET_SYM(_basic_sf_t, a1);
 GEN_OFFSET_SYM(_basic_sf_t, a2);
 GEN_OFFSET_SYM(_basic_sf_t, a3);
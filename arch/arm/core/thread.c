@@ -346,6 +346,11 @@ u32_t z_check_thread_stack_fail(const u32_t fault_addr, const u32_t psp)
 #endif /* CONFIG_MPU_STACK_GUARD || CONFIG_USERSPACE */
 
 #if defined(CONFIG_FLOAT) && defined(CONFIG_FP_SHARING)
+/* Thread whose callee-saved FP registers are live in s16-s31, see
+ * __pendsv()
+ */
+struct k_thread *z_arm_fp_owner;
+
 int z_arch_float_disable(struct k_thread *thread)
 {
 	if (thread != _current) {
@@ -369,6 +374,11 @@ int z_arch_float_disable(struct k_thread *thread)
 
 	__set_CONTROL(__get_CONTROL() & (~CONTROL_FPCA_Msk));
 
+	/* The registers may have been modified since they were last
+	 * saved, nobody owns them anymore.
+	 */
+	z_arm_fp_owner = NULL;
+
 	/* No need to add an ISB barrier after setting the CONTROL
 	 * register; z_arch_irq_unlock() already adds one.
 	 */
@@ -80,6 +80,12 @@ struct _thread_arch {
 	struct _preempt_float  preempt_float;
 #endif
 
+#if defined(CONFIG_FP_SHARING_STATS)
+	/* Callee-saved FP registers save and reload counts */
+	u32_t fp_saves;
+	u32_t fp_restores;
+#endif
+
 #if defined(CONFIG_USERSPACE) || defined(CONFIG_FP_SHARING)
 	u32_t mode;
 #if defined(CONFIG_USERSPACE)
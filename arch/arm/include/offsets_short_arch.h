@@ -26,6 +26,14 @@
 #define _thread_offset_to_preempt_float \
 	(___thread_t_arch_OFFSET + ___thread_arch_t_preempt_float_OFFSET)
 
+#ifdef CONFIG_FP_SHARING_STATS
+#define _thread_offset_to_fp_saves \
+	(___thread_t_arch_OFFSET + ___thread_arch_t_fp_saves_OFFSET)
+
+#define _thread_offset_to_fp_restores \
+	(___thread_t_arch_OFFSET + ___thread_arch_t_fp_restores_OFFSET)
+#endif
+
 #if defined(CONFIG_USERSPACE) || defined(CONFIG_FP_SHARING)
 #define _thread_offset_to_mode \
 	(___thread_t_arch_OFFSET + ___thread_arch_t_mode_OFFSET)
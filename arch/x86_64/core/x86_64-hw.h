@@ -263,6 +263,12 @@ static inline void set_msr_bit(unsigned int msr, int bit)
 			 :: "r"(mask), "c"(msr) : "eax", "edx");
 }
 
+static inline void set_msr(unsigned int msr, unsigned long long val)
+{
+	__asm__ volatile("wrmsr" :: "c"(msr), "a"((unsigned int)val),
+			 "d"((unsigned int)(val >> 32)));
+}
+
 static inline unsigned int get_msr(unsigned int msr)
 {
 	unsigned int val;
@@ -142,8 +142,15 @@ void z_arch_sched_ipi(void)
 /* Called from xuk layer on actual CPU start */
 void z_cpu_start(int cpu)
 {
+	const unsigned int IA32_GS_BASE = 0xc0000101;
+
 	xuk_set_f_ptr(cpu, &_kernel.cpus[cpu]);
 
+	/* GS is based at the struct _cpu itself instead of the xuk
+	 * pointer slot, see z_arch_curr_thread()
+	 */
+	set_msr(IA32_GS_BASE, (long)&_kernel.cpus[cpu]);
+
 	/* Set up the timer ISR, but ensure the timer is disabled */
 	xuk_set_isr(INT_APIC_LVT_TIMER, 13, x86_apic_timer_isr, 0);
 	_apic.INIT_COUNT = 0U;
@@ -6,6 +6,7 @@
 #ifndef _KERNEL_ARCH_FUNC_H
 #define _KERNEL_ARCH_FUNC_H
 
+#include <stddef.h>
 #include <irq.h>
 #include <xuk-switch.h>
 
@@ -27,6 +28,25 @@ static inline struct _cpu *z_arch_curr_cpu(void)
 	return (struct _cpu *)(long)ret;
 }
 
+/* Reads a field of the struct _cpu of the current CPU, which the GS
+ * segment is based at. The single access can't be split by a migration
+ * to another CPU. The _kernel.cpus operand orders it against the writes
+ * to the field.
+ */
+#define Z_X86_64_CURR_CPU_READ(field) ({				\
+	__typeof__(((struct _cpu *)0)->field) _val;			\
+									\
+	__asm__ volatile("mov %%gs:%c1, %0" : "=r"(_val)		\
+			 : "i"(offsetof(struct _cpu, field)),		\
+			   "m"(_kernel.cpus));				\
+	_val;								\
+})
+
+static inline struct k_thread *z_arch_curr_thread(void)
+{
+	return Z_X86_64_CURR_CPU_READ(current);
+}
+
 static inline unsigned int z_arch_irq_lock(void)
 {
 	unsigned long long key;
@@ -78,7 +98,7 @@ static inline unsigned int z_arch_k_cycle_get_32(void)
 #endif
 }
 
-#define z_is_in_isr() (z_arch_curr_cpu()->nested != 0)
+#define z_is_in_isr() (Z_X86_64_CURR_CPU_READ(nested) != 0)
 
 static inline void z_arch_switch(void *switch_to, void **switched_from)
 {
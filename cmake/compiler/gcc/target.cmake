@@ -134,6 +134,7 @@ include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_freestanding.cmake)
 include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_security_fortify.cmake)
 include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_security_canaries.cmake)
 include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_optimizations.cmake)
+include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_lto.cmake)
 include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_cpp.cmake)
 include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_asm.cmake)
 include(${ZEPHYR_BASE}/cmake/compiler/${COMPILER}/target_baremetal.cmake)
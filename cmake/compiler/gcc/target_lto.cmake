@@ -0,0 +1,16 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# See root CMakeLists.txt for description and expectations of this macro
+#
+# The objects keep their machine code next to the intermediate language
+# used at link time, for the build steps reading them directly such as
+# the generation of offsets.h. This also lets the plain archiver index
+# the symbols of the libraries.
+macro(toolchain_cc_lto)
+
+  zephyr_compile_options(-flto)
+  zephyr_cc_option(-ffat-lto-objects)
+
+  zephyr_ld_options(-flto)
+
+endmacro()
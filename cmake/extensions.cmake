@@ -414,17 +414,30 @@ function(zephyr_library_compile_options item)
   string(MD5 uniqueness ${item})
   set(lib_name options_interface_lib_${uniqueness})
 
-  if (TARGET ${lib_name})
-    # ${item} already added, ignoring duplicate just like CMake does
-    return()
+  # The same options given to several libraries share their dummy
+  # interface library, which each of them must still link with.
+  if (NOT TARGET ${lib_name})
+    add_library(           ${lib_name} INTERFACE)
+    target_compile_options(${lib_name} INTERFACE ${item} ${ARGN})
   endif()
 
-  add_library(           ${lib_name} INTERFACE)
-  target_compile_options(${lib_name} INTERFACE ${item} ${ARGN})
-
   target_link_libraries(${ZEPHYR_CURRENT_LIBRARY} PRIVATE ${lib_name})
 endfunction()
 
+# Mark the current library as a hot path of the system: it is built with
+# CONFIG_HOT_PATH_OPTIMIZATION_FLAG instead of the optimization level of
+# the image when CONFIG_HOT_PATH_OPTIMIZATIONS is enabled.
+function(zephyr_library_hot_path)
+  zephyr_hot_path(${ZEPHYR_CURRENT_LIBRARY})
+endfunction()
+
+# zephyr_library_hot_path() for libraries which are not a zephyr_library,
+# themselves linked with zephyr_interface using the keyword signature of
+# target_link_libraries().
+function(zephyr_hot_path target)
+  target_link_libraries(${target} PRIVATE zephyr_hot_path)
+endfunction()
+
 function(zephyr_library_cc_option)
   foreach(option ${ARGV})
     string(MAKE_C_IDENTIFIER check${option} check)
@@ -903,6 +916,22 @@ function(zephyr_code_relocate file location)
     "${location}:${CMAKE_CURRENT_SOURCE_DIR}/${file}")
 endfunction()
 
+# Helper function for CONFIG_CODE_DATA_RELOCATION
+# Relocates the functions and variables listed in a profile file, one name
+# per line, instead of whole files. Call this function with 2 arguments
+# profile file and then memory location, e.g.
+#   zephyr_code_relocate_profile(hot_functions.txt ITCM_TEXT)
+#   zephyr_code_relocate_profile(hot_data.txt DTCM_DATA_BSS)
+# See scripts/gen_relocate_profile.py to make one from a profiling run.
+function(zephyr_code_relocate_profile file location)
+  set_property(TARGET code_data_relocation_target
+    APPEND PROPERTY RELOCATE_PROFILES
+    "${location}:${CMAKE_CURRENT_SOURCE_DIR}/${file}")
+  set_property(TARGET code_data_relocation_target
+    APPEND PROPERTY RELOCATE_PROFILES_FILES
+    ${CMAKE_CURRENT_SOURCE_DIR}/${file})
+endfunction()
+
 # Usage:
 #   check_dtc_flag("-Wtest" DTC_WARN_TEST)
 #
@@ -18,11 +18,13 @@ macro(toolchain_ld_relocation)
     $<$<BOOL:${CMAKE_VERBOSE_MAKEFILE}>:--verbose>
     -d ${APPLICATION_BINARY_DIR}
     -i '$<TARGET_PROPERTY:code_data_relocation_target,COMPILE_DEFINITIONS>'
+    -p '$<TARGET_PROPERTY:code_data_relocation_target,RELOCATE_PROFILES>'
     -o ${MEM_RELOCATION_LD}
     -s ${MEM_RELOCATION_SRAM_DATA_LD}
     -b ${MEM_RELOCATION_SRAM_BSS_LD}
     -c ${MEM_RELOCATION_CODE}
     DEPENDS app kernel ${ZEPHYR_LIBS_PROPERTY}
+    $<TARGET_PROPERTY:code_data_relocation_target,RELOCATE_PROFILES_FILES>
     )
 
   add_library(code_relocation_source_lib  STATIC ${MEM_RELOCATION_CODE})
@@ -7,6 +7,9 @@
 #define ADC_CONTEXT_USES_KERNEL_TIMER
 #include "adc_context.h"
 #include <hal/nrf_saadc.h>
+#ifdef CONFIG_ADC_STREAM
+#include <drivers/counter.h>
+#endif
 
 #define LOG_LEVEL CONFIG_ADC_LOG_LEVEL
 #include <logging/log.h>
@@ -16,6 +19,13 @@ struct driver_data {
 	struct adc_context ctx;
 
 	u8_t positive_inputs[NRF_SAADC_CHANNEL_COUNT];
+
+#ifdef CONFIG_ADC_STREAM
+	const struct adc_stream_cfg *stream;
+	nrf_saadc_value_t *stream_buf;
+	u16_t stream_half;
+	u8_t stream_idx;
+#endif
 };
 
 static struct driver_data m_data = {
@@ -247,7 +257,8 @@ static int check_buffer_size(const struct adc_sequence *sequence,
 	return 0;
 }
 
-static int start_read(struct device *dev, const struct adc_sequence *sequence)
+static int setup_sequence(const struct adc_sequence *sequence,
+			  u8_t *active)
 {
 	int error;
 	u32_t selected_channels = sequence->channels;
@@ -313,6 +324,21 @@ static int start_read(struct device *dev, const struct adc_sequence *sequence)
 		return error;
 	}
 
+	*active = active_channels;
+
+	return 0;
+}
+
+static int start_read(struct device *dev, const struct adc_sequence *sequence)
+{
+	int error;
+	u8_t active_channels;
+
+	error = setup_sequence(sequence, &active_channels);
+	if (error) {
+		return error;
+	}
+
 	error = check_buffer_size(sequence, active_channels);
 	if (error) {
 		return error;
@@ -356,10 +382,208 @@ static int adc_nrfx_read_async(struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_STREAM
+/* The SAADC timer counts at 16 MHz and its period is limited to 80..2047
+ * ticks. It only samples a single channel.
+ */
+#define SAADC_TIMER_FREQ	16000000
+#define SAADC_TIMER_CC_MIN	80
+#define SAADC_TIMER_CC_MAX	2047
+
+/* Paces the conversions with a counter: its channel 0 triggers the SAMPLE
+ * task through (D)PPI at the end of each period, so that the sampling
+ * instants do not depend on any interrupt latency.
+ */
+static int stream_counter_setup(const struct adc_stream_cfg *cfg)
+{
+	struct device *counter = cfg->counter;
+	u32_t ticks = cfg->rate ?
+		      counter_get_frequency(counter) / cfg->rate : 0;
+	struct counter_top_cfg top_cfg = {
+		.ticks = ticks - 1,
+	};
+	struct counter_trigger_cfg trigger_cfg = {
+		.ticks = ticks - 1,
+		.task = nrf_saadc_task_address_get(NRF_SAADC_TASK_SAMPLE),
+	};
+	int error;
+
+	if (ticks < 2 || ticks - 1 > counter_get_max_top_value(counter)) {
+		LOG_ERR("Continuous sampling not possible at %u Hz",
+			cfg->rate);
+		return -EINVAL;
+	}
+
+	counter_stop(counter);
+
+	error = counter_set_top_value(counter, &top_cfg);
+	if (!error) {
+		error = counter_set_channel_trigger(counter, 0, &trigger_cfg);
+	}
+
+	if (error) {
+		LOG_ERR("Counter cannot trigger the sampling (%d)", error);
+	}
+
+	return error;
+}
+
+/* Implementation of the ADC driver API function: adc_stream_start. */
+static int adc_nrfx_stream_start(struct device *dev,
+				 const struct adc_sequence *sequence,
+				 const struct adc_stream_cfg *cfg)
+{
+	u32_t cc = cfg->rate ? SAADC_TIMER_FREQ / cfg->rate : 0;
+	size_t half = sequence->buffer_size / (2 * sizeof(nrf_saadc_value_t));
+	u8_t active_channels;
+	int error;
+
+	if (sequence->options || sequence->calibrate ||
+	    (!cfg->counter &&
+	     (cc < SAADC_TIMER_CC_MIN || cc > SAADC_TIMER_CC_MAX))) {
+		LOG_ERR("Continuous sampling not possible at %u Hz",
+			cfg->rate);
+		return -EINVAL;
+	}
+
+	if (half == 0 || half > BIT_MASK(15)) {
+		LOG_ERR("Provided buffer is of invalid size (%u)",
+			sequence->buffer_size);
+		return -ENOMEM;
+	}
+
+	adc_context_lock(&m_data.ctx, false, NULL);
+
+	error = setup_sequence(sequence, &active_channels);
+	if (!error && !cfg->counter && active_channels != 1U) {
+		LOG_ERR("Continuous sampling is supported for single channel "
+			"only");
+		error = -EINVAL;
+	}
+
+	if (!error && half % active_channels) {
+		/* Each half must hold whole scans of the channels */
+		LOG_ERR("Provided buffer is of invalid size (%u)",
+			sequence->buffer_size);
+		error = -ENOMEM;
+	}
+
+	if (!error && cfg->counter) {
+		error = stream_counter_setup(cfg);
+	}
+
+	if (error) {
+		adc_context_release(&m_data.ctx, error);
+		return error;
+	}
+
+	m_data.stream = cfg;
+	m_data.stream_buf = sequence->buffer;
+	m_data.stream_half = half;
+	m_data.stream_idx = 0U;
+
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_int_enable(NRF_SAADC_INT_STARTED);
+	nrf_saadc_buffer_init(m_data.stream_buf, half);
+	if (!cfg->counter) {
+		nrf_saadc_continuous_mode_enable(cc);
+	}
+
+	nrf_saadc_enable();
+	nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+	if (cfg->counter) {
+		/* The first sample comes one period later. */
+		counter_start(cfg->counter);
+	} else {
+		/* Starts the timer, which triggers the following samples. */
+		nrf_saadc_task_trigger(NRF_SAADC_TASK_SAMPLE);
+	}
+
+	return 0;
+}
+
+/* Implementation of the ADC driver API function: adc_stream_stop. */
+static int adc_nrfx_stream_stop(struct device *dev)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (!m_data.stream) {
+		irq_unlock(key);
+		return -EALREADY;
+	}
+
+	if (m_data.stream->counter) {
+		counter_stop(m_data.stream->counter);
+		(void)counter_cancel_channel_trigger(m_data.stream->counter, 0);
+	}
+
+	m_data.stream = NULL;
+
+	nrf_saadc_int_disable(NRF_SAADC_INT_STARTED);
+	nrf_saadc_continuous_mode_disable();
+	nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
+	while (!nrf_saadc_event_check(NRF_SAADC_EVENT_STOPPED)) {
+	}
+
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+	nrf_saadc_disable();
+
+	irq_unlock(key);
+
+	adc_context_release(&m_data.ctx, 0);
+
+	return 0;
+}
+
+/* Returns true if the event was part of continuous sampling. */
+static bool stream_irq_handle(struct device *dev)
+{
+	const struct adc_stream_cfg *stream = m_data.stream;
+	nrf_saadc_value_t *done;
+
+	if (!stream) {
+		return false;
+	}
+
+	if (nrf_saadc_event_check(NRF_SAADC_EVENT_STARTED)) {
+		nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+
+		/* The pointer is latched, queue the other half. */
+		nrf_saadc_buffer_pointer_set(m_data.stream_buf +
+			(m_data.stream_idx ^ 1U) * m_data.stream_half);
+	}
+
+	if (nrf_saadc_event_check(NRF_SAADC_EVENT_END)) {
+		nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+
+		done = m_data.stream_buf +
+		       m_data.stream_idx * m_data.stream_half;
+		m_data.stream_idx ^= 1U;
+		nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+
+		stream->callback(dev, done,
+				 m_data.stream_half * sizeof(nrf_saadc_value_t),
+				 stream->user_data);
+	}
+
+	return true;
+}
+#endif /* CONFIG_ADC_STREAM */
+
 static void saadc_irq_handler(void *param)
 {
 	struct device *dev = (struct device *)param;
 
+#ifdef CONFIG_ADC_STREAM
+	if (stream_irq_handle(dev)) {
+		return;
+	}
+#endif
+
 	if (nrf_saadc_event_check(NRF_SAADC_EVENT_END)) {
 		nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
 
@@ -405,6 +629,10 @@ static const struct adc_driver_api adc_nrfx_driver_api = {
 	.read          = adc_nrfx_read,
 #ifdef CONFIG_ADC_ASYNC
 	.read_async    = adc_nrfx_read_async,
+#endif
+#ifdef CONFIG_ADC_STREAM
+	.stream_start  = adc_nrfx_stream_start,
+	.stream_stop   = adc_nrfx_stream_stop,
 #endif
 	.ref_internal  = 600,
 };
@@ -16,7 +16,8 @@ LOG_MODULE_DECLARE(mpxxdtyy);
 #define NUM_RX_BLOCKS			4
 #define PDM_BLOCK_MAX_SIZE_BYTES	512
 
-K_MEM_SLAB_DEFINE(rx_pdm_i2s_mslab, PDM_BLOCK_MAX_SIZE_BYTES, NUM_RX_BLOCKS, 1);
+/* Word aligned, the samples are processed 32 bits at a time */
+K_MEM_SLAB_DEFINE(rx_pdm_i2s_mslab, PDM_BLOCK_MAX_SIZE_BYTES, NUM_RX_BLOCKS, 4);
 
 int mpxxdtyy_i2s_read(struct device *dev, u8_t stream, void **buffer,
 		      size_t *size, s32_t timeout)
@@ -43,6 +43,44 @@ static u8_t right_channel(u8_t a, u8_t b)
 	return ch_demux[a & CHANNEL_MASK] | (ch_demux[b & CHANNEL_MASK] << 4);
 }
 
+/* The filter takes 16-bit big endian PDM words. The bytes of both words
+ * in a 32-bit word are swapped at once, a single instruction on most cores.
+ */
+static void pdm_mono_swap(void *pdm_block, size_t pdm_size)
+{
+	u32_t *word = pdm_block;
+	size_t i;
+
+	if (IS_ENABLED(CONFIG_BIG_ENDIAN)) {
+		return;
+	}
+
+	for (i = 0; i < pdm_size / 4; i++) {
+		word[i] = ((word[i] & 0x00ff00ffU) << 8) |
+			  ((word[i] >> 8) & 0x00ff00ffU);
+	}
+
+	if (pdm_size & 2) {
+		((u16_t *)pdm_block)[pdm_size / 2 - 1] =
+			HTONS(((u16_t *)pdm_block)[pdm_size / 2 - 1]);
+	}
+}
+
+static void pdm_stereo_demux(void *pdm_block, size_t pdm_size)
+{
+	u8_t *pdm = pdm_block;
+	size_t i;
+	u8_t a, b;
+
+	for (i = 0; i + 1 < pdm_size; i += 2) {
+		a = pdm[i];
+		b = pdm[i + 1];
+
+		pdm[i] = left_channel(a, b);
+		pdm[i + 1] = right_channel(a, b);
+	}
+}
+
 u16_t sw_filter_lib_init(struct device *dev, struct dmic_cfg *cfg)
 {
 	struct mpxxdtyy_data *const data = DEV_DATA(dev);
@@ -87,31 +125,22 @@ int sw_filter_lib_run(TPDMFilter_InitStruct *pdm_filter,
 		      size_t pdm_size, size_t pcm_size)
 {
 	int i;
-	u8_t a, b;
 
 	if (pdm_block == NULL || pcm_block == NULL || pdm_filter == NULL) {
 		return -EINVAL;
 	}
 
-	for (i = 0; i < pdm_size/2; i++) {
-		switch (pdm_filter[0].In_MicChannels) {
-		case 1: /* MONO */
-			((u16_t *)pdm_block)[i] = HTONS(((u16_t *)pdm_block)[i]);
-			break;
-
-		case 2: /* STEREO */
-			if (pdm_filter[0].In_MicChannels > 1) {
-				a = ((u8_t *)pdm_block)[2*i];
-				b = ((u8_t *)pdm_block)[2*i + 1];
+	switch (pdm_filter[0].In_MicChannels) {
+	case 1: /* MONO */
+		pdm_mono_swap(pdm_block, pdm_size);
+		break;
 
-				((u8_t *)pdm_block)[2*i] = left_channel(a, b);
-				((u8_t *)pdm_block)[2*i + 1] = right_channel(a, b);
-			}
-			break;
+	case 2: /* STEREO */
+		pdm_stereo_demux(pdm_block, pdm_size);
+		break;
 
-		default:
-			return -EINVAL;
-		}
+	default:
+		return -EINVAL;
 	}
 
 	switch (pdm_filter[0].Decimation) {
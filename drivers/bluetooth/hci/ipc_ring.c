@@ -0,0 +1,209 @@
+/* ipc_ring.c - HCI driver for a controller on another core */
+
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr.h>
+#include <init.h>
+#include <device.h>
+#include <ipc/ipc_ring.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/hci_driver.h>
+
+#define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_DRIVER)
+#define LOG_MODULE_NAME bt_driver
+#include "common/log.h"
+
+/* Packets are exchanged with an H:4 packet type in front, see
+ * samples/bluetooth/hci_ipc for the controller side.
+ */
+#define H4_CMD  0x01
+#define H4_ACL  0x02
+#define H4_EVT  0x04
+
+static K_THREAD_STACK_DEFINE(rx_thread_stack, CONFIG_BT_RX_STACK_SIZE);
+static struct k_thread rx_thread_data;
+
+static struct ipc_ring ring;
+
+/* The ring takes one sender at a time */
+static K_SEM_DEFINE(tx_sem, 1, 1);
+
+static struct net_buf *evt_get(const u8_t *data, size_t len)
+{
+	const struct bt_hci_evt_hdr *hdr = (const void *)data;
+	bool discardable = false;
+
+	if (len < sizeof(*hdr)) {
+		return NULL;
+	}
+
+	/* Advertising reports may be dropped if the host runs short */
+	if (hdr->evt == BT_HCI_EVT_LE_META_EVENT && len > sizeof(*hdr) &&
+	    data[sizeof(*hdr)] == BT_HCI_EVT_LE_ADVERTISING_REPORT) {
+		discardable = true;
+	}
+
+	return bt_buf_get_evt(hdr->evt, discardable,
+			      discardable ? K_NO_WAIT : K_FOREVER);
+}
+
+static void recv_cb(struct ipc_ring *ring, const void *data, size_t len,
+		    void *user_data)
+{
+	const u8_t *pkt = data;
+	struct net_buf *buf;
+
+	if (len < 1) {
+		return;
+	}
+
+	switch (pkt[0]) {
+	case H4_EVT:
+		buf = evt_get(&pkt[1], len - 1);
+		break;
+	case H4_ACL:
+		buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
+		break;
+	default:
+		BT_ERR("Unknown packet type %u", pkt[0]);
+		return;
+	}
+
+	if (buf == NULL) {
+		BT_DBG("Discarding packet type %u", pkt[0]);
+		return;
+	}
+
+	if (len - 1 > net_buf_tailroom(buf)) {
+		BT_ERR("Packet too large (%zu bytes)", len - 1);
+		net_buf_unref(buf);
+		return;
+	}
+
+	/* The packet is copied out of shared memory once, straight into the
+	 * host buffer.
+	 */
+	net_buf_add_mem(buf, &pkt[1], len - 1);
+
+	if (pkt[0] == H4_EVT && bt_hci_evt_is_prio(pkt[1])) {
+		bt_recv_prio(buf);
+	} else {
+		bt_recv(buf);
+	}
+}
+
+static void rx_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		(void)ipc_ring_process(&ring, K_FOREVER);
+	}
+}
+
+static int ipc_send(struct net_buf *buf)
+{
+	u8_t *pkt;
+	u8_t type;
+	int err;
+
+	BT_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf), buf->len);
+
+	switch (bt_buf_get_type(buf)) {
+	case BT_BUF_ACL_OUT:
+		type = H4_ACL;
+		break;
+	case BT_BUF_CMD:
+		type = H4_CMD;
+		break;
+	default:
+		BT_ERR("Unknown buffer type");
+		return -EINVAL;
+	}
+
+	k_sem_take(&tx_sem, K_FOREVER);
+
+	pkt = ipc_ring_alloc(&ring, buf->len + 1);
+	if (pkt == NULL) {
+		k_sem_give(&tx_sem);
+		BT_ERR("No room for %u bytes in ring", buf->len + 1);
+		return -ENOMEM;
+	}
+
+	pkt[0] = type;
+	memcpy(&pkt[1], buf->data, buf->len);
+
+	err = ipc_ring_commit(&ring, buf->len + 1);
+	k_sem_give(&tx_sem);
+
+	if (err != 0) {
+		return err;
+	}
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+static int ipc_open(void)
+{
+	struct device *ipm;
+	int err;
+
+	BT_DBG("");
+
+	ipm = device_get_binding(CONFIG_BT_IPC_RING_IPM_DEV_NAME);
+	if (ipm == NULL) {
+		BT_ERR("No IPM device %s", CONFIG_BT_IPC_RING_IPM_DEV_NAME);
+		return -ENODEV;
+	}
+
+	err = ipc_ring_init(&ring, ipm,
+			    (void *)CONFIG_BT_IPC_RING_TX_ADDR,
+			    CONFIG_BT_IPC_RING_TX_SIZE,
+			    (void *)CONFIG_BT_IPC_RING_RX_ADDR,
+			    CONFIG_BT_IPC_RING_RX_SIZE,
+			    recv_cb, NULL);
+	if (err != 0) {
+		BT_ERR("Ring init failed (err %d)", err);
+		return err;
+	}
+
+	k_thread_create(&rx_thread_data, rx_thread_stack,
+			K_THREAD_STACK_SIZEOF(rx_thread_stack),
+			rx_thread, NULL, NULL, NULL,
+			K_PRIO_COOP(CONFIG_BT_RX_PRIO),
+			0, K_NO_WAIT);
+
+	return 0;
+}
+
+static const struct bt_hci_driver drv = {
+	.name		= "IPC ring",
+	.bus		= BT_HCI_DRIVER_BUS_IPM,
+	.open		= ipc_open,
+	.send		= ipc_send,
+};
+
+static int bt_ipc_init(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	bt_hci_driver_register(&drv);
+
+	return 0;
+}
+
+SYS_INIT(bt_ipc_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
@@ -12,6 +12,15 @@ LOG_MODULE_REGISTER(net_can, CONFIG_CAN_NET_LOG_LEVEL);
 
 struct mcast_filter_mapping {
 	const struct in6_addr *addr;
+	u16_t group;
+};
+
+/* Filter matching the groups whose address bits set in mask are the
+ * ones of group.
+ */
+struct mcast_filter {
+	u16_t group;
+	u16_t mask;
 	int filter_id;
 };
 
@@ -20,6 +29,9 @@ struct net_can_context {
 	struct net_if *iface;
 	int recv_filter_id;
 	struct mcast_filter_mapping mcast_mapping[NET_IF_MAX_IPV6_MADDR];
+	struct mcast_filter mcast_filter[CONFIG_CAN_NET_MCAST_FILTERS];
+	/* Some mcast filters match groups that are not joined */
+	bool mcast_merged;
 #ifdef CONFIG_NET_L2_CANBUS_ETH_TRANSLATOR
 	int eth_bridge_filter_id;
 	int all_mcast_filter_id;
@@ -42,6 +54,19 @@ struct mcast_filter_mapping *can_get_mcast_filter(struct net_can_context *ctx,
 	return NULL;
 }
 
+static bool can_mcast_group_joined(struct net_can_context *ctx, u16_t group)
+{
+	struct mcast_filter_mapping *map = ctx->mcast_mapping;
+
+	for (int i = 0; i < NET_IF_MAX_IPV6_MADDR; i++) {
+		if (map[i].addr && map[i].group == group) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 static inline u8_t can_get_frame_datalength(struct zcan_frame *frame)
 {
 	/* TODO: Needs update when CAN FD support is added */
@@ -106,6 +131,21 @@ static void net_can_recv(struct zcan_frame *frame, void *arg)
 	int ret;
 
 	NET_DBG("Frame with ID 0x%x received", frame->ext_id);
+
+	/* The translator forwards all the mcast frames to Ethernet */
+	if (!IS_ENABLED(CONFIG_NET_L2_CANBUS_ETH_TRANSLATOR) &&
+	    ctx->mcast_merged &&
+	    (frame->ext_id & CAN_NET_IF_ADDR_MCAST_MASK) &&
+	    !can_mcast_group_joined(ctx, can_get_lladdr_dest(frame) &
+				    CAN_NET_IF_ADDR_MASK)) {
+		return;
+	}
+
+	/* Consecutive frames go straight into the reassembled packet */
+	if (net_6locan_recv_cf(ctx->iface, frame)) {
+		return;
+	}
+
 	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, pkt_size, AF_UNSPEC, 0,
 					   K_NO_WAIT);
 	if (!pkt) {
@@ -140,57 +180,160 @@ drop:
 }
 
 static inline int attach_mcast_filter(struct net_can_context *ctx,
-				      const struct in6_addr *addr)
+				      const struct mcast_filter *mcast_filter)
 {
-	static struct zcan_filter filter = {
+	const struct zcan_filter filter = {
 		.id_type = CAN_EXTENDED_IDENTIFIER,
 		.rtr = CAN_DATAFRAME,
 		.rtr_mask = 1,
 		.ext_id_mask = CAN_NET_IF_ADDR_MCAST_MASK |
-			       CAN_NET_IF_ADDR_DEST_MASK
+			       (mcast_filter->mask << CAN_NET_IF_ADDR_DEST_POS),
+		.ext_id = CAN_NET_IF_ADDR_MCAST_MASK |
+			  (mcast_filter->group << CAN_NET_IF_ADDR_DEST_POS)
 	};
-	const u16_t group =
-		sys_be16_to_cpu(UNALIGNED_GET((&addr->s6_addr16[7])));
 	int filter_id;
 
-	filter.ext_id = CAN_NET_IF_ADDR_MCAST_MASK |
-			((group & CAN_NET_IF_ADDR_MASK) <<
-			 CAN_NET_IF_ADDR_DEST_POS);
-
 	filter_id = can_attach_isr(ctx->can_dev, net_can_recv,
 				   ctx, &filter);
 	if (filter_id == CAN_NET_FILTER_NOT_SET) {
 		return CAN_NET_FILTER_NOT_SET;
 	}
 
-	NET_DBG("Attached mcast filter. Group 0x%04x. Filter:%d",
-		group, filter_id);
+	NET_DBG("Attached mcast filter. Group 0x%04x mask 0x%04x. Filter:%d",
+		mcast_filter->group, mcast_filter->mask, filter_id);
 
 	return filter_id;
 }
 
+/* Number of address bits still compared when merging two filters */
+static inline int mcast_filter_merge_weight(const struct mcast_filter *a,
+					    const struct mcast_filter *b)
+{
+	return popcount(a->mask & b->mask & ~(a->group ^ b->group));
+}
+
+/* Build one filter per joined group, then merge the two filters sharing
+ * the most address bits until they fit in the hardware filters.
+ */
+static int can_build_mcast_filters(struct net_can_context *ctx,
+				   struct mcast_filter *filters)
+{
+	struct mcast_filter_mapping *map = ctx->mcast_mapping;
+	int weight, best_weight, best_i, best_j;
+	int count = 0;
+	int i, j;
+
+	for (i = 0; i < NET_IF_MAX_IPV6_MADDR; i++) {
+		if (!map[i].addr) {
+			continue;
+		}
+
+		for (j = 0; j < count; j++) {
+			if (filters[j].group == map[i].group) {
+				break;
+			}
+		}
+
+		if (j == count) {
+			filters[count].group = map[i].group;
+			filters[count].mask = CAN_NET_IF_ADDR_MASK;
+			count++;
+		}
+	}
+
+	while (count > CONFIG_CAN_NET_MCAST_FILTERS) {
+		best_weight = -1;
+		best_i = 0;
+		best_j = 1;
+
+		for (i = 0; i < count; i++) {
+			for (j = i + 1; j < count; j++) {
+				weight = mcast_filter_merge_weight(&filters[i],
+								   &filters[j]);
+				if (weight > best_weight) {
+					best_weight = weight;
+					best_i = i;
+					best_j = j;
+				}
+			}
+		}
+
+		filters[best_i].mask &= filters[best_j].mask &
+			~(filters[best_i].group ^ filters[best_j].group);
+		filters[best_i].group &= filters[best_i].mask;
+		filters[best_j] = filters[--count];
+	}
+
+	return count;
+}
+
+static void can_update_mcast_filters(struct net_can_context *ctx)
+{
+	struct mcast_filter filters[NET_IF_MAX_IPV6_MADDR];
+	struct mcast_filter *slot;
+	bool merged = false;
+	int count, i;
+
+	count = can_build_mcast_filters(ctx, filters);
+
+	for (i = 0; i < count; i++) {
+		if (filters[i].mask != CAN_NET_IF_ADDR_MASK) {
+			merged = true;
+		}
+	}
+
+	/* Filter in software before the filters get wider */
+	if (merged) {
+		ctx->mcast_merged = true;
+	}
+
+	for (i = 0; i < CONFIG_CAN_NET_MCAST_FILTERS; i++) {
+		slot = &ctx->mcast_filter[i];
+
+		if (i < count && slot->filter_id != CAN_NET_FILTER_NOT_SET &&
+		    slot->group == filters[i].group &&
+		    slot->mask == filters[i].mask) {
+			continue;
+		}
+
+		if (slot->filter_id != CAN_NET_FILTER_NOT_SET) {
+			can_detach(ctx->can_dev, slot->filter_id);
+			slot->filter_id = CAN_NET_FILTER_NOT_SET;
+		}
+
+		if (i >= count) {
+			continue;
+		}
+
+		slot->group = filters[i].group;
+		slot->mask = filters[i].mask;
+		slot->filter_id = attach_mcast_filter(ctx, slot);
+		if (slot->filter_id < 0) {
+			NET_ERR("Can't attach mcast filter");
+		}
+	}
+
+	ctx->mcast_merged = merged;
+}
+
 static void mcast_cb(struct net_if *iface, const struct in6_addr *addr,
 		     bool is_joined)
 {
 	struct device *dev = net_if_get_device(iface);
 	struct net_can_context *ctx = dev->driver_data;
 	struct mcast_filter_mapping *filter_mapping;
-	int filter_id;
 
 	if (is_joined) {
 		filter_mapping = can_get_mcast_filter(ctx, NULL);
 		if (!filter_mapping) {
 			NET_ERR("Can't get a free filter_mapping");
-		}
-
-		filter_id = attach_mcast_filter(ctx, addr);
-		if (filter_id < 0) {
-			NET_ERR("Can't attach mcast filter");
 			return;
 		}
 
+		filter_mapping->group =
+			sys_be16_to_cpu(UNALIGNED_GET((&addr->s6_addr16[7]))) &
+			CAN_NET_IF_ADDR_MASK;
 		filter_mapping->addr = addr;
-		filter_mapping->filter_id = filter_id;
 	} else {
 		filter_mapping = can_get_mcast_filter(ctx, addr);
 		if (!filter_mapping) {
@@ -198,9 +341,10 @@ static void mcast_cb(struct net_if *iface, const struct in6_addr *addr,
 			return;
 		}
 
-		can_detach(ctx->can_dev, filter_mapping->filter_id);
 		filter_mapping->addr = NULL;
 	}
+
+	can_update_mcast_filters(ctx);
 }
 
 static void net_can_iface_init(struct net_if *iface)
@@ -376,6 +520,9 @@ static int net_can_init(struct device *dev)
 	struct net_can_context *ctx = dev->driver_data;
 
 	ctx->recv_filter_id = CAN_NET_FILTER_NOT_SET;
+	for (int i = 0; i < CONFIG_CAN_NET_MCAST_FILTERS; i++) {
+		ctx->mcast_filter[i].filter_id = CAN_NET_FILTER_NOT_SET;
+	}
 #ifdef CONFIG_NET_L2_CANBUS_ETH_TRANSLATOR
 	ctx->eth_bridge_filter_id = CAN_NET_FILTER_NOT_SET;
 	ctx->all_mcast_filter_id = CAN_NET_FILTER_NOT_SET;
@@ -58,6 +58,7 @@ void uart_mcumgr_free_rx_buf(struct uart_mcumgr_rx_buf *rx_buf)
 	k_mem_slab_free(&uart_mcumgr_slab, &block);
 }
 
+#if !defined(CONFIG_UART_MCUMGR_ASYNC)
 /**
  * Reads a chunk of received data from the UART.
  */
@@ -69,6 +70,7 @@ static int uart_mcumgr_read_chunk(void *buf, int capacity)
 
 	return uart_fifo_read(uart_mcumgr_dev, buf, capacity);
 }
+#endif /* !CONFIG_UART_MCUMGR_ASYNC */
 
 /**
  * Processes a single incoming byte.
@@ -112,6 +114,79 @@ static struct uart_mcumgr_rx_buf *uart_mcumgr_rx_byte(u8_t byte)
 	return NULL;
 }
 
+#if defined(CONFIG_UART_MCUMGR_ASYNC)
+/** Two DMA buffers, received into alternately. */
+static u8_t uart_mcumgr_async_buf[2][CONFIG_UART_MCUMGR_ASYNC_RX_BUF_SIZE];
+static u8_t uart_mcumgr_async_idx;
+
+static K_SEM_DEFINE(uart_mcumgr_tx_sem, 0, 1);
+
+static void uart_mcumgr_rx_enable(void)
+{
+	uart_mcumgr_async_idx = 1U;
+	uart_rx_enable(uart_mcumgr_dev, uart_mcumgr_async_buf[0],
+		       sizeof(uart_mcumgr_async_buf[0]),
+		       CONFIG_UART_MCUMGR_ASYNC_RX_TIMEOUT);
+}
+
+/**
+ * Handler of the asynchronous UART events.
+ */
+static void uart_mcumgr_async(struct uart_event *evt, void *user_data)
+{
+	struct uart_mcumgr_rx_buf *rx_buf;
+	const u8_t *data;
+	size_t i;
+
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&uart_mcumgr_tx_sem);
+		break;
+	case UART_RX_RDY:
+		data = &evt->data.rx.buf[evt->data.rx.offset];
+		for (i = 0; i < evt->data.rx.len; i++) {
+			rx_buf = uart_mcumgr_rx_byte(data[i]);
+			if (rx_buf != NULL) {
+				uart_mgumgr_recv_cb(rx_buf);
+			}
+		}
+		break;
+	case UART_RX_BUF_REQUEST:
+		uart_rx_buf_rsp(uart_mcumgr_dev,
+				uart_mcumgr_async_buf[uart_mcumgr_async_idx],
+				sizeof(uart_mcumgr_async_buf[0]));
+		uart_mcumgr_async_idx ^= 1U;
+		break;
+	case UART_RX_DISABLED:
+		/* Stopped by a line error, start over. */
+		uart_mcumgr_rx_enable();
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Sends raw data over the UART.
+ */
+static int uart_mcumgr_send_raw(const void *data, int len, void *arg)
+{
+	int rc;
+
+	rc = uart_tx(uart_mcumgr_dev, data, len, K_FOREVER);
+	if (rc != 0) {
+		return rc;
+	}
+
+	/* The data lives on the caller's stack. */
+	k_sem_take(&uart_mcumgr_tx_sem, K_FOREVER);
+
+	return 0;
+}
+#else
 /**
  * ISR that is called when UART bytes are received.
  */
@@ -155,12 +230,20 @@ static int uart_mcumgr_send_raw(const void *data, int len, void *arg)
 
 	return 0;
 }
+#endif /* CONFIG_UART_MCUMGR_ASYNC */
 
 int uart_mcumgr_send(const u8_t *data, int len)
 {
 	return mcumgr_serial_tx_pkt(data, len, uart_mcumgr_send_raw, NULL);
 }
 
+#if defined(CONFIG_UART_MCUMGR_ASYNC)
+static void uart_mcumgr_setup(struct device *uart)
+{
+	uart_callback_set(uart, uart_mcumgr_async, NULL);
+	uart_mcumgr_rx_enable();
+}
+#else
 static void uart_mcumgr_setup(struct device *uart)
 {
 	u8_t c;
@@ -177,6 +260,7 @@ static void uart_mcumgr_setup(struct device *uart)
 
 	uart_irq_rx_enable(uart);
 }
+#endif /* CONFIG_UART_MCUMGR_ASYNC */
 
 void uart_mcumgr_register(uart_mcumgr_recv_fn *cb)
 {
@@ -12,6 +12,9 @@
 #else
 #include <nrfx_ppi.h>
 #endif
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+#include "counter_nrfx_trigger.h"
+#endif
 
 #define LOG_LEVEL CONFIG_COUNTER_LOG_LEVEL
 #define LOG_MODULE_NAME counter_rtc
@@ -43,6 +46,11 @@ struct counter_nrfx_data {
 struct counter_nrfx_ch_data {
 	counter_alarm_callback_t callback;
 	void *user_data;
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+	/* Task triggered by the compare event, 0 if none */
+	u32_t task;
+	u8_t ppi_ch;
+#endif
 };
 
 struct counter_nrfx_config {
@@ -86,6 +94,16 @@ static u32_t counter_nrfx_read(struct device *dev)
 	return nrfx_rtc_counter_get(&get_nrfx_config(dev)->rtc);
 }
 
+static bool ch_is_busy(const struct counter_nrfx_ch_data *ch_data)
+{
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+	if (ch_data->task) {
+		return true;
+	}
+#endif
+	return ch_data->callback != NULL;
+}
+
 static int counter_nrfx_set_alarm(struct device *dev, u8_t chan_id,
 				  const struct counter_alarm_cfg *alarm_cfg)
 {
@@ -97,7 +115,7 @@ static int counter_nrfx_set_alarm(struct device *dev, u8_t chan_id,
 		return -EINVAL;
 	}
 
-	if (nrfx_config->ch_data[chan_id].callback) {
+	if (ch_is_busy(&nrfx_config->ch_data[chan_id])) {
 		return -EBUSY;
 	}
 
@@ -141,6 +159,79 @@ static int counter_nrfx_cancel_alarm(struct device *dev, u8_t chan_id)
 	return 0;
 }
 
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+static int counter_nrfx_set_trigger(struct device *dev, u8_t chan_id,
+				    const struct counter_trigger_cfg *cfg)
+{
+	const struct counter_nrfx_config *nrfx_config = get_nrfx_config(dev);
+	const nrfx_rtc_t *rtc = &nrfx_config->rtc;
+	struct counter_nrfx_ch_data *ch_data = &nrfx_config->ch_data[chan_id];
+	u32_t top = get_dev_data(dev)->top;
+	u32_t ticks = cfg->ticks;
+	int err;
+
+	if (ticks > top) {
+		return -EINVAL;
+	}
+
+	/* A custom top value cleared by the interrupt handler would make the
+	 * period depend on the interrupt latency.
+	 */
+	if ((top != COUNTER_MAX_TOP_VALUE)
+#if CONFIG_COUNTER_RTC_WITH_PPI_WRAP
+	    && !nrfx_config->use_ppi
+#endif
+	    ) {
+		return -ENOTSUP;
+	}
+
+	if (ch_is_busy(ch_data)) {
+		return -EBUSY;
+	}
+
+	err = counter_nrfx_trigger_connect(
+		nrfx_rtc_event_address_get(rtc,
+				RTC_CHANNEL_EVENT_ADDR(ID_TO_CC(chan_id))),
+		cfg->task, &ch_data->ppi_ch);
+	if (err < 0) {
+		return err;
+	}
+
+	ch_data->task = cfg->task;
+
+	if ((ticks == 0) && (top != COUNTER_MAX_TOP_VALUE)) {
+		/* CC of 0 never matches when the counter is cleared. */
+		INF("Attempt to set CC to 0, delayed to 1.");
+		ticks++;
+	}
+
+	/* The event only drives the task, it does not interrupt */
+	nrfx_rtc_cc_set(rtc, ID_TO_CC(chan_id), ticks, false);
+
+	return 0;
+}
+
+static int counter_nrfx_cancel_trigger(struct device *dev, u8_t chan_id)
+{
+	const struct counter_nrfx_config *nrfx_config = get_nrfx_config(dev);
+	const nrfx_rtc_t *rtc = &nrfx_config->rtc;
+	struct counter_nrfx_ch_data *ch_data = &nrfx_config->ch_data[chan_id];
+
+	if (!ch_data->task) {
+		return -EALREADY;
+	}
+
+	nrfx_rtc_cc_disable(rtc, ID_TO_CC(chan_id));
+	counter_nrfx_trigger_disconnect(
+		nrfx_rtc_event_address_get(rtc,
+				RTC_CHANNEL_EVENT_ADDR(ID_TO_CC(chan_id))),
+		ch_data->task, ch_data->ppi_ch);
+	ch_data->task = 0U;
+
+	return 0;
+}
+#endif /* CONFIG_COUNTER_NRF_TRIGGER */
+
 static int counter_nrfx_set_top_value(struct device *dev,
 				      const struct counter_top_cfg *cfg)
 {
@@ -327,6 +418,10 @@ static const struct counter_driver_api counter_nrfx_driver_api = {
 	.get_pending_int = counter_nrfx_get_pending_int,
 	.get_top_value = counter_nrfx_get_top_value,
 	.get_max_relative_alarm = counter_nrfx_get_max_relative_alarm,
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+	.set_trigger = counter_nrfx_set_trigger,
+	.cancel_trigger = counter_nrfx_cancel_trigger,
+#endif
 };
 
 #define COUNTER_NRFX_RTC_DEVICE(idx)					       \
@@ -5,6 +5,9 @@
  */
 #include <drivers/counter.h>
 #include <nrfx_timer.h>
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+#include "counter_nrfx_trigger.h"
+#endif
 
 #define LOG_LEVEL CONFIG_COUNTER_LOG_LEVEL
 #define LOG_MODULE_NAME counter_timer
@@ -33,6 +36,11 @@ struct counter_nrfx_data {
 struct counter_nrfx_ch_data {
 	counter_alarm_callback_t callback;
 	void *user_data;
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+	/* Task triggered by the compare event, 0 if none */
+	u32_t task;
+	u8_t ppi_ch;
+#endif
 };
 
 struct counter_nrfx_config {
@@ -115,6 +123,16 @@ static inline u32_t counter_nrfx_get_cc_value(struct device *dev,
 	return cc_val;
 }
 
+static bool ch_is_busy(const struct counter_nrfx_ch_data *ch_data)
+{
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+	if (ch_data->task) {
+		return true;
+	}
+#endif
+	return ch_data->callback != NULL;
+}
+
 static int counter_nrfx_set_alarm(struct device *dev, u8_t chan_id,
 				  const struct counter_alarm_cfg *alarm_cfg)
 {
@@ -126,7 +144,7 @@ static int counter_nrfx_set_alarm(struct device *dev, u8_t chan_id,
 		return -EINVAL;
 	}
 
-	if (nrfx_config->ch_data[chan_id].callback) {
+	if (ch_is_busy(&nrfx_config->ch_data[chan_id])) {
 		return -EBUSY;
 	}
 
@@ -155,6 +173,56 @@ static int counter_nrfx_cancel_alarm(struct device *dev, u8_t chan_id)
 	return 0;
 }
 
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+static int counter_nrfx_set_trigger(struct device *dev, u8_t chan_id,
+				    const struct counter_trigger_cfg *cfg)
+{
+	const struct counter_nrfx_config *nrfx_config = get_nrfx_config(dev);
+	const nrfx_timer_t *timer = &nrfx_config->timer;
+	struct counter_nrfx_ch_data *ch_data = &nrfx_config->ch_data[chan_id];
+	int err;
+
+	if (cfg->ticks > nrfx_timer_capture_get(timer, TOP_CH)) {
+		return -EINVAL;
+	}
+
+	if (ch_is_busy(ch_data)) {
+		return -EBUSY;
+	}
+
+	err = counter_nrfx_trigger_connect(
+		nrfx_timer_compare_event_address_get(timer, ID_TO_CC(chan_id)),
+		cfg->task, &ch_data->ppi_ch);
+	if (err < 0) {
+		return err;
+	}
+
+	ch_data->task = cfg->task;
+
+	/* The event only drives the task, it does not interrupt */
+	nrfx_timer_compare(timer, ID_TO_CC(chan_id), cfg->ticks, false);
+
+	return 0;
+}
+
+static int counter_nrfx_cancel_trigger(struct device *dev, u8_t chan_id)
+{
+	const struct counter_nrfx_config *nrfx_config = get_nrfx_config(dev);
+	const nrfx_timer_t *timer = &nrfx_config->timer;
+	struct counter_nrfx_ch_data *ch_data = &nrfx_config->ch_data[chan_id];
+
+	if (!ch_data->task) {
+		return -EALREADY;
+	}
+
+	counter_nrfx_trigger_disconnect(
+		nrfx_timer_compare_event_address_get(timer, ID_TO_CC(chan_id)),
+		ch_data->task, ch_data->ppi_ch);
+	ch_data->task = 0U;
+
+	return 0;
+}
+#endif /* CONFIG_COUNTER_NRF_TRIGGER */
 
 static int counter_nrfx_set_top_value(struct device *dev,
 				      const struct counter_top_cfg *cfg)
@@ -261,6 +329,10 @@ static const struct counter_driver_api counter_nrfx_driver_api = {
 	.get_pending_int = counter_nrfx_get_pending_int,
 	.get_top_value = counter_nrfx_get_top_value,
 	.get_max_relative_alarm = counter_nrfx_get_max_relative_alarm,
+#ifdef CONFIG_COUNTER_NRF_TRIGGER
+	.set_trigger = counter_nrfx_set_trigger,
+	.cancel_trigger = counter_nrfx_cancel_trigger,
+#endif
 };
 
 #define COUNTER_NRFX_TIMER_DEVICE(idx)					       \
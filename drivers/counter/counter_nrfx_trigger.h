@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Connection of a counter compare event to a peripheral task, shared by
+ * the TIMER and RTC counters for counter_set_channel_trigger().
+ */
+
+#ifndef ZEPHYR_DRIVERS_COUNTER_COUNTER_NRFX_TRIGGER_H_
+#define ZEPHYR_DRIVERS_COUNTER_COUNTER_NRFX_TRIGGER_H_
+
+#include <errno.h>
+#include <zephyr/types.h>
+#ifdef DPPI_PRESENT
+#include <nrfx_dppi.h>
+#else
+#include <nrfx_ppi.h>
+#endif
+
+#ifdef DPPI_PRESENT
+/* The PUBLISH and SUBSCRIBE registers of an event or task are at this
+ * offset from it.
+ */
+#define TRIGGER_DPPI_OFFSET	0x80
+#define TRIGGER_DPPI_EN		BIT(31)
+#endif
+
+static inline int counter_nrfx_trigger_connect(u32_t evt, u32_t task,
+					       u8_t *ch)
+{
+#ifdef DPPI_PRESENT
+	if (nrfx_dppi_channel_alloc(ch) != NRFX_SUCCESS) {
+		return -ENOMEM;
+	}
+
+	*(volatile u32_t *)(evt + TRIGGER_DPPI_OFFSET) =
+		TRIGGER_DPPI_EN | *ch;
+	*(volatile u32_t *)(task + TRIGGER_DPPI_OFFSET) =
+		TRIGGER_DPPI_EN | *ch;
+	(void)nrfx_dppi_channel_enable(*ch);
+#else
+	nrf_ppi_channel_t ppi_ch;
+
+	if (nrfx_ppi_channel_alloc(&ppi_ch) != NRFX_SUCCESS) {
+		return -ENOMEM;
+	}
+
+	(void)nrfx_ppi_channel_assign(ppi_ch, evt, task);
+	(void)nrfx_ppi_channel_enable(ppi_ch);
+	*ch = ppi_ch;
+#endif
+
+	return 0;
+}
+
+static inline void counter_nrfx_trigger_disconnect(u32_t evt, u32_t task,
+						   u8_t ch)
+{
+#ifdef DPPI_PRESENT
+	(void)nrfx_dppi_channel_disable(ch);
+	*(volatile u32_t *)(evt + TRIGGER_DPPI_OFFSET) = 0U;
+	*(volatile u32_t *)(task + TRIGGER_DPPI_OFFSET) = 0U;
+	(void)nrfx_dppi_channel_free(ch);
+#else
+	(void)nrfx_ppi_channel_disable((nrf_ppi_channel_t)ch);
+	(void)nrfx_ppi_channel_free((nrf_ppi_channel_t)ch);
+#endif
+}
+
+#endif /* ZEPHYR_DRIVERS_COUNTER_COUNTER_NRFX_TRIGGER_H_ */
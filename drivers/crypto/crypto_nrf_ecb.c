@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file Crypto driver for the AES ECB peripheral of nRF SoCs
+ *
+ * The peripheral only encrypts a single block with a 128-bit key. CCM is
+ * built on top of it in the driver, both the CBC-MAC and the counter
+ * blocks are encrypted by the hardware.
+ */
+
+#include <init.h>
+#include <kernel.h>
+#include <string.h>
+#include <crypto/cipher.h>
+#include <hal/nrf_ecb.h>
+
+#define LOG_LEVEL CONFIG_CRYPTO_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(crypto_nrf_ecb);
+
+#define ECB_BLOCK_SIZE 16
+
+#define CRYPTO_MAX_SESSION CONFIG_CRYPTO_NRF_ECB_MAX_SESSION
+
+/* Layout expected by the peripheral at ECBDATAPTR */
+struct ecb_data {
+	u8_t key[ECB_BLOCK_SIZE];
+	u8_t cleartext[ECB_BLOCK_SIZE];
+	u8_t ciphertext[ECB_BLOCK_SIZE];
+} __packed;
+
+struct nrf_ecb_drv_state {
+	bool in_use;
+	u8_t key[ECB_BLOCK_SIZE];
+};
+
+static struct nrf_ecb_drv_state nrf_ecb_state[CRYPTO_MAX_SESSION];
+static struct ecb_data ecb_data;
+static K_SEM_DEFINE(ecb_sem, 1, 1);
+
+/* Called with ecb_sem taken, the key is loaded in ecb_data already */
+static void ecb_encrypt(const u8_t *in, u8_t *out)
+{
+	memcpy(ecb_data.cleartext, in, ECB_BLOCK_SIZE);
+
+	do {
+		nrf_ecb_task_trigger(NRF_ECB, NRF_ECB_TASK_STOPECB);
+		NRF_ECB->ECBDATAPTR = (u32_t)&ecb_data;
+		NRF_ECB->EVENTS_ENDECB = 0;
+		NRF_ECB->EVENTS_ERRORECB = 0;
+		nrf_ecb_task_trigger(NRF_ECB, NRF_ECB_TASK_STARTECB);
+		while ((NRF_ECB->EVENTS_ENDECB == 0) &&
+		       (NRF_ECB->EVENTS_ERRORECB == 0)) {
+		}
+	} while (NRF_ECB->EVENTS_ERRORECB != 0);
+
+	memcpy(out, ecb_data.ciphertext, ECB_BLOCK_SIZE);
+}
+
+static void ecb_begin(struct cipher_ctx *ctx)
+{
+	struct nrf_ecb_drv_state *data = ctx->drv_sessn_state;
+
+	k_sem_take(&ecb_sem, K_FOREVER);
+	memcpy(ecb_data.key, data->key, sizeof(ecb_data.key));
+}
+
+static void ecb_end(void)
+{
+	(void)memset(&ecb_data, 0, sizeof(ecb_data));
+	k_sem_give(&ecb_sem);
+}
+
+static int do_ecb_encrypt(struct cipher_ctx *ctx, struct cipher_pkt *op)
+{
+	if (op->in_len != ECB_BLOCK_SIZE ||
+	    op->out_buf_max < ECB_BLOCK_SIZE) {
+		LOG_ERR("ECB operates on a single block");
+		return -EINVAL;
+	}
+
+	ecb_begin(ctx);
+	ecb_encrypt(op->in_buf, op->out_buf);
+	ecb_end();
+
+	op->out_len = ECB_BLOCK_SIZE;
+
+	return 0;
+}
+
+static inline void xor_block(u8_t *dst, const u8_t *src, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		dst[i] ^= src[i];
+	}
+}
+
+/* CBC-MAC of the header and the plain text, RFC 3610 section 2.2 */
+static void ccm_mac(struct cipher_ctx *ctx, struct cipher_aead_pkt *aead_op,
+		    const u8_t *nonce, const u8_t *text, u8_t *mac)
+{
+	struct ccm_params *ccm_param = &ctx->mode_params.ccm_info;
+	u8_t l = 15U - ccm_param->nonce_len;
+	u8_t block[ECB_BLOCK_SIZE];
+	size_t len = aead_op->pkt->in_len;
+	size_t ofs;
+	size_t n;
+
+	block[0] = ((aead_op->ad_len ? 1 : 0) << 6) |
+		   (((ccm_param->tag_len - 2U) / 2U) << 3) | (l - 1U);
+	memcpy(&block[1], nonce, ccm_param->nonce_len);
+	for (n = 0; n < l; n++) {
+		block[15 - n] = len >> (8 * n);
+	}
+
+	ecb_encrypt(block, mac);
+
+	if (aead_op->ad_len) {
+		(void)memset(block, 0, sizeof(block));
+		block[0] = aead_op->ad_len >> 8;
+		block[1] = aead_op->ad_len;
+		ofs = 2;
+
+		for (size_t i = 0; i < aead_op->ad_len; i += n) {
+			n = MIN(aead_op->ad_len - i, ECB_BLOCK_SIZE - ofs);
+			memcpy(&block[ofs], &aead_op->ad[i], n);
+			xor_block(mac, block, ofs + n);
+			ecb_encrypt(mac, mac);
+			ofs = 0;
+			(void)memset(block, 0, sizeof(block));
+		}
+	}
+
+	for (size_t i = 0; i < len; i += ECB_BLOCK_SIZE) {
+		xor_block(mac, &text[i], MIN(len - i, ECB_BLOCK_SIZE));
+		ecb_encrypt(mac, mac);
+	}
+}
+
+/* Counter mode encryption, block 0 encrypts the MAC */
+static void ccm_ctr(struct cipher_ctx *ctx, const u8_t *nonce,
+		    const u8_t *in, u8_t *out, size_t len, u8_t *mac)
+{
+	struct ccm_params *ccm_param = &ctx->mode_params.ccm_info;
+	u8_t l = 15U - ccm_param->nonce_len;
+	u8_t ctr[ECB_BLOCK_SIZE];
+	u8_t stream[ECB_BLOCK_SIZE];
+	u32_t count = 0U;
+	size_t n;
+
+	(void)memset(ctr, 0, sizeof(ctr));
+	ctr[0] = l - 1U;
+	memcpy(&ctr[1], nonce, ccm_param->nonce_len);
+
+	ecb_encrypt(ctr, stream);
+	xor_block(mac, stream, ccm_param->tag_len);
+
+	for (size_t i = 0; i < len; i += n) {
+		count++;
+		for (size_t b = 0; b < MIN(l, sizeof(count)); b++) {
+			ctr[15 - b] = count >> (8 * b);
+		}
+
+		ecb_encrypt(ctr, stream);
+
+		n = MIN(len - i, ECB_BLOCK_SIZE);
+		memmove(&out[i], &in[i], n);
+		xor_block(&out[i], stream, n);
+	}
+}
+
+static int ccm_check(struct cipher_ctx *ctx, struct cipher_aead_pkt *aead_op)
+{
+	struct ccm_params *ccm_param = &ctx->mode_params.ccm_info;
+	struct cipher_pkt *op = aead_op->pkt;
+
+	if (op->out_buf_max < op->in_len + ccm_param->tag_len) {
+		LOG_ERR("Output buffer too small");
+		return -EINVAL;
+	}
+
+	if (aead_op->ad_len >= 0xff00) {
+		LOG_ERR("Header too long");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int do_ccm_encrypt_mac(struct cipher_ctx *ctx,
+			      struct cipher_aead_pkt *aead_op, u8_t *nonce)
+{
+	struct ccm_params *ccm_param = &ctx->mode_params.ccm_info;
+	struct cipher_pkt *op = aead_op->pkt;
+	u8_t mac[ECB_BLOCK_SIZE];
+	int err;
+
+	err = ccm_check(ctx, aead_op);
+	if (err) {
+		return err;
+	}
+
+	ecb_begin(ctx);
+	ccm_mac(ctx, aead_op, nonce, op->in_buf, mac);
+	ccm_ctr(ctx, nonce, op->in_buf, op->out_buf, op->in_len, mac);
+	ecb_end();
+
+	/* Same layout as the TinyCrypt shim, the MAC follows the data */
+	memcpy(op->out_buf + op->in_len, mac, ccm_param->tag_len);
+	if (aead_op->tag) {
+		memcpy(aead_op->tag, mac, ccm_param->tag_len);
+	}
+
+	op->out_len = op->in_len + ccm_param->tag_len;
+
+	return 0;
+}
+
+static int do_ccm_decrypt_auth(struct cipher_ctx *ctx,
+			       struct cipher_aead_pkt *aead_op, u8_t *nonce)
+{
+	struct ccm_params *ccm_param = &ctx->mode_params.ccm_info;
+	struct cipher_pkt *op = aead_op->pkt;
+	u8_t mac[ECB_BLOCK_SIZE];
+	u8_t mask[ECB_BLOCK_SIZE];
+	u8_t diff = 0U;
+	int err;
+
+	err = ccm_check(ctx, aead_op);
+	if (err) {
+		return err;
+	}
+
+	if (!aead_op->tag) {
+		LOG_ERR("No MAC to verify");
+		return -EINVAL;
+	}
+
+	/* The MAC covers the plain text, decrypt first. */
+	(void)memset(mask, 0, sizeof(mask));
+	ecb_begin(ctx);
+	ccm_ctr(ctx, nonce, op->in_buf, op->out_buf, op->in_len, mask);
+	ccm_mac(ctx, aead_op, nonce, op->out_buf, mac);
+	ecb_end();
+
+	for (size_t i = 0; i < ccm_param->tag_len; i++) {
+		diff |= mac[i] ^ mask[i] ^ aead_op->tag[i];
+	}
+
+	if (diff) {
+		LOG_DBG("MAC mismatch");
+		(void)memset(op->out_buf, 0, op->in_len);
+		return -EIO;
+	}
+
+	/* Same as the TinyCrypt shim */
+	op->out_len = op->in_len + ccm_param->tag_len;
+
+	return 0;
+}
+
+static int nrf_ecb_session_setup(struct device *dev, struct cipher_ctx *ctx,
+				 enum cipher_algo algo, enum cipher_mode mode,
+				 enum cipher_op op_type)
+{
+	struct ccm_params *ccm_param = &ctx->mode_params.ccm_info;
+	int idx;
+
+	ARG_UNUSED(dev);
+
+	if (algo != CRYPTO_CIPHER_ALGO_AES) {
+		LOG_ERR("Unsupported algo");
+		return -EINVAL;
+	}
+
+	/* The peripheral is much faster than an interrupt round trip. */
+	if (!(ctx->flags & CAP_SYNC_OPS)) {
+		LOG_ERR("Async not supported by this driver");
+		return -EINVAL;
+	}
+
+	if (ctx->keylen != ECB_BLOCK_SIZE) {
+		LOG_ERR("Unsupported key size");
+		return -EINVAL;
+	}
+
+	switch (mode) {
+	case CRYPTO_CIPHER_MODE_ECB:
+		/* The peripheral has no inverse cipher */
+		if (op_type != CRYPTO_CIPHER_OP_ENCRYPT) {
+			LOG_ERR("ECB decryption not supported");
+			return -EINVAL;
+		}
+		ctx->ops.block_crypt_hndlr = do_ecb_encrypt;
+		break;
+	case CRYPTO_CIPHER_MODE_CCM:
+		if (ccm_param->nonce_len < 7U || ccm_param->nonce_len > 13U ||
+		    ccm_param->tag_len < 4U || ccm_param->tag_len > 16U ||
+		    (ccm_param->tag_len & 1U)) {
+			LOG_ERR("Unsupported CCM parameters");
+			return -EINVAL;
+		}
+
+		if (op_type == CRYPTO_CIPHER_OP_ENCRYPT) {
+			ctx->ops.ccm_crypt_hndlr = do_ccm_encrypt_mac;
+		} else {
+			ctx->ops.ccm_crypt_hndlr = do_ccm_decrypt_auth;
+		}
+		break;
+	default:
+		LOG_ERR("Unsupported mode");
+		return -EINVAL;
+	}
+
+	ctx->ops.cipher_mode = mode;
+
+	for (idx = 0; idx < CRYPTO_MAX_SESSION; idx++) {
+		if (!nrf_ecb_state[idx].in_use) {
+			break;
+		}
+	}
+
+	if (idx == CRYPTO_MAX_SESSION) {
+		LOG_ERR("Max sessions in progress");
+		return -ENOSPC;
+	}
+
+	nrf_ecb_state[idx].in_use = true;
+	memcpy(nrf_ecb_state[idx].key, ctx->key.bit_stream, ECB_BLOCK_SIZE);
+	ctx->drv_sessn_state = &nrf_ecb_state[idx];
+
+	return 0;
+}
+
+static int nrf_ecb_query_caps(struct device *dev)
+{
+	return (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS);
+}
+
+static int nrf_ecb_session_free(struct device *dev, struct cipher_ctx *sessn)
+{
+	struct nrf_ecb_drv_state *data = sessn->drv_sessn_state;
+
+	ARG_UNUSED(dev);
+	(void)memset(data, 0, sizeof(struct nrf_ecb_drv_state));
+
+	return 0;
+}
+
+static int nrf_ecb_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static struct crypto_driver_api crypto_enc_funcs = {
+	.begin_session = nrf_ecb_session_setup,
+	.free_session = nrf_ecb_session_free,
+	.crypto_async_callback_set = NULL,
+	.query_hw_caps = nrf_ecb_query_caps,
+};
+
+DEVICE_AND_API_INIT(crypto_nrf_ecb, CONFIG_CRYPTO_NRF_ECB_DRV_NAME,
+		    &nrf_ecb_init, NULL, NULL,
+		    POST_KERNEL, CONFIG_CRYPTO_INIT_PRIORITY,
+		    (void *)&crypto_enc_funcs);
@@ -238,8 +238,14 @@ int ssd1306_write(const struct device *dev, const u16_t x, const u16_t y,
 		return -1;
 	}
 
-	if (x != 0U && y != 0U) {
-		LOG_ERR("Unsupported origin");
+	if ((y % 8U) != 0U || (desc->height % 8U) != 0U) {
+		LOG_ERR("Rows not aligned to pages");
+		return -1;
+	}
+
+	if ((y + desc->height) / 8U > SSD1306_PANEL_NUMOF_PAGES ||
+	    (x + desc->width) > SSD1306_PANEL_NUMOF_COLUMS) {
+		LOG_ERR("Buffer out of bounds");
 		return -1;
 	}
 
@@ -254,15 +260,15 @@ int ssd1306_write(const struct device *dev, const u16_t x, const u16_t y,
 		SSD1306_CONTROL_BYTE_CMD,
 		SSD1306_SET_COLUMN_ADDRESS,
 		SSD1306_CONTROL_BYTE_CMD,
-		0,
+		x,
 		SSD1306_CONTROL_BYTE_CMD,
-		(SSD1306_PANEL_NUMOF_COLUMS - 1),
+		(x + desc->width - 1),
 		SSD1306_CONTROL_BYTE_CMD,
 		SSD1306_SET_PAGE_ADDRESS,
 		SSD1306_CONTROL_BYTE_CMD,
-		0,
+		y / 8U,
 		SSD1306_CONTROL_LAST_BYTE_CMD,
-		(SSD1306_PANEL_NUMOF_PAGES - 1)
+		((y + desc->height) / 8U - 1)
 	};
 
 	if (i2c_write(driver->i2c, cmd_buf, sizeof(cmd_buf),
@@ -276,12 +282,14 @@ int ssd1306_write(const struct device *dev, const u16_t x, const u16_t y,
 			       (u8_t *)buf, desc->buf_size);
 
 #elif defined(CONFIG_SSD1306_SH1106_COMPATIBLE)
-	if (desc->buf_size !=
-	    (SSD1306_PANEL_NUMOF_PAGES * DT_INST_0_SOLOMON_SSD1306FB_WIDTH)) {
+	/* Pages are always written from the first column */
+	if (x != 0U || desc->width != DT_INST_0_SOLOMON_SSD1306FB_WIDTH ||
+	    desc->buf_size !=
+	    (desc->height / 8U * DT_INST_0_SOLOMON_SSD1306FB_WIDTH)) {
 		return -1;
 	}
 
-	for (size_t pidx = 0; pidx < SSD1306_PANEL_NUMOF_PAGES; pidx++) {
+	for (size_t pidx = y / 8U; pidx < (y + desc->height) / 8U; pidx++) {
 		if (ssd1306_write_page(dev, pidx, buf,
 		    DT_INST_0_SOLOMON_SSD1306FB_WIDTH)) {
 			return -1;
@@ -552,6 +552,23 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 		return -1;
 	}
 
+#if defined(CONFIG_PTP_CLOCK_MCUX)
+	/* The descriptor timestamp is only captured for PTP event frames,
+	 * other frames the application wants timestamped get the 1588 timer
+	 * value at the time they were handed to the controller.
+	 */
+	if (!timestamped_frame && net_pkt_is_tx_timestamping(pkt)) {
+		enet_ptp_time_t enet_time;
+
+		ENET_Ptp1588GetTimer(ENET, &context->enet_handle, &enet_time);
+
+		pkt->timestamp.second = enet_time.second;
+		pkt->timestamp.nanosecond = enet_time.nanosecond;
+
+		net_if_add_tx_timestamp(pkt);
+	}
+#endif
+
 	k_sem_take(&context->tx_buf_sem, K_FOREVER);
 
 	return 0;
@@ -640,10 +657,19 @@ static void eth_rx(struct device *iface)
 #endif
 
 #if defined(CONFIG_PTP_CLOCK_MCUX)
-	if (eth_get_ptp_data(get_iface(context, vlan_tag), pkt,
-			     &ptpTimeData, false) &&
-	    (ENET_GetRxFrameTime(&context->enet_handle,
-				 &ptpTimeData) == kStatus_Success)) {
+	if (!eth_get_ptp_data(get_iface(context, vlan_tag), pkt,
+			      &ptpTimeData, false)) {
+		enet_ptp_time_t enet_time;
+
+		/* Not a PTP event frame, so there is no descriptor
+		 * timestamp; use the 1588 timer value at reception.
+		 */
+		ENET_Ptp1588GetTimer(ENET, &context->enet_handle, &enet_time);
+
+		pkt->timestamp.nanosecond = enet_time.nanosecond;
+		pkt->timestamp.second = enet_time.second;
+	} else if (ENET_GetRxFrameTime(&context->enet_handle,
+				       &ptpTimeData) == kStatus_Success) {
 		pkt->timestamp.nanosecond = ptpTimeData.timeStamp.nanosecond;
 		pkt->timestamp.second = ptpTimeData.timeStamp.second;
 	} else {
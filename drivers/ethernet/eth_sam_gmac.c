@@ -30,6 +30,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <sys/util.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <net/net_pkt.h>
 #include <net/net_if.h>
 #include <net/ethernet.h>
@@ -525,7 +526,8 @@ static void tx_completed(Gmac *gmac, struct gmac_queue *queue)
 
 			timestamp_tx_pkt(gmac, hdr, pkt);
 
-			if (hdr && need_timestamping(hdr)) {
+			if ((hdr && need_timestamping(hdr)) ||
+			    net_pkt_is_tx_timestamping(pkt)) {
 				net_if_add_tx_timestamp(pkt);
 			}
 			net_pkt_unref(pkt);
@@ -1198,13 +1200,15 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 	return rx_frame;
 }
 
-static void eth_rx(struct gmac_queue *queue)
+/* Receive at most budget frames, return the number of frames received */
+static int eth_rx(struct gmac_queue *queue, int budget)
 {
 	struct eth_sam_dev_data *dev_data =
 		CONTAINER_OF(queue, struct eth_sam_dev_data,
 			     queue_list[queue->que_idx]);
 	u16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
 	struct net_pkt *rx_frame;
+	int count = 0;
 #if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
 	struct device *const dev = net_if_get_device(dev_data->iface);
 	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
@@ -1215,8 +1219,13 @@ static void eth_rx(struct gmac_queue *queue)
 	/* More than one frame could have been received by GMAC, get all
 	 * complete frames stored in the GMAC RX descriptor list.
 	 */
-	rx_frame = frame_get(queue);
-	while (rx_frame) {
+	while (count < budget) {
+		rx_frame = frame_get(queue);
+		if (!rx_frame) {
+			break;
+		}
+
+		count++;
 		LOG_DBG("ETH rx");
 
 #if defined(CONFIG_NET_VLAN)
@@ -1258,17 +1267,88 @@ static void eth_rx(struct gmac_queue *queue)
 		}
 #endif /* CONFIG_PTP_CLOCK_SAM_GMAC */
 
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POLL)
+		net_eth_rx_poll_recv(&queue->rx_poll,
+				     get_iface(dev_data, vlan_tag), rx_frame);
+#else
 		if (net_recv_data(get_iface(dev_data, vlan_tag),
 				  rx_frame) < 0) {
 			eth_stats_update_errors_rx(get_iface(dev_data,
 							     vlan_tag));
 			net_pkt_unref(rx_frame);
 		}
+#endif
+	}
 
-		rx_frame = frame_get(queue);
+	return count;
+}
+
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POLL)
+static Gmac *queue_regs(struct gmac_queue *queue)
+{
+	struct eth_sam_dev_data *dev_data =
+		CONTAINER_OF(queue, struct eth_sam_dev_data,
+			     queue_list[queue->que_idx]);
+
+	return DEV_CFG(net_if_get_device(dev_data->iface))->regs;
+}
+
+static void rx_irq_enable(Gmac *gmac, struct gmac_queue *queue, bool enable)
+{
+	if (queue->que_idx == 0) {
+		if (enable) {
+			gmac->GMAC_IER = GMAC_INT_RX_BITS;
+		} else {
+			gmac->GMAC_IDR = GMAC_INT_RX_BITS;
+		}
+
+		return;
+	}
+
+#if GMAC_PRIORITY_QUEUE_NO >= 1
+	if (enable) {
+		gmac->GMAC_IERPQ[queue->que_idx - 1] = GMAC_INTPQ_RX_BITS;
+	} else {
+		gmac->GMAC_IDRPQ[queue->que_idx - 1] = GMAC_INTPQ_RX_BITS;
+	}
+#endif
+}
+
+static int eth_rx_poll(struct net_eth_rx_poll *rx_poll, int budget)
+{
+	struct gmac_queue *queue =
+		CONTAINER_OF(rx_poll, struct gmac_queue, rx_poll);
+
+	/* The frames still in the descriptors are abandoned */
+	if (atomic_clear(&queue->rx_error)) {
+		rx_error_handler(queue_regs(queue), queue);
 	}
+
+	return eth_rx(queue, budget);
 }
 
+static bool eth_rx_poll_irq_enable(struct net_eth_rx_poll *rx_poll)
+{
+	struct gmac_queue *queue =
+		CONTAINER_OF(rx_poll, struct gmac_queue, rx_poll);
+	struct gmac_desc_list *rx_desc_list = &queue->rx_desc_list;
+	Gmac *gmac = queue_regs(queue);
+
+	rx_irq_enable(gmac, queue, true);
+
+	/* The status of a frame received since the last poll may have been
+	 * cleared by a TX interrupt reading the status register, look at
+	 * the descriptors instead.
+	 */
+	if (rx_desc_list->buf[rx_desc_list->tail].w0 & GMAC_RXW0_OWNERSHIP) {
+		rx_irq_enable(gmac, queue, false);
+		return true;
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_L2_ETHERNET_RX_POLL */
+
 #if !defined(CONFIG_ETH_SAM_GMAC_FORCE_QUEUE) && \
 	((CONFIG_ETH_SAM_GMAC_QUEUES != NET_TC_TX_COUNT) || \
 	((NET_TC_TX_COUNT != NET_TC_RX_COUNT) && defined(CONFIG_NET_VLAN)))
@@ -1462,7 +1542,8 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 #endif
 	hdr = check_gptp_msg(get_iface(dev_data, vlan_tag), pkt, true);
 	timestamp_tx_pkt(gmac, hdr, pkt);
-	if (hdr && need_timestamping(hdr)) {
+	if ((hdr && need_timestamping(hdr)) ||
+	    net_pkt_is_tx_timestamping(pkt)) {
 		net_if_add_tx_timestamp(pkt);
 	}
 #endif
@@ -1492,6 +1573,19 @@ static void queue0_isr(void *arg)
 	tx_desc_list = &queue->tx_desc_list;
 
 	/* RX packet */
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POLL)
+	if (isr & (GMAC_INT_RX_ERR_BITS | GMAC_ISR_RCOMP)) {
+		if (isr & GMAC_INT_RX_ERR_BITS) {
+			atomic_set(&queue->rx_error, 1);
+		}
+
+		/* Receive from the poll thread until no frame is left */
+		gmac->GMAC_IDR = GMAC_INT_RX_BITS;
+		net_eth_rx_poll_schedule(&queue->rx_poll);
+	}
+
+	ARG_UNUSED(rx_desc_list);
+#else
 	if (isr & GMAC_INT_RX_ERR_BITS) {
 		rx_error_handler(gmac, queue);
 	} else if (isr & GMAC_ISR_RCOMP) {
@@ -1499,8 +1593,9 @@ static void queue0_isr(void *arg)
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
-		eth_rx(queue);
+		eth_rx(queue, INT_MAX);
 	}
+#endif
 
 	/* TX packet */
 	if (isr & GMAC_INT_TX_ERR_BITS) {
@@ -1542,6 +1637,19 @@ static inline void priority_queue_isr(void *arg, unsigned int queue_idx)
 	tx_desc_list = &queue->tx_desc_list;
 
 	/* RX packet */
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POLL)
+	if (isrpq & (GMAC_INTPQ_RX_ERR_BITS | GMAC_ISRPQ_RCOMP)) {
+		if (isrpq & GMAC_INTPQ_RX_ERR_BITS) {
+			atomic_set(&queue->rx_error, 1);
+		}
+
+		/* Receive from the poll thread until no frame is left */
+		gmac->GMAC_IDRPQ[queue_idx - 1] = GMAC_INTPQ_RX_BITS;
+		net_eth_rx_poll_schedule(&queue->rx_poll);
+	}
+
+	ARG_UNUSED(rx_desc_list);
+#else
 	if (isrpq & GMAC_INTPQ_RX_ERR_BITS) {
 		rx_error_handler(gmac, queue);
 	} else if (isrpq & GMAC_ISRPQ_RCOMP) {
@@ -1549,8 +1657,9 @@ static inline void priority_queue_isr(void *arg, unsigned int queue_idx)
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
-		eth_rx(queue);
+		eth_rx(queue, INT_MAX);
 	}
+#endif
 
 	/* TX packet */
 	if (isrpq & GMAC_INTPQ_TX_ERR_BITS) {
@@ -1700,6 +1809,10 @@ static void eth0_iface_init(struct net_if *iface)
 
 	/* Initialize GMAC queues */
 	for (i = 0; i < GMAC_QUEUE_NO; i++) {
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POLL)
+		net_eth_rx_poll_init(&dev_data->queue_list[i].rx_poll,
+				     eth_rx_poll, eth_rx_poll_irq_enable);
+#endif
 		result = queue_init(cfg->regs, &dev_data->queue_list[i]);
 		if (result < 0) {
 			LOG_ERR("Unable to initialize ETH queue%d", i);
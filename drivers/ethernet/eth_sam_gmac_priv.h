@@ -138,6 +138,12 @@
 		(GMAC_IERPQ_RCOMP | GMAC_INTPQ_RX_ERR_BITS | \
 		 GMAC_IERPQ_TCOMP | GMAC_INTPQ_TX_ERR_BITS | GMAC_IERPQ_HRESP)
 
+/* RX interrupts, disabled while the RX queue is polled */
+#define GMAC_INT_RX_BITS \
+		(GMAC_IER_RCOMP | GMAC_INT_RX_ERR_BITS)
+#define GMAC_INTPQ_RX_BITS \
+		(GMAC_IERPQ_RCOMP | GMAC_INTPQ_RX_ERR_BITS)
+
 /** List of GMAC queues */
 enum queue_idx {
 	GMAC_QUE_0,  /** Main queue */
@@ -193,6 +199,12 @@ struct gmac_queue {
 	/** Number of times transmit queue was flushed */
 	volatile u32_t err_tx_flushed_count;
 
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POLL)
+	struct net_eth_rx_poll rx_poll;
+	/** RX error reported by the interrupt, handled by the poll */
+	atomic_t rx_error;
+#endif
+
 	enum queue_idx que_idx;
 };
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <kernel.h>
+#include <init.h>
+#include <drivers/flash.h>
+
+enum {
+	FLASH_ASYNC_READ,
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+
+static K_THREAD_STACK_DEFINE(flash_async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q flash_async_work_q;
+
+static void flash_async_handler(struct k_work *work)
+{
+	struct flash_async_req *req = CONTAINER_OF(work, struct flash_async_req,
+						   work);
+	int rc;
+
+	switch (req->op) {
+	case FLASH_ASYNC_READ:
+		rc = flash_read(req->dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_WRITE:
+		rc = flash_write(req->dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_ERASE:
+		rc = flash_erase(req->dev, req->offset, req->len);
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	/* The request can be reused from here on */
+	if (req->signal) {
+		k_poll_signal_raise(req->signal, rc);
+	}
+
+	if (req->cb) {
+		req->cb(req, rc);
+	}
+}
+
+static int flash_async_submit(struct device *dev, u8_t op, off_t offset,
+			      void *data, size_t len,
+			      struct flash_async_req *req)
+{
+	if (k_work_pending(&req->work)) {
+		return -EBUSY;
+	}
+
+	k_work_init(&req->work, flash_async_handler);
+	req->dev = dev;
+	req->op = op;
+	req->offset = offset;
+	req->data = data;
+	req->len = len;
+
+	k_work_submit_to_queue(&flash_async_work_q, &req->work);
+
+	return 0;
+}
+
+int flash_read_async(struct device *dev, off_t offset, void *data,
+		     size_t len, struct flash_async_req *req)
+{
+	return flash_async_submit(dev, FLASH_ASYNC_READ, offset, data, len,
+				  req);
+}
+
+int flash_write_async(struct device *dev, off_t offset, const void *data,
+		      size_t len, struct flash_async_req *req)
+{
+	return flash_async_submit(dev, FLASH_ASYNC_WRITE, offset, (void *)data,
+				  len, req);
+}
+
+int flash_erase_async(struct device *dev, off_t offset, size_t size,
+		      struct flash_async_req *req)
+{
+	return flash_async_submit(dev, FLASH_ASYNC_ERASE, offset, NULL, size,
+				  req);
+}
+
+static int flash_async_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&flash_async_work_q, flash_async_stack,
+		       K_THREAD_STACK_SIZEOF(flash_async_stack),
+		       CONFIG_FLASH_ASYNC_THREAD_PRIO);
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -20,6 +20,21 @@
 
 static u8_t test_arr[TEST_ARR_SIZE];
 
+/* The device is looked up once rather than on every command */
+static struct device *flash_device_get(const struct shell *shell)
+{
+	static struct device *flash_dev;
+
+	if (!flash_dev) {
+		flash_dev = device_get_binding(DT_FLASH_DEV_NAME);
+		if (!flash_dev) {
+			shell_error(shell, "Flash driver was not found!");
+		}
+	}
+
+	return flash_dev;
+}
+
 static int cmd_erase(const struct shell *shell, size_t argc, char *argv[])
 {
 	struct device *flash_dev;
@@ -27,9 +42,8 @@ static int cmd_erase(const struct shell *shell, size_t argc, char *argv[])
 	int result;
 	u32_t size;
 
-	flash_dev = device_get_binding(DT_FLASH_DEV_NAME);
+	flash_dev = flash_device_get(shell);
 	if (!flash_dev) {
-		shell_error(shell, "Flash driver was not found!");
 		return -ENODEV;
 	}
 
@@ -78,9 +92,8 @@ static int cmd_write(const struct shell *shell, size_t argc, char *argv[])
 	u32_t w_addr;
 	int j = 0;
 
-	flash_dev = device_get_binding(DT_FLASH_DEV_NAME);
+	flash_dev = flash_device_get(shell);
 	if (!flash_dev) {
-		shell_error(shell, "Flash driver was not found!");
 		return -ENODEV;
 	}
 
@@ -130,9 +143,8 @@ static int cmd_read(const struct shell *shell, size_t argc, char *argv[])
 	u32_t addr;
 	int cnt;
 
-	flash_dev = device_get_binding(DT_FLASH_DEV_NAME);
+	flash_dev = flash_device_get(shell);
 	if (!flash_dev) {
-		shell_error(shell, "Flash driver was not found!");
 		return -ENODEV;
 	}
 
@@ -170,9 +182,8 @@ static int cmd_test(const struct shell *shell, size_t argc, char *argv[])
 	u32_t addr;
 	u32_t size;
 
-	flash_dev = device_get_binding(DT_FLASH_DEV_NAME);
+	flash_dev = flash_device_get(shell);
 	if (!flash_dev) {
-		shell_error(shell, "Flash driver was not found!");
 		return -ENODEV;
 	}
 
@@ -7,6 +7,7 @@
  */
 
 #include <errno.h>
+#include <sys/byteorder.h>
 #include <drivers/flash.h>
 #include <drivers/spi.h>
 #include <init.h>
@@ -26,6 +27,8 @@ LOG_MODULE_REGISTER(spi_nor, CONFIG_FLASH_LOG_LEVEL);
  * @spi_cfg: The SPI configuration
  * @cs_ctrl: The GPIO pin used to emulate the SPI CS if required
  * @sem: The semaphore to access to the flash
+ * @addr_len: The number of address bytes sent with a command
+ * @has_be32k: Support for the 32 KiB block erase
  */
 struct spi_nor_data {
 	struct device *spi;
@@ -34,6 +37,8 @@ struct spi_nor_data {
 	struct spi_cs_control cs_ctrl;
 #endif /* DT_INST_0_JEDEC_SPI_NOR_CS_GPIOS_CONTROLLER */
 	struct k_sem sem;
+	u8_t addr_len;
+	bool has_be32k;
 };
 
 #if defined(CONFIG_MULTITHREADING)
@@ -64,18 +69,28 @@ static int spi_nor_access(const struct device *const dev,
 			  void *data, size_t length, bool is_write)
 {
 	struct spi_nor_data *const driver_data = dev->driver_data;
+	u8_t buf[1 + SPI_NOR_MAX_ADDR_WIDTH + 1] = { opcode };
+	size_t buf_len = 1;
 
-	u8_t buf[4] = {
-		opcode,
-		(addr & 0xFF0000) >> 16,
-		(addr & 0xFF00) >> 8,
-		(addr & 0xFF),
-	};
+	if (is_addressed) {
+		u8_t addr_buf[4];
+
+		sys_put_be32((u32_t)addr, addr_buf);
+		memcpy(&buf[1], &addr_buf[4 - driver_data->addr_len],
+		       driver_data->addr_len);
+		buf_len += driver_data->addr_len;
+
+		/* These reads clock out a dummy byte after the address */
+		if ((opcode == SPI_NOR_CMD_FAST_READ) ||
+		    (opcode == SPI_NOR_CMD_RDSFDP)) {
+			buf_len++;
+		}
+	}
 
 	struct spi_buf spi_buf[2] = {
 		{
 			.buf = buf,
-			.len = (is_addressed) ? 4 : 1,
+			.len = buf_len,
 		},
 		{
 			.buf = data,
@@ -152,6 +167,32 @@ static int spi_nor_wait_until_ready(struct device *dev)
 	return ret;
 }
 
+/**
+ * @brief Wait until the flash is ready, sleeping between the polls
+ *
+ * Erasing takes milliseconds, polling the status register all that
+ * time would keep the CPU and the SPI bus busy.
+ *
+ * @param dev The device structure
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_wait_until_ready_sleep(struct device *dev)
+{
+	int ret;
+	u8_t reg;
+
+	while (true) {
+		ret = spi_nor_cmd_read(dev, SPI_NOR_CMD_RDSR, &reg, 1);
+		if (ret || !(reg & SPI_NOR_WIP_BIT)) {
+			return ret;
+		}
+
+#if defined(CONFIG_MULTITHREADING)
+		k_sleep(K_MSEC(1));
+#endif
+	}
+}
+
 static int spi_nor_read(struct device *dev, off_t addr, void *dest,
 			size_t size)
 {
@@ -168,7 +209,8 @@ static int spi_nor_read(struct device *dev, off_t addr, void *dest,
 
 	spi_nor_wait_until_ready(dev);
 
-	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
+	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_FAST_READ, addr, dest,
+				    size);
 
 	SYNC_UNLOCK();
 	return ret;
@@ -248,7 +290,8 @@ static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 			NULL, 0);
 			addr += SPI_NOR_BLOCK_SIZE;
 			size -= SPI_NOR_BLOCK_SIZE;
-		} else if ((size >= SPI_NOR_BLOCK32_SIZE)
+		} else if (driver_data->has_be32k
+			   && (size >= SPI_NOR_BLOCK32_SIZE)
 			   && SPI_NOR_IS_BLOCK32_ALIGNED(addr)) {
 			/* 32 KiB block erase */
 			spi_nor_cmd_addr_write(dev, SPI_NOR_CMD_BE_32K, addr,
@@ -270,7 +313,7 @@ static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 			return -EINVAL;
 		}
 
-		spi_nor_wait_until_ready(dev);
+		spi_nor_wait_until_ready_sleep(dev);
 	}
 
 	SYNC_UNLOCK();
@@ -295,6 +338,109 @@ static int spi_nor_write_protection_set(struct device *dev, bool write_protect)
 	return ret;
 }
 
+#if defined(CONFIG_SPI_NOR_SFDP)
+/**
+ * @brief Read the flash characteristics from its SFDP tables
+ *
+ * The basic flash parameter table tells the density, the supported
+ * address modes and the erase sizes of the flash.
+ *
+ * @param dev The device structure
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_sfdp_probe(struct device *dev)
+{
+	struct spi_nor_data *const data = dev->driver_data;
+	const struct spi_nor_config *params = dev->config->config_info;
+	u8_t hdr[SPI_NOR_SFDP_HDR_SIZE];
+	u32_t bfpt[SPI_NOR_SFDP_BFPT_DWORDS] = { 0 };
+	u32_t bfpt_off = 0U;
+	u32_t bfpt_len = 0U;
+	u64_t density;
+	unsigned int nph;
+	unsigned int i;
+	int ret;
+
+	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_RDSFDP, 0, hdr,
+				    sizeof(hdr));
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (sys_get_le32(hdr) != SPI_NOR_SFDP_SIGNATURE) {
+		return -ENOTSUP;
+	}
+
+	/* Find the newest basic flash parameter table */
+	nph = hdr[6] + 1U;
+	for (i = 0U; i < nph; i++) {
+		ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_RDSFDP,
+					    SPI_NOR_SFDP_HDR_SIZE * (i + 1U),
+					    hdr, sizeof(hdr));
+		if (ret != 0) {
+			return ret;
+		}
+
+		if ((hdr[0] == SPI_NOR_SFDP_BFPT_ID) && (hdr[7] == 0xFF)) {
+			bfpt_len = MIN(hdr[3], SPI_NOR_SFDP_BFPT_DWORDS);
+			bfpt_off = sys_get_le32(&hdr[4]) & 0xFFFFFF;
+		}
+	}
+
+	if (bfpt_len < 2U) {
+		return -ENOTSUP;
+	}
+
+	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_RDSFDP, bfpt_off, bfpt,
+				    bfpt_len * sizeof(u32_t));
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (i = 0U; i < bfpt_len; i++) {
+		bfpt[i] = sys_le32_to_cpu(bfpt[i]);
+	}
+
+	/* Density is given in bits */
+	if (bfpt[1] & BIT(31)) {
+		density = 1ULL << (bfpt[1] & 0x7FFFFFFF);
+	} else {
+		density = (u64_t)bfpt[1] + 1U;
+	}
+
+	if ((density / 8U) != params->size) {
+		LOG_WRN("SFDP size %u differs from devicetree size %u",
+			(u32_t)(density / 8U), params->size);
+	}
+
+	if ((params->size > SPI_NOR_3B_ADDR_MAX_SIZE) &&
+	    ((bfpt[0] & SPI_NOR_SFDP_ADDR_MASK) == SPI_NOR_SFDP_ADDR_3B)) {
+		LOG_ERR("flash doesn't support 4-byte addresses");
+		return -ENOTSUP;
+	}
+
+	/* Erase types 1 to 4, size as a power of 2 and opcode */
+	if (bfpt_len >= 9U) {
+		data->has_be32k = false;
+
+		for (i = 0U; i < 4U; i++) {
+			u16_t type = bfpt[7 + i / 2U] >> (16U * (i % 2U));
+
+			if (((type & 0xFF) == 15U) &&
+			    ((type >> 8) == SPI_NOR_CMD_BE_32K)) {
+				data->has_be32k = true;
+			}
+		}
+	}
+
+	LOG_DBG("SFDP: %u bytes, address mode %u, BE32K %d",
+		(u32_t)(density / 8U), (bfpt[0] >> 17) & 0x3,
+		data->has_be32k);
+
+	return 0;
+}
+#endif /* CONFIG_SPI_NOR_SFDP */
+
 /**
  * @brief Configure the flash
  *
@@ -329,11 +475,31 @@ static int spi_nor_configure(struct device *dev)
 	data->spi_cfg.cs = &data->cs_ctrl;
 #endif /* DT_INST_0_JEDEC_SPI_NOR_CS_GPIOS_CONTROLLER */
 
+	data->addr_len = 3;
+	data->has_be32k = params->has_be32k;
+
 	/* now the spi bus is configured, we can verify the flash id */
 	if (spi_nor_read_id(dev, params) != 0) {
 		return -ENODEV;
 	}
 
+#if defined(CONFIG_SPI_NOR_SFDP)
+	if (spi_nor_sfdp_probe(dev) != 0) {
+		LOG_WRN("no usable SFDP, using devicetree parameters");
+		data->has_be32k = params->has_be32k;
+	}
+#endif
+
+	/* The top of larger flashes can only be reached with 4-byte
+	 * addresses.
+	 */
+	if (params->size > SPI_NOR_3B_ADDR_MAX_SIZE) {
+		if (spi_nor_cmd_write(dev, SPI_NOR_CMD_EN4B) != 0) {
+			return -ENODEV;
+		}
+
+		data->addr_len = 4;
+	}
 
 	return 0;
 }
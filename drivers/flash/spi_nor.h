@@ -38,6 +38,24 @@ struct spi_nor_config {
 #define SPI_NOR_CMD_BE          0xD8    /* Block erase */
 #define SPI_NOR_CMD_CE          0xC7    /* Chip erase */
 #define SPI_NOR_CMD_RDID        0x9F    /* Read JEDEC ID */
+#define SPI_NOR_CMD_FAST_READ   0x0B    /* Read data at higher speed */
+#define SPI_NOR_CMD_RDSFDP      0x5A    /* Read SFDP parameters */
+#define SPI_NOR_CMD_EN4B        0xB7    /* Enter 4-byte address mode */
+
+/* SFDP header and basic flash parameter table (JESD216) */
+#define SPI_NOR_SFDP_SIGNATURE  0x50444653U     /* "SFDP" */
+#define SPI_NOR_SFDP_HDR_SIZE   8U
+#define SPI_NOR_SFDP_BFPT_ID    0x00U
+#define SPI_NOR_SFDP_BFPT_DWORDS 9U
+
+/* BFPT DWORD 1: supported address bytes */
+#define SPI_NOR_SFDP_ADDR_MASK  (0x3U << 17)
+#define SPI_NOR_SFDP_ADDR_3B    (0x0U << 17)
+#define SPI_NOR_SFDP_ADDR_3B_4B (0x1U << 17)
+#define SPI_NOR_SFDP_ADDR_4B    (0x2U << 17)
+
+/* Flashes larger than this need 4-byte addresses */
+#define SPI_NOR_3B_ADDR_MAX_SIZE 0x1000000U
 
 /* Page, sector, and block size are standard, not configurable. */
 #define SPI_NOR_PAGE_SIZE    0x0100U
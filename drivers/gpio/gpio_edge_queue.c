@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <drivers/gpio.h>
+
+/* Called from the interrupt handler of the port */
+static void edge_queue_handler(struct device *port, struct gpio_callback *cb,
+			       u32_t pins)
+{
+	struct gpio_edge_queue *queue =
+		CONTAINER_OF(cb, struct gpio_edge_queue, callback);
+	struct gpio_edge_event evt = {
+		.timestamp = k_cycle_get_32(),
+		.pins = pins & cb->pin_mask,
+	};
+
+	if (gpio_read(port, GPIO_ACCESS_BY_PORT, 0, &evt.level) != 0) {
+		evt.level = 0U;
+	}
+
+	if (k_msgq_put(queue->msgq, &evt, K_NO_WAIT) != 0) {
+		queue->dropped++;
+	}
+}
+
+int gpio_edge_queue_add(struct device *port, struct gpio_edge_queue *queue,
+			struct k_msgq *msgq, u32_t pin_mask)
+{
+	__ASSERT(msgq->msg_size == sizeof(struct gpio_edge_event),
+		 "Wrong message size");
+
+	queue->msgq = msgq;
+	queue->dropped = 0U;
+	gpio_init_callback(&queue->callback, edge_queue_handler, pin_mask);
+
+	return gpio_add_callback(port, &queue->callback);
+}
+
+int gpio_edge_queue_remove(struct device *port,
+			   struct gpio_edge_queue *queue)
+{
+	return gpio_remove_callback(port, &queue->callback);
+}
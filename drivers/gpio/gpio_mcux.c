@@ -157,6 +157,47 @@ static int gpio_mcux_write(struct device *dev,
 	return 0;
 }
 
+static int gpio_mcux_port_set_masked(struct device *dev, u32_t mask,
+				     u32_t value)
+{
+	const struct gpio_mcux_config *config = dev->config->config_info;
+	GPIO_Type *gpio_base = config->gpio_base;
+	unsigned int key;
+
+	key = irq_lock();
+	gpio_base->PDOR = (gpio_base->PDOR & ~mask) | (value & mask);
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int gpio_mcux_port_set_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_mcux_config *config = dev->config->config_info;
+
+	config->gpio_base->PSOR = pins;
+
+	return 0;
+}
+
+static int gpio_mcux_port_clear_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_mcux_config *config = dev->config->config_info;
+
+	config->gpio_base->PCOR = pins;
+
+	return 0;
+}
+
+static int gpio_mcux_port_toggle_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_mcux_config *config = dev->config->config_info;
+
+	config->gpio_base->PTOR = pins;
+
+	return 0;
+}
+
 static int gpio_mcux_read(struct device *dev,
 			  int access_op, u32_t pin, u32_t *value)
 {
@@ -234,6 +275,10 @@ static const struct gpio_driver_api gpio_mcux_driver_api = {
 	.manage_callback = gpio_mcux_manage_callback,
 	.enable_callback = gpio_mcux_enable_callback,
 	.disable_callback = gpio_mcux_disable_callback,
+	.port_set_masked = gpio_mcux_port_set_masked,
+	.port_set_bits = gpio_mcux_port_set_bits,
+	.port_clear_bits = gpio_mcux_port_clear_bits,
+	.port_toggle_bits = gpio_mcux_port_toggle_bits,
 };
 
 #ifdef CONFIG_GPIO_MCUX_PORTA
@@ -253,6 +253,57 @@ static int gpio_nrfx_read(struct device *port, int access_op,
 	return 0;
 }
 
+static int gpio_nrfx_port_set_masked(struct device *port, u32_t mask,
+				     u32_t value)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	struct gpio_nrfx_data *data = get_port_data(port);
+	unsigned int key;
+	u32_t out;
+
+	key = irq_lock();
+	out = nrf_gpio_port_out_read(reg);
+	nrf_gpio_port_out_write(reg, (out & ~mask) |
+				     ((value ^ data->inverted) & mask));
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int gpio_nrfx_port_set_bits(struct device *port, u32_t pins)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	struct gpio_nrfx_data *data = get_port_data(port);
+
+	nrf_gpio_port_out_set(reg, pins & ~data->inverted);
+	nrf_gpio_port_out_clear(reg, pins & data->inverted);
+
+	return 0;
+}
+
+static int gpio_nrfx_port_clear_bits(struct device *port, u32_t pins)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	struct gpio_nrfx_data *data = get_port_data(port);
+
+	nrf_gpio_port_out_clear(reg, pins & ~data->inverted);
+	nrf_gpio_port_out_set(reg, pins & data->inverted);
+
+	return 0;
+}
+
+static int gpio_nrfx_port_toggle_bits(struct device *port, u32_t pins)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	unsigned int key;
+
+	key = irq_lock();
+	nrf_gpio_port_out_write(reg, nrf_gpio_port_out_read(reg) ^ pins);
+	irq_unlock(key);
+
+	return 0;
+}
+
 static int gpio_nrfx_manage_callback(struct device *port,
 				     struct gpio_callback *callback,
 				     bool set)
@@ -311,7 +362,11 @@ static const struct gpio_driver_api gpio_nrfx_drv_api_funcs = {
 	.read = gpio_nrfx_read,
 	.manage_callback = gpio_nrfx_manage_callback,
 	.enable_callback = gpio_nrfx_pin_enable_callback,
-	.disable_callback = gpio_nrfx_pin_disable_callback
+	.disable_callback = gpio_nrfx_pin_disable_callback,
+	.port_set_masked = gpio_nrfx_port_set_masked,
+	.port_set_bits = gpio_nrfx_port_set_bits,
+	.port_clear_bits = gpio_nrfx_port_clear_bits,
+	.port_toggle_bits = gpio_nrfx_port_toggle_bits,
 };
 
 static inline u32_t get_level_pins(struct device *port)
@@ -360,11 +360,72 @@ static int gpio_stm32_read(struct device *dev, int access_op,
 	const struct gpio_stm32_config *cfg = dev->config->config_info;
 	GPIO_TypeDef *gpio = (GPIO_TypeDef *)cfg->base;
 
-	if (access_op != GPIO_ACCESS_BY_PIN) {
-		return -ENOTSUP;
+	if (access_op == GPIO_ACCESS_BY_PORT) {
+		*value = LL_GPIO_ReadInputPort(gpio);
+	} else {
+		*value = (LL_GPIO_ReadInputPort(gpio) >> pin) & 0x1;
 	}
 
-	*value = (LL_GPIO_ReadInputPort(gpio) >> pin) & 0x1;
+	return 0;
+}
+
+/**
+ * @brief Translate a mask of pins to what the LL set/reset functions need
+ */
+static inline u32_t stm32_pinmask_get(u32_t pins)
+{
+#ifdef CONFIG_SOC_SERIES_STM32F1X
+	return (pins & 0xFFFF) << GPIO_PIN_MASK_POS;
+#else
+	return pins & 0xFFFF;
+#endif
+}
+
+static int gpio_stm32_port_set_masked(struct device *dev, u32_t mask,
+				      u32_t value)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+	GPIO_TypeDef *gpio = (GPIO_TypeDef *)cfg->base;
+	unsigned int key;
+	u32_t out;
+
+	key = irq_lock();
+	out = LL_GPIO_ReadOutputPort(gpio);
+	LL_GPIO_WriteOutputPort(gpio, (out & ~mask) | (value & mask));
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int gpio_stm32_port_set_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+
+	LL_GPIO_SetOutputPin((GPIO_TypeDef *)cfg->base,
+			     stm32_pinmask_get(pins));
+
+	return 0;
+}
+
+static int gpio_stm32_port_clear_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+
+	LL_GPIO_ResetOutputPin((GPIO_TypeDef *)cfg->base,
+			       stm32_pinmask_get(pins));
+
+	return 0;
+}
+
+static int gpio_stm32_port_toggle_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+	GPIO_TypeDef *gpio = (GPIO_TypeDef *)cfg->base;
+	unsigned int key;
+
+	key = irq_lock();
+	LL_GPIO_WriteOutputPort(gpio, LL_GPIO_ReadOutputPort(gpio) ^ pins);
+	irq_unlock(key);
 
 	return 0;
 }
@@ -413,7 +474,10 @@ static const struct gpio_driver_api gpio_stm32_driver = {
 	.manage_callback = gpio_stm32_manage_callback,
 	.enable_callback = gpio_stm32_enable_callback,
 	.disable_callback = gpio_stm32_disable_callback,
-
+	.port_set_masked = gpio_stm32_port_set_masked,
+	.port_set_bits = gpio_stm32_port_set_bits,
+	.port_clear_bits = gpio_stm32_port_clear_bits,
+	.port_toggle_bits = gpio_stm32_port_toggle_bits,
 };
 
 /**
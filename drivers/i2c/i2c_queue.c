@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per-controller I2C transaction queue. Each controller in use gets a work
+ * item on the I2C queue thread, which performs the queued transactions
+ * back to back and raises their signals.
+ */
+
+#include <errno.h>
+#include <kernel.h>
+#include <init.h>
+#include <drivers/i2c.h>
+
+struct i2c_queue {
+	struct device *dev;
+	sys_slist_t txns;
+	struct k_work work;
+};
+
+static struct i2c_queue queues[CONFIG_I2C_QUEUE_MAX_BUSES];
+
+static K_THREAD_STACK_DEFINE(i2c_queue_stack, CONFIG_I2C_QUEUE_STACK_SIZE);
+static struct k_work_q i2c_queue_work_q;
+
+static void queue_process(struct k_work *work)
+{
+	struct i2c_queue *queue = CONTAINER_OF(work, struct i2c_queue, work);
+	struct i2c_txn *txn;
+	sys_snode_t *node;
+	unsigned int key;
+	int ret;
+
+	while (true) {
+		key = irq_lock();
+		node = sys_slist_get(&queue->txns);
+		irq_unlock(key);
+
+		if (!node) {
+			break;
+		}
+
+		txn = CONTAINER_OF(node, struct i2c_txn, node);
+		ret = i2c_transfer(queue->dev, txn->msgs, txn->num_msgs,
+				   txn->addr);
+		k_poll_signal_raise(txn->signal, ret);
+	}
+}
+
+/* Called with interrupts locked. */
+static struct i2c_queue *queue_get(struct device *dev)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(queues); i++) {
+		if (queues[i].dev == dev) {
+			return &queues[i];
+		}
+
+		if (!queues[i].dev) {
+			queues[i].dev = dev;
+			sys_slist_init(&queues[i].txns);
+			k_work_init(&queues[i].work, queue_process);
+			return &queues[i];
+		}
+	}
+
+	return NULL;
+}
+
+int i2c_transfer_queued(struct device *dev, struct i2c_txn *txn)
+{
+	struct i2c_queue *queue;
+	unsigned int key;
+
+	key = irq_lock();
+
+	queue = queue_get(dev);
+	if (queue) {
+		sys_slist_append(&queue->txns, &txn->node);
+	}
+
+	irq_unlock(key);
+
+	if (!queue) {
+		return -ENOMEM;
+	}
+
+	k_work_submit_to_queue(&i2c_queue_work_q, &queue->work);
+
+	return 0;
+}
+
+static int i2c_queue_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&i2c_queue_work_q, i2c_queue_stack,
+		       K_THREAD_STACK_SIZEOF(i2c_queue_stack),
+		       CONFIG_I2C_QUEUE_THREAD_PRIO);
+
+	return 0;
+}
+
+SYS_INIT(i2c_queue_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
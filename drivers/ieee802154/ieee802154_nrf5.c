@@ -48,6 +48,9 @@ static struct nrf5_802154_data nrf5_data;
 
 #define ACK_TIMEOUT K_MSEC(10)
 
+/* Worst case of the driver CSMA-CA backoffs plus the ACK wait */
+#define CSMA_CA_TIMEOUT K_MSEC(50)
+
 /* Convenience defines for RADIO */
 #define NRF5_802154_DATA(dev) \
 	((struct nrf5_802154_data * const)(dev)->driver_data)
@@ -60,6 +63,52 @@ static void nrf5_get_eui64(u8_t *mac)
 	memcpy(mac, (const u32_t *)&NRF_FICR->DEVICEID, 8);
 }
 
+#if defined(CONFIG_IEEE802154_NRF5_RX_ZERO_COPY)
+/* Received frames are wrapped, not copied, into buffers of this pool. The
+ * radio buffer is handed back to the radio driver once the net_buf is freed.
+ */
+static u8_t *rx_psdu[NRF_802154_RX_BUFFERS];
+
+static void nrf5_rx_buf_destroy(struct net_buf *buf)
+{
+	int id = net_buf_id(buf);
+
+	nrf_802154_buffer_free_raw(rx_psdu[id]);
+	rx_psdu[id] = NULL;
+
+	net_buf_destroy(buf);
+}
+
+NET_BUF_POOL_FIXED_DEFINE(nrf5_rx_pool, NRF_802154_RX_BUFFERS, 0,
+			  nrf5_rx_buf_destroy);
+
+static struct net_pkt *nrf5_rx_pkt_get(struct net_if *iface, u8_t *psdu,
+				       u8_t len)
+{
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+
+	pkt = net_pkt_rx_alloc_on_iface(iface, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	buf = net_buf_alloc_with_data(&nrf5_rx_pool, psdu,
+				      NRF5_PHR_LENGTH + len, K_NO_WAIT);
+	if (!buf) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	rx_psdu[net_buf_id(buf)] = psdu;
+	net_buf_pull(buf, NRF5_PHR_LENGTH);
+
+	net_pkt_append_buffer(pkt, buf);
+
+	return pkt;
+}
+#endif /* CONFIG_IEEE802154_NRF5_RX_ZERO_COPY */
+
 static void nrf5_rx_thread(void *arg1, void *arg2, void *arg3)
 {
 	struct device *dev = (struct device *)arg1;
@@ -96,6 +145,17 @@ static void nrf5_rx_thread(void *arg1, void *arg2, void *arg3)
 
 		LOG_DBG("Frame received");
 
+#if defined(CONFIG_IEEE802154_NRF5_RX_ZERO_COPY)
+		pkt = nrf5_rx_pkt_get(nrf5_radio->iface, rx_frame->psdu,
+				      pkt_len);
+		if (!pkt) {
+			LOG_ERR("No pkt available");
+			goto drop;
+		}
+
+		/* The radio buffer now belongs to the packet */
+		rx_frame->psdu = NULL;
+#else
 		pkt = net_pkt_alloc_with_buffer(nrf5_radio->iface, pkt_len,
 						AF_UNSPEC, 0, K_NO_WAIT);
 		if (!pkt) {
@@ -106,6 +166,7 @@ static void nrf5_rx_thread(void *arg1, void *arg2, void *arg3)
 		if (net_pkt_write(pkt, rx_frame->psdu + 1, pkt_len)) {
 			goto drop;
 		}
+#endif
 
 		net_pkt_set_ieee802154_lqi(pkt, rx_frame->lqi);
 		net_pkt_set_ieee802154_rssi(pkt, rx_frame->rssi);
@@ -118,8 +179,10 @@ static void nrf5_rx_thread(void *arg1, void *arg2, void *arg3)
 			goto drop;
 		}
 
-		nrf_802154_buffer_free_raw(rx_frame->psdu);
-		rx_frame->psdu = NULL;
+		if (rx_frame->psdu) {
+			nrf_802154_buffer_free_raw(rx_frame->psdu);
+			rx_frame->psdu = NULL;
+		}
 
 		if (LOG_LEVEL >= LOG_LEVEL_DBG) {
 			net_analyze_stack(
@@ -131,8 +194,10 @@ static void nrf5_rx_thread(void *arg1, void *arg2, void *arg3)
 		continue;
 
 drop:
-		nrf_802154_buffer_free_raw(rx_frame->psdu);
-		rx_frame->psdu = NULL;
+		if (rx_frame->psdu) {
+			nrf_802154_buffer_free_raw(rx_frame->psdu);
+			rx_frame->psdu = NULL;
+		}
 
 		if (pkt) {
 			net_pkt_unref(pkt);
@@ -145,7 +210,9 @@ drop:
 static enum ieee802154_hw_caps nrf5_get_capabilities(struct device *dev)
 {
 	return IEEE802154_HW_FCS | IEEE802154_HW_2_4_GHZ |
-	       IEEE802154_HW_TX_RX_ACK | IEEE802154_HW_FILTER;
+	       IEEE802154_HW_TX_RX_ACK | IEEE802154_HW_FILTER |
+	       (IS_ENABLED(CONFIG_IEEE802154_NRF5_CSMA_CA) ?
+		IEEE802154_HW_CSMA : 0);
 }
 
 
@@ -263,25 +330,47 @@ static int nrf5_tx(struct device *dev,
 	struct nrf5_802154_data *nrf5_radio = NRF5_802154_DATA(dev);
 	u8_t payload_len = frag->len;
 	u8_t *payload = frag->data;
+	u8_t *psdu;
+	s32_t timeout;
 
 	LOG_DBG("%p (%u)", payload, payload_len);
 
-	nrf5_radio->tx_psdu[0] = payload_len + NRF5_FCS_LENGTH;
-	memcpy(nrf5_radio->tx_psdu + 1, payload, payload_len);
+	/* The frame can be sent in place if the PHR fits in front of it,
+	 * the buffer is only read by the radio until tx_wait is given.
+	 */
+	if (net_buf_headroom(frag) >= NRF5_PHR_LENGTH &&
+	    net_buf_tailroom(frag) >= NRF5_FCS_LENGTH) {
+		psdu = payload - NRF5_PHR_LENGTH;
+	} else {
+		psdu = nrf5_radio->tx_psdu;
+		memcpy(psdu + NRF5_PHR_LENGTH, payload, payload_len);
+	}
+
+	psdu[0] = payload_len + NRF5_FCS_LENGTH;
 
 	/* Reset semaphore in case ACK was received after timeout */
 	k_sem_reset(&nrf5_radio->tx_wait);
 
-	if (!nrf_802154_transmit_raw(nrf5_radio->tx_psdu, false)) {
+#if defined(CONFIG_IEEE802154_NRF5_CSMA_CA)
+	/* Backoffs, CCA and ACK wait are all handled by the radio driver,
+	 * which calls back once the frame is done with.
+	 */
+	nrf_802154_transmit_csma_ca_raw(psdu);
+	timeout = CSMA_CA_TIMEOUT;
+#else
+	if (!nrf_802154_transmit_raw(psdu, false)) {
 		LOG_ERR("Cannot send frame");
 		return -EIO;
 	}
 
+	timeout = ACK_TIMEOUT;
+#endif
+
 	LOG_DBG("Sending frame (ch:%d, txpower:%d)",
 		nrf_802154_channel_get(), nrf_802154_tx_power_get());
 
 	/* Wait for ack to be received */
-	if (k_sem_take(&nrf5_radio->tx_wait, ACK_TIMEOUT)) {
+	if (k_sem_take(&nrf5_radio->tx_wait, timeout)) {
 		LOG_DBG("ACK not received");
 
 		if (!nrf_802154_receive()) {
@@ -304,6 +393,10 @@ static int nrf5_tx(struct device *dev,
 		return 0;
 	}
 
+	if (nrf5_radio->tx_result == NRF_802154_TX_ERROR_BUSY_CHANNEL) {
+		return -EBUSY;
+	}
+
 	return -EIO;
 }
 
@@ -171,6 +171,30 @@ static void process_cmd(struct modem_cmd *cmd, size_t match_len,
 	}
 }
 
+/* index the first bytes of the commands of an array */
+static void cmd_index_update(struct modem_cmd_handler_data *data, int j)
+{
+	int i;
+	u8_t c;
+
+	(void)memset(data->cmds_first[j], 0, sizeof(data->cmds_first[j]));
+	data->cmds_match_any[j] = false;
+
+	if (!data->cmds[j]) {
+		return;
+	}
+
+	for (i = 0; i < data->cmds_len[j]; i++) {
+		if (data->cmds[j][i].cmd_len == 0U) {
+			data->cmds_match_any[j] = true;
+			continue;
+		}
+
+		c = data->cmds[j][i].cmd[0];
+		data->cmds_first[j][c >> 5] |= BIT(c & 0x1f);
+	}
+}
+
 /*
  * check 3 arrays of commands for a match in match_buf:
  * - response handlers[0]
@@ -179,6 +203,8 @@ static void process_cmd(struct modem_cmd *cmd, size_t match_len,
  */
 static struct modem_cmd *find_cmd_match(struct modem_cmd_handler_data *data)
 {
+	struct modem_cmd *cmd;
+	u8_t c = data->match_buf[0];
 	int j, i;
 
 	for (j = 0; j < ARRAY_SIZE(data->cmds); j++) {
@@ -186,12 +212,21 @@ static struct modem_cmd *find_cmd_match(struct modem_cmd_handler_data *data)
 			continue;
 		}
 
+		/* no command of this array starts like the line */
+		if (!data->cmds_match_any[j] &&
+		    !(data->cmds_first[j][c >> 5] & BIT(c & 0x1f))) {
+			continue;
+		}
+
 		for (i = 0; i < data->cmds_len[j]; i++) {
+			cmd = &data->cmds[j][i];
+
 			/* match on "empty" cmd */
-			if (strlen(data->cmds[j][i].cmd) == 0 ||
-			    strncmp(data->match_buf, data->cmds[j][i].cmd,
-				    data->cmds[j][i].cmd_len) == 0) {
-				return &data->cmds[j][i];
+			if (cmd->cmd_len == 0U ||
+			    (cmd->cmd[0] == c &&
+			     strncmp(data->match_buf, cmd->cmd,
+				     cmd->cmd_len) == 0)) {
+				return cmd;
 			}
 		}
 	}
@@ -355,6 +390,7 @@ int modem_cmd_handler_update_cmds(struct modem_cmd_handler_data *data,
 
 	data->cmds[CMD_HANDLER] = handler_cmds;
 	data->cmds_len[CMD_HANDLER] = handler_cmds_len;
+	cmd_index_update(data, CMD_HANDLER);
 	if (reset_error_flag) {
 		data->last_error = 0;
 	}
@@ -485,6 +521,10 @@ int modem_cmd_handler_init(struct modem_cmd_handler *handler,
 	handler->cmd_handler_data = data;
 	handler->process = cmd_handler_process;
 
+	cmd_index_update(data, CMD_RESP);
+	cmd_index_update(data, CMD_UNSOL);
+	cmd_index_update(data, CMD_HANDLER);
+
 	k_sem_init(&data->sem_tx_lock, 1, 1);
 	k_sem_init(&data->sem_parse_lock, 1, 1);
 
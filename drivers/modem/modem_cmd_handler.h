@@ -67,6 +67,12 @@ struct modem_cmd_handler_data {
 	struct modem_cmd *cmds[CMD_MAX];
 	size_t cmds_len[CMD_MAX];
 
+	/* first bytes of the commands of each array, to skip the arrays
+	 * which can't match a line (an "empty" cmd matches any line)
+	 */
+	u32_t cmds_first[CMD_MAX][8];
+	bool cmds_match_any[CMD_MAX];
+
 	char *read_buf;
 	size_t read_buf_len;
 
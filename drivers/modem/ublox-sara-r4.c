@@ -182,44 +182,45 @@ static int hex_to_binary(struct modem_cmd_handler_data *data,
 			 u16_t data_length,
 			 u8_t *bin_buf, u16_t bin_buf_len)
 {
-	int i;
+	u16_t i = 0U, hex_len = data_length * 2U, run, pos;
 	u8_t c = 0U, c2;
 
-	/* make sure we have room for a NUL char at the end of bin_buf */
-	if (data_length > bin_buf_len - 1) {
+	if (data_length > bin_buf_len) {
 		return -ENOMEM;
 	}
 
-	for (i = 0; i < data_length * 2; i++) {
+	/* decode straight from the RX fragments, dropping them once used */
+	while (i < hex_len) {
 		if (!data->rx_buf) {
 			return -ENOMEM;
 		}
 
-		c2 = *data->rx_buf->data;
-		if (isdigit(c2)) {
-			c += c2 - '0';
-		} else if (isalpha(c2)) {
-			c += c2 - (isupper(c2) ? 'A' - 10 : 'a' - 10);
-		} else {
-			return -EINVAL;
-		}
-
-		if (i % 2) {
-			bin_buf[i / 2] = c;
-			c = 0U;
-		} else {
-			c = c << 4;
+		run = MIN(data->rx_buf->len, hex_len - i);
+		for (pos = 0U; pos < run; pos++, i++) {
+			c2 = data->rx_buf->data[pos];
+			if (isdigit(c2)) {
+				c += c2 - '0';
+			} else if (isalpha(c2)) {
+				c += c2 - (isupper(c2) ? 'A' - 10 : 'a' - 10);
+			} else {
+				net_buf_pull(data->rx_buf, pos);
+				return -EINVAL;
+			}
+
+			if (i % 2) {
+				bin_buf[i / 2] = c;
+				c = 0U;
+			} else {
+				c = c << 4;
+			}
 		}
 
-		/* pull data from buf and advance to the next frag if needed */
-		net_buf_pull_u8(data->rx_buf);
+		net_buf_pull(data->rx_buf, run);
 		if (!data->rx_buf->len) {
 			data->rx_buf = net_buf_frag_del(NULL, data->rx_buf);
 		}
 	}
 
-	/* end with a NUL char */
-	bin_buf[i / 2] = '\0';
 	return 0;
 }
 
@@ -1056,7 +1057,7 @@ static ssize_t offload_recvfrom(int sock_fd, void *buf, short int len,
 				socklen_t *fromlen)
 {
 	struct modem_socket *sock;
-	int ret;
+	int ret, i, read_len, max_len;
 	struct modem_cmd cmd[] = {
 		MODEM_CMD("+USORF: ", on_cmd_sockreadfrom, 4U, ","),
 		MODEM_CMD("+USORD: ", on_cmd_sockread, 2U, ","),
@@ -1084,10 +1085,22 @@ static ssize_t offload_recvfrom(int sock_fd, void *buf, short int len,
 		k_sem_take(&sock->sem_data_ready, K_FOREVER);
 	}
 
+	/*
+	 * TCP data is a stream: read all the queued packets which fit
+	 * in the buffer with a single command.
+	 */
+	read_len = sock->packet_sizes[0];
+	if (sock->type == SOCK_STREAM) {
+		max_len = MIN(len, MDM_MAX_DATA_LENGTH);
+		for (i = 1; i < sock->packet_count &&
+			    read_len + sock->packet_sizes[i] <= max_len; i++) {
+			read_len += sock->packet_sizes[i];
+		}
+	}
+
 	snprintk(sendbuf, sizeof(sendbuf), "AT+USO%s=%d,%d",
 		 from ? "RF" : "RD", sock->id,
-		 len < sock->packet_sizes[0] ? len :
-					       sock->packet_sizes[0]);
+		 len < read_len ? len : read_len);
 
 	/* socket read settings */
 	(void)memset(&sock_data, 0, sizeof(sock_data));
@@ -7,8 +7,9 @@
 /**
  * @file
  *
- * PPP driver using uart_pipe. This is meant for network connectivity between
- * two network end points.
+ * PPP driver using uart_pipe, or the asynchronous UART API when
+ * CONFIG_NET_PPP_ASYNC_UART is set. This is meant for network connectivity
+ * between two network end points.
  */
 
 #define LOG_LEVEL CONFIG_NET_PPP_LOG_LEVEL
@@ -28,6 +29,7 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include <net/net_if.h>
 #include <net/net_core.h>
 #include <console/uart_pipe.h>
+#include <drivers/uart.h>
 #include <crc.h>
 
 #include "../../subsys/net/ip/net_stats.h"
@@ -35,6 +37,17 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 
 #define UART_BUF_LEN CONFIG_NET_PPP_UART_PIPE_BUF_LEN
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+#define SEND_BUF_LEN CONFIG_NET_PPP_ASYNC_UART_TX_BUF_LEN
+#define RX_BUF_LEN CONFIG_NET_PPP_ASYNC_UART_RX_BUF_LEN
+#else
+#define SEND_BUF_LEN UART_BUF_LEN
+#endif
+
+/* HDLC flag and control escape bytes, RFC 1662 ch 4.2 */
+#define HDLC_FLAG 0x7e
+#define HDLC_ESCAPE 0x7d
+
 enum ppp_driver_state {
 	STATE_HDLC_FRAME_START,
 	STATE_HDLC_FRAME_ADDRESS,
@@ -50,11 +63,31 @@ struct ppp_driver_context {
 	/* How much free space we have in the net_pkt */
 	size_t available;
 
+	/* FCS of the bytes saved in the net_pkt */
+	u16_t fcs;
+
 	/* ppp data is read into this buf */
 	u8_t buf[UART_BUF_LEN];
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	struct device *dev;
+
+	/* The UART receives into one buffer while the other one is
+	 * waiting to be given back to it.
+	 */
+	u8_t rx_buf[2][RX_BUF_LEN];
+	u8_t rx_buf_next;
+
+	/* The UART sends one buffer while the other one is filled */
+	u8_t send_buf[2][SEND_BUF_LEN];
+	u8_t send_buf_idx;
+
+	/* Given when the UART has sent the buffer given to it */
+	struct k_sem tx_sem;
+#else
 	/* ppp buf use when sending data */
-	u8_t send_buf[UART_BUF_LEN];
+	u8_t send_buf[SEND_BUF_LEN];
+#endif
 
 	u8_t mac_addr[6];
 	struct net_linkaddr ll_addr;
@@ -71,8 +104,10 @@ struct ppp_driver_context {
 
 static struct ppp_driver_context ppp_driver_context_data;
 
-static int ppp_save_byte(struct ppp_driver_context *ppp, u8_t byte)
+static int ppp_save_bytes(struct ppp_driver_context *ppp, const u8_t *data,
+			  size_t len)
 {
+	size_t count;
 	int ret;
 
 	if (!ppp->pkt) {
@@ -88,39 +123,49 @@ static int ppp_save_byte(struct ppp_driver_context *ppp, u8_t byte)
 		net_pkt_cursor_init(ppp->pkt);
 
 		ppp->available = net_pkt_available_buffer(ppp->pkt);
+		ppp->fcs = 0xffff;
 	}
 
 	/* Extra debugging can be enabled separately if really
 	 * needed. Normally it would just print too much data.
 	 */
 	if (0) {
-		LOG_DBG("Saving byte %02x", byte);
+		LOG_HEXDUMP_DBG(data, len, "Saving bytes");
 	}
 
-	/* This is not very intuitive but we must allocate new buffer
-	 * before we write a byte to last available cursor position.
-	 */
-	if (ppp->available == 1) {
-		ret = net_pkt_alloc_buffer(ppp->pkt,
-					   CONFIG_NET_BUF_DATA_SIZE,
-					   AF_UNSPEC, K_NO_WAIT);
-		if (ret < 0) {
-			LOG_ERR("[%p] cannot allocate new data buffer", ppp);
-			goto out_of_mem;
+	if (IS_ENABLED(CONFIG_NET_PPP_VERIFY_FCS)) {
+		ppp->fcs = crc16_ccitt(ppp->fcs, data, len);
+	}
+
+	while (len) {
+		/* This is not very intuitive but we must allocate new buffer
+		 * before we write a byte to last available cursor position.
+		 */
+		if (ppp->available == 1) {
+			ret = net_pkt_alloc_buffer(ppp->pkt,
+						   CONFIG_NET_BUF_DATA_SIZE,
+						   AF_UNSPEC, K_NO_WAIT);
+			if (ret < 0) {
+				LOG_ERR("[%p] cannot allocate new data buffer",
+					ppp);
+				goto out_of_mem;
+			}
+
+			ppp->available = net_pkt_available_buffer(ppp->pkt);
 		}
 
-		ppp->available = net_pkt_available_buffer(ppp->pkt);
-	}
+		count = MIN(len, ppp->available - 1);
 
-	if (ppp->available) {
-		ret = net_pkt_write_u8(ppp->pkt, byte);
+		ret = net_pkt_write(ppp->pkt, data, count);
 		if (ret < 0) {
 			LOG_ERR("[%p] Cannot write to pkt %p (%d)",
 				ppp, ppp->pkt, ret);
 			goto out_of_mem;
 		}
 
-		ppp->available--;
+		ppp->available -= count;
+		data += count;
+		len -= count;
 	}
 
 	return 0;
@@ -131,6 +176,11 @@ out_of_mem:
 	return -ENOMEM;
 }
 
+static int ppp_save_byte(struct ppp_driver_context *ppp, u8_t byte)
+{
+	return ppp_save_bytes(ppp, &byte, 1);
+}
+
 static const char *ppp_driver_state_str(enum ppp_driver_state state)
 {
 #if (CONFIG_NET_PPP_LOG_LEVEL >= LOG_LEVEL_DBG)
@@ -258,25 +308,9 @@ static int ppp_input_byte(struct ppp_driver_context *ppp, u8_t byte)
 
 static bool ppp_check_fcs(struct ppp_driver_context *ppp)
 {
-	struct net_buf *buf;
-	u16_t crc;
-
-	buf = ppp->pkt->buffer;
-	if (!buf) {
-		return false;
-	}
-
-	crc = crc16_ccitt(0xffff, buf->data, buf->len);
-
-	buf = buf->frags;
-
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
-	}
-
-	if (crc != 0xf0b8) {
-		LOG_DBG("Invalid FCS (0x%x)", crc);
+	/* The FCS was computed as the bytes were saved */
+	if (ppp->fcs != 0xf0b8) {
+		LOG_DBG("Invalid FCS (0x%x)", ppp->fcs);
 #if defined(CONFIG_NET_STATISTICS_PPP)
 		ppp->stats.chkerr++;
 #endif
@@ -333,105 +367,103 @@ static void ppp_process_msg(struct ppp_driver_context *ppp)
 	ppp->pkt = NULL;
 }
 
-static u8_t *ppp_recv_cb(u8_t *buf, size_t *off)
+/* Process received bytes. The bytes of a frame which need no de-stuffing
+ * are saved by runs rather than one by one, as they are most of them.
+ */
+static void ppp_input(struct ppp_driver_context *ppp, const u8_t *data,
+		      size_t len)
 {
-	struct ppp_driver_context *ppp =
-		CONTAINER_OF(buf, struct ppp_driver_context, buf);
-	size_t i, len = *off;
+	size_t i = 0, end;
+
+	while (i < len) {
+		if (ppp->state == STATE_HDLC_FRAME_DATA && !ppp->next_escaped) {
+			for (end = i; end < len; end++) {
+				if (data[end] == HDLC_FLAG ||
+				    data[end] == HDLC_ESCAPE) {
+					break;
+				}
+			}
 
-	for (i = 0; i < *off; i++) {
-		if (0) {
-			/* Extra debugging can be enabled separately if really
-			 * needed. Normally it would just print too much data.
-			 */
-			LOG_DBG("[%zd] %02x", i, buf[i]);
-		}
+			if (end > i) {
+				if (ppp_save_bytes(ppp, &data[i], end - i) < 0) {
+					ppp_change_state(ppp,
+							 STATE_HDLC_FRAME_START);
+				}
 
-		if (ppp_input_byte(ppp, buf[i]) == 0) {
-			/* Ignore empty or too short frames */
-			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
-				ppp_process_msg(ppp);
-				break;
+				i = end;
+				continue;
 			}
 		}
-	}
 
-	if (i == *off) {
-		*off = 0;
-	} else {
-		*off = len - i - 1;
+		if (ppp_input_byte(ppp, data[i++]) != 0 || !ppp->pkt) {
+			continue;
+		}
 
-		memmove(&buf[0], &buf[i + 1], *off);
+		/* Ignore empty or too short frames */
+		if (net_pkt_get_len(ppp->pkt) > 3) {
+			ppp_process_msg(ppp);
+		} else {
+			net_pkt_unref(ppp->pkt);
+			ppp->pkt = NULL;
+		}
 	}
+}
+
+#if !defined(CONFIG_NET_PPP_ASYNC_UART)
+static u8_t *ppp_recv_cb(u8_t *buf, size_t *off)
+{
+	struct ppp_driver_context *ppp =
+		CONTAINER_OF(buf, struct ppp_driver_context, buf);
+
+	ppp_input(ppp, buf, *off);
+
+	*off = 0;
 
 	return buf;
 }
+#endif
 
 #if defined(CONFIG_NET_TEST)
 void ppp_driver_feed_data(u8_t *data, int data_len)
 {
 	struct ppp_driver_context *ppp = &ppp_driver_context_data;
-	size_t recv_off = 0;
-
-	/* We are expecting that the tests are feeding data in large
-	 * chunks so we can reset the uart buffer here.
-	 */
-	memset(ppp->buf, 0, UART_BUF_LEN);
 
 	ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 
-	while (data_len > 0) {
-		int data_to_copy = MIN(data_len, UART_BUF_LEN);
-		int remaining;
+	LOG_DBG("Feeding %d bytes", data_len);
 
-		LOG_DBG("Feeding %d bytes", data_to_copy);
-
-		memcpy(ppp->buf, data, data_to_copy);
-
-		recv_off = data_to_copy;
-
-		(void)ppp_recv_cb(ppp->buf, &recv_off);
-
-		remaining = data_to_copy - recv_off;
-
-		LOG_DBG("We copied %d bytes", remaining);
-
-		data_len -= remaining;
-		data += remaining;
-	}
+	ppp_input(ppp, data, data_len);
 }
 #endif
 
-static bool calc_fcs(struct net_pkt *pkt, u16_t *fcs, u16_t protocol)
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+static inline u8_t *ppp_send_buf(struct ppp_driver_context *ppp)
 {
-	struct net_buf *buf;
-	u16_t crc;
-	u16_t c;
+	return ppp->send_buf[ppp->send_buf_idx];
+}
 
-	buf = pkt->buffer;
-	if (!buf) {
-		return false;
+static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
+{
+	if (IS_ENABLED(CONFIG_NET_TEST) || off == 0) {
+		return 0;
 	}
 
-	/* HDLC Address and Control fields */
-	c = sys_cpu_to_be16(0xff << 8 | 0x03);
+	/* Wait for the other buffer to be sent before giving this one */
+	k_sem_take(&ppp->tx_sem, K_FOREVER);
 
-	crc = crc16_ccitt(0xffff, (const u8_t *)&c, sizeof(c));
-
-	if (protocol > 0) {
-		crc = crc16_ccitt(crc, (const u8_t *)&protocol,
-				  sizeof(protocol));
-	}
-
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
+	if (uart_tx(ppp->dev, ppp_send_buf(ppp), off, K_FOREVER) < 0) {
+		LOG_ERR("[%p] cannot send %d bytes", ppp, off);
+		k_sem_give(&ppp->tx_sem);
 	}
 
-	crc ^= 0xffff;
-	*fcs = crc;
+	ppp->send_buf_idx ^= 1U;
 
-	return true;
+	return 0;
+}
+#else
+static inline u8_t *ppp_send_buf(struct ppp_driver_context *ppp)
+{
+	return ppp->send_buf;
 }
 
 static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
@@ -442,16 +474,23 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 
 	return 0;
 }
+#endif /* CONFIG_NET_PPP_ASYNC_UART */
 
 static int ppp_send_bytes(struct ppp_driver_context *ppp,
 			  const u8_t *data, int len, int off)
 {
-	int i;
+	int count;
+
+	while (len > 0) {
+		count = MIN(len, SEND_BUF_LEN - off);
 
-	for (i = 0; i < len; i++) {
-		ppp->send_buf[off++] = data[i];
+		memcpy(ppp_send_buf(ppp) + off, data, count);
 
-		if (off >= sizeof(ppp->send_buf)) {
+		off += count;
+		data += count;
+		len -= count;
+
+		if (off >= SEND_BUF_LEN) {
 			off = ppp_send_flush(ppp, off);
 		}
 	}
@@ -459,15 +498,42 @@ static int ppp_send_bytes(struct ppp_driver_context *ppp,
 	return off;
 }
 
-static u16_t ppp_escape_byte(u8_t byte, int *offset)
+static inline bool ppp_needs_escape(u8_t byte)
+{
+	return byte == HDLC_FLAG || byte == HDLC_ESCAPE || byte < 0x20;
+}
+
+/* Send data with the bytes which need it escaped, copying the runs of bytes
+ * which do not at once.
+ */
+static int ppp_send_escaped(struct ppp_driver_context *ppp,
+			    const u8_t *data, int len, int off)
 {
-	if (byte == 0x7e || byte == 0x7d || byte < 0x20) {
-		*offset = 0;
-		return (0x7d << 8) | (byte ^ 0x20);
+	u8_t escaped[2] = { HDLC_ESCAPE };
+	int run;
+
+	while (len > 0) {
+		for (run = 0; run < len; run++) {
+			if (ppp_needs_escape(data[run])) {
+				break;
+			}
+		}
+
+		if (run > 0) {
+			off = ppp_send_bytes(ppp, data, run, off);
+			data += run;
+			len -= run;
+			continue;
+		}
+
+		/* RFC 1662, ch. 4.2 */
+		escaped[1] = *data ^ 0x20;
+		off = ppp_send_bytes(ppp, escaped, sizeof(escaped), off);
+		data++;
+		len--;
 	}
 
-	*offset = 1;
-	return byte;
+	return off;
 }
 
 static int ppp_send(struct device *dev, struct net_pkt *pkt)
@@ -477,9 +543,10 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 	u16_t protocol = 0;
 	int send_off = 0;
 	u32_t sync_addr_ctrl;
-	u16_t fcs, escaped;
+	u16_t addr_ctrl;
+	u8_t fcs_bytes[2];
 	u8_t byte;
-	int i, offset;
+	u16_t fcs;
 
 #if defined(CONFIG_NET_TEST)
 	return 0;
@@ -505,9 +572,9 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
-	if (!calc_fcs(pkt, &fcs, protocol)) {
-		return -ENOMEM;
-	}
+	/* The FCS covers the HDLC Address and Control fields */
+	addr_ctrl = sys_cpu_to_be16(0xff << 8 | 0x03);
+	fcs = crc16_ccitt(0xffff, (const u8_t *)&addr_ctrl, sizeof(addr_ctrl));
 
 	/* Sync, Address & Control fields */
 	sync_addr_ctrl = sys_cpu_to_be32(0x7e << 24 | 0xff << 16 |
@@ -516,15 +583,10 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 				  sizeof(sync_addr_ctrl), send_off);
 
 	if (protocol > 0) {
-		escaped = htons(ppp_escape_byte(protocol, &offset));
-		send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
-
-		escaped = htons(ppp_escape_byte(protocol >> 8, &offset));
-		send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+		fcs = crc16_ccitt(fcs, (const u8_t *)&protocol,
+				  sizeof(protocol));
+		send_off = ppp_send_escaped(ppp, (const u8_t *)&protocol,
+					    sizeof(protocol), send_off);
 	}
 
 	/* Note that we do not print the first four bytes and FCS bytes at the
@@ -535,30 +597,24 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 		net_pkt_hexdump(pkt, "send ppp");
 	}
 
+	/* The FCS is computed while the data is escaped, so that it is
+	 * read once.
+	 */
 	while (buf) {
-		for (i = 0; i < buf->len; i++) {
-			/* Escape illegal bytes */
-			escaped = htons(ppp_escape_byte(buf->data[i], &offset));
-			send_off = ppp_send_bytes(ppp,
-						  (u8_t *)&escaped + offset,
-						  offset ? 1 : 2,
-						  send_off);
-		}
-
+		fcs = crc16_ccitt(fcs, buf->data, buf->len);
+		send_off = ppp_send_escaped(ppp, buf->data, buf->len,
+					    send_off);
 		buf = buf->frags;
 	}
 
-	escaped = htons(ppp_escape_byte(fcs, &offset));
-	send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	/* The FCS is sent least significant byte first */
+	fcs ^= 0xffff;
+	fcs_bytes[0] = fcs;
+	fcs_bytes[1] = fcs >> 8;
+	send_off = ppp_send_escaped(ppp, fcs_bytes, sizeof(fcs_bytes),
+				    send_off);
 
-	escaped = htons(ppp_escape_byte(fcs >> 8, &offset));
-	send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
-
-	byte = 0x7e;
+	byte = HDLC_FLAG;
 	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
 
 	(void)ppp_send_flush(ppp, send_off);
@@ -566,6 +622,62 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+static int ppp_rx_enable(struct ppp_driver_context *ppp)
+{
+	ppp->rx_buf_next = 1U;
+
+	return uart_rx_enable(ppp->dev, ppp->rx_buf[0], RX_BUF_LEN,
+			      CONFIG_NET_PPP_ASYNC_UART_RX_TIMEOUT);
+}
+
+static void ppp_uart_cb(struct uart_event *evt, void *user_data)
+{
+	struct ppp_driver_context *ppp = user_data;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&ppp->tx_sem);
+		break;
+
+	case UART_RX_RDY:
+		ppp_input(ppp, evt->data.rx.buf + evt->data.rx.offset,
+			  evt->data.rx.len);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		/* The buffer received into before the current one has been
+		 * released and processed, hand it back.
+		 */
+		(void)uart_rx_buf_rsp(ppp->dev, ppp->rx_buf[ppp->rx_buf_next],
+				      RX_BUF_LEN);
+		ppp->rx_buf_next ^= 1U;
+		break;
+
+	case UART_RX_STOPPED:
+		LOG_DBG("[%p] RX stopped (%d)", ppp, evt->data.rx_stop.reason);
+
+		/* Bytes were lost, resynchronize on the next frame */
+		if (ppp->pkt) {
+			net_pkt_unref(ppp->pkt);
+			ppp->pkt = NULL;
+		}
+
+		ppp->next_escaped = false;
+		ppp_change_state(ppp, STATE_HDLC_FRAME_START);
+		break;
+
+	case UART_RX_DISABLED:
+		(void)ppp_rx_enable(ppp);
+		break;
+
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_NET_PPP_ASYNC_UART */
+
 static int ppp_driver_init(struct device *dev)
 {
 	struct ppp_driver_context *ppp = dev->driver_data;
@@ -628,12 +740,31 @@ use_random_mac:
 
 	memset(ppp->buf, 0, sizeof(ppp->buf));
 
-	/* We do not use uart_pipe for unit tests as the unit test has its
+	/* We do not use the UART for unit tests as the unit test has its
 	 * own handling of UART. See tests/net/ppp/driver for details.
 	 */
-	if (!IS_ENABLED(CONFIG_NET_TEST)) {
-		uart_pipe_register(ppp->buf, sizeof(ppp->buf), ppp_recv_cb);
+	if (IS_ENABLED(CONFIG_NET_TEST)) {
+		return;
 	}
+
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	ppp->dev = device_get_binding(CONFIG_NET_PPP_ASYNC_UART_DEV_NAME);
+	if (!ppp->dev) {
+		LOG_ERR("[%p] cannot find UART %s", ppp,
+			CONFIG_NET_PPP_ASYNC_UART_DEV_NAME);
+		return;
+	}
+
+	k_sem_init(&ppp->tx_sem, 1, 1);
+
+	(void)uart_callback_set(ppp->dev, ppp_uart_cb, ppp);
+
+	if (ppp_rx_enable(ppp) < 0) {
+		LOG_ERR("[%p] cannot start receiving", ppp);
+	}
+#else
+	uart_pipe_register(ppp->buf, sizeof(ppp->buf), ppp_recv_cb);
+#endif
 }
 
 #if defined(CONFIG_NET_STATISTICS_PPP)
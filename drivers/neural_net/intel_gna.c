@@ -48,65 +48,131 @@ static struct intel_gna_config_desc __aligned(GNA_PG_SIZE_IN_BYTES)
 static struct intel_gna_page_table __aligned(GNA_PG_SIZE_IN_BYTES)
 	gna_page_table[GNA_NUM_PG_TABLES_NEEDED];
 
-static void intel_gna_interrupt_handler(struct device *dev)
+/*
+ * Start inferring the current frame of the active request. The model
+ * reads its input from, and writes its output to, the buffers of its
+ * rw_region: the layer descriptors hold their addresses. The frames are
+ * copied in and out of them between two runs, so that the accelerator is
+ * restarted right away.
+ */
+static void intel_gna_start(struct intel_gna_data *gna)
 {
-	struct intel_gna_data *const gna = DEV_DATA(dev);
-
+	struct intel_gna_pending_req *req = &gna->active;
+	struct intel_gna_model *handle = req->model;
 	volatile struct intel_gna_regs *regs = gna->regs;
+
+	/* copy input */
+	memcpy(handle->input, req->input + req->frame * req->input_len,
+			req->input_len);
+	SOC_DCACHE_FLUSH(handle->input, req->input_len);
+
+	if (gna->loaded != handle) {
+		/* assign layer descriptor base address to configuration
+		 * descriptor
+		 */
+		gna_config_desc.labase = (u32_t)handle->vabase;
+		gna_config_desc.lacnt =
+			(u16_t)handle->model.header->layer_count;
+		SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
+		gna->loaded = handle;
+	}
+
+	gna->state = GNA_STATE_ACTIVE;
+	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
+		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
+}
+
+static void intel_gna_complete(struct intel_gna_data *gna,
+		enum gna_result result)
+{
+	struct intel_gna_pending_req *req = &gna->active;
 	struct intel_gna_pending_resp pending_resp;
-	struct intel_gna_pending_req pending_req;
 
-	/* check for generic / virtual address out of range error */
-	if (regs->gnasts & (GNA_STS_VIRT_ADDR_OOR | GNA_STS_ERROR)) {
-		pending_resp.response.result = GNA_RESULT_GENERIC_ERROR;
+#if defined(CONFIG_POLL)
+	if (req->callback == NULL) {
+		k_poll_signal_raise(req->signal, result);
+		return;
 	}
+#endif
+
+	pending_resp.response.result = result;
+	pending_resp.response.output = req->output;
+	pending_resp.response.output_len = req->output_len * req->frame;
+	pending_resp.response.stats = req->stats;
+	pending_resp.callback = req->callback;
+
+	if (k_msgq_put(&gna->response_queue, &pending_resp, K_NO_WAIT)) {
+		LOG_ERR("Response queue is full");
+		return;
+	}
+
+	k_work_submit(&gna->gna_work);
+}
+
+static void intel_gna_interrupt_handler(struct device *dev)
+{
+	struct intel_gna_data *const gna = DEV_DATA(dev);
+
+	volatile struct intel_gna_regs *regs = gna->regs;
+	struct intel_gna_pending_req *req = &gna->active;
+	enum gna_result result = GNA_RESULT_GENERIC_ERROR;
+	u32_t status = regs->gnasts;
+	k_spinlock_key_t key;
 
 	/* check for parameter out of range error */
-	if (regs->gnasts & GNA_STS_PARAM_OOR) {
-		pending_resp.response.result =
-			GNA_RESULT_PARAM_OUT_OF_RANGE_ERROR;
+	if (status & GNA_STS_PARAM_OOR) {
+		result = GNA_RESULT_PARAM_OUT_OF_RANGE_ERROR;
 	}
 
 	/* check for output buffer full error */
-	if (regs->gnasts & GNA_STS_BUFFER_FULL) {
-		pending_resp.response.result =
-			GNA_RESULT_OUTPUT_BUFFER_FULL_ERROR;
+	if (status & GNA_STS_BUFFER_FULL) {
+		result = GNA_RESULT_OUTPUT_BUFFER_FULL_ERROR;
 	}
 
 	/* check for scoring completion out of range error */
-	if (regs->gnasts & GNA_STS_SCORE_COMPL) {
-		pending_resp.response.result = GNA_RESULT_INFERENCE_COMPLETE;
+	if (status & GNA_STS_SCORE_COMPL) {
+		result = GNA_RESULT_INFERENCE_COMPLETE;
 	}
 
-	if (k_msgq_get(&gna->request_queue, &pending_req, K_NO_WAIT) != 0) {
-		LOG_ERR("Pending request queue is empty");
+	key = k_spin_lock(&gna->lock);
+
+	/* clear GNA operation and disable interrupt */
+	regs->gnactrl |= GNA_CTRL_INTR_DISABLE | GNA_CTRL_ABORT_CLEAR;
+
+	if (gna->state != GNA_STATE_ACTIVE) {
+		LOG_ERR("No active request");
+		k_spin_unlock(&gna->lock, key);
+		return;
+	}
+
+	SOC_DCACHE_INVALIDATE(req->model->output, req->output_len);
+	/* copy output from the model buffer to applciation buffer */
+	memcpy(req->output + req->frame * req->output_len, req->model->output,
+			req->output_len);
+
+	if (status & GNA_STS_STATS_VALID) {
+		req->stats.total_cycles += regs->gnaptc;
+		req->stats.stall_cycles += regs->gnasc;
+	}
+
+	req->frame++;
+
+	if ((result == GNA_RESULT_INFERENCE_COMPLETE) &&
+			(req->frame < req->frames)) {
+		/* next frame of the batch */
+		intel_gna_start(gna);
 	} else {
-		SOC_DCACHE_INVALIDATE(pending_req.model->output,
-				pending_req.output_len);
-		/* copy output from the model buffer to applciation buffer */
-		memcpy(pending_req.output, pending_req.model->output,
-				pending_req.output_len);
-		pending_resp.response.output = pending_req.output;
-		pending_resp.response.output_len = pending_req.output_len;
-		pending_resp.callback = pending_req.callback;
-
-		pending_resp.response.stats.cycles_per_sec = 200000000U;
-		if (regs->gnasts & GNA_STS_STATS_VALID) {
-			pending_resp.response.stats.total_cycles = regs->gnaptc;
-			pending_resp.response.stats.stall_cycles = regs->gnasc;
+		intel_gna_complete(gna, result);
+
+		/* next pending request */
+		if (k_msgq_get(&gna->request_queue, req, K_NO_WAIT) == 0) {
+			intel_gna_start(gna);
 		} else {
-			pending_resp.response.stats.total_cycles = 0U;
-			pending_resp.response.stats.stall_cycles = 0U;
+			gna->state = GNA_STATE_IDLE;
 		}
-
-		k_msgq_put(&gna->response_queue, &pending_resp, K_NO_WAIT);
-
-		k_work_submit(&gna->gna_work);
 	}
 
-	/* clear GNA operation and disable interrupt */
-	regs->gnactrl |= GNA_CTRL_INTR_DISABLE | GNA_CTRL_ABORT_CLEAR;
-	gna->state = GNA_STATE_IDLE;
+	k_spin_unlock(&gna->lock, key);
 }
 
 static void gna_work_handler(struct k_work *work)
@@ -176,7 +242,7 @@ static int intel_gna_initialize(struct device *dev)
 
 	k_msgq_init(&gna->response_queue, (char *)gna->responses,
 			sizeof(struct intel_gna_pending_resp),
-			GNA_REQUEST_QUEUE_LEN);
+			GNA_REQUEST_QUEUE_LEN + 1);
 
 	k_mem_slab_init(&gna->model_slab, (char *)gna->models,
 			sizeof(struct intel_gna_model), GNA_MAX_NUM_MODELS);
@@ -392,6 +458,9 @@ static int intel_gna_deregister_model(struct device *dev, void *model_handle)
 
 	gna_model = (struct intel_gna_model *)model_handle;
 	gna_model->registered = false;
+	if (gna->loaded == gna_model) {
+		gna->loaded = NULL;
+	}
 	k_mem_slab_free(&gna->model_slab, &model_handle);
 
 	return 0;
@@ -401,13 +470,12 @@ static int intel_gna_infer(struct device *dev, struct gna_inference_req *req,
 		gna_callback callback)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
-	volatile struct intel_gna_regs *regs = gna->regs;
 	struct intel_gna_pending_req pending_req;
 	struct gna_model_header *header;
 	struct intel_gna_model *handle;
 	struct gna_model_info *model;
-	size_t input_size;
-	int ret;
+	k_spinlock_key_t key;
+	int ret = 0;
 
 	LOG_DBG("device %p", dev);
 	if (req == NULL) {
@@ -415,11 +483,18 @@ static int intel_gna_infer(struct device *dev, struct gna_inference_req *req,
 		return -EINVAL;
 	}
 
-	if (callback == NULL) {
+	if ((callback == NULL) &&
+			(!IS_ENABLED(CONFIG_POLL) || (req->signal == NULL))) {
 		LOG_ERR("Invalid callback function pointer");
 		return -EINVAL;
 	}
 
+	if ((gna->state != GNA_STATE_IDLE) &&
+			(gna->state != GNA_STATE_ACTIVE)) {
+		LOG_ERR("Invalid state (%u)", gna->state);
+		return -EINVAL;
+	}
+
 	handle = (struct intel_gna_model *)req->model_handle;
 
 	if (handle->registered != true) {
@@ -439,39 +514,38 @@ static int intel_gna_infer(struct device *dev, struct gna_inference_req *req,
 
 	model = &handle->model;
 	header = model->header;
-	input_size = header->bytes_per_input * header->num_input_nodes;
 
 	pending_req.model = handle;
+	pending_req.input = req->input;
+	pending_req.input_len = header->bytes_per_input *
+		header->num_input_nodes;
 	pending_req.output = req->output;
 	pending_req.output_len = header->bytes_per_output *
 		header->num_output_nodes;
+	pending_req.frames = req->frames ? req->frames : 1;
+	pending_req.frame = 0U;
 	pending_req.callback = callback;
+	pending_req.signal = req->signal;
+	pending_req.stats.total_cycles = 0U;
+	pending_req.stats.stall_cycles = 0U;
+	pending_req.stats.cycles_per_sec = 200000000U;
 
-	ret = k_msgq_put(&gna->request_queue, &pending_req, K_NO_WAIT);
-	if (ret) {
-		LOG_ERR("Unable to queue request (code %d)", ret);
-		return ret;
-	}
+	key = k_spin_lock(&gna->lock);
 
-	if (gna->state != GNA_STATE_IDLE) {
-		/* multiple pending requests are not yet supported */
-		return -EBUSY;
+	if (gna->state == GNA_STATE_IDLE) {
+		gna->active = pending_req;
+		intel_gna_start(gna);
+	} else {
+		/* started by the interrupt once the active one completes */
+		ret = k_msgq_put(&gna->request_queue, &pending_req, K_NO_WAIT);
+		if (ret) {
+			LOG_ERR("Unable to queue request (code %d)", ret);
+		}
 	}
 
-	/* copy input */
-	memcpy(handle->input, req->input, input_size);
-	SOC_DCACHE_FLUSH(handle->input, input_size);
-
-	/* assign layer descriptor base address to configuration descriptor */
-	gna_config_desc.labase = (u32_t)handle->vabase;
-	gna_config_desc.lacnt = (u16_t)header->layer_count;
-	SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
+	k_spin_unlock(&gna->lock, key);
 
-	gna->state = GNA_STATE_ACTIVE;
-	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
-		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
-
-	return 0;
+	return ret;
 }
 
 #if LOG_LEVEL >= LOG_LEVEL_DBG
@@ -162,10 +162,16 @@ struct intel_gna_model {
 };
 
 struct intel_gna_pending_req {
-	struct intel_gna_model	*model;
-	void			*output;
-	size_t			output_len;
-	gna_callback		callback;
+	struct intel_gna_model		*model;
+	u8_t				*input;
+	size_t				input_len;	/* per frame */
+	u8_t				*output;
+	size_t				output_len;	/* per frame */
+	u32_t				frames;
+	u32_t				frame;		/* being inferred */
+	gna_callback			callback;
+	struct k_poll_signal		*signal;
+	struct gna_inference_stats	stats;
 };
 
 struct intel_gna_pending_resp {
@@ -192,7 +198,13 @@ struct intel_gna_data {
 	struct k_msgq			request_queue;
 	struct intel_gna_pending_req	requests[GNA_REQUEST_QUEUE_LEN];
 	struct k_msgq			response_queue;
-	struct intel_gna_pending_resp	responses[GNA_REQUEST_QUEUE_LEN];
+	/* the active request completes while the queue is full */
+	struct intel_gna_pending_resp	responses[GNA_REQUEST_QUEUE_LEN + 1];
+	/* request being inferred, out of the queue */
+	struct intel_gna_pending_req	active;
+	/* model the configuration descriptor points to */
+	struct intel_gna_model		*loaded;
+	struct k_spinlock		lock;
 	enum gna_state			state;
 };
 
@@ -46,7 +46,8 @@ int lis2dh_spi_access(struct lis2dh_data *ctx, u8_t cmd,
 }
 #endif
 
-#if defined(CONFIG_LIS2DH_TRIGGER) || defined(CONFIG_LIS2DH_ACCEL_RANGE_RUNTIME)
+#if defined(CONFIG_LIS2DH_TRIGGER) || \
+	defined(CONFIG_LIS2DH_ACCEL_RANGE_RUNTIME) || defined(CONFIG_SENSOR_FIFO)
 int lis2dh_reg_field_update(struct device *dev, u8_t reg_addr,
 			    u8_t pos, u8_t mask, u8_t val)
 {
@@ -88,32 +89,43 @@ static void lis2dh_convert(s16_t raw_val, u16_t scale,
 	}
 }
 
-static int lis2dh_channel_get(struct device *dev,
-			      enum sensor_channel chan,
-			      struct sensor_value *val)
+static int lis2dh_channel_ofs(enum sensor_channel chan,
+			      int *ofs_start, int *ofs_end)
 {
-	struct lis2dh_data *lis2dh = dev->driver_data;
-	int ofs_start;
-	int ofs_end;
-	int i;
-
 	switch (chan) {
 	case SENSOR_CHAN_ACCEL_X:
-		ofs_start = ofs_end = 0;
+		*ofs_start = *ofs_end = 0;
 		break;
 	case SENSOR_CHAN_ACCEL_Y:
-		ofs_start = ofs_end = 1;
+		*ofs_start = *ofs_end = 1;
 		break;
 	case SENSOR_CHAN_ACCEL_Z:
-		ofs_start = ofs_end = 2;
+		*ofs_start = *ofs_end = 2;
 		break;
 	case SENSOR_CHAN_ACCEL_XYZ:
-		ofs_start = 0;
-		ofs_end = 2;
+		*ofs_start = 0;
+		*ofs_end = 2;
 		break;
 	default:
 		return -ENOTSUP;
 	}
+
+	return 0;
+}
+
+static int lis2dh_channel_get(struct device *dev,
+			      enum sensor_channel chan,
+			      struct sensor_value *val)
+{
+	struct lis2dh_data *lis2dh = dev->driver_data;
+	int ofs_start;
+	int ofs_end;
+	int i;
+
+	if (lis2dh_channel_ofs(chan, &ofs_start, &ofs_end) < 0) {
+		return -ENOTSUP;
+	}
+
 	for (i = ofs_start; i <= ofs_end; i++, val++) {
 		lis2dh_convert(lis2dh->sample.xyz[i], lis2dh->scale, val);
 	}
@@ -121,6 +133,23 @@ static int lis2dh_channel_get(struct device *dev,
 	return 0;
 }
 
+static int lis2dh_scale_get(struct device *dev, enum sensor_channel chan,
+			    struct sensor_scale *scale)
+{
+	struct lis2dh_data *lis2dh = dev->driver_data;
+	int ofs_start;
+	int ofs_end;
+
+	if (lis2dh_channel_ofs(chan, &ofs_start, &ofs_end) < 0) {
+		return -ENOTSUP;
+	}
+
+	scale->range = (s32_t)lis2dh->scale << 15;
+	scale->offset = 0;
+
+	return 0;
+}
+
 static int lis2dh_sample_fetch(struct device *dev, enum sensor_channel chan)
 {
 	struct lis2dh_data *lis2dh = dev->driver_data;
@@ -162,10 +191,103 @@ static int lis2dh_sample_fetch(struct device *dev, enum sensor_channel chan)
 	return -ENODATA;
 }
 
-#ifdef CONFIG_LIS2DH_ODR_RUNTIME
+#if defined(CONFIG_LIS2DH_ODR_RUNTIME) || defined(CONFIG_SENSOR_FIFO)
 /* 1620 & 5376 are low power only */
 static const u16_t lis2dh_odr_map[] = {0, 1, 10, 25, 50, 100, 200, 400, 1620,
 				       1344, 5376};
+#endif
+
+#ifdef CONFIG_SENSOR_FIFO
+static int lis2dh_fifo_enable(struct device *dev)
+{
+	int status;
+
+	status = lis2dh_reg_field_update(dev, LIS2DH_REG_CTRL5,
+					 LIS2DH_FIFO_EN_SHIFT,
+					 LIS2DH_FIFO_EN_BIT, 1);
+	if (status < 0) {
+		return status;
+	}
+
+	/* Stream mode, the oldest samples are overwritten when full */
+	return lis2dh_reg_write_byte(dev, LIS2DH_REG_FIFO_CTRL,
+				     LIS2DH_FIFO_MODE_STREAM);
+}
+
+static int lis2dh_fifo_read(struct device *dev, u8_t *buf, size_t size,
+			    struct sensor_fifo_block *block)
+{
+	struct lis2dh_data *lis2dh = dev->driver_data;
+	u16_t num_frames;
+	u8_t src;
+	int status;
+
+	/* Enabled on first use, sample_fetch() then pops from the FIFO. */
+	if (!lis2dh->fifo_on) {
+		status = lis2dh_fifo_enable(dev);
+		if (status < 0) {
+			return status;
+		}
+
+		lis2dh->fifo_on = true;
+	}
+
+	status = lis2dh_reg_read_byte(dev, LIS2DH_REG_FIFO_SRC, &src);
+	if (status < 0) {
+		return status;
+	}
+
+	block->timestamp = k_cycle_get_32();
+
+	num_frames = (src & LIS2DH_FIFO_OVRN_BIT) ?
+		     LIS2DH_FIFO_SIZE : (src & LIS2DH_FIFO_FSS_MASK);
+	num_frames = MIN(num_frames, size / LIS2DH_FIFO_FRAME_SIZE);
+
+	/* With the FIFO on, the address wraps from Z MSB back to X LSB, so
+	 * the whole FIFO is drained with one burst.
+	 */
+	if (num_frames) {
+		status = lis2dh_burst_read(dev, LIS2DH_REG_ACCEL_X_LSB, buf,
+					   num_frames *
+					   LIS2DH_FIFO_FRAME_SIZE);
+		if (status < 0) {
+			LOG_WRN("Could not read FIFO");
+			return status;
+		}
+	}
+
+	block->frames = buf;
+	block->num_frames = num_frames;
+	block->frame_size = LIS2DH_FIFO_FRAME_SIZE;
+	block->overrun = (src & LIS2DH_FIFO_OVRN_BIT) != 0U;
+	block->period = sys_clock_hw_cycles_per_sec() / lis2dh->odr;
+
+	return 0;
+}
+
+static int lis2dh_frame_decode(struct device *dev, const u8_t *frame,
+			       enum sensor_channel chan,
+			       struct sensor_value *val)
+{
+	struct lis2dh_data *lis2dh = dev->driver_data;
+	int ofs_start;
+	int ofs_end;
+	int i;
+
+	if (lis2dh_channel_ofs(chan, &ofs_start, &ofs_end) < 0) {
+		return -ENOTSUP;
+	}
+
+	for (i = ofs_start; i <= ofs_end; i++, val++) {
+		lis2dh_convert((s16_t)sys_get_le16(&frame[i * sizeof(s16_t)]),
+			       lis2dh->scale, val);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SENSOR_FIFO */
+
+#ifdef CONFIG_LIS2DH_ODR_RUNTIME
 
 static int lis2dh_freq_to_odr_val(u16_t freq)
 {
@@ -187,6 +309,9 @@ static int lis2dh_freq_to_odr_val(u16_t freq)
 
 static int lis2dh_acc_odr_set(struct device *dev, u16_t freq)
 {
+#ifdef CONFIG_SENSOR_FIFO
+	struct lis2dh_data *lis2dh = dev->driver_data;
+#endif
 	int odr;
 	int status;
 	u8_t value;
@@ -212,9 +337,16 @@ static int lis2dh_acc_odr_set(struct device *dev, u16_t freq)
 		odr--;
 	}
 
-	return lis2dh_reg_write_byte(dev, LIS2DH_REG_CTRL1,
-				  (value & ~LIS2DH_ODR_MASK) |
-				  LIS2DH_ODR_RATE(odr));
+	status = lis2dh_reg_write_byte(dev, LIS2DH_REG_CTRL1,
+				       (value & ~LIS2DH_ODR_MASK) |
+				       LIS2DH_ODR_RATE(odr));
+#ifdef CONFIG_SENSOR_FIFO
+	if (status == 0) {
+		lis2dh->odr = freq;
+	}
+#endif
+
+	return status;
 }
 #endif
 
@@ -310,6 +442,11 @@ static const struct sensor_driver_api lis2dh_driver_api = {
 #endif
 	.sample_fetch = lis2dh_sample_fetch,
 	.channel_get = lis2dh_channel_get,
+	.scale_get = lis2dh_scale_get,
+#ifdef CONFIG_SENSOR_FIFO
+	.fifo_read = lis2dh_fifo_read,
+	.frame_decode = lis2dh_frame_decode,
+#endif
 };
 
 int lis2dh_init(struct device *dev)
@@ -359,6 +496,13 @@ int lis2dh_init(struct device *dev)
 		    LIS2DH_BUS_DEV_NAME, 1 << (LIS2DH_FS_IDX + 1),
 		    LIS2DH_ODR_IDX, (u8_t)LIS2DH_LP_EN_BIT, lis2dh->scale);
 
+#ifdef CONFIG_SENSOR_FIFO
+	/* index 9 stands for 5376 Hz in low power mode */
+	lis2dh->odr = (LIS2DH_LP_EN_BIT && LIS2DH_ODR_IDX == LIS2DH_ODR_9) ?
+		      lis2dh_odr_map[LIS2DH_ODR_9 + 1] :
+		      lis2dh_odr_map[LIS2DH_ODR_IDX];
+#endif
+
 	/* enable accel measurements and set power mode and data rate */
 	return lis2dh_reg_write_byte(dev, LIS2DH_REG_CTRL1,
 				     LIS2DH_ACCEL_EN_BITS | LIS2DH_LP_EN_BIT |
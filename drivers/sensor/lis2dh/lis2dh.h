@@ -123,6 +123,8 @@
 #define LIS2DH_REG_CTRL5		0x24
 #define LIS2DH_LIR_INT2_SHIFT		1
 #define LIS2DH_EN_LIR_INT2		BIT(LIS2DH_LIR_INT2_SHIFT)
+#define LIS2DH_FIFO_EN_SHIFT		6
+#define LIS2DH_FIFO_EN_BIT		BIT(LIS2DH_FIFO_EN_SHIFT)
 
 #define LIS2DH_REG_CTRL6		0x25
 #define LIS2DH_EN_INT2_INT2_SHIFT	5
@@ -149,6 +151,18 @@
 #define LIS2DH_REG_ACCEL_Y_MSB		0x2B
 #define LIS2DH_REG_ACCEL_Z_MSB		0x2D
 
+#define LIS2DH_REG_FIFO_CTRL		0x2E
+#define LIS2DH_FIFO_MODE_SHIFT		6
+#define LIS2DH_FIFO_MODE_STREAM		(2 << LIS2DH_FIFO_MODE_SHIFT)
+
+#define LIS2DH_REG_FIFO_SRC		0x2F
+#define LIS2DH_FIFO_OVRN_BIT		BIT(6)
+#define LIS2DH_FIFO_FSS_MASK		BIT_MASK(5)
+
+/* Frames of the X, Y and Z samples */
+#define LIS2DH_FIFO_SIZE		32
+#define LIS2DH_FIFO_FRAME_SIZE		(3 * sizeof(s16_t))
+
 #define LIS2DH_REG_INT1_CFG		0x30
 #define LIS2DH_REG_INT2_CFG		0x34
 #define LIS2DH_AOI_CFG			BIT(7)
@@ -208,6 +222,12 @@ struct lis2dh_data {
 	/* current scaling factor, in micro m/s^2 / lsb */
 	u16_t scale;
 
+#ifdef CONFIG_SENSOR_FIFO
+	/* current output data rate, in Hz */
+	u16_t odr;
+	bool fifo_on;
+#endif
+
 #ifdef CONFIG_LIS2DH_TRIGGER
 	struct device *gpio_int1;
 	struct device *gpio_int2;
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/sensor.h>
+
+void sensor_q15_to_q31(const s16_t *raw, s32_t *out, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		out[i] = (s32_t)raw[i] << 16;
+	}
+}
+
+void sensor_q15_to_micro(const struct sensor_scale *scale, const s16_t *raw,
+			 s32_t *out, size_t count)
+{
+	s32_t range = scale->range;
+	s32_t offset = scale->offset;
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		out[i] = offset + (s32_t)(((s64_t)raw[i] * range) >> 15);
+	}
+}
+
+void sensor_q15_to_value(const struct sensor_scale *scale, const s16_t *raw,
+			 struct sensor_value *out, size_t count)
+{
+	s32_t micro;
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		sensor_q15_to_micro(scale, &raw[i], &micro, 1);
+		out[i].val1 = micro / 1000000;
+		out[i].val2 = micro % 1000000;
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per-controller SPI transaction queue. Each controller in use gets a work
+ * item on the SPI queue thread, which performs the queued transactions
+ * back to back and raises their signals.
+ */
+
+#include <errno.h>
+#include <kernel.h>
+#include <init.h>
+#include <drivers/spi.h>
+
+struct spi_queue {
+	struct device *dev;
+	sys_slist_t txns;
+	struct k_work work;
+};
+
+static struct spi_queue queues[CONFIG_SPI_QUEUE_MAX_BUSES];
+
+static K_THREAD_STACK_DEFINE(spi_queue_stack, CONFIG_SPI_QUEUE_STACK_SIZE);
+static struct k_work_q spi_queue_work_q;
+
+static void queue_process(struct k_work *work)
+{
+	struct spi_queue *queue = CONTAINER_OF(work, struct spi_queue, work);
+	struct spi_txn *txn;
+	sys_snode_t *node;
+	unsigned int key;
+	int ret;
+
+	while (true) {
+		key = irq_lock();
+		node = sys_slist_get(&queue->txns);
+		irq_unlock(key);
+
+		if (!node) {
+			break;
+		}
+
+		txn = CONTAINER_OF(node, struct spi_txn, node);
+		ret = spi_transceive(queue->dev, txn->config, txn->tx_bufs,
+				     txn->rx_bufs);
+		k_poll_signal_raise(txn->signal, ret);
+	}
+}
+
+/* Called with interrupts locked. */
+static struct spi_queue *queue_get(struct device *dev)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(queues); i++) {
+		if (queues[i].dev == dev) {
+			return &queues[i];
+		}
+
+		if (!queues[i].dev) {
+			queues[i].dev = dev;
+			sys_slist_init(&queues[i].txns);
+			k_work_init(&queues[i].work, queue_process);
+			return &queues[i];
+		}
+	}
+
+	return NULL;
+}
+
+int spi_transceive_queued(struct device *dev, struct spi_txn *txn)
+{
+	struct spi_queue *queue;
+	unsigned int key;
+
+	key = irq_lock();
+
+	queue = queue_get(dev);
+	if (queue) {
+		sys_slist_append(&queue->txns, &txn->node);
+	}
+
+	irq_unlock(key);
+
+	if (!queue) {
+		return -ENOMEM;
+	}
+
+	k_work_submit_to_queue(&spi_queue_work_q, &queue->work);
+
+	return 0;
+}
+
+static int spi_queue_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&spi_queue_work_q, spi_queue_stack,
+		       K_THREAD_STACK_SIZEOF(spi_queue_stack),
+		       CONFIG_SPI_QUEUE_THREAD_PRIO);
+
+	return 0;
+}
+
+SYS_INIT(spi_queue_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
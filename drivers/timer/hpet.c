@@ -136,6 +136,24 @@ void z_clock_set_timeout(s32_t ticks, bool idle)
 #endif
 }
 
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+void z_clock_set_cycle_timeout(u32_t cycle)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u32_t now = MAIN_COUNTER_REG;
+
+	if ((s32_t)(cycle - now) < MIN_DELAY) {
+		cycle = now + MIN_DELAY;
+	}
+
+	if ((s32_t)(cycle - TIMER0_COMPARATOR_REG) < 0) {
+		TIMER0_COMPARATOR_REG = cycle;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+#endif
+
 u32_t z_clock_elapsed(void)
 {
 	if (!IS_ENABLED(CONFIG_TICKLESS_KERNEL)) {
@@ -219,6 +219,27 @@ void z_clock_set_timeout(s32_t ticks, bool idle)
 #endif /* CONFIG_TICKLESS_KERNEL */
 }
 
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+void z_clock_set_cycle_timeout(u32_t cycle)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u32_t t = counter();
+	u32_t now = counter_sub(t, last_count) + last_count;
+	s32_t dt = (s32_t)(cycle - now);
+
+	/* As in z_clock_set_timeout(), a comparator three or more
+	 * cycles ahead of the counter is guaranteed to fire.
+	 */
+	dt = MAX(dt, 3);
+
+	if ((u32_t)dt < counter_sub(nrf_rtc_cc_get(RTC, 0), t)) {
+		set_comparator(t + dt);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+#endif
+
 u32_t z_clock_elapsed(void)
 {
 	if (!IS_ENABLED(CONFIG_TICKLESS_KERNEL)) {
@@ -76,6 +76,8 @@ struct eswifi_dev {
 	unsigned int mutex_depth;
 	void *bus_data;
 	struct eswifi_off_socket socket[ESWIFI_OFFLOAD_MAX_SOCKETS];
+	/* Socket selected in the module, -1 if unknown */
+	int selected_socket;
 };
 
 struct eswifi_bus_ops {
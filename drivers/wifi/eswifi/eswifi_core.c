@@ -38,6 +38,8 @@ static struct eswifi_dev eswifi0; /* static instance */
 
 static int eswifi_reset(struct eswifi_dev *eswifi)
 {
+	eswifi->selected_socket = -1;
+
 	gpio_pin_write(eswifi->resetn.dev, eswifi->resetn.pin, 0);
 	k_sleep(10);
 	gpio_pin_write(eswifi->resetn.dev, eswifi->resetn.pin, 1);
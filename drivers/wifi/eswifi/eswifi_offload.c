@@ -22,8 +22,18 @@ LOG_MODULE_REGISTER(wifi_eswifi_offload);
 
 static inline int __select_socket(struct eswifi_dev *eswifi, u8_t idx)
 {
+	int err;
+
+	/* The module keeps the selection, each command costs a round trip */
+	if (eswifi->selected_socket == idx) {
+		return 0;
+	}
+
 	snprintf(eswifi->buf, sizeof(eswifi->buf), "P0=%d\r", idx);
-	return eswifi_at_cmd(eswifi, eswifi->buf);
+	err = eswifi_at_cmd(eswifi, eswifi->buf);
+	eswifi->selected_socket = (err < 0) ? -1 : idx;
+
+	return err;
 }
 
 static int __stop_socket(struct eswifi_dev *eswifi,
@@ -42,13 +52,22 @@ static int __stop_socket(struct eswifi_dev *eswifi,
 	return eswifi_at_cmd(eswifi, socket->is_server ? cmd_srv : cmd_cli);
 }
 
-static int __read_data(struct eswifi_dev *eswifi, size_t len, char **data)
+static int __read_data(struct eswifi_dev *eswifi,
+		       struct eswifi_off_socket *socket, size_t len,
+		       char **data)
 {
 	char cmd[] = "R0\r";
 	char size[] = "R1=9999\r";
 	char timeout[] = "R2=30000\r";
 	int ret;
 
+	/* The read size and timeout are the same for every read, they are
+	 * only set once for each socket.
+	 */
+	if (socket->read_cfg) {
+		return eswifi_at_cmd_rsp(eswifi, cmd, data);
+	}
+
 	/* Set max read size */
 	snprintf(size, sizeof(size), "R1=%u\r", len);
 	ret = eswifi_at_cmd(eswifi, size);
@@ -65,6 +84,8 @@ static int __read_data(struct eswifi_dev *eswifi, size_t len, char **data)
 		return -EIO;
 	}
 
+	socket->read_cfg = true;
+
 	return eswifi_at_cmd_rsp(eswifi, cmd, data);
 }
 
@@ -96,7 +117,7 @@ static void eswifi_off_read_work(struct k_work *work)
 
 	__select_socket(eswifi, socket->index);
 
-	len = __read_data(eswifi, 1460, &data); /* 1460 is max size */
+	len = __read_data(eswifi, socket, 1460, &data); /* 1460 is max size */
 	if (len < 0) {
 		__stop_socket(eswifi, socket);
 		goto done;
@@ -625,6 +646,7 @@ static int eswifi_off_get(sa_family_t family,
 		if (!eswifi->socket[i].context) {
 			socket = &eswifi->socket[i];
 			socket->index = i;
+			socket->read_cfg = false;
 			socket->context = *context;
 			(*context)->offload_context = socket;
 			break;
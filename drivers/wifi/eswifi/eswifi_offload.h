@@ -49,6 +49,7 @@ struct eswifi_off_socket {
 	struct k_sem accept_sem;
 	u16_t port;
 	bool is_server;
+	bool read_cfg;
 	int usage;
 };
 
@@ -35,6 +35,27 @@ void z_arch_configure_static_mpu_regions(void);
  */
 void z_arch_configure_dynamic_mpu_regions(struct k_thread *thread);
 
+#if defined(CONFIG_MPU_DYNAMIC_REGIONS_STATS)
+/**
+ * @brief Dynamic MPU region reprogramming statistics
+ */
+struct z_arm_mpu_stats {
+	/** Number of times the dynamic MPU regions were programmed */
+	u32_t programmed;
+	/** Number of times programming was skipped, the regions being
+	 *  unchanged since the last time
+	 */
+	u32_t skipped;
+};
+
+/**
+ * @brief Get the dynamic MPU region reprogramming statistics
+ *
+ * @param stats Filled with the counts since boot
+ */
+void z_arm_mpu_stats_get(struct z_arm_mpu_stats *stats);
+#endif /* CONFIG_MPU_DYNAMIC_REGIONS_STATS */
+
 #ifdef __cplusplus
 }
 #endif
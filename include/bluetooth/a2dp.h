@@ -10,6 +10,7 @@
 #ifndef ZEPHYR_INCLUDE_BLUETOOTH_A2DP_H_
 #define ZEPHYR_INCLUDE_BLUETOOTH_A2DP_H_
 
+#include <net/buf.h>
 #include <bluetooth/avdtp.h>
 
 #ifdef __cplusplus
@@ -18,7 +19,19 @@ extern "C" {
 
 /** @brief Stream Structure */
 struct bt_a2dp_stream {
-	/* TODO */
+	/** AVDTP stream carrying the media */
+	struct bt_avdtp_stream avdtp;
+	/** Pool of the media packets, with buffers of the transport MTU */
+	struct net_buf_pool *pool;
+	/** Audio samples per channel encoded in each SBC frame */
+	u16_t frame_samples;
+	/* Media packet being filled with SBC frames */
+	struct net_buf *pending;
+	/* SBC frames of the pending packet */
+	u8_t frames;
+	/* RTP timestamp of the pending packet and of the next frame */
+	u32_t ts;
+	u32_t next_ts;
 };
 
 /** @brief Codec ID */
@@ -104,6 +117,62 @@ struct bt_a2dp *bt_a2dp_connect(struct bt_conn *conn);
 int bt_a2dp_register_endpoint(struct bt_a2dp_endpoint *endpoint,
 			      u8_t media_type, u8_t role);
 
+/** @brief Open the media transport of a stream.
+ *
+ *  This function connects the transport channel of a stream, once it has
+ *  been configured and opened with the peer endpoint. The pool and frame
+ *  samples of the stream have to be set beforehand.
+ *
+ *  @param a2dp A2DP connection returned by bt_a2dp_connect().
+ *  @param stream Stream to open.
+ *
+ *  @return 0 in case of success and error code in case of error.
+ */
+int bt_a2dp_stream_connect(struct bt_a2dp *a2dp,
+			   struct bt_a2dp_stream *stream);
+
+/** @brief Close the media transport of a stream.
+ *
+ *  SBC frames not sent yet are dropped.
+ *
+ *  @param stream Stream to close.
+ *
+ *  @return 0 in case of success and error code in case of error.
+ */
+int bt_a2dp_stream_disconnect(struct bt_a2dp_stream *stream);
+
+/** @brief Get room for an SBC frame in the next media packet.
+ *
+ *  SBC frames are batched into media packets of up to the MTU of the
+ *  transport: the encoder writes each frame where this function returns, so
+ *  that the PCM blocks of an audio stream (e.g. those of i2s_read()) are
+ *  encoded straight into the packets sent to the controller. The pending
+ *  packet is sent first when it does not have room for the frame.
+ *
+ *  @param stream Stream to send the frame on.
+ *  @param len Length of the SBC frame.
+ *  @param timeout Time to wait for a media packet buffer.
+ *
+ *  @return Room for @a len bytes, or NULL if no buffer was available in
+ *  time, the frame is larger than the MTU or sending the pending packet
+ *  failed.
+ */
+u8_t *bt_a2dp_sbc_frame_alloc(struct bt_a2dp_stream *stream, size_t len,
+			      s32_t timeout);
+
+/** @brief Send the pending media packet.
+ *
+ *  Sends the SBC frames added to the stream since the last media packet,
+ *  e.g. before pausing the audio. This waits for the controller to
+ *  complete an earlier packet of the stream when
+ *  CONFIG_BT_AVDTP_MEDIA_TX_COUNT of them are in flight.
+ *
+ *  @param stream Stream to send the packet on.
+ *
+ *  @return 0 in case of success and error code in case of error.
+ */
+int bt_a2dp_sbc_flush(struct bt_a2dp_stream *stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,8 @@
 #ifndef ZEPHYR_INCLUDE_BLUETOOTH_AVDTP_H_
 #define ZEPHYR_INCLUDE_BLUETOOTH_AVDTP_H_
 
+#include <bluetooth/l2cap.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,15 +40,46 @@ struct bt_avdtp_seid_lsep {
 	struct bt_avdtp_seid_lsep *next;
 };
 
+/** @def BT_AVDTP_MEDIA_HDR_SIZE
+ *  @brief Size of the RTP header of the media packets
+ */
+#define BT_AVDTP_MEDIA_HDR_SIZE 12
+
+/** @def BT_AVDTP_MEDIA_SEND_RESERVE
+ *  @brief Headroom needed for outgoing media packets
+ */
+#define BT_AVDTP_MEDIA_SEND_RESERVE (BT_L2CAP_CHAN_SEND_RESERVE + \
+				     BT_AVDTP_MEDIA_HDR_SIZE)
+
 /** @brief AVDTP Stream */
 struct bt_avdtp_stream {
 	struct bt_l2cap_br_chan chan; /* Transport Channel*/
 	struct bt_avdtp_seid_info lsep; /* Configured Local SEP */
 	struct bt_avdtp_seid_info rsep; /* Configured Remote SEP*/
 	u8_t state; /* current state of the stream */
+	u16_t seq; /* RTP sequence number of the next media packet */
+	struct k_sem tx_sem; /* Media packets which may still be sent */
 	struct bt_avdtp_stream *next;
 };
 
+/** @brief Send a media packet on a stream
+ *
+ *  Prepends the RTP header to the media payload of @a buf, which needs
+ *  BT_AVDTP_MEDIA_SEND_RESERVE bytes of headroom, and sends it on the
+ *  transport channel of the stream. At most CONFIG_BT_AVDTP_MEDIA_TX_COUNT
+ *  packets of the stream are waiting for the controller to complete them,
+ *  this waits for one of them to complete beyond that.
+ *
+ *  @param stream Stream with an open transport channel.
+ *  @param buf Media payload, unreferenced once sent.
+ *  @param timestamp RTP timestamp of the payload, in samples.
+ *
+ *  @return 0 in case of success, or a negative error code in which case
+ *  @a buf still belongs to the caller.
+ */
+int bt_avdtp_media_send(struct bt_avdtp_stream *stream, struct net_buf *buf,
+			u32_t timestamp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -182,6 +182,41 @@ struct bt_conn_info {
  */
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 
+/** @brief ACL transmit statistics of a connection */
+struct bt_conn_tx_stats {
+	/** Packets waiting in the host for a controller buffer */
+	u16_t queued;
+	/** Highest number of packets waiting in the host */
+	u16_t queued_max;
+	/** ACL packets sent to the controller and not completed yet */
+	u16_t pending;
+	/** ACL packets completed by the controller */
+	u32_t completed;
+	/** Average time in milliseconds the controller took to complete
+	 *  an ACL packet
+	 */
+	u32_t latency_avg;
+	/** Longest time in milliseconds the controller took to complete
+	 *  an ACL packet
+	 */
+	u32_t latency_max;
+};
+
+/** @brief Get ACL transmit statistics of a connection
+ *
+ *  Requires CONFIG_BT_CONN_TX_STATS. The ACL packets of the connections
+ *  take turns for the controller buffers, so a connection with many
+ *  queued packets and a low latency is waiting for the other connections
+ *  rather than for its peer.
+ *
+ *  @param conn Connection object.
+ *  @param stats Statistics object.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_conn_get_tx_stats(const struct bt_conn *conn,
+			 struct bt_conn_tx_stats *stats);
+
 /** @brief Update the connection parameters.
  *
  *  @param conn Connection object.
@@ -813,6 +813,46 @@ struct bt_gatt_notify_params {
 int bt_gatt_notify_cb(struct bt_conn *conn,
 		      struct bt_gatt_notify_params *params);
 
+/** @brief Notify multiple attribute value changes.
+ *
+ *  Send the notifications of several attribute value changes to the given
+ *  connection. If the peer has enabled Multiple Handle Value Notifications
+ *  in its Client Supported Features, consecutive values are packed in
+ *  Multiple Handle Value Notification PDUs up to the ATT MTU, otherwise
+ *  each value is sent with @ref bt_gatt_notify_cb.
+ *
+ *  When values are packed, only the callback of the last parameters of each
+ *  PDU is called, once that PDU has been sent. Setting a callback allows
+ *  several PDUs to be queued to the connection. In case of error, the values
+ *  which have not been sent yet are dropped.
+ *
+ *  @param conn Connection object.
+ *  @param num_params Number of notification parameters.
+ *  @param params Array of notification parameters.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_gatt_notify_multiple(struct bt_conn *conn, u16_t num_params,
+			    struct bt_gatt_notify_params *params);
+
+/** Notification statistics */
+struct bt_gatt_notify_stats {
+	/** Number of values notified */
+	u32_t notifications;
+	/** Number of ATT PDUs sent */
+	u32_t pdus;
+	/** Number of ATT PDU bytes sent */
+	u32_t bytes;
+};
+
+/** @brief Get the notification statistics.
+ *
+ *  Only available with CONFIG_BT_GATT_NOTIFY_MULTIPLE.
+ *
+ *  @param stats Statistics to be filled.
+ */
+void bt_gatt_notify_stats_get(struct bt_gatt_notify_stats *stats);
+
 /** @brief Notify attribute value change.
  *
  *  Send notification of attribute value change, if connection is NULL notify
@@ -915,6 +955,25 @@ int bt_gatt_indicate(struct bt_conn *conn,
  */
 u16_t bt_gatt_get_mtu(struct bt_conn *conn);
 
+/** @brief Connect Enhanced ATT bearers
+ *
+ *  Connect additional ATT bearers to the peer over L2CAP credit based
+ *  channels. The requests to the peer, and the indications to it, are then
+ *  spread over the connected bearers, so they may complete in a different
+ *  order than they were sent in. Only the bearers with an MTU at least equal
+ *  to the one of the connection are used. Requests queued once all bearers
+ *  are busy are sent on the first bearer which becomes available.
+ *
+ *  Only available with CONFIG_BT_EATT. The bearers require the connection
+ *  to be encrypted, the security is elevated if needed.
+ *
+ *  @param conn Connection object.
+ *  @param num Number of bearers to connect.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_gatt_eatt_connect(struct bt_conn *conn, u8_t num);
+
 /** @} */
 
 /**
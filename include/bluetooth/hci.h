@@ -1955,6 +1955,30 @@ typedef bool bt_hci_vnd_evt_cb_t(struct net_buf_simple *buf);
   */
 int bt_hci_register_vnd_evt_cb(bt_hci_vnd_evt_cb_t cb);
 
+/** Number of buckets of the HCI event queueing delay histograms */
+#define BT_HCI_RX_DELAY_BUCKETS 8
+
+/** @brief Queueing delay of the HCI events received from the controller.
+  *
+  * Bucket 0 counts the events which waited less than 1 ms for the RX
+  * thread, bucket n the ones which waited from 2^(n-1) to 2^n - 1 ms and
+  * the last bucket the ones which waited longer.
+  */
+struct bt_hci_rx_delay_stats {
+	/** Disconnection Complete and LE connection events */
+	u32_t conn_evt[BT_HCI_RX_DELAY_BUCKETS];
+	/** Other events */
+	u32_t evt[BT_HCI_RX_DELAY_BUCKETS];
+};
+
+/** Get the queueing delay histograms of the HCI events.
+  *
+  * Requires CONFIG_BT_RX_DELAY_STATS.
+  *
+  * @param stats Histograms of the events received since bt_enable().
+  */
+void bt_hci_get_rx_delay_stats(struct bt_hci_rx_delay_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -129,6 +129,39 @@ struct bt_hci_cp_vs_set_scan_req_reports {
 	u8_t  enable;
 } __packed;
 
+#define BT_HCI_OP_VS_READ_CONN_AUTO_UPDATE      BT_OP(BT_OGF_VS, 0x000e)
+struct bt_hci_cp_vs_read_conn_auto_update {
+	u16_t handle;
+} __packed;
+
+struct bt_hci_rp_vs_read_conn_auto_update {
+	u8_t  status;
+	u16_t handle;
+	u8_t  tx_phy;
+	u8_t  rx_phy;
+	u16_t max_tx_octets;
+	u16_t max_rx_octets;
+	s8_t  rssi;
+	u8_t  crc_err_pct;
+	u8_t  phy_upd_count;
+} __packed;
+
+#define BT_HCI_OP_VS_READ_MAYFLY_STATS          BT_OP(BT_OGF_VS, 0x000f)
+struct bt_hci_vs_mayfly_stats {
+	u32_t run_count;
+	u32_t latency_max_us;
+	u32_t latency_last_us;
+	u16_t depth;
+	u16_t depth_max;
+	u16_t yield_count;
+} __packed;
+
+struct bt_hci_rp_vs_read_mayfly_stats {
+	u8_t   status;
+	u8_t   num_callees;
+	struct bt_hci_vs_mayfly_stats s[0];
+} __packed;
+
 /* Events */
 
 struct bt_hci_evt_vs {
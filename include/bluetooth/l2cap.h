@@ -132,6 +132,8 @@ struct bt_l2cap_le_chan {
 	/** Segment SDU packet from upper layer */
 	struct net_buf			*_sdu;
 	u16_t				_sdu_len;
+	/** Credits returned but not given to the remote yet */
+	u16_t				_rx_credits;
 };
 
 /** @def BT_L2CAP_LE_CHAN(_ch)
@@ -206,7 +208,10 @@ struct bt_l2cap_chan_ops {
 	/** Channel alloc_buf callback
 	 *
 	 *  If this callback is provided the channel will use it to allocate
-	 *  buffers to store incoming data.
+	 *  buffers to store incoming data. Otherwise an SDU received in
+	 *  several segments is passed as the chain of the buffers the segments
+	 *  were received in, and the receive MTU is limited to what the
+	 *  initial credits allow.
 	 *
 	 *  @param chan The channel requesting a buffer.
 	 *
@@ -361,6 +366,9 @@ int bt_l2cap_chan_disconnect(struct bt_l2cap_chan *chan);
  *
  *  Send data from buffer to the channel. If credits are not available, buf will
  *  be queued and sent as and when credits are received from peer.
+ *  Fragments of buf, other than the first one, which fit in a segment and
+ *  have BT_L2CAP_CHAN_SEND_RESERVE bytes of headroom are sent without being
+ *  copied.
  *  Regarding to first input parameter, to get details see reference description
  *  to bt_l2cap_chan_connect() API above.
  *
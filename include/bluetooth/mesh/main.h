@@ -300,6 +300,16 @@ int bt_mesh_suspend(void);
  */
 int bt_mesh_resume(void);
 
+/** @brief Write the pending Replay Protection List updates to storage.
+ *
+ *  RPL updates are written to storage in batches, at most
+ *  CONFIG_BT_MESH_RPL_STORE_TIMEOUT seconds after a change. This API writes
+ *  them right away, e.g. when a power failure is imminent, so that the
+ *  messages received meanwhile cannot be replayed to the node after it has
+ *  restarted. bt_mesh_suspend() does this as well.
+ */
+void bt_mesh_rpl_flush(void);
+
 /** @brief Provision the local Mesh Node.
  *
  *  This API should normally not be used directly by the application. The
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Control blocks of the CMSIS-RTOS v2 objects
+ *
+ * Applications passing their own control block memory in the cb_mem
+ * field of an object's attributes size it with these types, e.g.
+ * sizeof(struct cv2_thread) for osThreadNew().
+ */
+
+#ifndef ZEPHYR_INCLUDE_CMSIS_RTOS_V2_CMSIS_TYPES_H_
+#define ZEPHYR_INCLUDE_CMSIS_RTOS_V2_CMSIS_TYPES_H_
+
+#include <kernel.h>
+#include <cmsis_os2.h>
+
+struct cv2_thread {
+	sys_dnode_t node;
+	struct k_thread z_thread;
+	struct k_poll_signal poll_signal;
+	struct k_poll_event poll_event;
+	u32_t signal_results;
+	char name[16];
+	u32_t attr_bits;
+	struct k_sem join_guard;
+	char has_joined;
+};
+
+struct cv2_timer {
+	struct k_timer z_timer;
+	osTimerType_t type;
+	u32_t status;
+	char name[16];
+	void (*callback_function)(void *argument);
+	void *arg;
+	char is_cb_dynamic_allocation;
+};
+
+struct cv2_mutex {
+	struct k_mutex z_mutex;
+	char name[16];
+	u32_t state;
+	char is_cb_dynamic_allocation;
+};
+
+struct cv2_sem {
+	struct k_sem z_semaphore;
+	char name[16];
+	char is_cb_dynamic_allocation;
+};
+
+struct cv2_mslab {
+	struct k_mem_slab z_mslab;
+	void *pool;
+	char is_dynamic_allocation;
+	char is_cb_dynamic_allocation;
+	char name[16];
+};
+
+struct cv2_msgq {
+	struct k_msgq z_msgq;
+	void *pool;
+	char is_dynamic_allocation;
+	char is_cb_dynamic_allocation;
+	char name[16];
+};
+
+struct cv2_event_flags {
+	struct k_event z_event;
+	char name[16];
+	char is_cb_dynamic_allocation;
+};
+
+#endif /* ZEPHYR_INCLUDE_CMSIS_RTOS_V2_CMSIS_TYPES_H_ */
@@ -634,6 +634,143 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 		    const void *val, json_append_bytes_t append_bytes,
 		    void *data);
 
+/**
+ * @brief Encodes an object through a small staging buffer
+ *
+ * The output is collected in @p buffer and handed to @p flush whenever
+ * the buffer is full, and once more at the end, so that the writer sees
+ * a few large writes instead of one per token. Unlike
+ * json_obj_encode_buf(), the encoded object does not have to fit in the
+ * buffer, and there is no need to measure it first with
+ * json_calc_encoded_len().
+ *
+ * @param descr Pointer to the descriptor array
+ *
+ * @param descr_len Number of elements in the descriptor array
+ *
+ * @param val Struct holding the values
+ *
+ * @param buffer Staging buffer
+ *
+ * @param buf_size Size of the staging buffer, in bytes
+ *
+ * @param flush Function writing out the staged bytes
+ *
+ * @param data Data pointer to be passed to the flush callback function.
+ *
+ * @return 0 if object has been successfully encoded. A negative value
+ * indicates an error.
+ */
+int json_obj_encode_stream(const struct json_obj_descr *descr,
+			   size_t descr_len, const void *val,
+			   char *buffer, size_t buf_size,
+			   json_append_bytes_t flush, void *data);
+
+/**
+ * @brief Function pointer type called by the streaming parser for each
+ * value and container boundary.
+ *
+ * @param token JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END,
+ * JSON_TOK_LIST_START, JSON_TOK_LIST_END, JSON_TOK_STRING,
+ * JSON_TOK_NUMBER, JSON_TOK_TRUE, JSON_TOK_FALSE or JSON_TOK_NULL
+ *
+ * @param key NUL terminated name of the object member the value or
+ * container belongs to, NULL for array elements, the top-level value
+ * and container ends
+ *
+ * @param value NUL terminated text of a string (without the quotes and
+ * with escape sequences left as is), number or literal token, NULL for
+ * container boundaries
+ *
+ * @param len Length of @p value
+ *
+ * @param data User-provided pointer
+ *
+ * @return 0 to continue parsing, or a negative number to stop (which
+ * will be propagated to the return value of json_stream_parse()).
+ */
+typedef int (*json_stream_cb_t)(enum json_tokens token, const char *key,
+				const char *value, size_t len, void *data);
+
+/** Maximum nesting depth supported by the streaming parser */
+#define JSON_STREAM_MAX_DEPTH 32
+
+/**
+ * @brief Streaming JSON parser state
+ *
+ * The fields are private, use json_stream_parser_init() to set them up.
+ */
+struct json_stream_parser {
+	json_stream_cb_t cb;
+	void *data;
+
+	/* holds the current key, followed by the current value */
+	char *buf;
+	size_t buf_size;
+	size_t len;
+	size_t key_len;
+
+	/* bit set for each nesting level that is an object */
+	u32_t objects;
+	u8_t depth;
+
+	u8_t state;
+	u8_t expect;
+	u8_t token;
+	u8_t aux;
+	int error;
+};
+
+/**
+ * @brief Prepares a streaming parser for a new document
+ *
+ * @param parser Parser to initialize
+ *
+ * @param buffer Buffer for the key and value being parsed. It must be
+ * large enough for the longest key plus the longest value, plus two
+ * terminating NUL characters.
+ *
+ * @param buf_size Size of buffer, in bytes
+ *
+ * @param cb Function called for each token
+ *
+ * @param data Data pointer to be passed to the cb callback function.
+ */
+void json_stream_parser_init(struct json_stream_parser *parser,
+			     char *buffer, size_t buf_size,
+			     json_stream_cb_t cb, void *data);
+
+/**
+ * @brief Feeds the next part of a document to a streaming parser
+ *
+ * Chunks may be split anywhere, including in the middle of a token; the
+ * parser does not keep references to them.
+ *
+ * @param parser Parser set up by json_stream_parser_init()
+ *
+ * @param chunk Next bytes of the document
+ *
+ * @param len Number of bytes in @p chunk
+ *
+ * @return 0 if the chunk was parsed, -EINVAL on invalid JSON, -ENOMEM
+ * if a key and value do not fit in the parser buffer, -ENOSPC if the
+ * document is nested deeper than JSON_STREAM_MAX_DEPTH, or the error
+ * returned by the callback. Once an error is returned, every later
+ * call returns it as well.
+ */
+int json_stream_parse(struct json_stream_parser *parser, const char *chunk,
+		      size_t len);
+
+/**
+ * @brief Tells a streaming parser that the document is complete
+ *
+ * @param parser Parser set up by json_stream_parser_init()
+ *
+ * @return 0 if exactly one complete value was parsed, a negative error
+ * code otherwise.
+ */
+int json_stream_parse_end(struct json_stream_parser *parser);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <sys/base64.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,11 +47,8 @@ struct jwt_builder {
 	 */
 	bool overflowed;
 
-	/* Pending bytes yet to be converted to base64. */
-	unsigned char wip[3];
-
-	/* Number of pending bytes. */
-	int pending;
+	/* Base64url encoder of the current section. */
+	struct base64_stream enc;
 };
 
 /**
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PC_SAMPLER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PC_SAMPLER_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start sampling the program counter of the running thread.
+ *
+ * A sample is taken on every system clock tick and counted in the bin of
+ * 2^CONFIG_TRACING_PC_SAMPLER_BIN_SHIFT bytes of code it falls into.
+ * Samples taken so far are kept.
+ */
+void pc_sampler_start(void);
+
+/**
+ * @brief Stop sampling, keeping the samples taken so far.
+ */
+void pc_sampler_stop(void);
+
+/**
+ * @brief Drop all samples.
+ */
+void pc_sampler_reset(void);
+
+/**
+ * @brief Print the samples with printk().
+ *
+ * One "pc_sampler: <address> <count>" line is printed for every bin that
+ * was hit, followed by the total number of samples and the number of
+ * samples lost because the table was full. The output of a profiling run
+ * is turned into a relocation profile by scripts/gen_relocate_profile.py.
+ */
+void pc_sampler_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PC_SAMPLER_H_ */
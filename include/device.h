@@ -30,6 +30,12 @@ extern "C" {
 
 #define Z_DEVICE_MAX_NAME_LEN	48
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define Z_DEVICE_INIT_PRIO(prio) .init_prio = (prio),
+#else
+#define Z_DEVICE_INIT_PRIO(prio)
+#endif
+
 /**
  * @def DEVICE_INIT
  *
@@ -105,6 +111,7 @@ extern "C" {
 	static struct device_config _CONCAT(__config_, dev_name) __used	  \
 	__attribute__((__section__(".devconfig.init"))) = {		  \
 		.name = drv_name, .init = (init_fn),			  \
+		Z_DEVICE_INIT_PRIO(prio)				  \
 		.config_info = (cfg_info)				  \
 	};								  \
 	static Z_DECL_ALIGN(struct device) _CONCAT(__device_, dev_name) __used \
@@ -162,6 +169,7 @@ extern "C" {
 		.name = drv_name, .init = (init_fn),			  \
 		.device_pm_control = (pm_control_fn),			  \
 		.pm  = &_CONCAT(__pm_, dev_name),                         \
+		Z_DEVICE_INIT_PRIO(prio)				  \
 		.config_info = (cfg_info)				  \
 	};								  \
 	static Z_DECL_ALIGN(struct device) _CONCAT(__device_, dev_name) __used \
@@ -235,6 +243,10 @@ typedef void (*device_pm_cb)(struct device *dev,
  * @param fsm_state device idle internal power state
  * @param event event object to listen to the sync request events
  * @param signal signal to notify the Async API callers
+ * @param parent device which must be active while this one is
+ * @param parent_held whether this device holds a usage count on its parent
+ * @param autosuspend_work delayed suspend after the last asynchronous put
+ * @param autosuspend_delay delay before suspending, in milliseconds
  */
 struct device_pm {
 	struct device *dev;
@@ -245,6 +257,14 @@ struct device_pm {
 	struct k_work work;
 	struct k_poll_event event;
 	struct k_poll_signal signal;
+#ifdef CONFIG_DEVICE_IDLE_PM
+	struct device *parent;
+	bool parent_held;
+#endif
+#ifdef CONFIG_DEVICE_IDLE_PM_AUTOSUSPEND
+	struct k_delayed_work autosuspend_work;
+	s32_t autosuspend_delay;
+#endif
 };
 
 /**
@@ -252,6 +272,7 @@ struct device_pm {
  *
  * @param name name of the device
  * @param init init function for the driver
+ * @param init_prio initialization priority within the level
  * @param config_info address of driver instance config information
  */
 struct device_config {
@@ -261,6 +282,9 @@ struct device_config {
 	int (*device_pm_control)(struct device *device, u32_t command,
 				 void *context, device_pm_cb cb, void *arg);
 	struct device_pm *pm;
+#endif
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	u8_t init_prio;
 #endif
 	const void *config_info;
 };
@@ -271,15 +295,51 @@ struct device_config {
  * @param driver_api pointer to structure containing the API functions for
  * the device type. This pointer is filled in by the driver at init time.
  * @param driver_data driver instance data. For driver use only
+ * @param init_cycles time spent in the init function, in cycles
  */
 struct device {
 	struct device_config *config;
 	const void *driver_api;
 	void *driver_data;
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	u32_t init_cycles;
+#endif
+#ifdef CONFIG_DEVICE_NAME_HASH
+	struct device *name_next;
+#endif
 };
 
 void z_sys_device_do_config_level(s32_t level);
 
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+/**
+ * @brief Get the time a device took to initialize
+ *
+ * Also available for SYS_INIT() entries, which are devices without name.
+ * Entries running before the system timer is initialized may read as 0.
+ *
+ * @param dev Device
+ *
+ * @return Cycles spent in the init function of the device
+ */
+static inline u32_t device_init_cycles_get(struct device *dev)
+{
+	return dev->init_cycles;
+}
+
+/**
+ * @brief Get the time an initialization level took
+ *
+ * With CONFIG_DEVICE_INIT_PARALLEL this is less than the sum of the
+ * device init times of the level.
+ *
+ * @param level One of the _SYS_INIT_LEVEL_* values
+ *
+ * @return Cycles from the start to the end of the level
+ */
+u32_t device_init_level_cycles_get(s32_t level);
+#endif
+
 /**
  * @brief Retrieve the device structure for a driver by name
  *
@@ -288,6 +348,11 @@ void z_sys_device_do_config_level(s32_t level);
  * it can use this function to retrieve the device structure of the lower level
  * driver by the name the driver exposes to the system.
  *
+ * Code which knows the dev_name of a device object gets it in constant time
+ * with DEVICE_GET(). Lookups by name are cheapest with the name string the
+ * device was defined with, e.g. its devicetree label macro, and do not scan
+ * all the devices with CONFIG_DEVICE_NAME_HASH.
+ *
  * @param name device name to search for.
  *
  * @return pointer to device structure; NULL if not found or cannot be used.
@@ -581,6 +646,37 @@ int device_pm_put(struct device *dev);
  * @retval Errno Negative errno code if failure.
  */
 int device_pm_put_sync(struct device *dev);
+
+/**
+ * @brief Set the parent of a device
+ *
+ * Called by a device driver, typically one on a bus, before enabling
+ * device idle PM. The parent is resumed before the device is and is
+ * released once the device is suspended, so a bus stays powered only
+ * while one of its devices is in use. The parent must have device idle
+ * PM enabled too.
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param parent Pointer to device structure of the parent, NULL for none.
+ */
+void device_pm_parent_set(struct device *dev, struct device *parent);
+
+#ifdef CONFIG_DEVICE_IDLE_PM_AUTOSUSPEND
+/**
+ * @brief Set the autosuspend delay of a device
+ *
+ * When the last user releases the device with device_pm_put(), the
+ * device is only suspended if it is not used again within the delay,
+ * which saves suspend and resume cycles between close transactions.
+ * device_pm_put_sync() still suspends at once.
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param delay_ms Delay in milliseconds, 0 to suspend at once.
+ */
+void device_pm_autosuspend_set(struct device *dev, s32_t delay_ms);
+#endif
 #else
 static inline void device_pm_enable(struct device *dev) { }
 static inline void device_pm_disable(struct device *dev) { }
@@ -588,6 +684,8 @@ static inline int device_pm_get(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_get_sync(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_put(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_put_sync(struct device *dev) { return -ENOTSUP; }
+static inline void device_pm_parent_set(struct device *dev,
+					struct device *parent) { }
 #endif
 
 #endif
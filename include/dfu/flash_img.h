@@ -10,6 +10,10 @@
 
 #include <storage/flash_map.h>
 
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+#include <tinycrypt/sha256.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -22,6 +26,12 @@ struct flash_img_context {
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 	off_t off_last;
 #endif
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+	struct tc_sha256_state_struct sha;
+	/* Bytes covered by the image hash, 0 if there's no image header */
+	size_t hash_len;
+	size_t hashed;
+#endif
 };
 
 /**
@@ -62,6 +72,41 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, u8_t *data,
 		    size_t len, bool flush);
 
+#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+/**
+ * @brief Initialize context to resume writing an image.
+ *
+ * Writing resumes at the start of the flash sector @p offset belongs
+ * to, which is erased again: data might have been written past the
+ * given offset by the interrupted writer. With
+ * CONFIG_IMG_ENABLE_HASH_CHECK, the part of the image before it is
+ * read back to compute its hash.
+ *
+ * @param ctx context to be initialized
+ * @param offset bytes of the image known to be written
+ * @return  0 on success, negative errno code on fail. The offset
+ *          writing resumes at is given by flash_img_bytes_written().
+ */
+int flash_img_resume(struct flash_img_context *ctx, size_t offset);
+#endif
+
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+/**
+ * @brief Check the hash of the image written
+ *
+ * Compares the SHA-256 hash of the image computed while it was written
+ * with the hash in the MCUboot TLVs of the image.  To be called after
+ * the final call to flash_img_buffered_write().
+ *
+ * @param ctx context
+ *
+ * @return  0 if the hash matches, -EBADMSG if it doesn't, -EINVAL if
+ *          no MCUboot image was written, -ENOENT if the image has no
+ *          hash, other negative errno code on flash access fail
+ */
+int flash_img_check(struct flash_img_context *ctx);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,7 @@
 #define ZEPHYR_INCLUDE_DRIVERS_ADC_H_
 
 #include <device.h>
+#include <errno.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -291,6 +292,62 @@ typedef int (*adc_api_read_async)(struct device *dev,
 				  struct k_poll_signal *async);
 #endif
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Type definition of the callback of continuous sampling.
+ *
+ * Called from the ADC interrupt each time a half of the ring buffer has been
+ * filled. The half has to be consumed before the hardware gets back to it,
+ * that is within the time it takes to fill the other half.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param data      The half of the ring buffer just filled.
+ * @param size      Size of the half, in bytes.
+ * @param user_data User data given in struct adc_stream_cfg.
+ */
+typedef void (*adc_stream_callback)(struct device *dev, const void *data,
+				    size_t size, void *user_data);
+
+/**
+ * @brief Structure defining continuous sampling.
+ */
+struct adc_stream_cfg {
+	/** Sampling rate, in Hz. */
+	u32_t rate;
+
+	/** Callback called for every half of the ring buffer filled. */
+	adc_stream_callback callback;
+
+	/** User data passed to the callback. */
+	void *user_data;
+
+	/**
+	 * Counter pacing the conversions, or NULL for the timer of the ADC.
+	 *
+	 * Channel 0 of the counter triggers the conversions in hardware,
+	 * see counter_set_channel_trigger(). Its top value is set to the
+	 * sampling period and it runs only while sampling.
+	 */
+	struct device *counter;
+};
+
+/**
+ * @brief Type definition of ADC API function for starting continuous
+ *        sampling.
+ * See adc_stream_start() for argument descriptions.
+ */
+typedef int (*adc_api_stream_start)(struct device *dev,
+				    const struct adc_sequence *sequence,
+				    const struct adc_stream_cfg *cfg);
+
+/**
+ * @brief Type definition of ADC API function for stopping continuous
+ *        sampling.
+ * See adc_stream_stop() for argument descriptions.
+ */
+typedef int (*adc_api_stream_stop)(struct device *dev);
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief ADC driver API
  *
@@ -301,6 +358,10 @@ struct adc_driver_api {
 	adc_api_read          read;
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
+#endif
+#ifdef CONFIG_ADC_STREAM
+	adc_api_stream_start  stream_start;
+	adc_api_stream_stop   stream_stop;
 #endif
 	u16_t ref_internal;	/* mV */
 };
@@ -395,6 +456,66 @@ static inline int z_impl_adc_read_async(struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Start continuous sampling.
+ *
+ * Conversions are triggered by a hardware timer at the requested rate and
+ * written by DMA to the buffer of @p sequence, used as a ring of two halves.
+ * There is one interrupt per half of the buffer, not per sample. Sampling
+ * goes on until adc_stream_stop() is called, and the ADC cannot be used for
+ * other reads meanwhile.
+ *
+ * The options field of @p sequence must be NULL. Drivers may support
+ * several channels only when a counter paces the conversions.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param sequence  Channels, resolution, oversampling and ring buffer.
+ * @param cfg       Rate and callback. Must stay valid until the sampling is
+ *                  stopped.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided.
+ * @retval -ENOMEM  If the buffer cannot hold two halves.
+ * @retval -ENOTSUP If the driver does not support continuous sampling.
+ */
+static inline int adc_stream_start(struct device *dev,
+				   const struct adc_sequence *sequence,
+				   const struct adc_stream_cfg *cfg)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->driver_api;
+
+	if (api->stream_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_start(dev, sequence, cfg);
+}
+
+/**
+ * @brief Stop continuous sampling.
+ *
+ * The half of the ring buffer being filled is discarded.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ *
+ * @retval 0        On success.
+ * @retval -EALREADY If no continuous sampling is running.
+ */
+static inline int adc_stream_stop(struct device *dev)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->driver_api;
+
+	if (api->stream_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_stop(dev);
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief Get the internal reference voltage.
  *
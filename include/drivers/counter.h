@@ -152,6 +152,22 @@ struct counter_top_cfg {
 	u32_t flags;
 };
 
+/** @brief Hardware trigger configuration structure.
+ *
+ * @param ticks	Counter value at which the channel triggers the task, on
+ *		every turnaround of the counter: the counter top value sets
+ *		the period (see @ref counter_set_top_value). It cannot exceed
+ *		the top value.
+ * @param task	Implementation-specific identifier of the task triggered,
+ *		e.g. on nRF the address of a task register (SAADC SAMPLE,
+ *		SPIM START, GPIOTE OUT...), connected to the compare event
+ *		with a PPI or DPPI channel.
+ */
+struct counter_trigger_cfg {
+	u32_t ticks;
+	u32_t task;
+};
+
 /** @brief Structure with generic counter features.
  *
  * @param max_top_value Maximal (default) top value on which counter is reset
@@ -184,6 +200,9 @@ typedef u32_t (*counter_api_get_guard_period)(struct device *dev, u32_t flags);
 typedef int (*counter_api_set_guard_period)(struct device *dev, u32_t ticks,
 						u32_t flags);
 typedef void *(*counter_api_get_user_data)(struct device *dev);
+typedef int (*counter_api_set_trigger)(struct device *dev, u8_t chan_id,
+				const struct counter_trigger_cfg *trigger_cfg);
+typedef int (*counter_api_cancel_trigger)(struct device *dev, u8_t chan_id);
 
 struct counter_driver_api {
 	counter_api_start start;
@@ -198,6 +217,8 @@ struct counter_driver_api {
 	counter_api_get_guard_period get_guard_period;
 	counter_api_set_guard_period set_guard_period;
 	counter_api_get_user_data get_user_data;
+	counter_api_set_trigger set_trigger;
+	counter_api_cancel_trigger cancel_trigger;
 };
 
 
@@ -406,6 +427,70 @@ static inline int counter_cancel_channel_alarm(struct device *dev,
 	return api->cancel_alarm(dev, chan_id);
 }
 
+/**
+ * @brief Trigger a hardware task periodically from a channel.
+ *
+ * The compare event of the channel is connected to the task in hardware, so
+ * that the task is triggered on every period of the counter without any
+ * interrupt: acquisitions are started with the accuracy of the counter
+ * clock, not of the interrupt latency. Several channels can trigger tasks
+ * of different peripherals at different offsets within the period.
+ *
+ * The channel cannot be used for alarms until the trigger is cancelled.
+ *
+ * @note API is not thread safe.
+ *
+ * @param dev		Pointer to the device structure for the driver instance.
+ * @param chan_id	Channel ID.
+ * @param trigger_cfg	Trigger configuration.
+ *
+ * @retval 0 If successful.
+ * @retval -ENOTSUP if the device or the channel cannot trigger tasks.
+ * @retval -EINVAL if trigger settings are invalid.
+ * @retval -EBUSY if the channel is in use.
+ * @retval -ENOMEM if no hardware channel is left to connect the task.
+ */
+static inline int counter_set_channel_trigger(struct device *dev,
+			u8_t chan_id,
+			const struct counter_trigger_cfg *trigger_cfg)
+{
+	const struct counter_driver_api *api =
+				(struct counter_driver_api *)dev->driver_api;
+
+	if ((api->set_trigger == NULL) ||
+	    (chan_id >= counter_get_num_of_channels(dev))) {
+		return -ENOTSUP;
+	}
+
+	return api->set_trigger(dev, chan_id, trigger_cfg);
+}
+
+/**
+ * @brief Cancel a hardware trigger on a channel.
+ *
+ * @note API is not thread safe.
+ *
+ * @param dev		Pointer to the device structure for the driver instance.
+ * @param chan_id	Channel ID.
+ *
+ * @retval 0 If successful.
+ * @retval -ENOTSUP if the device or the channel cannot trigger tasks.
+ * @retval -EALREADY if the channel was not triggering a task.
+ */
+static inline int counter_cancel_channel_trigger(struct device *dev,
+						  u8_t chan_id)
+{
+	const struct counter_driver_api *api =
+				(struct counter_driver_api *)dev->driver_api;
+
+	if ((api->cancel_trigger == NULL) ||
+	    (chan_id >= counter_get_num_of_channels(dev))) {
+		return -ENOTSUP;
+	}
+
+	return api->cancel_trigger(dev, chan_id);
+}
+
 /**
  * @brief Set counter top value.
  *
@@ -274,6 +274,94 @@ static inline size_t z_impl_flash_get_write_block_size(struct device *dev)
 	return api->write_block_size;
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+struct flash_async_req;
+
+/**
+ * @brief Completion callback of an asynchronous flash operation.
+ *
+ * Called from the flash work queue thread.
+ *
+ * @param req    The completed request
+ * @param result 0 on success, negative errno code of the operation on fail
+ */
+typedef void (*flash_async_cb_t)(struct flash_async_req *req, int result);
+
+/**
+ * @brief Asynchronous flash operation.
+ *
+ * Set @a cb and/or @a signal before starting the operation.  The other
+ * fields are filled in by the flash_*_async() functions.  The request
+ * and the buffer it refers to must stay valid until the operation
+ * completes.
+ */
+struct flash_async_req {
+	/** Called on completion, may be NULL */
+	flash_async_cb_t cb;
+	/** Raised with the result on completion, may be NULL */
+	struct k_poll_signal *signal;
+
+	/* Internal */
+	struct k_work work;
+	struct device *dev;
+	off_t offset;
+	void *data;
+	size_t len;
+	u8_t op;
+};
+
+/**
+ *  @brief  Read data from flash asynchronously
+ *
+ *  Operations are run one by one, in the order they are started, by a
+ *  dedicated thread.  This lets the caller overlap slow flash operations
+ *  with other work.  Not available from user mode.
+ *
+ *  @param  dev    : flash device
+ *  @param  offset : Offset (byte aligned) to read
+ *  @param  data   : Buffer to store read data
+ *  @param  len    : Number of bytes to read.
+ *  @param  req    : Request describing how to report completion
+ *
+ *  @return  0 if the operation is queued, -EBUSY if @a req is in use.
+ */
+int flash_read_async(struct device *dev, off_t offset, void *data,
+		     size_t len, struct flash_async_req *req);
+
+/**
+ *  @brief  Write buffer into flash memory asynchronously
+ *
+ *  See flash_write() for the requirements on @a offset and @a len, and
+ *  flash_read_async() for how the operation is run.
+ *
+ *  @param  dev    : flash device
+ *  @param  offset : starting offset for the write
+ *  @param  data   : data to write
+ *  @param  len    : Number of bytes to write
+ *  @param  req    : Request describing how to report completion
+ *
+ *  @return  0 if the operation is queued, -EBUSY if @a req is in use.
+ */
+int flash_write_async(struct device *dev, off_t offset, const void *data,
+		      size_t len, struct flash_async_req *req);
+
+/**
+ *  @brief  Erase part or all of a flash memory asynchronously
+ *
+ *  See flash_erase() for the requirements on @a offset and @a size, and
+ *  flash_read_async() for how the operation is run.
+ *
+ *  @param  dev    : flash device
+ *  @param  offset : erase area starting offset
+ *  @param  size   : size of area to be erased
+ *  @param  req    : Request describing how to report completion
+ *
+ *  @return  0 if the operation is queued, -EBUSY if @a req is in use.
+ */
+int flash_erase_async(struct device *dev, off_t offset, size_t size,
+		      struct flash_async_req *req);
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
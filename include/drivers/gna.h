@@ -60,16 +60,25 @@ struct gna_model_info {
 
 /**
  * Request to perform inference on the given neural network model
+ *
+ * The input holds @a frames input vectors back to back, the output
+ * receives as many output vectors. The frames are inferred one after the
+ * other, without returning to the application in between.
  */
 struct gna_inference_req {
 	void *model_handle;
 	void *input;
 	void *output;
 	void *intermediate;
+	/** Number of input frames, 0 for a single one */
+	u32_t frames;
+	/** Signal raised with the gna_result when there is no callback */
+	struct k_poll_signal *signal;
 };
 
 /**
- * Statistics of the inference operation returned after completion
+ * Statistics of the inference operation returned after completion,
+ * summed over the frames of the request
  */
 struct gna_inference_stats {
 	u32_t total_cycles;
@@ -190,9 +199,20 @@ static inline int gna_deregister_model(struct device *dev, void *model)
  * input data vector
  * A callback is provided for notification of inference completion
  *
+ * Requests are queued while the device is busy, up to
+ * CONFIG_INTEL_GNA_MAX_PENDING_REQUESTS, and started as soon as the one
+ * before is complete. The input and output buffers must stay valid until
+ * then.
+ *
+ * Without a callback, the k_poll signal of the request is raised from the
+ * interrupt with the gna_result instead, so that a thread can wait for the
+ * completion of several requests with k_poll(). The statistics are not
+ * reported then.
+ *
  * @param dev Pointer to the device structure for the driver instance.
  * @param req Information required to perform inference on a neural network
- * @param callback A callback function to notify inference completion
+ * @param callback A callback function to notify inference completion, or
+ * NULL to raise the signal of the request
  *
  * @retval 0 If the request is accepted
  * @retval A negative error code in case of a failure.
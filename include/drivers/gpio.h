@@ -109,6 +109,11 @@ typedef int (*gpio_disable_callback_t)(struct device *port,
 				       int access_op,
 				       u32_t pin);
 typedef u32_t (*gpio_api_get_pending_int)(struct device *dev);
+typedef int (*gpio_port_set_masked_t)(struct device *port, u32_t mask,
+				      u32_t value);
+typedef int (*gpio_port_set_bits_t)(struct device *port, u32_t pins);
+typedef int (*gpio_port_clear_bits_t)(struct device *port, u32_t pins);
+typedef int (*gpio_port_toggle_bits_t)(struct device *port, u32_t pins);
 
 struct gpio_driver_api {
 	gpio_config_t config;
@@ -118,6 +123,10 @@ struct gpio_driver_api {
 	gpio_enable_callback_t enable_callback;
 	gpio_disable_callback_t disable_callback;
 	gpio_api_get_pending_int get_pending_int;
+	gpio_port_set_masked_t port_set_masked;
+	gpio_port_set_bits_t port_set_bits;
+	gpio_port_clear_bits_t port_clear_bits;
+	gpio_port_toggle_bits_t port_toggle_bits;
 };
 
 __syscall int gpio_config(struct device *port, int access_op, u32_t pin,
@@ -435,6 +444,168 @@ static inline int z_impl_gpio_get_pending_int(struct device *dev)
 	return api->get_pending_int(dev);
 }
 
+/**
+ * @brief Set the output of several pins of the port at once.
+ *
+ * The pins in @p mask take the state of the matching bit in @p value,
+ * the other pins keep theirs. Drivers update the port with interrupts
+ * locked or a single register write, so the pins change together.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param mask Pins to update, pin 0 is the least significant bit.
+ * @param value New state of the pins in @p mask.
+ * @return 0 if successful, -ENOTSUP if the driver lacks port operations.
+ */
+__syscall int gpio_port_set_masked(struct device *port, u32_t mask,
+				   u32_t value);
+
+/**
+ * @internal
+ */
+static inline int z_impl_gpio_port_set_masked(struct device *port,
+					      u32_t mask, u32_t value)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+
+	if (api->port_set_masked == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->port_set_masked(port, mask, value);
+}
+
+/**
+ * @brief Set several output pins of the port at once.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param pins Pins to set, pin 0 is the least significant bit.
+ * @return 0 if successful, -ENOTSUP if the driver lacks port operations.
+ */
+__syscall int gpio_port_set_bits(struct device *port, u32_t pins);
+
+/**
+ * @internal
+ */
+static inline int z_impl_gpio_port_set_bits(struct device *port, u32_t pins)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+
+	if (api->port_set_bits == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->port_set_bits(port, pins);
+}
+
+/**
+ * @brief Clear several output pins of the port at once.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param pins Pins to clear, pin 0 is the least significant bit.
+ * @return 0 if successful, -ENOTSUP if the driver lacks port operations.
+ */
+__syscall int gpio_port_clear_bits(struct device *port, u32_t pins);
+
+/**
+ * @internal
+ */
+static inline int z_impl_gpio_port_clear_bits(struct device *port, u32_t pins)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+
+	if (api->port_clear_bits == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->port_clear_bits(port, pins);
+}
+
+/**
+ * @brief Toggle several output pins of the port at once.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param pins Pins to toggle, pin 0 is the least significant bit.
+ * @return 0 if successful, -ENOTSUP if the driver lacks port operations.
+ */
+__syscall int gpio_port_toggle_bits(struct device *port, u32_t pins);
+
+/**
+ * @internal
+ */
+static inline int z_impl_gpio_port_toggle_bits(struct device *port, u32_t pins)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+
+	if (api->port_toggle_bits == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->port_toggle_bits(port, pins);
+}
+
+#ifdef CONFIG_GPIO_EDGE_QUEUE
+/**
+ * @brief Edge event stored by a GPIO edge queue
+ */
+struct gpio_edge_event {
+	/** Cycle count when the interrupt was handled, see k_cycle_get_32() */
+	u32_t timestamp;
+
+	/** Pins that triggered the interrupt */
+	u32_t pins;
+
+	/** Level of the whole port when the interrupt was handled */
+	u32_t level;
+};
+
+/**
+ * @brief GPIO edge queue
+ *
+ * Stores a struct gpio_edge_event in a message queue for every interrupt
+ * of the selected pins, from the interrupt handler. The consumer takes
+ * the events from the message queue at its own pace.
+ */
+struct gpio_edge_queue {
+	/** Registered on the port, see gpio_edge_queue_add() */
+	struct gpio_callback callback;
+
+	/** Message queue of struct gpio_edge_event items */
+	struct k_msgq *msgq;
+
+	/** Number of events lost because the message queue was full */
+	u32_t dropped;
+};
+
+/**
+ * @brief Start queueing the interrupts of some pins of a port.
+ *
+ * The pins must be configured to trigger an interrupt and their callback
+ * enabled, as for any callback.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param queue Edge queue, must not be allocated on the stack.
+ * @param msgq Message queue with items of struct gpio_edge_event.
+ * @param pin_mask Pins to queue the interrupts of.
+ * @return 0 if successful, negative errno code on failure.
+ */
+int gpio_edge_queue_add(struct device *port, struct gpio_edge_queue *queue,
+			struct k_msgq *msgq, u32_t pin_mask);
+
+/**
+ * @brief Stop queueing the interrupts.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param queue Edge queue added with gpio_edge_queue_add().
+ * @return 0 if successful, negative errno code on failure.
+ */
+int gpio_edge_queue_remove(struct device *port,
+			   struct gpio_edge_queue *queue);
+#endif /* CONFIG_GPIO_EDGE_QUEUE */
+
 struct gpio_pin_config {
 	char *gpio_controller;
 	u32_t gpio_pin;
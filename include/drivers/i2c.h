@@ -21,6 +21,7 @@
 
 #include <zephyr/types.h>
 #include <device.h>
+#include <sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -1019,6 +1020,44 @@ __deprecated static inline int i2c_reg_update_addr(struct device *dev,
 	return i2c_transfer(dev, msg, 2, dev_addr);
 }
 
+#ifdef CONFIG_I2C_QUEUE
+/**
+ * @brief I2C transaction for the per-controller transaction queue.
+ *
+ * The structure, the messages and the signal must stay valid until the
+ * signal is raised.
+ */
+struct i2c_txn {
+	/** Used by the queue */
+	sys_snode_t node;
+	/** Messages, as for i2c_transfer() */
+	struct i2c_msg *msgs;
+	/** Number of messages */
+	u8_t num_msgs;
+	/** Address of the I2C target device */
+	u16_t addr;
+	/** Raised with the result of the transfer */
+	struct k_poll_signal *signal;
+};
+
+/**
+ * @brief Queue a transaction on an I2C controller.
+ *
+ * Transactions queued on a controller are performed in order, back to back,
+ * from the I2C queue thread. Completion of each is reported by raising its
+ * signal with the value i2c_transfer() returned, so a caller can queue the
+ * reads of several devices on the bus and wait for all of them with one
+ * k_poll() call.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param txn Transaction to perform.
+ *
+ * @retval 0 If the transaction was queued.
+ * @retval -ENOMEM If CONFIG_I2C_QUEUE_MAX_BUSES controllers are in use.
+ */
+int i2c_transfer_queued(struct device *dev, struct i2c_txn *txn);
+#endif /* CONFIG_I2C_QUEUE */
+
 struct i2c_client_config {
 	char *i2c_master;
 	u16_t i2c_addr;
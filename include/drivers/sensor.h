@@ -316,11 +316,80 @@ typedef int (*sensor_channel_get_t)(struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
 
+/**
+ * @brief Scale of the raw samples of a channel.
+ *
+ * Raw samples are 16-bit two's complement values, the q15 fraction of the
+ * full scale range: a raw sample r stands for offset + r * range / 2^15.
+ */
+struct sensor_scale {
+	/** Full scale range, in millionths of the channel unit */
+	s32_t range;
+	/** Value of a zero raw sample, in millionths of the channel unit */
+	s32_t offset;
+};
+
+/**
+ * @typedef sensor_scale_get_t
+ * @brief Callback API for getting the scale of the raw samples of a channel
+ *
+ * See sensor_channel_scale_get() for argument description
+ */
+typedef int (*sensor_scale_get_t)(struct device *dev,
+				  enum sensor_channel chan,
+				  struct sensor_scale *scale);
+
+#ifdef CONFIG_SENSOR_FIFO
+/**
+ * @brief Block of raw frames read from the FIFO of a sensor.
+ *
+ * A frame holds one sample of every channel the FIFO stores, in the format
+ * of the hardware. Frames are converted on demand with sensor_frame_get().
+ */
+struct sensor_fifo_block {
+	/** Frames, oldest first */
+	u8_t *frames;
+	/** Number of frames */
+	u16_t num_frames;
+	/** Size of a frame in bytes */
+	u8_t frame_size;
+	/** Samples were lost since the previous read */
+	bool overrun;
+	/** k_cycle_get_32() when the block was read, time of the last frame */
+	u32_t timestamp;
+	/** Sampling period, in hardware cycles */
+	u32_t period;
+};
+
+/**
+ * @typedef sensor_fifo_read_t
+ * @brief Callback API for reading the FIFO of a sensor
+ *
+ * See sensor_fifo_read() for argument description
+ */
+typedef int (*sensor_fifo_read_t)(struct device *dev, u8_t *buf, size_t size,
+				  struct sensor_fifo_block *block);
+/**
+ * @typedef sensor_frame_decode_t
+ * @brief Callback API for converting a channel of a raw frame
+ *
+ * See sensor_frame_get() for argument description
+ */
+typedef int (*sensor_frame_decode_t)(struct device *dev, const u8_t *frame,
+				     enum sensor_channel chan,
+				     struct sensor_value *val);
+#endif /* CONFIG_SENSOR_FIFO */
+
 struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+	sensor_scale_get_t scale_get;
+#ifdef CONFIG_SENSOR_FIFO
+	sensor_fifo_read_t fifo_read;
+	sensor_frame_decode_t frame_decode;
+#endif
 };
 
 /**
@@ -473,6 +542,143 @@ static inline int z_impl_sensor_channel_get(struct device *dev,
 	return api->channel_get(dev, chan, val);
 }
 
+/**
+ * @brief Get the scale of the raw samples of a channel
+ *
+ * The scale applies to the raw samples of the frames read with
+ * sensor_fifo_read() and may change when the full scale attribute is set.
+ * Arrays of raw samples are converted with sensor_q15_to_micro() and the
+ * other batch helpers.
+ *
+ * @param dev Pointer to the sensor device
+ * @param chan The channel
+ * @param scale Where to store the scale
+ *
+ * @return 0 if successful, -ENOTSUP if the driver does not publish scales,
+ * negative errno code if failure.
+ */
+static inline int sensor_channel_scale_get(struct device *dev,
+					   enum sensor_channel chan,
+					   struct sensor_scale *scale)
+{
+	const struct sensor_driver_api *api = dev->driver_api;
+
+	if (api->scale_get == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->scale_get(dev, chan, scale);
+}
+
+/**
+ * @brief Convert raw q15 samples to q31.
+ *
+ * The output keeps the fraction of the full scale range, in the format
+ * expected by fixed-point DSP code.
+ *
+ * @param raw Raw samples
+ * @param out Where to store the converted samples
+ * @param count Number of samples
+ */
+void sensor_q15_to_q31(const s16_t *raw, s32_t *out, size_t count);
+
+/**
+ * @brief Convert raw q15 samples to millionths of the channel unit.
+ *
+ * There is one multiplication and no division per sample.
+ *
+ * @param scale Scale of the samples
+ * @param raw Raw samples
+ * @param out Where to store the converted samples
+ * @param count Number of samples
+ */
+void sensor_q15_to_micro(const struct sensor_scale *scale, const s16_t *raw,
+			 s32_t *out, size_t count);
+
+/**
+ * @brief Convert raw q15 samples to struct sensor_value.
+ *
+ * @param scale Scale of the samples
+ * @param raw Raw samples
+ * @param out Where to store the converted samples
+ * @param count Number of samples
+ */
+void sensor_q15_to_value(const struct sensor_scale *scale, const s16_t *raw,
+			 struct sensor_value *out, size_t count);
+
+#ifdef CONFIG_SENSOR_FIFO
+/**
+ * @brief Read the hardware FIFO of a sensor in bulk
+ *
+ * Moves as many whole frames as fit in @p buf out of the sensor FIFO with
+ * a single bus transfer, without converting them. Call it when the FIFO
+ * watermark trigger fires, or periodically, instead of fetching every
+ * sample.
+ *
+ * @param dev Pointer to the sensor device
+ * @param buf Where to store the frames
+ * @param size Size of @p buf in bytes
+ * @param block Filled in with the description of the frames read
+ *
+ * @return 0 if successful, -ENOTSUP if the sensor has no FIFO, negative
+ * errno code if failure.
+ */
+static inline int sensor_fifo_read(struct device *dev, u8_t *buf, size_t size,
+				   struct sensor_fifo_block *block)
+{
+	const struct sensor_driver_api *api = dev->driver_api;
+
+	if (api->fifo_read == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->fifo_read(dev, buf, size, block);
+}
+
+/**
+ * @brief Convert a channel of a frame read by sensor_fifo_read()
+ *
+ * Vectorial channels are returned as for sensor_channel_get().
+ *
+ * @param dev Pointer to the sensor device
+ * @param block Block the frame belongs to
+ * @param idx Index of the frame in the block
+ * @param chan The channel to convert
+ * @param val Where to store the value
+ *
+ * @return 0 if successful, negative errno code if failure.
+ */
+static inline int sensor_frame_get(struct device *dev,
+				   const struct sensor_fifo_block *block,
+				   u16_t idx, enum sensor_channel chan,
+				   struct sensor_value *val)
+{
+	const struct sensor_driver_api *api = dev->driver_api;
+
+	if (idx >= block->num_frames) {
+		return -EINVAL;
+	}
+
+	return api->frame_decode(dev, &block->frames[idx * block->frame_size],
+				 chan, val);
+}
+
+/**
+ * @brief Get the time a frame read by sensor_fifo_read() was sampled
+ *
+ * @param block Block the frame belongs to
+ * @param idx Index of the frame in the block
+ *
+ * @return Time of the sample, in hardware cycles.
+ */
+static inline u32_t sensor_frame_timestamp(
+	const struct sensor_fifo_block *block, u16_t idx)
+{
+	return block->timestamp -
+	       (u32_t)(block->num_frames - 1U - idx) * block->period;
+}
+#endif /* CONFIG_SENSOR_FIFO */
+
 /**
  * @brief The value of gravitational constant in micro m/s^2.
  */
@@ -22,6 +22,7 @@
 #include <zephyr/types.h>
 #include <stddef.h>
 #include <device.h>
+#include <sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -412,6 +413,44 @@ static inline int z_impl_spi_release(struct device *dev,
 	return api->release(dev, config);
 }
 
+#ifdef CONFIG_SPI_QUEUE
+/**
+ * @brief SPI transaction for the per-controller transaction queue.
+ *
+ * The structure, the configuration, the buffers and the signal must stay
+ * valid until the signal is raised.
+ */
+struct spi_txn {
+	/** Used by the queue */
+	sys_snode_t node;
+	/** Configuration, as for spi_transceive() */
+	const struct spi_config *config;
+	/** Buffers to send, may be NULL */
+	const struct spi_buf_set *tx_bufs;
+	/** Buffers to receive into, may be NULL */
+	const struct spi_buf_set *rx_bufs;
+	/** Raised with the result of the transfer */
+	struct k_poll_signal *signal;
+};
+
+/**
+ * @brief Queue a transaction on a SPI controller.
+ *
+ * Transactions queued on a controller are performed in order, back to back,
+ * from the SPI queue thread. Completion of each is reported by raising its
+ * signal with the value spi_transceive() returned, so a caller can queue
+ * the reads of several devices on the bus and wait for all of them with
+ * one k_poll() call.
+ *
+ * @param dev Pointer to the device structure for the driver instance
+ * @param txn Transaction to perform
+ *
+ * @retval 0 If the transaction was queued.
+ * @retval -ENOMEM If CONFIG_SPI_QUEUE_MAX_BUSES controllers are in use.
+ */
+int spi_transceive_queued(struct device *dev, struct spi_txn *txn);
+#endif /* CONFIG_SPI_QUEUE */
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,23 @@ extern int z_clock_device_ctrl(struct device *device, u32_t ctrl_command,
  */
 extern void z_clock_set_timeout(s32_t ticks, bool idle);
 
+/**
+ * @brief Bring the next timer interrupt forward to a cycle count
+ *
+ * Implemented by drivers that select CONFIG_TIMER_HAS_CYCLE_TIMEOUT,
+ * and called by the kernel right after z_clock_set_timeout() (and
+ * whenever a new high-resolution timeout becomes the earliest one)
+ * when CONFIG_SYS_CLOCK_HR_TIMEOUT is enabled.  If the interrupt
+ * currently programmed would arrive later than the given cycle, the
+ * driver moves it to that cycle, or as soon after it as the hardware
+ * allows; otherwise nothing changes.  The interrupt then calls
+ * z_clock_announce() as usual, with the number of whole ticks elapsed,
+ * which may be zero.
+ *
+ * @param cycle Absolute expiry time in units of k_cycle_get_32()
+ */
+extern void z_clock_set_cycle_timeout(u32_t cycle);
+
 /**
  * @brief Timer idle exit notification
  *
@@ -76,6 +76,22 @@ struct fcb_entry_ctx {
 	/**< Flash area where the entry is placed */
 };
 
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+/**
+ * @brief FCB sector summary structure. It holds what is known in RAM
+ * about the elements of a sector, so they need not be checked again.
+ */
+struct fcb_sector_summary {
+	u32_t fss_checked_off;
+	/**< Offset up to which all the elements of the sector have been
+	 * checked and found valid.
+	 */
+
+	u16_t fss_elem_cnt;
+	/**< Number of elements before fss_checked_off. */
+};
+#endif
+
 /**
  * @brief FCB instance structure
  *
@@ -101,6 +117,13 @@ struct fcb {
 	struct flash_sector *f_sectors;
 	/**< Array of sectors, must be contiguous */
 
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+	struct fcb_sector_summary *f_summary;
+	/**< Optional array of f_sector_cnt sector summaries, filled in by
+	 * FCB. Walks only read the length of the elements already checked.
+	 */
+#endif
+
 	/* Flash circular buffer internal state */
 	struct k_mutex f_mtx;
 	/**< Locking for accessing the FCB data, internal state */
@@ -173,6 +196,20 @@ int fcb_init(int f_area_id, struct fcb *fcb);
  */
 int fcb_append(struct fcb *fcb, u16_t len, struct fcb_entry *loc);
 
+/**
+ * Appends several entries to circular buffer, with their data. The entries
+ * are written one after the other, no other entry is appended in between.
+ * The entries do not need to be finished with fcb_append_finish().
+ * @param[in] fcb FCB instance structure.
+ * @param[in] data Array of pointers to the data of the entries.
+ * @param[in] len Array of lengths of the entries.
+ * @param[in] cnt Number of entries.
+ * @return Number of entries appended, which is cnt unless the FCB became
+ * full, or negative FCB error code if none could be appended.
+ */
+int fcb_append_batch(struct fcb *fcb, const void *const *data,
+		     const u16_t *len, int cnt);
+
 /**
  * Finishes entry append operation.
  *
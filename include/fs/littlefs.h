@@ -33,10 +33,21 @@ struct fs_littlefs {
 	 */
 	u32_t *lookahead_buffer[CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE / sizeof(u32_t)];
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	/* Customizable before mount.  Time in milliseconds fs_sync() may
+	 * delay committing a file, zero to commit it immediately.
+	 */
+	s32_t sync_delay;
+#endif
+
 	/* These structures are filled automatically at mount. */
 	struct lfs lfs;
 	const struct flash_area *area;
 	struct k_mutex mutex;
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	struct k_delayed_work sync_work;
+	sys_slist_t sync_files;
+#endif
 };
 
 /** @brief Define a littlefs configuration with customized size
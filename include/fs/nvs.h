@@ -43,6 +43,13 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Address of the most recent ate for every id hash
+ * @param gc_work Background garbage collection work
+ * @param gc_addr Next allocation table entry to garbage collect
+ * @param gc_stop_addr Last allocation table entry to garbage collect
+ * @param gc_reserve Space kept free in the write sector for the garbage
+ * collection
+ * @param gc_pending Is a background garbage collection ongoing ?
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -57,6 +64,16 @@ struct nvs_fs {
 
 	struct k_mutex nvs_lock;
 	struct device *flash_device;
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	u32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+	struct k_work gc_work;
+	u32_t gc_addr;		/* next ate to garbage collect */
+	u32_t gc_stop_addr;	/* last ate to garbage collect */
+	u32_t gc_reserve;	/* space the garbage collection may need */
+	bool gc_pending;	/* is a garbage collection ongoing ? */
+#endif
 };
 
 /**
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Shared memory message rings between cores
+ */
+
+#ifndef ZEPHYR_INCLUDE_IPC_IPC_RING_H_
+#define ZEPHYR_INCLUDE_IPC_IPC_RING_H_
+
+#include <kernel.h>
+#include <device.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief IPC ring APIs
+ * @defgroup ipc_ring IPC ring
+ * @{
+ *
+ * An IPC ring passes variable sized messages between two cores through
+ * memory both of them can access. Each side writes messages into its own
+ * transmit ring and reads the messages of its peer in place, from the
+ * peer's transmit ring. An IPM device notifies the peer, only when its
+ * receive ring goes from empty to non-empty: a burst of messages costs a
+ * single interrupt however long it is.
+ *
+ * Each ring has a single producer and a single consumer. Callers sending
+ * from several threads must serialize their calls, and so must callers
+ * processing from several threads. The shared memory must not be cached,
+ * or be kept coherent between the cores by the hardware.
+ */
+
+/** Bytes taken in a ring by the header of each message. */
+#define IPC_RING_MSG_HDR_SIZE 4
+
+/** Bytes of a ring taken by a message of a given size. */
+#define IPC_RING_MSG_SIZE(len) \
+	(IPC_RING_MSG_HDR_SIZE + ROUND_UP(len, sizeof(u32_t)))
+
+/** @brief Layout of a transmit ring in shared memory. */
+struct ipc_ring_shm {
+	/** Offset of the next message to write, only the producer writes it */
+	atomic_t head;
+	/** Offset of the next message to read, only the consumer writes it */
+	atomic_t tail;
+	/** Messages */
+	u32_t data[];
+};
+
+struct ipc_ring;
+
+/**
+ * @typedef ipc_ring_cb_t
+ * @brief Callback for each received message.
+ *
+ * The message is read in place in shared memory, and may not be accessed
+ * once the callback returns: its space is then given back to the sender.
+ *
+ * @param ring Ring the message was received on.
+ * @param data Message data.
+ * @param len Message size in bytes.
+ * @param user_data User data given to ipc_ring_init().
+ */
+typedef void (*ipc_ring_cb_t)(struct ipc_ring *ring, const void *data,
+			      size_t len, void *user_data);
+
+/** @brief IPC ring endpoint, all fields are private */
+struct ipc_ring {
+	struct ipc_ring_shm *tx;
+	struct ipc_ring_shm *rx;
+	u32_t tx_size;
+	u32_t rx_size;
+	struct device *ipm;
+	ipc_ring_cb_t cb;
+	void *user_data;
+	struct k_sem rx_sem;
+	/* Message being written, from ipc_ring_alloc() to ipc_ring_commit() */
+	u32_t alloc_off;
+	u32_t alloc_len;
+	bool alloc_wrap;
+};
+
+/**
+ * @brief Initialize one side of an IPC ring.
+ *
+ * The transmit ring is reset, both cores must therefore initialize their
+ * side before the peer sends to them. The memory given as transmit ring on
+ * one core is the receive ring of the other.
+ *
+ * @param ring IPC ring endpoint.
+ * @param ipm IPM device notifying the peer, and notified by it.
+ * @param tx_mem Shared memory the messages are sent in, aligned on 4 bytes.
+ * @param tx_size Size of @a tx_mem in bytes.
+ * @param rx_mem Shared memory the messages are received from.
+ * @param rx_size Size of @a rx_mem in bytes.
+ * @param cb Callback for each received message.
+ * @param user_data User data passed to @a cb.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL The memory is misaligned or too small for a ring.
+ */
+int ipc_ring_init(struct ipc_ring *ring, struct device *ipm,
+		  void *tx_mem, size_t tx_size, void *rx_mem, size_t rx_size,
+		  ipc_ring_cb_t cb, void *user_data);
+
+/**
+ * @brief Allocate a message in the transmit ring.
+ *
+ * The caller writes the message directly in shared memory, then sends it
+ * with ipc_ring_commit(). Only one message can be allocated at a time.
+ *
+ * @param ring IPC ring endpoint.
+ * @param len Size of the message in bytes.
+ *
+ * @return Message buffer, or NULL if the ring has no room for it.
+ */
+void *ipc_ring_alloc(struct ipc_ring *ring, size_t len);
+
+/**
+ * @brief Send the message allocated by ipc_ring_alloc().
+ *
+ * The peer is notified if it had no other message to read.
+ *
+ * @param ring IPC ring endpoint.
+ * @param len Size of the message in bytes, at most the allocated size.
+ *
+ * @retval 0 Success.
+ * @retval -EIO The peer could not be notified.
+ */
+int ipc_ring_commit(struct ipc_ring *ring, size_t len);
+
+/**
+ * @brief Copy a message into the transmit ring and send it.
+ *
+ * @param ring IPC ring endpoint.
+ * @param data Message data.
+ * @param len Size of the message in bytes.
+ *
+ * @retval 0 Success.
+ * @retval -ENOMEM The ring has no room for the message.
+ * @retval -EIO The peer could not be notified.
+ */
+int ipc_ring_send(struct ipc_ring *ring, const void *data, size_t len);
+
+/**
+ * @brief Receive the messages sent by the peer.
+ *
+ * Calls the ring callback for each message in the receive ring, waiting
+ * for the peer to send if there is none.
+ *
+ * @param ring IPC ring endpoint.
+ * @param timeout Time to wait for a message (in milliseconds), or one of
+ *                the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages received, or -EAGAIN if none was received.
+ */
+int ipc_ring_process(struct ipc_ring *ring, s32_t timeout);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_IPC_IPC_RING_H_ */
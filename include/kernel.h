@@ -85,6 +85,15 @@ extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 #define Z_WAIT_Q_INIT(wait_q) { { { .lessthan_fn = z_priq_rb_lessthan } } }
 
+#elif defined(CONFIG_WAITQ_BITMAP)
+
+typedef struct {
+	struct _priq_bm waitq;
+} _wait_q_t;
+
+#define Z_WAIT_Q_INIT(wait_q) \
+	{ { .list = SYS_DLIST_STATIC_INIT(&(wait_q)->waitq.list) } }
+
 #else
 
 typedef struct {
@@ -343,6 +352,62 @@ static inline void k_obj_free(void *obj)
 /* LCOV_EXCL_STOP */
 #endif /* CONFIG_DYNAMIC_OBJECTS */
 
+/**
+ * @brief System call descriptor for k_syscall_batch()
+ */
+struct k_syscall_entry {
+	/** System call ID, one of the K_SYSCALL_* values */
+	u32_t id;
+	/** Arguments, in the order the system call takes them */
+	u32_t arg[6];
+	/** Return value of the system call, set by k_syscall_batch() */
+	u32_t ret;
+};
+
+/**
+ * @brief Statically initialize a k_syscall_entry
+ *
+ * Arguments must be cast to u32_t, e.g.
+ * K_SYSCALL_ENTRY(K_SYSCALL_K_SEM_GIVE, (u32_t)&my_sem).
+ *
+ * @param id_ System call ID
+ */
+#define K_SYSCALL_ENTRY(id_, ...) { .id = (id_), .arg = { __VA_ARGS__ } }
+
+/**
+ * Run several system calls in a single trap
+ *
+ * Each entry is verified and run in order exactly as if the calling user
+ * thread had made that system call itself, including any argument
+ * validation failure terminating the thread, but with only one privilege
+ * transition for the whole batch. The return value of each call is stored
+ * in its entry.
+ *
+ * Blocking calls are allowed and block the rest of the batch. Batches
+ * can't be nested.
+ *
+ * @param entries Array of system call descriptors
+ * @param count Number of entries
+ * @retval 0 All entries were run
+ * @retval -EPERM Called from supervisor mode, which has no use for
+ *         batching since it calls kernel functions directly
+ * @retval -ENOSYS User mode not supported (CONFIG_USERSPACE disabled)
+ */
+__syscall int k_syscall_batch(struct k_syscall_entry *entries, size_t count);
+
+#ifndef CONFIG_USERSPACE
+/* LCOV_EXCL_START */
+static inline int z_impl_k_syscall_batch(struct k_syscall_entry *entries,
+					 size_t count)
+{
+	ARG_UNUSED(entries);
+	ARG_UNUSED(count);
+
+	return -ENOSYS;
+}
+/* LCOV_EXCL_STOP */
+#endif /* !CONFIG_USERSPACE */
+
 /** @} */
 
 /* Using typedef deliberately here, this is quite intended to be an opaque
@@ -447,6 +512,11 @@ struct _thread_base {
 
 	u32_t order_key;
 
+#if defined(CONFIG_SCHED_BITMAP) || defined(CONFIG_WAITQ_BITMAP)
+	/* priority index the thread was queued under in a bitmap priq */
+	u16_t priq_index;
+#endif
+
 #ifdef CONFIG_SMP
 	/* True for the per-CPU idle threads */
 	u8_t is_idle;
@@ -459,6 +529,11 @@ struct _thread_base {
 
 #endif
 
+#ifdef CONFIG_SCHED_PERCPU_RUNQ
+	/* CPU whose run queue holds the thread while it is queued */
+	u8_t runq_cpu;
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 	/* "May run on" bits for each CPU */
 	u8_t cpu_mask;
@@ -493,6 +568,80 @@ struct _thread_stack_info {
 typedef struct _thread_stack_info _thread_stack_info_t;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#if defined(CONFIG_TRACING_CPU_STATS_LATENCY)
+/* Ready to run delay of a thread, kept by the CPU stats tracer */
+struct _thread_latency {
+	/* Cycle count when the thread was last made ready */
+	u32_t ready_stamp;
+
+	/* Worst delay between being made ready and running, in cycles */
+	u32_t ready_max;
+
+	/* Made ready and not switched in since */
+	bool ready_pending;
+};
+#endif /* CONFIG_TRACING_CPU_STATS_LATENCY */
+
+#if defined(CONFIG_TRACING_CPU_STATS_THREADS)
+/* Run time accounting of a thread, kept by the CPU stats tracer */
+struct _thread_runtime {
+	/* Cycles spent running and spent ready but not running */
+	u64_t exec_cycles;
+	u64_t ready_cycles;
+
+	/* Times switched in, and switched out while still ready */
+	u32_t switches;
+	u32_t preemptions;
+
+	/* Cycle count when last switched in or resumed from an interrupt */
+	u32_t run_stamp;
+
+	/* Cycle count when last made ready */
+	u32_t ready_stamp;
+
+	/* Made ready and not switched in since */
+	bool ready_pending;
+};
+#endif /* CONFIG_TRACING_CPU_STATS_THREADS */
+
+#if defined(CONFIG_DYNAMIC_OBJECTS_CACHE)
+struct _k_object;
+
+/* Dynamic kernel objects recently looked up by a thread */
+struct _thread_obj_cache {
+	/* Value of the dynamic object free counter the entries are valid
+	 * for, the whole cache is dropped when it changes
+	 */
+	atomic_val_t gen;
+
+	/* Entry to replace next */
+	u8_t next;
+
+	struct {
+		void *obj;
+		struct _k_object *ko;
+	} entry[CONFIG_DYNAMIC_OBJECTS_CACHE_SIZE];
+};
+#endif /* CONFIG_DYNAMIC_OBJECTS_CACHE */
+
+#if defined(CONFIG_SCHED_DEADLINE_CBS)
+/* CPU budget reservation, see k_thread_cbs_set() */
+struct _thread_cbs {
+	/* Reservation period and budget in ticks, budget 0 if none */
+	s32_t period;
+	s32_t budget;
+
+	/* Budget left in the current period, in ticks */
+	s32_t left;
+
+	/* End of the current period, in absolute ticks */
+	s64_t deadline;
+
+	/* Periods in which the thread ran out of budget */
+	u32_t overruns;
+};
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #if defined(CONFIG_USERSPACE)
 struct _mem_domain_info {
 	/* memory domain queue node */
@@ -504,8 +653,14 @@ struct _mem_domain_info {
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
+struct sys_mutex;
+
 struct _thread_userspace_local_data {
 	int errno_var;
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+	/* sys_mutexes the kernel checked the thread has access to */
+	struct sys_mutex *sys_mutexes[CONFIG_SYS_MUTEX_USER_CACHE_SIZE];
+#endif
 };
 #endif
 
@@ -563,6 +718,21 @@ struct k_thread {
 	struct _thread_stack_info stack_info;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#if defined(CONFIG_TRACING_CPU_STATS_LATENCY)
+	/** Ready to run delay tracking */
+	struct _thread_latency latency;
+#endif /* CONFIG_TRACING_CPU_STATS_LATENCY */
+
+#if defined(CONFIG_TRACING_CPU_STATS_THREADS)
+	/** Run time accounting */
+	struct _thread_runtime runtime;
+#endif /* CONFIG_TRACING_CPU_STATS_THREADS */
+
+#if defined(CONFIG_SCHED_DEADLINE_CBS)
+	/** CPU budget reservation */
+	struct _thread_cbs cbs;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #if defined(CONFIG_USERSPACE)
 	/** memory domain info of the thread */
 	struct _mem_domain_info mem_domain_info;
@@ -570,6 +740,11 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_DYNAMIC_OBJECTS_CACHE)
+	/** Recently looked up dynamic kernel objects */
+	struct _thread_obj_cache obj_cache;
+#endif /* CONFIG_DYNAMIC_OBJECTS_CACHE */
+
 #if defined(CONFIG_USE_SWITCH)
 	/* When using __switch() a few previously arch-specific items
 	 * become part of the core OS
@@ -1062,6 +1237,51 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Give a thread a CPU budget reservation
+ *
+ * The thread is served by a constant bandwidth server: it may run for
+ * @a budget out of every @a period, with a deadline the end of its
+ * current period. Deadlines are set as with k_thread_deadline_set(),
+ * so reserved threads sharing a static priority are scheduled earliest
+ * deadline first.
+ *
+ * A thread exhausting its budget before blocking overruns: its
+ * overrun count is incremented, its budget replenished and its
+ * deadline postponed by one period, so that it falls behind threads
+ * still within their reservation. A thread waking up with a budget
+ * too large for the time left to its deadline starts a new period.
+ *
+ * Budgets are charged in ticks, through the time slicing machinery.
+ *
+ * @note
+ *    @rst
+ *    You should enable :option:`CONFIG_SCHED_DEADLINE_CBS` in your project
+ *    configuration.
+ *    @endrst
+ *
+ * @param thread Thread to reserve the CPU for
+ * @param period Reservation period, in milliseconds
+ * @param budget Run time per period, in milliseconds, or 0 to remove the
+ *        reservation
+ * @retval 0 Reservation set
+ * @retval -EINVAL Invalid period or budget
+ * @retval -EBUSY All reservations together would exceed
+ *         :option:`CONFIG_SCHED_DEADLINE_CBS_MAX_UTIL` percent of the CPU
+ */
+__syscall int k_thread_cbs_set(k_tid_t thread, s32_t period, s32_t budget);
+
+/**
+ * @brief Get the number of budget overruns of a thread
+ *
+ * @param thread Thread to query
+ * @return Number of periods in which the thread ran out of budget since
+ *         its reservation was last set
+ */
+__syscall u32_t k_thread_cbs_overruns_get(k_tid_t thread);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -1446,6 +1666,11 @@ struct k_timer {
 	/* timer status */
 	u32_t status;
 
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	/* started with k_timer_start_cycles(), period is in cycles */
+	bool hr;
+#endif
+
 	/* user-specific data, also used to support legacy features */
 	void *user_data;
 
@@ -1558,6 +1783,31 @@ extern void k_timer_init(struct k_timer *timer,
 __syscall void k_timer_start(struct k_timer *timer,
 			     s32_t duration, s32_t period);
 
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+/**
+ * @brief Start a timer with hardware cycle resolution.
+ *
+ * This routine works like k_timer_start(), but takes its duration and
+ * period in hardware clock cycles (see k_cycle_get_32()) and expires
+ * the timer at the exact cycle instead of the tick following it.  A
+ * periodic timer is restarted relative to its previous expiry, so it
+ * doesn't drift however late its expiry function runs.
+ *
+ * The timer stays in high-resolution mode until it is started again
+ * with k_timer_start().
+ *
+ * @note Cannot be called from user mode.
+ *
+ * @param timer     Address of timer.
+ * @param duration  Initial timer duration (in hardware cycles).
+ * @param period    Timer period (in hardware cycles, below 2^31).
+ *
+ * @return N/A
+ */
+extern void k_timer_start_cycles(struct k_timer *timer,
+				 u32_t duration, u32_t period);
+#endif
+
 /**
  * @brief Stop a timer.
  *
@@ -1610,6 +1860,7 @@ __syscall u32_t k_timer_status_get(struct k_timer *timer);
 __syscall u32_t k_timer_status_sync(struct k_timer *timer);
 
 extern s32_t z_timeout_remaining(struct _timeout *timeout);
+extern s32_t z_hr_timeout_remaining(struct _timeout *timeout);
 
 /**
  * @brief Get time remaining before a timer next expires.
@@ -1625,6 +1876,14 @@ __syscall u32_t k_timer_remaining_get(struct k_timer *timer);
 
 static inline u32_t z_impl_k_timer_remaining_get(struct k_timer *timer)
 {
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	if (timer->hr) {
+		const s32_t cyc = z_hr_timeout_remaining(&timer->timeout);
+
+		return (u32_t)(((u64_t)cyc * MSEC_PER_SEC) /
+			       sys_clock_hw_cycles_per_sec());
+	}
+#endif
 	const s32_t ticks = z_timeout_remaining(&timer->timeout);
 	return (ticks > 0) ? (u32_t)__ticks_to_ms(ticks) : 0U;
 }
@@ -1822,6 +2081,13 @@ struct k_queue {
 		_POLL_EVENT;
 	};
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	/* LIFO stack of items appended without taking the lock, moved
+	 * to data_q in order by the next locked operation
+	 */
+	atomic_t incoming;
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_queue)
 };
 
@@ -1837,6 +2103,10 @@ struct k_queue {
 
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+extern void z_queue_flush_incoming(struct k_queue *queue);
+#endif
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -1978,6 +2248,27 @@ extern void k_queue_insert(struct k_queue *queue, void *prev, void *data);
  */
 extern void k_queue_append_list(struct k_queue *queue, void *head, void *tail);
 
+/**
+ * @brief Atomically append a list of elements, waking at most one waiter.
+ *
+ * This routine behaves like k_queue_append_list(), except that instead
+ * of handing one item to each pending thread it readies at most one
+ * of them (giving it the first item) and leaves the rest of the batch
+ * queued.  This suits single-consumer queues where the consumer drains
+ * the queue after waking, and keeps a burst of items from causing a
+ * burst of context switches.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param queue Address of the queue.
+ * @param head Pointer to first node in singly-linked list.
+ * @param tail Pointer to last node in singly-linked list.
+ *
+ * @return N/A
+ */
+extern void k_queue_append_batch(struct k_queue *queue, void *head,
+				 void *tail);
+
 /**
  * @brief Atomically add a list of elements to a queue.
  *
@@ -2027,6 +2318,10 @@ __syscall void *k_queue_get(struct k_queue *queue, s32_t timeout);
  */
 static inline bool k_queue_remove(struct k_queue *queue, void *data)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	/* The item may still be on the lock-free incoming stack */
+	z_queue_flush_incoming(queue);
+#endif
 	return sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 }
 
@@ -2048,6 +2343,13 @@ static inline bool k_queue_unique_append(struct k_queue *queue, void *data)
 {
 	sys_sfnode_t *test;
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	/* Items on the incoming stack must be seen, pushing one of them
+	 * again would link it into a cycle.
+	 */
+	z_queue_flush_incoming(queue);
+#endif
+
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			return false;
@@ -2075,6 +2377,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	if (atomic_get(&queue->incoming) != 0) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -2091,6 +2398,9 @@ __syscall void *k_queue_peek_head(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	z_queue_flush_incoming(queue);
+#endif
 	return z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 }
 
@@ -2107,6 +2417,9 @@ __syscall void *k_queue_peek_tail(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	z_queue_flush_incoming(queue);
+#endif
 	return z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 }
 
@@ -2149,6 +2462,13 @@ struct k_futex {
 struct z_futex_data {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_SYS_MUTEX_PRIO_INHERIT
+	/* Owner of the sys_mutex whose priority a waiter raised, and its
+	 * priority before
+	 */
+	struct k_thread *owner;
+	int owner_orig_prio;
+#endif
 };
 
 #define Z_FUTEX_DATA_INITIALIZER(obj) \
@@ -2314,6 +2634,24 @@ struct k_fifo {
 #define k_fifo_put_list(fifo, head, tail) \
 	k_queue_append_list(&(fifo)->_queue, head, tail)
 
+/**
+ * @brief Atomically add a list of elements to a FIFO, waking one waiter.
+ *
+ * This routine adds a list of data items to @a fifo in one operation,
+ * like k_fifo_put_list(), but readies at most one pending thread for
+ * the whole batch.  See k_queue_append_batch().
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param head Pointer to first node in singly-linked list.
+ * @param tail Pointer to last node in singly-linked list.
+ *
+ * @return N/A
+ */
+#define k_fifo_put_batch(fifo, head, tail) \
+	k_queue_append_batch(&(fifo)->_queue, head, tail)
+
 /**
  * @brief Atomically add a list of elements to a FIFO queue.
  *
@@ -2691,9 +3029,34 @@ typedef void (*k_work_handler_t)(struct k_work *work);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_WORKQUEUE_STATS
+struct k_work_q_stats {
+	/* Work items processed */
+	u32_t count;
+	/* Longest time an item waited to be processed, in cycles */
+	u32_t wait_max;
+	/* Longest and total handler run time, in cycles */
+	u32_t run_max;
+	u64_t run_total;
+	/* Handler that ran for run_max cycles */
+	k_work_handler_t run_max_handler;
+};
+
+struct k_work_stats {
+	/* Times the work item was processed */
+	u32_t count;
+	/* Longest time it waited to be processed, in cycles */
+	u32_t wait_max;
+};
+#endif
+
 struct k_work_q {
 	struct k_queue queue;
 	struct k_thread thread;
+#ifdef CONFIG_WORKQUEUE_STATS
+	struct k_spinlock stats_lock;
+	struct k_work_q_stats stats;
+#endif
 };
 
 enum {
@@ -2704,6 +3067,11 @@ struct k_work {
 	void *_reserved;		/* Used by k_queue implementation. */
 	k_work_handler_t handler;
 	atomic_t flags[1];
+#ifdef CONFIG_WORKQUEUE_STATS
+	/* Cycle count at the last submission */
+	u32_t queued;
+	struct k_work_stats stats;
+#endif
 };
 
 struct k_delayed_work {
@@ -2784,6 +3152,9 @@ static inline void k_work_submit_to_queue(struct k_work_q *work_q,
 					  struct k_work *work)
 {
 	if (!atomic_test_and_set_bit(work->flags, K_WORK_STATE_PENDING)) {
+#ifdef CONFIG_WORKQUEUE_STATS
+		work->queued = k_cycle_get_32();
+#endif
 		k_queue_append(&work_q->queue, work);
 	}
 }
@@ -2891,6 +3262,74 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+/**
+ * @brief Add a worker thread to a workqueue.
+ *
+ * This routine starts an additional thread processing the work items of
+ * @a work_q, which must have been started with k_work_q_start(). All of
+ * the workqueue's threads take items off the same queue, so that a slow
+ * work handler only holds up the thread running it.
+ *
+ * @warning
+ * With more than one thread, work items are no longer processed one at a
+ * time or in the order they were submitted, and a work item resubmitted by
+ * its handler may be processed again before the handler returns.
+ *
+ * @param work_q Address of workqueue.
+ * @param thread Thread object of the new worker.
+ * @param stack Pointer to the worker thread's stack space, as defined by
+ *		K_THREAD_STACK_DEFINE()
+ * @param stack_size Size of the worker thread's stack (in bytes).
+ * @param prio Priority of the worker thread.
+ * @param cpu CPU the worker thread is pinned to, or a negative value to
+ *	      let it run on any CPU. Pinning requires CONFIG_SCHED_CPU_MASK.
+ *
+ * @retval 0 Worker thread started.
+ * @retval -EINVAL @a cpu is not a valid CPU number.
+ * @retval -ENOTSUP CPU affinity is not supported.
+ */
+extern int k_work_q_worker_add(struct k_work_q *work_q,
+			       struct k_thread *thread,
+			       k_thread_stack_t *stack,
+			       size_t stack_size, int prio, int cpu);
+
+#ifdef CONFIG_WORKQUEUE_STATS
+/**
+ * @brief Get the statistics of a workqueue.
+ *
+ * This routine returns how many work items @a work_q processed, the
+ * longest time they waited in the queue and the longest and total time
+ * their handlers ran, along with the handler that took longest. Times are
+ * in units of k_cycle_get_32(). Work items processed by threads running
+ * in user mode are not accounted for.
+ *
+ * @param work_q Address of workqueue.
+ * @param stats Statistics to fill in.
+ *
+ * @return N/A
+ */
+extern void k_work_q_stats_get(struct k_work_q *work_q,
+			       struct k_work_q_stats *stats);
+
+/**
+ * @brief Get the statistics of a work item.
+ *
+ * This routine returns how many times @a work was processed and the
+ * longest time it waited in its queue, in units of k_cycle_get_32(),
+ * since k_work_init() or k_delayed_work_init() was called on it.
+ *
+ * @param work Address of work item.
+ * @param stats Statistics to fill in.
+ *
+ * @return N/A
+ */
+static inline void k_work_stats_get(struct k_work *work,
+				    struct k_work_stats *stats)
+{
+	*stats = work->stats;
+}
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -3301,6 +3740,150 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	u32_t events;
+
+	_OBJECT_TRACING_NEXT_PTR(k_event)
+};
+
+#define Z_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.events = 0U, \
+	_OBJECT_TRACING_INIT \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize an event object.
+ *
+ * This routine initializes an event object, prior to its first use. All
+ * of its 32 events are cleared.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+__syscall void k_event_init(struct k_event *event);
+
+/**
+ * @brief Post events to an event object.
+ *
+ * This routine adds @a events to the events of @a event and wakes every
+ * thread whose wait condition is then satisfied, in wait queue order. A
+ * waiter which clears the events it waited for does so before the next
+ * waiter is checked.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to post.
+ *
+ * @return Events of @a event once the waiters were woken.
+ */
+__syscall u32_t k_event_post(struct k_event *event, u32_t events);
+
+/**
+ * @brief Set the events of an event object.
+ *
+ * This routine replaces the events of @a event with @a events and wakes
+ * the waiters then satisfied, as k_event_post() does.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to set.
+ *
+ * @return Events of @a event once the waiters were woken.
+ */
+__syscall u32_t k_event_set(struct k_event *event, u32_t events);
+
+/**
+ * @brief Clear events of an event object.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to clear.
+ *
+ * @return Events of @a event before they were cleared.
+ */
+__syscall u32_t k_event_clear(struct k_event *event, u32_t events);
+
+/**
+ * @brief Wait for any of the specified events.
+ *
+ * This routine waits until at least one of @a events is set in @a event.
+ * Only a thread whose condition is satisfied is woken.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Events to wait for, cannot be zero.
+ * @param clear Clear @a events when the wait is satisfied, atomically
+ *              with the wake up.
+ * @param timeout Waiting period (in milliseconds), or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Returned without waiting, or waiting period timed out.
+ * @return Events of @a event when the wait was satisfied, before
+ *         clearing.
+ */
+__syscall u32_t k_event_wait(struct k_event *event, u32_t events, bool clear,
+			     s32_t timeout);
+
+/**
+ * @brief Wait for all of the specified events.
+ *
+ * This routine waits until all of @a events are set in @a event, and
+ * otherwise behaves as k_event_wait().
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Events to wait for, cannot be zero.
+ * @param clear Clear @a events when the wait is satisfied, atomically
+ *              with the wake up.
+ * @param timeout Waiting period (in milliseconds), or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Returned without waiting, or waiting period timed out.
+ * @return Events of @a event when the wait was satisfied, before
+ *         clearing.
+ */
+__syscall u32_t k_event_wait_all(struct k_event *event, u32_t events,
+				 bool clear, s32_t timeout);
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	Z_STRUCT_SECTION_ITERABLE(k_event, name) = \
+		Z_EVENT_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @defgroup msgq_apis Message Queue APIs
  * @ingroup kernel_apis
@@ -3491,6 +4074,72 @@ __syscall int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout);
  */
 __syscall int k_msgq_peek(struct k_msgq *q, void *data);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data
+ * to message queue @a q. The messages that fit are moved in a single
+ * critical section: the first ones go straight to threads waiting to
+ * receive, one each, and the rest are copied into the ring buffer at once.
+ * Only if no message fits does it wait, for room for the first one.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Waiting period to add the first message (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages sent.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_n(struct k_msgq *q, void *data, u32_t num_msgs,
+			   s32_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a max_msgs messages from message queue
+ * @a q in a "first in, first out" manner, copying them out of the ring
+ * buffer at once. The room made is given to the threads waiting to send,
+ * one message each. Only if the queue is empty does it wait, for one
+ * message; the messages queued along with it are then received as well.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Address of area to hold up to @a max_msgs messages.
+ * @param max_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_n(struct k_msgq *q, void *data, u32_t max_msgs,
+			   s32_t timeout);
+
+/**
+ * @brief Peek/read several messages from a message queue.
+ *
+ * This routine reads up to @a max_msgs messages from message queue @a q
+ * in a "first in, first out" manner and leaves them in the queue.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param q Address of the message queue.
+ * @param data Address of area to hold up to @a max_msgs messages.
+ * @param max_msgs Maximum number of messages to read.
+ *
+ * @return Number of messages read, zero when the queue has no message.
+ */
+__syscall int k_msgq_peek_n(struct k_msgq *q, void *data, u32_t max_msgs);
+
 /**
  * @brief Purge a message queue.
  *
@@ -3762,6 +4411,11 @@ extern void k_mbox_data_get(struct k_mbox_msg *rx_msg, void *buffer);
  * permits the caller to reattempt data retrieval at a later time or to dispose
  * of the received message without retrieving its data.
  *
+ * If the sender supplied a memory pool block, the sender's block descriptor
+ * is handed over to the receiver as is: the data is not copied or touched,
+ * and @a pool is not used for allocation. The block must then be freed by
+ * the receiver, as it still belongs to the sender's pool.
+ *
  * @param rx_msg Address of a receive message descriptor.
  * @param pool Address of memory pool, or NULL to discard data.
  * @param block Address of the area to hold memory pool block info.
@@ -3794,6 +4448,8 @@ struct k_pipe {
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
 	struct k_spinlock lock;		/**< Synchronization lock */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 
 	struct {
 		_wait_q_t      readers; /**< Reader wait queue */
@@ -3817,6 +4473,8 @@ struct k_pipe {
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
 	.lock = {},                                                 \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
 		.writers = Z_WAIT_Q_INIT(&obj.wait_q.writers)        \
@@ -3963,12 +4621,103 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+/**
+ * @brief Claim space in a pipe's buffer to write data into in place.
+ *
+ * This routine returns a pointer to the first free byte of the buffer of
+ * @a pipe and how many bytes up to @a size can be written to it in one
+ * go, which is less than @a size if the free space wraps around or not
+ * enough of it is left. The data becomes visible to readers once
+ * k_pipe_put_finish() is called.
+ *
+ * Together with k_pipe_get_claim(), this moves data through the pipe
+ * without copying it. Readers pending in k_pipe_get() are given the data
+ * when it is committed, which copies it once.
+ *
+ * @warning
+ * Only one thread may write to the pipe while space is claimed, i.e. it
+ * must not be mixed with k_pipe_put() or k_pipe_block_put().
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the claimed space.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, possibly 0.
+ */
+extern size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			       size_t size);
+
+/**
+ * @brief Commit data written into claimed pipe buffer space.
+ *
+ * This routine makes the first @a size bytes claimed by
+ * k_pipe_put_claim() available to readers and releases the claim. All
+ * readers whose request is satisfied by then are woken up at once.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, or 0 to release the claim only.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the claimed space.
+ */
+extern int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer to read it in place.
+ *
+ * This routine returns a pointer to the oldest data in the buffer of
+ * @a pipe and how many bytes up to @a size can be read from it in one go,
+ * which is less than @a size if the data wraps around or not enough of it
+ * is available. The data is removed from the pipe once
+ * k_pipe_get_finish() is called.
+ *
+ * @warning
+ * Only one thread may read from the pipe while data is claimed, i.e. it
+ * must not be mixed with k_pipe_get().
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the claimed data.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, possibly 0.
+ */
+extern size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			       size_t size);
+
+/**
+ * @brief Release data read from a pipe's buffer in place.
+ *
+ * This routine removes the first @a size bytes claimed by
+ * k_pipe_get_claim() from the pipe and releases the claim. Pending
+ * writers are then moved into the freed space, and all writers whose
+ * request has been satisfied are woken up at once.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, or 0 to release the claim only.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the claimed data.
+ */
+extern int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+/* Per-CPU magazine of free blocks, see kernel/mem_slab.c */
+struct _mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	u32_t count;
+	u32_t hits;
+	u32_t refills;
+	u32_t drains;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	u32_t num_blocks;
@@ -3976,6 +4725,10 @@ struct k_mem_slab {
 	char *buffer;
 	char *free_list;
 	u32_t num_used;
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	atomic_t waiters;
+	struct _mem_slab_cache cache[CONFIG_MP_NUM_CPUS];
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 };
@@ -4102,7 +4855,18 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	u32_t cached = 0U;
+
+	/* num_used counts blocks held in the per-CPU caches as well */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->cache[i].count;
+	}
+
+	return slab->num_used - cached;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4118,9 +4882,40 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+/**
+ * @brief Memory slab per-CPU cache statistics.
+ */
+struct k_mem_slab_cache_stats {
+	/** Allocations and frees served by a per-CPU cache alone */
+	u32_t hits;
+	/** Batch transfers from the slab's free list into a cache */
+	u32_t refills;
+	/** Batch transfers from a cache back to the slab's free list */
+	u32_t drains;
+	/** Free blocks currently held in the per-CPU caches */
+	u32_t cached;
+};
+
+/**
+ * @brief Get the per-CPU cache statistics of a memory slab.
+ *
+ * The counters are summed over all CPUs. They are read without
+ * synchronization against running allocations and are meant for
+ * tuning only.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Statistics structure to fill in.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				       struct k_mem_slab_cache_stats *stats);
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
 /** @} */
 
 /**
@@ -4289,6 +5084,64 @@ extern void k_free(void *ptr);
  */
 extern void *k_calloc(size_t nmemb, size_t size);
 
+#ifdef CONFIG_HEAP_MEM_SLAB_CACHE
+
+/* Number of size classes of the heap slab cache */
+#define Z_HEAP_SLAB_CLASSES 3
+
+/**
+ * @brief Statistics of one heap slab cache size class.
+ *
+ * Byte counters are cumulative over the lifetime of the system and wrap
+ * around on overflow; use their ratio rather than their absolute value.
+ */
+struct k_malloc_slab_class_stats {
+	/** Size of a slab block, including the hidden block descriptor */
+	size_t block_size;
+	/** Number of blocks reserved for this class */
+	u32_t num_blocks;
+	/** Number of blocks currently allocated */
+	u32_t num_used;
+	/** Number of requests served by this class */
+	u32_t hits;
+	/** Number of requests for this class that found it exhausted */
+	u32_t overflows;
+	/** Bytes requested by the callers of the served requests */
+	u32_t requested_bytes;
+	/** Bytes handed out (block sizes) for the served requests */
+	u32_t granted_bytes;
+};
+
+/**
+ * @brief Heap slab cache statistics.
+ */
+struct k_malloc_slab_stats {
+	/** Per size class statistics, in increasing block size order */
+	struct k_malloc_slab_class_stats classes[Z_HEAP_SLAB_CLASSES];
+	/** Number of requests served by the heap memory pool */
+	u32_t pool_allocs;
+	/** Bytes requested by the callers of pool served requests */
+	u32_t pool_requested_bytes;
+	/** Bytes handed out (pool block sizes) for pool served requests */
+	u32_t pool_granted_bytes;
+};
+
+/**
+ * @brief Get heap slab cache statistics.
+ *
+ * The hit rate of the cache is the sum of the class @a hits over the
+ * total number of successful k_malloc() requests (class hits plus
+ * @a pool_allocs). Internal fragmentation of each allocator is one
+ * minus the ratio of requested to granted bytes.
+ *
+ * @param stats Statistics structure to fill in.
+ *
+ * @return N/A
+ */
+extern void k_malloc_slab_stats_get(struct k_malloc_slab_stats *stats);
+
+#endif /* CONFIG_HEAP_MEM_SLAB_CACHE */
+
 /** @} */
 
 /* polling API - PRIVATE */
@@ -4303,8 +5156,14 @@ extern void *k_calloc(size_t nmemb, size_t size);
 struct _poller {
 	struct k_thread *thread;
 	volatile bool is_polling;
+	/* _POLLER_MODE_xxx: who owns this poller */
+	u8_t mode;
 };
 
+/* private - poller owners */
+#define _POLLER_MODE_POLL 0 /* on the stack of a k_poll() call */
+#define _POLLER_MODE_SET 1 /* embedded in a struct k_poll_set */
+
 /* private - types bit positions */
 enum _poll_types_bits {
 	/* can be used to ignore an event */
@@ -4598,6 +5457,86 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Persistent poll set.
+ *
+ * A poll set keeps the registrations of its events with their kernel
+ * objects across calls to k_poll_set_wait(), the way an epoll instance
+ * does, so that the cost of a wait only depends on the number of events
+ * that became ready rather than on the size of the set.
+ *
+ * All fields are private.
+ */
+struct k_poll_set {
+	struct _poller poller;
+	_wait_q_t wait_q;
+	/* events that fired and are waiting to be reported */
+	sys_dlist_t ready;
+	/* events that have to be registered again before the next wait */
+	sys_dlist_t rearm;
+	struct k_poll_event *events;
+	int num_events;
+};
+
+/**
+ * @brief Initialize a persistent poll set.
+ *
+ * The events must have been initialized with k_poll_event_init() or one
+ * of the K_POLL_EVENT_*_INITIALIZER() macros, and must stay valid until
+ * k_poll_set_cleanup() is called. The set is owned by the thread calling
+ * k_poll_set_wait() on it; only one thread may wait on a set at a time.
+ * To change the events of a set, clean it up and initialize it again.
+ *
+ * This API is only available to kernel threads.
+ *
+ * @param set Poll set to initialize.
+ * @param events Array of events making up the set.
+ * @param num_events Number of events in the array.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set,
+			    struct k_poll_event *events, int num_events);
+
+/**
+ * @brief Wait for events of a persistent poll set.
+ *
+ * Reports the events that became ready since the previous call, waiting
+ * for one to do so if there are none. Events are edge triggered: the
+ * condition of an event is only evaluated when it is registered (on the
+ * first wait, and on the wait following the one that reported it), an
+ * event is reported once per firing, and its state field carries the
+ * K_POLL_STATE_xxx bits of that firing until it is registered again.
+ * Reported events are registered again by the next call, so the caller
+ * has to consume the condition (take the semaphore, empty the FIFO,
+ * reset the signal) before waiting again.
+ *
+ * @param set Poll set, initialized with k_poll_set_init().
+ * @param ready Array filled with pointers to the ready events.
+ * @param max_ready Size of the @a ready array. Ready events that do not
+ *        fit are reported by the next call.
+ * @param timeout Waiting period for an event to be ready (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready (at least one) on success.
+ * @retval -EAGAIN Waiting period timed out, no event is ready.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **ready, int max_ready,
+			   s32_t timeout);
+
+/**
+ * @brief Release a persistent poll set.
+ *
+ * Drops all registrations of the set's events, after which the events
+ * and the set may be reused or go out of scope.
+ *
+ * @param set Poll set to release.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_cleanup(struct k_poll_set *set);
+
 /**
  * @internal
  */
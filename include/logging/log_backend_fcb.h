@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FCB_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FCB_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flash log backend readout
+ * @defgroup log_backend_fcb Flash log backend readout
+ * @ingroup logger
+ * @{
+ */
+
+/**
+ * @brief Callback called for each message stored in flash.
+ *
+ * @param data Message, as formatted by the log output.
+ * @param len  Length of the message.
+ * @param ctx  Context passed to log_backend_fcb_walk().
+ *
+ * @return 0 to continue, non-zero to stop the walk.
+ */
+typedef int (*log_backend_fcb_cb_t)(const u8_t *data, size_t len, void *ctx);
+
+/**
+ * @brief Walk over the messages stored in flash, oldest first.
+ *
+ * Messages still batched in RAM are not included.
+ *
+ * @param cb  Callback called for each message.
+ * @param ctx Context passed to the callback.
+ *
+ * @return 0 on success, value returned by the callback if it stopped the
+ *	   walk, negative error code otherwise.
+ */
+int log_backend_fcb_walk(log_backend_fcb_cb_t cb, void *ctx);
+
+/**
+ * @brief Erase all the messages stored in flash.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+int log_backend_fcb_clear(void);
+
+/**
+ * @brief Get the number of messages which could not be stored.
+ *
+ * @return Number of messages lost since boot.
+ */
+u32_t log_backend_fcb_lost_get(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FCB_H_ */
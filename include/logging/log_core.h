@@ -215,11 +215,23 @@ extern "C" {
 /******************************************************************************/
 #define __LOG(_level, _id, _filter, ...)				    \
 	do {								    \
-		bool is_user_context = _is_user_context();		    \
+		bool is_user_context;					    \
 									    \
-		if (Z_LOG_CONST_LEVEL_CHECK(_level) &&			    \
-		    (is_user_context ||					    \
-		     (_level <= LOG_RUNTIME_FILTER(_filter)))) {	    \
+		if (!Z_LOG_CONST_LEVEL_CHECK(_level)) {			    \
+			if (false) {					    \
+				/* Arguments checker present but never */   \
+				/* evaluated. Placed here to ensure that */ \
+				/* __VA_ARGS__ are evaluated once when */   \
+				/* log is enabled.*/			    \
+				log_printf_arg_checker(__VA_ARGS__);	    \
+			}						    \
+			break;						    \
+		}							    \
+									    \
+		/* Only compiled in for enabled levels. */		    \
+		is_user_context = _is_user_context();			    \
+		if (is_user_context ||					    \
+		    (_level <= LOG_RUNTIME_FILTER(_filter))) {		    \
 			struct log_msg_ids src_level = {		    \
 				.level = _level,			    \
 				.domain_id = CONFIG_LOG_DOMAIN_ID,	    \
@@ -233,11 +245,6 @@ extern "C" {
 				__LOG_INTERNAL(is_user_context, src_level,  \
 						__VA_ARGS__);		    \
 			}						    \
-		} else if (false) {					    \
-			/* Arguments checker present but never evaluated.*/ \
-			/* Placed here to ensure that __VA_ARGS__ are*/     \
-			/* evaluated once when log is enabled.*/	    \
-			log_printf_arg_checker(__VA_ARGS__);		    \
 		}							    \
 	} while (false)
 
@@ -261,11 +268,15 @@ extern "C" {
 /******************************************************************************/
 #define __LOG_HEXDUMP(_level, _id, _filter, _data, _length, _str)	      \
 	do {								      \
-		bool is_user_context = _is_user_context();		      \
+		bool is_user_context;					      \
+									      \
+		if (!Z_LOG_CONST_LEVEL_CHECK(_level)) {			      \
+			break;						      \
+		}							      \
 									      \
-		if (Z_LOG_CONST_LEVEL_CHECK(_level) &&			      \
-		    (is_user_context ||					      \
-		     (_level <= LOG_RUNTIME_FILTER(_filter)))) {	      \
+		is_user_context = _is_user_context();			      \
+		if (is_user_context ||					      \
+		    (_level <= LOG_RUNTIME_FILTER(_filter))) {		      \
 			struct log_msg_ids src_level = {		      \
 				.level = _level,			      \
 				.source_id = _id,			      \
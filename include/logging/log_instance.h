@@ -28,6 +28,10 @@ struct log_source_const_data {
 /** @brief Dynamic data associated with the source of log messages. */
 struct log_source_dynamic_data {
 	u32_t filters;
+#ifdef CONFIG_LOG_RUNTIME_FILTER_MASKS
+	/* Mask of backends accepting each level, error to debug. */
+	u16_t backend_masks[4];
+#endif
 #ifdef CONFIG_NIOS2
 	/* Workaround alert! Dummy data to ensure that structure is >8 bytes.
 	 * Nios2 uses global pointer register for structures <=8 bytes and
@@ -45,6 +45,11 @@ extern "C" {
  */
 #define LOG_OUTPUT_FLAG_FORMAT_SYSLOG		BIT(6)
 
+/** @brief Flag leaving the end of a message in the output buffer, so that
+ *         several messages are output at once by log_output_flush().
+ */
+#define LOG_OUTPUT_FLAG_NO_FLUSH		BIT(7)
+
 /**
  * @brief Prototype of the function processing output data.
  *
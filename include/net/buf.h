@@ -409,6 +409,20 @@ size_t net_buf_simple_headroom(struct net_buf_simple *buf);
  */
 size_t net_buf_simple_tailroom(struct net_buf_simple *buf);
 
+/**
+ * @brief Check maximum net_buf_simple::len value.
+ *
+ * This value depends on the number of bytes being reserved as headroom.
+ *
+ * @param buf A valid pointer on a buffer
+ *
+ * @return Number of bytes usable behind the net_buf_simple::data pointer.
+ */
+static inline u16_t net_buf_simple_max_len(struct net_buf_simple *buf)
+{
+	return buf->size - net_buf_simple_headroom(buf);
+}
+
 /**
  * @brief Parsing state of a buffer.
  *
@@ -727,6 +741,137 @@ extern const struct net_buf_data_cb net_buf_var_cb;
 		NET_BUF_POOL_INITIALIZER(_name, &net_buf_data_alloc_##_name,  \
 					 _net_buf_##_name, _count, _destroy)
 
+/** @cond INTERNAL_HIDDEN */
+struct net_buf_slab_usage {
+	atomic_t allocs;
+	atomic_t fallbacks;
+	atomic_t max_used;
+};
+
+struct net_buf_slab_class {
+	struct k_mem_slab *slab;
+	struct net_buf_slab_usage *usage;
+	size_t data_size;
+};
+
+struct net_buf_pool_slab {
+	const struct net_buf_slab_class *classes;
+	u8_t class_count;
+};
+
+extern const struct net_buf_data_cb net_buf_slab_cb;
+
+/* Each block starts with the class index and ends its header with the
+ * reference count, so that the data stays 32-bit aligned.
+ */
+#define NET_BUF_SLAB_HDR_SIZE 4
+#define NET_BUF_SLAB_BLOCK_SIZE(_size) \
+	(NET_BUF_SLAB_HDR_SIZE + ROUND_UP(_size, 4))
+/** @endcond */
+
+/**
+ * @def NET_BUF_POOL_SLAB_DEFINE
+ * @brief Define a new pool for buffers with payloads from size classes
+ *
+ * Defines a net_buf_pool struct and the necessary memory storage (array of
+ * structs) for the needed amount of buffers. After this, the buffers can be
+ * accessed from the pool through net_buf_alloc_len(), which gives the size
+ * to pick a class for: net_buf_alloc() is only for fixed-size pools. The
+ * pool is defined as a static variable, so if it needs to be exported
+ * outside the current module this needs to happen with the help of a
+ * separate pointer rather than an extern declaration.
+ *
+ * The data payload of the buffers will be allocated from three memory
+ * slabs of increasing block sizes. A request is served by the smallest
+ * class it fits in or, if that one is exhausted, by a larger one. Requests
+ * larger than the largest class get a buffer of that size, like with
+ * fixed-size pools. Only the best fitting class is waited on when all
+ * of them are exhausted.
+ *
+ * If provided with a custom destroy callback, this callback is
+ * responsible for eventually calling net_buf_destroy() to complete the
+ * process of returning the buffer to the pool.
+ *
+ * @param _name      Name of the pool variable.
+ * @param _count     Number of buffers in the pool.
+ * @param _size0     Data size of the smallest class.
+ * @param _count0    Number of blocks in the smallest class.
+ * @param _size1     Data size of the middle class.
+ * @param _count1    Number of blocks in the middle class.
+ * @param _size2     Data size of the largest class.
+ * @param _count2    Number of blocks in the largest class.
+ * @param _destroy   Optional destroy callback when buffer is freed.
+ */
+#define NET_BUF_POOL_SLAB_DEFINE(_name, _count, _size0, _count0, _size1,     \
+				 _count1, _size2, _count2, _destroy)         \
+	BUILD_ASSERT(_size0 < _size1 && _size1 < _size2);                     \
+	static struct net_buf _net_buf_##_name[_count] __noinit;              \
+	K_MEM_SLAB_DEFINE(net_buf_slab0_##_name,                              \
+			  NET_BUF_SLAB_BLOCK_SIZE(_size0), _count0, 4);       \
+	K_MEM_SLAB_DEFINE(net_buf_slab1_##_name,                              \
+			  NET_BUF_SLAB_BLOCK_SIZE(_size1), _count1, 4);       \
+	K_MEM_SLAB_DEFINE(net_buf_slab2_##_name,                              \
+			  NET_BUF_SLAB_BLOCK_SIZE(_size2), _count2, 4);       \
+	static struct net_buf_slab_usage net_buf_slab_usage_##_name[3];       \
+	static const struct net_buf_slab_class net_buf_slab_classes_##_name[] = { \
+		{ &net_buf_slab0_##_name, &net_buf_slab_usage_##_name[0],     \
+		  _size0 },                                                   \
+		{ &net_buf_slab1_##_name, &net_buf_slab_usage_##_name[1],     \
+		  _size1 },                                                   \
+		{ &net_buf_slab2_##_name, &net_buf_slab_usage_##_name[2],     \
+		  _size2 },                                                   \
+	};                                                                    \
+	static const struct net_buf_pool_slab net_buf_slab_##_name = {        \
+		.classes = net_buf_slab_classes_##_name,                      \
+		.class_count = ARRAY_SIZE(net_buf_slab_classes_##_name),      \
+	};                                                                    \
+	static const struct net_buf_data_alloc net_buf_slab_alloc_##_name = { \
+		.cb = &net_buf_slab_cb,                                       \
+		.alloc_data = (void *)&net_buf_slab_##_name,                  \
+	};                                                                    \
+	struct net_buf_pool _name __net_buf_align                             \
+			__in_section(_net_buf_pool, static, _name) =          \
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_slab_alloc_##_name,  \
+					 _net_buf_##_name, _count, _destroy)
+
+/**
+ * @brief Utilization of a size class of a pool defined with
+ * NET_BUF_POOL_SLAB_DEFINE().
+ */
+struct net_buf_slab_stats {
+	/** Data size of the blocks */
+	size_t data_size;
+
+	/** Number of blocks */
+	u32_t count;
+
+	/** Blocks currently in use */
+	u32_t used;
+
+	/** Highest number of blocks in use at the same time */
+	u32_t max_used;
+
+	/** Allocations served by this class */
+	u32_t allocs;
+
+	/** Allocations served by this class because the best fitting one
+	 * was exhausted
+	 */
+	u32_t fallbacks;
+};
+
+/**
+ * @brief Get the utilization of a size class of a slab based pool.
+ *
+ * @param pool Pool defined with NET_BUF_POOL_SLAB_DEFINE().
+ * @param idx Index of the size class, 0 being the smallest one.
+ * @param stats Filled with the statistics of the class.
+ *
+ * @return 0 on success, -EINVAL if the pool has no such class.
+ */
+int net_buf_pool_slab_stats(struct net_buf_pool *pool, int idx,
+			    struct net_buf_slab_stats *stats);
+
 /**
  * @def NET_BUF_POOL_DEFINE
  * @brief Define a new pool for buffers
@@ -778,6 +923,10 @@ int net_buf_id(struct net_buf *buf);
 /**
  * @brief Allocate a new fixed buffer from a pool.
  *
+ * Only for pools defined with NET_BUF_POOL_FIXED_DEFINE() or
+ * NET_BUF_POOL_DEFINE(); fails on pools defined with
+ * NET_BUF_POOL_SLAB_DEFINE().
+ *
  * @param pool Which pool to allocate the buffer from.
  * @param timeout Affects the action taken should the pool be empty.
  *        If K_NO_WAIT, then return immediately. If K_FOREVER, then
@@ -1279,6 +1428,18 @@ static inline void *net_buf_user_data(const struct net_buf *buf)
  */
 #define net_buf_headroom(buf) net_buf_simple_headroom(&(buf)->b)
 
+/**
+ * @def net_buf_max_len
+ * @brief Check maximum net_buf::len value.
+ *
+ * This value depends on the number of bytes being reserved as headroom.
+ *
+ * @param buf A valid pointer on a buffer
+ *
+ * @return Number of bytes usable behind the net_buf::data pointer.
+ */
+#define net_buf_max_len(buf) net_buf_simple_max_len(&(buf)->b)
+
 /**
  * @def net_buf_tail
  * @brief Get the tail pointer for a buffer.
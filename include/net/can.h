@@ -190,6 +190,8 @@ struct canbus_isotp_rx_ctx {
 	struct net_pkt *pkt;
 	/** Timeout for RX timeout*/
 	struct _timeout timeout;
+	/** Work item sending the FC frame at the end of a block */
+	struct k_work fc_work;
 	/** Remaining data to receive. Goes from message length to zero */
 	u16_t rem_len;
 	/** State of the reception */
@@ -209,6 +211,22 @@ struct canbus_isotp_rx_ctx {
  */
 void net_6locan_init(struct net_if *iface);
 
+/**
+ * Consecutive frame input function for the canbus L2.
+ *
+ * This function is called by the driver from its RX callback. If the frame
+ * is a unicast consecutive frame of a message being received, its payload
+ * is written directly into the packet of the message, without allocating a
+ * net_pkt for the frame.
+ *
+ * @param iface Interface the frame was received on
+ * @param frame Received frame
+ *
+ * @return true if the frame was consumed, false if it has to be passed to
+ * the network stack.
+ */
+bool net_6locan_recv_cf(struct net_if *iface, struct zcan_frame *frame);
+
 /**
  * Ethernet frame input function for Ethernet to 6LoCAN translation
  *
@@ -594,6 +594,22 @@ int coap_update_from_block(const struct coap_packet *cpkt,
 size_t coap_next_block(const struct coap_packet *cpkt,
 		       struct coap_block_context *ctx);
 
+/**
+ * @brief Retrieves the block number, more flag and block size of the
+ * BLOCK2 option of @a cpkt, without a block context.
+ *
+ * This lets a client which keeps several block requests in flight tell
+ * which block a response carries.
+ *
+ * @param cpkt Packet in which to look for the BLOCK2 option
+ * @param has_more Set to the more flag of the option
+ * @param block_number Set to the block number of the option
+ *
+ * @return The block size in bytes, -ENOENT if there is no BLOCK2 option.
+ */
+int coap_get_block2_option(const struct coap_packet *cpkt, bool *has_more,
+			   u32_t *block_number);
+
 /**
  * @brief Indicates that the remote device referenced by @a addr, with
  * @a request, wants to observe a resource.
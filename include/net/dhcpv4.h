@@ -37,6 +37,7 @@ enum net_dhcpv4_state {
 	NET_DHCPV4_INIT,
 	NET_DHCPV4_SELECTING,
 	NET_DHCPV4_REQUESTING,
+	NET_DHCPV4_REBOOTING,
 	NET_DHCPV4_RENEWING,
 	NET_DHCPV4_REBINDING,
 	NET_DHCPV4_BOUND,
@@ -208,6 +208,18 @@ struct dns_resolve_context {
 
 		/** DNS id of this query */
 		u16_t id;
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		/** Index of the query whose answer this one waits for
+		 * instead of sending its own, -1 if there is none.
+		 */
+		s8_t leader;
+
+		/** Copy of the query string used to cache the answer, empty
+		 * if it is too long to be cached.
+		 */
+		char name[CONFIG_DNS_RESOLVER_CACHE_NAME_LEN + 1];
+#endif
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -126,6 +126,13 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload (TSO) supported. TCP packets larger
+	 * than the MTU are then passed to the driver as they are, to be
+	 * split into segments carrying net_pkt_gso_size() bytes of
+	 * payload each.
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(15),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -722,6 +729,87 @@ static inline int net_eth_get_ptp_port(struct net_if *iface)
 void net_eth_set_ptp_port(struct net_if *iface, int port);
 #endif /* CONFIG_NET_GPTP */
 
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POLL)
+struct net_eth_rx_poll;
+
+/**
+ * @typedef net_eth_rx_poll_cb_t
+ * @brief Receive at most budget frames, passing them to
+ * net_eth_rx_poll_recv().
+ *
+ * @return Number of frames received, budget if more frames may be pending.
+ */
+typedef int (*net_eth_rx_poll_cb_t)(struct net_eth_rx_poll *rx_poll,
+				    int budget);
+
+/**
+ * @typedef net_eth_rx_irq_enable_cb_t
+ * @brief Enable the RX interrupt again once polling is over.
+ *
+ * @return True if frames were received while the interrupt was disabled,
+ * in which case the driver disables it again and polling goes on.
+ */
+typedef bool (*net_eth_rx_irq_enable_cb_t)(struct net_eth_rx_poll *rx_poll);
+
+/**
+ * @brief RX polling context of an Ethernet driver.
+ *
+ * A driver receiving many frames takes one interrupt for a burst of them:
+ * its RX interrupt handler disables the RX interrupt and calls
+ * net_eth_rx_poll_schedule(). The frames are then received by the poll
+ * callback from the Ethernet RX poll thread, at most
+ * CONFIG_NET_L2_ETHERNET_RX_POLL_BUDGET frames at a time, until there
+ * are none left and the interrupt is enabled again.
+ */
+struct net_eth_rx_poll {
+	/** Work item of the RX poll thread */
+	struct k_work work;
+
+	/** Driver callbacks */
+	net_eth_rx_poll_cb_t poll;
+	net_eth_rx_irq_enable_cb_t irq_enable;
+
+	/** Frames received by the current poll, passed up the stack
+	 *  together once it returns.
+	 */
+	struct net_pkt *batch[CONFIG_NET_L2_ETHERNET_RX_POLL_BUDGET];
+	int batch_count;
+};
+
+/**
+ * @brief Initialize the RX polling context of a driver.
+ *
+ * @param rx_poll RX polling context
+ * @param poll Callback receiving the frames
+ * @param irq_enable Callback enabling the RX interrupt
+ */
+void net_eth_rx_poll_init(struct net_eth_rx_poll *rx_poll,
+			  net_eth_rx_poll_cb_t poll,
+			  net_eth_rx_irq_enable_cb_t irq_enable);
+
+/**
+ * @brief Start polling, called from the RX interrupt handler after it
+ * disabled the RX interrupt.
+ *
+ * @param rx_poll RX polling context
+ */
+void net_eth_rx_poll_schedule(struct net_eth_rx_poll *rx_poll);
+
+/**
+ * @brief Pass a frame received by the poll callback to the network stack.
+ *
+ * @details The frames are delivered with net_recv_data() when the poll
+ * callback returns. The frames which can't be delivered are counted as
+ * RX errors and released.
+ *
+ * @param rx_poll RX polling context
+ * @param iface Network interface the frame was received on
+ * @param pkt Received frame
+ */
+void net_eth_rx_poll_recv(struct net_eth_rx_poll *rx_poll,
+			  struct net_if *iface, struct net_pkt *pkt);
+#endif /* CONFIG_NET_L2_ETHERNET_RX_POLL */
+
 /**
  * @}
  */
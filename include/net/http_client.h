@@ -0,0 +1,172 @@
+/** @file
+ * @brief HTTP client library
+ *
+ * An API for applications to send HTTP/1.1 requests, over TCP or TLS,
+ * on persistent connections kept in a small pool.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_HTTP_CLIENT_H_
+#define ZEPHYR_INCLUDE_NET_HTTP_CLIENT_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <net/http_parser.h>
+#include <net/tls_credentials.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief HTTP client library
+ * @defgroup http_client HTTP client library
+ * @ingroup networking
+ * @{
+ */
+
+struct http_request;
+
+/** State of the response to a request, updated as it arrives */
+struct http_response {
+	/** HTTP status code, such as 200 */
+	u16_t status_code;
+
+	/** Content-Length of the body, 0 if the response has none, such as
+	 * a chunked response.
+	 */
+	size_t content_length;
+
+	/** Number of body bytes received so far */
+	size_t body_received;
+
+	/** Set once the whole response has been received */
+	bool complete;
+};
+
+/**
+ * @typedef http_response_cb_t
+ * @brief Callback receiving the body of a response.
+ *
+ * @details The callback is called for each part of the body as it is
+ * received, chunked bodies being decoded already, and a last time with no
+ * data once the response is complete. The status code is available from
+ * the first call on.
+ *
+ * @param req Request the response belongs to
+ * @param rsp Response state
+ * @param data Next part of the body, NULL on the last call
+ * @param len Length of data
+ *
+ * @return 0 to continue, or a negative error code to abort the request,
+ * which closes the connection.
+ */
+typedef int (*http_response_cb_t)(struct http_request *req,
+				  struct http_response *rsp,
+				  const u8_t *data, size_t len);
+
+/** HTTP request */
+struct http_request {
+	/** Request method, such as HTTP_GET */
+	enum http_method method;
+
+	/** Server host name or address, also sent as the Host header */
+	const char *host;
+
+	/** Server port */
+	u16_t port;
+
+	/** Request target, such as "/index.html" */
+	const char *url;
+
+	/** Additional header lines, each followed by "\r\n", NULL if none */
+	const char *header_fields;
+
+	/** Content-Type of the payload, NULL if none */
+	const char *content_type;
+
+	/** Request body, NULL if none */
+	const u8_t *payload;
+
+	/** Length of payload */
+	size_t payload_len;
+
+	/** Credentials to connect with TLS, NULL for plain TCP. The TLS
+	 *  connection is kept open between requests like TCP ones are.
+	 */
+	const sec_tag_t *sec_tag_list;
+
+	/** Number of entries in sec_tag_list */
+	size_t sec_tag_count;
+
+	/** Function receiving the response body */
+	http_response_cb_t response_cb;
+
+	/** User data, for the response callback */
+	void *user_data;
+
+	/** Response state, set up by the library */
+	struct http_response response;
+};
+
+/**
+ * @brief Send a request and receive its response.
+ *
+ * @details An idle connection to the same server is reused when there is
+ * one in the pool, otherwise a new connection is opened. It is kept open
+ * for the next requests unless the server closes it. If a reused
+ * connection turns out to have been closed by the server before any
+ * response byte arrived, the request is sent again on a new connection.
+ *
+ * @param req Request to send
+ * @param timeout Time to wait for each part of the response, in
+ *        milliseconds, or K_FOREVER
+ *
+ * @return 0 once the response has been received completely, a negative
+ * error code otherwise: -EBUSY if the pool has no room for another
+ * connection to the server, -ETIMEDOUT, -ECONNRESET if the connection was
+ * closed before the end of the response, -EINVAL if the response is not
+ * valid HTTP, or the error returned by the response callback.
+ */
+int http_client_request(struct http_request *req, s32_t timeout);
+
+/**
+ * @brief Send several requests to one server on a single connection.
+ *
+ * @details All the requests are written before reading the responses,
+ * which then arrive in order (HTTP/1.1 pipelining), saving a round trip
+ * per request. The requests must all go to the same host and port with
+ * the same credentials, and should be idempotent, as a server may close
+ * the connection before answering all of them.
+ *
+ * @param reqs Requests to send
+ * @param count Number of requests
+ * @param timeout Time to wait for each part of the responses, in
+ *        milliseconds, or K_FOREVER
+ *
+ * @return 0 once all the responses have been received, a negative error
+ * code as for http_client_request() otherwise. The complete field of the
+ * responses tells which ones have been received.
+ */
+int http_client_pipeline(struct http_request *reqs, size_t count,
+			 s32_t timeout);
+
+/**
+ * @brief Close the idle connections of the pool.
+ */
+void http_client_close_idle(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_HTTP_CLIENT_H_ */
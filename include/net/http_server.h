@@ -0,0 +1,144 @@
+/** @file
+ * @brief HTTP server library
+ *
+ * An API for applications to serve static assets, stored in flash, over
+ * HTTP/1.1.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+#define ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief HTTP server library
+ * @defgroup http_server HTTP server library
+ * @ingroup networking
+ * @{
+ */
+
+/**
+ * Static asset served by the HTTP server.
+ *
+ * The content is sent from where it is stored, either memory, such as
+ * a const array in XIP flash, or a flash_map partition. Partitions of
+ * the internal flash of an XIP image are memory mapped and are read in
+ * place too, other partitions are read by parts into the buffer of the
+ * connection.
+ */
+struct http_server_asset {
+	/** Path of the asset, such as "/index.html" */
+	const char *path;
+
+	/** Content-Type of the asset, such as "text/html" */
+	const char *content_type;
+
+	/** Content, NULL if it is stored in a flash_map partition */
+	const u8_t *data;
+
+	/** Flash area ID of the partition holding the content */
+	u8_t flash_area_id;
+
+	/** Offset of the content in the partition */
+	off_t offset;
+
+	/** Length of the content */
+	size_t len;
+
+	/** The content is gzip compressed, and is sent as is with
+	 *  "Content-Encoding: gzip" to the clients which accept it.
+	 */
+	bool gzip;
+};
+
+/**
+ * @brief Define an asset held in memory.
+ *
+ * @param _path Path of the asset
+ * @param _type Content-Type of the asset
+ * @param _data Content
+ * @param _len Length of the content
+ * @param _gzip Set if the content is gzip compressed
+ */
+#define HTTP_SERVER_ASSET(_path, _type, _data, _len, _gzip)	\
+	{							\
+		.path = (_path),				\
+		.content_type = (_type),			\
+		.data = (const u8_t *)(_data),			\
+		.len = (_len),					\
+		.gzip = (_gzip),				\
+	}
+
+/**
+ * @brief Define an asset held in a flash_map partition.
+ *
+ * @param _path Path of the asset
+ * @param _type Content-Type of the asset
+ * @param _id Flash area ID of the partition
+ * @param _offset Offset of the content in the partition
+ * @param _len Length of the content
+ * @param _gzip Set if the content is gzip compressed
+ */
+#define HTTP_SERVER_FLASH_ASSET(_path, _type, _id, _offset, _len, _gzip) \
+	{							\
+		.path = (_path),				\
+		.content_type = (_type),			\
+		.data = NULL,					\
+		.flash_area_id = (_id),				\
+		.offset = (_offset),				\
+		.len = (_len),					\
+		.gzip = (_gzip),				\
+	}
+
+/** HTTP server configuration */
+struct http_server {
+	/** Port to listen on */
+	u16_t port;
+
+	/** Assets served, a request for a path not in the table gets a 404
+	 *  response.
+	 */
+	const struct http_server_asset *assets;
+
+	/** Number of entries in assets */
+	size_t asset_count;
+};
+
+/**
+ * @brief Run the HTTP server.
+ *
+ * @details The server handles all its connections in the calling thread,
+ * polling their sockets, so it does not return unless it fails. GET and
+ * HEAD requests are supported, on connections kept open between requests
+ * as long as the client wants and until they are idle for
+ * CONFIG_HTTP_SERVER_IDLE_TIMEOUT milliseconds.
+ *
+ * @param server Server configuration, which must stay valid while the
+ *        server runs
+ *
+ * @return A negative error code if the server could not listen for
+ * connections or polling them failed.
+ */
+int http_server_run(const struct http_server *server);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_ */
@@ -0,0 +1,90 @@
+/** @file
+ * @brief mDNS responder
+ *
+ * An API for applications to announce DNS-SD services with the mDNS
+ * responder.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_MDNS_RESPONDER_H_
+#define ZEPHYR_INCLUDE_NET_MDNS_RESPONDER_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief mDNS responder
+ * @defgroup mdns_responder mDNS Responder
+ * @ingroup networking
+ * @{
+ */
+
+/**
+ * DNS-SD service instance, see RFC 6763.
+ *
+ * The responder answers for "<instance>.<service>.<proto>.local" with
+ * a SRV record pointing to "<hostname>.local" and a TXT record, and lists
+ * the instance in the PTR records of "<service>.<proto>.local".
+ */
+struct mdns_service {
+	/** Instance name, a single label such as "Office printer" */
+	const char *instance;
+
+	/** Service type, such as "_http" */
+	const char *service;
+
+	/** Transport protocol, "_tcp" or "_udp" */
+	const char *proto;
+
+	/** TXT record data as a sequence of length prefixed strings,
+	 * NULL for an empty TXT record.
+	 */
+	const u8_t *txt;
+
+	/** Length of the TXT record data */
+	u16_t txt_len;
+
+	/** Port the service is available at, in host byte order */
+	u16_t port;
+};
+
+/**
+ * @brief Start announcing a DNS-SD service.
+ *
+ * @details The service is not copied, it must stay valid until it is
+ * removed.
+ *
+ * @param service Service to announce
+ *
+ * @return 0 if ok, -EINVAL if a name is not a valid label, -EALREADY if
+ * the service is announced already, -ENOMEM if there is no room for more
+ * services.
+ */
+int mdns_responder_service_add(const struct mdns_service *service);
+
+/**
+ * @brief Stop announcing a DNS-SD service.
+ *
+ * @param service Service given to mdns_responder_service_add()
+ *
+ * @return 0 if ok, -ENOENT if the service was not announced.
+ */
+int mdns_responder_service_remove(const struct mdns_service *service);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_MDNS_RESPONDER_H_ */
@@ -74,7 +74,13 @@ enum mqtt_evt_type {
 	MQTT_EVT_SUBACK,
 
 	/** Acknowledgment to a unsubscribe request. */
-	MQTT_EVT_UNSUBACK
+	MQTT_EVT_UNSUBACK,
+
+	/** Chunk of the payload of a received publish message. Only notified
+	 *  with CONFIG_MQTT_PAYLOAD_EVENTS, for the payload not read with
+	 *  @ref mqtt_read_publish_payload from the PUBLISH event handler.
+	 */
+	MQTT_EVT_PUBLISH_PAYLOAD
 };
 
 /** @brief MQTT version protocol level. */
@@ -220,6 +226,18 @@ struct mqtt_unsuback_param {
 	u16_t message_id;
 };
 
+/** @brief Chunk of the payload of a received publish message. */
+struct mqtt_publish_payload_param {
+	/** Chunk data, valid until the event handler returns. */
+	const u8_t *data;
+
+	/** Length of the chunk. */
+	u32_t len;
+
+	/** Payload length still to be received after this chunk. */
+	u32_t remaining;
+};
+
 /** @brief Parameters for a publish message. */
 struct mqtt_publish_param {
 	/** Messages including topic, QoS and its payload (if any)
@@ -286,6 +304,9 @@ union mqtt_evt_param {
 
 	/** Parameters accompanying MQTT_EVT_UNSUBACK event. */
 	struct mqtt_unsuback_param unsuback;
+
+	/** Parameters accompanying MQTT_EVT_PUBLISH_PAYLOAD event. */
+	struct mqtt_publish_payload_param payload;
 };
 
 /** @brief Defines MQTT asynchronous event notified to the application. */
@@ -315,6 +336,22 @@ struct mqtt_client;
 typedef void (*mqtt_evt_cb_t)(struct mqtt_client *client,
 			      const struct mqtt_evt *evt);
 
+/**
+ * @brief Payload producer of a streamed publish message.
+ *
+ * @param[in] client Identifies the client sending the message.
+ * @param[out] buf Buffer to fill with the next part of the payload.
+ * @param[in] len Size of the buffer, never more than the payload length
+ *                still to be sent.
+ * @param[in] offset Offset of this part in the payload.
+ * @param[in] user_data User data given to @ref mqtt_publish_stream.
+ *
+ * @return Number of bytes written to the buffer, or a negative error code
+ *         (errno.h) to abort the message.
+ */
+typedef int (*mqtt_payload_cb_t)(struct mqtt_client *client, u8_t *buf,
+				 size_t len, size_t offset, void *user_data);
+
 /** @brief TLS configuration for secure MQTT transports. */
 struct mqtt_sec_config {
 	/** Indicates the preference for peer verification. */
@@ -338,6 +375,12 @@ struct mqtt_sec_config {
 	 *  May be NULL to skip hostname verification.
 	 */
 	char *hostname;
+
+	/** Indicates the preference for the TLS session cache,
+	 *  TLS_SESSION_CACHE_ENABLED resumes the previous session when
+	 *  reconnecting. Requires CONFIG_NET_SOCKETS_TLS_SESSION_CACHE.
+	 */
+	int session_cache;
 };
 
 /** @brief MQTT transport type. */
@@ -393,6 +436,19 @@ struct mqtt_transport {
 #endif
 };
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+/** @brief Unacknowledged QoS 1 or QoS 2 publish. */
+struct mqtt_inflight_msg {
+	/** Internal. Message id of the publish. */
+	u16_t message_id;
+
+	/** Internal. Length of the PUBLISH packet, or of the PUBREL packet
+	 *  once the message was released, stored in the in-flight buffer.
+	 */
+	u32_t len;
+};
+#endif /* CONFIG_MQTT_INFLIGHT */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -411,6 +467,19 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	u32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+	/** Internal. Unacknowledged publishes, oldest first. Their packets
+	 *  are stored back to back in the same order in the in-flight buffer.
+	 */
+	struct mqtt_inflight_msg inflight[CONFIG_MQTT_INFLIGHT_WINDOW];
+
+	/** Internal. Number of entries in inflight. */
+	u8_t inflight_count;
+
+	/** Internal. Length of the packets in the in-flight buffer. */
+	u32_t inflight_buf_used;
+#endif /* CONFIG_MQTT_INFLIGHT */
 };
 
 /**
@@ -467,6 +536,16 @@ struct mqtt_client {
 	/** Size of transmit buffer. */
 	u32_t tx_buf_size;
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+	/** Buffer keeping QoS 1 and QoS 2 publishes until they are
+	 *  acknowledged. NULL to send them without tracking.
+	 */
+	u8_t *inflight_buf;
+
+	/** Size of in-flight buffer. */
+	u32_t inflight_buf_size;
+#endif /* CONFIG_MQTT_INFLIGHT */
+
 	/** Keepalive interval for this client in seconds.
 	 *  Default is CONFIG_MQTT_KEEPALIVE.
 	 */
@@ -539,16 +618,51 @@ int mqtt_connect(struct mqtt_client *client);
 /**
  * @brief API to publish messages on topics.
  *
+ * @details With CONFIG_MQTT_INFLIGHT and an in-flight buffer, QoS 1 and
+ * QoS 2 messages are copied to the buffer, so that the application does
+ * not need to wait for the acknowledgment of a message before publishing
+ * the next one. Messages not acknowledged yet are sent again with the DUP
+ * flag once reconnected to a broker which kept the session, and discarded
+ * otherwise.
+ *
  * @param[in] client Client instance for which the procedure is requested.
  *                   Shall not be NULL.
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         With in-flight tracking, -EAGAIN if CONFIG_MQTT_INFLIGHT_WINDOW
+ *         messages wait for an acknowledgment already, -ENOMEM if the
+ *         message does not fit in the in-flight buffer and -EALREADY if a
+ *         message with the same id is in flight.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to publish a message whose payload is produced while sending.
+ *
+ * @details The payload is requested from the producer in parts, each of
+ * which is written to the transport from the transmit buffer of the client,
+ * so that the payload never needs to be in RAM as a whole. The payload
+ * length must be set in param, its data pointer is ignored. The message
+ * is not tracked by CONFIG_MQTT_INFLIGHT. As the message cannot be
+ * completed once part of it was sent, a producer error disconnects the
+ * client.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message.
+ *                  Shall not be NULL.
+ * @param[in] cb Payload producer. Shall not be NULL.
+ * @param[in] user_data User data passed to the producer.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_stream(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			mqtt_payload_cb_t cb, void *user_data);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -686,7 +800,10 @@ int mqtt_live(struct mqtt_client *client);
  *
  * @note In case of PUBLISH message, the payload has to be read separately with
  *       @ref mqtt_read_publish_payload function. The size of the payload to
- *       read is provided in the publish event structure.
+ *       read is provided in the publish event structure. With
+ *       CONFIG_MQTT_PAYLOAD_EVENTS, the payload left unread by the PUBLISH
+ *       event handler is instead notified in chunks with
+ *       MQTT_EVT_PUBLISH_PAYLOAD events, as it is received.
  *
  * @note This is a non-blocking call.
  *
@@ -26,6 +26,7 @@
 #include <net/net_ip.h>
 #include <net/net_if.h>
 #include <net/net_stats.h>
+#include <net/ptp_time.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -178,6 +179,62 @@ typedef struct k_mem_slab *(*net_pkt_get_slab_func_t)(void);
  */
 typedef struct net_buf_pool *(*net_pkt_get_pool_func_t)(void);
 
+/**
+ * @typedef net_context_zerocopy_cb_t
+ * @brief Zero-copy send completion callback.
+ *
+ * @details Called once for every iovec handed over by a MSG_ZEROCOPY
+ * sendmsg, as soon as the networking stack and the network driver no
+ * longer reference its data, which can then be reused by the caller.
+ * This also happens if the send eventually failed. The callback may be
+ * called from the context of any network thread or from an ISR.
+ *
+ * @param data The iov_base of the iovec
+ * @param len The iov_len of the iovec
+ * @param user_data The user data given in struct net_context_zerocopy
+ */
+typedef void (*net_context_zerocopy_cb_t)(const void *data, size_t len,
+					  void *user_data);
+
+/**
+ * @brief Value of the NET_OPT_ZEROCOPY option (and SO_ZEROCOPY sockopt)
+ */
+struct net_context_zerocopy {
+	/** Completion callback, NULL disables zero-copy sends */
+	net_context_zerocopy_cb_t cb;
+	/** User data given to the callback */
+	void *user_data;
+};
+
+/** NET_OPT_TIMESTAMP flag: Report the hardware TX timestamps of the sent
+ *  packets, see net_context_get_tx_timestamp()
+ */
+#define NET_CONTEXT_TIMESTAMP_TX_HW BIT(0)
+
+#if defined(CONFIG_NET_CONTEXT_TX_TIMESTAMP)
+/** @cond INTERNAL_HIDDEN */
+struct net_context_tx_timestamps {
+	struct net_ptp_time ts[CONFIG_NET_CONTEXT_TX_TIMESTAMP_QUEUE];
+	u8_t head;
+	u8_t count;
+};
+/** @endcond */
+#endif
+
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+/** @cond INTERNAL_HIDDEN */
+struct net_context_nexthop {
+	struct in6_addr dst;
+	struct in6_addr nexthop;
+	struct net_if *iface;
+	/* Route generation this is valid for, 0 if unused */
+	u32_t gen;
+	/* No route was found, the packet is sent to dst directly */
+	bool direct;
+};
+/** @endcond */
+#endif
+
 struct net_tcp;
 
 struct net_conn_handle;
@@ -267,6 +324,11 @@ struct net_context {
 	/** TLS context information */
 	struct tls_context *tls;
 #endif /* CONFIG_NET_SOCKETS_SOCKOPT_TLS */
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** Entries of the epoll instances the socket belongs to */
+	sys_slist_t epoll_entries;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -285,11 +347,18 @@ struct net_context {
 		u8_t priority;
 #endif
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMP)
-		bool timestamp;
+		/** Timestamping flags, any non-zero value also enables
+		 *  TX time statistics
+		 */
+		u8_t timestamp;
 #endif
 #if defined(CONFIG_NET_CONTEXT_TXTIME)
 		bool txtime;
 #endif
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+		/** Completion of the zero-copy sends of this context */
+		struct net_context_zerocopy zerocopy;
+#endif
 #if defined(CONFIG_SOCKS)
 		struct {
 			struct sockaddr addr;
@@ -298,6 +367,16 @@ struct net_context {
 #endif
 	} options;
 
+#if defined(CONFIG_NET_CONTEXT_TX_TIMESTAMP)
+	/** TX timestamps not yet read by the application */
+	struct net_context_tx_timestamps tx_ts;
+#endif
+
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+	/** Next hop of the last IPv6 destination sent to */
+	struct net_context_nexthop nexthop;
+#endif
+
 	/** Protocol (UDP, TCP or IEEE 802.3 protocol value) */
 	u16_t proto;
 
@@ -971,6 +1050,7 @@ enum net_context_option {
 	NET_OPT_TIMESTAMP	= 2,
 	NET_OPT_TXTIME		= 3,
 	NET_OPT_SOCKS5		= 4,
+	NET_OPT_ZEROCOPY	= 5,
 };
 
 /**
@@ -1001,6 +1081,34 @@ int net_context_get_option(struct net_context *context,
 			   enum net_context_option option,
 			   void *value, size_t *len);
 
+/**
+ * @brief Get the oldest unread hardware TX timestamp of this context.
+ *
+ * @details With the NET_CONTEXT_TIMESTAMP_TX_HW flag set in the
+ * NET_OPT_TIMESTAMP option, the time at which every sent datagram left
+ * the network device is queued to the context, once the driver reports
+ * it. Only the most recent CONFIG_NET_CONTEXT_TX_TIMESTAMP_QUEUE
+ * timestamps are kept.
+ *
+ * @param context The network context to use.
+ * @param timestamp Filled with the timestamp.
+ *
+ * @return 0 if ok, -EAGAIN if there is no timestamp available.
+ */
+#if defined(CONFIG_NET_CONTEXT_TX_TIMESTAMP)
+int net_context_get_tx_timestamp(struct net_context *context,
+				 struct net_ptp_time *timestamp);
+#else
+static inline int net_context_get_tx_timestamp(struct net_context *context,
+					       struct net_ptp_time *timestamp)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(timestamp);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @typedef net_context_cb_t
  * @brief Callback used while iterating over network contexts
@@ -83,6 +83,22 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Same as net_recv_data(), but called by a network device driver
+ * that already knows to which flow the packet belongs, typically because
+ * the hardware distributes the received packets over several queues.
+ *
+ * @details The packets of the same flow are processed in the order they
+ * were received, see CONFIG_NET_RX_FLOW_WORKERS.
+ *
+ * @param iface Network interface where the packet was received.
+ * @param pkt Network packet data.
+ * @param flow Flow hash or hardware queue the packet was received from.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int net_recv_data_flow(struct net_if *iface, struct net_pkt *pkt, u32_t flow);
+
 /**
  * @brief Send data to network.
  *
@@ -44,6 +44,32 @@ enum net_event_if_cmd {
 #define NET_EVENT_IF_UP					\
 	(_NET_EVENT_IF_BASE | NET_EVENT_IF_CMD_UP)
 
+/* Network packet pool events */
+#define _NET_PKT_LAYER		NET_MGMT_LAYER_L2
+#define _NET_PKT_CORE_CODE	0x002
+#define _NET_EVENT_PKT_BASE	(NET_MGMT_EVENT_BIT |			\
+				 NET_MGMT_LAYER(_NET_PKT_LAYER) |	\
+				 NET_MGMT_LAYER_CODE(_NET_PKT_CORE_CODE))
+
+enum net_event_pkt_cmd {
+	NET_EVENT_PKT_CMD_RX_POOL_LOW = 1,
+	NET_EVENT_PKT_CMD_RX_POOL_OK,
+	NET_EVENT_PKT_CMD_TX_POOL_LOW,
+	NET_EVENT_PKT_CMD_TX_POOL_OK,
+};
+
+#define NET_EVENT_PKT_RX_POOL_LOW				\
+	(_NET_EVENT_PKT_BASE | NET_EVENT_PKT_CMD_RX_POOL_LOW)
+
+#define NET_EVENT_PKT_RX_POOL_OK				\
+	(_NET_EVENT_PKT_BASE | NET_EVENT_PKT_CMD_RX_POOL_OK)
+
+#define NET_EVENT_PKT_TX_POOL_LOW				\
+	(_NET_EVENT_PKT_BASE | NET_EVENT_PKT_CMD_TX_POOL_LOW)
+
+#define NET_EVENT_PKT_TX_POOL_OK				\
+	(_NET_EVENT_PKT_BASE | NET_EVENT_PKT_CMD_TX_POOL_OK)
+
 /* IPv6 Events */
 #define _NET_IPV6_LAYER		NET_MGMT_LAYER_L3
 #define _NET_IPV6_CORE_CODE	0x060
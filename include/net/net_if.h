@@ -97,7 +97,10 @@ struct net_if_mcast_addr {
 	/** Did we join to this group */
 	u8_t is_joined : 1;
 
-	u8_t _unused : 6;
+	/** Is the join of this group not reported yet */
+	u8_t is_report_pending : 1;
+
+	u8_t _unused : 5;
 };
 
 /**
@@ -304,6 +307,11 @@ struct net_if_dhcpv4 {
 	/** Requested IP addr */
 	struct in_addr requested_ip;
 
+#if defined(CONFIG_NET_DHCPV4_INIT_REBOOT)
+	/** IP addr of the previous lease, requested first on restart */
+	struct in_addr previous_ip;
+#endif
+
 	/**
 	 *  DHCPv4 client state in the process of network
 	 *  address allocation.
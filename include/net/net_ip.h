@@ -236,6 +236,19 @@ struct cmsghdr {
 	/* Followed by unsigned char cmsg_data[]; */
 };
 
+/* Ancillary data of received IPv4 packets (IP_PKTINFO) */
+struct in_pktinfo {
+	unsigned int   ipi_ifindex;  /* Interface index */
+	struct in_addr ipi_spec_dst; /* Local address */
+	struct in_addr ipi_addr;     /* Header destination address */
+};
+
+/* Ancillary data of received IPv6 packets (IPV6_PKTINFO) */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /* Destination address */
+	unsigned int    ipi6_ifindex; /* Interface index */
+};
+
 /* Alignment for headers and data. These are arch specific but define
  * them here atm if not found alredy.
  */
@@ -415,6 +428,7 @@ enum net_addr_state {
 	NET_ADDR_TENTATIVE = 0,  /**< Tentative address              */
 	NET_ADDR_PREFERRED,      /**< Preferred address              */
 	NET_ADDR_DEPRECATED,     /**< Deprecated address             */
+	NET_ADDR_OPTIMISTIC,     /**< Optimistic address, RFC 4429   */
 } __packed;
 
 /** How the network address is assigned to network interface */
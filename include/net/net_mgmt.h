@@ -145,7 +145,8 @@ struct net_mgmt_event_callback {
 	/** A mask of network events on which the above handler should be
 	 * called in case those events come. Such mask can be modified
 	 * whenever necessary by the owner, and thus will affect the handler
-	 * being called or not.
+	 * being called or not. The layer must not be changed while the
+	 * callback is added, as callbacks are indexed by their layer.
 	 */
 	union {
 		/** A mask of network events on which the above handler should
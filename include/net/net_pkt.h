@@ -110,6 +110,13 @@ struct net_pkt {
 	};
 #endif /* CONFIG_NET_PKT_TIMESTAMP || CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+	/** Cycle counter value at the end of the last stage the packet went
+	 * through, for the per-stage latency statistics.
+	 */
+	u32_t stage_time;
+#endif /* CONFIG_NET_STATISTICS_LATENCY */
+
 	/** Reference counter */
 	atomic_t atomic_ref;
 
@@ -163,6 +170,12 @@ struct net_pkt {
 		u8_t ppp_msg           : 1; /* This is a PPP message */
 	};
 
+	u8_t tx_timestamping : 1; /* For outgoing packet: report the TX
+				   * timestamp to the sending context.
+				   * Used only if
+				   * defined(CONFIG_NET_CONTEXT_TX_TIMESTAMP)
+				   */
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -187,6 +200,13 @@ struct net_pkt {
 	u16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Payload size of the segments this TCP packet is split into by
+	 * the link layer or the hardware, 0 if it fits the MTU.
+	 */
+	u16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_IPV6)
 	u16_t ipv6_ext_len;	/* length of extension headers */
 
@@ -300,6 +320,17 @@ static inline void net_pkt_set_gptp(struct net_pkt *pkt, bool is_gptp)
 	pkt->gptp_pkt = is_gptp;
 }
 
+static inline bool net_pkt_is_tx_timestamping(struct net_pkt *pkt)
+{
+	return !!(pkt->tx_timestamping);
+}
+
+static inline void net_pkt_set_tx_timestamping(struct net_pkt *pkt,
+					       bool tx_timestamping)
+{
+	pkt->tx_timestamping = tx_timestamping;
+}
+
 static inline u8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 	return pkt->ip_hdr_len;
@@ -742,6 +773,58 @@ static inline void net_pkt_set_txtime(struct net_pkt *pkt, u64_t txtime)
 }
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+static inline u32_t net_pkt_stage_time(struct net_pkt *pkt)
+{
+	return pkt->stage_time;
+}
+
+static inline void net_pkt_set_stage_time(struct net_pkt *pkt,
+					  u32_t stage_time)
+{
+	pkt->stage_time = stage_time;
+}
+#else
+static inline u32_t net_pkt_stage_time(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_stage_time(struct net_pkt *pkt,
+					  u32_t stage_time)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(stage_time);
+}
+#endif /* CONFIG_NET_STATISTICS_LATENCY */
+
+#if defined(CONFIG_NET_TCP_GSO)
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, u16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, u16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static inline size_t net_pkt_get_len(struct net_pkt *pkt)
 {
 	return net_buf_frags_len(pkt->frags);
@@ -1190,6 +1273,29 @@ void net_pkt_get_info(struct k_mem_slab **rx,
 		      struct net_buf_pool **rx_data,
 		      struct net_buf_pool **tx_data);
 
+/**
+ * @brief Check if the RX or TX pool is below its low watermark.
+ *
+ * @details The pool stays low until its free packets and buffers get back
+ * to the high watermark, see CONFIG_NET_PKT_WATERMARKS.
+ *
+ * @return True if the pool is low, False otherwise.
+ */
+#if defined(CONFIG_NET_PKT_WATERMARKS)
+bool net_pkt_rx_pool_is_low(void);
+bool net_pkt_tx_pool_is_low(void);
+#else
+static inline bool net_pkt_rx_pool_is_low(void)
+{
+	return false;
+}
+
+static inline bool net_pkt_tx_pool_is_low(void)
+{
+	return false;
+}
+#endif /* CONFIG_NET_PKT_WATERMARKS */
+
 /** @cond INTERNAL_HIDDEN */
 
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
@@ -228,6 +228,93 @@ struct net_stats_tc {
 	} recv[NET_TC_RX_COUNT];
 };
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+/**
+ * @brief Stages of the receive path of a network packet
+ *
+ * Each stage is measured from the end of the previous one, the first one
+ * from the allocation of the packet.
+ */
+enum net_stats_rx_stage {
+	/** Driver, until the packet is passed to net_recv_data() */
+	NET_STATS_RX_DRIVER,
+
+	/** Waiting in the RX queue for the RX thread */
+	NET_STATS_RX_QUEUE,
+
+	/** L2 processing */
+	NET_STATS_RX_L2,
+
+	/** IP processing, until the connection lookup */
+	NET_STATS_RX_IP,
+
+	/** Connection lookup and transport processing, until the packet is
+	 * queued to the socket.
+	 */
+	NET_STATS_RX_CONN,
+
+	/** Waiting in the socket receive queue for the application */
+	NET_STATS_RX_SOCKET,
+
+	/** Copying the data of a datagram to the application */
+	NET_STATS_RX_APP,
+
+	/** Number of receive stages */
+	NET_STATS_RX_STAGES
+};
+
+/**
+ * @brief Stages of the transmit path of a network packet
+ *
+ * Each stage is measured from the end of the previous one, the first one
+ * from the allocation of the packet.
+ */
+enum net_stats_tx_stage {
+	/** Building the packet, until it is passed to net_send_data() */
+	NET_STATS_TX_SOCKET,
+
+	/** Address checks and neighbor resolution, until it is queued */
+	NET_STATS_TX_IP,
+
+	/** Waiting in the TX queue for the TX thread */
+	NET_STATS_TX_QUEUE,
+
+	/** L2 processing and sending by the driver */
+	NET_STATS_TX_DRIVER,
+
+	/** Number of transmit stages */
+	NET_STATS_TX_STAGES
+};
+
+/**
+ * @brief Time spent by network packets in a stage of the stack
+ */
+struct net_stats_latency {
+	/** Sum of the times, in microseconds */
+	u64_t time_sum;
+
+	/** Number of packets measured */
+	net_stats_t time_count;
+
+	/** Longest time, in microseconds */
+	u32_t time_max;
+
+	/** Histogram of the times: hist[0] counts the times below one
+	 * microsecond, hist[i] the times from 2^(i-1) up to 2^i
+	 * microseconds, and the last bucket all the longer times.
+	 */
+	net_stats_t hist[CONFIG_NET_STATISTICS_LATENCY_BUCKETS];
+};
+
+/**
+ * @brief Per-stage latency statistics of the receive and transmit paths
+ */
+struct net_stats_pkt_latency {
+	struct net_stats_latency rx[NET_STATS_RX_STAGES];
+	struct net_stats_latency tx[NET_STATS_TX_STAGES];
+};
+#endif /* CONFIG_NET_STATISTICS_LATENCY */
+
 /**
  * @brief All network statistics in one struct.
  */
@@ -244,6 +331,12 @@ struct net_stats {
 	/** IP layer errors */
 	struct net_stats_ip_errors ip_errors;
 
+	/**
+	 * Number of L2 headers written into the headroom of the packet
+	 * instead of a separately allocated and inserted fragment.
+	 */
+	net_stats_t l2_hdr_in_place;
+
 #if defined(CONFIG_NET_STATISTICS_IPV6)
 	/** IPv6 statistics */
 	struct net_stats_ip ipv6;
@@ -288,6 +381,11 @@ struct net_stats {
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
 #endif
+
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+	/** Time spent by network packets in each stage of the stack */
+	struct net_stats_pkt_latency latency;
+#endif
 };
 
 /**
@@ -412,6 +510,7 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_TCP,
 	NET_REQUEST_STATS_CMD_GET_ETHERNET,
 	NET_REQUEST_STATS_CMD_GET_PPP,
+	NET_REQUEST_STATS_CMD_GET_LATENCY,
 };
 
 #define NET_REQUEST_STATS_GET_ALL				\
@@ -490,6 +589,13 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_ETHERNET);
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PPP);
 #endif /* CONFIG_NET_STATISTICS_PPP */
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+#define NET_REQUEST_STATS_GET_LATENCY				\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_LATENCY)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_LATENCY);
+#endif /* CONFIG_NET_STATISTICS_LATENCY */
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
 
 /**
@@ -79,6 +79,24 @@ __deprecated int sntp_request(struct sntp_ctx *ctx, u32_t timeout,
 int sntp_query(struct sntp_ctx *ctx, u32_t timeout,
 	       struct sntp_time *time);
 
+/**
+ * @brief Perform SNTP query, also giving when the server received it
+ *
+ * Same as sntp_query(), with the receive timestamp of the server as well
+ * as its transmit timestamp. With the local times of the request and of
+ * the response, they give the round trip delay of the query and the
+ * offset of the local clock, see RFC 4330.
+ *
+ * @param ctx Address of sntp context.
+ * @param timeout Timeout of waiting for sntp response (in milliseconds).
+ * @param rx_time Time the server received the request (output), or NULL.
+ * @param tx_time Time the server sent the response (output).
+ *
+ * @return 0 if ok, <0 if error (-ETIMEDOUT if timeout).
+ */
+int sntp_query_times(struct sntp_ctx *ctx, u32_t timeout,
+		     struct sntp_time *rx_time, struct sntp_time *tx_time);
+
 /**
  * @brief Release SNTP context
  *
@@ -102,6 +120,32 @@ void sntp_close(struct sntp_ctx *ctx);
 int sntp_simple(const char *server, u32_t timeout,
 		struct sntp_time *time);
 
+/**
+ * @brief Synchronize the realtime clock now
+ *
+ * With CONFIG_SNTP_CLOCK, the POSIX CLOCK_REALTIME clock is kept
+ * synchronized in the background: each of the CONFIG_SNTP_CLOCK_SERVERS
+ * is queried several times, the sample of lowest round trip delay of each
+ * one is kept, and the clock is corrected by the median of their offsets.
+ * The first correction, or one larger than
+ * CONFIG_SNTP_CLOCK_STEP_THRESHOLD, sets the clock, the others slew it
+ * with adjtime(). Applications read the time with clock_gettime(),
+ * without querying a server.
+ *
+ * This function runs a synchronization without waiting for the next one,
+ * e.g. once the network is up.
+ *
+ * @return 0 if ok, <0 if error (-ENOENT if no server answered in time).
+ */
+int sntp_clock_sync(void);
+
+/**
+ * @brief Check that the realtime clock was synchronized
+ *
+ * @return true once the clock was set from the SNTP servers.
+ */
+bool sntp_clock_is_synced(void);
+
 #ifdef __cplusplus
 }
 #endif
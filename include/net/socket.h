@@ -26,6 +26,8 @@
 #include <net/net_ip.h>
 #include <net/dns_resolve.h>
 #include <net/socket_select.h>
+#include <net/socket_epoll.h>
+#include <net/socket_buf.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -56,6 +58,14 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_PEEK 0x02
 /** zsock_recv/zsock_send: Override operation to non-blocking */
 #define ZSOCK_MSG_DONTWAIT 0x40
+/** zsock_sendmsg: Send the iovec data without copying it, see SO_ZEROCOPY */
+#define ZSOCK_MSG_ZEROCOPY 0x4000000
+/** zsock_recvmsg: Control data was discarded (output value only) */
+#define ZSOCK_MSG_CTRUNC 0x08
+/** zsock_recvmsg: Datagram was longer than the buffers (output value only) */
+#define ZSOCK_MSG_TRUNC 0x20
+/** zsock_recvmsg: Read a TX timestamp instead of data, see SO_TIMESTAMPING */
+#define ZSOCK_MSG_ERRQUEUE 0x2000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -119,6 +129,68 @@ struct zsock_pollfd {
  *    - 1 - server
  */
 #define TLS_DTLS_ROLE 6
+/** Socket option to enable the TLS session cache on a socket. It accepts and
+ *  returns an integer, TLS_SESSION_CACHE_DISABLED (default) or
+ *  TLS_SESSION_CACHE_ENABLED.
+ *
+ *  On clients, the session negotiated by a handshake is kept, keyed by
+ *  the hostname and the credentials of the socket, and offered again on the
+ *  next connection with the same hostname and credentials, either by session
+ *  ID or by session ticket (RFC 5077), as supported by the server. On
+ *  servers, sessions are cached and tickets issued when mbedTLS supports it.
+ */
+#define TLS_SESSION_CACHE 7
+/** Write-only socket option to remove all the sessions from the TLS session
+ *  cache. The value is ignored.
+ */
+#define TLS_SESSION_CACHE_PURGE 8
+/** Read-only socket option to read the TLS session cache statistics. It
+ *  returns a struct tls_session_cache_stats.
+ */
+#define TLS_SESSION_CACHE_STATS 9
+/** Socket option to use the DTLS Connection ID extension (RFC 9146), so that
+ *  a DTLS connection survives a change of the client address, such as a NAT
+ *  rebinding. It accepts and returns an integer:
+ *    - TLS_DTLS_CID_DISABLED - no connection ID (default)
+ *    - TLS_DTLS_CID_SUPPORTED - use the connection ID chosen by the peer,
+ *      without asking the peer to use one
+ *    - TLS_DTLS_CID_ENABLED - also ask the peer to use our connection ID,
+ *      DTLS servers then follow clients whose address changed
+ *
+ *  The option must be set before the handshake. It requires mbedTLS to be
+ *  built with MBEDTLS_SSL_DTLS_CONNECTION_ID.
+ */
+#define TLS_DTLS_CID 10
+/** Read-only socket option to read the DTLS Connection ID status once the
+ *  handshake is done. It returns an integer, one of TLS_DTLS_CID_STATUS_*.
+ */
+#define TLS_DTLS_CID_STATUS 11
+
+/** Values for TLS_DTLS_CID option */
+#define TLS_DTLS_CID_DISABLED 0
+#define TLS_DTLS_CID_SUPPORTED 1
+#define TLS_DTLS_CID_ENABLED 2
+
+/** Values for TLS_DTLS_CID_STATUS option */
+#define TLS_DTLS_CID_STATUS_DISABLED 0
+/** The peer sends our connection ID */
+#define TLS_DTLS_CID_STATUS_DOWNLINK 1
+/** We send the connection ID of the peer */
+#define TLS_DTLS_CID_STATUS_UPLINK 2
+#define TLS_DTLS_CID_STATUS_BIDIRECTIONAL 3
+
+/** Values for TLS_SESSION_CACHE option */
+#define TLS_SESSION_CACHE_DISABLED 0
+#define TLS_SESSION_CACHE_ENABLED 1
+
+/** TLS session cache statistics, shared by all the client sockets. */
+struct tls_session_cache_stats {
+	/** Handshakes which resumed a cached session */
+	u32_t hits;
+
+	/** Handshakes which negotiated a new session */
+	u32_t misses;
+};
 
 /** @} */
 
@@ -301,6 +373,62 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Receive a message from an arbitrary network address
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description.
+ * This function is also exposed as ``recvmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * If msg_control is set, datagrams come with the IP_PKTINFO (IPv4) or
+ * IPV6_PKTINFO (IPv6) ancillary data, and, with
+ * :option:`CONFIG_NET_PKT_TIMESTAMP`, an SO_TIMESTAMPING message holding
+ * the struct net_ptp_time RX timestamp of the packet.
+ *
+ * With ZSOCK_MSG_ERRQUEUE, no data is read; instead the oldest hardware
+ * TX timestamp of the socket (see SOF_TIMESTAMPING_TX_HARDWARE) is
+ * returned as an SO_TIMESTAMPING message, and msg_flags has
+ * ZSOCK_MSG_ERRQUEUE set. This never blocks: -1 with errno EAGAIN is
+ * returned if no timestamp is available.
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/** Message of a zsock_recvmmsg() batch */
+struct zsock_mmsghdr {
+	/** Message, as for zsock_recvmsg() */
+	struct msghdr msg_hdr;
+	/** Number of bytes received into the message (output value) */
+	unsigned int msg_len;
+};
+
+/**
+ * @brief Receive several datagrams at once
+ *
+ * @details
+ * @rst
+ * Linux extension, see `recvmmsg(2)
+ * <http://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__.
+ * This function is also exposed as ``recvmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * Only waits for the first datagram, like the MSG_WAITFORONE Linux flag,
+ * then takes as many of the already queued ones as fit into msgvec.
+ * There is no timeout argument, MSG_PEEK is not supported and the
+ * socket has to be a datagram one. For calls from user mode vlen is
+ * capped to 32.
+ *
+ * @return Number of messages received, -1 with errno set if there was
+ * none.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -624,6 +752,19 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+#define mmsghdr zsock_mmsghdr
+
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -728,6 +869,10 @@ static inline int inet_pton(sa_family_t family, const char *src, void *dst)
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
+#define MSG_ZEROCOPY ZSOCK_MSG_ZEROCOPY
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
+#define MSG_TRUNC ZSOCK_MSG_TRUNC
+#define MSG_ERRQUEUE ZSOCK_MSG_ERRQUEUE
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -758,16 +903,34 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /** sockopt: Async error (ignored, for compatibility) */
 #define SO_ERROR 4
 
-/** sockopt: Timestamp TX packets */
+/** sockopt: Timestamp TX packets, int value of SOF_TIMESTAMPING_* flags */
 #define SO_TIMESTAMPING 37
+/** cmsg: RX or TX timestamp of a packet, see zsock_recvmsg() */
+#define SCM_TIMESTAMPING SO_TIMESTAMPING
+
+/** SO_TIMESTAMPING flag: Queue the hardware TX timestamp of every sent
+ *  datagram, to be read with ZSOCK_MSG_ERRQUEUE. Needs
+ *  :option:`CONFIG_NET_CONTEXT_TX_TIMESTAMP`.
+ */
+#define SOF_TIMESTAMPING_TX_HARDWARE 0x01
+/** SO_TIMESTAMPING flag: Hardware RX timestamps, for compatibility as
+ *  these are always reported
+ */
+#define SOF_TIMESTAMPING_RX_HARDWARE 0x04
 
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
 
+/* Socket options for IPPROTO_IP level */
+/** cmsg: Receive interface and destination address, struct in_pktinfo */
+#define IP_PKTINFO 8
+
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
+/** cmsg: Receive interface and destination address, struct in6_pktinfo */
+#define IPV6_PKTINFO 50
 
 /** sockopt: Socket priority */
 #define SO_PRIORITY 12
@@ -780,6 +943,11 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /** sockopt: Enable SOCKS5 for Socket */
 #define SO_SOCKS5 60
 
+/** sockopt: Set the completion callback of MSG_ZEROCOPY sends, the value
+ * is a struct net_context_zerocopy
+ */
+#define SO_ZEROCOPY 62
+
 /** @cond INTERNAL_HIDDEN */
 /**
  * @brief Registration information for a given BSD socket family.
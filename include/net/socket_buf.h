@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2019 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Socket data buffers shared with user mode
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_BUF_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_BUF_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <sys/types.h>
+#include <kernel.h>
+#include <sys/slist.h>
+#include <net/net_ip.h>
+#include <app_memory/app_memdomain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_USER_BUFS)
+
+/** Size of the data of each socket buffer */
+#define ZSOCK_BUF_SIZE CONFIG_NET_SOCKETS_USER_BUF_SIZE
+
+/** Number of socket buffers of each pool */
+#define ZSOCK_BUF_COUNT CONFIG_NET_SOCKETS_USER_BUF_COUNT
+
+/**
+ * @brief Pool of socket buffers of a memory domain
+ *
+ * The data of the buffers lives in a memory partition of its own, the
+ * state of the pool in kernel memory.
+ */
+struct zsock_buf_pool {
+	/** Partition of the data of the buffers */
+	struct k_mem_partition *partition;
+	/** Data of the buffers */
+	u8_t (*data)[ZSOCK_BUF_SIZE];
+
+	/* Private, used by the socket buffer calls */
+	sys_snode_t node;
+	struct k_mem_domain *domain;
+	struct k_sem free_sem;
+	bool in_use[ZSOCK_BUF_COUNT];
+};
+
+/**
+ * @brief Statically define a pool of socket buffers
+ *
+ * Also defines the partition of the data of the pool, named after the pool
+ * with a _partition suffix. The pool must then be given to a memory domain
+ * with zsock_buf_pool_attach().
+ *
+ * @param name Name of the pool.
+ */
+#define ZSOCK_BUF_POOL_DEFINE(name) \
+	K_APPMEM_PARTITION_DEFINE(name##_partition); \
+	K_APP_BMEM(name##_partition) static u8_t __aligned(4) \
+		name##_data[ZSOCK_BUF_COUNT][ZSOCK_BUF_SIZE]; \
+	struct zsock_buf_pool name = { \
+		.partition = &name##_partition, \
+		.data = name##_data, \
+		.free_sem = Z_SEM_INITIALIZER(name.free_sem, \
+					      ZSOCK_BUF_COUNT, \
+					      ZSOCK_BUF_COUNT), \
+	}
+
+/**
+ * @brief Give a pool of socket buffers to a memory domain
+ *
+ * Adds the partition of the pool to the domain, whose user threads then
+ * allocate their socket buffers from the pool. As no other domain has the
+ * partition, the data of the buffers is only accessible to the threads of
+ * the domain. A pool belongs to a single domain, and a domain has a single
+ * pool.
+ *
+ * Only callable from supervisor mode.
+ *
+ * @param pool Pool of socket buffers.
+ * @param domain Memory domain of the user threads of the pool.
+ */
+void zsock_buf_pool_attach(struct zsock_buf_pool *pool,
+			   struct k_mem_domain *domain);
+
+/**
+ * @brief Allocate a socket buffer
+ *
+ * The buffer comes from the pool of the memory domain of the calling
+ * thread, only the threads of that domain can use it.
+ *
+ * @param timeout Time to wait for a free buffer (in milliseconds), or one
+ *        of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return ZSOCK_BUF_SIZE bytes of data of the buffer, or NULL with errno
+ *         set to EAGAIN if none was freed in time, or to EPERM if the
+ *         domain of the calling thread has no pool.
+ */
+__syscall void *zsock_buf_alloc(s32_t timeout);
+
+/**
+ * @brief Free a socket buffer
+ *
+ * @param buf Buffer from zsock_buf_alloc().
+ *
+ * @return 0 on success, -1 with errno set to EBADF if @a buf is not a
+ *         buffer of the domain of the calling thread.
+ */
+__syscall int zsock_buf_free(void *buf);
+
+/**
+ * @brief Send the data of a socket buffer
+ *
+ * Same as zsock_sendto(), except that the data comes from the socket
+ * buffer: only its address is checked, instead of the whole data being
+ * validated as user memory. The buffer still belongs to the caller once
+ * sent.
+ *
+ * @param sock Socket.
+ * @param buf Buffer from zsock_buf_alloc().
+ * @param len Bytes of the buffer to send, at most ZSOCK_BUF_SIZE.
+ * @param flags Flags of zsock_sendto().
+ * @param dest_addr Destination address, or NULL for a connected socket.
+ * @param addrlen Size of @a dest_addr.
+ */
+__syscall ssize_t zsock_sendto_buf(int sock, const void *buf, size_t len,
+				   int flags, const struct sockaddr *dest_addr,
+				   socklen_t addrlen);
+
+/**
+ * @brief Receive data into a socket buffer
+ *
+ * Same as zsock_recvfrom(), for the ZSOCK_BUF_SIZE bytes of a socket
+ * buffer.
+ *
+ * @param sock Socket.
+ * @param buf Buffer from zsock_buf_alloc().
+ * @param flags Flags of zsock_recvfrom().
+ * @param src_addr Source address of the data, or NULL.
+ * @param addrlen Size of @a src_addr, updated with the size of the
+ *        address.
+ */
+__syscall ssize_t zsock_recvfrom_buf(int sock, void *buf, int flags,
+				     struct sockaddr *src_addr,
+				     socklen_t *addrlen);
+
+#include <syscalls/socket_buf.h>
+
+#endif /* CONFIG_NET_SOCKETS_USER_BUFS */
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_BUF_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2019 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** zsock_epoll_ctl: Readable, same value as ZSOCK_POLLIN */
+#define ZSOCK_EPOLLIN 0x001
+/** zsock_epoll_ctl: Writable, same value as ZSOCK_POLLOUT */
+#define ZSOCK_EPOLLOUT 0x004
+/** zsock_epoll_wait: Error condition (output value only) */
+#define ZSOCK_EPOLLERR 0x008
+/** zsock_epoll_wait: Peer closed the connection (output value only) */
+#define ZSOCK_EPOLLHUP 0x010
+/** zsock_epoll_ctl: Disable the socket once it has been reported */
+#define ZSOCK_EPOLLONESHOT (1U << 30)
+/** zsock_epoll_ctl: Edge triggered, report readiness changes only */
+#define ZSOCK_EPOLLET (1U << 31)
+
+/** zsock_epoll_ctl: Add a socket */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Remove a socket */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a socket */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	u32_t u32;
+	u64_t u64;
+} zsock_epoll_data_t;
+
+struct zsock_epoll_event {
+	u32_t events;
+	zsock_epoll_data_t data;
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man7/epoll.7.html>`__
+ * for the description of the epoll interface. Unlike :c:func:`zsock_poll()`,
+ * which looks at every socket it is given on each call, an epoll instance
+ * keeps a set of sockets which notify it when they receive data or
+ * connections, so that the cost of a wait depends on the number of ready
+ * sockets only. The instance is released with :c:func:`zsock_close()`.
+ * In Zephyr, epoll instances are only available to kernel threads, and
+ * only work with TCP and UDP sockets.
+ * This function is also exposed as ``epoll_create()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param size Ignored, must be greater than zero
+ *
+ * @return File descriptor of the instance, or -1 with errno set
+ */
+int zsock_epoll_create(int size);
+
+/**
+ * @brief Add, modify or remove a socket of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for normative description. Closing a socket removes it from the epoll
+ * instances it belongs to. ZSOCK_EPOLLOUT is always reported, as sockets
+ * are always writable in Zephyr.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for sockets of an epoll instance to be ready
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for normative description. Ready sockets are reported in turn when there
+ * are more of them than ``maxevents``.
+ * This function is also exposed as ``epoll_wait()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define epoll_data_t zsock_epoll_data_t
+#define epoll_event zsock_epoll_event
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+static inline int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -158,6 +158,8 @@ static inline void freeaddrinfo(struct addrinfo *res)
 	return socket_ops->freeaddrinfo(res);
 }
 
+ssize_t sendmsg(int sock, const struct msghdr *message, int flags);
+
 int fcntl(int fd, int cmd, ...);
 
 #ifdef __cplusplus
@@ -54,6 +54,8 @@ struct socket_offload {
 	ssize_t (*send)(int sock, const void *buf, size_t len, int flags);
 	ssize_t (*sendto)(int sock, const void *buf, size_t len, int flags,
 			  const struct sockaddr *to, socklen_t tolen);
+	/* Optional, lets the provider gather the buffers itself */
+	ssize_t (*sendmsg)(int sock, const struct msghdr *msg, int flags);
 	int (*getaddrinfo)(const char *node, const char *service,
 			   const struct addrinfo *hints,
 			   struct addrinfo **res);
@@ -19,6 +19,10 @@ extern "C" {
 
 typedef void *mqd_t;
 
+#ifdef CONFIG_MQUEUE_PRIO_MAX
+#define MQ_PRIO_MAX CONFIG_MQUEUE_PRIO_MAX
+#endif
+
 typedef struct mq_attr {
 	long mq_flags;
 	long mq_maxmsg;
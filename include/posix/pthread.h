@@ -488,6 +488,7 @@ int pthread_attr_getstack(const pthread_attr_t *attr,
 			  void **stackaddr, size_t *stacksize);
 int pthread_attr_setstack(pthread_attr_t *attr, void *stackaddr,
 			  size_t stacksize);
+int pthread_attr_setstacksize(pthread_attr_t *attr, size_t stacksize);
 int pthread_once(pthread_once_t *once, void (*initFunc)(void));
 void pthread_exit(void *retval);
 int pthread_join(pthread_t thread, void **status);
@@ -518,4 +519,31 @@ int pthread_key_delete(pthread_key_t key);
 int pthread_setspecific(pthread_key_t key, const void *value);
 void *pthread_getspecific(pthread_key_t key);
 
+#ifdef CONFIG_PTHREAD_WORKQUEUE
+/* Routine queued to the pthread worker pool */
+struct pthread_work {
+	struct k_work work;
+	void *(*routine)(void *);
+	void *arg;
+};
+
+/**
+ * @brief Run a routine on the pthread worker pool.
+ *
+ * The routine runs on the first idle worker thread, which is not a pthread:
+ * it must return instead of calling pthread_exit() and cannot be joined,
+ * detached or cancelled. Its return value is ignored. @a work must stay
+ * valid until the routine has started.
+ *
+ * @param work Work item, may be reused once the routine has started.
+ * @param routine Routine to run.
+ * @param arg Argument passed to @a routine.
+ *
+ * @retval 0 Routine queued.
+ * @retval EBUSY @a work is still queued.
+ */
+int pthread_work_submit(struct pthread_work *work, void *(*routine)(void *),
+			void *arg);
+#endif /* CONFIG_PTHREAD_WORKQUEUE */
+
 #endif /* ZEPHYR_INCLUDE_POSIX_PTHREAD_H_ */
@@ -30,6 +30,7 @@ extern "C" {
 #endif
 
 int gettimeofday(struct timeval *tv, const void *tz);
+int adjtime(const struct timeval *delta, struct timeval *olddelta);
 
 #ifdef __cplusplus
 }
@@ -9,6 +9,7 @@
 
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -212,6 +213,56 @@ extern bool sys_pm_ctrl_is_state_enabled(enum power_states state);
 
 #endif /* CONFIG_SYS_PM_STATE_LOCK */
 
+#ifdef CONFIG_SYS_PM_LATENCY
+/**
+ * @brief Wake latency constraint
+ *
+ * Owned by the driver or subsystem setting it, e.g. a radio driver with
+ * an event scheduled soon. The fields are private.
+ */
+struct sys_pm_latency_req {
+	sys_snode_t node;
+	u32_t max_us;
+};
+
+/**
+ * @brief Add a wake latency constraint
+ *
+ * @details Power states whose exit latency exceeds the lowest constraint
+ *	    set are not selected by the Zephyr power management policies.
+ *	    Can be called from interrupt context.
+ *
+ * @param [in] req Constraint, not already added.
+ * @param [in] max_us Largest tolerated exit latency in microseconds.
+ */
+extern void sys_pm_latency_request(struct sys_pm_latency_req *req,
+				   u32_t max_us);
+
+/**
+ * @brief Change the value of a wake latency constraint
+ *
+ * @param [in] req Constraint previously added.
+ * @param [in] max_us Largest tolerated exit latency in microseconds.
+ */
+extern void sys_pm_latency_update(struct sys_pm_latency_req *req,
+				  u32_t max_us);
+
+/**
+ * @brief Remove a wake latency constraint
+ *
+ * @param [in] req Constraint previously added.
+ */
+extern void sys_pm_latency_release(struct sys_pm_latency_req *req);
+
+/**
+ * @brief Get the lowest wake latency constraint
+ *
+ * @return Largest exit latency in microseconds allowed by all the
+ *	   constraints set, UINT32_MAX if there is none.
+ */
+extern u32_t sys_pm_latency_get(void);
+#endif /* CONFIG_SYS_PM_LATENCY */
+
 /**
  * @}
  */
@@ -239,6 +290,17 @@ extern bool sys_pm_ctrl_is_state_enabled(enum power_states state);
  */
 void _sys_resume_from_deep_sleep(void);
 
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICT
+/**
+ * @brief Hook function to notify the end of an idle period
+ *
+ * Called by the kernel from the interrupt waking it from idle, whether a
+ * power state was entered or not, so the residency policy learns the
+ * length of idle periods.
+ */
+void sys_pm_policy_idle_exit(void);
+#endif
+
 /**
  * @brief Notify exit from kernel idling after PM operations
  *
@@ -21,6 +21,7 @@
 #define ZEPHYR_INCLUDE_RANDOM_RAND32_H_
 
 #include <zephyr/types.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,6 +29,21 @@ extern "C" {
 
 extern u32_t sys_rand32_get(void);
 
+/**
+ * @brief Fill a buffer with cryptographically secure random numbers.
+ *
+ * Available with CONFIG_CTR_DRBG_CSPRNG_GENERATOR. The numbers come from
+ * a CTR-DRBG seeded from the entropy driver, the call never waits for the
+ * hardware and can be made from interrupt context.
+ *
+ * @param dst Buffer to fill.
+ * @param len Number of bytes to write.
+ *
+ * @return 0 on success, -EAGAIN if the generator is not seeded yet or
+ *         needs a reseed first, -EIO on generator failure.
+ */
+extern int sys_csrand_get(void *dst, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -60,4 +60,31 @@ void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
 void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread);
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
 
+/* Bitmap-indexed list.  All threads live on one list sorted by
+ * priority (FIFO within a priority) exactly like the "dumb" queue, so
+ * the best thread is always the list head.  A pointer to the last
+ * thread of each occupied priority, found through a two-level bitmap
+ * with CLZ, gives the insertion point in constant time.  It costs one
+ * pointer per priority (half of what the multi-queue list heads
+ * need), which makes it usable for wait queues as well.  Like the
+ * multi-queue it cannot represent deadline ordering.
+ */
+#define Z_PRIQ_BM_PRIOS (CONFIG_NUM_COOP_PRIORITIES + \
+			 CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define Z_PRIQ_BM_WORDS ((Z_PRIQ_BM_PRIOS + 31) / 32)
+
+struct _priq_bm {
+	sys_dlist_t list;
+	struct k_thread *last[Z_PRIQ_BM_PRIOS];
+	u32_t bitmap[Z_PRIQ_BM_WORDS]; /* bit set if last[i] is valid */
+#if Z_PRIQ_BM_WORDS > 1
+	u32_t summary; /* bit w set if bitmap[w] is non-zero */
+#endif
+};
+
+void z_priq_bm_init(struct _priq_bm *pq);
+void z_priq_bm_add(struct _priq_bm *pq, struct k_thread *thread);
+void z_priq_bm_remove(struct _priq_bm *pq, struct k_thread *thread);
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq);
+
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
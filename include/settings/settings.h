@@ -451,6 +451,37 @@ int settings_runtime_commit(const char *name);
 
 #endif /* CONFIG_SETTINGS_RUNTIME */
 
+/*
+ * API for the write-back cache
+ */
+
+#ifdef CONFIG_SETTINGS_WRITE_BACK
+
+/**
+ * Write all the items held in the write-back cache to persisted storage.
+ * This is meant to be called e.g. before entering a low power state or
+ * on a brown-out warning.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_flush(void);
+
+/**
+ * Set how long the items of a subtree may stay in the write-back cache
+ * before they are written to persisted storage. The policy of the longest
+ * matching subtree applies, items of no subtree with a policy use
+ * CONFIG_SETTINGS_WRITE_BACK_DELAY.
+ *
+ * @param subtree Name of the subtree, must stay valid.
+ * @param delay Delay in milliseconds, K_NO_WAIT to write the items of the
+ * subtree through.
+ *
+ * @return 0 on success, -ENOMEM if no more policies can be set.
+ */
+int settings_write_back_policy_set(const char *subtree, s32_t delay);
+
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
+
 
 #ifdef __cplusplus
 }
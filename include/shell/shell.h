@@ -524,6 +524,7 @@ struct shell_flags {
 	u32_t mode_delete :1; /*!< Operation mode of backspace key */
 	u32_t history_exit:1; /*!< Request to exit history mode */
 	u32_t cmd_ctx	  :1; /*!< Shell is executing command */
+	u32_t batch       :1; /*!< Non-interactive mode, no prompt nor history*/
 	u32_t last_nl     :8; /*!< Last received new line character */
 };
 
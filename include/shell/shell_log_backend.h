@@ -77,7 +77,8 @@ int shell_log_backend_output_func(u8_t *data, size_t length, void *ctx);
 		.msgq = &_name##_msgq,					     \
 		.log_output = &_name##_log_output,			     \
 		.control_block = &_name##_control_block,		     \
-		.timeout = _timeout					     \
+		.timeout = IS_ENABLED(CONFIG_SHELL_LOG_BACKEND_LOSSLESS) ?    \
+				K_FOREVER : _timeout			     \
 	}
 
 #define SHELL_LOG_BACKEND_PTR(_name) (&_name##_log_backend)
@@ -41,12 +41,18 @@ struct shell_telnet {
 	/** RX packet FIFO. */
 	struct k_fifo rx_fifo;
 
-	/** The timer is used to send non-lf terminated output that has
-	 *  been around for "too long". This will prove to be useful
-	 *  to send the shell prompt for instance.
+	/** The timer is used to send the buffered output that has been
+	 *  around for "too long". Output is coalesced until then, unless
+	 *  the line buffer fills up.
 	 */
 	struct k_timer send_timer;
 
+	/** Sends the buffered output once the timer expired. */
+	struct k_work send_work;
+
+	/** Protects the line buffer. */
+	struct k_mutex lock;
+
 	/** If set, no output is sent to the TELNET client. */
 	bool output_lock;
 };
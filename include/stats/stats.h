@@ -46,6 +46,28 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * A group has a type, telling readers how to interpret its entries:
+ *
+ * - STATS_TYPE_COUNTER: event counters, the default.
+ *
+ * - STATS_TYPE_GAUGE: current levels, e.g. buffers in use, updated with
+ *   STATS_INCN()/STATS_DECN() or STATS_SET().
+ *
+ * - STATS_TYPE_HIST: log2 histogram buckets, declared with
+ *   STATS_HIST_SECT() and updated with STATS_HIST_RECORD().  Bucket N
+ *   counts values of 2^(N-1) to 2^N - 1 (bucket 0 those of zero) and the
+ *   last bucket also all larger ones.
+ *
+ * A group updated from several CPUs can be declared with STATS_PCPU_DECL()
+ * so that every CPU increments its own copy, without locking or cache line
+ * sharing.  The copies are summed when the group is read with
+ * stats_value_get() or stats_group_export(); readers accessing the entries
+ * directly only see the copy of CPU 0.
+ *
+ * Every group is also given a small numeric ID when registered, in
+ * registration order, which stats_group_find_id() looks up in constant
+ * time.
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
@@ -53,6 +75,7 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#include <sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,11 +86,20 @@ struct stats_name_map {
 	const char *snm_name;
 } __attribute__((packed));
 
+#define STATS_TYPE_COUNTER	0
+#define STATS_TYPE_GAUGE	1
+#define STATS_TYPE_HIST		2
+
+/** ID of the groups registered beyond CONFIG_STATS_MAX_GROUPS */
+#define STATS_ID_NONE		0xff
+
 struct stats_hdr {
 	const char *s_name;
 	u8_t s_size;
 	u16_t s_cnt;
-	u8_t s_pad1;
+	u8_t s_type;
+	u8_t s_cpus;
+	u8_t s_id;
 #ifdef CONFIG_STATS_NAMES
 	const struct stats_name_map *s_map;
 	int s_map_cnt;
@@ -167,6 +199,100 @@ struct stats_hdr {
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
 
+/**
+ * @brief Decreases a gauge entry by the specified amount.
+ *
+ * @param group__               The group containing the entry to decrease.
+ * @param var__                 The statistic entry to decrease.
+ * @param n__                   The amount to decrease the statistic entry by.
+ */
+#define STATS_DECN(group__, var__, n__) \
+	((group__).var__ -= (n__))
+
+/**
+ * @brief Sets a gauge entry.
+ *
+ * Not meant for per-CPU groups, whose copies are summed.
+ *
+ * @param group__               The group containing the entry to set.
+ * @param var__                 The statistic entry to set.
+ * @param val__                 The new value.
+ */
+#define STATS_SET(group__, var__, val__) \
+	((group__).var__ = (val__))
+
+/**
+ * @brief Declares a histogram group struct.
+ *
+ * @param group__               The stats group struct name.
+ * @param buckets__             The number of log2 buckets.
+ */
+#define STATS_HIST_SECT(group__, buckets__)	\
+	STATS_SECT_DECL(group__) {		\
+		struct stats_hdr s_hdr;		\
+		u32_t bucket[buckets__];	\
+	}
+
+/**
+ * @brief Counts a value in a histogram group.
+ *
+ * @param group__               The histogram group.
+ * @param val__                 The value, an unsigned 32-bit integer.
+ */
+#define STATS_HIST_RECORD(group__, val__)				\
+	((group__).bucket[stats_hist_bucket((val__),			\
+			ARRAY_SIZE((group__).bucket))]++)
+
+/**
+ * @brief Declares a per-CPU instance of a group.
+ *
+ * @param group__               The stats group struct name.
+ * @param var__                 The name of the instance.
+ */
+#define STATS_PCPU_DECL(group__, var__) \
+	STATS_SECT_DECL(group__) var__[CONFIG_MP_NUM_CPUS]
+
+/**
+ * @brief Increases an entry of a per-CPU group on the current CPU.
+ *
+ * The caller must not migrate to another CPU meanwhile, which holds in
+ * interrupt handlers and in code with preemption disabled.
+ *
+ * @param group__               The per-CPU group instance.
+ * @param var__                 The statistic entry to increase.
+ * @param n__                   The amount to increase the statistic entry by.
+ */
+#define STATS_PCPU_INCN(group__, var__, n__) \
+	STATS_INCN((group__)[stats_cpu_id()], var__, n__)
+
+/**
+ * @brief Increments an entry of a per-CPU group on the current CPU.
+ *
+ * @param group__               The per-CPU group instance.
+ * @param var__                 The statistic entry to increase.
+ */
+#define STATS_PCPU_INC(group__, var__) \
+	STATS_PCPU_INCN(group__, var__, 1)
+
+/**
+ * @brief Decreases a gauge entry of a per-CPU group on the current CPU.
+ *
+ * @param group__               The per-CPU group instance.
+ * @param var__                 The statistic entry to decrease.
+ * @param n__                   The amount to decrease the statistic entry by.
+ */
+#define STATS_PCPU_DECN(group__, var__, n__) \
+	STATS_DECN((group__)[stats_cpu_id()], var__, n__)
+
+/**
+ * @brief Counts a value in a per-CPU histogram group on the current CPU.
+ *
+ * @param group__               The per-CPU histogram group instance.
+ * @param val__                 The value, an unsigned 32-bit integer.
+ */
+#define STATS_PCPU_HIST_RECORD(group__, val__) \
+	STATS_HIST_RECORD((group__)[stats_cpu_id()], val__)
+
 #define STATS_SIZE_16 (sizeof(u16_t))
 #define STATS_SIZE_32 (sizeof(u32_t))
 #define STATS_SIZE_64 (sizeof(u64_t))
@@ -175,6 +301,20 @@ struct stats_hdr {
 	(size__),			       \
 	((sizeof(group__)) - sizeof(struct stats_hdr)) / (size__)
 
+#if CONFIG_MP_NUM_CPUS > 1
+int z_stats_cpu_id(void);
+#define stats_cpu_id() z_stats_cpu_id()
+#else
+#define stats_cpu_id() 0
+#endif
+
+static inline unsigned int stats_hist_bucket(u32_t val, unsigned int cnt)
+{
+	unsigned int bucket = val ? 32 - __builtin_clz(val) : 0;
+
+	return bucket < cnt ? bucket : cnt - 1;
+}
+
 /**
  * @brief Initializes and registers a statistics group.
  *
@@ -197,6 +337,60 @@ struct stats_hdr {
 		STATS_NAME_INIT_PARMS(group__),				 \
 		(name__))
 
+/**
+ * @brief Initializes and registers a gauge group.
+ *
+ * @param group__               The statistics group to initialize and
+ *                                  register.
+ * @param size__                The size of each entry in the statistics group,
+ *                                  in bytes.
+ * @param name__                The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+#define STATS_GAUGE_INIT_AND_REG(group__, size__, name__)		 \
+	stats_init_and_reg_ext(						 \
+		&(group__).s_hdr, STATS_TYPE_GAUGE, 1,			 \
+		(size__),						 \
+		(sizeof(group__) - sizeof(struct stats_hdr)) / (size__), \
+		STATS_NAME_INIT_PARMS(group__),				 \
+		(name__))
+
+/**
+ * @brief Initializes and registers a histogram group.
+ *
+ * @param group__               The histogram group to initialize and
+ *                                  register.
+ * @param name__                The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+#define STATS_HIST_INIT_AND_REG(group__, name__)			\
+	stats_init_and_reg_ext(						\
+		&(group__).s_hdr, STATS_TYPE_HIST, 1, STATS_SIZE_32,	\
+		ARRAY_SIZE((group__).bucket), NULL, 0, (name__))
+
+/**
+ * @brief Initializes and registers a per-CPU group.
+ *
+ * @param group__               The per-CPU group instance, declared with
+ *                                  STATS_PCPU_DECL() and named like its
+ *                                  section, as for STATS_INIT_AND_REG().
+ * @param type__                The group type, STATS_TYPE_*.
+ * @param size__                The size of each entry in the statistics group,
+ *                                  in bytes.
+ * @param name__                The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+#define STATS_PCPU_INIT_AND_REG(group__, type__, size__, name__)	    \
+	stats_init_and_reg_ext(						    \
+		&(group__)[0].s_hdr, (type__), CONFIG_MP_NUM_CPUS,	    \
+		(size__),						    \
+		(sizeof((group__)[0]) - sizeof(struct stats_hdr)) / (size__), \
+		STATS_NAME_INIT_PARMS(group__),				    \
+		(name__))
+
 /**
  * @brief Initializes a statistics group.
  *
@@ -259,6 +453,58 @@ int stats_init_and_reg(struct stats_hdr *hdr, u8_t size, u16_t cnt,
 		       const struct stats_name_map *map, u16_t map_cnt,
 		       const char *name);
 
+/**
+ * @brief Initializes and registers a statistics group of any type.
+ *
+ * @param hdr                   The header of the statistics group, the one
+ *                                  of CPU 0 for a per-CPU group.
+ * @param type                  The group type, STATS_TYPE_*.
+ * @param cpus                  The number of per-CPU copies, 1 for a
+ *                                  regular group.
+ * @param size                  The size of each individual statistics
+ *                                  element, in bytes.
+ * @param cnt                   The number of elements in the stats group.
+ * @param map                   The mapping of stat offset to name.
+ * @param map_cnt               The number of items in the statistics map
+ * @param name                  The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+int stats_init_and_reg_ext(struct stats_hdr *hdr, u8_t type, u8_t cpus,
+			   u8_t size, u16_t cnt,
+			   const struct stats_name_map *map, u16_t map_cnt,
+			   const char *name);
+
+/**
+ * @brief Reads a statistic entry.
+ *
+ * The copies of a per-CPU group are summed.
+ *
+ * @param hdr                   The group containing the entry.
+ * @param off                   The offset of the entry, from `hdr`, as
+ *                                  passed to a stats_walk_fn.
+ *
+ * @return                      The value of the entry.
+ */
+u64_t stats_value_get(const struct stats_hdr *hdr, u16_t off);
+
+/**
+ * @brief Exports a statistics group in binary form.
+ *
+ * The group is written as its ID, type and entry size, one byte each,
+ * the number of entries as 16 bits, then the values of all entries, at
+ * their entry size.  All fields are little endian.  Entry names are not
+ * included, they can be read once with stats_walk().
+ *
+ * @param hdr                   The group to export.
+ * @param buf                   The destination buffer.
+ * @param size                  The size of the destination buffer.
+ *
+ * @return                      The number of bytes written on success;
+ *                              -ENOMEM if the buffer is too small.
+ */
+int stats_group_export(const struct stats_hdr *hdr, u8_t *buf, size_t size);
+
 /**
  * Zeroes the specified statistics group.
  *
@@ -336,6 +582,16 @@ struct stats_hdr *stats_group_get_next(const struct stats_hdr *cur);
  */
 struct stats_hdr *stats_group_find(const char *name);
 
+/**
+ * @brief Retrieves the statistics group with the specified ID.
+ *
+ * @param id                    The ID of the statistics group to look up.
+ *
+ * @return                      Pointer to the retrieved group on success;
+ *                              NULL if there is no group with that ID.
+ */
+struct stats_hdr *stats_group_find_id(u8_t id);
+
 #else /* CONFIG_STATS */
 
 #define STATS_SECT_START(group__) \
@@ -350,7 +606,21 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_INCN(group__, var__, n__)
 #define STATS_INC(group__, var__)
 #define STATS_CLEAR(group__, var__)
+#define STATS_DECN(group__, var__, n__)
+#define STATS_SET(group__, var__, val__)
+#define STATS_HIST_SECT(group__, buckets__) \
+	STATS_SECT_DECL(group__) {	     \
+	}
+#define STATS_HIST_RECORD(group__, val__)
+#define STATS_PCPU_DECL(group__, var__) STATS_SECT_DECL(group__) var__
+#define STATS_PCPU_INCN(group__, var__, n__)
+#define STATS_PCPU_INC(group__, var__)
+#define STATS_PCPU_DECN(group__, var__, n__)
+#define STATS_PCPU_HIST_RECORD(group__, val__)
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
+#define STATS_GAUGE_INIT_AND_REG(group__, size__, name__) (0)
+#define STATS_HIST_INIT_AND_REG(group__, name__) (0)
+#define STATS_PCPU_INIT_AND_REG(group__, type__, size__, name__) (0)
 
 #endif /* !CONFIG_STATS */
 
@@ -25,6 +25,7 @@
 #define ZEPHYR_INCLUDE_SYS_BASE64_H_
 
 #include <stddef.h>
+#include <stdbool.h>
 #include <zephyr/types.h>
 
 #ifdef __cplusplus
@@ -72,6 +73,115 @@ int base64_encode(u8_t *dst, size_t dlen, size_t *olen, const u8_t *src,
 int base64_decode(u8_t *dst, size_t dlen, size_t *olen, const u8_t *src,
 		  size_t slen);
 
+/**
+ * @brief          Encode a buffer into base64url format (RFC 4648)
+ *
+ * Same as base64_encode(), with '-' and '_' in place of '+' and '/' and
+ * without trailing '=' padding, as used by JSON Web Tokens.
+ */
+int base64url_encode(u8_t *dst, size_t dlen, size_t *olen, const u8_t *src,
+		     size_t slen);
+
+/**
+ * @brief          Decode a base64url-formatted buffer
+ *
+ * Same as base64_decode() for the base64url alphabet. The input must not
+ * be padded.
+ */
+int base64url_decode(u8_t *dst, size_t dlen, size_t *olen, const u8_t *src,
+		     size_t slen);
+
+/**
+ * @brief State of a chunked base64 or base64url conversion.
+ *
+ * Lets data be encoded or decoded in pieces of any length, for instance
+ * as it is received from or handed to a transport, without first
+ * gathering it in one buffer. The fields are private.
+ */
+struct base64_stream {
+	u32_t acc;
+	u8_t buf[3];
+	u8_t bits;
+	u8_t count;
+	u8_t pad;
+	bool url;
+};
+
+/**
+ * @brief          Start a chunked conversion
+ *
+ * @param stream   conversion state
+ * @param url      true for the base64url alphabet, without padding
+ */
+void base64_stream_init(struct base64_stream *stream, bool url);
+
+/**
+ * @brief          Encode the next chunk of a stream
+ *
+ * Writes the characters of every group of three bytes completed by this
+ * chunk and keeps the remaining one or two bytes for the next call. The
+ * output is not NUL terminated.
+ *
+ * @param stream   conversion state
+ * @param dst      destination buffer
+ * @param dlen     size of the destination buffer
+ * @param olen     number of characters written
+ * @param src      source buffer
+ * @param slen     amount of data to be encoded
+ *
+ * @return         0 if successful, or -ENOMEM if the buffer is too small,
+ *                 in which case nothing is consumed and *olen is set to
+ *                 the size needed.
+ */
+int base64_encode_update(struct base64_stream *stream, u8_t *dst,
+			 size_t dlen, size_t *olen, const u8_t *src,
+			 size_t slen);
+
+/**
+ * @brief          Encode the bytes left at the end of a stream
+ *
+ * @param stream   conversion state, ready for a new stream on success
+ * @param dst      destination buffer, 4 characters are always enough
+ * @param dlen     size of the destination buffer
+ * @param olen     number of characters written
+ *
+ * @return         0 if successful, or -ENOMEM if the buffer is too small.
+ */
+int base64_encode_finish(struct base64_stream *stream, u8_t *dst,
+			 size_t dlen, size_t *olen);
+
+/**
+ * @brief          Decode the next chunk of a stream
+ *
+ * Symbols may be split across chunks in any way. Spaces and line breaks
+ * are ignored.
+ *
+ * @param stream   conversion state
+ * @param dst      destination buffer
+ * @param dlen     size of the destination buffer
+ * @param olen     number of bytes written
+ * @param src      source buffer
+ * @param slen     amount of data to be decoded
+ *
+ * @return         0 if successful, -ENOMEM if the buffer is too small or
+ *                 -EINVAL if the input data is not correct. Nothing is
+ *                 consumed on error; on -ENOMEM *olen is set to the size
+ *                 needed.
+ */
+int base64_decode_update(struct base64_stream *stream, u8_t *dst,
+			 size_t dlen, size_t *olen, const u8_t *src,
+			 size_t slen);
+
+/**
+ * @brief          End a decoded stream
+ *
+ * @param stream   conversion state, ready for a new stream
+ *
+ * @return         0 if successful, or -EINVAL if the input stopped in the
+ *                 middle of a group.
+ */
+int base64_decode_finish(struct base64_stream *stream);
+
 #ifdef __cplusplus
 }
 #endif
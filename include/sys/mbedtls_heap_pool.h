@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MBEDTLS_HEAP_POOL_H_
+#define ZEPHYR_INCLUDE_SYS_MBEDTLS_HEAP_POOL_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Block classes of the mbed TLS heap pool */
+enum mbedtls_heap_pool_class {
+	MBEDTLS_HEAP_POOL_SMALL,
+	MBEDTLS_HEAP_POOL_MEDIUM,
+	MBEDTLS_HEAP_POOL_RECORD,
+	MBEDTLS_HEAP_POOL_LARGE,
+	MBEDTLS_HEAP_POOL_CLASSES,
+};
+
+/** Usage statistics of the mbed TLS heap pool */
+struct mbedtls_heap_pool_stats {
+	/** Blocks currently allocated, per class */
+	u32_t used[MBEDTLS_HEAP_POOL_CLASSES];
+	/** Most blocks allocated at once, per class */
+	u32_t peak[MBEDTLS_HEAP_POOL_CLASSES];
+	/** Bytes currently reserved, counted in whole blocks */
+	size_t cur_bytes;
+	/** Most bytes reserved at once, counted in whole blocks */
+	size_t peak_bytes;
+	/** Allocations which could not be served */
+	u32_t failed;
+};
+
+/**
+ * @brief Get the usage statistics of the mbed TLS heap pool.
+ *
+ * @param stats Filled with the current statistics.
+ */
+void mbedtls_heap_pool_stats_get(struct mbedtls_heap_pool_stats *stats);
+
+/**
+ * @brief Restart the peak tracking from the current usage.
+ */
+void mbedtls_heap_pool_peak_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MBEDTLS_HEAP_POOL_H_ */
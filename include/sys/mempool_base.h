@@ -75,6 +75,60 @@ struct sys_mem_pool_base {
 	(Z_MPOOL_HAVE_LVL((maxsz), (minsz), (l)) ?	\
 	 4 * Z_MPOOL_LBIT_WORDS((n_max), l) : 0)
 
+#ifdef CONFIG_SYS_MEM_POOL_TLSF
+
+/*
+ * With the TLSF backend the pool buffer holds, instead of the level
+ * bitmaps, the TLSF control block (first and second level bitmaps plus
+ * the free list heads) followed by a single arena that is carved into
+ * variable sized blocks.  The extra space reserved after the n_max *
+ * max_sz bytes covers the control block and, for each of the n_max
+ * largest blocks plus the end sentinel, one block header and the
+ * rounding to the block granularity.
+ */
+#define Z_TLSF_SL_BITS CONFIG_SYS_MEM_POOL_TLSF_SL_BITS
+#define Z_TLSF_SL (1 << Z_TLSF_SL_BITS)
+#define Z_TLSF_ALIGN (2 * sizeof(void *))
+#define Z_TLSF_SMALL (Z_TLSF_ALIGN << Z_TLSF_SL_BITS)
+
+#define Z_TLSF_RESERVE(n_max) (((n_max) + 1) * 2 * Z_TLSF_ALIGN)
+
+#define Z_TLSF_HAVE_FL(sz, i) ((((sz) >> (i)) >= Z_TLSF_SMALL) ? 1 : 0)
+
+/* Number of first level classes needed for blocks smaller than sz */
+#define Z_TLSF_FL_COUNT(sz) (1 +					\
+	Z_TLSF_HAVE_FL(sz, 0) + Z_TLSF_HAVE_FL(sz, 1) +			\
+	Z_TLSF_HAVE_FL(sz, 2) + Z_TLSF_HAVE_FL(sz, 3) +			\
+	Z_TLSF_HAVE_FL(sz, 4) + Z_TLSF_HAVE_FL(sz, 5) +			\
+	Z_TLSF_HAVE_FL(sz, 6) + Z_TLSF_HAVE_FL(sz, 7) +			\
+	Z_TLSF_HAVE_FL(sz, 8) + Z_TLSF_HAVE_FL(sz, 9) +			\
+	Z_TLSF_HAVE_FL(sz, 10) + Z_TLSF_HAVE_FL(sz, 11) +		\
+	Z_TLSF_HAVE_FL(sz, 12) + Z_TLSF_HAVE_FL(sz, 13) +		\
+	Z_TLSF_HAVE_FL(sz, 14) + Z_TLSF_HAVE_FL(sz, 15) +		\
+	Z_TLSF_HAVE_FL(sz, 16) + Z_TLSF_HAVE_FL(sz, 17) +		\
+	Z_TLSF_HAVE_FL(sz, 18) + Z_TLSF_HAVE_FL(sz, 19) +		\
+	Z_TLSF_HAVE_FL(sz, 20) + Z_TLSF_HAVE_FL(sz, 21) +		\
+	Z_TLSF_HAVE_FL(sz, 22) + Z_TLSF_HAVE_FL(sz, 23) +		\
+	Z_TLSF_HAVE_FL(sz, 24) + Z_TLSF_HAVE_FL(sz, 25) +		\
+	Z_TLSF_HAVE_FL(sz, 26) + Z_TLSF_HAVE_FL(sz, 27) +		\
+	Z_TLSF_HAVE_FL(sz, 28) + Z_TLSF_HAVE_FL(sz, 29) +		\
+	Z_TLSF_HAVE_FL(sz, 30))
+
+/* First level classes of a pool; twice its size bounds any block */
+#define Z_TLSF_POOL_FL(maxsz, n_max) \
+	Z_TLSF_FL_COUNT(2 * (WB_UP(maxsz) * (n_max) + Z_TLSF_RESERVE(n_max)))
+
+/* Control block: two bitmap words per class row plus the list heads */
+#define Z_TLSF_CTL_SIZE(fl)						\
+	(ROUND_UP(4 * (2 + (fl)), Z_TLSF_ALIGN) +			\
+	 ROUND_UP((fl) * Z_TLSF_SL * sizeof(void *), Z_TLSF_ALIGN))
+
+#define _MPOOL_BITS_SIZE(maxsz, minsz, n_max)				\
+	(Z_TLSF_RESERVE(n_max) +					\
+	 Z_TLSF_CTL_SIZE(Z_TLSF_POOL_FL(maxsz, n_max)))
+
+#else
+
 /* Size of the bitmap array that follows the buffer in allocated memory */
 #define _MPOOL_BITS_SIZE(maxsz, minsz, n_max) \
 	(Z_MPOOL_LBIT_BYTES(maxsz, minsz, 0, n_max) +	\
@@ -94,6 +148,7 @@ struct sys_mem_pool_base {
 	Z_MPOOL_LBIT_BYTES(maxsz, minsz, 14, n_max) +	\
 	Z_MPOOL_LBIT_BYTES(maxsz, minsz, 15, n_max))
 
+#endif /* CONFIG_SYS_MEM_POOL_TLSF */
 
 void z_sys_mem_pool_base_init(struct sys_mem_pool_base *p);
 
@@ -103,4 +158,14 @@ int z_sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
 void z_sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
 			      u32_t block);
 
+/* Usable size of an allocated block, counted from its data pointer */
+size_t z_sys_mem_pool_block_size(struct sys_mem_pool_base *p, u32_t level,
+				 u32_t block);
+
+/* Grow an allocated block in place to at least size bytes if the backend
+ * can; returns 0 on success or -ENOMEM if the data has to move.
+ */
+int z_sys_mem_pool_block_grow(struct sys_mem_pool_base *p, u32_t level,
+			      u32_t block, size_t size);
+
 #endif /* ZEPHYR_INCLUDE_SYS_MEMPOOL_BASE_H_ */
@@ -11,21 +11,30 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With userspace enabled, a sys_mutex is a k_futex holding the owning
+ * thread. With CONFIG_SYS_MUTEX_USER_FAST_PATH, user threads lock and
+ * unlock uncontended sys_mutexes with atomic ops on that word, similar to
+ * Linux's FUTEX_LOCK_PI and FUTEX_UNLOCK_PI, and only make syscalls to
+ * wait for the mutex or to wake up a waiter. Supervisor threads always go
+ * through the kernel side, which validates the mutex before touching it.
  */
 
 #ifdef CONFIG_USERSPACE
+#include <kernel.h>
 #include <sys/atomic.h>
 #include <zephyr/types.h>
 
+/* Set in the futex word while threads may be waiting for the mutex */
+#define Z_SYS_MUTEX_WAITERS	BIT(0)
+
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* Recursive lock count, only accessed by the owner */
+	u32_t lock_count;
+	/* Owning thread or 0 if unlocked, ORed with Z_SYS_MUTEX_WAITERS.
+	 * Not the first member, so that the address of a sys_mutex is not
+	 * taken for that of a k_futex.
 	 */
-	atomic_t val;
+	struct k_futex futex;
 };
 
 #define SYS_MUTEX_DEFINE(name) \
@@ -58,6 +67,73 @@ __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex, s32_t timeout);
 
 __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
 
+int z_sys_mutex_lock_contended(struct sys_mutex *mutex,
+			       struct k_thread *self, s32_t timeout);
+
+int z_sys_mutex_unlock_contended(struct sys_mutex *mutex);
+
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+/* The thread the kernel last scheduled, published in the C library
+ * partition for user threads to find out who they are. seq changes with
+ * every update, which the kernel makes with interrupts locked.
+ */
+struct z_sys_mutex_thread {
+	u32_t seq;
+	struct k_thread *thread;
+	uintptr_t stack_start;
+	struct _thread_userspace_local_data *local;
+};
+
+extern struct z_sys_mutex_thread z_sys_mutex_current;
+
+void z_sys_mutex_switch(struct k_thread *thread);
+
+void z_sys_mutex_forget(struct k_thread *thread);
+#endif
+
+/* Returns the calling thread if it may lock or unlock @a mutex with
+ * atomic ops, NULL if it must call the kernel side
+ */
+static inline struct k_thread *z_sys_mutex_user_self(struct sys_mutex *mutex)
+{
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+	volatile struct z_sys_mutex_thread *cur = &z_sys_mutex_current;
+	struct _thread_userspace_local_data *local;
+	struct k_thread *thread;
+	uintptr_t start, sp = (uintptr_t)&local;
+	u32_t seq;
+	int i;
+
+	if (!_is_user_context()) {
+		return NULL;
+	}
+
+	do {
+		seq = cur->seq;
+		thread = cur->thread;
+		start = cur->stack_start;
+		local = cur->local;
+	} while (seq != cur->seq);
+
+	/* The record may be for a thread about to be switched in, but only
+	 * the stack of the running thread holds our locals
+	 */
+	if (sp < start || sp >= (uintptr_t)local) {
+		return NULL;
+	}
+
+	/* Mutexes the kernel checked this thread has access to */
+	for (i = 0; i < CONFIG_SYS_MUTEX_USER_CACHE_SIZE; i++) {
+		if (local->sys_mutexes[i] == mutex) {
+			return thread;
+		}
+	}
+#else
+	ARG_UNUSED(mutex);
+#endif
+	return NULL;
+}
+
 /**
  * @brief Lock a mutex.
  *
@@ -75,13 +151,34 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval 0 Mutex locked.
  * @retval -EBUSY Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
- * @retval -EACCESS Caller has no access to provided mutex address
+ * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, s32_t timeout)
 {
-	/* For now, make the syscall unconditionally */
-	return z_sys_mutex_kernel_lock(mutex, timeout);
+	struct k_thread *self = z_sys_mutex_user_self(mutex);
+	atomic_val_t val;
+
+	if (self == NULL) {
+		return z_sys_mutex_kernel_lock(mutex, timeout);
+	}
+
+	if (atomic_cas(&mutex->futex.val, 0, (atomic_val_t)self)) {
+		mutex->lock_count = 1U;
+		return 0;
+	}
+
+	val = atomic_get(&mutex->futex.val);
+	if ((val & ~Z_SYS_MUTEX_WAITERS) == (atomic_val_t)self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		return -EBUSY;
+	}
+
+	return z_sys_mutex_lock_contended(mutex, self, timeout);
 }
 
 /**
@@ -95,15 +192,41 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, s32_t timeout)
  * thread.
  *
  * @param mutex Address of the mutex, which may reside in user memory
- * @retval -EACCESS Caller has no access to provided mutex address
+ * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel or mutex wasn't
  *                 locked
  * @retval -EPERM Caller does not own the mutex
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
-	return z_sys_mutex_kernel_unlock(mutex);
+	struct k_thread *self = z_sys_mutex_user_self(mutex);
+	atomic_val_t val;
+
+	if (self == NULL) {
+		return z_sys_mutex_kernel_unlock(mutex);
+	}
+
+	val = atomic_get(&mutex->futex.val);
+	if (val == 0) {
+		return -EINVAL;
+	}
+
+	if ((val & ~Z_SYS_MUTEX_WAITERS) != (atomic_val_t)self) {
+		return -EPERM;
+	}
+
+	if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+		return 0;
+	}
+
+	/* Cleared first: a new owner may set it right after the release */
+	mutex->lock_count = 0U;
+	if (atomic_cas(&mutex->futex.val, (atomic_val_t)self, 0)) {
+		return 0;
+	}
+
+	return z_sys_mutex_unlock_contended(mutex);
 }
 
 #include <syscalls/mutex.h>
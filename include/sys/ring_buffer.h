@@ -21,12 +21,34 @@ extern "C" {
 
 #define SIZE32_OF(x) (sizeof((x))/sizeof(u32_t))
 
+#ifdef CONFIG_RING_BUFFER_INDEX_ALIGN
+#define Z_RING_BUF_INDEX_ALIGN CONFIG_RING_BUFFER_INDEX_ALIGN
+#else
+#define Z_RING_BUF_INDEX_ALIGN 4
+#endif
+
 /**
  * @brief A structure to represent a ring buffer
+ *
+ * The fields only written by the consumer, by the producer and by neither
+ * are kept apart, on separate cache lines if
+ * CONFIG_RING_BUFFER_INDEX_ALIGN is set accordingly.
  */
 struct ring_buf {
-	u32_t head;	 /**< Index in buf for the head element */
-	u32_t tail;	 /**< Index in buf for the tail element */
+	u32_t size;   /**< Size of buf in 32-bit chunks */
+
+	union ring_buf_buffer {
+		u32_t *buf32;	 /**< Memory region for stored entries */
+		u8_t *buf8;
+	} buf;
+	u32_t mask;   /**< Modulo mask if size is a power of 2 */
+
+	/** Index in buf for the head element */
+	u32_t head __aligned(Z_RING_BUF_INDEX_ALIGN);
+	u32_t tmp_head;  /**< Head of the data claimed for reading */
+
+	/** Index in buf for the tail element */
+	u32_t tail __aligned(Z_RING_BUF_INDEX_ALIGN);
 	union ring_buf_misc {
 		struct ring_buf_misc_item_mode {
 			u32_t dropped_put_count; /**< Running tally of the
@@ -36,21 +58,50 @@ struct ring_buf {
 		} item_mode;
 		struct ring_buf_misc_byte_mode {
 			u32_t tmp_tail;
-			u32_t tmp_head;
 		} byte_mode;
 	} misc;
-	u32_t size;   /**< Size of buf in 32-bit chunks */
+} __aligned(Z_RING_BUF_INDEX_ALIGN);
 
-	union ring_buf_buffer {
-		u32_t *buf32;	 /**< Memory region for stored entries */
-		u8_t *buf8;
-	} buf;
-	u32_t mask;   /**< Modulo mask if size is a power of 2 */
-};
+/*
+ * Accessors for the indices shared between producer and consumer: the
+ * data must be written before the index moving past it is, and read after
+ * the index covering it is.
+ */
+static inline u32_t z_ring_buf_index_get(const u32_t *index)
+{
+#ifdef CONFIG_SMP
+	return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+#else
+	u32_t val = *(const volatile u32_t *)index;
+
+	compiler_barrier();
+	return val;
+#endif
+}
+
+static inline void z_ring_buf_index_set(u32_t *index, u32_t val)
+{
+#ifdef CONFIG_SMP
+	__atomic_store_n(index, val, __ATOMIC_RELEASE);
+#else
+	compiler_barrier();
+	*(volatile u32_t *)index = val;
+#endif
+}
 
 /**
  * @defgroup ring_buffer_apis Ring Buffer APIs
  * @ingroup kernel_apis
+ *
+ * A ring buffer needs no locking if it has a single producer and a single
+ * consumer, e.g. an ISR putting data and a thread getting it, even when
+ * they run on different CPUs. The producer may only call the put routines
+ * (ring_buf_put(), ring_buf_put_claim(), ring_buf_put_finish() or
+ * ring_buf_item_put()), the consumer only the get routines; the state
+ * queries may be called by either. ring_buf_init() and ring_buf_reset()
+ * must not run concurrently with anything else. Several producers or
+ * consumers must be serialized among themselves.
+ *
  * @{
  */
 
@@ -193,7 +244,8 @@ static inline u32_t z_ring_buf_custom_space_get(u32_t size, u32_t head,
  */
 static inline int ring_buf_is_empty(struct ring_buf *buf)
 {
-	return (buf->head == buf->tail);
+	return (z_ring_buf_index_get(&buf->head) ==
+		z_ring_buf_index_get(&buf->tail));
 }
 
 /**
@@ -204,6 +256,7 @@ static inline int ring_buf_is_empty(struct ring_buf *buf)
 static inline void ring_buf_reset(struct ring_buf *buf)
 {
 	buf->head = 0;
+	buf->tmp_head = 0;
 	buf->tail = 0;
 	memset(&buf->misc, 0, sizeof(buf->misc));
 }
@@ -223,7 +276,9 @@ __deprecated static inline int sys_ring_buf_is_empty(struct ring_buf *buf)
  */
 static inline u32_t ring_buf_space_get(struct ring_buf *buf)
 {
-	return z_ring_buf_custom_space_get(buf->size, buf->head, buf->tail);
+	return z_ring_buf_custom_space_get(buf->size,
+					   z_ring_buf_index_get(&buf->head),
+					   z_ring_buf_index_get(&buf->tail));
 }
 
 /**
@@ -170,6 +170,20 @@ size_t bin2hex(const u8_t *buf, size_t buflen, char *hex, size_t hexlen);
  */
 size_t hex2bin(const char *hex, size_t hexlen, u8_t *buf, size_t buflen);
 
+/**
+ * @brief      Convert an unsigned long into its decimal representation.
+ *
+ * Digits are produced two at a time, with one division by 100 for each
+ * pair.
+ *
+ * @param[out] buf     Address of where to store the NUL terminated string,
+ *                     at least 11 bytes, or 21 if long is 64 bits wide.
+ * @param[in]  value   The value to convert.
+ *
+ * @return     The number of digits written.
+ */
+u8_t ul_to_dec(char *buf, unsigned long value);
+
 #endif /* !_ASMLANGUAGE */
 
 /* KB, MB, GB */
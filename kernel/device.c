@@ -7,9 +7,12 @@
 #include <errno.h>
 #include <string.h>
 #include <device.h>
+#include <init.h>
+#include <kernel.h>
 #include <sys/util.h>
 #include <sys/atomic.h>
 #include <syscall_handler.h>
+#include <spinlock.h>
 
 extern struct device __device_init_start[];
 extern struct device __device_PRE_KERNEL_1_start[];
@@ -25,6 +28,191 @@ extern u32_t __device_busy_end[];
 #define DEVICE_BUSY_SIZE (__device_busy_end - __device_busy_start)
 #endif
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+BUILD_ASSERT_MSG((CONFIG_DEVICE_NAME_HASH_SIZE &
+		  (CONFIG_DEVICE_NAME_HASH_SIZE - 1)) == 0,
+		 "CONFIG_DEVICE_NAME_HASH_SIZE must be a power of two");
+
+/* Devices chained by name_next from the bucket of their name hash, filled
+ * before the first level is initialized. Devices whose initialization fails
+ * stay chained and are skipped by the lookups.
+ */
+static struct device *name_hash[CONFIG_DEVICE_NAME_HASH_SIZE];
+
+static u32_t name_hash_bucket(const char *name)
+{
+	u32_t hash = 5381U;
+
+	while (*name) {
+		hash = (hash * 33U) ^ (u8_t)*name++;
+	}
+
+	return hash & (CONFIG_DEVICE_NAME_HASH_SIZE - 1);
+}
+
+static void name_hash_build(void)
+{
+	struct device *info;
+
+	/* Walk backwards so that each chain keeps the definition order,
+	 * in which the linear search used to find duplicate names.
+	 */
+	for (info = __device_init_end; info-- != __device_init_start;) {
+		u32_t bucket = name_hash_bucket(info->config->name);
+
+		info->name_next = name_hash[bucket];
+		name_hash[bucket] = info;
+	}
+}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
+static int device_init_one(struct device *info)
+{
+	struct device_config *device_conf = info->config;
+	int retval;
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	u32_t start = k_cycle_get_32();
+#endif
+
+	retval = device_conf->init(info);
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	info->init_cycles = k_cycle_get_32() - start;
+#endif
+	if (retval != 0) {
+		/* Initialization failed. Clear the API struct so that
+		 * device_get_binding() will not succeed for it.
+		 */
+		info->driver_api = NULL;
+	} else {
+		z_object_init(info);
+	}
+
+	return retval;
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+/*
+ * Entries sharing an init priority are initialized by the calling thread
+ * and a set of worker threads together, each claiming the next pending
+ * entry of the batch until none is left.  The workers are created at the
+ * first batch with more than one entry, wait for the next batch between
+ * batches and are aborted after the last level.
+ */
+#define INIT_THREADS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, INIT_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[INIT_THREADS];
+static bool init_threads_started;
+static K_SEM_DEFINE(batch_start, 0, INIT_THREADS);
+static K_SEM_DEFINE(batch_done, 0, INIT_THREADS);
+static struct k_spinlock batch_lock;
+static struct device *batch_next, *batch_end;
+
+static void batch_run(void)
+{
+	struct device *info;
+
+	for (;;) {
+		k_spinlock_key_t key = k_spin_lock(&batch_lock);
+
+		info = batch_next < batch_end ? batch_next++ : NULL;
+		k_spin_unlock(&batch_lock, key);
+
+		if (info == NULL) {
+			break;
+		}
+
+		(void)device_init_one(info);
+	}
+}
+
+static void init_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		k_sem_take(&batch_start, K_FOREVER);
+		batch_run();
+		k_sem_give(&batch_done);
+	}
+}
+
+static void batch_do(struct device *first, struct device *end)
+{
+	if (end - first == 1) {
+		(void)device_init_one(first);
+		return;
+	}
+
+	if (!init_threads_started) {
+		int prio = k_thread_priority_get(k_current_get());
+
+		for (int i = 0; i < INIT_THREADS; i++) {
+			k_thread_create(&init_threads[i], init_stacks[i],
+					K_THREAD_STACK_SIZEOF(init_stacks[i]),
+					init_thread_entry, NULL, NULL, NULL,
+					prio, 0, K_NO_WAIT);
+			k_thread_name_set(&init_threads[i], "dev_init");
+		}
+		init_threads_started = true;
+	}
+
+	batch_next = first;
+	batch_end = end;
+
+	for (int i = 0; i < INIT_THREADS; i++) {
+		k_sem_give(&batch_start);
+	}
+
+	batch_run();
+
+	for (int i = 0; i < INIT_THREADS; i++) {
+		k_sem_take(&batch_done, K_FOREVER);
+	}
+}
+
+static void config_level_parallel(struct device *first, struct device *end)
+{
+	while (first < end) {
+		struct device *info = first + 1;
+
+		while (info < end &&
+		       info->config->init_prio == first->config->init_prio) {
+			info++;
+		}
+
+		batch_do(first, info);
+		first = info;
+	}
+}
+
+static void init_threads_stop(void)
+{
+	if (init_threads_started) {
+		for (int i = 0; i < INIT_THREADS; i++) {
+			k_thread_abort(&init_threads[i]);
+		}
+		init_threads_started = false;
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+static u32_t level_cycles[_SYS_INIT_LEVEL_APPLICATION + 1];
+
+u32_t device_init_level_cycles_get(s32_t level)
+{
+	if (level < 0 || (size_t)level >= ARRAY_SIZE(level_cycles)) {
+		return 0;
+	}
+
+	return level_cycles[level];
+}
+#endif
+
 /**
  * @brief Execute all the device initialization functions at a given level
  *
@@ -34,6 +222,10 @@ extern u32_t __device_busy_end[];
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, objects of the same priority at the
+ * POST_KERNEL and APPLICATION levels are initialized concurrently, and
+ * all of them are done before the next priority starts.
+ *
  * @param level init level to run.
  */
 void z_sys_device_do_config_level(s32_t level)
@@ -47,28 +239,64 @@ void z_sys_device_do_config_level(s32_t level)
 		/* End marker */
 		__device_init_end,
 	};
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	u32_t start = k_cycle_get_32();
+#endif
 
-	for (info = config_levels[level]; info < config_levels[level+1];
-								info++) {
-		int retval;
-		struct device_config *device_conf = info->config;
-
-		retval = device_conf->init(info);
-		if (retval != 0) {
-			/* Initialization failed. Clear the API struct so that
-			 * device_get_binding() will not succeed for it.
-			 */
-			info->driver_api = NULL;
-		} else {
-			z_object_init(info);
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (level == _SYS_INIT_LEVEL_PRE_KERNEL_1) {
+		name_hash_build();
+	}
+#endif
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if (level >= _SYS_INIT_LEVEL_POST_KERNEL) {
+		config_level_parallel(config_levels[level],
+				      config_levels[level+1]);
+		if (level == _SYS_INIT_LEVEL_APPLICATION) {
+			init_threads_stop();
+		}
+	} else
+#endif
+	{
+		for (info = config_levels[level]; info < config_levels[level+1];
+									info++) {
+			(void)device_init_one(info);
 		}
 	}
+
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	level_cycles[level] = k_cycle_get_32() - start;
+#endif
 }
 
 struct device *z_impl_device_get_binding(const char *name)
 {
 	struct device *info;
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+	struct device *bucket = name_hash[name_hash_bucket(name)];
+
+	/* Only the devices of the bucket can match. As in the linear
+	 * search, pointer matches win over string matches, so that the
+	 * lookup of duplicate names does not change.
+	 */
+	for (info = bucket; info != NULL; info = info->name_next) {
+		if ((info->driver_api != NULL) &&
+		    (info->config->name == name)) {
+			return info;
+		}
+	}
+
+	for (info = bucket; info != NULL; info = info->name_next) {
+		if ((info->driver_api != NULL) &&
+		    (strcmp(name, info->config->name) == 0)) {
+			return info;
+		}
+	}
+
+	return NULL;
+#else
 	/* Split the search into two loops: in the common scenario, where
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
@@ -92,6 +320,7 @@ struct device *z_impl_device_get_binding(const char *name)
 	}
 
 	return NULL;
+#endif /* CONFIG_DEVICE_NAME_HASH */
 }
 
 #ifdef CONFIG_USERSPACE
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel event object.
+ *
+ * An event object holds 32 events. Threads wait for any or all of a set of
+ * them, optionally clearing that set when the wait is satisfied. Posting
+ * events walks the wait queue once and wakes only the waiters whose
+ * condition then holds, so unrelated waiters are never woken to find
+ * nothing to do.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/object_tracing_common.h>
+#include <toolchain.h>
+#include <wait_q.h>
+#include <ksched.h>
+#include <init.h>
+#include <syscall_handler.h>
+
+#define WAIT_ALL	BIT(0)
+#define WAIT_CLEAR	BIT(1)
+
+/* Kept on the stack of a waiting thread, pointed to by its swap_data */
+struct event_waiter {
+	u32_t events;
+	u32_t options;
+	u32_t result;
+	struct k_thread *next;
+};
+
+/* A system-wide lock, as for semaphores: events are posted from ISRs and
+ * the critical sections are short.
+ */
+static struct k_spinlock lock;
+
+#ifdef CONFIG_OBJECT_TRACING
+
+struct k_event *_trace_list_k_event;
+
+/*
+ * Complete initialization of statically defined event objects.
+ */
+static int init_event_module(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	Z_STRUCT_SECTION_FOREACH(k_event, event) {
+		SYS_TRACING_OBJ_INIT(k_event, event);
+	}
+	return 0;
+}
+
+SYS_INIT(init_event_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+#endif /* CONFIG_OBJECT_TRACING */
+
+void z_impl_k_event_init(struct k_event *event)
+{
+	event->events = 0U;
+	z_waitq_init(&event->wait_q);
+
+	SYS_TRACING_OBJ_INIT(k_event, event);
+
+	z_object_init(event);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_event_init, event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(event, K_OBJ_EVENT));
+	z_impl_k_event_init((struct k_event *)event);
+	return 0;
+}
+#endif
+
+static inline bool condition_met(struct event_waiter *waiter, u32_t events)
+{
+	u32_t match = events & waiter->events;
+
+	if (waiter->options & WAIT_ALL) {
+		return match == waiter->events;
+	}
+
+	return match != 0U;
+}
+
+/* Replaces the events selected by mask with those of events */
+static u32_t event_update(struct k_event *event, u32_t events, u32_t mask)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_thread *thread, *next, *head = NULL;
+	struct event_waiter *waiter;
+	u32_t current;
+
+	current = (event->events & ~mask) | events;
+
+	/* Waiters are checked in queue order against the events left by
+	 * those before them, and the woken ones are only collected here as
+	 * the wait queue cannot be changed while walking it.
+	 */
+	_WAIT_Q_FOR_EACH(&event->wait_q, thread) {
+		waiter = thread->base.swap_data;
+
+		if (condition_met(waiter, current)) {
+			waiter->result = current;
+			if (waiter->options & WAIT_CLEAR) {
+				current &= ~waiter->events;
+			}
+
+			waiter->next = head;
+			head = thread;
+		}
+	}
+
+	event->events = current;
+
+	for (thread = head; thread != NULL; thread = next) {
+		/* The waiter is gone once its thread runs */
+		next = ((struct event_waiter *)thread->base.swap_data)->next;
+
+		z_unpend_thread(thread);
+		z_set_thread_return_value(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	z_reschedule(&lock, key);
+
+	return current;
+}
+
+u32_t z_impl_k_event_post(struct k_event *event, u32_t events)
+{
+	return event_update(event, events, 0U);
+}
+
+u32_t z_impl_k_event_set(struct k_event *event, u32_t events)
+{
+	return event_update(event, events, ~0U);
+}
+
+u32_t z_impl_k_event_clear(struct k_event *event, u32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u32_t previous = event->events;
+
+	event->events &= ~events;
+	k_spin_unlock(&lock, key);
+
+	return previous;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_event_post, event, events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_post((struct k_event *)event, events);
+}
+
+Z_SYSCALL_HANDLER(k_event_set, event, events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_set((struct k_event *)event, events);
+}
+
+Z_SYSCALL_HANDLER(k_event_clear, event, events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_clear((struct k_event *)event, events);
+}
+#endif
+
+static u32_t event_wait(struct k_event *event, u32_t events, u32_t options,
+			s32_t timeout)
+{
+	struct event_waiter waiter = {
+		.events = events,
+		.options = options,
+	};
+	k_spinlock_key_t key;
+	u32_t current;
+
+	__ASSERT(((z_is_in_isr() == false) || (timeout == K_NO_WAIT)), "");
+	__ASSERT(events != 0U, "no events to wait for");
+
+	key = k_spin_lock(&lock);
+	current = event->events;
+
+	if (condition_met(&waiter, current)) {
+		if (options & WAIT_CLEAR) {
+			event->events &= ~events;
+		}
+		k_spin_unlock(&lock, key);
+		return current;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		k_spin_unlock(&lock, key);
+		return 0U;
+	}
+
+	/* Posters check the condition and clear the events on our behalf,
+	 * so a wake up always means the wait is satisfied.
+	 */
+	_current->base.swap_data = &waiter;
+
+	if (z_pend_curr(&lock, key, &event->wait_q, timeout) != 0) {
+		return 0U;
+	}
+
+	return waiter.result;
+}
+
+u32_t z_impl_k_event_wait(struct k_event *event, u32_t events, bool clear,
+			  s32_t timeout)
+{
+	return event_wait(event, events, clear ? WAIT_CLEAR : 0U, timeout);
+}
+
+u32_t z_impl_k_event_wait_all(struct k_event *event, u32_t events,
+			      bool clear, s32_t timeout)
+{
+	return event_wait(event, events,
+			  WAIT_ALL | (clear ? WAIT_CLEAR : 0U), timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_event_wait, event, events, clear, timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(events != 0U, "no events to wait for"));
+	return z_impl_k_event_wait((struct k_event *)event, events,
+				   (bool)clear, timeout);
+}
+
+Z_SYSCALL_HANDLER(k_event_wait_all, event, events, clear, timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(events != 0U, "no events to wait for"));
+	return z_impl_k_event_wait_all((struct k_event *)event, events,
+				       (bool)clear, timeout);
+}
+#endif
@@ -121,6 +121,10 @@ void z_sys_power_save_idle_exit(s32_t ticks)
 	}
 #endif
 
+#if defined(CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICT)
+	sys_pm_policy_idle_exit();
+#endif
+
 	z_clock_idle_exit();
 }
 
@@ -81,6 +81,8 @@ struct _ready_q {
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
+#elif defined(CONFIG_SCHED_BITMAP)
+	struct _priq_bm runq;
 #endif
 };
 
@@ -110,6 +112,11 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	u8_t swap_ok;
 #endif
+
+#ifdef CONFIG_SCHED_PERCPU_RUNQ
+	/* threads queued to run on this CPU */
+	struct _ready_q ready_q;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -144,11 +151,13 @@ struct z_kernel {
 	s32_t idle; /* Number of ticks for kernel idling */
 #endif
 
+#ifndef CONFIG_SCHED_PERCPU_RUNQ
 	/*
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
 	struct _ready_q ready_q;
+#endif
 
 #ifdef CONFIG_FP_SHARING
 	/*
@@ -175,7 +184,11 @@ extern struct z_kernel _kernel;
 
 #ifdef CONFIG_SMP
 #define _current_cpu (z_arch_curr_cpu())
+#ifdef CONFIG_ARCH_HAS_CUSTOM_CURRENT_IMPL
+#define _current (z_arch_curr_thread())
+#else
 #define _current (z_arch_curr_cpu()->current)
+#endif
 #else
 #define _current_cpu (&_kernel.cpus[0])
 #define _current _kernel.current
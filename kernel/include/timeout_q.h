@@ -59,6 +59,10 @@ void z_set_timeout_expiry(s32_t ticks, bool idle);
 
 s32_t z_timeout_remaining(struct _timeout *timeout);
 
+void z_add_hr_timeout(struct _timeout *to, _timeout_func_t fn, u32_t cycle);
+
+int z_abort_hr_timeout(struct _timeout *to);
+
 #else
 
 /* Stubs when !CONFIG_SYS_CLOCK_EXISTS */
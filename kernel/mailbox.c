@@ -217,6 +217,53 @@ static void mbox_message_dispose(struct k_mbox_msg *rx_msg)
 	z_reschedule_unlocked();
 }
 
+/**
+ * @brief Find a receiver compatible with a message being sent.
+ *
+ * A thread pends on at most one wait queue, so a message sent to a specific
+ * thread can only match that thread. Its pend state is checked directly
+ * instead of walking the mailbox's rx queue, which keeps targeted sends
+ * constant time however many threads wait on the mailbox. Messages sent to
+ * K_ANY still take the first compatible receiver in queue order.
+ *
+ * Must be called with the mailbox locked. On success the message
+ * descriptors of both sides are updated as by mbox_message_match().
+ *
+ * @param mbox Pointer to the mailbox object.
+ * @param tx_msg Pointer to transmit message descriptor.
+ *
+ * @return Matching receiving thread, or NULL if there is none.
+ */
+static struct k_thread *mbox_receiver_find(struct k_mbox *mbox,
+					   struct k_mbox_msg *tx_msg)
+{
+	struct k_thread *receiving_thread = tx_msg->tx_target_thread;
+	struct k_mbox_msg *rx_msg;
+
+	if (receiving_thread != (k_tid_t)K_ANY) {
+		if (receiving_thread->base.pended_on != &mbox->rx_msg_queue) {
+			return NULL;
+		}
+
+		rx_msg = (struct k_mbox_msg *)receiving_thread->base.swap_data;
+		if (mbox_message_match(tx_msg, rx_msg) == 0) {
+			return receiving_thread;
+		}
+
+		return NULL;
+	}
+
+	_WAIT_Q_FOR_EACH(&mbox->rx_msg_queue, receiving_thread) {
+		rx_msg = (struct k_mbox_msg *)receiving_thread->base.swap_data;
+
+		if (mbox_message_match(tx_msg, rx_msg) == 0) {
+			return receiving_thread;
+		}
+	}
+
+	return NULL;
+}
+
 /**
  * @brief Send a mailbox message.
  *
@@ -236,7 +283,6 @@ static int mbox_message_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg,
 {
 	struct k_thread *sending_thread;
 	struct k_thread *receiving_thread;
-	struct k_mbox_msg *rx_msg;
 	k_spinlock_key_t key;
 
 	/* save sender id so it can be used during message matching */
@@ -246,42 +292,37 @@ static int mbox_message_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg,
 	sending_thread = tx_msg->_syncing_thread;
 	sending_thread->base.swap_data = tx_msg;
 
-	/* search mailbox's rx queue for a compatible receiver */
 	key = k_spin_lock(&mbox->lock);
 
-	_WAIT_Q_FOR_EACH(&mbox->rx_msg_queue, receiving_thread) {
-		rx_msg = (struct k_mbox_msg *)receiving_thread->base.swap_data;
-
-		if (mbox_message_match(tx_msg, rx_msg) == 0) {
-			/* take receiver out of rx queue */
-			z_unpend_thread(receiving_thread);
+	/* search mailbox's rx queue for a compatible receiver */
+	receiving_thread = mbox_receiver_find(mbox, tx_msg);
+	if (receiving_thread != NULL) {
+		/* take receiver out of rx queue */
+		z_unpend_thread(receiving_thread);
 
-			/* ready receiver for execution */
-			z_set_thread_return_value(receiving_thread, 0);
-			z_ready_thread(receiving_thread);
+		/* ready receiver for execution */
+		z_set_thread_return_value(receiving_thread, 0);
+		z_ready_thread(receiving_thread);
 
 #if (CONFIG_NUM_MBOX_ASYNC_MSGS > 0)
-			/*
-			 * asynchronous send: swap out current thread
-			 * if receiver has priority, otherwise let it continue
-			 *
-			 * note: dummy sending thread sits (unqueued)
-			 * until the receiver consumes the message
-			 */
-			if ((sending_thread->base.thread_state & _THREAD_DUMMY)
-			    != 0U) {
-				z_reschedule(&mbox->lock, key);
-				return 0;
-			}
+		/*
+		 * asynchronous send: swap out current thread
+		 * if receiver has priority, otherwise let it continue
+		 *
+		 * note: dummy sending thread sits (unqueued)
+		 * until the receiver consumes the message
+		 */
+		if ((sending_thread->base.thread_state & _THREAD_DUMMY) != 0U) {
+			z_reschedule(&mbox->lock, key);
+			return 0;
+		}
 #endif
 
-			/*
-			 * synchronous send: pend current thread (unqueued)
-			 * until the receiver consumes the message
-			 */
-			return z_pend_curr(&mbox->lock, key, NULL, K_FOREVER);
-
-		}
+		/*
+		 * synchronous send: pend current thread (unqueued)
+		 * until the receiver consumes the message
+		 */
+		return z_pend_curr(&mbox->lock, key, NULL, K_FOREVER);
 	}
 
 	/* didn't find a matching receiver: don't wait for one */
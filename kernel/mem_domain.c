@@ -10,11 +10,35 @@
 #include <kernel_internal.h>
 #include <sys/__assert.h>
 #include <stdbool.h>
+#include <string.h>
 #include <spinlock.h>
+#include <sys/mutex.h>
 
 static struct k_spinlock lock;
 static u8_t max_partitions;
 
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+/* Threads losing access to memory must go back to having the kernel check
+ * the sys_mutexes they use
+ */
+static void forget_sys_mutexes(struct k_mem_domain *domain)
+{
+	sys_dnode_t *node;
+
+	SYS_DLIST_FOR_EACH_NODE(&domain->mem_domain_q, node) {
+		struct k_thread *thread =
+			CONTAINER_OF(node, struct k_thread, mem_domain_info);
+
+		z_sys_mutex_forget(thread);
+	}
+}
+#else
+static inline void forget_sys_mutexes(struct k_mem_domain *domain)
+{
+	ARG_UNUSED(domain);
+}
+#endif
+
 #if (defined(CONFIG_EXECUTE_XOR_WRITE) || \
 	defined(CONFIG_MPU_REQUIRES_NON_OVERLAPPING_REGIONS)) && __ASSERT_ON
 static bool sane_partition(const struct k_mem_partition *part,
@@ -80,6 +104,121 @@ static inline bool sane_partition_domain(const struct k_mem_domain *domain,
 #define sane_partition_domain(...) (true)
 #endif
 
+static int free_partition_get(struct k_mem_domain *domain)
+{
+	int p_idx;
+
+	for (p_idx = 0; p_idx < max_partitions; p_idx++) {
+		/* A zero-sized partition denotes it's a free partition */
+		if (domain->partitions[p_idx].size == 0U) {
+			break;
+		}
+	}
+
+	/* Assert if there is no free partition */
+	__ASSERT(p_idx < max_partitions, "");
+
+	return p_idx;
+}
+
+#ifdef CONFIG_MEM_DOMAIN_MERGE_PARTITIONS
+/* Index of a partition of the domain, other than skip, which directly
+ * precedes or follows part and has the same attributes, -1 if none
+ */
+static int merge_partition_find(struct k_mem_domain *domain,
+				const struct k_mem_partition *part, int skip)
+{
+	for (int i = 0; i < max_partitions; i++) {
+		struct k_mem_partition *cur = &domain->partitions[i];
+
+		if (i == skip || cur->size == 0U ||
+		    memcmp(&cur->attr, &part->attr, sizeof(cur->attr)) != 0) {
+			continue;
+		}
+
+		if (cur->start + cur->size == part->start ||
+		    part->start + part->size == cur->start) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static void merge_partition(struct k_mem_partition *dst,
+			    const struct k_mem_partition *src)
+{
+	uintptr_t end = MAX(dst->start + dst->size, src->start + src->size);
+
+	dst->start = MIN(dst->start, src->start);
+	dst->size = end - dst->start;
+}
+
+/* Merge part into p_idx; the result may close the gap to yet another
+ * partition, which is then merged as well
+ */
+static void merge_add_partition(struct k_mem_domain *domain, int p_idx,
+				const struct k_mem_partition *part)
+{
+	struct k_mem_partition *dst = &domain->partitions[p_idx];
+	int other;
+
+	merge_partition(dst, part);
+
+	other = merge_partition_find(domain, dst, p_idx);
+	if (other >= 0) {
+		merge_partition(dst, &domain->partitions[other]);
+		domain->partitions[other].size = 0U;
+		domain->num_partitions--;
+	}
+
+	z_arch_mem_domain_partition_add(domain, p_idx);
+}
+
+/* Remove part from the middle or an end of a merged partition */
+static void merge_remove_partition(struct k_mem_domain *domain,
+				   const struct k_mem_partition *part)
+{
+	struct k_mem_partition *cur = NULL;
+	struct k_mem_partition head, tail;
+	int p_idx;
+
+	for (p_idx = 0; p_idx < max_partitions; p_idx++) {
+		cur = &domain->partitions[p_idx];
+		if (cur->size != 0U && cur->start <= part->start &&
+		    part->start + part->size <= cur->start + cur->size) {
+			break;
+		}
+	}
+
+	/* Assert if not found */
+	__ASSERT(p_idx < max_partitions, "no matching partition found");
+
+	head = *cur;
+	head.size = part->start - cur->start;
+	tail = *cur;
+	tail.start = part->start + part->size;
+	tail.size = cur->start + cur->size - tail.start;
+
+	z_arch_mem_domain_partition_remove(domain, p_idx);
+
+	if (head.size != 0U) {
+		*cur = head;
+		z_arch_mem_domain_partition_add(domain, p_idx);
+
+		if (tail.size == 0U) {
+			return;
+		}
+
+		p_idx = free_partition_get(domain);
+		domain->num_partitions++;
+	}
+
+	domain->partitions[p_idx] = tail;
+	z_arch_mem_domain_partition_add(domain, p_idx);
+}
+#endif /* CONFIG_MEM_DOMAIN_MERGE_PARTITIONS */
+
 void k_mem_domain_init(struct k_mem_domain *domain, u8_t num_parts,
 		       struct k_mem_partition *parts[])
 {
@@ -130,6 +269,7 @@ void k_mem_domain_destroy(struct k_mem_domain *domain)
 	key = k_spin_lock(&lock);
 
 	z_arch_mem_domain_destroy(domain);
+	forget_sys_mutexes(domain);
 
 	SYS_DLIST_FOR_EACH_NODE_SAFE(&domain->mem_domain_q, node, next_node) {
 		struct k_thread *thread =
@@ -160,15 +300,16 @@ void k_mem_domain_add_partition(struct k_mem_domain *domain,
 
 	key = k_spin_lock(&lock);
 
-	for (p_idx = 0; p_idx < max_partitions; p_idx++) {
-		/* A zero-sized partition denotes it's a free partition */
-		if (domain->partitions[p_idx].size == 0U) {
-			break;
-		}
+#ifdef CONFIG_MEM_DOMAIN_MERGE_PARTITIONS
+	p_idx = merge_partition_find(domain, part, -1);
+	if (p_idx >= 0) {
+		merge_add_partition(domain, p_idx, part);
+		k_spin_unlock(&lock, key);
+		return;
 	}
+#endif
 
-	/* Assert if there is no free partition */
-	__ASSERT(p_idx < max_partitions, "");
+	p_idx = free_partition_get(domain);
 
 	domain->partitions[p_idx].start = part->start;
 	domain->partitions[p_idx].size = part->size;
@@ -191,6 +332,8 @@ void k_mem_domain_remove_partition(struct k_mem_domain *domain,
 
 	key = k_spin_lock(&lock);
 
+	forget_sys_mutexes(domain);
+
 	/* find a partition that matches the given start and size */
 	for (p_idx = 0; p_idx < max_partitions; p_idx++) {
 		if (domain->partitions[p_idx].start == part->start &&
@@ -199,6 +342,15 @@ void k_mem_domain_remove_partition(struct k_mem_domain *domain,
 		}
 	}
 
+#ifdef CONFIG_MEM_DOMAIN_MERGE_PARTITIONS
+	if (p_idx == max_partitions) {
+		/* Part of a partition it was merged with */
+		merge_remove_partition(domain, part);
+		k_spin_unlock(&lock, key);
+		return;
+	}
+#endif
+
 	/* Assert if not found */
 	__ASSERT(p_idx < max_partitions, "no matching partition found");
 
@@ -241,6 +393,9 @@ void k_mem_domain_remove_thread(k_tid_t thread)
 
 	key = k_spin_lock(&lock);
 	z_arch_mem_domain_thread_remove(thread);
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+	z_sys_mutex_forget(thread);
+#endif
 
 	sys_dlist_remove(&thread->mem_domain_info.mem_domain_q_node);
 	thread->mem_domain_info.mem_domain = NULL;
@@ -13,6 +13,7 @@
 #include <sys/dlist.h>
 #include <ksched.h>
 #include <init.h>
+#include <string.h>
 
 static struct k_spinlock lock;
 
@@ -41,6 +42,11 @@ static void create_free_list(struct k_mem_slab *slab)
 	slab->free_list = NULL;
 	p = slab->buffer;
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+	slab->waiters = ATOMIC_INIT(0);
+#endif
+
 	for (j = 0U; j < slab->num_blocks; j++) {
 		*(char **)p = slab->free_list;
 		slab->free_list = p;
@@ -84,7 +90,7 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	z_object_init(slab);
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+static int slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	int result;
@@ -113,7 +119,7 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 	return result;
 }
 
-void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+static void slab_free(struct k_mem_slab *slab, void **mem)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
@@ -129,3 +135,188 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 		k_spin_unlock(&lock, key);
 	}
 }
+
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+
+/*
+ * Per-CPU magazines.  Each CPU keeps a small stack of free blocks per
+ * slab, guarded by its own spinlock which in the common case is only
+ * ever taken by that CPU, so the fast paths touch no shared cache
+ * line.  Empty or full magazines are refilled from or drained to the
+ * slab's global free list in batches of half a magazine, under the
+ * global lock (always nested inside a magazine lock, never the other
+ * way around).
+ *
+ * slab->num_used counts the blocks outside the global free list,
+ * including those sitting in magazines.
+ *
+ * A thread about to pend announces itself in slab->waiters before it
+ * flushes all magazines back to the global list.  Frees check that
+ * count under their magazine lock, so a free either lands in a
+ * magazine before the flush visits it or sees the waiter and goes to
+ * the global list (and the waiter) directly.
+ */
+
+#define CACHE_SIZE CONFIG_MEM_SLAB_PERCPU_CACHE_SIZE
+#define CACHE_BATCH MAX(CACHE_SIZE / 2, 1)
+
+/* Called with interrupts locked, which pins the caller to its CPU */
+static inline struct _mem_slab_cache *local_cache(struct k_mem_slab *slab)
+{
+	return &slab->cache[_current_cpu->id];
+}
+
+static void cache_push(struct _mem_slab_cache *c, char *mem)
+{
+	*(char **)mem = c->free_list;
+	c->free_list = mem;
+	c->count++;
+}
+
+static char *cache_pop(struct _mem_slab_cache *c)
+{
+	char *mem = c->free_list;
+
+	c->free_list = *(char **)mem;
+	c->count--;
+
+	return mem;
+}
+
+/* Called with the cache lock held */
+static void cache_refill(struct k_mem_slab *slab, struct _mem_slab_cache *c)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	while (c->count < CACHE_BATCH && slab->free_list != NULL) {
+		char *mem = slab->free_list;
+
+		slab->free_list = *(char **)mem;
+		slab->num_used++;
+		cache_push(c, mem);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (c->count != 0U) {
+		c->refills++;
+	}
+}
+
+/* Called with the cache lock held */
+static void cache_drain(struct k_mem_slab *slab, struct _mem_slab_cache *c,
+			u32_t keep)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	while (c->count > keep) {
+		char *mem = cache_pop(c);
+
+		*(char **)mem = slab->free_list;
+		slab->free_list = mem;
+		slab->num_used--;
+	}
+
+	k_spin_unlock(&lock, key);
+	c->drains++;
+}
+
+static void cache_flush_all(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct _mem_slab_cache *c = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		if (c->count != 0U) {
+			cache_drain(slab, c, 0);
+		}
+		k_spin_unlock(&c->lock, key);
+	}
+}
+
+void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				struct k_mem_slab_cache_stats *stats)
+{
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats->hits += slab->cache[i].hits;
+		stats->refills += slab->cache[i].refills;
+		stats->drains += slab->cache[i].drains;
+		stats->cached += slab->cache[i].count;
+	}
+}
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+{
+	unsigned int irq = z_arch_irq_lock();
+	struct _mem_slab_cache *c = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	if (c->count != 0U) {
+		c->hits++;
+	} else {
+		cache_refill(slab, c);
+	}
+
+	if (c->count != 0U) {
+		*mem = cache_pop(c);
+		k_spin_unlock(&c->lock, key);
+		z_arch_irq_unlock(irq);
+		return 0;
+	}
+
+	k_spin_unlock(&c->lock, key);
+	z_arch_irq_unlock(irq);
+
+	/* Slab free list empty: collect what the other CPUs hold */
+	if (timeout != K_NO_WAIT) {
+		(void)atomic_inc(&slab->waiters);
+	}
+	cache_flush_all(slab);
+
+	int result = slab_alloc(slab, mem, timeout);
+
+	if (timeout != K_NO_WAIT) {
+		(void)atomic_dec(&slab->waiters);
+	}
+
+	return result;
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq = z_arch_irq_lock();
+	struct _mem_slab_cache *c = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	if (atomic_get(&slab->waiters) == 0) {
+		if (c->count >= CACHE_SIZE) {
+			cache_drain(slab, c, CACHE_SIZE - CACHE_BATCH);
+		} else {
+			c->hits++;
+		}
+		cache_push(c, *mem);
+		k_spin_unlock(&c->lock, key);
+		z_arch_irq_unlock(irq);
+		return;
+	}
+
+	k_spin_unlock(&c->lock, key);
+	z_arch_irq_unlock(irq);
+	slab_free(slab, mem);
+}
+
+#else
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+{
+	return slab_alloc(slab, mem, timeout);
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	slab_free(slab, mem);
+}
+
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
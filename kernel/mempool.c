@@ -156,12 +156,111 @@ void *k_mem_pool_malloc(struct k_mem_pool *pool, size_t size)
 	return (char *)block.data + WB_UP(sizeof(struct k_mem_block_id));
 }
 
+#ifdef CONFIG_HEAP_MEM_SLAB_CACHE
+
+/*
+ * Size-class front-end for k_malloc().  Blocks carry the same hidden
+ * descriptor as pool blocks, with a pool index that no real pool can
+ * have (the pool field is 8 bits wide and the linker section holds far
+ * fewer pools) and the size class stored in the level field, so that
+ * k_free() can route them back without any address range checks.
+ */
+#define HEAP_SLAB_POOL_ID 0xff
+#define HEAP_SLAB_BLOCKS CONFIG_HEAP_MEM_SLAB_CACHE_BLOCKS
+
+K_MEM_SLAB_DEFINE(_heap_slab_32, 32, HEAP_SLAB_BLOCKS, sizeof(void *));
+K_MEM_SLAB_DEFINE(_heap_slab_64, 64, HEAP_SLAB_BLOCKS, sizeof(void *));
+K_MEM_SLAB_DEFINE(_heap_slab_128, 128, HEAP_SLAB_BLOCKS, sizeof(void *));
+
+static struct k_mem_slab *const heap_slabs[Z_HEAP_SLAB_CLASSES] = {
+	&_heap_slab_32, &_heap_slab_64, &_heap_slab_128,
+};
+
+struct heap_slab_counters {
+	atomic_t hits;
+	atomic_t overflows;
+	atomic_t requested;
+	atomic_t granted;
+};
+
+static struct heap_slab_counters heap_slab_counters[Z_HEAP_SLAB_CLASSES];
+static struct heap_slab_counters heap_pool_counters;
+
+static void heap_count(struct heap_slab_counters *c, size_t requested,
+		       size_t granted)
+{
+	(void)atomic_inc(&c->hits);
+	(void)atomic_add(&c->requested, (atomic_val_t)requested);
+	(void)atomic_add(&c->granted, (atomic_val_t)granted);
+}
+
+/* size includes the hidden block descriptor */
+static void *heap_slab_alloc(size_t size)
+{
+	for (int i = 0; i < Z_HEAP_SLAB_CLASSES; i++) {
+		struct k_mem_slab *slab = heap_slabs[i];
+		struct k_mem_block_id *id;
+
+		if (size > slab->block_size) {
+			continue;
+		}
+
+		if (k_mem_slab_alloc(slab, (void **)&id, K_NO_WAIT) != 0) {
+			/* Class exhausted: let the pool serve it rather
+			 * than wasting a bigger class on it
+			 */
+			(void)atomic_inc(&heap_slab_counters[i].overflows);
+			return NULL;
+		}
+
+		id->pool = HEAP_SLAB_POOL_ID;
+		id->level = i;
+		id->block = 0;
+		heap_count(&heap_slab_counters[i], size, slab->block_size);
+
+		return id;
+	}
+
+	return NULL;
+}
+
+void k_malloc_slab_stats_get(struct k_malloc_slab_stats *stats)
+{
+	for (int i = 0; i < Z_HEAP_SLAB_CLASSES; i++) {
+		struct k_malloc_slab_class_stats *cs = &stats->classes[i];
+		struct heap_slab_counters *c = &heap_slab_counters[i];
+
+		cs->block_size = heap_slabs[i]->block_size;
+		cs->num_blocks = heap_slabs[i]->num_blocks;
+		cs->num_used = k_mem_slab_num_used_get(heap_slabs[i]);
+		cs->hits = atomic_get(&c->hits);
+		cs->overflows = atomic_get(&c->overflows);
+		cs->requested_bytes = atomic_get(&c->requested);
+		cs->granted_bytes = atomic_get(&c->granted);
+	}
+
+	stats->pool_allocs = atomic_get(&heap_pool_counters.hits);
+	stats->pool_requested_bytes = atomic_get(&heap_pool_counters.requested);
+	stats->pool_granted_bytes = atomic_get(&heap_pool_counters.granted);
+}
+
+#endif /* CONFIG_HEAP_MEM_SLAB_CACHE */
+
 void k_free(void *ptr)
 {
 	if (ptr != NULL) {
 		/* point to hidden block descriptor at start of block */
 		ptr = (char *)ptr - WB_UP(sizeof(struct k_mem_block_id));
 
+#ifdef CONFIG_HEAP_MEM_SLAB_CACHE
+		struct k_mem_block_id *id = ptr;
+
+		if (id->pool == HEAP_SLAB_POOL_ID) {
+			k_mem_slab_free(heap_slabs[id->level], &ptr);
+			return;
+		}
+#endif
+
 		/* return block to the heap memory pool */
 		k_mem_pool_free_id(ptr);
 	}
@@ -180,10 +279,40 @@ K_MEM_POOL_DEFINE(_heap_mem_pool, CONFIG_HEAP_MEM_POOL_MIN_SIZE,
 		  CONFIG_HEAP_MEM_POOL_SIZE, 1, 4);
 #define _HEAP_MEM_POOL (&_heap_mem_pool)
 
+#ifdef CONFIG_HEAP_MEM_SLAB_CACHE
+void *k_malloc(size_t size)
+{
+	struct k_mem_block block;
+	size_t total;
+
+	if (size_add_overflow(size, WB_UP(sizeof(struct k_mem_block_id)),
+			      &total)) {
+		return NULL;
+	}
+
+	block.data = heap_slab_alloc(total);
+	if (block.data == NULL) {
+		if (k_mem_pool_alloc(_HEAP_MEM_POOL, &block, total,
+				     K_NO_WAIT) != 0) {
+			return NULL;
+		}
+
+		heap_count(&heap_pool_counters, total,
+			   z_sys_mem_pool_block_size(&_HEAP_MEM_POOL->base,
+						     block.id.level,
+						     block.id.block));
+		(void)memcpy(block.data, &block.id,
+			     sizeof(struct k_mem_block_id));
+	}
+
+	return (char *)block.data + WB_UP(sizeof(struct k_mem_block_id));
+}
+#else
 void *k_malloc(size_t size)
 {
 	return k_mem_pool_malloc(_HEAP_MEM_POOL, size);
 }
+#endif /* CONFIG_HEAP_MEM_SLAB_CACHE */
 
 void *k_calloc(size_t nmemb, size_t size)
 {
@@ -280,6 +280,234 @@ Z_SYSCALL_HANDLER(k_msgq_peek, msgq_p, data)
 }
 #endif
 
+/* Copies n messages out of the ring buffer from position from, in at most
+ * two parts, and returns the position past them.
+ */
+static char *ring_read(struct k_msgq *msgq, char *from, char *data, u32_t n)
+{
+	size_t len = n * msgq->msg_size;
+	size_t first = MIN(len, (size_t)(msgq->buffer_end - from));
+
+	(void)memcpy(data, from, first);
+	if (first < len) {
+		(void)memcpy(data + first, msgq->buffer_start, len - first);
+		return msgq->buffer_start + (len - first);
+	}
+
+	from += len;
+	return (from == msgq->buffer_end) ? msgq->buffer_start : from;
+}
+
+/* Copies n messages into the ring buffer at position to, in at most two
+ * parts, and returns the position past them.
+ */
+static char *ring_write(struct k_msgq *msgq, char *to, const char *data,
+			u32_t n)
+{
+	size_t len = n * msgq->msg_size;
+	size_t first = MIN(len, (size_t)(msgq->buffer_end - to));
+
+	(void)memcpy(to, data, first);
+	if (first < len) {
+		(void)memcpy(msgq->buffer_start, data + first, len - first);
+		return msgq->buffer_start + (len - first);
+	}
+
+	to += len;
+	return (to == msgq->buffer_end) ? msgq->buffer_start : to;
+}
+
+int z_impl_k_msgq_put_n(struct k_msgq *msgq, void *data, u32_t num_msgs,
+			s32_t timeout)
+{
+	__ASSERT(!z_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	char *src = data;
+	bool woken = false;
+	u32_t sent = 0U;
+	u32_t n;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs == msgq->max_msgs) {
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* wait for room for the first message, as k_msgq_put() */
+		_current->base.swap_data = data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	/* the queue isn't full, so any waiting threads are receivers and
+	 * the queue is empty: give each of them a message directly
+	 */
+	while (sent < num_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(pending_thread->base.swap_data, src,
+			     msgq->msg_size);
+		z_set_thread_return_value(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		src += msgq->msg_size;
+		sent++;
+		woken = true;
+	}
+
+	/* put as many of the remaining messages in the queue as fit */
+	n = MIN(num_msgs - sent, msgq->max_msgs - msgq->used_msgs);
+	if (n > 0U) {
+		msgq->write_ptr = ring_write(msgq, msgq->write_ptr, src, n);
+		msgq->used_msgs += n;
+		sent += n;
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return sent;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_msgq_put_n, msgq_p, data, num_msgs, timeout)
+{
+	struct k_msgq *q = (struct k_msgq *)msgq_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_put_n(q, (void *)data, num_msgs, timeout);
+}
+#endif
+
+int z_impl_k_msgq_get_n(struct k_msgq *msgq, void *data, u32_t max_msgs,
+			s32_t timeout)
+{
+	__ASSERT(!z_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	char *dst = data;
+	bool woken = false;
+	u32_t received = 0U;
+	u32_t n;
+	int result;
+
+	if (max_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs == 0U) {
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* wait for a message, as k_msgq_get() */
+		_current->base.swap_data = data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result != 0) {
+			return result;
+		}
+
+		/* the sender may have queued more along with it */
+		key = k_spin_lock(&msgq->lock);
+		dst += msgq->msg_size;
+		received = 1U;
+	}
+
+	n = MIN(max_msgs - received, msgq->used_msgs);
+	if (n > 0U) {
+		/* take the messages from the queue at once */
+		msgq->read_ptr = ring_read(msgq, msgq->read_ptr, dst, n);
+		msgq->used_msgs -= n;
+		received += n;
+
+		/* the queue wasn't empty, so any waiting threads are
+		 * senders: add their messages to the room made
+		 */
+		while (msgq->used_msgs < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			msgq->write_ptr = ring_write(msgq, msgq->write_ptr,
+					pending_thread->base.swap_data, 1U);
+			msgq->used_msgs++;
+			z_set_thread_return_value(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			woken = true;
+		}
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return received;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_msgq_get_n, msgq_p, data, max_msgs, timeout)
+{
+	struct k_msgq *q = (struct k_msgq *)msgq_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, max_msgs, q->msg_size));
+
+	return z_impl_k_msgq_get_n(q, (void *)data, max_msgs, timeout);
+}
+#endif
+
+int z_impl_k_msgq_peek_n(struct k_msgq *msgq, void *data, u32_t max_msgs)
+{
+	k_spinlock_key_t key;
+	u32_t n;
+
+	key = k_spin_lock(&msgq->lock);
+
+	n = MIN(max_msgs, msgq->used_msgs);
+	if (n > 0U) {
+		(void)ring_read(msgq, msgq->read_ptr, data, n);
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return n;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_msgq_peek_n, msgq_p, data, max_msgs)
+{
+	struct k_msgq *q = (struct k_msgq *)msgq_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, max_msgs, q->msg_size));
+
+	return z_impl_k_msgq_peek_n(q, (void *)data, max_msgs);
+}
+#endif
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -135,6 +135,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->read_index = 0;
 	pipe->write_index = 0;
 	pipe->flags = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
 	SYS_TRACING_OBJ_INIT(k_pipe, pipe);
@@ -776,3 +778,127 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 				    bytes_to_write, K_FOREVER);
 }
 #endif
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	__ASSERT(pipe->put_claimed == 0U, "pipe space already claimed");
+
+	size = MIN(size, MIN(pipe->size - pipe->bytes_used,
+			     pipe->size - pipe->write_index));
+	*data = pipe->buffer + pipe->write_index;
+	pipe->put_claimed = size;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread *thread;
+	struct k_pipe_desc *desc;
+	size_t bytes_copied;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Hand the data to pending readers, oldest first. A reader that can
+	 * not be fully satisfied takes what is there and stays pending.
+	 */
+	while (pipe->bytes_used != 0U &&
+	       (thread = z_waitq_head(&pipe->wait_q.readers)) != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+	}
+
+	z_reschedule(&pipe->lock, key);
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	__ASSERT(pipe->get_claimed == 0U, "pipe data already claimed");
+
+	size = MIN(size, MIN(pipe->bytes_used,
+			     pipe->size - pipe->read_index));
+	*data = pipe->buffer + pipe->read_index;
+	pipe->get_claimed = size;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread *thread;
+	struct k_pipe_desc *desc;
+	size_t bytes_copied;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Refill the freed space from pending writers, oldest first. A
+	 * writer whose data does not fit entirely stays pending.
+	 */
+	while (pipe->bytes_used != pipe->size &&
+	       (thread = z_waitq_head(&pipe->wait_q.writers)) != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		pipe_thread_ready(thread);
+	}
+
+	z_reschedule(&pipe->lock, key);
+
+	return 0;
+}
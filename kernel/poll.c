@@ -333,6 +333,27 @@ oops_free:
 }
 #endif
 
+/* must be called with interrupts locked */
+static int signal_set_event(struct k_poll_event *event, u32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller,
+					      struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	/* The object already unlinked the event, queue it for reporting */
+	set_event_ready(event, state);
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		z_set_thread_return_value(thread,
+				state == K_POLL_STATE_CANCELLED ? -EINTR : 0);
+		z_ready_thread(thread);
+	}
+
+	return 0;
+}
+
 /* must be called with interrupts locked */
 static int signal_poll_event(struct k_poll_event *event, u32_t state)
 {
@@ -340,6 +361,10 @@ static int signal_poll_event(struct k_poll_event *event, u32_t state)
 		goto ready_event;
 	}
 
+	if (event->poller->mode == _POLLER_MODE_SET) {
+		return signal_set_event(event, state);
+	}
+
 	struct k_thread *thread = event->poller->thread;
 
 	__ASSERT(event->poller->thread != NULL,
@@ -380,6 +405,113 @@ void z_handle_obj_poll_events(sys_dlist_t *events, u32_t state)
 	}
 }
 
+void k_poll_set_init(struct k_poll_set *set, struct k_poll_event *events,
+		     int num_events)
+{
+	__ASSERT(events != NULL || num_events == 0, "NULL events\n");
+
+	set->poller.thread = NULL;
+	set->poller.is_polling = false;
+	set->poller.mode = _POLLER_MODE_SET;
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->rearm);
+	set->events = events;
+	set->num_events = num_events;
+
+	/* Registration is deferred to the first wait */
+	for (int ii = 0; ii < num_events; ii++) {
+		events[ii].poller = NULL;
+		sys_dlist_append(&set->rearm, &events[ii]._node);
+	}
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, s32_t timeout)
+{
+	__ASSERT(!z_is_in_isr(), "");
+	__ASSERT(ready != NULL && max_ready > 0, "no room for events\n");
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	sys_dnode_t *node;
+	int num_ready;
+
+	set->poller.thread = _current;
+
+	/* Register the events reported by the previous call (or never
+	 * registered yet) again, catching conditions that are already met.
+	 * Relax the lock between events for latency, as k_poll() does.
+	 */
+	while ((node = sys_dlist_get(&set->rearm)) != NULL) {
+		struct k_poll_event *event =
+			CONTAINER_OF(node, struct k_poll_event, _node);
+		u32_t state;
+
+		event->state = K_POLL_STATE_NOT_READY;
+		if (is_condition_met(event, &state)) {
+			set_event_ready(event, state);
+			sys_dlist_append(&set->ready, &event->_node);
+		} else {
+			(void)register_event(event, &set->poller);
+		}
+
+		k_spin_unlock(&lock, key);
+		key = k_spin_lock(&lock);
+	}
+
+	if (sys_dlist_is_empty(&set->ready)) {
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		int swap_rc = z_pend_curr(&lock, key, &set->wait_q, timeout);
+
+		key = k_spin_lock(&lock);
+		if (sys_dlist_is_empty(&set->ready)) {
+			k_spin_unlock(&lock, key);
+			return swap_rc != 0 ? swap_rc : -EAGAIN;
+		}
+	}
+
+	for (num_ready = 0; num_ready < max_ready; num_ready++) {
+		node = sys_dlist_get(&set->ready);
+		if (node == NULL) {
+			break;
+		}
+
+		ready[num_ready] = CONTAINER_OF(node, struct k_poll_event,
+						_node);
+		sys_dlist_append(&set->rearm, node);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return num_ready;
+}
+
+void k_poll_set_cleanup(struct k_poll_set *set)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Unlinks each event from its object, or from the set's lists */
+	clear_event_registrations(set->events, set->num_events - 1, key);
+
+	/* K_POLL_TYPE_IGNORE events are left to the set's lists */
+	for (int ii = 0; ii < set->num_events; ii++) {
+		struct k_poll_event *event = &set->events[ii];
+
+		if (sys_dnode_is_linked(&event->_node)) {
+			sys_dlist_remove(&event->_node);
+		}
+	}
+
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->rearm);
+
+	k_spin_unlock(&lock, key);
+}
+
 void z_impl_k_poll_signal_init(struct k_poll_signal *signal)
 {
 	sys_dlist_init(&signal->poll_events);
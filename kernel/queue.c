@@ -56,6 +56,59 @@ void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free)
 	return ret;
 }
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+BUILD_ASSERT(sizeof(atomic_t) == sizeof(void *));
+
+/* Move the items appended on the lock-free path to data_q, restoring
+ * their order.  Must be called with the queue lock held, before any
+ * data_q access.
+ */
+static void queue_drain(struct k_queue *queue)
+{
+	sys_sfnode_t *node = (sys_sfnode_t *)atomic_set(&queue->incoming, 0);
+	sys_sfnode_t *head = NULL, *tail = node;
+
+	if (node == NULL) {
+		return;
+	}
+
+	while (node != NULL) {
+		sys_sfnode_t *next = (sys_sfnode_t *)node->next_and_flags;
+
+		node->next_and_flags = (unative_t)head;
+		head = node;
+		node = next;
+	}
+
+	sys_sflist_append_list(&queue->data_q, head, tail);
+}
+
+void z_queue_flush_incoming(struct k_queue *queue)
+{
+	if (atomic_get(&queue->incoming) != 0) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+		queue_drain(queue);
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+
+/* True if a thread may be waiting for data from this queue */
+static inline bool queue_has_waiters(struct k_queue *queue)
+{
+#ifdef CONFIG_POLL
+	return !sys_dlist_is_empty(&queue->poll_events);
+#else
+	return z_waitq_head(&queue->wait_q) != NULL;
+#endif
+}
+#else
+static inline void queue_drain(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif /* CONFIG_QUEUE_LOCKLESS_APPEND */
+
 #ifdef CONFIG_OBJECT_TRACING
 
 struct k_queue *_trace_list_k_queue;
@@ -81,6 +134,9 @@ void z_impl_k_queue_init(struct k_queue *queue)
 {
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	(void)atomic_set(&queue->incoming, 0);
+#endif
 	z_waitq_init(&queue->wait_q);
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
@@ -140,9 +196,15 @@ Z_SYSCALL_HANDLER1_SIMPLE_VOID(k_queue_cancel_wait, K_OBJ_QUEUE,
 #endif
 
 static s32_t queue_insert(struct k_queue *queue, void *prev, void *data,
-			  bool alloc)
+			  bool alloc, bool is_append)
 {
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	queue_drain(queue);
+	if (is_append) {
+		prev = sys_sflist_peek_tail(&queue->data_q);
+	}
+
 #if !defined(CONFIG_POLL)
 	struct k_thread *first_pending_thread;
 
@@ -182,24 +244,68 @@ static s32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 
 void k_queue_insert(struct k_queue *queue, void *prev, void *data)
 {
-	(void)queue_insert(queue, prev, data, false);
+	(void)queue_insert(queue, prev, data, false, false);
 }
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+/* Push onto the incoming stack with compare-and-swap.  The lock and
+ * the scheduler are only involved when somebody may be waiting; a
+ * consumer checks for incoming items under the lock before pending,
+ * so one of the two sides always sees the other.
+ */
+static void queue_append_lockless(struct k_queue *queue, void *data)
+{
+	sys_sfnode_t *node = data;
+	atomic_val_t head;
+
+	do {
+		head = atomic_get(&queue->incoming);
+		node->next_and_flags = (unative_t)head;
+	} while (!atomic_cas(&queue->incoming, head, (atomic_val_t)node));
+
+	if (!queue_has_waiters(queue)) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	queue_drain(queue);
+#if !defined(CONFIG_POLL)
+	struct k_thread *thread;
+
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread != NULL) {
+			prepare_thread_to_run(thread, z_queue_node_peek(
+				sys_sflist_get_not_empty(&queue->data_q),
+				true));
+		}
+	}
+#else
+	handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+#endif /* !CONFIG_POLL */
+
+	z_reschedule(&queue->lock, key);
+}
+#endif /* CONFIG_QUEUE_LOCKLESS_APPEND */
+
 void k_queue_append(struct k_queue *queue, void *data)
 {
-	(void)queue_insert(queue, sys_sflist_peek_tail(&queue->data_q),
-			   data, false);
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	queue_append_lockless(queue, data);
+#else
+	(void)queue_insert(queue, NULL, data, false, true);
+#endif
 }
 
 void k_queue_prepend(struct k_queue *queue, void *data)
 {
-	(void)queue_insert(queue, NULL, data, false);
+	(void)queue_insert(queue, NULL, data, false, false);
 }
 
 s32_t z_impl_k_queue_alloc_append(struct k_queue *queue, void *data)
 {
-	return queue_insert(queue, sys_sflist_peek_tail(&queue->data_q), data,
-			    true);
+	return queue_insert(queue, NULL, data, true, true);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -214,7 +320,7 @@ Z_SYSCALL_HANDLER(k_queue_alloc_append, queue, data)
 
 s32_t z_impl_k_queue_alloc_prepend(struct k_queue *queue, void *data)
 {
-	return queue_insert(queue, NULL, data, true);
+	return queue_insert(queue, NULL, data, true, false);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -232,6 +338,9 @@ void k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	__ASSERT(head && tail, "invalid head or tail");
 
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	queue_drain(queue);
+
 #if !defined(CONFIG_POLL)
 	struct k_thread *thread = NULL;
 
@@ -257,6 +366,36 @@ void k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	z_reschedule(&queue->lock, key);
 }
 
+void k_queue_append_batch(struct k_queue *queue, void *head, void *tail)
+{
+	__ASSERT(head && tail, "invalid head or tail");
+
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	queue_drain(queue);
+
+#if !defined(CONFIG_POLL)
+	struct k_thread *thread = z_unpend_first_thread(&queue->wait_q);
+
+	/* A pending thread means the queue was empty, so the first item
+	 * of the batch is the one it is waiting for.
+	 */
+	if (thread != NULL) {
+		prepare_thread_to_run(thread, head);
+		head = *(void **)head;
+	}
+
+	if (head != NULL) {
+		sys_sflist_append_list(&queue->data_q, head, tail);
+	}
+#else
+	sys_sflist_append_list(&queue->data_q, head, tail);
+	handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+#endif /* !CONFIG_POLL */
+
+	z_reschedule(&queue->lock, key);
+}
+
 void k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list)
 {
 	__ASSERT(!sys_slist_is_empty(list), "list must not be empty");
@@ -300,6 +439,7 @@ static void *k_queue_poll(struct k_queue *queue, s32_t timeout)
 		}
 
 		key = k_spin_lock(&queue->lock);
+		queue_drain(queue);
 		val = z_queue_node_peek(sys_sflist_get(&queue->data_q), true);
 		k_spin_unlock(&queue->lock, key);
 
@@ -318,6 +458,8 @@ void *z_impl_k_queue_get(struct k_queue *queue, s32_t timeout)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	void *data;
 
+	queue_drain(queue);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
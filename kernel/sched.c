@@ -12,12 +12,13 @@
 #include <kernel_arch_func.h>
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
+#include <sys/mutex.h>
 #include <stdbool.h>
 
 #if defined(CONFIG_SCHED_DUMB)
 #define _priq_run_add		z_priq_dumb_add
 #define _priq_run_remove	z_priq_dumb_remove
-# if defined(CONFIG_SCHED_CPU_MASK)
+# if defined(CONFIG_SCHED_CPU_MASK) && !defined(CONFIG_SCHED_PERCPU_RUNQ)
 #  define _priq_run_best	_priq_dumb_mask_best
 # else
 #  define _priq_run_best	z_priq_dumb_best
@@ -30,6 +31,17 @@
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_best		z_priq_mq_best
+#elif defined(CONFIG_SCHED_BITMAP)
+#define _priq_run_add		z_priq_bm_add
+#define _priq_run_remove	z_priq_bm_remove
+#define _priq_run_best		z_priq_bm_best
+#endif
+
+/* Best thread from another CPU's queue that may run on this one */
+#if defined(CONFIG_SCHED_CPU_MASK)
+#define _priq_steal_best	_priq_dumb_mask_best
+#else
+#define _priq_steal_best	_priq_run_best
 #endif
 
 #if defined(CONFIG_WAITQ_SCALABLE)
@@ -40,6 +52,10 @@
 #define z_priq_wait_add		z_priq_dumb_add
 #define _priq_wait_remove	z_priq_dumb_remove
 #define _priq_wait_best		z_priq_dumb_best
+#elif defined(CONFIG_WAITQ_BITMAP)
+#define z_priq_wait_add		z_priq_bm_add
+#define _priq_wait_remove	z_priq_bm_remove
+#define _priq_wait_best		z_priq_bm_best
 #endif
 
 /* the only struct z_kernel instance */
@@ -52,6 +68,15 @@ static struct k_spinlock sched_spinlock;
 			!__i.key;					\
 			k_spin_unlock(lck, __key), __i.key = 1)
 
+#ifdef CONFIG_SWAP_NONATOMIC
+/* Run queue the current thread was scheduled from */
+#ifdef CONFIG_SCHED_PERCPU_RUNQ
+#define current_runq() (&_current_cpu->ready_q.runq)
+#else
+#define current_runq() (&_kernel.ready_q.runq)
+#endif
+#endif
+
 static inline int is_preempt(struct k_thread *thread)
 {
 #ifdef CONFIG_PREEMPT_ENABLED
@@ -176,6 +201,156 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+#ifdef CONFIG_SCHED_PERCPU_RUNQ
+/* CPUs with a scheduler IPI posted but not yet taken */
+static atomic_t pending_ipi;
+
+static ALWAYS_INLINE struct _ready_q *thread_ready_q(struct k_thread *th)
+{
+	return &_kernel.cpus[th->base.runq_cpu].ready_q;
+}
+
+static ALWAYS_INLINE bool cpu_allowed(struct k_thread *th, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (th->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	return true;
+#endif
+}
+
+/* Pick the CPU queue for a thread becoming ready: the allowed CPU
+ * running the least important thread, preferring the CPU the thread
+ * last ran on so it keeps its cache footprint.
+ */
+static int select_cpu(struct k_thread *th)
+{
+	int best = -1;
+
+	if (cpu_allowed(th, th->base.cpu)) {
+		best = th->base.cpu;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if (i == best || !cpu_allowed(th, i)) {
+			continue;
+		}
+
+		/* A CPU that has not started scheduling yet takes
+		 * anything
+		 */
+		if (best < 0 || curr == NULL ||
+		    (_kernel.cpus[best].current != NULL &&
+		     z_is_t1_higher_prio_than_t2(_kernel.cpus[best].current,
+						 curr))) {
+			best = i;
+		}
+	}
+
+	__ASSERT(best >= 0, "thread %p has an empty CPU mask", th);
+
+	return best;
+}
+
+/* Ask a remote CPU to reschedule, unless that request is already in
+ * flight.  The architecture IPI is a broadcast, so this is what keeps
+ * a burst of wakeups from turning into a burst of interrupts on every
+ * CPU.
+ */
+static void signal_cpu(int cpu)
+{
+	if (cpu == _current_cpu->id) {
+		return;
+	}
+
+	if ((atomic_or(&pending_ipi, BIT(cpu)) & BIT(cpu)) == 0) {
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+		z_arch_sched_ipi();
+#endif
+	}
+}
+
+static void runq_add_cpu(struct k_thread *th, int cpu)
+{
+	struct k_thread *curr = _kernel.cpus[cpu].current;
+
+	th->base.runq_cpu = cpu;
+	_priq_run_add(&thread_ready_q(th)->runq, th);
+
+	if (curr == NULL || z_is_t1_higher_prio_than_t2(th, curr)) {
+		signal_cpu(cpu);
+	}
+}
+
+static void runq_add(struct k_thread *th)
+{
+	runq_add_cpu(th, select_cpu(th));
+}
+
+static void runq_requeue(struct k_thread *th)
+{
+	_priq_run_add(&thread_ready_q(th)->runq, th);
+}
+
+static void runq_remove(struct k_thread *th)
+{
+	_priq_run_remove(&thread_ready_q(th)->runq, th);
+}
+
+/* Called when the local queue is empty: find the best thread queued
+ * on another CPU that is allowed to run here.
+ */
+static struct k_thread *steal(void)
+{
+	struct k_thread *best = NULL;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *th;
+
+		if (i == _current_cpu->id) {
+			continue;
+		}
+
+		th = _priq_steal_best(&_kernel.cpus[i].ready_q.runq);
+		if (th != NULL &&
+		    (best == NULL || z_is_t1_higher_prio_than_t2(th, best))) {
+			best = th;
+		}
+	}
+
+	return best;
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	struct k_thread *th = _priq_run_best(&_current_cpu->ready_q.runq);
+
+	return th != NULL ? th : steal();
+}
+#else
+static ALWAYS_INLINE void runq_add(struct k_thread *th)
+{
+	_priq_run_add(&_kernel.ready_q.runq, th);
+}
+
+static ALWAYS_INLINE void runq_requeue(struct k_thread *th)
+{
+	_priq_run_add(&_kernel.ready_q.runq, th);
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *th)
+{
+	_priq_run_remove(&_kernel.ready_q.runq, th);
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	return _priq_run_best(&_kernel.ready_q.runq);
+}
+#endif /* CONFIG_SCHED_PERCPU_RUNQ */
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 #ifndef CONFIG_SMP
@@ -185,7 +360,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	 * responsible for putting it back in z_swap and ISR return!),
 	 * which makes this choice simple.
 	 */
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best();
 
 	return th ? th : _current_cpu->idle_thread;
 #else
@@ -203,7 +378,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	int active = !z_is_thread_prevented_from_running(_current);
 
 	/* Choose the best thread that is not current */
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best();
 	if (th == NULL) {
 		th = _current_cpu->idle_thread;
 	}
@@ -221,13 +396,16 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 
 	/* Put _current back into the queue */
 	if (th != _current && active && !is_idle(_current) && !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+#ifdef CONFIG_SCHED_PERCPU_RUNQ
+		_current->base.runq_cpu = _current_cpu->id;
+#endif
+		runq_requeue(_current);
 		z_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(th)) {
-		_priq_run_remove(&_kernel.ready_q.runq, th);
+		runq_remove(th);
 	}
 	z_mark_thread_as_not_queued(th);
 
@@ -235,6 +413,105 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 #endif
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+
+/* Fixed point scale of CPU utilization */
+#define CBS_UTIL_SCALE 10000U
+
+/* Sum of budget/period of all reservations, in 1/CBS_UTIL_SCALE */
+static u32_t cbs_util_total;
+
+static u32_t cbs_util(s32_t period, s32_t budget)
+{
+	if (budget == 0) {
+		return 0U;
+	}
+
+	/* Round up, so admission errs on the safe side */
+	return (u32_t)(((u64_t)budget * CBS_UTIL_SCALE + period - 1) / period);
+}
+
+/* Align prio_deadline, which the scheduler compares, with the end of
+ * the current period
+ */
+static void cbs_deadline_update(struct k_thread *th, s64_t now)
+{
+	u32_t delta = (u32_t)(th->cbs.deadline - now) *
+		sys_clock_hw_cycles_per_tick();
+
+	th->base.prio_deadline = (int)(k_cycle_get_32() + delta);
+}
+
+static void cbs_replenish(struct k_thread *th, s64_t now)
+{
+	th->cbs.left = th->cbs.budget;
+	th->cbs.deadline = now + th->cbs.period;
+	cbs_deadline_update(th, now);
+}
+
+/* A waking thread keeps its deadline only if the budget left can be
+ * used up before it at the reserved rate, otherwise a new period starts
+ */
+static void cbs_wakeup(struct k_thread *th)
+{
+	s64_t now;
+
+	if (th->cbs.budget == 0) {
+		return;
+	}
+
+	now = z_tick_get();
+	if (th->cbs.deadline <= now ||
+	    (s64_t)th->cbs.left * th->cbs.period >
+	    (th->cbs.deadline - now) * th->cbs.budget) {
+		cbs_replenish(th, now);
+	} else {
+		cbs_deadline_update(th, now);
+	}
+}
+
+/* Get a timer interrupt when the budget of a thread about to run is
+ * used up
+ */
+static void cbs_arm(struct k_thread *th)
+{
+	if (th->cbs.budget != 0) {
+		z_set_timeout_expiry(MAX(th->cbs.left, 1), false);
+	}
+}
+
+/* Charge the announced ticks to the running thread */
+static void cbs_charge(int ticks)
+{
+	struct k_thread *th = _current;
+
+	if (th->cbs.budget == 0 || ticks <= 0) {
+		return;
+	}
+
+	th->cbs.left -= ticks;
+	if (th->cbs.left > 0) {
+		return;
+	}
+
+	/* Overrun: postpone the deadline by as many periods as it takes
+	 * to pay back the budget, and let earlier deadlines run first
+	 */
+	th->cbs.overruns++;
+	do {
+		th->cbs.left += th->cbs.budget;
+		th->cbs.deadline += th->cbs.period;
+	} while (th->cbs.left <= 0);
+
+	cbs_deadline_update(th, z_tick_get());
+	z_move_thread_to_end_of_prio_q(th);
+	cbs_arm(th);
+}
+#else
+static void cbs_wakeup(struct k_thread *th) { /* !CONFIG_SCHED_DEADLINE_CBS */ }
+static void cbs_arm(struct k_thread *th) { /* !CONFIG_SCHED_DEADLINE_CBS */ }
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_TIMESLICING
 
 static int slice_time;
@@ -290,6 +567,10 @@ void z_time_slice(int ticks)
 	pending_current = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	cbs_charge(ticks);
+#endif
+
 	if (slice_time && sliceable(_current)) {
 		if (ticks >= _current_cpu->slice_ticks) {
 			z_move_thread_to_end_of_prio_q(_current);
@@ -313,12 +594,16 @@ static void update_cache(int preempt_ok)
 	if (should_preempt(th, preempt_ok)) {
 		if (th != _current) {
 			reset_time_slice();
+			cbs_arm(th);
 		}
 		_kernel.ready_q.cache = th;
 	} else {
 		_kernel.ready_q.cache = _current;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+	z_sys_mutex_switch(_kernel.ready_q.cache);
+#endif
 #else
 	/* The way this works is that the CPU record keeps its
 	 * "cooperative swapping is OK" flag until the next reschedule
@@ -333,7 +618,8 @@ static void update_cache(int preempt_ok)
 void z_add_thread_to_ready_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+		cbs_wakeup(thread);
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(0);
 	}
@@ -342,8 +628,8 @@ void z_add_thread_to_ready_q(struct k_thread *thread)
 void z_move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
+		runq_requeue(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(thread == _current);
 	}
@@ -353,7 +639,7 @@ void z_remove_thread_from_ready_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 		}
 		update_cache(thread == _current);
@@ -490,9 +776,9 @@ bool z_set_prio(struct k_thread *thread, int prio)
 		if (need_sched) {
 			/* Don't requeue on SMP if it's the running thread */
 			if (!IS_ENABLED(CONFIG_SMP) || z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				thread->base.prio = prio;
-				_priq_run_add(&_kernel.ready_q.runq, thread);
+				runq_requeue(thread);
 			} else {
 				thread->base.prio = prio;
 			}
@@ -594,7 +880,7 @@ static inline void set_current(struct k_thread *new_thread)
 #ifdef CONFIG_TRACING
 	sys_trace_thread_switched_out();
 #endif
-	_current = new_thread;
+	_current_cpu->current = new_thread;
 #ifdef CONFIG_TRACING
 	sys_trace_thread_switched_in();
 #endif
@@ -613,6 +899,7 @@ void *z_get_next_switch_handle(void *interrupted)
 
 		if (_current != th) {
 			reset_time_slice();
+			cbs_arm(th);
 			_current_cpu->swap_ok = 0;
 			set_current(th);
 #ifdef SPIN_VALIDATE
@@ -661,7 +948,7 @@ ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq, struct k_thread *thread)
 void z_priq_dumb_remove(sys_dlist_t *pq, struct k_thread *thread)
 {
 #if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_DUMB)
-	if (pq == &_kernel.ready_q.runq && thread == _current &&
+	if (pq == current_runq() && thread == _current &&
 	    z_is_thread_prevented_from_running(thread)) {
 		return;
 	}
@@ -725,7 +1012,7 @@ void z_priq_rb_add(struct _priq_rb *pq, struct k_thread *thread)
 void z_priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread)
 {
 #if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_SCALABLE)
-	if (pq == &_kernel.ready_q.runq && thread == _current &&
+	if (pq == current_runq() && thread == _current &&
 	    z_is_thread_prevented_from_running(thread)) {
 		return;
 	}
@@ -767,7 +1054,7 @@ ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
 ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
 {
 #if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_MULTIQ)
-	if (pq == &_kernel.ready_q.runq && thread == _current &&
+	if (pq == current_runq() && thread == _current &&
 	    z_is_thread_prevented_from_running(thread)) {
 		return;
 	}
@@ -796,6 +1083,124 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return t;
 }
 
+#if defined(CONFIG_SCHED_BITMAP) || defined(CONFIG_WAITQ_BITMAP)
+BUILD_ASSERT(Z_PRIQ_BM_PRIOS == K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1);
+BUILD_ASSERT_MSG(Z_PRIQ_BM_WORDS <= 32, "Too many priorities for bitmap priq");
+
+void z_priq_bm_init(struct _priq_bm *pq)
+{
+	*pq = (struct _priq_bm) { };
+	sys_dlist_init(&pq->list);
+}
+
+static ALWAYS_INLINE void priq_bm_set(struct _priq_bm *pq, int i)
+{
+	pq->bitmap[i / 32] |= BIT(i % 32);
+#if Z_PRIQ_BM_WORDS > 1
+	pq->summary |= BIT(i / 32);
+#endif
+}
+
+static ALWAYS_INLINE void priq_bm_clear(struct _priq_bm *pq, int i)
+{
+	pq->bitmap[i / 32] &= ~BIT(i % 32);
+#if Z_PRIQ_BM_WORDS > 1
+	if (pq->bitmap[i / 32] == 0U) {
+		pq->summary &= ~BIT(i / 32);
+	}
+#endif
+}
+
+/* Highest occupied index less than or equal to i, or -1 */
+static ALWAYS_INLINE int priq_bm_floor(struct _priq_bm *pq, int i)
+{
+	int w = i / 32;
+	u32_t bits = pq->bitmap[w] & (~0U >> (31 - (i % 32)));
+
+#if Z_PRIQ_BM_WORDS > 1
+	if (bits == 0U) {
+		u32_t words = pq->summary & BIT_MASK(w);
+
+		if (words == 0U) {
+			return -1;
+		}
+		w = 31 - __builtin_clz(words);
+		bits = pq->bitmap[w];
+	}
+#endif
+	if (bits == 0U) {
+		return -1;
+	}
+
+	return w * 32 + (31 - __builtin_clz(bits));
+}
+
+ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq, struct k_thread *thread)
+{
+	int i = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int h = priq_bm_floor(pq, i);
+	sys_dnode_t *node = &thread->base.qnode_dlist;
+
+	__ASSERT_NO_MSG(!is_idle(thread));
+
+	/* Queue behind the last thread of equal or better priority */
+	if (h < 0) {
+		sys_dlist_prepend(&pq->list, node);
+	} else {
+		sys_dnode_t *next = sys_dlist_peek_next(&pq->list,
+						&pq->last[h]->base.qnode_dlist);
+
+		if (next != NULL) {
+			sys_dlist_insert(next, node);
+		} else {
+			sys_dlist_append(&pq->list, node);
+		}
+	}
+
+	thread->base.priq_index = i;
+	pq->last[i] = thread;
+	priq_bm_set(pq, i);
+}
+
+ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq,
+				    struct k_thread *thread)
+{
+#if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_BITMAP)
+	if (pq == current_runq() && thread == _current &&
+	    z_is_thread_prevented_from_running(thread)) {
+		return;
+	}
+#endif
+	int i = thread->base.priq_index;
+
+	if (pq->last[i] == thread) {
+		sys_dnode_t *prev = sys_dlist_peek_prev(&pq->list,
+						&thread->base.qnode_dlist);
+		struct k_thread *t = prev == NULL ? NULL :
+			CONTAINER_OF(prev, struct k_thread, base.qnode_dlist);
+
+		if (t != NULL && t->base.priq_index == i) {
+			pq->last[i] = t;
+		} else {
+			priq_bm_clear(pq, i);
+		}
+	}
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+}
+
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq)
+{
+	struct k_thread *t = NULL;
+	sys_dnode_t *n = sys_dlist_peek_head(&pq->list);
+
+	if (n != NULL) {
+		t = CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+	}
+	return t;
+}
+#endif /* CONFIG_SCHED_BITMAP || CONFIG_WAITQ_BITMAP */
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -810,14 +1215,14 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
-void z_sched_init(void)
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
@@ -825,9 +1230,24 @@ void z_sched_init(void)
 #endif
 
 #ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
+	}
+#endif
+
+#ifdef CONFIG_SCHED_BITMAP
+	z_priq_bm_init(&rq->runq);
+#endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_PERCPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
+#else
+	init_ready_q(&_kernel.ready_q);
 #endif
 
 #ifdef CONFIG_TIMESLICING
@@ -885,8 +1305,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	LOCKED(&sched_spinlock) {
 		th->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(th)) {
-			_priq_run_remove(&_kernel.ready_q.runq, th);
-			_priq_run_add(&_kernel.ready_q.runq, th);
+			runq_remove(th);
+			runq_requeue(th);
 		}
 	}
 }
@@ -907,6 +1327,77 @@ Z_SYSCALL_HANDLER(k_thread_deadline_set, thread_p, deadline)
 #endif
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+int z_impl_k_thread_cbs_set(k_tid_t tid, s32_t period, s32_t budget)
+{
+	struct k_thread *th = tid;
+	s32_t period_ticks, budget_ticks;
+	int ret = 0;
+
+	if (period <= 0 || budget < 0 || budget > period) {
+		return -EINVAL;
+	}
+
+	period_ticks = z_ms_to_ticks(period);
+	budget_ticks = z_ms_to_ticks(budget);
+
+	LOCKED(&sched_spinlock) {
+		u32_t util = cbs_util_total -
+			cbs_util(th->cbs.period, th->cbs.budget) +
+			cbs_util(period_ticks, budget_ticks);
+
+		if (util > CONFIG_SCHED_DEADLINE_CBS_MAX_UTIL *
+		    (CBS_UTIL_SCALE / 100U)) {
+			ret = -EBUSY;
+		} else {
+			cbs_util_total = util;
+			th->cbs.period = period_ticks;
+			th->cbs.budget = budget_ticks;
+			th->cbs.overruns = 0U;
+		}
+
+		if (ret == 0 && budget_ticks != 0) {
+			cbs_replenish(th, z_tick_get());
+			if (z_is_thread_queued(th)) {
+				runq_remove(th);
+				runq_requeue(th);
+			}
+		}
+	}
+
+	return ret;
+}
+
+void z_sched_cbs_release(struct k_thread *thread)
+{
+	LOCKED(&sched_spinlock) {
+		cbs_util_total -= cbs_util(thread->cbs.period,
+					   thread->cbs.budget);
+		thread->cbs.period = 0;
+		thread->cbs.budget = 0;
+	}
+}
+
+u32_t z_impl_k_thread_cbs_overruns_get(k_tid_t thread)
+{
+	return thread->cbs.overruns;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_thread_cbs_set, thread_p, period, budget)
+{
+	struct k_thread *thread = (struct k_thread *)thread_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+
+	return z_impl_k_thread_cbs_set((k_tid_t)thread, period, budget);
+}
+
+Z_SYSCALL_HANDLER1_SIMPLE(k_thread_cbs_overruns_get, K_OBJ_THREAD,
+			  struct k_thread *);
+#endif
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 void z_impl_k_yield(void)
 {
 	__ASSERT(!z_is_in_isr(), "");
@@ -915,10 +1406,8 @@ void z_impl_k_yield(void)
 		LOCKED(&sched_spinlock) {
 			if (!IS_ENABLED(CONFIG_SMP) ||
 			    z_is_thread_queued(_current)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 _current);
-				_priq_run_add(&_kernel.ready_q.runq,
-					      _current);
+				runq_remove(_current);
+				runq_requeue(_current);
 			}
 			update_cache(1);
 		}
@@ -1039,6 +1528,10 @@ void z_impl_k_wakeup(k_tid_t thread)
  */
 void z_sched_ipi(void)
 {
+#ifdef CONFIG_SCHED_PERCPU_RUNQ
+	atomic_and(&pending_ipi, ~BIT(_current_cpu->id));
+#endif
+
 	LOCKED(&sched_spinlock) {
 		if (_current->base.thread_state & _THREAD_ABORTING) {
 			_current->base.thread_state |= _THREAD_DEAD;
@@ -1070,7 +1563,7 @@ void z_sched_abort(struct k_thread *thread)
 		LOCKED(&sched_spinlock) {
 			if (z_is_thread_queued(thread)) {
 				thread->base.thread_state |= _THREAD_DEAD;
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				z_mark_thread_as_not_queued(thread);
 			}
 		}
@@ -30,6 +30,7 @@
 #include <kswap.h>
 #include <init.h>
 #include <debug/tracing.h>
+#include <sys/mutex.h>
 #include <stdbool.h>
 
 static struct k_spinlock lock;
@@ -407,12 +408,20 @@ void z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(new_thread);
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
+#ifdef CONFIG_DYNAMIC_OBJECTS_CACHE
+	(void)memset(&new_thread->obj_cache, 0,
+		     sizeof(new_thread->obj_cache));
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
 #endif
 	stack_size = adjust_stack_size(stack_size);
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	(void)memset(&new_thread->cbs, 0, sizeof(new_thread->cbs));
+#endif
+
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
 #ifndef CONFIG_THREAD_USERSPACE_LOCAL_DATA_ARCH_DEFER_SETUP
 	/* reserve space on top of stack for local data */
@@ -435,6 +444,11 @@ void z_setup_new_thread(struct k_thread *new_thread,
 #endif
 #endif
 
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+	/* The local data lies in uninitialized stack memory */
+	z_sys_mutex_forget(new_thread);
+#endif
+
 #ifdef CONFIG_THREAD_MONITOR
 	new_thread->entry.pEntry = entry;
 	new_thread->entry.parameter1 = p1;
@@ -656,6 +670,10 @@ void z_thread_single_abort(struct k_thread *thread)
 
 	thread->base.thread_state |= _THREAD_DEAD;
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	z_sched_cbs_release(thread);
+#endif
+
 	sys_trace_thread_abort(thread);
 
 #ifdef CONFIG_USERSPACE
@@ -17,7 +17,9 @@
 
 static u64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -38,6 +40,188 @@ Z_SYSCALL_HANDLER(z_clock_hw_cycles_per_sec_runtime_get)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+
+/*
+ * Hierarchical timing wheel.  Each timeout stores the low 32 bits of
+ * its absolute expiry tick in dticks.  Level N of the wheel has
+ * WHEEL_SLOTS buckets, each covering WHEEL_SLOTS^N ticks, and a
+ * timeout is filed in the lowest level where its bucket lies less
+ * than WHEEL_SLOTS buckets ahead of the current tick.  That placement
+ * stays valid as time advances (the distance only shrinks until the
+ * timeout fires), so no cascading is needed: arming and cancelling
+ * are O(1), and the earliest timeout is found by looking at the
+ * first occupied bucket of each level.
+ */
+#define WHEEL_BITS CONFIG_TIMEOUT_WHEEL_SLOT_BITS
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS ((32 + WHEEL_BITS - 1) / WHEEL_BITS)
+#define WHEEL_USED_MASK (~0U >> (32 - WHEEL_SLOTS))
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+/* Occupied-bucket bitmap per level */
+static u32_t wheel_used[WHEEL_LEVELS];
+
+/* Cached earliest timeout, valid when wheel_first_valid is set */
+static struct _timeout *wheel_first;
+static bool wheel_first_valid = true;
+
+static inline u32_t expiry(struct _timeout *t)
+{
+	return (u32_t)t->dticks;
+}
+
+static inline s32_t ticks_until(struct _timeout *t)
+{
+	return (s32_t)(expiry(t) - (u32_t)curr_tick);
+}
+
+static inline unsigned int level_shift(int level)
+{
+	return level * WHEEL_BITS;
+}
+
+static inline unsigned int slot_of(u32_t tick, int level)
+{
+	return (tick >> level_shift(level)) & WHEEL_MASK;
+}
+
+/* Distance in buckets of the given level between now and tick */
+static inline u32_t bucket_distance(u32_t tick, u32_t now, int level)
+{
+	unsigned int shift = level_shift(level);
+
+	return ((tick >> shift) - (now >> shift)) & (~0U >> shift);
+}
+
+static void wheel_init(void)
+{
+	static bool initialized;
+
+	if (initialized) {
+		return;
+	}
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		for (int s = 0; s < WHEEL_SLOTS; s++) {
+			sys_dlist_init(&wheel[l][s]);
+		}
+	}
+	initialized = true;
+}
+
+static struct _timeout *scan_first(void)
+{
+	struct _timeout *best = NULL;
+	u32_t now = (u32_t)curr_tick;
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		u32_t used = wheel_used[l];
+		unsigned int cur = slot_of(now, l);
+		sys_dnode_t *node;
+
+		if (used == 0U) {
+			continue;
+		}
+
+		/* Rotate so that bit 0 is the current bucket */
+		if (cur != 0U) {
+			used = (used >> cur) | (used << (WHEEL_SLOTS - cur));
+			used &= WHEEL_USED_MASK;
+		}
+
+		cur = (cur + find_lsb_set(used) - 1) & WHEEL_MASK;
+
+		SYS_DLIST_FOR_EACH_NODE(&wheel[l][cur], node) {
+			struct _timeout *t = CONTAINER_OF(node,
+							  struct _timeout,
+							  node);
+
+			if (best == NULL || ticks_until(t) < ticks_until(best)) {
+				best = t;
+			}
+		}
+	}
+
+	return best;
+}
+
+static struct _timeout *first(void)
+{
+	if (!wheel_first_valid) {
+		wheel_first = scan_first();
+		wheel_first_valid = true;
+	}
+
+	return wheel_first;
+}
+
+static void insert_timeout(struct _timeout *to, s32_t ticks)
+{
+	u32_t now = (u32_t)curr_tick;
+	u32_t exp = now + ticks;
+	int l;
+
+	wheel_init();
+
+	for (l = 0; l < WHEEL_LEVELS - 1; l++) {
+		if (bucket_distance(exp, now, l) < WHEEL_SLOTS) {
+			break;
+		}
+	}
+
+	to->dticks = (s32_t)exp;
+	sys_dlist_append(&wheel[l][slot_of(exp, l)], &to->node);
+	wheel_used[l] |= BIT(slot_of(exp, l));
+
+	if (wheel_first_valid &&
+	    (wheel_first == NULL || ticks < ticks_until(wheel_first))) {
+		wheel_first = to;
+	}
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	u32_t exp = expiry(t);
+
+	sys_dlist_remove(&t->node);
+
+	/* The timeout sat in one of these buckets; clear whichever
+	 * one it may have left empty.
+	 */
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		unsigned int s = slot_of(exp, l);
+
+		if ((wheel_used[l] & BIT(s)) != 0U &&
+		    sys_dlist_is_empty(&wheel[l][s])) {
+			wheel_used[l] &= ~BIT(s);
+		}
+	}
+
+	if (t == wheel_first) {
+		wheel_first_valid = false;
+	}
+}
+
+static void expire_timeout(struct _timeout *t)
+{
+	remove_timeout(t);
+}
+
+static void rebase_timeouts(s32_t ticks)
+{
+	ARG_UNUSED(ticks);
+}
+
+static s32_t timeout_ticks(struct _timeout *timeout)
+{
+	return ticks_until(timeout);
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -52,6 +236,32 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+static inline s32_t ticks_until(struct _timeout *t)
+{
+	return t->dticks;
+}
+
+static void insert_timeout(struct _timeout *to, s32_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+	for (t = first(); t != NULL; t = next(t)) {
+		__ASSERT(t->dticks >= 0, "");
+
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -61,6 +271,145 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static void expire_timeout(struct _timeout *t)
+{
+	t->dticks = 0;
+	remove_timeout(t);
+}
+
+static void rebase_timeouts(s32_t ticks)
+{
+	if (first() != NULL) {
+		first()->dticks -= ticks;
+	}
+}
+
+static s32_t timeout_ticks(struct _timeout *timeout)
+{
+	s32_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+
+/*
+ * High-resolution timeouts live in their own list, sorted by absolute
+ * expiry in k_cycle_get_32() units, which is kept in dticks.  The
+ * tick queue programs the timer driver as usual and the first
+ * high-resolution timeout then pulls the interrupt forward with
+ * z_clock_set_cycle_timeout(); expired entries are run from
+ * z_clock_announce() whatever the number of ticks announced.
+ */
+static sys_dlist_t hr_timeout_list = SYS_DLIST_STATIC_INIT(&hr_timeout_list);
+
+static struct _timeout *hr_first(void)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&hr_timeout_list);
+
+	return t == NULL ? NULL : CONTAINER_OF(t, struct _timeout, node);
+}
+
+static inline s32_t hr_cycles_until(struct _timeout *t, u32_t now)
+{
+	return (s32_t)((u32_t)t->dticks - now);
+}
+
+static s32_t hr_next_ticks(void)
+{
+	struct _timeout *t = hr_first();
+
+	if (t == NULL) {
+		return MAX_WAIT;
+	}
+
+	return MAX(0, hr_cycles_until(t, k_cycle_get_32())) /
+		sys_clock_hw_cycles_per_tick();
+}
+
+static void hr_program(void)
+{
+	struct _timeout *t = hr_first();
+
+	if (t != NULL) {
+		z_clock_set_cycle_timeout((u32_t)t->dticks);
+	}
+}
+
+static void hr_announce(k_spinlock_key_t *key)
+{
+	struct _timeout *t;
+
+	while ((t = hr_first()) != NULL &&
+	       hr_cycles_until(t, k_cycle_get_32()) <= 0) {
+		sys_dlist_remove(&t->node);
+
+		k_spin_unlock(&timeout_lock, *key);
+		t->fn(t);
+		*key = k_spin_lock(&timeout_lock);
+	}
+}
+
+void z_add_hr_timeout(struct _timeout *to, _timeout_func_t fn, u32_t cycle)
+{
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+	to->dticks = (s32_t)cycle;
+
+	LOCKED(&timeout_lock) {
+		struct _timeout *t;
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&hr_timeout_list, t, node) {
+			if ((s32_t)(cycle - (u32_t)t->dticks) < 0) {
+				sys_dlist_insert(&t->node, &to->node);
+				break;
+			}
+		}
+
+		if (!sys_dnode_is_linked(&to->node)) {
+			sys_dlist_append(&hr_timeout_list, &to->node);
+		}
+
+		if (to == hr_first()) {
+			z_clock_set_cycle_timeout(cycle);
+		}
+	}
+}
+
+int z_abort_hr_timeout(struct _timeout *to)
+{
+	int ret = -EINVAL;
+
+	LOCKED(&timeout_lock) {
+		if (sys_dnode_is_linked(&to->node)) {
+			sys_dlist_remove(&to->node);
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+s32_t z_hr_timeout_remaining(struct _timeout *timeout)
+{
+	if (z_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	return MAX(0, hr_cycles_until(timeout, k_cycle_get_32()));
+}
+
+#endif /* CONFIG_SYS_CLOCK_HR_TIMEOUT */
+
 static s32_t elapsed(void)
 {
 	return announce_remaining == 0 ? z_clock_elapsed() : 0;
@@ -70,16 +419,27 @@ static s32_t next_timeout(void)
 {
 	struct _timeout *to = first();
 	s32_t ticks_elapsed = elapsed();
-	s32_t ret = to == NULL ? MAX_WAIT : MAX(0, to->dticks - ticks_elapsed);
+	s32_t ret = to == NULL ? MAX_WAIT : MAX(0, ticks_until(to) - ticks_elapsed);
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
 		ret = _current_cpu->slice_ticks;
 	}
+#endif
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	ret = MIN(ret, hr_next_ticks());
 #endif
 	return ret;
 }
 
+static void set_clock_timeout(s32_t ticks, bool idle)
+{
+	z_clock_set_timeout(ticks, idle);
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	hr_program();
+#endif
+}
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 {
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
@@ -87,26 +447,10 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
-		to->dticks = ticks + elapsed();
-		for (t = first(); t != NULL; t = next(t)) {
-			__ASSERT(t->dticks >= 0, "");
-
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, ticks + elapsed());
 
 		if (to == first()) {
-			z_clock_set_timeout(next_timeout(), false);
+			set_clock_timeout(next_timeout(), false);
 		}
 	}
 }
@@ -134,12 +478,7 @@ s32_t z_timeout_remaining(struct _timeout *timeout)
 	}
 
 	LOCKED(&timeout_lock) {
-		for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-			ticks += t->dticks;
-			if (timeout == t) {
-				break;
-			}
-		}
+		ticks = timeout_ticks(timeout);
 	}
 
 	return ticks - elapsed();
@@ -169,7 +508,7 @@ void z_set_timeout_expiry(s32_t ticks, bool idle)
 		 * it's not considered to be settable as directed.
 		 */
 		if (sooner && !imminent) {
-			z_clock_set_timeout(ticks, idle);
+			set_clock_timeout(ticks, idle);
 		}
 	}
 }
@@ -184,28 +523,29 @@ void z_clock_announce(s32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
+	while (first() != NULL && ticks_until(first()) <= announce_remaining) {
 		struct _timeout *t = first();
-		int dt = t->dticks;
+		int dt = ticks_until(t);
 
 		curr_tick += dt;
 		announce_remaining -= dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		expire_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
+	rebase_timeouts(announce_remaining);
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
-	z_clock_set_timeout(next_timeout(), false);
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	hr_announce(&key);
+#endif
+
+	set_clock_timeout(next_timeout(), false);
 
 	k_spin_unlock(&timeout_lock, key);
 }
@@ -35,6 +35,24 @@ SYS_INIT(init_timer_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
 #endif /* CONFIG_OBJECT_TRACING */
 
+static inline bool timer_is_hr(struct k_timer *timer)
+{
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	return timer->hr;
+#else
+	return false;
+#endif
+}
+
+static int timer_abort(struct k_timer *timer)
+{
+	if (timer_is_hr(timer)) {
+		return z_abort_hr_timeout(&timer->timeout);
+	}
+
+	return z_abort_timeout(&timer->timeout);
+}
+
 /**
  * @brief Handle expiration of a kernel timer object.
  *
@@ -51,7 +69,11 @@ void z_timer_expiration_handler(struct _timeout *t)
 	 * if the timer is periodic, start it again; don't add _TICK_ALIGN
 	 * since we're already aligned to a tick boundary
 	 */
-	if (timer->period > 0) {
+	if (timer->period > 0 && timer_is_hr(timer)) {
+		/* high-resolution: relative to the expiry that just passed */
+		z_add_hr_timeout(&timer->timeout, z_timer_expiration_handler,
+				 (u32_t)t->dticks + timer->period);
+	} else if (timer->period > 0) {
 		z_add_timeout(&timer->timeout, z_timer_expiration_handler,
 			     timer->period);
 	}
@@ -114,13 +136,31 @@ void z_impl_k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
 	period_in_ticks = z_ms_to_ticks(period);
 	duration_in_ticks = z_ms_to_ticks(duration);
 
-	(void)z_abort_timeout(&timer->timeout);
+	(void)timer_abort(timer);
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	timer->hr = false;
+#endif
 	timer->period = period_in_ticks;
 	timer->status = 0U;
 	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
 		     duration_in_ticks);
 }
 
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+void k_timer_start_cycles(struct k_timer *timer, u32_t duration, u32_t period)
+{
+	__ASSERT((s32_t)duration >= 0 && (s32_t)period >= 0 &&
+		 (duration != 0 || period != 0), "invalid parameters\n");
+
+	(void)timer_abort(timer);
+	timer->hr = true;
+	timer->period = (s32_t)period;
+	timer->status = 0U;
+	z_add_hr_timeout(&timer->timeout, z_timer_expiration_handler,
+			 k_cycle_get_32() + duration);
+}
+#endif
+
 #ifdef CONFIG_USERSPACE
 Z_SYSCALL_HANDLER(k_timer_start, timer, duration_p, period_p)
 {
@@ -139,7 +179,7 @@ Z_SYSCALL_HANDLER(k_timer_start, timer, duration_p, period_p)
 
 void z_impl_k_timer_stop(struct k_timer *timer)
 {
-	int inactive = z_abort_timeout(&timer->timeout) != 0;
+	int inactive = timer_abort(timer) != 0;
 
 	if (inactive) {
 		return;
@@ -9,7 +9,6 @@
 #include <string.h>
 #include <sys/math_extras.h>
 #include <sys/printk.h>
-#include <sys/rb.h>
 #include <kernel_structs.h>
 #include <sys/sys_io.h>
 #include <ksched.h>
@@ -94,7 +93,7 @@ struct perm_ctx {
 struct dyn_obj {
 	struct _k_object kobj;
 	sys_dnode_t obj_list;
-	struct rbnode node; /* must be immediately before data member */
+	sys_snode_t hash_node;
 	u8_t data[]; /* The object itself */
 };
 
@@ -102,15 +101,15 @@ extern struct _k_object *z_object_gperf_find(void *obj);
 extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b);
+BUILD_ASSERT_MSG((CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS &
+		  (CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS - 1)) == 0,
+		 "CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS must be a power of two");
 
 /*
- * Red/black tree of allocated kernel objects, for reasonably fast lookups
+ * Hash table of allocated kernel objects, for constant time lookups
  * based on object pointer values.
  */
-static struct rbtree obj_rb_tree = {
-	.lessthan_fn = node_lessthan
-};
+static sys_slist_t obj_hash[CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
 
 /*
  * Linked list of allocated kernel objects, for iteration over all allocated
@@ -118,10 +117,12 @@ static struct rbtree obj_rb_tree = {
  */
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
+#ifdef CONFIG_DYNAMIC_OBJECTS_CACHE
+/* Bumped whenever a dynamic object goes away, invalidating all the
+ * per-thread lookup caches
  */
+static atomic_t obj_gen;
+#endif
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -137,39 +138,92 @@ static size_t obj_size_get(enum k_objects otype)
 	return ret;
 }
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+static inline sys_slist_t *obj_bucket(void *obj)
 {
-	return a < b;
-}
+	uintptr_t h = (uintptr_t)obj;
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
-{
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	/* Objects come from the heap, so the lowest bits carry hardly
+	 * any information
+	 */
+	h = (h >> 3) ^ (h >> 11);
+
+	return &obj_hash[h & (CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS - 1)];
 }
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
-	struct dyn_obj *ret;
-
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the conatining struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
-	 */
-	node = (struct rbnode *)((char *)obj - sizeof(struct rbnode));
+	struct dyn_obj *node;
+	struct dyn_obj *ret = NULL;
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
-	} else {
-		ret = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_bucket(obj), node, hash_node) {
+		if (node->kobj.name == obj) {
+			ret = node;
+			break;
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 
 	return ret;
 }
 
+/* Must be called with lists_lock held */
+static void dyn_object_unlink(struct dyn_obj *dyn_obj)
+{
+	(void)sys_slist_find_and_remove(obj_bucket(dyn_obj->kobj.name),
+					&dyn_obj->hash_node);
+	sys_dlist_remove(&dyn_obj->obj_list);
+#ifdef CONFIG_DYNAMIC_OBJECTS_CACHE
+	(void)atomic_inc(&obj_gen);
+#endif
+}
+
+#ifdef CONFIG_DYNAMIC_OBJECTS_CACHE
+static struct _thread_obj_cache *obj_cache_get(void)
+{
+	struct _thread_obj_cache *cache;
+	atomic_val_t gen;
+
+	/* ISRs would race with the owner of the interrupted thread's cache */
+	if (k_is_in_isr() || _current == NULL) {
+		return NULL;
+	}
+
+	/* Read before looking anything up, so an object freed meanwhile
+	 * can't end up cached under the new generation
+	 */
+	gen = atomic_get(&obj_gen);
+	cache = &_current->obj_cache;
+	if (cache->gen != gen) {
+		(void)memset(cache->entry, 0, sizeof(cache->entry));
+		cache->gen = gen;
+	}
+
+	return cache;
+}
+
+static struct _k_object *obj_cache_find(struct _thread_obj_cache *cache,
+					void *obj)
+{
+	for (int i = 0; i < CONFIG_DYNAMIC_OBJECTS_CACHE_SIZE; i++) {
+		if (cache->entry[i].obj == obj) {
+			return cache->entry[i].ko;
+		}
+	}
+
+	return NULL;
+}
+
+static void obj_cache_add(struct _thread_obj_cache *cache, void *obj,
+			  struct _k_object *ko)
+{
+	cache->entry[cache->next].obj = obj;
+	cache->entry[cache->next].ko = ko;
+	cache->next = (cache->next + 1) % CONFIG_DYNAMIC_OBJECTS_CACHE_SIZE;
+}
+#endif /* CONFIG_DYNAMIC_OBJECTS_CACHE */
+
 /**
  * @internal
  *
@@ -233,6 +287,15 @@ static void thread_idx_free(u32_t tidx)
 	sys_bitfield_set_bit((mem_addr_t)_thread_idx_map, tidx);
 }
 
+int z_impl_k_syscall_batch(struct k_syscall_entry *entries, size_t count)
+{
+	ARG_UNUSED(entries);
+	ARG_UNUSED(count);
+
+	/* Supervisor threads call the kernel functions directly */
+	return -EPERM;
+}
+
 void *z_impl_k_object_alloc(enum k_objects otype)
 {
 	struct dyn_obj *dyn_obj;
@@ -273,7 +336,7 @@ void *z_impl_k_object_alloc(enum k_objects otype)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn_obj->node);
+	sys_slist_prepend(obj_bucket(dyn_obj->kobj.name), &dyn_obj->hash_node);
 	sys_dlist_append(&obj_list, &dyn_obj->obj_list);
 	k_spin_unlock(&lists_lock, key);
 
@@ -293,8 +356,10 @@ void k_object_free(void *obj)
 
 	dyn_obj = dyn_object_find(obj);
 	if (dyn_obj != NULL) {
-		rb_remove(&obj_rb_tree, &dyn_obj->node);
-		sys_dlist_remove(&dyn_obj->obj_list);
+		k_spinlock_key_t lists_key = k_spin_lock(&lists_lock);
+
+		dyn_object_unlink(dyn_obj);
+		k_spin_unlock(&lists_lock, lists_key);
 
 		if (dyn_obj->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn_obj->kobj.data);
@@ -315,10 +380,25 @@ struct _k_object *z_object_find(void *obj)
 
 	if (ret == NULL) {
 		struct dyn_obj *dynamic_obj;
+#ifdef CONFIG_DYNAMIC_OBJECTS_CACHE
+		struct _thread_obj_cache *cache = obj_cache_get();
+
+		if (cache != NULL) {
+			ret = obj_cache_find(cache, obj);
+			if (ret != NULL) {
+				return ret;
+			}
+		}
+#endif
 
 		dynamic_obj = dyn_object_find(obj);
 		if (dynamic_obj != NULL) {
 			ret = &dynamic_obj->kobj;
+#ifdef CONFIG_DYNAMIC_OBJECTS_CACHE
+			if (cache != NULL) {
+				obj_cache_add(cache, obj, ret);
+			}
+#endif
 		}
 	}
 
@@ -393,8 +473,10 @@ static void unref_check(struct _k_object *ko, int index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn_obj->node);
-	sys_dlist_remove(&dyn_obj->obj_list);
+	k_spinlock_key_t lists_key = k_spin_lock(&lists_lock);
+
+	dyn_object_unlink(dyn_obj);
+	k_spin_unlock(&lists_lock, lists_key);
 	k_free(dyn_obj);
 out:
 #endif
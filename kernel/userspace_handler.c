@@ -7,6 +7,7 @@
 #include <kernel.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#include <string.h>
 
 static struct _k_object *validate_any_object(void *obj)
 {
@@ -61,6 +62,36 @@ Z_SYSCALL_HANDLER(k_object_release, object)
 	return 0;
 }
 
+Z_SYSCALL_HANDLER(k_syscall_batch, entries_p, count)
+{
+	struct k_syscall_entry *entries = (struct k_syscall_entry *)entries_p;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(entries, count,
+					    sizeof(struct k_syscall_entry)));
+
+	for (size_t i = 0; i < count; i++) {
+		struct k_syscall_entry entry;
+
+		/* Work on a copy, the thread may modify the array under us */
+		(void)memcpy(&entry, &entries[i], sizeof(entry));
+
+		Z_OOPS(Z_SYSCALL_VERIFY_MSG(entry.id < K_SYSCALL_LIMIT &&
+					    entry.id != K_SYSCALL_K_SYSCALL_BATCH,
+					    "bad syscall %u in batch",
+					    entry.id));
+
+		entries[i].ret = _k_syscall_table[entry.id](entry.arg[0],
+							    entry.arg[1],
+							    entry.arg[2],
+							    entry.arg[3],
+							    entry.arg[4],
+							    entry.arg[5],
+							    ssf);
+	}
+
+	return 0;
+}
+
 Z_SYSCALL_HANDLER(k_object_alloc, otype)
 {
 	Z_OOPS(Z_SYSCALL_VERIFY_MSG(otype > K_OBJ_ANY && otype < K_OBJ_LAST &&
@@ -16,6 +16,7 @@
 #include <spinlock.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define WORKQUEUE_THREAD_NAME	"workqueue"
 
@@ -29,12 +30,57 @@ void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 		    size_t stack_size, int prio)
 {
 	k_queue_init(&work_q->queue);
+#ifdef CONFIG_WORKQUEUE_STATS
+	(void)memset(&work_q->stats, 0, sizeof(work_q->stats));
+#endif
 	(void)k_thread_create(&work_q->thread, stack, stack_size, z_work_q_main,
 			work_q, NULL, NULL, prio, 0, 0);
 
 	k_thread_name_set(&work_q->thread, WORKQUEUE_THREAD_NAME);
 }
 
+int k_work_q_worker_add(struct k_work_q *work_q, struct k_thread *thread,
+			k_thread_stack_t *stack, size_t stack_size, int prio,
+			int cpu)
+{
+	if (cpu >= CONFIG_MP_NUM_CPUS) {
+		return -EINVAL;
+	}
+
+#ifndef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		return -ENOTSUP;
+	}
+#endif
+
+	(void)k_thread_create(thread, stack, stack_size, z_work_q_main,
+			      work_q, NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_name_set(thread, WORKQUEUE_THREAD_NAME);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* The mask can only be changed before the thread is started */
+	if (cpu >= 0) {
+		(void)k_thread_cpu_mask_clear(thread);
+		(void)k_thread_cpu_mask_enable(thread, cpu);
+	}
+#endif
+
+	k_thread_start(thread);
+
+	return 0;
+}
+
+#ifdef CONFIG_WORKQUEUE_STATS
+void k_work_q_stats_get(struct k_work_q *work_q, struct k_work_q_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+
+	*stats = work_q->stats;
+
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+#endif
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 static void work_timeout(struct _timeout *t)
 {
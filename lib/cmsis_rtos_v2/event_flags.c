@@ -17,9 +17,6 @@ static const osEventFlagsAttr_t init_event_flags_attrs = {
 	.cb_size = 0,
 };
 
-#define DONT_CARE               (0)
-#define NSEC_PER_MSEC           (NSEC_PER_USEC * USEC_PER_MSEC)
-
 /**
  * @brief Create and Initialize an Event Flags object.
  */
@@ -35,17 +32,20 @@ osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr)
 		attr = &init_event_flags_attrs;
 	}
 
-	if (k_mem_slab_alloc(&cv2_event_flags_slab, (void **)&events, 100)
-	    == 0) {
-		memset(events, 0, sizeof(struct cv2_event_flags));
-	} else {
+	if (attr->cb_mem != NULL) {
+		if (attr->cb_size < sizeof(struct cv2_event_flags)) {
+			return NULL;
+		}
+		events = (struct cv2_event_flags *)attr->cb_mem;
+	} else if (k_mem_slab_alloc(&cv2_event_flags_slab, (void **)&events,
+				    100) != 0) {
 		return NULL;
 	}
 
-	k_poll_signal_init(&events->poll_signal);
-	k_poll_event_init(&events->poll_event, K_POLL_TYPE_SIGNAL,
-			  K_POLL_MODE_NOTIFY_ONLY, &events->poll_signal);
-	events->signal_results = 0U;
+	memset(events, 0, sizeof(struct cv2_event_flags));
+	events->is_cb_dynamic_allocation = (attr->cb_mem == NULL);
+
+	k_event_init(&events->z_event);
 
 	if (attr->name == NULL) {
 		strncpy(events->name, init_event_flags_attrs.name,
@@ -63,19 +63,12 @@ osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr)
 uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
 {
 	struct cv2_event_flags *events = (struct cv2_event_flags *)ef_id;
-	int key;
 
 	if ((ef_id == NULL) || (flags & 0x80000000)) {
 		return osFlagsErrorParameter;
 	}
 
-	key = irq_lock();
-	events->signal_results |= flags;
-	irq_unlock(key);
-
-	k_poll_signal_raise(&events->poll_signal, DONT_CARE);
-
-	return events->signal_results;
+	return k_event_post(&events->z_event, flags);
 }
 
 /**
@@ -84,19 +77,12 @@ uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
 uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags)
 {
 	struct cv2_event_flags *events = (struct cv2_event_flags *)ef_id;
-	int key;
-	u32_t sig;
 
 	if ((ef_id == NULL) || (flags & 0x80000000)) {
 		return osFlagsErrorParameter;
 	}
 
-	key = irq_lock();
-	sig = events->signal_results;
-	events->signal_results &= ~(flags);
-	irq_unlock(key);
-
-	return sig;
+	return k_event_clear(&events->z_event, flags);
 }
 
 /**
@@ -106,92 +92,40 @@ uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags,
 			  uint32_t options, uint32_t timeout)
 {
 	struct cv2_event_flags *events = (struct cv2_event_flags *)ef_id;
-	int retval, key;
+	bool clear = !(options & osFlagsNoClear);
+	s32_t timeout_ms;
 	u32_t sig;
-	u32_t time_delta_ms, timeout_ms = __ticks_to_ms(timeout);
-	u64_t time_stamp_start, hwclk_cycles_delta, time_delta_ns;
 
 	/* Can be called from ISRs only if timeout is set to 0 */
 	if (timeout > 0 && k_is_in_isr()) {
 		return osFlagsErrorUnknown;
 	}
 
-	if ((ef_id == NULL) || (flags & 0x80000000)) {
+	if ((ef_id == NULL) || (flags == 0U) || (flags & 0x80000000)) {
 		return osFlagsErrorParameter;
 	}
 
-	for (;;) {
-
-		time_stamp_start = (u64_t)k_cycle_get_32();
-
-		switch (timeout) {
-		case 0:
-			retval = k_poll(&events->poll_event, 1, K_NO_WAIT);
-			break;
-		case osWaitForever:
-			retval = k_poll(&events->poll_event, 1, K_FOREVER);
-			break;
-		default:
-			retval = k_poll(&events->poll_event, 1, timeout_ms);
-			break;
-		}
-
-		switch (retval) {
-		case 0:
-			break;
-		case -EAGAIN:
-			return osFlagsErrorTimeout;
-		default:
-			return osFlagsErrorUnknown;
-		}
-
-		__ASSERT(events->poll_event.state == K_POLL_STATE_SIGNALED,
-			 "event state not signalled!");
-		__ASSERT(events->poll_event.signal->signaled == 1U,
-			 "event signaled is not 1");
-
-		/* Reset the states to facilitate the next trigger */
-		events->poll_event.signal->signaled = 0U;
-		events->poll_event.state = K_POLL_STATE_NOT_READY;
-
-		if (options & osFlagsWaitAll) {
-
-			/* Check if all events we are waiting on have
-			 * been signalled
-			 */
-			if ((events->signal_results & flags) == flags) {
-				break;
-			}
-
-			/* If we need to wait on more signals, we need to
-			 * adjust the timeout value accordingly based on
-			 * the time that has already elapsed.
-			 */
-			hwclk_cycles_delta =
-				(u64_t)k_cycle_get_32() - time_stamp_start;
-
-			time_delta_ns =
-				(u32_t)SYS_CLOCK_HW_CYCLES_TO_NS(hwclk_cycles_delta);
-
-			time_delta_ms = (u32_t)time_delta_ns / NSEC_PER_MSEC;
-
-			if (timeout_ms > time_delta_ms) {
-				timeout_ms -= time_delta_ms;
-			} else {
-				timeout_ms = 0U;
-			}
-		} else {
-			break;
-		}
+	if (timeout == osWaitForever) {
+		timeout_ms = K_FOREVER;
+	} else if (timeout == 0U) {
+		timeout_ms = K_NO_WAIT;
+	} else {
+		timeout_ms = __ticks_to_ms(timeout);
 	}
 
-	sig = events->signal_results;
-	if (!(options & osFlagsNoClear)) {
+	/* The kernel only wakes us once the condition holds, and clears the
+	 * flags on our behalf.
+	 */
+	if (options & osFlagsWaitAll) {
+		sig = k_event_wait_all(&events->z_event, flags, clear,
+				       timeout_ms);
+	} else {
+		sig = k_event_wait(&events->z_event, flags, clear, timeout_ms);
+	}
 
-		/* Clear signal flags as the thread is ready now */
-		key = irq_lock();
-		events->signal_results &= ~(flags);
-		irq_unlock(key);
+	if (sig == 0U) {
+		return (timeout == 0U) ? osFlagsErrorResource :
+					 osFlagsErrorTimeout;
 	}
 
 	return sig;
@@ -222,7 +156,7 @@ uint32_t osEventFlagsGet(osEventFlagsId_t ef_id)
 		return 0;
 	}
 
-	return events->signal_results;
+	return events->z_event.events;
 }
 
 /**
@@ -244,7 +178,9 @@ osStatus_t osEventFlagsDelete(osEventFlagsId_t ef_id)
 	 * ef_id is incorrect) is not supported in Zephyr.
 	 */
 
-	k_mem_slab_free(&cv2_event_flags_slab, (void *)&events);
+	if (events->is_cb_dynamic_allocation) {
+		k_mem_slab_free(&cv2_event_flags_slab, (void *)&events);
+	}
 
 	return osOK;
 }
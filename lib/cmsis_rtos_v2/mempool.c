@@ -45,12 +45,19 @@ osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size,
 		attr = &init_mslab_attrs;
 	}
 
-	if (k_mem_slab_alloc(&cv2_mem_slab, (void **)&mslab, 100) == 0) {
-		(void)memset(mslab, 0, sizeof(struct cv2_mslab));
-	} else {
+	if (attr->cb_mem != NULL) {
+		if (attr->cb_size < sizeof(struct cv2_mslab)) {
+			return NULL;
+		}
+		mslab = (struct cv2_mslab *)attr->cb_mem;
+	} else if (k_mem_slab_alloc(&cv2_mem_slab, (void **)&mslab,
+				    100) != 0) {
 		return NULL;
 	}
 
+	(void)memset(mslab, 0, sizeof(struct cv2_mslab));
+	mslab->is_cb_dynamic_allocation = (attr->cb_mem == NULL);
+
 	if (attr->mp_mem == NULL) {
 		__ASSERT((block_count * block_size) <=
 			 CONFIG_CMSIS_V2_MEM_SLAB_MAX_DYNAMIC_SIZE,
@@ -58,7 +65,9 @@ osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size,
 
 		mslab->pool = k_calloc(block_count, block_size);
 		if (mslab->pool == NULL) {
-			k_mem_slab_free(&cv2_mem_slab, (void *) &mslab);
+			if (mslab->is_cb_dynamic_allocation) {
+				k_mem_slab_free(&cv2_mem_slab, (void *)&mslab);
+			}
 			return NULL;
 		}
 		mslab->is_dynamic_allocation = TRUE;
@@ -232,7 +241,9 @@ osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id)
 	if (mslab->is_dynamic_allocation) {
 		k_free(mslab->pool);
 	}
-	k_mem_slab_free(&cv2_mem_slab, (void *)&mslab);
+	if (mslab->is_cb_dynamic_allocation) {
+		k_mem_slab_free(&cv2_mem_slab, (void *)&mslab);
+	}
 
 	return osOK;
 }
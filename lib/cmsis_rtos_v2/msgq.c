@@ -43,12 +43,19 @@ osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size,
 		attr = &init_msgq_attrs;
 	}
 
-	if (k_mem_slab_alloc(&cv2_msgq_slab, (void **)&msgq, 100) == 0) {
-		(void)memset(msgq, 0, sizeof(struct cv2_msgq));
-	} else {
+	if (attr->cb_mem != NULL) {
+		if (attr->cb_size < sizeof(struct cv2_msgq)) {
+			return NULL;
+		}
+		msgq = (struct cv2_msgq *)attr->cb_mem;
+	} else if (k_mem_slab_alloc(&cv2_msgq_slab, (void **)&msgq,
+				    100) != 0) {
 		return NULL;
 	}
 
+	(void)memset(msgq, 0, sizeof(struct cv2_msgq));
+	msgq->is_cb_dynamic_allocation = (attr->cb_mem == NULL);
+
 	if (attr->mq_mem == NULL) {
 		__ASSERT((msg_count * msg_size) <=
 			 CONFIG_CMSIS_V2_MSGQ_MAX_DYNAMIC_SIZE,
@@ -56,7 +63,9 @@ osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size,
 
 		msgq->pool = k_calloc(msg_count, msg_size);
 		if (msgq->pool == NULL) {
-			k_mem_slab_free(&cv2_msgq_slab, (void *) &msgq);
+			if (msgq->is_cb_dynamic_allocation) {
+				k_mem_slab_free(&cv2_msgq_slab, (void *)&msgq);
+			}
 			return NULL;
 		}
 		msgq->is_dynamic_allocation = TRUE;
@@ -273,7 +282,9 @@ osStatus_t osMessageQueueDelete(osMessageQueueId_t msgq_id)
 	if (msgq->is_dynamic_allocation) {
 		k_free(msgq->pool);
 	}
-	k_mem_slab_free(&cv2_msgq_slab, (void *)&msgq);
+	if (msgq->is_cb_dynamic_allocation) {
+		k_mem_slab_free(&cv2_msgq_slab, (void *)&msgq);
+	}
 
 	return osOK;
 }
@@ -38,12 +38,19 @@ osMutexId_t osMutexNew(const osMutexAttr_t *attr)
 	__ASSERT(!(attr->attr_bits & osMutexRobust),
 		 "Zephyr does not support osMutexRobust.\n");
 
-	if (k_mem_slab_alloc(&cv2_mutex_slab, (void **)&mutex, 100) == 0) {
-		memset(mutex, 0, sizeof(struct cv2_mutex));
-	} else {
+	if (attr->cb_mem != NULL) {
+		if (attr->cb_size < sizeof(struct cv2_mutex)) {
+			return NULL;
+		}
+		mutex = (struct cv2_mutex *)attr->cb_mem;
+	} else if (k_mem_slab_alloc(&cv2_mutex_slab, (void **)&mutex,
+				    100) != 0) {
 		return NULL;
 	}
 
+	memset(mutex, 0, sizeof(struct cv2_mutex));
+	mutex->is_cb_dynamic_allocation = (attr->cb_mem == NULL);
+
 	k_mutex_init(&mutex->z_mutex);
 	mutex->state = attr->attr_bits;
 
@@ -150,7 +157,9 @@ osStatus_t osMutexDelete(osMutexId_t mutex_id)
 	 * mutex_id is in an invalid mutex state) is not supported in Zephyr.
 	 */
 
-	k_mem_slab_free(&cv2_mutex_slab, (void *) &mutex);
+	if (mutex->is_cb_dynamic_allocation) {
+		k_mem_slab_free(&cv2_mutex_slab, (void *)&mutex);
+	}
 
 	return osOK;
 }
@@ -33,13 +33,19 @@ osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count,
 		attr = &init_sema_attrs;
 	}
 
-	if (k_mem_slab_alloc(&cv2_semaphore_slab,
-			     (void **)&semaphore, 100) == 0) {
-		(void)memset(semaphore, 0, sizeof(struct cv2_sem));
-	} else {
+	if (attr->cb_mem != NULL) {
+		if (attr->cb_size < sizeof(struct cv2_sem)) {
+			return NULL;
+		}
+		semaphore = (struct cv2_sem *)attr->cb_mem;
+	} else if (k_mem_slab_alloc(&cv2_semaphore_slab, (void **)&semaphore,
+				    100) != 0) {
 		return NULL;
 	}
 
+	(void)memset(semaphore, 0, sizeof(struct cv2_sem));
+	semaphore->is_cb_dynamic_allocation = (attr->cb_mem == NULL);
+
 	k_sem_init(&semaphore->z_semaphore, initial_count, max_count);
 
 	if (attr->name == NULL) {
@@ -141,7 +147,9 @@ osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id)
 	 * supported in Zephyr.
 	 */
 
-	k_mem_slab_free(&cv2_semaphore_slab, (void *) &semaphore);
+	if (semaphore->is_cb_dynamic_allocation) {
+		k_mem_slab_free(&cv2_semaphore_slab, (void *)&semaphore);
+	}
 
 	return osOK;
 }
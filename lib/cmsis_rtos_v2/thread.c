@@ -114,14 +114,18 @@ osThreadId_t osThreadNew(osThreadFunc_t threadfunc, void *arg,
 		return NULL;
 	}
 
-	if (thread_num >= CONFIG_CMSIS_V2_THREAD_MAX_COUNT) {
-		return NULL;
-	}
-
 	if (attr == NULL) {
 		attr = &init_thread_attrs;
 	}
 
+	if (attr->cb_mem != NULL) {
+		if (attr->cb_size < sizeof(struct cv2_thread)) {
+			return NULL;
+		}
+	} else if (thread_num >= CONFIG_CMSIS_V2_THREAD_MAX_COUNT) {
+		return NULL;
+	}
+
 	if (attr->priority == osPriorityNone) {
 		cv2_prio = osPriorityNormal;
 	} else {
@@ -158,9 +162,13 @@ osThreadId_t osThreadNew(osThreadFunc_t threadfunc, void *arg,
 
 	prio = cmsis_to_zephyr_priority(cv2_prio);
 
-	this_thread_num = atomic_inc((atomic_t *)&thread_num);
+	if (attr->cb_mem != NULL) {
+		tid = (struct cv2_thread *)attr->cb_mem;
+	} else {
+		this_thread_num = atomic_inc((atomic_t *)&thread_num);
+		tid = &cv2_thread_pool[this_thread_num];
+	}
 
-	tid = &cv2_thread_pool[this_thread_num];
 	tid->attr_bits = attr->attr_bits;
 
 	if (attr->stack_mem == NULL) {
@@ -186,7 +194,12 @@ osThreadId_t osThreadNew(osThreadFunc_t threadfunc, void *arg,
 		one_time = 1U;
 	}
 
-	sys_dlist_append(&thread_list, &tid->node);
+	/* A caller supplied control block may be reused once its thread
+	 * terminated, it is still on the list then.
+	 */
+	if (is_cmsis_rtos_v2_thread(tid) == NULL) {
+		sys_dlist_append(&thread_list, &tid->node);
+	}
 
 	k_sem_init(&tid->join_guard, 0, 1);
 	tid->has_joined = FALSE;
@@ -50,12 +50,19 @@ osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type,
 		attr = &init_timer_attrs;
 	}
 
-	if (k_mem_slab_alloc(&cv2_timer_slab, (void **)&timer, 100) == 0) {
-		(void)memset(timer, 0, sizeof(struct cv2_timer));
-	} else {
+	if (attr->cb_mem != NULL) {
+		if (attr->cb_size < sizeof(struct cv2_timer)) {
+			return NULL;
+		}
+		timer = (struct cv2_timer *)attr->cb_mem;
+	} else if (k_mem_slab_alloc(&cv2_timer_slab, (void **)&timer,
+				    100) != 0) {
 		return NULL;
 	}
 
+	(void)memset(timer, 0, sizeof(struct cv2_timer));
+	timer->is_cb_dynamic_allocation = (attr->cb_mem == NULL);
+
 	timer->callback_function = func;
 	timer->arg = argument;
 	timer->type = type;
@@ -143,7 +150,9 @@ osStatus_t osTimerDelete(osTimerId_t timer_id)
 		timer->status = NOT_ACTIVE;
 	}
 
-	k_mem_slab_free(&cv2_timer_slab, (void *) &timer);
+	if (timer->is_cb_dynamic_allocation) {
+		k_mem_slab_free(&cv2_timer_slab, (void *)&timer);
+	}
 	return osOK;
 }
 
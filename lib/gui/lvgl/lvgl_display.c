@@ -4,8 +4,52 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr.h>
 #include "lvgl_display.h"
 
+#ifdef CONFIG_LVGL_FLUSH_THREAD
+struct lvgl_flush {
+	struct _disp_drv_t *disp_drv;
+	lv_area_t area;
+	lv_color_t *color_p;
+};
+
+/* LVGL does not flush again before the previous flush is ready. */
+K_MSGQ_DEFINE(lvgl_flush_msgq, sizeof(struct lvgl_flush), 1, 4);
+
+static void (*lvgl_flush_cb_display)(struct _disp_drv_t *disp_drv,
+		const lv_area_t *area, lv_color_t *color_p);
+
+static void lvgl_flush_cb_thread(struct _disp_drv_t *disp_drv,
+		const lv_area_t *area, lv_color_t *color_p)
+{
+	struct lvgl_flush flush = {
+		.disp_drv = disp_drv,
+		.area = *area,
+		.color_p = color_p,
+	};
+
+	k_msgq_put(&lvgl_flush_msgq, &flush, K_FOREVER);
+}
+
+static void lvgl_flush_thread(void)
+{
+	struct lvgl_flush flush;
+
+	while (true) {
+		k_msgq_get(&lvgl_flush_msgq, &flush, K_FOREVER);
+
+		/* Calls lv_disp_flush_ready() once written */
+		lvgl_flush_cb_display(flush.disp_drv, &flush.area,
+				      flush.color_p);
+	}
+}
+
+K_THREAD_DEFINE(lvgl_flush, CONFIG_LVGL_FLUSH_THREAD_STACK_SIZE,
+		lvgl_flush_thread, NULL, NULL, NULL,
+		CONFIG_LVGL_FLUSH_THREAD_PRIO, 0, K_NO_WAIT);
+#endif /* CONFIG_LVGL_FLUSH_THREAD */
+
 int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv)
 {
 	int err = 0;
@@ -53,5 +97,12 @@ int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv)
 
 	}
 
+#ifdef CONFIG_LVGL_FLUSH_THREAD
+	if (err == 0) {
+		lvgl_flush_cb_display = disp_drv->flush_cb;
+		disp_drv->flush_cb = lvgl_flush_cb_thread;
+	}
+#endif
+
 	return err;
 }
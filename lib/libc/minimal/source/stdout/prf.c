@@ -42,13 +42,21 @@ static void _uc(char *buf)
  */
 static int _to_x(char *buf, unsigned VALTYPE n, unsigned int base)
 {
+	/* Hex and octal digits are taken with shifts, not divisions */
+	unsigned int shift = (base == 16U) ? 4U : (base == 8U) ? 3U : 0U;
 	char *start = buf;
 	int len;
 
 	do {
-		unsigned int d = n % base;
+		unsigned int d;
 
-		n /= base;
+		if (shift) {
+			d = n & (base - 1U);
+			n >>= shift;
+		} else {
+			d = n % base;
+			n /= base;
+		}
 		*buf++ = '0' + d + (d > 9 ? ('a' - '0' - 10) : 0);
 	} while (n);
 
@@ -99,7 +107,13 @@ static int _to_octal(char *buf, unsigned VALTYPE value, bool alt_form)
 
 static int _to_udec(char *buf, unsigned VALTYPE value)
 {
-	return _to_x(buf, value, 10);
+#ifdef CONFIG_MINIMAL_LIBC_LL_PRINTF
+	if (value > ULONG_MAX) {
+		return _to_x(buf, value, 10);
+	}
+#endif
+
+	return ul_to_dec(buf, value);
 }
 
 static int _to_dec(char *buf, VALTYPE value, bool fplus, bool fspace)
@@ -8,8 +8,29 @@
 
 #include <string.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <sys/types.h>
 
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+/*
+ * Word-at-a-time helpers. Aligned words never straddle a page or an MPU
+ * region, so reading the whole word holding the last byte of a string is
+ * harmless. Accesses go through a may_alias type, the words overlay
+ * buffers of any type.
+ */
+typedef mem_word_t __attribute__((__may_alias__)) word_t;
+
+#define WORD_SIZE	sizeof(mem_word_t)
+#define WORD_MASK	(WORD_SIZE - 1)
+#define WORD_ONES	((mem_word_t)-1 / 0xFF)
+#define WORD_HIGHS	(WORD_ONES * 0x80)
+
+/* Non zero if any byte of the word is zero */
+#define HAS_ZERO(w)	(((w) - WORD_ONES) & ~(w) & WORD_HIGHS)
+
+#define IS_ALIGNED_PTR(p)	((((uintptr_t)(p)) & WORD_MASK) == 0)
+#endif /* CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS */
+
 /**
  *
  * @brief Copy a string
@@ -70,6 +91,25 @@ char *strchr(const char *s, int c)
 {
 	char tmp = (char) c;
 
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+	mem_word_t c_word = WORD_ONES * (unsigned char)c;
+	const word_t *w;
+
+	while (!IS_ALIGNED_PTR(s)) {
+		if ((*s == tmp) || (*s == '\0')) {
+			return (*s == tmp) ? (char *) s : NULL;
+		}
+		s++;
+	}
+
+	/* Skip the words holding neither the byte nor the terminator */
+	w = (const word_t *)s;
+	while (!HAS_ZERO(*w) && !HAS_ZERO(*w ^ c_word)) {
+		w++;
+	}
+	s = (const char *)w;
+#endif
+
 	while ((*s != tmp) && (*s != '\0')) {
 		s++;
 	}
@@ -106,6 +146,29 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+	const char *start = s;
+	const word_t *w;
+
+	while (!IS_ALIGNED_PTR(s)) {
+		if (*s == '\0') {
+			return s - start;
+		}
+		s++;
+	}
+
+	w = (const word_t *)s;
+	while (!HAS_ZERO(*w)) {
+		w++;
+	}
+
+	s = (const char *)w;
+	while (*s != '\0') {
+		s++;
+	}
+
+	return s - start;
+#else
 	size_t n = 0;
 
 	while (*s != '\0') {
@@ -114,6 +177,7 @@ size_t strlen(const char *s)
 	}
 
 	return n;
+#endif
 }
 
 /**
@@ -144,6 +208,31 @@ size_t strnlen(const char *s, size_t maxlen)
 
 int strcmp(const char *s1, const char *s2)
 {
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+	if ((((uintptr_t)s1 ^ (uintptr_t)s2) & WORD_MASK) == 0) {
+		const word_t *w1, *w2;
+
+		while (!IS_ALIGNED_PTR(s1)) {
+			if ((*s1 != *s2) || (*s1 == '\0')) {
+				return *s1 - *s2;
+			}
+			s1++;
+			s2++;
+		}
+
+		/* Skip equal words without a terminator */
+		w1 = (const word_t *)s1;
+		w2 = (const word_t *)s2;
+		while ((*w1 == *w2) && !HAS_ZERO(*w1)) {
+			w1++;
+			w2++;
+		}
+
+		s1 = (const char *)w1;
+		s2 = (const char *)w2;
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -206,6 +295,31 @@ int memcmp(const void *m1, const void *m2, size_t n)
 		return 0;
 	}
 
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+	if ((((uintptr_t)c1 ^ (uintptr_t)c2) & WORD_MASK) == 0) {
+		while (!IS_ALIGNED_PTR(c1)) {
+			if (*c1 != *c2) {
+				return *c1 - *c2;
+			}
+			if (--n == 0) {
+				return 0;
+			}
+			c1++;
+			c2++;
+		}
+
+		/* Skip equal words, the bytes of the first different one
+		 * are compared below
+		 */
+		while ((n > WORD_SIZE) &&
+		       (*(const word_t *)c1 == *(const word_t *)c2)) {
+			c1 += WORD_SIZE;
+			c2 += WORD_SIZE;
+			n -= WORD_SIZE;
+		}
+	}
+#endif
+
 	while ((--n > 0) && (*c1 == *c2)) {
 		c1++;
 		c2++;
@@ -281,6 +395,28 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 		mem_word_t *d_word = (mem_word_t *)d_byte;
 		const mem_word_t *s_word = (const mem_word_t *)s_byte;
 
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+		/* do 4 words per iteration, as load/store multiple on ARM */
+
+		while (n >= 4 * sizeof(mem_word_t)) {
+#if defined(CONFIG_ARM) && !defined(CONFIG_64BIT)
+			__asm__ volatile("ldmia %1!, {r3-r6}\n\t"
+					 "stmia %0!, {r3-r6}"
+					 : "+l" (d_word), "+l" (s_word)
+					 :
+					 : "r3", "r4", "r5", "r6", "memory");
+#else
+			d_word[0] = s_word[0];
+			d_word[1] = s_word[1];
+			d_word[2] = s_word[2];
+			d_word[3] = s_word[3];
+			d_word += 4;
+			s_word += 4;
+#endif
+			n -= 4 * sizeof(mem_word_t);
+		}
+#endif
+
 		while (n >= sizeof(mem_word_t)) {
 			*(d_word++) = *(s_word++);
 			n -= sizeof(mem_word_t);
@@ -289,6 +425,45 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 		d_byte = (unsigned char *)d_word;
 		s_byte = (unsigned char *)s_word;
 	}
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+	else if (n >= 2 * WORD_SIZE) {
+		/*
+		 * Different alignments: store aligned words, each merged
+		 * from the two aligned source words it straddles.
+		 */
+		unsigned int shift;
+		const word_t *s_word;
+		word_t *d_word;
+		mem_word_t w0, w1;
+
+		while (!IS_ALIGNED_PTR(d_byte)) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		shift = ((uintptr_t)s_byte & WORD_MASK) * 8U;
+		s_word = (const word_t *)((uintptr_t)s_byte & ~WORD_MASK);
+		d_word = (word_t *)d_byte;
+		w0 = *(s_word++);
+
+		while (n >= WORD_SIZE) {
+			w1 = *(s_word++);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			*(d_word++) = (w0 >> shift) |
+				      (w1 << (Z_MEM_WORD_T_WIDTH - shift));
+#else
+			*(d_word++) = (w0 << shift) |
+				      (w1 >> (Z_MEM_WORD_T_WIDTH - shift));
+#endif
+			w0 = w1;
+			n -= WORD_SIZE;
+		}
+
+		d_byte = (unsigned char *)d_word;
+		s_byte = (const unsigned char *)s_word - WORD_SIZE +
+			 shift / 8U;
+	}
+#endif
 
 	/* do byte-sized copying until finished */
 
@@ -333,6 +508,17 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+#ifdef CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+#endif
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <errno.h>
+#include <string.h>
 #include <sys/base64.h>
 
 static const u8_t base64_enc_map[64] = {
@@ -36,6 +37,16 @@ static const u8_t base64_enc_map[64] = {
 	'8', '9', '+', '/'
 };
 
+static const u8_t base64url_enc_map[64] = {
+	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J',
+	'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T',
+	'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd',
+	'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
+	'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x',
+	'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7',
+	'8', '9', '-', '_'
+};
+
 static const u8_t base64_dec_map[128] = {
 	127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
 	127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
@@ -215,3 +226,291 @@ int base64_decode(u8_t *dst, size_t dlen, size_t *olen, const u8_t *src,
 	return 0;
 }
 
+/*
+ * Encode n whole groups of 3 bytes, one 24 bit word at a time
+ */
+static u8_t *encode_groups(const u8_t *map, u8_t *p, const u8_t *src,
+			   size_t n)
+{
+	while (n--) {
+		u32_t x = ((u32_t)src[0] << 16) | ((u32_t)src[1] << 8) |
+			  src[2];
+
+		p[0] = map[x >> 18];
+		p[1] = map[(x >> 12) & 0x3F];
+		p[2] = map[(x >> 6) & 0x3F];
+		p[3] = map[x & 0x3F];
+		p += 4;
+		src += 3;
+	}
+
+	return p;
+}
+
+/*
+ * Encode the last 1 or 2 bytes, padded with '=' unless pad is false
+ */
+static u8_t *encode_tail(const u8_t *map, u8_t *p, const u8_t *src,
+			 size_t n, bool pad)
+{
+	u32_t x = (u32_t)src[0] << 16;
+
+	if (n > 1) {
+		x |= (u32_t)src[1] << 8;
+	}
+
+	*p++ = map[x >> 18];
+	*p++ = map[(x >> 12) & 0x3F];
+
+	if (n > 1) {
+		*p++ = map[(x >> 6) & 0x3F];
+	} else if (pad) {
+		*p++ = '=';
+	}
+
+	if (pad) {
+		*p++ = '=';
+	}
+
+	return p;
+}
+
+int base64url_encode(u8_t *dst, size_t dlen, size_t *olen, const u8_t *src,
+		     size_t slen)
+{
+	size_t n;
+	u8_t *p;
+
+	n = slen / 3;
+	if (n > (BASE64_SIZE_T_MAX - 4) / 4) {
+		*olen = BASE64_SIZE_T_MAX;
+		return -ENOMEM;
+	}
+
+	/* Trailing bytes take one character more than their number */
+	n = 4 * n + ((slen % 3) ? (slen % 3) + 1 : 0);
+
+	if ((dlen < n + 1) || (!dst)) {
+		*olen = n + 1;
+		return -ENOMEM;
+	}
+
+	p = encode_groups(base64url_enc_map, dst, src, slen / 3);
+	if (slen % 3) {
+		p = encode_tail(base64url_enc_map, p, src + slen - slen % 3,
+				slen % 3, false);
+	}
+
+	*olen = p - dst;
+	*p = 0U;
+
+	return 0;
+}
+
+int base64url_decode(u8_t *dst, size_t dlen, size_t *olen, const u8_t *src,
+		     size_t slen)
+{
+	struct base64_stream stream;
+	size_t n;
+	int rc;
+
+	base64_stream_init(&stream, true);
+
+	rc = base64_decode_update(&stream, dst, dlen, &n, src, slen);
+	if (rc == 0) {
+		rc = base64_decode_finish(&stream);
+	}
+
+	*olen = n;
+
+	return rc;
+}
+
+void base64_stream_init(struct base64_stream *stream, bool url)
+{
+	stream->acc = 0U;
+	stream->bits = 0U;
+	stream->count = 0U;
+	stream->pad = 0U;
+	stream->url = url;
+}
+
+int base64_encode_update(struct base64_stream *stream, u8_t *dst,
+			 size_t dlen, size_t *olen, const u8_t *src,
+			 size_t slen)
+{
+	const u8_t *map = stream->url ? base64url_enc_map : base64_enc_map;
+	size_t pending = stream->count;
+	size_t n, groups;
+	u8_t *p = dst;
+
+	if (slen > BASE64_SIZE_T_MAX - pending) {
+		*olen = BASE64_SIZE_T_MAX;
+		return -ENOMEM;
+	}
+
+	groups = (pending + slen) / 3;
+	if (groups > BASE64_SIZE_T_MAX / 4) {
+		*olen = BASE64_SIZE_T_MAX;
+		return -ENOMEM;
+	}
+
+	if (dlen < groups * 4 || (groups && !dst)) {
+		*olen = groups * 4;
+		return -ENOMEM;
+	}
+
+	/* Complete the group left over by the previous call */
+	if (pending && groups) {
+		n = 3 - pending;
+		(void)memcpy(stream->buf + pending, src, n);
+		p = encode_groups(map, p, stream->buf, 1);
+		src += n;
+		slen -= n;
+		groups--;
+		pending = 0;
+	}
+
+	p = encode_groups(map, p, src, groups);
+	src += groups * 3;
+	slen -= groups * 3;
+
+	(void)memcpy(stream->buf + pending, src, slen);
+	stream->count = pending + slen;
+
+	*olen = p - dst;
+
+	return 0;
+}
+
+int base64_encode_finish(struct base64_stream *stream, u8_t *dst,
+			 size_t dlen, size_t *olen)
+{
+	const u8_t *map = stream->url ? base64url_enc_map : base64_enc_map;
+	size_t n = 0;
+
+	if (stream->count) {
+		n = stream->url ? stream->count + 1 : 4;
+	}
+
+	if (dlen < n || (n && !dst)) {
+		*olen = n;
+		return -ENOMEM;
+	}
+
+	if (n) {
+		encode_tail(map, dst, stream->buf, stream->count,
+			    !stream->url);
+	}
+
+	stream->count = 0U;
+	*olen = n;
+
+	return 0;
+}
+
+/*
+ * Value of a base64 symbol, 64 for the padding character or 127 if the
+ * character is not part of the alphabet
+ */
+static u8_t decode_symbol(const struct base64_stream *stream, u8_t c)
+{
+	if (stream->url) {
+		if (c == '-') {
+			return 62;
+		} else if (c == '_') {
+			return 63;
+		} else if (c == '+' || c == '/' || c == '=') {
+			return 127;
+		}
+	}
+
+	return (c > 127) ? 127 : base64_dec_map[c];
+}
+
+int base64_decode_update(struct base64_stream *stream, u8_t *dst,
+			 size_t dlen, size_t *olen, const u8_t *src,
+			 size_t slen)
+{
+	size_t i, symbols = 0;
+	u8_t count = stream->count;
+	u8_t pad = stream->pad;
+	u32_t acc = stream->acc;
+	u8_t bits = stream->bits;
+	u8_t *p = dst;
+	size_t n;
+
+	/* Validate the whole chunk before consuming any of it */
+	for (i = 0; i < slen; i++) {
+		u8_t x;
+
+		if (src[i] == ' ' || src[i] == '\r' || src[i] == '\n') {
+			continue;
+		}
+
+		x = decode_symbol(stream, src[i]);
+		if (x == 127U) {
+			return -EINVAL;
+		}
+
+		if (x == 64U) {
+			/* At most two, ending a group of four */
+			if (count < 2 || ++pad > 2) {
+				return -EINVAL;
+			}
+		} else if (pad) {
+			return -EINVAL;
+		} else {
+			symbols++;
+		}
+
+		count = (count + 1) & 3;
+	}
+
+	/* Bytes completed by this chunk, without risk of overflow */
+	n = 3 * (symbols >> 2) + ((6 * (symbols & 3) + bits) >> 3);
+
+	if (dlen < n || (n && !dst)) {
+		*olen = n;
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < slen; i++) {
+		u8_t x = decode_symbol(stream, src[i]);
+
+		if (x >= 64U) {
+			continue;
+		}
+
+		acc = (acc << 6) | x;
+		bits += 6;
+
+		if (bits >= 8) {
+			bits -= 8;
+			*p++ = acc >> bits;
+		}
+	}
+
+	stream->acc = acc & ((1U << bits) - 1);
+	stream->bits = bits;
+	stream->count = count;
+	stream->pad = pad;
+
+	*olen = p - dst;
+
+	return 0;
+}
+
+int base64_decode_finish(struct base64_stream *stream)
+{
+	int rc = 0;
+
+	/* Unpadded input may end one or two symbols short of a group */
+	if (stream->count == 1U || (stream->count && !stream->url)) {
+		rc = -EINVAL;
+	}
+
+	base64_stream_init(stream, stream->url);
+
+	return rc;
+}
@@ -5,12 +5,54 @@
  */
 
 #include <sys/crc.h>
+#include <sys/byteorder.h>
+
+#if defined(CONFIG_CRC32_IEEE_TABLE) || defined(CONFIG_CRC32_IEEE_SLICING_BY_8)
+#include "crc32_ieee_table.h"
+#endif
 
 u32_t crc32_ieee(const u8_t *data, size_t len)
 {
 	return crc32_ieee_update(0x0, data, len);
 }
 
+#if defined(CONFIG_CRC32_IEEE_SLICING_BY_8)
+u32_t crc32_ieee_update(u32_t crc, const u8_t *data, size_t len)
+{
+	const u32_t (*t)[256] = crc32_ieee_table;
+
+	crc = ~crc;
+
+	/* Fold 8 bytes at a time, each through its own table */
+	while (len >= 8) {
+		u32_t lo = crc ^ sys_get_le32(data);
+		u32_t hi = sys_get_le32(data + 4);
+
+		crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^
+		      t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+		      t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+		      t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+		data += 8;
+		len -= 8;
+	}
+
+	while (len--) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+	}
+
+	return (~crc);
+}
+#elif defined(CONFIG_CRC32_IEEE_TABLE)
+u32_t crc32_ieee_update(u32_t crc, const u8_t *data, size_t len)
+{
+	crc = ~crc;
+	for (size_t i = 0; i < len; i++) {
+		crc = (crc >> 8) ^ crc32_ieee_table[0][(crc ^ data[i]) & 0xff];
+	}
+
+	return (~crc);
+}
+#elif defined(CONFIG_CRC32_IEEE_BITWISE)
 u32_t crc32_ieee_update(u32_t crc, const u8_t *data, size_t len)
 {
 	crc = ~crc;
@@ -24,3 +66,4 @@ u32_t crc32_ieee_update(u32_t crc, const u8_t *data, size_t len)
 
 	return (~crc);
 }
+#endif
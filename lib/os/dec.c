@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/types.h>
+#include <sys/util.h>
+
+#define UL_MAX_DIGITS (sizeof(long) == 8 ? 20 : 10)
+
+static const char digit_pairs[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+u8_t ul_to_dec(char *buf, unsigned long value)
+{
+	unsigned long pow = 10UL;
+	u8_t len = 1U;
+	char *p;
+
+	/* Count the digits first, so they are written in place */
+	while (len < UL_MAX_DIGITS && value >= pow) {
+		len++;
+		pow *= 10UL;
+	}
+
+	p = buf + len;
+	*p = '\0';
+
+	while (value >= 100UL) {
+		unsigned int pair = (value % 100UL) * 2U;
+
+		value /= 100UL;
+		*--p = digit_pairs[pair + 1];
+		*--p = digit_pairs[pair];
+	}
+
+	if (value >= 10UL) {
+		*--p = digit_pairs[value * 2U + 1];
+		*--p = digit_pairs[value * 2U];
+	} else {
+		*--p = '0' + value;
+	}
+
+	return len;
+}
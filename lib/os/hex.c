@@ -39,17 +39,15 @@ int hex2char(u8_t x, char *c)
 
 size_t bin2hex(const u8_t *buf, size_t buflen, char *hex, size_t hexlen)
 {
+	static const char digits[16] = "0123456789abcdef";
+
 	if ((hexlen + 1) < buflen * 2) {
 		return 0;
 	}
 
 	for (size_t i = 0; i < buflen; i++) {
-		if (hex2char(buf[i] >> 4, &hex[2 * i]) < 0) {
-			return 0;
-		}
-		if (hex2char(buf[i] & 0xf, &hex[2 * i + 1]) < 0) {
-			return 0;
-		}
+		hex[2 * i] = digits[buf[i] >> 4];
+		hex[2 * i + 1] = digits[buf[i] & 0xf];
 	}
 
 	hex[2 * buflen] = '\0';
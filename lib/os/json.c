@@ -599,6 +599,345 @@ int json_obj_parse(char *payload, size_t len,
 	return obj_parse(&obj, descr, descr_len, val);
 }
 
+enum stream_state {
+	STREAM_TOKEN,
+	STREAM_STRING,
+	STREAM_ESCAPE,
+	STREAM_UNICODE,
+	STREAM_NUMBER,
+	STREAM_LITERAL,
+};
+
+enum stream_expect {
+	EXPECT_VALUE,
+	EXPECT_VALUE_OR_END,
+	EXPECT_KEY,
+	EXPECT_KEY_OR_END,
+	EXPECT_COLON,
+	EXPECT_COMMA_OR_END,
+	EXPECT_DONE,
+};
+
+static const char *stream_literal(enum json_tokens token)
+{
+	switch (token) {
+	case JSON_TOK_TRUE:
+		return "true";
+	case JSON_TOK_FALSE:
+		return "false";
+	default:
+		return "null";
+	}
+}
+
+static int stream_add(struct json_stream_parser *parser, char chr)
+{
+	/* Keep room for the terminating NUL */
+	if (parser->len + 1 >= parser->buf_size) {
+		return -ENOMEM;
+	}
+
+	parser->buf[parser->len++] = chr;
+
+	return 0;
+}
+
+static bool stream_in_object(struct json_stream_parser *parser)
+{
+	return parser->depth &&
+		(parser->objects & BIT(parser->depth - 1));
+}
+
+static bool stream_expects_value(struct json_stream_parser *parser)
+{
+	return parser->expect == EXPECT_VALUE ||
+		parser->expect == EXPECT_VALUE_OR_END;
+}
+
+static const char *stream_key(struct json_stream_parser *parser)
+{
+	return parser->key_len ? parser->buf : NULL;
+}
+
+static void stream_after_value(struct json_stream_parser *parser)
+{
+	parser->len = 0;
+	parser->key_len = 0;
+	parser->expect = parser->depth ? EXPECT_COMMA_OR_END : EXPECT_DONE;
+}
+
+static int stream_value(struct json_stream_parser *parser,
+			enum json_tokens token)
+{
+	char *value = parser->buf + parser->key_len;
+	int ret;
+
+	parser->buf[parser->len] = '\0';
+
+	ret = parser->cb(token, stream_key(parser), value,
+			 parser->len - parser->key_len, parser->data);
+
+	stream_after_value(parser);
+
+	return ret;
+}
+
+static int stream_string_end(struct json_stream_parser *parser)
+{
+	if (parser->expect == EXPECT_KEY ||
+	    parser->expect == EXPECT_KEY_OR_END) {
+		parser->buf[parser->len++] = '\0';
+		parser->key_len = parser->len;
+		parser->expect = EXPECT_COLON;
+
+		return 0;
+	}
+
+	return stream_value(parser, JSON_TOK_STRING);
+}
+
+static int stream_open(struct json_stream_parser *parser,
+		       enum json_tokens token)
+{
+	int ret;
+
+	if (!stream_expects_value(parser)) {
+		return -EINVAL;
+	}
+
+	if (parser->depth == JSON_STREAM_MAX_DEPTH) {
+		return -ENOSPC;
+	}
+
+	ret = parser->cb(token, stream_key(parser), NULL, 0, parser->data);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (token == JSON_TOK_OBJECT_START) {
+		parser->objects |= BIT(parser->depth);
+		parser->expect = EXPECT_KEY_OR_END;
+	} else {
+		parser->objects &= ~BIT(parser->depth);
+		parser->expect = EXPECT_VALUE_OR_END;
+	}
+
+	parser->depth++;
+	parser->len = 0;
+	parser->key_len = 0;
+
+	return 0;
+}
+
+static int stream_close(struct json_stream_parser *parser,
+			enum json_tokens token)
+{
+	bool object = token == JSON_TOK_OBJECT_END;
+
+	if (!parser->depth || stream_in_object(parser) != object) {
+		return -EINVAL;
+	}
+
+	if (parser->expect != EXPECT_COMMA_OR_END &&
+	    parser->expect != (object ? EXPECT_KEY_OR_END :
+			       EXPECT_VALUE_OR_END)) {
+		return -EINVAL;
+	}
+
+	parser->depth--;
+	stream_after_value(parser);
+
+	return parser->cb(token, NULL, NULL, 0, parser->data);
+}
+
+static int stream_token(struct json_stream_parser *parser, char chr)
+{
+	if (isspace((unsigned char)chr)) {
+		return 0;
+	}
+
+	switch (chr) {
+	case '{':
+	case '[':
+		return stream_open(parser, (enum json_tokens)chr);
+	case '}':
+	case ']':
+		return stream_close(parser, (enum json_tokens)chr);
+	case ',':
+		if (parser->expect != EXPECT_COMMA_OR_END) {
+			return -EINVAL;
+		}
+
+		parser->expect = stream_in_object(parser) ? EXPECT_KEY :
+			EXPECT_VALUE;
+		return 0;
+	case ':':
+		if (parser->expect != EXPECT_COLON) {
+			return -EINVAL;
+		}
+
+		parser->expect = EXPECT_VALUE;
+		return 0;
+	case '"':
+		if (!stream_expects_value(parser) &&
+		    parser->expect != EXPECT_KEY &&
+		    parser->expect != EXPECT_KEY_OR_END) {
+			return -EINVAL;
+		}
+
+		parser->state = STREAM_STRING;
+		return 0;
+	case 't':
+	case 'f':
+	case 'n':
+		if (!stream_expects_value(parser)) {
+			return -EINVAL;
+		}
+
+		parser->state = STREAM_LITERAL;
+		parser->token = chr;
+		parser->aux = 1U;
+		return stream_add(parser, chr);
+	default:
+		if (chr != '-' && !isdigit((unsigned char)chr)) {
+			return -EINVAL;
+		}
+
+		if (!stream_expects_value(parser)) {
+			return -EINVAL;
+		}
+
+		parser->state = STREAM_NUMBER;
+		return stream_add(parser, chr);
+	}
+}
+
+static int stream_char(struct json_stream_parser *parser, char chr)
+{
+	const char *literal;
+	int ret;
+
+	switch (parser->state) {
+	case STREAM_STRING:
+		if (chr == '"') {
+			parser->state = STREAM_TOKEN;
+			return stream_string_end(parser);
+		}
+
+		if (chr == '\\') {
+			parser->state = STREAM_ESCAPE;
+		} else if ((unsigned char)chr < ' ') {
+			return -EINVAL;
+		}
+
+		return stream_add(parser, chr);
+	case STREAM_ESCAPE:
+		if (chr == 'u') {
+			parser->state = STREAM_UNICODE;
+			parser->aux = 4U;
+		} else if (chr && strchr("\"\\/bfnrt", chr)) {
+			parser->state = STREAM_STRING;
+		} else {
+			return -EINVAL;
+		}
+
+		return stream_add(parser, chr);
+	case STREAM_UNICODE:
+		if (!isxdigit((unsigned char)chr)) {
+			return -EINVAL;
+		}
+
+		if (--parser->aux == 0U) {
+			parser->state = STREAM_STRING;
+		}
+
+		return stream_add(parser, chr);
+	case STREAM_LITERAL:
+		literal = stream_literal(parser->token);
+		if (chr != literal[parser->aux]) {
+			return -EINVAL;
+		}
+
+		ret = stream_add(parser, chr);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (literal[++parser->aux] == '\0') {
+			parser->state = STREAM_TOKEN;
+			return stream_value(parser, parser->token);
+		}
+
+		return 0;
+	case STREAM_NUMBER:
+		if (isdigit((unsigned char)chr) || chr == '.') {
+			return stream_add(parser, chr);
+		}
+
+		/* The number ends with the first other character, which
+		 * is then handled as the start of the next token.
+		 */
+		parser->state = STREAM_TOKEN;
+		ret = stream_value(parser, JSON_TOK_NUMBER);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* fallthrough */
+	default:
+		return stream_token(parser, chr);
+	}
+}
+
+void json_stream_parser_init(struct json_stream_parser *parser,
+			     char *buffer, size_t buf_size,
+			     json_stream_cb_t cb, void *data)
+{
+	(void)memset(parser, 0, sizeof(*parser));
+
+	parser->cb = cb;
+	parser->data = data;
+	parser->buf = buffer;
+	parser->buf_size = buf_size;
+	parser->state = STREAM_TOKEN;
+	parser->expect = EXPECT_VALUE;
+}
+
+int json_stream_parse(struct json_stream_parser *parser, const char *chunk,
+		      size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len && !parser->error; i++) {
+		parser->error = stream_char(parser, chunk[i]);
+	}
+
+	return parser->error;
+}
+
+int json_stream_parse_end(struct json_stream_parser *parser)
+{
+	if (parser->error) {
+		return parser->error;
+	}
+
+	/* A top-level number is only terminated by the end of input */
+	if (parser->state == STREAM_NUMBER) {
+		parser->state = STREAM_TOKEN;
+		parser->error = stream_value(parser, JSON_TOK_NUMBER);
+		if (parser->error) {
+			return parser->error;
+		}
+	}
+
+	if (parser->state != STREAM_TOKEN ||
+	    parser->expect != EXPECT_DONE) {
+		parser->error = -EINVAL;
+	}
+
+	return parser->error;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -625,22 +964,38 @@ static int json_escape_internal(const char *str,
 				json_append_bytes_t append_bytes,
 				void *data)
 {
-	const char *cur;
-	int ret = 0;
+	const char *cur, *run;
+	int ret;
 
-	for (cur = str; ret == 0 && *cur; cur++) {
+	/* Append runs of characters needing no escape at once */
+	for (cur = run = str; *cur; cur++) {
 		char escaped = escape_as(*cur);
+		char bytes[2] = { '\\', escaped };
 
-		if (escaped) {
-			char bytes[2] = { '\\', escaped };
+		if (!escaped) {
+			continue;
+		}
 
-			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
+		if (cur > run) {
+			ret = append_bytes(run, cur - run, data);
+			if (ret) {
+				return ret;
+			}
+		}
+
+		ret = append_bytes(bytes, 2, data);
+		if (ret) {
+			return ret;
 		}
+
+		run = cur + 1;
 	}
 
-	return ret;
+	if (cur > run) {
+		return append_bytes(run, cur - run, data);
+	}
+
+	return 0;
 }
 
 size_t json_calc_escaped_len(const char *str, size_t len)
@@ -919,3 +1274,64 @@ ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+struct stream_appender {
+	char *buffer;
+	size_t used;
+	size_t size;
+	json_append_bytes_t flush;
+	void *data;
+};
+
+static int append_bytes_to_stream(const char *bytes, size_t len, void *data)
+{
+	struct stream_appender *appender = data;
+	size_t chunk;
+	int ret;
+
+	while (len) {
+		if (appender->used == appender->size) {
+			ret = appender->flush(appender->buffer, appender->used,
+					      appender->data);
+			if (ret < 0) {
+				return ret;
+			}
+
+			appender->used = 0;
+		}
+
+		chunk = MIN(len, appender->size - appender->used);
+		memcpy(appender->buffer + appender->used, bytes, chunk);
+		appender->used += chunk;
+		bytes += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+int json_obj_encode_stream(const struct json_obj_descr *descr,
+			   size_t descr_len, const void *val,
+			   char *buffer, size_t buf_size,
+			   json_append_bytes_t flush, void *data)
+{
+	struct stream_appender appender = {
+		.buffer = buffer,
+		.size = buf_size,
+		.flush = flush,
+		.data = data,
+	};
+	int ret;
+
+	if (!buf_size) {
+		return -EINVAL;
+	}
+
+	ret = json_obj_encode(descr, descr_len, val, append_bytes_to_stream,
+			      &appender);
+	if (ret < 0 || !appender.used) {
+		return ret;
+	}
+
+	return flush(appender.buffer, appender.used, data);
+}
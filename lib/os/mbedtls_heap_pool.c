@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fixed size block allocator for mbed TLS.
+ *
+ * A TLS handshake mostly allocates bignum limbs and ASN.1 structures of a
+ * few sizes, and one input and one output record buffer per context. Each
+ * of them is served from a memory slab of the matching block size, which
+ * takes constant time and cannot fragment. The rare allocations larger
+ * than a medium block, other than record buffers, come from a small buddy
+ * pool.
+ */
+
+#include <init.h>
+#include <kernel.h>
+#include <string.h>
+#include <sys/mbedtls_heap_pool.h>
+
+#if !defined(CONFIG_MBEDTLS_CFG_FILE)
+#include "mbedtls/config.h"
+#else
+#include CONFIG_MBEDTLS_CFG_FILE
+#endif /* CONFIG_MBEDTLS_CFG_FILE */
+
+#include <mbedtls/platform.h>
+
+#if !defined(MBEDTLS_PLATFORM_MEMORY)
+#error "The mbed TLS heap pool requires MBEDTLS_PLATFORM_MEMORY"
+#endif
+
+#define RECORD_SIZE ROUND_UP(CONFIG_MBEDTLS_SSL_MAX_CONTENT_LEN + \
+			     CONFIG_MBEDTLS_HEAP_POOL_RECORD_OVERHEAD, 4)
+
+/* Large allocations keep their size in front of the user data */
+#define LARGE_HDR_SIZE 8
+
+K_MEM_SLAB_DEFINE(mbedtls_small_slab, CONFIG_MBEDTLS_HEAP_POOL_SMALL_SIZE,
+		  CONFIG_MBEDTLS_HEAP_POOL_SMALL_COUNT, 4);
+K_MEM_SLAB_DEFINE(mbedtls_medium_slab, CONFIG_MBEDTLS_HEAP_POOL_MEDIUM_SIZE,
+		  CONFIG_MBEDTLS_HEAP_POOL_MEDIUM_COUNT, 4);
+K_MEM_SLAB_DEFINE(mbedtls_record_slab, RECORD_SIZE,
+		  CONFIG_MBEDTLS_HEAP_POOL_RECORD_COUNT, 4);
+K_MEM_POOL_DEFINE(mbedtls_large_pool, 64, CONFIG_MBEDTLS_HEAP_POOL_LARGE_SIZE,
+		  CONFIG_MBEDTLS_HEAP_POOL_LARGE_COUNT, 8);
+
+/* In increasing block size order */
+static struct k_mem_slab *const slabs[] = {
+	[MBEDTLS_HEAP_POOL_SMALL] = &mbedtls_small_slab,
+	[MBEDTLS_HEAP_POOL_MEDIUM] = &mbedtls_medium_slab,
+	[MBEDTLS_HEAP_POOL_RECORD] = &mbedtls_record_slab,
+};
+
+static struct mbedtls_heap_pool_stats stats;
+
+static void stats_alloc(enum mbedtls_heap_pool_class cls, size_t size)
+{
+	unsigned int key = irq_lock();
+
+	stats.used[cls]++;
+	stats.peak[cls] = MAX(stats.peak[cls], stats.used[cls]);
+	stats.cur_bytes += size;
+	stats.peak_bytes = MAX(stats.peak_bytes, stats.cur_bytes);
+
+	irq_unlock(key);
+}
+
+static void stats_free(enum mbedtls_heap_pool_class cls, size_t size)
+{
+	unsigned int key = irq_lock();
+
+	stats.used[cls]--;
+	stats.cur_bytes -= size;
+
+	irq_unlock(key);
+}
+
+static void *large_alloc(size_t size)
+{
+	u8_t *mem;
+
+	if (size > SIZE_MAX - LARGE_HDR_SIZE) {
+		return NULL;
+	}
+
+	size += LARGE_HDR_SIZE;
+	mem = k_mem_pool_malloc(&mbedtls_large_pool, size);
+	if (!mem) {
+		return NULL;
+	}
+
+	*(size_t *)mem = size;
+	stats_alloc(MBEDTLS_HEAP_POOL_LARGE, size);
+
+	return mem + LARGE_HDR_SIZE;
+}
+
+static void large_free(u8_t *ptr)
+{
+	u8_t *mem = ptr - LARGE_HDR_SIZE;
+
+	stats_free(MBEDTLS_HEAP_POOL_LARGE, *(size_t *)mem);
+	k_free(mem);
+}
+
+static bool slab_owns(struct k_mem_slab *slab, void *ptr)
+{
+	char *p = ptr;
+
+	return p >= slab->buffer &&
+	       p < slab->buffer + slab->block_size * slab->num_blocks;
+}
+
+static void *heap_pool_calloc(size_t n, size_t size)
+{
+	void *ptr = NULL;
+	size_t total;
+	int i;
+
+	if (size && n > SIZE_MAX / size) {
+		goto out;
+	}
+
+	total = n * size;
+	if (total == 0) {
+		return NULL;
+	}
+
+	/* The smallest class that fits, or a larger one when it is full */
+	for (i = 0; i < ARRAY_SIZE(slabs); i++) {
+		if (total > slabs[i]->block_size) {
+			continue;
+		}
+
+		if (k_mem_slab_alloc(slabs[i], &ptr, K_NO_WAIT) == 0) {
+			stats_alloc(i, slabs[i]->block_size);
+			break;
+		}
+	}
+
+	if (!ptr) {
+		ptr = large_alloc(total);
+	}
+
+	if (ptr) {
+		(void)memset(ptr, 0, total);
+	}
+
+out:
+	if (!ptr) {
+		unsigned int key = irq_lock();
+
+		stats.failed++;
+		irq_unlock(key);
+	}
+
+	return ptr;
+}
+
+static void heap_pool_free(void *ptr)
+{
+	int i;
+
+	if (!ptr) {
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(slabs); i++) {
+		if (slab_owns(slabs[i], ptr)) {
+			stats_free(i, slabs[i]->block_size);
+			k_mem_slab_free(slabs[i], &ptr);
+			return;
+		}
+	}
+
+	large_free(ptr);
+}
+
+void mbedtls_heap_pool_stats_get(struct mbedtls_heap_pool_stats *out)
+{
+	unsigned int key = irq_lock();
+
+	*out = stats;
+
+	irq_unlock(key);
+}
+
+void mbedtls_heap_pool_peak_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	(void)memcpy(stats.peak, stats.used, sizeof(stats.peak));
+	stats.peak_bytes = stats.cur_bytes;
+
+	irq_unlock(key);
+}
+
+static int mbedtls_heap_pool_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return mbedtls_platform_set_calloc_free(heap_pool_calloc,
+						heap_pool_free);
+}
+
+/* After the mbed TLS heap set up, so the pool replaces it. */
+SYS_INIT(mbedtls_heap_pool_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -10,6 +10,8 @@
 #include <sys/mempool_base.h>
 #include <sys/mempool.h>
 
+#ifndef CONFIG_SYS_MEM_POOL_TLSF
+
 #ifdef CONFIG_MISRA_SANE
 #define LVL_ARRAY_SZ(n) (8 * sizeof(void *) / 2)
 #else
@@ -317,6 +319,30 @@ void z_sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
 	block_free(p, level, lsizes, block);
 }
 
+size_t z_sys_mem_pool_block_size(struct sys_mem_pool_base *p, u32_t level,
+				 u32_t block)
+{
+	size_t block_size = p->max_sz;
+
+	ARG_UNUSED(block);
+
+	for (int i = 1; i <= level; i++) {
+		block_size = WB_DN(block_size / 4);
+	}
+
+	return block_size;
+}
+
+int z_sys_mem_pool_block_grow(struct sys_mem_pool_base *p, u32_t level,
+			      u32_t block, size_t size)
+{
+	/* Buddy blocks never change size once allocated */
+	return z_sys_mem_pool_block_size(p, level, block) >= size ?
+		0 : -ENOMEM;
+}
+
+#endif /* !CONFIG_SYS_MEM_POOL_TLSF */
+
 /*
  * Functions specific to user-mode blocks
  */
@@ -367,25 +393,27 @@ void sys_mem_pool_free(void *ptr)
 size_t sys_mem_pool_try_expand_inplace(void *ptr, size_t requested_size)
 {
 	struct sys_mem_pool_block *blk;
+	struct sys_mem_pool *p;
 	size_t struct_blk_size = WB_UP(sizeof(struct sys_mem_pool_block));
-	size_t block_size, total_requested_size;
+	size_t block_size;
+	int ret;
 
 	ptr = (char *)ptr - struct_blk_size;
 	blk = (struct sys_mem_pool_block *)ptr;
+	p = blk->pool;
 
-	/*
-	 * Determine size of previously allocated block by its level.
-	 * Most likely a bit larger than the original allocation
+	/* We really need this much memory; the backend either already has
+	 * it in the (most likely a bit larger than requested) block, or
+	 * may be able to grow the block into its free neighbour.
 	 */
-	block_size = blk->pool->base.max_sz;
-	for (int i = 1; i <= blk->level; i++) {
-		block_size = WB_DN(block_size / 4);
-	}
-
-	/* We really need this much memory */
-	total_requested_size = requested_size + struct_blk_size;
+	sys_mutex_lock(&p->mutex, K_FOREVER);
+	ret = z_sys_mem_pool_block_grow(&p->base, blk->level, blk->block,
+					requested_size + struct_blk_size);
+	block_size = z_sys_mem_pool_block_size(&p->base, blk->level,
+					       blk->block);
+	sys_mutex_unlock(&p->mutex);
 
-	if (block_size >= total_requested_size) {
+	if (ret == 0) {
 		/* size adjustment can occur in-place */
 		return 0;
 	}
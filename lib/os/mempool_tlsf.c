@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two-level segregated fit backend for sys_mem_pool_base
+ *
+ * Free blocks are kept in Z_TLSF_SL segregated lists per power of two
+ * ("first level") size class.  Two levels of bitmaps make finding a
+ * list whose every block satisfies a request a pair of find-first-set
+ * operations, and physical neighbours are coalesced on free through the
+ * block headers, so both allocation and free run in constant time.
+ *
+ * The pool buffer starts with the control block (see
+ * Z_TLSF_CTL_SIZE()), followed by the arena, which ends with a zero
+ * sized, permanently allocated sentinel header.
+ *
+ * The level/block pair handed back to the pool front-ends is always
+ * level 0 and the offset of the block header in the buffer in units of
+ * Z_TLSF_ALIGN, which fits the block fields of both k_mem_block_id and
+ * sys_mem_pool_block for any realistic pool size.
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <sys/__assert.h>
+#include <sys/mempool_base.h>
+#include <sys/mempool.h>
+
+struct tlsf_block {
+	/* Physically preceding block, NULL for the first one */
+	struct tlsf_block *prev_phys;
+	/* Size of the whole block including this header, BLOCK_FREE flag */
+	size_t size;
+	/* Only valid while the block is free */
+	struct tlsf_block *next_free;
+	struct tlsf_block *prev_free;
+};
+
+struct tlsf_ctl {
+	u32_t fl_count;
+	u32_t fl_bitmap;
+	u32_t sl_bitmap[];
+};
+
+#define BLOCK_FREE	1U
+#define BLOCK_HDR	offsetof(struct tlsf_block, next_free)
+#define BLOCK_MIN	sizeof(struct tlsf_block)
+#define SMALL_SHIFT	(find_lsb_set(Z_TLSF_SMALL) - 1)
+
+BUILD_ASSERT(BLOCK_HDR == Z_TLSF_ALIGN);
+BUILD_ASSERT(Z_TLSF_SL <= 32);
+
+static inline int pool_irq_lock(struct sys_mem_pool_base *p)
+{
+	if (p->flags & SYS_MEM_POOL_KERNEL) {
+		return irq_lock();
+	} else {
+		return 0;
+	}
+}
+
+static inline void pool_irq_unlock(struct sys_mem_pool_base *p, int key)
+{
+	if (p->flags & SYS_MEM_POOL_KERNEL) {
+		irq_unlock(key);
+	}
+}
+
+static inline struct tlsf_ctl *pool_ctl(struct sys_mem_pool_base *p)
+{
+	return p->buf;
+}
+
+static inline struct tlsf_block **free_heads(struct tlsf_ctl *c)
+{
+	return (struct tlsf_block **)((u8_t *)c +
+		ROUND_UP(4 * (2 + c->fl_count), Z_TLSF_ALIGN));
+}
+
+static inline size_t block_size(struct tlsf_block *b)
+{
+	return b->size & ~(size_t)BLOCK_FREE;
+}
+
+static inline bool block_is_free(struct tlsf_block *b)
+{
+	return (b->size & BLOCK_FREE) != 0U;
+}
+
+static inline struct tlsf_block *block_next(struct tlsf_block *b)
+{
+	return (struct tlsf_block *)((u8_t *)b + block_size(b));
+}
+
+static inline struct tlsf_block *block_at(struct sys_mem_pool_base *p,
+					  u32_t block)
+{
+	return (struct tlsf_block *)((u8_t *)p->buf + block * Z_TLSF_ALIGN);
+}
+
+/* Size class a block of the given size is filed under */
+static void mapping_insert(size_t size, u32_t *fl, u32_t *sl)
+{
+	if (size < Z_TLSF_SMALL) {
+		*fl = 0U;
+		*sl = size / Z_TLSF_ALIGN;
+	} else {
+		u32_t msb = find_msb_set(size) - 1;
+
+		*fl = msb - SMALL_SHIFT + 1;
+		*sl = (size >> (msb - Z_TLSF_SL_BITS)) & (Z_TLSF_SL - 1);
+	}
+}
+
+/* Smallest size class all of whose blocks are at least size long;
+ * returns false if there is no such class in the pool
+ */
+static bool mapping_search(struct tlsf_ctl *c, size_t size, u32_t *fl,
+			   u32_t *sl)
+{
+	if (size >= Z_TLSF_SMALL) {
+		u32_t msb = find_msb_set(size) - 1;
+
+		size += (1U << (msb - Z_TLSF_SL_BITS)) - 1;
+	}
+
+	mapping_insert(size, fl, sl);
+
+	return *fl < c->fl_count;
+}
+
+static struct tlsf_block *find_suitable(struct tlsf_ctl *c, u32_t fl,
+					u32_t sl)
+{
+	u32_t sl_map = c->sl_bitmap[fl] & (~0U << sl);
+
+	if (sl_map == 0U) {
+		u32_t fl_map = fl + 1 < 32 ? c->fl_bitmap & (~0U << (fl + 1))
+					   : 0U;
+
+		if (fl_map == 0U) {
+			return NULL;
+		}
+
+		fl = find_lsb_set(fl_map) - 1;
+		sl_map = c->sl_bitmap[fl];
+	}
+
+	sl = find_lsb_set(sl_map) - 1;
+
+	return free_heads(c)[fl * Z_TLSF_SL + sl];
+}
+
+static void insert_free(struct tlsf_ctl *c, struct tlsf_block *b)
+{
+	struct tlsf_block **head;
+	u32_t fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+	head = &free_heads(c)[fl * Z_TLSF_SL + sl];
+
+	b->size |= BLOCK_FREE;
+	b->prev_free = NULL;
+	b->next_free = *head;
+	if (*head != NULL) {
+		(*head)->prev_free = b;
+	}
+	*head = b;
+
+	c->fl_bitmap |= BIT(fl);
+	c->sl_bitmap[fl] |= BIT(sl);
+}
+
+static void remove_free(struct tlsf_ctl *c, struct tlsf_block *b)
+{
+	struct tlsf_block **head;
+	u32_t fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+	head = &free_heads(c)[fl * Z_TLSF_SL + sl];
+
+	if (b->next_free != NULL) {
+		b->next_free->prev_free = b->prev_free;
+	}
+	if (b->prev_free != NULL) {
+		b->prev_free->next_free = b->next_free;
+	} else {
+		*head = b->next_free;
+		if (*head == NULL) {
+			c->sl_bitmap[fl] &= ~BIT(sl);
+			if (c->sl_bitmap[fl] == 0U) {
+				c->fl_bitmap &= ~BIT(fl);
+			}
+		}
+	}
+
+	b->size &= ~(size_t)BLOCK_FREE;
+}
+
+/* Split the allocated block b down to size bytes if the rest makes up a
+ * block of its own, which is then freed (merging it with a free
+ * physical successor, if any)
+ */
+static void block_trim(struct tlsf_ctl *c, struct tlsf_block *b, size_t size)
+{
+	struct tlsf_block *rest, *next;
+	size_t rest_size = block_size(b) - size;
+
+	if (rest_size < BLOCK_MIN) {
+		return;
+	}
+
+	next = block_next(b);
+	if (block_is_free(next)) {
+		remove_free(c, next);
+		rest_size += block_size(next);
+		next = block_next(next);
+	}
+
+	b->size = size;
+	rest = block_next(b);
+	rest->prev_phys = b;
+	rest->size = rest_size;
+	next->prev_phys = rest;
+	insert_free(c, rest);
+}
+
+/* Total block size needed to hand out size bytes of data */
+static size_t alloc_size(size_t size)
+{
+	size = ROUND_UP(size, Z_TLSF_ALIGN) + BLOCK_HDR;
+
+	return MAX(size, BLOCK_MIN);
+}
+
+void z_sys_mem_pool_base_init(struct sys_mem_pool_base *p)
+{
+	struct tlsf_ctl *c = pool_ctl(p);
+	u32_t fl_count = Z_TLSF_POOL_FL(p->max_sz, p->n_max);
+	size_t ctl_size = Z_TLSF_CTL_SIZE(fl_count);
+	size_t buflen = p->n_max * p->max_sz + _MPOOL_BITS_SIZE(p->max_sz,
+							0, p->n_max);
+	struct tlsf_block *first, *sentinel;
+
+	(void)memset(c, 0, ctl_size);
+	c->fl_count = fl_count;
+
+	first = (struct tlsf_block *)((u8_t *)p->buf + ctl_size);
+	first->prev_phys = NULL;
+	first->size = ROUND_DOWN(buflen - ctl_size - BLOCK_HDR,
+				 Z_TLSF_ALIGN);
+
+	sentinel = block_next(first);
+	sentinel->prev_phys = first;
+	sentinel->size = 0;
+
+	insert_free(c, first);
+}
+
+int z_sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
+			      u32_t *level_p, u32_t *block_p, void **data_p)
+{
+	struct tlsf_ctl *c = pool_ctl(p);
+	struct tlsf_block *b = NULL;
+	unsigned int key;
+	u32_t fl, sl;
+
+	if (size > p->n_max * p->max_sz) {
+		*data_p = NULL;
+		return -ENOMEM;
+	}
+
+	size = alloc_size(size);
+
+	key = pool_irq_lock(p);
+
+	if (mapping_search(c, size, &fl, &sl)) {
+		b = find_suitable(c, fl, sl);
+	}
+
+	/* Good fit failed: a block in the request's own class may still be
+	 * big enough, which matters when the pool is almost full.  Only its
+	 * first block is looked at to keep this constant time.
+	 */
+	if (b == NULL) {
+		mapping_insert(size, &fl, &sl);
+		if (fl < c->fl_count) {
+			b = free_heads(c)[fl * Z_TLSF_SL + sl];
+			if (b != NULL && block_size(b) < size) {
+				b = NULL;
+			}
+		}
+	}
+
+	if (b != NULL) {
+		remove_free(c, b);
+		block_trim(c, b, size);
+	}
+
+	pool_irq_unlock(p, key);
+
+	if (b == NULL) {
+		*data_p = NULL;
+		return -ENOMEM;
+	}
+
+	*level_p = 0U;
+	*block_p = ((u8_t *)b - (u8_t *)p->buf) / Z_TLSF_ALIGN;
+	*data_p = (u8_t *)b + BLOCK_HDR;
+
+	return 0;
+}
+
+void z_sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
+			      u32_t block)
+{
+	struct tlsf_ctl *c = pool_ctl(p);
+	struct tlsf_block *b = block_at(p, block);
+	struct tlsf_block *next, *prev;
+	unsigned int key;
+
+	ARG_UNUSED(level);
+
+	key = pool_irq_lock(p);
+
+	/* Detect common double-free occurrences */
+	__ASSERT(!block_is_free(b), "mempool double-free detected at %p",
+		 (u8_t *)b + BLOCK_HDR);
+
+	next = block_next(b);
+	if (block_is_free(next)) {
+		remove_free(c, next);
+		b->size += block_size(next);
+	}
+
+	prev = b->prev_phys;
+	if (prev != NULL && block_is_free(prev)) {
+		remove_free(c, prev);
+		prev->size += block_size(b);
+		b = prev;
+	}
+
+	block_next(b)->prev_phys = b;
+	insert_free(c, b);
+
+	pool_irq_unlock(p, key);
+}
+
+size_t z_sys_mem_pool_block_size(struct sys_mem_pool_base *p, u32_t level,
+				 u32_t block)
+{
+	ARG_UNUSED(level);
+
+	return block_size(block_at(p, block)) - BLOCK_HDR;
+}
+
+int z_sys_mem_pool_block_grow(struct sys_mem_pool_base *p, u32_t level,
+			      u32_t block, size_t size)
+{
+	struct tlsf_ctl *c = pool_ctl(p);
+	struct tlsf_block *b = block_at(p, block);
+	struct tlsf_block *next;
+	unsigned int key;
+	int ret = 0;
+
+	ARG_UNUSED(level);
+
+	if (size > p->n_max * p->max_sz) {
+		return -ENOMEM;
+	}
+
+	size = alloc_size(size);
+
+	key = pool_irq_lock(p);
+
+	if (block_size(b) < size) {
+		next = block_next(b);
+
+		if (block_is_free(next) &&
+		    block_size(b) + block_size(next) >= size) {
+			remove_free(c, next);
+			b->size += block_size(next);
+			block_next(b)->prev_phys = b;
+			block_trim(c, b, size);
+		} else {
+			ret = -ENOMEM;
+		}
+	}
+
+	pool_irq_unlock(p, key);
+
+	return ret;
+}
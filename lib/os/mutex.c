@@ -8,71 +8,500 @@
 #include <sys/mutex.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <string.h>
+#include <app_memory/app_memdomain.h>
 
-static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
+/*
+ * Slow paths of sys_mutex. Ownership is kept in the word of the k_futex
+ * embedded in each sys_mutex, and threads wait on the futex's wait queue.
+ * The kernel side updates the word under the futex lock, so that it
+ * agrees with the wait queue, while owners may still change it from user
+ * mode with atomic ops as long as the Z_SYS_MUTEX_WAITERS flag is clear.
+ * There is no hand over: a released mutex goes to whichever thread takes
+ * it first.
+ */
+
+BUILD_ASSERT(sizeof(atomic_val_t) == sizeof(struct k_thread *));
+
+#ifdef CONFIG_SYS_MUTEX_USER_FAST_PATH
+K_APP_BMEM(z_libc_partition) struct z_sys_mutex_thread z_sys_mutex_current;
+
+void z_sys_mutex_switch(struct k_thread *thread)
+{
+	z_sys_mutex_current.seq++;
+	z_sys_mutex_current.thread = thread;
+	z_sys_mutex_current.stack_start = thread->stack_info.start;
+	z_sys_mutex_current.local = thread->userspace_local_data;
+}
+
+void z_sys_mutex_forget(struct k_thread *thread)
+{
+	(void)memset(thread->userspace_local_data->sys_mutexes, 0,
+		     sizeof(thread->userspace_local_data->sys_mutexes));
+}
+
+/* Let the calling user thread lock and unlock the mutex from user mode
+ * from now on. The entries are only compared by the kernel, never
+ * dereferenced, as the thread may overwrite them.
+ */
+static void remember_mutex(struct sys_mutex *mutex)
+{
+	struct sys_mutex **cache = _current->userspace_local_data->sys_mutexes;
+	int i;
+
+	for (i = 0; i < CONFIG_SYS_MUTEX_USER_CACHE_SIZE - 1; i++) {
+		if (cache[i] == mutex) {
+			break;
+		}
+	}
+
+	/* Most recently used first, the last one is dropped */
+	(void)memmove(&cache[1], &cache[0], i * sizeof(cache[0]));
+	cache[0] = mutex;
+}
+
+static inline bool mutex_known(struct k_thread *thread,
+			       struct sys_mutex *mutex)
+{
+	struct sys_mutex **cache = thread->userspace_local_data->sys_mutexes;
+	int i;
+
+	for (i = 0; i < CONFIG_SYS_MUTEX_USER_CACHE_SIZE; i++) {
+		if (cache[i] == mutex) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
+static inline void remember_mutex(struct sys_mutex *mutex)
+{
+}
+
+static inline bool mutex_known(struct k_thread *thread,
+			       struct sys_mutex *mutex)
+{
+	return false;
+}
+#endif /* CONFIG_SYS_MUTEX_USER_FAST_PATH */
+
+static struct z_futex_data *get_futex_data(struct sys_mutex *mutex)
 {
 	struct _k_object *obj;
 
-	obj = z_object_find(mutex);
-	if (obj == NULL || obj->type != K_OBJ_SYS_MUTEX) {
+	obj = z_object_find(&mutex->futex);
+	if (obj == NULL || obj->type != K_OBJ_FUTEX) {
 		return NULL;
 	}
 
-	return (struct k_mutex *)obj->data;
+	return (struct z_futex_data *)obj->data;
 }
 
 static bool check_sys_mutex_addr(u32_t addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* We don't want threads using mutexes that are outside their memory
+	 * domain, in particular as the kernel updates the mutex word for
+	 * them
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+static inline struct k_thread *val_owner(atomic_val_t val)
+{
+	return (struct k_thread *)(val & ~Z_SYS_MUTEX_WAITERS);
+}
+
+/* Milliseconds left of a wait that started at start, K_NO_WAIT once over */
+static s32_t time_left(s32_t timeout, u32_t start)
+{
+	u32_t elapsed;
+
+	if (timeout == K_FOREVER) {
+		return K_FOREVER;
+	}
+
+	elapsed = k_uptime_get_32() - start;
+	return elapsed < (u32_t)timeout ? timeout - (s32_t)elapsed : K_NO_WAIT;
+}
+
+#ifdef CONFIG_SYS_MUTEX_PRIO_INHERIT
+static bool adjust_owner_prio(struct z_futex_data *data, s32_t new_prio)
+{
+	if (data->owner->base.prio != new_prio) {
+		return z_set_prio(data->owner, new_prio);
+	}
+	return false;
+}
+
+/* Raise the owner's priority to the waiter's. The owner is read from
+ * user memory, so it must be an actual thread, and a user waiter must
+ * either have access to that thread or the kernel must have seen the
+ * thread use this mutex.
+ */
+static bool inherit_prio(struct sys_mutex *mutex, struct z_futex_data *data,
+			 struct k_thread *owner)
+{
+	struct _k_object *obj = z_object_find(owner);
+	int new_prio;
+
+	if (obj == NULL || obj->type != K_OBJ_THREAD ||
+	    (obj->flags & K_OBJ_FLAG_INITIALIZED) == 0U) {
+		return false;
+	}
+
+	if ((_current->base.user_options & K_USER) != 0U &&
+	    z_object_validate(obj, K_OBJ_THREAD, _OBJ_INIT_TRUE) != 0 &&
+	    !mutex_known(owner, mutex)) {
+		return false;
+	}
+
+	if (data->owner != owner) {
+		data->owner = owner;
+		data->owner_orig_prio = owner->base.prio;
+	}
+
+	new_prio = z_is_prio_higher(_current->base.prio, owner->base.prio) ?
+		   _current->base.prio : owner->base.prio;
+	new_prio = z_get_new_prio_with_ceiling(new_prio);
+
+	if (z_is_prio_higher(new_prio, owner->base.prio)) {
+		return adjust_owner_prio(data, new_prio);
+	}
+	return false;
+}
+
+/* Drop the owner's priority to what is left to inherit from the
+ * remaining waiters
+ */
+static bool restore_prio(struct z_futex_data *data)
+{
+	struct k_thread *waiter = z_waitq_head(&data->wait_q);
+	int new_prio = data->owner_orig_prio;
+	bool resched;
+
+	if (data->owner == NULL) {
+		return false;
+	}
+
+	if (waiter != NULL && z_is_prio_higher(waiter->base.prio, new_prio)) {
+		new_prio = z_get_new_prio_with_ceiling(waiter->base.prio);
+	}
+
+	resched = adjust_owner_prio(data, new_prio);
+	if (waiter == NULL) {
+		data->owner = NULL;
+	}
+
+	return resched;
+}
+
+/* Give up what the releasing owner inherited */
+static bool release_prio(struct z_futex_data *data)
+{
+	bool resched = false;
+
+	if (data->owner == _current) {
+		resched = adjust_owner_prio(data, data->owner_orig_prio);
+	}
+	data->owner = NULL;
+
+	return resched;
+}
+#else
+static inline bool inherit_prio(struct sys_mutex *mutex,
+				struct z_futex_data *data,
+				struct k_thread *owner)
+{
+	return false;
+}
+
+static inline bool restore_prio(struct z_futex_data *data)
+{
+	return false;
+}
+
+static inline bool release_prio(struct z_futex_data *data)
+{
+	return false;
+}
+#endif /* CONFIG_SYS_MUTEX_PRIO_INHERIT */
+
+static int kernel_lock(struct sys_mutex *mutex, struct z_futex_data *data,
+		       s32_t timeout)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	bool waited = false, resched = false;
+	s32_t left = timeout;
+	u32_t start = 0U;
+	k_spinlock_key_t key;
+	atomic_val_t val;
+	int ret;
+
+	key = k_spin_lock(&data->lock);
+
+	for (;;) {
+		val = atomic_get(&mutex->futex.val);
+
+		if (val == 0) {
+			/* Threads left waiting keep the flag set, so that
+			 * the new owner wakes one of them when unlocking
+			 */
+			if (z_waitq_head(&data->wait_q) != NULL) {
+				self |= Z_SYS_MUTEX_WAITERS;
+			}
+			if (atomic_cas(&mutex->futex.val, 0, self)) {
+				mutex->lock_count = 1U;
+				ret = 0;
+				break;
+			}
+			self &= ~Z_SYS_MUTEX_WAITERS;
+			continue;
+		}
+
+		if (val_owner(val) == _current) {
+			mutex->lock_count++;
+			ret = 0;
+			break;
+		}
+
+		if (left == K_NO_WAIT && !waited) {
+			ret = -EBUSY;
+			break;
+		}
+
+		if ((val & Z_SYS_MUTEX_WAITERS) == 0 &&
+		    !atomic_cas(&mutex->futex.val, val,
+				val | Z_SYS_MUTEX_WAITERS)) {
+			continue;
+		}
+
+		/* Out of time after a wake up. The flag is set again, as the
+		 * thread that took the mutex may not know about the others.
+		 */
+		if (left == K_NO_WAIT) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		(void)inherit_prio(mutex, data, val_owner(val));
+
+		if (!waited) {
+			start = k_uptime_get_32();
+			waited = true;
+		}
+
+		ret = z_pend_curr(&data->lock, key, &data->wait_q, left);
+		key = k_spin_lock(&data->lock);
+		if (ret != 0) {
+			if (z_waitq_head(&data->wait_q) == NULL) {
+				(void)atomic_and(&mutex->futex.val,
+						 ~Z_SYS_MUTEX_WAITERS);
+			}
+			resched = restore_prio(data);
+			ret = -EAGAIN;
+			break;
+		}
+
+		/* Woken up by the owner releasing the mutex, compete for it
+		 * again
+		 */
+		left = time_left(timeout, start);
+	}
+
+	if (resched) {
+		z_reschedule(&data->lock, key);
+	} else {
+		k_spin_unlock(&data->lock, key);
+	}
+
+	return ret;
+}
+
+static int kernel_unlock(struct sys_mutex *mutex, struct z_futex_data *data)
+{
+	struct k_thread *waiter;
+	k_spinlock_key_t key;
+	atomic_val_t val;
+	bool resched;
+
+	key = k_spin_lock(&data->lock);
+
+	val = atomic_get(&mutex->futex.val);
+	if (val == 0) {
+		k_spin_unlock(&data->lock, key);
+		return -EINVAL;
+	}
+
+	if (val_owner(val) != _current) {
+		k_spin_unlock(&data->lock, key);
+		return -EPERM;
+	}
+
+	if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+		k_spin_unlock(&data->lock, key);
+		return 0;
+	}
+
+	mutex->lock_count = 0U;
+	resched = release_prio(data);
+	atomic_set(&mutex->futex.val, 0);
+
+	waiter = z_unpend_first_thread(&data->wait_q);
+	if (waiter != NULL) {
+		z_ready_thread(waiter);
+		z_set_thread_return_value(waiter, 0);
+		resched = true;
+	}
+
+	if (resched) {
+		z_reschedule(&data->lock, key);
+	} else {
+		k_spin_unlock(&data->lock, key);
+	}
+
+	return 0;
+}
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, s32_t timeout)
 {
-	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
+	struct z_futex_data *data = get_futex_data(mutex);
 
-	if (kernel_mutex == NULL) {
+	if (data == NULL) {
 		return -EINVAL;
 	}
 
-	return k_mutex_lock(kernel_mutex, timeout);
+	return kernel_lock(mutex, data, timeout);
 }
 
 Z_SYSCALL_HANDLER(z_sys_mutex_kernel_lock, mutex, timeout)
 {
+	struct z_futex_data *data;
+
 	if (check_sys_mutex_addr(mutex)) {
 		return -EACCES;
 	}
 
-	return z_impl_z_sys_mutex_kernel_lock((struct sys_mutex *)mutex,
-					      timeout);
+	data = get_futex_data((struct sys_mutex *)mutex);
+	if (data == NULL) {
+		return -EINVAL;
+	}
+
+	remember_mutex((struct sys_mutex *)mutex);
+
+	return kernel_lock((struct sys_mutex *)mutex, data, timeout);
 }
 
 int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
-	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
+	struct z_futex_data *data = get_futex_data(mutex);
 
-	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
+	if (data == NULL) {
 		return -EINVAL;
 	}
 
-	if (kernel_mutex->owner != _current) {
-		return -EPERM;
-	}
-
-	k_mutex_unlock(kernel_mutex);
-	return 0;
+	return kernel_unlock(mutex, data);
 }
 
 Z_SYSCALL_HANDLER(z_sys_mutex_kernel_unlock, mutex)
 {
+	struct z_futex_data *data;
+
 	if (check_sys_mutex_addr(mutex)) {
 		return -EACCES;
 	}
 
-	return z_impl_z_sys_mutex_kernel_unlock((struct sys_mutex *)mutex);
+	data = get_futex_data((struct sys_mutex *)mutex);
+	if (data == NULL) {
+		return -EINVAL;
+	}
+
+	remember_mutex((struct sys_mutex *)mutex);
+
+	return kernel_unlock((struct sys_mutex *)mutex, data);
 }
 
+/* Called from user mode if the mutex is locked by another thread.
+ * Priority inheritance needs the kernel to know about the waiter before
+ * it starts waiting, otherwise the futex is enough.
+ */
+int z_sys_mutex_lock_contended(struct sys_mutex *mutex,
+			       struct k_thread *self, s32_t timeout)
+{
+#ifdef CONFIG_SYS_MUTEX_PRIO_INHERIT
+	ARG_UNUSED(self);
+
+	return z_sys_mutex_kernel_lock(mutex, timeout);
+#else
+	atomic_val_t waiters = 0;
+	s32_t left = timeout;
+	u32_t start = 0U;
+	atomic_val_t val;
+	int ret;
+
+	for (;;) {
+		val = atomic_get(&mutex->futex.val);
+
+		if (val == 0) {
+			/* Once woken up, there is no telling whether other
+			 * threads still wait
+			 */
+			if (atomic_cas(&mutex->futex.val, 0,
+				       (atomic_val_t)self | waiters)) {
+				mutex->lock_count = 1U;
+				return 0;
+			}
+			continue;
+		}
+
+		if ((val & Z_SYS_MUTEX_WAITERS) == 0) {
+			if (!atomic_cas(&mutex->futex.val, val,
+					val | Z_SYS_MUTEX_WAITERS)) {
+				continue;
+			}
+			val |= Z_SYS_MUTEX_WAITERS;
+		}
+
+		/* As in kernel_lock(), only once the flag is set again */
+		if (left == K_NO_WAIT) {
+			return -EAGAIN;
+		}
+
+		if (waiters == 0) {
+			start = k_uptime_get_32();
+		}
+
+		ret = k_futex_wait(&mutex->futex, val, left);
+		if (ret == -ETIMEDOUT) {
+			return -EAGAIN;
+		} else if (ret != 0 && ret != -EAGAIN) {
+			return ret;
+		}
+
+		waiters = Z_SYS_MUTEX_WAITERS;
+		left = time_left(timeout, start);
+	}
+#endif
+}
+
+/* Called from user mode by the owner if threads may wait for the mutex,
+ * which the lock count is already cleared for
+ */
+int z_sys_mutex_unlock_contended(struct sys_mutex *mutex)
+{
+#ifdef CONFIG_SYS_MUTEX_PRIO_INHERIT
+	/* The kernel restores the inherited priority */
+	mutex->lock_count = 1U;
+	return z_sys_mutex_kernel_unlock(mutex);
+#else
+	int ret;
+
+	atomic_set(&mutex->futex.val, 0);
+
+	ret = k_futex_wake(&mutex->futex, false);
+	return ret < 0 ? ret : 0;
+#endif
+}
@@ -463,36 +463,23 @@ static void _printk_dec_ulong(out_func_t out, void *ctx,
 			      const unsigned long num, enum pad_type padding,
 			      int min_width)
 {
-	unsigned long pos = 1000000000;
-	unsigned long remainder = num;
-	int found_largest_digit = 0;
-	int remaining = sizeof(long) * 5 / 2;
-	int digits = 1;
-
-	if (sizeof(long) == 8) {
-		pos *= 10000000000;
-	}
-
-	/* make sure we don't skip if value is zero */
-	if (min_width <= 0) {
-		min_width = 1;
-	}
-
-	while (pos >= 10) {
-		if (found_largest_digit != 0 || remainder >= pos) {
-			found_largest_digit = 1;
-			out((int)(remainder / pos + 48), ctx);
-			digits++;
-		} else if (remaining <= min_width
-				&& padding < PAD_SPACE_AFTER) {
+	/* Padding before the number stops at the widest long */
+	int max_width = sizeof(long) * 5 / 2;
+	char buf[sizeof(long) * 5 / 2 + 1];
+	int digits = ul_to_dec(buf, num);
+	int remaining;
+	char *p = buf;
+
+	if (padding != PAD_SPACE_AFTER) {
+		remaining = MIN(min_width, max_width) - digits;
+		while (remaining-- > 0) {
 			out((int)(padding == PAD_ZERO_BEFORE ? '0' : ' '), ctx);
-			digits++;
 		}
-		remaining--;
-		remainder %= pos;
-		pos /= 10;
 	}
-	out((int)(remainder + 48), ctx);
+
+	while (*p) {
+		out((int)*p++, ctx);
+	}
 
 	if (padding == PAD_SPACE_AFTER) {
 		remaining = min_width - digits;
@@ -39,14 +39,15 @@ int ring_buf_item_put(struct ring_buf *buf, u16_t type, u8_t value,
 				index = (i + buf->tail + 1) & buf->mask;
 				buf->buf.buf32[index] = data[i];
 			}
-			buf->tail = (buf->tail + size32 + 1) & buf->mask;
+			index = (buf->tail + size32 + 1) & buf->mask;
 		} else {
 			for (i = 0U; i < size32; ++i) {
 				index = (i + buf->tail + 1) % buf->size;
 				buf->buf.buf32[index] = data[i];
 			}
-			buf->tail = (buf->tail + size32 + 1) % buf->size;
+			index = (buf->tail + size32 + 1) % buf->size;
 		}
+		z_ring_buf_index_set(&buf->tail, index);
 		rc = 0U;
 	} else {
 		buf->misc.item_mode.dropped_put_count++;
@@ -82,14 +83,15 @@ int ring_buf_item_get(struct ring_buf *buf, u16_t *type, u8_t *value,
 			index = (i + buf->head + 1) & buf->mask;
 			data[i] = buf->buf.buf32[index];
 		}
-		buf->head = (buf->head + header->length + 1) & buf->mask;
+		index = (buf->head + header->length + 1) & buf->mask;
 	} else {
 		for (i = 0U; i < header->length; ++i) {
 			index = (i + buf->head + 1) % buf->size;
 			data[i] = buf->buf.buf32[index];
 		}
-		buf->head = (buf->head + header->length + 1) % buf->size;
+		index = (buf->head + header->length + 1) % buf->size;
 	}
+	z_ring_buf_index_set(&buf->head, index);
 
 	return 0;
 }
@@ -110,7 +112,8 @@ u32_t ring_buf_put_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 {
 	u32_t space, trail_size, allocated;
 
-	space = z_ring_buf_custom_space_get(buf->size, buf->head,
+	space = z_ring_buf_custom_space_get(buf->size,
+					    z_ring_buf_index_get(&buf->head),
 					    buf->misc.byte_mode.tmp_tail);
 
 	/* Limit requested size to available size. */
@@ -133,8 +136,8 @@ int ring_buf_put_finish(struct ring_buf *buf, u32_t size)
 		return -EINVAL;
 	}
 
-	buf->tail = wrap(buf->tail + size, buf->size);
-	buf->misc.byte_mode.tmp_tail = buf->tail;
+	buf->misc.byte_mode.tmp_tail = wrap(buf->tail + size, buf->size);
+	z_ring_buf_index_set(&buf->tail, buf->misc.byte_mode.tmp_tail);
 
 	return 0;
 }
@@ -166,9 +169,9 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 
 	space = (buf->size - 1) -
 		z_ring_buf_custom_space_get(buf->size,
-					    buf->misc.byte_mode.tmp_head,
-					    buf->tail);
-	trail_size = buf->size - buf->misc.byte_mode.tmp_head;
+					    buf->tmp_head,
+					    z_ring_buf_index_get(&buf->tail));
+	trail_size = buf->size - buf->tmp_head;
 
 	/* Limit requested size to available size. */
 	granted_size = MIN(size, space);
@@ -176,9 +179,8 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 	/* Limit allocated size to trail size. */
 	granted_size = MIN(trail_size, granted_size);
 
-	*data = &buf->buf.buf8[buf->misc.byte_mode.tmp_head];
-	buf->misc.byte_mode.tmp_head =
-		wrap(buf->misc.byte_mode.tmp_head + granted_size, buf->size);
+	*data = &buf->buf.buf8[buf->tmp_head];
+	buf->tmp_head = wrap(buf->tmp_head + granted_size, buf->size);
 
 	return granted_size;
 }
@@ -191,8 +193,8 @@ int ring_buf_get_finish(struct ring_buf *buf, u32_t size)
 		return -EINVAL;
 	}
 
-	buf->head = wrap(buf->head + size, buf->size);
-	buf->misc.byte_mode.tmp_head = buf->head;
+	buf->tmp_head = wrap(buf->head + size, buf->size);
+	z_ring_buf_index_set(&buf->head, buf->tmp_head);
 
 	return 0;
 }
@@ -8,6 +8,41 @@
 #include <kernel.h>
 #define WORKQUEUE_THREAD_NAME	"workqueue"
 
+#ifdef CONFIG_WORKQUEUE_STATS
+/* Account for a work item about to be processed, returning how long it
+ * waited. Only called while the item is still pending, so it cannot be
+ * processed by another thread at the same time.
+ */
+static u32_t work_stats_start(struct k_work *work, u32_t now)
+{
+	u32_t wait = now - work->queued;
+
+	work->stats.count++;
+	work->stats.wait_max = MAX(work->stats.wait_max, wait);
+
+	return wait;
+}
+
+static void work_q_stats_update(struct k_work_q *work_q,
+				k_work_handler_t handler, u32_t wait,
+				u32_t start)
+{
+	u32_t run = k_cycle_get_32() - start;
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+	struct k_work_q_stats *stats = &work_q->stats;
+
+	stats->count++;
+	stats->wait_max = MAX(stats->wait_max, wait);
+	stats->run_total += run;
+	if (run > stats->run_max) {
+		stats->run_max = run;
+		stats->run_max_handler = handler;
+	}
+
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 void z_work_q_main(void *work_q_ptr, void *p2, void *p3)
 {
 	struct k_work_q *work_q = work_q_ptr;
@@ -18,6 +53,11 @@ void z_work_q_main(void *work_q_ptr, void *p2, void *p3)
 	while (true) {
 		struct k_work *work;
 		k_work_handler_t handler;
+#ifdef CONFIG_WORKQUEUE_STATS
+		/* The cycle counter may not be readable from user mode */
+		bool stats = !_is_user_context();
+		u32_t start = 0U, wait = 0U;
+#endif
 
 		work = k_queue_get(&work_q->queue, K_FOREVER);
 		if (work == NULL) {
@@ -26,10 +66,26 @@ void z_work_q_main(void *work_q_ptr, void *p2, void *p3)
 
 		handler = work->handler;
 
+#ifdef CONFIG_WORKQUEUE_STATS
+		if (stats) {
+			start = k_cycle_get_32();
+			wait = work_stats_start(work, start);
+		}
+#endif
+
 		/* Reset pending state so it can be resubmitted by handler */
 		if (atomic_test_and_clear_bit(work->flags,
 					      K_WORK_STATE_PENDING)) {
 			handler(work);
+#ifdef CONFIG_WORKQUEUE_STATS
+			/* The work item may be gone by now, only the
+			 * workqueue is updated
+			 */
+			if (stats) {
+				work_q_stats_update(work_q, handler, wait,
+						    start);
+			}
+#endif
 		}
 
 		/* Make sure we don't hog up the CPU if the FIFO never (or
@@ -7,15 +7,57 @@
 #include <errno.h>
 #include <posix/time.h>
 #include <posix/sys/time.h>
+#include <spinlock.h>
 
 /*
- * `k_uptime_get` returns a timestamp based on an always increasing
+ * `z_tick_get` returns a timestamp based on an always increasing
  * value from the system start.  To support the `CLOCK_REALTIME`
  * clock, this `rt_clock_base` records the time that the system was
- * started.  This can either be set via 'clock_settime', or could be
- * set from a real time clock, if such hardware is present.
+ * started, in nanoseconds.  This can either be set via
+ * 'clock_settime', or could be set from a real time clock, if such
+ * hardware is present.
  */
-static struct timespec rt_clock_base;
+static s64_t rt_clock_base;
+
+/*
+ * Correction requested via `adjtime`, in nanoseconds.  It is applied
+ * gradually from the uptime `start`, the realtime clock running at most
+ * 1 ns faster or slower every SLEW_RATIO ns (500 ppm), so that it never
+ * jumps nor goes backward while being corrected.
+ */
+#define SLEW_RATIO 2000
+
+static struct {
+	s64_t delta;
+	s64_t start;
+} rt_clock_slew;
+
+static struct k_spinlock rt_clock_lock;
+
+static s64_t uptime_nsecs(void)
+{
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+	s64_t ticks = z_tick_get();
+
+	return (ticks / CONFIG_SYS_CLOCK_TICKS_PER_SEC) * NSEC_PER_SEC +
+	       (ticks % CONFIG_SYS_CLOCK_TICKS_PER_SEC) * NSEC_PER_SEC /
+	       CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+#else
+	return 0;
+#endif
+}
+
+/* Part of the `adjtime` correction applied at uptime `now` */
+static s64_t slew_applied(s64_t now)
+{
+	s64_t max = (now - rt_clock_slew.start) / SLEW_RATIO;
+
+	if (rt_clock_slew.delta >= 0) {
+		return MIN(rt_clock_slew.delta, max);
+	}
+
+	return MAX(rt_clock_slew.delta, -max);
+}
 
 /**
  * @brief Get clock time specified by clock_id.
@@ -24,17 +66,19 @@ static struct timespec rt_clock_base;
  */
 int clock_gettime(clockid_t clock_id, struct timespec *ts)
 {
-	u64_t elapsed_msecs;
-	struct timespec base;
+	k_spinlock_key_t key;
+	s64_t nsecs;
 
 	switch (clock_id) {
 	case CLOCK_MONOTONIC:
-		base.tv_sec = 0;
-		base.tv_nsec = 0;
+		nsecs = uptime_nsecs();
 		break;
 
 	case CLOCK_REALTIME:
-		base = rt_clock_base;
+		key = k_spin_lock(&rt_clock_lock);
+		nsecs = uptime_nsecs();
+		nsecs += rt_clock_base + slew_applied(nsecs);
+		k_spin_unlock(&rt_clock_lock, key);
 		break;
 
 	default:
@@ -42,16 +86,11 @@ int clock_gettime(clockid_t clock_id, struct timespec *ts)
 		return -1;
 	}
 
-	elapsed_msecs = k_uptime_get();
-	ts->tv_sec = (s32_t) (elapsed_msecs / MSEC_PER_SEC);
-	ts->tv_nsec = (s32_t) ((elapsed_msecs % MSEC_PER_SEC) *
-					USEC_PER_MSEC * NSEC_PER_USEC);
-
-	ts->tv_sec += base.tv_sec;
-	ts->tv_nsec += base.tv_nsec;
-	if (ts->tv_nsec > NSEC_PER_SEC) {
-		ts->tv_sec++;
-		ts->tv_nsec -= NSEC_PER_SEC;
+	ts->tv_sec = nsecs / NSEC_PER_SEC;
+	ts->tv_nsec = nsecs % NSEC_PER_SEC;
+	if (ts->tv_nsec < 0) {
+		ts->tv_sec--;
+		ts->tv_nsec += NSEC_PER_SEC;
 	}
 
 	return 0;
@@ -63,25 +102,68 @@ int clock_gettime(clockid_t clock_id, struct timespec *ts)
  * See IEEE 1003.1.
  *
  * Note that only the `CLOCK_REALTIME` clock can be set using this
- * call.
+ * call.  Any correction pending from `adjtime` is cancelled.
  */
 int clock_settime(clockid_t clock_id, const struct timespec *tp)
 {
-	struct timespec base;
+	k_spinlock_key_t key;
 
 	if (clock_id != CLOCK_REALTIME) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	u64_t elapsed_msecs = k_uptime_get();
-	s64_t delta = (s64_t)NSEC_PER_SEC * tp->tv_sec + tp->tv_nsec
-		- elapsed_msecs * USEC_PER_MSEC * NSEC_PER_USEC;
+	key = k_spin_lock(&rt_clock_lock);
+
+	rt_clock_base = (s64_t)NSEC_PER_SEC * tp->tv_sec + tp->tv_nsec -
+			uptime_nsecs();
+	rt_clock_slew.delta = 0;
+
+	k_spin_unlock(&rt_clock_lock, key);
 
-	base.tv_sec = delta / NSEC_PER_SEC;
-	base.tv_nsec = delta % NSEC_PER_SEC;
+	return 0;
+}
 
-	rt_clock_base = base;
+/**
+ * @brief Correct the real time gradually.
+ *
+ * The `CLOCK_REALTIME` clock is slowed down or sped up by 500 ppm
+ * until it has moved by @a delta, replacing any pending correction.
+ * With a NULL @a delta, the pending correction is kept.
+ *
+ * See 4.3BSD.
+ */
+int adjtime(const struct timeval *delta, struct timeval *olddelta)
+{
+	k_spinlock_key_t key;
+	s64_t now, applied, remaining;
+
+	key = k_spin_lock(&rt_clock_lock);
+
+	now = uptime_nsecs();
+	applied = slew_applied(now);
+	remaining = rt_clock_slew.delta - applied;
+
+	rt_clock_base += applied;
+	rt_clock_slew.start = now;
+	if (delta) {
+		rt_clock_slew.delta = (s64_t)NSEC_PER_SEC * delta->tv_sec +
+				      (s64_t)NSEC_PER_USEC * delta->tv_usec;
+	} else {
+		rt_clock_slew.delta = remaining;
+	}
+
+	k_spin_unlock(&rt_clock_lock, key);
+
+	if (olddelta) {
+		remaining /= NSEC_PER_USEC;
+		olddelta->tv_sec = remaining / USEC_PER_SEC;
+		olddelta->tv_usec = remaining % USEC_PER_SEC;
+		if (olddelta->tv_usec < 0) {
+			olddelta->tv_sec--;
+			olddelta->tv_usec += USEC_PER_SEC;
+		}
+	}
 
 	return 0;
 }
@@ -10,11 +10,30 @@
 #include <posix/time.h>
 #include <posix/mqueue.h>
 
+/* Message slot, queued to the list of its priority or to the free list */
+struct mqueue_msg {
+	sys_snode_t node;
+	size_t len;
+	char data[];
+};
+
 typedef struct mqueue_object {
 	sys_snode_t snode;
 	char *mem_buffer;
 	char *mem_obj;
-	struct k_msgq queue;
+	struct k_spinlock lock;
+	/* Counts free slots and queued messages, senders and receivers
+	 * block on them
+	 */
+	struct k_sem free_sem;
+	struct k_sem used_sem;
+	sys_slist_t free_list;
+	sys_slist_t prio_list[CONFIG_MQUEUE_PRIO_MAX];
+	/* Bit set for each priority with queued messages */
+	u32_t prio_mask;
+	size_t msg_size;
+	u32_t max_msgs;
+	u32_t hash;
 	atomic_t ref_count;
 	char *name;
 } mqueue_object;
@@ -25,17 +44,27 @@ typedef struct mqueue_desc {
 	u32_t  flags;
 } mqueue_desc;
 
+#define MQ_SLOT_SIZE(msg_size) \
+	ROUND_UP(sizeof(struct mqueue_msg) + (msg_size), sizeof(void *))
+
 K_SEM_DEFINE(mq_sem, 1, 1);
 
-/* Initialize the list */
-sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
+/* Named message queues, hashed by name. Empty lists are all zeroes. */
+static sys_slist_t mq_buckets[CONFIG_MQUEUE_HASH_BUCKETS];
+
+BUILD_ASSERT_MSG((CONFIG_MQUEUE_HASH_BUCKETS &
+		  (CONFIG_MQUEUE_HASH_BUCKETS - 1)) == 0,
+		 "CONFIG_MQUEUE_HASH_BUCKETS must be a power of 2");
 
 s64_t timespec_to_timeoutms(const struct timespec *abstime);
-static mqueue_object *find_in_list(const char *name);
+static u32_t name_hash(const char *name);
+static mqueue_object *find_in_list(const char *name, u32_t hash);
+static void init_queue(mqueue_object *msg_queue, long msg_size,
+		       long max_msgs);
 static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  s32_t timeout);
+			  unsigned int msg_prio, s32_t timeout);
 static int receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   s32_t timeout);
+			   unsigned int *msg_prio, s32_t timeout);
 static void remove_mq(mqueue_object *msg_queue);
 
 /**
@@ -55,6 +84,7 @@ mqd_t mq_open(const char *name, int oflags, ...)
 	mqueue_object *msg_queue;
 	mqueue_desc *msg_queue_desc = NULL, *mqd = (mqueue_desc *)(-1);
 	char *mq_desc_ptr, *mq_obj_ptr, *mq_buf_ptr, *mq_name_ptr;
+	u32_t hash;
 
 	va_start(va, oflags);
 	if ((oflags & O_CREAT) != 0) {
@@ -80,8 +110,9 @@ mqd_t mq_open(const char *name, int oflags, ...)
 	}
 
 	/* Check if queue already exists */
+	hash = name_hash(name);
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
+	msg_queue = find_in_list(name, hash);
 	k_sem_give(&mq_sem);
 
 	if ((msg_queue != NULL) && (oflags & O_CREAT) != 0 &&
@@ -136,21 +167,20 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 		strcpy(msg_queue->name, name);
 
-		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(u8_t));
+		mq_buf_ptr = k_malloc(MQ_SLOT_SIZE(msg_size) * max_msgs);
 		if (mq_buf_ptr != NULL) {
-			(void)memset(mq_buf_ptr, 0,
-				     msg_size * max_msgs * sizeof(u8_t));
 			msg_queue->mem_buffer = mq_buf_ptr;
 		} else {
 			goto free_mq_buffer;
 		}
 
 		(void)atomic_set(&msg_queue->ref_count, 1);
-		/* initialize zephyr message queue */
-		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
-			    max_msgs);
+		msg_queue->hash = hash;
+		init_queue(msg_queue, msg_size, max_msgs);
 		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
+		sys_slist_append(&mq_buckets[hash &
+					     (CONFIG_MQUEUE_HASH_BUCKETS - 1)],
+				 (sys_snode_t *)&(msg_queue->snode));
 		k_sem_give(&mq_sem);
 
 	} else {
@@ -205,9 +235,10 @@ int mq_close(mqd_t mqdes)
 int mq_unlink(const char *name)
 {
 	mqueue_object *msg_queue;
+	u32_t hash = name_hash(name);
 
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
+	msg_queue = find_in_list(name, hash);
 
 	if (msg_queue == NULL) {
 		k_sem_give(&mq_sem);
@@ -215,6 +246,12 @@ int mq_unlink(const char *name)
 		return -1;
 	}
 
+	/* The name can be reused right away, the queue lives on until
+	 * its last descriptor is closed.
+	 */
+	sys_slist_find_and_remove(&mq_buckets[hash &
+					      (CONFIG_MQUEUE_HASH_BUCKETS - 1)],
+				  (sys_snode_t *)msg_queue);
 	k_free(msg_queue->name);
 	msg_queue->name = NULL;
 	k_sem_give(&mq_sem);
@@ -225,7 +262,8 @@ int mq_unlink(const char *name)
 /**
  * @brief Send a message to a message queue.
  *
- * All messages in message queue are of equal priority.
+ * Messages are received highest priority first, and in sending order
+ * within a priority.
  *
  * See IEEE 1003.1
  */
@@ -235,14 +273,12 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	s32_t  timeout = K_FOREVER;
 
-	return send_message(mqd, msg_ptr, msg_len, timeout);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
  * @brief Send message to a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -252,13 +288,13 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	s32_t  timeout;
 
 	timeout = (s32_t) timespec_to_timeoutms(abstime);
-	return send_message(mqd, msg_ptr, msg_len, timeout);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
  * @brief Receive a message from a message queue.
  *
- * All messages in message queue are of equal priority.
+ * Returns the oldest of the highest priority messages.
  *
  * See IEEE 1003.1
  */
@@ -268,15 +304,13 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	s32_t  timeout = K_FOREVER;
 
-	return receive_message(mqd, msg_ptr, msg_len, timeout);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 
 }
 
 /**
  * @brief Receive message from a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
@@ -286,7 +320,7 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	s32_t  timeout = K_NO_WAIT;
 
 	timeout = (s32_t) timespec_to_timeoutms(abstime);
-	return receive_message(mqd, msg_ptr, msg_len, timeout);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
@@ -297,7 +331,6 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
-	struct k_msgq_attrs attrs;
 
 	if (mqd == NULL) {
 		errno = EBADF;
@@ -305,11 +338,10 @@ int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 	}
 
 	k_sem_take(&mq_sem, K_FOREVER);
-	k_msgq_get_attrs(&mqd->mqueue->queue, &attrs);
 	mqstat->mq_flags = mqd->flags;
-	mqstat->mq_maxmsg = attrs.max_msgs;
-	mqstat->mq_msgsize = attrs.msg_size;
-	mqstat->mq_curmsgs = attrs.used_msgs;
+	mqstat->mq_maxmsg = mqd->mqueue->max_msgs;
+	mqstat->mq_msgsize = mqd->mqueue->msg_size;
+	mqstat->mq_curmsgs = k_sem_count_get(&mqd->mqueue->used_sem);
 	k_sem_give(&mq_sem);
 	return 0;
 }
@@ -346,16 +378,30 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mqstat,
 }
 
 /* Internal functions */
-static mqueue_object *find_in_list(const char *name)
+
+/* FNV-1a */
+static u32_t name_hash(const char *name)
+{
+	u32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash = (hash ^ (u8_t)*name++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static mqueue_object *find_in_list(const char *name, u32_t hash)
 {
 	sys_snode_t *mq;
 	mqueue_object *msg_queue;
 
-	mq = mq_list.head;
+	mq = mq_buckets[hash & (CONFIG_MQUEUE_HASH_BUCKETS - 1)].head;
 
 	while (mq != NULL) {
 		msg_queue = (mqueue_object *)mq;
-		if (strcmp(msg_queue->name, name) == 0) {
+		if (msg_queue->hash == hash &&
+		    strcmp(msg_queue->name, name) == 0) {
 			return msg_queue;
 		}
 
@@ -365,9 +411,29 @@ static mqueue_object *find_in_list(const char *name)
 	return NULL;
 }
 
+static void init_queue(mqueue_object *msg_queue, long msg_size,
+		       long max_msgs)
+{
+	long i;
+
+	msg_queue->msg_size = msg_size;
+	msg_queue->max_msgs = max_msgs;
+	k_sem_init(&msg_queue->free_sem, max_msgs, max_msgs);
+	k_sem_init(&msg_queue->used_sem, 0, max_msgs);
+
+	for (i = 0; i < max_msgs; i++) {
+		sys_slist_append(&msg_queue->free_list,
+				 (sys_snode_t *)(msg_queue->mem_buffer +
+						 i * MQ_SLOT_SIZE(msg_size)));
+	}
+}
+
 static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  s32_t timeout)
+			  unsigned int msg_prio, s32_t timeout)
 {
+	mqueue_object *msg_queue;
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
 	s32_t ret = -1;
 
 	if (mqd == NULL) {
@@ -375,26 +441,55 @@ static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
 		return ret;
 	}
 
+	msg_queue = mqd->mqueue;
+
 	if ((mqd->flags & O_NONBLOCK) != 0U) {
 		timeout = K_NO_WAIT;
 	}
 
-	if (msg_len >  mqd->mqueue->queue.msg_size) {
+	if (msg_len >  msg_queue->msg_size) {
 		errno = EMSGSIZE;
 		return ret;
 	}
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
+	if (msg_prio >= MQ_PRIO_MAX) {
+		errno = EINVAL;
+		return ret;
+	}
+
+	if (k_sem_take(&msg_queue->free_sem, timeout) != 0) {
 		errno = (timeout == K_NO_WAIT) ?   EAGAIN : ETIMEDOUT;
 		return ret;
 	}
 
+	/* The semaphore guarantees a free slot, which is ours once off
+	 * the list.
+	 */
+	key = k_spin_lock(&msg_queue->lock);
+	msg = (struct mqueue_msg *)sys_slist_get_not_empty(
+						&msg_queue->free_list);
+	k_spin_unlock(&msg_queue->lock, key);
+
+	(void)memcpy(msg->data, msg_ptr, msg_len);
+	msg->len = msg_len;
+
+	key = k_spin_lock(&msg_queue->lock);
+	sys_slist_append(&msg_queue->prio_list[msg_prio], &msg->node);
+	msg_queue->prio_mask |= BIT(msg_prio);
+	k_spin_unlock(&msg_queue->lock, key);
+
+	k_sem_give(&msg_queue->used_sem);
+
 	return 0;
 }
 
 static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     s32_t timeout)
+			     unsigned int *msg_prio, s32_t timeout)
 {
+	mqueue_object *msg_queue;
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
+	unsigned int prio;
 	int ret = -1;
 
 	if (mqd == NULL) {
@@ -402,7 +497,9 @@ static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		return ret;
 	}
 
-	if (msg_len < mqd->mqueue->queue.msg_size) {
+	msg_queue = mqd->mqueue;
+
+	if (msg_len < msg_queue->msg_size) {
 		errno = EMSGSIZE;
 		return ret;
 	}
@@ -411,23 +508,39 @@ static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		timeout = K_NO_WAIT;
 	}
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
+	if (k_sem_take(&msg_queue->used_sem, timeout) != 0) {
 		errno = (timeout != K_NO_WAIT) ? ETIMEDOUT : EAGAIN;
-	} else {
-		ret = mqd->mqueue->queue.msg_size;
+		return ret;
+	}
+
+	key = k_spin_lock(&msg_queue->lock);
+	prio = 31 - __builtin_clz(msg_queue->prio_mask);
+	msg = (struct mqueue_msg *)sys_slist_get_not_empty(
+					&msg_queue->prio_list[prio]);
+	if (sys_slist_is_empty(&msg_queue->prio_list[prio])) {
+		msg_queue->prio_mask &= ~BIT(prio);
+	}
+	k_spin_unlock(&msg_queue->lock, key);
+
+	(void)memcpy(msg_ptr, msg->data, msg->len);
+	ret = msg->len;
+	if (msg_prio != NULL) {
+		*msg_prio = prio;
 	}
 
+	key = k_spin_lock(&msg_queue->lock);
+	sys_slist_append(&msg_queue->free_list, &msg->node);
+	k_spin_unlock(&msg_queue->lock, key);
+
+	k_sem_give(&msg_queue->free_sem);
+
 	return ret;
 }
 
 static void remove_mq(mqueue_object *msg_queue)
 {
 	if (atomic_cas(&msg_queue->ref_count, 0, 0)) {
-		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_find_and_remove(&mq_list, (sys_snode_t *) msg_queue);
-		k_sem_give(&mq_sem);
-
-		/* Free mq buffer and pbject */
+		/* Already out of the name table since unlinked */
 		k_free(msg_queue->mem_buffer);
 		k_free(msg_queue->mem_obj);
 	}
@@ -37,6 +37,49 @@ static const pthread_attr_t init_pthread_attrs = {
 static struct posix_thread posix_thread_pool[CONFIG_MAX_PTHREAD_COUNT];
 PTHREAD_MUTEX_DEFINE(pthread_pool_lock);
 
+/* Released slots, reused most recent first, and the first slot never used */
+static u8_t pthread_free_slots[CONFIG_MAX_PTHREAD_COUNT];
+static u32_t pthread_free_count;
+static u32_t pthread_unused_slot;
+
+#ifdef CONFIG_PTHREAD_STACK_POOL
+static K_THREAD_STACK_ARRAY_DEFINE(posix_thread_stacks,
+				   CONFIG_MAX_PTHREAD_COUNT,
+				   CONFIG_PTHREAD_STACK_POOL_SIZE);
+#endif
+
+static struct posix_thread *posix_thread_alloc(void)
+{
+	struct posix_thread *thread = NULL;
+
+	pthread_mutex_lock(&pthread_pool_lock);
+	if (pthread_free_count > 0) {
+		pthread_free_count--;
+		thread = &posix_thread_pool[
+				pthread_free_slots[pthread_free_count]];
+	} else if (pthread_unused_slot < CONFIG_MAX_PTHREAD_COUNT) {
+		thread = &posix_thread_pool[pthread_unused_slot++];
+	}
+
+	if (thread != NULL) {
+		thread->state = PTHREAD_JOINABLE;
+	}
+	pthread_mutex_unlock(&pthread_pool_lock);
+
+	return thread;
+}
+
+/*
+ * Called once the thread state is PTHREAD_TERMINATED, and the thread cannot
+ * run anymore: either it was aborted or the scheduler is locked until it is.
+ */
+static void posix_thread_release(struct posix_thread *thread)
+{
+	pthread_mutex_lock(&pthread_pool_lock);
+	pthread_free_slots[pthread_free_count++] = thread - posix_thread_pool;
+	pthread_mutex_unlock(&pthread_pool_lock);
+}
+
 static bool is_posix_prio_valid(u32_t priority, int policy)
 {
 	if (priority >= sched_get_priority_min(policy) &&
@@ -112,6 +155,21 @@ int pthread_attr_setstack(pthread_attr_t *attr, void *stackaddr,
 	return 0;
 }
 
+/**
+ * @brief Set stack size attribute in thread attributes object.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_attr_setstacksize(pthread_attr_t *attr, size_t stacksize)
+{
+	if ((attr == NULL) || (attr->initialized == 0U) || (stacksize == 0)) {
+		return EINVAL;
+	}
+
+	attr->stacksize = stacksize;
+	return 0;
+}
+
 static void zephyr_thread_wrapper(void *arg1, void *arg2, void *arg3)
 {
 	void * (*fun_ptr)(void *) = arg3;
@@ -123,8 +181,8 @@ static void zephyr_thread_wrapper(void *arg1, void *arg2, void *arg3)
 /**
  * @brief Create a new thread.
  *
- * Pthread attribute should not be NULL. API will return Error on NULL
- * attribute value.
+ * Without CONFIG_PTHREAD_STACK_POOL, pthread attribute should not be NULL
+ * and must provide a stack. API will return Error otherwise.
  *
  * See IEEE 1003.1
  */
@@ -132,10 +190,26 @@ int pthread_create(pthread_t *newthread, const pthread_attr_t *attr,
 		   void *(*threadroutine)(void *), void *arg)
 {
 	s32_t prio;
-	u32_t pthread_num;
 	pthread_condattr_t cond_attr;
 	struct posix_thread *thread;
+	k_thread_stack_t *stack;
+	size_t stacksize;
+
+#ifdef CONFIG_PTHREAD_STACK_POOL
+	if (attr == NULL) {
+		attr = &init_pthread_attrs;
+	}
+
+	if ((attr->initialized == 0U) ||
+	    ((attr->stack != NULL) && (attr->stacksize == 0))) {
+		return EINVAL;
+	}
 
+	if ((attr->stack == NULL) &&
+	    (attr->stacksize > CONFIG_PTHREAD_STACK_POOL_SIZE)) {
+		return EAGAIN;
+	}
+#else
 	/*
 	 * FIXME: Pthread attribute must be non-null and it provides stack
 	 * pointer and stack size. So even though POSIX 1003.1 spec accepts
@@ -145,25 +219,24 @@ int pthread_create(pthread_t *newthread, const pthread_attr_t *attr,
 	    || (attr->stack == NULL) || (attr->stacksize == 0)) {
 		return EINVAL;
 	}
+#endif
 
-	pthread_mutex_lock(&pthread_pool_lock);
-	for (pthread_num = 0;
-	    pthread_num < CONFIG_MAX_PTHREAD_COUNT; pthread_num++) {
-		thread = &posix_thread_pool[pthread_num];
-		if (thread->state == PTHREAD_TERMINATED) {
-			thread->state = PTHREAD_JOINABLE;
-			break;
-		}
+	thread = posix_thread_alloc();
+	if (thread == NULL) {
+		return EAGAIN;
 	}
-	pthread_mutex_unlock(&pthread_pool_lock);
 
-	if (pthread_num >= CONFIG_MAX_PTHREAD_COUNT) {
-		return EAGAIN;
+	stack = attr->stack;
+	stacksize = attr->stacksize;
+#ifdef CONFIG_PTHREAD_STACK_POOL
+	if (stack == NULL) {
+		stack = posix_thread_stacks[thread - posix_thread_pool];
+		stacksize = K_THREAD_STACK_SIZEOF(posix_thread_stacks[0]);
 	}
+#endif
 
 	prio = posix_to_zephyr_priority(attr->priority, attr->schedpolicy);
 
-	thread = &posix_thread_pool[pthread_num];
 	/*
 	 * Ignore return value, as we know that Zephyr implementation
 	 * cannot fail.
@@ -183,8 +256,8 @@ int pthread_create(pthread_t *newthread, const pthread_attr_t *attr,
 	pthread_cond_init(&thread->state_cond, &cond_attr);
 	sys_slist_init(&thread->key_list);
 
-	*newthread = (pthread_t) k_thread_create(&thread->thread, attr->stack,
-						 attr->stacksize,
+	*newthread = (pthread_t) k_thread_create(&thread->thread, stack,
+						 stacksize,
 						 (k_thread_entry_t)
 						 zephyr_thread_wrapper,
 						 (void *)arg, NULL,
@@ -242,9 +315,17 @@ int pthread_cancel(pthread_t pthread)
 	pthread_mutex_unlock(&thread->cancel_lock);
 
 	if (cancel_state == PTHREAD_CANCEL_ENABLE) {
+		bool release = false;
+
+		/* Joiners and creators must not see the slot before the
+		 * thread is gone.
+		 */
+		k_sched_lock();
+
 		pthread_mutex_lock(&thread->state_lock);
 		if (thread->state == PTHREAD_DETACHED) {
 			thread->state = PTHREAD_TERMINATED;
+			release = true;
 		} else {
 			thread->retval = PTHREAD_CANCELED;
 			thread->state = PTHREAD_EXITED;
@@ -252,7 +333,12 @@ int pthread_cancel(pthread_t pthread)
 		}
 		pthread_mutex_unlock(&thread->state_lock);
 
+		if (release) {
+			posix_thread_release(thread);
+		}
+
 		k_thread_abort((k_tid_t) thread);
+		k_sched_unlock();
 	}
 
 	return 0;
@@ -358,6 +444,7 @@ void pthread_exit(void *retval)
 	pthread_key_obj *key_obj;
 	pthread_thread_data *thread_spec_data;
 	sys_snode_t *node_l;
+	bool release = false;
 
 	/* Make a thread as cancelable before exiting */
 	pthread_mutex_lock(&self->cancel_lock);
@@ -367,25 +454,34 @@ void pthread_exit(void *retval)
 
 	pthread_mutex_unlock(&self->cancel_lock);
 
+	SYS_SLIST_FOR_EACH_NODE(&self->key_list, node_l) {
+		thread_spec_data = (pthread_thread_data *)node_l;
+		key_obj = thread_spec_data->key;
+		if ((key_obj->destructor != NULL) && (thread_spec_data != NULL)) {
+			(key_obj->destructor)(thread_spec_data->spec_data);
+		}
+	}
+
+	/* Joiners and creators must not run before the thread is gone,
+	 * the lock ends with it.
+	 */
+	k_sched_lock();
+
 	pthread_mutex_lock(&self->state_lock);
 	if (self->state == PTHREAD_JOINABLE) {
 		self->retval = retval;
 		self->state = PTHREAD_EXITED;
-		self->retval = retval;
 		pthread_cond_broadcast(&self->state_cond);
 	} else {
 		self->state = PTHREAD_TERMINATED;
+		release = true;
 	}
+	pthread_mutex_unlock(&self->state_lock);
 
-	SYS_SLIST_FOR_EACH_NODE(&self->key_list, node_l) {
-		thread_spec_data = (pthread_thread_data *)node_l;
-		key_obj = thread_spec_data->key;
-		if ((key_obj->destructor != NULL) && (thread_spec_data != NULL)) {
-			(key_obj->destructor)(thread_spec_data->spec_data);
-		}
+	if (release) {
+		posix_thread_release(self);
 	}
 
-	pthread_mutex_unlock(&self->state_lock);
 	k_thread_abort((k_tid_t)self);
 }
 
@@ -397,6 +493,7 @@ void pthread_exit(void *retval)
 int pthread_join(pthread_t thread, void **status)
 {
 	struct posix_thread *pthread = (struct posix_thread *) thread;
+	bool release = false;
 	int ret = 0;
 
 	if (pthread == NULL) {
@@ -417,6 +514,9 @@ int pthread_join(pthread_t thread, void **status)
 		if (status != NULL) {
 			*status = pthread->retval;
 		}
+
+		pthread->state = PTHREAD_TERMINATED;
+		release = true;
 	} else if (pthread->state == PTHREAD_DETACHED) {
 		ret = EINVAL;
 	} else {
@@ -424,6 +524,12 @@ int pthread_join(pthread_t thread, void **status)
 	}
 
 	pthread_mutex_unlock(&pthread->state_lock);
+
+	/* Only now, a new thread of the slot reinitializes state_lock */
+	if (release) {
+		posix_thread_release(pthread);
+	}
+
 	return ret;
 }
 
@@ -435,6 +541,7 @@ int pthread_join(pthread_t thread, void **status)
 int pthread_detach(pthread_t thread)
 {
 	struct posix_thread *pthread = (struct posix_thread *) thread;
+	bool release = false;
 	int ret = 0;
 
 	if (pthread == NULL) {
@@ -456,6 +563,7 @@ int pthread_detach(pthread_t thread)
 		/* THREAD has already exited.
 		 * Pthread remained to provide exit status.
 		 */
+		release = true;
 		break;
 	case PTHREAD_TERMINATED:
 		ret = ESRCH;
@@ -466,6 +574,11 @@ int pthread_detach(pthread_t thread)
 	}
 
 	pthread_mutex_unlock(&pthread->state_lock);
+
+	if (release) {
+		posix_thread_release(pthread);
+	}
+
 	return ret;
 }
 
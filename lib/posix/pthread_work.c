@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <posix/pthread.h>
+
+#define WORKERS CONFIG_PTHREAD_WORKQUEUE_THREADS
+
+static struct k_work_q pthread_work_q;
+#if WORKERS > 1
+static struct k_thread pthread_workers[WORKERS - 1];
+#endif
+static K_THREAD_STACK_ARRAY_DEFINE(pthread_work_stacks, WORKERS,
+				   CONFIG_PTHREAD_WORKQUEUE_STACK_SIZE);
+
+static void pthread_work_handler(struct k_work *item)
+{
+	struct pthread_work *work = CONTAINER_OF(item, struct pthread_work,
+						 work);
+
+	(void)work->routine(work->arg);
+}
+
+int pthread_work_submit(struct pthread_work *work, void *(*routine)(void *),
+			void *arg)
+{
+	if (k_work_pending(&work->work)) {
+		return EBUSY;
+	}
+
+	k_work_init(&work->work, pthread_work_handler);
+	work->routine = routine;
+	work->arg = arg;
+
+	k_work_submit_to_queue(&pthread_work_q, &work->work);
+
+	return 0;
+}
+
+static int pthread_work_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&pthread_work_q, pthread_work_stacks[0],
+		       K_THREAD_STACK_SIZEOF(pthread_work_stacks[0]),
+		       CONFIG_PTHREAD_WORKQUEUE_PRIORITY);
+
+#if WORKERS > 1
+	/* The other workers take items from the same queue */
+	for (int i = 1; i < WORKERS; i++) {
+		(void)k_work_q_worker_add(&pthread_work_q,
+					  &pthread_workers[i - 1],
+					  pthread_work_stacks[i],
+					  K_THREAD_STACK_SIZEOF(
+						  pthread_work_stacks[i]),
+					  CONFIG_PTHREAD_WORKQUEUE_PRIORITY,
+					  -1);
+	}
+#endif
+
+	return 0;
+}
+
+SYS_INIT(pthread_work_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
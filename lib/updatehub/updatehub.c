@@ -9,6 +9,7 @@
 LOG_MODULE_REGISTER(updatehub);
 
 #include <zephyr.h>
+#include <limits.h>
 
 #include <logging/log_ctrl.h>
 #include <net/socket.h>
@@ -21,6 +22,12 @@ LOG_MODULE_REGISTER(updatehub);
 #include <power/reboot.h>
 #include <tinycrypt/sha256.h>
 #include <data/json.h>
+#if defined(CONFIG_UPDATEHUB_DOWNLOAD_HTTP)
+#include <net/http_client.h>
+#endif
+#if defined(CONFIG_UPDATEHUB_RESUME)
+#include <settings/settings.h>
+#endif
 
 #include <updatehub.h>
 #include "updatehub_priv.h"
@@ -37,6 +44,8 @@ LOG_MODULE_REGISTER(updatehub);
 #define MAX_PATH_SIZE 255
 #define MAX_PAYLOAD_SIZE 500
 #define MAX_DOWNLOAD_DATA 1100
+#define DOWNLOAD_BLOCK_SIZE 1024
+#define DOWNLOAD_WINDOW CONFIG_UPDATEHUB_COAP_WINDOW
 #define COAP_MAX_RETRY 3
 #define MAX_IP_SIZE 30
 
@@ -46,6 +55,12 @@ LOG_MODULE_REGISTER(updatehub);
 #define UPDATEHUB_SERVER "coap.updatehub.io"
 #endif
 
+#if defined(CONFIG_UPDATEHUB_CE)
+#define UPDATEHUB_HTTP_SERVER CONFIG_UPDATEHUB_SERVER
+#else
+#define UPDATEHUB_HTTP_SERVER "api.updatehub.io"
+#endif
+
 static struct updatehub_context {
 	struct coap_block_context block;
 	struct k_sem semaphore;
@@ -315,104 +330,619 @@ error:
 	return ret;
 }
 
-static void install_update_cb(void)
+static bool image_hash_matches(void)
 {
-	struct coap_packet response_packet;
+	u8_t image_hash[TC_SHA256_DIGEST_SIZE];
 	char buffer[3], sha256_image_dowloaded[TC_SHA256_BLOCK_SIZE + 1];
-	u8_t *data = k_malloc(MAX_DOWNLOAD_DATA);
 	int i, buffer_len = 0;
-	int rcvd = -1;
 
-	if (data == NULL) {
-		LOG_ERR("Could not alloc data memory");
+	if (tc_sha256_final(image_hash, &ctx.sha256sum) < 1) {
+		LOG_ERR("Could not finish sha256sum");
+		return false;
+	}
+
+	memset(&sha256_image_dowloaded, 0, TC_SHA256_BLOCK_SIZE + 1);
+	for (i = 0; i < TC_SHA256_DIGEST_SIZE; i++) {
+		snprintk(buffer, sizeof(buffer), "%02x", image_hash[i]);
+		buffer_len = buffer_len + strlen(buffer);
+		strncat(&sha256_image_dowloaded[i], buffer,
+			MIN(TC_SHA256_BLOCK_SIZE, buffer_len));
+	}
+
+	if (strncmp(sha256_image_dowloaded,
+		    update_info.sha256sum_image,
+		    strlen(update_info.sha256sum_image)) != 0) {
+		LOG_ERR("SHA256SUM of image are not the same");
+		return false;
+	}
+
+	return true;
+}
+
+#if !defined(CONFIG_UPDATEHUB_DOWNLOAD_HTTP)
+/* Block of the image, hashed in order and then written to flash by the
+ * writer thread, while the next blocks are downloaded.
+ */
+struct download_block {
+	void *fifo_reserved;
+	size_t offset;
+	u16_t len;
+	bool last;
+	u8_t data[DOWNLOAD_BLOCK_SIZE];
+};
+
+/* Block2 request waiting for its response */
+struct download_slot {
+	size_t offset;
+	u8_t retries;
+	bool used;
+};
+
+K_MEM_SLAB_DEFINE(download_slab, sizeof(struct download_block),
+		  DOWNLOAD_WINDOW + 1, 4);
+static K_FIFO_DEFINE(write_fifo);
+static K_SEM_DEFINE(write_sem, 0, UINT_MAX);
+static atomic_t write_error;
+
+static struct {
+	struct download_slot slots[DOWNLOAD_WINDOW];
+	/* blocks received ahead of the next one to hash */
+	struct download_block *held[DOWNLOAD_WINDOW];
+	/* block size chosen by the server, 0 until the first response */
+	u16_t block_len;
+	size_t start;
+	size_t next_request;
+	u32_t queued;
+	u32_t written;
+} download;
+
+#if defined(CONFIG_UPDATEHUB_RESUME)
+/* Progress of the download, stored in settings */
+static struct download_progress {
+	char package_uid[TC_SHA256_BLOCK_SIZE + 1];
+	char sha256sum_image[TC_SHA256_BLOCK_SIZE + 1];
+	u32_t offset;
+} progress;
+
+static void download_progress_store(void)
+{
+	size_t written = download.start +
+			 (size_t)download.written * download.block_len;
+	int ret;
+
+	if (!download.block_len ||
+	    written < progress.offset +
+		      CONFIG_UPDATEHUB_RESUME_INTERVAL * download.block_len) {
+		return;
+	}
+
+	progress.offset = written;
+	ret = settings_save_one("updatehub/progress", &progress,
+				sizeof(progress));
+	if (ret < 0) {
+		LOG_ERR("Could not store the download progress (%d)", ret);
+	}
+}
+
+static void download_progress_clear(void)
+{
+	memset(&progress, 0, sizeof(progress));
+	(void)settings_delete("updatehub/progress");
+}
+
+/* Continue the download from the progress stored, if it is of the same
+ * package, or start writing the image again.
+ */
+static int download_start(u8_t *buf)
+{
+	size_t resumed, off, len;
+
+	if (!progress.offset || progress.offset > update_info.image_size ||
+	    strcmp(progress.package_uid, update_info.package_uid) ||
+	    strcmp(progress.sha256sum_image, update_info.sha256sum_image)) {
+		goto restart;
+	}
+
+	if (flash_img_resume(&ctx.flash_ctx, progress.offset) < 0) {
+		goto restart;
+	}
+
+	resumed = flash_img_bytes_written(&ctx.flash_ctx);
+	if (resumed % DOWNLOAD_BLOCK_SIZE) {
+		goto restart;
+	}
+
+	/* Hash again the part of the image kept on flash */
+	for (off = 0; off < resumed; off += len) {
+		len = MIN(MAX_DOWNLOAD_DATA, resumed - off);
+
+		if (flash_area_read(ctx.flash_ctx.flash_area, off, buf,
+				    len) < 0 ||
+		    tc_sha256_update(&ctx.sha256sum, buf, len) < 1) {
+			LOG_ERR("Could not hash the image written");
+			return -EIO;
+		}
+	}
+
+	ctx.downloaded_size = resumed;
+	download.start = resumed;
+	download.next_request = resumed;
+	progress.offset = resumed;
+
+	LOG_INF("Resuming download at byte %zu", resumed);
+
+	return 0;
+
+restart:
+	download_progress_clear();
+	memcpy(progress.package_uid, update_info.package_uid,
+	       sizeof(progress.package_uid));
+	memcpy(progress.sha256sum_image, update_info.sha256sum_image,
+	       sizeof(progress.sha256sum_image));
+
+	return flash_img_init(&ctx.flash_ctx);
+}
+
+static int download_progress_set(const char *key, size_t len,
+				 settings_read_cb read_cb, void *cb_arg)
+{
+	if (!settings_name_steq(key, "progress", NULL)) {
+		return 0;
+	}
+
+	if (read_cb(cb_arg, &progress, sizeof(progress)) != sizeof(progress)) {
+		LOG_ERR("Invalid stored download progress");
+		memset(&progress, 0, sizeof(progress));
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(updatehub, "updatehub", NULL,
+			       download_progress_set, NULL, NULL);
+#else
+static inline void download_progress_store(void)
+{
+}
+
+static inline void download_progress_clear(void)
+{
+}
+
+static inline int download_start(u8_t *buf)
+{
+	return flash_img_init(&ctx.flash_ctx);
+}
+#endif /* CONFIG_UPDATEHUB_RESUME */
+
+static void download_writer(void *p1, void *p2, void *p3)
+{
+	struct download_block *block;
+
+	while (true) {
+		block = k_fifo_get(&write_fifo, K_FOREVER);
+
+		if (!atomic_get(&write_error) &&
+		    flash_img_buffered_write(&ctx.flash_ctx, block->data,
+					     block->len, block->last) < 0) {
+			LOG_ERR("Error to write on the flash");
+			atomic_set(&write_error, 1);
+		}
+
+		k_mem_slab_free(&download_slab, (void **)&block);
+		k_sem_give(&write_sem);
+	}
+}
+
+/* Runs whenever the download waits for the network */
+K_THREAD_DEFINE(updatehub_writer, CONFIG_UPDATEHUB_WRITER_STACK_SIZE,
+		download_writer, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+
+static int download_request(struct download_slot *slot)
+{
+	ctx.block.current = slot->offset;
+
+	return send_request(COAP_TYPE_CON, COAP_METHOD_GET,
+			    UPDATEHUB_DOWNLOAD);
+}
+
+static int download_fill_window(void)
+{
+	struct download_slot *slot;
+	bool busy = false;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(download.slots); i++) {
+		busy |= download.slots[i].used;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(download.slots); i++) {
+		slot = &download.slots[i];
+		if (slot->used) {
+			continue;
+		}
+
+		/* One request at a time until the block size is known */
+		if (download.next_request >= update_info.image_size ||
+		    (busy && !download.block_len)) {
+			break;
+		}
+
+		slot->offset = download.next_request;
+		slot->retries = 0U;
+
+		if (download_request(slot) < 0) {
+			return -EIO;
+		}
+
+		slot->used = true;
+		busy = true;
+		download.next_request += download.block_len ?
+					 download.block_len :
+					 DOWNLOAD_BLOCK_SIZE;
+	}
+
+	return 0;
+}
+
+static int download_retry(void)
+{
+	struct download_slot *slot;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(download.slots); i++) {
+		slot = &download.slots[i];
+		if (!slot->used) {
+			continue;
+		}
+
+		if (slot->retries == COAP_MAX_RETRY) {
+			LOG_ERR("Could not get the packet");
+			ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+			return -ETIMEDOUT;
+		}
+
+		slot->retries++;
+
+		if (download_request(slot) < 0) {
+			ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+/* Hash the next block of the image, and queue it to be written */
+static int download_verify(struct download_block *block)
+{
+	if (tc_sha256_update(&ctx.sha256sum, block->data, block->len) < 1) {
+		LOG_ERR("Could not update sha256sum");
+		k_mem_slab_free(&download_slab, (void **)&block);
 		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-		goto cleanup;
+		return -EIO;
 	}
 
-	wait_fds();
+	ctx.downloaded_size += block->len;
+	block->last = ctx.downloaded_size == update_info.image_size;
+
+	download.queued++;
+	k_fifo_put(&write_fifo, block);
+
+	return 0;
+}
+
+static int download_verify_held(void)
+{
+	struct download_block *block;
+	int i, ret;
+
+	for (i = 0; i < ARRAY_SIZE(download.held); i++) {
+		block = download.held[i];
+		if (!block || block->offset != ctx.downloaded_size) {
+			continue;
+		}
+
+		download.held[i] = NULL;
+
+		ret = download_verify(block);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* the next block may be held in an earlier entry */
+		i = -1;
+	}
+
+	return 0;
+}
+
+static int download_hold(struct download_block *block)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(download.held); i++) {
+		if (!download.held[i]) {
+			download.held[i] = block;
+			return 0;
+		}
+	}
+
+	k_mem_slab_free(&download_slab, (void **)&block);
+	ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+
+	return -ENOMEM;
+}
+
+static int download_receive(u8_t *data)
+{
+	struct coap_packet response_packet;
+	struct download_slot *slot = NULL;
+	struct download_block *block;
+	const u8_t *payload;
+	u16_t payload_len;
+	size_t offset;
+	u32_t num;
+	bool more;
+	int rcvd, size, i;
 
 	rcvd = recv(ctx.sock, data, MAX_DOWNLOAD_DATA, MSG_DONTWAIT);
 	if (rcvd <= 0) {
 		ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
 		LOG_ERR("Could not receive data");
-		goto cleanup;
+		return -EIO;
 	}
 
 	if (coap_packet_parse(&response_packet, data, rcvd, NULL, 0) < 0) {
 		LOG_ERR("Invalid data received");
 		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-		goto cleanup;
+		return -EINVAL;
 	}
 
-	ctx.downloaded_size = ctx.downloaded_size +
-			      (response_packet.max_len - response_packet.offset);
-
-	if (tc_sha256_update(&ctx.sha256sum,
-			     response_packet.data + response_packet.offset,
-			     response_packet.max_len - response_packet.offset) < 1) {
-		LOG_ERR("Could not update sha256sum");
+	size = coap_get_block2_option(&response_packet, &more, &num);
+	if (size <= 0 || size > DOWNLOAD_BLOCK_SIZE ||
+	    (download.block_len && size != download.block_len)) {
+		LOG_ERR("Unexpected block size");
 		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-		goto cleanup;
+		return -EINVAL;
 	}
 
-	if (flash_img_buffered_write(&ctx.flash_ctx,
-				     response_packet.data + response_packet.offset,
-				     response_packet.max_len - response_packet.offset,
-				     ctx.downloaded_size == ctx.block.total_size) < 0) {
-		LOG_ERR("Error to write on the flash");
-		ctx.code_status = UPDATEHUB_INSTALL_ERROR;
-		goto cleanup;
+	offset = (size_t)num * size;
+
+	for (i = 0; i < ARRAY_SIZE(download.slots); i++) {
+		if (download.slots[i].used &&
+		    download.slots[i].offset == offset) {
+			slot = &download.slots[i];
+			break;
+		}
+	}
+
+	if (!slot) {
+		LOG_DBG("Duplicate block %u ignored", num);
+		return 0;
+	}
+
+	/* The server can choose a smaller block size than requested */
+	if (!download.block_len) {
+		download.block_len = size;
+		download.next_request = offset + size;
+		while (coap_block_size_to_bytes(ctx.block.block_size) > size) {
+			ctx.block.block_size--;
+		}
 	}
 
-	if (coap_update_from_block(&response_packet, &ctx.block) < 0) {
+	payload = coap_packet_get_payload(&response_packet, &payload_len);
+	if (!payload ||
+	    payload_len != MIN(size, update_info.image_size - offset)) {
+		LOG_ERR("Unexpected length of block %u", num);
 		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-		goto cleanup;
+		return -EINVAL;
+	}
+
+	slot->used = false;
+
+	/* Bounded by the blocks held and queued to the writer */
+	k_mem_slab_alloc(&download_slab, (void **)&block, K_FOREVER);
+	memcpy(block->data, payload, payload_len);
+	block->offset = offset;
+	block->len = payload_len;
+
+	if (offset != ctx.downloaded_size) {
+		return download_hold(block);
+	}
+
+	if (download_verify(block) < 0) {
+		return -EIO;
 	}
 
-	if (coap_next_block(&response_packet, &ctx.block) == 0) {
-		LOG_ERR("Could not get the next");
+	return download_verify_held();
+}
+
+/* Download the image keeping several blocks in flight, hashing them as
+ * they arrive in order while the writer thread writes them to flash.
+ */
+static void install_update_coap(void)
+{
+	u8_t *data = k_malloc(MAX_DOWNLOAD_DATA);
+	int i, ret;
+
+	if (data == NULL) {
+		LOG_ERR("Could not alloc data memory");
 		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+		return;
+	}
+
+	memset(&download, 0, sizeof(download));
+	atomic_set(&write_error, 0);
+	ctx.code_status = UPDATEHUB_OK;
+
+	if (download_start(data) < 0) {
+		LOG_ERR("Failed to init flash");
+		ctx.code_status = UPDATEHUB_FLASH_INIT_ERROR;
 		goto cleanup;
 	}
 
-	if (ctx.downloaded_size == ctx.block.total_size) {
-		u8_t image_hash[TC_SHA256_DIGEST_SIZE];
+	while (ctx.downloaded_size != update_info.image_size) {
+		if (atomic_get(&write_error)) {
+			ctx.code_status = UPDATEHUB_INSTALL_ERROR;
+			break;
+		}
 
-		if (tc_sha256_final(image_hash, &ctx.sha256sum) < 1) {
-			LOG_ERR("Could not finish sha256sum");
-			ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-			goto cleanup;
+		if (download_fill_window() < 0) {
+			ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
+			break;
 		}
 
-		memset(&sha256_image_dowloaded, 0, TC_SHA256_BLOCK_SIZE + 1);
-		for (i = 0; i < TC_SHA256_DIGEST_SIZE; i++) {
-			snprintk(buffer, sizeof(buffer), "%02x", image_hash[i]);
-			buffer_len = buffer_len + strlen(buffer);
-			strncat(&sha256_image_dowloaded[i], buffer,
-				MIN(TC_SHA256_BLOCK_SIZE, buffer_len));
+		while (k_sem_take(&write_sem, K_NO_WAIT) == 0) {
+			download.written++;
 		}
 
-		if (strncmp(sha256_image_dowloaded,
-			    update_info.sha256sum_image,
-			    strlen(update_info.sha256sum_image)) != 0) {
-			LOG_ERR("SHA256SUM of image are not the same");
-			ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-			goto cleanup;
+		download_progress_store();
+
+		ret = poll(ctx.fds, ctx.nfds, NETWORK_TIMEOUT);
+		if (ret < 0) {
+			LOG_ERR("Error in poll");
+			ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
+			break;
+		}
+
+		if (ret == 0) {
+			ret = download_retry();
+		} else {
+			ret = download_receive(data);
+		}
+
+		if (ret < 0) {
+			break;
 		}
 	}
 
-	ctx.code_status = UPDATEHUB_OK;
+	/* Let the writer finish with the blocks queued */
+	while (download.written < download.queued) {
+		k_sem_take(&write_sem, K_FOREVER);
+		download.written++;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(download.held); i++) {
+		if (download.held[i]) {
+			k_mem_slab_free(&download_slab,
+					(void **)&download.held[i]);
+		}
+	}
+
+	if (ctx.code_status != UPDATEHUB_OK) {
+		goto cleanup;
+	}
+
+	if (atomic_get(&write_error)) {
+		ctx.code_status = UPDATEHUB_INSTALL_ERROR;
+		goto cleanup;
+	}
+
+	if (!image_hash_matches()) {
+		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+	}
+
+	/* Done with this package, or not to resume the corrupted image */
+	download_progress_clear();
 
 cleanup:
 	k_free(data);
 }
+#endif /* !CONFIG_UPDATEHUB_DOWNLOAD_HTTP */
 
-static enum updatehub_response install_update(void)
+#if defined(CONFIG_UPDATEHUB_DOWNLOAD_HTTP)
+static int install_update_http_cb(struct http_request *req,
+				  struct http_response *rsp,
+				  const u8_t *data, size_t len)
+{
+	if (rsp->status_code != 200) {
+		LOG_ERR("Download failed with HTTP status %u",
+			rsp->status_code);
+		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+		return -EINVAL;
+	}
+
+	if (!data) {
+		if (ctx.downloaded_size != update_info.image_size ||
+		    !image_hash_matches()) {
+			ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+			return -EINVAL;
+		}
+
+		ctx.code_status = UPDATEHUB_OK;
+		return 0;
+	}
+
+	ctx.downloaded_size += len;
+	if (ctx.downloaded_size > update_info.image_size) {
+		LOG_ERR("Image larger than announced");
+		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+		return -EINVAL;
+	}
+
+	if (tc_sha256_update(&ctx.sha256sum, data, len) < 1) {
+		LOG_ERR("Could not update sha256sum");
+		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+		return -EINVAL;
+	}
+
+	if (flash_img_buffered_write(&ctx.flash_ctx, (u8_t *)data, len,
+				     ctx.downloaded_size ==
+				     update_info.image_size) < 0) {
+		LOG_ERR("Error to write on the flash");
+		ctx.code_status = UPDATEHUB_INSTALL_ERROR;
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* Stream the image in a single HTTP response rather than CoAP blocks */
+static void install_update_http(void)
 {
-	int verification_download = 0;
-	int attempts_download = 0;
+#if defined(CONFIG_UPDATEHUB_DTLS)
+	static const sec_tag_t sec_list[] = { CA_CERTIFICATE_TAG };
+#endif
+	struct http_request req = {
+		.method = HTTP_GET,
+		.host = UPDATEHUB_HTTP_SERVER,
+		.port = CONFIG_UPDATEHUB_DOWNLOAD_HTTP_PORT,
+		.header_fields = UPDATEHUB_API_HEADER "\r\n",
+		.url = ctx.uri_path,
+#if defined(CONFIG_UPDATEHUB_DTLS)
+		.sec_tag_list = sec_list,
+		.sec_tag_count = ARRAY_SIZE(sec_list),
+#endif
+		.response_cb = install_update_http_cb,
+	};
+	int ret;
+
+	snprintk(ctx.uri_path, MAX_PATH_SIZE,
+		 "/%s/%s/packages/%s/objects/%s", uri_path(UPDATEHUB_DOWNLOAD),
+		 CONFIG_UPDATEHUB_PRODUCT_UID, update_info.package_uid,
+		 update_info.sha256sum_image);
+
+	ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
 
-	if (boot_erase_img_bank(DT_FLASH_AREA_IMAGE_1_ID) != 0) {
+	ret = http_client_request(&req, NETWORK_TIMEOUT);
+	if (ret < 0 && !req.response.status_code) {
+		LOG_ERR("Could not download the image (%d)", ret);
+		ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
+	}
+
+	/* No more requests to the server until the next probe */
+	http_client_close_idle();
+}
+#endif
+
+static enum updatehub_response install_update(void)
+{
+	/* A resumed image is kept, erased as it is written */
+	if (!IS_ENABLED(CONFIG_UPDATEHUB_RESUME) &&
+	    boot_erase_img_bank(DT_FLASH_AREA_IMAGE_1_ID) != 0) {
 		LOG_ERR("Failed to init flash and erase second slot");
 		ctx.code_status = UPDATEHUB_FLASH_INIT_ERROR;
 		goto error;
@@ -424,6 +954,13 @@ static enum updatehub_response install_update(void)
 		goto error;
 	}
 
+#if defined(CONFIG_UPDATEHUB_DOWNLOAD_HTTP)
+	flash_img_init(&ctx.flash_ctx);
+
+	ctx.downloaded_size = 0;
+
+	install_update_http();
+#else
 	if (!start_coap_client()) {
 		ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
 		goto error;
@@ -436,37 +973,13 @@ static enum updatehub_response install_update(void)
 		goto cleanup;
 	}
 
-	flash_img_init(&ctx.flash_ctx);
-
 	ctx.downloaded_size = 0;
 
-	while (ctx.downloaded_size != ctx.block.total_size) {
-		verification_download = ctx.downloaded_size;
-
-		if (send_request(COAP_TYPE_CON, COAP_METHOD_GET,
-				 UPDATEHUB_DOWNLOAD) < 0) {
-			ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
-			goto cleanup;
-		}
-
-		install_update_cb();
-
-		if (ctx.code_status != UPDATEHUB_OK) {
-			goto cleanup;
-		}
-
-		if (verification_download == ctx.downloaded_size) {
-			if (attempts_download == COAP_MAX_RETRY) {
-				LOG_ERR("Could not get the packet");
-				ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-				goto cleanup;
-			}
-			attempts_download++;
-		}
-	}
+	install_update_coap();
 
 cleanup:
 	cleanup_connection();
+#endif
 
 error:
 	ctx.downloaded_size = 0;
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr.h>
+#include <logging/log.h>
+#include <sys/util.h>
+
+#include <device.h>
+#include <ipc/ipc_ring.h>
+
+#include <net/buf.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/l2cap.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/buf.h>
+#include <bluetooth/hci_raw.h>
+
+#define LOG_MODULE_NAME hci_ipc
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+static K_THREAD_STACK_DEFINE(tx_thread_stack, CONFIG_BT_HCI_TX_STACK_SIZE);
+static struct k_thread tx_thread_data;
+
+static struct ipc_ring ring;
+
+/* HCI command buffers */
+#define CMD_BUF_SIZE BT_BUF_RX_SIZE
+NET_BUF_POOL_DEFINE(cmd_tx_pool, CONFIG_BT_HCI_CMD_COUNT, CMD_BUF_SIZE,
+		    BT_BUF_USER_DATA_MIN, NULL);
+
+#if defined(CONFIG_BT_CTLR_TX_BUFFER_SIZE)
+#define BT_L2CAP_MTU (CONFIG_BT_CTLR_TX_BUFFER_SIZE - BT_L2CAP_HDR_SIZE)
+#else
+#define BT_L2CAP_MTU 65 /* 64-byte public key + opcode */
+#endif /* CONFIG_BT_CTLR */
+
+/** Data size needed for ACL buffers */
+#define BT_BUF_ACL_SIZE BT_L2CAP_BUF_SIZE(BT_L2CAP_MTU)
+
+#if defined(CONFIG_BT_CTLR_TX_BUFFERS)
+#define TX_BUF_COUNT CONFIG_BT_CTLR_TX_BUFFERS
+#else
+#define TX_BUF_COUNT 6
+#endif
+
+NET_BUF_POOL_DEFINE(acl_tx_pool, TX_BUF_COUNT, BT_BUF_ACL_SIZE,
+		    BT_BUF_USER_DATA_MIN, NULL);
+
+#define H4_CMD 0x01
+#define H4_ACL 0x02
+#define H4_EVT 0x04
+
+/* Called for each packet from the host, in the TX thread */
+static void recv_cb(struct ipc_ring *ring, const void *data, size_t len,
+		    void *user_data)
+{
+	const u8_t *pkt = data;
+	struct net_buf *buf;
+	int err;
+
+	if (len < 1) {
+		return;
+	}
+
+	switch (pkt[0]) {
+	case H4_CMD:
+		buf = net_buf_alloc(&cmd_tx_pool, K_NO_WAIT);
+		if (buf) {
+			bt_buf_set_type(buf, BT_BUF_CMD);
+		} else {
+			LOG_ERR("No available command buffers!");
+		}
+		break;
+	case H4_ACL:
+		/* The host only sends as many as there are buffers */
+		buf = net_buf_alloc(&acl_tx_pool, K_FOREVER);
+		bt_buf_set_type(buf, BT_BUF_ACL_OUT);
+		break;
+	default:
+		LOG_ERR("Unknown packet type %u", pkt[0]);
+		return;
+	}
+
+	if (!buf) {
+		return;
+	}
+
+	if (len - 1 > net_buf_tailroom(buf)) {
+		LOG_ERR("Packet too large (%zu bytes)", len - 1);
+		net_buf_unref(buf);
+		return;
+	}
+
+	net_buf_add_mem(buf, &pkt[1], len - 1);
+
+	err = bt_send(buf);
+	if (err) {
+		LOG_ERR("Unable to send (err %d)", err);
+		net_buf_unref(buf);
+	}
+}
+
+static void tx_thread(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		(void)ipc_ring_process(&ring, K_FOREVER);
+
+		/* Give other threads a chance to run if the host keeps
+		 * sending all the time.
+		 */
+		k_yield();
+	}
+}
+
+static int hci_ipc_send(struct net_buf *buf)
+{
+	size_t len;
+	u8_t *pkt;
+	u8_t type;
+
+	LOG_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf),
+		    buf->len);
+
+	switch (bt_buf_get_type(buf)) {
+	case BT_BUF_ACL_IN:
+		type = H4_ACL;
+		break;
+	case BT_BUF_EVT:
+		type = H4_EVT;
+		break;
+	default:
+		LOG_ERR("Unknown type %u", bt_buf_get_type(buf));
+		net_buf_unref(buf);
+		return -EINVAL;
+	}
+
+	len = buf->len + 1;
+
+	/* Events may not be dropped, wait for the host to make room */
+	while ((pkt = ipc_ring_alloc(&ring, len)) == NULL) {
+		k_sleep(K_MSEC(1));
+	}
+
+	pkt[0] = type;
+	memcpy(&pkt[1], buf->data, buf->len);
+	net_buf_unref(buf);
+
+	return ipc_ring_commit(&ring, len);
+}
+
+void main(void)
+{
+	/* incoming events and data from the controller */
+	static K_FIFO_DEFINE(rx_queue);
+	struct device *ipm;
+	int err;
+
+	LOG_DBG("Start");
+
+	ipm = device_get_binding(CONFIG_HCI_IPC_IPM_DEV_NAME);
+	if (!ipm) {
+		LOG_ERR("No IPM device %s", CONFIG_HCI_IPC_IPM_DEV_NAME);
+		return;
+	}
+
+	err = ipc_ring_init(&ring, ipm,
+			    (void *)CONFIG_HCI_IPC_TX_ADDR,
+			    CONFIG_HCI_IPC_TX_SIZE,
+			    (void *)CONFIG_HCI_IPC_RX_ADDR,
+			    CONFIG_HCI_IPC_RX_SIZE,
+			    recv_cb, NULL);
+	if (err) {
+		LOG_ERR("Ring init failed (err %d)", err);
+		return;
+	}
+
+	/* Enable the raw interface, this will in turn open the HCI driver */
+	bt_enable_raw(&rx_queue);
+
+	/* Spawn the TX thread and start feeding commands and data to the
+	 * controller
+	 */
+	k_thread_create(&tx_thread_data, tx_thread_stack,
+			K_THREAD_STACK_SIZEOF(tx_thread_stack), tx_thread,
+			NULL, NULL, NULL, K_PRIO_COOP(7), 0, K_NO_WAIT);
+
+	while (1) {
+		struct net_buf *buf;
+
+		buf = net_buf_get(&rx_queue, K_FOREVER);
+		err = hci_ipc_send(buf);
+		if (err) {
+			LOG_ERR("Failed to send (err %d)", err);
+		}
+	}
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr.h>
+#include <sys/byteorder.h>
+#include <logging/log.h>
+#include <sys/util.h>
+
+#include <device.h>
+#include <drivers/uart.h>
+
+#include <net/buf.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/l2cap.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/buf.h>
+#include <bluetooth/hci_raw.h>
+
+#define LOG_MODULE_NAME hci_uart_async
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+static struct device *hci_uart_dev;
+static K_THREAD_STACK_DEFINE(tx_thread_stack, CONFIG_BT_HCI_TX_STACK_SIZE);
+static struct k_thread tx_thread_data;
+
+/* HCI command buffers */
+#define CMD_BUF_SIZE BT_BUF_RX_SIZE
+NET_BUF_POOL_DEFINE(cmd_tx_pool, CONFIG_BT_HCI_CMD_COUNT, CMD_BUF_SIZE,
+		    BT_BUF_USER_DATA_MIN, NULL);
+
+#if defined(CONFIG_BT_CTLR_TX_BUFFER_SIZE)
+#define BT_L2CAP_MTU (CONFIG_BT_CTLR_TX_BUFFER_SIZE - BT_L2CAP_HDR_SIZE)
+#else
+#define BT_L2CAP_MTU 65 /* 64-byte public key + opcode */
+#endif /* CONFIG_BT_CTLR */
+
+/** Data size needed for ACL buffers */
+#define BT_BUF_ACL_SIZE BT_L2CAP_BUF_SIZE(BT_L2CAP_MTU)
+
+#if defined(CONFIG_BT_CTLR_TX_BUFFERS)
+#define TX_BUF_COUNT CONFIG_BT_CTLR_TX_BUFFERS
+#else
+#define TX_BUF_COUNT 6
+#endif
+
+NET_BUF_POOL_DEFINE(acl_tx_pool, TX_BUF_COUNT, BT_BUF_ACL_SIZE,
+		    BT_BUF_USER_DATA_MIN, NULL);
+
+static K_FIFO_DEFINE(tx_queue);
+
+#define H4_CMD 0x01
+#define H4_ACL 0x02
+#define H4_SCO 0x03
+#define H4_EVT 0x04
+
+/* Buffers the UART receives into in turn, parsed when either is full or
+ * after RX_TIMEOUT ms without new bytes.
+ */
+#define RX_BUF_SIZE 64
+#define RX_TIMEOUT 1
+
+static u8_t rx_buf[2][RX_BUF_SIZE];
+static u8_t rx_next;
+
+/* H:4 packet being received */
+static struct {
+	struct net_buf *buf;
+	u8_t type;
+	u8_t hdr[4];
+	u8_t hdr_len;
+	u8_t hdr_read;
+	u16_t remaining;
+} rx;
+
+/* Packets to the host are gathered in one buffer while the other one is
+ * being sent.
+ */
+#define H4_TX_BUF_SIZE (4 * (1 + BT_BUF_RX_SIZE))
+
+static u8_t tx_buf[2][H4_TX_BUF_SIZE];
+static u8_t tx_cur;
+static size_t tx_len;
+static K_SEM_DEFINE(tx_sem, 1, 1);
+
+static void h4_rx_pkt_done(void)
+{
+	if (rx.buf) {
+		LOG_DBG("full packet received");
+
+		/* Put buffer into TX queue, thread will dequeue */
+		net_buf_put(&tx_queue, rx.buf);
+		rx.buf = NULL;
+	}
+
+	rx.type = 0U;
+}
+
+static void h4_rx_hdr_done(void)
+{
+	if (rx.type == H4_CMD) {
+		rx.remaining = rx.hdr[2];
+		rx.buf = net_buf_alloc(&cmd_tx_pool, K_NO_WAIT);
+		if (rx.buf) {
+			bt_buf_set_type(rx.buf, BT_BUF_CMD);
+		} else {
+			LOG_ERR("No available command buffers!");
+		}
+	} else {
+		rx.remaining = sys_get_le16(&rx.hdr[2]);
+		rx.buf = net_buf_alloc(&acl_tx_pool, K_NO_WAIT);
+		if (rx.buf) {
+			bt_buf_set_type(rx.buf, BT_BUF_ACL_OUT);
+		} else {
+			LOG_ERR("No available ACL buffers!");
+		}
+	}
+
+	LOG_DBG("need to get %u bytes", rx.remaining);
+
+	if (rx.buf) {
+		if (rx.hdr_len + rx.remaining > net_buf_tailroom(rx.buf)) {
+			LOG_ERR("Not enough space in buffer");
+			net_buf_unref(rx.buf);
+			rx.buf = NULL;
+		} else {
+			net_buf_add_mem(rx.buf, rx.hdr, rx.hdr_len);
+		}
+	}
+
+	if (!rx.remaining) {
+		h4_rx_pkt_done();
+	}
+}
+
+static void h4_rx(const u8_t *data, size_t len)
+{
+	while (len) {
+		size_t chunk;
+
+		/* Beginning of a new packet */
+		if (!rx.type) {
+			rx.type = *data++;
+			len--;
+
+			switch (rx.type) {
+			case H4_CMD:
+				rx.hdr_len = sizeof(struct bt_hci_cmd_hdr);
+				break;
+			case H4_ACL:
+				rx.hdr_len = sizeof(struct bt_hci_acl_hdr);
+				break;
+			default:
+				LOG_ERR("Unknown H4 type %u", rx.type);
+				rx.type = 0U;
+				continue;
+			}
+
+			rx.hdr_read = 0U;
+			continue;
+		}
+
+		if (rx.hdr_read < rx.hdr_len) {
+			chunk = MIN(len, rx.hdr_len - rx.hdr_read);
+			memcpy(&rx.hdr[rx.hdr_read], data, chunk);
+			rx.hdr_read += chunk;
+			data += chunk;
+			len -= chunk;
+
+			if (rx.hdr_read == rx.hdr_len) {
+				h4_rx_hdr_done();
+			}
+
+			continue;
+		}
+
+		chunk = MIN(len, rx.remaining);
+		if (rx.buf) {
+			net_buf_add_mem(rx.buf, data, chunk);
+		} else {
+			LOG_WRN("Discarded %zu bytes", chunk);
+		}
+
+		data += chunk;
+		len -= chunk;
+		rx.remaining -= chunk;
+
+		if (!rx.remaining) {
+			h4_rx_pkt_done();
+		}
+	}
+}
+
+static void uart_cb(struct uart_event *evt, void *user_data)
+{
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		k_sem_give(&tx_sem);
+		break;
+	case UART_TX_ABORTED:
+		LOG_ERR("TX aborted after %zu bytes", evt->data.tx.len);
+		k_sem_give(&tx_sem);
+		break;
+	case UART_RX_RDY:
+		h4_rx(&evt->data.rx.buf[evt->data.rx.offset],
+		      evt->data.rx.len);
+		break;
+	case UART_RX_BUF_REQUEST:
+		err = uart_rx_buf_rsp(hci_uart_dev, rx_buf[rx_next],
+				      sizeof(rx_buf[rx_next]));
+		if (err) {
+			LOG_ERR("RX buffer not provided (err %d)", err);
+		}
+		rx_next ^= 1U;
+		break;
+	case UART_RX_STOPPED:
+		LOG_ERR("RX stopped, reason %u", evt->data.rx_stop.reason);
+		break;
+	case UART_RX_DISABLED:
+		/* Keep receiving, whatever stopped the UART */
+		err = uart_rx_enable(hci_uart_dev, rx_buf[rx_next],
+				     sizeof(rx_buf[rx_next]), RX_TIMEOUT);
+		if (err) {
+			LOG_ERR("RX not enabled (err %d)", err);
+		}
+		rx_next ^= 1U;
+		break;
+	default:
+		break;
+	}
+}
+
+static void tx_thread(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		struct net_buf *buf;
+		int err;
+
+		/* Wait until a buffer is available */
+		buf = net_buf_get(&tx_queue, K_FOREVER);
+		/* Pass buffer to the stack */
+		err = bt_send(buf);
+		if (err) {
+			LOG_ERR("Unable to send (err %d)", err);
+			net_buf_unref(buf);
+		}
+
+		/* Give other threads a chance to run if tx_queue keeps getting
+		 * new data all the time.
+		 */
+		k_yield();
+	}
+}
+
+static void h4_flush(void)
+{
+	int err;
+
+	if (!tx_len) {
+		return;
+	}
+
+	/* Wait for the other buffer to be sent */
+	k_sem_take(&tx_sem, K_FOREVER);
+
+	err = uart_tx(hci_uart_dev, tx_buf[tx_cur], tx_len, K_FOREVER);
+	if (err) {
+		LOG_ERR("Failed to send (err %d)", err);
+		k_sem_give(&tx_sem);
+	}
+
+	tx_cur ^= 1U;
+	tx_len = 0;
+}
+
+static int h4_send(struct net_buf *buf)
+{
+	u8_t type;
+
+	LOG_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf),
+		    buf->len);
+
+	switch (bt_buf_get_type(buf)) {
+	case BT_BUF_ACL_IN:
+		type = H4_ACL;
+		break;
+	case BT_BUF_EVT:
+		type = H4_EVT;
+		break;
+	default:
+		LOG_ERR("Unknown type %u", bt_buf_get_type(buf));
+		net_buf_unref(buf);
+		return -EINVAL;
+	}
+
+	if (tx_len + 1 + buf->len > H4_TX_BUF_SIZE) {
+		h4_flush();
+	}
+
+	tx_buf[tx_cur][tx_len++] = type;
+	memcpy(&tx_buf[tx_cur][tx_len], buf->data, buf->len);
+	tx_len += buf->len;
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+void main(void)
+{
+	/* incoming events and data from the controller */
+	static K_FIFO_DEFINE(rx_queue);
+	int err;
+
+	LOG_DBG("Start");
+
+	/* Derived from DT's bt-c2h-uart chosen node */
+	hci_uart_dev = device_get_binding(CONFIG_BT_CTLR_TO_HOST_UART_DEV_NAME);
+	if (!hci_uart_dev) {
+		LOG_ERR("No UART device %s",
+			CONFIG_BT_CTLR_TO_HOST_UART_DEV_NAME);
+		return;
+	}
+
+	err = uart_callback_set(hci_uart_dev, uart_cb, NULL);
+	if (err) {
+		LOG_ERR("UART async API not supported (err %d)", err);
+		return;
+	}
+
+	/* Enable the raw interface, this will in turn open the HCI driver */
+	bt_enable_raw(&rx_queue);
+
+	/* Spawn the TX thread and start feeding commands and data to the
+	 * controller
+	 */
+	k_thread_create(&tx_thread_data, tx_thread_stack,
+			K_THREAD_STACK_SIZEOF(tx_thread_stack), tx_thread,
+			NULL, NULL, NULL, K_PRIO_COOP(7), 0, K_NO_WAIT);
+
+	rx_next = 1U;
+	err = uart_rx_enable(hci_uart_dev, rx_buf[0], sizeof(rx_buf[0]),
+			     RX_TIMEOUT);
+	if (err) {
+		LOG_ERR("RX not enabled (err %d)", err);
+		return;
+	}
+
+	while (1) {
+		struct net_buf *buf;
+
+		buf = net_buf_get(&rx_queue, K_NO_WAIT);
+		if (!buf) {
+			/* Nothing more to gather, send what is pending */
+			h4_flush();
+
+			buf = net_buf_get(&rx_queue, K_FOREVER);
+		}
+
+		err = h4_send(buf);
+		if (err) {
+			LOG_ERR("Failed to send");
+		}
+	}
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_latency_sample, LOG_LEVEL_DBG);
+
+#include <zephyr.h>
+#include <errno.h>
+#include <stdio.h>
+
+#include <net/socket.h>
+#include <net/net_if.h>
+#include <net/ethernet.h>
+#include <ptp_clock.h>
+
+#define PEER_PORT 4242
+#define ROUNDS 100
+#define REPLY_TIMEOUT_MS 1000
+#define ERRQUEUE_TRIES 10
+
+struct latency {
+	s64_t min;
+	s64_t max;
+	s64_t sum;
+	int count;
+};
+
+static struct latency tx_stack, rx_stack, wire;
+static char payload[64];
+
+static s64_t ptp_ns(const struct net_ptp_time *ts)
+{
+	return (s64_t)ts->second * NSEC_PER_SEC + ts->nanosecond;
+}
+
+static void latency_add(struct latency *l, s64_t ns)
+{
+	if (l->count == 0 || ns < l->min) {
+		l->min = ns;
+	}
+
+	if (l->count == 0 || ns > l->max) {
+		l->max = ns;
+	}
+
+	l->sum += ns;
+	l->count++;
+}
+
+static void latency_print(const char *name, struct latency *l)
+{
+	if (l->count == 0) {
+		printk("%-10s no samples\n", name);
+		return;
+	}
+
+	printk("%-10s min %lld ns avg %lld ns max %lld ns (%d samples)\n",
+	       name, l->min, l->sum / l->count, l->max, l->count);
+}
+
+/* The TX timestamp is queued once the driver reports the frame as sent,
+ * which may be a little after sendto() returned.
+ */
+static int get_tx_timestamp(int sock, struct net_ptp_time *ts)
+{
+	u8_t control[CMSG_SPACE(sizeof(struct net_ptp_time))];
+	struct msghdr msg = { 0 };
+	struct cmsghdr *cmsg;
+	int i;
+
+	for (i = 0; i < ERRQUEUE_TRIES; i++) {
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		if (recvmsg(sock, &msg, MSG_ERRQUEUE) == 0) {
+			break;
+		}
+
+		if (errno != EAGAIN) {
+			return -errno;
+		}
+
+		k_sleep(K_MSEC(1));
+	}
+
+	if (i == ERRQUEUE_TRIES) {
+		return -EAGAIN;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET &&
+		    cmsg->cmsg_type == SCM_TIMESTAMPING) {
+			memcpy(ts, CMSG_DATA(cmsg), sizeof(*ts));
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static int recv_reply(int sock, struct net_ptp_time *ts)
+{
+	u8_t control[CMSG_SPACE(sizeof(struct net_ptp_time))];
+	struct iovec iov = {
+		.iov_base = payload,
+		.iov_len = sizeof(payload),
+	};
+	struct msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+		.msg_control = control,
+		.msg_controllen = sizeof(control),
+	};
+	struct pollfd fds = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+	struct cmsghdr *cmsg;
+
+	if (poll(&fds, 1, REPLY_TIMEOUT_MS) <= 0) {
+		return -ETIMEDOUT;
+	}
+
+	if (recvmsg(sock, &msg, 0) < 0) {
+		return -errno;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET &&
+		    cmsg->cmsg_type == SCM_TIMESTAMPING) {
+			memcpy(ts, CMSG_DATA(cmsg), sizeof(*ts));
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static void measure(int sock, struct device *clk, struct sockaddr_in *peer)
+{
+	struct net_ptp_time before, tx_ts, rx_ts, after;
+	int ret;
+
+	ptp_clock_get(clk, &before);
+
+	if (sendto(sock, payload, sizeof(payload), 0,
+		   (struct sockaddr *)peer, sizeof(*peer)) < 0) {
+		LOG_ERR("Cannot send (%d)", -errno);
+		return;
+	}
+
+	ret = get_tx_timestamp(sock, &tx_ts);
+	if (ret < 0) {
+		LOG_ERR("No TX timestamp (%d)", ret);
+		return;
+	}
+
+	latency_add(&tx_stack, ptp_ns(&tx_ts) - ptp_ns(&before));
+
+	ret = recv_reply(sock, &rx_ts);
+	if (ret < 0) {
+		LOG_WRN("No reply (%d)", ret);
+		return;
+	}
+
+	ptp_clock_get(clk, &after);
+
+	latency_add(&rx_stack, ptp_ns(&after) - ptp_ns(&rx_ts));
+	latency_add(&wire, ptp_ns(&rx_ts) - ptp_ns(&tx_ts));
+}
+
+void main(void)
+{
+	struct sockaddr_in peer = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PEER_PORT),
+	};
+	int flags = SOF_TIMESTAMPING_TX_HARDWARE |
+		    SOF_TIMESTAMPING_RX_HARDWARE;
+	struct device *clk;
+	int sock, i;
+
+	clk = net_eth_get_ptp_clock(net_if_get_default());
+	if (!clk) {
+		LOG_ERR("Default interface has no PTP clock");
+		return;
+	}
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_PEER_IPV4_ADDR, &peer.sin_addr);
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		LOG_ERR("Cannot create socket (%d)", -errno);
+		return;
+	}
+
+	if (setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPING, &flags,
+		       sizeof(flags)) < 0) {
+		LOG_ERR("Cannot enable timestamping (%d)", -errno);
+		close(sock);
+		return;
+	}
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = 'a' + i % 26;
+	}
+
+	LOG_INF("Sending %d datagrams to %s:%d", ROUNDS,
+		CONFIG_NET_CONFIG_PEER_IPV4_ADDR, PEER_PORT);
+
+	for (i = 0; i < ROUNDS; i++) {
+		measure(sock, clk, &peer);
+	}
+
+	close(sock);
+
+	latency_print("TX stack", &tx_stack);
+	latency_print("RX stack", &rx_stack);
+	latency_print("Wire RTT", &wire);
+}
@@ -19,12 +19,7 @@ static int dummy_open(struct device *dev)
 
 	printk("open()\n");
 
-	/* Make sure parent is resumed */
-	ret = device_pm_get_sync(parent);
-	if (ret < 0) {
-		return ret;
-	}
-
+	/* The parent is resumed first */
 	ret = device_pm_get(dev);
 	if (ret < 0) {
 		return ret;
@@ -85,11 +80,6 @@ static int dummy_close(struct device *dev)
 		printk("Async suspend request ququed\n");
 	}
 
-	/* Parent can be suspended */
-	if (parent) {
-		device_pm_put(parent);
-	}
-
 	return ret;
 }
 
@@ -154,6 +144,8 @@ int dummy_init(struct device *dev)
 		printk("parent not found\n");
 	}
 
+	/* Keep the parent active while the device is */
+	device_pm_parent_set(dev, parent);
 	device_pm_enable(dev);
 	device_power_state = DEVICE_PM_ACTIVE_STATE;
 
@@ -31,7 +31,8 @@ old_alias_names = False
 regs_config = {
     'zephyr,sram'  : 'DT_SRAM',
     'zephyr,ccm'   : 'DT_CCM',
-    'zephyr,dtcm'  : 'DT_DTCM'
+    'zephyr,dtcm'  : 'DT_DTCM',
+    'zephyr,itcm'  : 'DT_ITCM'
 }
 
 name_config = {
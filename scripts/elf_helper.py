@@ -37,7 +37,6 @@ DW_OP_addr = 0x3
 DW_OP_fbreg = 0x91
 STACK_TYPE = "_k_thread_stack_element"
 thread_counter = 0
-sys_mutex_counter = 0
 futex_counter = 0
 
 # Global type environment. Populated by pass 1.
@@ -56,7 +55,6 @@ scr = os.path.basename(sys.argv[0])
 class KobjectInstance:
     def __init__(self, type_obj, addr):
         global thread_counter
-        global sys_mutex_counter
         global futex_counter
 
         self.addr = addr
@@ -71,9 +69,6 @@ class KobjectInstance:
             # permissions to other kernel objects
             self.data = thread_counter
             thread_counter = thread_counter + 1
-        elif self.type_obj.name == "sys_mutex":
-            self.data = "(u32_t)(&kernel_mutexes[%d])" % sys_mutex_counter
-            sys_mutex_counter += 1
         elif self.type_obj.name == "k_futex":
             self.data = "(u32_t)(&futex_data[%d])" % futex_counter
             futex_counter += 1
@@ -582,8 +577,5 @@ class ElfHelper:
     def get_thread_counter(self):
         return thread_counter
 
-    def get_sys_mutex_counter(self):
-        return sys_mutex_counter
-
     def get_futex_counter(self):
         return futex_counter
@@ -81,12 +81,12 @@ kobjects = OrderedDict ([
     ("k_queue", (None, False)),
     ("k_poll_signal", (None, False)),
     ("k_sem", (None, False)),
+    ("k_event", ("CONFIG_EVENTS", False)),
     ("k_stack", (None, False)),
     ("k_thread", (None, False)),
     ("k_timer", (None, False)),
     ("_k_thread_stack_element", (None, False)),
     ("device", (None, False)),
-    ("sys_mutex", (None, True)),
     ("k_futex", (None, True))
 ])
 
@@ -163,15 +163,6 @@ void z_object_wordlist_foreach(_wordlist_cb_func_t func, void *context)
 
 def write_gperf_table(fp, eh, objs, static_begin, static_end):
     fp.write(header)
-    num_mutexes = eh.get_sys_mutex_counter()
-    if num_mutexes != 0:
-        fp.write("static struct k_mutex kernel_mutexes[%d] = {\n" % num_mutexes)
-        for i in range(num_mutexes):
-            fp.write("_K_MUTEX_INITIALIZER(kernel_mutexes[%d])" % i)
-            if i != num_mutexes - 1:
-                fp.write(", ")
-        fp.write("};\n")
-
     num_futex = eh.get_futex_counter()
     if (num_futex != 0):
         fp.write("static struct z_futex_data futex_data[%d] = {\n" % num_futex)
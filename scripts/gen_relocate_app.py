@@ -21,6 +21,15 @@
 # ignored.
 # NOTE: multiple regions can be appended together like SRAM2_DATA_BSS
 # this will place data and bss inside SRAM2
+#
+# Single functions and variables can be relocated as well, by listing their
+# names in a profile file, one per line, and passing the file with its
+# memory region:
+# python3 gen_relocate_app.py -p ITCM_TEXT:/path/hot_functions.txt
+# The section of each symbol is looked up in all object files, so this
+# requires the code to be built with -ffunction-sections and
+# -fdata-sections. Data and bss relocated to DTCM get section and symbol
+# names of their own, as the SoC linker script already has DTCM sections.
 
 import sys
 import argparse
@@ -168,6 +177,66 @@ def find_sections(filename, full_list_of_sections):
     return full_list_of_sections
 
 
+def section_kind(section_name):
+    for kind in ["text", "rodata", "data", "bss"]:
+        if section_name.startswith("." + kind + "."):
+            return kind
+    return None
+
+
+def read_profile(filename):
+    symbols = []
+    with open(filename) as profile:
+        for line in profile:
+            line = line.split("#")[0].strip()
+            if line:
+                symbols.append(line.split()[0])
+    return symbols
+
+
+# Find the input sections holding the given symbols in all object files
+def find_symbol_sections(searchpath, symbols):
+    wanted = set(symbols)
+    found = set()
+    full_list_of_sections = {"text":[], "rodata":[], "data":[], "bss":[]}
+
+    for dirpath, _, files in os.walk(searchpath):
+        for filename in files:
+            if not filename.endswith(".obj"):
+                continue
+
+            with open(os.path.join(dirpath, filename), 'rb') as obj_file_desc:
+                obj = ELFFile(obj_file_desc)
+                symtab = obj.get_section_by_name(".symtab")
+                if not symtab:
+                    continue
+
+                for symbol in symtab.iter_symbols():
+                    if symbol.name not in wanted:
+                        continue
+
+                    # Undefined and common symbols have no section here
+                    shndx = symbol.entry["st_shndx"]
+                    if not isinstance(shndx, int):
+                        continue
+
+                    section_name = obj.get_section(shndx).name
+                    kind = section_kind(section_name)
+                    if not kind:
+                        warnings.warn("Symbol " + symbol.name + " in section " +
+                                      section_name + " cannot be relocated")
+                        continue
+
+                    found.add(symbol.name)
+                    if section_name not in full_list_of_sections[kind]:
+                        full_list_of_sections[kind].append(section_name)
+
+    for symbol in sorted(wanted - found):
+        warnings.warn("Symbol: " + symbol + " Not found")
+
+    return full_list_of_sections
+
+
 def assign_to_correct_mem_region(memory_type,
                                  full_list_of_sections, complete_list_of_sections):
     all_regions = False
@@ -356,6 +425,8 @@ def parse_args():
                         help="Output sram data ld file")
     parser.add_argument("-b", "--output_sram_bss", required=False,
                         help="Output sram bss ld file")
+    parser.add_argument("-p", "--profiles", required=False, default='',
+                        help="memory type:profile file string")
     parser.add_argument("-c", "--output_code", required=False,
                         help="Output relocation code header file")
     parser.add_argument("-v", "--verbose", action="count", default=0,
@@ -379,10 +450,12 @@ def get_obj_filename(searchpath, filename):
 def create_dict_wrt_mem():
 #need to support wild card *
     rel_dict = dict()
-    if args.input_rel_dict == '':
+    if args.input_rel_dict == '' and args.profiles == '':
         print("Disable CONFIG_CODE_DATA_RELOCATION if no file needs relocation")
         sys.exit(1)
     for line in args.input_rel_dict.split(';'):
+        if line == '':
+            continue
         mem_region, file_name = line.split(':')
 
         file_name_list = glob.glob(file_name)
@@ -430,6 +503,30 @@ def main():
                                                                  full_list_of_sections,
                                                                  complete_list_of_sections)
 
+    #then the symbols listed in the profiles
+    for line in args.profiles.split(';'):
+        if line == '':
+            continue
+        memory_type, profile = line.split(':')
+        full_list_of_sections = find_symbol_sections(searchpath,
+                                                     read_profile(profile))
+        if args.verbose:
+            print("Memory region ", memory_type, " Selected for sections:",
+                  full_list_of_sections)
+        complete_list_of_sections = assign_to_correct_mem_region(memory_type,
+                                                                 full_list_of_sections,
+                                                                 complete_list_of_sections)
+
+    # The SoC linker script already uses the DTCM section and symbol names.
+    # It aliases the DTCM memory region as DTCM_RELOC for relocated data.
+    if "DTCM" in complete_list_of_sections:
+        dtcm = complete_list_of_sections.pop("DTCM")
+        if dtcm["text"] or dtcm["rodata"]:
+            warnings.warn("Code and read-only data cannot be relocated to DTCM")
+            dtcm["text"] = []
+            dtcm["rodata"] = []
+        complete_list_of_sections["DTCM_RELOC"] = dtcm
+
     generate_linker_script(linker_file, sram_data_linker_file,
                        sram_bss_linker_file, complete_list_of_sections)
 
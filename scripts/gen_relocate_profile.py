@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2019 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Turn a program counter sampler dump into a relocation profile.
+
+Reads the "pc_sampler:" lines printed by pc_sampler_dump() (enable
+CONFIG_TRACING_PC_SAMPLER) from a log of a profiling run, attributes the
+samples to the functions of the ELF file of that run and writes the names
+of the hottest ones, one per line, for zephyr_code_relocate_profile().
+
+Functions are taken by decreasing number of samples until the given share
+of all samples is covered, skipping those which would not fit in the size
+budget, usually the size of the ITCM. Functions running before the
+relocated code is copied to RAM are never selected. Names of variables to
+relocate along, such as _kernel, can be added with --data.
+
+Example:
+    gen_relocate_profile.py -e build/zephyr/zephyr.elf -l run.log \\
+        -s 16384 -o hot_functions.txt
+"""
+
+import argparse
+import bisect
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+# Called before or while data_copy_xip_relocation() copies the code
+EARLY_FUNCTIONS = [
+    "__start", "z_arm_reset", "__reset", "z_arm_prep_c", "_PrepC",
+    "z_data_copy", "z_bss_zero", "data_copy_xip_relocation",
+    "bss_zeroing_relocation", "memcpy", "memset", "z_early_memcpy",
+    "z_early_memset", "SystemInit",
+]
+
+SAMPLE_RE = re.compile(r"pc_sampler: 0x([0-9a-fA-F]+) (\d+)")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-e", "--elf", required=True,
+                        help="ELF file of the profiled image")
+    parser.add_argument("-l", "--log", required=True, nargs="+",
+                        help="Logs holding the pc_sampler dumps")
+    parser.add_argument("-o", "--output", required=True,
+                        help="Output profile file")
+    parser.add_argument("-c", "--coverage", type=float, default=0.9,
+                        help="Share of the samples to cover, default 0.9")
+    parser.add_argument("-s", "--max-size", type=int, default=0,
+                        help="Size budget of the selected code in bytes")
+    parser.add_argument("-x", "--exclude", action="append", default=[],
+                        help="Function never to select, can be repeated")
+    parser.add_argument("-d", "--data", action="append", default=[],
+                        help="Variable to add to the profile, can be repeated")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="Print the selected functions")
+    return parser.parse_args()
+
+
+def read_functions(elf_file):
+    functions = []
+    with open(elf_file, "rb") as f:
+        elf = ELFFile(f)
+        symtab = elf.get_section_by_name(".symtab")
+        if not symtab:
+            sys.exit("No symbol table in " + elf_file)
+
+        for symbol in symtab.iter_symbols():
+            if (symbol.entry["st_info"]["type"] == "STT_FUNC" and
+                    symbol.entry["st_size"] > 0):
+                # Clear the Thumb bit
+                addr = symbol.entry["st_value"] & ~1
+                functions.append((addr, symbol.entry["st_size"],
+                                  symbol.name))
+
+    functions.sort()
+    return functions
+
+
+def read_samples(logs):
+    samples = {}
+    for log in logs:
+        with open(log, errors="replace") as f:
+            for line in f:
+                match = SAMPLE_RE.search(line)
+                if match:
+                    addr = int(match.group(1), 16)
+                    samples[addr] = samples.get(addr, 0) + int(match.group(2))
+    return samples
+
+
+def main():
+    args = parse_args()
+    functions = read_functions(args.elf)
+    samples = read_samples(args.log)
+    starts = [f[0] for f in functions]
+
+    hits = {}
+    total = 0
+    for addr, count in samples.items():
+        total += count
+        i = bisect.bisect_right(starts, addr) - 1
+        if i >= 0 and addr < functions[i][0] + functions[i][1]:
+            hits[functions[i]] = hits.get(functions[i], 0) + count
+
+    if not total:
+        sys.exit("No pc_sampler samples found")
+
+    excluded = set(EARLY_FUNCTIONS + args.exclude)
+    selected = []
+    covered = 0
+    size = 0
+    for function, count in sorted(hits.items(), key=lambda h: -h[1]):
+        if covered >= args.coverage * total:
+            break
+        if function[2] in excluded:
+            continue
+        if args.max_size and size + function[1] > args.max_size:
+            continue
+        selected.append((function, count))
+        covered += count
+        size += function[1]
+
+    with open(args.output, "w") as f:
+        f.write("# {} of {} samples in {} bytes\n".format(covered, total,
+                                                         size))
+        for (_, fsize, name), count in selected:
+            f.write("{:<40} # {} samples, {} bytes\n".format(name, count,
+                                                              fsize))
+        for name in args.data:
+            f.write("{}\n".format(name))
+
+    if args.verbose:
+        for (_, fsize, name), count in selected:
+            print("{:<40} {:8} {:6}".format(name, count, fsize))
+        print("{:.1%} of the samples in {} bytes".format(covered / total,
+                                                           size))
+
+
+if __name__ == "__main__":
+    main()
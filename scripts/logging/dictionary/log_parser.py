@@ -0,0 +1,292 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2019 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Decode the output of a logger backend built with CONFIG_LOG_DICTIONARY.
+
+Messages are sent by the target as binary frames holding the address of the
+format string and the raw arguments. The strings are looked up in the
+zephyr.elf of the same build, which serves as the dictionary, and the
+messages are formatted on the host.
+
+Frame layout, multi-byte fields in target byte order, pointers and
+arguments are target words:
+
+    STD:     A5 00 ids:u16 timestamp:u32 nargs:u8 fmt:ptr args:word[nargs]
+             strdup_mask:u16 strings (NUL terminated, one per mask bit)
+    HEXDUMP: A5 01 ids:u16 timestamp:u32 str:ptr length:u16 data
+    RAW:     A5 02 length:u16 data
+    DROPPED: A5 03 count:u32
+
+ids is level << 13 | domain_id << 10 | source_id.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+SYNC = 0xA5
+FRAME_STD = 0
+FRAME_HEXDUMP = 1
+FRAME_RAW = 2
+FRAME_DROPPED = 3
+
+LEVELS = [None, "err", "wrn", "inf", "dbg"]
+
+HEXDUMP_BYTES_IN_LINE = 8
+
+FMT_RE = re.compile(r"%([-+ #0]*)(\d+|\*)?(\.\d+)?(hh|h|ll|l|z|j|t)?"
+                    r"([diouxXcsp%])")
+
+
+class Dictionary:
+    def __init__(self, elf_file):
+        self.elf = ELFFile(open(elf_file, "rb"))
+        self.endian = "<" if self.elf.little_endian else ">"
+        self.ptr_size = self.elf.elfclass // 8
+        self.ptr_fmt = self.endian + ("Q" if self.ptr_size == 8 else "I")
+        self.sections = [s for s in self.elf.iter_sections()
+                         if s["sh_type"] != "SHT_NOBITS" and
+                         s["sh_addr"] != 0]
+        self.sources = self._sources_get()
+
+    def _symbols_get(self):
+        syms = {}
+        for section in self.elf.iter_sections():
+            if isinstance(section, SymbolTableSection):
+                for sym in section.iter_symbols():
+                    syms.setdefault(sym.name, sym)
+        return syms
+
+    def read(self, addr, size):
+        for section in self.sections:
+            start = section["sh_addr"]
+            if start <= addr < start + section["sh_size"]:
+                offset = addr - start
+                return section.data()[offset:offset + size]
+        return None
+
+    def string(self, addr):
+        for section in self.sections:
+            start = section["sh_addr"]
+            if start <= addr < start + section["sh_size"]:
+                data = section.data()
+                offset = addr - start
+                end = data.find(b"\0", offset)
+                if end < 0:
+                    end = len(data)
+                return data[offset:end].decode("utf-8", "replace")
+        return "<unknown string 0x%x>" % addr
+
+    def _sources_get(self):
+        syms = self._symbols_get()
+        if "__log_const_start" not in syms:
+            sys.exit("%s has no logger sources" % self.elf.stream.name)
+
+        start = syms["__log_const_start"]["st_value"]
+        end = syms["__log_const_end"]["st_value"]
+
+        # Entries are struct log_source_const_data, take the size of the
+        # instance symbols as it depends on the architecture.
+        stride = 2 * self.ptr_size
+        for sym in syms.values():
+            if sym["st_value"] == start and sym["st_size"] and \
+               sym.name.startswith("log_const_"):
+                stride = sym["st_size"]
+                break
+
+        names = []
+        for addr in range(start, end, stride):
+            name_addr = struct.unpack(self.ptr_fmt,
+                                      self.read(addr, self.ptr_size))[0]
+            names.append(self.string(name_addr))
+        return names
+
+
+class Decoder:
+    def __init__(self, dictionary, freq):
+        self.dict = dictionary
+        self.freq = freq
+        self.buf = b""
+        self.e = dictionary.endian
+
+    def _take(self, size):
+        if len(self.buf) < size:
+            raise EOFError
+        data = self.buf[:size]
+        self.buf = self.buf[size:]
+        return data
+
+    def _unpack(self, fmt):
+        return struct.unpack(self.e + fmt,
+                             self._take(struct.calcsize(self.e + fmt)))[0]
+
+    def _ptr(self):
+        return struct.unpack(self.dict.ptr_fmt,
+                             self._take(self.dict.ptr_size))[0]
+
+    def _cstring(self):
+        end = self.buf.find(b"\0")
+        if end < 0:
+            raise EOFError
+        return self._take(end + 1)[:-1].decode("utf-8", "replace")
+
+    def _prefix(self, ids, timestamp):
+        level = ids >> 13
+        source_id = ids & 0x3ff
+        if source_id < len(self.dict.sources):
+            source = self.dict.sources[source_id]
+        else:
+            source = "<unknown source %d>" % source_id
+
+        if self.freq:
+            us = timestamp * 1000000 // self.freq
+            stamp = "[%02d:%02d:%02d.%03d,%03d]" % (
+                us // 3600000000, us // 60000000 % 60,
+                us // 1000000 % 60, us // 1000 % 1000, us % 1000)
+        else:
+            stamp = "[%08d]" % timestamp
+
+        return "%s <%s> %s: " % (stamp, LEVELS[level & 0x7], source)
+
+    def _format(self, fmt, raw_args, strings):
+        word = self.dict.ptr_size * 8
+        args = list(enumerate(raw_args))
+
+        def conv(m):
+            flags, width, prec, length, spec = m.groups()
+            if spec == "%":
+                return "%"
+            if width == "*":
+                width = str(args.pop(0)[1] if args else 0)
+            if not args:
+                return m.group(0)
+
+            idx, value = args.pop(0)
+            bits = word
+            if length == "ll" and word == 32:
+                if args:
+                    value |= args.pop(0)[1] << 32
+                bits = 64
+
+            if spec == "s":
+                if idx in strings:
+                    value = strings[idx]
+                else:
+                    value = self.dict.string(value)
+            elif spec == "p":
+                return "0x%x" % value
+            elif spec == "c":
+                value = chr(value & 0xff)
+            elif spec in "di":
+                if value & (1 << (bits - 1)):
+                    value -= 1 << bits
+            elif spec == "u":
+                spec = "d"
+
+            pyfmt = "%" + flags + (width or "") + (prec or "") + spec
+            return pyfmt % value
+
+        return FMT_RE.sub(conv, fmt)
+
+    def _hexdump(self, prefix_len, data):
+        lines = []
+        for i in range(0, len(data), HEXDUMP_BYTES_IN_LINE):
+            chunk = data[i:i + HEXDUMP_BYTES_IN_LINE]
+            hexs = " ".join("%02x" % b for b in chunk)
+            text = "".join(chr(b) if 32 <= b < 127 else "." for b in chunk)
+            lines.append("\n" + " " * prefix_len +
+                         "%-*s|%s" % (HEXDUMP_BYTES_IN_LINE * 3, hexs, text))
+        return "".join(lines)
+
+    def _frame(self):
+        while self.buf and self.buf[0] != SYNC:
+            self.buf = self.buf[1:]
+
+        self._take(1)
+        frame = self._unpack("B")
+
+        if frame == FRAME_DROPPED:
+            return "--- %d messages dropped ---\n" % self._unpack("I")
+
+        if frame == FRAME_RAW:
+            length = self._unpack("H")
+            return self._take(length).decode("utf-8", "replace")
+
+        ids = self._unpack("H")
+        timestamp = self._unpack("I")
+        prefix = self._prefix(ids, timestamp)
+
+        if frame == FRAME_HEXDUMP:
+            metadata = self.dict.string(self._ptr())
+            length = self._unpack("H")
+            data = self._take(length)
+            return prefix + metadata + self._hexdump(len(prefix), data) + "\n"
+
+        if frame != FRAME_STD:
+            return ""
+
+        nargs = self._unpack("B")
+        fmt = self.dict.string(self._ptr())
+        args = [self._ptr() for _ in range(nargs)]
+        mask = self._unpack("H")
+        strings = {}
+        for i in range(nargs):
+            if mask & (1 << i):
+                strings[i] = self._cstring()
+
+        return prefix + self._format(fmt, args, strings) + "\n"
+
+    def feed(self, data):
+        self.buf += data
+        out = []
+        while self.buf:
+            saved = self.buf
+            try:
+                out.append(self._frame())
+            except EOFError:
+                self.buf = saved
+                break
+        return "".join(out)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="zephyr.elf of the build")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="binary log capture or serial device, "
+                             "stdin by default")
+    parser.add_argument("-f", "--freq", type=int, default=0,
+                        help="timestamp frequency in Hz, raw timestamps "
+                             "are printed if not given")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    decoder = Decoder(Dictionary(args.elf), args.freq)
+
+    if args.input == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.input, "rb", buffering=0)
+
+    while True:
+        data = stream.read(256)
+        if not data:
+            break
+        sys.stdout.write(decoder.feed(data))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
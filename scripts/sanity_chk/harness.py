@@ -3,6 +3,8 @@ import re
 from collections import OrderedDict
 
 result_re = re.compile("(PASS|FAIL|SKIP) - (test_)?(.*)")
+# Printed by TC_PERF_RECORD(): value, unit and name of a measurement
+perf_re = re.compile(r"PERF: (\d+) (\S+) (.+)$")
 
 class Harness:
     GCOV_START = "GCOV_COVERAGE_DUMP_START"
@@ -22,6 +24,7 @@ class Harness:
         self.fault = False
         self.capture_coverage = False
         self.next_pattern = 0
+        self.perf = OrderedDict()
 
     def configure(self, instance):
         config = instance.test.harness_config
@@ -35,6 +38,12 @@ class Harness:
             self.repeat = config.get('repeat', 1)
             self.ordered = config.get('ordered', True)
 
+    def handle_perf(self, line):
+        match = perf_re.search(line)
+        if match:
+            self.perf[match.group(3).strip()] = (int(match.group(1)),
+                                                 match.group(2))
+
 class Console(Harness):
 
     def configure(self, instance):
@@ -68,6 +77,8 @@ class Console(Harness):
             if self.FAULT in line:
                 self.fault = True
 
+        self.handle_perf(line)
+
         if self.GCOV_START in line:
             self.capture_coverage = True
         elif self.GCOV_END in line:
@@ -102,6 +113,8 @@ class Test(Harness):
             if self.FAULT in line:
                 self.fault = True
 
+        self.handle_perf(line)
+
         if self.GCOV_START in line:
             self.capture_coverage = True
         elif self.GCOV_END in line:
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CRC-32 (IEEE 802.3) on the CRC calculation unit.
+ *
+ * The unit shifts data MSB first through the default polynomial
+ * 0x04C11DB7. Reversing the input bits and the output register makes it
+ * compute the usual reflected CRC, and loading the bit reversed running
+ * CRC as initial value lets each call continue a previous one.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <soc.h>
+#include <sys/crc.h>
+#include <sys/byteorder.h>
+
+/* Bytes processed with interrupts locked */
+#define CRC_CHUNK 64
+
+u32_t crc32_ieee_update(u32_t crc, const u8_t *data, size_t len)
+{
+	crc = ~crc;
+
+	while (len) {
+		size_t n = MIN(len, CRC_CHUNK);
+		unsigned int key;
+
+		len -= n;
+		key = irq_lock();
+
+		LL_CRC_SetInitialData(CRC, __RBIT(crc));
+		LL_CRC_ResetCRCCalculationUnit(CRC);
+
+		LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_WORD);
+		for (; n >= 4; n -= 4, data += 4) {
+			LL_CRC_FeedData32(CRC, sys_get_le32(data));
+		}
+
+		LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+		for (; n; n--) {
+			LL_CRC_FeedData8(CRC, *data++);
+		}
+
+		crc = LL_CRC_ReadData32(CRC);
+
+		irq_unlock(key);
+	}
+
+	return ~crc;
+}
+
+static int stm32_crc_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+	LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+
+	return 0;
+}
+
+SYS_INIT(stm32_crc_init, PRE_KERNEL_1, 0);
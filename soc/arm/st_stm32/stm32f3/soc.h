@@ -70,6 +70,11 @@
 #include <stm32f3xx_ll_adc.h>
 #endif
 
+#ifdef CONFIG_CRC32_IEEE_STM32
+#include <stm32f3xx_ll_bus.h>
+#include <stm32f3xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32F3_SOC_H_ */
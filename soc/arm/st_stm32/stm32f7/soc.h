@@ -72,6 +72,11 @@
 #include <stm32f7xx_ll_adc.h>
 #endif
 
+#ifdef CONFIG_CRC32_IEEE_STM32
+#include <stm32f7xx_ll_bus.h>
+#include <stm32f7xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32F7_SOC_H_ */
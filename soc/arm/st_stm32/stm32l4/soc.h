@@ -87,6 +87,11 @@
 #include <stm32l4xx_ll_adc.h>
 #endif
 
+#ifdef CONFIG_CRC32_IEEE_STM32
+#include <stm32l4xx_ll_bus.h>
+#include <stm32l4xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32L4X_SOC_H_ */
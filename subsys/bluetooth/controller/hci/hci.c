@@ -52,6 +52,11 @@
 #include "hci_user_ext.h"
 #endif /* CONFIG_BT_CTLR_USER_EXT */
 
+#if defined(CONFIG_BT_MAYFLY_STATS)
+#include "hal/ticker.h"
+#include "util/mayfly.h"
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 #define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_DRIVER)
 #define LOG_MODULE_NAME bt_ctlr_hci
 #include "common/log.h"
@@ -64,14 +69,19 @@
 static u16_t _opcode;
 
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
-/* Scan duplicate filter */
+/* Scan duplicate filter, hashed on the address. An address is looked up in
+ * the few entries following its hash, and replaces the oldest one of these
+ * when not found.
+ */
+#define DUP_PROBE_MAX MIN(4, CONFIG_BT_CTLR_DUP_FILTER_LEN)
+
 struct dup {
 	u8_t         mask;
 	bt_addr_le_t addr;
+	u32_t        time;
 };
 static struct dup dup_filter[CONFIG_BT_CTLR_DUP_FILTER_LEN];
-static s32_t dup_count;
-static u32_t dup_curr;
+static bool dup_enabled;
 #endif
 
 #if defined(CONFIG_BT_HCI_MESH_EXT)
@@ -260,7 +270,7 @@ static void reset(struct net_buf *buf, struct net_buf **evt)
 #endif
 
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
-	dup_count = -1;
+	dup_enabled = false;
 #endif
 
 	/* reset event masks */
@@ -1046,10 +1056,14 @@ static void le_set_scan_enable(struct net_buf *buf, struct net_buf **evt)
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
 	/* initialize duplicate filtering */
 	if (cmd->enable && cmd->filter_dup) {
-		dup_count = 0;
-		dup_curr = 0U;
+		u32_t i;
+
+		for (i = 0U; i < ARRAY_SIZE(dup_filter); i++) {
+			dup_filter[i].mask = 0U;
+		}
+		dup_enabled = true;
 	} else {
-		dup_count = -1;
+		dup_enabled = false;
 	}
 #endif
 	status = ll_scan_enable(cmd->enable);
@@ -1848,6 +1862,14 @@ static void vs_read_supported_commands(struct net_buf *buf,
 	/* Read Static Addresses, Read Key Hierarchy Roots */
 	rp->commands[1] |= BIT(0) | BIT(1);
 #endif /* CONFIG_BT_HCI_VS_EXT */
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+	/* Read Connection Auto Update */
+	rp->commands[1] |= BIT(5);
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+#if defined(CONFIG_BT_MAYFLY_STATS)
+	/* Read Mayfly Statistics */
+	rp->commands[1] |= BIT(6);
+#endif /* CONFIG_BT_MAYFLY_STATS */
 }
 
 static void vs_read_supported_features(struct net_buf *buf,
@@ -1981,6 +2003,77 @@ static void vs_read_key_hierarchy_roots(struct net_buf *buf,
 }
 #endif /* CONFIG_BT_HCI_VS_EXT */
 
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+static void vs_read_conn_auto_update(struct net_buf *buf,
+				     struct net_buf **evt)
+{
+	struct bt_hci_cp_vs_read_conn_auto_update *cmd = (void *)buf->data;
+	struct bt_hci_rp_vs_read_conn_auto_update *rp;
+	u16_t max_tx_octets;
+	u16_t max_rx_octets;
+	u8_t phy_upd_count;
+	u8_t crc_err_pct;
+	u16_t handle;
+	u8_t tx_phy;
+	u8_t rx_phy;
+	u8_t status;
+	u8_t rssi;
+
+	handle = sys_le16_to_cpu(cmd->handle);
+	status = ll_conn_auto_upd_get(handle, &tx_phy, &rx_phy,
+				      &max_tx_octets, &max_rx_octets, &rssi,
+				      &crc_err_pct, &phy_upd_count);
+
+	rp = hci_cmd_complete(evt, sizeof(*rp));
+	rp->status = status;
+	rp->handle = sys_cpu_to_le16(handle);
+
+	if (status) {
+		return;
+	}
+
+	rp->tx_phy = find_lsb_set(tx_phy);
+	rp->rx_phy = find_lsb_set(rx_phy);
+	rp->max_tx_octets = sys_cpu_to_le16(max_tx_octets);
+	rp->max_rx_octets = sys_cpu_to_le16(max_rx_octets);
+	/* 127 if not measured, as in HCI */
+	rp->rssi = (rssi == 0x7F) ? 127 : -rssi;
+	rp->crc_err_pct = crc_err_pct;
+	rp->phy_upd_count = phy_upd_count;
+}
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
+#if defined(CONFIG_BT_MAYFLY_STATS)
+static void vs_read_mayfly_stats(struct net_buf *buf, struct net_buf **evt)
+{
+	struct bt_hci_rp_vs_read_mayfly_stats *rp;
+	u8_t callee_id;
+
+	rp = hci_cmd_complete(evt, sizeof(*rp) +
+				   (MAYFLY_CALLEE_COUNT * sizeof(rp->s[0])));
+
+	rp->status = 0x00;
+	rp->num_callees = MAYFLY_CALLEE_COUNT;
+
+	for (callee_id = 0U; callee_id < MAYFLY_CALLEE_COUNT; callee_id++) {
+		struct bt_hci_vs_mayfly_stats *s = &rp->s[callee_id];
+		struct mayfly_stats stats;
+		u32_t latency_us;
+
+		mayfly_stats_get(callee_id, &stats);
+
+		s->run_count = sys_cpu_to_le32(stats.run_count);
+		latency_us = HAL_TICKER_TICKS_TO_US(stats.latency_max);
+		s->latency_max_us = sys_cpu_to_le32(latency_us);
+		latency_us = HAL_TICKER_TICKS_TO_US(stats.latency_last);
+		s->latency_last_us = sys_cpu_to_le32(latency_us);
+		s->depth = sys_cpu_to_le16(stats.depth);
+		s->depth_max = sys_cpu_to_le16(stats.depth_max);
+		s->yield_count = sys_cpu_to_le16(stats.yield_count);
+	}
+}
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 #if defined(CONFIG_BT_HCI_MESH_EXT)
 static void mesh_get_opts(struct net_buf *buf, struct net_buf **evt)
 {
@@ -2167,6 +2260,18 @@ int hci_vendor_cmd_handle_common(u16_t ocf, struct net_buf *cmd,
 		break;
 #endif /* CONFIG_BT_HCI_VS_EXT */
 
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+	case BT_OCF(BT_HCI_OP_VS_READ_CONN_AUTO_UPDATE):
+		vs_read_conn_auto_update(cmd, evt);
+		break;
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
+#if defined(CONFIG_BT_MAYFLY_STATS)
+	case BT_OCF(BT_HCI_OP_VS_READ_MAYFLY_STATS):
+		vs_read_mayfly_stats(cmd, evt);
+		break;
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 #if defined(CONFIG_BT_HCI_MESH_EXT)
 	case BT_OCF(BT_HCI_OP_VS_MESH):
 		mesh_cmd_handle(cmd, evt);
@@ -2336,46 +2441,84 @@ int hci_acl_handle(struct net_buf *buf, struct net_buf **evt)
 #endif /* CONFIG_BT_CONN */
 
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
+static inline u32_t dup_hash(u8_t const *const addr, u8_t type)
+{
+	u32_t hash = 2166136261U ^ type;
+	u8_t i;
+
+	/* FNV-1a */
+	for (i = 0U; i < BDADDR_SIZE; i++) {
+		hash ^= addr[i];
+		hash *= 16777619U;
+	}
+
+	return hash % CONFIG_BT_CTLR_DUP_FILTER_LEN;
+}
+
 static inline bool dup_found(struct pdu_adv *adv)
 {
+	struct dup *oldest = NULL;
+	u32_t now;
+	u32_t idx;
+	u8_t i;
+
 	/* check for duplicate filtering */
-	if (dup_count >= 0) {
-		int i;
-
-		for (i = 0; i < dup_count; i++) {
-			if (!memcmp(&adv->adv_ind.addr[0],
-				    &dup_filter[i].addr.a.val[0],
-				    sizeof(bt_addr_t)) &&
-			    adv->tx_addr == dup_filter[i].addr.type) {
-
-				if (dup_filter[i].mask & BIT(adv->type)) {
-					/* duplicate found */
-					return true;
-				}
-				/* report different adv types */
-				dup_filter[i].mask |= BIT(adv->type);
+	if (!dup_enabled) {
+		return false;
+	}
+
+	now = k_uptime_get_32();
+	idx = dup_hash(&adv->adv_ind.addr[0], adv->tx_addr);
+
+	for (i = 0U; i < DUP_PROBE_MAX; i++) {
+		struct dup *dup = &dup_filter[idx];
+
+		if (!dup->mask) {
+			/* free entry, address not in the filter */
+			oldest = dup;
+			break;
+		}
+
+		if (!memcmp(&adv->adv_ind.addr[0], &dup->addr.a.val[0],
+			    sizeof(bt_addr_t)) &&
+		    adv->tx_addr == dup->addr.type) {
+#if CONFIG_BT_CTLR_DUP_FILTER_PERIOD > 0
+			/* report again once per period */
+			if ((now - dup->time) >=
+			    CONFIG_BT_CTLR_DUP_FILTER_PERIOD) {
+				dup->mask = BIT(adv->type);
+				dup->time = now;
 				return false;
 			}
-		}
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_PERIOD > 0 */
 
-		/* insert into the duplicate filter */
-		memcpy(&dup_filter[dup_curr].addr.a.val[0],
-		       &adv->adv_ind.addr[0], sizeof(bt_addr_t));
-		dup_filter[dup_curr].addr.type = adv->tx_addr;
-		dup_filter[dup_curr].mask = BIT(adv->type);
+			if (dup->mask & BIT(adv->type)) {
+				/* duplicate found */
+				return true;
+			}
 
-		if (dup_count < CONFIG_BT_CTLR_DUP_FILTER_LEN) {
-			dup_count++;
-			dup_curr = dup_count;
-		} else {
-			dup_curr++;
+			/* report different adv types */
+			dup->mask |= BIT(adv->type);
+			return false;
 		}
 
-		if (dup_curr == CONFIG_BT_CTLR_DUP_FILTER_LEN) {
-			dup_curr = 0U;
+		if (!oldest || ((now - dup->time) > (now - oldest->time))) {
+			oldest = dup;
+		}
+
+		idx++;
+		if (idx == CONFIG_BT_CTLR_DUP_FILTER_LEN) {
+			idx = 0U;
 		}
 	}
 
+	/* insert into the duplicate filter */
+	memcpy(&oldest->addr.a.val[0], &adv->adv_ind.addr[0],
+	       sizeof(bt_addr_t));
+	oldest->addr.type = adv->tx_addr;
+	oldest->mask = BIT(adv->type);
+	oldest->time = now;
+
 	return false;
 }
 #endif /* CONFIG_BT_CTLR_DUP_FILTER_LEN > 0 */
@@ -2592,11 +2735,28 @@ static void le_advertising_report(struct pdu_data *pdu_data,
 	}
 	info_len = sizeof(struct bt_hci_evt_le_advertising_info) + data_len +
 		   sizeof(*prssi);
-	sep = meta_evt(buf, BT_HCI_EVT_LE_ADVERTISING_REPORT,
-		       sizeof(*sep) + info_len);
 
-	sep->num_reports = 1U;
-	adv_info = (void *)(((u8_t *)sep) + sizeof(*sep));
+#if defined(CONFIG_BT_CTLR_ADV_REPORT_BATCH)
+	if (buf->len) {
+		struct bt_hci_evt_hdr *hdr = (void *)buf->data;
+
+		/* Append to the reports of the event, hci_evt_batchable()
+		 * checked the room.
+		 */
+		sep = (void *)&buf->data[sizeof(*hdr) +
+				 sizeof(struct bt_hci_evt_le_meta_event)];
+		sep->num_reports++;
+		hdr->len += info_len;
+		adv_info = net_buf_add(buf, info_len);
+	} else
+#endif /* CONFIG_BT_CTLR_ADV_REPORT_BATCH */
+	{
+		sep = meta_evt(buf, BT_HCI_EVT_LE_ADVERTISING_REPORT,
+			       sizeof(*sep) + info_len);
+
+		sep->num_reports = 1U;
+		adv_info = (void *)(((u8_t *)sep) + sizeof(*sep));
+	}
 
 	adv_info->evt_type = c_adv_type[adv->type];
 
@@ -2624,6 +2784,47 @@ static void le_advertising_report(struct pdu_data *pdu_data,
 	*prssi = rssi;
 }
 
+#if defined(CONFIG_BT_CTLR_ADV_REPORT_BATCH)
+bool hci_evt_batchable(struct node_rx_pdu *node_rx, struct net_buf *buf)
+{
+	struct pdu_adv *adv = (void *)node_rx->pdu;
+	struct bt_hci_evt_le_meta_event *me;
+	struct bt_hci_evt_hdr *hdr;
+	u8_t info_len;
+
+	if (node_rx->hdr.type != NODE_RX_TYPE_REPORT) {
+		return false;
+	}
+
+#if defined(CONFIG_BT_CTLR_EXT_SCAN_FP)
+	/* Reported in a Direct Advertising Report event */
+	if (node_rx->hdr.rx_ftr.direct) {
+		return false;
+	}
+#endif /* CONFIG_BT_CTLR_EXT_SCAN_FP */
+
+	/* Previous reports dropped, start a new event */
+	if (!buf->len) {
+		return true;
+	}
+
+	hdr = (void *)buf->data;
+	me = (void *)&buf->data[sizeof(*hdr)];
+	if ((hdr->evt != BT_HCI_EVT_LE_META_EVENT) ||
+	    (me->subevent != BT_HCI_EVT_LE_ADVERTISING_REPORT)) {
+		return false;
+	}
+
+	info_len = sizeof(struct bt_hci_evt_le_advertising_info) + sizeof(s8_t);
+	if (adv->type != PDU_ADV_TYPE_DIRECT_IND) {
+		info_len += adv->len - BDADDR_SIZE;
+	}
+
+	return ((hdr->len + info_len) <= UINT8_MAX) &&
+	       (net_buf_tailroom(buf) >= info_len);
+}
+#endif /* CONFIG_BT_CTLR_ADV_REPORT_BATCH */
+
 #if defined(CONFIG_BT_CTLR_ADV_EXT)
 static void le_adv_ext_report(struct pdu_data *pdu_data,
 			      struct node_rx_pdu *node_rx,
@@ -3087,13 +3288,15 @@ static void encode_control(struct node_rx_pdu *node_rx,
 
 #if defined(CONFIG_BT_CTLR_PROFILE_ISR)
 	case NODE_RX_TYPE_PROFILE:
-		BT_INFO("l: %d, %d, %d; t: %d, %d, %d.",
+		BT_INFO("l: %d, %d, %d; t: %d, %d, %d; j: %d, %d.",
 			pdu_data->profile.lcur,
 			pdu_data->profile.lmin,
 			pdu_data->profile.lmax,
 			pdu_data->profile.cur,
 			pdu_data->profile.min,
-			pdu_data->profile.max);
+			pdu_data->profile.max,
+			pdu_data->profile.job_cur,
+			pdu_data->profile.job_max);
 		return;
 #endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 
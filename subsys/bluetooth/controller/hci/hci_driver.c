@@ -70,6 +70,154 @@ static sys_slist_t hbuf_pend;
 static s32_t hbuf_count;
 #endif
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+/* L2CAP basic header, length and channel id */
+#define RX_ZC_L2CAP_HDR_SIZE 4
+
+/* Rx node lent as the data of the buffer being allocated */
+static struct node_rx_pdu *rx_zc_node;
+static u32_t rx_zc_pdus;
+static u32_t rx_zc_octets;
+
+static void rx_zc_release(struct node_rx_pdu *node_rx)
+{
+	node_rx->hdr.type = NODE_RX_TYPE_DC_PDU;
+	node_rx->hdr.next = NULL;
+	ll_rx_mem_release((void **)&node_rx);
+}
+
+static u8_t *rx_zc_data_alloc(struct net_buf *buf, size_t *size,
+			      s32_t timeout)
+{
+	struct node_rx_pdu *node_rx = rx_zc_node;
+
+	ARG_UNUSED(timeout);
+
+	/* The link is not used while the node is lent to the Host, keep the
+	 * reference count of the data there.
+	 */
+	node_rx->hdr.ack_last = 1U;
+
+	return (u8_t *)node_rx;
+}
+
+static u8_t *rx_zc_data_ref(struct net_buf *buf, u8_t *data)
+{
+	struct node_rx_pdu *node_rx = (void *)data;
+
+	node_rx->hdr.ack_last++;
+
+	return data;
+}
+
+static void rx_zc_data_unref(struct net_buf *buf, u8_t *data)
+{
+	struct node_rx_pdu *node_rx = (void *)data;
+
+	if (--node_rx->hdr.ack_last) {
+		return;
+	}
+
+	/* Rx node memory is not thread-safe, defer the release to
+	 * recv_thread() when the Host frees the buffer from another thread.
+	 */
+	if (k_current_get() == &recv_thread_data) {
+		rx_zc_release(node_rx);
+	} else {
+		node_rx->hdr.type = NODE_RX_TYPE_DC_PDU_RELEASE;
+		k_fifo_put(&recv_fifo, node_rx);
+	}
+}
+
+static const struct net_buf_data_cb rx_zc_cb = {
+	.alloc = rx_zc_data_alloc,
+	.ref   = rx_zc_data_ref,
+	.unref = rx_zc_data_unref,
+};
+
+static const struct net_buf_data_alloc rx_zc_alloc = {
+	.cb = &rx_zc_cb,
+};
+
+/* Buffers count caps the Rx nodes held by the Host */
+static struct net_buf rx_zc_bufs[CONFIG_BT_CTLR_RX_ZERO_COPY_BUFFERS] __noinit;
+struct net_buf_pool rx_zc_pool __net_buf_align
+		__in_section(_net_buf_pool, static, rx_zc_pool) =
+	NET_BUF_POOL_INITIALIZER(rx_zc_pool, &rx_zc_alloc, rx_zc_bufs,
+				 CONFIG_BT_CTLR_RX_ZERO_COPY_BUFFERS, NULL);
+
+/* Encode the ACL header in place of the PDU header, and lend the Rx node to
+ * the Host as the buffer data.
+ */
+static struct net_buf *rx_zc_acl_encode(struct node_rx_pdu *node_rx)
+{
+	struct pdu_data *pdu_data = (void *)node_rx->pdu;
+	struct bt_hci_acl_hdr *acl;
+	struct net_buf *buf;
+	u16_t handle_flags;
+	size_t offset;
+	u8_t ll_id;
+	u8_t len;
+
+	/* The ACL header overlaps the PDU header */
+	ll_id = pdu_data->ll_id;
+	len = pdu_data->len;
+
+	switch (ll_id) {
+	case PDU_DATA_LLID_DATA_START:
+		/* Host reassembles an L2CAP frame into the tailroom of its
+		 * start fragment, copy these.
+		 */
+		if (len < RX_ZC_L2CAP_HDR_SIZE ||
+		    (sys_get_le16(pdu_data->lldata) +
+		     RX_ZC_L2CAP_HDR_SIZE) != len) {
+			return NULL;
+		}
+		handle_flags = bt_acl_handle_pack(node_rx->hdr.handle,
+						  BT_ACL_START);
+		break;
+
+	case PDU_DATA_LLID_DATA_CONTINUE:
+		handle_flags = bt_acl_handle_pack(node_rx->hdr.handle,
+						  BT_ACL_CONT);
+		break;
+
+	default:
+		return NULL;
+	}
+
+	offset = pdu_data->lldata - (u8_t *)node_rx;
+
+	rx_zc_node = node_rx;
+	buf = net_buf_alloc_len(&rx_zc_pool, offset + len, K_NO_WAIT);
+	if (!buf) {
+		/* Host already holds the maximum of Rx nodes */
+		return NULL;
+	}
+
+	bt_buf_set_type(buf, BT_BUF_ACL_IN);
+	net_buf_reserve(buf, offset - sizeof(*acl));
+
+	acl = (void *)net_buf_add(buf, sizeof(*acl));
+	acl->handle = sys_cpu_to_le16(handle_flags);
+	acl->len = sys_cpu_to_le16(len);
+	net_buf_add(buf, len);
+
+	rx_zc_pdus++;
+	rx_zc_octets += len;
+
+	BT_DBG("Zero-copy: %u PDUs, %u octets", rx_zc_pdus, rx_zc_octets);
+
+	return buf;
+}
+
+void hci_driver_rx_zc_stats_get(u32_t *pdus, u32_t *octets)
+{
+	*pdus = rx_zc_pdus;
+	*octets = rx_zc_octets;
+}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 /**
  * @brief Handover from Controller thread to Host thread
  * @details Execution context: Controller thread
@@ -135,6 +283,32 @@ static void prio_recv_thread(void *p1, void *p2, void *p3)
 	}
 }
 
+#if defined(CONFIG_BT_CTLR_ADV_REPORT_BATCH)
+/* Append the advertising reports queued behind the encoded one */
+static void report_batch(struct net_buf *buf)
+{
+	struct node_rx_pdu *node_rx;
+	u8_t count = 1U;
+
+	while (count < CONFIG_BT_CTLR_ADV_REPORT_BATCH_MAX) {
+		node_rx = k_fifo_peek_head(&recv_fifo);
+		if (!node_rx || !hci_evt_batchable(node_rx, buf)) {
+			break;
+		}
+
+		/* Only recv_thread() gets from recv_fifo */
+		(void)k_fifo_get(&recv_fifo, K_NO_WAIT);
+
+		hci_evt_encode(node_rx, buf);
+
+		node_rx->hdr.next = NULL;
+		ll_rx_mem_release((void **)&node_rx);
+
+		count++;
+	}
+}
+#endif /* CONFIG_BT_CTLR_ADV_REPORT_BATCH */
+
 static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 					  s8_t class)
 {
@@ -153,10 +327,25 @@ static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 		}
 		if (buf) {
 			hci_evt_encode(node_rx, buf);
+
+#if defined(CONFIG_BT_CTLR_ADV_REPORT_BATCH)
+			if (class == HCI_CLASS_EVT_DISCARDABLE &&
+			    hci_evt_batchable(node_rx, buf)) {
+				report_batch(buf);
+			}
+#endif /* CONFIG_BT_CTLR_ADV_REPORT_BATCH */
 		}
 		break;
 #if defined(CONFIG_BT_CONN)
 	case HCI_CLASS_ACL_DATA:
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+		buf = rx_zc_acl_encode(node_rx);
+		if (buf) {
+			/* Rx node released when the Host frees the buffer */
+			return buf;
+		}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 		/* generate ACL data */
 		buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
 		hci_acl_encode(node_rx, buf);
@@ -349,6 +538,14 @@ static void recv_thread(void *p1, void *p2, void *p3)
 
 #else
 		node_rx = k_fifo_get(&recv_fifo, K_FOREVER);
+
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+		/* Rx node freed by the Host from another thread */
+		if (node_rx->hdr.type == NODE_RX_TYPE_DC_PDU_RELEASE) {
+			rx_zc_release(node_rx);
+			node_rx = NULL;
+		}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
 #endif
 		BT_DBG("unblocked");
 
@@ -31,11 +31,17 @@ void hci_init(struct k_poll_signal *signal_host_buf);
 struct net_buf *hci_cmd_handle(struct net_buf *cmd, void **node_rx);
 void hci_evt_encode(struct node_rx_pdu *node_rx, struct net_buf *buf);
 s8_t hci_get_class(struct node_rx_pdu *node_rx);
+#if defined(CONFIG_BT_CTLR_ADV_REPORT_BATCH)
+bool hci_evt_batchable(struct node_rx_pdu *node_rx, struct net_buf *buf);
+#endif /* CONFIG_BT_CTLR_ADV_REPORT_BATCH */
 #if defined(CONFIG_BT_CONN)
 int hci_acl_handle(struct net_buf *acl, struct net_buf **evt);
 void hci_acl_encode(struct node_rx_pdu *node_rx, struct net_buf *buf);
 void hci_num_cmplt_encode(struct net_buf *buf, u16_t handle, u8_t num);
 #endif
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+void hci_driver_rx_zc_stats_get(u32_t *pdus, u32_t *octets);
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
 int hci_vendor_cmd_handle(u16_t ocf, struct net_buf *cmd,
 			  struct net_buf **evt);
 int hci_vendor_cmd_handle_common(u16_t ocf, struct net_buf *cmd,
@@ -86,6 +86,10 @@ void ll_tx_pwr_get(s8_t *min, s8_t *max);
 
 u8_t ll_apto_get(u16_t handle, u16_t *apto);
 u8_t ll_apto_set(u16_t handle, u16_t apto);
+u8_t ll_conn_evt_stats_get(u16_t handle, u32_t *count, u32_t *skipped);
+u8_t ll_conn_auto_upd_get(u16_t handle, u8_t *phy_tx, u8_t *phy_rx,
+			  u16_t *tx_octets, u16_t *rx_octets, u8_t *rssi,
+			  u8_t *crc_err_pct, u8_t *phy_upd_count);
 
 u32_t ll_length_req_send(u16_t handle, u16_t tx_octets, u16_t tx_time);
 void ll_length_default_get(u16_t *max_tx_octets, u16_t *max_tx_time);
@@ -3760,6 +3760,7 @@ static inline void isr_rx_conn(u8_t crc_ok, u8_t trx_done,
 	static u8_t s_max;
 	static u8_t s_prv;
 
+	u32_t ticks_job, ticks_job_max;
 	u8_t latency, elapsed, prv;
 	u32_t radio_tmr_end = 0U;
 	u32_t sample;
@@ -4052,6 +4053,12 @@ isr_rx_conn_terminate_exit:
 			pdu_data_rx->profile.cur = elapsed;
 			pdu_data_rx->profile.min = s_min;
 			pdu_data_rx->profile.max = s_max;
+			ticker_job_profile_get(RADIO_TICKER_INSTANCE_ID_RADIO,
+					       &ticks_job, &ticks_job_max);
+			pdu_data_rx->profile.job_cur =
+				HAL_TICKER_TICKS_TO_US(ticks_job);
+			pdu_data_rx->profile.job_max =
+				HAL_TICKER_TICKS_TO_US(ticks_job_max);
 			packet_rx_enqueue();
 		}
 	}
@@ -9,9 +9,12 @@
 
 #include "hal/ccm.h"
 #include "hal/radio.h"
+#include "hal/ticker.h"
 
 #include "util/memq.h"
 
+#include "ticker/ticker.h"
+
 #include "pdu.h"
 
 #include "lll.h"
@@ -23,6 +26,7 @@ static u8_t cputime_min = (u8_t) -1;
 static u8_t cputime_max;
 static u8_t cputime_prev;
 static u32_t timestamp_latency;
+static u32_t ticks_job_max;
 
 void lll_prof_latency_capture(void)
 {
@@ -59,6 +63,7 @@ void lll_prof_cputime_capture(void)
 
 void lll_prof_send(void)
 {
+	u32_t ticks_job, ticks_job_max_new;
 	u8_t latency, cputime, prev;
 	u8_t chg = 0U;
 
@@ -109,6 +114,14 @@ void lll_prof_send(void)
 		chg = 1U;
 	}
 
+	/* check for change in the worst-case ticker job execution time */
+	ticker_job_profile_get(TICKER_INSTANCE_ID_CTLR, &ticks_job,
+			       &ticks_job_max_new);
+	if (ticks_job_max_new != ticks_job_max) {
+		ticks_job_max = ticks_job_max_new;
+		chg = 1U;
+	}
+
 	/* generate event if any change */
 	if (chg) {
 		struct node_rx_pdu *rx;
@@ -132,6 +145,8 @@ void lll_prof_send(void)
 			p->cur = cputime;
 			p->min = cputime_min;
 			p->max = cputime_max;
+			p->job_cur = HAL_TICKER_TICKS_TO_US(ticks_job);
+			p->job_max = HAL_TICKER_TICKS_TO_US(ticks_job_max);
 
 			ull_rx_put(rx->hdr.link, rx);
 			ull_rx_sched();
@@ -14,6 +14,8 @@
  */
 #define EVENT_OVERHEAD_END_US         40
 #define EVENT_JITTER_US               16
+/* Worst-case radio Tx ready delay, for use before the radio is set up */
+#define EVENT_TX_READY_MAX_US         140
 
 #define EVENT_RX_JITTER_US(phy) 16    /* Radio Rx timing uncertainty */
 #define EVENT_RX_TO_US(phy) ((((((phy)&0x03) + 4)<<3)/BIT((((phy)&0x3)>>1))) + \
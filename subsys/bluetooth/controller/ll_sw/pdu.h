@@ -16,6 +16,11 @@
 #define PDU_AC_LL_HEADER_SIZE  (offsetof(struct pdu_adv, payload))
 /* Advertisement channel maximum PDU size */
 #define PDU_AC_SIZE_MAX        (PDU_AC_LL_HEADER_SIZE + PDU_AC_PAYLOAD_SIZE_MAX)
+/* Extended advertising, secondary channel maximum payload size */
+#define PDU_AC_EXT_PAYLOAD_SIZE_MAX 255
+/* Extended advertising, secondary channel maximum PDU size */
+#define PDU_AC_EXT_SIZE_MAX    (PDU_AC_LL_HEADER_SIZE + \
+				PDU_AC_EXT_PAYLOAD_SIZE_MAX)
 
 #define ACCESS_ADDR_SIZE        4
 #define ADVA_SIZE               6
@@ -503,6 +508,8 @@ struct profile {
 	u8_t cur;
 	u8_t min;
 	u8_t max;
+	u16_t job_cur;
+	u16_t job_max;
 } __packed;
 #endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 
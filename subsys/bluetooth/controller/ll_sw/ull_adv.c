@@ -608,8 +608,24 @@ u8_t ll_adv_enable(u8_t enable)
 
 		conn->connect_expire = 6;
 		conn->supervision_expire = 0;
+
 		conn->procedure_expire = 0;
 
+#if defined(CONFIG_BT_CTLR_CONN_EVT_STATS)
+		conn->evt_count = 0U;
+		conn->evt_skipped = 0U;
+#endif /* CONFIG_BT_CTLR_CONN_EVT_STATS */
+
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+		conn->auto_upd.evt_count = 0U;
+		conn->auto_upd.crc_err = 0U;
+		conn->auto_upd.crc_err_pct = 0U;
+		conn->auto_upd.rssi_avg = 0x7F;
+		conn->auto_upd.phy_upd_count = 0U;
+		conn->auto_upd.dle_done = 0U;
+		conn->auto_upd.phy_host = 0U;
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 		conn->common.fex_valid = 0;
 
 		conn->llcp_req = conn->llcp_ack = conn->llcp_type = 0;
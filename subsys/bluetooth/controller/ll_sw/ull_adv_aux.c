@@ -5,6 +5,7 @@
  */
 
 #include <string.h>
+#include <errno.h>
 
 #include <zephyr.h>
 #include <bluetooth/hci.h>
@@ -15,6 +16,7 @@
 #include "util/memq.h"
 
 #include "pdu.h"
+#include "ll.h"
 #include "lll.h"
 #include "lll_adv.h"
 #include "lll_conn.h"
@@ -22,16 +24,61 @@
 #include "ull_adv_types.h"
 #include "ull_adv_internal.h"
 
+/* Ext header length and flags octets, ADI and AuxPtr fields */
+#define AUX_HDR_SIZE     (1 + 1)
+#define AUX_ADI_SIZE     sizeof(struct ext_adv_adi)
+#define AUX_AUX_PTR_SIZE sizeof(struct ext_adv_aux_ptr)
+
+/* AD data carried by an AUX_ADV_IND, which has AdvA, and by each of the
+ * AUX_CHAIN_IND following it. Room for the AuxPtr is always reserved so that
+ * the fragment boundaries do not depend on the index of the last fragment.
+ */
+#define AUX_ADV_IND_DATA_MAX   (PDU_AC_EXT_PAYLOAD_SIZE_MAX - AUX_HDR_SIZE - \
+				BDADDR_SIZE - AUX_ADI_SIZE - AUX_AUX_PTR_SIZE)
+#define AUX_CHAIN_IND_DATA_MAX (PDU_AC_EXT_PAYLOAD_SIZE_MAX - AUX_HDR_SIZE - \
+				AUX_ADI_SIZE - AUX_AUX_PTR_SIZE)
+
+struct adv_aux_data {
+	u8_t  data[CONFIG_BT_CTLR_ADV_DATA_LEN_MAX];
+	u16_t len;
+	u16_t did:12;
+	u16_t frag:1;
+};
+
+static struct {
+	struct adv_aux_data ad;
+	struct adv_aux_data sr;
+	u8_t rand_addr[BDADDR_SIZE];
+	u8_t rand_addr_valid:1;
+} aux[BT_CTLR_ADV_MAX];
+
+static u8_t aux_data_set(struct adv_aux_data *d, u8_t op, u8_t len,
+			 u8_t *data);
+static void aux_reset(u8_t handle);
+
 u8_t ll_adv_aux_random_addr_set(u8_t handle, u8_t *addr)
 {
-	/* TODO: store in adv set instance */
+	if (handle >= BT_CTLR_ADV_MAX) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	memcpy(aux[handle].rand_addr, addr, BDADDR_SIZE);
+	aux[handle].rand_addr_valid = 1U;
+
 	return 0;
 }
 
 u8_t *ll_adv_aux_random_addr_get(u8_t handle, u8_t *addr)
 {
-	/* TODO: copy adv set instance addr into addr and/or return reference */
-	return NULL;
+	if ((handle >= BT_CTLR_ADV_MAX) || !aux[handle].rand_addr_valid) {
+		return NULL;
+	}
+
+	if (addr) {
+		memcpy(addr, aux[handle].rand_addr, BDADDR_SIZE);
+	}
+
+	return aux[handle].rand_addr;
 }
 
 u8_t ll_adv_aux_ad_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
@@ -42,15 +89,19 @@ u8_t ll_adv_aux_ad_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
 	struct ext_adv_hdr *h;
 	struct pdu_adv *prev;
 	struct pdu_adv *pdu;
+	u8_t status;
 	u8_t idx;
 
-	/* TODO: */
-
 	adv = ull_adv_set_get(handle);
 	if (!adv) {
 		return BT_HCI_ERR_CMD_DISALLOWED;
 	}
 
+	status = aux_data_set(&aux[handle].ad, op, len, data);
+	if (status) {
+		return status;
+	}
+
 	/* Dont update data if not extended advertising. */
 	prev = lll_adv_data_peek(&adv->lll);
 	if (prev->type != PDU_ADV_TYPE_EXT_IND) {
@@ -75,32 +126,195 @@ u8_t ll_adv_aux_ad_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
 u8_t ll_adv_aux_sr_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
 			    u8_t *data)
 {
-	/* TODO: */
-	return 0;
+	if (!ull_adv_set_get(handle)) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	return aux_data_set(&aux[handle].sr, op, len, data);
 }
 
 u16_t ll_adv_aux_max_data_length_get(void)
 {
-	/* TODO: return a Kconfig value */
-	return 0;
+	return CONFIG_BT_CTLR_ADV_DATA_LEN_MAX;
 }
 
 u8_t ll_adv_aux_set_count_get(void)
 {
-	/*  TODO: return a Kconfig value */
-	return 0;
+	return CONFIG_BT_ADV_SET;
 }
 
 u8_t ll_adv_aux_set_remove(u8_t handle)
 {
-	/* TODO: reset/release primary channel and Aux channel PDUs */
+	if (handle >= BT_CTLR_ADV_MAX) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	if (ull_adv_is_enabled(handle)) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	aux_reset(handle);
+
 	return 0;
 }
 
 u8_t ll_adv_aux_set_clear(void)
 {
-	/* TODO: reset/release all adv set primary channel and  Aux channel
-	 * PDUs
-	 */
+	u8_t handle;
+
+	for (handle = 0U; handle < BT_CTLR_ADV_MAX; handle++) {
+		if (ull_adv_is_enabled(handle)) {
+			return BT_HCI_ERR_CMD_DISALLOWED;
+		}
+	}
+
+	for (handle = 0U; handle < BT_CTLR_ADV_MAX; handle++) {
+		aux_reset(handle);
+	}
+
 	return 0;
 }
+
+int ull_adv_aux_chain_pdu_get(u8_t handle, u8_t index,
+			      const struct ext_adv_aux_ptr *aux_ptr,
+			      struct pdu_adv *pdu)
+{
+	struct pdu_adv_com_ext_adv *p;
+	struct adv_aux_data *d;
+	struct ext_adv_adi *adi;
+	struct ext_adv_hdr *h;
+	u16_t offset;
+	u8_t *ptr;
+	u8_t len;
+	int more;
+
+	if (handle >= BT_CTLR_ADV_MAX) {
+		return -EINVAL;
+	}
+
+	d = &aux[handle].ad;
+
+	/* Fragment boundaries, the first one is shorter by the AdvA */
+	if (!index) {
+		offset = 0U;
+		len = MIN(d->len, AUX_ADV_IND_DATA_MAX);
+	} else {
+		offset = AUX_ADV_IND_DATA_MAX +
+			 (index - 1) * AUX_CHAIN_IND_DATA_MAX;
+		if (offset >= d->len) {
+			return -EINVAL;
+		}
+
+		len = MIN(d->len - offset, AUX_CHAIN_IND_DATA_MAX);
+	}
+
+	more = (offset + len) < d->len;
+
+	pdu->type = PDU_ADV_TYPE_AUX_CHAIN_IND;
+	pdu->rfu = 0U;
+	pdu->chan_sel = 0U;
+	pdu->rx_addr = 0U;
+
+	p = (void *)&pdu->adv_ext_ind;
+	p->adv_mode = EXT_ADV_MODE_NON_CONN_NON_SCAN;
+	h = (void *)p->ext_hdr_adi_adv_data;
+	*(u8_t *)h = 0U;
+	ptr = (u8_t *)h + sizeof(*h);
+
+	/* AdvA, only in the AUX_ADV_IND */
+	if (!index) {
+		u8_t *addr = aux[handle].rand_addr_valid ?
+			     aux[handle].rand_addr : NULL;
+
+		h->adv_addr = 1U;
+		pdu->tx_addr = addr ? 1U : 0U;
+		if (addr) {
+			memcpy(ptr, addr, BDADDR_SIZE);
+		} else {
+			ll_addr_get(0, ptr);
+		}
+		ptr += BDADDR_SIZE;
+	} else {
+		pdu->tx_addr = 0U;
+	}
+
+	/* ADI, the SID being the advertising set handle */
+	h->adi = 1U;
+	adi = (void *)ptr;
+	adi->did = d->did;
+	adi->sid = handle;
+	ptr += sizeof(*adi);
+
+	/* AuxPtr, to the next AUX_CHAIN_IND */
+	if (more) {
+		h->aux_ptr = 1U;
+		memcpy(ptr, aux_ptr, sizeof(*aux_ptr));
+		ptr += sizeof(*aux_ptr);
+	}
+
+	p->ext_hdr_len = ptr - (u8_t *)h;
+
+	memcpy(ptr, &d->data[offset], len);
+	ptr += len;
+
+	pdu->len = ptr - (u8_t *)p;
+
+	return more;
+}
+
+static u8_t aux_data_set(struct adv_aux_data *d, u8_t op, u8_t len,
+			 u8_t *data)
+{
+	switch (op) {
+	case BT_HCI_LE_EXT_ADV_OP_FIRST_FRAG:
+	case BT_HCI_LE_EXT_ADV_OP_COMPLETE_DATA:
+		d->len = 0U;
+		d->frag = 0U;
+		break;
+
+	case BT_HCI_LE_EXT_ADV_OP_INTERM_FRAG:
+	case BT_HCI_LE_EXT_ADV_OP_LAST_FRAG:
+		if (!d->frag) {
+			return BT_HCI_ERR_CMD_DISALLOWED;
+		}
+		break;
+
+	case BT_HCI_LE_EXT_ADV_OP_UNCHANGED_DATA:
+		if (len || d->frag) {
+			return BT_HCI_ERR_INVALID_PARAM;
+		}
+
+		/* Only generate a new DID, so that scanners report again */
+		d->did++;
+
+		return 0;
+
+	default:
+		return BT_HCI_ERR_INVALID_PARAM;
+	}
+
+	if ((d->len + len) > sizeof(d->data)) {
+		d->len = 0U;
+		d->frag = 0U;
+
+		return BT_HCI_ERR_MEM_CAPACITY_EXCEEDED;
+	}
+
+	memcpy(&d->data[d->len], data, len);
+	d->len += len;
+
+	if ((op == BT_HCI_LE_EXT_ADV_OP_FIRST_FRAG) ||
+	    (op == BT_HCI_LE_EXT_ADV_OP_INTERM_FRAG)) {
+		d->frag = 1U;
+	} else {
+		d->frag = 0U;
+		d->did++;
+	}
+
+	return 0;
+}
+
+static void aux_reset(u8_t handle)
+{
+	(void)memset(&aux[handle], 0, sizeof(aux[handle]));
+}
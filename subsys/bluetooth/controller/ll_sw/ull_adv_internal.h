@@ -21,3 +21,13 @@ u32_t ull_adv_is_enabled(u16_t handle);
 
 /* Return filter policy used */
 u32_t ull_adv_filter_pol_get(u16_t handle);
+
+#if defined(CONFIG_BT_CTLR_ADV_EXT)
+/* Build the AUX_ADV_IND (index 0) or AUX_CHAIN_IND (index > 0) carrying the
+ * fragment at index of the set's AD data, returns 1 if more fragments follow,
+ * 0 for the last one, or -EINVAL if index is beyond the data.
+ */
+int ull_adv_aux_chain_pdu_get(u8_t handle, u8_t index,
+			      const struct ext_adv_aux_ptr *aux_ptr,
+			      struct pdu_adv *pdu);
+#endif /* CONFIG_BT_CTLR_ADV_EXT */
@@ -90,6 +90,11 @@ static inline void event_phy_upd_ind_prep(struct ll_conn *conn,
 					  u16_t event_counter);
 #endif /* CONFIG_BT_CTLR_PHY */
 
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+static void auto_upd_done(struct ll_conn *conn,
+			  struct node_rx_event_done *done);
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 static inline void ctrl_tx_pre_ack(struct ll_conn *conn,
 				   struct pdu_data *pdu_tx);
 static inline void ctrl_tx_ack(struct ll_conn *conn, struct node_tx **tx,
@@ -409,6 +414,11 @@ u32_t ll_length_req_send(u16_t handle, u16_t tx_octets, u16_t tx_time)
 
 	conn->llcp_length.req++;
 
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+	/* Host choice is not overridden */
+	conn->auto_upd.dle_done = 1U;
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 	return 0;
 }
 
@@ -492,6 +502,11 @@ u8_t ll_phy_req_send(u16_t handle, u8_t tx, u8_t flags, u8_t rx)
 	conn->llcp_phy.rx = rx;
 	conn->llcp_phy.req++;
 
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+	/* Host choice is not overridden */
+	conn->auto_upd.phy_host = 1U;
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 	return 0;
 }
 #endif /* CONFIG_BT_CTLR_PHY */
@@ -543,6 +558,59 @@ u8_t ll_apto_set(u16_t handle, u16_t apto)
 }
 #endif /* CONFIG_BT_CTLR_LE_PING */
 
+#if defined(CONFIG_BT_CTLR_CONN_EVT_STATS)
+u8_t ll_conn_evt_stats_get(u16_t handle, u32_t *count, u32_t *skipped)
+{
+	struct ll_conn *conn;
+
+	conn = ll_connected_get(handle);
+	if (!conn) {
+		return BT_HCI_ERR_UNKNOWN_CONN_ID;
+	}
+
+	*count = conn->evt_count;
+	*skipped = conn->evt_skipped;
+
+	return 0;
+}
+#endif /* CONFIG_BT_CTLR_CONN_EVT_STATS */
+
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+u8_t ll_conn_auto_upd_get(u16_t handle, u8_t *phy_tx, u8_t *phy_rx,
+			  u16_t *tx_octets, u16_t *rx_octets, u8_t *rssi,
+			  u8_t *crc_err_pct, u8_t *phy_upd_count)
+{
+	struct ll_conn *conn;
+
+	conn = ll_connected_get(handle);
+	if (!conn) {
+		return BT_HCI_ERR_UNKNOWN_CONN_ID;
+	}
+
+#if defined(CONFIG_BT_CTLR_PHY)
+	*phy_tx = conn->lll.phy_tx;
+	*phy_rx = conn->lll.phy_rx;
+#else /* !CONFIG_BT_CTLR_PHY */
+	*phy_tx = BIT(0);
+	*phy_rx = BIT(0);
+#endif /* !CONFIG_BT_CTLR_PHY */
+
+#if defined(CONFIG_BT_CTLR_DATA_LENGTH)
+	*tx_octets = conn->lll.max_tx_octets;
+	*rx_octets = conn->lll.max_rx_octets;
+#else /* !CONFIG_BT_CTLR_DATA_LENGTH */
+	*tx_octets = PDU_DC_PAYLOAD_SIZE_MIN;
+	*rx_octets = PDU_DC_PAYLOAD_SIZE_MIN;
+#endif /* !CONFIG_BT_CTLR_DATA_LENGTH */
+
+	*rssi = conn->auto_upd.rssi_avg;
+	*crc_err_pct = conn->auto_upd.crc_err_pct;
+	*phy_upd_count = conn->auto_upd.phy_upd_count;
+
+	return 0;
+}
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 int ull_conn_init(void)
 {
 	int err;
@@ -584,7 +652,7 @@ int ull_conn_reset(void)
 	MFIFO_INIT(conn_ack);
 
 	/* Reset the current conn update conn context pointer */
-	conn_upd_curr = NULL;
+	ull_conn_upd_curr_reset();
 
 	err = init_reset();
 	if (err) {
@@ -594,6 +662,11 @@ int ull_conn_reset(void)
 	return 0;
 }
 
+void ull_conn_upd_curr_reset(void)
+{
+	conn_upd_curr = NULL;
+}
+
 u8_t ull_conn_chan_map_cpy(u8_t *chan_map)
 {
 	memcpy(chan_map, data_chan_map, sizeof(data_chan_map));
@@ -724,6 +797,12 @@ int ull_conn_llcp(struct ll_conn *conn, u32_t ticks_at_expire, u16_t lazy)
 {
 	LL_ASSERT(conn->lll.handle != 0xFFFF);
 
+#if defined(CONFIG_BT_CTLR_CONN_EVT_STATS)
+	/* Account this event and the ones skipped since the previous one */
+	conn->evt_count += lazy + 1U;
+	conn->evt_skipped += lazy;
+#endif /* CONFIG_BT_CTLR_CONN_EVT_STATS */
+
 #if defined(CONFIG_BT_CTLR_CONN_PARAM_REQ) || defined(CONFIG_BT_CTLR_PHY)
 	/* Check if no other procedure with instant is requested and not in
 	 * Encryption setup.
@@ -1111,6 +1190,10 @@ void ull_conn_done(struct node_rx_event_done *done)
 	}
 #endif /* CONFIG_BT_CTLR_CONN_RSSI */
 
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+	auto_upd_done(conn, done);
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 	/* break latency based on ctrl procedure pending */
 	if ((((conn->llcp_req - conn->llcp_ack) & 0x03) == 0x02) &&
 	    ((conn->llcp_type == LLCP_CONN_UPD) ||
@@ -1527,6 +1610,11 @@ static void conn_cleanup(struct ll_conn *conn)
 	 */
 	mayfly_enable(TICKER_USER_ID_ULL_HIGH, TICKER_USER_ID_ULL_LOW, 1);
 
+#if defined(CONFIG_BT_CTLR_CONN_EVT_STATS)
+	BT_INFO("handle %u: %u of %u events skipped", lll->handle,
+		conn->evt_skipped, conn->evt_count);
+#endif /* CONFIG_BT_CTLR_CONN_EVT_STATS */
+
 	/* Stop Master or Slave role ticker */
 	ticker_status = ticker_stop(TICKER_INSTANCE_ID_CTLR,
 				    TICKER_USER_ID_ULL_HIGH,
@@ -4281,6 +4369,154 @@ static inline u8_t phy_upd_ind_recv(struct ll_conn *conn, memq_link_t *link,
 }
 #endif /* CONFIG_BT_CTLR_PHY */
 
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+#if defined(CONFIG_BT_CTLR_DATA_LENGTH)
+static bool auto_upd_length(struct ll_conn *conn)
+{
+	u16_t max_tx_octets;
+	u16_t max_tx_time;
+	u16_t max_rx_octets;
+	u16_t max_rx_time;
+
+	/* Requested once, the peer may support less than the maximum */
+	if (conn->auto_upd.dle_done) {
+		return false;
+	}
+	conn->auto_upd.dle_done = 1U;
+
+	if (!(conn->llcp_features & BIT(BT_LE_FEAT_BIT_DLE)) ||
+	    (conn->llcp_length.req != conn->llcp_length.ack)) {
+		return false;
+	}
+
+	ll_length_max_get(&max_tx_octets, &max_tx_time,
+			  &max_rx_octets, &max_rx_time);
+	if (conn->lll.max_tx_octets >= max_tx_octets) {
+		return false;
+	}
+
+	conn->llcp_length.state = LLCP_LENGTH_STATE_REQ;
+	conn->llcp_length.tx_octets = max_tx_octets;
+
+#if defined(CONFIG_BT_CTLR_PHY)
+	conn->llcp_length.tx_time = max_tx_time;
+#endif /* CONFIG_BT_CTLR_PHY */
+
+	conn->llcp_length.req++;
+
+	return true;
+}
+#endif /* CONFIG_BT_CTLR_DATA_LENGTH */
+
+#if defined(CONFIG_BT_CTLR_PHY)
+static void auto_upd_phy(struct ll_conn *conn, bool poor, bool good)
+{
+	u8_t phy = conn->lll.phy_tx;
+
+	if (conn->auto_upd.phy_host ||
+	    (conn->llcp_phy.req != conn->llcp_phy.ack)) {
+		return;
+	}
+
+	/* Step one PHY at a time, Coded, 1M and 2M */
+	if (poor) {
+		if (phy == BIT(1)) {
+			phy = BIT(0);
+#if defined(CONFIG_BT_CTLR_PHY_CODED)
+		} else if ((phy == BIT(0)) &&
+			   (conn->llcp_features &
+			    BIT(BT_LE_FEAT_BIT_PHY_CODED))) {
+			phy = BIT(2);
+#endif /* CONFIG_BT_CTLR_PHY_CODED */
+		}
+	} else if (good) {
+		if (phy == BIT(2)) {
+			phy = BIT(0);
+		} else if ((phy == BIT(0)) &&
+			   (conn->llcp_features & BIT(BT_LE_FEAT_BIT_PHY_2M))) {
+			phy = BIT(1);
+		}
+	}
+
+	if ((phy == conn->lll.phy_tx) && (phy == conn->lll.phy_rx)) {
+		return;
+	}
+
+	conn->llcp_phy.state = LLCP_PHY_STATE_REQ;
+	conn->llcp_phy.cmd = 0U;
+	conn->llcp_phy.tx = phy;
+	conn->llcp_phy.flags = 0U;
+	conn->llcp_phy.rx = phy;
+	conn->llcp_phy.req++;
+
+	conn->auto_upd.phy_upd_count++;
+}
+#endif /* CONFIG_BT_CTLR_PHY */
+
+static void auto_upd_done(struct ll_conn *conn,
+			  struct node_rx_event_done *done)
+{
+	bool poor;
+	bool good;
+
+	if (!done->extra.crc_valid) {
+		conn->auto_upd.crc_err++;
+	}
+
+#if defined(CONFIG_BT_CTLR_CONN_RSSI)
+	if (conn->lll.rssi_latest != 0x7F) {
+		if (conn->auto_upd.rssi_avg == 0x7F) {
+			conn->auto_upd.rssi_avg = conn->lll.rssi_latest;
+		} else {
+			conn->auto_upd.rssi_avg =
+				((conn->auto_upd.rssi_avg * 3U) +
+				 conn->lll.rssi_latest) >> 2;
+		}
+	}
+#endif /* CONFIG_BT_CTLR_CONN_RSSI */
+
+	if (++conn->auto_upd.evt_count <
+	    CONFIG_BT_CTLR_CONN_AUTO_UPDATE_INTERVAL) {
+		return;
+	}
+
+	conn->auto_upd.crc_err_pct = (conn->auto_upd.crc_err * 100U) /
+				     conn->auto_upd.evt_count;
+	conn->auto_upd.evt_count = 0U;
+	conn->auto_upd.crc_err = 0U;
+
+	/* Wait for the peer features, and for any procedure in progress */
+	if (!conn->common.fex_valid || (conn->llcp_req != conn->llcp_ack)) {
+		return;
+	}
+
+#if defined(CONFIG_BT_CTLR_DATA_LENGTH)
+	if (auto_upd_length(conn)) {
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_DATA_LENGTH */
+
+	/* RSSI is larger on weaker links, not used until measured */
+	poor = (conn->auto_upd.crc_err_pct >=
+		CONFIG_BT_CTLR_CONN_AUTO_CRC_ERR_POOR);
+	good = (conn->auto_upd.crc_err_pct <
+		(CONFIG_BT_CTLR_CONN_AUTO_CRC_ERR_POOR / 2U));
+	if (conn->auto_upd.rssi_avg != 0x7F) {
+		poor = poor || (conn->auto_upd.rssi_avg >=
+				CONFIG_BT_CTLR_CONN_AUTO_RSSI_POOR);
+		good = good && (conn->auto_upd.rssi_avg <=
+				CONFIG_BT_CTLR_CONN_AUTO_RSSI_GOOD);
+	}
+
+#if defined(CONFIG_BT_CTLR_PHY)
+	auto_upd_phy(conn, poor, good);
+#else /* !CONFIG_BT_CTLR_PHY */
+	ARG_UNUSED(poor);
+	ARG_UNUSED(good);
+#endif /* !CONFIG_BT_CTLR_PHY */
+}
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 static inline void ctrl_tx_pre_ack(struct ll_conn *conn,
 				   struct pdu_data *pdu_tx)
 {
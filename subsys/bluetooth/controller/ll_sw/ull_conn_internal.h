@@ -25,6 +25,7 @@ struct ll_conn *ll_conn_get(u16_t handle);
 struct ll_conn *ll_connected_get(u16_t handle);
 int ull_conn_init(void);
 int ull_conn_reset(void);
+void ull_conn_upd_curr_reset(void);
 u8_t ull_conn_chan_map_cpy(u8_t *chan_map);
 void ull_conn_chan_map_set(u8_t *chan_map);
 u16_t ull_conn_default_tx_octets_get(void);
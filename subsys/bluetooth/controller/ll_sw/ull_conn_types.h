@@ -214,6 +214,23 @@ struct ll_conn {
 	struct node_tx *tx_data_last;
 
 	u8_t chm_updated;
+
+#if defined(CONFIG_BT_CTLR_CONN_EVT_STATS)
+	u32_t evt_count;   /* Connection events elapsed */
+	u32_t evt_skipped; /* Connection events skipped */
+#endif /* CONFIG_BT_CTLR_CONN_EVT_STATS */
+
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+	struct {
+		u16_t evt_count;     /* Events in the evaluation window */
+		u16_t crc_err;       /* Events without a valid CRC */
+		u8_t  crc_err_pct;   /* Of the last evaluation window */
+		u8_t  rssi_avg;      /* -dBm, 0x7F if not measured */
+		u8_t  phy_upd_count; /* PHY updates requested */
+		u8_t  dle_done:1;
+		u8_t  phy_host:1;    /* Host requested a PHY */
+	} auto_upd;
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
 };
 
 struct node_rx_cc {
@@ -90,7 +90,10 @@ u8_t ll_create_connection(u16_t scan_interval, u16_t scan_window,
 	lll->adv_addr_type = peer_addr_type;
 	memcpy(lll->adv_addr, peer_addr, BDADDR_SIZE);
 	lll->conn_timeout = timeout;
-	lll->conn_ticks_slot = 0; /* TODO: */
+	lll->conn_ticks_slot =
+		HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_START_US +
+				       EVENT_TX_READY_MAX_US + 328 +
+				       EVENT_IFS_US + 328);
 
 	conn_lll = &conn->lll;
 
@@ -157,6 +160,22 @@ u8_t ll_create_connection(u16_t scan_interval, u16_t scan_window,
 
 	conn->connect_expire = 6U;
 	conn->supervision_expire = 0U;
+
+#if defined(CONFIG_BT_CTLR_CONN_EVT_STATS)
+	conn->evt_count = 0U;
+	conn->evt_skipped = 0U;
+#endif /* CONFIG_BT_CTLR_CONN_EVT_STATS */
+
+#if defined(CONFIG_BT_CTLR_CONN_AUTO_UPDATE)
+	conn->auto_upd.evt_count = 0U;
+	conn->auto_upd.crc_err = 0U;
+	conn->auto_upd.crc_err_pct = 0U;
+	conn->auto_upd.rssi_avg = 0x7F;
+	conn->auto_upd.phy_upd_count = 0U;
+	conn->auto_upd.dle_done = 0U;
+	conn->auto_upd.phy_host = 0U;
+#endif /* CONFIG_BT_CTLR_CONN_AUTO_UPDATE */
+
 	conn_interval_us = (u32_t)interval * 1250U;
 	conn->supervision_reload = RADIO_CONN_EVENTS(timeout * 10000U,
 							 conn_interval_us);
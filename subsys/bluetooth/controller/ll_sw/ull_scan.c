@@ -401,7 +401,8 @@ static void ticker_cb(u32_t ticks_at_expire, u32_t remainder, u16_t lazy,
 			ull_sched_mfy_after_mstr_offset_get};
 		u32_t retval;
 
-		s_mfy_sched_after_mstr_offset_get.param = (void *)scan;
+		/* The offset is relative to the anchor of this event */
+		s_mfy_sched_after_mstr_offset_get.param = (void *)&p;
 
 		retval = mayfly_enqueue(TICKER_USER_ID_ULL_HIGH,
 				TICKER_USER_ID_ULL_LOW, 1,
@@ -210,6 +210,12 @@ struct ticker_instance {
 						     * the trigger (compare
 						     * value)
 						     */
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	u32_t ticks_job_last;	   /* Execution time of last ticker_job */
+	u32_t ticks_job_max;	   /* Worst-case execution time of
+				    * ticker_job
+				    */
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 };
 
 BUILD_ASSERT(sizeof(struct ticker_node)    == TICKER_NODE_T_SIZE);
@@ -634,15 +640,21 @@ static u8_t ticker_resolve_collision(struct ticker_node *nodes,
 		while (id_head != TICKER_NULL) {
 			struct ticker_node *ticker_next = &nodes[id_head];
 
+			/* Accumulate ticks_to_expire for each node. Nodes are
+			 * sorted by expiry, so none of the remaining ones can
+			 * be within the reservation slot of this node.
+			 */
+			acc_ticks_to_expire += ticker_next->ticks_to_expire;
+			if (acc_ticks_to_expire >= ticker->ticks_slot) {
+				break;
+			}
+
 			/* We only care about nodes with slot reservation */
 			if (ticker_next->ticks_slot == 0) {
 				id_head = ticker_next->next;
 				continue;
 			}
 
-			/* Accumulate ticks_to_expire for each node */
-			acc_ticks_to_expire += ticker_next->ticks_to_expire;
-
 			s32_t lazy_next = ticker_next->lazy_current;
 			u8_t  lazy_next_periodic_skip =
 				ticker_next->lazy_periodic > lazy_next;
@@ -688,7 +700,6 @@ static u8_t ticker_resolve_collision(struct ticker_node *nodes,
 			 * and wins conflict resolution
 			 */
 			if (!lazy_next_periodic_skip &&
-			    (acc_ticks_to_expire < ticker->ticks_slot) &&
 			    (next_force ||
 			     next_is_critical ||
 			    (next_has_priority && !current_is_older) ||
@@ -1808,6 +1819,9 @@ void ticker_job(void *param)
 	u8_t flag_elapsed;
 	u8_t pending;
 	u8_t flag_compare_update;
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	u32_t ticks_job_start;
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 
 	DEBUG_TICKER_JOB(1);
 
@@ -1818,6 +1832,10 @@ void ticker_job(void *param)
 	}
 	instance->job_guard = 1U;
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	ticks_job_start = cntr_cnt_get();
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	/* Back up the previous known tick */
 	ticks_previous = instance->ticks_current;
 
@@ -1882,6 +1900,14 @@ void ticker_job(void *param)
 		ticker_job_list_inquire(instance);
 	}
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	instance->ticks_job_last = ticker_ticks_diff_get(cntr_cnt_get(),
+							 ticks_job_start);
+	if (instance->ticks_job_last > instance->ticks_job_max) {
+		instance->ticks_job_max = instance->ticks_job_last;
+	}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	/* Permit worker job to run */
 	instance->job_guard = 0U;
 
@@ -1975,6 +2001,11 @@ u32_t ticker_init(u8_t instance_index, u8_t count_node, void *node,
 	instance->ticks_elapsed_first = 0U;
 	instance->ticks_elapsed_last = 0U;
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	instance->ticks_job_last = 0U;
+	instance->ticks_job_max = 0U;
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	return TICKER_STATUS_SUCCESS;
 }
 
@@ -2398,6 +2429,27 @@ void ticker_job_sched(u8_t instance_index, u8_t user_id)
 			   TICKER_CALL_ID_JOB, 0, instance);
 }
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+/**
+ * @brief Get ticker job execution time
+ *
+ * @details Gets the execution time of the last ticker_job, and the
+ * worst-case execution time since the ticker instance was initialized.
+ *
+ * @param instance_index Index of ticker instance
+ * @param ticks_last     Pointer to ticks used by last ticker_job [out]
+ * @param ticks_max      Pointer to worst-case ticks used by ticker_job [out]
+ */
+void ticker_job_profile_get(u8_t instance_index, u32_t *ticks_last,
+			    u32_t *ticks_max)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+
+	*ticks_last = instance->ticks_job_last;
+	*ticks_max = instance->ticks_job_max;
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 /**
  * @brief Get current absolute tick count
  *
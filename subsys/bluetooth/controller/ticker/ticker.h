@@ -121,6 +121,10 @@ u32_t ticker_job_idle_get(u8_t instance_index, u8_t user_id,
 void ticker_job_sched(u8_t instance_index, u8_t user_id);
 u32_t ticker_ticks_now_get(void);
 u32_t ticker_ticks_diff_get(u32_t ticks_now, u32_t ticks_old);
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+void ticker_job_profile_get(u8_t instance_index, u32_t *ticks_last,
+			    u32_t *ticks_max);
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 #if !defined(CONFIG_BT_TICKER_COMPATIBILITY_MODE)
 u32_t ticker_priority_set(u8_t instance_index, u8_t user_id, u8_t ticker_id,
 			  s8_t priority, ticker_op_func fp_op_func,
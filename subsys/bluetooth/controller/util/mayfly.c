@@ -11,6 +11,11 @@
 #include "memq.h"
 #include "mayfly.h"
 
+#if defined(CONFIG_BT_MAYFLY_STATS) || (CONFIG_BT_MAYFLY_RUN_BUDGET_US > 0)
+#include "hal/cntr.h"
+#include "hal/ticker.h"
+#endif
+
 static struct {
 	memq_link_t *head;
 	memq_link_t *tail;
@@ -23,6 +28,28 @@ static struct {
 static memq_link_t mfl[MAYFLY_CALLEE_COUNT][MAYFLY_CALLER_COUNT];
 static u8_t mfp[MAYFLY_CALLEE_COUNT];
 
+#if defined(CONFIG_BT_MAYFLY_STATS)
+/* Enqueue count is written only by the caller, dequeue count and the
+ * statistics only by the callee.
+ */
+static u32_t mfs_enqueue[MAYFLY_CALLEE_COUNT][MAYFLY_CALLER_COUNT];
+static u32_t mfs_dequeue[MAYFLY_CALLEE_COUNT];
+static struct mayfly_stats mfs[MAYFLY_CALLEE_COUNT];
+
+static u16_t depth_get(u8_t callee_id)
+{
+	u32_t enqueue = 0U;
+	u8_t caller_id;
+
+	caller_id = MAYFLY_CALLER_COUNT;
+	while (caller_id--) {
+		enqueue += mfs_enqueue[callee_id][caller_id];
+	}
+
+	return enqueue - mfs_dequeue[callee_id];
+}
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 #if defined(MAYFLY_UT)
 static u8_t _state;
 #endif /* MAYFLY_UT */
@@ -85,6 +112,10 @@ u32_t mayfly_enqueue(u8_t caller_id, u8_t callee_id, u8_t chain,
 				/* mark as ready in queue */
 				m->_req = ack + 1;
 
+#if defined(CONFIG_BT_MAYFLY_STATS)
+				m->_ticks_enqueue = cntr_cnt_get();
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 				goto mayfly_enqueue_pend;
 			}
 
@@ -106,6 +137,10 @@ u32_t mayfly_enqueue(u8_t caller_id, u8_t callee_id, u8_t chain,
 
 	/* new, add as ready in the queue */
 	m->_req = ack + 1;
+#if defined(CONFIG_BT_MAYFLY_STATS)
+	m->_ticks_enqueue = cntr_cnt_get();
+	mfs_enqueue[callee_id][caller_id]++;
+#endif /* CONFIG_BT_MAYFLY_STATS */
 	memq_enqueue(m->_link, m, &mft[callee_id][caller_id].tail);
 
 mayfly_enqueue_pend:
@@ -149,6 +184,10 @@ static void dequeue(u8_t callee_id, u8_t caller_id, memq_link_t *link,
 		/* release link into dequeued mayfly struct */
 		m->_link = link;
 
+#if defined(CONFIG_BT_MAYFLY_STATS)
+		mfs_dequeue[callee_id]++;
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 		/* reset mayfly state to idle */
 		ack = m->_ack;
 		m->_ack = req;
@@ -161,6 +200,11 @@ static void dequeue(u8_t callee_id, u8_t caller_id, memq_link_t *link,
 
 			m->_ack = ack;
 			memq_enqueue(link, m, &mft[callee_id][callee_id].tail);
+
+#if defined(CONFIG_BT_MAYFLY_STATS)
+			/* still in the callee queues */
+			mfs_dequeue[callee_id]--;
+#endif /* CONFIG_BT_MAYFLY_STATS */
 		}
 	}
 }
@@ -170,12 +214,29 @@ void mayfly_run(u8_t callee_id)
 	u8_t disable = 0U;
 	u8_t enable = 0U;
 	u8_t caller_id;
+#if (CONFIG_BT_MAYFLY_RUN_BUDGET_US > 0)
+	u32_t ticks_start;
+#endif /* CONFIG_BT_MAYFLY_RUN_BUDGET_US > 0 */
 
 	if (!mfp[callee_id]) {
 		return;
 	}
 	mfp[callee_id] = 1U;
 
+#if (CONFIG_BT_MAYFLY_RUN_BUDGET_US > 0)
+	ticks_start = cntr_cnt_get();
+#endif /* CONFIG_BT_MAYFLY_RUN_BUDGET_US > 0 */
+
+#if defined(CONFIG_BT_MAYFLY_STATS)
+	{
+		u16_t depth = depth_get(callee_id);
+
+		if (mfs[callee_id].depth_max < depth) {
+			mfs[callee_id].depth_max = depth;
+		}
+	}
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 	/* iterate through each caller queue to this callee_id */
 	caller_id = MAYFLY_CALLER_COUNT;
 	while (caller_id--) {
@@ -203,6 +264,22 @@ void mayfly_run(u8_t callee_id)
 				/* mark mayfly as ran */
 				m->_ack--;
 
+#if defined(CONFIG_BT_MAYFLY_STATS)
+				{
+					struct mayfly_stats *s =
+						&mfs[callee_id];
+
+					s->latency_last = (cntr_cnt_get() -
+							   m->_ticks_enqueue) &
+							  HAL_TICKER_CNTR_MASK;
+					if (s->latency_max < s->latency_last) {
+						s->latency_max =
+							s->latency_last;
+					}
+					s->run_count++;
+				}
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 				/* call the mayfly function */
 				m->fp(m->param);
 			}
@@ -235,11 +312,34 @@ void mayfly_run(u8_t callee_id)
 				 * processed.
 				 */
 				if (caller_id || link) {
+#if defined(CONFIG_BT_MAYFLY_STATS)
+					mfs[callee_id].yield_count++;
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 					mayfly_pend(callee_id, callee_id);
 
 					return;
 				}
 			}
+#elif (CONFIG_BT_MAYFLY_RUN_BUDGET_US > 0)
+			/* yield out of mayfly_run once the time budget is
+			 * used, so that a lower level callee sharing the
+			 * priority of a higher level one does not delay it,
+			 * and tailchain the remaining mayflies.
+			 */
+			if ((state == 1U) && (caller_id || link) &&
+			    (((cntr_cnt_get() - ticks_start) &
+			      HAL_TICKER_CNTR_MASK) >=
+			     HAL_TICKER_US_TO_TICKS(
+				     CONFIG_BT_MAYFLY_RUN_BUDGET_US))) {
+#if defined(CONFIG_BT_MAYFLY_STATS)
+				mfs[callee_id].yield_count++;
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
+				mayfly_pend(callee_id, callee_id);
+
+				return;
+			}
 #endif
 		}
 
@@ -265,6 +365,15 @@ void mayfly_run(u8_t callee_id)
 	}
 }
 
+#if defined(CONFIG_BT_MAYFLY_STATS)
+void mayfly_stats_get(u8_t callee_id, struct mayfly_stats *stats)
+{
+	/* Consistent only in the callee context, indicative otherwise */
+	*stats = mfs[callee_id];
+	stats->depth = depth_get(callee_id);
+}
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 #if defined(MAYFLY_UT)
 #define MAYFLY_CALL_ID_CALLER MAYFLY_CALL_ID_0
 #define MAYFLY_CALL_ID_CALLEE MAYFLY_CALL_ID_2
@@ -18,13 +18,30 @@ struct mayfly {
 	memq_link_t *_link;
 	void *param;
 	void (*fp)(void *);
+#if defined(CONFIG_BT_MAYFLY_STATS)
+	u32_t _ticks_enqueue;
+#endif /* CONFIG_BT_MAYFLY_STATS */
 };
 
+#if defined(CONFIG_BT_MAYFLY_STATS)
+struct mayfly_stats {
+	u32_t run_count;    /* Queued mayflies called */
+	u32_t latency_max;  /* Ticks from enqueue to call */
+	u32_t latency_last;
+	u16_t depth;        /* Mayflies in the callee queues */
+	u16_t depth_max;
+	u16_t yield_count;  /* Runs yielding with mayflies pending */
+};
+#endif /* CONFIG_BT_MAYFLY_STATS */
+
 void mayfly_init(void);
 void mayfly_enable(u8_t caller_id, u8_t callee_id, u8_t enable);
 u32_t mayfly_enqueue(u8_t caller_id, u8_t callee_id, u8_t chain,
 		     struct mayfly *m);
 void mayfly_run(u8_t callee_id);
+#if defined(CONFIG_BT_MAYFLY_STATS)
+void mayfly_stats_get(u8_t callee_id, struct mayfly_stats *stats);
+#endif /* CONFIG_BT_MAYFLY_STATS */
 
 extern void mayfly_enable_cb(u8_t caller_id, u8_t callee_id, u8_t enable);
 extern u32_t mayfly_is_enabled(u8_t caller_id, u8_t callee_id);
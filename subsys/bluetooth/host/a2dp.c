@@ -33,6 +33,10 @@
 
 #define A2DP_NO_SPACE (-1)
 
+/* SBC media payload header: frame count in the 4 lowest bits */
+#define A2DP_SBC_HDR_SIZE 1
+#define A2DP_SBC_MAX_FRAMES 15
+
 struct bt_a2dp {
 	struct bt_avdtp session;
 };
@@ -160,3 +164,94 @@ int bt_a2dp_register_endpoint(struct bt_a2dp_endpoint *endpoint,
 
 	return 0;
 }
+
+int bt_a2dp_stream_connect(struct bt_a2dp *a2dp,
+			   struct bt_a2dp_stream *stream)
+{
+	BT_ASSERT(a2dp && stream && stream->pool);
+
+	stream->pending = NULL;
+	stream->next_ts = 0U;
+
+	return bt_avdtp_stream_connect(&a2dp->session, &stream->avdtp);
+}
+
+int bt_a2dp_stream_disconnect(struct bt_a2dp_stream *stream)
+{
+	BT_ASSERT(stream);
+
+	if (stream->pending) {
+		net_buf_unref(stream->pending);
+		stream->pending = NULL;
+	}
+
+	return bt_avdtp_stream_disconnect(&stream->avdtp);
+}
+
+int bt_a2dp_sbc_flush(struct bt_a2dp_stream *stream)
+{
+	struct net_buf *buf = stream->pending;
+	int err;
+
+	if (!buf) {
+		return 0;
+	}
+
+	stream->pending = NULL;
+
+	/* Not fragmented: only the frame count is set */
+	buf->data[0] = stream->frames;
+
+	err = bt_avdtp_media_send(&stream->avdtp, buf, stream->ts);
+	if (err < 0) {
+		BT_ERR("Media send failed (err %d)", err);
+		net_buf_unref(buf);
+	}
+
+	return err;
+}
+
+u8_t *bt_a2dp_sbc_frame_alloc(struct bt_a2dp_stream *stream, size_t len,
+			      s32_t timeout)
+{
+	size_t max_len = stream->avdtp.chan.tx.mtu - BT_AVDTP_MEDIA_HDR_SIZE;
+	struct net_buf *buf = stream->pending;
+
+	if (len + A2DP_SBC_HDR_SIZE > max_len) {
+		return NULL;
+	}
+
+	if (buf && (stream->frames == A2DP_SBC_MAX_FRAMES ||
+		    buf->len + len > max_len ||
+		    net_buf_tailroom(buf) < len)) {
+		if (bt_a2dp_sbc_flush(stream) < 0) {
+			return NULL;
+		}
+
+		buf = NULL;
+	}
+
+	if (!buf) {
+		buf = net_buf_alloc(stream->pool, timeout);
+		if (!buf) {
+			return NULL;
+		}
+
+		net_buf_reserve(buf, BT_AVDTP_MEDIA_SEND_RESERVE);
+		if (net_buf_tailroom(buf) < A2DP_SBC_HDR_SIZE + len) {
+			BT_ERR("Too small media buffers");
+			net_buf_unref(buf);
+			return NULL;
+		}
+
+		net_buf_add(buf, A2DP_SBC_HDR_SIZE);
+		stream->pending = buf;
+		stream->frames = 0U;
+		stream->ts = stream->next_ts;
+	}
+
+	stream->frames++;
+	stream->next_ts += stream->frame_samples;
+
+	return net_buf_add(buf, len);
+}
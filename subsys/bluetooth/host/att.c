@@ -48,6 +48,8 @@
 
 #define ATT_TIMEOUT				K_SECONDS(30)
 
+#define BT_EATT_PSM				0x0027
+
 typedef enum __packed {
 		ATT_COMMAND,
 		ATT_REQUEST,
@@ -93,11 +95,37 @@ struct bt_att {
 #if CONFIG_BT_ATT_PREPARE_COUNT > 0
 	struct k_fifo		prep_queue;
 #endif
+#if defined(CONFIG_BT_EATT)
+	/* Context of the fixed channel, which holds the queue of requests,
+	 * if this is an enhanced bearer.
+	 */
+	struct bt_att		*fixed;
+	/* Enhanced bearers of the connection, on the fixed channel context */
+	struct bt_att		*eatt[CONFIG_BT_EATT_MAX];
+	/* Bearer to be tried first for the next request, 0 being the fixed
+	 * channel.
+	 */
+	u8_t			eatt_next;
+#endif /* CONFIG_BT_EATT */
 };
 
 static struct bt_att bt_req_pool[CONFIG_BT_MAX_CONN];
 static struct bt_att_req cancel;
 
+#if defined(CONFIG_BT_EATT)
+static struct bt_att eatt_pool[CONFIG_BT_MAX_CONN * CONFIG_BT_EATT_MAX];
+
+static inline bool att_is_eatt(struct bt_att *att)
+{
+	return att->fixed != NULL;
+}
+#else
+static inline bool att_is_eatt(struct bt_att *att)
+{
+	return false;
+}
+#endif /* CONFIG_BT_EATT */
+
 static void att_req_destroy(struct bt_att_req *req)
 {
 	BT_DBG("req %p", req);
@@ -230,9 +258,56 @@ static bt_conn_tx_cb_t att_cb(struct net_buf *buf)
 	}
 }
 
-static void send_err_rsp(struct bt_conn *conn, u8_t req, u16_t handle,
+#if defined(CONFIG_BT_EATT)
+/* Enhanced bearers are flow controlled by the credits of their channel
+ * instead of tx_sem, so what the sent callbacks do is done when the PDU is
+ * queued to the channel.
+ */
+static void eatt_send(struct bt_att *att, struct net_buf *buf)
+{
+	switch (att_op_get_type(buf->data[0])) {
+	case ATT_RESPONSE:
+		atomic_clear_bit(att->flags, ATT_PENDING_RSP);
+		break;
+	case ATT_CONFIRMATION:
+		atomic_clear_bit(att->flags, ATT_PENDING_CFM);
+		break;
+	case ATT_REQUEST:
+	case ATT_INDICATION:
+		if (att->req) {
+			k_delayed_work_submit(&att->timeout_work, ATT_TIMEOUT);
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (bt_l2cap_chan_send(&att->chan.chan, buf) < 0) {
+		net_buf_unref(buf);
+	}
+}
+#endif /* CONFIG_BT_EATT */
+
+/* Send a PDU on the bearer it belongs to, such as the response to a request
+ * received on that bearer.
+ */
+static void att_chan_send(struct bt_att *att, struct net_buf *buf,
+			  bt_conn_tx_cb_t cb)
+{
+#if defined(CONFIG_BT_EATT)
+	if (att_is_eatt(att)) {
+		eatt_send(att, buf);
+		return;
+	}
+#endif /* CONFIG_BT_EATT */
+
+	bt_l2cap_send_cb(att->chan.chan.conn, BT_L2CAP_CID_ATT, buf, cb, NULL);
+}
+
+static void send_err_rsp(struct bt_att *att, u8_t req, u16_t handle,
 			 u8_t err)
 {
+	struct bt_conn *conn = att->chan.chan.conn;
 	struct bt_att_error_rsp *rsp;
 	struct net_buf *buf;
 
@@ -251,7 +326,7 @@ static void send_err_rsp(struct bt_conn *conn, u8_t req, u16_t handle,
 	rsp->handle = sys_cpu_to_le16(handle);
 	rsp->error = err;
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, buf, att_rsp_sent, NULL);
+	att_chan_send(att, buf, att_rsp_sent);
 }
 
 static u8_t att_mtu_req(struct bt_att *att, struct net_buf *buf)
@@ -268,6 +343,11 @@ static u8_t att_mtu_req(struct bt_att *att, struct net_buf *buf)
 
 	BT_DBG("Client MTU %u", mtu_client);
 
+	/* The MTU of an enhanced bearer is the one of its L2CAP channel */
+	if (att_is_eatt(att)) {
+		return BT_ATT_ERR_NOT_SUPPORTED;
+	}
+
 	/* Check if MTU is valid */
 	if (mtu_client < BT_ATT_DEFAULT_LE_MTU) {
 		return BT_ATT_ERR_INVALID_PDU;
@@ -285,7 +365,7 @@ static u8_t att_mtu_req(struct bt_att *att, struct net_buf *buf)
 	rsp = net_buf_add(pdu, sizeof(*rsp));
 	rsp->mtu = sys_cpu_to_le16(mtu_server);
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, pdu, att_rsp_sent, NULL);
+	att_chan_send(att, pdu, att_rsp_sent);
 
 	/* BLUETOOTH SPECIFICATION Version 4.2 [Vol 3, Part F] page 484:
 	 *
@@ -315,6 +395,16 @@ static int att_send_req(struct bt_att *att, struct bt_att_req *req)
 
 	att->req = req;
 
+#if defined(CONFIG_BT_EATT)
+	if (att_is_eatt(att)) {
+		/* Save request state so it can be resent */
+		net_buf_simple_save(&req->buf->b, &req->state);
+
+		eatt_send(att, net_buf_ref(req->buf));
+		return 0;
+	}
+#endif /* CONFIG_BT_EATT */
+
 	if (k_sem_take(&att->tx_sem, K_NO_WAIT) < 0) {
 		k_fifo_put(&att->tx_queue, req->buf);
 		return 0;
@@ -330,12 +420,115 @@ static int att_send_req(struct bt_att *att, struct bt_att_req *req)
 	return 0;
 }
 
+#if defined(CONFIG_BT_EATT)
+static bool att_req_allowed(struct bt_att *att, struct bt_att_req *req)
+{
+	if (!att_is_eatt(att)) {
+		return true;
+	}
+
+	if (att->chan.chan.state != BT_L2CAP_CONNECTED ||
+	    atomic_test_bit(att->flags, ATT_DISCONNECTED)) {
+		return false;
+	}
+
+	/* The MTU can only be exchanged on the fixed channel, and prepared
+	 * writes are queued by the server per bearer, so keep them with their
+	 * execution on the fixed channel.
+	 */
+	switch (req->buf->data[0]) {
+	case BT_ATT_OP_MTU_REQ:
+	case BT_ATT_OP_PREPARE_WRITE_REQ:
+	case BT_ATT_OP_EXEC_WRITE_REQ:
+		return false;
+	default:
+		break;
+	}
+
+	/* GATT sizes requests and detects the end of long reads with the MTU
+	 * of the fixed channel.
+	 */
+	return att->chan.tx.mtu >= att->fixed->chan.tx.mtu;
+}
+#endif /* CONFIG_BT_EATT */
+
+/* Find a bearer without outstanding request which can send req, trying the
+ * bearers in turn so that the requests are spread over them.
+ */
+static struct bt_att *att_req_bearer(struct bt_att *att,
+				     struct bt_att_req *req)
+{
+#if defined(CONFIG_BT_EATT)
+	u8_t i, id;
+
+	for (i = 0U; i <= CONFIG_BT_EATT_MAX; i++) {
+		struct bt_att *bearer;
+
+		id = (att->eatt_next + i) % (CONFIG_BT_EATT_MAX + 1);
+		bearer = id ? att->eatt[id - 1] : att;
+
+		if (bearer && !bearer->req && att_req_allowed(bearer, req)) {
+			att->eatt_next = id + 1;
+			return bearer;
+		}
+	}
+
+	return NULL;
+#else
+	return att->req ? NULL : att;
+#endif /* CONFIG_BT_EATT */
+}
+
+#if defined(CONFIG_BT_EATT)
+static void eatt_process(struct bt_att *att)
+{
+	sys_snode_t *node, *prev = NULL;
+
+	/* Pull the next request this bearer can send from the list of the
+	 * fixed channel.
+	 */
+	SYS_SLIST_FOR_EACH_NODE(&att->fixed->reqs, node) {
+		if (att_req_allowed(att, ATT_REQ(node))) {
+			sys_slist_remove(&att->fixed->reqs, prev, node);
+			att_send_req(att, ATT_REQ(node));
+			return;
+		}
+
+		prev = node;
+	}
+}
+#endif /* CONFIG_BT_EATT */
+
+/* Find the bearer on which req is outstanding */
+static struct bt_att *att_req_find_bearer(struct bt_att *att,
+					  struct bt_att_req *req)
+{
+#if defined(CONFIG_BT_EATT)
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(att->eatt); i++) {
+		if (att->eatt[i] && att->eatt[i]->req == req) {
+			return att->eatt[i];
+		}
+	}
+#endif /* CONFIG_BT_EATT */
+
+	return att->req == req ? att : NULL;
+}
+
 static void att_process(struct bt_att *att)
 {
 	sys_snode_t *node;
 
 	BT_DBG("");
 
+#if defined(CONFIG_BT_EATT)
+	if (att_is_eatt(att)) {
+		eatt_process(att);
+		return;
+	}
+#endif /* CONFIG_BT_EATT */
+
 	/* Pull next request from the list */
 	node = sys_slist_get(&att->reqs);
 	if (!node) {
@@ -528,19 +721,18 @@ static u8_t att_find_info_rsp(struct bt_att *att, u16_t start_handle,
 	if (!data.rsp) {
 		net_buf_unref(data.buf);
 		/* Respond since handle is set */
-		send_err_rsp(conn, BT_ATT_OP_FIND_INFO_REQ, start_handle,
+		send_err_rsp(att, BT_ATT_OP_FIND_INFO_REQ, start_handle,
 			     BT_ATT_ERR_ATTRIBUTE_NOT_FOUND);
 		return 0;
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf, att_rsp_sent, NULL);
+	att_chan_send(att, data.buf, att_rsp_sent);
 
 	return 0;
 }
 
 static u8_t att_find_info_req(struct bt_att *att, struct net_buf *buf)
 {
-	struct bt_conn *conn = att->chan.chan.conn;
 	struct bt_att_find_info_req *req;
 	u16_t start_handle, end_handle, err_handle;
 
@@ -553,7 +745,7 @@ static u8_t att_find_info_req(struct bt_att *att, struct net_buf *buf)
 	       end_handle);
 
 	if (!range_is_valid(start_handle, end_handle, &err_handle)) {
-		send_err_rsp(conn, BT_ATT_OP_FIND_INFO_REQ, err_handle,
+		send_err_rsp(att, BT_ATT_OP_FIND_INFO_REQ, err_handle,
 			     BT_ATT_ERR_INVALID_HANDLE);
 		return 0;
 	}
@@ -674,19 +866,18 @@ static u8_t att_find_type_rsp(struct bt_att *att, u16_t start_handle,
 	if (data.err) {
 		net_buf_unref(data.buf);
 		/* Respond since handle is set */
-		send_err_rsp(conn, BT_ATT_OP_FIND_TYPE_REQ, start_handle,
+		send_err_rsp(att, BT_ATT_OP_FIND_TYPE_REQ, start_handle,
 			     data.err);
 		return 0;
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf, att_rsp_sent, NULL);
+	att_chan_send(att, data.buf, att_rsp_sent);
 
 	return 0;
 }
 
 static u8_t att_find_type_req(struct bt_att *att, struct net_buf *buf)
 {
-	struct bt_conn *conn = att->chan.chan.conn;
 	struct bt_att_find_type_req *req;
 	u16_t start_handle, end_handle, err_handle, type;
 	u8_t *value;
@@ -702,7 +893,7 @@ static u8_t att_find_type_req(struct bt_att *att, struct net_buf *buf)
 	       end_handle, type);
 
 	if (!range_is_valid(start_handle, end_handle, &err_handle)) {
-		send_err_rsp(conn, BT_ATT_OP_FIND_TYPE_REQ, err_handle,
+		send_err_rsp(att, BT_ATT_OP_FIND_TYPE_REQ, err_handle,
 			     BT_ATT_ERR_INVALID_HANDLE);
 		return 0;
 	}
@@ -713,7 +904,7 @@ static u8_t att_find_type_req(struct bt_att *att, struct net_buf *buf)
 	 * UUID for the specific primary service.
 	 */
 	if (bt_uuid_cmp(BT_UUID_DECLARE_16(type), BT_UUID_GATT_PRIMARY)) {
-		send_err_rsp(conn, BT_ATT_OP_FIND_TYPE_REQ, start_handle,
+		send_err_rsp(att, BT_ATT_OP_FIND_TYPE_REQ, start_handle,
 			     BT_ATT_ERR_ATTRIBUTE_NOT_FOUND);
 		return 0;
 	}
@@ -872,19 +1063,18 @@ static u8_t att_read_type_rsp(struct bt_att *att, struct bt_uuid *uuid,
 	if (data.err) {
 		net_buf_unref(data.buf);
 		/* Response here since handle is set */
-		send_err_rsp(conn, BT_ATT_OP_READ_TYPE_REQ, start_handle,
+		send_err_rsp(att, BT_ATT_OP_READ_TYPE_REQ, start_handle,
 			     data.err);
 		return 0;
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf, att_rsp_sent, NULL);
+	att_chan_send(att, data.buf, att_rsp_sent);
 
 	return 0;
 }
 
 static u8_t att_read_type_req(struct bt_att *att, struct net_buf *buf)
 {
-	struct bt_conn *conn = att->chan.chan.conn;
 	struct bt_att_read_type_req *req;
 	u16_t start_handle, end_handle, err_handle;
 	union {
@@ -911,7 +1101,7 @@ static u8_t att_read_type_req(struct bt_att *att, struct net_buf *buf)
 	       start_handle, end_handle, bt_uuid_str(&u.uuid));
 
 	if (!range_is_valid(start_handle, end_handle, &err_handle)) {
-		send_err_rsp(conn, BT_ATT_OP_READ_TYPE_REQ, err_handle,
+		send_err_rsp(att, BT_ATT_OP_READ_TYPE_REQ, err_handle,
 			     BT_ATT_ERR_INVALID_HANDLE);
 		return 0;
 	}
@@ -996,11 +1186,11 @@ static u8_t att_read_rsp(struct bt_att *att, u8_t op, u8_t rsp, u16_t handle,
 	if (data.err) {
 		net_buf_unref(data.buf);
 		/* Respond here since handle is set */
-		send_err_rsp(conn, op, handle, data.err);
+		send_err_rsp(att, op, handle, data.err);
 		return 0;
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf, att_rsp_sent, NULL);
+	att_chan_send(att, data.buf, att_rsp_sent);
 
 	return 0;
 }
@@ -1072,13 +1262,13 @@ static u8_t att_read_mult_req(struct bt_att *att, struct net_buf *buf)
 		if (data.err) {
 			net_buf_unref(data.buf);
 			/* Respond here since handle is set */
-			send_err_rsp(conn, BT_ATT_OP_READ_MULT_REQ, handle,
+			send_err_rsp(att, BT_ATT_OP_READ_MULT_REQ, handle,
 				     data.err);
 			return 0;
 		}
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf, att_rsp_sent, NULL);
+	att_chan_send(att, data.buf, att_rsp_sent);
 
 	return 0;
 }
@@ -1178,19 +1368,18 @@ static u8_t att_read_group_rsp(struct bt_att *att, struct bt_uuid *uuid,
 	if (!data.rsp->len) {
 		net_buf_unref(data.buf);
 		/* Respond here since handle is set */
-		send_err_rsp(conn, BT_ATT_OP_READ_GROUP_REQ, start_handle,
+		send_err_rsp(att, BT_ATT_OP_READ_GROUP_REQ, start_handle,
 			     BT_ATT_ERR_ATTRIBUTE_NOT_FOUND);
 		return 0;
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf, att_rsp_sent, NULL);
+	att_chan_send(att, data.buf, att_rsp_sent);
 
 	return 0;
 }
 
 static u8_t att_read_group_req(struct bt_att *att, struct net_buf *buf)
 {
-	struct bt_conn *conn = att->chan.chan.conn;
 	struct bt_att_read_group_req *req;
 	u16_t start_handle, end_handle, err_handle;
 	union {
@@ -1218,7 +1407,7 @@ static u8_t att_read_group_req(struct bt_att *att, struct net_buf *buf)
 	       start_handle, end_handle, bt_uuid_str(&u.uuid));
 
 	if (!range_is_valid(start_handle, end_handle, &err_handle)) {
-		send_err_rsp(conn, BT_ATT_OP_READ_GROUP_REQ, err_handle,
+		send_err_rsp(att, BT_ATT_OP_READ_GROUP_REQ, err_handle,
 			     BT_ATT_ERR_INVALID_HANDLE);
 		return 0;
 	}
@@ -1232,7 +1421,7 @@ static u8_t att_read_group_req(struct bt_att *att, struct net_buf *buf)
 	 */
 	if (bt_uuid_cmp(&u.uuid, BT_UUID_GATT_PRIMARY) &&
 	    bt_uuid_cmp(&u.uuid, BT_UUID_GATT_SECONDARY)) {
-		send_err_rsp(conn, BT_ATT_OP_READ_GROUP_REQ, start_handle,
+		send_err_rsp(att, BT_ATT_OP_READ_GROUP_REQ, start_handle,
 			     BT_ATT_ERR_UNSUPPORTED_GROUP_TYPE);
 		return 0;
 	}
@@ -1282,10 +1471,11 @@ static u8_t write_cb(const struct bt_gatt_attr *attr, void *user_data)
 	return BT_GATT_ITER_CONTINUE;
 }
 
-static u8_t att_write_rsp(struct bt_conn *conn, u8_t req, u8_t rsp,
+static u8_t att_write_rsp(struct bt_att *att, u8_t req, u8_t rsp,
 			  u16_t handle, u16_t offset, const void *value,
 			  u8_t len)
 {
+	struct bt_conn *conn = att->chan.chan.conn;
 	struct write_data data;
 
 	if (!bt_gatt_change_aware(conn, req ? true : false)) {
@@ -1320,14 +1510,13 @@ static u8_t att_write_rsp(struct bt_conn *conn, u8_t req, u8_t rsp,
 		if (rsp) {
 			net_buf_unref(data.buf);
 			/* Respond here since handle is set */
-			send_err_rsp(conn, req, handle, data.err);
+			send_err_rsp(att, req, handle, data.err);
 		}
 		return req == BT_ATT_OP_EXEC_WRITE_REQ ? data.err : 0;
 	}
 
 	if (data.buf) {
-		bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf,
-				 att_rsp_sent, NULL);
+		att_chan_send(att, data.buf, att_rsp_sent);
 	}
 
 	return 0;
@@ -1335,14 +1524,13 @@ static u8_t att_write_rsp(struct bt_conn *conn, u8_t req, u8_t rsp,
 
 static u8_t att_write_req(struct bt_att *att, struct net_buf *buf)
 {
-	struct bt_conn *conn = att->chan.chan.conn;
 	u16_t handle;
 
 	handle = net_buf_pull_le16(buf);
 
 	BT_DBG("handle 0x%04x", handle);
 
-	return att_write_rsp(conn, BT_ATT_OP_WRITE_REQ, BT_ATT_OP_WRITE_RSP,
+	return att_write_rsp(att, BT_ATT_OP_WRITE_REQ, BT_ATT_OP_WRITE_RSP,
 			     handle, 0, buf->data, buf->len);
 }
 
@@ -1429,7 +1617,7 @@ static u8_t att_prep_write_rsp(struct bt_att *att, u16_t handle, u16_t offset,
 
 	if (data.err) {
 		/* Respond here since handle is set */
-		send_err_rsp(conn, BT_ATT_OP_PREPARE_WRITE_REQ, handle,
+		send_err_rsp(att, BT_ATT_OP_PREPARE_WRITE_REQ, handle,
 			     data.err);
 		return 0;
 	}
@@ -1451,7 +1639,7 @@ static u8_t att_prep_write_rsp(struct bt_att *att, u16_t handle, u16_t offset,
 	net_buf_add(data.buf, len);
 	memcpy(rsp->value, value, len);
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, data.buf, att_rsp_sent, NULL);
+	att_chan_send(att, data.buf, att_rsp_sent);
 
 	return 0;
 }
@@ -1491,12 +1679,12 @@ static u8_t att_exec_write_rsp(struct bt_att *att, u8_t flags)
 
 		/* Just discard the data if an error was set */
 		if (!err && flags == BT_ATT_FLAG_EXEC) {
-			err = att_write_rsp(conn, BT_ATT_OP_EXEC_WRITE_REQ, 0,
+			err = att_write_rsp(att, BT_ATT_OP_EXEC_WRITE_REQ, 0,
 					    data->handle, data->offset,
 					    buf->data, buf->len);
 			if (err) {
 				/* Respond here since handle is set */
-				send_err_rsp(conn, BT_ATT_OP_EXEC_WRITE_REQ,
+				send_err_rsp(att, BT_ATT_OP_EXEC_WRITE_REQ,
 					     data->handle, err);
 			}
 		}
@@ -1514,7 +1702,7 @@ static u8_t att_exec_write_rsp(struct bt_att *att, u8_t flags)
 		return BT_ATT_ERR_UNLIKELY;
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, buf, att_rsp_sent, NULL);
+	att_chan_send(att, buf, att_rsp_sent);
 
 	return 0;
 }
@@ -1538,14 +1726,13 @@ static u8_t att_exec_write_req(struct bt_att *att, struct net_buf *buf)
 
 static u8_t att_write_cmd(struct bt_att *att, struct net_buf *buf)
 {
-	struct bt_conn *conn = att->chan.chan.conn;
 	u16_t handle;
 
 	handle = net_buf_pull_le16(buf);
 
 	BT_DBG("handle 0x%04x", handle);
 
-	return att_write_rsp(conn, 0, 0, handle, 0, buf->data, buf->len);
+	return att_write_rsp(att, 0, 0, handle, 0, buf->data, buf->len);
 }
 
 #if defined(CONFIG_BT_SIGNING)
@@ -1574,7 +1761,7 @@ static u8_t att_signed_write_cmd(struct bt_att *att, struct net_buf *buf)
 	net_buf_pull(buf, sizeof(struct bt_att_hdr));
 	net_buf_pull(buf, sizeof(*req));
 
-	return att_write_rsp(conn, 0, 0, handle, 0, buf->data,
+	return att_write_rsp(att, 0, 0, handle, 0, buf->data,
 			     buf->len - sizeof(struct bt_att_signature));
 }
 #endif /* CONFIG_BT_SIGNING */
@@ -1784,7 +1971,7 @@ static u8_t att_indicate(struct bt_att *att, struct net_buf *buf)
 		return 0;
 	}
 
-	bt_l2cap_send_cb(conn, BT_L2CAP_CID_ATT, buf, att_cfm_sent, NULL);
+	att_chan_send(att, buf, att_cfm_sent);
 
 	return 0;
 }
@@ -1960,6 +2147,7 @@ static att_type_t att_op_get_type(u8_t op)
 	case BT_ATT_OP_EXEC_WRITE_RSP:
 		return ATT_RESPONSE;
 	case BT_ATT_OP_NOTIFY:
+	case BT_ATT_OP_NOTIFY_MULT:
 		return ATT_NOTIFICATION;
 	case BT_ATT_OP_INDICATE:
 		return ATT_INDICATION;
@@ -1994,7 +2182,7 @@ static int bt_att_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
 	if (!handler) {
 		BT_WARN("Unhandled ATT code 0x%02x", hdr->code);
 		if (att_op_get_type(hdr->code) != ATT_COMMAND) {
-			send_err_rsp(chan->conn, hdr->code, 0,
+			send_err_rsp(att, hdr->code, 0,
 				     BT_ATT_ERR_NOT_SUPPORTED);
 		}
 		return 0;
@@ -2022,7 +2210,7 @@ static int bt_att_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
 
 	if (handler->type == ATT_REQUEST && err) {
 		BT_DBG("ATT error 0x%02x", err);
-		send_err_rsp(chan->conn, hdr->code, 0, err);
+		send_err_rsp(att, hdr->code, 0, err);
 	}
 
 	return 0;
@@ -2152,6 +2340,14 @@ static void att_timeout(struct k_work *work)
 	 */
 	att_reset(att);
 
+#if defined(CONFIG_BT_EATT)
+	/* Only this bearer is lost */
+	if (att_is_eatt(att)) {
+		bt_l2cap_chan_disconnect(&ch->chan);
+		return;
+	}
+#endif /* CONFIG_BT_EATT */
+
 	/* Consider the channel disconnected */
 	bt_gatt_disconnected(ch->chan.conn);
 	ch->chan.conn = NULL;
@@ -2216,6 +2412,16 @@ static void bt_att_encrypt_change(struct bt_l2cap_chan *chan,
 		return;
 	}
 
+#if defined(CONFIG_BT_EATT)
+	if (att_is_eatt(att)) {
+		BT_DBG("Retrying");
+
+		eatt_send(att, att->req->buf);
+		att->req->buf = NULL;
+		return;
+	}
+#endif /* CONFIG_BT_EATT */
+
 	k_sem_take(&att->tx_sem, K_FOREVER);
 	if (!att_is_connected(att)) {
 		BT_WARN("Disconnected");
@@ -2270,8 +2476,165 @@ static int bt_att_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
 
 BT_L2CAP_CHANNEL_DEFINE(att_fixed_chan, BT_L2CAP_CID_ATT, bt_att_accept);
 
+#if defined(CONFIG_BT_EATT)
+static void eatt_free(struct bt_att *att)
+{
+	struct bt_att *fixed = att->fixed;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(fixed->eatt); i++) {
+		if (fixed->eatt[i] == att) {
+			fixed->eatt[i] = NULL;
+		}
+	}
+
+	att->fixed = NULL;
+}
+
+static void eatt_connected(struct bt_l2cap_chan *chan)
+{
+	struct bt_att *att = ATT_CHAN(chan);
+	struct bt_l2cap_le_chan *ch = BT_L2CAP_LE_CHAN(chan);
+
+	/* The ATT MTU of an enhanced bearer is the smallest of the MTUs of
+	 * its channel.
+	 */
+	ch->tx.mtu = MIN(MIN(ch->tx.mtu, ch->rx.mtu), BT_ATT_MTU);
+
+	BT_DBG("chan %p cid 0x%04x mtu %u", ch, ch->tx.cid, ch->tx.mtu);
+
+	/* Take over a queued request */
+	att_process(att);
+}
+
+static void eatt_disconnected(struct bt_l2cap_chan *chan)
+{
+	struct bt_att *att = ATT_CHAN(chan);
+
+	BT_DBG("chan %p", chan);
+
+	att_reset(att);
+	eatt_free(att);
+}
+
+static struct bt_att *eatt_alloc(struct bt_att *fixed)
+{
+	static struct bt_l2cap_chan_ops ops = {
+		.connected = eatt_connected,
+		.disconnected = eatt_disconnected,
+		.recv = bt_att_recv,
+		.encrypt_change = bt_att_encrypt_change,
+	};
+	struct bt_att *att = NULL;
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(fixed->eatt); i++) {
+		if (!fixed->eatt[i]) {
+			break;
+		}
+	}
+
+	if (i == ARRAY_SIZE(fixed->eatt)) {
+		BT_WARN("No available EATT bearer for conn %p",
+			fixed->chan.chan.conn);
+		return NULL;
+	}
+
+	for (j = 0; j < ARRAY_SIZE(eatt_pool); j++) {
+		if (!eatt_pool[j].fixed) {
+			att = &eatt_pool[j];
+			break;
+		}
+	}
+
+	if (!att) {
+		BT_ERR("No available EATT context");
+		return NULL;
+	}
+
+	(void)memset(att, 0, sizeof(*att));
+	att->chan.chan.ops = &ops;
+	att->chan.chan.required_sec_level = BT_SECURITY_L2;
+	att->fixed = fixed;
+	k_sem_init(&att->tx_sem, CONFIG_BT_ATT_TX_MAX, CONFIG_BT_ATT_TX_MAX);
+	k_fifo_init(&att->tx_queue);
+#if CONFIG_BT_ATT_PREPARE_COUNT > 0
+	k_fifo_init(&att->prep_queue);
+#endif
+	k_delayed_work_init(&att->timeout_work, att_timeout);
+	sys_slist_init(&att->reqs);
+
+	fixed->eatt[i] = att;
+
+	return att;
+}
+
+static int eatt_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
+{
+	struct bt_att *fixed, *att;
+
+	BT_DBG("conn %p handle %u", conn, conn->handle);
+
+	fixed = att_chan_get(conn);
+	if (!fixed) {
+		return -ENOTCONN;
+	}
+
+	att = eatt_alloc(fixed);
+	if (!att) {
+		return -ENOMEM;
+	}
+
+	*chan = &att->chan.chan;
+
+	return 0;
+}
+
+static struct bt_l2cap_server eatt_server = {
+	.psm		= BT_EATT_PSM,
+	.sec_level	= BT_SECURITY_L2,
+	.accept		= eatt_accept,
+};
+
+int bt_att_eatt_connect(struct bt_conn *conn, u8_t num)
+{
+	struct bt_att *fixed, *att;
+	int err;
+
+	fixed = att_chan_get(conn);
+	if (!fixed) {
+		return -ENOTCONN;
+	}
+
+	while (num--) {
+		att = eatt_alloc(fixed);
+		if (!att) {
+			return -ENOMEM;
+		}
+
+		err = bt_l2cap_chan_connect(conn, &att->chan.chan,
+					    BT_EATT_PSM);
+		if (err) {
+			eatt_free(att);
+			return err;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_BT_EATT */
+
 void bt_att_init(void)
 {
+#if defined(CONFIG_BT_EATT)
+	int err;
+
+	err = bt_l2cap_server_register(&eatt_server);
+	if (err) {
+		BT_ERR("EATT server registration failed (err %d)", err);
+	}
+#endif /* CONFIG_BT_EATT */
+
 	bt_gatt_init();
 }
 
@@ -2325,7 +2688,7 @@ int bt_att_send(struct bt_conn *conn, struct net_buf *buf, bt_conn_tx_cb_t cb,
 
 int bt_att_req_send(struct bt_conn *conn, struct bt_att_req *req)
 {
-	struct bt_att *att;
+	struct bt_att *att, *bearer;
 
 	BT_DBG("conn %p req %p", conn, req);
 
@@ -2338,19 +2701,20 @@ int bt_att_req_send(struct bt_conn *conn, struct bt_att_req *req)
 		return -ENOTCONN;
 	}
 
-	/* Check if there is a request outstanding */
-	if (att->req) {
+	/* Check if there is a bearer without request outstanding */
+	bearer = att_req_bearer(att, req);
+	if (!bearer) {
 		/* Queue the request to be send later */
 		sys_slist_append(&att->reqs, &req->node);
 		return 0;
 	}
 
-	return att_send_req(att, req);
+	return att_send_req(bearer, req);
 }
 
 void bt_att_req_cancel(struct bt_conn *conn, struct bt_att_req *req)
 {
-	struct bt_att *att;
+	struct bt_att *att, *bearer;
 
 	BT_DBG("req %p", req);
 
@@ -2364,8 +2728,9 @@ void bt_att_req_cancel(struct bt_conn *conn, struct bt_att_req *req)
 	}
 
 	/* Check if request is outstanding */
-	if (att->req == req) {
-		att->req = &cancel;
+	bearer = att_req_find_bearer(att, req);
+	if (bearer) {
+		bearer->req = &cancel;
 	} else {
 		/* Remove request from the list */
 		sys_slist_find_and_remove(&att->reqs, &req->node);
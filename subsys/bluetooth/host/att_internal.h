@@ -208,6 +208,14 @@ struct bt_att_notify {
 	u8_t  value[0];
 } __packed;
 
+/* Multiple Handle Value Notification */
+#define BT_ATT_OP_NOTIFY_MULT			0x23
+struct bt_att_notify_mult {
+	u16_t handle;
+	u16_t len;
+	u8_t  value[0];
+} __packed;
+
 /* Handle Value Indication */
 #define BT_ATT_OP_INDICATE			0x1d
 struct bt_att_indicate {
@@ -258,3 +266,6 @@ int bt_att_req_send(struct bt_conn *conn, struct bt_att_req *req);
 
 /* Cancel ATT request */
 void bt_att_req_cancel(struct bt_conn *conn, struct bt_att_req *req);
+
+/* Connect Enhanced ATT bearers */
+int bt_att_eatt_connect(struct bt_conn *conn, u8_t num);
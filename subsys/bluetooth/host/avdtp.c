@@ -43,6 +43,8 @@ static struct bt_avdtp_seid_lsep *lseps;
 
 #define AVDTP_CHAN(_ch) CONTAINER_OF(_ch, struct bt_avdtp, br_chan.chan)
 
+#define AVDTP_STREAM(_ch) CONTAINER_OF(_ch, struct bt_avdtp_stream, chan.chan)
+
 #define AVDTP_KWORK(_work) CONTAINER_OF(_work, struct bt_avdtp_req,\
 					timeout_work)
 
@@ -282,6 +284,115 @@ int bt_avdtp_register_sep(u8_t media_type, u8_t role,
 	return 0;
 }
 
+/* Transport channel callbacks */
+static void avdtp_media_connected(struct bt_l2cap_chan *chan)
+{
+	struct bt_avdtp_stream *stream = AVDTP_STREAM(chan);
+
+	BT_DBG("chan %p stream %p", chan, stream);
+
+	stream->seq = 0U;
+	stream->state = BT_AVDTP_STREAM_STATE_OPEN;
+}
+
+static void avdtp_media_disconnected(struct bt_l2cap_chan *chan)
+{
+	struct bt_avdtp_stream *stream = AVDTP_STREAM(chan);
+
+	BT_DBG("chan %p stream %p", chan, stream);
+
+	stream->state = BT_AVDTP_STREAM_STATE_IDLE;
+
+	/* Wake up a sender waiting for a packet which will never complete,
+	 * it passes the semaphore on to the next one.
+	 */
+	k_sem_give(&stream->tx_sem);
+}
+
+static int avdtp_media_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	/* Only the source role is supported: there is no media to receive */
+	BT_DBG("chan %p len %u", chan, buf->len);
+
+	return 0;
+}
+
+static void avdtp_media_sent(struct bt_conn *conn, void *user_data)
+{
+	struct bt_avdtp_stream *stream = user_data;
+
+	k_sem_give(&stream->tx_sem);
+}
+
+int bt_avdtp_stream_connect(struct bt_avdtp *session,
+			    struct bt_avdtp_stream *stream)
+{
+	static struct bt_l2cap_chan_ops ops = {
+		.connected = avdtp_media_connected,
+		.disconnected = avdtp_media_disconnected,
+		.recv = avdtp_media_recv,
+	};
+
+	if (!session || !stream) {
+		return -EINVAL;
+	}
+
+	BT_DBG("session %p stream %p", session, stream);
+
+	stream->chan.chan.ops = &ops;
+	stream->chan.chan.required_sec_level = BT_SECURITY_L2;
+	stream->chan.rx.mtu = BT_AVDTP_MAX_MTU;
+	k_sem_init(&stream->tx_sem, CONFIG_BT_AVDTP_MEDIA_TX_COUNT,
+		   CONFIG_BT_AVDTP_MEDIA_TX_COUNT);
+
+	return bt_l2cap_chan_connect(session->br_chan.chan.conn,
+				     &stream->chan.chan, BT_L2CAP_PSM_AVDTP);
+}
+
+int bt_avdtp_stream_disconnect(struct bt_avdtp_stream *stream)
+{
+	if (!stream) {
+		return -EINVAL;
+	}
+
+	BT_DBG("stream %p", stream);
+
+	return bt_l2cap_chan_disconnect(&stream->chan.chan);
+}
+
+int bt_avdtp_media_send(struct bt_avdtp_stream *stream, struct net_buf *buf,
+			u32_t timestamp)
+{
+	struct bt_avdtp_media_hdr *hdr;
+
+	if (buf->len + sizeof(*hdr) > stream->chan.tx.mtu) {
+		return -EMSGSIZE;
+	}
+
+	/* Queuing more packets than the controller can take would only add
+	 * latency, wait for it to complete one of those in flight instead.
+	 */
+	k_sem_take(&stream->tx_sem, K_FOREVER);
+
+	if (stream->state != BT_AVDTP_STREAM_STATE_OPEN &&
+	    stream->state != BT_AVDTP_STREAM_STATE_STREAMING) {
+		k_sem_give(&stream->tx_sem);
+		return -ENOTCONN;
+	}
+
+	hdr = net_buf_push(buf, sizeof(*hdr));
+	hdr->flags = BT_AVDTP_MEDIA_RTP_VERSION;
+	hdr->pt = BT_AVDTP_MEDIA_PT;
+	hdr->seq = sys_cpu_to_be16(stream->seq++);
+	hdr->ts = sys_cpu_to_be32(timestamp);
+	hdr->ssrc = sys_cpu_to_be32(stream->lsep.id);
+
+	bt_l2cap_send_cb(stream->chan.chan.conn, stream->chan.tx.cid, buf,
+			 avdtp_media_sent, stream);
+
+	return 0;
+}
+
 /* init function */
 int bt_avdtp_init(void)
 {
@@ -107,6 +107,21 @@ struct bt_avdtp_single_sig_hdr {
 
 #define BT_AVDTP_SIG_HDR_LEN sizeof(struct bt_avdtp_single_sig_hdr)
 
+/* RTP header of the media packets */
+struct bt_avdtp_media_hdr {
+	u8_t flags; /* Version, padding, extension and CSRC count */
+	u8_t pt; /* Marker and payload type */
+	u16_t seq;
+	u32_t ts;
+	u32_t ssrc;
+} __packed;
+
+/* RTP version 2, without padding, extension nor CSRC */
+#define BT_AVDTP_MEDIA_RTP_VERSION 0x80
+
+/* Dynamic RTP payload type used by A2DP */
+#define BT_AVDTP_MEDIA_PT 96
+
 struct bt_avdtp_ind_cb {
 	/*
 	 * discovery_ind;
@@ -168,3 +183,10 @@ int bt_avdtp_register_sep(u8_t media_type, u8_t role,
 /* AVDTP Discover Request */
 int bt_avdtp_discover(struct bt_avdtp *session,
 		      struct bt_avdtp_discover_params *param);
+
+/* AVDTP transport channel connect */
+int bt_avdtp_stream_connect(struct bt_avdtp *session,
+			    struct bt_avdtp_stream *stream);
+
+/* AVDTP transport channel disconnect */
+int bt_avdtp_stream_disconnect(struct bt_avdtp_stream *stream);
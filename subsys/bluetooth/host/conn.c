@@ -1179,6 +1179,10 @@ void bt_conn_recv(struct bt_conn *conn, struct net_buf *buf, u8_t flags)
 int bt_conn_send_cb(struct bt_conn *conn, struct net_buf *buf,
 		    bt_conn_tx_cb_t cb, void *user_data)
 {
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	atomic_val_t queued;
+#endif
+
 	BT_DBG("conn handle %u buf len %u cb %p user_data %p", conn->handle,
 	       buf->len, cb, user_data);
 
@@ -1191,6 +1195,14 @@ int bt_conn_send_cb(struct bt_conn *conn, struct net_buf *buf,
 	conn_tx(buf)->cb = cb;
 	conn_tx(buf)->user_data = user_data;
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	/* Counted first, so that the TX thread never takes it below zero */
+	queued = atomic_inc(&conn->tx_queued) + 1;
+	if (queued > conn->tx_stats.queued_max) {
+		conn->tx_stats.queued_max = queued;
+	}
+#endif
+
 	net_buf_put(&conn->tx_queue, buf);
 	return 0;
 }
@@ -1280,9 +1292,13 @@ static struct bt_conn_tx *add_pending_tx(struct bt_conn *conn,
 	k_work_init(&tx->work, tx_notify_cb);
 	tx->data.cb = cb;
 	tx->data.user_data = user_data;
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	tx->sent = k_uptime_get_32();
+#endif
 
 	key = irq_lock();
 	sys_slist_append(&conn->tx_pending, &tx->node);
+	conn->tx_pending_cnt++;
 	irq_unlock(key);
 
 	return tx;
@@ -1293,12 +1309,48 @@ static void remove_pending_tx(struct bt_conn *conn, struct bt_conn_tx *tx)
 	unsigned int key;
 
 	key = irq_lock();
-	sys_slist_find_and_remove(&conn->tx_pending, &tx->node);
+	if (sys_slist_find_and_remove(&conn->tx_pending, &tx->node)) {
+		conn->tx_pending_cnt--;
+	}
 	irq_unlock(key);
 
 	tx_free(tx);
 }
 
+struct bt_conn_tx *bt_conn_tx_complete(struct bt_conn *conn)
+{
+	struct bt_conn_tx *tx;
+	sys_snode_t *node;
+	unsigned int key;
+
+	key = irq_lock();
+	node = sys_slist_get(&conn->tx_pending);
+	if (node) {
+		conn->tx_pending_cnt--;
+	}
+	irq_unlock(key);
+
+	if (!node) {
+		return NULL;
+	}
+
+	tx = CONTAINER_OF(node, struct bt_conn_tx, node);
+
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	{
+		u32_t latency = k_uptime_get_32() - tx->sent;
+
+		conn->tx_stats.completed++;
+		conn->tx_latency_total += latency;
+		if (latency > conn->tx_stats.latency_max) {
+			conn->tx_stats.latency_max = latency;
+		}
+	}
+#endif
+
+	return tx;
+}
+
 static bool send_frag(struct bt_conn *conn, struct net_buf *buf, u8_t flags,
 		      bool always_consume)
 {
@@ -1309,13 +1361,12 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, u8_t flags,
 	BT_DBG("conn %p buf %p len %u flags 0x%02x", conn, buf, buf->len,
 	       flags);
 
-	/* Wait until the controller can accept ACL packets */
-	k_sem_take(bt_conn_get_pkts(conn), K_FOREVER);
+	/* The caller has taken a controller buffer, given back on failure */
 
 	/* Make sure we notify and free up any pending tx contexts */
 	notify_tx();
 
-	/* Check for disconnection while waiting for pkts_sem */
+	/* Check for disconnection since the packet was queued */
 	if (conn->state != BT_CONN_CONNECTED) {
 		goto fail;
 	}
@@ -1385,48 +1436,76 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 	return frag;
 }
 
-static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
+static struct net_buf *tx_dequeue(struct bt_conn *conn)
+{
+	struct net_buf *buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
+
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	atomic_dec(&conn->tx_queued);
+#endif
+
+	return buf;
+}
+
+/* Send the next fragment of the packet at the head of the TX queue, with
+ * the controller buffer taken by the caller. The packet only leaves the
+ * queue with its last fragment, so that the other connections get their
+ * turn between two fragments.
+ */
+static bool send_next_frag(struct bt_conn *conn, struct net_buf *buf)
 {
 	struct net_buf *frag;
+	u8_t flags;
 
 	BT_DBG("conn %p buf %p len %u", conn, buf, buf->len);
 
-	/* Send directly if the packet fits the ACL MTU */
+	if (atomic_test_bit(conn->flags, BT_CONN_TX_CONT)) {
+		flags = BT_ACL_CONT;
+	} else {
+		flags = BT_ACL_START_NO_FLUSH;
+	}
+
+	/* Send directly if the rest of the packet fits the ACL MTU, for
+	 * the last fragment this simply uses the original buffer (which
+	 * works since we've used net_buf_pull on it).
+	 */
 	if (buf->len <= conn_mtu(conn)) {
-		return send_frag(conn, buf, BT_ACL_START_NO_FLUSH, false);
+		buf = tx_dequeue(conn);
+		atomic_clear_bit(conn->flags, BT_CONN_TX_CONT);
+
+		if (!send_frag(conn, buf, flags, false)) {
+			net_buf_unref(buf);
+			return false;
+		}
+
+		return true;
 	}
 
-	/* Create & enqueue first fragment */
 	frag = create_frag(conn, buf);
 	if (!frag) {
-		return false;
+		k_sem_give(bt_conn_get_pkts(conn));
+		goto drop;
 	}
 
-	if (!send_frag(conn, frag, BT_ACL_START_NO_FLUSH, true)) {
-		return false;
+	if (!send_frag(conn, frag, flags, true)) {
+		goto drop;
 	}
 
-	/*
-	 * Send the fragments. For the last one simply use the original
-	 * buffer (which works since we've used net_buf_pull on it.
-	 */
-	while (buf->len > conn_mtu(conn)) {
-		frag = create_frag(conn, buf);
-		if (!frag) {
-			return false;
-		}
-
-		if (!send_frag(conn, frag, BT_ACL_CONT, true)) {
-			return false;
-		}
-	}
+	atomic_set_bit(conn->flags, BT_CONN_TX_CONT);
+	return true;
 
-	return send_frag(conn, buf, BT_ACL_CONT, false);
+drop:
+	atomic_clear_bit(conn->flags, BT_CONN_TX_CONT);
+	net_buf_unref(tx_dequeue(conn));
+	return false;
 }
 
 static struct k_poll_signal conn_change =
 		K_POLL_SIGNAL_INITIALIZER(conn_change);
 
+/* Connection polled first for ACL data */
+static u8_t tx_next;
+
 static void conn_cleanup(struct bt_conn *conn)
 {
 	struct net_buf *buf;
@@ -1436,6 +1515,11 @@ static void conn_cleanup(struct bt_conn *conn)
 		net_buf_unref(buf);
 	}
 
+	atomic_clear_bit(conn->flags, BT_CONN_TX_CONT);
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	atomic_set(&conn->tx_queued, 0);
+#endif
+
 	__ASSERT(sys_slist_is_empty(&conn->tx_pending), "Pending TX packets");
 
 	bt_conn_notify_tx(conn);
@@ -1448,8 +1532,42 @@ static void conn_cleanup(struct bt_conn *conn)
 	bt_conn_unref(conn);
 }
 
+/* Number of controller buffers a connection may hold while the other
+ * connections sharing them have data queued, so that a connection whose
+ * peer is slow to acknowledge does not keep the buffers from the others.
+ */
+static u16_t tx_fair_share(struct k_sem *pkts)
+{
+	u16_t total = k_sem_count_get(pkts);
+	u16_t waiting = 0U;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		struct bt_conn *conn = &conns[i];
+
+		if (!atomic_get(&conn->ref) ||
+		    bt_conn_get_pkts(conn) != pkts) {
+			continue;
+		}
+
+		total += conn->tx_pending_cnt;
+
+		if (conn->state == BT_CONN_CONNECTED &&
+		    !k_fifo_is_empty(&conn->tx_queue)) {
+			waiting++;
+		}
+	}
+
+	return ceiling_fraction(total, MAX(waiting, 1U));
+}
+
 int bt_conn_prepare_events(struct k_poll_event events[])
 {
+	u16_t le_share, share;
+#if defined(CONFIG_BT_BREDR)
+	u16_t br_share;
+#endif
+	struct k_sem *pkts;
 	int i, ev_count = 0;
 
 	BT_DBG("");
@@ -1458,8 +1576,14 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 	k_poll_event_init(&events[ev_count++], K_POLL_TYPE_SIGNAL,
 			  K_POLL_MODE_NOTIFY_ONLY, &conn_change);
 
+	le_share = tx_fair_share(&bt_dev.le.pkts);
+#if defined(CONFIG_BT_BREDR)
+	br_share = tx_fair_share(&bt_dev.br.pkts);
+#endif
+
+	/* Start after the connection which sent last */
 	for (i = 0; i < ARRAY_SIZE(conns); i++) {
-		struct bt_conn *conn = &conns[i];
+		struct bt_conn *conn = &conns[(tx_next + i) % ARRAY_SIZE(conns)];
 
 		if (!atomic_get(&conn->ref)) {
 			continue;
@@ -1483,6 +1607,22 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 				  &conn->tx_notify);
 		events[ev_count++].tag = BT_EVENT_CONN_TX_NOTIFY;
 
+		pkts = bt_conn_get_pkts(conn);
+		share = le_share;
+#if defined(CONFIG_BT_BREDR)
+		if (pkts == &bt_dev.br.pkts) {
+			share = br_share;
+		}
+#endif
+
+		/* Only wait for the queued data when it can be sent, the
+		 * controller completing a packet of any connection wakes
+		 * the thread up through its tx_notify FIFO.
+		 */
+		if (!k_sem_count_get(pkts) || conn->tx_pending_cnt >= share) {
+			continue;
+		}
+
 		k_poll_event_init(&events[ev_count],
 				  K_POLL_TYPE_FIFO_DATA_AVAILABLE,
 				  K_POLL_MODE_NOTIFY_ONLY,
@@ -1506,11 +1646,19 @@ void bt_conn_process_tx(struct bt_conn *conn)
 		return;
 	}
 
+	/* The controller buffers may have gone to the connections polled
+	 * before this one, in which case the packet stays queued.
+	 */
+	if (k_sem_take(bt_conn_get_pkts(conn), K_NO_WAIT)) {
+		return;
+	}
+
 	/* Get next ACL packet for connection */
-	buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
+	buf = k_fifo_peek_head(&conn->tx_queue);
 	BT_ASSERT(buf);
-	if (!send_buf(conn, buf)) {
-		net_buf_unref(buf);
+	if (send_next_frag(conn, buf)) {
+		/* Poll the other connections first next time */
+		tx_next = bt_conn_index(conn) + 1;
 	}
 }
 
@@ -1544,6 +1692,9 @@ static void process_unack_tx(struct bt_conn *conn)
 
 		key = irq_lock();
 		node = sys_slist_get(&conn->tx_pending);
+		if (node) {
+			conn->tx_pending_cnt--;
+		}
 		irq_unlock(key);
 
 		if (!node) {
@@ -1856,6 +2007,22 @@ int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
 	return -EINVAL;
 }
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+int bt_conn_get_tx_stats(const struct bt_conn *conn,
+			 struct bt_conn_tx_stats *stats)
+{
+	*stats = conn->tx_stats;
+	stats->queued = atomic_get(&conn->tx_queued);
+	stats->pending = conn->tx_pending_cnt;
+
+	if (stats->completed) {
+		stats->latency_avg = conn->tx_latency_total / stats->completed;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 static int bt_hci_disconnect(struct bt_conn *conn, u8_t reason)
 {
 	struct net_buf *buf;
@@ -30,6 +30,7 @@ enum {
 	BT_CONN_SLAVE_PARAM_SET,	/* If slave param were set from app */
 	BT_CONN_SLAVE_PARAM_L2CAP,	/* If should force L2CAP for CPUP */
 	BT_CONN_FORCE_PAIR,             /* Pairing even with existing keys. */
+	BT_CONN_TX_CONT,		/* Head of tx_queue partially sent */
 
 	/* Total number of flags - must be at the end of the enum */
 	BT_CONN_NUM_FLAGS,
@@ -92,6 +93,10 @@ struct bt_conn_tx {
 	struct bt_conn *conn;
 	struct k_work work;
 	struct bt_conn_tx_data data;
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	/* Uptime when the packet was sent to the controller */
+	u32_t sent;
+#endif
 };
 
 struct bt_conn {
@@ -120,12 +125,19 @@ struct bt_conn {
 
 	/* Sent but not acknowledged TX packets */
 	sys_slist_t		tx_pending;
+	u16_t			tx_pending_cnt;
 	/* Acknowledged but not yet notified TX packets */
 	struct k_fifo		tx_notify;
 
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	atomic_t		tx_queued;
+	struct bt_conn_tx_stats	tx_stats;
+	u32_t			tx_latency_total;
+#endif
+
 	/* Active L2CAP channels */
 	sys_slist_t		channels;
 
@@ -143,6 +155,9 @@ struct bt_conn {
 /* Process incoming data for a connection */
 void bt_conn_recv(struct bt_conn *conn, struct net_buf *buf, u8_t flags);
 
+/* Remove the oldest TX packet the controller has completed */
+struct bt_conn_tx *bt_conn_tx_complete(struct bt_conn *conn);
+
 /* Send data over a connection */
 int bt_conn_send_cb(struct bt_conn *conn, struct net_buf *buf,
 		    bt_conn_tx_cb_t cb, void *user_data);
@@ -67,6 +67,33 @@ static const u16_t gap_appearance = CONFIG_BT_DEVICE_APPEARANCE;
 static sys_slist_t db;
 static atomic_t init;
 
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+/* Services of db in ascending handle order, to look up the service of a
+ * handle without walking the list. Not used when more services are
+ * registered than it can hold.
+ */
+static struct bt_gatt_service *db_index[CONFIG_BT_GATT_DB_INDEX_SIZE];
+static size_t db_index_count;
+static bool db_index_valid = true;
+
+static void db_index_update(void)
+{
+	struct bt_gatt_service *svc;
+
+	db_index_count = 0;
+	db_index_valid = true;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		if (db_index_count == ARRAY_SIZE(db_index)) {
+			db_index_valid = false;
+			return;
+		}
+
+		db_index[db_index_count++] = svc;
+	}
+}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, u16_t len, u16_t offset)
 {
@@ -198,6 +225,7 @@ enum {
 };
 
 #define CF_ROBUST_CACHING(_cfg) (_cfg->data[0] & BIT(0))
+#define CF_NOTIFY_MULTI(_cfg) (_cfg->data[0] & BIT(2))
 
 struct gatt_cf_cfg {
 	u8_t                    id;
@@ -246,7 +274,8 @@ static bool cf_set_value(struct gatt_cf_cfg *cfg, const u8_t *value, u16_t len)
 {
 	u16_t i;
 	u8_t last_byte = 1U;
-	u8_t last_bit = 1U;
+	/* Bit 1 (EATT) is not supported */
+	u8_t last_bit = IS_ENABLED(CONFIG_BT_GATT_NOTIFY_MULTIPLE) ? 3U : 1U;
 
 	/* Validate the bits */
 	for (i = 0U; i < len && i < last_byte; i++) {
@@ -603,6 +632,7 @@ populate:
 	}
 
 	gatt_insert(svc, last_handle);
+	db_index_update();
 
 	return 0;
 }
@@ -879,6 +909,8 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+	db_index_update();
+
 	sc_indicate(&gatt_sc, svc->attrs[0].handle,
 		    svc->attrs[svc->attr_count - 1].handle);
 
@@ -1089,13 +1121,66 @@ static u8_t gatt_foreach_iter(const struct bt_gatt_attr *attr,
 	return result;
 }
 
+/* Return the first service of db ending at or after the handle */
+static struct bt_gatt_service *db_find_service(u16_t handle)
+{
+	struct bt_gatt_service *svc;
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	if (db_index_valid) {
+		size_t low = 0, high = db_index_count;
+
+		while (low < high) {
+			size_t mid = (low + high) / 2U;
+
+			svc = db_index[mid];
+			if (svc->attrs[svc->attr_count - 1].handle < handle) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		return low < db_index_count ? db_index[low] : NULL;
+	}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		if (svc->attrs[svc->attr_count - 1].handle >= handle) {
+			return svc;
+		}
+	}
+
+	return NULL;
+}
+
+/* Return the index of the first attribute of the service at or after the
+ * handle, attributes being in ascending handle order.
+ */
+static size_t svc_find_attr(const struct bt_gatt_service *svc, u16_t handle)
+{
+	size_t low = 0, high = svc->attr_count;
+
+	while (low < high) {
+		size_t mid = (low + high) / 2U;
+
+		if (svc->attrs[mid].handle < handle) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
 void bt_gatt_foreach_attr_type(u16_t start_handle, u16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
 			       bt_gatt_attr_func_t func, void *user_data)
 {
 	struct bt_gatt_service *svc;
-	int i;
+	size_t i;
 
 	if (!num_matches) {
 		num_matches = UINT16_MAX;
@@ -1111,7 +1196,16 @@ void bt_gatt_foreach_attr_type(u16_t start_handle, u16_t end_handle,
 				continue;
 			}
 
-			for (i = 0; i < static_svc->attr_count; i++, handle++) {
+			/* Static handles are sequential, go straight to the
+			 * start handle.
+			 */
+			i = 0;
+			if (start_handle > handle) {
+				i = start_handle - handle;
+				handle = start_handle;
+			}
+
+			for (; i < static_svc->attr_count; i++, handle++) {
 				struct bt_gatt_attr attr;
 
 				memcpy(&attr, &static_svc->attrs[i],
@@ -1130,18 +1224,10 @@ void bt_gatt_foreach_attr_type(u16_t start_handle, u16_t end_handle,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
-		struct bt_gatt_service *next;
-
-		next = SYS_SLIST_PEEK_NEXT_CONTAINER(svc, node);
-		if (next) {
-			/* Skip ahead if start is not within service handles */
-			if (next->attrs[0].handle <= start_handle) {
-				continue;
-			}
-		}
-
-		for (i = 0; i < svc->attr_count; i++) {
+	for (svc = db_find_service(start_handle); svc;
+	     svc = SYS_SLIST_PEEK_NEXT_CONTAINER(svc, node)) {
+		for (i = svc_find_attr(svc, start_handle); i < svc->attr_count;
+		     i++) {
 			struct bt_gatt_attr *attr = &svc->attrs[i];
 
 			if (gatt_foreach_iter(attr, start_handle, end_handle,
@@ -1357,6 +1443,10 @@ struct notify_data {
 	};
 };
 
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+static struct bt_gatt_notify_stats notify_stats;
+#endif
+
 static int gatt_notify(struct bt_conn *conn, u16_t handle,
 		       struct bt_gatt_notify_params *params)
 {
@@ -1389,6 +1479,12 @@ static int gatt_notify(struct bt_conn *conn, u16_t handle,
 	net_buf_add(buf, params->len);
 	memcpy(nfy->value, params->data, params->len);
 
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	notify_stats.notifications++;
+	notify_stats.pdus++;
+	notify_stats.bytes += buf->len;
+#endif
+
 	return bt_att_send(conn, buf, params->func, params->user_data);
 }
 
@@ -1576,10 +1672,9 @@ static u8_t match_uuid(const struct bt_gatt_attr *attr, void *user_data)
 	return BT_GATT_ITER_STOP;
 }
 
-int bt_gatt_notify_cb(struct bt_conn *conn,
-		      struct bt_gatt_notify_params *params)
+static int gatt_notify_handle(struct bt_gatt_notify_params *params,
+			      u16_t *value_handle)
 {
-	struct notify_data data;
 	const struct bt_gatt_attr *attr;
 	u16_t handle;
 
@@ -1620,6 +1715,23 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 		handle = bt_gatt_attr_value_handle(attr);
 	}
 
+	*value_handle = handle;
+
+	return 0;
+}
+
+int bt_gatt_notify_cb(struct bt_conn *conn,
+		      struct bt_gatt_notify_params *params)
+{
+	struct notify_data data;
+	u16_t handle;
+	int err;
+
+	err = gatt_notify_handle(params, &handle);
+	if (err) {
+		return err;
+	}
+
 	if (conn) {
 		return gatt_notify(conn, handle, params);
 	}
@@ -1634,6 +1746,145 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 	return data.err;
 }
 
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+static bool gatt_notify_mult_supported(struct bt_conn *conn)
+{
+	struct gatt_cf_cfg *cfg = find_cf_cfg(conn);
+
+	return cfg && CF_NOTIFY_MULTI(cfg);
+}
+
+/* Send a Multiple Handle Value Notification, which must hold at least two
+ * values: a single one is sent in a Handle Value Notification instead.
+ */
+static int gatt_notify_mult_send(struct bt_conn *conn, struct net_buf *buf,
+				 u16_t count, u16_t handle,
+				 struct bt_gatt_notify_params *last)
+{
+	u16_t len;
+	int err;
+
+	if (count == 1U) {
+		net_buf_unref(buf);
+		return gatt_notify(conn, handle, last);
+	}
+
+	BT_DBG("conn %p count %u len %u", conn, count, buf->len);
+
+	len = buf->len;
+
+	/* Notifications with a callback don't wait for the ATT TX queue, so
+	 * that several PDUs can be queued to the connection.
+	 */
+	err = bt_att_send(conn, buf, last->func, last->user_data);
+	if (err) {
+		net_buf_unref(buf);
+		return err;
+	}
+
+	notify_stats.notifications += count;
+	notify_stats.pdus++;
+	notify_stats.bytes += len;
+
+	return 0;
+}
+
+int bt_gatt_notify_multiple(struct bt_conn *conn, u16_t num_params,
+			    struct bt_gatt_notify_params *params)
+{
+	struct bt_gatt_notify_params *last = NULL;
+	struct bt_att_notify_mult *nfy;
+	struct net_buf *buf = NULL;
+	u16_t handle, last_handle = 0U, count = 0U, mtu, i;
+	int err;
+
+	__ASSERT(conn, "invalid parameters\n");
+	__ASSERT(params || !num_params, "invalid parameters\n");
+
+	if (conn->state != BT_CONN_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	if (!gatt_notify_mult_supported(conn)) {
+		for (i = 0U; i < num_params; i++) {
+			err = bt_gatt_notify_cb(conn, &params[i]);
+			if (err) {
+				return err;
+			}
+		}
+
+		return 0;
+	}
+
+#if defined(CONFIG_BT_GATT_ENFORCE_CHANGE_UNAWARE)
+	if (!bt_gatt_change_aware(conn, false)) {
+		return -EAGAIN;
+	}
+#endif
+
+	mtu = bt_gatt_get_mtu(conn);
+
+	for (i = 0U; i < num_params; i++) {
+		u16_t len = sizeof(*nfy) + params[i].len;
+
+		err = gatt_notify_handle(&params[i], &handle);
+		if (err) {
+			goto fail;
+		}
+
+		/* Send the values packed so far if this one doesn't fit */
+		if (buf && buf->len + len > mtu) {
+			err = gatt_notify_mult_send(conn, buf, count,
+						    last_handle, last);
+			buf = NULL;
+			if (err) {
+				return err;
+			}
+		}
+
+		if (!buf) {
+			buf = bt_att_create_pdu(conn, BT_ATT_OP_NOTIFY_MULT,
+						len);
+			if (!buf) {
+				BT_WARN("No buffer available to send "
+					"notification");
+				return -ENOMEM;
+			}
+
+			count = 0U;
+		}
+
+		nfy = net_buf_add(buf, sizeof(*nfy));
+		nfy->handle = sys_cpu_to_le16(handle);
+		nfy->len = sys_cpu_to_le16(params[i].len);
+		net_buf_add_mem(buf, params[i].data, params[i].len);
+
+		last = &params[i];
+		last_handle = handle;
+		count++;
+	}
+
+	if (buf) {
+		return gatt_notify_mult_send(conn, buf, count, last_handle,
+					     last);
+	}
+
+	return 0;
+
+fail:
+	if (buf) {
+		net_buf_unref(buf);
+	}
+
+	return err;
+}
+
+void bt_gatt_notify_stats_get(struct bt_gatt_notify_stats *stats)
+{
+	*stats = notify_stats;
+}
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+
 int bt_gatt_indicate(struct bt_conn *conn,
 		     struct bt_gatt_indicate_params *params)
 {
@@ -1697,6 +1948,13 @@ u16_t bt_gatt_get_mtu(struct bt_conn *conn)
 	return bt_att_get_mtu(conn);
 }
 
+#if defined(CONFIG_BT_EATT)
+int bt_gatt_eatt_connect(struct bt_conn *conn, u8_t num)
+{
+	return bt_att_eatt_connect(conn, num);
+}
+#endif /* CONFIG_BT_EATT */
+
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
 static void sc_restore(struct bt_gatt_ccc_cfg *cfg)
 {
@@ -77,6 +77,9 @@ struct bt_dev bt_dev = {
 #if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
 	.rx_queue      = Z_FIFO_INITIALIZER(bt_dev.rx_queue),
 #endif
+#if defined(CONFIG_BT_RX_CONN_EVT_FIRST)
+	.rx_conn_queue = Z_FIFO_INITIALIZER(bt_dev.rx_conn_queue),
+#endif
 };
 
 static bt_ready_cb_t ready_cb;
@@ -125,8 +128,17 @@ struct acl_data {
 	u16_t handle;
 };
 
+struct evt_data {
+	/** BT_BUF_EVT */
+	u8_t  type;
+
+	/** Uptime when the event was given to bt_recv() */
+	u32_t recv;
+};
+
 #define cmd(buf) ((struct cmd_data *)net_buf_user_data(buf))
 #define acl(buf) ((struct acl_data *)net_buf_user_data(buf))
+#define evt(buf) ((struct evt_data *)net_buf_user_data(buf))
 
 /* HCI command buffers. Derive the needed size from BT_BUF_RX_SIZE since
  * the same buffer is also used for the response.
@@ -675,18 +687,15 @@ static void hci_num_completed_packets(struct net_buf *buf)
 		irq_unlock(key);
 
 		while (count--) {
-			sys_snode_t *node;
+			struct bt_conn_tx *tx;
 
-			key = irq_lock();
-			node = sys_slist_get(&conn->tx_pending);
-			irq_unlock(key);
-
-			if (!node) {
+			tx = bt_conn_tx_complete(conn);
+			if (!tx) {
 				BT_ERR("packets count mismatch");
 				break;
 			}
 
-			k_fifo_put(&conn->tx_notify, node);
+			k_fifo_put(&conn->tx_notify, tx);
 			k_sem_give(bt_conn_get_pkts(conn));
 		}
 
@@ -4048,8 +4057,7 @@ static void read_supported_commands_complete(struct net_buf *buf)
 	 * supported if TinyCrypt ECC is used for emulation.
 	 */
 	if (IS_ENABLED(CONFIG_BT_TINYCRYPT_ECC)) {
-		bt_dev.supported_commands[34] |= 0x02;
-		bt_dev.supported_commands[34] |= 0x04;
+		bt_hci_ecc_supported_commands(bt_dev.supported_commands);
 	}
 }
 
@@ -4888,6 +4896,73 @@ int bt_send(struct net_buf *buf)
 	return bt_dev.drv->send(buf);
 }
 
+#if defined(CONFIG_BT_RX_CONN_EVT_FIRST) || defined(CONFIG_BT_RX_DELAY_STATS)
+static bool evt_is_conn(struct net_buf *buf)
+{
+	struct bt_hci_evt_hdr *hdr = (void *)buf->data;
+	struct bt_hci_evt_le_meta_event *meta;
+
+	if (buf->len < sizeof(*hdr)) {
+		return false;
+	}
+
+	if (hdr->evt == BT_HCI_EVT_DISCONN_COMPLETE) {
+		return true;
+	}
+
+	if (hdr->evt != BT_HCI_EVT_LE_META_EVENT ||
+	    buf->len < sizeof(*hdr) + sizeof(*meta)) {
+		return false;
+	}
+
+	meta = (void *)&buf->data[sizeof(*hdr)];
+
+	switch (meta->subevent) {
+	case BT_HCI_EVT_LE_CONN_COMPLETE:
+	case BT_HCI_EVT_LE_ENH_CONN_COMPLETE:
+	case BT_HCI_EVT_LE_CONN_UPDATE_COMPLETE:
+	case BT_HCI_EVT_LE_CONN_PARAM_REQ:
+		return true;
+	default:
+		return false;
+	}
+}
+#endif /* CONFIG_BT_RX_CONN_EVT_FIRST || CONFIG_BT_RX_DELAY_STATS */
+
+#if defined(CONFIG_BT_RX_CONN_EVT_FIRST)
+static bool evt_is_disconn(struct net_buf *buf)
+{
+	struct bt_hci_evt_hdr *hdr = (void *)buf->data;
+
+	return buf->len >= sizeof(*hdr) &&
+	       hdr->evt == BT_HCI_EVT_DISCONN_COMPLETE;
+}
+#endif /* CONFIG_BT_RX_CONN_EVT_FIRST */
+
+#if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
+static void rx_queue_evt(struct net_buf *buf)
+{
+#if defined(CONFIG_BT_RX_DELAY_STATS)
+	evt(buf)->recv = k_uptime_get_32();
+#endif
+
+#if defined(CONFIG_BT_RX_CONN_EVT_FIRST)
+	/* A Disconnection Complete stays behind the data of the link, and
+	 * the connection events after it wait for it, since the handle
+	 * may be reused by the next connection.
+	 */
+	if (evt_is_disconn(buf)) {
+		atomic_inc(&bt_dev.rx_disconn);
+	} else if (evt_is_conn(buf) && !atomic_get(&bt_dev.rx_disconn)) {
+		net_buf_put(&bt_dev.rx_conn_queue, buf);
+		return;
+	}
+#endif
+
+	net_buf_put(&bt_dev.rx_queue, buf);
+}
+#endif /* !CONFIG_BT_RECV_IS_RX_THREAD */
+
 int bt_recv(struct net_buf *buf)
 {
 	bt_monitor_send(bt_monitor_opcode(buf), buf->data, buf->len);
@@ -4908,7 +4983,7 @@ int bt_recv(struct net_buf *buf)
 #if defined(CONFIG_BT_RECV_IS_RX_THREAD)
 		hci_event(buf);
 #else
-		net_buf_put(&bt_dev.rx_queue, buf);
+		rx_queue_evt(buf);
 #endif
 		return 0;
 	default:
@@ -5048,6 +5123,68 @@ static void init_work(struct k_work *work)
 	}
 }
 
+#if defined(CONFIG_BT_RX_DELAY_STATS)
+static struct bt_hci_rx_delay_stats rx_delay_stats;
+
+static void rx_delay_update(struct net_buf *buf)
+{
+	u32_t delay = k_uptime_get_32() - evt(buf)->recv;
+	u32_t *hist;
+
+	if (evt_is_conn(buf)) {
+		hist = rx_delay_stats.conn_evt;
+	} else {
+		hist = rx_delay_stats.evt;
+	}
+
+	hist[MIN(find_msb_set(delay), BT_HCI_RX_DELAY_BUCKETS - 1)]++;
+}
+
+void bt_hci_get_rx_delay_stats(struct bt_hci_rx_delay_stats *stats)
+{
+	*stats = rx_delay_stats;
+}
+#endif /* CONFIG_BT_RX_DELAY_STATS */
+
+#if defined(CONFIG_BT_RX_CONN_EVT_FIRST)
+static struct net_buf *rx_get(void)
+{
+	static struct k_poll_event events[] = {
+		K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+						K_POLL_MODE_NOTIFY_ONLY,
+						&bt_dev.rx_conn_queue, 0),
+		K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+						K_POLL_MODE_NOTIFY_ONLY,
+						&bt_dev.rx_queue, 0),
+	};
+	struct net_buf *buf;
+
+	while (1) {
+		buf = net_buf_get(&bt_dev.rx_conn_queue, K_NO_WAIT);
+		if (buf) {
+			return buf;
+		}
+
+		buf = net_buf_get(&bt_dev.rx_queue, K_NO_WAIT);
+		if (buf) {
+			/* The connection events received after the
+			 * disconnection are now processed after it.
+			 */
+			if (bt_buf_get_type(buf) == BT_BUF_EVT &&
+			    evt_is_disconn(buf)) {
+				atomic_dec(&bt_dev.rx_disconn);
+			}
+
+			return buf;
+		}
+
+		events[0].state = K_POLL_STATE_NOT_READY;
+		events[1].state = K_POLL_STATE_NOT_READY;
+		k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+	}
+}
+#endif /* CONFIG_BT_RX_CONN_EVT_FIRST */
+
 #if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
 static void hci_rx_thread(void)
 {
@@ -5057,7 +5194,11 @@ static void hci_rx_thread(void)
 
 	while (1) {
 		BT_DBG("calling fifo_get_wait");
+#if defined(CONFIG_BT_RX_CONN_EVT_FIRST)
+		buf = rx_get();
+#else
 		buf = net_buf_get(&bt_dev.rx_queue, K_FOREVER);
+#endif
 
 		BT_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf),
 		       buf->len);
@@ -5069,6 +5210,9 @@ static void hci_rx_thread(void)
 			break;
 #endif /* CONFIG_BT_CONN */
 		case BT_BUF_EVT:
+#if defined(CONFIG_BT_RX_DELAY_STATS)
+			rx_delay_update(buf);
+#endif
 			hci_event(buf);
 			break;
 		default:
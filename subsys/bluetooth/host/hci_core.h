@@ -165,6 +165,13 @@ struct bt_dev {
 	struct k_fifo		rx_queue;
 #endif
 
+#if defined(CONFIG_BT_RX_CONN_EVT_FIRST)
+	/* Queue for incoming connection events, processed first */
+	struct k_fifo		rx_conn_queue;
+	/* Disconnection Complete events in rx_queue */
+	atomic_t		rx_disconn;
+#endif
+
 	/* Queue for outgoing HCI commands */
 	struct k_fifo		cmd_tx_queue;
 
@@ -58,6 +58,8 @@ static const u8_t debug_public_key[64] = {
 enum {
 	PENDING_PUB_KEY,
 	PENDING_DHKEY,
+	SPARE_KEY,
+	CTLR_ECC,
 
 	/* Total number of flags - must be at the end of the enum */
 	NUM_FLAGS,
@@ -76,6 +78,14 @@ static struct {
 	};
 } ecc;
 
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PREGEN)
+/* Next key pair, generated while the thread is idle */
+static struct {
+	u8_t private_key[32];
+	u8_t pk[64];
+} spare;
+#endif
+
 static void send_cmd_status(u16_t opcode, u8_t status)
 {
 	struct bt_hci_evt_cmd_status *evt;
@@ -99,20 +109,52 @@ static void send_cmd_status(u16_t opcode, u8_t status)
 	bt_recv_prio(buf);
 }
 
-static u8_t generate_keys(void)
-{
 #if !defined(CONFIG_BT_USE_DEBUG_KEYS)
+static u8_t make_key(u8_t pk[64], u8_t private_key[32])
+{
 	do {
 		int rc;
 
-		rc = uECC_make_key(ecc.pk, ecc.private_key, &curve_secp256r1);
+		rc = uECC_make_key(pk, private_key, &curve_secp256r1);
 		if (rc == TC_CRYPTO_FAIL) {
 			BT_ERR("Failed to create ECC public/private pair");
 			return BT_HCI_ERR_UNSPECIFIED;
 		}
 
 	/* make sure generated key isn't debug key */
-	} while (memcmp(ecc.private_key, debug_private_key, 32) == 0);
+	} while (memcmp(private_key, debug_private_key, 32) == 0);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PREGEN)
+static bool generate_spare_key(void)
+{
+	BT_DBG("");
+
+	if (make_key(spare.pk, spare.private_key)) {
+		return false;
+	}
+
+	atomic_set_bit(flags, SPARE_KEY);
+	return true;
+}
+#endif
+
+static u8_t generate_keys(void)
+{
+#if !defined(CONFIG_BT_USE_DEBUG_KEYS)
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PREGEN)
+	if (atomic_test_and_clear_bit(flags, SPARE_KEY)) {
+		memcpy(ecc.pk, spare.pk, sizeof(spare.pk));
+		memcpy(ecc.private_key, spare.private_key,
+		       sizeof(spare.private_key));
+		return 0;
+	}
+#endif
+
+	return make_key(ecc.pk, ecc.private_key);
 #else
 	sys_memcpy_swap(&ecc.pk, debug_public_key, 32);
 	sys_memcpy_swap(&ecc.pk[32], &debug_public_key[32], 32);
@@ -206,8 +248,30 @@ static void emulate_le_generate_dhkey(void)
 
 static void ecc_thread(void *p1, void *p2, void *p3)
 {
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PREGEN)
+	bool spare_failed = false;
+#endif
+
 	while (true) {
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PREGEN)
+		/* Use the idle time to prepare the key pair of the next
+		 * LE Read Local P-256 Public Key command. A failure is only
+		 * retried after the next command.
+		 */
+		if (k_sem_take(&cmd_sem, K_NO_WAIT)) {
+			if (!atomic_test_bit(flags, SPARE_KEY) &&
+			    !spare_failed) {
+				spare_failed = !generate_spare_key();
+				continue;
+			}
+
+			k_sem_take(&cmd_sem, K_FOREVER);
+		}
+
+		spare_failed = false;
+#else
 		k_sem_take(&cmd_sem, K_FOREVER);
+#endif
 
 		if (atomic_test_bit(flags, PENDING_PUB_KEY)) {
 			emulate_le_p256_public_key_cmd();
@@ -287,9 +351,25 @@ static void le_p256_pub_key(struct net_buf *buf)
 	send_cmd_status(BT_HCI_OP_LE_P256_PUBLIC_KEY, status);
 }
 
+void bt_hci_ecc_supported_commands(u8_t *supported_commands)
+{
+	/* LE Read Local P-256 Public Key and LE Generate DH Key */
+	if (IS_ENABLED(CONFIG_BT_TINYCRYPT_ECC_CTLR_FIRST) &&
+	    (supported_commands[34] & 0x06) == 0x06) {
+		BT_DBG("Using controller ECC");
+		atomic_set_bit(flags, CTLR_ECC);
+		return;
+	}
+
+	atomic_clear_bit(flags, CTLR_ECC);
+	supported_commands[34] |= 0x02;
+	supported_commands[34] |= 0x04;
+}
+
 int bt_hci_ecc_send(struct net_buf *buf)
 {
-	if (bt_buf_get_type(buf) == BT_BUF_CMD) {
+	if (bt_buf_get_type(buf) == BT_BUF_CMD &&
+	    !atomic_test_bit(flags, CTLR_ECC)) {
 		struct bt_hci_cmd_hdr *chdr = (void *)buf->data;
 
 		switch (sys_le16_to_cpu(chdr->opcode)) {
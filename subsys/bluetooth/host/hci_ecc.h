@@ -8,3 +8,4 @@
 
 void bt_hci_ecc_init(void);
 int bt_hci_ecc_send(struct net_buf *buf);
+void bt_hci_ecc_supported_commands(u8_t *supported_commands);
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <sys/atomic.h>
 #include <sys/util.h>
+#include <sys/byteorder.h>
 
 #include <settings/settings.h>
 
@@ -31,6 +32,47 @@
 
 static struct bt_keys key_pool[CONFIG_BT_MAX_PAIRED];
 
+#if CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0
+/* Recent RPA resolutions, indexed by the hash part of the address which is
+ * itself the output of the resolution function. Unused entries have
+ * BT_ADDR_ANY, which is not an RPA.
+ */
+struct rpa_cache_entry {
+	bt_addr_t		rpa;
+	u8_t			id;
+	/* Index into key_pool, ARRAY_SIZE(key_pool) if no IRK matched */
+	u8_t			keys;
+};
+
+static struct rpa_cache_entry rpa_cache[CONFIG_BT_KEYS_RPA_CACHE_SIZE];
+
+static struct rpa_cache_entry *rpa_cache_entry(const bt_addr_t *rpa)
+{
+	u16_t hash = sys_get_le16(rpa->val);
+
+	return &rpa_cache[hash % ARRAY_SIZE(rpa_cache)];
+}
+
+static void rpa_cache_add(u8_t id, const bt_addr_t *rpa, struct bt_keys *keys)
+{
+	struct rpa_cache_entry *entry = rpa_cache_entry(rpa);
+
+	bt_addr_copy(&entry->rpa, rpa);
+	entry->id = id;
+	entry->keys = keys ? keys - key_pool : ARRAY_SIZE(key_pool);
+}
+
+/* Called whenever an IRK is added, changed or removed, as the cached
+ * results may not hold anymore.
+ */
+static void rpa_cache_flush(void)
+{
+	(void)memset(rpa_cache, 0, sizeof(rpa_cache));
+}
+#else
+static inline void rpa_cache_flush(void) {}
+#endif /* CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0 */
+
 struct bt_keys *bt_keys_get_addr(u8_t id, const bt_addr_le_t *addr)
 {
 	struct bt_keys *keys;
@@ -116,6 +158,11 @@ struct bt_keys *bt_keys_get_type(int type, u8_t id, const bt_addr_le_t *addr)
 
 	BT_DBG("type %d %s", type, bt_addr_le_str(addr));
 
+	/* The IRK is about to be set */
+	if (type & BT_KEYS_IRK) {
+		rpa_cache_flush();
+	}
+
 	keys = bt_keys_find(type, id, addr);
 	if (keys) {
 		return keys;
@@ -131,16 +178,10 @@ struct bt_keys *bt_keys_get_type(int type, u8_t id, const bt_addr_le_t *addr)
 	return keys;
 }
 
-struct bt_keys *bt_keys_find_irk(u8_t id, const bt_addr_le_t *addr)
+static struct bt_keys *keys_resolve_irk(u8_t id, const bt_addr_le_t *addr)
 {
 	int i;
 
-	BT_DBG("%s", bt_addr_le_str(addr));
-
-	if (!bt_addr_le_is_rpa(addr)) {
-		return NULL;
-	}
-
 	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
 		if (!(key_pool[i].keys & BT_KEYS_IRK)) {
 			continue;
@@ -180,6 +221,43 @@ struct bt_keys *bt_keys_find_irk(u8_t id, const bt_addr_le_t *addr)
 	return NULL;
 }
 
+struct bt_keys *bt_keys_find_irk(u8_t id, const bt_addr_le_t *addr)
+{
+#if CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0
+	struct rpa_cache_entry *entry;
+#endif
+	struct bt_keys *keys;
+
+	BT_DBG("%s", bt_addr_le_str(addr));
+
+	if (!bt_addr_le_is_rpa(addr)) {
+		return NULL;
+	}
+
+#if CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0
+	entry = rpa_cache_entry(&addr->a);
+	if (entry->id == id && !bt_addr_cmp(&entry->rpa, &addr->a)) {
+		if (entry->keys == ARRAY_SIZE(key_pool)) {
+			BT_DBG("No IRK for %s (cached)", bt_addr_le_str(addr));
+			return NULL;
+		}
+
+		keys = &key_pool[entry->keys];
+		bt_addr_copy(&keys->irk.rpa, &addr->a);
+
+		return keys;
+	}
+#endif /* CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0 */
+
+	keys = keys_resolve_irk(id, addr);
+
+#if CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0
+	rpa_cache_add(id, &addr->a, keys);
+#endif
+
+	return keys;
+}
+
 struct bt_keys *bt_keys_find_addr(u8_t id, const bt_addr_le_t *addr)
 {
 	int i;
@@ -198,6 +276,10 @@ struct bt_keys *bt_keys_find_addr(u8_t id, const bt_addr_le_t *addr)
 
 void bt_keys_add_type(struct bt_keys *keys, int type)
 {
+	if (type & BT_KEYS_IRK) {
+		rpa_cache_flush();
+	}
+
 	keys->keys |= type;
 }
 
@@ -207,11 +289,16 @@ void bt_keys_clear(struct bt_keys *keys)
 
 	if (keys->keys & BT_KEYS_IRK) {
 		bt_id_del(keys);
+		rpa_cache_flush();
 	}
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		char key[BT_SETTINGS_KEY_MAX];
 
+#if CONFIG_BT_KEYS_SAVE_DELAY > 0
+		atomic_clear_bit(save_pending, keys - key_pool);
+#endif
+
 		/* Delete stored keys from flash */
 		if (keys->id) {
 			char id[4];
@@ -250,7 +337,7 @@ void bt_keys_clear_all(u8_t id)
 }
 
 #if defined(CONFIG_BT_SETTINGS)
-int bt_keys_store(struct bt_keys *keys)
+static int keys_save(struct bt_keys *keys)
 {
 	char key[BT_SETTINGS_KEY_MAX];
 	int err;
@@ -278,6 +365,45 @@ int bt_keys_store(struct bt_keys *keys)
 	return 0;
 }
 
+#if CONFIG_BT_KEYS_SAVE_DELAY > 0
+/* Entries of key_pool to be stored by save_work */
+static ATOMIC_DEFINE(save_pending, CONFIG_BT_MAX_PAIRED);
+static struct k_delayed_work save_work;
+static atomic_t save_work_init;
+
+static void keys_save_pending(struct k_work *work)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
+		if (atomic_test_and_clear_bit(save_pending, i)) {
+			(void)keys_save(&key_pool[i]);
+		}
+	}
+}
+
+int bt_keys_store(struct bt_keys *keys)
+{
+	if (!atomic_set(&save_work_init, 1)) {
+		k_delayed_work_init(&save_work, keys_save_pending);
+	}
+
+	atomic_set_bit(save_pending, keys - key_pool);
+
+	/* Restarted on each update, so that the updates of a pairing or of
+	 * successive pairings are written together.
+	 */
+	k_delayed_work_submit(&save_work, K_MSEC(CONFIG_BT_KEYS_SAVE_DELAY));
+
+	return 0;
+}
+#else
+int bt_keys_store(struct bt_keys *keys)
+{
+	return keys_save(keys);
+}
+#endif /* CONFIG_BT_KEYS_SAVE_DELAY > 0 */
+
 static int keys_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 		    void *cb_arg)
 {
@@ -303,6 +429,8 @@ static int keys_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 	BT_DBG("name %s val %s", log_strdup(name),
 	       (len) ? bt_hex(val, sizeof(val)) : "(null)");
 
+	rpa_cache_flush();
+
 	err = bt_settings_decode_key(name, &addr);
 	if (err) {
 		BT_ERR("Unable to decode address %s", name);
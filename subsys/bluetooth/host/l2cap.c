@@ -705,6 +705,16 @@ static void l2cap_chan_rx_init(struct bt_l2cap_le_chan *chan)
 	 */
 	chan->rx.mps = MIN(chan->rx.mtu + 2, L2CAP_MAX_LE_MPS);
 	k_sem_init(&chan->rx.credits, 0, UINT_MAX);
+	chan->_rx_credits = 0U;
+
+	/* Without alloc_buf the segments are held until the SDU is complete,
+	 * so the SDU shall not need more segments than there are credits.
+	 */
+	if (!chan->chan.ops->alloc_buf) {
+		chan->rx.mtu = MIN(chan->rx.mtu,
+				   (u32_t)chan->rx.init_credits *
+				   chan->rx.mps - 2);
+	}
 
 	if (BT_DBG_ENABLED &&
 	    chan->rx.init_credits * chan->rx.mps < chan->rx.mtu + 2) {
@@ -1214,6 +1224,37 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch, struct net_buf *buf,
 	return len;
 }
 
+/* Send the next segment from the fragment at the head of the remaining SDU
+ * data. A fragment followed by others which fits in a segment and has room
+ * for the headers is sent on its own, without copying it.
+ */
+static int l2cap_chan_le_send_frag(struct bt_l2cap_le_chan *ch,
+				   struct net_buf **frag)
+{
+	struct net_buf *buf = *frag;
+	struct net_buf *next = buf->frags;
+	int ret;
+
+	if (!next || buf->len > ch->tx.mps ||
+	    net_buf_headroom(buf) < BT_L2CAP_CHAN_SEND_RESERVE) {
+		return l2cap_chan_le_send(ch, buf, 0);
+	}
+
+	buf->frags = NULL;
+
+	ret = l2cap_chan_le_send(ch, buf, 0);
+	if (ret < 0) {
+		buf->frags = next;
+		return ret;
+	}
+
+	/* The segment being sent holds its own reference */
+	net_buf_unref(buf);
+	*frag = next;
+
+	return ret;
+}
+
 static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 				  struct net_buf **buf, int sent)
 {
@@ -1253,7 +1294,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 			frag = net_buf_frag_del(NULL, frag);
 		}
 
-		ret = l2cap_chan_le_send(ch, frag, 0);
+		ret = l2cap_chan_le_send_frag(ch, &frag);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -1440,11 +1481,27 @@ static void l2cap_chan_send_credits(struct bt_l2cap_le_chan *chan,
 {
 	struct bt_l2cap_le_credits *ev;
 
+	credits += chan->_rx_credits;
+
 	/* Cap the number of credits given */
 	if (credits > chan->rx.init_credits) {
 		credits = chan->rx.init_credits;
 	}
 
+	/* Return the credits in batches while the remote has enough of them
+	 * to keep sending, so that data consumed as fast as it comes doesn't
+	 * cost a credits packet per SDU. The remote is given them as soon as
+	 * it runs low.
+	 */
+	if (credits < chan->rx.init_credits / 2U &&
+	    k_sem_count_get(&chan->rx.credits) > chan->rx.init_credits / 2U) {
+		chan->_rx_credits = credits;
+		BT_DBG("chan %p pending credits %u", chan, credits);
+		return;
+	}
+
+	chan->_rx_credits = 0U;
+
 	l2cap_chan_rx_give_credits(chan, credits);
 
 	buf = l2cap_create_le_sig_pdu(buf, BT_L2CAP_LE_CREDITS, get_ident(),
@@ -1567,13 +1624,18 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 
 	BT_DBG("chan %p seg %d len %zu", chan, seg, net_buf_frags_len(buf));
 
-	/* Append received segment to SDU */
-	len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
-				   l2cap_alloc_frag, chan);
-	if (len != buf->len) {
-		BT_ERR("Unable to store SDU");
-		bt_l2cap_chan_disconnect(&chan->chan);
-		return;
+	if (!chan->chan.ops->alloc_buf) {
+		/* Chain the received segment to the SDU */
+		net_buf_frag_add(chan->_sdu, net_buf_ref(buf));
+	} else {
+		/* Append received segment to SDU */
+		len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data,
+					   K_NO_WAIT, l2cap_alloc_frag, chan);
+		if (len != buf->len) {
+			BT_ERR("Unable to store SDU");
+			bt_l2cap_chan_disconnect(&chan->chan);
+			return;
+		}
 	}
 
 	if (net_buf_frags_len(chan->_sdu) < chan->_sdu_len) {
@@ -1636,6 +1698,18 @@ static void l2cap_chan_le_recv(struct bt_l2cap_le_chan *chan,
 		return;
 	}
 
+	/* Keep the first segment as head of the chain of the SDU segments,
+	 * the SDU is then passed once complete.
+	 */
+	if (sdu_len > buf->len) {
+		u16_t seg = 1U;
+
+		memcpy(net_buf_user_data(buf), &seg, sizeof(seg));
+		chan->_sdu = net_buf_ref(buf);
+		chan->_sdu_len = sdu_len;
+		return;
+	}
+
 	err = chan->chan.ops->recv(&chan->chan, buf);
 	if (err) {
 		if (err != -EINPROGRESS) {
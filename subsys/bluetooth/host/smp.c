@@ -187,6 +187,18 @@ struct bt_smp {
 
 	/* Delayed work for timeout handling */
 	struct k_delayed_work		work;
+
+#if defined(CONFIG_BT_SMP_LOG_TIMINGS)
+	/* Uptime when the pairing started */
+	u32_t				time_start;
+
+	/* Uptime when the current wait for a key started */
+	u32_t				time_wait;
+
+	/* Time waited for the local public key and for the DHKey */
+	u32_t				time_pkey;
+	u32_t				time_dhkey;
+#endif /* CONFIG_BT_SMP_LOG_TIMINGS */
 };
 
 static unsigned int fixed_passkey = BT_PASSKEY_INVALID;
@@ -264,6 +276,33 @@ static bool sc_supported;
 static const u8_t *sc_public_key;
 static K_SEM_DEFINE(sc_local_pkey_ready, 0, 1);
 
+#if CONFIG_BT_SMP_PUB_KEY_ROTATE > 0
+/* LE SC pairings done with the current local public key */
+static u8_t sc_pairings;
+#endif
+
+#if defined(CONFIG_BT_SMP_LOG_TIMINGS)
+static void smp_timing_start(struct bt_smp *smp)
+{
+	smp->time_start = k_uptime_get_32();
+	smp->time_pkey = 0U;
+	smp->time_dhkey = 0U;
+}
+
+static void smp_timing_wait(struct bt_smp *smp)
+{
+	smp->time_wait = k_uptime_get_32();
+}
+
+static u32_t smp_timing_waited(struct bt_smp *smp)
+{
+	return k_uptime_get_32() - smp->time_wait;
+}
+#else
+static inline void smp_timing_start(struct bt_smp *smp) {}
+static inline void smp_timing_wait(struct bt_smp *smp) {}
+#endif /* CONFIG_BT_SMP_LOG_TIMINGS */
+
 static u8_t get_io_capa(void)
 {
 	if (!bt_auth) {
@@ -1179,6 +1218,7 @@ static u8_t smp_br_pairing_req(struct bt_smp_br *smp, struct net_buf *buf)
 	smp_br_send(smp, rsp_buf, NULL);
 
 	atomic_set_bit(smp->flags, SMP_FLAG_PAIRING);
+	smp_timing_start(smp);
 
 	/* derive LTK if requested and clear distribution bits */
 	if ((smp->local_dist & BT_SMP_DIST_ENC_KEY) &&
@@ -1616,6 +1656,7 @@ int bt_smp_br_send_pairing_req(struct bt_conn *conn)
 	atomic_set_bit(&smp->allowed_cmds, BT_SMP_CMD_PAIRING_RSP);
 
 	atomic_set_bit(smp->flags, SMP_FLAG_PAIRING);
+	smp_timing_start(smp);
 
 	return 0;
 }
@@ -1648,10 +1689,56 @@ static void smp_reset(struct bt_smp *smp)
 	}
 }
 
+#if CONFIG_BT_SMP_PUB_KEY_ROTATE > 0
+static struct bt_pub_key_cb pub_key_cb;
+
+/* The public key is part of the computations of the whole pairing, so it
+ * is only changed while no pairing is in progress.
+ */
+static void sc_pub_key_rotate(void)
+{
+	int i, err;
+
+	if (sc_pairings < CONFIG_BT_SMP_PUB_KEY_ROTATE || !sc_public_key) {
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(bt_smp_pool); i++) {
+		if (atomic_test_bit(bt_smp_pool[i].flags, SMP_FLAG_PAIRING)) {
+			return;
+		}
+	}
+
+	BT_DBG("Regenerating public key after %u pairings", sc_pairings);
+
+	sc_pairings = 0U;
+	sc_public_key = NULL;
+
+	err = bt_pub_key_gen(&pub_key_cb);
+	if (err) {
+		BT_ERR("Failed to regenerate public key (err %d)", err);
+	}
+}
+#endif /* CONFIG_BT_SMP_PUB_KEY_ROTATE > 0 */
+
 static void smp_pairing_complete(struct bt_smp *smp, u8_t status)
 {
 	BT_DBG("status 0x%x", status);
 
+#if defined(CONFIG_BT_SMP_LOG_TIMINGS)
+	BT_INFO("Pairing %s in %u ms (public key %u ms, DHKey %u ms)",
+		status ? "failed" : "completed",
+		k_uptime_get_32() - smp->time_start, smp->time_pkey,
+		smp->time_dhkey);
+#endif
+
+#if CONFIG_BT_SMP_PUB_KEY_ROTATE > 0
+	if (atomic_test_bit(smp->flags, SMP_FLAG_SC) &&
+	    sc_pairings < UINT8_MAX) {
+		sc_pairings++;
+	}
+#endif
+
 	if (!status) {
 #if defined(CONFIG_BT_BREDR)
 		/*
@@ -1687,6 +1774,10 @@ static void smp_pairing_complete(struct bt_smp *smp, u8_t status)
 	}
 
 	smp_reset(smp);
+
+#if CONFIG_BT_SMP_PUB_KEY_ROTATE > 0
+	sc_pub_key_rotate();
+#endif
 }
 
 static void smp_timeout(struct k_work *work)
@@ -2615,6 +2706,7 @@ static u8_t smp_pairing_req(struct bt_smp *smp, struct net_buf *buf)
 	}
 
 	atomic_set_bit(smp->flags, SMP_FLAG_PAIRING);
+	smp_timing_start(smp);
 
 	smp->method = get_pair_method(smp, req->io_capability);
 
@@ -2750,6 +2842,7 @@ int bt_smp_send_pairing_req(struct bt_conn *conn)
 
 	atomic_set_bit(&smp->allowed_cmds, BT_SMP_CMD_PAIRING_RSP);
 	atomic_set_bit(smp->flags, SMP_FLAG_PAIRING);
+	smp_timing_start(smp);
 
 	return 0;
 }
@@ -2828,6 +2921,7 @@ static u8_t smp_pairing_rsp(struct bt_smp *smp, struct net_buf *buf)
 
 	if (!sc_public_key) {
 		atomic_set_bit(smp->flags, SMP_FLAG_PKEY_SEND);
+		smp_timing_wait(smp);
 		return 0;
 	}
 
@@ -3039,6 +3133,10 @@ static void bt_smp_dhkey_ready(const u8_t *dhkey)
 		return;
 	}
 
+#if defined(CONFIG_BT_SMP_LOG_TIMINGS)
+	smp->time_dhkey = smp_timing_waited(smp);
+#endif
+
 	if (!dhkey) {
 		smp_error(smp, BT_SMP_ERR_DHKEY_CHECK_FAILED);
 		return;
@@ -3572,6 +3670,8 @@ static u8_t smp_security_request(struct bt_smp *smp, struct net_buf *buf)
 
 static u8_t generate_dhkey(struct bt_smp *smp)
 {
+	smp_timing_wait(smp);
+
 	if (bt_dh_key_gen(smp->pkey, bt_smp_dhkey_ready)) {
 		return BT_SMP_ERR_UNSPECIFIED;
 	}
@@ -3734,6 +3834,7 @@ static u8_t smp_public_key(struct bt_smp *smp, struct net_buf *buf)
 #if defined(CONFIG_BT_PERIPHERAL)
 	if (!sc_public_key) {
 		atomic_set_bit(smp->flags, SMP_FLAG_PKEY_SEND);
+		smp_timing_wait(smp);
 		return 0;
 	}
 
@@ -3922,6 +4023,10 @@ static void bt_smp_pkey_ready(const u8_t *pkey)
 			continue;
 		}
 
+#if defined(CONFIG_BT_SMP_LOG_TIMINGS)
+		smp->time_pkey = smp_timing_waited(smp);
+#endif
+
 		if (IS_ENABLED(CONFIG_BT_CENTRAL) &&
 		    smp->chan.chan.conn->role == BT_HCI_ROLE_MASTER) {
 			err = sc_send_public_key(smp);
@@ -4871,6 +4976,7 @@ int bt_smp_auth_pairing_confirm(struct bt_conn *conn)
 
 		if (!sc_public_key) {
 			atomic_set_bit(smp->flags, SMP_FLAG_PKEY_SEND);
+			smp_timing_wait(smp);
 			return 0;
 		}
 
@@ -5128,11 +5234,19 @@ BT_L2CAP_CHANNEL_DEFINE(smp_br_fixed_chan, BT_L2CAP_CID_BR_SMP,
 			bt_smp_br_accept);
 #endif /* CONFIG_BT_BREDR */
 
+#if CONFIG_BT_SMP_PUB_KEY_ROTATE > 0
+static struct bt_pub_key_cb pub_key_cb = {
+	.func           = bt_smp_pkey_ready,
+};
+#endif
+
 int bt_smp_init(void)
 {
+#if !(CONFIG_BT_SMP_PUB_KEY_ROTATE > 0)
 	static struct bt_pub_key_cb pub_key_cb = {
 		.func           = bt_smp_pkey_ready,
 	};
+#endif
 
 	sc_supported = le_sc_supported();
 	if (IS_ENABLED(CONFIG_BT_SMP_SC_PAIR_ONLY) && !sc_supported) {
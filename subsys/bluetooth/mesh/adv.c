@@ -89,10 +89,27 @@ static inline void adv_send_end(int err, const struct bt_mesh_send_cb *cb,
 	}
 }
 
+static inline s32_t adv_int_min_get(void)
+{
+	return ((bt_dev.hci_version >= BT_HCI_VERSION_5_0) ?
+		ADV_INT_FAST_MS : ADV_INT_DEFAULT_MS);
+}
+
+static inline u16_t adv_int_get(struct net_buf *buf)
+{
+	return MAX(adv_int_min_get(),
+		   BT_MESH_TRANSMIT_INT(BT_MESH_ADV(buf)->xmit));
+}
+
+static inline u16_t adv_duration_get(struct net_buf *buf)
+{
+	return (MESH_SCAN_WINDOW_MS +
+		((BT_MESH_TRANSMIT_COUNT(BT_MESH_ADV(buf)->xmit) + 1) *
+		 (adv_int_get(buf) + 10)));
+}
+
 static inline void adv_send(struct net_buf *buf)
 {
-	const s32_t adv_int_min = ((bt_dev.hci_version >= BT_HCI_VERSION_5_0) ?
-				   ADV_INT_FAST_MS : ADV_INT_DEFAULT_MS);
 	const struct bt_mesh_send_cb *cb = BT_MESH_ADV(buf)->cb;
 	void *cb_data = BT_MESH_ADV(buf)->cb_data;
 	struct bt_le_adv_param param;
@@ -100,11 +117,8 @@ static inline void adv_send(struct net_buf *buf)
 	struct bt_data ad;
 	int err;
 
-	adv_int = MAX(adv_int_min,
-		      BT_MESH_TRANSMIT_INT(BT_MESH_ADV(buf)->xmit));
-	duration = (MESH_SCAN_WINDOW_MS +
-		    ((BT_MESH_TRANSMIT_COUNT(BT_MESH_ADV(buf)->xmit) + 1) *
-		     (adv_int + 10)));
+	adv_int = adv_int_get(buf);
+	duration = adv_duration_get(buf);
 
 	BT_DBG("type %u len %u: %s", BT_MESH_ADV(buf)->type,
 	       buf->len, bt_hex(buf->data, buf->len));
@@ -148,6 +162,181 @@ static inline void adv_send(struct net_buf *buf)
 	BT_DBG("Advertising stopped");
 }
 
+#if defined(CONFIG_BT_MESH_ADV_MULTIPLEX)
+/* PDUs sharing the advertiser. They are put in the advertising data in
+ * turn, without stopping advertising in between, each one until it has been
+ * sent its number of times.
+ */
+static struct adv_mux {
+	struct net_buf *buf;
+	s64_t next;     /* Uptime of the next transmission, in milliseconds */
+	u8_t  count;    /* Transmissions left */
+	u8_t  started:1;
+} adv_mux[CONFIG_BT_MESH_ADV_MULTIPLEX_COUNT];
+
+static struct adv_mux *adv_mux_free_get(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(adv_mux); i++) {
+		if (!adv_mux[i].buf) {
+			return &adv_mux[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void adv_mux_add(struct adv_mux *mux, struct net_buf *buf)
+{
+	mux->buf = buf;
+	mux->next = k_uptime_get();
+	mux->count = BT_MESH_TRANSMIT_COUNT(BT_MESH_ADV(buf)->xmit) + 1;
+	mux->started = 0U;
+}
+
+static void adv_mux_done(struct adv_mux *mux, int err)
+{
+	const struct bt_mesh_send_cb *cb = BT_MESH_ADV(mux->buf)->cb;
+	void *cb_data = BT_MESH_ADV(mux->buf)->cb_data;
+
+	if (!mux->started) {
+		adv_send_start(adv_duration_get(mux->buf), err, cb, cb_data);
+	}
+
+	if (!err) {
+		adv_send_end(err, cb, cb_data);
+	}
+
+	net_buf_unref(mux->buf);
+	mux->buf = NULL;
+}
+
+/* Return the PDU due the soonest */
+static struct adv_mux *adv_mux_next_get(void)
+{
+	struct adv_mux *next = NULL;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(adv_mux); i++) {
+		if (adv_mux[i].buf && (!next || adv_mux[i].next < next->next)) {
+			next = &adv_mux[i];
+		}
+	}
+
+	return next;
+}
+
+static int adv_mux_tx(struct adv_mux *mux, bool adv_started)
+{
+	struct net_buf *buf = mux->buf;
+	struct bt_le_adv_param param;
+	struct bt_data ad;
+
+	BT_DBG("type %u len %u: %s", BT_MESH_ADV(buf)->type,
+	       buf->len, bt_hex(buf->data, buf->len));
+
+	ad.type = adv_type[BT_MESH_ADV(buf)->type];
+	ad.data_len = buf->len;
+	ad.data = buf->data;
+
+	if (adv_started) {
+		return bt_le_adv_update_data(&ad, 1, NULL, 0);
+	}
+
+	if (IS_ENABLED(CONFIG_BT_MESH_DEBUG_USE_ID_ADDR)) {
+		param.options = BT_LE_ADV_OPT_USE_IDENTITY;
+	} else {
+		param.options = 0U;
+	}
+
+	/* The interval of each PDU is kept by the turns they take */
+	param.id = BT_ID_DEFAULT;
+	param.interval_min = ADV_SCAN_UNIT(adv_int_min_get());
+	param.interval_max = param.interval_min;
+
+	return bt_le_adv_start(&param, &ad, 1, NULL, 0);
+}
+
+static void adv_mux_send(struct net_buf *buf)
+{
+	bool adv_started = false;
+	struct adv_mux *mux;
+	s64_t now;
+	int err;
+
+	adv_mux_add(&adv_mux[0], buf);
+
+	while (1) {
+		/* Take in the PDUs queued meanwhile */
+		while ((mux = adv_mux_free_get()) &&
+		       (buf = net_buf_get(&adv_queue, K_NO_WAIT))) {
+			/* busy == 0 means this was canceled */
+			if (BT_MESH_ADV(buf)->busy) {
+				BT_MESH_ADV(buf)->busy = 0U;
+				adv_mux_add(mux, buf);
+			} else {
+				net_buf_unref(buf);
+			}
+		}
+
+		mux = adv_mux_next_get();
+		if (!mux) {
+			break;
+		}
+
+		/* Don't keep sending the previous PDU until the next is due */
+		now = k_uptime_get();
+		if (mux->next > now) {
+			if (adv_started) {
+				adv_started = false;
+				err = bt_le_adv_stop();
+				if (err) {
+					BT_ERR("Stopping advertising failed: "
+					       "err %d", err);
+				}
+			}
+
+			k_sleep(K_MSEC(mux->next - now));
+			continue;
+		}
+
+		err = adv_mux_tx(mux, adv_started);
+		if (err) {
+			BT_ERR("Advertising failed: err %d", err);
+			adv_mux_done(mux, err);
+			continue;
+		}
+
+		adv_started = true;
+
+		if (!mux->started) {
+			mux->started = 1U;
+			adv_send_start(adv_duration_get(mux->buf), 0,
+				       BT_MESH_ADV(mux->buf)->cb,
+				       BT_MESH_ADV(mux->buf)->cb_data);
+		}
+
+		/* Long enough for at least one advertising event */
+		k_sleep(K_MSEC(adv_int_min_get() + 10));
+
+		mux->next = now + adv_int_get(mux->buf);
+		if (!--mux->count) {
+			adv_mux_done(mux, 0);
+		}
+	}
+
+	if (adv_started) {
+		err = bt_le_adv_stop();
+		if (err) {
+			BT_ERR("Stopping advertising failed: err %d", err);
+		}
+	}
+
+	BT_DBG("Advertising stopped");
+}
+#endif /* CONFIG_BT_MESH_ADV_MULTIPLEX */
+
 static void adv_stack_dump(const struct k_thread *thread, void *user_data)
 {
 #if defined(CONFIG_THREAD_STACK_INFO)
@@ -185,7 +374,11 @@ static void adv_thread(void *p1, void *p2, void *p3)
 		/* busy == 0 means this was canceled */
 		if (BT_MESH_ADV(buf)->busy) {
 			BT_MESH_ADV(buf)->busy = 0U;
+#if defined(CONFIG_BT_MESH_ADV_MULTIPLEX)
+			adv_mux_send(buf);
+#else
 			adv_send(buf);
+#endif
 		} else {
 			net_buf_unref(buf);
 		}
@@ -61,8 +61,15 @@ NET_BUF_POOL_FIXED_DEFINE(friend_buf_pool, FRIEND_BUF_COUNT,
 static struct friend_adv {
 	struct bt_mesh_adv adv;
 	u64_t seq_auth;
+	bool update;
 } adv_pool[FRIEND_BUF_COUNT];
 
+/* Union of the subscription filters of all LPNs: group and virtual
+ * addresses are looked up for every received message, and most of them
+ * are rejected here without scanning any subscription list.
+ */
+static u32_t sub_filter;
+
 static struct bt_mesh_adv *adv_alloc(int id)
 {
 	return &adv_pool[id].adv;
@@ -171,6 +178,7 @@ static void friend_clear(struct bt_mesh_friend *frnd)
 	frnd->queue_size = 0U;
 	frnd->pending_req = 0U;
 	(void)memset(frnd->sub_list, 0, sizeof(frnd->sub_list));
+	sub_filter_update(frnd);
 }
 
 void bt_mesh_friend_clear_net_idx(u16_t net_idx)
@@ -265,6 +273,26 @@ int bt_mesh_friend_clear(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 	return 0;
 }
 
+static void sub_filter_update(struct bt_mesh_friend *frnd)
+{
+	int i;
+
+	frnd->sub_filter = 0U;
+
+	for (i = 0; i < ARRAY_SIZE(frnd->sub_list); i++) {
+		if (frnd->sub_list[i] != BT_MESH_ADDR_UNASSIGNED) {
+			frnd->sub_filter |=
+				bt_mesh_addr_hash(frnd->sub_list[i]);
+		}
+	}
+
+	sub_filter = 0U;
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.frnd); i++) {
+		sub_filter |= bt_mesh.frnd[i].sub_filter;
+	}
+}
+
 static void friend_sub_add(struct bt_mesh_friend *frnd, u16_t addr)
 {
 	int i;
@@ -312,6 +340,7 @@ static struct net_buf *create_friend_pdu(struct bt_mesh_friend *frnd,
 
 	BT_MESH_ADV(buf)->addr = info->src;
 	FRIEND_ADV(buf)->seq_auth = TRANS_SEQ_AUTH_NVAL;
+	FRIEND_ADV(buf)->update = false;
 
 	/* Friend Offer needs master security credentials */
 	if (info->ctl && TRANS_CTL_OP(sdu->data) == TRANS_CTL_OP_FRIEND_OFFER) {
@@ -473,6 +502,8 @@ int bt_mesh_friend_sub_add(struct bt_mesh_net_rx *rx,
 		friend_sub_add(frnd, net_buf_simple_pull_be16(buf));
 	}
 
+	sub_filter_update(frnd);
+
 	enqueue_sub_cfm(frnd, xact);
 
 	return 0;
@@ -508,6 +539,8 @@ int bt_mesh_friend_sub_rem(struct bt_mesh_net_rx *rx,
 		friend_sub_rem(frnd, net_buf_simple_pull_be16(buf));
 	}
 
+	sub_filter_update(frnd);
+
 	enqueue_sub_cfm(frnd, xact);
 
 	return 0;
@@ -519,6 +552,31 @@ static void enqueue_buf(struct bt_mesh_friend *frnd, struct net_buf *buf)
 	frnd->queue_size++;
 }
 
+/* A queued Friend Update is superseded by any later one, which carries the
+ * current flags and IV Index: only the last one needs to reach the LPN.
+ */
+static void friend_purge_old_update(struct bt_mesh_friend *frnd)
+{
+	sys_snode_t *cur, *prev = NULL;
+
+	for (cur = sys_slist_peek_head(&frnd->queue);
+	     cur != NULL; prev = cur, cur = sys_slist_peek_next(cur)) {
+		struct net_buf *buf = (void *)cur;
+
+		if (FRIEND_ADV(buf)->update) {
+			BT_DBG("Removing old Friend Update from Friend Queue");
+
+			sys_slist_remove(&frnd->queue, prev, cur);
+			frnd->queue_size--;
+			/* Make sure old slist entry state doesn't remain */
+			buf->frags = NULL;
+
+			net_buf_unref(buf);
+			break;
+		}
+	}
+}
+
 static void enqueue_update(struct bt_mesh_friend *frnd, u8_t md)
 {
 	struct net_buf *buf;
@@ -529,6 +587,9 @@ static void enqueue_update(struct bt_mesh_friend *frnd, u8_t md)
 		return;
 	}
 
+	friend_purge_old_update(frnd);
+
+	FRIEND_ADV(buf)->update = true;
 	frnd->sec_update = 0U;
 	enqueue_buf(frnd, buf);
 }
@@ -1192,6 +1253,10 @@ static bool friend_lpn_matches(struct bt_mesh_friend *frnd, u16_t net_idx,
 		return is_lpn_unicast(frnd, addr);
 	}
 
+	if (!(frnd->sub_filter & bt_mesh_addr_hash(addr))) {
+		return false;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(frnd->sub_list); i++) {
 		if (frnd->sub_list[i] == addr) {
 			return true;
@@ -1205,6 +1270,12 @@ bool bt_mesh_friend_match(u16_t net_idx, u16_t addr)
 {
 	int i;
 
+	if (!BT_MESH_ADDR_IS_UNICAST(addr) &&
+	    !(sub_filter & bt_mesh_addr_hash(addr))) {
+		BT_DBG("No matching LPN for address 0x%04x", addr);
+		return false;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(bt_mesh.frnd); i++) {
 		struct bt_mesh_friend *frnd = &bt_mesh.frnd[i];
 
@@ -226,9 +226,18 @@ int bt_mesh_suspend(void)
 
 	bt_mesh_model_foreach(model_suspend, NULL);
 
+	bt_mesh_rpl_flush();
+
 	return 0;
 }
 
+void bt_mesh_rpl_flush(void)
+{
+	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+		bt_mesh_store_rpl_flush();
+	}
+}
+
 static void model_resume(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
 			  bool vnd, bool primary, void *user_data)
 {
@@ -17,6 +17,7 @@
 #include <net/buf.h>
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/conn.h>
+#include <bluetooth/crypto.h>
 #include <bluetooth/mesh.h>
 
 #define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_MESH_DEBUG_NET)
@@ -70,8 +71,43 @@
 static struct friend_cred friend_cred[FRIEND_CRED_COUNT];
 #endif
 
+/* Hash set over the message cache entries, with room for twice as many
+ * entries so that the linear probing sequences stay short. A slot holds the
+ * index of the entry plus one, or zero when free.
+ */
+#define MSG_CACHE_TBL_SIZE (2 * CONFIG_BT_MESH_MSG_CACHE_SIZE)
+
 static u64_t msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static u16_t msg_cache_next;
+static u16_t msg_cache_tbl[MSG_CACHE_TBL_SIZE];
+static struct bt_mesh_msg_cache_stats msg_cache_stats;
+
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+/* Number of times each cached message was heard again, e.g. relayed by the
+ * neighbours, saturating.
+ */
+static u8_t msg_cache_dup[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+
+/* Relays waiting for their jitter delay to expire */
+static struct relay_pending {
+	struct k_delayed_work work;
+	struct net_buf *buf;
+	u64_t hash;
+	u16_t cache_idx;
+} relay_pending[CONFIG_BT_MESH_RELAY_PENDING_COUNT];
+
+/* Token buckets, in thousandths of a PDU, of the recent destinations */
+#define RELAY_TOKEN      1000U
+#define RELAY_TOKENS_MAX (CONFIG_BT_MESH_RELAY_RATE_BURST * RELAY_TOKEN)
+
+static struct relay_dst {
+	u16_t addr;
+	u32_t tokens;
+	u32_t last;   /* Uptime of the last refill, in milliseconds */
+} relay_dst[CONFIG_BT_MESH_RELAY_RATE_DST_COUNT];
+
+static struct bt_mesh_relay_stats relay_stats;
+#endif /* CONFIG_BT_MESH_RELAY_ADAPTIVE */
 
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
@@ -124,26 +160,119 @@ static u64_t msg_hash(struct bt_mesh_net_rx *rx, struct net_buf_simple *pdu)
 	return (u64_t)hash1 << 32 | (u64_t)hash2;
 }
 
+static u32_t msg_cache_slot(u64_t hash)
+{
+	u32_t val = (u32_t)hash ^ (u32_t)(hash >> 32);
+
+	/* SEQ and SRC are in the low bits, spread them over the table */
+	val ^= val >> 16;
+	val *= 0x45d9f3bU;
+	val ^= val >> 16;
+
+	return val % MSG_CACHE_TBL_SIZE;
+}
+
+static u32_t msg_cache_slot_next(u32_t slot)
+{
+	return (slot + 1) % MSG_CACHE_TBL_SIZE;
+}
+
+/* Remove the hash set slot of the entry at idx, if it is in use. Entries
+ * following it in the probing sequence are moved back so that lookups
+ * stop at the first free slot.
+ */
+static bool msg_cache_tbl_del(u16_t idx)
+{
+	u32_t slot, next, home;
+
+	slot = msg_cache_slot(msg_cache[idx]);
+	while (msg_cache_tbl[slot] != idx + 1) {
+		if (!msg_cache_tbl[slot]) {
+			return false;
+		}
+
+		slot = msg_cache_slot_next(slot);
+	}
+
+	msg_cache_tbl[slot] = 0U;
+
+	for (next = msg_cache_slot_next(slot); msg_cache_tbl[next];
+	     next = msg_cache_slot_next(next)) {
+		home = msg_cache_slot(msg_cache[msg_cache_tbl[next] - 1]);
+
+		/* Keep the entry if its home slot is within (slot, next] */
+		if ((slot < next) ? (home > slot && home <= next) :
+				    (home > slot || home <= next)) {
+			continue;
+		}
+
+		msg_cache_tbl[slot] = msg_cache_tbl[next];
+		msg_cache_tbl[next] = 0U;
+		slot = next;
+	}
+
+	return true;
+}
+
+static void msg_cache_tbl_add(u16_t idx)
+{
+	u32_t slot;
+
+	for (slot = msg_cache_slot(msg_cache[idx]); msg_cache_tbl[slot];
+	     slot = msg_cache_slot_next(slot)) {
+	}
+
+	msg_cache_tbl[slot] = idx + 1;
+}
+
 static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 			    struct net_buf_simple *pdu)
 {
 	u64_t hash = msg_hash(rx, pdu);
-	u16_t i;
-
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i] == hash) {
+	u32_t slot;
+
+	for (slot = msg_cache_slot(hash); msg_cache_tbl[slot];
+	     slot = msg_cache_slot_next(slot)) {
+		if (msg_cache[msg_cache_tbl[slot] - 1] == hash) {
+			msg_cache_stats.hit++;
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+			if (msg_cache_dup[msg_cache_tbl[slot] - 1] < UINT8_MAX) {
+				msg_cache_dup[msg_cache_tbl[slot] - 1]++;
+			}
+#endif /* CONFIG_BT_MESH_RELAY_ADAPTIVE */
 			return true;
 		}
 	}
 
-	/* Add to the cache */
+	msg_cache_stats.miss++;
+
+	/* Add to the cache, in place of the oldest entry */
 	rx->msg_cache_idx = msg_cache_next++;
+	if (msg_cache_tbl_del(rx->msg_cache_idx)) {
+		msg_cache_stats.evict++;
+	}
+
 	msg_cache[rx->msg_cache_idx] = hash;
+	msg_cache_tbl_add(rx->msg_cache_idx);
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+	msg_cache_dup[rx->msg_cache_idx] = 0U;
+#endif /* CONFIG_BT_MESH_RELAY_ADAPTIVE */
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
 
 	return false;
 }
 
+static void msg_cache_remove(u16_t idx)
+{
+	(void)msg_cache_tbl_del(idx);
+	msg_cache[idx] = 0ULL;
+}
+
+void bt_mesh_net_msg_cache_stats_get(struct bt_mesh_msg_cache_stats *stats)
+{
+	*stats = msg_cache_stats;
+}
+
 struct bt_mesh_subnet *bt_mesh_subnet_get(u16_t net_idx)
 {
 	int i;
@@ -450,6 +579,8 @@ int bt_mesh_net_create(u16_t idx, u8_t flags, const u8_t key[16],
 	BT_DBG("NetKey %s", bt_hex(key, 16));
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	(void)memset(msg_cache_tbl, 0, sizeof(msg_cache_tbl));
+	(void)memset(&msg_cache_stats, 0, sizeof(msg_cache_stats));
 	msg_cache_next = 0U;
 
 	sub = &bt_mesh.sub[0];
@@ -572,9 +703,16 @@ void bt_mesh_rpl_reset(void)
 				(void)memset(rpl, 0, sizeof(*rpl));
 			} else {
 				rpl->old_iv = true;
+
+				/* Written along with the new IV Index */
+				if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+					bt_mesh_store_rpl(rpl);
+				}
 			}
 		}
 	}
+
+	bt_mesh_rpl_index_rebuild();
 }
 
 #if defined(CONFIG_BT_MESH_IV_UPDATE_TEST)
@@ -653,6 +791,7 @@ bool bt_mesh_net_iv_update(u32_t iv_index, bool iv_update)
 		if (iv_index > bt_mesh.iv_index + 1) {
 			BT_WARN("Performing IV Index Recovery");
 			(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+			bt_mesh_rpl_index_rebuild();
 			bt_mesh.iv_index = iv_index;
 			bt_mesh.seq = 0U;
 			goto do_update;
@@ -1130,6 +1269,121 @@ static bool relay_to_adv(enum bt_mesh_net_if net_if)
 	}
 }
 
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+/* Take a token from the bucket of the destination, if there is one left */
+static bool relay_rate_allow(u16_t dst)
+{
+	struct relay_dst *entry = NULL;
+	struct relay_dst *oldest = &relay_dst[0];
+	u32_t now = k_uptime_get_32();
+	u32_t elapsed;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(relay_dst); i++) {
+		if (relay_dst[i].addr == dst) {
+			entry = &relay_dst[i];
+			break;
+		}
+
+		if ((now - relay_dst[i].last) > (now - oldest->last)) {
+			oldest = &relay_dst[i];
+		}
+	}
+
+	/* Replace the destination that was relayed to the least recently */
+	if (!entry) {
+		entry = oldest;
+		entry->addr = dst;
+		entry->tokens = RELAY_TOKENS_MAX;
+		entry->last = now;
+	}
+
+	/* A bucket is full again after that many milliseconds at most */
+	elapsed = MIN(now - entry->last, RELAY_TOKENS_MAX);
+	entry->tokens = MIN(entry->tokens + elapsed * CONFIG_BT_MESH_RELAY_RATE,
+			    RELAY_TOKENS_MAX);
+	entry->last = now;
+
+	if (entry->tokens < RELAY_TOKEN) {
+		return false;
+	}
+
+	entry->tokens -= RELAY_TOKEN;
+
+	return true;
+}
+
+static void relay_pending_send(struct k_work *work)
+{
+	struct relay_pending *pending = CONTAINER_OF(work, struct relay_pending,
+						     work);
+	struct net_buf *buf = pending->buf;
+
+	pending->buf = NULL;
+
+	/* Another relay was heard enough times meanwhile, unless the cache
+	 * entry got replaced by then.
+	 */
+	if (msg_cache[pending->cache_idx] == pending->hash &&
+	    msg_cache_dup[pending->cache_idx] >=
+	    CONFIG_BT_MESH_RELAY_SUPPRESS_COUNT) {
+		BT_DBG("Suppressing relay, heard %u times",
+		       msg_cache_dup[pending->cache_idx]);
+		relay_stats.suppressed++;
+	} else {
+		relay_stats.relayed++;
+		bt_mesh_adv_send(buf, NULL, NULL);
+	}
+
+	net_buf_unref(buf);
+}
+
+static void relay_adv_send(struct net_buf *buf, struct bt_mesh_net_rx *rx)
+{
+	struct relay_pending *pending = NULL;
+	u16_t delay;
+	int i;
+
+	/* Only the relaying from the advertising bearer is adapted */
+	if (rx->net_if != BT_MESH_NET_IF_ADV) {
+		bt_mesh_adv_send(buf, NULL, NULL);
+		return;
+	}
+
+	if (!relay_rate_allow(rx->ctx.recv_dst)) {
+		BT_DBG("Rate limiting relay to 0x%04x", rx->ctx.recv_dst);
+		relay_stats.rate_limited++;
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(relay_pending); i++) {
+		if (!relay_pending[i].buf) {
+			pending = &relay_pending[i];
+			break;
+		}
+	}
+
+	/* Relay right away rather than not at all */
+	if (!pending || bt_rand(&delay, sizeof(delay))) {
+		relay_stats.relayed++;
+		bt_mesh_adv_send(buf, NULL, NULL);
+		return;
+	}
+
+	pending->buf = net_buf_ref(buf);
+	pending->cache_idx = rx->msg_cache_idx;
+	pending->hash = msg_cache[rx->msg_cache_idx];
+
+	k_delayed_work_submit(&pending->work,
+			      delay % (CONFIG_BT_MESH_RELAY_JITTER_MAX + 1));
+}
+
+void bt_mesh_relay_stats_get(struct bt_mesh_relay_stats *stats)
+{
+	*stats = relay_stats;
+}
+#endif /* CONFIG_BT_MESH_RELAY_ADAPTIVE */
+
 static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 			      struct bt_mesh_net_rx *rx)
 {
@@ -1226,7 +1480,11 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 	}
 
 	if (relay_to_adv(rx->net_if)) {
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+		relay_adv_send(buf, rx);
+#else
 		bt_mesh_adv_send(buf, NULL, NULL);
+#endif
 	}
 
 done:
@@ -1333,7 +1591,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, s8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
-		msg_cache[rx.msg_cache_idx] = 0ULL;
+		msg_cache_remove(rx.msg_cache_idx);
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
 	}
@@ -1408,7 +1666,17 @@ void bt_mesh_net_start(void)
 
 void bt_mesh_net_init(void)
 {
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+	int i;
+#endif /* CONFIG_BT_MESH_RELAY_ADAPTIVE */
+
 	k_delayed_work_init(&bt_mesh.ivu_timer, ivu_refresh);
 
 	k_work_init(&bt_mesh.local_work, bt_mesh_net_local);
+
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+	for (i = 0; i < ARRAY_SIZE(relay_pending); i++) {
+		k_delayed_work_init(&relay_pending[i].work, relay_pending_send);
+	}
+#endif /* CONFIG_BT_MESH_RELAY_ADAPTIVE */
 }
@@ -102,6 +102,8 @@ struct bt_mesh_friend {
 	u16_t net_idx;
 
 	u16_t sub_list[FRIEND_SUB_LIST_SIZE];
+	/* A bit for the hash of each address in sub_list */
+	u32_t sub_filter;
 
 	struct k_delayed_work timer;
 
@@ -297,6 +299,14 @@ extern struct bt_mesh_net bt_mesh;
 
 #define BT_MESH_NET_HDR_LEN 9
 
+/* One bit out of 32 for an address, for address filters which reject most
+ * addresses before any address list is scanned.
+ */
+static inline u32_t bt_mesh_addr_hash(u16_t addr)
+{
+	return BIT((addr ^ (addr >> 5) ^ (addr >> 10)) & 0x1f);
+}
+
 int bt_mesh_net_keys_create(struct bt_mesh_subnet_keys *keys,
 			    const u8_t key[16]);
 
@@ -319,6 +329,22 @@ void bt_mesh_net_sec_update(struct bt_mesh_subnet *sub);
 
 struct bt_mesh_subnet *bt_mesh_subnet_get(u16_t net_idx);
 
+struct bt_mesh_msg_cache_stats {
+	u32_t hit;   /* Received PDUs found in the cache */
+	u32_t miss;  /* Received PDUs added to the cache */
+	u32_t evict; /* Entries replaced by a newer one */
+};
+
+void bt_mesh_net_msg_cache_stats_get(struct bt_mesh_msg_cache_stats *stats);
+
+struct bt_mesh_relay_stats {
+	u32_t relayed;      /* PDUs relayed on the advertising bearer */
+	u32_t suppressed;   /* Relays dropped as heard from enough neighbours */
+	u32_t rate_limited; /* Relays dropped by the destination rate limit */
+};
+
+void bt_mesh_relay_stats_get(struct bt_mesh_relay_stats *stats);
+
 struct bt_mesh_subnet *bt_mesh_subnet_find(const u8_t net_id[8], u8_t flags,
 					   u32_t iv_index, const u8_t auth[8],
 					   bool *new_key);
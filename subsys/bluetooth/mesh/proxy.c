@@ -83,6 +83,8 @@ static bool prov_fast_adv;
 static struct bt_mesh_proxy_client {
 	struct bt_conn *conn;
 	u16_t filter[CONFIG_BT_MESH_PROXY_FILTER_SIZE];
+	/* A bit for the hash of each address in filter */
+	u32_t filter_hash;
 	enum __packed {
 		NONE,
 		WHITELIST,
@@ -145,6 +147,20 @@ static int next_idx;
 static int proxy_segment_and_send(struct bt_conn *conn, u8_t type,
 				  struct net_buf_simple *msg);
 
+static void filter_hash_update(struct bt_mesh_proxy_client *client)
+{
+	int i;
+
+	client->filter_hash = 0U;
+
+	for (i = 0; i < ARRAY_SIZE(client->filter); i++) {
+		if (client->filter[i] != BT_MESH_ADDR_UNASSIGNED) {
+			client->filter_hash |=
+				bt_mesh_addr_hash(client->filter[i]);
+		}
+	}
+}
+
 static int filter_set(struct bt_mesh_proxy_client *client,
 		      struct net_buf_simple *buf)
 {
@@ -172,6 +188,8 @@ static int filter_set(struct bt_mesh_proxy_client *client,
 		return -EINVAL;
 	}
 
+	client->filter_hash = 0U;
+
 	return 0;
 }
 
@@ -194,6 +212,7 @@ static void filter_add(struct bt_mesh_proxy_client *client, u16_t addr)
 	for (i = 0; i < ARRAY_SIZE(client->filter); i++) {
 		if (client->filter[i] == BT_MESH_ADDR_UNASSIGNED) {
 			client->filter[i] = addr;
+			client->filter_hash |= bt_mesh_addr_hash(addr);
 			return;
 		}
 	}
@@ -212,6 +231,7 @@ static void filter_remove(struct bt_mesh_proxy_client *client, u16_t addr)
 	for (i = 0; i < ARRAY_SIZE(client->filter); i++) {
 		if (client->filter[i] == addr) {
 			client->filter[i] = BT_MESH_ADDR_UNASSIGNED;
+			filter_hash_update(client);
 			return;
 		}
 	}
@@ -567,6 +587,7 @@ static void proxy_connected(struct bt_conn *conn, u8_t err)
 	client->conn = bt_conn_ref(conn);
 	client->filter_type = NONE;
 	(void)memset(client->filter, 0, sizeof(client->filter));
+	client->filter_hash = 0U;
 	net_buf_simple_reset(&client->buf);
 }
 
@@ -854,6 +875,11 @@ static bool client_filter_match(struct bt_mesh_proxy_client *client,
 
 	BT_DBG("filter_type %u addr 0x%04x", client->filter_type, addr);
 
+	/* The lists can't hold the address if its hash bit isn't set */
+	if (!(client->filter_hash & bt_mesh_addr_hash(addr))) {
+		return client->filter_type == BLACKLIST;
+	}
+
 	if (client->filter_type == WHITELIST) {
 		for (i = 0; i < ARRAY_SIZE(client->filter); i++) {
 			if (client->filter[i] == addr) {
@@ -950,7 +976,7 @@ static int proxy_segment_and_send(struct bt_conn *conn, u8_t type,
 	net_buf_simple_pull(msg, mtu);
 
 	while (msg->len) {
-		if (msg->len + 1 < mtu) {
+		if (msg->len + 1 <= mtu) {
 			net_buf_simple_push_u8(msg, PDU_HDR(SAR_LAST, type));
 			proxy_send(conn, msg->data, msg->len);
 			break;
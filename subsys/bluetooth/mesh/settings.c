@@ -796,6 +796,8 @@ static int mesh_commit(void)
 		k_delayed_work_submit(&bt_mesh.ivu_timer, BT_MESH_IVU_TIMEOUT);
 	}
 
+	bt_mesh_rpl_index_rebuild();
+
 	bt_mesh_model_foreach(commit_mod, NULL);
 
 	hb_pub = bt_mesh_hb_pub_get();
@@ -967,6 +969,10 @@ void bt_mesh_store_seq(void)
 	schedule_store(BT_MESH_SEQ_PENDING);
 }
 
+/* RPL entry updates, and the writes to storage they took once batched */
+static u32_t rpl_updates;
+static u32_t rpl_writes;
+
 static void store_rpl(struct bt_mesh_rpl *entry)
 {
 	struct rpl_val rpl;
@@ -986,6 +992,7 @@ static void store_rpl(struct bt_mesh_rpl *entry)
 		BT_ERR("Failed to store RPL %s value", log_strdup(path));
 	} else {
 		BT_DBG("Stored RPL %s value", log_strdup(path));
+		rpl_writes++;
 	}
 }
 
@@ -1013,6 +1020,8 @@ static void clear_rpl(void)
 
 		(void)memset(rpl, 0, sizeof(*rpl));
 	}
+
+	bt_mesh_rpl_index_rebuild();
 }
 
 static void store_pending_rpl(void)
@@ -1029,6 +1038,8 @@ static void store_pending_rpl(void)
 			store_rpl(rpl);
 		}
 	}
+
+	BT_DBG("RPL updates %u writes %u", rpl_updates, rpl_writes);
 }
 
 static void store_pending_hb_pub(void)
@@ -1398,9 +1409,27 @@ static void store_pending(struct k_work *work)
 void bt_mesh_store_rpl(struct bt_mesh_rpl *entry)
 {
 	entry->store = true;
+	rpl_updates++;
 	schedule_store(BT_MESH_RPL_PENDING);
 }
 
+void bt_mesh_store_rpl_flush(void)
+{
+	if (atomic_test_and_clear_bit(bt_mesh.flags, BT_MESH_RPL_PENDING)) {
+		if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
+			store_pending_rpl();
+		} else {
+			clear_rpl();
+		}
+	}
+}
+
+void bt_mesh_store_rpl_stats(u32_t *updates, u32_t *writes)
+{
+	*updates = rpl_updates;
+	*writes = rpl_writes;
+}
+
 static struct key_update *key_update_find(bool app_key, u16_t key_idx,
 					  struct key_update **free_slot)
 {
@@ -21,4 +21,7 @@ void bt_mesh_clear_subnet(struct bt_mesh_subnet *sub);
 void bt_mesh_clear_app_key(struct bt_mesh_app_key *key);
 void bt_mesh_clear_rpl(void);
 
+void bt_mesh_store_rpl_flush(void);
+void bt_mesh_store_rpl_stats(u32_t *updates, u32_t *writes);
+
 void bt_mesh_settings_init(void);
@@ -26,6 +26,7 @@
 #include "net.h"
 #include "transport.h"
 #include "foundation.h"
+#include "settings.h"
 
 #define CID_NVAL   0xffff
 
@@ -710,6 +711,88 @@ static int cmd_net_send(const struct shell *shell, size_t argc, char *argv[])
 	return 0;
 }
 
+static struct k_sem seg_bench_sem;
+
+static void seg_bench_end(int err, void *cb_data)
+{
+	int *result = cb_data;
+
+	*result = err;
+	k_sem_give(&seg_bench_sem);
+}
+
+static const struct bt_mesh_send_cb seg_bench_cb = {
+	.end = seg_bench_end,
+};
+
+/* Segmented messages are complete once the destination acknowledged all
+ * the segments, which gives the end-to-end throughput across the hops.
+ */
+static int cmd_seg_bench(const struct shell *shell, size_t argc,
+			 char *argv[])
+{
+	NET_BUF_SIMPLE_DEFINE(msg, BT_MESH_TX_SDU_MAX);
+	struct bt_mesh_msg_ctx ctx = {
+		.send_ttl = BT_MESH_TTL_DEFAULT,
+		.net_idx = net.net_idx,
+		.addr = net.dst,
+		.app_idx = net.app_idx,
+	};
+	struct bt_mesh_net_tx tx = {
+		.ctx = &ctx,
+		.src = net.local,
+		.xmit = bt_mesh_net_transmit_get(),
+		.sub = bt_mesh_subnet_get(net.net_idx),
+	};
+	u32_t len, count, i, start, elapsed;
+	int err, result;
+
+	len = strtoul(argv[1], NULL, 0);
+	if (len < 1 || len > BT_MESH_TX_SDU_MAX - 4) {
+		shell_error(shell, "Length must be 1 to %u",
+			    BT_MESH_TX_SDU_MAX - 4);
+		return -EINVAL;
+	}
+
+	count = (argc > 2) ? strtoul(argv[2], NULL, 0) : 10;
+
+	if (!tx.sub) {
+		shell_print(shell, "No matching subnet for NetKey Index 0x%04x",
+			    net.net_idx);
+		return 0;
+	}
+
+	k_sem_init(&seg_bench_sem, 0, 1);
+
+	start = k_uptime_get_32();
+
+	for (i = 0U; i < count; i++) {
+		net_buf_simple_reset(&msg);
+		(void)memset(net_buf_simple_add(&msg, len), i, len);
+
+		ctx.send_ttl = BT_MESH_TTL_DEFAULT;
+		ctx.send_rel = true;
+
+		err = bt_mesh_trans_send(&tx, &msg, &seg_bench_cb, &result);
+		if (err) {
+			shell_error(shell, "Failed to send (err %d)", err);
+			return 0;
+		}
+
+		if (k_sem_take(&seg_bench_sem, K_SECONDS(30)) || result) {
+			shell_error(shell, "Message %u not acknowledged", i);
+			return 0;
+		}
+	}
+
+	elapsed = MAX(k_uptime_get_32() - start, 1);
+
+	shell_print(shell, "%u messages of %u bytes in %u ms: %u bytes/s",
+		    count, len, elapsed, (count * len * 1000U) / elapsed);
+
+	return 0;
+}
+
 #if defined(CONFIG_BT_MESH_IV_UPDATE_TEST)
 static int cmd_iv_update(const struct shell *shell, size_t argc, char *argv[])
 {
@@ -753,6 +836,35 @@ static int cmd_rpl_clear(const struct shell *shell, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_BT_SETTINGS)
+static int cmd_rpl_stats(const struct shell *shell, size_t argc, char *argv[])
+{
+	u32_t updates, writes;
+
+	bt_mesh_store_rpl_stats(&updates, &writes);
+
+	shell_print(shell, "RPL updates %u, writes %u, writes saved %u",
+		    updates, writes, updates - writes);
+
+	return 0;
+}
+#endif /* CONFIG_BT_SETTINGS */
+
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+static int cmd_relay_stats(const struct shell *shell, size_t argc,
+			   char *argv[])
+{
+	struct bt_mesh_relay_stats stats;
+
+	bt_mesh_relay_stats_get(&stats);
+
+	shell_print(shell, "Relayed %u, suppressed %u, rate limited %u",
+		    stats.relayed, stats.suppressed, stats.rate_limited);
+
+	return 0;
+}
+#endif /* CONFIG_BT_MESH_RELAY_ADAPTIVE */
+
 static int cmd_beacon(const struct shell *shell, size_t argc, char *argv[])
 {
 	u8_t status;
@@ -1938,12 +2050,19 @@ SHELL_STATIC_SUBCMD_SET_CREATE(mesh_cmds,
 
 	/* Commands which access internal APIs, for testing only */
 	SHELL_CMD_ARG(net-send, NULL, "<hex string>", cmd_net_send, 2, 0),
+	SHELL_CMD_ARG(seg-bench, NULL, "<len> [count]", cmd_seg_bench, 2, 1),
 #if defined(CONFIG_BT_MESH_IV_UPDATE_TEST)
 	SHELL_CMD_ARG(iv-update, NULL, NULL, cmd_iv_update, 1, 0),
 	SHELL_CMD_ARG(iv-update-test, NULL, "<value: off, on>",
 		      cmd_iv_update_test, 2, 0),
 #endif
 	SHELL_CMD_ARG(rpl-clear, NULL, NULL, cmd_rpl_clear, 1, 0),
+#if defined(CONFIG_BT_SETTINGS)
+	SHELL_CMD_ARG(rpl-stats, NULL, NULL, cmd_rpl_stats, 1, 0),
+#endif
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+	SHELL_CMD_ARG(relay-stats, NULL, NULL, cmd_relay_stats, 1, 0),
+#endif
 
 	/* Configuration Client Model operations */
 	SHELL_CMD_ARG(get-comp, NULL, "[page]", cmd_get_comp, 1, 1),
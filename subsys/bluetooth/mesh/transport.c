@@ -78,6 +78,7 @@ static struct seg_tx {
 	u8_t                     seg_n:5,       /* Last segment index */
 				 new_key:1;     /* New/old key */
 	u8_t                     nack_count;    /* Number of unacked segs */
+	u8_t                     seg_unsent;    /* First seg not sent yet */
 	u8_t                     ttl;
 	const struct bt_mesh_send_cb *cb;
 	void                    *cb_data;
@@ -270,11 +271,45 @@ static const struct bt_mesh_send_cb seg_sent_cb = {
 	.end = seg_sent,
 };
 
+/* Send the segments beyond the window as the ones before get acked */
+static int seg_tx_send_window(struct seg_tx *tx)
+{
+	u8_t in_flight = 0U;
+	int i, err;
+
+	for (i = 0; i < tx->seg_unsent; i++) {
+		if (tx->seg[i]) {
+			in_flight++;
+		}
+	}
+
+	while (tx->seg_unsent <= tx->seg_n &&
+	       in_flight < CONFIG_BT_MESH_SEG_WINDOW) {
+		struct net_buf *seg = tx->seg[tx->seg_unsent++];
+
+		if (!seg) {
+			continue;
+		}
+
+		BT_DBG("Sending %u/%u", tx->seg_unsent - 1, tx->seg_n);
+
+		err = bt_mesh_net_resend(tx->sub, seg, tx->new_key,
+					 &seg_sent_cb, tx);
+		if (err) {
+			return err;
+		}
+
+		in_flight++;
+	}
+
+	return 0;
+}
+
 static void seg_tx_send_unacked(struct seg_tx *tx)
 {
 	int i, err;
 
-	for (i = 0; i <= tx->seg_n; i++) {
+	for (i = 0; i < tx->seg_unsent; i++) {
 		struct net_buf *seg = tx->seg[i];
 
 		if (!seg) {
@@ -302,6 +337,11 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 			return;
 		}
 	}
+
+	if (seg_tx_send_window(tx)) {
+		BT_ERR("Sending segment failed");
+		seg_tx_complete(tx, -EIO);
+	}
 }
 
 static void seg_retransmit(struct k_work *work)
@@ -371,6 +411,13 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 
 	BT_DBG("SeqZero 0x%04x", seq_zero);
 
+	/* Only an acknowledging peer moves the window forward */
+	if (BT_MESH_ADDR_IS_UNICAST(tx->dst) && !bt_mesh_elem_find(tx->dst)) {
+		tx->seg_unsent = MIN(CONFIG_BT_MESH_SEG_WINDOW, tx->seg_n + 1);
+	} else {
+		tx->seg_unsent = tx->seg_n + 1;
+	}
+
 	if (IS_ENABLED(CONFIG_BT_MESH_FRIEND) &&
 	    !bt_mesh_friend_queue_has_space(tx->sub->net_idx, net_tx->src,
 					    tx->dst, &tx->seq_auth,
@@ -433,6 +480,21 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 
 		tx->seg[seg_o] = net_buf_ref(seg);
 
+		/* Segments beyond the window go out as the acks come in */
+		if (seg_o >= tx->seg_unsent) {
+			BT_DBG("Deferring %u/%u", seg_o, tx->seg_n);
+
+			err = bt_mesh_net_encode(net_tx, &seg->b, false);
+			net_buf_unref(seg);
+			if (err) {
+				BT_ERR("Encoding segment failed");
+				seg_tx_reset(tx);
+				return err;
+			}
+
+			continue;
+		}
+
 		BT_DBG("Sending %u/%u", seg_o, tx->seg_n);
 
 		err = bt_mesh_net_send(net_tx, seg,
@@ -550,9 +612,102 @@ int bt_mesh_trans_send(struct bt_mesh_net_tx *tx, struct net_buf_simple *msg,
 	return err;
 }
 
+/* Index of the RPL by source address, with room for twice as many entries
+ * as the RPL so that the linear probing sequences stay short. A slot holds
+ * the index of the RPL entry plus one, or zero when free. Slots of entries
+ * cleared or reused meanwhile are skipped by the lookups, and dropped when
+ * the index gets rebuilt.
+ */
+#define RPL_TBL_SIZE (2 * CONFIG_BT_MESH_CRPL)
+
+static u16_t rpl_tbl[RPL_TBL_SIZE];
+static u32_t rpl_tbl_used;
+
+static u32_t rpl_slot(u16_t src)
+{
+	/* Unicast addresses are mostly allocated in sequence, which spreads
+	 * them over consecutive slots.
+	 */
+	return src % RPL_TBL_SIZE;
+}
+
+static u32_t rpl_slot_next(u32_t slot)
+{
+	return (slot + 1) % RPL_TBL_SIZE;
+}
+
+static void rpl_tbl_add(u16_t idx)
+{
+	u32_t slot;
+
+	for (slot = rpl_slot(bt_mesh.rpl[idx].src); rpl_tbl[slot];
+	     slot = rpl_slot_next(slot)) {
+	}
+
+	rpl_tbl[slot] = idx + 1;
+	rpl_tbl_used++;
+}
+
+static void rpl_tbl_insert(u16_t idx)
+{
+	/* Keep a free slot to end the lookups, dropping the stale slots */
+	if (rpl_tbl_used + 1 >= RPL_TBL_SIZE) {
+		bt_mesh_rpl_index_rebuild();
+		return;
+	}
+
+	rpl_tbl_add(idx);
+}
+
+static struct bt_mesh_rpl *rpl_lookup(u16_t src)
+{
+	u32_t slot;
+
+	for (slot = rpl_slot(src); rpl_tbl[slot]; slot = rpl_slot_next(slot)) {
+		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[rpl_tbl[slot] - 1];
+
+		if (rpl->src == src) {
+			return rpl;
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_free_get(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+		if (!bt_mesh.rpl[i].src) {
+			return &bt_mesh.rpl[i];
+		}
+	}
+
+	return NULL;
+}
+
+void bt_mesh_rpl_index_rebuild(void)
+{
+	u16_t i;
+
+	(void)memset(rpl_tbl, 0, sizeof(rpl_tbl));
+	rpl_tbl_used = 0U;
+
+	for (i = 0U; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+		if (bt_mesh.rpl[i].src) {
+			rpl_tbl_add(i);
+		}
+	}
+}
+
 static void update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
 {
-	rpl->src = rx->ctx.addr;
+	if (rpl->src != rx->ctx.addr) {
+		rpl->src = rx->ctx.addr;
+		rpl_tbl_insert(rpl - bt_mesh.rpl);
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -568,7 +723,7 @@ static void update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
  */
 static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -580,42 +735,40 @@ static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
+	rpl = rpl_lookup(rx->ctx.addr);
 
-		/* Empty slot */
-		if (!rpl->src) {
-			if (match) {
-				*match = rpl;
-			} else {
-				update_rpl(rpl, rx);
-			}
+	/* No slot for given address yet, take an empty one */
+	if (!rpl) {
+		rpl = rpl_free_get();
+		if (!rpl) {
+			BT_ERR("RPL is full!");
+			return true;
+		}
 
-			return false;
+		if (match) {
+			*match = rpl;
+		} else {
+			update_rpl(rpl, rx);
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		return false;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					update_rpl(rpl, rx);
-				}
+	/* Existing slot for given address */
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
 
-				return false;
-			} else {
-				return true;
-			}
+	if ((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq) {
+		if (match) {
+			*match = rpl;
+		} else {
+			update_rpl(rpl, rx);
 		}
+
+		return false;
 	}
 
-	BT_ERR("RPL is full!");
 	return true;
 }
 
@@ -1194,6 +1347,21 @@ static struct seg_rx *seg_rx_alloc(struct bt_mesh_net_rx *net_rx,
 	return NULL;
 }
 
+/* Acknowledge before the timer, so that the sender can move its segment
+ * window forward, or resend a lost segment without waiting.
+ */
+static bool seg_ack_early(struct seg_rx *rx, u32_t prev_block, u8_t seg_o)
+{
+	/* Another window of segments received */
+	if (!(popcount(rx->block) % CONFIG_BT_MESH_SEG_WINDOW)) {
+		return true;
+	}
+
+	/* A later segment was received first, one is likely lost */
+	return (IS_ENABLED(CONFIG_BT_MESH_SEG_ACK_ON_GAP) &&
+		seg_o > find_msb_set(prev_block));
+}
+
 static int trans_seg(struct net_buf_simple *buf, struct bt_mesh_net_rx *net_rx,
 		     enum bt_mesh_friend_pdu_type *pdu_type, u64_t *seq_auth,
 		     u8_t *seg_count)
@@ -1201,6 +1369,7 @@ static int trans_seg(struct net_buf_simple *buf, struct bt_mesh_net_rx *net_rx,
 	struct bt_mesh_rpl *rpl = NULL;
 	struct seg_rx *rx;
 	u8_t *hdr = buf->data;
+	u32_t prev_block;
 	u16_t seq_zero;
 	u8_t seg_n;
 	u8_t seg_o;
@@ -1378,9 +1547,18 @@ found_rx:
 	BT_DBG("Received %u/%u", seg_o, seg_n);
 
 	/* Mark segment as received */
+	prev_block = rx->block;
 	rx->block |= BIT(seg_o);
 
 	if (rx->block != BLOCK_COMPLETE(seg_n)) {
+		if (seg_ack_early(rx, prev_block, seg_o) &&
+		    !bt_mesh_lpn_established()) {
+			send_ack(net_rx->sub, net_rx->ctx.recv_dst,
+				 net_rx->ctx.addr, net_rx->ctx.send_ttl,
+				 seq_auth, rx->block, rx->obo);
+			k_delayed_work_submit(&rx->ack, ack_timeout(rx));
+		}
+
 		*pdu_type = BT_MESH_FRIEND_PDU_PARTIAL;
 		return 0;
 	}
@@ -1514,6 +1692,8 @@ void bt_mesh_rx_reset(void)
 	} else {
 		(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
 	}
+
+	bt_mesh_rpl_index_rebuild();
 }
 
 void bt_mesh_tx_reset(void)
@@ -1547,6 +1727,7 @@ void bt_mesh_rpl_clear(void)
 {
 	BT_DBG("");
 	(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+	bt_mesh_rpl_index_rebuild();
 }
 
 void bt_mesh_heartbeat_send(void)
@@ -95,4 +95,6 @@ void bt_mesh_trans_init(void);
 
 void bt_mesh_rpl_clear(void);
 
+void bt_mesh_rpl_index_rebuild(void);
+
 void bt_mesh_heartbeat_send(void);
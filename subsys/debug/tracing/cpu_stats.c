@@ -6,6 +6,10 @@
 
 #include <tracing_cpu_stats.h>
 #include <sys/printk.h>
+#include <stats/stats.h>
+#include <string.h>
+#include <ksched.h>
+#include <debug/stack.h>
 
 enum cpu_state {
 	CPU_STATE_IDLE,
@@ -68,6 +72,271 @@ static void cpu_stats_update_counters(void)
 	}
 }
 
+#ifdef CONFIG_TRACING_CPU_STATS_LATENCY
+struct latency_stats {
+#ifdef CONFIG_STATS
+	struct stats_hdr s_hdr;
+#endif
+	struct cpu_stats_histogram hist;
+};
+
+static struct latency_stats latency[CPU_STATS_LATENCY_COUNT];
+static u32_t isr_start;
+static u32_t swap_start;
+static bool swap_pending;
+
+static void latency_record(enum cpu_stats_latency which, u32_t cycles)
+{
+	struct cpu_stats_histogram *hist = &latency[which].hist;
+	unsigned int bucket = MIN(find_msb_set(cycles),
+				  CONFIG_TRACING_CPU_STATS_LATENCY_BUCKETS - 1);
+
+	hist->count++;
+	hist->max = MAX(hist->max, cycles);
+	hist->bucket[bucket]++;
+}
+
+void cpu_stats_latency_get(enum cpu_stats_latency which,
+			   struct cpu_stats_histogram *hist)
+{
+	int key = irq_lock();
+
+	*hist = latency[which].hist;
+	irq_unlock(key);
+}
+
+static void thread_latency_reset(const struct k_thread *thread,
+				 void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	((struct k_thread *)thread)->latency.ready_max = 0U;
+}
+
+void cpu_stats_latency_reset(void)
+{
+	int key = irq_lock();
+
+	for (int i = 0; i < CPU_STATS_LATENCY_COUNT; i++) {
+		(void)memset(&latency[i].hist, 0, sizeof(latency[i].hist));
+	}
+	irq_unlock(key);
+
+	k_thread_foreach(thread_latency_reset, NULL);
+}
+
+static void latency_thread_ready(struct k_thread *thread)
+{
+	/* Keep the first stamp if readied again before running */
+	if (!thread->latency.ready_pending) {
+		thread->latency.ready_stamp = k_cycle_get_32();
+		thread->latency.ready_pending = true;
+	}
+}
+
+static void latency_switched_in(struct k_thread *thread)
+{
+	u32_t now = k_cycle_get_32();
+
+	if (swap_pending) {
+		latency_record(CPU_STATS_LATENCY_SWAP, now - swap_start);
+		swap_pending = false;
+	}
+
+	if (thread->latency.ready_pending) {
+		u32_t delay = now - thread->latency.ready_stamp;
+
+		thread->latency.ready_pending = false;
+		if (!is_idle_thread(thread)) {
+			latency_record(CPU_STATS_LATENCY_READY, delay);
+			thread->latency.ready_max =
+				MAX(thread->latency.ready_max, delay);
+		}
+	}
+}
+
+#ifdef CONFIG_STATS
+#ifdef CONFIG_STATS_NAMES
+static const struct stats_name_map latency_names[] = {
+	{ offsetof(struct latency_stats, hist.count), "count" },
+	{ offsetof(struct latency_stats, hist.max), "max" },
+};
+#define LATENCY_NAMES latency_names, ARRAY_SIZE(latency_names)
+#else
+#define LATENCY_NAMES NULL, 0
+#endif
+
+static int latency_stats_init(struct device *dev)
+{
+	static const char *const names[CPU_STATS_LATENCY_COUNT] = {
+		[CPU_STATS_LATENCY_ISR] = "cpu_lat_isr",
+		[CPU_STATS_LATENCY_SWAP] = "cpu_lat_swap",
+		[CPU_STATS_LATENCY_READY] = "cpu_lat_ready",
+	};
+
+	ARG_UNUSED(dev);
+
+	for (int i = 0; i < CPU_STATS_LATENCY_COUNT; i++) {
+		(void)stats_init_and_reg(&latency[i].s_hdr, STATS_SIZE_32,
+				sizeof(struct cpu_stats_histogram) /
+				STATS_SIZE_32, LATENCY_NAMES, names[i]);
+	}
+
+	return 0;
+}
+
+SYS_INIT(latency_stats_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_STATS */
+#endif /* CONFIG_TRACING_CPU_STATS_LATENCY */
+
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+#ifdef CONFIG_STATS
+/* Totals over all threads */
+static struct sched_stats {
+	struct stats_hdr s_hdr;
+	u32_t switches;
+	u32_t preemptions;
+} sched_stats;
+#endif
+
+static void runtime_thread_ready(struct k_thread *thread)
+{
+	if (!thread->runtime.ready_pending) {
+		thread->runtime.ready_stamp = k_cycle_get_32();
+		thread->runtime.ready_pending = true;
+	}
+}
+
+static void runtime_switched_in(struct k_thread *thread)
+{
+	u32_t now = k_cycle_get_32();
+
+	if (thread->runtime.ready_pending) {
+		thread->runtime.ready_cycles +=
+			now - thread->runtime.ready_stamp;
+		thread->runtime.ready_pending = false;
+	}
+
+	thread->runtime.run_stamp = now;
+	thread->runtime.switches++;
+#ifdef CONFIG_STATS
+	sched_stats.switches++;
+#endif
+}
+
+static void runtime_switched_out(struct k_thread *thread)
+{
+	u32_t now = k_cycle_get_32();
+
+	thread->runtime.exec_cycles += now - thread->runtime.run_stamp;
+
+	/* A thread pending or suspended is no longer ready, one still ready
+	 * was preempted or yielded and starts waiting for the CPU.
+	 */
+	if (z_is_thread_ready(thread)) {
+		thread->runtime.preemptions++;
+		thread->runtime.ready_stamp = now;
+		thread->runtime.ready_pending = true;
+#ifdef CONFIG_STATS
+		sched_stats.preemptions++;
+#endif
+	}
+}
+
+void cpu_stats_thread_get(const struct k_thread *thread,
+			  struct cpu_stats_thread *stats)
+{
+	const struct _thread_runtime *rt = &thread->runtime;
+	int key = irq_lock();
+	u32_t now = k_cycle_get_32();
+
+	stats->exec_cycles = rt->exec_cycles;
+	stats->ready_cycles = rt->ready_cycles;
+	stats->switches = rt->switches;
+	stats->preemptions = rt->preemptions;
+
+	/* Add the current run or wait */
+	if (thread == current_thread && nested_interrupts == 0 &&
+	    last_cpu_state != CPU_STATE_SCHEDULER) {
+		stats->exec_cycles += now - rt->run_stamp;
+	} else if (rt->ready_pending) {
+		stats->ready_cycles += now - rt->ready_stamp;
+	}
+	irq_unlock(key);
+
+#ifdef CONFIG_INIT_STACKS
+	stats->stack_max_used = thread->stack_info.size -
+		stack_unused_space_get((char *)thread->stack_info.start,
+				       thread->stack_info.size);
+#else
+	stats->stack_max_used = 0;
+#endif
+}
+
+static void thread_runtime_reset(const struct k_thread *thread,
+				 void *user_data)
+{
+	struct _thread_runtime *rt = &((struct k_thread *)thread)->runtime;
+	u32_t now = *(u32_t *)user_data;
+
+	rt->exec_cycles = 0U;
+	rt->ready_cycles = 0U;
+	rt->switches = 0U;
+	rt->preemptions = 0U;
+	rt->run_stamp = now;
+	rt->ready_stamp = now;
+}
+
+void cpu_stats_thread_reset(void)
+{
+	int key = irq_lock();
+	u32_t now = k_cycle_get_32();
+
+	k_thread_foreach(thread_runtime_reset, &now);
+	irq_unlock(key);
+}
+
+#ifdef CONFIG_STATS
+#ifdef CONFIG_STATS_NAMES
+static const struct stats_name_map sched_names[] = {
+	{ offsetof(struct sched_stats, switches), "switches" },
+	{ offsetof(struct sched_stats, preemptions), "preemptions" },
+};
+#define SCHED_NAMES sched_names, ARRAY_SIZE(sched_names)
+#else
+#define SCHED_NAMES NULL, 0
+#endif
+
+static int sched_stats_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return stats_init_and_reg(&sched_stats.s_hdr, STATS_SIZE_32,
+				  (sizeof(sched_stats) -
+				   sizeof(sched_stats.s_hdr)) / STATS_SIZE_32,
+				  SCHED_NAMES, "cpu_sched");
+}
+
+SYS_INIT(sched_stats_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_STATS */
+#endif /* CONFIG_TRACING_CPU_STATS_THREADS */
+
+#if defined(CONFIG_TRACING_CPU_STATS_LATENCY) || \
+	defined(CONFIG_TRACING_CPU_STATS_THREADS)
+void sys_trace_thread_ready(struct k_thread *thread)
+{
+	int key = irq_lock();
+
+#ifdef CONFIG_TRACING_CPU_STATS_LATENCY
+	latency_thread_ready(thread);
+#endif
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+	runtime_thread_ready(thread);
+#endif
+	irq_unlock(key);
+}
+#endif
+
 void cpu_stats_get_ns(struct cpu_stats *cpu_stats_ns)
 {
 	int key = irq_lock();
@@ -110,6 +379,12 @@ void sys_trace_thread_switched_in(void)
 
 	cpu_stats_update_counters();
 	current_thread = k_current_get();
+#ifdef CONFIG_TRACING_CPU_STATS_LATENCY
+	latency_switched_in(current_thread);
+#endif
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+	runtime_switched_in(current_thread);
+#endif
 	if (is_idle_thread(current_thread)) {
 		last_cpu_state = CPU_STATE_IDLE;
 	} else {
@@ -127,6 +402,15 @@ void sys_trace_thread_switched_out(void)
 
 	cpu_stats_update_counters();
 	last_cpu_state = CPU_STATE_SCHEDULER;
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+	if (current_thread) {
+		runtime_switched_out(current_thread);
+	}
+#endif
+#ifdef CONFIG_TRACING_CPU_STATS_LATENCY
+	swap_start = k_cycle_get_32();
+	swap_pending = true;
+#endif
 	irq_unlock(key);
 }
 
@@ -138,6 +422,18 @@ void sys_trace_isr_enter(void)
 		cpu_stats_update_counters();
 		cpu_state_before_interrupts = last_cpu_state;
 		last_cpu_state = CPU_STATE_NON_IDLE;
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+		/* Interrupt handling is not charged to the thread */
+		if (current_thread &&
+		    cpu_state_before_interrupts != CPU_STATE_SCHEDULER) {
+			current_thread->runtime.exec_cycles +=
+				k_cycle_get_32() -
+				current_thread->runtime.run_stamp;
+		}
+#endif
+#ifdef CONFIG_TRACING_CPU_STATS_LATENCY
+		isr_start = k_cycle_get_32();
+#endif
 	}
 	nested_interrupts++;
 	irq_unlock(key);
@@ -151,6 +447,15 @@ void sys_trace_isr_exit(void)
 	if (nested_interrupts == 0) {
 		cpu_stats_update_counters();
 		last_cpu_state = cpu_state_before_interrupts;
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+		if (current_thread) {
+			current_thread->runtime.run_stamp = k_cycle_get_32();
+		}
+#endif
+#ifdef CONFIG_TRACING_CPU_STATS_LATENCY
+		latency_record(CPU_STATS_LATENCY_ISR,
+			       k_cycle_get_32() - isr_start);
+#endif
 	}
 	irq_unlock(key);
 }
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr.h>
+#include <kernel_structs.h>
+#include <sys/ring_buffer.h>
+#include "ctf_bottom.h"
+
+#if defined(CONFIG_TRACING_CTF_RING_SINK_UART)
+#include <drivers/uart.h>
+#elif defined(CONFIG_TRACING_CTF_RING_SINK_NET)
+#include <net/socket.h>
+#endif
+
+static u8_t ring_data[CONFIG_MP_NUM_CPUS][CONFIG_TRACING_CTF_RING_SIZE];
+static struct ring_buf rings[CONFIG_MP_NUM_CPUS];
+static atomic_t dropped;
+static bool frozen;
+
+void ctf_bottom_configure(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		ring_buf_init(&rings[i], sizeof(ring_data[i]), ring_data[i]);
+	}
+}
+
+void ctf_bottom_start(void)
+{
+	frozen = false;
+}
+
+#if defined(CONFIG_TRACING_CTF_RING_SINK_SNAPSHOT)
+static void ring_skip(struct ring_buf *ring, u32_t len)
+{
+	u32_t total = 0U;
+	u32_t part;
+	u8_t *data;
+
+	do {
+		part = ring_buf_get_claim(ring, &data, len - total);
+		total += part;
+	} while (part && total < len);
+
+	ring_buf_get_finish(ring, total);
+}
+
+/* Events are stored with a length byte, so the oldest can be dropped. */
+static bool ring_event_put(struct ring_buf *ring, const void *ptr, u8_t size)
+{
+	u8_t len;
+
+	while (ring_buf_space_get(ring) < size + sizeof(len)) {
+		if (ring_buf_get(ring, &len, sizeof(len)) == 0U) {
+			return false;
+		}
+
+		ring_skip(ring, len);
+	}
+
+	ring_buf_put(ring, &size, sizeof(size));
+	ring_buf_put(ring, ptr, size);
+
+	return true;
+}
+
+void ctf_bottom_snapshot_trigger(void)
+{
+	frozen = true;
+}
+
+size_t ctf_bottom_snapshot_get(int cpu, u8_t *buf, size_t size)
+{
+	struct ring_buf *ring = &rings[cpu];
+	size_t total = 0;
+	u8_t len;
+
+	__ASSERT(frozen, "Recording must be stopped first");
+
+	while (ring_buf_get(ring, &len, sizeof(len))) {
+		if (total + len > size) {
+			break;
+		}
+
+		total += ring_buf_get(ring, &buf[total], len);
+	}
+
+	return total;
+}
+#else
+/* The drain thread is the only reader, events are published at once. */
+static bool ring_event_put(struct ring_buf *ring, const void *ptr, u8_t size)
+{
+	if (ring_buf_space_get(ring) < size) {
+		return false;
+	}
+
+	ring_buf_put(ring, ptr, size);
+
+	return true;
+}
+#endif /* CONFIG_TRACING_CTF_RING_SINK_SNAPSHOT */
+
+void ctf_bottom_emit(const void *ptr, size_t size)
+{
+	unsigned int key;
+	bool stored;
+
+	if (frozen) {
+		return;
+	}
+
+	/* Only this CPU writes to its ring, masking its interrupts is enough
+	 * even on SMP.
+	 */
+	key = z_arch_irq_lock();
+	stored = ring_event_put(&rings[_current_cpu->id], ptr, size);
+	z_arch_irq_unlock(key);
+
+	if (!stored) {
+		atomic_inc(&dropped);
+	}
+}
+
+u32_t ctf_bottom_dropped_get(void)
+{
+	return atomic_get(&dropped);
+}
+
+#if !defined(CONFIG_TRACING_CTF_RING_SINK_SNAPSHOT)
+#if defined(CONFIG_TRACING_CTF_RING_SINK_UART)
+static struct device *uart_dev;
+
+#if defined(CONFIG_UART_ASYNC_API)
+static K_SEM_DEFINE(tx_done, 0, 1);
+
+static void uart_cb(struct uart_event *evt, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (evt->type == UART_TX_DONE || evt->type == UART_TX_ABORTED) {
+		k_sem_give(&tx_done);
+	}
+}
+#endif
+
+static int sink_open(void)
+{
+	uart_dev = device_get_binding(CONFIG_TRACING_CTF_RING_UART_DEV);
+	if (!uart_dev) {
+		return -ENODEV;
+	}
+
+#if defined(CONFIG_UART_ASYNC_API)
+	return uart_callback_set(uart_dev, uart_cb, NULL);
+#else
+	return 0;
+#endif
+}
+
+/* With the async API, the USB CDC ACM driver sends the whole chunk as one
+ * bulk transfer.
+ */
+static void sink_write(const u8_t *data, size_t len)
+{
+#if defined(CONFIG_UART_ASYNC_API)
+	if (uart_tx(uart_dev, data, len, K_FOREVER) == 0) {
+		k_sem_take(&tx_done, K_FOREVER);
+		return;
+	}
+#endif
+	while (len--) {
+		uart_poll_out(uart_dev, *data++);
+	}
+}
+#elif defined(CONFIG_TRACING_CTF_RING_SINK_NET)
+static int sock = -1;
+
+static int sink_open(void)
+{
+	struct sockaddr addr;
+
+	if (!net_ipaddr_parse(CONFIG_TRACING_CTF_RING_NET_SERVER,
+			      sizeof(CONFIG_TRACING_CTF_RING_NET_SERVER) - 1,
+			      &addr)) {
+		return -EINVAL;
+	}
+
+	sock = zsock_socket(addr.sa_family,
+			    IS_ENABLED(CONFIG_TRACING_CTF_RING_NET_TCP) ?
+			    SOCK_STREAM : SOCK_DGRAM,
+			    IS_ENABLED(CONFIG_TRACING_CTF_RING_NET_TCP) ?
+			    IPPROTO_TCP : IPPROTO_UDP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	/* UDP is connected as well, so send() can be used for both. */
+	if (zsock_connect(sock, &addr, (addr.sa_family == AF_INET6) ?
+			  sizeof(struct sockaddr_in6) :
+			  sizeof(struct sockaddr_in)) < 0) {
+		zsock_close(sock);
+		sock = -1;
+		return -errno;
+	}
+
+	return 0;
+}
+
+static void sink_write(const u8_t *data, size_t len)
+{
+	ssize_t ret;
+
+	while (len) {
+		ret = zsock_send(sock, data, len, 0);
+		if (ret < 0) {
+			return;
+		}
+
+		data += ret;
+		len -= ret;
+	}
+}
+#endif
+
+static void ctf_drain_thread(void)
+{
+	bool idle;
+	u8_t *data;
+	u32_t len;
+
+	while (sink_open() != 0) {
+		k_sleep(CONFIG_TRACING_CTF_RING_DRAIN_INTERVAL);
+	}
+
+	while (true) {
+		idle = true;
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			len = ring_buf_get_claim(&rings[i], &data,
+					CONFIG_TRACING_CTF_RING_DRAIN_CHUNK);
+			if (len) {
+				sink_write(data, len);
+				ring_buf_get_finish(&rings[i], len);
+				idle = false;
+			}
+		}
+
+		if (idle) {
+			k_sleep(CONFIG_TRACING_CTF_RING_DRAIN_INTERVAL);
+		}
+	}
+}
+
+K_THREAD_DEFINE(ctf_drain, CONFIG_TRACING_CTF_RING_THREAD_STACK_SIZE,
+		ctf_drain_thread, NULL, NULL, NULL,
+		CONFIG_TRACING_CTF_RING_THREAD_PRIO, 0, K_NO_WAIT);
+#endif /* !CONFIG_TRACING_CTF_RING_SINK_SNAPSHOT */
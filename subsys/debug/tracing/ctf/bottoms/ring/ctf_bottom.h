@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SUBSYS_DEBUG_TRACING_BOTTOMS_RING_CTF_BOTTOM_H
+#define SUBSYS_DEBUG_TRACING_BOTTOMS_RING_CTF_BOTTOM_H
+
+#include <stddef.h>
+#include <string.h>
+#include <zephyr/types.h>
+#include <ctf_map.h>
+
+
+/* Obtain a field's size at compile-time.
+ * Internal to this bottom-layer.
+ */
+#define CTF_BOTTOM_INTERNAL_FIELD_SIZE(x)      + sizeof(x)
+
+/* Append a field to current event-packet.
+ * Internal to this bottom-layer.
+ */
+#define CTF_BOTTOM_INTERNAL_FIELD_APPEND(x)		 \
+	{						 \
+		memcpy(epacket_cursor, &(x), sizeof(x)); \
+		epacket_cursor += sizeof(x);		 \
+	}
+
+/* Gather fields to a contiguous event-packet, then atomically emit.
+ * Used by middle-layer.
+ */
+#define CTF_BOTTOM_FIELDS(...)						    \
+{									    \
+	u8_t epacket[0 MAP(CTF_BOTTOM_INTERNAL_FIELD_SIZE, ##__VA_ARGS__)]; \
+	u8_t *epacket_cursor = &epacket[0];				    \
+									    \
+	MAP(CTF_BOTTOM_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)		    \
+	ctf_bottom_emit(epacket, sizeof(epacket));			    \
+}
+
+/* Events go to the ring of the current CPU, which only needs interrupts
+ * of that CPU locked, done by ctf_bottom_emit. Used by middle-layer.
+ */
+#define CTF_BOTTOM_LOCK()         { /* empty */ }
+#define CTF_BOTTOM_UNLOCK()       { /* empty */ }
+
+/* The bottom has no clock of its own.
+ * Used by middle-layer.
+ */
+#define CTF_BOTTOM_TIMESTAMPED_INTERNALLY
+
+
+/* Configure initializes the per-CPU rings */
+void ctf_bottom_configure(void);
+
+/* Start a new trace stream */
+void ctf_bottom_start(void);
+
+/* Copy an event to the ring of the current CPU, it is dropped if the ring
+ * is full, or the oldest events are in snapshot mode.
+ */
+void ctf_bottom_emit(const void *ptr, size_t size);
+
+/* Stop recording, the rings keep the last events (snapshot mode) */
+void ctf_bottom_snapshot_trigger(void);
+
+/* Copy out the recorded events of a CPU, returns the number of bytes */
+size_t ctf_bottom_snapshot_get(int cpu, u8_t *buf, size_t size);
+
+/* Number of events dropped since start */
+u32_t ctf_bottom_dropped_get(void);
+
+#endif /* SUBSYS_DEBUG_TRACING_BOTTOMS_RING_CTF_BOTTOM_H */
@@ -26,6 +26,56 @@ void cpu_stats_get_ns(struct cpu_stats *cpu_stats_ns);
 u32_t cpu_stats_non_idle_and_sched_get_percent(void);
 void cpu_stats_reset_counters(void);
 
+#ifdef CONFIG_TRACING_CPU_STATS_LATENCY
+enum cpu_stats_latency {
+	/* Outermost interrupt entry to exit */
+	CPU_STATS_LATENCY_ISR,
+	/* Thread switched out to next thread switched in */
+	CPU_STATS_LATENCY_SWAP,
+	/* Thread made ready to thread switched in */
+	CPU_STATS_LATENCY_READY,
+	CPU_STATS_LATENCY_COUNT
+};
+
+/* All fields in hardware cycles, bucket N counts samples of 2^(N-1) to
+ * 2^N - 1 cycles (bucket 0 those of zero) and the last bucket also all
+ * longer ones.
+ */
+struct cpu_stats_histogram {
+	u32_t count;
+	u32_t max;
+	u32_t bucket[CONFIG_TRACING_CPU_STATS_LATENCY_BUCKETS];
+};
+
+void cpu_stats_latency_get(enum cpu_stats_latency which,
+			   struct cpu_stats_histogram *hist);
+void cpu_stats_latency_reset(void);
+#endif
+
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+/* Cycles are hardware cycles, the stack high-water mark is 0 unless
+ * INIT_STACKS is enabled.
+ */
+struct cpu_stats_thread {
+	u64_t exec_cycles;
+	u64_t ready_cycles;
+	u32_t switches;
+	u32_t preemptions;
+	size_t stack_max_used;
+};
+
+void cpu_stats_thread_get(const struct k_thread *thread,
+			  struct cpu_stats_thread *stats);
+void cpu_stats_thread_reset(void);
+#endif
+
+#if defined(CONFIG_TRACING_CPU_STATS_LATENCY) || \
+	defined(CONFIG_TRACING_CPU_STATS_THREADS)
+void sys_trace_thread_ready(struct k_thread *thread);
+#else
+#define sys_trace_thread_ready(thread)
+#endif
+
 #define sys_trace_isr_exit_to_scheduler()
 
 #define sys_trace_thread_priority_set(thread)
@@ -34,7 +84,6 @@ void cpu_stats_reset_counters(void);
 #define sys_trace_thread_abort(thread)
 #define sys_trace_thread_suspend(thread)
 #define sys_trace_thread_resume(thread)
-#define sys_trace_thread_ready(thread)
 #define sys_trace_thread_pend(thread)
 
 #define sys_trace_void(id)
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Statistical profiler sampling the program counter of the running thread
+ * from a timer expiry function. Threads run on the process stack, while
+ * interrupts use the main stack, so the frame stacked on exception entry
+ * at the process stack pointer holds the interrupted thread program
+ * counter. Samples are counted in an open addressing hash table of code
+ * address bins.
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <debug/pc_sampler.h>
+#include <arch/arm/cortex_m/cmsis.h>
+
+#define SLOTS CONFIG_TRACING_PC_SAMPLER_SLOTS
+#define BIN_SHIFT CONFIG_TRACING_PC_SAMPLER_BIN_SHIFT
+
+/* Program counter position in the basic exception stack frame */
+#define FRAME_PC 6
+
+BUILD_ASSERT_MSG((SLOTS & (SLOTS - 1)) == 0,
+		 "The number of slots must be a power of two");
+
+struct pc_bin {
+	u32_t addr;
+	u32_t count;
+};
+
+static struct pc_bin bins[SLOTS];
+static u32_t total;
+static u32_t dropped;
+
+static void pc_sampler_record(u32_t pc)
+{
+	u32_t addr = pc & ~((1U << BIN_SHIFT) - 1);
+	u32_t i = (addr >> BIN_SHIFT) * 2654435761U;
+	u32_t n;
+
+	total++;
+
+	for (n = 0U; n < SLOTS; n++, i++) {
+		struct pc_bin *bin = &bins[i & (SLOTS - 1)];
+
+		if (bin->count == 0U) {
+			bin->addr = addr;
+		}
+
+		if (bin->addr == addr) {
+			bin->count++;
+			return;
+		}
+	}
+
+	dropped++;
+}
+
+static void pc_sampler_expiry(struct k_timer *timer)
+{
+	const u32_t *frame = (const u32_t *)__get_PSP();
+
+	ARG_UNUSED(timer);
+
+#ifdef SCB_ICSR_RETTOBASE_Msk
+	/* The clock interrupt preempted another one, not a thread */
+	if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0U) {
+		return;
+	}
+#endif
+
+	/* Ticks taken before the first thread ran have no process stack */
+	if (frame != NULL && frame[FRAME_PC] != 0U) {
+		pc_sampler_record(frame[FRAME_PC]);
+	}
+}
+
+K_TIMER_DEFINE(pc_sampler_timer, pc_sampler_expiry, NULL);
+
+void pc_sampler_start(void)
+{
+	k_timer_start(&pc_sampler_timer, 1, 1);
+}
+
+void pc_sampler_stop(void)
+{
+	k_timer_stop(&pc_sampler_timer);
+}
+
+void pc_sampler_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	(void)memset(bins, 0, sizeof(bins));
+	total = 0U;
+	dropped = 0U;
+
+	irq_unlock(key);
+}
+
+void pc_sampler_dump(void)
+{
+	int i;
+
+	for (i = 0; i < SLOTS; i++) {
+		if (bins[i].count) {
+			printk("pc_sampler: 0x%08x %u\n", bins[i].addr,
+			       bins[i].count);
+		}
+	}
+
+	printk("pc_sampler: total %u dropped %u\n", total, dropped);
+}
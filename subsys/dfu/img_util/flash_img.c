@@ -23,6 +23,10 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <drivers/flash.h>
 #endif
 
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+#include <sys/byteorder.h>
+#endif
+
 #include <generated_dts_board.h>
 /* DT_FLASH_AREA_IMAGE_XX_YY values used below are auto-generated by DT */
 #ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
@@ -35,6 +39,119 @@ BUILD_ASSERT_MSG((CONFIG_IMG_BLOCK_BUF_SIZE % DT_FLASH_WRITE_BLOCK_SIZE == 0),
 		 "CONFIG_IMG_BLOCK_BUF_SIZE is not a multiple of "
 		 "DT_FLASH_WRITE_BLOCK_SIZE");
 
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+/* MCUboot image header and TLV layout */
+#define IMAGE_MAGIC		0x96f3b83d
+#define IMAGE_HEADER_SIZE	32
+#define IMAGE_TLV_INFO_MAGIC	0x6907
+#define IMAGE_TLV_INFO_SIZE	4
+#define IMAGE_TLV_SIZE		4
+#define IMAGE_TLV_SHA256	0x10
+
+BUILD_ASSERT_MSG(CONFIG_IMG_BLOCK_BUF_SIZE >= IMAGE_HEADER_SIZE,
+		 "CONFIG_IMG_BLOCK_BUF_SIZE can't hold the image header");
+
+/* The hash covers the header, the image and the protected TLVs */
+static size_t flash_img_hash_len(const u8_t *hdr)
+{
+	if (sys_get_le32(&hdr[0]) != IMAGE_MAGIC) {
+		LOG_WRN("no MCUboot image header");
+		return 0;
+	}
+
+	return sys_get_le16(&hdr[8]) + sys_get_le16(&hdr[10]) +
+	       sys_get_le32(&hdr[12]);
+}
+
+static void flash_img_hash_update(struct flash_img_context *ctx)
+{
+	size_t len;
+
+	if (ctx->bytes_written == 0) {
+		ctx->hash_len = flash_img_hash_len(ctx->buf);
+	}
+
+	if (ctx->hashed >= ctx->hash_len) {
+		return;
+	}
+
+	len = MIN(ctx->buf_bytes, ctx->hash_len - ctx->hashed);
+	tc_sha256_update(&ctx->sha, ctx->buf, len);
+	ctx->hashed += len;
+}
+
+int flash_img_check(struct flash_img_context *ctx)
+{
+	struct tc_sha256_state_struct sha = ctx->sha;
+	const struct flash_area *fa;
+	u8_t hash[TC_SHA256_DIGEST_SIZE];
+	u8_t expected[TC_SHA256_DIGEST_SIZE];
+	u8_t tlv[IMAGE_TLV_SIZE];
+	off_t off;
+	off_t end;
+	int rc;
+
+	if ((ctx->hash_len == 0) || (ctx->hashed != ctx->hash_len)) {
+		return -EINVAL;
+	}
+
+	/* Finalize a copy, so the check can be repeated */
+	tc_sha256_final(hash, &sha);
+
+	rc = flash_area_open(FLASH_AREA_IMAGE_SECONDARY, &fa);
+	if (rc) {
+		return rc;
+	}
+
+	/* Only the few bytes of the TLVs are read back */
+	off = ctx->hash_len;
+	rc = flash_area_read(fa, off, tlv, sizeof(tlv));
+	if (rc) {
+		goto out;
+	}
+
+	if (sys_get_le16(&tlv[0]) != IMAGE_TLV_INFO_MAGIC) {
+		rc = -ENOENT;
+		goto out;
+	}
+
+	end = off + sys_get_le16(&tlv[2]);
+	rc = -ENOENT;
+
+	for (off += IMAGE_TLV_INFO_SIZE; off + IMAGE_TLV_SIZE <= end;
+	     off += IMAGE_TLV_SIZE + sys_get_le16(&tlv[2])) {
+		rc = flash_area_read(fa, off, tlv, sizeof(tlv));
+		if (rc) {
+			goto out;
+		}
+
+		if ((tlv[0] != IMAGE_TLV_SHA256) ||
+		    (sys_get_le16(&tlv[2]) != sizeof(expected))) {
+			rc = -ENOENT;
+			continue;
+		}
+
+		rc = flash_area_read(fa, off + IMAGE_TLV_SIZE, expected,
+				     sizeof(expected));
+		if (rc) {
+			goto out;
+		}
+
+		if (memcmp(hash, expected, sizeof(hash))) {
+			LOG_ERR("image hash mismatch");
+			rc = -EBADMSG;
+		}
+
+		break;
+	}
+
+out:
+	flash_area_close(fa);
+
+	return rc;
+}
+#endif /* CONFIG_IMG_ENABLE_HASH_CHECK */
+
 static bool flash_verify(const struct flash_area *fa, off_t offset,
 			 u8_t *data, size_t len)
 {
@@ -137,6 +254,10 @@ static int flash_sync(struct flash_img_context *ctx)
 				CONFIG_IMG_BLOCK_BUF_SIZE);
 #endif
 
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+	flash_img_hash_update(ctx);
+#endif
+
 	rc = flash_area_write(ctx->flash_area, ctx->bytes_written, ctx->buf,
 			      CONFIG_IMG_BLOCK_BUF_SIZE);
 	if (rc) {
@@ -220,7 +341,67 @@ int flash_img_init(struct flash_img_context *ctx)
 	ctx->buf_bytes = 0U;
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 	ctx->off_last = -1;
+#endif
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+	ctx->hash_len = 0;
+	ctx->hashed = 0;
+	tc_sha256_init(&ctx->sha);
 #endif
 	return flash_area_open(FLASH_AREA_IMAGE_SECONDARY,
 			       (const struct flash_area **)&(ctx->flash_area));
 }
+
+#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+int flash_img_resume(struct flash_img_context *ctx, size_t offset)
+{
+	struct flash_sector sector;
+	int rc;
+
+	rc = flash_img_init(ctx);
+	if (rc) {
+		return rc;
+	}
+
+	/* Data may have been written past the offset, resume at the start
+	 * of its sector, erased again before writing to it.
+	 */
+	offset -= offset % CONFIG_IMG_BLOCK_BUF_SIZE;
+	rc = flash_sector_from_off(ctx->flash_area, offset, &sector);
+	if (rc) {
+		LOG_ERR("Unable to determine flash sector size");
+		return rc;
+	}
+
+	if (sector.fs_off % CONFIG_IMG_BLOCK_BUF_SIZE) {
+		return -EINVAL;
+	}
+
+	rc = flash_progressive_erase(ctx, sector.fs_off);
+	if (rc) {
+		return rc;
+	}
+
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+	/* Hash the part of the image kept */
+	while (ctx->bytes_written < sector.fs_off) {
+		rc = flash_area_read(ctx->flash_area, ctx->bytes_written,
+				     ctx->buf, CONFIG_IMG_BLOCK_BUF_SIZE);
+		if (rc) {
+			LOG_ERR("flash_read error %d offset=0x%08zx", rc,
+				ctx->bytes_written);
+			return rc;
+		}
+
+		ctx->buf_bytes = CONFIG_IMG_BLOCK_BUF_SIZE;
+		flash_img_hash_update(ctx);
+		ctx->bytes_written += CONFIG_IMG_BLOCK_BUF_SIZE;
+	}
+
+	ctx->buf_bytes = 0U;
+#endif
+
+	ctx->bytes_written = sector.fs_off;
+
+	return 0;
+}
+#endif /* CONFIG_IMG_ERASE_PROGRESSIVELY */
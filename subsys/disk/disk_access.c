@@ -53,6 +53,341 @@ struct disk_info *disk_access_get_di(const char *name)
 	return disk;
 }
 
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+#define CACHE_LINE_SECTORS CONFIG_DISK_ACCESS_CACHE_LINE_SECTORS
+#define CACHE_SECTOR_SIZE CONFIG_DISK_ACCESS_CACHE_SECTOR_SIZE
+
+/* CACHE_LINE_SECTORS contiguous sectors of a disk, starting at a
+ * multiple of CACHE_LINE_SECTORS.
+ */
+struct disk_cache_line {
+	struct disk_info *disk;
+	u32_t start;
+	u32_t valid;	/* bitmap of the sectors held in data */
+	u32_t dirty;	/* bitmap of the sectors not written to the disk */
+	u32_t used;	/* cache_clock of the last access */
+	u8_t data[CACHE_LINE_SECTORS * CACHE_SECTOR_SIZE];
+};
+
+static struct disk_cache_line cache_lines[CONFIG_DISK_ACCESS_CACHE_LINES];
+static u32_t cache_clock;
+
+/* lock to protect the cache lines */
+static struct k_mutex cache_mutex;
+
+static bool disk_cache_usable(struct disk_info *disk)
+{
+	u32_t size;
+
+	if ((disk->ops->ioctl == NULL) ||
+	    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &size) != 0)) {
+		return false;
+	}
+
+	return size == CACHE_SECTOR_SIZE;
+}
+
+/* Returns the bitmap of the sectors of the line in the given range */
+static u32_t cache_line_range(struct disk_cache_line *line, u32_t sector,
+			      u32_t count)
+{
+	u32_t mask = 0U;
+	u32_t idx;
+
+	for (idx = 0U; idx < CACHE_LINE_SECTORS; idx++) {
+		if ((line->start + idx >= sector) &&
+		    (line->start + idx - sector < count)) {
+			mask |= BIT(idx);
+		}
+	}
+
+	return mask;
+}
+
+/* Transfers the sectors of mask, one request per run of contiguous
+ * sectors.
+ */
+static int cache_line_io(struct disk_cache_line *line, u32_t mask, bool write)
+{
+	struct disk_info *disk = line->disk;
+	u32_t first;
+	u32_t end;
+	u8_t *buf;
+	int rc;
+
+	for (first = 0U; first < CACHE_LINE_SECTORS; first = end) {
+		end = first + 1U;
+
+		if (!(mask & BIT(first))) {
+			continue;
+		}
+
+		while ((end < CACHE_LINE_SECTORS) && (mask & BIT(end))) {
+			end++;
+		}
+
+		buf = &line->data[first * CACHE_SECTOR_SIZE];
+		if (write) {
+			rc = disk->ops->write(disk, buf, line->start + first,
+					      end - first);
+		} else {
+			rc = disk->ops->read(disk, buf, line->start + first,
+					     end - first);
+		}
+
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+static int cache_line_flush(struct disk_cache_line *line)
+{
+	int rc;
+
+	if (!line->dirty) {
+		return 0;
+	}
+
+	rc = cache_line_io(line, line->dirty, true);
+	if (rc == 0) {
+		line->dirty = 0U;
+	}
+
+	return rc;
+}
+
+/* Loads all the sectors of the line that are not cached yet, or only
+ * sector idx if that fails.
+ */
+static int cache_line_fill(struct disk_cache_line *line, u32_t idx)
+{
+	struct disk_info *disk = line->disk;
+	u32_t count = CACHE_LINE_SECTORS;
+	u32_t sectors;
+	u32_t mask;
+	int rc;
+
+	/* don't read ahead past the end of the disk */
+	if ((disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+			      &sectors) == 0) &&
+	    (sectors > line->start) && (sectors - line->start < count)) {
+		count = sectors - line->start;
+	}
+
+	mask = ((count < 32U) ? (u32_t)(BIT(count) - 1U) : 0xFFFFFFFF) &
+	       ~line->valid;
+
+	rc = cache_line_io(line, mask, false);
+	if (rc != 0) {
+		mask = BIT(idx);
+		rc = cache_line_io(line, mask, false);
+	}
+
+	if (rc == 0) {
+		line->valid |= mask;
+	}
+
+	return rc;
+}
+
+/* Returns the line holding the sectors from start, evicting the least
+ * recently used line if it is not cached.
+ */
+static int cache_line_get(struct disk_info *disk, u32_t start,
+			  struct disk_cache_line **linep)
+{
+	struct disk_cache_line *line = NULL;
+	int rc;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cache_lines); i++) {
+		if ((cache_lines[i].disk == disk) &&
+		    (cache_lines[i].start == start)) {
+			line = &cache_lines[i];
+			goto found;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(cache_lines); i++) {
+		if (cache_lines[i].disk == NULL) {
+			line = &cache_lines[i];
+			break;
+		}
+
+		if (!line || (cache_lines[i].used < line->used)) {
+			line = &cache_lines[i];
+		}
+	}
+
+	rc = cache_line_flush(line);
+	if (rc != 0) {
+		return rc;
+	}
+
+	line->disk = disk;
+	line->start = start;
+	line->valid = 0U;
+	line->dirty = 0U;
+
+found:
+	line->used = ++cache_clock;
+	*linep = line;
+
+	return 0;
+}
+
+static int disk_cache_read(struct disk_info *disk, u8_t *buf,
+			   u32_t sector, u32_t count)
+{
+	struct disk_cache_line *line;
+	u32_t mask;
+	u32_t idx;
+	int rc;
+	int i;
+
+	if (!disk_cache_usable(disk)) {
+		return disk->ops->read(disk, buf, sector, count);
+	}
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	if (count != 1U) {
+		/* Multi-sector transfers go to the disk, only the sectors
+		 * not written back yet are taken from the cache.
+		 */
+		rc = disk->ops->read(disk, buf, sector, count);
+
+		for (i = 0; (rc == 0) && (i < ARRAY_SIZE(cache_lines)); i++) {
+			line = &cache_lines[i];
+			if (line->disk != disk) {
+				continue;
+			}
+
+			mask = cache_line_range(line, sector, count) &
+			       line->dirty;
+			for (idx = 0U; mask; idx++, mask >>= 1) {
+				if (mask & 1U) {
+					memcpy(&buf[(line->start + idx - sector) *
+						    CACHE_SECTOR_SIZE],
+					       &line->data[idx *
+							   CACHE_SECTOR_SIZE],
+					       CACHE_SECTOR_SIZE);
+				}
+			}
+		}
+
+		goto out;
+	}
+
+	idx = sector % CACHE_LINE_SECTORS;
+
+	rc = cache_line_get(disk, sector - idx, &line);
+	if ((rc == 0) && !(line->valid & BIT(idx))) {
+		rc = cache_line_fill(line, idx);
+	}
+
+	if (rc == 0) {
+		memcpy(buf, &line->data[idx * CACHE_SECTOR_SIZE],
+		       CACHE_SECTOR_SIZE);
+	}
+
+out:
+	k_mutex_unlock(&cache_mutex);
+
+	return rc;
+}
+
+static int disk_cache_write(struct disk_info *disk, const u8_t *buf,
+			    u32_t sector, u32_t count)
+{
+	struct disk_cache_line *line;
+	u32_t mask;
+	u32_t idx;
+	int rc;
+	int i;
+
+	if (!disk_cache_usable(disk)) {
+		return disk->ops->write(disk, buf, sector, count);
+	}
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	if (count != 1U) {
+		/* Multi-sector transfers go to the disk, the cached copies
+		 * of the sectors become stale.
+		 */
+		for (i = 0; i < ARRAY_SIZE(cache_lines); i++) {
+			line = &cache_lines[i];
+			if (line->disk != disk) {
+				continue;
+			}
+
+			mask = cache_line_range(line, sector, count);
+			line->valid &= ~mask;
+			line->dirty &= ~mask;
+		}
+
+		rc = disk->ops->write(disk, buf, sector, count);
+		goto out;
+	}
+
+	idx = sector % CACHE_LINE_SECTORS;
+
+	rc = cache_line_get(disk, sector - idx, &line);
+	if (rc == 0) {
+		memcpy(&line->data[idx * CACHE_SECTOR_SIZE], buf,
+		       CACHE_SECTOR_SIZE);
+		line->valid |= BIT(idx);
+		line->dirty |= BIT(idx);
+	}
+
+out:
+	k_mutex_unlock(&cache_mutex);
+
+	return rc;
+}
+
+/* Writes back the dirty sectors of the disk, and forgets about the
+ * disk if drop is set.
+ */
+static int disk_cache_sync(struct disk_info *disk, bool drop)
+{
+	struct disk_cache_line *line;
+	int rc = 0;
+	int rc2;
+	int i;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(cache_lines); i++) {
+		line = &cache_lines[i];
+		if (line->disk != disk) {
+			continue;
+		}
+
+		rc2 = cache_line_flush(line);
+		if (rc2 != 0) {
+			LOG_ERR("sector %u write back failed (%d)",
+				line->start, rc2);
+			if (rc == 0) {
+				rc = rc2;
+			}
+		}
+
+		if (drop) {
+			line->disk = NULL;
+		}
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return rc;
+}
+#endif /* CONFIG_DISK_ACCESS_CACHE */
+
 int disk_access_init(const char *pdrv)
 {
 	struct disk_info *disk = disk_access_get_di(pdrv);
@@ -87,7 +422,11 @@ int disk_access_read(const char *pdrv, u8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		rc = disk_cache_read(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -101,7 +440,11 @@ int disk_access_write(const char *pdrv, const u8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		rc = disk_cache_write(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -114,6 +457,14 @@ int disk_access_ioctl(const char *pdrv, u8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		if (cmd == DISK_IOCTL_CTRL_SYNC) {
+			rc = disk_cache_sync(disk, false);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+#endif
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -161,6 +512,9 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+	(void)disk_cache_sync(disk, true);
+#endif
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistred", disk->name);
@@ -174,6 +528,9 @@ static int disk_init(struct device *dev)
 	ARG_UNUSED(dev);
 
 	k_mutex_init(&mutex);
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+	k_mutex_init(&cache_mutex);
+#endif
 	sys_dlist_init(&disk_access_list);
 	return 0;
 }
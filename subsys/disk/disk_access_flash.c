@@ -22,6 +22,13 @@ static struct device *flash_dev;
 static u8_t read_copy_buf[CONFIG_DISK_ERASE_BLOCK_SIZE];
 static u8_t *fs_buff = read_copy_buf;
 
+#if defined(CONFIG_DISK_FLASH_WRITE_COALESCE)
+/* address of the erase block held in fs_buff, waiting to be written */
+static off_t cached_block = -1;
+
+static int flush_cached_range(off_t start_addr, u32_t size);
+#endif
+
 /* calculate number of blocks required for a given size */
 #define GET_NUM_BLOCK(total_size, block_size) \
 	((total_size + block_size - 1) / block_size)
@@ -76,6 +83,13 @@ static int disk_flash_access_read(struct disk_info *disk, u8_t *buff,
 	remaining = (sector_count * SECTOR_SIZE);
 	len = CONFIG_DISK_FLASH_MAX_RW_SIZE;
 
+#if defined(CONFIG_DISK_FLASH_WRITE_COALESCE)
+	/* the flash content is stale while the block is cached */
+	if (flush_cached_range(fl_addr, remaining) != 0) {
+		return -EIO;
+	}
+#endif
+
 	num_read = GET_NUM_BLOCK(remaining, CONFIG_DISK_FLASH_MAX_RW_SIZE);
 
 	for (u32_t i = 0; i < num_read; i++) {
@@ -134,31 +148,11 @@ static int read_copy_flash_block(off_t start_addr, u32_t size,
 	return 0;
 }
 
-/* input size is either less or equal to a block size,
- * CONFIG_DISK_ERASE_BLOCK_SIZE.
- */
-static int update_flash_block(off_t start_addr, u32_t size, const void *buff)
+/* erase a block and write a whole block of data to it */
+static int erase_write_flash_block(off_t fl_addr, const u8_t *src)
 {
-	off_t fl_addr;
-	u8_t *src = (u8_t *)buff;
 	u32_t num_write;
 
-	/* if size is a partial block, perform read-copy with user data */
-	if (size < CONFIG_DISK_ERASE_BLOCK_SIZE) {
-		int rc;
-
-		rc = read_copy_flash_block(start_addr, size, buff, fs_buff);
-		if (rc != 0) {
-			return -EIO;
-		}
-
-		/* now use the local buffer as the source */
-		src = (u8_t *)fs_buff;
-	}
-
-	/* always align starting address for flash write operation */
-	fl_addr = ROUND_DOWN(start_addr, CONFIG_DISK_FLASH_ERASE_ALIGNMENT);
-
 	/* disable write-protection first before erase */
 	flash_write_protection_set(flash_dev, false);
 	if (flash_erase(flash_dev, fl_addr, CONFIG_DISK_ERASE_BLOCK_SIZE)
@@ -186,6 +180,87 @@ static int update_flash_block(off_t start_addr, u32_t size, const void *buff)
 	return 0;
 }
 
+#if defined(CONFIG_DISK_FLASH_WRITE_COALESCE)
+static int flush_cached_block(void)
+{
+	off_t fl_addr = cached_block;
+
+	if (fl_addr < 0) {
+		return 0;
+	}
+
+	cached_block = -1;
+
+	return erase_write_flash_block(fl_addr, fs_buff);
+}
+
+/* flush the cached block if it overlaps the given range */
+static int flush_cached_range(off_t start_addr, u32_t size)
+{
+	if ((cached_block < 0) ||
+	    (cached_block >= (start_addr + size)) ||
+	    ((cached_block + CONFIG_DISK_ERASE_BLOCK_SIZE) <= start_addr)) {
+		return 0;
+	}
+
+	return flush_cached_block();
+}
+#endif /* CONFIG_DISK_FLASH_WRITE_COALESCE */
+
+/* input size is either less or equal to a block size,
+ * CONFIG_DISK_ERASE_BLOCK_SIZE.
+ */
+static int update_flash_block(off_t start_addr, u32_t size, const void *buff)
+{
+	off_t fl_addr;
+	u8_t *src = (u8_t *)buff;
+	int rc;
+
+	/* always align starting address for flash write operation */
+	fl_addr = ROUND_DOWN(start_addr, CONFIG_DISK_FLASH_ERASE_ALIGNMENT);
+
+#if defined(CONFIG_DISK_FLASH_WRITE_COALESCE)
+	if (size < CONFIG_DISK_ERASE_BLOCK_SIZE) {
+		/* update the cached copy, it is written later on */
+		if (cached_block == fl_addr) {
+			memcpy(fs_buff + (start_addr - fl_addr), buff, size);
+			return 0;
+		}
+
+		rc = flush_cached_block();
+		if (rc != 0) {
+			return -EIO;
+		}
+
+		rc = read_copy_flash_block(start_addr, size, buff, fs_buff);
+		if (rc != 0) {
+			return -EIO;
+		}
+
+		cached_block = fl_addr;
+		return 0;
+	}
+
+	/* a whole block supersedes the cached copy */
+	if (cached_block == fl_addr) {
+		cached_block = -1;
+	}
+#else
+	/* if size is a partial block, perform read-copy with user data */
+	if (size < CONFIG_DISK_ERASE_BLOCK_SIZE) {
+		rc = read_copy_flash_block(start_addr, size, buff, fs_buff);
+		if (rc != 0) {
+			return -EIO;
+		}
+
+		/* now use the local buffer as the source */
+		src = (u8_t *)fs_buff;
+	}
+#endif /* CONFIG_DISK_FLASH_WRITE_COALESCE */
+
+	return erase_write_flash_block(fl_addr, src);
+}
+
 static int disk_flash_access_write(struct disk_info *disk, const u8_t *buff,
 				 u32_t start_sector, u32_t sector_count)
 {
@@ -259,7 +334,11 @@ static int disk_flash_access_ioctl(struct disk_info *disk, u8_t cmd, void *buff)
 {
 	switch (cmd) {
 	case DISK_IOCTL_CTRL_SYNC:
+#if defined(CONFIG_DISK_FLASH_WRITE_COALESCE)
+		return flush_cached_block();
+#else
 		return 0;
+#endif
 	case DISK_IOCTL_GET_SECTOR_COUNT:
 		*(u32_t *)buff = CONFIG_DISK_VOLUME_SIZE / SECTOR_SIZE;
 		return 0;
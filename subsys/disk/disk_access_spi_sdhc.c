@@ -416,15 +416,15 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 	return 0;
 }
 
-/* Transmits a SDHC data block */
+/* Transmits a SDHC data block, starting with the given token */
 static int sdhc_spi_tx_block(struct sdhc_spi_data *data,
-	u8_t *send, int len)
+	u8_t token, u8_t *send, int len)
 {
 	u8_t buf[SDHC_CRC16_SIZE];
 	int err;
 
 	/* Start the block */
-	buf[0] = SDHC_TOKEN_SINGLE;
+	buf[0] = token;
 	err = sdhc_spi_tx(data, buf, 1);
 	if (err != 0) {
 		return err;
@@ -649,6 +649,60 @@ error:
 	return err;
 }
 
+/* Writes the blocks with a single WRITE_MULTIPLE_BLOCK command, so the
+ * card can program them without waiting for a command per block.
+ */
+static int sdhc_spi_write_multi(struct sdhc_spi_data *data,
+	const u8_t *buf, u32_t sector, u32_t count)
+{
+	u8_t token = SDHC_TOKEN_STOP_TRAN;
+	int err;
+	int err2;
+
+	err = sdhc_spi_cmd_r1(data, SDHC_WRITE_MULTIPLE_BLOCK, sector);
+	if (err < 0) {
+		return err;
+	}
+
+	for (; count != 0U; count--) {
+		err = sdhc_spi_tx_block(data, SDHC_TOKEN_MULTI_WRITE,
+			(u8_t *)buf, SDMMC_DEFAULT_BLOCK_SIZE);
+		if (err != 0) {
+			break;
+		}
+
+		/* Wait for the card to finish programming */
+		err = sdhc_spi_skip_until_ready(data);
+		if (err != 0) {
+			break;
+		}
+
+		buf += SDMMC_DEFAULT_BLOCK_SIZE;
+	}
+
+	/* End the transfer, also after an error. The card goes busy
+	 * one byte after the token.
+	 */
+	err2 = sdhc_spi_tx(data, &token, 1);
+	if (err2 == 0) {
+		err2 = sdhc_spi_rx_u8(data);
+	}
+
+	if (err2 >= 0) {
+		err2 = sdhc_spi_skip_until_ready(data);
+	}
+
+	if (err == 0) {
+		err = err2;
+	}
+
+	if (err == 0) {
+		err = sdhc_spi_cmd_r2(data, SDHC_SEND_STATUS, 0);
+	}
+
+	return err;
+}
+
 static int sdhc_spi_write(struct sdhc_spi_data *data,
 	const u8_t *buf, u32_t sector, u32_t count)
 {
@@ -661,6 +715,11 @@ static int sdhc_spi_write(struct sdhc_spi_data *data,
 
 	sdhc_spi_set_cs(data, 0);
 
+	if (count > 1) {
+		err = sdhc_spi_write_multi(data, buf, sector, count);
+		goto error;
+	}
+
 	/* Write the blocks one-by-one */
 	for (; count != 0U; count--) {
 		err = sdhc_spi_cmd_r1(data, SDHC_WRITE_BLOCK, sector);
@@ -668,7 +727,7 @@ static int sdhc_spi_write(struct sdhc_spi_data *data,
 			goto error;
 		}
 
-		err = sdhc_spi_tx_block(data, (u8_t *)buf,
+		err = sdhc_spi_tx_block(data, SDHC_TOKEN_SINGLE, (u8_t *)buf,
 			SDMMC_DEFAULT_BLOCK_SIZE);
 		if (err != 0) {
 			goto error;
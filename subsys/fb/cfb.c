@@ -51,10 +51,48 @@ struct char_framebuffer {
 
 	/** Invertedj*/
 	bool inverted;
+
+	/** First and last page changed since the last finalize */
+	u16_t dirty_first;
+	u16_t dirty_last;
 };
 
 static struct char_framebuffer char_fb;
 
+#if CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE
+/* Glyphs of a font rearranged page by page, in the framebuffer layout */
+struct glyph_cache {
+	const struct cfb_font *font;
+	u8_t *data;
+};
+
+static struct glyph_cache glyph_cache[CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE];
+static u8_t glyph_cache_next;
+#endif
+
+static inline bool fb_is_dirty(const struct char_framebuffer *fb)
+{
+	return fb->dirty_first <= fb->dirty_last;
+}
+
+static inline void fb_mark_dirty(struct char_framebuffer *fb,
+				 u16_t first, u16_t last)
+{
+	if (!fb_is_dirty(fb)) {
+		fb->dirty_first = first;
+		fb->dirty_last = last;
+		return;
+	}
+
+	fb->dirty_first = MIN(fb->dirty_first, first);
+	fb->dirty_last = MAX(fb->dirty_last, last);
+}
+
+static inline void fb_mark_all(struct char_framebuffer *fb)
+{
+	fb_mark_dirty(fb, 0, fb->size / fb->x_res - 1);
+}
+
 static inline u8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 {
 	if (fptr->caps & CFB_FONT_MONO_VPACKED) {
@@ -66,46 +104,132 @@ static inline u8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 	return NULL;
 }
 
+#if CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE
+static u8_t *glyph_cache_build(const struct cfb_font *fptr)
+{
+	size_t pages = fptr->height / 8U;
+	size_t glyph_size = fptr->width * pages;
+	size_t num = fptr->last_char - fptr->first_char + 1;
+	const u8_t *src = fptr->data;
+	u8_t *data;
+
+	data = k_malloc(num * glyph_size);
+	if (!data) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < num * glyph_size; i += glyph_size) {
+		for (size_t g_x = 0; g_x < fptr->width; g_x++) {
+			for (size_t g_y = 0; g_y < pages; g_y++) {
+				data[i + g_y * fptr->width + g_x] =
+					src[i + g_x * pages + g_y];
+			}
+		}
+	}
+
+	return data;
+}
+
+static u8_t *glyph_cache_get(const struct cfb_font *fptr)
+{
+	struct glyph_cache *entry;
+
+	for (size_t i = 0; i < ARRAY_SIZE(glyph_cache); i++) {
+		if (glyph_cache[i].font == fptr) {
+			return glyph_cache[i].data;
+		}
+	}
+
+	entry = &glyph_cache[glyph_cache_next];
+	glyph_cache_next = (glyph_cache_next + 1) % ARRAY_SIZE(glyph_cache);
+
+	k_free(entry->data);
+	entry->data = glyph_cache_build(fptr);
+	entry->font = entry->data ? fptr : NULL;
+
+	return entry->data;
+}
+#endif
+
+/*
+ * Glyph data laid out page by page like the framebuffer, each page of the
+ * glyph is then a single copy. Fonts one page high already are.
+ */
+static inline u8_t *get_glyph_paged_ptr(const struct cfb_font *fptr, char c)
+{
+	if (!(fptr->caps & CFB_FONT_MONO_VPACKED)) {
+		return NULL;
+	}
+
+	if (fptr->height == 8U) {
+		return get_glyph_ptr(fptr, c);
+	}
+
+#if CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE
+	u8_t *data = glyph_cache_get(fptr);
+
+	if (data) {
+		return data + (c - fptr->first_char) *
+			      (fptr->width * fptr->height / 8U);
+	}
+#endif
+
+	return NULL;
+}
+
 /*
  * Draw the monochrome character in the monochrome tiled framebuffer,
  * a byte is interpreted as 8 pixels ordered vertically among each other.
  */
-static u8_t draw_char_vtmono(const struct char_framebuffer *fb,
+static u8_t draw_char_vtmono(struct char_framebuffer *fb,
 			     char c, u16_t x, u16_t y)
 {
 	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
+	u32_t y_segment = y / 8U;
+	u32_t pages = fptr->height / 8U;
 	u8_t *glyph_ptr;
+	size_t width;
 
 	if (c < fptr->first_char || c > fptr->last_char) {
 		c = ' ';
 	}
 
-	glyph_ptr = get_glyph_ptr(fptr, c);
-	if (!glyph_ptr) {
+	if (x >= fb->x_res || (y_segment + pages) * fb->x_res > fb->size) {
 		return 0;
 	}
 
-	for (size_t g_x = 0; g_x < fptr->width; g_x++) {
-		u32_t y_segment = y / 8U;
+	width = MIN(fptr->width, fb->x_res - x);
+
+	glyph_ptr = get_glyph_paged_ptr(fptr, c);
+	if (glyph_ptr) {
+		for (size_t g_y = 0; g_y < pages; g_y++) {
+			memcpy(&fb->buf[(y_segment + g_y) * fb->x_res + x],
+			       &glyph_ptr[g_y * fptr->width], width);
+		}
+	} else {
+		glyph_ptr = get_glyph_ptr(fptr, c);
+		if (!glyph_ptr) {
+			return 0;
+		}
 
-		for (size_t g_y = 0; g_y < fptr->height / 8U; g_y++) {
-			u32_t fb_y = (y_segment + g_y) * fb->x_res;
+		for (size_t g_x = 0; g_x < width; g_x++) {
+			for (size_t g_y = 0; g_y < pages; g_y++) {
+				u32_t fb_y = (y_segment + g_y) * fb->x_res;
 
-			if ((fb_y + x + g_x) >= fb->size) {
-				return 0;
+				fb->buf[fb_y + x + g_x] =
+					glyph_ptr[g_x * pages + g_y];
 			}
-			fb->buf[fb_y + x + g_x] =
-				glyph_ptr[g_x * (fptr->height / 8U) + g_y];
 		}
-
 	}
 
+	fb_mark_dirty(fb, y_segment, y_segment + pages - 1);
+
 	return fptr->width;
 }
 
 int cfb_print(struct device *dev, char *str, u16_t x, u16_t y)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
 
 	if (!fb->fonts || !fb->buf) {
@@ -132,28 +256,62 @@ int cfb_print(struct device *dev, char *str, u16_t x, u16_t y)
 	return -1;
 }
 
-static int cfb_reverse_bytes(const struct char_framebuffer *fb)
+static inline u32_t reverse_bits_in_bytes(u32_t v)
 {
+	v = (v & 0xf0f0f0f0) >> 4 | (v & 0x0f0f0f0f) << 4;
+	v = (v & 0xcccccccc) >> 2 | (v & 0x33333333) << 2;
+	v = (v & 0xaaaaaaaa) >> 1 | (v & 0x55555555) << 1;
+
+	return v;
+}
+
+/*
+ * Both transformations are their own inverse, they are applied to the
+ * range sent to the display and undone afterwards.
+ */
+static int cfb_reverse_bytes(const struct char_framebuffer *fb,
+			     size_t start, size_t len)
+{
+	size_t i = start;
+
 	if (!(fb->screen_info & SCREEN_INFO_MONO_VTILED)) {
 		LOG_ERR("Unsupported framebuffer configuration");
 		return -1;
 	}
 
-	for (size_t i = 0; i < fb->x_res * fb->y_res / 8U; i++) {
-		fb->buf[i] = (fb->buf[i] & 0xf0) >> 4 |
-			      (fb->buf[i] & 0x0f) << 4;
-		fb->buf[i] = (fb->buf[i] & 0xcc) >> 2 |
-			      (fb->buf[i] & 0x33) << 2;
-		fb->buf[i] = (fb->buf[i] & 0xaa) >> 1 |
-			      (fb->buf[i] & 0x55) << 1;
+	for (; i < start + len && ((uintptr_t)&fb->buf[i] & 0x3); i++) {
+		fb->buf[i] = reverse_bits_in_bytes(fb->buf[i]);
+	}
+
+	for (; i + 4 <= start + len; i += 4) {
+		u32_t *word = (u32_t *)&fb->buf[i];
+
+		*word = reverse_bits_in_bytes(*word);
+	}
+
+	for (; i < start + len; i++) {
+		fb->buf[i] = reverse_bits_in_bytes(fb->buf[i]);
 	}
 
 	return 0;
 }
 
-static int cfb_invert(const struct char_framebuffer *fb)
+static int cfb_invert(const struct char_framebuffer *fb,
+		      size_t start, size_t len)
 {
-	for (size_t i = 0; i < fb->x_res * fb->y_res / 8U; i++) {
+	size_t i = start;
+
+	for (; i < start + len && ((uintptr_t)&fb->buf[i] & 0x3); i++) {
+		fb->buf[i] = ~fb->buf[i];
+	}
+
+	for (; i + 4 <= start + len; i += 4) {
+		u32_t *word = (u32_t *)&fb->buf[i];
+
+		*word = ~*word;
+	}
+
+	for (; i < start + len; i++) {
 		fb->buf[i] = ~fb->buf[i];
 	}
 
@@ -162,7 +320,7 @@ static int cfb_invert(const struct char_framebuffer *fb)
 
 int cfb_framebuffer_clear(struct device *dev, bool clear_display)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
 
 	if (!fb || !fb->buf) {
@@ -174,6 +332,7 @@ int cfb_framebuffer_clear(struct device *dev, bool clear_display)
 	desc.height = fb->y_res;
 	desc.pitch = fb->x_res;
 	memset(fb->buf, 0, fb->size);
+	fb_mark_all(fb);
 
 	return 0;
 }
@@ -188,34 +347,63 @@ int cfb_framebuffer_invert(struct device *dev)
 	}
 
 	fb->inverted = !fb->inverted;
+	fb_mark_all(fb);
 
 	return 0;
 }
 
+/* Only the pages changed since the last call are sent to the display. */
 int cfb_framebuffer_finalize(struct device *dev)
 {
 	const struct display_driver_api *api = dev->driver_api;
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
+	bool invert;
+	bool reverse;
+	size_t start;
+	int err;
 
 	if (!fb || !fb->buf) {
 		return -1;
 	}
 
-	desc.buf_size = fb->size;
+	if (!fb_is_dirty(fb)) {
+		return 0;
+	}
+
+	start = fb->dirty_first * fb->x_res;
+	desc.buf_size = (fb->dirty_last - fb->dirty_first + 1) * fb->x_res;
 	desc.width = fb->x_res;
-	desc.height = fb->y_res;
+	desc.height = (fb->dirty_last - fb->dirty_first + 1) * 8U;
 	desc.pitch = fb->x_res;
 
-	if (!(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted)) {
-		cfb_invert(fb);
+	invert = !(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted);
+	reverse = fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST;
+
+	if (invert) {
+		cfb_invert(fb, start, desc.buf_size);
 	}
 
-	if (fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) {
-		cfb_reverse_bytes(fb);
+	if (reverse) {
+		cfb_reverse_bytes(fb, start, desc.buf_size);
+	}
+
+	err = api->write(dev, 0, fb->dirty_first * 8U, &desc, &fb->buf[start]);
+
+	if (reverse) {
+		cfb_reverse_bytes(fb, start, desc.buf_size);
 	}
 
-	return api->write(dev, 0, 0, &desc, fb->buf);
+	if (invert) {
+		cfb_invert(fb, start, desc.buf_size);
+	}
+
+	if (!err) {
+		fb->dirty_first = 1U;
+		fb->dirty_last = 0U;
+	}
+
+	return err;
 }
 
 int cfb_get_display_parameter(struct device *dev,
@@ -318,5 +506,10 @@ int cfb_framebuffer_init(struct device *dev)
 
 	memset(fb->buf, 0, fb->size);
 
+	/* Whatever the display shows is unknown, start over completely. */
+	fb->dirty_first = 1U;
+	fb->dirty_last = 0U;
+	fb_mark_all(fb);
+
 	return 0;
 }
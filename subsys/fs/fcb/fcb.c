@@ -85,6 +85,10 @@ fcb_erase_sector(const struct fcb *fcb, const struct flash_sector *sector)
 		return FCB_ERR_FLASH;
 	}
 
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+	fcb_summary_reset(fcb, sector);
+#endif
+
 	return 0;
 }
 
@@ -116,6 +120,9 @@ fcb_init(int f_area_id, struct fcb *fcb)
 	/* Fill last used, first used */
 	for (i = 0; i < fcb->f_sector_cnt; i++) {
 		sector = &fcb->f_sectors[i];
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+		fcb_summary_reset(fcb, sector);
+#endif
 		rc = fcb_sector_hdr_read(fcb, sector, &fda);
 		if (rc < 0) {
 			return rc;
@@ -245,6 +252,9 @@ fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, u16_t id)
 	if (rc != 0) {
 		return FCB_ERR_FLASH;
 	}
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+	fcb_summary_reset(fcb, sector);
+#endif
 	return 0;
 }
 
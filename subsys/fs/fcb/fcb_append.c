@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 #include <string.h>
+#include <sys/crc.h>
 
 #include <fs/fcb.h>
 #include "fcb_priv.h"
@@ -56,8 +57,8 @@ fcb_append_to_scratch(struct fcb *fcb)
 	return FCB_OK;
 }
 
-int
-fcb_append(struct fcb *fcb, u16_t len, struct fcb_entry *append_loc)
+static int
+fcb_append_nolock(struct fcb *fcb, u16_t len, struct fcb_entry *append_loc)
 {
 	struct flash_sector *sector;
 	struct fcb_entry *active;
@@ -74,21 +75,16 @@ fcb_append(struct fcb *fcb, u16_t len, struct fcb_entry *append_loc)
 
 	__ASSERT_NO_MSG(cnt <= sizeof(tmp_str));
 
-	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
-	if (rc) {
-		return FCB_ERR_ARGS;
-	}
 	active = &fcb->f_active;
 	if (active->fe_elem_off + len + cnt > active->fe_sector->fs_size) {
 		sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
 		if (!sector || (sector->fs_size <
 			sizeof(struct fcb_disk_area) + len + cnt)) {
-			rc = FCB_ERR_NOSPACE;
-			goto err;
+			return FCB_ERR_NOSPACE;
 		}
 		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
 		if (rc) {
-			goto err;
+			return rc;
 		}
 		fcb->f_active.fe_sector = sector;
 		fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
@@ -97,8 +93,7 @@ fcb_append(struct fcb *fcb, u16_t len, struct fcb_entry *append_loc)
 
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
 	if (rc) {
-		rc = FCB_ERR_FLASH;
-		goto err;
+		return FCB_ERR_FLASH;
 	}
 	append_loc->fe_sector = active->fe_sector;
 	append_loc->fe_elem_off = active->fe_elem_off;
@@ -106,14 +101,118 @@ fcb_append(struct fcb *fcb, u16_t len, struct fcb_entry *append_loc)
 
 	active->fe_elem_off = append_loc->fe_data_off + len;
 
-	k_mutex_unlock(&fcb->f_mtx);
-
 	return FCB_OK;
-err:
+}
+
+int
+fcb_append(struct fcb *fcb, u16_t len, struct fcb_entry *append_loc)
+{
+	int rc;
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return FCB_ERR_ARGS;
+	}
+
+	rc = fcb_append_nolock(fcb, len, append_loc);
+
 	k_mutex_unlock(&fcb->f_mtx);
+
 	return rc;
 }
 
+/*
+ * Write the data of an element, and its crc8 computed from RAM rather than
+ * read back from flash.
+ */
+static int
+fcb_append_data(struct fcb *fcb, struct fcb_entry *loc, const u8_t *data,
+		u16_t len)
+{
+	u8_t tmp_str[FCB_TMP_BUF_SZ];
+	u8_t crc8;
+	size_t blen;
+	int cnt;
+	int rc;
+
+	__ASSERT_NO_MSG(fcb->f_align <= sizeof(tmp_str));
+
+	cnt = fcb_put_len(tmp_str, len);
+	crc8 = CRC8_CCITT_INITIAL_VALUE;
+	crc8 = crc8_ccitt(crc8, tmp_str, cnt);
+	crc8 = crc8_ccitt(crc8, data, len);
+
+	/* aligned part, then the remainder padded to the write alignment */
+	blen = len & ~(fcb->f_align - 1U);
+	if (blen) {
+		rc = fcb_flash_write(fcb, loc->fe_sector, loc->fe_data_off,
+				     data, blen);
+		if (rc) {
+			return FCB_ERR_FLASH;
+		}
+	}
+	if (len > blen) {
+		(void)memset(tmp_str, 0xFF, fcb->f_align);
+		memcpy(tmp_str, data + blen, len - blen);
+		rc = fcb_flash_write(fcb, loc->fe_sector,
+				     loc->fe_data_off + blen, tmp_str,
+				     fcb->f_align);
+		if (rc) {
+			return FCB_ERR_FLASH;
+		}
+	}
+
+	(void)memset(tmp_str, 0xFF, fcb->f_align);
+	tmp_str[0] = crc8;
+	rc = fcb_flash_write(fcb, loc->fe_sector,
+			     loc->fe_data_off + fcb_len_in_flash(fcb, len),
+			     tmp_str, fcb->f_align);
+	if (rc) {
+		return FCB_ERR_FLASH;
+	}
+
+	loc->fe_data_len = len;
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+	fcb_summary_update(fcb, loc);
+#endif
+
+	return 0;
+}
+
+int
+fcb_append_batch(struct fcb *fcb, const void *const *data,
+		 const u16_t *len, int cnt)
+{
+	struct fcb_entry loc;
+	int rc;
+	int i;
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return FCB_ERR_ARGS;
+	}
+
+	for (i = 0; i < cnt; i++) {
+		rc = fcb_append_nolock(fcb, len[i], &loc);
+		if (rc) {
+			break;
+		}
+
+		rc = fcb_append_data(fcb, &loc, data[i], len[i]);
+		if (rc) {
+			break;
+		}
+	}
+
+	k_mutex_unlock(&fcb->f_mtx);
+
+	if (rc == FCB_ERR_NOSPACE && i) {
+		return i;
+	}
+
+	return rc ? rc : cnt;
+}
+
 int
 fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 {
@@ -133,5 +232,8 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return FCB_ERR_FLASH;
 	}
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+	fcb_summary_update(fcb, loc);
+#endif
 	return 0;
 }
@@ -11,19 +11,14 @@
 #include "fcb_priv.h"
 
 /*
- * Given offset in flash sector, fill in rest of the fcb_entry, and crc8 over
- * the data.
+ * Given offset in flash sector, read the length of the element and fill in
+ * rest of the fcb_entry. Returns the number of bytes of the length.
  */
-int
-fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *c8p)
+static int
+fcb_elem_len_read(struct fcb *fcb, struct fcb_entry *loc, u8_t *tmp_str)
 {
-	u8_t tmp_str[FCB_TMP_BUF_SZ];
 	int cnt;
-	int blk_sz;
-	u8_t crc8;
 	u16_t len;
-	u32_t off;
-	u32_t end;
 	int rc;
 
 	if (loc->fe_elem_off + 2 > loc->fe_sector->fs_size) {
@@ -41,6 +36,31 @@ fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *c8p)
 	loc->fe_data_off = loc->fe_elem_off + fcb_len_in_flash(fcb, cnt);
 	loc->fe_data_len = len;
 
+	return cnt;
+}
+
+/*
+ * Given offset in flash sector, fill in rest of the fcb_entry, and crc8 over
+ * the data.
+ */
+int
+fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *c8p)
+{
+	u8_t tmp_str[FCB_TMP_BUF_SZ];
+	int cnt;
+	int blk_sz;
+	u8_t crc8;
+	u16_t len;
+	u32_t off;
+	u32_t end;
+	int rc;
+
+	cnt = fcb_elem_len_read(fcb, loc, tmp_str);
+	if (cnt < 0) {
+		return cnt;
+	}
+	len = loc->fe_data_len;
+
 	crc8 = CRC8_CCITT_INITIAL_VALUE;
 	crc8 = crc8_ccitt(crc8, tmp_str, cnt);
 
@@ -63,12 +83,55 @@ fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *c8p)
 	return 0;
 }
 
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+void fcb_summary_reset(const struct fcb *fcb,
+		       const struct flash_sector *sector)
+{
+	struct fcb_sector_summary *summary;
+
+	summary = fcb_sector_summary(fcb, sector);
+	if (summary) {
+		summary->fss_checked_off = sizeof(struct fcb_disk_area);
+		summary->fss_elem_cnt = 0U;
+	}
+}
+
+/*
+ * Extend the checked part of the sector if loc, found valid, follows it.
+ */
+void fcb_summary_update(struct fcb *fcb, const struct fcb_entry *loc)
+{
+	struct fcb_sector_summary *summary;
+
+	summary = fcb_sector_summary(fcb, loc->fe_sector);
+	if (!summary || loc->fe_elem_off != summary->fss_checked_off) {
+		return;
+	}
+
+	summary->fss_checked_off = loc->fe_data_off +
+				   fcb_len_in_flash(fcb, loc->fe_data_len) +
+				   fcb_len_in_flash(fcb, FCB_CRC_SZ);
+	summary->fss_elem_cnt++;
+}
+#endif
+
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 {
 	int rc;
 	u8_t crc8;
 	u8_t fl_crc8;
 	off_t off;
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+	struct fcb_sector_summary *summary;
+	u8_t tmp_str[2];
+
+	/* the element has already been found valid */
+	summary = fcb_sector_summary(fcb, loc->fe_sector);
+	if (summary && loc->fe_elem_off < summary->fss_checked_off) {
+		rc = fcb_elem_len_read(fcb, loc, tmp_str);
+		return (rc < 0) ? rc : 0;
+	}
+#endif
 
 	rc = fcb_elem_crc8(fcb, loc, &crc8);
 	if (rc) {
@@ -84,5 +147,8 @@ int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 	if (fl_crc8 != crc8) {
 		return FCB_ERR_CRC;
 	}
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+	fcb_summary_update(fcb, loc);
+#endif
 	return 0;
 }
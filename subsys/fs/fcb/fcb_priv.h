@@ -47,6 +47,21 @@ int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *crc8p);
 
+#if defined(CONFIG_FCB_SECTOR_SUMMARY)
+static inline struct fcb_sector_summary *
+fcb_sector_summary(const struct fcb *fcb, const struct flash_sector *sector)
+{
+	if (!fcb->f_summary) {
+		return NULL;
+	}
+	return &fcb->f_summary[sector - fcb->f_sectors];
+}
+
+void fcb_summary_reset(const struct fcb *fcb,
+		       const struct flash_sector *sector);
+void fcb_summary_update(struct fcb *fcb, const struct fcb_entry *loc);
+#endif
+
 int fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, u16_t id);
 int fcb_sector_hdr_read(struct fcb *fcb, struct flash_sector *sector,
 			struct fcb_disk_area *fdap);
@@ -26,6 +26,10 @@ struct lfs_file_data {
 	struct lfs_file file;
 	struct lfs_file_config config;
 	struct k_mem_block cache_block;
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	sys_snode_t sync_node;
+	bool sync_pending;
+#endif
 };
 
 #define LFS_FILEP(fp) (&((struct lfs_file_data *)(fp->filep))->file)
@@ -169,6 +173,69 @@ static int lfs_api_sync(const struct lfs_config *c)
 	return LFS_ERR_OK;
 }
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+/* Commit all files with a deferred sync.  Must be called with the
+ * file system locked.
+ */
+static int sync_pending_files(struct fs_littlefs *fs)
+{
+	struct lfs_file_data *fdp;
+	sys_snode_t *node;
+	int ret = 0;
+	int rc;
+
+	while ((node = sys_slist_get(&fs->sync_files)) != NULL) {
+		fdp = CONTAINER_OF(node, struct lfs_file_data, sync_node);
+		fdp->sync_pending = false;
+
+		rc = lfs_file_sync(&fs->lfs, &fdp->file);
+		if (rc < 0) {
+			LOG_ERR("deferred sync failed (LFS %d)", rc);
+			if (ret == 0) {
+				ret = rc;
+			}
+		}
+	}
+
+	return ret;
+}
+
+static void sync_work_handler(struct k_work *work)
+{
+	struct fs_littlefs *fs = CONTAINER_OF(work, struct fs_littlefs,
+					      sync_work);
+
+	fs_lock(fs);
+
+	(void)sync_pending_files(fs);
+
+	fs_unlock(fs);
+}
+
+/* Returns true if the sync of the file is left to the work queue. */
+static bool sync_defer(struct fs_littlefs *fs, struct lfs_file_data *fdp)
+{
+	if (fs->sync_delay <= 0) {
+		return false;
+	}
+
+	if (!fdp->sync_pending) {
+		/* The delay runs from the oldest uncommitted sync, so a
+		 * file synced all the time still gets committed.
+		 */
+		if (sys_slist_is_empty(&fs->sync_files)) {
+			k_delayed_work_submit(&fs->sync_work,
+					      K_MSEC(fs->sync_delay));
+		}
+
+		sys_slist_append(&fs->sync_files, &fdp->sync_node);
+		fdp->sync_pending = true;
+	}
+
+	return true;
+}
+#endif /* CONFIG_FS_LITTLEFS_DEFERRED_SYNC */
+
 static void release_file_data(struct fs_file_t *fp)
 {
 	struct lfs_file_data *fdp = fp->filep;
@@ -227,6 +294,16 @@ static int littlefs_close(struct fs_file_t *fp)
 
 	fs_lock(fs);
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	struct lfs_file_data *fdp = fp->filep;
+
+	/* Closing the file commits it. */
+	if (fdp->sync_pending) {
+		sys_slist_find_and_remove(&fs->sync_files, &fdp->sync_node);
+		fdp->sync_pending = false;
+	}
+#endif
+
 	int ret = lfs_file_close(&fs->lfs, LFS_FILEP(fp));
 
 	fs_unlock(fs);
@@ -341,6 +418,13 @@ static int littlefs_sync(struct fs_file_t *fp)
 
 	fs_lock(fs);
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	if (sync_defer(fs, fp->filep)) {
+		fs_unlock(fs);
+		return 0;
+	}
+#endif
+
 	int ret = lfs_file_sync(&fs->lfs, LFS_FILEP(fp));
 
 	fs_unlock(fs);
@@ -547,6 +631,11 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 	k_mutex_init(&fs->mutex);
 	fs_lock(fs);
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	k_delayed_work_init(&fs->sync_work, sync_work_handler);
+	sys_slist_init(&fs->sync_files);
+#endif
+
 	/* Open flash area */
 	ret = flash_area_open(area_id, &fs->area);
 	if ((ret < 0) || (fs->area == NULL)) {
@@ -632,6 +721,9 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 		block_count, block_size, block_cycles);
 	LOG_INF("sizes: rd %u ; pr %u ; ca %u ; la %u",
 		read_size, prog_size, cache_size, lookahead_size);
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	LOG_INF("sync delay %d ms", fs->sync_delay);
+#endif
 
 	__ASSERT_NO_MSG(prog_size != 0);
 	__ASSERT_NO_MSG(read_size != 0);
@@ -695,6 +787,11 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 
 	fs_lock(fs);
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	k_delayed_work_cancel(&fs->sync_work);
+	(void)sync_pending_files(fs);
+#endif
+
 	lfs_unmount(&fs->lfs);
 	flash_area_close(fs->area);
 	fs->area = NULL;
@@ -9,6 +9,7 @@
 #include <string.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <fs/nvs.h>
 #include <sys/crc.h>
 #include "nvs_priv.h"
@@ -26,6 +27,36 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 	}
 	return (len + (fs->write_block_size - 1U)) & ~(fs->write_block_size - 1U);
 }
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+/* the lookup cache holds, for every hash of the id, the address of the most
+ * recent ate of all the ids sharing that hash. A read starts walking from
+ * there instead of from fs->ate_wra.
+ */
+static inline size_t nvs_lookup_cache_pos(u16_t id)
+{
+	return id % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+
+static inline void nvs_lookup_cache_set(struct nvs_fs *fs, u16_t id,
+					u32_t addr)
+{
+	fs->lookup_cache[nvs_lookup_cache_pos(id)] = addr;
+}
+
+/* drop the cache entries that point to a sector that is erased */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, u32_t addr)
+{
+	size_t i;
+
+	for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] & ADDR_SECT_MASK) ==
+		    (addr & ADDR_SECT_MASK)) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif
 /* end basic routines */
 
 /* flash routines */
@@ -243,6 +274,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, u32_t addr)
 		return rc;
 	}
 	(void) flash_write_protection_set(fs->flash_device, 1);
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	nvs_lookup_cache_invalidate(fs, addr);
+#endif
 	return 0;
 }
 
@@ -308,6 +342,9 @@ static int nvs_flash_wrt_entry(struct nvs_fs *fs, u16_t id, const void *data,
 	if (rc) {
 		return rc;
 	}
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	nvs_lookup_cache_set(fs, id, fs->ate_wra);
+#endif
 	rc = nvs_flash_ate_wrt(fs, &entry);
 	if (rc) {
 		return rc;
@@ -437,24 +474,34 @@ static int nvs_sector_close(struct nvs_fs *fs)
 
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
- * sector.
+ * sector. nvs_gc_sector returns the address of that sector.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static u32_t nvs_gc_sector(struct nvs_fs *fs)
+{
+	u32_t sec_addr;
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+
+	return sec_addr;
+}
+
+/* locate the ate's in the sector to gc: gc_addr is set to the most recent
+ * ate and stop_addr to the oldest one. Returns 1 if there are ate's to go
+ * through, 0 if the sector is not closed and only needs an erase.
+ */
+static int nvs_gc_locate(struct nvs_fs *fs, u32_t *gc_addr, u32_t *stop_addr)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	u32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	*gc_addr = nvs_gc_sector(fs) + fs->sector_size - ate_size;
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_flash_ate_rd(fs, *gc_addr, &close_ate);
 	if (rc < 0) {
 		/* flash error */
 		return rc;
@@ -462,78 +509,300 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, 0xff);
 	if (!rc) {
-		rc = nvs_flash_erase_sector(fs, sec_addr);
+		return 0;
+	}
+
+	*stop_addr = *gc_addr - ate_size;
+
+	*gc_addr &= ADDR_SECT_MASK;
+	*gc_addr += close_ate.offset;
+
+	return 1;
+}
+
+/* read the ate at gc_addr, modify gc_addr to the previous ate and copy the
+ * entry to the write sector if it is the most recent one of its id. When
+ * move_size is not NULL nothing is copied, the space the copy would take is
+ * added to move_size instead.
+ */
+static int nvs_gc_move(struct nvs_fs *fs, u32_t *gc_addr, u32_t *gc_prev_addr,
+		       struct nvs_ate *gc_ate, size_t *move_size)
+{
+	int rc;
+	struct nvs_ate wlk_ate, mv_ate;
+	u32_t wlk_addr, wlk_prev_addr, data_addr;
+
+	*gc_prev_addr = *gc_addr;
+	rc = nvs_prev_ate(fs, gc_addr, gc_ate);
+	if (rc) {
+		return rc;
+	}
+	wlk_addr = fs->ate_wra;
+	while (1) {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
 			return rc;
 		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (!nvs_ate_crc8_check(&wlk_ate))) {
+			break;
+		}
+	}
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr != *gc_prev_addr) || !gc_ate->len) {
 		return 0;
 	}
 
-	stop_addr = gc_addr - ate_size;
+	if (move_size) {
+		*move_size += nvs_al_size(fs, gc_ate->len);
+		*move_size += nvs_al_size(fs, sizeof(struct nvs_ate));
+		return 0;
+	}
 
-	gc_addr &= ADDR_SECT_MASK;
-	gc_addr += close_ate.offset;
+	/* copy needed */
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
 
-	while (1) {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+	data_addr = (*gc_prev_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	mv_ate = *gc_ate;
+	mv_ate.offset = (u16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(&mv_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, mv_ate.len);
+	if (rc) {
+		return rc;
+	}
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	nvs_lookup_cache_set(fs, mv_ate.id, fs->ate_wra);
+#endif
+	rc = nvs_flash_ate_wrt(fs, &mv_ate);
+	if (rc) {
+		return rc;
+	}
+
+	return 0;
+}
+
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	u32_t gc_addr, gc_prev_addr, stop_addr;
+
+	rc = nvs_gc_locate(fs, &gc_addr, &stop_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	while (rc) {
+		rc = nvs_gc_move(fs, &gc_addr, &gc_prev_addr, &gc_ate, NULL);
 		if (rc) {
 			return rc;
 		}
-		wlk_addr = fs->ate_wra;
-		while (1) {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (!nvs_ate_crc8_check(&wlk_ate))) {
-				break;
-			}
+
+		/* stop gc at end of the sector */
+		if (gc_prev_addr == stop_addr) {
+			break;
 		}
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+	}
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+	rc = nvs_flash_erase_sector(fs, nvs_gc_sector(fs));
+	if (rc) {
+		return rc;
+	}
+	return 0;
+}
 
-			gc_ate.offset = (u16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+/* space needed in the write sector to finish the gc that was interrupted */
+static int nvs_gc_move_size(struct nvs_fs *fs, size_t *move_size)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	u32_t gc_addr, gc_prev_addr, stop_addr;
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
+	*move_size = 0;
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
+	rc = nvs_gc_locate(fs, &gc_addr, &stop_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	while (rc) {
+		rc = nvs_gc_move(fs, &gc_addr, &gc_prev_addr, &gc_ate,
+				 move_size);
+		if (rc) {
+			return rc;
 		}
 
-		/* stop gc at end of the sector */
 		if (gc_prev_addr == stop_addr) {
 			break;
 		}
 	}
 
-	rc = nvs_flash_erase_sector(fs, sec_addr);
+	return 0;
+}
+
+/* background garbage collection: the ate's of the sector to gc are gone
+ * through a few at a time from the system workqueue, with writes allowed in
+ * between. fs->gc_reserve is kept at an upper bound of the space the
+ * remaining copies take, writes leave that much space free in the write
+ * sector.
+ */
+static int nvs_gc_bg_step(struct nvs_fs *fs, int budget)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	u32_t gc_prev_addr;
+
+	/* no reserve left when only the erase has to be done */
+	while (fs->gc_reserve && budget--) {
+		rc = nvs_gc_move(fs, &fs->gc_addr, &gc_prev_addr, &gc_ate,
+				 NULL);
+		if (rc) {
+			return rc;
+		}
+
+		if (gc_prev_addr == fs->gc_stop_addr) {
+			fs->gc_reserve = 0U;
+			break;
+		}
+
+		/* the data of the older ate's is below the one just done,
+		 * keep the previous bound when its offset can't be trusted.
+		 */
+		if (!nvs_ate_crc8_check(&gc_ate)) {
+			fs->gc_reserve = gc_ate.offset +
+					 (fs->gc_stop_addr - gc_prev_addr);
+		}
+	}
+
+	if (fs->gc_reserve) {
+		return 0;
+	}
+
+	rc = nvs_flash_erase_sector(fs, nvs_gc_sector(fs));
 	if (rc) {
 		return rc;
 	}
+	fs->gc_pending = false;
+
 	return 0;
 }
 
+static int nvs_gc_bg_start(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	rc = nvs_gc_locate(fs, &fs->gc_addr, &fs->gc_stop_addr);
+	if (rc < 0) {
+		return rc;
+	}
+	if (!rc) {
+		return nvs_flash_erase_sector(fs, nvs_gc_sector(fs));
+	}
+
+	/* reserve the data up to the end of the most recent entry and all
+	 * the ate's, or the whole sector if that entry is not valid.
+	 */
+	rc = nvs_flash_ate_rd(fs, fs->gc_addr, &gc_ate);
+	if (rc) {
+		return rc;
+	}
+
+	if (!nvs_ate_crc8_check(&gc_ate)) {
+		fs->gc_reserve = gc_ate.offset + nvs_al_size(fs, gc_ate.len);
+	} else {
+		fs->gc_reserve = fs->gc_addr & ADDR_OFFS_MASK;
+	}
+	fs->gc_reserve += fs->gc_stop_addr - fs->gc_addr + ate_size;
+
+	fs->gc_pending = true;
+	k_work_submit(&fs->gc_work);
+
+	return 0;
+}
+
+static void nvs_gc_bg_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!fs->gc_pending) {
+		goto end;
+	}
+
+	rc = nvs_gc_bg_step(fs, CONFIG_NVS_GC_BACKGROUND_STEP);
+	if (rc) {
+		/* left to the next write to finish */
+		LOG_ERR("Background gc failed (err %d)", rc);
+		goto end;
+	}
+
+	if (fs->gc_pending) {
+		k_work_submit(&fs->gc_work);
+	}
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+}
+#endif
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+/* walk all ate's from newest to oldest and keep the first valid one that is
+ * found for every cache position.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate ate;
+	u32_t addr, ate_addr;
+	size_t i, pos;
+
+	for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+	}
+
+	addr = fs->ate_wra;
+
+	while (1) {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		pos = nvs_lookup_cache_pos(ate.id);
+		if ((fs->lookup_cache[pos] == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    (!nvs_ate_crc8_check(&ate))) {
+			fs->lookup_cache[pos] = ate_addr;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+#endif
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -545,6 +814,10 @@ static int nvs_startup(struct nvs_fs *fs)
 	 */
 	u32_t addr = 0U;
 	u16_t i, closed_sectors = 0;
+	bool gc_in_place = false;
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+	size_t move_size;
+#endif
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
@@ -650,19 +923,35 @@ static int nvs_startup(struct nvs_fs *fs)
 	}
 	if (rc) {
 		/* the sector after fs->ate_wrt is not empty */
-		rc = nvs_flash_erase_sector(fs, fs->ate_wra);
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+		/* writes may have been done next to the gc, finish the gc
+		 * in place when the write sector still has the space for it.
+		 */
+		rc = nvs_gc_move_size(fs, &move_size);
 		if (rc) {
 			goto end;
 		}
-		fs->ate_wra &= ADDR_SECT_MASK;
-		fs->ate_wra += (fs->sector_size - 2 * ate_size);
-		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+		gc_in_place = (fs->ate_wra >= fs->data_wra + move_size);
+#endif
+		if (!gc_in_place) {
+			rc = nvs_flash_erase_sector(fs, fs->ate_wra);
+			if (rc) {
+				goto end;
+			}
+			fs->ate_wra &= ADDR_SECT_MASK;
+			fs->ate_wra += (fs->sector_size - 2 * ate_size);
+			fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+		}
 		rc = nvs_gc(fs);
 		if (rc) {
 			goto end;
 		}
 	}
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	rc = nvs_lookup_cache_rebuild(fs);
+#endif
+
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -678,6 +967,12 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	fs->gc_pending = false;
+	k_mutex_unlock(&fs->nvs_lock);
+#endif
+
 	for (u16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -696,6 +991,14 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 
 	k_mutex_init(&fs->nvs_lock);
 
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+	/* the work may still be queued from a previous init */
+	if (!fs->ready) {
+		k_work_init(&fs->gc_work, nvs_gc_bg_handler);
+	}
+	fs->gc_pending = false;
+#endif
+
 	fs->flash_device = device_get_binding(dev_name);
 	if (!fs->flash_device) {
 		LOG_ERR("No valid flash device found");
@@ -773,10 +1076,14 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
-	while (1) {
+	while (wlk_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
@@ -836,6 +1143,29 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 			goto end;
 		}
 
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+		if (fs->gc_pending) {
+			/* keep the space the gc still needs and the space
+			 * for a delete ate free.
+			 */
+			if (fs->ate_wra >= fs->data_wra + data_size +
+					   ate_size + fs->gc_reserve) {
+				rc = nvs_flash_wrt_entry(fs, id, data, len);
+				if (rc) {
+					goto end;
+				}
+				break;
+			}
+
+			/* no room next to the gc, finish it now */
+			rc = nvs_gc_bg_step(fs, INT_MAX);
+			if (rc) {
+				goto end;
+			}
+			continue;
+		}
+#endif
+
 		if (fs->ate_wra >= fs->data_wra + required_space) {
 
 			rc = nvs_flash_wrt_entry(fs, id, data, len);
@@ -851,7 +1181,11 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 			goto end;
 		}
 
+#if defined(CONFIG_NVS_GC_BACKGROUND)
+		rc = nvs_gc_bg_start(fs);
+#else
 		rc = nvs_gc(fs);
+#endif
 		if (rc) {
 			goto end;
 		}
@@ -890,7 +1224,14 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		return -ENOENT;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -28,6 +28,11 @@ extern "C" {
 
 #define NVS_BLOCK_SIZE 32
 
+/*
+ * Lookup cache position without an ate
+ */
+#define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	u16_t id;	/* data id */
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <errno.h>
+#include <drivers/ipm.h>
+#include <ipc/ipc_ring.h>
+
+/* Header of the unused end of a ring, the next message is at its start */
+#define WRAP_MARKER 0xFFFFFFFF
+
+/* Any word will do, some IPM drivers only interrupt on a data write */
+#define NOTIFY_DATA 0x55005500
+
+static inline u32_t *ring_word(struct ipc_ring_shm *shm, u32_t off)
+{
+	return &shm->data[off / sizeof(u32_t)];
+}
+
+/* Offset of the message after the one of len bytes at off */
+static inline u32_t ring_next(u32_t off, size_t len, u32_t size)
+{
+	off += IPC_RING_MSG_SIZE(len);
+
+	return (off == size) ? 0 : off;
+}
+
+static void ipm_cb(void *context, u32_t id, volatile void *data)
+{
+	struct ipc_ring *ring = context;
+
+	ARG_UNUSED(id);
+	ARG_UNUSED(data);
+
+	k_sem_give(&ring->rx_sem);
+}
+
+int ipc_ring_init(struct ipc_ring *ring, struct device *ipm,
+		  void *tx_mem, size_t tx_size, void *rx_mem, size_t rx_size,
+		  ipc_ring_cb_t cb, void *user_data)
+{
+	size_t min_size = sizeof(struct ipc_ring_shm) +
+			  2 * IPC_RING_MSG_HDR_SIZE;
+
+	if (((uintptr_t)tx_mem % sizeof(u32_t)) != 0 ||
+	    ((uintptr_t)rx_mem % sizeof(u32_t)) != 0 ||
+	    tx_size < min_size || rx_size < min_size) {
+		return -EINVAL;
+	}
+
+	ring->tx = tx_mem;
+	ring->rx = rx_mem;
+	ring->tx_size = ROUND_DOWN(tx_size - sizeof(struct ipc_ring_shm),
+				   sizeof(u32_t));
+	ring->rx_size = ROUND_DOWN(rx_size - sizeof(struct ipc_ring_shm),
+				   sizeof(u32_t));
+	ring->ipm = ipm;
+	ring->cb = cb;
+	ring->user_data = user_data;
+	ring->alloc_len = 0U;
+	k_sem_init(&ring->rx_sem, 0, 1);
+
+	atomic_set(&ring->tx->head, 0);
+	atomic_set(&ring->tx->tail, 0);
+
+	ipm_register_callback(ipm, ipm_cb, ring);
+
+	return ipm_set_enabled(ipm, 1);
+}
+
+void *ipc_ring_alloc(struct ipc_ring *ring, size_t len)
+{
+	u32_t need = IPC_RING_MSG_SIZE(len);
+	u32_t head = atomic_get(&ring->tx->head);
+	u32_t tail = atomic_get(&ring->tx->tail);
+
+	__ASSERT(ring->alloc_len == 0U, "message already allocated");
+
+	/* The head never catches up with the tail, which would make the
+	 * ring look empty: at least one word is always left free.
+	 */
+	if (head >= tail) {
+		if ((ring->tx_size - head > need) ||
+		    ((ring->tx_size - head == need) && (tail != 0U))) {
+			ring->alloc_off = head;
+			ring->alloc_wrap = false;
+		} else if (tail > need) {
+			/* Message does not fit before the end of the ring */
+			ring->alloc_off = 0U;
+			ring->alloc_wrap = true;
+		} else {
+			return NULL;
+		}
+	} else if (tail - head > need) {
+		ring->alloc_off = head;
+		ring->alloc_wrap = false;
+	} else {
+		return NULL;
+	}
+
+	ring->alloc_len = len;
+
+	return ring_word(ring->tx, ring->alloc_off + IPC_RING_MSG_HDR_SIZE);
+}
+
+int ipc_ring_commit(struct ipc_ring *ring, size_t len)
+{
+	u32_t notify_data = NOTIFY_DATA;
+	u32_t head = atomic_get(&ring->tx->head);
+	int err;
+
+	__ASSERT(len <= ring->alloc_len, "message larger than allocated");
+
+	if (ring->alloc_wrap) {
+		*ring_word(ring->tx, head) = WRAP_MARKER;
+	}
+	*ring_word(ring->tx, ring->alloc_off) = len;
+	ring->alloc_len = 0U;
+
+	/* Publishing the head and then reading the tail, the reverse of what
+	 * the consumer does, means that either it sees this message before
+	 * waiting, or it had read everything and is notified here.
+	 */
+	atomic_set(&ring->tx->head,
+		   ring_next(ring->alloc_off, len, ring->tx_size));
+
+	if (atomic_get(&ring->tx->tail) != head) {
+		return 0;
+	}
+
+	/* A busy IPM channel has a notification the peer did not handle
+	 * yet, which also covers this message.
+	 */
+	err = ipm_send(ring->ipm, 0, 0, &notify_data, sizeof(notify_data));
+	if (err != 0 && err != -EBUSY) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int ipc_ring_send(struct ipc_ring *ring, const void *data, size_t len)
+{
+	void *buf = ipc_ring_alloc(ring, len);
+
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	(void)memcpy(buf, data, len);
+
+	return ipc_ring_commit(ring, len);
+}
+
+int ipc_ring_process(struct ipc_ring *ring, s32_t timeout)
+{
+	u32_t tail = atomic_get(&ring->rx->tail);
+	u32_t len;
+	int count = 0;
+
+	while (true) {
+		if (atomic_get(&ring->rx->head) == tail) {
+			if (count > 0) {
+				return count;
+			}
+
+			if (k_sem_take(&ring->rx_sem, timeout) != 0) {
+				return -EAGAIN;
+			}
+
+			continue;
+		}
+
+		len = *ring_word(ring->rx, tail);
+		if (len == WRAP_MARKER) {
+			tail = 0U;
+			len = *ring_word(ring->rx, tail);
+		}
+
+		ring->cb(ring, ring_word(ring->rx, tail + IPC_RING_MSG_HDR_SIZE),
+			 len, ring->user_data);
+
+		tail = ring_next(tail, len, ring->rx_size);
+		atomic_set(&ring->rx->tail, tail);
+		count++;
+	}
+}
@@ -26,40 +26,6 @@
 #include <random/rand32.h>
 #endif
 
-/*
- * Base-64 encoding is typically done by lookup into a 64-byte static
- * array.  As an experiment, lets look at both code size and time for
- * one that does the character encoding computationally.  Like the
- * array version, this doesn't do bounds checking, and assumes the
- * passed value has been masked.
- *
- * On Cortex-M, this function is 34 bytes of code, which is only a
- * little more than half of the size of the lookup table.
- */
-#if 1
-static int base64_char(int value)
-{
-	if (value < 26) {
-		return value + 'A';
-	} else if (value < 52) {
-		return value + 'a' - 26;
-	} else if (value < 62) {
-		return value + '0' - 52;
-	} else if (value == 62) {
-		return '-';
-	} else {
-		return '_';
-	}
-}
-#else
-static const char b64_table[] =
-	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
-static inline int base64_char(int value)
-{
-	return b64_table[value];
-}
-#endif
-
 /*
  * Add a single character to the jwt buffer.  Detects overflow, and
  * always keeps the buffer null terminated.
@@ -81,49 +47,49 @@ static void base64_outch(struct jwt_builder *st, char ch)
 }
 
 /*
- * Flush any pending base64 character data out.  If we have all three
- * bytes are present, this will generate 4 characters, otherwise it
- * may generate fewer.
+ * Flush the one or two bytes still pending in the encoder out.  This
+ * generates two or three characters, as base64url is not padded.
  */
 static void base64_flush(struct jwt_builder *st)
 {
-	if (st->pending < 1) {
+	size_t olen;
+
+	if (st->overflowed) {
 		return;
 	}
 
-	base64_outch(st, base64_char(st->wip[0] >> 2));
-	base64_outch(st, base64_char(((st->wip[0] & 0x03) << 4) |
-				(st->wip[1] >> 4)));
-
-	if (st->pending >= 2) {
-		base64_outch(st, base64_char(((st->wip[1] & 0x0f) << 2) |
-				(st->wip[2] >> 6)));
-	}
-	if (st->pending >= 3) {
-		base64_outch(st, base64_char(st->wip[2] & 0x3f));
+	/* Keep room for the null terminator */
+	if (base64_encode_finish(&st->enc, (u8_t *)st->buf,
+				 st->len - 1, &olen) != 0) {
+		st->overflowed = true;
+		return;
 	}
 
-	st->pending = 0;
-	memset(st->wip, 0, 3);
-}
-
-static void base64_addbyte(struct jwt_builder *st, uint8_t byte)
-{
-	st->wip[st->pending++] = byte;
-	if (st->pending == 3) {
-		base64_flush(st);
-	}
+	st->buf += olen;
+	st->len -= olen;
+	*st->buf = 0;
 }
 
 static int base64_append_bytes(const char *bytes, size_t len,
 			 void *data)
 {
 	struct jwt_builder *st = data;
+	size_t olen;
+
+	if (st->overflowed) {
+		return 0;
+	}
 
-	while (len-- > 0) {
-		base64_addbyte(st, *bytes++);
+	if (base64_encode_update(&st->enc, (u8_t *)st->buf, st->len - 1,
+				 &olen, (const u8_t *)bytes, len) != 0) {
+		st->overflowed = true;
+		return 0;
 	}
 
+	st->buf += olen;
+	st->len -= olen;
+	*st->buf = 0;
+
 	return 0;
 }
 
@@ -312,7 +278,7 @@ int jwt_init_builder(struct jwt_builder *builder,
 	builder->buf = buffer;
 	builder->len = buffer_size;
 	builder->overflowed = false;
-	builder->pending = 0;
+	base64_stream_init(&builder->enc, true);
 
 	jwt_add_header(builder);
 
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief Flash circular buffer (FCB) backend implementation.
+ *
+ * Messages are stored as FCB entries, one entry per message, in a flash
+ * partition labelled "log" or in the storage partition if the board has
+ * none. Entries are collected in RAM and programmed in batches from the
+ * logger thread. When the partition is full the oldest sector is erased.
+ */
+
+#include <logging/log_backend.h>
+#include <logging/log_backend_fcb.h>
+#include <logging/log_core.h>
+#include <logging/log_msg.h>
+#include <logging/log_output.h>
+#include "log_backend_std.h"
+#include <fs/fcb.h>
+#include <init.h>
+#include <string.h>
+#include <shell/shell.h>
+
+#if defined(DT_FLASH_AREA_LOG_ID)
+#define LOG_FCB_AREA_ID DT_FLASH_AREA_LOG_ID
+#else
+#define LOG_FCB_AREA_ID DT_FLASH_AREA_STORAGE_ID
+#endif
+
+#define LOG_FCB_MAGIC 0x4c4f4721
+
+#define BATCH_SIZE CONFIG_LOG_BACKEND_FCB_BATCH_SIZE
+#define BATCH_RECORDS CONFIG_LOG_BACKEND_FCB_BATCH_RECORDS
+
+static struct flash_sector log_fcb_sectors[CONFIG_LOG_BACKEND_FCB_SECTORS];
+static struct fcb log_fcb = {
+	.f_magic = LOG_FCB_MAGIC,
+	.f_version = 1,
+	.f_sectors = log_fcb_sectors,
+};
+static bool log_fcb_ready;
+
+/* Messages not programmed yet, rec_start is where the current one begins */
+static u8_t batch[BATCH_SIZE];
+static u16_t batch_len;
+static u16_t rec_len[BATCH_RECORDS];
+static u16_t rec_cnt;
+static u16_t rec_start;
+static u32_t lost_cnt;
+static bool in_panic;
+
+static u8_t buf[1];
+
+static void batch_flush(void)
+{
+	const void *data[BATCH_RECORDS];
+	u16_t off = 0U;
+	int done = 0;
+	int rc;
+	int i;
+
+	if (!rec_cnt) {
+		return;
+	}
+
+	if (!log_fcb_ready) {
+		lost_cnt += rec_cnt;
+		goto out;
+	}
+
+	for (i = 0; i < rec_cnt; i++) {
+		data[i] = &batch[off];
+		off += rec_len[i];
+	}
+
+	while (done < rec_cnt) {
+		rc = fcb_append_batch(&log_fcb, &data[done], &rec_len[done],
+				      rec_cnt - done);
+		if (rc > 0) {
+			done += rc;
+			continue;
+		}
+
+		/* Full, drop the oldest sector. */
+		if (rc != FCB_ERR_NOSPACE || fcb_rotate(&log_fcb)) {
+			lost_cnt += rec_cnt - done;
+			break;
+		}
+	}
+
+out:
+	/* Keep the message being formatted, if any */
+	off = 0U;
+	for (i = 0; i < rec_cnt; i++) {
+		off += rec_len[i];
+	}
+
+	memmove(batch, &batch[off], batch_len - off);
+	batch_len -= off;
+	rec_start -= off;
+	rec_cnt = 0U;
+}
+
+static int data_out(u8_t *data, size_t length, void *ctx)
+{
+	size_t len;
+
+	ARG_UNUSED(ctx);
+
+	if ((batch_len + length > sizeof(batch)) && rec_start) {
+		batch_flush();
+	}
+
+	/* A message longer than the batch is truncated. */
+	len = MIN(length, sizeof(batch) - batch_len);
+	memcpy(&batch[batch_len], data, len);
+	batch_len += len;
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(log_output, data_out, buf, sizeof(buf));
+
+static void record_end(void)
+{
+	if (batch_len != rec_start) {
+		rec_len[rec_cnt++] = batch_len - rec_start;
+	}
+
+	rec_start = batch_len;
+
+	if (in_panic || rec_cnt == BATCH_RECORDS ||
+	    batch_len >= sizeof(batch) - CONFIG_LOG_BACKEND_FCB_BATCH_SPARE) {
+		batch_flush();
+	}
+}
+
+static void put(const struct log_backend *const backend,
+		struct log_msg *msg)
+{
+	log_backend_std_put(&log_output, 0, msg);
+	record_end();
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	/* Nothing is buffered from now on, the system may not come back. */
+	in_panic = true;
+	log_backend_std_panic(&log_output);
+	record_end();
+	batch_flush();
+}
+
+static void dropped(const struct log_backend *const backend, u32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	log_backend_std_dropped(&log_output, cnt);
+	record_end();
+}
+
+static void log_backend_fcb_init(void)
+{
+}
+
+static int log_backend_fcb_storage_init(struct device *dev)
+{
+	const struct flash_area *fap;
+	u32_t cnt = ARRAY_SIZE(log_fcb_sectors);
+	int rc;
+
+	ARG_UNUSED(dev);
+
+	rc = flash_area_get_sectors(LOG_FCB_AREA_ID, &cnt, log_fcb_sectors);
+	if (rc != 0 && rc != -ENOMEM) {
+		return rc;
+	}
+
+	log_fcb.f_sector_cnt = cnt;
+
+	rc = fcb_init(LOG_FCB_AREA_ID, &log_fcb);
+	if (rc) {
+		rc = flash_area_open(LOG_FCB_AREA_ID, &fap);
+		if (rc) {
+			return rc;
+		}
+
+		rc = flash_area_erase(fap, 0, fap->fa_size);
+		flash_area_close(fap);
+		if (rc) {
+			return rc;
+		}
+
+		rc = fcb_init(LOG_FCB_AREA_ID, &log_fcb);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	log_fcb_ready = true;
+
+	return 0;
+}
+
+/* Flash drivers and the flash map are ready by then. */
+SYS_INIT(log_backend_fcb_storage_init, APPLICATION,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+struct fcb_walk_arg {
+	log_backend_fcb_cb_t cb;
+	void *ctx;
+};
+
+static int fcb_walk_cb(struct fcb_entry_ctx *entry_ctx, void *arg)
+{
+	static u8_t rec[BATCH_SIZE];
+	struct fcb_walk_arg *walk = arg;
+	size_t len = MIN(entry_ctx->loc.fe_data_len, sizeof(rec));
+	int rc;
+
+	rc = flash_area_read(entry_ctx->fap,
+			     FCB_ENTRY_FA_DATA_OFF(entry_ctx->loc), rec, len);
+	if (rc) {
+		return rc;
+	}
+
+	return walk->cb(rec, len, walk->ctx);
+}
+
+int log_backend_fcb_walk(log_backend_fcb_cb_t cb, void *ctx)
+{
+	struct fcb_walk_arg arg = {
+		.cb = cb,
+		.ctx = ctx,
+	};
+
+	if (!log_fcb_ready) {
+		return -ENODEV;
+	}
+
+	return fcb_walk(&log_fcb, NULL, fcb_walk_cb, &arg);
+}
+
+int log_backend_fcb_clear(void)
+{
+	if (!log_fcb_ready) {
+		return -ENODEV;
+	}
+
+	return fcb_clear(&log_fcb) ? -EIO : 0;
+}
+
+u32_t log_backend_fcb_lost_get(void)
+{
+	return lost_cnt;
+}
+
+const struct log_backend_api log_backend_fcb_api = {
+	.put = put,
+	.panic = panic,
+	.init = log_backend_fcb_init,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(log_backend_fcb, log_backend_fcb_api, true);
+
+#if defined(CONFIG_SHELL)
+static int shell_rec_print(const u8_t *data, size_t len, void *ctx)
+{
+	const struct shell *shell = ctx;
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY)) {
+		shell_hexdump(shell, data, len);
+	} else {
+		shell_fprintf(shell, SHELL_NORMAL, "%.*s", (int)len, data);
+	}
+
+	return 0;
+}
+
+static int cmd_log_fcb_dump(const struct shell *shell, size_t argc,
+			    char **argv)
+{
+	int rc;
+
+	rc = log_backend_fcb_walk(shell_rec_print, (void *)shell);
+	if (rc) {
+		shell_error(shell, "Failed to read the log (err %d)", rc);
+		return rc;
+	}
+
+	shell_print(shell, "%u messages lost", log_backend_fcb_lost_get());
+
+	return 0;
+}
+
+static int cmd_log_fcb_clear(const struct shell *shell, size_t argc,
+			     char **argv)
+{
+	int rc;
+
+	rc = log_backend_fcb_clear();
+	if (rc) {
+		shell_error(shell, "Failed to clear the log (err %d)", rc);
+	}
+
+	return rc;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_fcb,
+	SHELL_CMD(dump, NULL, "Print the messages stored in flash",
+		  cmd_log_fcb_dump),
+	SHELL_CMD(clear, NULL, "Erase the messages stored in flash",
+		  cmd_log_fcb_clear),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(log_fcb, &sub_log_fcb, "Flash log commands", NULL);
+#endif /* CONFIG_SHELL */
@@ -11,8 +11,12 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #include <logging/log_core.h>
 #include <logging/log_output.h>
 #include <logging/log_msg.h>
+#include <logging/log_ctrl.h>
 #include <net/net_pkt.h>
 #include <net/net_context.h>
+#if defined(CONFIG_LOG_BACKEND_NET_TCP)
+#include <net/socket.h>
+#endif
 
 /* Set this to 1 if you want to see what is being sent to server */
 #define DEBUG_PRINTING 0
@@ -29,6 +33,14 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #define MAX_HOSTNAME_LEN NET_IPV4_ADDR_LEN
 #endif
 
+#if defined(CONFIG_LOG_BACKEND_NET_TLS)
+#define SYSLOG_PORT 6514
+#elif defined(CONFIG_LOG_BACKEND_NET_TCP)
+#define SYSLOG_PORT 601
+#else
+#define SYSLOG_PORT 514
+#endif
+
 static char hostname[MAX_HOSTNAME_LEN + 1];
 
 static u8_t output_buf[CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE];
@@ -36,8 +48,94 @@ static bool net_init_done;
 struct sockaddr server_addr;
 static bool panic_mode;
 
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+/* Messages, each terminated by a newline, sent as one datagram or write */
+static u8_t batch_buf[CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE];
+static size_t batch_len;
+#endif
+
 const struct log_backend *log_backend_net_get(void);
 
+#if defined(CONFIG_LOG_BACKEND_NET_TCP)
+static int sock = -1;
+
+static int sock_connect(void)
+{
+	socklen_t addr_len = (server_addr.sa_family == AF_INET6) ?
+			     sizeof(struct sockaddr_in6) :
+			     sizeof(struct sockaddr_in);
+#if defined(CONFIG_LOG_BACKEND_NET_TLS)
+	sec_tag_t sec_tag = CONFIG_LOG_BACKEND_NET_TLS_SEC_TAG;
+	int proto = IPPROTO_TLS_1_2;
+#else
+	int proto = IPPROTO_TCP;
+#endif
+	int ret;
+
+	sock = zsock_socket(server_addr.sa_family, SOCK_STREAM, proto);
+	if (sock < 0) {
+		DBG("Cannot create socket (%d)\n", errno);
+		return -errno;
+	}
+
+#if defined(CONFIG_LOG_BACKEND_NET_TLS)
+	ret = zsock_setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST, &sec_tag,
+			       sizeof(sec_tag));
+	if (ret == 0 && sizeof(CONFIG_LOG_BACKEND_NET_TLS_HOSTNAME) > 1) {
+		ret = zsock_setsockopt(sock, SOL_TLS, TLS_HOSTNAME,
+				CONFIG_LOG_BACKEND_NET_TLS_HOSTNAME,
+				sizeof(CONFIG_LOG_BACKEND_NET_TLS_HOSTNAME));
+	}
+
+	if (ret < 0) {
+		DBG("Cannot setup TLS (%d)\n", errno);
+		goto fail;
+	}
+#endif
+
+	ret = zsock_connect(sock, &server_addr, addr_len);
+	if (ret < 0) {
+		DBG("Cannot connect (%d)\n", errno);
+		goto fail;
+	}
+
+	return 0;
+
+fail:
+	ret = -errno;
+	zsock_close(sock);
+	sock = -1;
+
+	return ret;
+}
+
+/* The connection is opened again on the next send after an error. */
+static int data_send(void *output_ctx, const u8_t *data, size_t length)
+{
+	ssize_t ret;
+
+	ARG_UNUSED(output_ctx);
+
+	if (sock < 0 && sock_connect() < 0) {
+		return -ENOTCONN;
+	}
+
+	while (length) {
+		ret = zsock_send(sock, data, length, 0);
+		if (ret < 0) {
+			DBG("Cannot send (%d)\n", errno);
+			zsock_close(sock);
+			sock = -1;
+			return -EIO;
+		}
+
+		data += ret;
+		length -= ret;
+	}
+
+	return 0;
+}
+#else
 NET_PKT_SLAB_DEFINE(syslog_tx_pkts, CONFIG_LOG_BACKEND_NET_MAX_BUF);
 NET_PKT_DATA_POOL_DEFINE(syslog_tx_bufs,
 			 ROUND_UP(CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE /
@@ -54,27 +152,69 @@ struct net_buf_pool *get_data_pool(void)
 	return &syslog_tx_bufs;
 }
 
-static int line_out(u8_t *data, size_t length, void *output_ctx)
+static int data_send(void *output_ctx, const u8_t *data, size_t length)
 {
 	struct net_context *ctx = (struct net_context *)output_ctx;
-	int ret = -ENOMEM;
 
 	if (ctx == NULL) {
-		return length;
+		return -ENOTCONN;
 	}
 
-	ret = net_context_send(ctx, data, length, NULL, K_NO_WAIT, NULL);
-	if (ret < 0) {
-		goto fail;
+	return net_context_send(ctx, data, length, NULL, K_NO_WAIT, NULL);
+}
+#endif /* CONFIG_LOG_BACKEND_NET_TCP */
+
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+static void batch_send(void *output_ctx)
+{
+	if (batch_len) {
+		(void)data_send(output_ctx, batch_buf, batch_len);
+		batch_len = 0;
+	}
+}
+#endif
+
+static int line_out(u8_t *data, size_t length, void *output_ctx)
+{
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	/* A message not fitting in the batch any more starts a new one, the
+	 * output buffer always fits.
+	 */
+	if (batch_len + length > sizeof(batch_buf)) {
+		batch_send(output_ctx);
 	}
 
+	memcpy(&batch_buf[batch_len], data, length);
+	batch_len += length;
+#else
+	(void)data_send(output_ctx, data, length);
+#endif
+
 	DBG(data);
-fail:
+
 	return length;
 }
 
 LOG_OUTPUT_DEFINE(log_output, line_out, output_buf, sizeof(output_buf));
 
+#if defined(CONFIG_LOG_BACKEND_NET_TCP)
+static int do_net_init(void)
+{
+	int ret;
+
+	ret = sock_connect();
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_HOSTNAME_ENABLE)) {
+		(void)memcpy(hostname, net_hostname_get(), MAX_HOSTNAME_LEN);
+		log_output_hostname_set(&log_output, hostname);
+	}
+
+	return 0;
+}
+#else
 static int do_net_init(void)
 {
 	struct sockaddr *local_addr = NULL;
@@ -169,6 +309,7 @@ static int do_net_init(void)
 
 	return 0;
 }
+#endif /* CONFIG_LOG_BACKEND_NET_TCP */
 
 static void send_output(const struct log_backend *const backend,
 			struct log_msg *msg)
@@ -188,13 +329,20 @@ static void send_output(const struct log_backend *const backend,
 			       LOG_OUTPUT_FLAG_TIMESTAMP);
 
 	log_msg_put(msg);
+
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	/* Send once the burst of pending messages has been formatted. */
+	if (log_buffered_cnt() == 0) {
+		batch_send(log_output.control_block->ctx);
+	}
+#endif
 }
 
 static void init_net(void)
 {
 	int ret;
 
-	net_sin(&server_addr)->sin_port = htons(514);
+	net_sin(&server_addr)->sin_port = htons(SYSLOG_PORT);
 
 	ret = net_ipaddr_parse(CONFIG_LOG_BACKEND_NET_SERVER,
 			       sizeof(CONFIG_LOG_BACKEND_NET_SERVER) - 1,
@@ -209,6 +357,11 @@ static void init_net(void)
 
 static void panic(struct log_backend const *const backend)
 {
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH) && \
+	!defined(CONFIG_LOG_BACKEND_NET_TCP)
+	/* Datagrams are sent without blocking, a stream write may not be. */
+	batch_send(log_output.control_block->ctx);
+#endif
 	panic_mode = true;
 }
 
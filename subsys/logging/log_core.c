@@ -199,11 +199,15 @@ static inline void msg_finalize(struct log_msg *msg,
 
 	atomic_inc(&buffered_cnt);
 
+#if defined(CONFIG_LOG_LOCKLESS_LIST)
+	log_list_add_tail(&list, msg);
+#else
 	key = irq_lock();
 
 	log_list_add_tail(&list, msg);
 
 	irq_unlock(key);
+#endif
 
 	if (panic_mode) {
 		key = irq_lock();
@@ -597,10 +601,27 @@ void z_impl_log_panic(void)
 Z_SYSCALL_HANDLER0_SIMPLE_VOID(log_panic);
 #endif
 
+/* Mask of backends which accept the message, all of them unless the masks
+ * are precomputed.
+ */
+static u32_t msg_backends_get(struct log_msg *msg)
+{
+#if defined(CONFIG_LOG_RUNTIME_FILTER_MASKS)
+	u32_t level = log_msg_level_get(msg);
+
+	if (level != LOG_LEVEL_INTERNAL_RAW_STRING) {
+		return __log_dynamic_start[log_msg_source_id_get(msg)]
+				.backend_masks[level - 1];
+	}
+#endif
+	return UINT32_MAX;
+}
+
 static bool msg_filter_check(struct log_backend const *backend,
 			     struct log_msg *msg)
 {
-	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING)) {
+	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) &&
+	    !IS_ENABLED(CONFIG_LOG_RUNTIME_FILTER_MASKS)) {
 		u32_t backend_level;
 		u32_t msg_level;
 
@@ -619,6 +640,7 @@ static bool msg_filter_check(struct log_backend const *backend,
 static void msg_process(struct log_msg *msg, bool bypass)
 {
 	struct log_backend const *backend;
+	u32_t backends;
 
 	if (!bypass) {
 		if (IS_ENABLED(CONFIG_LOG_DETECT_MISSED_STRDUP) &&
@@ -626,10 +648,13 @@ static void msg_process(struct log_msg *msg, bool bypass)
 			detect_missed_strdup(msg);
 		}
 
+		backends = msg_backends_get(msg);
+
 		for (int i = 0; i < log_backend_count_get(); i++) {
 			backend = log_backend_get(i);
 
-			if (log_backend_is_active(backend) &&
+			if ((backends & BIT(i)) &&
+			    log_backend_is_active(backend) &&
 			    msg_filter_check(backend, msg)) {
 				log_backend_put(backend, msg);
 			}
@@ -673,7 +698,10 @@ bool z_impl_log_process(bool bypass)
 		dropped_notify();
 	}
 
-	return (log_list_head_peek(&list) != NULL);
+	/* No progress while a message is still being added, the callers
+	 * looping on the result must not spin on it.
+	 */
+	return (msg != NULL) && (log_list_head_peek(&list) != NULL);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -724,6 +752,29 @@ static u32_t max_filter_get(u32_t filters)
 	return max_filter;
 }
 
+#if defined(CONFIG_LOG_RUNTIME_FILTER_MASKS)
+static void backend_masks_update(u32_t src_id)
+{
+	struct log_source_dynamic_data *data = &__log_dynamic_start[src_id];
+	u32_t level;
+	u16_t mask;
+	int i;
+
+	for (level = LOG_LEVEL_ERR; level <= LOG_LEVEL_DBG; level++) {
+		mask = 0U;
+
+		for (i = 0; i < log_backend_count_get(); i++) {
+			if (LOG_FILTER_SLOT_GET(&data->filters,
+				LOG_FILTER_FIRST_BACKEND_SLOT_IDX + i) >= level) {
+				mask |= BIT(i);
+			}
+		}
+
+		data->backend_masks[level - 1] = mask;
+	}
+}
+#endif
+
 u32_t z_impl_log_filter_set(struct log_backend const *const backend,
 			    u32_t domain_id,
 			    u32_t src_id,
@@ -767,6 +818,9 @@ u32_t z_impl_log_filter_set(struct log_backend const *const backend,
 			LOG_FILTER_SLOT_SET(filters,
 					    LOG_FILTER_AGGR_SLOT_IDX,
 					    new_aggr_filter);
+#if defined(CONFIG_LOG_RUNTIME_FILTER_MASKS)
+			backend_masks_update(src_id);
+#endif
 		}
 	}
 
@@ -6,6 +6,90 @@
 
 #include "log_list.h"
 
+#if defined(CONFIG_LOG_LOCKLESS_LIST)
+/*
+ * Intrusive multi-producer, single-consumer queue. Producers only swap
+ * the tail pointer and link the previous tail to the new item. The
+ * consumer keeps a stub item in the list so that it is never empty.
+ */
+void log_list_init(struct log_list_t *list)
+{
+	list->stub.next = NULL;
+	list->head = &list->stub;
+	list->tail = &list->stub;
+}
+
+void log_list_add_tail(struct log_list_t *list, struct log_msg *msg)
+{
+	struct log_msg *prev;
+
+	msg->next = NULL;
+	prev = __atomic_exchange_n(&list->tail, msg, __ATOMIC_ACQ_REL);
+
+	/* until then the consumer sees the list ending at prev */
+	__atomic_store_n(&prev->next, msg, __ATOMIC_RELEASE);
+}
+
+/* Returns the head item only if log_list_head_get() can take it out: not
+ * while a producer is still linking the item behind it, which an
+ * interrupt of that producer could otherwise wait for forever.
+ */
+struct log_msg *log_list_head_peek(struct log_list_t *list)
+{
+	struct log_msg *msg = list->head;
+
+	if (msg == &list->stub) {
+		msg = __atomic_load_n(&msg->next, __ATOMIC_ACQUIRE);
+		if (msg == NULL) {
+			return NULL;
+		}
+	}
+
+	if ((__atomic_load_n(&msg->next, __ATOMIC_ACQUIRE) == NULL) &&
+	    (msg != __atomic_load_n(&list->tail, __ATOMIC_ACQUIRE))) {
+		return NULL;
+	}
+
+	return msg;
+}
+
+struct log_msg *log_list_head_get(struct log_list_t *list)
+{
+	struct log_msg *msg = list->head;
+	struct log_msg *next = __atomic_load_n(&msg->next, __ATOMIC_ACQUIRE);
+
+	if (msg == &list->stub) {
+		if (next == NULL) {
+			return NULL;
+		}
+
+		list->head = next;
+		msg = next;
+		next = __atomic_load_n(&msg->next, __ATOMIC_ACQUIRE);
+	}
+
+	if (next != NULL) {
+		list->head = next;
+		return msg;
+	}
+
+	/* a producer is linking a new item behind msg */
+	if (msg != __atomic_load_n(&list->tail, __ATOMIC_ACQUIRE)) {
+		return NULL;
+	}
+
+	/* msg is the last item, put the stub behind it to take it out */
+	log_list_add_tail(list, &list->stub);
+
+	next = __atomic_load_n(&msg->next, __ATOMIC_ACQUIRE);
+	if (next != NULL) {
+		list->head = next;
+		return msg;
+	}
+
+	return NULL;
+}
+#else
 void log_list_init(struct log_list_t *list)
 {
 	list->tail = NULL;
@@ -39,3 +123,4 @@ struct log_msg *log_list_head_get(struct log_list_t *list)
 
 	return msg;
 }
+#endif /* CONFIG_LOG_LOCKLESS_LIST */
@@ -16,6 +16,9 @@ extern "C" {
 struct log_list_t {
 	struct log_msg *head;
 	struct log_msg *tail;
+#if defined(CONFIG_LOG_LOCKLESS_LIST)
+	struct log_msg stub;
+#endif
 };
 
 /** @brief Initialize log list instance.
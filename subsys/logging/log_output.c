@@ -12,6 +12,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -19,6 +20,16 @@
 
 #define HEXDUMP_BYTES_IN_LINE 8
 
+/* Dictionary frames, decoded by scripts/logging/dictionary/log_parser.py.
+ * Multi-byte fields are in target byte order, pointers and arguments are
+ * native words.
+ */
+#define LOG_DICT_SYNC		0xA5
+#define LOG_DICT_STD		0
+#define LOG_DICT_HEXDUMP	1
+#define LOG_DICT_RAW		2
+#define LOG_DICT_DROPPED	3
+
 #define  DROPPED_COLOR_PREFIX \
 	Z_LOG_EVAL(CONFIG_LOG_BACKEND_SHOW_COLOR, (LOG_COLOR_CODE_RED), ())
 
@@ -494,10 +505,121 @@ static void postfix_print(const struct log_output *log_output,
 	newline_print(log_output, flags);
 }
 
+#if defined(CONFIG_LOG_DICTIONARY)
+static void dict_write(const struct log_output *log_output,
+		       const void *data, size_t len)
+{
+	const u8_t *d = data;
+
+	while (len--) {
+		(void)out_func(*d++, (void *)log_output);
+	}
+}
+
+static void dict_hdr_write(const struct log_output *log_output, u8_t type)
+{
+	u8_t hdr[2] = { LOG_DICT_SYNC, type };
+
+	dict_write(log_output, hdr, sizeof(hdr));
+}
+
+static void dict_data_write(const struct log_output *log_output,
+			    struct log_msg *msg)
+{
+	u8_t buf[HEXDUMP_BYTES_IN_LINE];
+	u16_t total = msg->hdr.params.hexdump.length;
+	size_t offset = 0;
+	size_t length;
+
+	dict_write(log_output, &total, sizeof(total));
+
+	do {
+		length = sizeof(buf);
+		log_msg_hexdump_data_get(msg, buf, &length, offset);
+		dict_write(log_output, buf, length);
+		offset += length;
+	} while (length);
+}
+
+/* Strings from the log_strdup() pool are not in the ELF, they are sent
+ * inline after a mask of the arguments they belong to.
+ */
+static void dict_std_write(const struct log_output *log_output,
+			   struct log_msg *msg)
+{
+	const char *str = log_msg_str_get(msg);
+	u8_t nargs = (u8_t)log_msg_nargs_get(msg);
+	u16_t strdup_mask = 0U;
+	log_arg_t arg;
+	int i;
+
+	dict_write(log_output, &nargs, sizeof(nargs));
+	dict_write(log_output, &str, sizeof(str));
+
+	for (i = 0; i < nargs; i++) {
+		arg = log_msg_arg_get(msg, i);
+		dict_write(log_output, &arg, sizeof(arg));
+
+		if (log_is_strdup((const void *)arg)) {
+			strdup_mask |= BIT(i);
+		}
+	}
+
+	dict_write(log_output, &strdup_mask, sizeof(strdup_mask));
+
+	for (i = 0; i < nargs; i++) {
+		if (strdup_mask & BIT(i)) {
+			str = (const char *)log_msg_arg_get(msg, i);
+			dict_write(log_output, str, strlen(str) + 1);
+		}
+	}
+}
+
+static void dict_msg_process(const struct log_output *log_output,
+			     struct log_msg *msg)
+{
+	u8_t level = (u8_t)log_msg_level_get(msg);
+	u32_t timestamp = log_msg_timestamp_get(msg);
+	const char *str;
+	u16_t ids;
+
+	if (level == LOG_LEVEL_INTERNAL_RAW_STRING) {
+		dict_hdr_write(log_output, LOG_DICT_RAW);
+		dict_data_write(log_output, msg);
+		log_output_flush(log_output);
+		return;
+	}
+
+	ids = (level << 13) | (log_msg_domain_id_get(msg) << 10) |
+	      log_msg_source_id_get(msg);
+
+	dict_hdr_write(log_output, log_msg_is_std(msg) ?
+		       LOG_DICT_STD : LOG_DICT_HEXDUMP);
+	dict_write(log_output, &ids, sizeof(ids));
+	dict_write(log_output, &timestamp, sizeof(timestamp));
+
+	if (log_msg_is_std(msg)) {
+		dict_std_write(log_output, msg);
+	} else {
+		str = log_msg_str_get(msg);
+		dict_write(log_output, &str, sizeof(str));
+		dict_data_write(log_output, msg);
+	}
+
+	log_output_flush(log_output);
+}
+#endif /* CONFIG_LOG_DICTIONARY */
+
 void log_output_msg_process(const struct log_output *log_output,
 			    struct log_msg *msg,
 			    u32_t flags)
 {
+#if defined(CONFIG_LOG_DICTIONARY)
+	ARG_UNUSED(flags);
+
+	dict_msg_process(log_output, msg);
+	return;
+#endif
 	bool std_msg = log_msg_is_std(msg);
 	u32_t timestamp = log_msg_timestamp_get(msg);
 	u8_t level = (u8_t)log_msg_level_get(msg);
@@ -506,6 +628,11 @@ void log_output_msg_process(const struct log_output *log_output,
 	bool raw_string = (level == LOG_LEVEL_INTERNAL_RAW_STRING);
 	int prefix_offset;
 
+	/* Raw strings are copied to the start of the buffer */
+	if (raw_string && log_output->control_block->offset) {
+		log_output_flush(log_output);
+	}
+
 	prefix_offset = raw_string ?
 			0 : prefix_print(log_output, flags, std_msg, timestamp,
 					 level, domain_id, source_id);
@@ -522,7 +649,9 @@ void log_output_msg_process(const struct log_output *log_output,
 		postfix_print(log_output, flags, level);
 	}
 
-	log_output_flush(log_output);
+	if (!(flags & LOG_OUTPUT_FLAG_NO_FLUSH)) {
+		log_output_flush(log_output);
+	}
 }
 
 static bool ends_with_newline(const char *fmt)
@@ -614,6 +743,14 @@ void log_output_dropped_process(const struct log_output *log_output, u32_t cnt)
 	log_output_func_t outf = log_output->func;
 	struct device *dev = (struct device *)log_output->control_block->ctx;
 
+#if defined(CONFIG_LOG_DICTIONARY)
+	u8_t frame[2 + sizeof(cnt)] = { LOG_DICT_SYNC, LOG_DICT_DROPPED };
+
+	memcpy(&frame[2], &cnt, sizeof(cnt));
+	buffer_write(outf, frame, sizeof(frame), dev);
+	return;
+#endif
+
 	cnt = MIN(cnt, 9999);
 	len = snprintf(buf, sizeof(buf), "%d", cnt);
 
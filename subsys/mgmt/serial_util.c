@@ -10,11 +10,15 @@
 #include <errno.h>
 #include <sys/crc.h>
 #include <sys/byteorder.h>
+#include <sys/util.h>
 #include <net/buf.h>
 #include <sys/base64.h>
 #include <mgmt/buf.h>
 #include <mgmt/serial.h>
 
+/* Groups of three payload bytes encoded per transmit callback */
+#define MCUMGR_SERIAL_TX_GROUPS 16
+
 static void mcumgr_serial_free_rx_ctxt(struct mcumgr_serial_rx_ctxt *rx_ctxt)
 {
 	if (rx_ctxt->nb != NULL) {
@@ -194,8 +198,11 @@ int mcumgr_serial_tx_frame(const u8_t *data, bool first, int len,
 			   u16_t crc, mcumgr_serial_tx_cb cb, void *arg,
 			   int *out_data_bytes_txed)
 {
+	u8_t b64[MCUMGR_SERIAL_TX_GROUPS * 4 + 1];
+	size_t b64_len;
 	u8_t raw[3];
 	u16_t u16;
+	int groups;
 	int dst_off;
 	int src_off;
 	int rem;
@@ -283,14 +290,23 @@ int mcumgr_serial_tx_frame(const u8_t *data, bool first, int len,
 			break;
 		}
 
-		/* Otherwise, just encode payload data. */
-		memcpy(raw, data + src_off, 3);
-		rc = mcumgr_serial_tx_small(raw, 3, cb, arg);
+		/* Otherwise, just encode payload data, as many groups of three
+		 * bytes at a time as fit in the frame.
+		 */
+		groups = (MCUMGR_SERIAL_MAX_FRAME - 5 - dst_off) / 4 + 1;
+		groups = MIN(groups, rem / 3);
+		groups = MIN(groups, MCUMGR_SERIAL_TX_GROUPS);
+
+		rc = base64_encode(b64, sizeof(b64), &b64_len,
+				   data + src_off, groups * 3);
+		assert(rc == 0);
+
+		rc = cb(b64, b64_len, arg);
 		if (rc != 0) {
 			return rc;
 		}
-		src_off += 3;
-		dst_off += 4;
+		src_off += groups * 3;
+		dst_off += groups * 4;
 	}
 
 	rc = cb("\n", 1, arg);
@@ -5,6 +5,7 @@
  */
 
 #include <zephyr.h>
+#include <init.h>
 #include "net/buf.h"
 #include "mgmt/mgmt.h"
 #include "mgmt/buf.h"
@@ -20,6 +21,15 @@ static mgmt_init_writer_fn zephyr_smp_init_writer;
 static mgmt_free_buf_fn zephyr_smp_free_buf;
 static smp_tx_rsp_fn zephyr_smp_tx_rsp;
 
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+/* Requests are processed here, so the slow ones (e.g. image uploads
+ * writing to flash) don't hold up the system work queue.
+ */
+static K_THREAD_STACK_DEFINE(smp_work_q_stack,
+			     CONFIG_MCUMGR_SMP_WORKQUEUE_STACK_SIZE);
+static struct k_work_q smp_work_q;
+#endif
+
 static const struct mgmt_streamer_cfg zephyr_smp_cbor_cfg = {
 	.alloc_rsp = zephyr_smp_alloc_rsp,
 	.trim_front = zephyr_smp_trim_front,
@@ -300,5 +310,25 @@ void
 zephyr_smp_rx_req(struct zephyr_smp_transport *zst, struct net_buf *nb)
 {
 	k_fifo_put(&zst->zst_fifo, nb);
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+	k_work_submit_to_queue(&smp_work_q, &zst->zst_work);
+#else
 	k_work_submit(&zst->zst_work);
+#endif
+}
+
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+static int
+zephyr_smp_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&smp_work_q, smp_work_q_stack,
+		       K_THREAD_STACK_SIZEOF(smp_work_q_stack),
+		       CONFIG_MCUMGR_SMP_WORKQUEUE_THREAD_PRIO);
+
+	return 0;
 }
+
+SYS_INIT(zephyr_smp_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
@@ -21,14 +21,36 @@
 
 #include <mgmt/smp.h>
 
+#include <sys/byteorder.h>
+
 struct device;
 
 struct smp_bt_user_data {
 	struct bt_conn *conn;
 };
 
+/* Size of the SMP header, and offset of its big-endian length field */
+#define SMP_BT_HDR_SIZE 8
+#define SMP_BT_HDR_LEN_OFFS 2
+
 static struct zephyr_smp_transport smp_bt_transport;
 
+/* Request being reassembled from several writes; only accessed from
+ * the Bluetooth RX thread.
+ */
+static struct net_buf *smp_bt_rx_nb;
+
+static void smp_bt_ud_free(void *ud);
+
+static void smp_bt_rx_drop(void)
+{
+	if (smp_bt_rx_nb) {
+		smp_bt_ud_free(net_buf_user_data(smp_bt_rx_nb));
+		mcumgr_buf_free(smp_bt_rx_nb);
+		smp_bt_rx_nb = NULL;
+	}
+}
+
 /* SMP service.
  * {8D53DC1D-1DB7-4CD3-868B-8A527460AA84}
  */
@@ -45,6 +67,10 @@ static struct bt_uuid_128 smp_bt_chr_uuid = BT_UUID_INIT_128(
 
 /**
  * Write handler for the SMP characteristic; processes an incoming SMP request.
+ *
+ * A request larger than the ATT MTU arrives in several writes, which are
+ * appended until the length in the SMP header is reached.  This lets
+ * the client use chunks up to the mcumgr buffer size instead of the MTU.
  */
 static ssize_t smp_bt_chr_write(struct bt_conn *conn,
 				const struct bt_gatt_attr *attr,
@@ -53,13 +79,52 @@ static ssize_t smp_bt_chr_write(struct bt_conn *conn,
 {
 	struct smp_bt_user_data *ud;
 	struct net_buf *nb;
+	size_t req_len;
+
+	nb = smp_bt_rx_nb;
+	if (nb) {
+		ud = net_buf_user_data(nb);
+		if (ud->conn != conn) {
+			/* The other peer won't complete its request */
+			smp_bt_rx_drop();
+			nb = NULL;
+		}
+	}
+
+	if (!nb) {
+		nb = mcumgr_buf_alloc();
+		if (!nb) {
+			return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+		}
+
+		ud = net_buf_user_data(nb);
+		ud->conn = bt_conn_ref(conn);
+		smp_bt_rx_nb = nb;
+	}
+
+	if (len > net_buf_tailroom(nb)) {
+		smp_bt_rx_drop();
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+	}
 
-	nb = mcumgr_buf_alloc();
 	net_buf_add_mem(nb, buf, len);
 
-	ud = net_buf_user_data(nb);
-	ud->conn = bt_conn_ref(conn);
+	if (nb->len < SMP_BT_HDR_SIZE) {
+		return len;
+	}
+
+	req_len = SMP_BT_HDR_SIZE +
+		  sys_get_be16(&nb->data[SMP_BT_HDR_LEN_OFFS]);
+	if (req_len > nb->size) {
+		smp_bt_rx_drop();
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+	}
+
+	if (nb->len < req_len) {
+		return len;
+	}
 
+	smp_bt_rx_nb = NULL;
 	zephyr_smp_rx_req(&smp_bt_transport, nb);
 
 	return len;
@@ -170,8 +235,32 @@ static int smp_bt_tx_pkt(struct zephyr_smp_transport *zst, struct net_buf *nb)
 	return rc;
 }
 
+static void smp_bt_disconnected(struct bt_conn *conn, u8_t reason)
+{
+	struct smp_bt_user_data *ud;
+
+	if (smp_bt_rx_nb) {
+		ud = net_buf_user_data(smp_bt_rx_nb);
+		if (ud->conn == conn) {
+			smp_bt_rx_drop();
+		}
+	}
+}
+
+static struct bt_conn_cb smp_bt_conn_cb = {
+	.disconnected = smp_bt_disconnected,
+};
+
 int smp_bt_register(void)
 {
+	static bool conn_cb_registered;
+
+	/* Callbacks can't be unregistered, so only do it once */
+	if (!conn_cb_registered) {
+		bt_conn_cb_register(&smp_bt_conn_cb);
+		conn_cb_registered = true;
+	}
+
 	return bt_gatt_service_register(&smp_bt_svc);
 }
 
@@ -160,6 +160,107 @@ const struct net_buf_data_cb net_buf_fixed_cb = {
 	.unref = fixed_data_unref,
 };
 
+static u8_t *slab_data_alloc(struct net_buf *buf, size_t *size, s32_t timeout)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	const struct net_buf_pool_slab *slab = pool->alloc->alloc_data;
+	const struct net_buf_slab_class *class;
+	u8_t *block = NULL;
+	atomic_val_t used;
+	int fit, i;
+
+	/* Smallest class the data fits in, or the largest one */
+	for (fit = 0; fit < slab->class_count - 1; fit++) {
+		if (slab->classes[fit].data_size >= *size) {
+			break;
+		}
+	}
+
+	for (i = fit; i < slab->class_count; i++) {
+		if (!k_mem_slab_alloc(slab->classes[i].slab, (void **)&block,
+				      K_NO_WAIT)) {
+			break;
+		}
+	}
+
+	if (i == slab->class_count) {
+		i = fit;
+
+		if (timeout == K_NO_WAIT ||
+		    k_mem_slab_alloc(slab->classes[i].slab, (void **)&block,
+				     timeout)) {
+			return NULL;
+		}
+	}
+
+	class = &slab->classes[i];
+
+	atomic_inc(&class->usage->allocs);
+	if (i != fit) {
+		atomic_inc(&class->usage->fallbacks);
+	}
+
+	used = k_mem_slab_num_used_get(class->slab);
+	if (used > atomic_get(&class->usage->max_used)) {
+		atomic_set(&class->usage->max_used, used);
+	}
+
+	*size = MIN(class->data_size, *size);
+
+	block[0] = i;
+	block[NET_BUF_SLAB_HDR_SIZE - 1] = 1U;
+
+	return block + NET_BUF_SLAB_HDR_SIZE;
+}
+
+static void slab_data_unref(struct net_buf *buf, u8_t *data)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	const struct net_buf_pool_slab *slab = pool->alloc->alloc_data;
+	u8_t *block = data - NET_BUF_SLAB_HDR_SIZE;
+	u8_t *ref_count;
+
+	ref_count = data - 1;
+	if (--(*ref_count)) {
+		return;
+	}
+
+	k_mem_slab_free(slab->classes[block[0]].slab, (void **)&block);
+}
+
+const struct net_buf_data_cb net_buf_slab_cb = {
+	.alloc = slab_data_alloc,
+	.ref   = generic_data_ref,
+	.unref = slab_data_unref,
+};
+
+int net_buf_pool_slab_stats(struct net_buf_pool *pool, int idx,
+			    struct net_buf_slab_stats *stats)
+{
+	const struct net_buf_pool_slab *slab;
+	const struct net_buf_slab_class *class;
+
+	if (pool->alloc->cb != &net_buf_slab_cb) {
+		return -EINVAL;
+	}
+
+	slab = pool->alloc->alloc_data;
+	if (idx < 0 || idx >= slab->class_count) {
+		return -EINVAL;
+	}
+
+	class = &slab->classes[idx];
+
+	stats->data_size = class->data_size;
+	stats->count = class->slab->num_blocks;
+	stats->used = k_mem_slab_num_used_get(class->slab);
+	stats->max_used = atomic_get(&class->usage->max_used);
+	stats->allocs = atomic_get(&class->usage->allocs);
+	stats->fallbacks = atomic_get(&class->usage->fallbacks);
+
+	return 0;
+}
+
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 
 static u8_t *heap_data_alloc(struct net_buf *buf, size_t *size, s32_t timeout)
@@ -351,6 +452,13 @@ struct net_buf *net_buf_alloc_fixed_debug(struct net_buf_pool *pool,
 {
 	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
 
+	/* Their alloc_data is not a struct net_buf_pool_fixed */
+	if (pool->alloc->cb == &net_buf_slab_cb) {
+		NET_BUF_ERR("%s():%d: Slab pools need net_buf_alloc_len()",
+			    func, line);
+		return NULL;
+	}
+
 	return net_buf_alloc_len_debug(pool, fixed->data_size, timeout, func,
 				       line);
 }
@@ -359,6 +467,11 @@ struct net_buf *net_buf_alloc_fixed(struct net_buf_pool *pool, s32_t timeout)
 {
 	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
 
+	/* Their alloc_data is not a struct net_buf_pool_fixed */
+	if (pool->alloc->cb == &net_buf_slab_cb) {
+		return NULL;
+	}
+
 	return net_buf_alloc_len(pool, fixed->data_size, timeout);
 }
 #endif
@@ -155,6 +155,142 @@ static inline bool net_6lo_maddr_48_bit_compressible(struct in6_addr *addr)
 		 (addr->s6_addr[10] == 0x00));
 }
 
+#if defined(CONFIG_NET_6LO_HDR_CACHE)
+/* Everything the compressed header of a packet depends on. Kept zeroed
+ * apart from the fields so that it can be compared with memcmp().
+ */
+struct hdr_cache_key {
+	struct net_if *iface;
+	struct in6_addr src;
+	struct in6_addr dst;
+	u8_t tfl[4];
+	u16_t src_port;
+	u16_t dst_port;
+	u8_t nexthdr;
+	u8_t hop_limit;
+	u8_t ll_src_len;
+	u8_t ll_dst_len;
+	u8_t ll_src[8];
+	u8_t ll_dst[8];
+};
+
+struct hdr_cache_entry {
+	struct hdr_cache_key key;
+	u8_t hdr[NET_IPV6UDPH_LEN];
+	u8_t len;
+};
+
+static struct hdr_cache_entry hdr_cache[CONFIG_NET_6LO_HDR_CACHE_COUNT];
+static u8_t hdr_cache_next;
+
+static void hdr_cache_flush(void)
+{
+	unsigned int key = irq_lock();
+
+	(void)memset(hdr_cache, 0, sizeof(hdr_cache));
+
+	irq_unlock(key);
+}
+
+static bool hdr_cache_key_init(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+			       struct hdr_cache_key *key)
+{
+	struct net_linkaddr *ll_src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *ll_dst = net_pkt_lladdr_dst(pkt);
+
+	if (ll_src->len > sizeof(key->ll_src) ||
+	    ll_dst->len > sizeof(key->ll_dst)) {
+		return false;
+	}
+
+	(void)memset(key, 0, sizeof(*key));
+
+	key->iface = net_pkt_iface(pkt);
+	net_ipaddr_copy(&key->src, &ipv6->src);
+	net_ipaddr_copy(&key->dst, &ipv6->dst);
+	memcpy(key->tfl, ipv6, sizeof(key->tfl));
+	key->nexthdr = ipv6->nexthdr;
+	key->hop_limit = ipv6->hop_limit;
+
+	if (ipv6->nexthdr == IPPROTO_UDP) {
+		struct net_udp_hdr *udp = (struct net_udp_hdr *)
+			(pkt->buffer->data + NET_IPV6H_LEN);
+
+		key->src_port = UNALIGNED_GET(&udp->src_port);
+		key->dst_port = UNALIGNED_GET(&udp->dst_port);
+	}
+
+	if (ll_src->addr) {
+		key->ll_src_len = ll_src->len;
+		memcpy(key->ll_src, ll_src->addr, ll_src->len);
+	}
+
+	if (ll_dst->addr) {
+		key->ll_dst_len = ll_dst->len;
+		memcpy(key->ll_dst, ll_dst->addr, ll_dst->len);
+	}
+
+	return true;
+}
+
+/* Write the cached compressed header in front of the payload, returns
+ * the number of bytes saved or -ENOENT if the flow is not cached.
+ */
+static int hdr_cache_apply(struct net_pkt *pkt,
+			   const struct hdr_cache_key *key, u8_t *hdr_end)
+{
+	int ret = -ENOENT;
+	unsigned int irq_key;
+	u16_t chksum = 0U;
+	int i;
+
+	if (key->nexthdr == IPPROTO_UDP) {
+		memcpy(&chksum, hdr_end - sizeof(chksum), sizeof(chksum));
+	}
+
+	irq_key = irq_lock();
+
+	for (i = 0; i < CONFIG_NET_6LO_HDR_CACHE_COUNT; i++) {
+		struct hdr_cache_entry *entry = &hdr_cache[i];
+
+		if (!entry->len || memcmp(&entry->key, key, sizeof(*key))) {
+			continue;
+		}
+
+		memcpy(hdr_end - entry->len, entry->hdr, entry->len);
+		ret = hdr_end - entry->len - pkt->buffer->data;
+		break;
+	}
+
+	irq_unlock(irq_key);
+
+	/* The UDP checksum is always inlined and ends the header */
+	if (ret >= 0 && key->nexthdr == IPPROTO_UDP) {
+		memcpy(hdr_end - sizeof(chksum), &chksum, sizeof(chksum));
+	}
+
+	return ret;
+}
+
+static void hdr_cache_store(const struct hdr_cache_key *key,
+			    const u8_t *hdr, u8_t len)
+{
+	struct hdr_cache_entry *entry;
+	unsigned int irq_key;
+
+	irq_key = irq_lock();
+
+	entry = &hdr_cache[hdr_cache_next];
+	hdr_cache_next = (hdr_cache_next + 1) % CONFIG_NET_6LO_HDR_CACHE_COUNT;
+
+	memcpy(&entry->key, key, sizeof(*key));
+	memcpy(entry->hdr, hdr, len);
+	entry->len = len;
+
+	irq_unlock(irq_key);
+}
+#endif /* CONFIG_NET_6LO_HDR_CACHE */
+
 #if defined(CONFIG_NET_6LO_CONTEXT)
 /* RFC 6775, 4.2, 5.4.2, 5.4.3 and 7.2*/
 static inline void set_6lo_context(struct net_if *iface, u8_t index,
@@ -178,6 +314,11 @@ void net_6lo_set_context(struct net_if *iface,
 	int unused = -1;
 	u8_t i;
 
+#if defined(CONFIG_NET_6LO_HDR_CACHE)
+	/* Cached headers might use the old context information */
+	hdr_cache_flush();
+#endif
+
 	/* If the context information already exists, update or remove
 	 * as per data.
 	 */
@@ -723,6 +864,12 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 #if defined(CONFIG_NET_6LO_CONTEXT)
 	struct net_6lo_context *src_ctx = NULL;
 	struct net_6lo_context *dst_ctx = NULL;
+#endif
+#if defined(CONFIG_NET_6LO_HDR_CACHE)
+	struct hdr_cache_key key;
+	bool cacheable;
+	u8_t *hdr_end;
+	int ret;
 #endif
 	u8_t compressed = 0;
 	u16_t iphc = (NET_6LO_DISPATCH_IPHC << 8);
@@ -748,7 +895,23 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 	if (ipv6->nexthdr == IPPROTO_UDP) {
 		udp = (struct net_udp_hdr *)inline_pos;
 		inline_pos += NET_UDPH_LEN;
+	}
+
+#if defined(CONFIG_NET_6LO_HDR_CACHE)
+	hdr_end = inline_pos;
+	cacheable = hdr_cache_key_init(pkt, ipv6, &key);
+	if (cacheable) {
+		ret = hdr_cache_apply(pkt, &key, hdr_end);
+		if (ret >= 0) {
+			NET_DBG("Compressed header from cache");
 
+			net_buf_pull(pkt->buffer, ret);
+			return ret;
+		}
+	}
+#endif
+
+	if (ipv6->nexthdr == IPPROTO_UDP) {
 		inline_pos = compress_nh_udp(udp, inline_pos, false);
 	}
 
@@ -823,6 +986,12 @@ sa_end:
 	iphc = htons(iphc);
 	memmove(inline_pos, &iphc, sizeof(iphc));
 
+#if defined(CONFIG_NET_6LO_HDR_CACHE)
+	if (cacheable) {
+		hdr_cache_store(&key, inline_pos, hdr_end - inline_pos);
+	}
+#endif
+
 	compressed = inline_pos - pkt->buffer->data;
 
 	net_buf_pull(pkt->buffer, compressed);
@@ -1384,6 +1553,26 @@ static bool uncompress_IPHC_header(struct net_pkt *pkt)
 	ipv6->vtc = 0x60;
 	net_pkt_set_ip_hdr_len(pkt, NET_IPV6H_LEN);
 
+	/* Fast path for the common stateless link-local case, only next
+	 * header and hop limit can be inlined.
+	 */
+	if ((iphc & NET_6LO_IPHC_LL_MASK) == NET_6LO_IPHC_LL_ELIDED) {
+		ipv6->tcflow = 0U;
+		ipv6->flow = 0U;
+
+		if (!(iphc & NET_6LO_IPHC_NH_MASK)) {
+			ipv6->nexthdr = *cursor;
+			cursor++;
+		}
+
+		cursor = uncompress_hoplimit(iphc, cursor, ipv6);
+
+		net_ipv6_addr_create_iid(&ipv6->src, net_pkt_lladdr_src(pkt));
+		net_ipv6_addr_create_iid(&ipv6->dst, net_pkt_lladdr_dst(pkt));
+
+		goto nh;
+	}
+
 	/* Uncompress Traffic class and Flow label */
 	cursor = uncompress_tfl(iphc, cursor, ipv6);
 
@@ -1444,6 +1633,7 @@ static bool uncompress_IPHC_header(struct net_pkt *pkt)
 		}
 	}
 
+nh:
 	if (iphc & NET_6LO_IPHC_NH_MASK) {
 		ipv6->nexthdr = IPPROTO_UDP;
 		udp = (struct net_udp_hdr *)(frag->data + NET_IPV6H_LEN);
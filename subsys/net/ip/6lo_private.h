@@ -96,6 +96,17 @@
 					 NET_6LO_IPHC_DAM_MASK | \
 					 NET_6LO_IPHC_M_MASK)
 
+/* Stateless link-local form: traffic class and flow label elided, both
+ * addresses derived from the link layer addresses, no context.
+ */
+#define NET_6LO_IPHC_LL_MASK		(NET_6LO_IPHC_TF_MASK | \
+					 NET_6LO_IPHC_CID_MASK | \
+					 NET_6LO_IPHC_SA_MASK | \
+					 NET_6LO_IPHC_DA_MASK)
+#define NET_6LO_IPHC_LL_ELIDED		(NET_6LO_IPHC_TF_11 | \
+					 NET_6LO_IPHC_SAM_11 | \
+					 NET_6LO_IPHC_DAM_11)
+
 /* Next Header UDP */
 #define NET_6LO_NHC_UDP_BARE		0xF0
 
@@ -51,10 +51,23 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+#define CONN_HASH_SIZE			BIT(CONFIG_NET_CONN_HASH_BITS)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
-static sys_slist_t conn_used;
+
+/* UDP and TCP handlers having a local port are hashed on it and, when
+ * they are bound to a remote address and port too, on these as well.
+ * All the other handlers are kept in the wildcard list. A received
+ * packet then only has to be matched against the two buckets its end
+ * points map to and the wildcard list.
+ */
+static sys_slist_t conn_hash[CONN_HASH_SIZE];
+static sys_slist_t conn_wildcard;
+
+/* Registration order of the handlers, see conn_next() */
+static u32_t conn_seq;
 
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
@@ -110,6 +123,133 @@ void conn_register_debug(struct net_conn *conn,
 #define conn_register_debug(...)
 #endif /* (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG) */
 
+static u32_t conn_hash_bytes(u32_t hash, const void *data, size_t len)
+{
+	const u8_t *ptr = data;
+
+	/* FNV-1a */
+	while (len--) {
+		hash = (hash ^ *ptr++) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Ports are in network byte order, addr is NULL for a listening handler */
+static sys_slist_t *conn_hash_bucket(u16_t proto, u16_t local_port,
+				     u16_t remote_port, const void *addr,
+				     size_t addr_len)
+{
+	u32_t hash = 2166136261U;
+
+	hash = conn_hash_bytes(hash, &proto, sizeof(proto));
+	hash = conn_hash_bytes(hash, &local_port, sizeof(local_port));
+
+	if (addr) {
+		hash = conn_hash_bytes(hash, &remote_port, sizeof(remote_port));
+		hash = conn_hash_bytes(hash, addr, addr_len);
+	}
+
+	return &conn_hash[hash & (CONN_HASH_SIZE - 1)];
+}
+
+static inline bool conn_proto_has_ports(u16_t proto)
+{
+	return (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+		(IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP);
+}
+
+/* List the handler is kept in, this depends only on fields that do not
+ * change while it is registered.
+ */
+static sys_slist_t *conn_get_list(struct net_conn *conn)
+{
+	u16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	u16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+
+	if (!conn_proto_has_ports(conn->proto) || !local_port) {
+		return &conn_wildcard;
+	}
+
+	if (!remote_port || !(conn->flags & NET_CONN_REMOTE_ADDR_SPEC)) {
+		return conn_hash_bucket(conn->proto, local_port, 0, NULL, 0);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    conn->remote_addr.sa_family == AF_INET6) {
+		return conn_hash_bucket(conn->proto, local_port, remote_port,
+				&net_sin6(&conn->remote_addr)->sin6_addr,
+				sizeof(struct in6_addr));
+	}
+
+	return conn_hash_bucket(conn->proto, local_port, remote_port,
+				&net_sin(&conn->remote_addr)->sin_addr,
+				sizeof(struct in_addr));
+}
+
+/* Lists that can contain a handler for the packet */
+static int conn_get_lists(struct net_pkt *pkt, union net_ip_header *ip_hdr,
+			  u8_t proto, u16_t src_port, u16_t dst_port,
+			  sys_slist_t *lists[3])
+{
+	sys_slist_t *listen;
+	int count = 0;
+
+	if (conn_proto_has_ports(proto) && dst_port) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    net_pkt_family(pkt) == AF_INET6) {
+			lists[count++] = conn_hash_bucket(proto, dst_port,
+						src_port, &ip_hdr->ipv6->src,
+						sizeof(struct in6_addr));
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   net_pkt_family(pkt) == AF_INET) {
+			lists[count++] = conn_hash_bucket(proto, dst_port,
+						src_port, &ip_hdr->ipv4->src,
+						sizeof(struct in_addr));
+		}
+
+		listen = conn_hash_bucket(proto, dst_port, 0, NULL, 0);
+		if (count == 0 || lists[0] != listen) {
+			lists[count++] = listen;
+		}
+	}
+
+	lists[count++] = &conn_wildcard;
+
+	return count;
+}
+
+/* Every list is kept newest handler first. Merge them so that handlers
+ * are visited in the same order as if they were all in a single list,
+ * which the ranking in net_conn_input() depends on.
+ */
+static struct net_conn *conn_next(sys_snode_t *nodes[], int count)
+{
+	struct net_conn *next = NULL;
+	int i, pos = 0;
+
+	for (i = 0; i < count; i++) {
+		struct net_conn *conn;
+
+		if (!nodes[i]) {
+			continue;
+		}
+
+		conn = CONTAINER_OF(nodes[i], struct net_conn, node);
+
+		if (!next || (s32_t)(conn->seq - next->seq) > 0) {
+			next = conn;
+			pos = i;
+		}
+	}
+
+	if (next) {
+		nodes[pos] = sys_slist_peek_next(nodes[pos]);
+	}
+
+	return next;
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -127,8 +267,9 @@ static struct net_conn *conn_get_unused(void)
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
+	conn->seq = conn_seq++;
 
-	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_get_list(conn), &conn->node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -147,7 +288,11 @@ static struct net_conn *conn_find_handler(u16_t proto, u8_t family,
 {
 	struct net_conn *conn;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	for (conn = conns; conn < &conns[CONFIG_NET_MAX_CONN]; conn++) {
+		if (!(conn->flags & NET_CONN_IN_USE)) {
+			continue;
+		}
+
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -369,7 +514,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	NET_DBG("Connection handler %p removed", conn);
 
-	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_get_list(conn), &conn->node);
 
 	conn_set_unused(conn);
 
@@ -505,9 +650,16 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	struct net_if *pkt_iface = net_pkt_iface(pkt);
 	struct net_conn *best_match = NULL;
 	s16_t best_rank = -1;
+	sys_slist_t *lists[3];
+	sys_snode_t *nodes[3];
 	struct net_conn *conn;
 	u16_t src_port;
 	u16_t dst_port;
+	int count, i;
+
+	if (net_pkt_family(pkt) == AF_INET || net_pkt_family(pkt) == AF_INET6) {
+		net_stats_update_rx_stage(pkt, NET_STATS_RX_IP);
+	}
 
 	if (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) {
 		src_port = proto_hdr->udp->src_port;
@@ -546,7 +698,12 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		" family %d", net_proto2str(net_pkt_family(pkt), proto), pkt,
 		ntohs(src_port), ntohs(dst_port), net_pkt_family(pkt));
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	count = conn_get_lists(pkt, ip_hdr, proto, src_port, dst_port, lists);
+	for (i = 0; i < count; i++) {
+		nodes[i] = sys_slist_peek_head(lists[i]);
+	}
+
+	while ((conn = conn_next(nodes, count)) != NULL) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -657,8 +814,10 @@ void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data)
 {
 	struct net_conn *conn;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		cb(conn, user_data);
+	for (conn = conns; conn < &conns[CONFIG_NET_MAX_CONN]; conn++) {
+		if (conn->flags & NET_CONN_IN_USE) {
+			cb(conn, user_data);
+		}
 	}
 }
 
@@ -667,7 +826,11 @@ void net_conn_init(void)
 	int i;
 
 	sys_slist_init(&conn_unused);
-	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -62,6 +62,9 @@ struct net_conn {
 	/** Possible user to pass to the callback */
 	void *user_data;
 
+	/** Registration order, newer handlers win on equal rank */
+	u32_t seq;
+
 	/** Connection protocol */
 	u16_t proto;
 
@@ -26,6 +26,11 @@ LOG_MODULE_REGISTER(net_dhcpv4, CONFIG_NET_DHCPV4_LOG_LEVEL);
 #include <net/dhcpv4.h>
 #include <net/dns_resolve.h>
 
+#if defined(CONFIG_NET_DHCPV4_LEASE_SETTINGS)
+#include <stdlib.h>
+#include <settings/settings.h>
+#endif
+
 #include "dhcpv4.h"
 #include "ipv4.h"
 
@@ -34,6 +39,10 @@ LOG_MODULE_REGISTER(net_dhcpv4, CONFIG_NET_DHCPV4_LOG_LEVEL);
 static sys_slist_t dhcpv4_ifaces;
 static struct k_delayed_work timeout_work;
 
+#if defined(CONFIG_NET_DHCPV4_LEASE_SETTINGS)
+static struct k_work lease_store_work;
+#endif
+
 static struct net_mgmt_event_callback mgmt4_cb;
 
 /* RFC 1497 [17] */
@@ -275,6 +284,18 @@ static u32_t dhcpv4_send_request(struct net_if *iface)
 		with_server_id = true;
 		with_requested_ip = true;
 		break;
+	case NET_DHCPV4_REBOOTING:
+#if defined(CONFIG_NET_DHCPV4_INIT_REBOOT)
+		/* Any reply received in the meantime overwrote it */
+		net_ipaddr_copy(&iface->config.dhcpv4.requested_ip,
+				&iface->config.dhcpv4.previous_ip);
+#endif
+
+		/* RFC2131 4.3.2 INIT-REBOOT: no server identifier, and the
+		 * previous address as requested IP address.
+		 */
+		with_requested_ip = true;
+		break;
 	case NET_DHCPV4_RENEWING:
 		/* Since we have an address populate the ciaddr field.
 		 */
@@ -399,6 +420,45 @@ static void dhcpv4_enter_selecting(struct net_if *iface)
 		net_dhcpv4_state_name(iface->config.dhcpv4.state));
 }
 
+#if defined(CONFIG_NET_DHCPV4_INIT_REBOOT)
+static bool dhcpv4_enter_rebooting(struct net_if *iface)
+{
+	if (!iface->config.dhcpv4.previous_ip.s_addr) {
+		return false;
+	}
+
+	iface->config.dhcpv4.attempts = 0U;
+
+	iface->config.dhcpv4.lease_time = 0U;
+	iface->config.dhcpv4.renewal_time = 0U;
+	iface->config.dhcpv4.rebinding_time = 0U;
+
+	iface->config.dhcpv4.state = NET_DHCPV4_REBOOTING;
+	NET_DBG("enter state=%s previous=%s",
+		net_dhcpv4_state_name(iface->config.dhcpv4.state),
+		log_strdup(net_sprint_ipv4_addr(
+				   &iface->config.dhcpv4.previous_ip)));
+
+	return true;
+}
+
+/* Remember the address of the lease, to request it again on restart */
+static void dhcpv4_set_previous_ip(struct net_if *iface,
+				   const struct in_addr *addr)
+{
+	if (net_ipv4_addr_cmp(&iface->config.dhcpv4.previous_ip, addr)) {
+		return;
+	}
+
+	net_ipaddr_copy(&iface->config.dhcpv4.previous_ip, addr);
+
+#if defined(CONFIG_NET_DHCPV4_LEASE_SETTINGS)
+	/* Flash writes don't belong in the RX path */
+	k_work_submit(&lease_store_work);
+#endif
+}
+#endif /* CONFIG_NET_DHCPV4_INIT_REBOOT */
+
 static bool dhcpv4_check_timeout(s64_t start, u32_t time, s64_t timeout)
 {
 	start += K_SECONDS(time);
@@ -486,6 +546,10 @@ static void dhcpv4_enter_bound(struct net_if *iface)
 		net_dhcpv4_state_name(iface->config.dhcpv4.state),
 		renewal_time, rebinding_time);
 
+#if defined(CONFIG_NET_DHCPV4_INIT_REBOOT)
+	dhcpv4_set_previous_ip(iface, &iface->config.dhcpv4.requested_ip);
+#endif
+
 	iface->config.dhcpv4.timer_start = k_uptime_get();
 	iface->config.dhcpv4.request_time = MIN(renewal_time, rebinding_time);
 
@@ -505,6 +569,12 @@ static u32_t dhcph4_manage_timers(struct net_if *iface, s64_t timeout)
 	case NET_DHCPV4_DISABLED:
 		break;
 	case NET_DHCPV4_INIT:
+#if defined(CONFIG_NET_DHCPV4_INIT_REBOOT)
+		if (dhcpv4_enter_rebooting(iface)) {
+			return dhcpv4_send_request(iface);
+		}
+#endif
+
 		dhcpv4_enter_selecting(iface);
 		/* Fall through, as discover msg needs to be sent */
 	case NET_DHCPV4_SELECTING:
@@ -521,6 +591,18 @@ static u32_t dhcph4_manage_timers(struct net_if *iface, s64_t timeout)
 			return dhcpv4_send_discover(iface);
 		}
 
+		return dhcpv4_send_request(iface);
+	case NET_DHCPV4_REBOOTING:
+		/* No server confirmed the previous address, it may be on
+		 * another network: look for servers.
+		 */
+		if (iface->config.dhcpv4.attempts >=
+					DHCPV4_MAX_NUMBER_OF_REBOOT_ATTEMPTS) {
+			NET_DBG("too many attempts, discover");
+			dhcpv4_enter_selecting(iface);
+			return dhcpv4_send_discover(iface);
+		}
+
 		return dhcpv4_send_request(iface);
 	case NET_DHCPV4_BOUND:
 		if (dhcpv4_renewal_timedout(iface, timeout) ||
@@ -800,6 +882,7 @@ static inline void dhcpv4_handle_msg_offer(struct net_if *iface)
 	case NET_DHCPV4_DISABLED:
 	case NET_DHCPV4_INIT:
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 	case NET_DHCPV4_RENEWING:
 	case NET_DHCPV4_REBINDING:
 	case NET_DHCPV4_BOUND:
@@ -819,6 +902,7 @@ static void dhcpv4_handle_msg_ack(struct net_if *iface)
 	case NET_DHCPV4_BOUND:
 		break;
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 		NET_INFO("Received: %s",
 			 log_strdup(net_sprint_ipv4_addr(
 					 &iface->config.dhcpv4.requested_ip)));
@@ -858,6 +942,15 @@ static void dhcpv4_handle_msg_nak(struct net_if *iface)
 		/* Restart the configuration process. */
 		dhcpv4_enter_selecting(iface);
 		break;
+	case NET_DHCPV4_REBOOTING:
+#if defined(CONFIG_NET_DHCPV4_INIT_REBOOT)
+		/* The previous address is not valid on this network */
+		dhcpv4_set_previous_ip(iface, net_ipv4_unspecified_address());
+#endif
+
+		dhcpv4_enter_selecting(iface);
+		dhcpv4_update_timeout_work(dhcpv4_send_discover(iface));
+		break;
 	}
 }
 
@@ -1024,6 +1117,7 @@ const char *net_dhcpv4_state_name(enum net_dhcpv4_state state)
 		"init",
 		"selecting",
 		"requesting",
+		"rebooting",
 		"renewing",
 		"rebinding",
 		"bound",
@@ -1073,6 +1167,15 @@ void net_dhcpv4_start(struct net_if *iface)
 				  DHCPV4_INITIAL_DELAY_MIN) +
 				DHCPV4_INITIAL_DELAY_MIN;
 
+#if defined(CONFIG_NET_DHCPV4_INIT_REBOOT)
+		/* The delay is only required before the initial discover,
+		 * the previous address is requested right away.
+		 */
+		if (iface->config.dhcpv4.previous_ip.s_addr) {
+			timeout = 0U;
+		}
+#endif
+
 		NET_DBG("wait timeout=%us", timeout);
 
 		if (sys_slist_is_empty(&dhcpv4_ifaces)) {
@@ -1091,6 +1194,7 @@ void net_dhcpv4_start(struct net_if *iface)
 	case NET_DHCPV4_INIT:
 	case NET_DHCPV4_SELECTING:
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 	case NET_DHCPV4_RENEWING:
 	case NET_DHCPV4_REBINDING:
 	case NET_DHCPV4_BOUND:
@@ -1115,6 +1219,7 @@ void net_dhcpv4_stop(struct net_if *iface)
 	case NET_DHCPV4_INIT:
 	case NET_DHCPV4_SELECTING:
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 	case NET_DHCPV4_REBINDING:
 		iface->config.dhcpv4.state = NET_DHCPV4_DISABLED;
 		NET_DBG("state=%s",
@@ -1132,6 +1237,76 @@ void net_dhcpv4_stop(struct net_if *iface)
 	}
 }
 
+#if defined(CONFIG_NET_DHCPV4_LEASE_SETTINGS)
+static void dhcpv4_lease_store(struct k_work *work)
+{
+	struct net_if_dhcpv4 *current;
+
+	ARG_UNUSED(work);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&dhcpv4_ifaces, current, node) {
+		struct net_if *iface = CONTAINER_OF(
+			CONTAINER_OF(current, struct net_if_config, dhcpv4),
+			struct net_if, config);
+		char name[sizeof("net/dhcpv4/255")];
+		int err;
+
+		snprintk(name, sizeof(name), "net/dhcpv4/%d",
+			 net_if_get_by_iface(iface));
+
+		if (current->previous_ip.s_addr) {
+			err = settings_save_one(name, &current->previous_ip,
+						sizeof(current->previous_ip));
+		} else {
+			err = settings_delete(name);
+		}
+
+		if (err) {
+			NET_ERR("Cannot store lease of iface %p (%d)",
+				iface, err);
+		}
+	}
+}
+
+static int dhcpv4_lease_set(const char *key, size_t len,
+			    settings_read_cb read_cb, void *cb_arg)
+{
+	struct in_addr addr;
+	struct net_if *iface;
+	ssize_t ret;
+
+	iface = net_if_get_by_index(atoi(key));
+	if (!iface) {
+		NET_DBG("No iface %s for stored lease", log_strdup(key));
+		return 0;
+	}
+
+	ret = read_cb(cb_arg, &addr, sizeof(addr));
+	if (ret != sizeof(addr)) {
+		NET_ERR("Invalid stored lease of iface %p", iface);
+		return -EINVAL;
+	}
+
+	net_ipaddr_copy(&iface->config.dhcpv4.previous_ip, &addr);
+
+	/* The client may be waiting to discover servers already, request
+	 * the address right away instead.
+	 */
+	if (iface->config.dhcpv4.state == NET_DHCPV4_INIT) {
+		iface->config.dhcpv4.timer_start = k_uptime_get() - 1;
+		iface->config.dhcpv4.request_time = 0U;
+
+		k_delayed_work_cancel(&timeout_work);
+		k_delayed_work_submit(&timeout_work, K_NO_WAIT);
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(net_dhcpv4, "net/dhcpv4", NULL,
+			       dhcpv4_lease_set, NULL, NULL);
+#endif /* CONFIG_NET_DHCPV4_LEASE_SETTINGS */
+
 int net_dhcpv4_init(void)
 {
 	struct sockaddr local_addr;
@@ -1158,6 +1333,10 @@ int net_dhcpv4_init(void)
 
 	k_delayed_work_init(&timeout_work, dhcpv4_timeout);
 
+#if defined(CONFIG_NET_DHCPV4_LEASE_SETTINGS)
+	k_work_init(&lease_store_work, dhcpv4_lease_store);
+#endif
+
 	/* Catch network interface UP or DOWN events and renew the address
 	 * if interface is coming back up again.
 	 */
@@ -104,6 +104,11 @@ enum dhcpv4_msg_type {
  */
 #define DHCPV4_MAX_NUMBER_OF_ATTEMPTS	3
 
+/* Maximum number of REQUEST retransmits in INIT-REBOOT state before
+ * reverting to DISCOVER.
+ */
+#define DHCPV4_MAX_NUMBER_OF_REBOOT_ATTEMPTS	2
+
 /* Initial message retry timeout (s).  This timeout increases
  * exponentially on each retransmit.
  * RFC2131 4.1
@@ -304,6 +304,14 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 			goto drop;
 		}
 
+		/* RFC 8200 ch 3, the hop limit is decremented when routing */
+		if (hdr->hop_limit <= 1U) {
+			NET_DBG("DROP: hop limit exceeded for pkt %p", pkt);
+			net_icmpv6_send_error(pkt, NET_ICMPV6_TIME_EXCEEDED,
+					      0, 0);
+			goto drop;
+		}
+
 		/* Used when detecting if the original link
 		 * layer address length is changed or not.
 		 */
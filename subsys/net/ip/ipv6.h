@@ -22,6 +22,7 @@
 
 #include "icmpv6.h"
 #include "nbr.h"
+#include "reassembly.h"
 
 #define NET_IPV6_ND_HOP_LIMIT 255
 #define NET_IPV6_ND_INFINITE_LIFETIME 0xFFFFFFFF
@@ -381,9 +382,12 @@ struct net_ipv6_reassembly {
 	 */
 	struct k_delayed_work timer;
 
-	/** Pointers to pending fragments */
+	/** Pointers to pending fragments, sorted by fragment offset */
 	struct net_pkt *pkt[NET_IPV6_FRAGMENTS_MAX_PKT];
 
+	/** Received parts of the datagram */
+	struct net_reass ranges;
+
 	/** IPv6 fragment identification */
 	u32_t id;
 };
@@ -154,6 +154,7 @@ static struct net_ipv6_reassembly *reassembly_get(u32_t id,
 	net_ipaddr_copy(&reassembly[avail].dst, dst);
 
 	reassembly[avail].id = id;
+	net_reass_init(&reassembly[avail].ranges, 0);
 
 	return &reassembly[avail];
 }
@@ -245,7 +246,7 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	/* We start from 2nd packet which is then appended to
 	 * the first one.
 	 */
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
+	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT && reass->pkt[i]; i++) {
 		int removed_len;
 
 		pkt = reass->pkt[i];
@@ -363,39 +364,6 @@ void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
 	}
 }
 
-/* Verify that we have all the fragments received and in correct order.
- */
-static bool fragment_verify(struct net_ipv6_reassembly *reass)
-{
-	u16_t offset;
-	int i, prev_len;
-
-	prev_len = net_pkt_get_len(reass->pkt[0]);
-	offset = net_pkt_ipv6_fragment_offset(reass->pkt[0]);
-
-	NET_DBG("pkt %p offset %u", reass->pkt[0], offset);
-
-	if (offset != 0U) {
-		return false;
-	}
-
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		offset = net_pkt_ipv6_fragment_offset(reass->pkt[i]);
-
-		NET_DBG("pkt %p offset %u prev_len %d", reass->pkt[i],
-			offset, prev_len);
-
-		if (prev_len < offset) {
-			/* Something wrong with the offset value */
-			return false;
-		}
-
-		prev_len = net_pkt_get_len(reass->pkt[i]);
-	}
-
-	return true;
-}
-
 static int shift_packets(struct net_ipv6_reassembly *reass, int pos)
 {
 	int i;
@@ -434,7 +402,7 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 	bool found;
 	u8_t more;
 	u32_t id;
-	int i;
+	int i, len, ret;
 
 	if (!reassembly_init_done) {
 		/* Static initializing does not work here because of the array
@@ -468,15 +436,26 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 	more = flag & 0x01;
 	net_pkt_set_ipv6_fragment_offset(pkt, flag & 0xfff8);
 
-	if (!reass->pkt[0]) {
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, 0, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[0] = pkt;
+	len = net_pkt_get_len(pkt) - net_pkt_ipv6_fragment_start(pkt) -
+		sizeof(struct net_ipv6_frag_hdr);
 
-		reassembly_info("Reassembly 1st pkt", reass);
+	if (more && (len % 8)) {
+		/* Fragment length is not multiple of 8, discard
+		 * the packet and send parameter problem error.
+		 */
+		net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
+				      NET_ICMPV6_PARAM_PROB_OPTION, 0);
+		goto drop;
+	}
 
-		/* Wait for more fragments to receive. */
-		goto accept;
+	/* Overlapping fragments discard the whole packet (RFC 5722) */
+	ret = net_reass_add(&reass->ranges, net_pkt_ipv6_fragment_offset(pkt),
+			    len, !more);
+	if (ret < 0) {
+		NET_DBG("Invalid fragment offset %u len %d for 0x%x (%d)",
+			net_pkt_ipv6_fragment_offset(pkt), len, reass->id,
+			ret);
+		goto drop;
 	}
 
 	/* The fragments might come in wrong order so place them
@@ -510,52 +489,26 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 		 * list. We must discard the whole packet at this point.
 		 */
 		NET_DBG("No slots available for 0x%x", reass->id);
-		net_pkt_unref(pkt);
 		goto drop;
 	}
 
-	if (more) {
-		if (net_pkt_get_len(pkt) % 8) {
-			/* Fragment length is not multiple of 8, discard
-			 * the packet and send parameter problem error.
-			 */
-			net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
-					      NET_ICMPV6_PARAM_PROB_OPTION, 0);
-			goto drop;
-		}
-
+	if (!net_reass_is_complete(&reass->ranges)) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		NET_DBG("More fragments to be received");
-		goto accept;
+		return NET_OK;
 	}
 
 	reassembly_info("Reassembly last pkt", reass);
 
-	if (!fragment_verify(reass)) {
-		NET_DBG("Reassembled IPv6 verify failed, dropping id %u",
-			reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < NET_IPV6_FRAGMENTS_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
-		net_pkt_unref(pkt);
-		goto drop;
-	}
-
-	/* The last fragment received, reassemble the packet */
+	/* All the fragments received, reassemble the packet */
 	reassemble_packet(reass);
 
-accept:
 	return NET_OK;
 
 drop:
 	if (reass) {
-		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
-			return NET_OK;
-		}
+		reassembly_cancel(reass->id, &reass->src, &reass->dst);
 	}
 
 	return NET_DROP;
@@ -36,6 +36,10 @@ LOG_MODULE_DECLARE(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 
 #define MLDv2_LEN (MLDv2_MCAST_RECORD_LEN + sizeof(struct in6_addr))
 
+#if CONFIG_NET_IPV6_MLD_REPORT_DELAY > 0
+static struct k_delayed_work report_timer;
+#endif
+
 static int mld_create(struct net_pkt *pkt,
 		      const struct in6_addr *addr,
 		      u8_t record_type,
@@ -194,10 +198,23 @@ int net_ipv6_mld_join(struct net_if *iface, const struct in6_addr *addr)
 		}
 	}
 
+#if CONFIG_NET_IPV6_MLD_REPORT_DELAY > 0
+	/* The groups joined close together, like when the interface comes
+	 * up, are reported at once.
+	 */
+	maddr->is_report_pending = true;
+	ret = 0;
+
+	if (!k_delayed_work_remaining_get(&report_timer)) {
+		k_delayed_work_submit(&report_timer,
+				      K_MSEC(CONFIG_NET_IPV6_MLD_REPORT_DELAY));
+	}
+#else
 	ret = mld_send_generic(iface, addr, NET_IPV6_MLDv2_MODE_IS_EXCLUDE);
 	if (ret < 0) {
 		return ret;
 	}
+#endif
 
 	net_if_ipv6_maddr_join(maddr);
 
@@ -224,6 +241,8 @@ int net_ipv6_mld_leave(struct net_if *iface, const struct in6_addr *addr)
 		return -EINVAL;
 	}
 
+	maddr->is_report_pending = false;
+
 	ret = mld_send_generic(iface, addr, NET_IPV6_MLDv2_MODE_IS_INCLUDE);
 	if (ret < 0) {
 		return ret;
@@ -238,7 +257,17 @@ int net_ipv6_mld_leave(struct net_if *iface, const struct in6_addr *addr)
 	return ret;
 }
 
-static void send_mld_report(struct net_if *iface)
+static inline bool is_reported(struct net_if_mcast_addr *maddr,
+			       bool pending_only)
+{
+	return maddr->is_used && maddr->is_joined &&
+	       (!pending_only || maddr->is_report_pending);
+}
+
+/* Report all the joined groups of the interface in one message, or only
+ * the ones whose join was not reported yet.
+ */
+static int send_mld_report(struct net_if *iface, bool pending_only)
 {
 	struct net_if_ipv6 *ipv6 = iface->config.ip.ipv6;
 	struct net_pkt *pkt;
@@ -247,20 +276,24 @@ static void send_mld_report(struct net_if *iface)
 	NET_ASSERT(ipv6);
 
 	for (i = 0; i < NET_IF_MAX_IPV6_MADDR; i++) {
-		if (!ipv6->mcast[i].is_used || !ipv6->mcast[i].is_joined) {
+		if (!is_reported(&ipv6->mcast[i], pending_only)) {
 			continue;
 		}
 
 		count++;
 	}
 
+	if (!count) {
+		return 0;
+	}
+
 	pkt = net_pkt_alloc_with_buffer(iface, IPV6_OPT_HDR_ROUTER_ALERT_LEN +
 					NET_ICMPV6_UNUSED_LEN +
 					count * MLDv2_MCAST_RECORD_LEN,
 					AF_INET6, IPPROTO_ICMPV6,
 					PKT_WAIT_TIME);
 	if (!pkt) {
-		return;
+		return -ENOMEM;
 	}
 
 	if (mld_create_packet(pkt, count)) {
@@ -268,24 +301,62 @@ static void send_mld_report(struct net_if *iface)
 	}
 
 	for (i = 0; i < NET_IF_MAX_IPV6_MADDR; i++) {
-		if (!ipv6->mcast[i].is_used || !ipv6->mcast[i].is_joined) {
+		if (!is_reported(&ipv6->mcast[i], pending_only)) {
 			continue;
 		}
 
-		if (!mld_create(pkt, &ipv6->mcast[i].address.in6_addr,
-				NET_IPV6_MLDv2_MODE_IS_EXCLUDE, 0)) {
+		if (mld_create(pkt, &ipv6->mcast[i].address.in6_addr,
+			       NET_IPV6_MLDv2_MODE_IS_EXCLUDE, 0)) {
 			goto drop;
 		}
 	}
 
-	if (!mld_send(pkt)) {
-		return;
+	if (mld_send(pkt)) {
+		/* mld_send() has released the packet */
+		return -EIO;
 	}
 
+	for (i = 0; i < NET_IF_MAX_IPV6_MADDR; i++) {
+		ipv6->mcast[i].is_report_pending = false;
+	}
+
+	return 0;
+
 drop:
 	net_pkt_unref(pkt);
+
+	return -ENOBUFS;
+}
+
+#if CONFIG_NET_IPV6_MLD_REPORT_DELAY > 0
+static void report_pending(struct net_if *iface, void *user_data)
+{
+	bool *failed = user_data;
+
+	if (!iface->config.ip.ipv6) {
+		return;
+	}
+
+	if (send_mld_report(iface, true) < 0) {
+		*failed = true;
+	}
 }
 
+static void report_timeout(struct k_work *work)
+{
+	bool failed = false;
+
+	ARG_UNUSED(work);
+
+	net_if_foreach(report_pending, &failed);
+
+	if (failed) {
+		k_delayed_work_submit(&report_timer,
+				      K_MSEC(CONFIG_NET_IPV6_MLD_REPORT_DELAY));
+	}
+}
+#endif /* CONFIG_NET_IPV6_MLD_REPORT_DELAY > 0 */
+
 #define dbg_addr(action, pkt_str, src, dst)				\
 	do {								\
 		NET_DBG("%s %s from %s to %s", action, pkt_str,         \
@@ -338,7 +409,7 @@ static enum net_verdict handle_mld_query(struct net_pkt *pkt,
 		goto drop;
 	}
 
-	send_mld_report(net_pkt_iface(pkt));
+	(void)send_mld_report(net_pkt_iface(pkt), false);
 
 	net_pkt_unref(pkt);
 
@@ -358,5 +429,9 @@ static struct net_icmpv6_handler mld_query_input_handler = {
 
 void net_ipv6_mld_init(void)
 {
+#if CONFIG_NET_IPV6_MLD_REPORT_DELAY > 0
+	k_delayed_work_init(&report_timer, report_timeout);
+#endif
+
 	net_icmpv6_register_handler(&mld_query_input_handler);
 }
@@ -122,6 +122,64 @@ static inline struct net_nbr *get_nbr(int idx)
 	return &net_neighbor_pool[idx].nbr;
 }
 
+#if defined(CONFIG_NET_IPV6_NBR_CACHE_HASH)
+/* Neighbors are hashed on their IPv6 address. The hash chains link
+ * neighbor pool indexes, NBR_HASH_END terminating them.
+ */
+#define NBR_HASH_END 0xff
+
+BUILD_ASSERT_MSG(CONFIG_NET_IPV6_MAX_NEIGHBORS < NBR_HASH_END,
+		 "Neighbor pool indexes do not fit the hash chains");
+
+static u8_t nbr_hash[CONFIG_NET_IPV6_NBR_CACHE_HASH_SIZE] = {
+	[0 ... (CONFIG_NET_IPV6_NBR_CACHE_HASH_SIZE - 1)] = NBR_HASH_END
+};
+static u8_t nbr_hash_next[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+
+static inline int nbr_index(struct net_nbr *nbr)
+{
+	return ((u8_t *)nbr - (u8_t *)net_neighbor_pool) /
+		sizeof(net_neighbor_pool[0]);
+}
+
+static u8_t *nbr_hash_bucket(const struct in6_addr *addr)
+{
+	/* Neighbors mostly share their prefix, so only hash the
+	 * interface identifier.
+	 */
+	u32_t hash = addr->s6_addr32[2] ^ addr->s6_addr32[3];
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &nbr_hash[hash % CONFIG_NET_IPV6_NBR_CACHE_HASH_SIZE];
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	u8_t *bucket = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	int idx = nbr_index(nbr);
+
+	nbr_hash_next[idx] = *bucket;
+	*bucket = idx;
+}
+
+static void nbr_hash_remove(struct net_nbr *nbr)
+{
+	u8_t *link = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	int idx = nbr_index(nbr);
+
+	while (*link != NBR_HASH_END) {
+		if (*link == idx) {
+			*link = nbr_hash_next[idx];
+			return;
+		}
+
+		link = &nbr_hash_next[*link];
+	}
+}
+#endif /* CONFIG_NET_IPV6_NBR_CACHE_HASH */
+
 static inline struct net_nbr *get_nbr_from_data(struct net_ipv6_nbr_data *data)
 {
 	int i;
@@ -259,9 +317,16 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  struct in6_addr *addr)
 {
+#if defined(CONFIG_NET_IPV6_NBR_CACHE_HASH)
+	u8_t i;
+
+	for (i = *nbr_hash_bucket(addr); i != NBR_HASH_END;
+	     i = nbr_hash_next[i]) {
+#else
 	int i;
 
 	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+#endif
 		struct net_nbr *nbr = get_nbr(i);
 
 		if (!nbr->ref) {
@@ -409,6 +474,10 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
 	ipv6_nbr_set_state(nbr, state);
+
+#if defined(CONFIG_NET_IPV6_NBR_CACHE_HASH)
+	nbr_hash_add(nbr);
+#endif
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
 	net_ipv6_nbr_data(nbr)->send_ns = 0;
@@ -647,6 +716,10 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
+#if defined(CONFIG_NET_IPV6_NBR_CACHE_HASH)
+	nbr_hash_remove(nbr);
+#endif
+
 	return;
 }
 
@@ -707,6 +780,13 @@ static inline bool dad_failed(struct net_if *iface, struct in6_addr *addr)
 
 	return true;
 }
+
+/* Optimistic addresses are tentative as far as DAD is concerned */
+static inline bool is_tentative(struct net_if_addr *ifaddr)
+{
+	return ifaddr->addr_state == NET_ADDR_TENTATIVE ||
+	       ifaddr->addr_state == NET_ADDR_OPTIMISTIC;
+}
 #endif /* CONFIG_NET_IPV6_DAD */
 
 #if defined(CONFIG_NET_IPV6_NBR_CACHE)
@@ -761,6 +841,61 @@ static struct in6_addr *check_route(struct net_if *iface,
 	return nexthop;
 }
 
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+static bool nexthop_cache_get(struct net_pkt *pkt, struct in6_addr *dst,
+			      struct in6_addr *nexthop, struct net_if **iface)
+{
+	struct net_context *context = net_pkt_context(pkt);
+	struct net_context_nexthop *cache;
+	bool hit = false;
+	unsigned int key;
+
+	if (!context) {
+		return false;
+	}
+
+	cache = &context->nexthop;
+
+	/* The same context may send from several threads */
+	key = irq_lock();
+
+	if (cache->gen == net_route_nexthop_cache_gen() &&
+	    net_ipv6_addr_cmp(&cache->dst, dst)) {
+		net_ipaddr_copy(nexthop, &cache->nexthop);
+		*iface = cache->iface;
+		hit = true;
+	}
+
+	irq_unlock(key);
+
+	return hit;
+}
+
+static void nexthop_cache_set(struct net_pkt *pkt, struct in6_addr *dst,
+			      struct in6_addr *nexthop, struct net_if *iface,
+			      u32_t gen)
+{
+	struct net_context *context = net_pkt_context(pkt);
+	struct net_context_nexthop *cache;
+	unsigned int key;
+
+	if (!context) {
+		return;
+	}
+
+	cache = &context->nexthop;
+
+	key = irq_lock();
+
+	net_ipaddr_copy(&cache->dst, dst);
+	net_ipaddr_copy(&cache->nexthop, nexthop);
+	cache->iface = iface;
+	cache->gen = gen;
+
+	irq_unlock(key);
+}
+#endif /* CONFIG_NET_CONTEXT_NEXTHOP_CACHE */
+
 enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
@@ -769,6 +904,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 	struct net_ipv6_hdr *ip_hdr;
 	struct net_nbr *nbr;
 	int ret;
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+	struct in6_addr cached_nexthop;
+	u32_t gen;
+#endif
 
 	NET_ASSERT(pkt && pkt->buffer);
 
@@ -779,9 +918,11 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. A GSO
+	 * super-segment is split into segments fitting the MTU by the L2
+	 * or the hardware, it must not be fragmented.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && !net_pkt_gso_size(pkt)) {
 		u16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -827,6 +968,11 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 ignore_frag_error:
 #endif /* CONFIG_NET_IPV6_FRAGMENT */
 
+	/* A forwarded packet got its next hop from net_route_packet() */
+	if (net_pkt_forwarding(pkt) && net_pkt_lladdr_dst(pkt)->addr) {
+		return NET_OK;
+	}
+
 	/* If the IPv6 destination address is not link local, then try to get
 	 * the next hop from routing table if we have multi interface routing
 	 * enabled. The reason for this is that the neighbor cache will not
@@ -846,6 +992,23 @@ ignore_frag_error:
 		return NET_OK;
 	}
 
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+	/* Taken before looking at the routes, so that a concurrent change
+	 * makes the result stale instead of being cached.
+	 */
+	gen = net_route_nexthop_cache_gen();
+
+	if (nexthop_cache_get(pkt, &ip_hdr->dst, &cached_nexthop, &iface)) {
+		nexthop = &cached_nexthop;
+
+		if (iface) {
+			net_pkt_set_iface(pkt, iface);
+		}
+
+		goto try_send;
+	}
+#endif
+
 	if (net_if_ipv6_addr_onlink(&iface, &ip_hdr->dst)) {
 		nexthop = &ip_hdr->dst;
 		net_pkt_set_iface(pkt, iface);
@@ -861,6 +1024,10 @@ ignore_frag_error:
 		}
 
 		if (try_route) {
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+			nexthop_cache_set(pkt, &ip_hdr->dst, nexthop, NULL,
+					  gen);
+#endif
 			goto try_send;
 		}
 	}
@@ -880,6 +1047,10 @@ ignore_frag_error:
 		 */
 	}
 
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+	nexthop_cache_set(pkt, &ip_hdr->dst, nexthop, iface, gen);
+#endif
+
 try_send:
 	nbr = nbr_lookup(&net_neighbor.table, iface, nexthop);
 
@@ -970,6 +1141,19 @@ struct net_nbr *net_ipv6_get_nbr(struct net_if *iface, u8_t idx)
 	return NULL;
 }
 
+static bool is_optimistic(struct net_if *iface, const struct in6_addr *addr)
+{
+	struct net_if_addr *ifaddr;
+
+	if (!IS_ENABLED(CONFIG_NET_IPV6_OPTIMISTIC_DAD)) {
+		return false;
+	}
+
+	ifaddr = net_if_ipv6_addr_lookup_by_iface(iface, addr);
+
+	return ifaddr && ifaddr->addr_state == NET_ADDR_OPTIMISTIC;
+}
+
 static inline u8_t get_llao_len(struct net_if *iface)
 {
 	u8_t total_len = net_if_get_link_addr(iface)->len +
@@ -1279,7 +1463,7 @@ nexthop_found:
 			goto drop;
 		}
 
-		if (ifaddr->addr_state == NET_ADDR_TENTATIVE) {
+		if (is_tentative(ifaddr)) {
 			NET_DBG("DROP: DAD failed for %s iface %p",
 				log_strdup(net_sprint_ipv6_addr(
 						   &ifaddr->address.in6_addr)),
@@ -1342,6 +1526,14 @@ nexthop_found:
 	}
 
 send_na:
+	/* An optimistic address must not override the cache entry of its
+	 * real owner, RFC 4429 ch 3.3.
+	 */
+	if (ifaddr && is_optimistic(net_pkt_iface(pkt),
+				    &ifaddr->address.in6_addr)) {
+		flags &= ~NET_ICMPV6_NA_FLAG_OVERRIDE;
+	}
+
 	if (!net_ipv6_send_na(net_pkt_iface(pkt), src,
 			      &ip_hdr->dst, tgt, flags)) {
 		net_pkt_unref(pkt);
@@ -1760,7 +1952,7 @@ static enum net_verdict handle_na_input(struct net_pkt *pkt,
 			log_strdup(net_sprint_ipv6_addr(&na_hdr->tgt)));
 
 #if defined(CONFIG_NET_IPV6_DAD)
-		if (ifaddr->addr_state == NET_ADDR_TENTATIVE) {
+		if (is_tentative(ifaddr)) {
 			dad_failed(net_pkt_iface(pkt), &na_hdr->tgt);
 		}
 #endif /* CONFIG_NET_IPV6_DAD */
@@ -1821,6 +2013,11 @@ int net_ipv6_send_ns(struct net_if *iface,
 
 			goto drop;
 		}
+
+		/* No SLLAO from an optimistic address, RFC 4429 ch 3.3 */
+		if (is_optimistic(iface, src)) {
+			llao_len = 0U;
+		}
 	}
 
 	pkt = net_pkt_alloc_with_buffer(iface,
@@ -1852,7 +2049,7 @@ int net_ipv6_send_ns(struct net_if *iface,
 		goto drop;
 	}
 
-	if (!is_my_address) {
+	if (llao_len > 0) {
 		if (!set_llao(pkt, net_if_get_link_addr(iface),
 			      llao_len, NET_ICMPV6_ND_OPT_SLLAO)) {
 			goto drop;
@@ -1935,7 +2132,7 @@ int net_ipv6_send_rs(struct net_if *iface)
 	net_ipv6_addr_create_ll_allnodes_mcast(&dst);
 	src = net_if_ipv6_select_src_addr(iface, &dst);
 
-	if (!net_ipv6_is_addr_unspecified(src)) {
+	if (!net_ipv6_is_addr_unspecified(src) && !is_optimistic(iface, src)) {
 		llao_len = get_llao_len(iface);
 	}
 
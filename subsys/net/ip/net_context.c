@@ -281,6 +281,14 @@ int net_context_get(sa_family_t family,
 
 		k_mutex_init(&contexts[i].lock);
 
+#if defined(CONFIG_NET_CONTEXT_TX_TIMESTAMP)
+		contexts[i].tx_ts.count = 0U;
+#endif
+
+#if defined(CONFIG_NET_CONTEXT_NEXTHOP_CACHE)
+		contexts[i].nexthop.gen = 0U;
+#endif
+
 		contexts[i].flags |= NET_CONTEXT_IN_USE;
 		*context = &contexts[i];
 
@@ -1103,10 +1111,10 @@ static int get_context_timepstamp(struct net_context *context,
 				  void *value, size_t *len)
 {
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMP)
-	*((bool *)value) = context->options.timestamp;
+	*((u8_t *)value) = context->options.timestamp;
 
 	if (len) {
-		*len = sizeof(bool);
+		*len = sizeof(u8_t);
 	}
 
 	return 0;
@@ -1144,7 +1152,7 @@ int net_context_get_timestamp(struct net_context *context,
 			      struct net_pkt *pkt,
 			      struct net_ptp_time *timestamp)
 {
-	bool is_timestamped;
+	u8_t is_timestamped;
 
 	get_context_timepstamp(context, &is_timestamped, NULL);
 	if (is_timestamped) {
@@ -1156,6 +1164,68 @@ int net_context_get_timestamp(struct net_context *context,
 }
 #endif /* CONFIG_NET_CONTEXT_TIMESTAMP */
 
+#if defined(CONFIG_NET_CONTEXT_TX_TIMESTAMP)
+static struct net_if_timestamp_cb tx_timestamp_cb;
+
+/* Called from the TX timestamp thread for every timestamped packet */
+static void context_tx_timestamp(struct net_pkt *pkt)
+{
+	struct net_context *context = net_pkt_context(pkt);
+	struct net_context_tx_timestamps *tx_ts;
+	int tail;
+
+	if (!net_pkt_is_tx_timestamping(pkt) || !context ||
+	    !PART_OF_ARRAY(contexts, context)) {
+		return;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!net_context_is_used(context)) {
+		goto unlock;
+	}
+
+	tx_ts = &context->tx_ts;
+
+	/* Drop the oldest timestamp if the application is late */
+	if (tx_ts->count == ARRAY_SIZE(tx_ts->ts)) {
+		tx_ts->head = (tx_ts->head + 1) % ARRAY_SIZE(tx_ts->ts);
+		tx_ts->count--;
+	}
+
+	tail = (tx_ts->head + tx_ts->count) % ARRAY_SIZE(tx_ts->ts);
+	memcpy(&tx_ts->ts[tail], net_pkt_timestamp(pkt),
+	       sizeof(struct net_ptp_time));
+	tx_ts->count++;
+
+unlock:
+	k_mutex_unlock(&context->lock);
+}
+
+int net_context_get_tx_timestamp(struct net_context *context,
+				 struct net_ptp_time *timestamp)
+{
+	struct net_context_tx_timestamps *tx_ts = &context->tx_ts;
+	int ret = 0;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!tx_ts->count) {
+		ret = -EAGAIN;
+		goto unlock;
+	}
+
+	memcpy(timestamp, &tx_ts->ts[tx_ts->head], sizeof(*timestamp));
+	tx_ts->head = (tx_ts->head + 1) % ARRAY_SIZE(tx_ts->ts);
+	tx_ts->count--;
+
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_CONTEXT_TX_TIMESTAMP */
+
 static int get_context_txtime(struct net_context *context,
 			      void *value, size_t *len)
 {
@@ -1172,6 +1242,103 @@ static int get_context_txtime(struct net_context *context,
 #endif
 }
 
+static int get_context_zerocopy(struct net_context *context,
+				void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	*((struct net_context_zerocopy *)value) = context->options.zerocopy;
+
+	if (len) {
+		*len = sizeof(struct net_context_zerocopy);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* The iovec data of zero-copy sends is attached to the packets through
+ * external data buffers of this pool. Once the last reference of such a
+ * buffer is gone its completion callback is called.
+ */
+static struct {
+	net_context_zerocopy_cb_t cb;
+	void *user_data;
+	const void *data;
+	size_t len;
+} zerocopy_info[CONFIG_NET_CONTEXT_ZEROCOPY_BUFS];
+
+static void zerocopy_buf_destroy(struct net_buf *buf)
+{
+	int id = net_buf_id(buf);
+	net_context_zerocopy_cb_t cb = zerocopy_info[id].cb;
+	void *user_data = zerocopy_info[id].user_data;
+	const void *data = zerocopy_info[id].data;
+	size_t len = zerocopy_info[id].len;
+
+	/* The slot may be reused as soon as the buffer is back in the pool */
+	net_buf_destroy(buf);
+
+	cb(data, len, user_data);
+}
+
+NET_BUF_POOL_FIXED_DEFINE(zerocopy_bufs, CONFIG_NET_CONTEXT_ZEROCOPY_BUFS,
+			  0, zerocopy_buf_destroy);
+
+static bool context_is_zerocopy(struct net_context *context,
+				const struct msghdr *msghdr, int flags)
+{
+	return msghdr && (flags & ZSOCK_MSG_ZEROCOPY) &&
+		context->options.zerocopy.cb &&
+		net_context_get_ip_proto(context) == IPPROTO_UDP;
+}
+
+/* Append the iovecs of msghdr to pkt, which holds the headers */
+static int context_write_zerocopy(struct net_context *context,
+				  struct net_pkt *pkt, size_t len,
+				  const struct msghdr *msghdr)
+{
+	u16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
+	int i;
+
+	if (mtu && net_pkt_get_len(pkt) + len > mtu) {
+		return -EMSGSIZE;
+	}
+
+	for (i = 0; i < msghdr->msg_iovlen; i++) {
+		struct net_buf *buf;
+		int id;
+
+		if (msghdr->msg_iov[i].iov_len == 0) {
+			continue;
+		}
+
+		buf = net_buf_alloc_with_data(&zerocopy_bufs,
+					      msghdr->msg_iov[i].iov_base,
+					      msghdr->msg_iov[i].iov_len,
+					      PKT_WAIT_TIME);
+		if (!buf) {
+			return -ENOMEM;
+		}
+
+		id = net_buf_id(buf);
+		zerocopy_info[id].cb = context->options.zerocopy.cb;
+		zerocopy_info[id].user_data = context->options.zerocopy.user_data;
+		zerocopy_info[id].data = msghdr->msg_iov[i].iov_base;
+		zerocopy_info[id].len = msghdr->msg_iov[i].iov_len;
+
+		net_pkt_append_buffer(pkt, buf);
+	}
+
+	return 0;
+}
+#else
+#define context_is_zerocopy(...) false
+#define context_write_zerocopy(...) -ENOTSUP
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -1203,7 +1370,8 @@ static int context_setup_udp_packet(struct net_context *context,
 				    size_t len,
 				    const struct msghdr *msg,
 				    const struct sockaddr *dst_addr,
-				    socklen_t addrlen)
+				    socklen_t addrlen,
+				    bool zerocopy)
 {
 	int ret = -EINVAL;
 	u16_t dst_port = 0U;
@@ -1243,7 +1411,11 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	if (zerocopy) {
+		ret = context_write_zerocopy(context, pkt, len, msg);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg);
+	}
 	if (ret) {
 		return ret;
 	}
@@ -1331,10 +1503,12 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  s32_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  int flags)
 {
 	const struct msghdr *msghdr = NULL;
 	struct net_pkt *pkt;
+	bool zerocopy;
 	size_t tmp_len;
 	int ret;
 
@@ -1465,15 +1639,22 @@ static int context_sendto(struct net_context *context,
 		}
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+	/* Zero-copy packets only get buffers for the headers, the data is
+	 * appended as is.
+	 */
+	zerocopy = context_is_zerocopy(context, msghdr, flags);
+
+	pkt = context_alloc_pkt(context, zerocopy ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		return -ENOMEM;
 	}
 
-	tmp_len = net_pkt_available_payload_buffer(
+	if (!zerocopy) {
+		tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_ip_proto(context));
-	if (tmp_len < len) {
-		len = tmp_len;
+		if (tmp_len < len) {
+			len = tmp_len;
+		}
 	}
 
 	context->send_cb = cb;
@@ -1487,9 +1668,15 @@ static int context_sendto(struct net_context *context,
 	}
 
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP)) {
-		bool timestamp;
+		u8_t timestamp;
 
 		get_context_timepstamp(context, &timestamp, NULL);
+
+		if (IS_ENABLED(CONFIG_NET_CONTEXT_TX_TIMESTAMP) &&
+		    (timestamp & NET_CONTEXT_TIMESTAMP_TX_HW)) {
+			net_pkt_set_tx_timestamping(pkt, true);
+		}
+
 		if (timestamp) {
 			struct net_ptp_time tp = {
 				/* Use the nanosecond field to temporarily
@@ -1550,7 +1737,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       dst_addr, addrlen, zerocopy);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1646,7 +1833,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, 0);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -1665,7 +1852,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, flags);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1686,7 +1873,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, 0);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1988,12 +2175,15 @@ static int set_context_timestamp(struct net_context *context,
 				 const void *value, size_t len)
 {
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMP)
-	if (len > sizeof(bool)) {
+	/* Either a bool, or int flags like SO_TIMESTAMPING takes */
+	if (len == sizeof(int)) {
+		context->options.timestamp = *((int *)value);
+	} else if (len == sizeof(bool)) {
+		context->options.timestamp = *((bool *)value);
+	} else {
 		return -EINVAL;
 	}
 
-	context->options.timestamp = *((bool *)value);
-
 	return 0;
 #else
 	return -ENOTSUP;
@@ -2039,6 +2229,22 @@ static int set_context_proxy(struct net_context *context,
 #endif
 }
 
+static int set_context_zerocopy(struct net_context *context,
+				const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (len != sizeof(struct net_context_zerocopy)) {
+		return -EINVAL;
+	}
+
+	context->options.zerocopy = *((struct net_context_zerocopy *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -2066,6 +2272,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = set_context_proxy(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = set_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2100,6 +2309,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = get_context_proxy(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = get_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2131,4 +2343,9 @@ void net_context_foreach(net_context_cb_t cb, void *user_data)
 void net_context_init(void)
 {
 	k_sem_init(&contexts_lock, 1, UINT_MAX);
+
+#if defined(CONFIG_NET_CONTEXT_TX_TIMESTAMP)
+	net_if_register_timestamp_cb(&tx_timestamp_cb, NULL, NULL,
+				     context_tx_timestamp);
+#endif
 }
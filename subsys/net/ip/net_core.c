@@ -120,6 +120,17 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	 */
 	net_pkt_cursor_init(pkt);
 
+	net_stats_update_rx_stage(pkt, NET_STATS_RX_L2);
+
+	/* Packets of flows already forwarded skip the IP input processing */
+	if (IS_ENABLED(CONFIG_NET_ROUTING_FLOW_CACHE) &&
+	    !is_loopback && !locally_routed) {
+		ret = net_route_flow_forward(pkt);
+		if (ret != NET_CONTINUE) {
+			return ret;
+		}
+	}
+
 	/* IP version and header length. */
 	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
 #if defined(CONFIG_NET_IPV6)
@@ -299,6 +310,8 @@ int net_send_data(struct net_pkt *pkt)
 		return -EINVAL;
 	}
 
+	net_stats_update_tx_stage(pkt, NET_STATS_TX_SOCKET);
+
 #if defined(CONFIG_NET_STATISTICS)
 	switch (net_pkt_family(pkt)) {
 	case AF_INET:
@@ -337,6 +350,8 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 	bool is_loopback = false;
 	size_t pkt_len;
 
+	net_stats_update_rx_stage(pkt, NET_STATS_RX_QUEUE);
+
 	pkt_len = net_pkt_get_len(pkt);
 
 	NET_DBG("Received pkt %p len %zu", pkt, pkt_len);
@@ -366,7 +381,8 @@ static void process_rx_packet(struct k_work *work)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt,
+			 u32_t flow)
 {
 	u8_t prio = net_pkt_priority(pkt);
 	u8_t tc = net_rx_priority2tc(prio);
@@ -383,11 +399,11 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
-	net_tc_submit_to_rx_queue(tc, pkt);
+	net_tc_submit_to_rx_queue(tc, flow, pkt);
 }
 
-/* Called by driver when an IP packet has been received */
-int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+static int recv_data(struct net_if *iface, struct net_pkt *pkt,
+		     bool has_flow, u32_t flow)
 {
 	if (!pkt || !iface) {
 		return -EINVAL;
@@ -413,11 +429,29 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 
 	net_pkt_set_iface(pkt, iface);
 
-	net_queue_rx(iface, pkt);
+	if (!has_flow) {
+		flow = net_tc_rx_flow_hash(pkt);
+		net_pkt_cursor_init(pkt);
+	}
+
+	net_stats_update_rx_stage(pkt, NET_STATS_RX_DRIVER);
+
+	net_queue_rx(iface, pkt, flow);
 
 	return 0;
 }
 
+/* Called by driver when an IP packet has been received */
+int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+{
+	return recv_data(iface, pkt, false, 0);
+}
+
+int net_recv_data_flow(struct net_if *iface, struct net_pkt *pkt, u32_t flow)
+{
+	return recv_data(iface, pkt, true, flow);
+}
+
 static inline void l3_init(void)
 {
 	net_icmpv4_init();
@@ -22,6 +22,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "route.h"
 
 #include "net_stats.h"
 
@@ -158,6 +159,10 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	/* We collect send statistics for each socket priority */
 	u8_t pkt_priority;
 #endif
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+	/* The packet belongs to the driver once sent */
+	u32_t stage_time;
+#endif
 
 	if (!pkt) {
 		return false;
@@ -165,6 +170,8 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 
 	debug_check_packet(pkt);
 
+	net_stats_update_tx_stage(pkt, NET_STATS_TX_QUEUE);
+
 	dst = net_pkt_lladdr_dst(pkt);
 	context = net_pkt_context(pkt);
 
@@ -186,8 +193,20 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+		stage_time = net_pkt_stage_time(pkt);
+#endif
+
 		status = net_if_l2(iface)->send(iface, pkt);
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+		if (status >= 0) {
+			(void)net_stats_update_tx_latency(iface,
+							  NET_STATS_TX_DRIVER,
+							  stage_time);
+		}
+#endif
+
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMP)
 		if (status >= 0 && context) {
 			if (start_timestamp.nanosecond > 0) {
@@ -252,6 +271,8 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 
 	k_work_init(net_pkt_work(pkt), process_tx_packet);
 
+	net_stats_update_tx_stage(pkt, NET_STATS_TX_IP);
+
 	net_stats_update_tc_sent_pkt(iface, tc);
 	net_stats_update_tc_sent_bytes(iface, tc, net_pkt_get_len(pkt));
 	net_stats_update_tc_sent_priority(iface, tc, prio);
@@ -504,6 +525,8 @@ static void iface_router_notify_deletion(struct net_if_router *router,
 						router->iface,
 						&router->address.in6_addr,
 						sizeof(struct in6_addr));
+
+		net_route_nexthop_cache_flush();
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
 		   router->address.family == AF_INET) {
 		NET_DBG("IPv4 router %s %s",
@@ -607,6 +630,8 @@ static struct net_if_router *iface_router_add(struct net_if *iface,
 					&routers[i].address.in6_addr,
 					sizeof(struct in6_addr));
 
+			net_route_nexthop_cache_flush();
+
 			NET_DBG("interface %p router %s lifetime %u default %d "
 				"added", iface,
 				log_strdup(net_sprint_ipv6_addr(
@@ -873,7 +898,13 @@ static void dad_timeout(struct k_work *work)
 static void net_if_ipv6_start_dad(struct net_if *iface,
 				  struct net_if_addr *ifaddr)
 {
-	ifaddr->addr_state = NET_ADDR_TENTATIVE;
+	/* Optimistic DAD is not used for manual addresses, RFC 4429 ch 3.1 */
+	if (IS_ENABLED(CONFIG_NET_IPV6_OPTIMISTIC_DAD) &&
+	    ifaddr->addr_type == NET_ADDR_AUTOCONF) {
+		ifaddr->addr_state = NET_ADDR_OPTIMISTIC;
+	} else {
+		ifaddr->addr_state = NET_ADDR_TENTATIVE;
+	}
 
 	if (net_if_is_up(iface)) {
 		NET_DBG("Interface %p ll addr %s tentative IPv6 addr %s",
@@ -1717,6 +1748,8 @@ static void prefix_lifetime_expired(struct net_if_ipv6_prefix *ifprefix)
 
 	ifprefix->is_used = false;
 
+	net_route_nexthop_cache_flush();
+
 	if (net_if_config_ipv6_get(ifprefix->iface, &ipv6) < 0) {
 		return;
 	}
@@ -1885,6 +1918,8 @@ static void net_if_ipv6_prefix_init(struct net_if *iface,
 	ifprefix->iface = iface;
 	net_ipaddr_copy(&ifprefix->prefix, addr);
 
+	net_route_nexthop_cache_flush();
+
 	if (lifetime == NET_IPV6_ND_INFINITE_LIFETIME) {
 		ifprefix->is_infinite = true;
 	} else {
@@ -1959,6 +1994,8 @@ bool net_if_ipv6_prefix_rm(struct net_if *iface, struct in6_addr *addr,
 
 		ipv6->prefix[i].is_used = false;
 
+		net_route_nexthop_cache_flush();
+
 		/* Remove also all auto addresses if the they have the same
 		 * prefix.
 		 */
@@ -2227,9 +2264,10 @@ static u8_t get_diff_ipv6(const struct in6_addr *src,
 	return get_ipaddr_diff((const u8_t *)src, (const u8_t *)dst, 16);
 }
 
-static inline bool is_proper_ipv6_address(struct net_if_addr *addr)
+static inline bool is_proper_ipv6_address(struct net_if_addr *addr,
+					   enum net_addr_state addr_state)
 {
-	if (addr->is_used && addr->addr_state == NET_ADDR_PREFERRED &&
+	if (addr->is_used && addr->addr_state == addr_state &&
 	    addr->address.family == AF_INET6 &&
 	    !net_ipv6_is_ll_addr(&addr->address.in6_addr)) {
 		return true;
@@ -2240,6 +2278,7 @@ static inline bool is_proper_ipv6_address(struct net_if_addr *addr)
 
 static struct in6_addr *net_if_ipv6_get_best_match(struct net_if *iface,
 						   const struct in6_addr *dst,
+						   enum net_addr_state state,
 						   u8_t *best_so_far)
 {
 	struct net_if_ipv6 *ipv6 = iface->config.ip.ipv6;
@@ -2252,7 +2291,7 @@ static struct in6_addr *net_if_ipv6_get_best_match(struct net_if *iface,
 	}
 
 	for (i = 0; i < NET_IF_MAX_IPV6_ADDR; i++) {
-		if (!is_proper_ipv6_address(&ipv6->unicast[i])) {
+		if (!is_proper_ipv6_address(&ipv6->unicast[i], state)) {
 			continue;
 		}
 
@@ -2273,8 +2312,9 @@ static struct in6_addr *net_if_ipv6_get_best_match(struct net_if *iface,
 	return src;
 }
 
-const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
-						   const struct in6_addr *dst)
+static struct in6_addr *ipv6_select_src_addr(struct net_if *dst_iface,
+					      const struct in6_addr *dst,
+					      enum net_addr_state state)
 {
 	struct in6_addr *src = NULL;
 	u8_t best_match = 0U;
@@ -2287,7 +2327,7 @@ const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
 		     iface++) {
 			struct in6_addr *addr;
 
-			addr = net_if_ipv6_get_best_match(iface, dst,
+			addr = net_if_ipv6_get_best_match(iface, dst, state,
 							  &best_match);
 			if (addr) {
 				src = addr;
@@ -2296,7 +2336,7 @@ const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
 
 		/* If caller has supplied interface, then use that */
 		if (dst_iface) {
-			src = net_if_ipv6_get_best_match(dst_iface, dst,
+			src = net_if_ipv6_get_best_match(dst_iface, dst, state,
 							 &best_match);
 		}
 
@@ -2306,7 +2346,7 @@ const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
 		     iface++) {
 			struct in6_addr *addr;
 
-			addr = net_if_ipv6_get_ll(iface, NET_ADDR_PREFERRED);
+			addr = net_if_ipv6_get_ll(iface, state);
 			if (addr) {
 				src = addr;
 				break;
@@ -2314,10 +2354,29 @@ const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
 		}
 
 		if (dst_iface) {
-			src = net_if_ipv6_get_ll(dst_iface, NET_ADDR_PREFERRED);
+			src = net_if_ipv6_get_ll(dst_iface, state);
 		}
 	}
 
+	return src;
+}
+
+const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
+						   const struct in6_addr *dst)
+{
+	struct in6_addr *src;
+
+	src = ipv6_select_src_addr(dst_iface, dst, NET_ADDR_PREFERRED);
+
+#if defined(CONFIG_NET_IPV6_OPTIMISTIC_DAD)
+	/* Optimistic addresses are only used when there is no preferred
+	 * one, RFC 4429 ch 3.3.
+	 */
+	if (!src) {
+		src = ipv6_select_src_addr(dst_iface, dst, NET_ADDR_OPTIMISTIC);
+	}
+#endif
+
 	if (!src) {
 		return net_ipv6_unspecified_address();
 	}
@@ -3496,6 +3555,9 @@ static void net_tx_ts_thread(void)
 		pkt = k_fifo_get(&tx_ts_queue, K_FOREVER);
 		if (pkt) {
 			net_if_call_timestamp_cb(pkt);
+
+			/* Taken in net_if_add_tx_timestamp() */
+			net_pkt_unref(pkt);
 		}
 	}
 }
@@ -3536,7 +3598,8 @@ void net_if_call_timestamp_cb(struct net_pkt *pkt)
 
 void net_if_add_tx_timestamp(struct net_pkt *pkt)
 {
-	k_fifo_put(&tx_ts_queue, pkt);
+	/* Drivers typically release the packet right after this */
+	k_fifo_put(&tx_ts_queue, net_pkt_ref(pkt));
 }
 #endif /* CONFIG_NET_PKT_TIMESTAMP_THREAD */
 
@@ -27,6 +27,17 @@ struct mgmt_event_entry {
 #endif /* CONFIG_NET_MGMT_EVENT_INFO */
 };
 
+/* Callbacks are indexed by the layer of their event mask. The mask of a
+ * layer gathers the layer codes and commands its callbacks listen to, so
+ * that events nobody listens to are not even queued.
+ */
+struct mgmt_layer_callbacks {
+	sys_slist_t callbacks;
+	u32_t event_mask;
+};
+
+#define MGMT_LAYER_COUNT (NET_MGMT_GET_LAYER(NET_MGMT_LAYER_MASK) + 1)
+
 struct mgmt_event_wait {
 	struct k_sem sync_call;
 	struct net_if *iface;
@@ -39,12 +50,66 @@ NET_STACK_DEFINE(MGMT, mgmt_stack, CONFIG_NET_MGMT_EVENT_STACK_SIZE,
 		 CONFIG_NET_MGMT_EVENT_STACK_SIZE);
 static struct k_thread mgmt_thread_data;
 static struct mgmt_event_entry events[CONFIG_NET_MGMT_EVENT_QUEUE_SIZE];
-static u32_t global_event_mask;
-static sys_slist_t event_callbacks;
+static struct mgmt_layer_callbacks layers[MGMT_LAYER_COUNT];
 static s16_t in_event;
 static s16_t out_event;
 
-static inline void mgmt_push_event(u32_t mgmt_event, struct net_if *iface,
+#if defined(CONFIG_NET_MGMT_EVENT_COALESCE)
+/* An event is a duplicate if the last pending event of the same layer code
+ * on the same interface is identical to it. Looking at the last one only
+ * keeps the order in which listeners see the changes of a given subject.
+ * Must be called with the lock held.
+ */
+static bool mgmt_event_is_pending(u32_t mgmt_event, struct net_if *iface,
+				  void *info, size_t length)
+{
+	struct mgmt_event_entry *entry;
+	s16_t idx;
+
+	if (out_event < 0) {
+		return false;
+	}
+
+	idx = in_event;
+
+	while (true) {
+		entry = &events[idx];
+
+		if (entry->event && entry->iface == iface &&
+		    (NET_MGMT_GET_LAYER(entry->event) ==
+		     NET_MGMT_GET_LAYER(mgmt_event)) &&
+		    (NET_MGMT_GET_LAYER_CODE(entry->event) ==
+		     NET_MGMT_GET_LAYER_CODE(mgmt_event))) {
+			if (entry->event != mgmt_event) {
+				return false;
+			}
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+			if (!info || !length) {
+				length = 0;
+			}
+
+			return entry->info_length == length &&
+			       !memcmp(entry->info, info, length);
+#else
+			return true;
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+		}
+
+		if (idx == out_event) {
+			return false;
+		}
+
+		if (--idx < 0) {
+			idx = CONFIG_NET_MGMT_EVENT_QUEUE_SIZE - 1;
+		}
+	}
+}
+#else
+#define mgmt_event_is_pending(...) false
+#endif /* CONFIG_NET_MGMT_EVENT_COALESCE */
+
+static inline bool mgmt_push_event(u32_t mgmt_event, struct net_if *iface,
 				   void *info, size_t length)
 {
 	s16_t i_idx;
@@ -56,6 +121,13 @@ static inline void mgmt_push_event(u32_t mgmt_event, struct net_if *iface,
 
 	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
+	if (mgmt_event_is_pending(mgmt_event, iface, info, length)) {
+		NET_DBG("Event 0x%08x already pending", mgmt_event);
+		k_sem_give(&net_mgmt_lock);
+
+		return false;
+	}
+
 	i_idx = in_event + 1;
 	if (i_idx == CONFIG_NET_MGMT_EVENT_QUEUE_SIZE) {
 		i_idx = 0;
@@ -71,7 +143,7 @@ static inline void mgmt_push_event(u32_t mgmt_event, struct net_if *iface,
 				length, NET_EVENT_INFO_MAX_SIZE);
 			k_sem_give(&net_mgmt_lock);
 
-			return;
+			return false;
 		}
 	} else {
 		events[i_idx].info_length = 0;
@@ -98,6 +170,8 @@ static inline void mgmt_push_event(u32_t mgmt_event, struct net_if *iface,
 	in_event = i_idx;
 
 	k_sem_give(&net_mgmt_lock);
+
+	return true;
 }
 
 static inline struct mgmt_event_entry *mgmt_pop_event(void)
@@ -127,49 +201,49 @@ static inline void mgmt_clean_event(struct mgmt_event_entry *mgmt_event)
 	mgmt_event->iface = NULL;
 }
 
-static inline void mgmt_add_event_mask(u32_t event_mask)
+static inline struct mgmt_layer_callbacks *mgmt_get_layer(u32_t event_mask)
 {
-	global_event_mask |= event_mask;
+	return &layers[NET_MGMT_GET_LAYER(event_mask)];
 }
 
-static inline void mgmt_rebuild_global_event_mask(void)
+static inline void mgmt_rebuild_layer_event_mask(
+					struct mgmt_layer_callbacks *layer)
 {
 	struct net_mgmt_event_callback *cb, *tmp;
 
-	global_event_mask = 0U;
+	layer->event_mask = 0U;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		mgmt_add_event_mask(cb->event_mask);
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&layer->callbacks, cb, tmp, node) {
+		layer->event_mask |= cb->event_mask;
 	}
 }
 
 static inline bool mgmt_is_event_handled(u32_t mgmt_event)
 {
-	return (((NET_MGMT_GET_LAYER(mgmt_event) &
-		  NET_MGMT_GET_LAYER(global_event_mask)) ==
-		 NET_MGMT_GET_LAYER(mgmt_event)) &&
-		((NET_MGMT_GET_LAYER_CODE(mgmt_event) &
-		  NET_MGMT_GET_LAYER_CODE(global_event_mask)) ==
+	u32_t event_mask = mgmt_get_layer(mgmt_event)->event_mask;
+
+	return (((NET_MGMT_GET_LAYER_CODE(mgmt_event) &
+		  NET_MGMT_GET_LAYER_CODE(event_mask)) ==
 		 NET_MGMT_GET_LAYER_CODE(mgmt_event)) &&
 		((NET_MGMT_GET_COMMAND(mgmt_event) &
-		  NET_MGMT_GET_COMMAND(global_event_mask)) ==
+		  NET_MGMT_GET_COMMAND(event_mask)) ==
 		 NET_MGMT_GET_COMMAND(mgmt_event)));
 }
 
 static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 {
+	struct mgmt_layer_callbacks *layer = mgmt_get_layer(mgmt_event->event);
 	sys_snode_t *prev = NULL;
 	struct net_mgmt_event_callback *cb, *tmp;
+	bool removed = false;
 
 	NET_DBG("Event layer %u code %u cmd %u",
 		NET_MGMT_GET_LAYER(mgmt_event->event),
 		NET_MGMT_GET_LAYER_CODE(mgmt_event->event),
 		NET_MGMT_GET_COMMAND(mgmt_event->event));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER(cb->event_mask)) ||
-		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&layer->callbacks, cb, tmp, node) {
+		if (!(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
 		      NET_MGMT_GET_LAYER_CODE(cb->event_mask)) ||
 		    (NET_MGMT_GET_COMMAND(mgmt_event->event) &&
 		     NET_MGMT_GET_COMMAND(cb->event_mask) &&
@@ -203,7 +277,8 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 			cb->raised_event = mgmt_event->event;
 			sync_data->iface = mgmt_event->iface;
 
-			sys_slist_remove(&event_callbacks, prev, &cb->node);
+			sys_slist_remove(&layer->callbacks, prev, &cb->node);
+			removed = true;
 
 			k_sem_give(cb->sync_call);
 		} else {
@@ -215,6 +290,10 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 		}
 	}
 
+	if (removed) {
+		mgmt_rebuild_layer_event_mask(layer);
+	}
+
 #ifdef CONFIG_NET_DEBUG_MGMT_EVENT_STACK
 	net_analyze_stack("Net MGMT event stack",
 			  Z_THREAD_STACK_BUFFER(mgmt_stack),
@@ -312,26 +391,31 @@ static int mgmt_event_wait_call(struct net_if *iface,
 
 void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb)
 {
+	struct mgmt_layer_callbacks *layer;
+
 	NET_DBG("Adding event callback %p", cb);
 
 	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_prepend(&event_callbacks, &cb->node);
-
-	mgmt_add_event_mask(cb->event_mask);
+	layer = mgmt_get_layer(cb->event_mask);
+	sys_slist_prepend(&layer->callbacks, &cb->node);
+	layer->event_mask |= cb->event_mask;
 
 	k_sem_give(&net_mgmt_lock);
 }
 
 void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 {
+	struct mgmt_layer_callbacks *layer;
+
 	NET_DBG("Deleting event callback %p", cb);
 
 	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
+	layer = mgmt_get_layer(cb->event_mask);
+	sys_slist_find_and_remove(&layer->callbacks, &cb->node);
 
-	mgmt_rebuild_global_event_mask();
+	mgmt_rebuild_layer_event_mask(layer);
 
 	k_sem_give(&net_mgmt_lock);
 }
@@ -345,8 +429,9 @@ void net_mgmt_event_notify_with_info(u32_t mgmt_event, struct net_if *iface,
 			NET_MGMT_GET_LAYER_CODE(mgmt_event),
 			NET_MGMT_GET_COMMAND(mgmt_event));
 
-		mgmt_push_event(mgmt_event, iface, info, length);
-		k_sem_give(&network_event);
+		if (mgmt_push_event(mgmt_event, iface, info, length)) {
+			k_sem_give(&network_event);
+		}
 	}
 }
 
@@ -379,8 +464,12 @@ int net_mgmt_event_wait_on_iface(struct net_if *iface,
 
 void net_mgmt_event_init(void)
 {
-	sys_slist_init(&event_callbacks);
-	global_event_mask = 0U;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(layers); i++) {
+		sys_slist_init(&layers[i].callbacks);
+		layers[i].event_mask = 0U;
+	}
 
 	in_event = -1;
 	out_event = -1;
@@ -37,6 +37,8 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #include <net/net_pkt.h>
 #include <net/ethernet.h>
 #include <net/udp.h>
+#include <net/net_mgmt.h>
+#include <net/net_event.h>
 
 #include "net_private.h"
 #include "tcp_internal.h"
@@ -79,7 +81,8 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 /* Make sure that IP + TCP/UDP/ICMP headers fit into one fragment. This
  * makes possible to cast a fragment pointer to protocol header struct.
  */
-#if CONFIG_NET_BUF_DATA_SIZE < (MAX_IP_PROTO_LEN + MAX_NEXT_PROTO_LEN)
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE) && \
+	CONFIG_NET_BUF_DATA_SIZE < (MAX_IP_PROTO_LEN + MAX_NEXT_PROTO_LEN)
 #if defined(STRING2)
 #undef STRING2
 #endif
@@ -93,6 +96,11 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #error "Too small net_buf fragment size"
 #endif
 
+#if defined(CONFIG_NET_BUF_SLAB_DATA_SIZE) && \
+	CONFIG_NET_BUF_SLAB_SMALL_SIZE < (MAX_IP_PROTO_LEN + MAX_NEXT_PROTO_LEN)
+#error "Too small CONFIG_NET_BUF_SLAB_SMALL_SIZE"
+#endif
+
 #if CONFIG_NET_PKT_RX_COUNT <= 0
 #error "Minimum value for CONFIG_NET_PKT_RX_COUNT is 1"
 #endif
@@ -109,25 +117,163 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #error "Minimum value for CONFIG_NET_BUF_TX_COUNT is 1"
 #endif
 
+#if defined(CONFIG_NET_PKT_WATERMARKS)
+static void pkt_buf_destroy(struct net_buf *buf);
+#define PKT_BUF_DESTROY pkt_buf_destroy
+#else
+#define PKT_BUF_DESTROY NULL
+#endif
+
 K_MEM_SLAB_DEFINE(rx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_RX_COUNT, 4);
 K_MEM_SLAB_DEFINE(tx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_TX_COUNT, 4);
 
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 
 NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
-			  CONFIG_NET_BUF_DATA_SIZE, NULL);
+			  CONFIG_NET_BUF_DATA_SIZE, PKT_BUF_DESTROY);
 NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
-			  CONFIG_NET_BUF_DATA_SIZE, NULL);
-
-#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
+			  CONFIG_NET_BUF_DATA_SIZE, PKT_BUF_DESTROY);
+
+#elif defined(CONFIG_NET_BUF_SLAB_DATA_SIZE)
+
+NET_BUF_POOL_SLAB_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
+			 CONFIG_NET_BUF_SLAB_SMALL_SIZE,
+			 CONFIG_NET_BUF_SLAB_SMALL_COUNT,
+			 CONFIG_NET_BUF_SLAB_MEDIUM_SIZE,
+			 CONFIG_NET_BUF_SLAB_MEDIUM_COUNT,
+			 CONFIG_NET_BUF_SLAB_LARGE_SIZE,
+			 CONFIG_NET_BUF_SLAB_LARGE_COUNT, PKT_BUF_DESTROY);
+NET_BUF_POOL_SLAB_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
+			 CONFIG_NET_BUF_SLAB_SMALL_SIZE,
+			 CONFIG_NET_BUF_SLAB_SMALL_COUNT,
+			 CONFIG_NET_BUF_SLAB_MEDIUM_SIZE,
+			 CONFIG_NET_BUF_SLAB_MEDIUM_COUNT,
+			 CONFIG_NET_BUF_SLAB_LARGE_SIZE,
+			 CONFIG_NET_BUF_SLAB_LARGE_COUNT, PKT_BUF_DESTROY);
+
+#else /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
 
 NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
-			CONFIG_NET_BUF_DATA_POOL_SIZE, NULL);
+			CONFIG_NET_BUF_DATA_POOL_SIZE, PKT_BUF_DESTROY);
 NET_BUF_POOL_VAR_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
-			CONFIG_NET_BUF_DATA_POOL_SIZE, NULL);
+			CONFIG_NET_BUF_DATA_POOL_SIZE, PKT_BUF_DESTROY);
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
+#if defined(CONFIG_NET_PKT_WATERMARKS)
+BUILD_ASSERT(CONFIG_NET_PKT_WATERMARK_LOW < CONFIG_NET_PKT_WATERMARK_HIGH);
+
+enum {
+	POOL_RX,
+	POOL_TX,
+};
+
+/* Pools below their low watermark, and the state last reported with
+ * network management events. Allocations can happen in ISRs, so the
+ * events are sent from the system work queue.
+ */
+static atomic_t pools_low;
+static atomic_t pools_low_reported;
+
+static void pool_event_handler(struct k_work *work)
+{
+	static const u32_t events[][2] = {
+		[POOL_RX] = { NET_EVENT_PKT_RX_POOL_OK,
+			      NET_EVENT_PKT_RX_POOL_LOW },
+		[POOL_TX] = { NET_EVENT_PKT_TX_POOL_OK,
+			      NET_EVENT_PKT_TX_POOL_LOW },
+	};
+	int i;
+
+	ARG_UNUSED(work);
+
+	for (i = 0; i < ARRAY_SIZE(events); i++) {
+		bool low = atomic_test_bit(&pools_low, i);
+
+		if (low == atomic_test_bit(&pools_low_reported, i)) {
+			continue;
+		}
+
+		atomic_set_bit_to(&pools_low_reported, i, low);
+
+		NET_DBG("%s pool %s", i == POOL_RX ? "RX" : "TX",
+			low ? "low" : "ok");
+
+		net_mgmt_event_notify(events[i][low], NULL);
+	}
+}
+
+static K_WORK_DEFINE(pool_event_work, pool_event_handler);
+
+static void pool_watermark_check(int idx)
+{
+	struct k_mem_slab *slab = idx == POOL_RX ? &rx_pkts : &tx_pkts;
+	struct net_buf_pool *pool = idx == POOL_RX ? &rx_bufs : &tx_bufs;
+	int free_pkts, free_bufs, free_pct;
+
+	free_pkts = k_mem_slab_num_free_get(slab) * 100 / slab->num_blocks;
+	free_bufs = pool->avail_count * 100 / pool->buf_count;
+	free_pct = MIN(free_pkts, free_bufs);
+
+	if (free_pct <= CONFIG_NET_PKT_WATERMARK_LOW) {
+		if (!atomic_test_and_set_bit(&pools_low, idx)) {
+			k_work_submit(&pool_event_work);
+		}
+	} else if (free_pct >= CONFIG_NET_PKT_WATERMARK_HIGH) {
+		if (atomic_test_and_clear_bit(&pools_low, idx)) {
+			k_work_submit(&pool_event_work);
+		}
+	}
+}
+
+static void slab_watermark_check(struct k_mem_slab *slab)
+{
+	if (slab == &rx_pkts) {
+		pool_watermark_check(POOL_RX);
+	} else if (slab == &tx_pkts) {
+		pool_watermark_check(POOL_TX);
+	}
+}
+
+static void buf_watermark_check(struct net_buf_pool *pool)
+{
+	if (pool == &rx_bufs) {
+		pool_watermark_check(POOL_RX);
+	} else if (pool == &tx_bufs) {
+		pool_watermark_check(POOL_TX);
+	}
+}
+
+static void pkt_buf_destroy(struct net_buf *buf)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+	net_buf_destroy(buf);
+
+	buf_watermark_check(pool);
+}
+
+bool net_pkt_rx_pool_is_low(void)
+{
+	return atomic_test_bit(&pools_low, POOL_RX);
+}
+
+bool net_pkt_tx_pool_is_low(void)
+{
+	return atomic_test_bit(&pools_low, POOL_TX);
+}
+#else
+static inline void slab_watermark_check(struct k_mem_slab *slab)
+{
+	ARG_UNUSED(slab);
+}
+
+static inline void buf_watermark_check(struct net_buf_pool *pool)
+{
+	ARG_UNUSED(pool);
+}
+#endif /* CONFIG_NET_PKT_WATERMARKS */
+
 /* Allocation tracking is only available if separately enabled */
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 struct net_pkt_alloc {
@@ -376,11 +522,21 @@ struct net_buf *net_pkt_get_reserve_data(struct net_buf_pool *pool,
 	 */
 
 	if (k_is_in_isr()) {
-		frag = net_buf_alloc(pool, K_NO_WAIT);
-	} else {
-		frag = net_buf_alloc(pool, timeout);
+		timeout = K_NO_WAIT;
 	}
 
+#if defined(CONFIG_NET_BUF_SLAB_DATA_SIZE)
+	/* Callers of this API fill the fragment up to its tailroom, give
+	 * them a buffer of the largest class. Fixed size pools, such as
+	 * context data pools, cap the size to theirs.
+	 */
+	frag = net_buf_alloc_len(pool, CONFIG_NET_BUF_SLAB_LARGE_SIZE, timeout);
+#else
+	frag = net_buf_alloc(pool, timeout);
+#endif
+
+	buf_watermark_check(pool);
+
 	if (!frag) {
 		return NULL;
 	}
@@ -502,6 +658,7 @@ void net_pkt_unref_debug(struct net_pkt *pkt, const char *caller, int line)
 void net_pkt_unref(struct net_pkt *pkt)
 {
 #endif /* NET_LOG_LEVEL >= LOG_LEVEL_DBG */
+	struct k_mem_slab *slab;
 	atomic_val_t ref;
 
 	if (!pkt) {
@@ -591,7 +748,10 @@ done:
 		net_pkt_cursor_init(pkt);
 	}
 
-	k_mem_slab_free(pkt->slab, (void **)&pkt);
+	slab = pkt->slab;
+	k_mem_slab_free(slab, (void **)&pkt);
+
+	slab_watermark_check(slab);
 }
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -846,7 +1006,8 @@ void net_pkt_print(void)
 
 /* New allocator and API starts here */
 
-#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE) || \
+	defined(CONFIG_NET_BUF_SLAB_DATA_SIZE)
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
@@ -864,7 +1025,7 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 	while (size) {
 		struct net_buf *new;
 
-		new = net_buf_alloc_fixed(pool, timeout);
+		new = net_buf_alloc_len(pool, size, timeout);
 		if (!new) {
 			goto error;
 		}
@@ -899,8 +1060,12 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 #endif
 	}
 
+	buf_watermark_check(pool);
+
 	return first;
 error:
+	buf_watermark_check(pool);
+
 	if (first) {
 		net_buf_unref(first);
 	}
@@ -908,7 +1073,7 @@ error:
 	return NULL;
 }
 
-#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#else /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
@@ -923,6 +1088,8 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 
 	buf = net_buf_alloc_len(pool, size, timeout);
 
+	buf_watermark_check(pool);
+
 #if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
 	NET_FRAG_CHECK_IF_NOT_IN_USE(buf, buf->ref + 1);
 
@@ -936,7 +1103,7 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 	return buf;
 }
 
-#endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#endif /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
 
 static size_t pkt_buffer_length(struct net_pkt *pkt,
 				size_t size,
@@ -952,6 +1119,16 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 		max_len = 0;
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* TCP super-segments are split into MTU sized frames by the
+	 * Ethernet L2 or by the hardware.
+	 */
+	if (proto == IPPROTO_TCP && size > max_len && net_pkt_iface(pkt) &&
+	    net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		max_len = MIN(size, CONFIG_NET_TCP_GSO_MAX_SIZE);
+	}
+#endif /* CONFIG_NET_TCP_GSO */
+
 	/* Family vs iface MTU */
 	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
 		if (IS_ENABLED(CONFIG_NET_IPV6_FRAGMENT) && (size > max_len)) {
@@ -1015,13 +1192,38 @@ static size_t pkt_estimate_headers_length(struct net_pkt *pkt,
 	return hdr_len;
 }
 
+#if defined(CONFIG_NET_L2_ETHERNET_RESERVE_HEADER)
+/* Space for the link layer header in front of the first data buffer of
+ * an outgoing packet, so that the L2 can push it in place instead of
+ * inserting a fragment for it.
+ */
+static size_t pkt_l2_headroom(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+	if (pkt->buffer || pkt->slab == &rx_pkts || !iface ||
+	    net_pkt_family(pkt) == AF_UNSPEC ||
+	    net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return 0;
+	}
+
+	if (net_eth_is_vlan_enabled(net_if_l2_data(iface), iface)) {
+		return sizeof(struct net_eth_vlan_hdr);
+	}
+
+	return sizeof(struct net_eth_hdr);
+}
+#else
+#define pkt_l2_headroom(...) 0
+#endif /* CONFIG_NET_L2_ETHERNET_RESERVE_HEADER */
+
 static size_t pkt_get_size(struct net_pkt *pkt)
 {
 	struct net_buf *buf = pkt->buffer;
 	size_t size = 0;
 
 	while (buf) {
-		size += buf->size;
+		size += net_buf_max_len(buf);
 		buf = buf->frags;
 	}
 
@@ -1102,6 +1304,7 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	struct net_buf_pool *pool = NULL;
 	size_t alloc_len = 0;
 	size_t hdr_len = 0;
+	size_t reserve;
 	struct net_buf *buf;
 
 	if (!size && proto == 0 && net_pkt_family(pkt) == AF_UNSPEC) {
@@ -1126,8 +1329,10 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	/* Calculate the maximum that can be allocated depending on size */
 	alloc_len = pkt_buffer_length(pkt, size + hdr_len, proto, alloc_len);
 
-	NET_DBG("Data allocation maximum size %zu (requested %zu)",
-		alloc_len, size);
+	reserve = pkt_l2_headroom(pkt);
+
+	NET_DBG("Data allocation maximum size %zu (requested %zu, reserve %zu)",
+		alloc_len, size, reserve);
 
 	if (pkt->context) {
 		pool = get_data_pool(pkt->context);
@@ -1144,9 +1349,10 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	}
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
-	buf = pkt_alloc_buffer(pool, alloc_len, timeout, caller, line);
+	buf = pkt_alloc_buffer(pool, alloc_len + reserve, timeout,
+			       caller, line);
 #else
-	buf = pkt_alloc_buffer(pool, alloc_len, timeout);
+	buf = pkt_alloc_buffer(pool, alloc_len + reserve, timeout);
 #endif
 
 	if (!buf) {
@@ -1154,6 +1360,10 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 		return -ENOMEM;
 	}
 
+	if (reserve) {
+		net_buf_reserve(buf, reserve);
+	}
+
 	net_pkt_append_buffer(pkt, buf);
 
 	return 0;
@@ -1175,9 +1385,12 @@ static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, s32_t timeout)
 
 	ret = k_mem_slab_alloc(slab, (void **)&pkt, timeout);
 	if (ret) {
+		slab_watermark_check(slab);
 		return NULL;
 	}
 
+	slab_watermark_check(slab);
+
 	memset(pkt, 0, sizeof(struct net_pkt));
 
 	pkt->atomic_ref = ATOMIC_INIT(1);
@@ -1190,6 +1403,10 @@ static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, s32_t timeout)
 	net_pkt_set_priority(pkt, CONFIG_NET_TX_DEFAULT_PRIORITY);
 	net_pkt_set_vlan_tag(pkt, NET_VLAN_TAG_UNSPEC);
 
+	if (IS_ENABLED(CONFIG_NET_STATISTICS_LATENCY)) {
+		net_pkt_set_stage_time(pkt, k_cycle_get_32());
+	}
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 	net_pkt_alloc_add(pkt, true, caller, line);
 #endif
@@ -1439,7 +1656,8 @@ static void pkt_cursor_jump(struct net_pkt *pkt, bool write)
 
 	cursor->buf = cursor->buf->frags;
 	while (cursor->buf) {
-		size_t len = write ? cursor->buf->size : cursor->buf->len;
+		size_t len = write ? net_buf_max_len(cursor->buf) :
+			cursor->buf->len;
 
 		if (!len) {
 			cursor->buf = cursor->buf->frags;
@@ -1464,7 +1682,7 @@ static void pkt_cursor_advance(struct net_pkt *pkt, bool write)
 		return;
 	}
 
-	len = write ? cursor->buf->size : cursor->buf->len;
+	len = write ? net_buf_max_len(cursor->buf) : cursor->buf->len;
 	if ((cursor->pos - cursor->buf->data) == len) {
 		pkt_cursor_jump(pkt, write);
 	}
@@ -1480,9 +1698,10 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 		write = false;
 	}
 
-	len = write ? cursor->buf->size : cursor->buf->len;
+	len = write ? net_buf_max_len(cursor->buf) : cursor->buf->len;
 	if (length + (cursor->pos - cursor->buf->data) == len &&
-	    !(net_pkt_is_being_overwritten(pkt) && len < cursor->buf->size)) {
+	    !(net_pkt_is_being_overwritten(pkt) &&
+	      len < net_buf_max_len(cursor->buf))) {
 		pkt_cursor_jump(pkt, write);
 	} else {
 		cursor->pos += length;
@@ -1507,7 +1726,8 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 		}
 
 		if (write && !net_pkt_is_being_overwritten(pkt)) {
-			d_len = c_op->buf->size - (c_op->pos - c_op->buf->data);
+			d_len = net_buf_max_len(c_op->buf) -
+				(c_op->pos - c_op->buf->data);
 		} else {
 			d_len = c_op->buf->len - (c_op->pos - c_op->buf->data);
 		}
@@ -1637,7 +1857,8 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 		}
 
 		s_len = c_src->buf->len - (c_src->pos - c_src->buf->data);
-		d_len = c_dst->buf->size - (c_dst->pos - c_dst->buf->data);
+		d_len = net_buf_max_len(c_dst->buf) -
+			(c_dst->pos - c_dst->buf->data);
 		if (length < s_len && length < d_len) {
 			len = length;
 		} else {
@@ -1681,6 +1902,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
@@ -1889,7 +2111,7 @@ bool net_pkt_is_contiguous(struct net_pkt *pkt, size_t size)
 		size_t len;
 
 		len = net_pkt_is_being_overwritten(pkt) ?
-			pkt->cursor.buf->len : pkt->cursor.buf->size;
+			pkt->cursor.buf->len : net_buf_max_len(pkt->cursor.buf);
 		len -= pkt->cursor.pos - pkt->cursor.buf->data;
 		if (len >= size) {
 			return true;
@@ -48,7 +48,9 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback);
 extern void net_tc_tx_init(void);
 extern void net_tc_rx_init(void);
 extern void net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt);
-extern void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_to_rx_queue(u8_t tc, u32_t flow,
+				      struct net_pkt *pkt);
+extern u32_t net_tc_rx_flow_hash(struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
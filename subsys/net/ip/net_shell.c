@@ -120,6 +120,8 @@ static inline const char *addrstate2str(enum net_addr_state addr_state)
 		return "preferred";
 	case NET_ADDR_DEPRECATED:
 		return "deprecated";
+	case NET_ADDR_OPTIMISTIC:
+		return "optimistic";
 	}
 
 	return "<invalid state>";
@@ -783,6 +785,79 @@ static void print_tc_rx_stats(const struct shell *shell, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+static const char * const rx_stage_names[NET_STATS_RX_STAGES] = {
+	[NET_STATS_RX_DRIVER] = "driver",
+	[NET_STATS_RX_QUEUE] = "RX queue",
+	[NET_STATS_RX_L2] = "L2",
+	[NET_STATS_RX_IP] = "IP",
+	[NET_STATS_RX_CONN] = "conn",
+	[NET_STATS_RX_SOCKET] = "socket",
+	[NET_STATS_RX_APP] = "app",
+};
+
+static const char * const tx_stage_names[NET_STATS_TX_STAGES] = {
+	[NET_STATS_TX_SOCKET] = "socket",
+	[NET_STATS_TX_IP] = "IP",
+	[NET_STATS_TX_QUEUE] = "TX queue",
+	[NET_STATS_TX_DRIVER] = "driver",
+};
+
+static void print_latency_hdr(const struct shell *shell, const char *title)
+{
+	int i;
+
+	PR("%s latency (us)\n", title);
+	PR("Stage      Count   Avg     Max     Histogram <1");
+
+	for (i = 1; i < CONFIG_NET_STATISTICS_LATENCY_BUCKETS - 1; i++) {
+		PR(" <%u", 1U << i);
+	}
+
+	PR(" >=%u\n", 1U << (CONFIG_NET_STATISTICS_LATENCY_BUCKETS - 2));
+}
+
+static void print_latency(const struct shell *shell, const char *name,
+			  struct net_stats_latency *latency)
+{
+	int i;
+
+	if (latency->time_count == 0) {
+		PR("%-10s -\n", name);
+		return;
+	}
+
+	PR("%-10s %-7u %-7u %-7u", name, latency->time_count,
+	   (u32_t)(latency->time_sum / latency->time_count),
+	   latency->time_max);
+
+	for (i = 0; i < CONFIG_NET_STATISTICS_LATENCY_BUCKETS; i++) {
+		PR(" %u", latency->hist[i]);
+	}
+
+	PR("\n");
+}
+
+static void print_latency_stats(const struct shell *shell,
+				struct net_if *iface)
+{
+	struct net_stats_pkt_latency *latency = GET_STAT_ADDR(iface, latency);
+	int i;
+
+	print_latency_hdr(shell, "RX");
+
+	for (i = 0; i < NET_STATS_RX_STAGES; i++) {
+		print_latency(shell, rx_stage_names[i], &latency->rx[i]);
+	}
+
+	print_latency_hdr(shell, "TX");
+
+	for (i = 0; i < NET_STATS_TX_STAGES; i++) {
+		print_latency(shell, tx_stage_names[i], &latency->tx[i]);
+	}
+}
+#endif /* CONFIG_NET_STATISTICS_LATENCY */
+
 static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 {
 	struct net_shell_user_data *data = user_data;
@@ -884,9 +959,16 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	}
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+	print_latency_stats(shell, iface);
+#endif
+
 	PR("Bytes received %u\n", GET_STAT(iface, bytes.received));
 	PR("Bytes sent     %u\n", GET_STAT(iface, bytes.sent));
 	PR("Processing err %d\n", GET_STAT(iface, processing_error));
+#if defined(CONFIG_NET_L2_ETHERNET_RESERVE_HEADER)
+	PR("L2 hdr in place %u\n", GET_STAT(iface, l2_hdr_in_place));
+#endif
 
 	print_tc_tx_stats(shell, iface);
 	print_tc_rx_stats(shell, iface);
@@ -1075,6 +1157,34 @@ static void tcp_cb(struct net_tcp *tcp, void *user_data)
 	(*count)++;
 }
 
+static void tcp_wnd_cb(struct net_tcp *tcp, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+	u32_t cwnd = 0U, ssthresh = 0U;
+	u32_t rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	cwnd = tcp->cwnd;
+	ssthresh = tcp->ssthresh;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (tcp->rto) {
+		rto = tcp->rto;
+	}
+#endif
+
+	PR("%p %10u %10u %10u %10u %6u  %2u/%-2u %c%c%c\n",
+	   tcp, tcp->send_wnd, net_tcp_get_recv_wnd(tcp), cwnd, ssthresh,
+	   rto, tcp->send_wscale, tcp->recv_wscale,
+	   (tcp->flags & NET_TCP_SACK_ON) ? 'S' : '-',
+	   (tcp->flags & NET_TCP_TS_ON) ? 'T' : '-',
+	   (tcp->flags & NET_TCP_IN_RECOVERY) ? 'R' : '-');
+
+	(*count)++;
+}
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 static void tcp_sent_list_cb(struct net_tcp *tcp, void *user_data)
 {
@@ -2196,6 +2306,22 @@ static int cmd_net_gptp(const struct shell *shell, size_t argc, char *argv[])
 		   domain->state.clk_slave_sync.rcvd_local_clk_tick ?
 							   "yes" : "no");
 
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		PR("Local clock servo:\n");
+		PR("\tLocked                         : %s\n",
+		   domain->state.clk_slave_sync.servo.locked ? "yes" : "no");
+		PR("\tLast offset (ns)               : %lld\n",
+		   domain->state.clk_slave_sync.servo.offset);
+		PR("\tJitter (ns)                    : %lld\n",
+		   domain->state.clk_slave_sync.servo.jitter);
+		PR("\tFrequency correction (ppb)     : %d\n",
+		   domain->state.clk_slave_sync.servo.ppb);
+		PR("\tOffsets processed              : %u\n",
+		   domain->state.clk_slave_sync.servo.samples);
+		PR("\tClock set                      : %u\n",
+		   domain->state.clk_slave_sync.servo.steps);
+#endif
+
 		PR("PortRoleSelection state machine variables:\n");
 		PR("\tCurrent state                  : %s\n",
 		   pr_selection2str(domain->state.pr_sel.state));
@@ -2565,7 +2691,9 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 
 	net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
 
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 	PR("Fragment length %d bytes\n", CONFIG_NET_BUF_DATA_SIZE);
+#endif
 
 	PR("Network buffer pools:\n");
 
@@ -2595,6 +2723,27 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 	PR("%p\t%d\tTX DATA\n", tx_data, tx_data->buf_count);
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_SLAB_DATA_SIZE)
+	PR("\nData size classes:\n");
+	PR("Pool\tSize\tTotal\tUsed\tMax\tAllocs\tFallbacks\n");
+
+	for (int i = 0; ; i++) {
+		struct net_buf_slab_stats rx_stats, tx_stats;
+
+		if (net_buf_pool_slab_stats(rx_data, i, &rx_stats) ||
+		    net_buf_pool_slab_stats(tx_data, i, &tx_stats)) {
+			break;
+		}
+
+		PR("RX\t%zu\t%u\t%u\t%u\t%u\t%u\n", rx_stats.data_size,
+		   rx_stats.count, rx_stats.used, rx_stats.max_used,
+		   rx_stats.allocs, rx_stats.fallbacks);
+		PR("TX\t%zu\t%u\t%u\t%u\t%u\t%u\n", tx_stats.data_size,
+		   tx_stats.count, tx_stats.used, tx_stats.max_used,
+		   tx_stats.allocs, tx_stats.fallbacks);
+	}
+#endif /* CONFIG_NET_BUF_SLAB_DATA_SIZE */
+
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_NET_PKT_POOL)) {
 		struct net_shell_user_data user_data;
 		struct ctx_info info;
@@ -3703,9 +3852,33 @@ static int cmd_net_tcp_close(const struct shell *shell, size_t argc,
 
 static int cmd_net_tcp(const struct shell *shell, size_t argc, char *argv[])
 {
+#if defined(CONFIG_NET_TCP)
+	struct net_shell_user_data user_data;
+	int count = 0;
+#endif
+
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
+#if defined(CONFIG_NET_TCP)
+	/* Window and congestion state, S: SACK, T: timestamps,
+	 * R: in fast recovery
+	 */
+	PR("TCP          Send-Wnd   Recv-Wnd       Cwnd   Ssthresh    RTO "
+	   "Scale Opts\n");
+
+	user_data.shell = shell;
+	user_data.user_data = &count;
+
+	net_tcp_foreach(tcp_wnd_cb, &user_data);
+
+	if (count == 0) {
+		PR("No TCP connections\n");
+	}
+#else
+	PR_INFO("TCP not enabled. Set CONFIG_NET_TCP to enable it.\n");
+#endif /* CONFIG_NET_TCP */
+
 	return 0;
 }
 
@@ -4218,7 +4391,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_commands,
 		  cmd_net_stacks),
 	SHELL_CMD(stats, &net_cmd_stats, "Show network statistics.",
 		  cmd_net_stats),
-	SHELL_CMD(tcp, &net_cmd_tcp, "Connect/send/close TCP connection.",
+	SHELL_CMD(tcp, &net_cmd_tcp, "Show TCP window and congestion "
+		  "state, connect/send/close TCP connection.",
 		  cmd_net_tcp),
 	SHELL_CMD(vlan, &net_cmd_vlan, "Show VLAN information.", cmd_net_vlan),
 	SHELL_SUBCMD_SET_END
@@ -28,6 +28,60 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  */
 struct net_stats net_stats = { 0 };
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+static void latency_add(struct net_stats_latency *latency, u32_t us)
+{
+	int bucket = 0;
+
+	if (us) {
+		/* Index of the highest bit set, plus one */
+		bucket = MIN(32 - __builtin_clz(us),
+			     CONFIG_NET_STATISTICS_LATENCY_BUCKETS - 1);
+	}
+
+	latency->time_sum += us;
+	latency->time_count++;
+	latency->time_max = MAX(latency->time_max, us);
+	latency->hist[bucket]++;
+}
+
+static u32_t latency_update(struct net_stats_latency *global,
+			    struct net_stats_latency *local, u32_t start)
+{
+	u32_t now = k_cycle_get_32();
+	u32_t us;
+
+	us = (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(now - start) /
+		     NSEC_PER_USEC);
+
+	latency_add(global, us);
+
+	if (IS_ENABLED(CONFIG_NET_STATISTICS_PER_INTERFACE) && local) {
+		latency_add(local, us);
+	}
+
+	return now;
+}
+
+u32_t net_stats_update_rx_latency(struct net_if *iface,
+				  enum net_stats_rx_stage stage,
+				  u32_t start)
+{
+	return latency_update(&net_stats.latency.rx[stage],
+			      iface ? GET_STAT_ADDR(iface, latency.rx[stage]) :
+			      NULL, start);
+}
+
+u32_t net_stats_update_tx_latency(struct net_if *iface,
+				  enum net_stats_tx_stage stage,
+				  u32_t start)
+{
+	return latency_update(&net_stats.latency.tx[stage],
+			      iface ? GET_STAT_ADDR(iface, latency.tx[stage]) :
+			      NULL, start);
+}
+#endif /* CONFIG_NET_STATISTICS_LATENCY */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
 #define PRINT_STATISTICS_INTERVAL K_SECONDS(30)
@@ -283,6 +337,12 @@ static int net_stats_get(u32_t mgmt_request, struct net_if *iface,
 		len_chk = sizeof(struct net_stats_tcp);
 		src = GET_STAT_ADDR(iface, tcp);
 		break;
+#endif
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+	case NET_REQUEST_STATS_CMD_GET_LATENCY:
+		len_chk = sizeof(struct net_stats_pkt_latency);
+		src = GET_STAT_ADDR(iface, latency);
+		break;
 #endif
 	}
 
@@ -337,4 +397,9 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_TCP,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_LATENCY,
+				  net_stats_get);
+#endif
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
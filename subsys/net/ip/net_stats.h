@@ -14,6 +14,7 @@
 #include <net/net_ip.h>
 #include <net/net_stats.h>
 #include <net/net_if.h>
+#include <net/net_pkt.h>
 
 extern struct net_stats net_stats;
 
@@ -38,6 +39,11 @@ static inline void net_stats_update_processing_error(struct net_if *iface)
 	UPDATE_STAT(iface, stats.processing_error++);
 }
 
+static inline void net_stats_update_l2_hdr_in_place(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.l2_hdr_in_place++);
+}
+
 static inline void net_stats_update_ip_errors_protoerr(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.ip_errors.protoerr++);
@@ -61,6 +67,7 @@ static inline void net_stats_update_bytes_sent(struct net_if *iface,
 }
 #else
 #define net_stats_update_processing_error(iface)
+#define net_stats_update_l2_hdr_in_place(iface)
 #define net_stats_update_ip_errors_protoerr(iface)
 #define net_stats_update_ip_errors_vhlerr(iface)
 #define net_stats_update_bytes_recv(iface, bytes)
@@ -332,6 +339,38 @@ static inline void net_stats_update_tx_time(struct net_if *iface,
 }
 #endif /* CONFIG_NET_CONTEXT_TIMESTAMP && STATISTICS */
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY) && defined(CONFIG_NET_STATISTICS)
+/* Account the time since start to the stage, returns the current cycle
+ * counter value, which is the start of the next stage.
+ */
+u32_t net_stats_update_rx_latency(struct net_if *iface,
+				  enum net_stats_rx_stage stage,
+				  u32_t start);
+u32_t net_stats_update_tx_latency(struct net_if *iface,
+				  enum net_stats_tx_stage stage,
+				  u32_t start);
+
+/* Called at the end of each stage the packet goes through */
+static inline void net_stats_update_rx_stage(struct net_pkt *pkt,
+					     enum net_stats_rx_stage stage)
+{
+	net_pkt_set_stage_time(pkt,
+		net_stats_update_rx_latency(net_pkt_iface(pkt), stage,
+					    net_pkt_stage_time(pkt)));
+}
+
+static inline void net_stats_update_tx_stage(struct net_pkt *pkt,
+					     enum net_stats_tx_stage stage)
+{
+	net_pkt_set_stage_time(pkt,
+		net_stats_update_tx_latency(net_pkt_iface(pkt), stage,
+					    net_pkt_stage_time(pkt)));
+}
+#else
+#define net_stats_update_rx_stage(pkt, stage)
+#define net_stats_update_tx_stage(pkt, stage)
+#endif /* CONFIG_NET_STATISTICS_LATENCY && CONFIG_NET_STATISTICS */
+
 #if (NET_TC_COUNT > 1) && defined(CONFIG_NET_STATISTICS)
 static inline void net_stats_update_tc_sent_pkt(struct net_if *iface, u8_t tc)
 {
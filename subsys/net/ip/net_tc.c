@@ -13,11 +13,21 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
 
+#if defined(CONFIG_NET_RX_FLOW_WORKERS)
+#define RX_FLOW_WORKERS CONFIG_NET_RX_FLOW_WORKERS
+#else
+#define RX_FLOW_WORKERS 1
+#endif
+
+/* Every Rx traffic class has RX_FLOW_WORKERS queues */
+#define RX_QUEUE_COUNT (NET_TC_RX_COUNT * RX_FLOW_WORKERS)
+
 /* Stacks for TX work queue */
 NET_STACK_ARRAY_DEFINE(TX, tx_stack,
 		       CONFIG_NET_TX_STACK_SIZE,
@@ -28,20 +38,113 @@ NET_STACK_ARRAY_DEFINE(TX, tx_stack,
 NET_STACK_ARRAY_DEFINE(RX, rx_stack,
 		       CONFIG_NET_RX_STACK_SIZE,
 		       CONFIG_NET_RX_STACK_SIZE,
-		       NET_TC_RX_COUNT);
+		       RX_QUEUE_COUNT);
 
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[RX_QUEUE_COUNT];
 
 void net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt)
 {
 	k_work_submit_to_queue(&tx_classes[tc].work_q, net_pkt_work(pkt));
 }
 
-void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt)
+void net_tc_submit_to_rx_queue(u8_t tc, u32_t flow, struct net_pkt *pkt)
+{
+	int queue = tc * RX_FLOW_WORKERS + flow % RX_FLOW_WORKERS;
+
+	k_work_submit_to_queue(&rx_classes[queue].work_q, net_pkt_work(pkt));
+}
+
+#if RX_FLOW_WORKERS > 1
+static u32_t flow_hash_bytes(u32_t hash, const u8_t *data, size_t len)
 {
-	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
+	/* FNV-1a */
+	while (len--) {
+		hash = (hash ^ *data++) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Hash the addresses, protocol and ports of a received Ethernet frame.
+ * Anything that cannot be parsed here, like IP fragments after the first
+ * one or other link layers, ends up in flow 0.
+ */
+u32_t net_tc_rx_flow_hash(struct net_pkt *pkt)
+{
+	u32_t hash = 2166136261U;
+	union {
+		struct net_ipv4_hdr ipv4;
+		struct net_ipv6_hdr ipv6;
+	} hdr;
+	u8_t ports[4];
+	u16_t type;
+	u8_t proto;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(ETHERNET)) {
+		return 0;
+	}
+#else
+	return 0;
+#endif
+
+	if (net_pkt_skip(pkt, 2 * sizeof(struct net_eth_addr)) ||
+	    net_pkt_read_be16(pkt, &type)) {
+		return 0;
+	}
+
+	if (type == NET_ETH_PTYPE_VLAN &&
+	    (net_pkt_skip(pkt, sizeof(u16_t)) ||
+	     net_pkt_read_be16(pkt, &type))) {
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && type == NET_ETH_PTYPE_IP) {
+		if (net_pkt_read(pkt, &hdr.ipv4, sizeof(hdr.ipv4))) {
+			return 0;
+		}
+
+		hash = flow_hash_bytes(hash, hdr.ipv4.src.s4_addr,
+				       2 * sizeof(struct in_addr));
+		proto = hdr.ipv4.proto;
+
+		/* Only the first fragment has the ports */
+		if ((hdr.ipv4.offset[0] & 0x3f) || hdr.ipv4.offset[1] ||
+		    net_pkt_skip(pkt, (hdr.ipv4.vhl & 0x0f) * 4 -
+				 sizeof(hdr.ipv4))) {
+			proto = 0U;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   type == NET_ETH_PTYPE_IPV6) {
+		if (net_pkt_read(pkt, &hdr.ipv6, sizeof(hdr.ipv6))) {
+			return 0;
+		}
+
+		hash = flow_hash_bytes(hash, hdr.ipv6.src.s6_addr,
+				       2 * sizeof(struct in6_addr));
+		proto = hdr.ipv6.nexthdr;
+	} else {
+		return 0;
+	}
+
+	hash = flow_hash_bytes(hash, &proto, sizeof(proto));
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    !net_pkt_read(pkt, ports, sizeof(ports))) {
+		hash = flow_hash_bytes(hash, ports, sizeof(ports));
+	}
+
+	return hash;
+}
+#else
+u32_t net_tc_rx_flow_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
 }
+#endif /* RX_FLOW_WORKERS > 1 */
 
 int net_tx_priority2tc(enum net_priority prio)
 {
@@ -271,10 +374,11 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < RX_QUEUE_COUNT; i++) {
 		u8_t thread_priority;
 
-		thread_priority = rx_tc2thread(i);
+		/* All the workers of a traffic class run at its priority */
+		thread_priority = rx_tc2thread(i / RX_FLOW_WORKERS);
 		rx_classes[i].tc = thread_priority;
 
 #if defined(CONFIG_NET_SHELL)
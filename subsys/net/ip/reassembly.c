@@ -0,0 +1,91 @@
+/** @file
+ * @brief Fragment reassembly range tracking
+ *
+ * Shared by IPv6 and 6LoWPAN reassembly.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "reassembly.h"
+
+void net_reass_init(struct net_reass *reass, u16_t size)
+{
+	reass->size = size;
+	reass->received = 0U;
+	reass->count = 0U;
+}
+
+int net_reass_add(struct net_reass *reass, u32_t offset, u32_t len,
+		  bool last)
+{
+	struct net_reass_range *range = reass->range;
+	u32_t end = offset + len;
+	bool merge_prev, merge_next;
+	int i;
+
+	if (len == 0U || end > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	if (reass->size > 0U && end > reass->size) {
+		return -EINVAL;
+	}
+
+	if (last) {
+		if (reass->size > 0U && end != reass->size) {
+			return -EINVAL;
+		}
+
+		if (reass->count > 0U && range[reass->count - 1].end > end) {
+			return -EINVAL;
+		}
+	}
+
+	/* Search from the tail so that in order fragments cost nothing */
+	for (i = reass->count; i > 0 && range[i - 1].start > offset; i--) {
+	}
+
+	if ((i > 0 && range[i - 1].end > offset) ||
+	    (i < reass->count && range[i].start < end)) {
+		return -EEXIST;
+	}
+
+	merge_prev = i > 0 && range[i - 1].end == offset;
+	merge_next = i < reass->count && range[i].start == end;
+
+	if (merge_prev && merge_next) {
+		range[i - 1].end = range[i].end;
+		memmove(&range[i], &range[i + 1],
+			(reass->count - i - 1) * sizeof(*range));
+		reass->count--;
+	} else if (merge_prev) {
+		range[i - 1].end = end;
+	} else if (merge_next) {
+		range[i].start = offset;
+	} else {
+		if (reass->count == NET_REASS_MAX_RANGES) {
+			return -ENOMEM;
+		}
+
+		memmove(&range[i + 1], &range[i],
+			(reass->count - i) * sizeof(*range));
+		range[i].start = offset;
+		range[i].end = end;
+		reass->count++;
+	}
+
+	if (last) {
+		reass->size = end;
+	}
+
+	reass->received += len;
+
+	return 0;
+}
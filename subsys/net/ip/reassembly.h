@@ -0,0 +1,96 @@
+/** @file
+ * @brief Fragment reassembly range tracking
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __REASSEMBLY_H
+#define __REASSEMBLY_H
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Max number of disjoint byte ranges a single datagram can have pending */
+#if !defined(NET_REASS_MAX_RANGES)
+#define NET_REASS_MAX_RANGES 4
+#endif
+
+/** Received bytes [start, end) of a datagram */
+struct net_reass_range {
+	u16_t start;
+	u16_t end;
+};
+
+/**
+ * @brief Reassembly state of one datagram.
+ *
+ * The received parts are kept as a sorted list of non overlapping,
+ * non adjacent ranges. Fragments arriving in order just extend the last
+ * range, and as overlaps are refused the datagram is complete as soon as
+ * the received byte count reaches the datagram size.
+ */
+struct net_reass {
+	/** Received ranges, sorted by start offset */
+	struct net_reass_range range[NET_REASS_MAX_RANGES];
+
+	/** Total datagram size, 0 until known */
+	u16_t size;
+
+	/** Number of bytes received so far */
+	u16_t received;
+
+	/** Number of used entries in range[] */
+	u8_t count;
+};
+
+/**
+ * @brief Reset the reassembly state.
+ *
+ * @param reass Reassembly state
+ * @param size Total datagram size if known beforehand, 0 otherwise.
+ */
+void net_reass_init(struct net_reass *reass, u16_t size);
+
+/**
+ * @brief Record a received fragment.
+ *
+ * @param reass Reassembly state
+ * @param offset Offset of the fragment data in the datagram
+ * @param len Length of the fragment data
+ * @param last True if this fragment ends the datagram, which sets
+ *        the datagram size when it was not known yet.
+ *
+ * @return 0 if the fragment was recorded, -EEXIST if it overlaps already
+ * received data, -EINVAL if it does not fit the datagram size and
+ * -ENOMEM if there are too many holes to track.
+ */
+int net_reass_add(struct net_reass *reass, u32_t offset, u32_t len,
+		  bool last);
+
+/**
+ * @brief Check if the whole datagram has been received.
+ *
+ * @param reass Reassembly state
+ *
+ * @return True if all the bytes of the datagram are there.
+ */
+static inline bool net_reass_is_complete(const struct net_reass *reass)
+{
+	return reass->size > 0U && reass->received == reass->size;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __REASSEMBLY_H */
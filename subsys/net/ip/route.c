@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 
 #include <kernel.h>
 #include <limits.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <sys/slist.h>
 
@@ -256,10 +257,249 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
+#if defined(CONFIG_NET_ROUTE_CACHE_GEN)
+static atomic_t nexthop_cache_gen = ATOMIC_INIT(1);
+
+void net_route_nexthop_cache_flush(void)
+{
+	/* Skip 0 when wrapping around, it marks unused cache entries */
+	if (atomic_inc(&nexthop_cache_gen) == -1) {
+		atomic_inc(&nexthop_cache_gen);
+	}
+}
+
+u32_t net_route_nexthop_cache_gen(void)
+{
+	return (u32_t)atomic_get(&nexthop_cache_gen);
+}
+#endif /* CONFIG_NET_ROUTE_CACHE_GEN */
+
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+/* Path compressed binary trie of the route prefixes. Every node stands
+ * for a prefix and holds the routes having exactly that prefix. Its
+ * children have longer prefixes, continuing with a 0 or a 1 bit. Nodes
+ * without routes are only kept while they have two children, so there
+ * are never more than twice as many nodes as routes.
+ */
+struct net_route_trie_node {
+	struct net_route_trie_node *parent;
+	struct net_route_trie_node *child[2];
+
+	/** Routes to this prefix */
+	sys_slist_t routes;
+
+	/** The prefix, bits after the prefix length are zero */
+	struct in6_addr prefix;
+
+	u8_t len;
+	bool is_used;
+};
+
+static struct net_route_trie_node trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct net_route_trie_node *trie_root;
+
+static inline int addr_bit(const struct in6_addr *addr, u8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7 - pos % 8U)) & 1;
+}
+
+/* Number of leading bits the addresses have in common, at most max */
+static u8_t common_prefix_len(const struct in6_addr *a,
+			      const struct in6_addr *b, u8_t max)
+{
+	u8_t len = 0U;
+	int i;
+
+	for (i = 0; i < 16 && len < max; i++) {
+		u8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff) {
+			len += 8 - find_msb_set(diff);
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max);
+}
+
+static struct net_route_trie_node *trie_node_new(const struct in6_addr *addr,
+						 u8_t len)
+{
+	struct net_route_trie_node *node;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(trie_nodes); i++) {
+		node = &trie_nodes[i];
+
+		if (node->is_used) {
+			continue;
+		}
+
+		(void)memset(node, 0, sizeof(*node));
+
+		memcpy(node->prefix.s6_addr, addr->s6_addr, len / 8U);
+		if (len % 8U) {
+			node->prefix.s6_addr[len / 8U] = addr->s6_addr[len / 8U] &
+				(0xff << (8 - len % 8U));
+		}
+
+		node->len = len;
+		node->is_used = true;
+		sys_slist_init(&node->routes);
+
+		return node;
+	}
+
+	return NULL;
+}
+
+static int trie_insert(struct net_route_entry *route)
+{
+	struct net_route_trie_node **slot = &trie_root;
+	struct net_route_trie_node *parent = NULL;
+	struct net_route_trie_node *node, *split, *leaf;
+	u8_t len = route->prefix_len;
+	u8_t common;
+
+	while (*slot) {
+		node = *slot;
+
+		common = common_prefix_len(&node->prefix, &route->addr,
+					   MIN(node->len, len));
+		if (common < node->len) {
+			break;
+		}
+
+		if (node->len == len) {
+			goto add;
+		}
+
+		parent = node;
+		slot = &node->child[addr_bit(&route->addr, node->len)];
+	}
+
+	if (!*slot) {
+		node = trie_node_new(&route->addr, len);
+		if (!node) {
+			return -ENOMEM;
+		}
+
+		node->parent = parent;
+		*slot = node;
+
+		goto add;
+	}
+
+	/* The prefix of the node in the slot diverges from the route
+	 * prefix, or is longer than it. Put a node for their common part
+	 * in between, and the route either into that node or a new leaf.
+	 */
+	split = trie_node_new(&route->addr, common);
+	if (!split) {
+		return -ENOMEM;
+	}
+
+	if (common < len) {
+		leaf = trie_node_new(&route->addr, len);
+		if (!leaf) {
+			split->is_used = false;
+			return -ENOMEM;
+		}
+
+		leaf->parent = split;
+		split->child[addr_bit(&route->addr, common)] = leaf;
+	} else {
+		leaf = split;
+	}
+
+	split->parent = parent;
+	split->child[addr_bit(&node->prefix, common)] = node;
+	node->parent = split;
+	*slot = split;
+
+	node = leaf;
+
+add:
+	sys_slist_prepend(&node->routes, &route->trie_node);
+	route->trie = node;
+
+	return 0;
+}
+
+static void trie_remove(struct net_route_entry *route)
+{
+	struct net_route_trie_node *node = route->trie;
+
+	if (!node) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&node->routes, &route->trie_node);
+	route->trie = NULL;
+
+	/* Drop the nodes that neither hold routes nor branch anymore */
+	while (node && sys_slist_is_empty(&node->routes) &&
+	       !(node->child[0] && node->child[1])) {
+		struct net_route_trie_node *parent = node->parent;
+		struct net_route_trie_node *child;
+
+		child = node->child[0] ? node->child[0] : node->child[1];
+
+		if (!parent) {
+			trie_root = child;
+		} else if (parent->child[0] == node) {
+			parent->child[0] = child;
+		} else {
+			parent->child[1] = child;
+		}
+
+		if (child) {
+			child->parent = parent;
+		}
+
+		node->is_used = false;
+
+		/* The parent only lost a child if there was none to move up */
+		node = child ? NULL : parent;
+	}
+}
+
+static struct net_route_entry *trie_lookup(struct net_if *iface,
+					   struct in6_addr *dst)
+{
+	struct net_route_trie_node *node = trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node && net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+					  node->len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->len == 128U) {
+			break;
+		}
+
+		node = node->child[addr_bit(dst, node->len)];
+	}
+
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
+
 struct net_route_entry *net_route_lookup(struct net_if *iface,
 					 struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
+	struct net_route_entry *found = NULL;
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	found = trie_lookup(iface, dst);
+#else
+	struct net_route_entry *route;
 	u8_t longest_match = 0U;
 	int i;
 
@@ -284,6 +524,7 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 			longest_match = route->prefix_len;
 		}
 	}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
 
 	if (found) {
 		net_route_info("Found", found, dst);
@@ -400,6 +641,15 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route = net_route_data(nbr);
 	route->iface = iface;
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	if (trie_insert(route) < 0) {
+		NET_ERR("No route trie node available!");
+		net_nbr_unref(tmp);
+		nbr_free(nbr);
+		return NULL;
+	}
+#endif
+
 	sys_slist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
@@ -413,6 +663,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_info("Added", route, addr);
 
+	net_route_nexthop_cache_flush();
+
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
 	net_ipaddr_copy(&info.addr, addr);
 	net_ipaddr_copy(&info.nexthop, nexthop);
@@ -462,6 +714,12 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	trie_remove(route);
+#endif
+
+	net_route_nexthop_cache_flush();
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -763,6 +1021,169 @@ bool net_route_get_info(struct net_if *iface,
 	return false;
 }
 
+static int route_forward(struct net_pkt *pkt, struct net_nbr *nbr,
+			 struct net_linkaddr_storage *lladdr)
+{
+	net_pkt_set_forwarding(pkt, true);
+
+	/* The caller made sure the hop limit is bigger than 1 */
+	NET_IPV6_HDR(pkt)->hop_limit--;
+
+	/* Set the destination and source ll address in the packet.
+	 * We set the destination address to be the nexthop recipient.
+	 */
+	net_pkt_lladdr_src(pkt)->addr = net_pkt_lladdr_if(pkt)->addr;
+	net_pkt_lladdr_src(pkt)->type = net_pkt_lladdr_if(pkt)->type;
+	net_pkt_lladdr_src(pkt)->len = net_pkt_lladdr_if(pkt)->len;
+
+	net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
+	net_pkt_lladdr_dst(pkt)->type = lladdr->type;
+	net_pkt_lladdr_dst(pkt)->len = lladdr->len;
+
+	net_pkt_set_iface(pkt, nbr->iface);
+
+	return net_send_data(pkt);
+}
+
+#if defined(CONFIG_NET_ROUTING_FLOW_CACHE)
+/* Forwarded source and destination pairs. An entry is valid as long as
+ * the next hop cache generation is the same, and its neighbor still has
+ * the same address.
+ */
+struct net_route_flow {
+	struct in6_addr src;
+	struct in6_addr dst;
+	struct in6_addr nexthop;
+
+	/** Interface the flow arrives from */
+	struct net_if *iface;
+
+	/** Neighbor the flow is forwarded to */
+	struct net_nbr *nbr;
+
+	/** Uptime of the last packet, for replacing the oldest flow */
+	u32_t used;
+
+	/** Next hop cache generation, 0 for unused entries */
+	u32_t gen;
+};
+
+static struct net_route_flow flows[CONFIG_NET_ROUTING_FLOW_CACHE_SIZE];
+
+static void route_flow_add(struct net_pkt *pkt, struct in6_addr *nexthop,
+			   struct net_nbr *nbr)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	u32_t gen = net_route_nexthop_cache_gen();
+	struct net_route_flow *flow = &flows[0];
+	unsigned int key;
+	int i;
+
+	/* Replace the same flow, a stale one or the least recently used */
+	key = irq_lock();
+
+	for (i = 0; i < ARRAY_SIZE(flows); i++) {
+		if (flows[i].gen != gen ||
+		    (flows[i].iface == net_pkt_orig_iface(pkt) &&
+		     net_ipv6_addr_cmp(&flows[i].dst, &hdr->dst) &&
+		     net_ipv6_addr_cmp(&flows[i].src, &hdr->src))) {
+			flow = &flows[i];
+			break;
+		}
+
+		if ((s32_t)(flows[i].used - flow->used) < 0) {
+			flow = &flows[i];
+		}
+	}
+
+	net_ipaddr_copy(&flow->src, &hdr->src);
+	net_ipaddr_copy(&flow->dst, &hdr->dst);
+	net_ipaddr_copy(&flow->nexthop, nexthop);
+	flow->iface = net_pkt_orig_iface(pkt);
+	flow->nbr = nbr;
+	flow->used = k_uptime_get_32();
+	flow->gen = gen;
+
+	irq_unlock(key);
+}
+
+static struct net_nbr *route_flow_lookup(struct net_if *iface,
+					 struct net_ipv6_hdr *hdr,
+					 struct in6_addr *nexthop)
+{
+	u32_t gen = net_route_nexthop_cache_gen();
+	struct net_nbr *nbr = NULL;
+	unsigned int key;
+	int i;
+
+	key = irq_lock();
+
+	for (i = 0; i < ARRAY_SIZE(flows); i++) {
+		if (flows[i].gen == gen && flows[i].iface == iface &&
+		    net_ipv6_addr_cmp(&flows[i].dst, &hdr->dst) &&
+		    net_ipv6_addr_cmp(&flows[i].src, &hdr->src)) {
+			net_ipaddr_copy(nexthop, &flows[i].nexthop);
+			flows[i].used = k_uptime_get_32();
+			nbr = flows[i].nbr;
+			break;
+		}
+	}
+
+	irq_unlock(key);
+
+	return nbr;
+}
+
+enum net_verdict net_route_flow_forward(struct net_pkt *pkt)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	struct net_linkaddr_storage *lladdr;
+	struct in6_addr nexthop;
+	struct net_nbr *nbr;
+	int ret;
+
+	/* Anything unusual is left to the normal input path */
+	if (pkt->buffer->len < sizeof(struct net_ipv6_hdr) ||
+	    (hdr->vtc & 0xf0) != 0x60 || hdr->hop_limit <= 1U ||
+	    net_pkt_get_len(pkt) !=
+	    ntohs(hdr->len) + sizeof(struct net_ipv6_hdr)) {
+		return NET_CONTINUE;
+	}
+
+	nbr = route_flow_lookup(net_pkt_iface(pkt), hdr, &nexthop);
+	if (!nbr) {
+		return NET_CONTINUE;
+	}
+
+	/* The neighbor could have been removed or reused meanwhile */
+	if (!nbr->ref || nbr->idx == NET_NBR_LLADDR_UNKNOWN ||
+	    !net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, &nexthop)) {
+		return NET_CONTINUE;
+	}
+
+	/* An address of ours could have been added meanwhile */
+	if (net_ipv6_is_my_addr(&hdr->dst)) {
+		return NET_CONTINUE;
+	}
+
+	lladdr = net_nbr_get_lladdr(nbr->idx);
+
+	net_pkt_set_orig_iface(pkt, net_pkt_iface(pkt));
+
+	ret = route_forward(pkt, nbr, lladdr);
+	if (ret < 0) {
+		NET_DBG("Cannot forward pkt %p via %s at iface %p (%d)",
+			pkt, log_strdup(net_sprint_ipv6_addr(&nexthop)),
+			net_pkt_iface(pkt), ret);
+		return NET_DROP;
+	}
+
+	return NET_OK;
+}
+#else
+#define route_flow_add(...)
+#endif /* CONFIG_NET_ROUTING_FLOW_CACHE */
+
 int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 {
 	struct net_linkaddr_storage *lladdr;
@@ -806,22 +1227,9 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 	}
 #endif
 
-	net_pkt_set_forwarding(pkt, true);
+	route_flow_add(pkt, nexthop, nbr);
 
-	/* Set the destination and source ll address in the packet.
-	 * We set the destination address to be the nexthop recipient.
-	 */
-	net_pkt_lladdr_src(pkt)->addr = net_pkt_lladdr_if(pkt)->addr;
-	net_pkt_lladdr_src(pkt)->type = net_pkt_lladdr_if(pkt)->type;
-	net_pkt_lladdr_src(pkt)->len = net_pkt_lladdr_if(pkt)->len;
-
-	net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
-	net_pkt_lladdr_dst(pkt)->type = lladdr->type;
-	net_pkt_lladdr_dst(pkt)->len = lladdr->len;
-
-	net_pkt_set_iface(pkt, nbr->iface);
-
-	return net_send_data(pkt);
+	return route_forward(pkt, nbr, lladdr);
 }
 
 void net_route_init(void)
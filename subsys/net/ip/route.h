@@ -17,6 +17,7 @@
 #include <sys/slist.h>
 
 #include <net/net_ip.h>
+#include <net/net_core.h>
 
 #include "nbr.h"
 
@@ -24,6 +25,10 @@
 extern "C" {
 #endif
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+struct net_route_trie_node;
+#endif
+
 /**
  * @brief Next hop entry for a given route.
  */
@@ -59,6 +64,14 @@ struct net_route_entry {
 
 	/** IPv6 address/prefix length. */
 	u8_t prefix_len;
+
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	/** Trie node of the prefix of this route. */
+	struct net_route_trie_node *trie;
+
+	/** Node information in the list of routes of the trie node. */
+	sys_snode_t trie_node;
+#endif
 };
 
 /**
@@ -251,6 +264,54 @@ bool net_route_get_info(struct net_if *iface,
  */
 int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
 
+#if defined(CONFIG_NET_ROUTE_CACHE_GEN)
+/**
+ * @brief Invalidate the next hops cached in network contexts and the
+ * forwarded flows.
+ *
+ * @details To be called whenever a change in routes, routers or on-link
+ * prefixes may change the next hop of some destination.
+ */
+void net_route_nexthop_cache_flush(void);
+
+/**
+ * @brief Return the generation of cached next hops.
+ *
+ * @details A next hop cached while this returned some value is still
+ * valid as long as it keeps returning the same value. The value is never
+ * 0, so a zero initialized cache entry is always invalid.
+ *
+ * @return Current next hop cache generation.
+ */
+u32_t net_route_nexthop_cache_gen(void);
+#else
+#define net_route_nexthop_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE_GEN */
+
+#if defined(CONFIG_NET_ROUTING_FLOW_CACHE)
+/**
+ * @brief Forward a packet of an already known flow.
+ *
+ * @details Called for received packets once the link layer is done with
+ * them. If the source and destination of the IPv6 packet match a flow
+ * forwarded earlier by net_route_packet(), the packet is sent to the
+ * same neighbor right away.
+ *
+ * @param pkt Received network packet.
+ *
+ * @return NET_OK if the packet was forwarded, NET_DROP if forwarding it
+ * failed, NET_CONTINUE if the packet needs the normal input processing.
+ */
+enum net_verdict net_route_flow_forward(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_route_flow_forward(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_CONTINUE;
+}
+#endif /* CONFIG_NET_ROUTING_FLOW_CACHE */
+
 #if defined(CONFIG_NET_ROUTE)
 void net_route_init(void);
 #else
@@ -52,6 +52,10 @@ static struct tcp_backlog_entry {
 	struct k_delayed_work ack_timer;
 	struct sockaddr remote;
 	u16_t send_mss;
+	/* Options negotiated in the SYN, NET_TCP_*_ON flags */
+	u8_t opt_flags;
+	u8_t send_wscale;
+	u32_t ts_recent;
 } tcp_backlog[CONFIG_NET_TCP_BACKLOG_SIZE];
 
 #if defined(CONFIG_NET_TCP_ACK_TIMEOUT)
@@ -161,10 +165,25 @@ static void net_tcp_trace(struct net_pkt *pkt,
 		ntohs(tcp_hdr->chksum));
 }
 
+/* RFC 6298 2.4 and 2.5 bounds, the lower one as used by Linux */
+#define RTO_MIN 200
+#define RTO_MAX (60 * MSEC_PER_SEC)
+
+/* Flags of the options that are negotiated in the SYN */
+#define NET_TCP_SYN_OPT_FLAGS (NET_TCP_WSCALE_ON | NET_TCP_SACK_ON | \
+			       NET_TCP_TS_ON)
+
 static inline u32_t retry_timeout(const struct net_tcp *tcp)
 {
-	return ((u32_t)1 << tcp->retry_timeout_shift) *
-				CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+	u32_t rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (tcp->rto) {
+		rto = tcp->rto;
+	}
+#endif
+
+	return ((u32_t)1 << tcp->retry_timeout_shift) * rto;
 }
 
 #define is_6lo_technology(pkt)						\
@@ -195,6 +214,449 @@ static inline u32_t retry_timeout(const struct net_tcp *tcp)
 		}							\
 	} while (0)
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define RECV_WSCALE CONFIG_NET_TCP_WINDOW_SCALE_SHIFT
+#else
+#define RECV_WSCALE 0
+#endif
+
+/* Sequence space taken by a packet of sent_list: its first sequence
+ * number and the number of sequence numbers it covers, SYN and FIN
+ * counting as one each.
+ */
+static int sent_pkt_seq(struct net_pkt *pkt, u32_t *seq, u32_t *seq_len,
+			u8_t *flags)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv6_ext_len(pkt))) {
+		return -EMSGSIZE;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -EMSGSIZE;
+	}
+
+	*seq = sys_get_be32(tcp_hdr->seq);
+	*flags = tcp_hdr->flags;
+	hdr_len = NET_TCP_HDR_LEN(tcp_hdr);
+
+	net_pkt_acknowledge_data(pkt, &tcp_access);
+	*seq_len = net_pkt_remaining_data(pkt);
+
+	/* Options do not take sequence space */
+	if (hdr_len > sizeof(struct net_tcp_hdr)) {
+		*seq_len -= MIN(*seq_len, hdr_len - sizeof(struct net_tcp_hdr));
+	}
+
+	if (*flags & NET_TCP_SYN) {
+		*seq_len += 1U;
+	}
+	if (*flags & NET_TCP_FIN) {
+		*seq_len += 1U;
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL) || \
+	defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* First sequence number not acknowledged by the peer */
+static u32_t tcp_snd_una(struct net_tcp *tcp)
+{
+	sys_snode_t *head = sys_slist_peek_head(&tcp->sent_list);
+	u32_t seq, seq_len;
+	u8_t flags;
+
+	if (!head || sent_pkt_seq(CONTAINER_OF(head, struct net_pkt, sent_list),
+				  &seq, &seq_len, &flags) < 0) {
+		return tcp->send_seq;
+	}
+
+	return seq;
+}
+#endif
+
+/* (Re)transmit a packet of sent_list. Once the driver has released a
+ * packet it needs a new reference, as it is released again when sent.
+ */
+static int tcp_send_sent_list_pkt(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	int ret;
+
+	if (net_pkt_sent(pkt)) {
+		do_ref_if_needed(tcp, pkt);
+		net_pkt_set_sent(pkt, false);
+	}
+
+	net_pkt_set_queued(pkt, true);
+
+	ret = net_tcp_send_pkt(pkt);
+	if (ret < 0 && !is_6lo_technology(pkt)) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+/* A packet of sent_list is in flight while it waits in the TX queue
+ * (queued) and once the driver has sent it (sent). net_if_tx() clears
+ * the former when setting the latter, except for 6lo technologies that
+ * send a copy and so leave the packet queued.
+ */
+static inline bool sent_pkt_in_flight(struct net_pkt *pkt)
+{
+	return net_pkt_queued(pkt) || net_pkt_sent(pkt);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static bool tcp_is_sacked(struct net_tcp *tcp, u32_t seq, u32_t seq_len)
+{
+	int i;
+
+	for (i = 0; i < tcp->sacked_count; i++) {
+		if (net_tcp_seq_cmp(seq, tcp->sacked[i].left) >= 0 &&
+		    net_tcp_seq_cmp(seq + seq_len, tcp->sacked[i].right) <= 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Highest sequence number the peer reported as received, or ack */
+static u32_t tcp_sack_high(struct net_tcp *tcp, u32_t ack)
+{
+	u32_t high = ack;
+	int i;
+
+	for (i = 0; i < tcp->sacked_count; i++) {
+		if (net_tcp_seq_greater(tcp->sacked[i].right, high)) {
+			high = tcp->sacked[i].right;
+		}
+	}
+
+	return high;
+}
+
+/* The scoreboard only holds the blocks of the latest ACK: the peer
+ * repeats the most recent blocks in every ACK (RFC 2018 4), and
+ * segments are retransmitted at most once per ACK anyway.
+ */
+static void tcp_sack_update(struct net_tcp *tcp,
+			    const struct net_tcp_options *opts, u32_t ack)
+{
+	int i;
+
+	tcp->sacked_count = 0U;
+
+	for (i = 0; i < opts->sack_count; i++) {
+		const struct net_tcp_sack_block *block = &opts->sack[i];
+
+		if (!net_tcp_seq_greater(block->right, block->left) ||
+		    !net_tcp_seq_greater(block->left, ack) ||
+		    net_tcp_seq_greater(block->right, tcp->send_seq)) {
+			continue;
+		}
+
+		tcp->sacked[tcp->sacked_count++] = *block;
+	}
+}
+#else
+#define tcp_is_sacked(...) false
+#define tcp_sack_high(tcp, ack) (ack)
+#define tcp_sack_update(...)
+#endif /* CONFIG_NET_TCP_SACK */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Bytes sent and not acknowledged yet; high is set to the sequence
+ * number following the highest one sent.
+ */
+static u32_t tcp_flight_size(struct net_tcp *tcp, u32_t *high)
+{
+	struct net_pkt *pkt;
+	u32_t flight = 0U;
+	u32_t seq, seq_len;
+	u8_t flags;
+
+	*high = tcp->send_seq;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (!sent_pkt_in_flight(pkt) ||
+		    sent_pkt_seq(pkt, &seq, &seq_len, &flags) < 0) {
+			continue;
+		}
+
+		flight += seq_len;
+		*high = seq + seq_len;
+	}
+
+	return flight;
+}
+
+static void tcp_cwnd_init(struct net_tcp *tcp)
+{
+	u32_t mss = tcp->send_mss;
+
+	/* RFC 5681 3.1 initial window */
+	if (mss > 2190) {
+		tcp->cwnd = 2U * mss;
+	} else if (mss > 1095) {
+		tcp->cwnd = 3U * mss;
+	} else {
+		tcp->cwnd = 4U * mss;
+	}
+
+	tcp->ssthresh = UINT32_MAX;
+	tcp->dup_acks = 0U;
+	tcp->flags &= ~NET_TCP_IN_RECOVERY;
+}
+
+/* Retransmit the first unacknowledged segment and, when the peer sends
+ * SACK blocks, every other segment below the highest one it reported
+ * as received that no block covers (the "holes" of RFC 6675).
+ */
+static void tcp_retransmit_holes(struct net_tcp *tcp, u32_t ack)
+{
+	u32_t sack_high = tcp_sack_high(tcp, ack);
+	bool first = true;
+	struct net_pkt *pkt;
+	u32_t seq, seq_len;
+	u8_t flags;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (!sent_pkt_in_flight(pkt) ||
+		    sent_pkt_seq(pkt, &seq, &seq_len, &flags) < 0) {
+			break;
+		}
+
+		if (!first) {
+			if (!net_tcp_seq_greater(sack_high, seq)) {
+				break;
+			}
+
+			if (tcp_is_sacked(tcp, seq, seq_len)) {
+				continue;
+			}
+		}
+
+		first = false;
+
+		/* Still in the TX queue, sending it again now would
+		 * release it twice.
+		 */
+		if (net_pkt_queued(pkt) && !is_6lo_technology(pkt)) {
+			continue;
+		}
+
+		NET_DBG("[%p] fast retransmit pkt %p seq %u", tcp, pkt, seq);
+
+		if (tcp_send_sent_list_pkt(tcp, pkt) >= 0 &&
+		    IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
+		    !is_6lo_technology(pkt)) {
+			net_stats_update_tcp_seg_rexmit(net_pkt_iface(pkt));
+		}
+	}
+}
+
+/* New data has been acknowledged, RFC 5681 3.1 and RFC 6582 3.2 */
+static void tcp_cwnd_ack(struct net_tcp *tcp, u32_t ack, u32_t acked)
+{
+	u32_t mss = tcp->send_mss;
+	u32_t high;
+
+	if (tcp->flags & NET_TCP_IN_RECOVERY) {
+		if (net_tcp_seq_cmp(ack, tcp->recover) >= 0) {
+			/* Full acknowledgment, deflate the window */
+			tcp->cwnd = MIN(tcp->ssthresh,
+					MAX(tcp_flight_size(tcp, &high), mss) +
+					mss);
+			tcp->flags &= ~NET_TCP_IN_RECOVERY;
+			tcp->dup_acks = 0U;
+
+			NET_DBG("[%p] fast recovery done, cwnd %u", tcp,
+				tcp->cwnd);
+		} else {
+			/* Partial acknowledgment, the next segment is lost
+			 * too.
+			 */
+			tcp_retransmit_holes(tcp, ack);
+
+			tcp->cwnd -= MIN(tcp->cwnd, acked);
+			if (acked >= mss) {
+				tcp->cwnd += mss;
+			}
+		}
+
+		return;
+	}
+
+	tcp->dup_acks = 0U;
+
+	if (tcp->cwnd >= UINT32_MAX / 2U) {
+		return;
+	}
+
+	if (tcp->cwnd < tcp->ssthresh) {
+		/* Slow start */
+		tcp->cwnd += MIN(acked, mss);
+	} else {
+		/* Congestion avoidance */
+		tcp->cwnd += MAX(mss * mss / tcp->cwnd, 1U);
+	}
+}
+
+/* RFC 5681 2: an ACK is a duplicate if it acknowledges nothing new,
+ * carries neither data nor SYN/FIN, leaves the window unchanged, and
+ * there is outstanding data.
+ */
+static bool tcp_is_dup_ack(struct net_tcp *tcp, struct net_tcp_hdr *tcp_hdr,
+			   u16_t data_len, u32_t wnd)
+{
+	sys_snode_t *head = sys_slist_peek_head(&tcp->sent_list);
+
+	if (data_len || (NET_TCP_FLAGS(tcp_hdr) & (NET_TCP_SYN | NET_TCP_FIN)) ||
+	    wnd != tcp->send_wnd || !head ||
+	    !sent_pkt_in_flight(CONTAINER_OF(head, struct net_pkt,
+					     sent_list))) {
+		return false;
+	}
+
+	return sys_get_be32(tcp_hdr->ack) == tcp_snd_una(tcp);
+}
+
+static void tcp_dup_ack(struct net_tcp *tcp, u32_t ack)
+{
+	u32_t mss = tcp->send_mss;
+
+	if (tcp->flags & NET_TCP_IN_RECOVERY) {
+		/* Every duplicate means a segment has left the network */
+		tcp->cwnd += mss;
+		return;
+	}
+
+	if (++tcp->dup_acks < 3) {
+		return;
+	}
+
+	/* Fast retransmit, RFC 5681 3.2 */
+	tcp->ssthresh = MAX(tcp_flight_size(tcp, &tcp->recover) / 2U,
+			    2U * mss);
+	tcp->cwnd = tcp->ssthresh + 3U * mss;
+	tcp->flags |= NET_TCP_IN_RECOVERY;
+
+	NET_DBG("[%p] 3 dup ACKs, ssthresh %u cwnd %u recover %u", tcp,
+		tcp->ssthresh, tcp->cwnd, tcp->recover);
+
+	tcp_retransmit_holes(tcp, ack);
+}
+
+/* The retransmission timer expired, RFC 5681 3.1 */
+static void tcp_cwnd_timeout(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+	u32_t high;
+
+	/* Only the first timeout of a segment halves ssthresh */
+	if (tcp->retry_timeout_shift == 1U) {
+		tcp->ssthresh = MAX(tcp_flight_size(tcp, &high) / 2U,
+				    2U * tcp->send_mss);
+	}
+
+	tcp->cwnd = tcp->send_mss;
+	tcp->dup_acks = 0U;
+	tcp->flags &= ~NET_TCP_IN_RECOVERY;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* RFC 2018 8: SACK information is ignored after a timeout */
+	tcp->sacked_count = 0U;
+#endif
+
+	/* Everything after the first segment is sent again as the
+	 * congestion window opens up.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (pkt == CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
+					struct net_pkt, sent_list)) {
+			continue;
+		}
+
+		/* Turn it back into a packet waiting to be sent, which
+		 * holds one reference for the driver.
+		 */
+		if (is_6lo_technology(pkt)) {
+			net_pkt_set_queued(pkt, false);
+		} else if (net_pkt_sent(pkt)) {
+			do_ref_if_needed(tcp, pkt);
+			net_pkt_set_sent(pkt, false);
+		}
+	}
+}
+#else
+#define tcp_cwnd_init(...)
+#define tcp_cwnd_ack(...)
+#define tcp_cwnd_timeout(...)
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* RFC 6298 2, srtt and rttvar are kept scaled by 8 and 4 */
+static void tcp_rtt_update(struct net_tcp *tcp, u32_t rtt)
+{
+	s32_t err;
+
+	if (!tcp->rto) {
+		tcp->srtt = rtt << 3;
+		tcp->rttvar = rtt << 1;
+	} else {
+		err = rtt - (tcp->srtt >> 3);
+		tcp->srtt += err;
+		if (err < 0) {
+			err = -err;
+		}
+
+		err -= tcp->rttvar >> 2;
+		tcp->rttvar += err;
+	}
+
+	tcp->rto = MIN(MAX((tcp->srtt >> 3) + tcp->rttvar, RTO_MIN), RTO_MAX);
+}
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
+/* Note which of the options negotiated in a SYN the peer sent in its
+ * SYN or SYN-ACK. A SYN-ACK only carries the ones we offered.
+ */
+static void tcp_set_peer_syn_opts(struct net_tcp *tcp,
+				  const struct net_tcp_options *opts)
+{
+	tcp->flags &= ~NET_TCP_SYN_OPT_FLAGS;
+	tcp->send_wscale = 0U;
+	tcp->recv_wscale = 0U;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && opts->wscale_set) {
+		tcp->flags |= NET_TCP_WSCALE_ON;
+		tcp->send_wscale = MIN(opts->wscale, NET_TCP_MAX_WINDOW_SCALE);
+		tcp->recv_wscale = RECV_WSCALE;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && opts->sack_perm) {
+		tcp->flags |= NET_TCP_SACK_ON;
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (opts->ts_set) {
+		tcp->flags |= NET_TCP_TS_ON;
+		tcp->ts_recent = opts->tsval;
+	}
+#endif
+}
+
 static void abort_connection(struct net_tcp *tcp)
 {
 	struct net_context *ctx = tcp->context;
@@ -228,20 +690,15 @@ static void tcp_retry_expired(struct k_work *work)
 
 		k_delayed_work_submit(&tcp->retry_timer, retry_timeout(tcp));
 
+		tcp_cwnd_timeout(tcp);
+
 		pkt = CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
 				   struct net_pkt, sent_list);
 
-		if (net_pkt_sent(pkt)) {
-			do_ref_if_needed(tcp, pkt);
-			net_pkt_set_sent(pkt, false);
-		}
-
-		net_pkt_set_queued(pkt, true);
-
-		if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
+		if (tcp_send_sent_list_pkt(tcp, pkt) < 0 &&
+		    !is_6lo_technology(pkt)) {
 			NET_DBG("retry %u: [%p] pkt %p send failed",
 				tcp->retry_timeout_shift, tcp, pkt);
-			net_pkt_unref(pkt);
 		} else {
 			NET_DBG("retry %u: [%p] sent pkt %p",
 				tcp->retry_timeout_shift, tcp, pkt);
@@ -285,7 +742,9 @@ struct net_tcp *net_tcp_alloc(struct net_context *context)
 
 	tcp_context[i].send_seq = tcp_init_isn();
 	tcp_context[i].recv_wnd = MIN(NET_TCP_MAX_WIN, NET_TCP_BUF_MAX_LEN);
+	tcp_context[i].send_wnd = UINT16_MAX;
 	tcp_context[i].send_mss = NET_TCP_DEFAULT_MSS;
+	tcp_cwnd_init(&tcp_context[i]);
 
 	tcp_context[i].accept_cb = NULL;
 
@@ -511,6 +970,46 @@ u32_t net_tcp_get_recv_wnd(const struct net_tcp *tcp)
 	return tcp->recv_wnd;
 }
 
+/* Window to advertise in the next segment. While the RX pool is low the
+ * peer may only send one more segment, but as required by RFC 1122
+ * 4.2.2.16 the right edge advertised earlier is never moved back.
+ */
+static u32_t tcp_adv_wnd(struct net_tcp *tcp)
+{
+	u32_t wnd = net_tcp_get_recv_wnd(tcp);
+
+#if defined(CONFIG_NET_PKT_WATERMARKS)
+	if (net_pkt_rx_pool_is_low()) {
+		s32_t left = tcp->recv_wnd_edge - tcp->send_ack;
+
+		left = MAX(left, (s32_t)net_tcp_get_recv_mss(tcp));
+		wnd = MIN(wnd, (u32_t)left);
+	}
+
+	tcp->recv_wnd_edge = tcp->send_ack + wnd;
+#endif
+
+	return wnd;
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Two NOPs keep the timestamps 32-bit aligned (RFC 7323 appendix A) */
+static void net_tcp_set_ts_opt(struct net_tcp *tcp, u8_t *options,
+			       u8_t *optionlen)
+{
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_TIMESTAMP_OPT;
+	options[(*optionlen)++] = NET_TCP_TIMESTAMP_SIZE;
+
+	sys_put_be32(k_uptime_get_32(), options + *optionlen);
+	*optionlen += sizeof(u32_t);
+
+	sys_put_be32(tcp->ts_recent, options + *optionlen);
+	*optionlen += sizeof(u32_t);
+}
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
 int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 			    void *options, size_t optlen,
 			    const struct sockaddr_ptr *local,
@@ -518,6 +1017,9 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 			    struct net_pkt **send_pkt)
 {
 	struct tcp_segment segment = { 0 };
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	u8_t ts_options[NET_TCP_MAX_OPT_SIZE];
+#endif
 	u32_t seq;
 	u16_t wnd;
 	int status;
@@ -526,6 +1028,27 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 		local = &tcp->context->local;
 	}
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Once negotiated, timestamps are sent in every segment but RST,
+	 * SYN segments put them in place themselves.
+	 */
+	if ((tcp->flags & NET_TCP_TS_ON) &&
+	    !(flags & (NET_TCP_SYN | NET_TCP_RST)) &&
+	    optlen + 2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE <=
+	    sizeof(ts_options)) {
+		u8_t len = optlen;
+
+		if (optlen) {
+			memcpy(ts_options, options, optlen);
+		}
+
+		net_tcp_set_ts_opt(tcp, ts_options, &len);
+
+		options = ts_options;
+		optlen = len;
+	}
+#endif
+
 	seq = tcp->send_seq;
 
 	if (flags & NET_TCP_ACK) {
@@ -564,7 +1087,12 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 		}
 	}
 
-	wnd = net_tcp_get_recv_wnd(tcp);
+	/* RFC 7323 2.2: the window in a SYN segment is never scaled */
+	if (flags & NET_TCP_SYN) {
+		wnd = MIN(tcp_adv_wnd(tcp), UINT16_MAX);
+	} else {
+		wnd = MIN(tcp_adv_wnd(tcp) >> tcp->recv_wscale, UINT16_MAX);
+	}
 
 	segment.src_addr = (struct sockaddr_ptr *)local;
 	segment.dst_addr = remote;
@@ -657,6 +1185,15 @@ u16_t net_tcp_get_recv_mss(const struct net_tcp *tcp)
 	return 0;
 }
 
+/* A SYN offers every option we support, a SYN-ACK only accepts the
+ * ones offered by the peer.
+ */
+static inline bool syn_opt_wanted(struct net_tcp *tcp, u8_t flag)
+{
+	return net_tcp_get_state(tcp) != NET_TCP_SYN_RCVD ||
+		(tcp->flags & flag);
+}
+
 static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
 				u8_t *optionlen)
 {
@@ -664,18 +1201,39 @@ static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
 
 	*optionlen = 0U;
 
-	if (!(tcp->flags & NET_TCP_RECV_MSS_SET)) {
-		recv_mss = net_tcp_get_recv_mss(tcp);
-		tcp->flags |= NET_TCP_RECV_MSS_SET;
-	} else {
-		recv_mss = 0U;
-	}
+	/* The SYN-ACK of a listening context is sent for every incoming
+	 * connection, so always advertise the actual MSS.
+	 */
+	recv_mss = net_tcp_get_recv_mss(tcp);
+	tcp->flags |= NET_TCP_RECV_MSS_SET;
 
 	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
 	UNALIGNED_PUT(htonl(recv_mss),
 		      (u32_t *)(options + *optionlen));
 
 	*optionlen += NET_TCP_MSS_SIZE;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    syn_opt_wanted(tcp, NET_TCP_WSCALE_ON)) {
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_WINDOW_SCALE_OPT;
+		options[(*optionlen)++] = NET_TCP_WINDOW_SCALE_SIZE;
+		options[(*optionlen)++] = RECV_WSCALE;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    syn_opt_wanted(tcp, NET_TCP_SACK_ON)) {
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_SACK_PERM_OPT;
+		options[(*optionlen)++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (syn_opt_wanted(tcp, NET_TCP_TS_ON)) {
+		net_tcp_set_ts_opt(tcp, options, optionlen);
+	}
+#endif
 }
 
 int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
@@ -802,6 +1360,23 @@ const char *net_tcp_state_str(enum net_tcp_state state)
 	return "";
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Payload of the segments a super-segment is split into: each of them
+ * has to fit both the peer MSS and our MTU, along with the options
+ * every segment carries.
+ */
+static u16_t tcp_gso_size(struct net_tcp *tcp)
+{
+	u16_t mss = MIN(tcp->send_mss, net_tcp_get_recv_mss(tcp));
+
+	if (tcp->flags & NET_TCP_TS_ON) {
+		mss -= 2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE;
+	}
+
+	return mss;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 {
 	struct net_conn *conn = (struct net_conn *)context->conn_handler;
@@ -831,6 +1406,12 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 
 	context->tcp->send_seq += data_len;
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (data_len > tcp_gso_size(context->tcp)) {
+		net_pkt_set_gso_size(pkt, tcp_gso_size(context->tcp));
+	}
+#endif
+
 	net_stats_update_tcp_sent(net_pkt_iface(pkt), data_len);
 
 	return net_tcp_queue_pkt(context, pkt);
@@ -992,38 +1573,68 @@ static void restart_timer(struct net_tcp *tcp)
 	}
 }
 
-int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
-		      void *user_data)
+/* Send the packets of sent_list that have not been sent yet. With
+ * congestion control, only as far as the peer receive window and the
+ * congestion window allow; the rest goes out as ACKs come in.
+ */
+static void tcp_send_queued(struct net_tcp *tcp)
 {
 	struct net_pkt *pkt;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	u32_t wnd = MIN(tcp->send_wnd, tcp->cwnd);
+	u32_t flight = 0U;
+#endif
 
-	/* For now, just send all queued data synchronously.  Need to
-	 * add window handling and retry/ACK logic.
-	 */
-	SYS_SLIST_FOR_EACH_CONTAINER(&context->tcp->sent_list, pkt, sent_list) {
-		/* Do not resend packets that were sent by expire timer */
-		if (net_pkt_queued(pkt)) {
-			NET_DBG("[%p] Skipping pkt %p because it was already "
-				"sent.", context->tcp, pkt);
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		int ret;
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		u32_t seq, seq_len;
+		u8_t flags;
+
+		if (sent_pkt_seq(pkt, &seq, &seq_len, &flags) < 0) {
+			seq_len = 0U;
+		}
+
+		if (sent_pkt_in_flight(pkt)) {
+			flight += seq_len;
 			continue;
 		}
 
-		if (!net_pkt_sent(pkt)) {
-			int ret;
+		/* A segment larger than the window is still sent when
+		 * nothing is in flight, a closed window is probed by the
+		 * retransmission timer.
+		 */
+		if (flight + seq_len > wnd && (flight || !wnd)) {
+			NET_DBG("[%p] window full (flight %u wnd %u)", tcp,
+				flight, wnd);
+			break;
+		}
 
-			NET_DBG("[%p] Sending pkt %p (%zd bytes)", context->tcp,
-				pkt, net_pkt_get_len(pkt));
+		flight += seq_len;
+#else
+		/* Do not resend packets that were sent by expire timer */
+		if (sent_pkt_in_flight(pkt)) {
+			NET_DBG("[%p] Skipping pkt %p because it was already "
+				"sent.", tcp, pkt);
+			continue;
+		}
+#endif
 
-			ret = net_tcp_send_pkt(pkt);
-			if (ret < 0 && !is_6lo_technology(pkt)) {
-				NET_DBG("[%p] pkt %p not sent (%d)",
-					context->tcp, pkt, ret);
-				net_pkt_unref(pkt);
-			}
+		NET_DBG("[%p] Sending pkt %p (%zd bytes)", tcp, pkt,
+			net_pkt_get_len(pkt));
 
-			net_pkt_set_queued(pkt, true);
+		ret = tcp_send_sent_list_pkt(tcp, pkt);
+		if (ret < 0 && !is_6lo_technology(pkt)) {
+			NET_DBG("[%p] pkt %p not sent (%d)", tcp, pkt, ret);
 		}
 	}
+}
+
+int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
+		      void *user_data)
+{
+	tcp_send_queued(context->tcp);
 
 	/* Just make the callback synchronously even if it didn't
 	 * go over the wire.  In theory it would be nice to track
@@ -1045,6 +1656,7 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 	sys_snode_t *head;
 	struct net_pkt *pkt;
 	bool valid_ack = false;
+	u32_t acked = 0U;
 
 	if (net_tcp_seq_greater(ack, ctx->tcp->send_seq)) {
 		NET_ERR("ctx %p: ACK for unsent data", ctx);
@@ -1057,27 +1669,15 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 	}
 
 	while (!sys_slist_is_empty(list)) {
-		NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
-		struct net_tcp_hdr *tcp_hdr;
 		u32_t last_seq;
 		u32_t seq_len;
+		u32_t seq;
+		u8_t flags;
 
 		head = sys_slist_peek_head(list);
 		pkt = CONTAINER_OF(head, struct net_pkt, sent_list);
 
-		net_pkt_cursor_init(pkt);
-		net_pkt_set_overwrite(pkt, true);
-
-		if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
-			 net_pkt_ipv6_ext_len(pkt))) {
-			sys_slist_remove(list, NULL, head);
-			net_pkt_unref(pkt);
-			continue;
-		}
-
-		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt,
-								 &tcp_access);
-		if (!tcp_hdr) {
+		if (sent_pkt_seq(pkt, &seq, &seq_len, &flags) < 0) {
 			/* The pkt does not contain TCP header, this should
 			 * not happen.
 			 */
@@ -1087,21 +1687,8 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 			continue;
 		}
 
-		net_pkt_acknowledge_data(pkt, &tcp_access);
-		seq_len = net_pkt_remaining_data(pkt);
-
-		/* Each of SYN and FIN flags are counted
-		 * as one sequence number.
-		 */
-		if (tcp_hdr->flags & NET_TCP_SYN) {
-			seq_len += 1U;
-		}
-		if (tcp_hdr->flags & NET_TCP_FIN) {
-			seq_len += 1U;
-		}
-
 		/* Last sequence number in this packet. */
-		last_seq = sys_get_be32(tcp_hdr->seq) + seq_len - 1;
+		last_seq = seq + seq_len - 1;
 
 		/* Ack number should be strictly greater to acknowledged numbers
 		 * below it. For example, ack no. 10 acknowledges all numbers up
@@ -1111,7 +1698,7 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 			break;
 		}
 
-		if (tcp_hdr->flags & NET_TCP_FIN) {
+		if (flags & NET_TCP_FIN) {
 			enum net_tcp_state s = net_tcp_get_state(tcp);
 
 			if (s == NET_TCP_FIN_WAIT_1) {
@@ -1124,6 +1711,7 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		sys_slist_remove(list, NULL, head);
 		net_pkt_unref(pkt);
 		valid_ack = true;
+		acked += seq_len;
 	}
 
 	/* Restart the timer (if needed) on a valid inbound ACK.  This isn't
@@ -1134,6 +1722,7 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 	 */
 	if (valid_ack) {
 		restart_timer(ctx->tcp);
+		tcp_cwnd_ack(tcp, ack, acked);
 	}
 
 	return true;
@@ -1338,6 +1927,56 @@ int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 				goto error;
 			}
 
+			break;
+		case NET_TCP_WINDOW_SCALE_OPT:
+			if (optlen != NET_TCP_WINDOW_SCALE_SIZE - 2U) {
+				goto error;
+			}
+
+			if (net_pkt_read_u8(pkt, &opts->wscale)) {
+				goto error;
+			}
+
+			opts->wscale_set = 1U;
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (optlen != NET_TCP_SACK_PERM_SIZE - 2U) {
+				goto error;
+			}
+
+			opts->sack_perm = 1U;
+			break;
+		case NET_TCP_SACK_OPT: {
+			int i;
+
+			if (optlen == 0U || optlen % 8U ||
+			    optlen > NET_TCP_SACK_BLOCKS * 8U) {
+				goto error;
+			}
+
+			for (i = 0; i < optlen / 8U; i++) {
+				if (net_pkt_read_be32(pkt,
+						      &opts->sack[i].left) ||
+				    net_pkt_read_be32(pkt,
+						      &opts->sack[i].right)) {
+					goto error;
+				}
+			}
+
+			opts->sack_count = i;
+			break;
+		}
+		case NET_TCP_TIMESTAMP_OPT:
+			if (optlen != NET_TCP_TIMESTAMP_SIZE - 2U) {
+				goto error;
+			}
+
+			if (net_pkt_read_be32(pkt, &opts->tsval) ||
+			    net_pkt_read_be32(pkt, &opts->tsecr)) {
+				goto error;
+			}
+
+			opts->ts_set = 1U;
 			break;
 		default:
 			if (net_pkt_skip(pkt, optlen)) {
@@ -1430,7 +2069,8 @@ int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta)
 	}
 
 	new_win = context->tcp->recv_wnd + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
+	if (new_win < 0 ||
+	    new_win > ((s32_t)UINT16_MAX << context->tcp->recv_wscale)) {
 		return -EINVAL;
 	}
 
@@ -1577,6 +2217,12 @@ static int tcp_backlog_syn(struct net_pkt *pkt,
 	tcp_backlog[empty_slot].send_seq = context->tcp->send_seq;
 	tcp_backlog[empty_slot].send_ack = context->tcp->send_ack;
 	tcp_backlog[empty_slot].send_mss = send_mss;
+	tcp_backlog[empty_slot].opt_flags = context->tcp->flags &
+					    NET_TCP_SYN_OPT_FLAGS;
+	tcp_backlog[empty_slot].send_wscale = context->tcp->send_wscale;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	tcp_backlog[empty_slot].ts_recent = context->tcp->ts_recent;
+#endif
 
 	k_delayed_work_init(&tcp_backlog[empty_slot].ack_timer,
 			    backlog_ack_timeout);
@@ -1608,6 +2254,20 @@ static int tcp_backlog_ack(struct net_pkt *pkt,
 	context->tcp->send_ack = tcp_backlog[r].send_ack;
 	context->tcp->send_mss = tcp_backlog[r].send_mss;
 
+	context->tcp->flags |= tcp_backlog[r].opt_flags;
+	if (context->tcp->flags & NET_TCP_WSCALE_ON) {
+		context->tcp->send_wscale = tcp_backlog[r].send_wscale;
+		context->tcp->recv_wscale = RECV_WSCALE;
+	}
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	context->tcp->ts_recent = tcp_backlog[r].ts_recent;
+#endif
+
+	/* The window in this ACK is scaled already */
+	context->tcp->send_wnd = (u32_t)sys_get_be16(tcp_hdr->wnd) <<
+				 context->tcp->send_wscale;
+	tcp_cwnd_init(context->tcp);
+
 	k_delayed_work_cancel(&tcp_backlog[r].ack_timer);
 	(void)memset(&tcp_backlog[r], 0, sizeof(struct tcp_backlog_entry));
 
@@ -1796,7 +2456,7 @@ static inline int send_syn_segment(struct net_context *context,
 	u8_t options[NET_TCP_MAX_OPT_SIZE];
 	u8_t optionlen = 0U;
 
-	if (flags == NET_TCP_SYN) {
+	if (flags & NET_TCP_SYN) {
 		net_tcp_set_syn_opt(context->tcp, options, &optionlen);
 	}
 
@@ -1918,9 +2578,11 @@ NET_CONN_CB(tcp_established)
 {
 	struct net_context *context = (struct net_context *)user_data;
 	struct net_tcp_hdr *tcp_hdr = proto_hdr->tcp;
+	struct net_tcp_options tcp_opts = { 0 };
 	enum net_verdict ret = NET_OK;
 	u8_t tcp_flags;
 	u16_t data_len;
+	u16_t opt_totlen;
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
@@ -1989,14 +2651,77 @@ resend_ack:
 		goto unlock;
 	}
 
+	opt_totlen = NET_TCP_HDR_LEN(tcp_hdr) - sizeof(struct net_tcp_hdr);
+
+	/* Only timestamps and SACK blocks are of interest after the
+	 * handshake. The options are skipped with the header later on.
+	 */
+	if (opt_totlen &&
+	    (context->tcp->flags & (NET_TCP_TS_ON | NET_TCP_SACK_ON))) {
+		struct net_pkt_cursor backup;
+
+		net_pkt_cursor_backup(pkt, &backup);
+
+		if (net_tcp_parse_opts(pkt, opt_totlen, &tcp_opts) < 0) {
+			ret = NET_DROP;
+			goto unlock;
+		}
+
+		net_pkt_cursor_restore(pkt, &backup);
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Only in-order segments get here, so this is the timestamp to
+	 * echo as per RFC 7323 4.3.
+	 */
+	if (tcp_opts.ts_set) {
+		context->tcp->ts_recent = tcp_opts.tsval;
+	}
+#endif
+
 	/* Handle TCP state transition */
 	if (tcp_flags & NET_TCP_ACK) {
-		if (!net_tcp_ack_received(context,
-					  sys_get_be32(tcp_hdr->ack))) {
+		u32_t ack = sys_get_be32(tcp_hdr->ack);
+		u32_t wnd = (u32_t)sys_get_be16(tcp_hdr->wnd) <<
+			    context->tcp->send_wscale;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		u32_t una = tcp_snd_una(context->tcp);
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		bool dup_ack = tcp_is_dup_ack(context->tcp, tcp_hdr,
+					      net_pkt_remaining_data(pkt) -
+					      opt_totlen, wnd);
+#endif
+
+		if (!net_tcp_ack_received(context, ack)) {
 			ret = NET_DROP;
 			goto unlock;
 		}
 
+		context->tcp->send_wnd = wnd;
+
+		if (context->tcp->flags & NET_TCP_SACK_ON) {
+			tcp_sack_update(context->tcp, &tcp_opts, ack);
+		}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		/* RFC 7323 4.2: only ACKs of new data give an RTT sample */
+		if (tcp_opts.ts_set && tcp_opts.tsecr &&
+		    net_tcp_seq_greater(ack, una)) {
+			tcp_rtt_update(context->tcp,
+				       k_uptime_get_32() - tcp_opts.tsecr);
+		}
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		if (dup_ack) {
+			tcp_dup_ack(context->tcp, ack);
+		}
+
+		/* The window may have opened up */
+		tcp_send_queued(context->tcp);
+#endif
+
 		/* TCP state might be changed after maintaining the sent pkt
 		 * list, e.g., an ack of FIN is received.
 		 */
@@ -2160,9 +2885,23 @@ NET_CONN_CB(tcp_synack_received)
 		/* Remove the temporary connection handler and register
 		 * a proper now as we have an established connection.
 		 */
+		struct net_tcp_options tcp_opts = {
+			.mss = NET_TCP_DEFAULT_MSS,
+		};
 		struct sockaddr local_addr;
 		struct sockaddr remote_addr;
 
+		if (net_tcp_parse_opts(pkt, NET_TCP_HDR_LEN(tcp_hdr) -
+				       sizeof(struct net_tcp_hdr),
+				       &tcp_opts) < 0) {
+			return NET_DROP;
+		}
+
+		tcp_set_peer_syn_opts(context->tcp, &tcp_opts);
+		context->tcp->send_mss = tcp_opts.mss;
+		context->tcp->send_wnd = sys_get_be16(tcp_hdr->wnd);
+		tcp_cwnd_init(context->tcp);
+
 		tcp_copy_ip_addr_from_hdr(net_pkt_family(pkt), ip_hdr, tcp_hdr,
 					  &remote_addr, true);
 		tcp_copy_ip_addr_from_hdr(net_pkt_family(pkt), ip_hdr, tcp_hdr,
@@ -2304,6 +3043,9 @@ NET_CONN_CB(tcp_syn_rcvd)
 			return NET_DROP;
 		}
 
+		/* Picked up by the SYN-ACK and stored in the backlog */
+		tcp_set_peer_syn_opts(tcp, &tcp_opts);
+
 		net_tcp_change_state(tcp, NET_TCP_SYN_RCVD);
 
 		/* Set TCP seq and ack which are then stored in the backlog */
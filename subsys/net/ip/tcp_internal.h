@@ -29,7 +29,11 @@ extern "C" {
 /** Is this TCP context/socket used or not */
 #define NET_TCP_IN_USE BIT(0)
 
-/* BIT(1), BIT(2) are unused and available */
+/** Window scaling has been negotiated with the peer */
+#define NET_TCP_WSCALE_ON BIT(1)
+
+/** Peer has told us it can receive SACK options */
+#define NET_TCP_SACK_ON BIT(2)
 
 /** Is the socket shutdown for read/write */
 #define NET_TCP_IS_SHUTDOWN BIT(3)
@@ -40,6 +44,12 @@ extern "C" {
 /** MSS option has been set already */
 #define NET_TCP_RECV_MSS_SET BIT(5)
 
+/** Timestamps have been negotiated with the peer */
+#define NET_TCP_TS_ON BIT(6)
+
+/** Fast recovery is in progress */
+#define NET_TCP_IN_RECOVERY BIT(7)
+
 /*
  * TCP connection states
  */
@@ -83,23 +93,60 @@ enum net_tcp_state {
 /* Maximal value of the sequence number */
 #define NET_TCP_MAX_SEQ   0xffffffff
 
+/* Room for the options of a SYN: MSS, window scale, SACK permitted and
+ * timestamps, each padded to 4 bytes. Data segments carry at most the
+ * timestamps.
+ */
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK) || \
+	defined(CONFIG_NET_TCP_TIMESTAMPS)
+#define NET_TCP_MAX_OPT_SIZE  24
+#else
 #define NET_TCP_MAX_OPT_SIZE  8
+#endif
 
 /* TCP Option codes */
 #define NET_TCP_END_OPT          0
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* RFC 7323 2.3: the shift count must not be greater than 14 */
+#define NET_TCP_MAX_WINDOW_SCALE  14
+
+/* Max number of SACK blocks in one option (RFC 2018 3) */
+#define NET_TCP_SACK_BLOCKS       4
+
+/** A block of data received out of order by the peer */
+struct net_tcp_sack_block {
+	u32_t left;
+	u32_t right;
+};
 
 /** Parsed TCP option values for net_tcp_parse_opts()  */
 struct net_tcp_options {
 	u16_t mss;
+	/** Window scale shift count, valid if wscale_set */
+	u8_t wscale;
+	/** Number of valid entries in sack */
+	u8_t sack_count;
+	/** Timestamp value and echo reply, valid if ts_set */
+	u32_t tsval;
+	u32_t tsecr;
+	struct net_tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
+	u8_t wscale_set : 1;
+	u8_t sack_perm : 1;
+	u8_t ts_set : 1;
 };
 
 /* Max received bytes to buffer internally */
@@ -154,13 +201,64 @@ struct net_tcp {
 	/**
 	 * Current TCP receive window for our side
 	 */
-	u16_t recv_wnd;
+	u32_t recv_wnd;
+
+	/**
+	 * Send window last advertised by the peer, scaled
+	 */
+	u32_t send_wnd;
+
+#if defined(CONFIG_NET_PKT_WATERMARKS)
+	/** Right edge of the receive window last advertised */
+	u32_t recv_wnd_edge;
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	/** Congestion window, in bytes */
+	u32_t cwnd;
+
+	/** Slow start threshold, in bytes */
+	u32_t ssthresh;
+
+	/** Highest sequence number sent when fast recovery started */
+	u32_t recover;
+
+	/** Number of duplicate ACKs received in a row */
+	u8_t dup_acks;
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/** Number of valid entries in sacked */
+	u8_t sacked_count;
+
+	/** Blocks the peer reported in its last SACK option */
+	struct net_tcp_sack_block sacked[NET_TCP_SACK_BLOCKS];
+#endif
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/** Latest timestamp value received from the peer */
+	u32_t ts_recent;
+
+	/** Smoothed round-trip time, in milliseconds scaled by 8 */
+	u32_t srtt;
+
+	/** Round-trip time variation, in milliseconds scaled by 4 */
+	u32_t rttvar;
+
+	/** Retransmission timeout, in milliseconds, 0 until measured */
+	u32_t rto;
+#endif
 
 	/**
 	 * Send MSS for the peer
 	 */
 	u16_t send_mss;
 
+	/** Shift count applied to the windows the peer advertises */
+	u8_t send_wscale : 4;
+	/** Shift count applied to the windows we advertise */
+	u8_t recv_wscale : 4;
+
 	/** Current retransmit period */
 	u32_t retry_timeout_shift : 5;
 	/** Flags for the TCP */
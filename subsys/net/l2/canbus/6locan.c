@@ -137,6 +137,24 @@ static void canbus_rx_timeout(struct _timeout *t)
 	canbus_rx_report_err_from_isr(ctx->pkt);
 }
 
+/* Take a reception out of the CF state, unless its timeout did it first.
+ * Return true if the caller has to report the error.
+ */
+static bool canbus_rx_stop(struct canbus_isotp_rx_ctx *ctx)
+{
+	unsigned int key = irq_lock();
+	bool stopped = (ctx->state == NET_CAN_RX_STATE_CF);
+
+	if (stopped) {
+		ctx->state = NET_CAN_RX_STATE_TIMEOUT;
+		z_abort_timeout(&ctx->timeout);
+	}
+
+	irq_unlock(key);
+
+	return stopped;
+}
+
 static void canbus_st_min_timeout(struct _timeout *t)
 {
 	struct canbus_isotp_tx_ctx *ctx =
@@ -559,6 +577,119 @@ static enum net_verdict canbus_process_cf(struct net_pkt *pkt)
 	return NET_OK;
 }
 
+static void canbus_rx_fc_work_handler(struct k_work *item)
+{
+	struct canbus_isotp_rx_ctx *ctx =
+		CONTAINER_OF(item, struct canbus_isotp_rx_ctx, fc_work);
+	struct net_pkt *pkt = ctx->pkt;
+	struct net_canbus_lladdr src, dest;
+	int ret;
+
+	NET_DBG("BS reached. Send FC");
+	src.addr = canbus_get_src_lladdr(pkt);
+	dest.addr = canbus_get_dest_lladdr(pkt);
+	ret = canbus_send_fc(net_if_get_device(pkt->iface), &src, &dest,
+			     NET_CAN_PCI_FS_CTS);
+	if (ret) {
+		NET_ERR("Failed to send FC CTS. BS: %d", NET_CAN_BS);
+		if (canbus_rx_stop(ctx)) {
+			canbus_rx_report_err(pkt);
+		}
+	}
+}
+
+bool net_6locan_recv_cf(struct net_if *iface, struct zcan_frame *frame)
+{
+	struct canbus_isotp_rx_ctx *ctx = NULL;
+	struct net_pkt *pkt;
+	u16_t src_addr;
+	size_t data_len;
+	unsigned int key;
+	int i;
+
+	/* Multicast CFs are not flow controlled and may overtake their FF,
+	 * they keep going through the RX thread in order.
+	 */
+	if (frame->dlc == 0U ||
+	    (frame->data[0] & NET_CAN_PCI_TYPE_MASK) != NET_CAN_PCI_TYPE_CF ||
+	    (frame->ext_id & CAN_NET_IF_ADDR_MCAST_MASK)) {
+		return false;
+	}
+
+	src_addr = (frame->ext_id >> CAN_NET_IF_ADDR_SRC_POS) &
+		   CAN_NET_IF_ADDR_MASK;
+
+	/* The state only leaves CF with interrupts locked */
+	key = irq_lock();
+
+	for (i = 0; i < ARRAY_SIZE(l2_ctx.rx_ctx); i++) {
+		if (l2_ctx.rx_ctx[i].state == NET_CAN_RX_STATE_CF &&
+		    canbus_get_src_lladdr(l2_ctx.rx_ctx[i].pkt) == src_addr) {
+			ctx = &l2_ctx.rx_ctx[i];
+			break;
+		}
+	}
+
+	if (!ctx) {
+		irq_unlock(key);
+		return false;
+	}
+
+	pkt = ctx->pkt;
+	z_abort_timeout(&ctx->timeout);
+
+	if ((frame->data[0] & NET_CAN_PCI_SN_MASK) != ctx->sn) {
+		NET_ERR("Sequence number missmatch. Expect %u, got %u",
+			ctx->sn, frame->data[0] & NET_CAN_PCI_SN_MASK);
+		goto err;
+	}
+
+	ctx->sn++;
+
+	/* The buffer of the pkt was allocated for the whole message by the
+	 * FF, so writing to it does not allocate.
+	 */
+	data_len = MIN(frame->dlc - 1U, ctx->rem_len);
+	if (net_pkt_write(pkt, &frame->data[1], data_len) < 0) {
+		NET_ERR("Failed to write data to pkt");
+		goto err;
+	}
+
+	ctx->rem_len -= data_len;
+
+	if (ctx->rem_len == 0U) {
+		ctx->state = NET_CAN_RX_STATE_FIN;
+		irq_unlock(key);
+
+		if (net_recv_data(iface, pkt) < 0) {
+			NET_ERR("Packet dropped by NET stack");
+			ctx->state = NET_CAN_RX_STATE_TIMEOUT;
+			canbus_rx_report_err_from_isr(pkt);
+		}
+
+		return true;
+	}
+
+	z_add_timeout(&ctx->timeout, canbus_rx_timeout,
+		      z_ms_to_ticks(NET_CAN_BS_TIME));
+
+	if (NET_CAN_BS != 0 && ++ctx->act_block_nr >= NET_CAN_BS) {
+		ctx->act_block_nr = 0;
+		k_work_submit_to_queue(&net_canbus_workq, &ctx->fc_work);
+	}
+
+	irq_unlock(key);
+
+	return true;
+
+err:
+	ctx->state = NET_CAN_RX_STATE_TIMEOUT;
+	irq_unlock(key);
+	canbus_rx_report_err_from_isr(pkt);
+
+	return true;
+}
+
 static enum net_verdict canbus_process_ff(struct net_pkt *pkt)
 {
 	struct device *net_can_dev = net_if_get_device(pkt->iface);
@@ -624,23 +755,29 @@ static enum net_verdict canbus_process_ff(struct net_pkt *pkt)
 	rx_ctx->rem_len = msg_len - data_len;
 	net_pkt_unref(pkt);
 
+	/* At this point we expect to get Consecutive frames directly. The
+	 * driver may take them from its RX callback as soon as the FC is out,
+	 * so the context has to be ready before.
+	 */
+	z_add_timeout(&rx_ctx->timeout, canbus_rx_timeout,
+		      z_ms_to_ticks(NET_CAN_BS_TIME));
+
+	rx_ctx->state = NET_CAN_RX_STATE_CF;
+
 	if (!mcast) {
 		/* switch src and dest because we are answering */
 		ret = canbus_send_fc(net_can_dev, &src, &dest,
 				     NET_CAN_PCI_FS_CTS);
 		if (ret) {
 			NET_ERR("Failed to send FC CTS");
-			canbus_rx_report_err(new_pkt);
+			if (canbus_rx_stop(rx_ctx)) {
+				canbus_rx_report_err(new_pkt);
+			}
+
 			return NET_OK;
 		}
 	}
 
-	/* At this point we expect to get Consecutive frames directly */
-	z_add_timeout(&rx_ctx->timeout, canbus_rx_timeout,
-		      z_ms_to_ticks(NET_CAN_BS_TIME));
-
-	rx_ctx->state = NET_CAN_RX_STATE_CF;
-
 	NET_DBG("Processed FF from 0x%04x (%scast)"
 		"Msg length: %u CTX: %p",
 		src.addr, mcast ? "m" : "uni", msg_len, rx_ctx);
@@ -1724,6 +1861,8 @@ void net_6locan_init(struct net_if *iface)
 
 	for (i = 0; i < ARRAY_SIZE(l2_ctx.rx_ctx); i++) {
 		l2_ctx.rx_ctx[i].state = NET_CAN_RX_STATE_UNUSED;
+		k_work_init(&l2_ctx.rx_ctx[i].fc_work,
+			    canbus_rx_fc_work_handler);
 	}
 
 	ctx->dad_filter_id = CAN_NET_FILTER_NOT_SET;
@@ -22,29 +22,47 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT K_SECONDS(2)
+#define ARP_ENTRY_LIFETIME K_SECONDS(CONFIG_NET_ARP_ENTRY_LIFETIME)
+#define ARP_ENTRY_REFRESH (ARP_ENTRY_LIFETIME / 4 * 3)
 
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
 static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+static sys_slist_t arp_table[CONFIG_NET_ARP_TABLE_SIZE];
 
 struct k_delayed_work arp_request_timer;
 
+/* The resolved entries are hashed by their address, the hosts of a
+ * subnet differ by its lowest bits.
+ */
+static sys_slist_t *arp_table_bucket(struct in_addr *addr)
+{
+	return &arp_table[ntohl(UNALIGNED_GET(&addr->s_addr)) %
+			  CONFIG_NET_ARP_TABLE_SIZE];
+}
+
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 {
+	int i;
+
 	NET_DBG("%p", entry);
 
 	if (pending) {
-		NET_DBG("Releasing pending pkt %p (ref %d)",
-			entry->pending,
-			atomic_get(&entry->pending->atomic_ref) - 1);
-		net_pkt_unref(entry->pending);
-		entry->pending = NULL;
+		for (i = 0; i < entry->pending_count; i++) {
+			NET_DBG("Releasing pending pkt %p (ref %d)",
+				entry->pending[i],
+				atomic_get(&entry->pending[i]->atomic_ref) - 1);
+			net_pkt_unref(entry->pending[i]);
+			entry->pending[i] = NULL;
+		}
+
+		entry->pending_count = 0U;
 	}
 
 	entry->iface = NULL;
+	entry->refresh = false;
 
 	(void)memset(&entry->ip, 0, sizeof(struct in_addr));
 	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
@@ -77,22 +95,25 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
+	sys_slist_t *bucket = arp_table_bucket(dst);
 	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
+	entry = arp_entry_find(bucket, iface, dst, &prev);
 	if (entry) {
 		/* Let's assume the target is going to be accessed
 		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
+		 * place the entry first in position into the bucket
 		 * in order to reduce subsequent find.
 		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
+		if (&entry->node != sys_slist_peek_head(bucket)) {
+			sys_slist_remove(bucket, prev, &entry->node);
+			sys_slist_prepend(bucket, &entry->node);
 		}
+
+		entry->last_used = k_uptime_get_32();
 	}
 
 	return entry;
@@ -145,20 +166,48 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry, *oldest = NULL;
+	int i;
 
-	/* We assume last entry is the oldest one,
-	 * so is the preferred one to be taken out.
+	/* The entry used the longest ago is the preferred one to be
+	 * taken out.
 	 */
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			if (!oldest ||
+			    (s32_t)(entry->last_used - oldest->last_used) < 0) {
+				oldest = entry;
+			}
+		}
+	}
 
-	node = sys_slist_peek_tail(&arp_table);
-	if (!node) {
+	if (!oldest) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	sys_slist_find_and_remove(arp_table_bucket(&oldest->ip),
+				  &oldest->node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return oldest;
+}
+
+static void arp_entry_queue(struct arp_entry *entry, struct net_pkt *pkt)
+{
+	int i;
+
+	for (i = 0; i < entry->pending_count; i++) {
+		if (entry->pending[i] == pkt) {
+			return;
+		}
+	}
+
+	if (entry->pending_count == ARRAY_SIZE(entry->pending)) {
+		NET_DBG("Pending queue of %s full, dropping %p",
+			log_strdup(net_sprint_ipv4_addr(&entry->ip)), pkt);
+		return;
+	}
+
+	entry->pending[entry->pending_count++] = net_pkt_ref(pkt);
 }
 
 
@@ -266,7 +315,9 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	 * request and we want to send it again.
 	 */
 	if (entry) {
-		entry->pending = net_pkt_ref(pending);
+		entry->pending[0] = net_pkt_ref(pending);
+		entry->pending_count = 1U;
+		entry->refresh = false;
 		entry->iface = net_pkt_iface(pkt);
 
 		net_ipaddr_copy(&entry->ip, next_addr);
@@ -298,10 +349,10 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	memcpy(hdr->src_hwaddr.addr, net_pkt_lladdr_src(pkt)->addr,
 	       sizeof(struct net_eth_addr));
 
-	if (!entry || net_pkt_ipv4_auto(pkt)) {
+	if (net_pkt_ipv4_auto(pkt) || (!entry && current_ip)) {
 		my_addr = current_ip;
 	} else {
-		my_addr = if_get_addr(entry->iface, current_ip);
+		my_addr = if_get_addr(net_pkt_iface(pkt), current_ip);
 	}
 
 	if (my_addr) {
@@ -313,6 +364,48 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	return pkt;
 }
 
+/* Ask the host directly for its address before the entry expires */
+static void arp_entry_refresh(struct arp_entry *entry)
+{
+	struct net_pkt *req;
+
+	req = arp_prepare(entry->iface, &entry->ip, NULL, NULL, NULL);
+	if (!req) {
+		return;
+	}
+
+	net_pkt_lladdr_dst(req)->addr = (u8_t *)&entry->eth;
+
+	NET_DBG("Refreshing %s", log_strdup(net_sprint_ipv4_addr(&entry->ip)));
+
+	entry->refresh = true;
+	net_if_queue_tx(entry->iface, req);
+}
+
+/* Return false if the entry expired and was released */
+static bool arp_entry_check_lifetime(struct arp_entry *entry)
+{
+	u32_t age = k_uptime_get_32() - entry->req_start;
+
+	if (age >= ARP_ENTRY_LIFETIME) {
+		NET_DBG("Expired %s",
+			log_strdup(net_sprint_ipv4_addr(&entry->ip)));
+
+		sys_slist_find_and_remove(arp_table_bucket(&entry->ip),
+					  &entry->node);
+		arp_entry_cleanup(entry, false);
+		sys_slist_prepend(&arp_free_entries, &entry->node);
+
+		return false;
+	}
+
+	if (age >= ARP_ENTRY_REFRESH && !entry->refresh) {
+		arp_entry_refresh(entry);
+	}
+
+	return true;
+}
+
 struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				struct in_addr *request_ip,
 				struct in_addr *current_ip)
@@ -350,6 +443,11 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	 * to send any ARP packet.
 	 */
 	entry = arp_entry_find_move_first(net_pkt_iface(pkt), addr);
+	if (entry && CONFIG_NET_ARP_ENTRY_LIFETIME &&
+	    !arp_entry_check_lifetime(entry)) {
+		entry = NULL;
+	}
+
 	if (!entry) {
 		struct net_pkt *req;
 
@@ -362,7 +460,10 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				entry = arp_entry_get_last_from_table();
 			}
 		} else {
-			/* There is a pending already */
+			/* There is a pending already, the packet is sent
+			 * with the ones queued before it.
+			 */
+			arp_entry_queue(entry, pkt);
 			entry = NULL;
 		}
 
@@ -370,9 +471,9 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				  current_ip);
 
 		if (!entry) {
-			/* We cannot send the packet, the ARP cache is full
-			 * or there is already a pending query to this IP
-			 * address, so this packet must be discarded.
+			/* Either the packet got queued to the pending query
+			 * to this IP address, or the ARP cache is full and
+			 * this packet must be discarded.
 			 */
 			NET_DBG("Resending ARP %p", req);
 		}
@@ -399,10 +500,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find(arp_table_bucket(src), iface, src, NULL);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -422,8 +522,10 @@ static void arp_update(struct net_if *iface,
 		       bool gratuitous,
 		       bool force)
 {
+	struct net_pkt *pending[CONFIG_NET_ARP_PENDING_COUNT];
 	struct arp_entry *entry;
-	struct net_pkt *pkt;
+	u8_t count;
+	int i;
 
 	NET_DBG("src %s", log_strdup(net_sprint_ipv4_addr(src)));
 
@@ -433,55 +535,66 @@ static void arp_update(struct net_if *iface,
 			arp_gratuitous(iface, src, hwaddr);
 		}
 
-		if (force) {
-			sys_snode_t *prev = NULL;
-			struct arp_entry *entry;
-
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
-			if (entry) {
+		entry = arp_entry_find(arp_table_bucket(src), iface, src, NULL);
+		if (entry) {
+			/* Answer to a refresh, or forced update */
+			if (force || entry->refresh) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
-			} else {
-				/* Add new entry as it was not found and force
-				 * was set.
-				 */
-				entry = arp_entry_get_free();
-				if (!entry) {
-					/* Then let's take one from table? */
-					entry = arp_entry_get_last_from_table();
-				}
-
-				if (entry) {
-					entry->req_start = k_uptime_get_32();
-					entry->iface = iface;
-					net_ipaddr_copy(&entry->ip, src);
-					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
-				}
+				entry->req_start = k_uptime_get_32();
+				entry->refresh = false;
+			}
+		} else if (force) {
+			/* Add new entry as it was not found and force
+			 * was set.
+			 */
+			entry = arp_entry_get_free();
+			if (!entry) {
+				/* Then let's take one from table? */
+				entry = arp_entry_get_last_from_table();
+			}
+
+			if (entry) {
+				entry->req_start = k_uptime_get_32();
+				entry->last_used = entry->req_start;
+				entry->iface = iface;
+				entry->pending_count = 0U;
+				entry->refresh = false;
+				net_ipaddr_copy(&entry->ip, src);
+				memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
+				sys_slist_prepend(arp_table_bucket(src),
+						  &entry->node);
 			}
 		}
 
 		return;
 	}
 
-	/* Set the dst in the pending packet */
-	net_pkt_lladdr_dst(entry->pending)->len = sizeof(struct net_eth_addr);
-	net_pkt_lladdr_dst(entry->pending)->addr =
-		(u8_t *) &NET_ETH_HDR(entry->pending)->dst.addr;
-
-	NET_DBG("dst %s pending %p frag %p",
-		log_strdup(net_sprint_ipv4_addr(&entry->ip)),
-		entry->pending, entry->pending->frags);
-
-	pkt = entry->pending;
-	entry->pending = NULL;
+	/* The address overwrites the pending packets */
+	count = entry->pending_count;
+	memcpy(pending, entry->pending, count * sizeof(pending[0]));
+	entry->pending_count = 0U;
 
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+	entry->req_start = k_uptime_get_32();
+	entry->last_used = entry->req_start;
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	sys_slist_prepend(arp_table_bucket(&entry->ip), &entry->node);
+
+	for (i = 0; i < count; i++) {
+		/* Set the dst in the pending packet */
+		net_pkt_lladdr_dst(pending[i])->len =
+			sizeof(struct net_eth_addr);
+		net_pkt_lladdr_dst(pending[i])->addr =
+			(u8_t *) &NET_ETH_HDR(pending[i])->dst.addr;
+
+		NET_DBG("dst %s pending %p frag %p",
+			log_strdup(net_sprint_ipv4_addr(&entry->ip)),
+			pending[i], pending[i]->frags);
 
-	net_if_queue_tx(iface, pkt);
+		net_if_queue_tx(iface, pending[i]);
+	}
 }
 
 static inline struct net_pkt *arp_prepare_reply(struct net_if *iface,
@@ -669,21 +782,27 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 void net_arp_clear_cache(struct net_if *iface)
 {
-	sys_snode_t *prev = NULL;
+	sys_snode_t *prev;
 	struct arp_entry *entry, *next;
+	int i;
 
 	NET_DBG("Flushing ARP table");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
-		if (iface && iface != entry->iface) {
-			prev = &entry->node;
-			continue;
-		}
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		prev = NULL;
 
-		arp_entry_cleanup(entry, false);
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table[i], entry, next,
+						  node) {
+			if (iface && iface != entry->iface) {
+				prev = &entry->node;
+				continue;
+			}
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+			arp_entry_cleanup(entry, false);
+
+			sys_slist_remove(&arp_table[i], prev, &entry->node);
+			sys_slist_prepend(&arp_free_entries, &entry->node);
+		}
 	}
 
 	prev = NULL;
@@ -712,10 +831,13 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 {
 	int ret = 0;
 	struct arp_entry *entry;
+	int i;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
-		ret++;
-		cb(entry, user_data);
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			ret++;
+			cb(entry, user_data);
+		}
 	}
 
 	return ret;
@@ -731,7 +853,10 @@ void net_arp_init(void)
 
 	sys_slist_init(&arp_free_entries);
 	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		sys_slist_init(&arp_table[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
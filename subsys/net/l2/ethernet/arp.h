@@ -51,13 +51,19 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 struct arp_entry {
 	sys_snode_t node;
+	/* time the request was sent, or the address was last confirmed */
 	u32_t req_start;
+	/* time the address was last used, to replace the oldest entry */
+	u32_t last_used;
 	struct net_if *iface;
 	struct in_addr ip;
 	union {
-		struct net_pkt *pending;
+		struct net_pkt *pending[CONFIG_NET_ARP_PENDING_COUNT];
 		struct net_eth_addr eth;
 	};
+	u8_t pending_count;
+	/* a request was sent to refresh the address before it expires */
+	bool refresh;
 };
 
 typedef void (*net_arp_cb_t)(struct arp_entry *entry,
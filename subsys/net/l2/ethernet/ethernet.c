@@ -27,8 +27,11 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "arp.h"
 #include "eth_stats.h"
 #include "net_private.h"
+#include "net_stats.h"
+#include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
@@ -466,18 +469,40 @@ static void set_vlan_priority(struct ethernet_context *ctx,
 
 static struct net_buf *ethernet_fill_header(struct ethernet_context *ctx,
 					    struct net_pkt *pkt,
-					    u32_t ptype)
+					    u32_t ptype,
+					    size_t *in_place_len)
 {
 	struct net_buf *hdr_frag;
 	struct net_eth_hdr *hdr;
+	size_t hdr_len;
+	bool vlan;
 
-	hdr_frag = net_pkt_get_frag(pkt, NET_BUF_TIMEOUT);
-	if (!hdr_frag) {
-		return NULL;
+	vlan = IS_ENABLED(CONFIG_NET_VLAN) &&
+		net_eth_is_vlan_enabled(ctx, net_pkt_iface(pkt));
+	hdr_len = vlan ? sizeof(struct net_eth_vlan_hdr) :
+		sizeof(struct net_eth_hdr);
+
+	/* Use the headroom reserved at allocation time if there is some,
+	 * this saves allocating and inserting a fragment for the header.
+	 */
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET_RESERVE_HEADER) &&
+	    pkt->buffer && net_buf_headroom(pkt->buffer) >= hdr_len) {
+		hdr_frag = pkt->buffer;
+		net_buf_push(hdr_frag, hdr_len);
+		*in_place_len = hdr_len;
+
+		net_stats_update_l2_hdr_in_place(net_pkt_iface(pkt));
+	} else {
+		hdr_frag = net_pkt_get_frag(pkt, NET_BUF_TIMEOUT);
+		if (!hdr_frag) {
+			return NULL;
+		}
+
+		net_buf_add(hdr_frag, hdr_len);
+		*in_place_len = 0;
 	}
 
-	if (IS_ENABLED(CONFIG_NET_VLAN) &&
-	    net_eth_is_vlan_enabled(ctx, net_pkt_iface(pkt))) {
+	if (vlan) {
 		struct net_eth_vlan_hdr *hdr_vlan;
 
 		hdr_vlan = (struct net_eth_vlan_hdr *)(hdr_frag->data);
@@ -494,11 +519,10 @@ static struct net_buf *ethernet_fill_header(struct ethernet_context *ctx,
 		hdr_vlan->type = ptype;
 		hdr_vlan->vlan.tpid = htons(NET_ETH_PTYPE_VLAN);
 		hdr_vlan->vlan.tci = htons(net_pkt_vlan_tci(pkt));
-		net_buf_add(hdr_frag, sizeof(struct net_eth_vlan_hdr));
 
 		print_vlan_ll_addrs(pkt, ntohs(hdr_vlan->type),
 				    net_pkt_vlan_tci(pkt),
-				    hdr_frag->len,
+				    hdr_len,
 				    &hdr_vlan->src, &hdr_vlan->dst, false);
 	} else {
 		hdr = (struct net_eth_hdr *)(hdr_frag->data);
@@ -513,13 +537,14 @@ static struct net_buf *ethernet_fill_header(struct ethernet_context *ctx,
 		       sizeof(struct net_eth_addr));
 
 		hdr->type = ptype;
-		net_buf_add(hdr_frag, sizeof(struct net_eth_hdr));
 
 		print_ll_addrs(pkt, ntohs(hdr->type),
-			       hdr_frag->len, &hdr->src, &hdr->dst);
+			       hdr_len, &hdr->src, &hdr->dst);
 	}
 
-	net_pkt_frag_insert(pkt, hdr_frag);
+	if (!*in_place_len) {
+		net_pkt_frag_insert(pkt, hdr_frag);
+	}
 
 	return hdr_frag;
 }
@@ -542,10 +567,19 @@ static void ethernet_update_tx_stats(struct net_if *iface, struct net_pkt *pkt)
 #define ethernet_update_tx_stats(...)
 #endif /* CONFIG_NET_STATISTICS_ETHERNET */
 
-static void ethernet_remove_l2_header(struct net_pkt *pkt)
+static void ethernet_remove_l2_header(struct net_pkt *pkt,
+				      size_t in_place_len)
 {
 	struct net_buf *buf;
 
+	/* The packet may be sent again (e.g. TCP retransmission), so give
+	 * back the headroom used in ethernet_fill_header().
+	 */
+	if (in_place_len) {
+		net_buf_pull(pkt->buffer, in_place_len);
+		return;
+	}
+
 	/* Remove the buffer added in ethernet_fill_header() */
 	buf = pkt->buffer;
 	pkt->buffer = buf->frags;
@@ -554,10 +588,165 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Split a TCP super-segment into MTU sized segments and send them one by
+ * one. Like ethernet_send(), the original packet is released only on
+ * success.
+ */
+static int ethernet_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t hdr_len, data_len, offset, len;
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+	u8_t flags;
+	int sent = 0;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv6_ext_len(pkt))) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -EINVAL;
+	}
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv6_ext_len(pkt) +
+		  NET_TCP_HDR_LEN(tcp_hdr);
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	flags = tcp_hdr->flags;
+
+	for (offset = 0; offset < data_len; offset += len) {
+		len = MIN(data_len - offset, net_pkt_gso_size(pkt));
+
+		seg = net_pkt_alloc_with_buffer(iface, hdr_len + len,
+						AF_UNSPEC, 0, NET_BUF_TIMEOUT);
+		if (!seg) {
+			ret = -ENOMEM;
+			goto out;
+		}
+
+		net_pkt_set_family(seg, net_pkt_family(pkt));
+		net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_priority(seg, net_pkt_priority(pkt));
+		net_pkt_set_vlan_tci(seg, net_pkt_vlan_tci(pkt));
+		memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+		       sizeof(struct net_linkaddr));
+		memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+		       sizeof(struct net_linkaddr));
+
+		net_pkt_cursor_init(pkt);
+		if (net_pkt_copy(seg, pkt, hdr_len) ||
+		    net_pkt_skip(pkt, offset) ||
+		    net_pkt_copy(seg, pkt, len)) {
+			net_pkt_unref(seg);
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		net_pkt_cursor_init(seg);
+		net_pkt_set_overwrite(seg, true);
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(seg) == AF_INET) {
+			NET_PKT_DATA_ACCESS_DEFINE(ipv4_access,
+						   struct net_ipv4_hdr);
+			struct net_ipv4_hdr *ipv4_hdr;
+
+			ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							seg, &ipv4_access);
+			if (!ipv4_hdr) {
+				net_pkt_unref(seg);
+				ret = -ENOBUFS;
+				goto out;
+			}
+
+			/* Each segment is a datagram of its own */
+			sys_put_be16(sys_get_be16(ipv4_hdr->id) +
+				     offset / net_pkt_gso_size(pkt),
+				     ipv4_hdr->id);
+
+			net_pkt_set_data(seg, &ipv4_access);
+			net_pkt_cursor_init(seg);
+		}
+
+		net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) +
+			     net_pkt_ipv6_ext_len(seg));
+
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg,
+								 &tcp_access);
+		if (!tcp_hdr) {
+			net_pkt_unref(seg);
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		UNALIGNED_PUT(htonl(ntohl(UNALIGNED_GET(
+			(u32_t *)tcp_hdr->seq)) + offset), (u32_t *)tcp_hdr->seq);
+
+		/* FIN and PSH belong to the last segment only */
+		if (offset + len < data_len) {
+			tcp_hdr->flags = flags & ~(NET_TCP_FIN | NET_TCP_PSH);
+		}
+
+		net_pkt_set_data(seg, &tcp_access);
+		net_pkt_cursor_init(seg);
+		net_pkt_set_overwrite(seg, false);
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(seg) == AF_INET) {
+			ret = net_ipv4_finalize(seg, IPPROTO_TCP);
+		} else {
+			ret = net_ipv6_finalize(seg, IPPROTO_TCP);
+		}
+
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto out;
+		}
+
+		ret = ethernet_send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto out;
+		}
+
+		sent += ret;
+	}
+
+	ret = sent;
+	net_pkt_unref(pkt);
+
+out:
+	net_pkt_set_overwrite(pkt, false);
+
+	return ret;
+}
+
+static inline bool ethernet_needs_gso(struct net_if *iface,
+				      struct net_pkt *pkt)
+{
+	return net_pkt_gso_size(pkt) &&
+		!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TSO);
+}
+#else
+#define ethernet_gso_send(...) -ENOTSUP
+#define ethernet_needs_gso(...) false
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->driver_api;
 	struct ethernet_context *ctx = net_if_l2_data(iface);
+	size_t in_place_len = 0;
 	u16_t ptype;
 	int ret;
 
@@ -608,6 +797,16 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		goto error;
 	}
 
+	if (ptype != htons(NET_ETH_PTYPE_ARP) &&
+	    ethernet_needs_gso(iface, pkt)) {
+		ret = ethernet_gso_send(iface, pkt);
+		if (ret < 0) {
+			goto error;
+		}
+
+		return ret;
+	}
+
 	/* If the ll dst addr has not been set before, let's assume
 	 * temporarily it's a broadcast one. When filling the header,
 	 * it might detect this should be multicast and act accordingly.
@@ -629,7 +828,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 
 	/* Then set the ethernet header.
 	 */
-	if (!ethernet_fill_header(ctx, pkt, ptype)) {
+	if (!ethernet_fill_header(ctx, pkt, ptype, &in_place_len)) {
 		ret = -ENOMEM;
 		goto error;
 	}
@@ -640,14 +839,14 @@ send:
 	ret = api->send(net_if_get_device(iface), pkt);
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
-		ethernet_remove_l2_header(pkt);
+		ethernet_remove_l2_header(pkt, in_place_len);
 		goto error;
 	}
 
 	ethernet_update_tx_stats(iface, pkt);
 
 	ret = net_pkt_get_len(pkt);
-	ethernet_remove_l2_header(pkt);
+	ethernet_remove_l2_header(pkt, in_place_len);
 
 	net_pkt_unref(pkt);
 error:
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RX polling for Ethernet drivers
+ *
+ * A driver taking an RX interrupt disables it and schedules its poll
+ * work item. The work item receives a budget of frames at a time and
+ * gives way to the other drivers between two budgets, so that a busy link
+ * does not starve the others, then enables the interrupt of the driver
+ * again once it has no frames left.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_ethernet_rx_poll, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <kernel.h>
+#include <init.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/ethernet.h>
+
+#include "eth_stats.h"
+
+static struct k_work_q rx_poll_workq;
+K_THREAD_STACK_DEFINE(rx_poll_stack, CONFIG_NET_L2_ETHERNET_RX_POLL_STACK_SIZE);
+
+static void rx_poll_flush(struct net_eth_rx_poll *rx_poll)
+{
+	struct net_pkt *pkt;
+	struct net_if *iface;
+	int i;
+
+	/* When the thread is made preemptible, don't let the RX thread
+	 * run for each frame of the batch.
+	 */
+	k_sched_lock();
+
+	for (i = 0; i < rx_poll->batch_count; i++) {
+		pkt = rx_poll->batch[i];
+		iface = net_pkt_iface(pkt);
+
+		if (net_recv_data(iface, pkt) < 0) {
+			eth_stats_update_errors_rx(iface);
+			net_pkt_unref(pkt);
+		}
+	}
+
+	k_sched_unlock();
+
+	rx_poll->batch_count = 0;
+}
+
+static void rx_poll_handler(struct k_work *work)
+{
+	struct net_eth_rx_poll *rx_poll =
+		CONTAINER_OF(work, struct net_eth_rx_poll, work);
+	int count;
+
+	count = rx_poll->poll(rx_poll, CONFIG_NET_L2_ETHERNET_RX_POLL_BUDGET);
+	rx_poll_flush(rx_poll);
+
+	/* Poll again, after the other pending drivers, if the budget was
+	 * used up or frames came in while the interrupt was disabled.
+	 */
+	if (count >= CONFIG_NET_L2_ETHERNET_RX_POLL_BUDGET ||
+	    rx_poll->irq_enable(rx_poll)) {
+		k_work_submit_to_queue(&rx_poll_workq, &rx_poll->work);
+	}
+}
+
+void net_eth_rx_poll_recv(struct net_eth_rx_poll *rx_poll,
+			  struct net_if *iface, struct net_pkt *pkt)
+{
+	/* Poll callbacks should stay within their budget */
+	if (rx_poll->batch_count == ARRAY_SIZE(rx_poll->batch)) {
+		rx_poll_flush(rx_poll);
+	}
+
+	net_pkt_set_iface(pkt, iface);
+	rx_poll->batch[rx_poll->batch_count++] = pkt;
+}
+
+void net_eth_rx_poll_schedule(struct net_eth_rx_poll *rx_poll)
+{
+	k_work_submit_to_queue(&rx_poll_workq, &rx_poll->work);
+}
+
+void net_eth_rx_poll_init(struct net_eth_rx_poll *rx_poll,
+			  net_eth_rx_poll_cb_t poll,
+			  net_eth_rx_irq_enable_cb_t irq_enable)
+{
+	k_work_init(&rx_poll->work, rx_poll_handler);
+	rx_poll->poll = poll;
+	rx_poll->irq_enable = irq_enable;
+	rx_poll->batch_count = 0;
+}
+
+static int rx_poll_workq_init(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	k_work_q_start(&rx_poll_workq, rx_poll_stack,
+		       K_THREAD_STACK_SIZEOF(rx_poll_stack),
+		       K_PRIO_COOP(CONFIG_NET_L2_ETHERNET_RX_POLL_PRIORITY));
+	k_thread_name_set(&rx_poll_workq.thread, "eth_rx_poll");
+
+	return 0;
+}
+
+/* Started before the drivers can take an RX interrupt */
+SYS_INIT(rx_poll_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
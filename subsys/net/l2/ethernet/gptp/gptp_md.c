@@ -171,6 +171,7 @@ static void gptp_md_pdelay_reset(int port)
 		port_ds->is_measuring_delay = false;
 		port_ds->as_capable = false;
 		state->init_pdelay_compute = true;
+		state->prop_delay_avg_valid = false;
 	}
 }
 
@@ -276,6 +277,26 @@ static void gptp_md_compute_pdelay_rate_ratio(int port)
 	port_ds->neighbor_rate_ratio_valid = state->neighbor_rate_ratio_valid;
 }
 
+#define PROP_DELAY_AVG_FACTOR (1 << CONFIG_NET_GPTP_PROP_DELAY_AVG_SHIFT)
+
+/* Exponential average over about PROP_DELAY_AVG_FACTOR measurements. The
+ * average is kept scaled by that factor so that the integer division does
+ * not lose the precision of the measurements.
+ */
+static s64_t gptp_md_average_prop_delay(struct gptp_pdelay_req_state *state,
+					s64_t prop_delay)
+{
+	if (!state->prop_delay_avg_valid) {
+		state->prop_delay_avg = prop_delay * PROP_DELAY_AVG_FACTOR;
+		state->prop_delay_avg_valid = true;
+	} else {
+		state->prop_delay_avg += prop_delay -
+			state->prop_delay_avg / PROP_DELAY_AVG_FACTOR;
+	}
+
+	return state->prop_delay_avg / PROP_DELAY_AVG_FACTOR;
+}
+
 static void gptp_md_compute_prop_time(int port)
 {
 	u64_t t1_ns = 0U, t2_ns = 0U, t3_ns = 0U, t4_ns = 0U;
@@ -345,6 +366,10 @@ static void gptp_md_compute_prop_time(int port)
 	prop_time -= turn_around;
 	prop_time /= 2;
 
+	if (CONFIG_NET_GPTP_PROP_DELAY_AVG_SHIFT > 0) {
+		prop_time = gptp_md_average_prop_delay(state, prop_time);
+	}
+
 	port_ds->neighbor_prop_delay = prop_time;
 }
 
@@ -499,6 +524,7 @@ static void gptp_md_init_pdelay_req_state_machine(int port)
 	state->rcvd_pdelay_resp_ptr = NULL;
 	state->rcvd_pdelay_follow_up_ptr = NULL;
 	state->tx_pdelay_req_ptr = NULL;
+	state->prop_delay_avg_valid = false;
 
 	state->ini_resp_evt_tstamp = 0U;
 	state->ini_resp_ingress_tstamp = 0U;
@@ -677,6 +677,57 @@ static void gptp_mi_clk_slave_sync_compute(void)
 }
 
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+#define GPTP_SERVO_LOCK_COUNT 4
+
+static void gptp_servo_step(struct gptp_servo *servo)
+{
+	servo->drift = 0;
+	servo->ppb = 0;
+	servo->lock_count = 0U;
+	servo->locked = false;
+	servo->steps++;
+}
+
+/* Return the frequency correction, in ppb, for the offset in ns between the
+ * master and the local clock. The gains are in 1/1000, and so is the
+ * integral part, so that everything is computed with integers.
+ */
+static s32_t gptp_servo_sample(struct gptp_servo *servo, s64_t offset)
+{
+	const s64_t max_drift = (s64_t)CONFIG_NET_GPTP_SERVO_MAX_PPB * 1000;
+	s64_t abs_offset = offset < 0 ? -offset : offset;
+	s64_t ppb;
+
+	servo->drift += offset * CONFIG_NET_GPTP_SERVO_KI;
+	servo->drift = MAX(MIN(servo->drift, max_drift), -max_drift);
+
+	ppb = (offset * CONFIG_NET_GPTP_SERVO_KP + servo->drift) / 1000;
+	ppb = MAX(MIN(ppb, CONFIG_NET_GPTP_SERVO_MAX_PPB),
+		  -CONFIG_NET_GPTP_SERVO_MAX_PPB);
+
+	if (servo->samples++ == 0U) {
+		servo->jitter = abs_offset;
+	} else {
+		servo->jitter += (abs_offset - servo->jitter) / 16;
+	}
+
+	if (abs_offset < CONFIG_NET_GPTP_SERVO_LOCK_THRESHOLD) {
+		if (servo->lock_count < GPTP_SERVO_LOCK_COUNT) {
+			servo->lock_count++;
+		}
+	} else {
+		servo->lock_count = 0U;
+	}
+
+	servo->locked = (servo->lock_count == GPTP_SERVO_LOCK_COUNT);
+	servo->offset = offset;
+	servo->ppb = ppb;
+
+	return ppb;
+}
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
+
 static void gptp_update_local_port_clock(void)
 {
 	struct gptp_clk_slave_sync_state *state;
@@ -724,7 +775,9 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -NSEC_PER_SEC + nanosecond_diff;
 	}
 
+#if !defined(CONFIG_NET_GPTP_SERVO_PI)
 	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+#endif
 
 	/* If time difference is too high, set the clock value.
 	 * Otherwise, adjust it.
@@ -756,7 +809,21 @@ static void gptp_update_local_port_clock(void)
 
 		ptp_clock_set(clk, &tm);
 		irq_unlock(key);
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		gptp_servo_step(&state->servo);
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+#endif
 	} else {
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		s32_t ppb = gptp_servo_sample(&state->servo, nanosecond_diff);
+
+		/* The clock API takes a ratio, this is the only floating
+		 * point operation of the servo.
+		 */
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio +
+				      (double)ppb / NSEC_PER_SEC);
+#else
 		if (nanosecond_diff < -200) {
 			nanosecond_diff = -200;
 		} else if (nanosecond_diff > 200) {
@@ -764,6 +831,7 @@ static void gptp_update_local_port_clock(void)
 		}
 
 		ptp_clock_adjust(clk, nanosecond_diff);
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
 	}
 }
 #endif /* CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE */
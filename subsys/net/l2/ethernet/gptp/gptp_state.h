@@ -191,6 +191,9 @@ struct gptp_pdelay_req_state {
 	/** Pointer to the Path Delay Request to be transmitted. */
 	struct net_pkt *tx_pdelay_req_ptr;
 
+	/** Average Path Delay, in ns scaled by the averaging factor. */
+	s64_t prop_delay_avg;
+
 	/** Path Delay Response messages received. */
 	u32_t rcvd_pdelay_resp;
 
@@ -214,6 +217,9 @@ struct gptp_pdelay_req_state {
 
 	/** Count consecutive Pdelay_req with multiple responses. */
 	u8_t multiple_resp_count;
+
+	/** The average Path Delay has been initialized. */
+	bool prop_delay_avg_valid;
 };
 
 /**
@@ -367,10 +373,44 @@ struct gptp_site_sync_sync_state {
 };
 
 /* ClockSlaveSync state machine variables. */
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+/* PI servo of the local clock. */
+struct gptp_servo {
+	/** Integral part of the correction, in ppb scaled by 1000. */
+	s64_t drift;
+
+	/** Offset measured at the last Sync, in ns. */
+	s64_t offset;
+
+	/** Average absolute offset, in ns. */
+	s64_t jitter;
+
+	/** Frequency correction applied at the last Sync, in ppb. */
+	s32_t ppb;
+
+	/** Number of offsets processed by the servo. */
+	u32_t samples;
+
+	/** Number of times the clock had to be set. */
+	u32_t steps;
+
+	/** Consecutive offsets under the lock threshold. */
+	u8_t lock_count;
+
+	/** The offset stays under the lock threshold. */
+	bool locked;
+};
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
+
 struct gptp_clk_slave_sync_state {
 	/** Pointer to the PortSyncSync structure received. */
 	struct gptp_mi_port_sync_sync *pss_rcv_ptr;
 
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+	/** Servo of the local clock. */
+	struct gptp_servo servo;
+#endif
+
 	/** Current state of the state machine. */
 	enum gptp_clk_slave_sync_states state;
 
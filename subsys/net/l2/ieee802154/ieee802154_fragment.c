@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_ieee802154_fragment,
 #include "net_private.h"
 #include "6lo.h"
 #include "6lo_private.h"
+#include "reassembly.h"
 
 #define NET_FRAG_DISPATCH_MASK	0xF8
 #define NET_FRAG_OFFSET_POS	(NET_6LO_FRAG_DATAGRAM_SIZE_LEN +	\
@@ -44,6 +45,8 @@ static u16_t datagram_tag;
 struct frag_cache {
 	struct k_delayed_work timer;	/* Reassemble timer */
 	struct net_pkt *pkt;		/* Reassemble packet */
+	struct net_buf *last;		/* Fragment with the highest offset */
+	struct net_reass ranges;	/* Received parts of the datagram */
 	u16_t size;			/* Datagram size */
 	u16_t tag;			/* Datagram tag */
 	bool used;
@@ -310,10 +313,13 @@ static inline struct frag_cache *set_reass_cache(struct net_pkt *pkt,
 		}
 
 		cache[i].pkt = pkt;
+		cache[i].last = NULL;
 		cache[i].size = size;
 		cache[i].tag = tag;
 		cache[i].used = true;
 
+		net_reass_init(&cache[i].ranges, size);
+
 		k_delayed_work_init(&cache[i].timer, reass_timeout);
 		k_delayed_work_submit(&cache[i].timer, FRAG_REASSEMBLY_TIMEOUT);
 		return &cache[i];
@@ -342,89 +348,86 @@ static inline struct frag_cache *get_reass_cache(u16_t size, u16_t tag)
 	return NULL;
 }
 
-static inline void fragment_append(struct net_pkt *pkt, struct net_buf *frag)
+static inline u16_t fragment_offset(struct net_buf *frag)
 {
 	if ((frag->data[0] & NET_FRAG_DISPATCH_MASK) ==
-	    NET_6LO_DISPATCH_FRAG1) {
-		/* Always make sure first fragment is inserted first
-		 * This will be useful for fragment_cached_pkt_len()
-		 */
-		frag->frags = pkt->buffer;
-		pkt->buffer = frag;
-	} else {
-		net_pkt_append_buffer(pkt, frag);
+		    NET_6LO_DISPATCH_FRAG1) {
+		return 0;
 	}
+
+	return ((u16_t)frag->data[NET_FRAG_OFFSET_POS] << 3);
 }
 
-static inline size_t fragment_cached_pkt_len(struct net_pkt *pkt)
+/**
+ *  Length of the fragment payload once uncompressed. FRAG1 carries the
+ *  compressed headers so their size difference is added here, only once
+ *  per datagram. Returns a negative value for a bogus header.
+ */
+static inline int fragment_uncompressed_len(struct net_pkt *pkt)
 {
-	size_t len = 0U;
-	struct net_buf *frag;
-	int hdr_len;
+	struct net_buf *frag = pkt->buffer;
+	int hdr_diff;
 	u8_t *data;
 
-	frag = pkt->buffer;
-	while (frag) {
-		u16_t hdr_len = NET_6LO_FRAGN_HDR_LEN;
-
-		if ((frag->data[0] & NET_FRAG_DISPATCH_MASK) ==
-		    NET_6LO_DISPATCH_FRAG1) {
-			hdr_len = NET_6LO_FRAG1_HDR_LEN;
-		}
-
-		len += frag->len - hdr_len;
-
-		frag = frag->frags;
+	if ((frag->data[0] & NET_FRAG_DISPATCH_MASK) !=
+	    NET_6LO_DISPATCH_FRAG1) {
+		return frag->len - NET_6LO_FRAGN_HDR_LEN;
 	}
 
-	/* 6lo assumes that fragment header has been removed,
-	 * and in our side we assume first buffer is always the first fragment.
-	 */
-	data = pkt->buffer->data;
-	pkt->buffer->data += NET_6LO_FRAG1_HDR_LEN;
-
-	hdr_len = net_6lo_uncompress_hdr_diff(pkt);
-
-	pkt->buffer->data = data;
+	/* 6lo assumes that fragment header has been removed */
+	data = frag->data;
+	frag->data += NET_6LO_FRAG1_HDR_LEN;
 
-	if (hdr_len == INT_MAX) {
-		return 0;
-	}
+	hdr_diff = net_6lo_uncompress_hdr_diff(pkt);
 
-	return len + hdr_len;
-}
+	frag->data = data;
 
-static inline u16_t fragment_offset(struct net_buf *frag)
-{
-	if ((frag->data[0] & NET_FRAG_DISPATCH_MASK) ==
-		    NET_6LO_DISPATCH_FRAG1) {
-		return 0;
+	if (hdr_diff == INT_MAX) {
+		return -EINVAL;
 	}
 
-	return ((u16_t)frag->data[NET_FRAG_OFFSET_POS] << 3);
+	return frag->len - NET_6LO_FRAG1_HDR_LEN + hdr_diff;
 }
 
-static void fragment_move_back(struct net_pkt *pkt,
-			       struct net_buf *frag, struct net_buf *stop)
+/**
+ *  Keep the cached fragments sorted by offset. Fragments arriving in
+ *  order are appended to the tail directly.
+ */
+static inline void fragment_insert(struct frag_cache *cache,
+				   struct net_buf *frag)
 {
 	struct net_buf *prev, *current;
+	u16_t offset = fragment_offset(frag);
 
-	prev = NULL;
-	current = pkt->buffer;
+	frag->frags = NULL;
 
-	while (current && current != stop) {
-		if (fragment_offset(frag) < fragment_offset(current)) {
-			if (prev) {
-				prev->frags = frag;
-			}
+	if (!cache->last) {
+		cache->pkt->buffer = frag;
+		cache->last = frag;
+		return;
+	}
 
-			frag->frags = current;
-			break;
-		}
+	if (offset > fragment_offset(cache->last)) {
+		cache->last->frags = frag;
+		cache->last = frag;
+		return;
+	}
+
+	prev = NULL;
+	current = cache->pkt->buffer;
 
+	while (fragment_offset(current) < offset) {
 		prev = current;
 		current = current->frags;
 	}
+
+	frag->frags = current;
+
+	if (prev) {
+		prev->frags = frag;
+	} else {
+		cache->pkt->buffer = frag;
+	}
 }
 
 static inline void fragment_remove_headers(struct net_pkt *pkt)
@@ -447,30 +450,6 @@ static inline void fragment_remove_headers(struct net_pkt *pkt)
 	}
 }
 
-static inline void fragment_reconstruct_packet(struct net_pkt *pkt)
-{
-	struct net_buf *prev, *current, *next;
-
-	prev = NULL;
-	current = pkt->buffer;
-
-	while (current) {
-		next = current->frags;
-
-		if (!prev || (fragment_offset(prev) >
-			      fragment_offset(current))) {
-			prev = current;
-		} else {
-			fragment_move_back(pkt, current, prev);
-		}
-
-		current = next;
-	}
-
-	/* Let's remove now useless fragmentation headers */
-	fragment_remove_headers(pkt);
-}
-
 /**
  *  Parse size and tag from the fragment, check if we have any cache
  *  related to it. If not create a new cache.
@@ -484,8 +463,10 @@ static inline enum net_verdict fragment_add_to_cache(struct net_pkt *pkt)
 	bool first_frag = false;
 	struct frag_cache *cache;
 	struct net_buf *frag;
+	u16_t offset;
 	u16_t size;
 	u16_t tag;
+	int len;
 
 	/* Parse total size of packet */
 	size = get_datagram_size(pkt->buffer->data);
@@ -494,6 +475,14 @@ static inline enum net_verdict fragment_add_to_cache(struct net_pkt *pkt)
 	tag = get_datagram_tag(pkt->buffer->data +
 			       NET_6LO_FRAG_DATAGRAM_SIZE_LEN);
 
+	offset = fragment_offset(pkt->buffer);
+
+	len = fragment_uncompressed_len(pkt);
+	if (len <= 0) {
+		NET_ERR("Could not get fragment length. Bogus packet?");
+		return NET_DROP;
+	}
+
 	/* If there are no fragments in the cache means this frag
 	 * is the first one. So cache Rx pkt otherwise not.
 	 */
@@ -512,14 +501,35 @@ static inline enum net_verdict fragment_add_to_cache(struct net_pkt *pkt)
 		first_frag = true;
 	}
 
-	fragment_append(cache->pkt, frag);
+	if (net_reass_add(&cache->ranges, offset, len, false) < 0) {
+		NET_DBG("Dropping fragment offset %u len %d", offset, len);
+
+		if (first_frag) {
+			cache->pkt = NULL;
+			clear_reass_cache(size, tag);
+		}
 
-	if (fragment_cached_pkt_len(cache->pkt) == cache->size) {
+		pkt->buffer = frag;
+		return NET_DROP;
+	}
+
+	fragment_insert(cache, frag);
+
+	if (net_reass_is_complete(&cache->ranges)) {
 		/* Assign buffer back to input packet. */
-		pkt->buffer = cache->pkt->buffer;
+		frag = cache->pkt->buffer;
 		cache->pkt->buffer = NULL;
+		pkt->buffer = frag;
+
+		if (first_frag) {
+			/* Single fragment datagram, pkt is the cached one */
+			cache->pkt = NULL;
+		}
 
-		fragment_reconstruct_packet(pkt);
+		/* Fragments are already in order, let's remove now useless
+		 * fragmentation headers.
+		 */
+		fragment_remove_headers(pkt);
 
 		/* Once reassemble is done, cache is no longer needed. */
 		clear_reass_cache(size, tag);
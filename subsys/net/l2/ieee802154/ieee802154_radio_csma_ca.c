@@ -29,6 +29,8 @@ static inline int csma_ca_radio_send(struct net_if *iface,
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	bool ack_required = prepare_for_ack(ctx, pkt, frag);
 	u8_t be = CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE;
+	bool hw_csma = ieee802154_get_hw_capabilities(iface) &
+		IEEE802154_HW_CSMA;
 	u8_t nb = 0U;
 	int ret = -EIO;
 
@@ -38,22 +40,25 @@ loop:
 	while (retries) {
 		retries--;
 
-		if (be) {
-			u8_t bo_n = sys_rand32_get() & ((1 << be) - 1);
+		/* Radios doing CSMA-CA on their own just need the retries */
+		if (!hw_csma) {
+			if (be) {
+				u8_t bo_n = sys_rand32_get() & ((1 << be) - 1);
 
-			k_busy_wait(bo_n * 20U);
-		}
-
-		while (1) {
-			if (!ieee802154_cca(iface)) {
-				break;
+				k_busy_wait(bo_n * 20U);
 			}
 
-			be = MIN(be + 1, max_be);
-			nb++;
+			while (1) {
+				if (!ieee802154_cca(iface)) {
+					break;
+				}
+
+				be = MIN(be + 1, max_be);
+				nb++;
 
-			if (nb > max_bo) {
-				goto loop;
+				if (nb > max_bo) {
+					goto loop;
+				}
 			}
 		}
 
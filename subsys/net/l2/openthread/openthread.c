@@ -57,6 +57,9 @@ extern void platformShellInit(otInstance *aInstance);
 
 K_SEM_DEFINE(ot_sem, 0, 1);
 
+/* Received 802.15.4 frames waiting to be handed to OpenThread */
+static K_FIFO_DEFINE(rx_pkt_fifo);
+
 K_THREAD_STACK_DEFINE(ot_stack_area, OT_STACK_SIZE);
 static struct k_thread ot_thread_data;
 static k_tid_t ot_tid;
@@ -223,16 +226,61 @@ void ot_joiner_start_handler(otError error, void *context)
 	}
 }
 
+static void openthread_handle_frame(struct openthread_context *ot_context,
+				    struct net_pkt *pkt)
+{
+	otRadioFrame recv_frame;
+
+	/* The PSDU points into the packet buffer, which is only released
+	 * once OpenThread is done with the frame.
+	 */
+	recv_frame.mPsdu = net_buf_frag_last(pkt->buffer)->data;
+	/* Length inc. CRC. */
+	recv_frame.mLength = net_buf_frags_len(pkt->buffer);
+	recv_frame.mChannel = platformRadioChannelGet(ot_context->instance);
+	recv_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(pkt);
+	recv_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi(pkt);
+
+#if defined(CONFIG_OPENTHREAD_L2_DEBUG_DUMP_15_4)
+	net_pkt_hexdump(pkt, "Received 802.15.4 frame");
+#endif
+
+#if OPENTHREAD_ENABLE_DIAG
+	if (otPlatDiagModeGet()) {
+		otPlatDiagRadioReceiveDone(ot_context->instance,
+					   &recv_frame, OT_ERROR_NONE);
+	} else
+#endif
+	{
+		otPlatRadioReceiveDone(ot_context->instance,
+				       &recv_frame, OT_ERROR_NONE);
+	}
+
+	net_pkt_unref(pkt);
+}
+
 static void openthread_process(void *context, void *arg2, void *arg3)
 {
 	struct openthread_context *ot_context = context;
+	struct net_pkt *pkt;
 
 	while (1) {
-		while (otTaskletsArePending(ot_context->instance)) {
-			otTaskletsProcess(ot_context->instance);
-		}
+		/* Everything that got queued since the last wakeup is
+		 * handled in one go: all received frames first, then the
+		 * tasklets they scheduled, until nothing is left to do.
+		 */
+		do {
+			while ((pkt = k_fifo_get(&rx_pkt_fifo, K_NO_WAIT))) {
+				openthread_handle_frame(ot_context, pkt);
+			}
+
+			while (otTaskletsArePending(ot_context->instance)) {
+				otTaskletsProcess(ot_context->instance);
+			}
 
-		otSysProcessDrivers(ot_context->instance);
+			otSysProcessDrivers(ot_context->instance);
+		} while (!k_fifo_is_empty(&rx_pkt_fifo) ||
+			 otTaskletsArePending(ot_context->instance));
 
 		k_sem_take(&ot_sem, K_FOREVER);
 	}
@@ -253,33 +301,13 @@ static enum net_verdict openthread_recv(struct net_if *iface,
 		return NET_CONTINUE;
 	}
 
-	NET_DBG("Got 802.15.4 packet, sending to OT");
-
-	otRadioFrame recv_frame;
-
-	recv_frame.mPsdu = net_buf_frag_last(pkt->buffer)->data;
-	/* Length inc. CRC. */
-	recv_frame.mLength = net_buf_frags_len(pkt->buffer);
-	recv_frame.mChannel = platformRadioChannelGet(ot_context->instance);
-	recv_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(pkt);
-	recv_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi(pkt);
+	NET_DBG("Got 802.15.4 packet, queuing it for OT");
 
-#if defined(CONFIG_OPENTHREAD_L2_DEBUG_DUMP_15_4)
-	net_pkt_hexdump(pkt, "Received 802.15.4 frame");
-#endif
-
-#if OPENTHREAD_ENABLE_DIAG
-	if (otPlatDiagModeGet()) {
-		otPlatDiagRadioReceiveDone(ot_context->instance,
-					   &recv_frame, OT_ERROR_NONE);
-	} else
-#endif
-	{
-		otPlatRadioReceiveDone(ot_context->instance,
-				       &recv_frame, OT_ERROR_NONE);
-	}
-
-	net_pkt_unref(pkt);
+	/* OpenThread is not thread safe, so the frame is handed over to
+	 * its own thread.
+	 */
+	k_fifo_put(&rx_pkt_fifo, pkt);
+	k_sem_give(&ot_sem);
 
 	return NET_OK;
 }
@@ -922,6 +922,21 @@ static int get_block_option(const struct coap_packet *cpkt, u16_t code)
 	return val;
 }
 
+int coap_get_block2_option(const struct coap_packet *cpkt, bool *has_more,
+			   u32_t *block_number)
+{
+	int block = get_block_option(cpkt, COAP_OPTION_BLOCK2);
+
+	if (block < 0) {
+		return block;
+	}
+
+	*has_more = GET_MORE(block);
+	*block_number = GET_NUM(block);
+
+	return coap_block_size_to_bytes(GET_BLOCK_SIZE(block));
+}
+
 static int update_descriptive_block(struct coap_block_context *ctx,
 				    int block, int size)
 {
@@ -283,9 +283,8 @@ static void setup_ipv6(struct net_if *iface, u32_t flags)
 
 int net_config_init(const char *app_info, u32_t flags, s32_t timeout)
 {
-#define LOOP_DIVIDER 10
 	struct net_if *iface = net_if_get_default();
-	int loop = timeout / LOOP_DIVIDER;
+	s64_t end = k_uptime_get() + timeout;
 	int count = 0;
 
 	if (app_info) {
@@ -313,26 +312,24 @@ int net_config_init(const char *app_info, u32_t flags, s32_t timeout)
 
 	setup_ipv6(iface, flags);
 
-	if (timeout < 0) {
-		count = -1;
-	} else if (timeout == 0) {
-		count = 0;
-	} else {
-		count = timeout / 1000 + 1;
-	}
-
-	/* Loop here until we are ready to continue. As we might need
-	 * to wait multiple events, sleep smaller amounts of data.
+	/* All the setups above run concurrently, wait here until each of
+	 * them is done. The counter is checked as soon as any of them
+	 * signals the waiter.
 	 */
-	while (count--) {
-		if (k_sem_take(&waiter, loop)) {
-			if (!k_sem_count_get(&counter)) {
+	while (k_sem_count_get(&counter)) {
+		s32_t remaining = K_FOREVER;
+
+		if (timeout >= 0) {
+			remaining = end - k_uptime_get();
+			if (remaining <= 0) {
 				break;
 			}
 		}
+
+		(void)k_sem_take(&waiter, remaining);
 	}
 
-	if (!count && timeout) {
+	if (k_sem_count_get(&counter) && timeout) {
 		NET_ERR("Timeout while waiting setup");
 		return -ETIMEDOUT;
 	}
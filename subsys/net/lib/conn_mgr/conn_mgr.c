@@ -132,6 +132,8 @@ static void conn_mgr_initial_state(struct net_if *iface)
 			iface_states[idx] |= NET_STATE_IPV6_ADDR_SET |
 						NET_STATE_IPV6_DAD_OK;
 		} else if (net_if_ipv6_get_global_addr(NET_ADDR_TENTATIVE,
+						       &iface) ||
+			   net_if_ipv6_get_global_addr(NET_ADDR_OPTIMISTIC,
 						       &iface)) {
 			iface_states[idx] |= NET_STATE_IPV6_ADDR_SET;
 		}
@@ -0,0 +1,172 @@
+/** @file
+ * @brief DNS resolver answer cache
+ *
+ * Keeps the addresses returned for recent queries until their TTL runs
+ * out, and remembers names that did not resolve for a shorter while.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <kernel.h>
+#include <string.h>
+#include <errno.h>
+
+#include <net/net_ip.h>
+#include <net/dns_resolve.h>
+#include "dns_cache.h"
+
+struct dns_cache_entry {
+	/** Uptime when the entry expires, 0 for unused entries */
+	s64_t expiry;
+
+	/** Time to live the entry was stored with, in ms */
+	u32_t ttl;
+
+	/** Resolved addresses, none for a negative entry */
+	struct sockaddr addr[CONFIG_DNS_RESOLVER_CACHE_ADDRS];
+
+	/** Number of entries in addr */
+	u8_t count;
+
+	/** Query type, A or AAAA */
+	u8_t type;
+
+	/** Has the refresh been reported already */
+	bool refreshing;
+
+	/** Queried name */
+	char name[CONFIG_DNS_RESOLVER_CACHE_NAME_LEN + 1];
+};
+
+static struct dns_cache_entry cache[CONFIG_DNS_RESOLVER_CACHE_ENTRIES];
+static K_MUTEX_DEFINE(cache_lock);
+
+static struct dns_cache_entry *cache_lookup(const char *name,
+					    enum dns_query_type type,
+					    s64_t now)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].expiry > now && cache[i].type == type &&
+		    !strcmp(cache[i].name, name)) {
+			return &cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+void dns_cache_add(const char *name, enum dns_query_type type,
+		   const struct dns_addrinfo *info, int count, u32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	s64_t now = k_uptime_get();
+	int i;
+
+	if (strlen(name) > CONFIG_DNS_RESOLVER_CACHE_NAME_LEN) {
+		return;
+	}
+
+	if (count == 0) {
+		ttl = CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL;
+	}
+
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+	if (ttl == 0U) {
+		return;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	entry = cache_lookup(name, type, now);
+	if (!entry) {
+		/* Replace the entry which would be the first to go anyway,
+		 * expired and unused ones have the lowest expiry.
+		 */
+		entry = &cache[0];
+		for (i = 1; i < ARRAY_SIZE(cache); i++) {
+			if (cache[i].expiry < entry->expiry) {
+				entry = &cache[i];
+			}
+		}
+	}
+
+	entry->type = type;
+	entry->ttl = K_SECONDS(ttl);
+	entry->expiry = now + entry->ttl;
+	entry->refreshing = false;
+	strcpy(entry->name, name);
+
+	entry->count = MIN(count, ARRAY_SIZE(entry->addr));
+	for (i = 0; i < entry->count; i++) {
+		memcpy(&entry->addr[i], &info[i].ai_addr,
+		       sizeof(entry->addr[i]));
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	NET_DBG("Cached %d address(es) for %s (ttl %u)", entry->count,
+		log_strdup(name), ttl);
+}
+
+int dns_cache_find(const char *name, enum dns_query_type type,
+		   struct dns_addrinfo *info, int max, bool *refresh)
+{
+	struct dns_cache_entry *entry;
+	s64_t now = k_uptime_get();
+	int i, count;
+
+	*refresh = false;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	entry = cache_lookup(name, type, now);
+	if (!entry) {
+		k_mutex_unlock(&cache_lock);
+		return -ENOENT;
+	}
+
+	count = MIN(entry->count, max);
+	for (i = 0; i < count; i++) {
+		(void)memset(&info[i], 0, sizeof(info[i]));
+		memcpy(&info[i].ai_addr, &entry->addr[i],
+		       sizeof(info[i].ai_addr));
+		info[i].ai_family = entry->addr[i].sa_family;
+
+		if (info[i].ai_family == AF_INET6) {
+			info[i].ai_addrlen = sizeof(struct sockaddr_in6);
+		} else {
+			info[i].ai_addrlen = sizeof(struct sockaddr_in);
+		}
+	}
+
+	/* Renew positive answers a bit before they expire, so that
+	 * frequent lookups of the same name keep hitting the cache.
+	 */
+	if (entry->count && !entry->refreshing &&
+	    (entry->expiry - now) * 100 <
+	    (s64_t)entry->ttl * CONFIG_DNS_RESOLVER_CACHE_PREFETCH) {
+		entry->refreshing = true;
+		*refresh = true;
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return count;
+}
+
+void dns_cache_flush(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	(void)memset(cache, 0, sizeof(cache));
+	k_mutex_unlock(&cache_lock);
+}
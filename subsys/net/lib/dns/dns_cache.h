@@ -0,0 +1,61 @@
+/** @file
+ * @brief DNS resolver answer cache
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _DNS_CACHE_H_
+#define _DNS_CACHE_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <net/dns_resolve.h>
+
+/**
+ * @brief Store the answer to a query in the cache.
+ *
+ * @details An existing entry for the same name and type is replaced,
+ * otherwise the entry closest to expiry is reused. Names longer than
+ * CONFIG_DNS_RESOLVER_CACHE_NAME_LEN are not cached.
+ *
+ * @param name Name that was queried
+ * @param type Query type
+ * @param info Resolved addresses
+ * @param count Number of addresses in info, 0 to store that the name
+ *        does not resolve.
+ * @param ttl Time to live of the answer in seconds. It is limited to
+ *        CONFIG_DNS_RESOLVER_CACHE_MAX_TTL, and replaced by
+ *        CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL if count is 0.
+ */
+void dns_cache_add(const char *name, enum dns_query_type type,
+		   const struct dns_addrinfo *info, int count, u32_t ttl);
+
+/**
+ * @brief Look for a cached answer.
+ *
+ * @param name Name to resolve
+ * @param type Query type
+ * @param info Where to copy the cached addresses
+ * @param max Number of entries in info
+ * @param refresh Set to true if the entry is about to expire, the caller
+ *        is then expected to refresh it. This is only reported once per
+ *        entry.
+ *
+ * @return Number of addresses copied, 0 if the name is known not to
+ * resolve, -ENOENT if there is no valid entry.
+ */
+int dns_cache_find(const char *name, enum dns_query_type type,
+		   struct dns_addrinfo *info, int max, bool *refresh);
+
+/**
+ * @brief Remove all the entries from the cache.
+ */
+void dns_cache_flush(void);
+
+#endif /* _DNS_CACHE_H_ */
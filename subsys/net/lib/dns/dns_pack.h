@@ -86,7 +86,11 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
-	DNS_RR_TYPE_AAAA = 28		/* IPv6  */
+	DNS_RR_TYPE_PTR = 12,		/* PTR   */
+	DNS_RR_TYPE_TXT = 16,		/* TXT   */
+	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
+	DNS_RR_TYPE_SRV = 33,		/* SRV   */
+	DNS_RR_TYPE_ANY = 255		/* ANY   */
 };
 
 enum dns_response_type {
@@ -99,6 +103,7 @@ enum dns_response_type {
 enum dns_class {
 	DNS_CLASS_INVALID = 0,
 	DNS_CLASS_IN,
+	DNS_CLASS_ANY = 255,
 };
 
 enum dns_msg_type {
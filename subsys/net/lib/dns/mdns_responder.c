@@ -17,12 +17,16 @@ LOG_MODULE_REGISTER(net_mdns_responder, CONFIG_MDNS_RESPONDER_LOG_LEVEL);
 #include <init.h>
 #include <string.h>
 #include <strings.h>
+#include <ctype.h>
 #include <errno.h>
 #include <stdlib.h>
 
 #include <net/net_ip.h>
 #include <net/net_pkt.h>
+#include <net/net_mgmt.h>
+#include <net/net_event.h>
 #include <net/dns_resolve.h>
+#include <net/mdns_responder.h>
 
 #include "dns_pack.h"
 #include "ipv6.h"
@@ -33,6 +37,29 @@ LOG_MODULE_REGISTER(net_mdns_responder, CONFIG_MDNS_RESPONDER_LOG_LEVEL);
 
 #define MDNS_TTL CONFIG_MDNS_RESPONDER_TTL /* In seconds */
 
+/* A record is multicast at most once per second, RFC 6762 ch 6 */
+#define MDNS_RATE_LIMIT K_SECONDS(1)
+
+/* Longest name in wire format, RFC 1035 ch 2.3.4 */
+#define MDNS_NAME_MAX_LEN 255
+
+/* Bound on the compression pointers followed in a single name */
+#define MDNS_NAME_MAX_PTRS 16
+
+/* Bit 15 of the class asks to flush the cache in a record, and for an
+ * unicast response in a question.
+ */
+#define MDNS_CLASS_FLUSH BIT(15)
+
+#define MDNS_RR_FIXED_LEN (DNS_QTYPE_LEN + DNS_QCLASS_LEN + \
+			   DNS_TTL_LEN + DNS_RDLENGTH_LEN)
+
+/* Priority, weight and port come before the SRV target name */
+#define MDNS_SRV_FIXED_LEN 6
+
+/* Index of the per family send times of a record */
+#define FAMILY_IDX(family) ((family) == AF_INET6 ? 1 : 0)
+
 static struct net_context *ipv4;
 static struct net_context *ipv6;
 
@@ -47,6 +74,53 @@ static struct net_context *ipv6;
 NET_BUF_POOL_DEFINE(mdns_msg_pool, DNS_RESOLVER_BUF_CTR,
 		    DNS_RESOLVER_MAX_BUF_SIZE, 0, NULL);
 
+/** Serialized resource record, ready to be copied to a response */
+struct mdns_record {
+	/** Interface the record is valid on, NULL for all of them */
+	struct net_if *iface;
+
+	/** Uptime when the record was last multicast, per family */
+	s64_t last_sent[2];
+
+	/** Offset of the record in records_buf */
+	u16_t offset;
+
+	/** Length of the whole record */
+	u16_t len;
+
+	/** Length of the owner name the record starts with */
+	u16_t name_len;
+
+	/** Record type */
+	u16_t type;
+
+	/** Service the record describes, -1 for host records and service
+	 * type enumeration.
+	 */
+	s8_t service;
+};
+
+/* The answers are only rebuilt when the hostname, an address or a service
+ * changes, responding to a query is then a matter of copying records.
+ */
+static u8_t records_buf[CONFIG_MDNS_RESPONDER_RECORDS_SIZE];
+static struct mdns_record records[CONFIG_MDNS_RESPONDER_RECORDS];
+static u16_t records_used;
+static u8_t records_count;
+static bool records_valid;
+static char records_hostname[DNS_LABEL_MAX_SIZE + 1];
+static K_MUTEX_DEFINE(records_lock);
+
+/* Scratch space for names, used with records_lock held */
+static u8_t name_buf[MDNS_NAME_MAX_LEN];
+static u8_t rdata_buf[MDNS_SRV_FIXED_LEN + MDNS_NAME_MAX_LEN];
+
+#if defined(CONFIG_MDNS_RESPONDER_DNS_SD)
+static const struct mdns_service *services[CONFIG_MDNS_RESPONDER_DNS_SD_SERVICES];
+#endif
+
+static struct net_mgmt_event_callback mgmt_cb[2];
+
 #if defined(CONFIG_NET_IPV6)
 static void create_ipv6_addr(struct sockaddr_in6 *addr)
 {
@@ -105,7 +179,7 @@ static int bind_ctx(struct net_context *ctx,
 	return ret;
 }
 
-static void setup_dns_hdr(u8_t *buf, u16_t answers)
+static void setup_dns_hdr(u8_t *buf, u16_t answers, u16_t additional)
 {
 	u16_t offset;
 	u16_t flags;
@@ -130,138 +204,595 @@ static void setup_dns_hdr(u8_t *buf, u16_t answers)
 	UNALIGNED_PUT(0, (u16_t *)(buf + offset));
 	offset += DNS_NSCOUNT_LEN;
 
-	UNALIGNED_PUT(0, (u16_t *)(buf + offset));
+	UNALIGNED_PUT(htons(additional), (u16_t *)(buf + offset));
 }
 
-static void add_answer(struct net_buf *query, enum dns_rr_type qtype,
-		       u32_t ttl, u16_t addr_len, u8_t *addr)
+/* Encode the labels followed by "local" in wire format */
+static int name_encode(u8_t *buf, const char *const *labels, int count)
 {
-	char *dot = query->data + DNS_MSG_HEADER_SIZE;
-	char *prev = NULL;
-	u16_t offset;
+	const char *label;
+	size_t label_len;
+	int len = 0;
+	int i;
+
+	for (i = 0; i <= count; i++) {
+		label = i < count ? labels[i] : "local";
+		label_len = strlen(label);
+
+		if (label_len == 0 || label_len > DNS_LABEL_MAX_SIZE ||
+		    len + DNS_LABEL_LEN_SIZE + label_len + 1 >
+		    MDNS_NAME_MAX_LEN) {
+			return -EINVAL;
+		}
+
+		buf[len++] = label_len;
+		memcpy(&buf[len], label, label_len);
+		len += label_len;
+	}
+
+	buf[len++] = 0U;
+
+	return len;
+}
+
+/* Copy the possibly compressed name at *pos to buf in wire format, and
+ * move *pos past the name.
+ */
+static int name_decode(const u8_t *msg, u16_t msg_len, u16_t *pos, u8_t *buf)
+{
+	u16_t offset = *pos;
+	bool jumped = false;
+	u8_t label_len;
+	int ptrs = 0;
+	int len = 0;
+
+	do {
+		if (offset >= msg_len) {
+			return -EINVAL;
+		}
+
+		label_len = msg[offset];
+
+		if ((label_len & NS_CMPRSFLGS) == NS_CMPRSFLGS) {
+			if (offset + 1 >= msg_len ||
+			    ++ptrs > MDNS_NAME_MAX_PTRS) {
+				return -EINVAL;
+			}
 
-	while ((dot = strchr(dot, '.'))) {
-		if (!prev) {
-			prev = dot++;
+			if (!jumped) {
+				*pos = offset + 2;
+				jumped = true;
+			}
+
+			offset = ((label_len & ~NS_CMPRSFLGS) << 8) |
+				 msg[offset + 1];
 			continue;
 		}
 
-		*prev = dot - prev - 1;
-		prev = dot++;
-	}
+		if (label_len > DNS_LABEL_MAX_SIZE ||
+		    len + DNS_LABEL_LEN_SIZE + label_len > MDNS_NAME_MAX_LEN ||
+		    offset + DNS_LABEL_LEN_SIZE + label_len > msg_len) {
+			return -EINVAL;
+		}
 
-	if (prev) {
-		*prev = strlen(prev) - 1;
+		memcpy(&buf[len], &msg[offset], DNS_LABEL_LEN_SIZE + label_len);
+		len += DNS_LABEL_LEN_SIZE + label_len;
+		offset += DNS_LABEL_LEN_SIZE + label_len;
+	} while (label_len);
+
+	if (!jumped) {
+		*pos = offset;
 	}
 
-	/* terminator byte (0x00) */
-	query->len += 1;
+	return len;
+}
 
-	offset = DNS_MSG_HEADER_SIZE + query->len;
-	UNALIGNED_PUT(htons(qtype), (u16_t *)(query->data+offset));
+/* Names compare case insensitively, the label lengths are not affected */
+static bool name_eq(const u8_t *a, u16_t a_len, const u8_t *b, u16_t b_len)
+{
+	u16_t i;
 
-	/* Bit 15 tells to flush the cache */
-	offset += DNS_QTYPE_LEN;
-	UNALIGNED_PUT(htons(DNS_CLASS_IN | BIT(15)),
-		      (u16_t *)(query->data+offset));
+	if (a_len != b_len) {
+		return false;
+	}
 
+	for (i = 0U; i < a_len; i++) {
+		if (tolower(a[i]) != tolower(b[i])) {
+			return false;
+		}
+	}
 
-	offset += DNS_QCLASS_LEN;
-	UNALIGNED_PUT(htonl(ttl), query->data + offset);
+	return true;
+}
 
-	offset += DNS_TTL_LEN;
-	UNALIGNED_PUT(htons(addr_len), query->data + offset);
+static inline const u8_t *record_name(const struct mdns_record *record)
+{
+	return &records_buf[record->offset];
+}
+
+static inline const u8_t *record_rdata(const struct mdns_record *record)
+{
+	return &records_buf[record->offset + record->name_len +
+			    MDNS_RR_FIXED_LEN];
+}
 
-	offset += DNS_RDLENGTH_LEN;
-	memcpy(query->data + offset, addr, addr_len);
+static inline u16_t record_rdata_len(const struct mdns_record *record)
+{
+	return record->len - record->name_len - MDNS_RR_FIXED_LEN;
+}
+
+static inline bool record_is_host(const struct mdns_record *record)
+{
+	return record->type == DNS_RR_TYPE_A ||
+		record->type == DNS_RR_TYPE_AAAA;
 }
 
-static int create_answer(struct net_context *ctx,
-			 struct net_buf *query,
-			 enum dns_rr_type qtype,
-			 u16_t addr_len, u8_t *addr)
+static int record_add(struct net_if *iface, s8_t service,
+		      const u8_t *name, u16_t name_len,
+		      enum dns_rr_type type, bool unique,
+		      const u8_t *rdata, u16_t rdata_len)
 {
-	/* Prepare the response into the query buffer: move the name
-	 * query buffer has to get enough free space: dns_hdr + answer
+	struct mdns_record *record;
+	u16_t class = DNS_CLASS_IN;
+	u8_t *buf;
+
+	if (records_count == ARRAY_SIZE(records) ||
+	    records_used + name_len + MDNS_RR_FIXED_LEN + rdata_len >
+	    sizeof(records_buf)) {
+		return -ENOMEM;
+	}
+
+	/* Only the records nobody else owns flush the caches,
+	 * see RFC 6762 ch 10.2.
 	 */
-	if ((query->size - query->len) < (DNS_MSG_HEADER_SIZE +
-					  DNS_QTYPE_LEN + DNS_QCLASS_LEN +
-					  DNS_TTL_LEN + DNS_RDLENGTH_LEN +
-					  addr_len)) {
-		return -ENOBUFS;
+	if (unique) {
+		class |= MDNS_CLASS_FLUSH;
 	}
 
-	memmove(query->data + DNS_MSG_HEADER_SIZE, query->data, query->len);
+	record = &records[records_count++];
+	record->iface = iface;
+	record->service = service;
+	record->type = type;
+	record->offset = records_used;
+	record->name_len = name_len;
+	record->len = name_len + MDNS_RR_FIXED_LEN + rdata_len;
+	record->last_sent[0] = -MDNS_RATE_LIMIT;
+	record->last_sent[1] = -MDNS_RATE_LIMIT;
+
+	buf = &records_buf[records_used];
+	records_used += record->len;
+
+	memcpy(buf, name, name_len);
+	buf += name_len;
+
+	UNALIGNED_PUT(htons(type), (u16_t *)buf);
+	buf += DNS_QTYPE_LEN;
 
-	setup_dns_hdr(query->data, 1);
+	UNALIGNED_PUT(htons(class), (u16_t *)buf);
+	buf += DNS_QCLASS_LEN;
 
-	add_answer(query, qtype, MDNS_TTL, addr_len, addr);
+	UNALIGNED_PUT(htonl(MDNS_TTL), (u32_t *)buf);
+	buf += DNS_TTL_LEN;
 
-	query->len += DNS_MSG_HEADER_SIZE +
-		DNS_QTYPE_LEN + DNS_QCLASS_LEN +
-		DNS_TTL_LEN + DNS_RDLENGTH_LEN + addr_len;
+	UNALIGNED_PUT(htons(rdata_len), (u16_t *)buf);
+	buf += DNS_RDLENGTH_LEN;
+
+	memcpy(buf, rdata, rdata_len);
 
 	return 0;
 }
 
-static int send_response(struct net_context *ctx,
-			 struct net_pkt *pkt,
-			 union net_ip_header *ip_hdr,
-			 struct net_buf *query,
-			 enum dns_rr_type qtype)
+struct host_name {
+	u8_t name[MDNS_NAME_MAX_LEN];
+	int len;
+};
+
+static void iface_records_cb(struct net_if *iface, void *user_data)
 {
-	struct sockaddr dst;
-	socklen_t dst_len;
-	int ret;
+	struct host_name *host = user_data;
+	struct net_if_addr *ifaddr;
+	int i;
 
-	if (qtype == DNS_RR_TYPE_A) {
 #if defined(CONFIG_NET_IPV4)
-		const struct in_addr *addr;
+	for (i = 0; iface->config.ip.ipv4 && i < NET_IF_MAX_IPV4_ADDR; i++) {
+		ifaddr = &iface->config.ip.ipv4->unicast[i];
+		if (!ifaddr->is_used ||
+		    ifaddr->addr_state != NET_ADDR_PREFERRED) {
+			continue;
+		}
 
-		addr = net_if_ipv4_select_src_addr(net_pkt_iface(pkt),
-						   &ip_hdr->ipv4->src);
+		if (record_add(iface, -1, host->name, host->len,
+			       DNS_RR_TYPE_A, true,
+			       (u8_t *)&ifaddr->address.in_addr,
+			       sizeof(struct in_addr)) < 0) {
+			NET_WARN("No room for the records of iface %p", iface);
+			return;
+		}
+	}
+#endif /* CONFIG_NET_IPV4 */
 
-		create_ipv4_addr(net_sin(&dst));
-		dst_len = sizeof(struct sockaddr_in);
+#if defined(CONFIG_NET_IPV6)
+	for (i = 0; iface->config.ip.ipv6 && i < NET_IF_MAX_IPV6_ADDR; i++) {
+		ifaddr = &iface->config.ip.ipv6->unicast[i];
+		if (!ifaddr->is_used ||
+		    ifaddr->addr_state != NET_ADDR_PREFERRED) {
+			continue;
+		}
+
+		if (record_add(iface, -1, host->name, host->len,
+			       DNS_RR_TYPE_AAAA, true,
+			       (u8_t *)&ifaddr->address.in6_addr,
+			       sizeof(struct in6_addr)) < 0) {
+			NET_WARN("No room for the records of iface %p", iface);
+			return;
+		}
+	}
+#endif /* CONFIG_NET_IPV6 */
+}
+
+#if defined(CONFIG_MDNS_RESPONDER_DNS_SD)
+static bool service_type_eq(const struct mdns_service *a,
+			    const struct mdns_service *b)
+{
+	return !strncasecmp(a->service, b->service, DNS_LABEL_MAX_SIZE) &&
+		!strncasecmp(a->proto, b->proto, DNS_LABEL_MAX_SIZE);
+}
+
+static int service_records_add(int idx, const struct host_name *host)
+{
+	static const char *const enum_labels[] = {
+		"_services", "_dns-sd", "_udp"
+	};
+	const struct mdns_service *service = services[idx];
+	const char *labels[] = {
+		service->instance, service->service, service->proto
+	};
+	u8_t *type_name = &rdata_buf[MDNS_SRV_FIXED_LEN];
+	int name_len, type_len, ret, i;
+
+	/* <instance>.<service>.<proto>.local */
+	name_len = name_encode(name_buf, labels, ARRAY_SIZE(labels));
+	if (name_len < 0) {
+		return name_len;
+	}
+
+	/* <service>.<proto>.local PTR <instance>.<service>.<proto>.local */
+	type_len = name_encode(type_name, &labels[1], ARRAY_SIZE(labels) - 1);
+	if (type_len < 0) {
+		return type_len;
+	}
+
+	ret = record_add(NULL, idx, type_name, type_len, DNS_RR_TYPE_PTR,
+			 false, name_buf, name_len);
+	if (ret < 0) {
+		return ret;
+	}
 
-		ret = create_answer(ctx, query, qtype,
-				      sizeof(struct in_addr), (u8_t *)addr);
-		if (ret != 0) {
+	/* Browsing for service types lists every type once, RFC 6763 ch 9 */
+	for (i = 0; i < idx; i++) {
+		if (services[i] && service_type_eq(services[i], service)) {
+			break;
+		}
+	}
+
+	if (i == idx) {
+		u8_t enum_name[sizeof("_services._dns-sd._udp.local") + 1];
+		int enum_len;
+
+		enum_len = name_encode(enum_name, enum_labels,
+				       ARRAY_SIZE(enum_labels));
+
+		ret = record_add(NULL, -1, enum_name, enum_len,
+				 DNS_RR_TYPE_PTR, false, type_name, type_len);
+		if (ret < 0) {
 			return ret;
 		}
+	}
+
+	UNALIGNED_PUT(0, (u16_t *)&rdata_buf[0]); /* Priority */
+	UNALIGNED_PUT(0, (u16_t *)&rdata_buf[2]); /* Weight */
+	UNALIGNED_PUT(htons(service->port), (u16_t *)&rdata_buf[4]);
+	memcpy(&rdata_buf[MDNS_SRV_FIXED_LEN], host->name, host->len);
+
+	ret = record_add(NULL, idx, name_buf, name_len, DNS_RR_TYPE_SRV,
+			 true, rdata_buf, MDNS_SRV_FIXED_LEN + host->len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* An empty TXT record holds a single empty string, RFC 6763 ch 6.1 */
+	if (service->txt_len) {
+		ret = record_add(NULL, idx, name_buf, name_len,
+				 DNS_RR_TYPE_TXT, true, service->txt,
+				 service->txt_len);
+	} else {
+		ret = record_add(NULL, idx, name_buf, name_len,
+				 DNS_RR_TYPE_TXT, true, (const u8_t *)"", 1);
+	}
+
+	return ret;
+}
+
+static void services_records_add(const struct host_name *host)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(services); i++) {
+		if (services[i] && service_records_add(i, host) < 0) {
+			NET_WARN("No room for the records of service %s",
+				 log_strdup(services[i]->instance));
+		}
+	}
+}
+#else
+#define services_records_add(...)
+#endif /* CONFIG_MDNS_RESPONDER_DNS_SD */
+
+static void records_build(void)
+{
+	static struct host_name host;
+	const char *hostname = net_hostname_get();
+
+	records_count = 0U;
+	records_used = 0U;
+	records_valid = true;
+
+	strncpy(records_hostname, hostname, sizeof(records_hostname) - 1);
+
+	host.len = name_encode(host.name, &hostname, 1);
+	if (host.len < 0) {
+		NET_DBG("Hostname %s is not a valid label",
+			log_strdup(hostname));
+		return;
+	}
+
+	net_if_foreach(iface_records_cb, &host);
+	services_records_add(&host);
+
+	NET_DBG("%d records, %d bytes", records_count, records_used);
+}
+
+static void records_invalidate(void)
+{
+	k_mutex_lock(&records_lock, K_FOREVER);
+	records_valid = false;
+	k_mutex_unlock(&records_lock);
+}
+
+/* Mark the records answering the questions */
+static int questions_parse(const u8_t *msg, u16_t msg_len, u16_t *pos,
+			   int count, struct net_if *iface, u32_t *answers)
+{
+	struct mdns_record *record;
+	u16_t qtype, qclass;
+	int name_len;
+	int i;
+
+	while (count--) {
+		name_len = name_decode(msg, msg_len, pos, name_buf);
+		if (name_len < 0 ||
+		    *pos + DNS_QTYPE_LEN + DNS_QCLASS_LEN > msg_len) {
+			return -EINVAL;
+		}
+
+		qtype = ntohs(UNALIGNED_GET((u16_t *)&msg[*pos]));
+		qclass = ntohs(UNALIGNED_GET((u16_t *)&msg[*pos +
+							  DNS_QTYPE_LEN]));
+		qclass &= ~MDNS_CLASS_FLUSH;
+		*pos += DNS_QTYPE_LEN + DNS_QCLASS_LEN;
+
+		if (qclass != DNS_CLASS_IN && qclass != DNS_CLASS_ANY) {
+			continue;
+		}
+
+		for (i = 0; i < records_count; i++) {
+			record = &records[i];
+
+			if ((record->iface && record->iface != iface) ||
+			    (qtype != DNS_RR_TYPE_ANY &&
+			     qtype != record->type)) {
+				continue;
+			}
+
+			if (name_eq(name_buf, name_len, record_name(record),
+				    record->name_len)) {
+				*answers |= BIT(i);
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Records the querier is likely to ask next, RFC 6763 ch 12 */
+static u32_t additional_find(struct net_if *iface, u32_t answers)
+{
+	struct mdns_record *answer, *record;
+	u32_t additional = 0U;
+	int i, j;
+
+	for (i = 0; i < records_count; i++) {
+		if (!(answers & BIT(i))) {
+			continue;
+		}
+
+		answer = &records[i];
+
+		for (j = 0; j < records_count; j++) {
+			record = &records[j];
+
+			if (record->iface && record->iface != iface) {
+				continue;
+			}
+
+			if (record_is_host(record) &&
+			    (record_is_host(answer) ||
+			     answer->type == DNS_RR_TYPE_SRV ||
+			     (answer->type == DNS_RR_TYPE_PTR &&
+			      answer->service >= 0))) {
+				additional |= BIT(j);
+			} else if (answer->type == DNS_RR_TYPE_PTR &&
+				   answer->service >= 0 &&
+				   record->service == answer->service &&
+				   record->type != DNS_RR_TYPE_PTR) {
+				additional |= BIT(j);
+			}
+		}
+	}
+
+	return additional & ~answers;
+}
+
+static bool rdata_eq(const u8_t *msg, u16_t msg_len, u16_t pos,
+		     u16_t rdata_len, const struct mdns_record *record)
+{
+	const u8_t *rdata = record_rdata(record);
+	u16_t len = record_rdata_len(record);
+	u16_t prefix = 0U;
+	int name_len;
+
+	/* Names in the data can be compressed, compare them decoded */
+	if (record->type == DNS_RR_TYPE_SRV) {
+		prefix = MDNS_SRV_FIXED_LEN;
+		if (rdata_len < prefix || memcmp(&msg[pos], rdata, prefix)) {
+			return false;
+		}
+	} else if (record->type != DNS_RR_TYPE_PTR) {
+		return rdata_len == len && !memcmp(&msg[pos], rdata, len);
+	}
+
+	pos += prefix;
+
+	name_len = name_decode(msg, msg_len, &pos, name_buf);
+
+	return name_len >= 0 &&
+		name_eq(name_buf, name_len, rdata + prefix, len - prefix);
+}
+
+/* Known answer suppression, RFC 6762 ch 7.1: the querier lists the
+ * answers it already has, there is no need to send those again unless
+ * they are past half their lifetime.
+ */
+static void known_answers_suppress(const u8_t *msg, u16_t msg_len, u16_t pos,
+				   int count, u32_t *answers)
+{
+	static u8_t owner[MDNS_NAME_MAX_LEN];
+	struct mdns_record *record;
+	u16_t type, rdata_len;
+	u16_t rdata_pos;
+	int owner_len;
+	u32_t ttl;
+	int i;
+
+	while (count-- && *answers) {
+		owner_len = name_decode(msg, msg_len, &pos, owner);
+		if (owner_len < 0 || pos + MDNS_RR_FIXED_LEN > msg_len) {
+			return;
+		}
+
+		type = ntohs(UNALIGNED_GET((u16_t *)&msg[pos]));
+		pos += DNS_QTYPE_LEN + DNS_QCLASS_LEN;
+
+		ttl = ntohl(UNALIGNED_GET((u32_t *)&msg[pos]));
+		pos += DNS_TTL_LEN;
+
+		rdata_len = ntohs(UNALIGNED_GET((u16_t *)&msg[pos]));
+		pos += DNS_RDLENGTH_LEN;
+
+		rdata_pos = pos;
+		pos += rdata_len;
+		if (pos > msg_len) {
+			return;
+		}
+
+		if (ttl < MDNS_TTL / 2) {
+			continue;
+		}
+
+		for (i = 0; i < records_count; i++) {
+			record = &records[i];
+
+			if (!(*answers & BIT(i)) || record->type != type ||
+			    !name_eq(owner, owner_len, record_name(record),
+				     record->name_len)) {
+				continue;
+			}
+
+			if (rdata_eq(msg, msg_len, rdata_pos, rdata_len,
+				     record)) {
+				NET_DBG("Known answer %d suppressed", i);
+				*answers &= ~BIT(i);
+			}
+		}
+	}
+}
+
+/* Drop the records multicast less than a second ago */
+static u32_t rate_limit(u32_t mask, int family_idx, s64_t now)
+{
+	int i;
+
+	for (i = 0; i < records_count; i++) {
+		if ((mask & BIT(i)) &&
+		    now - records[i].last_sent[family_idx] < MDNS_RATE_LIMIT) {
+			mask &= ~BIT(i);
+		}
+	}
+
+	return mask;
+}
+
+static u16_t records_append(struct net_buf *buf, u32_t mask, int family_idx,
+			    s64_t now)
+{
+	struct mdns_record *record;
+	u16_t count = 0U;
+	int i;
+
+	for (i = 0; i < records_count; i++) {
+		record = &records[i];
+
+		if (!(mask & BIT(i)) || net_buf_tailroom(buf) < record->len) {
+			continue;
+		}
+
+		net_buf_add_mem(buf, record_name(record), record->len);
+		record->last_sent[family_idx] = now;
+		count++;
+	}
+
+	return count;
+}
+
+static int send_response(struct net_context *ctx, sa_family_t family,
+			 struct net_buf *response)
+{
+	struct sockaddr dst;
+	socklen_t dst_len;
+	int ret;
+
+	if (family == AF_INET) {
+#if defined(CONFIG_NET_IPV4)
+		create_ipv4_addr(net_sin(&dst));
+		dst_len = sizeof(struct sockaddr_in);
 
 		net_context_set_ipv4_ttl(ctx, 255);
 #else /* CONFIG_NET_IPV4 */
 		return -EPFNOSUPPORT;
 #endif /* CONFIG_NET_IPV4 */
 
-	} else if (qtype == DNS_RR_TYPE_AAAA) {
+	} else {
 #if defined(CONFIG_NET_IPV6)
-		const struct in6_addr *addr;
-
-		addr = net_if_ipv6_select_src_addr(net_pkt_iface(pkt),
-						   &ip_hdr->ipv6->src);
-
 		create_ipv6_addr(net_sin6(&dst));
 		dst_len = sizeof(struct sockaddr_in6);
 
-		ret = create_answer(ctx, query, qtype,
-				      sizeof(struct in6_addr), (u8_t *)addr);
-		if (ret != 0) {
-			return -ENOMEM;
-		}
-
 		net_context_set_ipv6_hop_limit(ctx, 255);
 #else /* CONFIG_NET_IPV6 */
 		return -EPFNOSUPPORT;
 #endif /* CONFIG_NET_IPV6 */
-
-	} else {
-		/* TODO: support also service PTRs */
-		return -EINVAL;
 	}
 
-	ret = net_context_sendto(ctx, query->data, query->len, &dst,
+	ret = net_context_sendto(ctx, response->data, response->len, &dst,
 				 dst_len, NULL, K_NO_WAIT, NULL);
 	if (ret < 0) {
 		NET_DBG("Cannot send mDNS reply (%d)", ret);
@@ -272,35 +803,28 @@ static int send_response(struct net_context *ctx,
 
 static int dns_read(struct net_context *ctx,
 		    struct net_pkt *pkt,
-		    union net_ip_header *ip_hdr,
 		    struct net_buf *dns_data,
-		    struct dns_addrinfo *info)
+		    struct net_buf *response)
 {
-	/* Helper struct to track the dns msg received from the server */
 	const char *hostname = net_hostname_get();
-	int hostname_len = strlen(hostname);
-	struct net_buf *result;
+	int family_idx = FAMILY_IDX(net_pkt_family(pkt));
+	struct net_if *iface = net_pkt_iface(pkt);
+	u32_t answers = 0U, additional;
 	struct dns_msg_t dns_msg;
+	u16_t ancount, arcount;
 	int data_len;
 	int queries;
+	u16_t pos;
+	s64_t now;
 	int ret;
 
 	data_len = MIN(net_pkt_remaining_data(pkt), DNS_RESOLVER_MAX_BUF_SIZE);
 
-	/* Store the DNS query name into a temporary net_buf, which will be
-	 * enventually used to send a response
-	 */
-	result = net_buf_alloc(&mdns_msg_pool, BUF_ALLOC_TIMEOUT);
-	if (!result) {
-		ret = -ENOMEM;
-		goto quit;
-	}
-
 	/* TODO: Instead of this temporary copy, just use the net_pkt directly.
 	 */
 	ret = net_pkt_read(pkt, dns_data->data, data_len);
 	if (ret < 0) {
-		goto quit;
+		return ret;
 	}
 
 	dns_msg.msg = dns_data->data;
@@ -308,8 +832,7 @@ static int dns_read(struct net_context *ctx,
 
 	ret = mdns_unpack_query_header(&dns_msg, NULL);
 	if (ret < 0) {
-		ret = -EINVAL;
-		goto quit;
+		return -EINVAL;
 	}
 
 	queries = ret;
@@ -320,50 +843,55 @@ static int dns_read(struct net_context *ctx,
 		log_strdup(net_sprint_ipv4_addr(&NET_IPV4_HDR(pkt)->src)) :
 		log_strdup(net_sprint_ipv6_addr(&NET_IPV6_HDR(pkt)->src)));
 
-	do {
-		enum dns_rr_type qtype;
-		enum dns_class qclass;
-		u8_t *lquery;
+	k_mutex_lock(&records_lock, K_FOREVER);
 
-		(void)memset(result->data, 0, net_buf_tailroom(result));
-		result->len = 0U;
+	if (!records_valid ||
+	    strncmp(records_hostname, hostname, sizeof(records_hostname))) {
+		records_build();
+	}
 
-		ret = dns_unpack_query(&dns_msg, result, &qtype, &qclass);
-		if (ret < 0) {
-			goto quit;
-		}
+	pos = dns_msg.query_offset;
 
-		/* Handle only .local queries */
-		lquery = strrchr(result->data + 1, '.');
-		if (!lquery || memcmp(lquery, (const void *){ ".local" }, 7)) {
-			continue;
-		}
+	ret = questions_parse(dns_msg.msg, data_len, &pos, queries, iface,
+			      &answers);
+	if (ret < 0 || !answers) {
+		goto unlock;
+	}
 
-		NET_DBG("[%d] query %s/%s label %s (%d bytes)", queries,
-			qtype == DNS_RR_TYPE_A ? "A" : "AAAA", "IN",
-			log_strdup(result->data), ret);
-
-		/* If the query matches to our hostname, then send reply.
-		 * We skip the first dot, and make sure there is dot after
-		 * matching hostname.
-		 */
-		if (!strncasecmp(hostname, result->data + 1, hostname_len) &&
-		    (result->len - 1) >= hostname_len &&
-		    &(result->data + 1)[hostname_len] == lquery) {
-			NET_DBG("mDNS query to our hostname %s.local",
-				hostname);
-			send_response(ctx, pkt, ip_hdr, result, qtype);
-		}
-	} while (--queries);
+	known_answers_suppress(dns_msg.msg, data_len, pos,
+			       dns_unpack_header_ancount(dns_msg.msg),
+			       &answers);
 
-	ret = 0;
+	/* The other hosts on the link saw the last response as well, so
+	 * a query storm only costs one response per second.
+	 */
+	now = k_uptime_get();
+	answers = rate_limit(answers, family_idx, now);
+	if (!answers) {
+		ret = -EALREADY;
+		goto unlock;
+	}
 
-quit:
-	if (result) {
-		net_buf_unref(result);
+	additional = rate_limit(additional_find(iface, answers), family_idx,
+				now);
+
+	/* All the answers go in a single response */
+	net_buf_add(response, DNS_MSG_HEADER_SIZE);
+	ancount = records_append(response, answers, family_idx, now);
+	arcount = records_append(response, additional, family_idx, now);
+	setup_dns_hdr(response->data, ancount, arcount);
+
+	NET_DBG("Sending %d answer(s) and %d additional record(s)",
+		ancount, arcount);
+
+unlock:
+	k_mutex_unlock(&records_lock);
+
+	if (ret < 0 || !answers) {
+		return ret;
 	}
 
-	return ret;
+	return send_response(ctx, net_pkt_family(pkt), response);
 }
 
 static void recv_cb(struct net_context *net_ctx,
@@ -375,7 +903,7 @@ static void recv_cb(struct net_context *net_ctx,
 {
 	struct net_context *ctx = user_data;
 	struct net_buf *dns_data = NULL;
-	struct dns_addrinfo info = { 0 };
+	struct net_buf *response = NULL;
 	int ret;
 
 	ARG_UNUSED(net_ctx);
@@ -394,17 +922,106 @@ static void recv_cb(struct net_context *net_ctx,
 		goto quit;
 	}
 
-	ret = dns_read(ctx, pkt, ip_hdr, dns_data, &info);
-	if (ret < 0 && ret != -EINVAL) {
-		NET_DBG("mDNS read failed (%d)", ret);
+	response = net_buf_alloc(&mdns_msg_pool, BUF_ALLOC_TIMEOUT);
+	if (!response) {
+		goto quit;
 	}
 
-	net_buf_unref(dns_data);
+	ret = dns_read(ctx, pkt, dns_data, response);
+	if (ret < 0 && ret != -EINVAL && ret != -EALREADY) {
+		NET_DBG("mDNS read failed (%d)", ret);
+	}
 
 quit:
+	if (response) {
+		net_buf_unref(response);
+	}
+
+	if (dns_data) {
+		net_buf_unref(dns_data);
+	}
+
 	net_pkt_unref(pkt);
 }
 
+static void addr_event_handler(struct net_mgmt_event_callback *cb,
+			       u32_t mgmt_event, struct net_if *iface)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(mgmt_event);
+	ARG_UNUSED(iface);
+
+	records_invalidate();
+}
+
+#if defined(CONFIG_MDNS_RESPONDER_DNS_SD)
+static bool label_is_valid(const char *label)
+{
+	return label && label[0] != '\0' &&
+		strlen(label) <= DNS_LABEL_MAX_SIZE;
+}
+
+int mdns_responder_service_add(const struct mdns_service *service)
+{
+	int i, slot = -1;
+	int ret = 0;
+
+	if (!label_is_valid(service->instance) ||
+	    !label_is_valid(service->service) ||
+	    !label_is_valid(service->proto) ||
+	    (service->txt_len && !service->txt)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&records_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(services); i++) {
+		if (services[i] == service) {
+			ret = -EALREADY;
+			goto out;
+		}
+
+		if (!services[i] && slot < 0) {
+			slot = i;
+		}
+	}
+
+	if (slot < 0) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	services[slot] = service;
+	records_valid = false;
+
+out:
+	k_mutex_unlock(&records_lock);
+
+	return ret;
+}
+
+int mdns_responder_service_remove(const struct mdns_service *service)
+{
+	int ret = -ENOENT;
+	int i;
+
+	k_mutex_lock(&records_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(services); i++) {
+		if (services[i] == service) {
+			services[i] = NULL;
+			records_valid = false;
+			ret = 0;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&records_lock);
+
+	return ret;
+}
+#endif /* CONFIG_MDNS_RESPONDER_DNS_SD */
+
 #if defined(CONFIG_NET_IPV6)
 static void iface_ipv6_cb(struct net_if *iface, void *user_data)
 {
@@ -510,10 +1127,31 @@ ipv4_out:
 	return !ok;
 }
 
+static void setup_addr_events(void)
+{
+#if defined(CONFIG_NET_IPV4)
+	net_mgmt_init_event_callback(&mgmt_cb[0], addr_event_handler,
+				     NET_EVENT_IPV4_ADDR_ADD |
+				     NET_EVENT_IPV4_ADDR_DEL);
+	net_mgmt_add_event_callback(&mgmt_cb[0]);
+#endif
+
+#if defined(CONFIG_NET_IPV6)
+	/* IPv6 addresses are only answered for once DAD is done */
+	net_mgmt_init_event_callback(&mgmt_cb[1], addr_event_handler,
+				     NET_EVENT_IPV6_ADDR_ADD |
+				     NET_EVENT_IPV6_ADDR_DEL |
+				     NET_EVENT_IPV6_DAD_SUCCEED);
+	net_mgmt_add_event_callback(&mgmt_cb[1]);
+#endif
+}
+
 static int mdns_responder_init(struct device *device)
 {
 	ARG_UNUSED(device);
 
+	setup_addr_events();
+
 	return init_listener();
 }
 
@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include <net/net_mgmt.h>
 #include <net/dns_resolve.h>
 #include "dns_pack.h"
+#include "dns_cache.h"
 
 #define DNS_SERVER_COUNT CONFIG_DNS_RESOLVER_MAX_SERVERS
 #define SERVER_COUNT     (DNS_SERVER_COUNT + DNS_MAX_MCAST_SERVERS)
@@ -355,6 +356,79 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+/* Pass a result to the query and to the queries waiting for its answer */
+static void query_result(struct dns_resolve_context *ctx, int idx,
+			 enum dns_resolve_status status,
+			 struct dns_addrinfo *info)
+{
+	ctx->queries[idx].cb(status, info, ctx->queries[idx].user_data);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (i != idx && ctx->queries[i].cb &&
+		    ctx->queries[i].leader == idx) {
+			ctx->queries[i].cb(status, info,
+					   ctx->queries[i].user_data);
+		}
+	}
+#endif
+}
+
+static void query_end(struct dns_resolve_context *ctx, int idx,
+		      enum dns_resolve_status status)
+{
+	if (k_delayed_work_remaining_get(&ctx->queries[idx].timer) > 0) {
+		k_delayed_work_cancel(&ctx->queries[idx].timer);
+	}
+
+	/* Marks the end of the results */
+	ctx->queries[idx].cb(status, NULL, ctx->queries[idx].user_data);
+	ctx->queries[idx].cb = NULL;
+}
+
+/* End the query and the queries waiting for its answer */
+static void query_finish(struct dns_resolve_context *ctx, int idx,
+			 enum dns_resolve_status status)
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (i != idx && ctx->queries[i].cb &&
+		    ctx->queries[i].leader == idx) {
+			query_end(ctx, i, status);
+		}
+	}
+#endif
+
+	query_end(ctx, idx, status);
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Callback of the queries which only refresh the cache, or whose caller
+ * gave up while others still wait for the answer.
+ */
+static void headless_cb(enum dns_resolve_status status,
+			struct dns_addrinfo *info, void *user_data)
+{
+	ARG_UNUSED(status);
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+}
+
+static bool query_has_followers(struct dns_resolve_context *ctx, int idx)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (i != idx && ctx->queries[i].cb &&
+		    ctx->queries[i].leader == idx) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
 static int dns_read(struct dns_resolve_context *ctx,
 		    struct net_pkt *pkt,
 		    struct net_buf *dns_data,
@@ -365,6 +439,10 @@ static int dns_read(struct dns_resolve_context *ctx,
 	/* Helper struct to track the dns msg received from the server */
 	struct dns_msg_t dns_msg;
 	u32_t ttl; /* RR ttl, so far it is not passed to caller */
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_addrinfo cached[CONFIG_DNS_RESOLVER_CACHE_ADDRS];
+	u32_t min_ttl = UINT32_MAX;
+#endif
 	u8_t *src, *addr;
 	int address_size;
 	/* index that points to the current answer being analyzed */
@@ -471,6 +549,10 @@ static int dns_read(struct dns_resolve_context *ctx,
 			goto quit;
 		}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		min_ttl = MIN(min_ttl, ttl);
+#endif
+
 		switch (dns_msg.response_type) {
 		case DNS_RESPONSE_IP:
 			if (dns_msg.response_length < address_size) {
@@ -483,8 +565,13 @@ static int dns_read(struct dns_resolve_context *ctx,
 
 			memcpy(addr, src, address_size);
 
-			ctx->queries[query_idx].cb(DNS_EAI_INPROGRESS, &info,
-					ctx->queries[query_idx].user_data);
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+			if (items < ARRAY_SIZE(cached)) {
+				cached[items] = info;
+			}
+#endif
+
+			query_result(ctx, query_idx, DNS_EAI_INPROGRESS, &info);
 			items++;
 			break;
 
@@ -532,14 +619,15 @@ static int dns_read(struct dns_resolve_context *ctx,
 		ret = DNS_EAI_ALLDONE;
 	}
 
-	if (k_delayed_work_remaining_get(&ctx->queries[query_idx].timer) > 0) {
-		k_delayed_work_cancel(&ctx->queries[query_idx].timer);
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	if (ctx->queries[query_idx].name[0]) {
+		dns_cache_add(ctx->queries[query_idx].name,
+			      ctx->queries[query_idx].query_type, cached,
+			      MIN(items, ARRAY_SIZE(cached)), min_ttl);
 	}
+#endif
 
-	/* Marks the end of the results */
-	ctx->queries[query_idx].cb(ret, NULL,
-				   ctx->queries[query_idx].user_data);
-	ctx->queries[query_idx].cb = NULL;
+	query_finish(ctx, query_idx, ret);
 
 	net_pkt_unref(pkt);
 
@@ -633,13 +721,7 @@ quit:
 		goto free_buf;
 	}
 
-	if (k_delayed_work_remaining_get(&ctx->queries[i].timer) > 0) {
-		k_delayed_work_cancel(&ctx->queries[i].timer);
-	}
-
-	/* Marks the end of the results */
-	ctx->queries[i].cb(ret, NULL, ctx->queries[i].user_data);
-	ctx->queries[i].cb = NULL;
+	query_finish(ctx, i, ret);
 
 free_buf:
 	if (dns_data) {
@@ -735,12 +817,19 @@ int dns_resolve_cancel(struct dns_resolve_context *ctx, u16_t dns_id)
 
 	NET_DBG("Cancelling DNS req %u", dns_id);
 
-	if (k_delayed_work_remaining_get(&ctx->queries[i].timer) > 0) {
-		k_delayed_work_cancel(&ctx->queries[i].timer);
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	/* Others still wait for the answer, keep the query going for them */
+	if (query_has_followers(ctx, i)) {
+		ctx->queries[i].cb(DNS_EAI_CANCELED, NULL,
+				   ctx->queries[i].user_data);
+		ctx->queries[i].cb = headless_cb;
+		ctx->queries[i].user_data = NULL;
+
+		return 0;
 	}
+#endif
 
-	ctx->queries[i].cb(DNS_EAI_CANCELED, NULL, ctx->queries[i].user_data);
-	ctx->queries[i].cb = NULL;
+	query_end(ctx, i, DNS_EAI_CANCELED);
 
 	return 0;
 }
@@ -749,12 +838,102 @@ static void query_timeout(struct k_work *work)
 {
 	struct dns_pending_query *pending_query =
 		CONTAINER_OF(work, struct dns_pending_query, timer);
+	struct dns_resolve_context *ctx = pending_query->ctx;
 
 	NET_DBG("Query timeout DNS req %u", pending_query->id);
 
-	dns_resolve_cancel(pending_query->ctx, pending_query->id);
+	if (!pending_query->cb) {
+		return;
+	}
+
+	query_finish(ctx, pending_query - ctx->queries, DNS_EAI_CANCELED);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Answer from the cache, or wait for an identical query already sent.
+ * Returns -ENOENT if the query has to be sent.
+ */
+static int dns_resolve_cached(struct dns_resolve_context *ctx,
+			      const char *query,
+			      enum dns_query_type type,
+			      u16_t *dns_id,
+			      dns_resolve_cb_t cb,
+			      void *user_data,
+			      s32_t timeout)
+{
+	struct dns_addrinfo info[CONFIG_DNS_RESOLVER_CACHE_ADDRS];
+	bool refresh;
+	int count, i, leader;
+
+	count = dns_cache_find(query, type, info, ARRAY_SIZE(info), &refresh);
+	if (count >= 0) {
+		if (refresh) {
+			NET_DBG("Refreshing %s", log_strdup(query));
+			(void)dns_resolve_name(ctx, query, type, NULL,
+					       headless_cb, NULL, timeout);
+		}
+
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		for (i = 0; i < count; i++) {
+			cb(DNS_EAI_INPROGRESS, &info[i], user_data);
+		}
+
+		cb(count ? DNS_EAI_ALLDONE : DNS_EAI_NODATA, NULL, user_data);
+
+		return 0;
+	}
+
+	for (leader = 0; leader < CONFIG_DNS_NUM_CONCUR_QUERIES; leader++) {
+		if (ctx->queries[leader].cb &&
+		    ctx->queries[leader].leader < 0 &&
+		    ctx->queries[leader].query_type == type &&
+		    ctx->queries[leader].name[0] &&
+		    !strcmp(ctx->queries[leader].name, query)) {
+			break;
+		}
+	}
+
+	if (leader == CONFIG_DNS_NUM_CONCUR_QUERIES) {
+		return -ENOENT;
+	}
+
+	i = get_cb_slot(ctx);
+	if (i < 0) {
+		return -EAGAIN;
+	}
+
+	/* Never sent, the id only needs to be unique for cancelling */
+	do {
+		ctx->queries[i].id = sys_rand32_get();
+	} while (ctx->queries[i].id == 0U ||
+		 get_slot_by_id(ctx, ctx->queries[i].id) >= 0);
+
+	ctx->queries[i].cb = cb;
+	ctx->queries[i].timeout = timeout;
+	ctx->queries[i].query = query;
+	ctx->queries[i].query_type = type;
+	ctx->queries[i].user_data = user_data;
+	ctx->queries[i].ctx = ctx;
+	ctx->queries[i].leader = leader;
+	ctx->queries[i].name[0] = '\0';
+
+	if (dns_id) {
+		*dns_id = ctx->queries[i].id;
+	}
+
+	k_delayed_work_init(&ctx->queries[i].timer, query_timeout);
+	(void)k_delayed_work_submit(&ctx->queries[i].timer, timeout);
+
+	NET_DBG("[%u] waiting for the answer to query %u", i,
+		ctx->queries[leader].id);
+
+	return 0;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 int dns_resolve_name(struct dns_resolve_context *ctx,
 		     const char *query,
 		     enum dns_query_type type,
@@ -816,6 +995,16 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	if (cb != headless_cb) {
+		ret = dns_resolve_cached(ctx, query, type, dns_id, cb,
+					 user_data, timeout);
+		if (ret != -ENOENT) {
+			return ret;
+		}
+	}
+#endif
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		return -EAGAIN;
@@ -828,6 +1017,16 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	ctx->queries[i].leader = -1;
+
+	if (strlen(query) < sizeof(ctx->queries[i].name)) {
+		strcpy(ctx->queries[i].name, query);
+	} else {
+		ctx->queries[i].name[0] = '\0';
+	}
+#endif
+
 	k_delayed_work_init(&ctx->queries[i].timer, query_timeout);
 
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
@@ -0,0 +1,538 @@
+/** @file
+ * @brief HTTP client library
+ *
+ * Sends HTTP/1.1 requests on keep-alive connections, kept in a pool
+ * shared by all the users of the library, and streams the response
+ * bodies to a callback.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_http_client, CONFIG_NET_HTTP_CLIENT_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+
+#include <net/socket.h>
+#include <net/http_parser.h>
+#include <net/http_client.h>
+
+struct http_client_conn {
+	/** Socket, -1 if the slot is unused */
+	int sock;
+
+	/** Used by a request */
+	bool busy;
+
+	/** Connected with TLS */
+	bool tls;
+
+	/** Server port */
+	u16_t port;
+
+	/** Uptime when the connection became idle */
+	s64_t idle_since;
+
+	/** Server host name */
+	char host[CONFIG_HTTP_CLIENT_HOSTNAME_LEN + 1];
+
+	/** Requests being answered on the connection, in order */
+	struct http_request *reqs;
+	size_t count;
+	size_t current;
+
+	/** Has any response byte been received */
+	bool received;
+
+	/** Does the server keep the connection open */
+	bool keep_alive;
+
+	/** Error returned by a response callback */
+	int cb_error;
+
+	struct http_parser parser;
+
+	/** Request head on sending, response data on receiving */
+	char buf[CONFIG_HTTP_CLIENT_BUF_SIZE];
+};
+
+static struct http_client_conn conns[CONFIG_HTTP_CLIENT_CONNECTIONS] = {
+	[0 ... (CONFIG_HTTP_CLIENT_CONNECTIONS - 1)] = { .sock = -1 },
+};
+static K_MUTEX_DEFINE(conns_lock);
+
+static void conn_close(struct http_client_conn *conn)
+{
+	if (conn->sock >= 0) {
+		(void)zsock_close(conn->sock);
+		conn->sock = -1;
+	}
+}
+
+static bool conn_matches(struct http_client_conn *conn,
+			 struct http_request *req)
+{
+	return conn->sock >= 0 && conn->port == req->port &&
+		conn->tls == (req->sec_tag_count > 0) &&
+		!strcmp(conn->host, req->host);
+}
+
+/* Take an idle connection to the server of req, or a slot for a new one */
+static struct http_client_conn *conn_acquire(struct http_request *req,
+					     bool *reused)
+{
+	struct http_client_conn *conn = NULL;
+	s64_t now = k_uptime_get();
+	int i, host_conns = 0;
+
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].busy || conns[i].sock < 0) {
+			continue;
+		}
+
+		if (now - conns[i].idle_since >=
+		    CONFIG_HTTP_CLIENT_IDLE_TIMEOUT) {
+			conn_close(&conns[i]);
+			continue;
+		}
+
+		if (conn_matches(&conns[i], req)) {
+			conn = &conns[i];
+			*reused = true;
+			goto out;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].sock >= 0 || conns[i].busy) {
+			if (!strcmp(conns[i].host, req->host)) {
+				host_conns++;
+			}
+
+			continue;
+		}
+
+		if (!conn) {
+			conn = &conns[i];
+		}
+	}
+
+	if (host_conns >= CONFIG_HTTP_CLIENT_CONNECTIONS_PER_HOST) {
+		conn = NULL;
+		goto out;
+	}
+
+	if (!conn) {
+		/* Make room by closing the connection idle for longest */
+		for (i = 0; i < ARRAY_SIZE(conns); i++) {
+			if (!conns[i].busy && (!conn || conns[i].idle_since <
+					       conn->idle_since)) {
+				conn = &conns[i];
+			}
+		}
+
+		if (!conn) {
+			goto out;
+		}
+
+		conn_close(conn);
+	}
+
+	*reused = false;
+	strcpy(conn->host, req->host);
+	conn->port = req->port;
+	conn->tls = req->sec_tag_count > 0;
+
+out:
+	if (conn) {
+		conn->busy = true;
+	}
+
+	k_mutex_unlock(&conns_lock);
+
+	return conn;
+}
+
+static void conn_release(struct http_client_conn *conn, bool keep)
+{
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	if (!keep) {
+		conn_close(conn);
+	}
+
+	conn->idle_since = k_uptime_get();
+	conn->busy = false;
+
+	k_mutex_unlock(&conns_lock);
+}
+
+static int conn_open(struct http_client_conn *conn, struct http_request *req)
+{
+	struct zsock_addrinfo hints = {
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *addr;
+	char port[sizeof("65535")];
+	int ret;
+
+	snprintk(port, sizeof(port), "%u", req->port);
+
+	ret = zsock_getaddrinfo(req->host, port, &hints, &addr);
+	if (ret) {
+		LOG_ERR("Cannot resolve %s (%d)", log_strdup(req->host), ret);
+		return -EHOSTUNREACH;
+	}
+
+	if (conn->tls) {
+#if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
+		conn->sock = zsock_socket(addr->ai_family, SOCK_STREAM,
+					  IPPROTO_TLS_1_2);
+#else
+		ret = -EPROTONOSUPPORT;
+		goto out;
+#endif
+	} else {
+		conn->sock = zsock_socket(addr->ai_family, SOCK_STREAM,
+					  IPPROTO_TCP);
+	}
+
+	if (conn->sock < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+#if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
+	if (conn->tls) {
+		ret = zsock_setsockopt(conn->sock, SOL_TLS, TLS_SEC_TAG_LIST,
+				       req->sec_tag_list,
+				       sizeof(sec_tag_t) * req->sec_tag_count);
+		if (ret == 0) {
+			ret = zsock_setsockopt(conn->sock, SOL_TLS,
+					       TLS_HOSTNAME, req->host,
+					       strlen(req->host));
+		}
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+		/* Resume the session, if any, when reconnecting */
+		if (ret == 0) {
+			int cache = TLS_SESSION_CACHE_ENABLED;
+
+			ret = zsock_setsockopt(conn->sock, SOL_TLS,
+					       TLS_SESSION_CACHE, &cache,
+					       sizeof(cache));
+		}
+#endif
+
+		if (ret < 0) {
+			ret = -errno;
+			goto out;
+		}
+	}
+#endif
+
+	ret = zsock_connect(conn->sock, addr->ai_addr, addr->ai_addrlen);
+	if (ret < 0) {
+		ret = -errno;
+		LOG_ERR("Cannot connect to %s (%d)", log_strdup(req->host),
+			ret);
+	}
+
+out:
+	zsock_freeaddrinfo(addr);
+
+	if (ret < 0) {
+		conn_close(conn);
+	}
+
+	return ret;
+}
+
+static int send_all(int sock, const void *data, size_t len)
+{
+	ssize_t ret;
+
+	while (len) {
+		ret = zsock_send(sock, data, len, 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		data = (const u8_t *)data + ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static int send_request(struct http_client_conn *conn,
+			struct http_request *req)
+{
+	bool has_body = req->payload_len || req->method == HTTP_POST ||
+		req->method == HTTP_PUT;
+	size_t len;
+	int ret;
+
+	ret = snprintk(conn->buf, sizeof(conn->buf),
+		       "%s %s HTTP/1.1\r\n"
+		       "Host: %s:%u\r\n"
+		       "%s%s%s",
+		       http_method_str(req->method), req->url, req->host,
+		       req->port,
+		       req->content_type ? "Content-Type: " : "",
+		       req->content_type ? req->content_type : "",
+		       req->content_type ? "\r\n" : "");
+	len = ret;
+
+	if (has_body && len < sizeof(conn->buf)) {
+		len += snprintk(conn->buf + len, sizeof(conn->buf) - len,
+				"Content-Length: %zu\r\n", req->payload_len);
+	}
+
+	if (len < sizeof(conn->buf)) {
+		len += snprintk(conn->buf + len, sizeof(conn->buf) - len,
+				"%s\r\n", req->header_fields ?
+				req->header_fields : "");
+	}
+
+	if (len >= sizeof(conn->buf)) {
+		LOG_ERR("Request head too long");
+		return -ENOMEM;
+	}
+
+	(void)memset(&req->response, 0, sizeof(req->response));
+
+	ret = send_all(conn->sock, conn->buf, len);
+	if (ret < 0 || !req->payload_len) {
+		return ret;
+	}
+
+	return send_all(conn->sock, req->payload, req->payload_len);
+}
+
+static struct http_request *current_request(struct http_parser *parser)
+{
+	struct http_client_conn *conn = parser->data;
+
+	return &conn->reqs[conn->current];
+}
+
+static int on_headers_complete(struct http_parser *parser)
+{
+	struct http_request *req = current_request(parser);
+
+	req->response.status_code = parser->status_code;
+	if (parser->content_length != ULLONG_MAX) {
+		req->response.content_length = parser->content_length;
+	}
+
+	/* Responses to HEAD have no body, whatever the headers say */
+	return req->method == HTTP_HEAD ? 1 : 0;
+}
+
+static int on_body(struct http_parser *parser, const char *at, size_t len)
+{
+	struct http_client_conn *conn = parser->data;
+	struct http_request *req = current_request(parser);
+	int ret;
+
+	req->response.body_received += len;
+
+	ret = req->response_cb(req, &req->response, (const u8_t *)at, len);
+	if (ret < 0) {
+		conn->cb_error = ret;
+		return 1;
+	}
+
+	return 0;
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_client_conn *conn = parser->data;
+	struct http_request *req = current_request(parser);
+	int ret;
+
+	req->response.complete = true;
+	conn->keep_alive = http_should_keep_alive(parser);
+	conn->current++;
+
+	ret = req->response_cb(req, &req->response, NULL, 0);
+	if (ret < 0) {
+		conn->cb_error = ret;
+		return 1;
+	}
+
+	/* Stop at the last expected response, or when the server closes */
+	if (conn->current == conn->count || !conn->keep_alive) {
+		http_parser_pause(parser, 1);
+	}
+
+	return 0;
+}
+
+static const struct http_parser_settings parser_settings = {
+	.on_headers_complete = on_headers_complete,
+	.on_body = on_body,
+	.on_message_complete = on_message_complete,
+};
+
+static int recv_responses(struct http_client_conn *conn, s32_t timeout)
+{
+	struct zsock_pollfd fds = {
+		.fd = conn->sock,
+		.events = ZSOCK_POLLIN,
+	};
+	ssize_t len;
+	int ret;
+
+	http_parser_init(&conn->parser, HTTP_RESPONSE);
+	conn->parser.data = conn;
+
+	while (conn->current < conn->count) {
+		ret = zsock_poll(&fds, 1, timeout);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		if (ret == 0) {
+			return -ETIMEDOUT;
+		}
+
+		len = zsock_recv(conn->sock, conn->buf, sizeof(conn->buf), 0);
+		if (len < 0) {
+			return -errno;
+		}
+
+		if (len > 0) {
+			conn->received = true;
+		}
+
+		/* A zero length tells the parser about the end of the
+		 * stream, which ends a body without a length.
+		 */
+		http_parser_execute(&conn->parser, &parser_settings,
+				    conn->buf, len);
+
+		if (conn->cb_error) {
+			return conn->cb_error;
+		}
+
+		if (HTTP_PARSER_ERRNO(&conn->parser) != HPE_OK &&
+		    HTTP_PARSER_ERRNO(&conn->parser) != HPE_PAUSED) {
+			LOG_ERR("Invalid response: %s",
+				http_errno_name(HTTP_PARSER_ERRNO(
+							&conn->parser)));
+			return -EINVAL;
+		}
+
+		if (conn->current < conn->count &&
+		    (len == 0 || !conn->keep_alive)) {
+			return -ECONNRESET;
+		}
+	}
+
+	return 0;
+}
+
+static int exchange(struct http_client_conn *conn, struct http_request *reqs,
+		    size_t count, s32_t timeout)
+{
+	size_t i;
+	int ret;
+
+	conn->reqs = reqs;
+	conn->count = count;
+	conn->current = 0;
+	conn->received = false;
+	conn->keep_alive = true;
+	conn->cb_error = 0;
+
+	for (i = 0; i < count; i++) {
+		ret = send_request(conn, &reqs[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return recv_responses(conn, timeout);
+}
+
+int http_client_pipeline(struct http_request *reqs, size_t count,
+			 s32_t timeout)
+{
+	struct http_client_conn *conn;
+	bool reused, retry;
+	size_t i;
+	int ret;
+
+	if (!count) {
+		return 0;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (!reqs[i].response_cb || !reqs[i].host || !reqs[i].url ||
+		    strlen(reqs[i].host) > CONFIG_HTTP_CLIENT_HOSTNAME_LEN ||
+		    strcmp(reqs[i].host, reqs[0].host) ||
+		    reqs[i].port != reqs[0].port ||
+		    reqs[i].sec_tag_count != reqs[0].sec_tag_count) {
+			return -EINVAL;
+		}
+	}
+
+	do {
+		conn = conn_acquire(&reqs[0], &reused);
+		if (!conn) {
+			return -EBUSY;
+		}
+
+		if (!reused) {
+			ret = conn_open(conn, &reqs[0]);
+			if (ret < 0) {
+				conn_release(conn, false);
+				return ret;
+			}
+		}
+
+		ret = exchange(conn, reqs, count, timeout);
+
+		/* The server may have closed a reused connection while it
+		 * was idle, try again once on a new one.
+		 */
+		retry = ret < 0 && reused && !conn->received &&
+			!conn->cb_error;
+
+		conn_release(conn, ret == 0 && conn->keep_alive);
+	} while (retry);
+
+	return ret;
+}
+
+int http_client_request(struct http_request *req, s32_t timeout)
+{
+	return http_client_pipeline(req, 1, timeout);
+}
+
+void http_client_close_idle(void)
+{
+	int i;
+
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (!conns[i].busy) {
+			conn_close(&conns[i]);
+		}
+	}
+
+	k_mutex_unlock(&conns_lock);
+}
@@ -0,0 +1,714 @@
+/** @file
+ * @brief HTTP server library
+ *
+ * Serves static assets over HTTP/1.1, handling all the connections in
+ * one thread with poll(). Asset contents are sent straight from flash.
+ */
+
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <soc.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#include <net/socket.h>
+#include <net/http_parser.h>
+#include <net/http_server.h>
+#include <storage/flash_map.h>
+
+#define ACCEPT_ENCODING "accept-encoding"
+
+/* Listening sockets, IPv4 and IPv6 */
+#define LISTENERS 2
+
+struct http_server_conn {
+	/** Socket, -1 if the slot is unused */
+	int sock;
+
+	/** Uptime of the last data received or sent */
+	s64_t last_activity;
+
+	struct http_parser parser;
+
+	/** Request target, without the query */
+	char url[CONFIG_HTTP_SERVER_URL_LEN + 1];
+	size_t url_len;
+	bool url_too_long;
+
+	/** Header field being received, lower case, and whether it is
+	 *  Accept-Encoding
+	 */
+	char field[sizeof(ACCEPT_ENCODING) - 1];
+	size_t field_len;
+	bool in_value;
+	bool in_accept_encoding;
+
+	/** Progress matching "gzip" in the value of Accept-Encoding */
+	size_t gzip_matched;
+	bool accept_gzip;
+
+	/** A request is being received */
+	bool in_request;
+
+	/** A request has been received, and its response not sent yet */
+	bool responding;
+
+	/** Keep the connection open after the response */
+	bool keep_alive;
+
+	/** Response body: mapped content, or data read from a partition */
+	const u8_t *body;
+	const struct flash_area *fa;
+	off_t fa_off;
+	size_t body_len;
+	size_t body_sent;
+
+	/** Received data not parsed yet, pipelined requests */
+	char rx[CONFIG_HTTP_SERVER_BUF_SIZE];
+	size_t rx_len;
+
+	/** Response head, then the parts of the body read from flash */
+	char tx[CONFIG_HTTP_SERVER_BUF_SIZE];
+	size_t tx_len;
+	size_t tx_sent;
+};
+
+static const struct http_server *server;
+static struct http_server_conn conns[CONFIG_HTTP_SERVER_CONNECTIONS];
+
+static void conn_close(struct http_server_conn *conn)
+{
+	if (conn->fa) {
+		flash_area_close(conn->fa);
+		conn->fa = NULL;
+	}
+
+	(void)zsock_close(conn->sock);
+	conn->sock = -1;
+}
+
+static struct http_server_conn *conn_of(struct http_parser *parser)
+{
+	return CONTAINER_OF(parser, struct http_server_conn, parser);
+}
+
+static int on_message_begin(struct http_parser *parser)
+{
+	struct http_server_conn *conn = conn_of(parser);
+
+	conn->in_request = true;
+	conn->url_len = 0;
+	conn->url_too_long = false;
+	conn->field_len = 0;
+	conn->in_value = false;
+	conn->in_accept_encoding = false;
+	conn->accept_gzip = false;
+
+	return 0;
+}
+
+static int on_url(struct http_parser *parser, const char *at, size_t len)
+{
+	struct http_server_conn *conn = conn_of(parser);
+
+	if (conn->url_len + len > CONFIG_HTTP_SERVER_URL_LEN) {
+		conn->url_too_long = true;
+		return 0;
+	}
+
+	memcpy(conn->url + conn->url_len, at, len);
+	conn->url_len += len;
+
+	return 0;
+}
+
+static int on_header_field(struct http_parser *parser, const char *at,
+			   size_t len)
+{
+	struct http_server_conn *conn = conn_of(parser);
+
+	/* The field may come in several parts, the first one follows the
+	 * value of the previous header
+	 */
+	if (conn->in_value) {
+		conn->in_value = false;
+		conn->field_len = 0;
+	}
+
+	if (conn->field_len + len > sizeof(conn->field)) {
+		/* Too long to be Accept-Encoding */
+		conn->field_len = sizeof(conn->field) + 1;
+		return 0;
+	}
+
+	while (len--) {
+		conn->field[conn->field_len++] = tolower((unsigned char)*at++);
+	}
+
+	return 0;
+}
+
+static int on_header_value(struct http_parser *parser, const char *at,
+			   size_t len)
+{
+	struct http_server_conn *conn = conn_of(parser);
+	static const char gzip[] = "gzip";
+
+	if (!conn->in_value) {
+		conn->in_value = true;
+		conn->in_accept_encoding =
+			conn->field_len == sizeof(conn->field) &&
+			!memcmp(conn->field, ACCEPT_ENCODING,
+				sizeof(conn->field));
+		conn->gzip_matched = 0;
+	}
+
+	if (!conn->in_accept_encoding) {
+		return 0;
+	}
+
+	while (len-- && !conn->accept_gzip) {
+		char c = tolower((unsigned char)*at++);
+
+		if (c != gzip[conn->gzip_matched]) {
+			conn->gzip_matched = 0;
+		}
+
+		if (c == gzip[conn->gzip_matched]) {
+			conn->gzip_matched++;
+		}
+
+		conn->accept_gzip = conn->gzip_matched == sizeof(gzip) - 1;
+	}
+
+	return 0;
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_server_conn *conn = conn_of(parser);
+
+	conn->in_request = false;
+	conn->responding = true;
+	conn->keep_alive = http_should_keep_alive(parser);
+
+	/* Leave the next pipelined requests until the response is sent */
+	http_parser_pause(parser, 1);
+
+	return 0;
+}
+
+static const struct http_parser_settings parser_settings = {
+	.on_message_begin = on_message_begin,
+	.on_url = on_url,
+	.on_header_field = on_header_field,
+	.on_header_value = on_header_value,
+	.on_message_complete = on_message_complete,
+};
+
+static const struct http_server_asset *find_asset(const char *url,
+						  size_t len)
+{
+	const char *query = memchr(url, '?', len);
+	size_t i;
+
+	if (query) {
+		len = query - url;
+	}
+
+	for (i = 0; i < server->asset_count; i++) {
+		const struct http_server_asset *asset = &server->assets[i];
+
+		if (strlen(asset->path) == len &&
+		    !memcmp(asset->path, url, len)) {
+			return asset;
+		}
+	}
+
+	return NULL;
+}
+
+/* Point to the content of an asset in place if possible, or open its
+ * partition to read it by parts
+ */
+static int map_asset(struct http_server_conn *conn,
+		     const struct http_server_asset *asset)
+{
+	int ret;
+
+	if (asset->data) {
+		conn->body = asset->data;
+		return 0;
+	}
+
+	ret = flash_area_open(asset->flash_area_id, &conn->fa);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (asset->offset + asset->len > conn->fa->fa_size) {
+		flash_area_close(conn->fa);
+		conn->fa = NULL;
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_XIP) && defined(DT_FLASH_DEV_NAME)
+	/* Partitions of the internal flash are mapped at its base address */
+	if (!strcmp(conn->fa->fa_dev_name, DT_FLASH_DEV_NAME)) {
+		conn->body = (const u8_t *)CONFIG_FLASH_BASE_ADDRESS +
+			conn->fa->fa_off + asset->offset;
+		flash_area_close(conn->fa);
+		conn->fa = NULL;
+		return 0;
+	}
+#endif
+
+	conn->fa_off = asset->offset;
+
+	return 0;
+}
+
+static void prepare_response(struct http_server_conn *conn)
+{
+	const struct http_server_asset *asset = NULL;
+	enum http_method method = conn->parser.method;
+	const char *status = NULL;
+	const char *headers = "";
+
+	conn->body = NULL;
+	conn->body_len = 0;
+	conn->body_sent = 0;
+
+	if (conn->url_too_long) {
+		status = "414 URI Too Long";
+	} else if (method != HTTP_GET && method != HTTP_HEAD) {
+		status = "405 Method Not Allowed";
+		headers = "Allow: GET, HEAD\r\n";
+	} else {
+		asset = find_asset(conn->url, conn->url_len);
+		if (!asset) {
+			status = "404 Not Found";
+		} else if (asset->gzip && !conn->accept_gzip) {
+			/* Not sent uncompressed, it is only stored that way */
+			status = "406 Not Acceptable";
+			asset = NULL;
+		} else if (map_asset(conn, asset) < 0) {
+			LOG_ERR("Cannot read %s", log_strdup(asset->path));
+			status = "500 Internal Server Error";
+			asset = NULL;
+		}
+	}
+
+	if (asset) {
+		conn->tx_len = snprintk(conn->tx, sizeof(conn->tx),
+					"HTTP/1.1 200 OK\r\n"
+					"Content-Type: %s\r\n"
+					"Content-Length: %zu\r\n"
+					"%s"
+					"Connection: %s\r\n\r\n",
+					asset->content_type, asset->len,
+					asset->gzip ?
+					"Content-Encoding: gzip\r\n"
+					"Vary: Accept-Encoding\r\n" : "",
+					conn->keep_alive ?
+					"keep-alive" : "close");
+
+		if (method == HTTP_GET) {
+			conn->body_len = asset->len;
+		}
+	} else {
+		conn->tx_len = snprintk(conn->tx, sizeof(conn->tx),
+					"HTTP/1.1 %s\r\n"
+					"%s"
+					"Content-Length: 0\r\n"
+					"Connection: %s\r\n\r\n",
+					status, headers, conn->keep_alive ?
+					"keep-alive" : "close");
+	}
+
+	conn->tx_len = MIN(conn->tx_len, sizeof(conn->tx));
+	conn->tx_sent = 0;
+}
+
+static void send_bad_request(struct http_server_conn *conn)
+{
+	static const char rsp[] = "HTTP/1.1 400 Bad Request\r\n"
+		"Content-Length: 0\r\n"
+		"Connection: close\r\n\r\n";
+
+	memcpy(conn->tx, rsp, sizeof(rsp) - 1);
+	conn->tx_len = sizeof(rsp) - 1;
+	conn->tx_sent = 0;
+	conn->body = NULL;
+	conn->body_len = 0;
+	conn->body_sent = 0;
+	conn->responding = true;
+	conn->keep_alive = false;
+	conn->rx_len = 0;
+}
+
+/* Parse the received data, up to the end of the first request */
+static void conn_parse(struct http_server_conn *conn)
+{
+	size_t parsed;
+
+	if (!conn->rx_len) {
+		return;
+	}
+
+	parsed = http_parser_execute(&conn->parser, &parser_settings,
+				     conn->rx, conn->rx_len);
+
+	if (HTTP_PARSER_ERRNO(&conn->parser) != HPE_OK &&
+	    HTTP_PARSER_ERRNO(&conn->parser) != HPE_PAUSED) {
+		LOG_DBG("Invalid request (%s)", http_errno_name(
+				HTTP_PARSER_ERRNO(&conn->parser)));
+		send_bad_request(conn);
+		return;
+	}
+
+	conn->rx_len -= parsed;
+	memmove(conn->rx, conn->rx + parsed, conn->rx_len);
+
+	if (conn->responding) {
+		prepare_response(conn);
+	}
+}
+
+/* Send as much of the response as the socket takes without blocking.
+ * Returns 0 once all of it is sent, -EAGAIN if there is more to send.
+ */
+static int send_response(struct http_server_conn *conn)
+{
+	const void *data;
+	size_t len;
+	ssize_t ret;
+
+	while (true) {
+		if (conn->tx_sent < conn->tx_len) {
+			data = conn->tx + conn->tx_sent;
+			len = conn->tx_len - conn->tx_sent;
+		} else if (conn->body_sent == conn->body_len) {
+			return 0;
+		} else if (conn->body) {
+			data = conn->body + conn->body_sent;
+			len = conn->body_len - conn->body_sent;
+		} else {
+			/* Not mapped, read the next part into the buffer */
+			len = MIN(sizeof(conn->tx),
+				  conn->body_len - conn->body_sent);
+			ret = flash_area_read(conn->fa,
+					      conn->fa_off + conn->body_sent,
+					      conn->tx, len);
+			if (ret < 0) {
+				return ret;
+			}
+
+			conn->tx_len = len;
+			conn->tx_sent = 0;
+			conn->body_sent += len;
+			continue;
+		}
+
+		ret = zsock_send(conn->sock, data, len, ZSOCK_MSG_DONTWAIT);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		conn->last_activity = k_uptime_get();
+
+		if (conn->tx_sent < conn->tx_len) {
+			conn->tx_sent += ret;
+		} else {
+			conn->body_sent += ret;
+		}
+	}
+}
+
+static void conn_writable(struct http_server_conn *conn)
+{
+	int ret;
+
+	do {
+		ret = send_response(conn);
+		if (ret == -EAGAIN) {
+			return;
+		}
+
+		if (conn->fa) {
+			flash_area_close(conn->fa);
+			conn->fa = NULL;
+		}
+
+		if (ret < 0 || !conn->keep_alive) {
+			conn_close(conn);
+			return;
+		}
+
+		conn->responding = false;
+		http_parser_pause(&conn->parser, 0);
+
+		/* Answer the next pipelined request, if it has been
+		 * received already
+		 */
+		conn_parse(conn);
+	} while (conn->responding);
+}
+
+static void conn_readable(struct http_server_conn *conn)
+{
+	ssize_t len;
+
+	len = zsock_recv(conn->sock, conn->rx + conn->rx_len,
+			 sizeof(conn->rx) - conn->rx_len, ZSOCK_MSG_DONTWAIT);
+	if (len < 0 && errno == EAGAIN) {
+		return;
+	}
+
+	if (len <= 0) {
+		conn_close(conn);
+		return;
+	}
+
+	conn->rx_len += len;
+	conn->last_activity = k_uptime_get();
+
+	conn_parse(conn);
+	if (conn->responding) {
+		conn_writable(conn);
+	}
+}
+
+static struct http_server_conn *conn_alloc(bool evict)
+{
+	struct http_server_conn *conn = NULL;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].sock < 0) {
+			return &conns[i];
+		}
+	}
+
+	if (!evict) {
+		return NULL;
+	}
+
+	/* Make room by closing the connection idle for longest */
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].in_request || conns[i].responding) {
+			continue;
+		}
+
+		if (!conn || conns[i].last_activity < conn->last_activity) {
+			conn = &conns[i];
+		}
+	}
+
+	if (conn) {
+		conn_close(conn);
+	}
+
+	return conn;
+}
+
+static void conn_accept(int listener)
+{
+	struct http_server_conn *conn;
+	int sock;
+
+	conn = conn_alloc(true);
+	if (!conn) {
+		return;
+	}
+
+	sock = zsock_accept(listener, NULL, NULL);
+	if (sock < 0) {
+		return;
+	}
+
+	(void)memset(conn, 0, sizeof(*conn));
+	conn->sock = sock;
+	conn->last_activity = k_uptime_get();
+	http_parser_init(&conn->parser, HTTP_REQUEST);
+}
+
+static int listen_on(sa_family_t family)
+{
+	struct sockaddr addr = { 0 };
+	int sock, ret;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		net_sin6(&addr)->sin6_family = AF_INET6;
+		net_sin6(&addr)->sin6_port = htons(server->port);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		net_sin(&addr)->sin_family = AF_INET;
+		net_sin(&addr)->sin_port = htons(server->port);
+	} else {
+		return -EAFNOSUPPORT;
+	}
+
+	sock = zsock_socket(family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	ret = zsock_bind(sock, &addr, sizeof(addr));
+	if (ret == 0) {
+		ret = zsock_listen(sock, CONFIG_HTTP_SERVER_CONNECTIONS);
+	}
+
+	if (ret < 0) {
+		ret = -errno;
+		(void)zsock_close(sock);
+		return ret;
+	}
+
+	return sock;
+}
+
+/* Close the connections idle for too long, and return the time until the
+ * next one should be closed
+ */
+static int expire_idle(void)
+{
+	s64_t now = k_uptime_get();
+	int timeout = K_FOREVER;
+	s64_t left;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].sock < 0) {
+			continue;
+		}
+
+		left = conns[i].last_activity +
+			CONFIG_HTTP_SERVER_IDLE_TIMEOUT - now;
+		if (left <= 0) {
+			LOG_DBG("Closing idle connection %d", conns[i].sock);
+			conn_close(&conns[i]);
+			continue;
+		}
+
+		if (timeout == K_FOREVER || left < timeout) {
+			timeout = left;
+		}
+	}
+
+	return timeout;
+}
+
+static bool conn_evictable(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].sock < 0 ||
+		    (!conns[i].in_request && !conns[i].responding)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int http_server_run(const struct http_server *config)
+{
+	struct zsock_pollfd fds[LISTENERS + CONFIG_HTTP_SERVER_CONNECTIONS];
+	struct http_server_conn *polled[ARRAY_SIZE(fds)];
+	int listeners[LISTENERS];
+	int i, nfds, ret, timeout;
+
+	server = config;
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		conns[i].sock = -1;
+	}
+
+	listeners[0] = listen_on(AF_INET);
+	listeners[1] = listen_on(AF_INET6);
+	if (listeners[0] < 0 && listeners[1] < 0) {
+		LOG_ERR("Cannot listen on port %u", server->port);
+		return listeners[0] != -EAFNOSUPPORT ?
+			listeners[0] : listeners[1];
+	}
+
+	while (true) {
+		timeout = expire_idle();
+		nfds = 0;
+
+		/* Leave new connections in the backlog if there is no room
+		 * for them
+		 */
+		for (i = 0; i < LISTENERS && conn_evictable(); i++) {
+			if (listeners[i] >= 0) {
+				fds[nfds].fd = listeners[i];
+				fds[nfds].events = ZSOCK_POLLIN;
+				polled[nfds++] = NULL;
+			}
+		}
+
+		for (i = 0; i < ARRAY_SIZE(conns); i++) {
+			if (conns[i].sock < 0) {
+				continue;
+			}
+
+			fds[nfds].fd = conns[i].sock;
+			fds[nfds].events = conns[i].responding ?
+				ZSOCK_POLLOUT : ZSOCK_POLLIN;
+			polled[nfds++] = &conns[i];
+		}
+
+		ret = zsock_poll(fds, nfds, timeout);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_ERR("Cannot poll connections (%d)", ret);
+			break;
+		}
+
+		for (i = 0; i < nfds; i++) {
+			struct http_server_conn *conn = polled[i];
+
+			if (!fds[i].revents) {
+				continue;
+			}
+
+			if (!conn) {
+				conn_accept(fds[i].fd);
+			} else if (conn->sock != fds[i].fd) {
+				/* Evicted for a new connection */
+				continue;
+			} else if (fds[i].revents &
+				   (ZSOCK_POLLERR | ZSOCK_POLLNVAL)) {
+				conn_close(conn);
+			} else if (conn->responding) {
+				conn_writable(conn);
+			} else {
+				conn_readable(conn);
+			}
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].sock >= 0) {
+			conn_close(&conns[i]);
+		}
+	}
+
+	for (i = 0; i < LISTENERS; i++) {
+		if (listeners[i] >= 0) {
+			(void)zsock_close(listeners[i]);
+		}
+	}
+
+	return ret;
+}
@@ -49,6 +49,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #ifdef CONFIG_LWM2M_RW_JSON_SUPPORT
 #include "lwm2m_rw_json.h"
 #endif
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+#include "lwm2m_rw_senml_cbor.h"
+#endif
 #ifdef CONFIG_LWM2M_RD_CLIENT_SUPPORT
 #include "lwm2m_rd_client.h"
 #endif
@@ -97,6 +100,9 @@ struct observe_node {
 	u32_t counter;
 	u16_t format;
 	u8_t  tkl;
+#if defined(CONFIG_LWM2M_ENGINE_NOTIFY_NON)
+	s64_t con_timestamp;
+#endif
 };
 
 struct notification_attrs {
@@ -124,6 +130,7 @@ static struct service_node service_node_data[MAX_PERIODIC_SERVICE];
 
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_OBJ_INST_HASH_SIZE];
 static sys_slist_t engine_observer_list;
 static sys_slist_t engine_service_list;
 
@@ -407,6 +414,7 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	struct lwm2m_engine_obj *obj = NULL;
 	struct lwm2m_engine_obj_field *obj_field = NULL;
 	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_res *res = NULL;
 	struct observe_node *obs;
 	struct notification_attrs attrs = {
 		.flags = BIT(LWM2M_ATTR_PMIN) | BIT(LWM2M_ATTR_PMAX),
@@ -479,13 +487,8 @@ static int engine_add_observer(struct lwm2m_message *msg,
 
 	/* check if resource exists */
 	if (msg->path.level >= 3U) {
-		for (i = 0; i < obj_inst->resource_count; i++) {
-			if (obj_inst->resources[i].res_id == msg->path.res_id) {
-				break;
-			}
-		}
-
-		if (i == obj_inst->resource_count) {
+		res = lwm2m_get_engine_res(obj_inst, msg->path.res_id);
+		if (!res) {
 			LOG_ERR("unable to find res_id: %u/%u/%u",
 				msg->path.obj_id, msg->path.obj_inst_id,
 				msg->path.res_id);
@@ -493,8 +496,7 @@ static int engine_add_observer(struct lwm2m_message *msg,
 		}
 
 		/* load object field data */
-		obj_field = lwm2m_get_engine_obj_field(obj,
-				obj_inst->resources[i].res_id);
+		obj_field = lwm2m_get_engine_obj_field(obj, res->res_id);
 		if (!obj_field) {
 			LOG_ERR("unable to find obj_field: %u/%u/%u",
 				msg->path.obj_id, msg->path.obj_inst_id,
@@ -507,7 +509,7 @@ static int engine_add_observer(struct lwm2m_message *msg,
 			return -EPERM;
 		}
 
-		ret = update_attrs(&obj_inst->resources[i], &attrs);
+		ret = update_attrs(res, &attrs);
 		if (ret < 0) {
 			return ret;
 		}
@@ -537,6 +539,10 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	observe_node_data[i].max_period_sec = MAX(attrs.pmax, attrs.pmin);
 	observe_node_data[i].format = format;
 	observe_node_data[i].counter = 1U;
+#if defined(CONFIG_LWM2M_ENGINE_NOTIFY_NON)
+	observe_node_data[i].con_timestamp =
+			observe_node_data[i].last_timestamp;
+#endif
 	sys_slist_append(&engine_observer_list,
 			 &observe_node_data[i].node);
 
@@ -605,6 +611,16 @@ static void engine_remove_observer_by_id(u16_t obj_id, s32_t obj_inst_id)
 
 void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 {
+	int i;
+
+	obj->fields_sorted = true;
+	for (i = 1; i < obj->field_count; i++) {
+		if (obj->fields[i].res_id <= obj->fields[i - 1].res_id) {
+			obj->fields_sorted = false;
+			break;
+		}
+	}
+
 	sys_slist_append(&engine_obj_list, &obj->node);
 }
 
@@ -630,14 +646,69 @@ static struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 struct lwm2m_engine_obj_field *
 lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 {
-	int i;
+	int i, low, high;
+
+	if (!obj || !obj->fields || obj->field_count == 0U) {
+		return NULL;
+	}
 
-	if (obj && obj->fields && obj->field_count > 0) {
+	if (!obj->fields_sorted) {
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
 			}
 		}
+
+		return NULL;
+	}
+
+	low = 0;
+	high = obj->field_count - 1;
+	while (low <= high) {
+		i = (low + high) / 2;
+		if (obj->fields[i].res_id == res_id) {
+			return &obj->fields[i];
+		} else if (obj->fields[i].res_id < res_id) {
+			low = i + 1;
+		} else {
+			high = i - 1;
+		}
+	}
+
+	return NULL;
+}
+
+struct lwm2m_engine_res *
+lwm2m_get_engine_res(struct lwm2m_engine_obj_inst *obj_inst, int res_id)
+{
+	struct lwm2m_engine_res *res = obj_inst->resources;
+	int i, low, high;
+
+	if (!res || obj_inst->resource_count == 0U) {
+		return NULL;
+	}
+
+	if (!obj_inst->resources_sorted) {
+		for (i = 0; i < obj_inst->resource_count; i++) {
+			if (res[i].res_id == res_id) {
+				return &res[i];
+			}
+		}
+
+		return NULL;
+	}
+
+	low = 0;
+	high = obj_inst->resource_count - 1;
+	while (low <= high) {
+		i = (low + high) / 2;
+		if (res[i].res_id == res_id) {
+			return &res[i];
+		} else if (res[i].res_id < res_id) {
+			low = i + 1;
+		} else {
+			high = i - 1;
+		}
 	}
 
 	return NULL;
@@ -645,9 +716,31 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 
 /* engine object instance */
 
+static inline sys_slist_t *obj_inst_hash_bucket(int obj_id, int obj_inst_id)
+{
+	u32_t hash = ((u32_t)obj_id << 16 | (u16_t)obj_inst_id) * 2654435761U;
+
+	return &engine_obj_inst_hash[(hash >> 16) %
+				     ARRAY_SIZE(engine_obj_inst_hash)];
+}
+
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
+	int i;
+
+	obj_inst->resources_sorted = true;
+	for (i = 1; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i].res_id <=
+		    obj_inst->resources[i - 1].res_id) {
+			obj_inst->resources_sorted = false;
+			break;
+		}
+	}
+
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_append(obj_inst_hash_bucket(obj_inst->obj->obj_id,
+					      obj_inst->obj_inst_id),
+			 &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -655,6 +748,9 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 	engine_remove_observer_by_id(
 			obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(obj_inst_hash_bucket(obj_inst->obj->obj_id,
+						       obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 }
 
 static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
@@ -662,8 +758,8 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
-				     node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_hash_bucket(obj_id, obj_inst_id),
+				     obj_inst, hash_node) {
 		if (obj_inst->obj->obj_id == obj_id &&
 		    obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -1137,6 +1233,12 @@ static int select_writer(struct lwm2m_output_context *out, u16_t accept)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		out->writer = &senml_cbor_writer;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", accept);
 		return -ENOMSG;
@@ -1168,6 +1270,12 @@ static int select_reader(struct lwm2m_input_context *in, u16_t format)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		in->reader = &senml_cbor_reader;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", format);
 		return -ENOMSG;
@@ -1277,13 +1385,7 @@ static int path_to_objs(const struct lwm2m_obj_path *path,
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
-		}
-	}
-
+	r = lwm2m_get_engine_res(oi, path->res_id);
 	if (!r) {
 		LOG_ERR("resource %d not found", path->res_id);
 		return -ENOENT;
@@ -2802,6 +2904,11 @@ static int do_read_op(struct lwm2m_message *msg, u16_t content_format)
 		return do_read_op_json(msg, content_format);
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_read_op_senml_cbor(msg, content_format);
+#endif
+
 	default:
 		LOG_ERR("Unsupported content-format: %u", content_format);
 		return -ENOMSG;
@@ -3205,6 +3312,11 @@ static int do_write_op(struct lwm2m_message *msg,
 		return do_write_op_json(msg);
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_write_op_senml_cbor(msg);
+#endif
+
 	default:
 		LOG_ERR("Unsupported format: %u", format);
 		return -ENOMSG;
@@ -3769,6 +3881,40 @@ static int notify_message_reply_cb(const struct coap_packet *response,
 	return 0;
 }
 
+#if defined(CONFIG_LWM2M_ENGINE_NOTIFY_NON)
+static u8_t notify_message_type(struct observe_node *obs)
+{
+	s64_t timestamp = k_uptime_get();
+	int i, used = 0;
+
+	for (i = 0; i < CONFIG_LWM2M_ENGINE_MAX_PENDING; i++) {
+		if (obs->ctx->pendings[i].timeout) {
+			used++;
+		}
+	}
+
+	/* confirm once in a while even if the queue is busy */
+	if (used < CONFIG_LWM2M_ENGINE_MAX_PENDING &&
+	    timestamp - obs->con_timestamp >=
+			K_SECONDS(CONFIG_LWM2M_ENGINE_NOTIFY_CON_INTERVAL)) {
+		obs->con_timestamp = timestamp;
+		return COAP_TYPE_CON;
+	}
+
+	if (used * 2 < CONFIG_LWM2M_ENGINE_MAX_PENDING) {
+		obs->con_timestamp = timestamp;
+		return COAP_TYPE_CON;
+	}
+
+	return COAP_TYPE_NON_CON;
+}
+#else
+static inline u8_t notify_message_type(struct observe_node *obs)
+{
+	return COAP_TYPE_CON;
+}
+#endif /* CONFIG_LWM2M_ENGINE_NOTIFY_NON */
+
 static int generate_notify_message(struct observe_node *obs,
 				   bool manual_trigger)
 {
@@ -3811,7 +3957,7 @@ static int generate_notify_message(struct observe_node *obs,
 		goto cleanup;
 	}
 
-	msg->type = COAP_TYPE_CON;
+	msg->type = notify_message_type(obs);
 	msg->code = COAP_RESPONSE_CODE_CONTENT;
 	msg->mid = 0U;
 	msg->token = obs->token;
@@ -3911,7 +4057,7 @@ static int lwm2m_engine_service(void)
 {
 	struct observe_node *obs;
 	struct service_node *srv;
-	s64_t timestamp, service_due_timestamp;
+	s64_t timestamp, service_due_timestamp, batch_timestamp;
 
 	/*
 	 * 1. scan the observer list
@@ -3920,6 +4066,27 @@ static int lwm2m_engine_service(void)
 	 *    attaching the notify response handler
 	 */
 	timestamp = k_uptime_get();
+	batch_timestamp = timestamp;
+
+#if CONFIG_LWM2M_ENGINE_NOTIFY_BATCH_WINDOW > 0
+	/*
+	 * If any notification is due, pretend to be at the end of the
+	 * batch window for the time-based notifications, so that those
+	 * which are due soon anyway go out in the same burst.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+		if ((obs->event_timestamp > obs->last_timestamp &&
+		     timestamp > obs->last_timestamp +
+				 K_SECONDS(obs->min_period_sec)) ||
+		    timestamp > obs->last_timestamp +
+				K_SECONDS(obs->max_period_sec)) {
+			batch_timestamp = timestamp +
+				CONFIG_LWM2M_ENGINE_NOTIFY_BATCH_WINDOW;
+			break;
+		}
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
 		/*
 		 * manual notify requirements:
@@ -3936,7 +4103,7 @@ static int lwm2m_engine_service(void)
 		 * automatic time-based notify requirements:
 		 * - current timestamp > last_timestamp + max_period_sec
 		 */
-		} else if (timestamp > obs->last_timestamp +
+		} else if (batch_timestamp > obs->last_timestamp +
 				K_SECONDS(obs->max_period_sec)) {
 			obs->last_timestamp = k_uptime_get();
 			generate_notify_message(obs, false);
@@ -4185,6 +4352,34 @@ int lwm2m_socket_start(struct lwm2m_ctx *client_ctx)
 			lwm2m_engine_context_close(client_ctx);
 			return -errno;
 		}
+
+#if defined(CONFIG_LWM2M_DTLS_SESSION_CACHE)
+		int session_cache = TLS_SESSION_CACHE_ENABLED;
+
+		ret = setsockopt(client_ctx->sock_fd, SOL_TLS,
+				 TLS_SESSION_CACHE, &session_cache,
+				 sizeof(session_cache));
+		if (ret < 0) {
+			LOG_ERR("Failed to set TLS_SESSION_CACHE option: %d",
+				errno);
+			lwm2m_engine_context_close(client_ctx);
+			return -errno;
+		}
+#endif
+
+#if defined(CONFIG_LWM2M_DTLS_CID)
+		int dtls_cid = TLS_DTLS_CID_SUPPORTED;
+
+		/* Not fatal, the connection just won't survive NAT
+		 * rebinding.
+		 */
+		ret = setsockopt(client_ctx->sock_fd, SOL_TLS, TLS_DTLS_CID,
+				 &dtls_cid, sizeof(dtls_cid));
+		if (ret < 0) {
+			LOG_WRN("Failed to set TLS_DTLS_CID option: %d",
+				errno);
+		}
+#endif
 	}
 #endif /* CONFIG_LWM2M_DTLS_SUPPORT */
 
@@ -4199,6 +4394,20 @@ int lwm2m_socket_start(struct lwm2m_ctx *client_ctx)
 	return 0;
 }
 
+int lwm2m_socket_reconnect(struct lwm2m_ctx *client_ctx)
+{
+	/* Pending messages and observers are kept, only the socket, and
+	 * so the DTLS connection, is replaced.
+	 */
+	lwm2m_socket_del(client_ctx);
+	if (client_ctx->sock_fd >= 0) {
+		(void)close(client_ctx->sock_fd);
+		client_ctx->sock_fd = -1;
+	}
+
+	return lwm2m_socket_start(client_ctx);
+}
+
 int lwm2m_parse_peerinfo(char *url, struct sockaddr *addr, bool *use_dtls)
 {
 	struct http_parser_url parser;
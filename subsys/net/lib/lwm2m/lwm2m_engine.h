@@ -18,6 +18,7 @@
 #define LWM2M_FORMAT_APP_OCTET_STREAM	42
 #define LWM2M_FORMAT_APP_EXI		47
 #define LWM2M_FORMAT_APP_JSON		50
+#define LWM2M_FORMAT_APP_SENML_CBOR	112
 #define LWM2M_FORMAT_OMA_PLAIN_TEXT	1541
 #define LWM2M_FORMAT_OMA_OLD_TLV	1542
 #define LWM2M_FORMAT_OMA_OLD_JSON	1543
@@ -58,6 +59,8 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj);
 void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj);
 struct lwm2m_engine_obj_field *
 lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id);
+struct lwm2m_engine_res *
+lwm2m_get_engine_res(struct lwm2m_engine_obj_inst *obj_inst, int res_id);
 int  lwm2m_create_obj_inst(u16_t obj_id, u16_t obj_inst_id,
 			   struct lwm2m_engine_obj_inst **obj_inst);
 int  lwm2m_delete_obj_inst(u16_t obj_id, u16_t obj_inst_id);
@@ -116,6 +119,7 @@ u8_t lwm2m_firmware_get_update_result(void);
 int  lwm2m_socket_add(struct lwm2m_ctx *ctx);
 void lwm2m_socket_del(struct lwm2m_ctx *ctx);
 int  lwm2m_socket_start(struct lwm2m_ctx *client_ctx);
+int  lwm2m_socket_reconnect(struct lwm2m_ctx *client_ctx);
 int  lwm2m_parse_peerinfo(char *url, struct sockaddr *addr, bool *use_dtls);
 
 #endif /* LWM2M_ENGINE_H */
@@ -14,9 +14,19 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <ctype.h>
 #include <stdio.h>
 #include <string.h>
+#include <init.h>
 
 #include <net/http_parser.h>
 #include <net/socket.h>
+#include <stats/stats.h>
+
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_FLASH)
+#include <dfu/flash_img.h>
+#endif
+
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_RESUME)
+#include <settings/settings.h>
+#endif
 
 #include "lwm2m_object.h"
 #include "lwm2m_engine.h"
@@ -26,6 +36,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define NETWORK_INIT_TIMEOUT	K_SECONDS(10)
 #define NETWORK_CONNECT_TIMEOUT	K_SECONDS(10)
 #define PACKET_TRANSFER_RETRY_MAX	3
+#define ETAG_LEN	8
 
 static struct k_work firmware_work;
 static char firmware_uri[URI_LEN];
@@ -33,6 +44,88 @@ static struct lwm2m_ctx firmware_ctx;
 static int firmware_retry;
 static struct coap_block_context firmware_block_ctx;
 
+/* ETag of the package, which must not change during the download */
+static u8_t firmware_etag[ETAG_LEN];
+static u8_t firmware_etag_len;
+
+/* start of the download and bytes written since, for its throughput */
+static s64_t transfer_start;
+static u32_t transfer_bytes;
+
+STATS_SECT_START(lwm2m_fw_stats)
+STATS_SECT_ENTRY32(blocks)		/* blocks written */
+STATS_SECT_ENTRY32(bytes)		/* bytes written */
+STATS_SECT_ENTRY32(retries)		/* requests sent again on timeout */
+STATS_SECT_ENTRY32(duplicates)		/* duplicate responses ignored */
+STATS_SECT_ENTRY32(resumes)		/* downloads resumed */
+STATS_SECT_ENTRY32(resumed_bytes)	/* bytes not downloaded again */
+STATS_SECT_ENTRY32(last_time_ms)	/* duration of the last download */
+STATS_SECT_ENTRY32(last_rate_bps)	/* bytes/s of the last download */
+STATS_SECT_END;
+
+STATS_SECT_DECL(lwm2m_fw_stats) lwm2m_fw_stats;
+STATS_NAME_START(lwm2m_fw_stats)
+STATS_NAME(lwm2m_fw_stats, blocks)
+STATS_NAME(lwm2m_fw_stats, bytes)
+STATS_NAME(lwm2m_fw_stats, retries)
+STATS_NAME(lwm2m_fw_stats, duplicates)
+STATS_NAME(lwm2m_fw_stats, resumes)
+STATS_NAME(lwm2m_fw_stats, resumed_bytes)
+STATS_NAME(lwm2m_fw_stats, last_time_ms)
+STATS_NAME(lwm2m_fw_stats, last_rate_bps)
+STATS_NAME_END(lwm2m_fw_stats);
+
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_FLASH)
+static struct flash_img_context firmware_img;
+#endif
+
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_RESUME)
+#define PROGRESS_INTERVAL CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_RESUME_INTERVAL
+
+/* Progress of the download of progress_uri, stored in settings */
+struct transfer_progress {
+	u32_t bytes;
+	u32_t total_size;
+	u8_t block_size;
+	u8_t etag_len;
+	u8_t etag[ETAG_LEN];
+};
+
+static char progress_uri[URI_LEN];
+static struct transfer_progress progress;
+/* block written when the progress was last stored */
+static u32_t progress_block;
+#endif
+
+#define TRANSFER_WINDOW	CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_WINDOW
+
+/* Block2 request waiting for its response */
+struct transfer_slot {
+	u8_t token[8];
+	u32_t block;
+	bool used;
+};
+
+static struct transfer_slot transfer_slots[TRANSFER_WINDOW];
+
+/* next block to request and to write, and number of blocks (0 if unknown) */
+static u32_t next_request_block;
+static u32_t next_write_block;
+static u32_t block_count;
+
+#if TRANSFER_WINDOW > 1
+/* Block received ahead of the next block to write */
+struct held_block {
+	u32_t block;
+	u16_t len;
+	bool last;
+	bool used;
+	u8_t data[CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_BLOCK_SIZE];
+};
+
+static struct held_block held_blocks[TRANSFER_WINDOW - 1];
+#endif
+
 #if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_COAP_PROXY_SUPPORT)
 #define COAP2COAP_PROXY_URI_PATH	"coap2coap"
 #define COAP2HTTP_PROXY_URI_PATH	"coap2http"
@@ -41,6 +134,10 @@ static char proxy_uri[URI_LEN];
 #endif
 
 static void do_transmit_timeout_cb(struct lwm2m_message *msg);
+static int
+do_firmware_transfer_reply_cb(const struct coap_packet *response,
+			      struct coap_reply *reply,
+			      const struct sockaddr *from);
 
 static void set_update_result_from_error(int error_code)
 {
@@ -61,6 +158,168 @@ static void set_update_result_from_error(int error_code)
 	}
 }
 
+static enum coap_block_size transfer_block_size(void)
+{
+	switch (CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_BLOCK_SIZE) {
+	case 16:
+		return COAP_BLOCK_16;
+	case 32:
+		return COAP_BLOCK_32;
+	case 64:
+		return COAP_BLOCK_64;
+	case 128:
+		return COAP_BLOCK_128;
+	case 256:
+		return COAP_BLOCK_256;
+	case 512:
+		return COAP_BLOCK_512;
+	case 1024:
+		return COAP_BLOCK_1024;
+	}
+
+	return lwm2m_default_block_size();
+}
+
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_RESUME)
+static void transfer_progress_store(void)
+{
+	int ret;
+
+	progress.bytes = flash_img_bytes_written(&firmware_img);
+	progress.total_size = firmware_block_ctx.total_size;
+	progress.block_size = firmware_block_ctx.block_size;
+	progress.etag_len = firmware_etag_len;
+	memcpy(progress.etag, firmware_etag, sizeof(progress.etag));
+	progress_block = next_write_block;
+
+	ret = settings_save_one("lwm2m/fw/progress", &progress,
+				sizeof(progress));
+	if (ret < 0) {
+		LOG_ERR("Cannot store download progress (err:%d)", ret);
+	}
+}
+
+static void transfer_progress_clear(void)
+{
+	(void)memset(&progress, 0, sizeof(progress));
+	progress_uri[0] = '\0';
+
+	(void)settings_delete("lwm2m/fw/progress");
+	(void)settings_delete("lwm2m/fw/uri");
+}
+
+/* Start the download of the package again, or continue it from the
+ * progress stored if it is of the same package.
+ */
+static int transfer_progress_start(void)
+{
+	size_t block_len, resumed;
+	int ret;
+
+	if (!progress.bytes || progress.block_size > COAP_BLOCK_1024 ||
+	    strcmp(progress_uri, firmware_uri)) {
+		goto restart;
+	}
+
+	ret = flash_img_resume(&firmware_img, progress.bytes);
+	if (ret < 0) {
+		return ret;
+	}
+
+	resumed = flash_img_bytes_written(&firmware_img);
+	block_len = coap_block_size_to_bytes(progress.block_size);
+	if (resumed % block_len) {
+		LOG_WRN("Cannot resume download at byte %zu", resumed);
+		goto restart;
+	}
+
+	coap_block_transfer_init(&firmware_block_ctx, progress.block_size,
+				 progress.total_size);
+	firmware_etag_len = progress.etag_len;
+	memcpy(firmware_etag, progress.etag, sizeof(firmware_etag));
+
+	next_request_block = resumed / block_len;
+	next_write_block = next_request_block;
+	progress_block = next_write_block;
+	if (progress.total_size > 0) {
+		block_count = (progress.total_size + block_len - 1) /
+			      block_len;
+	}
+
+	STATS_INC(lwm2m_fw_stats, resumes);
+	STATS_INCN(lwm2m_fw_stats, resumed_bytes, resumed);
+	LOG_INF("Resuming download at byte %zu", resumed);
+
+	return 0;
+
+restart:
+	transfer_progress_clear();
+	progress_block = 0U;
+
+	strcpy(progress_uri, firmware_uri);
+	ret = settings_save_one("lwm2m/fw/uri", progress_uri,
+				strlen(progress_uri));
+	if (ret < 0) {
+		LOG_ERR("Cannot store package URI (err:%d)", ret);
+	}
+
+	return flash_img_init(&firmware_img);
+}
+
+static int transfer_progress_set(const char *key, size_t len,
+				 settings_read_cb read_cb, void *cb_arg)
+{
+	ssize_t ret;
+
+	if (settings_name_steq(key, "uri", NULL)) {
+		ret = read_cb(cb_arg, progress_uri, sizeof(progress_uri) - 1);
+		if (ret < 0) {
+			return ret;
+		}
+
+		progress_uri[ret] = '\0';
+	} else if (settings_name_steq(key, "progress", NULL)) {
+		ret = read_cb(cb_arg, &progress, sizeof(progress));
+		if (ret != sizeof(progress)) {
+			LOG_ERR("Invalid stored download progress");
+			(void)memset(&progress, 0, sizeof(progress));
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(lwm2m_fw, "lwm2m/fw", NULL,
+			       transfer_progress_set, NULL, NULL);
+#elif defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_FLASH)
+static inline void transfer_progress_store(void)
+{
+}
+
+static inline void transfer_progress_clear(void)
+{
+}
+
+static inline int transfer_progress_start(void)
+{
+	return flash_img_init(&firmware_img);
+}
+#else
+static inline void transfer_progress_store(void)
+{
+}
+
+static inline void transfer_progress_clear(void)
+{
+}
+
+static inline int transfer_progress_start(void)
+{
+	return 0;
+}
+#endif /* CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_RESUME */
+
 static int transfer_request(struct coap_block_context *ctx,
 			    u8_t *token, u8_t tkl,
 			    coap_reply_t reply_cb)
@@ -227,22 +486,317 @@ cleanup:
 	return ret;
 }
 
+static struct transfer_slot *transfer_slot_find(const u8_t *token, u8_t tkl)
+{
+	int i;
+
+	if (tkl != sizeof(transfer_slots[0].token)) {
+		return NULL;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(transfer_slots); i++) {
+		if (transfer_slots[i].used &&
+		    !memcmp(transfer_slots[i].token, token, tkl)) {
+			return &transfer_slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int transfer_request_block(struct transfer_slot *slot)
+{
+	struct coap_block_context block_ctx;
+
+	memcpy(&block_ctx, &firmware_block_ctx, sizeof(block_ctx));
+	block_ctx.current = slot->block *
+		coap_block_size_to_bytes(firmware_block_ctx.block_size);
+
+	return transfer_request(&block_ctx, slot->token, sizeof(slot->token),
+				do_firmware_transfer_reply_cb);
+}
+
+static int transfer_fill_window(void)
+{
+	struct transfer_slot *slot;
+	bool busy = false;
+	int i, ret;
+
+	for (i = 0; i < ARRAY_SIZE(transfer_slots); i++) {
+		busy |= transfer_slots[i].used;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(transfer_slots); i++) {
+		slot = &transfer_slots[i];
+		if (slot->used) {
+			continue;
+		}
+
+		/* Until the package size is known, blocks are requested one
+		 * at a time, not to ask for blocks past the end.
+		 */
+		if (block_count ? next_request_block >= block_count : busy) {
+			break;
+		}
+
+		slot->block = next_request_block;
+		memcpy(slot->token, coap_next_token(), sizeof(slot->token));
+
+		ret = transfer_request_block(slot);
+		if (ret < 0) {
+			return ret;
+		}
+
+		slot->used = true;
+		busy = true;
+		next_request_block++;
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_FLASH)
+static int transfer_write(const u8_t *data, u16_t len, bool last_block)
+{
+	int ret;
+
+	ret = flash_img_buffered_write(&firmware_img, (u8_t *)data, len,
+				       last_block);
+	if (ret < 0) {
+		LOG_ERR("Cannot write image (err:%d)", ret);
+		return ret == -ENOMEM ? ret : -EIO;
+	}
+
+	STATS_INCN(lwm2m_fw_stats, bytes, len);
+	transfer_bytes += len;
+
+#if defined(CONFIG_IMG_ENABLE_HASH_CHECK)
+	if (last_block) {
+		ret = flash_img_check(&firmware_img);
+		if (ret < 0) {
+			LOG_ERR("Image check failed (err:%d)", ret);
+			return -EFAULT;
+		}
+	}
+#endif
+
+	return 0;
+}
+
+static int transfer_write_payload(const struct coap_packet *response,
+				  bool last_block)
+{
+	const u8_t *payload;
+	u16_t payload_len;
+
+	LOG_DBG("total: %zd, block: %u", firmware_block_ctx.total_size,
+		next_write_block);
+
+	/* Written from the packet, flash_img buffers what is left of
+	 * a flash write block.
+	 */
+	payload = coap_packet_get_payload(response, &payload_len);
+	if (!payload) {
+		payload_len = 0U;
+	}
+
+	return transfer_write(payload, payload_len, last_block);
+}
+#else
+static int transfer_write(const u8_t *data, u16_t len, bool last_block)
+{
+	lwm2m_engine_set_data_cb_t write_cb;
+
+	write_cb = lwm2m_firmware_get_write_cb();
+	if (!write_cb) {
+		return 0;
+	}
+
+	STATS_INCN(lwm2m_fw_stats, bytes, len);
+	transfer_bytes += len;
+
+	return write_cb(0, 0, 0, (u8_t *)data, len, last_block,
+			firmware_block_ctx.total_size);
+}
+
+static int transfer_write_payload(const struct coap_packet *response,
+				  bool last_block)
+{
+	int ret;
+	u16_t payload_len, payload_offset, len;
+	struct lwm2m_engine_res *res = NULL;
+	size_t write_buflen;
+	u8_t *write_buf;
+
+	payload_offset = response->hdr_len + response->opt_len;
+	coap_packet_get_payload(response, &payload_len);
+	if (payload_len == 0U || !lwm2m_firmware_get_write_cb()) {
+		return 0;
+	}
+
+	LOG_DBG("total: %zd, block: %u", firmware_block_ctx.total_size,
+		next_write_block);
+
+	/* look up firmware package resource */
+	ret = lwm2m_engine_get_resource("5/0/0", &res);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* get buffer data */
+	write_buf = res->res_instances->data_ptr;
+	write_buflen = res->res_instances->data_len;
+
+	/* check for user override to buffer */
+	if (res->pre_write_cb) {
+		write_buf = res->pre_write_cb(0, 0, 0, &write_buflen);
+	}
+
+	/* flush incoming data to write_cb */
+	while (payload_len > 0) {
+		len = (payload_len > write_buflen) ? write_buflen : payload_len;
+		payload_len -= len;
+		/* check for end of packet */
+		if (buf_read(write_buf, len, CPKT_BUF_READ(response),
+			     &payload_offset) < 0) {
+			/* malformed packet */
+			return -EFAULT;
+		}
+
+		ret = transfer_write(write_buf, len,
+				     last_block && (payload_len == 0U));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_FLASH */
+
+#if TRANSFER_WINDOW > 1
+static int transfer_hold_payload(const struct coap_packet *response,
+				 u32_t block, bool last_block)
+{
+	u16_t payload_len, payload_offset;
+	int i;
+
+	payload_offset = response->hdr_len + response->opt_len;
+	coap_packet_get_payload(response, &payload_len);
+
+	for (i = 0; i < ARRAY_SIZE(held_blocks); i++) {
+		if (!held_blocks[i].used) {
+			break;
+		}
+	}
+
+	if (i == ARRAY_SIZE(held_blocks)) {
+		return -ENOMEM;
+	}
+
+	if (payload_len > sizeof(held_blocks[i].data) ||
+	    buf_read(held_blocks[i].data, payload_len,
+		     CPKT_BUF_READ(response), &payload_offset) < 0) {
+		return -EFAULT;
+	}
+
+	held_blocks[i].block = block;
+	held_blocks[i].len = payload_len;
+	held_blocks[i].last = last_block;
+	held_blocks[i].used = true;
+
+	return 0;
+}
+
+static int transfer_write_held(void)
+{
+	struct held_block *held;
+	int i, ret;
+
+	for (i = 0; i < ARRAY_SIZE(held_blocks); i++) {
+		held = &held_blocks[i];
+		if (!held->used || held->block != next_write_block) {
+			continue;
+		}
+
+		ret = transfer_write(held->data, held->len, held->last);
+		if (ret < 0) {
+			return ret;
+		}
+
+		held->used = false;
+		next_write_block++;
+
+		/* the next block may be held in an earlier entry */
+		i = -1;
+	}
+
+	return 0;
+}
+#else
+static inline int transfer_hold_payload(const struct coap_packet *response,
+					u32_t block, bool last_block)
+{
+	return -ENOMEM;
+}
+
+static inline int transfer_write_held(void)
+{
+	return 0;
+}
+#endif /* TRANSFER_WINDOW > 1 */
+
+/* The ETag of the first block is the one of every other block */
+static int transfer_check_etag(const struct coap_packet *response,
+			       u32_t block)
+{
+	struct coap_option option;
+	u8_t len = 0U;
+	int ret;
+
+	ret = coap_find_options(response, COAP_OPTION_ETAG, &option, 1);
+	if (ret > 0) {
+		len = MIN(option.len, sizeof(firmware_etag));
+	}
+
+	if (block == 0U) {
+		memcpy(firmware_etag, option.value, len);
+		firmware_etag_len = len;
+	} else if (len != firmware_etag_len ||
+		   memcmp(firmware_etag, option.value, len)) {
+		LOG_ERR("Package changed during transfer");
+		return -EFAULT;
+	}
+
+	return 0;
+}
+
+static void transfer_done(void)
+{
+	u32_t elapsed = k_uptime_get() - transfer_start;
+
+	LOG_INF("Downloaded %u bytes in %u ms", transfer_bytes, elapsed);
+
+	STATS_SET(lwm2m_fw_stats, last_time_ms, elapsed);
+	STATS_SET(lwm2m_fw_stats, last_rate_bps, elapsed ?
+		  (u64_t)transfer_bytes * MSEC_PER_SEC / elapsed : 0);
+
+	transfer_progress_clear();
+}
+
 static int
 do_firmware_transfer_reply_cb(const struct coap_packet *response,
 			      struct coap_reply *reply,
 			      const struct sockaddr *from)
 {
 	int ret;
-	bool last_block;
+	bool more;
+	u32_t block;
 	u8_t token[8];
 	u8_t tkl;
-	u16_t payload_len, payload_offset, len;
 	struct coap_packet *check_response = (struct coap_packet *)response;
-	struct lwm2m_engine_res *res = NULL;
-	lwm2m_engine_set_data_cb_t write_cb;
-	size_t write_buflen;
-	u8_t resp_code, *write_buf;
-	struct coap_block_context received_block_ctx;
+	struct transfer_slot *slot;
+	u8_t resp_code;
 
 	/* token is used to determine a valid ACK vs a separated response */
 	tkl = coap_header_get_token(check_response, token);
@@ -269,114 +823,141 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 		goto error;
 	}
 
-	/* save main firmware block context */
-	memcpy(&received_block_ctx, &firmware_block_ctx,
-	       sizeof(firmware_block_ctx));
-
-	ret = coap_update_from_block(check_response, &firmware_block_ctx);
-	if (ret < 0) {
-		LOG_ERR("Error from block update: %d", ret);
-		ret = -EFAULT;
-		goto error;
-	}
-
 	/* test for duplicate transfer */
-	if (firmware_block_ctx.current < received_block_ctx.current) {
+	slot = transfer_slot_find(token, tkl);
+	if (!slot) {
 		LOG_WRN("Duplicate packet ignored");
-
-		/* restore main firmware block context */
-		memcpy(&firmware_block_ctx, &received_block_ctx,
-		       sizeof(firmware_block_ctx));
+		STATS_INC(lwm2m_fw_stats, duplicates);
 
 		/* set reply->user_data to error to avoid releasing */
 		reply->user_data = (void *)COAP_REPLY_STATUS_ERROR;
 		return 0;
 	}
 
-	/* Reach last block if ret equals to 0 */
-	last_block = !coap_next_block(check_response, &firmware_block_ctx);
-
-	/* Process incoming data */
-	payload_offset = response->hdr_len + response->opt_len;
-	coap_packet_get_payload(response, &payload_len);
-	if (payload_len > 0) {
-		LOG_DBG("total: %zd, current: %zd",
-			firmware_block_ctx.total_size,
-			firmware_block_ctx.current);
-
-		/* look up firmware package resource */
-		ret = lwm2m_engine_get_resource("5/0/0", &res);
+	ret = coap_get_block2_option(check_response, &more, &block);
+	if (ret == -ENOENT) {
+		/* the whole package fits in the response */
+		more = false;
+		block = 0U;
+	} else if (block == 0U) {
+		/* the first block sets the block size and package size */
+		ret = coap_update_from_block(check_response,
+					     &firmware_block_ctx);
 		if (ret < 0) {
+			LOG_ERR("Error from block update: %d", ret);
+			ret = -EFAULT;
 			goto error;
 		}
 
-		/* get buffer data */
-		write_buf = res->res_instances->data_ptr;
-		write_buflen = res->res_instances->data_len;
-
-		/* check for user override to buffer */
-		if (res->pre_write_cb) {
-			write_buf = res->pre_write_cb(0, 0, 0, &write_buflen);
+		if (firmware_block_ctx.total_size > 0) {
+			ret = coap_block_size_to_bytes(
+					firmware_block_ctx.block_size);
+			block_count = (firmware_block_ctx.total_size +
+				       ret - 1) / ret;
 		}
 
-		write_cb = lwm2m_firmware_get_write_cb();
-		if (write_cb) {
-			/* flush incoming data to write_cb */
-			while (payload_len > 0) {
-				len = (payload_len > write_buflen) ?
-				       write_buflen : payload_len;
-				payload_len -= len;
-				/* check for end of packet */
-				if (buf_read(write_buf, len,
-					     CPKT_BUF_READ(response),
-					     &payload_offset) < 0) {
-					/* malformed packet */
-					ret = -EFAULT;
-					goto error;
-				}
-
-				ret = write_cb(0, 0, 0,
-					       write_buf, len,
-					       last_block &&
-							(payload_len == 0U),
-					       firmware_block_ctx.total_size);
-				if (ret < 0) {
-					goto error;
-				}
-			}
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_FLASH)
+		if (firmware_block_ctx.total_size >
+		    firmware_img.flash_area->fa_size) {
+			LOG_ERR("Package of %zu bytes does not fit",
+				firmware_block_ctx.total_size);
+			ret = -ENOSPC;
+			goto error;
 		}
+#endif
+	} else if (ret != coap_block_size_to_bytes(
+					firmware_block_ctx.block_size)) {
+		LOG_ERR("Block size changed during transfer");
+		ret = -EFAULT;
+		goto error;
+	}
+
+	if (block != slot->block || (block_count && block >= block_count)) {
+		LOG_ERR("Unexpected block %u", block);
+		ret = -EFAULT;
+		goto error;
+	}
+
+	ret = transfer_check_etag(check_response, block);
+	if (ret < 0) {
+		goto error;
 	}
 
-	if (!last_block) {
-		/* More block(s) to come, setup next transfer */
-		ret = transfer_request(&firmware_block_ctx, token, tkl,
-				       do_firmware_transfer_reply_cb);
+	slot->used = false;
+	STATS_INC(lwm2m_fw_stats, blocks);
+
+	if (!more) {
+		block_count = block + 1;
+	}
+
+	/* Blocks are written in order, those received ahead are held until
+	 * the blocks before them came in.
+	 */
+	if (block == next_write_block) {
+		ret = transfer_write_payload(check_response, !more);
+		if (ret < 0) {
+			goto error;
+		}
+
+		next_write_block++;
+
+		ret = transfer_write_held();
 		if (ret < 0) {
 			goto error;
 		}
 	} else {
+		ret = transfer_hold_payload(check_response, block, !more);
+		if (ret < 0) {
+			goto error;
+		}
+	}
+
+	if (next_write_block == block_count) {
 		/* Download finished */
+		transfer_done();
 		lwm2m_firmware_set_update_state(STATE_DOWNLOADED);
+		return 0;
+	}
+
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_RESUME)
+	if (next_write_block - progress_block >= PROGRESS_INTERVAL) {
+		transfer_progress_store();
+	}
+#endif
+
+	/* More block(s) to come, setup next transfers */
+	ret = transfer_fill_window();
+	if (ret < 0) {
+		goto error;
 	}
 
 	return 0;
 
 error:
+	if (ret == -EFAULT) {
+		/* not to resume from the corrupted package */
+		transfer_progress_clear();
+	}
+
 	set_update_result_from_error(ret);
 	return ret;
 }
 
 static void do_transmit_timeout_cb(struct lwm2m_message *msg)
 {
+	struct transfer_slot *slot;
 	int ret;
 
+	slot = transfer_slot_find(msg->token, msg->tkl);
+	if (!slot) {
+		return;
+	}
+
 	if (firmware_retry < PACKET_TRANSFER_RETRY_MAX) {
 		/* retry block */
 		LOG_WRN("TIMEOUT - Sending a retry packet!");
 
-		ret = transfer_request(&firmware_block_ctx,
-				       msg->token, msg->tkl,
-				       do_firmware_transfer_reply_cb);
+		ret = transfer_request_block(slot);
 		if (ret < 0) {
 			/* abort retries / transfer */
 			set_update_result_from_error(ret);
@@ -385,6 +966,7 @@ static void do_transmit_timeout_cb(struct lwm2m_message *msg)
 		}
 
 		firmware_retry++;
+		STATS_INC(lwm2m_fw_stats, retries);
 	} else {
 		LOG_ERR("TIMEOUT - Too many retry packet attempts! "
 			"Aborting firmware download.");
@@ -429,10 +1011,27 @@ static void firmware_transfer(struct k_work *work)
 	LOG_INF("Connecting to server %s", log_strdup(firmware_uri));
 
 	/* reset block transfer context */
-	coap_block_transfer_init(&firmware_block_ctx,
-				 lwm2m_default_block_size(), 0);
-	ret = transfer_request(&firmware_block_ctx, coap_next_token(), 8,
-			       do_firmware_transfer_reply_cb);
+	coap_block_transfer_init(&firmware_block_ctx, transfer_block_size(),
+				 0);
+	(void)memset(transfer_slots, 0, sizeof(transfer_slots));
+#if TRANSFER_WINDOW > 1
+	(void)memset(held_blocks, 0, sizeof(held_blocks));
+#endif
+	next_request_block = 0U;
+	next_write_block = 0U;
+	block_count = 0U;
+	firmware_etag_len = 0U;
+
+	ret = transfer_progress_start();
+	if (ret < 0) {
+		LOG_ERR("Cannot start writing the image: %d", ret);
+		goto error;
+	}
+
+	transfer_start = k_uptime_get();
+	transfer_bytes = 0U;
+
+	ret = transfer_fill_window();
 	if (ret < 0) {
 		goto error;
 	}
@@ -468,3 +1067,11 @@ int lwm2m_firmware_start_transfer(char *package_uri)
 
 	return 0;
 }
+
+static int lwm2m_firmware_pull_init(struct device *dev)
+{
+	return STATS_INIT_AND_REG(lwm2m_fw_stats, STATS_SIZE_32, "lwm2m_fw");
+}
+
+SYS_INIT(lwm2m_firmware_pull_init, APPLICATION,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2019 Foundries.io
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Statistics object, a private object exposing the groups of the stats
+ * subsystem.  Instance N is the group with ID N; its Data resource holds
+ * the group in the binary form of stats_group_export(), so a server reads
+ * all values of a group in one request.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_obj_stats
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <string.h>
+#include <init.h>
+#include <stats/stats.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+
+/* Statistics resource IDs */
+#define STATS_NAME_ID			0
+#define STATS_DATA_ID			1
+
+#define STATS_MAX_ID			2
+
+#define MAX_INSTANCE_COUNT		CONFIG_LWM2M_STATS_OBJ_INSTANCE_COUNT
+
+#define RESOURCE_INSTANCE_COUNT		STATS_MAX_ID
+
+static struct lwm2m_engine_obj stats_obj;
+static struct lwm2m_engine_obj_field fields[] = {
+	OBJ_FIELD_DATA(STATS_NAME_ID, R, STRING),
+	OBJ_FIELD_DATA(STATS_DATA_ID, R, OPAQUE),
+};
+
+static struct lwm2m_engine_obj_inst inst[MAX_INSTANCE_COUNT];
+static struct lwm2m_engine_res res[MAX_INSTANCE_COUNT][STATS_MAX_ID];
+static struct lwm2m_engine_res_inst
+		res_inst[MAX_INSTANCE_COUNT][RESOURCE_INSTANCE_COUNT];
+
+/* Only used while a read is encoded */
+static u8_t export_buf[CONFIG_LWM2M_STATS_OBJ_DATA_SIZE];
+
+static void *data_read_cb(u16_t obj_inst_id, u16_t res_id, u16_t res_inst_id,
+			  size_t *data_len)
+{
+	struct stats_hdr *hdr = stats_group_find_id(obj_inst_id);
+	int len;
+
+	if (!hdr) {
+		return NULL;
+	}
+
+	len = stats_group_export(hdr, export_buf, sizeof(export_buf));
+	if (len < 0) {
+		LOG_ERR("Stats group %s too large: %d", hdr->s_name, len);
+		return NULL;
+	}
+
+	*data_len = len;
+	return export_buf;
+}
+
+static struct lwm2m_engine_obj_inst *stats_create(u16_t obj_inst_id)
+{
+	struct stats_hdr *hdr = stats_group_find_id(obj_inst_id);
+	int i = 0, j = 0;
+
+	if (!hdr || obj_inst_id >= MAX_INSTANCE_COUNT) {
+		LOG_ERR("Can not create instance - no stats group: %u",
+			obj_inst_id);
+		return NULL;
+	}
+
+	if (inst[obj_inst_id].obj) {
+		LOG_ERR("Can not create instance - already existing: %u",
+			obj_inst_id);
+		return NULL;
+	}
+
+	(void)memset(res[obj_inst_id], 0,
+		     sizeof(res[obj_inst_id][0]) * ARRAY_SIZE(res[obj_inst_id]));
+	init_res_instance(res_inst[obj_inst_id],
+			  ARRAY_SIZE(res_inst[obj_inst_id]));
+
+	/* initialize instance resource data */
+	INIT_OBJ_RES_DATA(STATS_NAME_ID, res[obj_inst_id], i,
+			  res_inst[obj_inst_id], j, (void *)hdr->s_name,
+			  strlen(hdr->s_name));
+	INIT_OBJ_RES(STATS_DATA_ID, res[obj_inst_id], i,
+		     res_inst[obj_inst_id], j, 1, true, NULL, 0,
+		     data_read_cb, NULL, NULL, NULL);
+
+	inst[obj_inst_id].resources = res[obj_inst_id];
+	inst[obj_inst_id].resource_count = i;
+
+	LOG_DBG("Create LWM2M stats instance: %d", obj_inst_id);
+
+	return &inst[obj_inst_id];
+}
+
+static int lwm2m_stats_init(struct device *dev)
+{
+	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	u16_t id;
+	int ret;
+
+	stats_obj.obj_id = CONFIG_LWM2M_STATS_OBJ_ID;
+	stats_obj.fields = fields;
+	stats_obj.field_count = ARRAY_SIZE(fields);
+	stats_obj.max_instance_count = MAX_INSTANCE_COUNT;
+	stats_obj.create_cb = stats_create;
+	lwm2m_register_obj(&stats_obj);
+
+	/* One instance per group registered so far */
+	for (id = 0U; id < MAX_INSTANCE_COUNT && stats_group_find_id(id);
+	     id++) {
+		ret = lwm2m_create_obj_inst(CONFIG_LWM2M_STATS_OBJ_ID, id,
+					    &obj_inst);
+		if (ret < 0) {
+			LOG_ERR("Create LWM2M stats instance %u error: %d",
+				id, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* Run last, once the subsystems have registered their groups. */
+SYS_INIT(lwm2m_stats_init, APPLICATION, 99);
@@ -190,6 +190,9 @@ struct lwm2m_engine_obj {
 	u16_t field_count;
 	u16_t instance_count;
 	u16_t max_instance_count;
+
+	/* fields are in increasing res_id order, set by the engine */
+	bool fields_sorted;
 };
 
 /* Resource instances with this value are considered "not created" yet */
@@ -342,12 +345,18 @@ struct lwm2m_engine_obj_inst {
 	/* instance list */
 	sys_snode_t node;
 
+	/* instance hash bucket list */
+	sys_snode_t hash_node;
+
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_res *resources;
 
 	/* object instance member data */
 	u16_t obj_inst_id;
 	u16_t resource_count;
+
+	/* resources are in increasing res_id order, set by the engine */
+	bool resources_sorted;
 };
 
 /* Initialize resource instances prior to use */
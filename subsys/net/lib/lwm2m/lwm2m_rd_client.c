@@ -85,6 +85,9 @@ enum sm_engine_state {
 	ENGINE_REGISTRATION_SENT,
 	ENGINE_REGISTRATION_DONE,
 	ENGINE_UPDATE_SENT,
+#if defined(CONFIG_LWM2M_DTLS_SESSION_CACHE)
+	ENGINE_UPDATE_RECONNECT,
+#endif
 	ENGINE_DEREGISTER,
 	ENGINE_DEREGISTER_SENT,
 	ENGINE_DEREGISTER_FAILED,
@@ -97,6 +100,9 @@ struct lwm2m_rd_client_info {
 	u8_t engine_state;
 	u8_t use_bootstrap;
 	u8_t trigger_update;
+#if defined(CONFIG_LWM2M_DTLS_SESSION_CACHE)
+	u8_t update_reconnected;
+#endif
 
 	s64_t last_update;
 
@@ -338,6 +344,18 @@ static void do_update_timeout_cb(struct lwm2m_message *msg)
 {
 	LOG_WRN("Registration Update Timeout");
 
+#if defined(CONFIG_LWM2M_DTLS_SESSION_CACHE)
+	/* The DTLS connection may have been lost with a change of our
+	 * address, try again once on a new one, which resumes the session,
+	 * before registering from scratch.
+	 */
+	if (client.ctx->use_dtls && !client.update_reconnected) {
+		client.update_reconnected = 1U;
+		set_sm_state(ENGINE_UPDATE_RECONNECT);
+		return;
+	}
+#endif
+
 	/* Re-do registration */
 	sm_handle_timeout_state(msg, ENGINE_DO_REGISTRATION);
 }
@@ -728,6 +746,9 @@ static int sm_registration_done(void)
 	      (k_uptime_get() - client.last_update) / 1000))) {
 		forced_update = client.trigger_update;
 		client.trigger_update = 0U;
+#if defined(CONFIG_LWM2M_DTLS_SESSION_CACHE)
+		client.update_reconnected = 0U;
+#endif
 		ret = sm_send_registration(forced_update,
 					   do_update_reply_cb,
 					   do_update_timeout_cb);
@@ -744,6 +765,34 @@ static int sm_registration_done(void)
 	return ret;
 }
 
+#if defined(CONFIG_LWM2M_DTLS_SESSION_CACHE)
+static int sm_do_update_reconnect(void)
+{
+	int ret;
+
+	ret = lwm2m_socket_reconnect(client.ctx);
+	if (ret < 0) {
+		LOG_ERR("Cannot reconnect (%d)", ret);
+		set_sm_state(ENGINE_DO_REGISTRATION);
+		return ret;
+	}
+
+	ret = sm_send_registration(false,
+				   do_update_reply_cb,
+				   do_update_timeout_cb);
+	if (!ret) {
+		set_sm_state(ENGINE_UPDATE_SENT);
+	} else {
+		LOG_ERR("Registration update err: %d", ret);
+		lwm2m_engine_context_close(client.ctx);
+		/* perform full registration */
+		set_sm_state(ENGINE_DO_REGISTRATION);
+	}
+
+	return ret;
+}
+#endif
+
 static int sm_do_deregister(void)
 {
 	struct lwm2m_message *msg;
@@ -832,6 +881,12 @@ static void lwm2m_rd_client_service(struct k_work *work)
 			/* wait update to be done or abort */
 			break;
 
+#if defined(CONFIG_LWM2M_DTLS_SESSION_CACHE)
+		case ENGINE_UPDATE_RECONNECT:
+			sm_do_update_reconnect();
+			break;
+#endif
+
 		case ENGINE_DEREGISTER:
 			sm_do_deregister();
 			break;
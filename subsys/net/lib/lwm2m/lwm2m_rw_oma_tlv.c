@@ -835,12 +835,7 @@ static int do_write_op_tlv_item(struct lwm2m_message *msg)
 		goto error;
 	}
 
-	for (i = 0; i < obj_inst->resource_count; i++) {
-		if (obj_inst->resources[i].res_id == msg->path.res_id) {
-			res = &obj_inst->resources[i];
-			break;
-		}
-	}
+	res = lwm2m_get_engine_res(obj_inst, msg->path.res_id);
 
 	if (res) {
 		for (i = 0; i < res->res_inst_count; i++) {
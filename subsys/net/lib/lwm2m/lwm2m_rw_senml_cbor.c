@@ -0,0 +1,909 @@
+/*
+ * Copyright (c) 2019 Foundries.io
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SenML-CBOR content format (RFC 8428, application/senml+cbor)
+ *
+ * Records are encoded with tinycbor straight into the CoAP packet buffer:
+ * the encoder writer appends to the outgoing packet, and the decoder
+ * reader walks the payload of the incoming one, so no intermediate copy
+ * of the payload is needed in either direction.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_senml_cbor
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "cbor.h"
+#include "compilersupport_p.h"
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_engine.h"
+
+/* SenML labels, RFC 8428 section 6 */
+#define SENML_LABEL_BN		-2
+#define SENML_LABEL_N		0
+#define SENML_LABEL_V		2
+#define SENML_LABEL_VS		3
+#define SENML_LABEL_VB		4
+#define SENML_LABEL_VD		8
+
+#define NAME_BUF_LEN		sizeof("65535/65535/65535")
+#define BASE_NAME_BUF_LEN	sizeof("/65535/65535/")
+
+struct senml_cbor_buf_writer {
+	struct cbor_encoder_writer enc;
+	struct lwm2m_output_context *out;
+};
+
+struct senml_cbor_buf_reader {
+	struct cbor_decoder_reader r;
+	const u8_t *data;
+};
+
+struct senml_cbor_out_formatter_data {
+	struct senml_cbor_buf_writer writer;
+
+	/* encoders of the payload and of the record array */
+	CborEncoder encoder;
+	CborEncoder array;
+
+	/* base name, sent with the first record */
+	char base_name[BASE_NAME_BUF_LEN];
+	bool base_name_sent;
+
+	/* flags */
+	u8_t writer_flags;
+
+	/* path storage */
+	u8_t path_level;
+};
+
+struct senml_cbor_in_formatter_data {
+	/* value of the record being written */
+	CborValue value;
+};
+
+static int senml_cbor_buf_write(struct cbor_encoder_writer *writer,
+				const char *data, int len)
+{
+	struct senml_cbor_buf_writer *w;
+
+	w = (struct senml_cbor_buf_writer *)writer;
+	if (buf_append(CPKT_BUF_WRITE(w->out->out_cpkt), (u8_t *)data,
+		       len) < 0) {
+		return CborErrorOutOfMemory;
+	}
+
+	writer->bytes_written += len;
+	return CborNoError;
+}
+
+static uint8_t senml_cbor_buf_get8(struct cbor_decoder_reader *d, int offset)
+{
+	struct senml_cbor_buf_reader *r;
+
+	r = (struct senml_cbor_buf_reader *)d;
+	if (offset < 0 || offset >= d->message_size) {
+		return UINT8_MAX;
+	}
+
+	return r->data[offset];
+}
+
+static uint16_t senml_cbor_buf_get16(struct cbor_decoder_reader *d,
+				     int offset)
+{
+	struct senml_cbor_buf_reader *r;
+	uint16_t val;
+
+	r = (struct senml_cbor_buf_reader *)d;
+	if (offset < 0 || offset > d->message_size - (int)sizeof(val)) {
+		return UINT16_MAX;
+	}
+
+	memcpy(&val, r->data + offset, sizeof(val));
+	return cbor_ntohs(val);
+}
+
+static uint32_t senml_cbor_buf_get32(struct cbor_decoder_reader *d,
+				     int offset)
+{
+	struct senml_cbor_buf_reader *r;
+	uint32_t val;
+
+	r = (struct senml_cbor_buf_reader *)d;
+	if (offset < 0 || offset > d->message_size - (int)sizeof(val)) {
+		return UINT32_MAX;
+	}
+
+	memcpy(&val, r->data + offset, sizeof(val));
+	return cbor_ntohl(val);
+}
+
+static uint64_t senml_cbor_buf_get64(struct cbor_decoder_reader *d,
+				     int offset)
+{
+	struct senml_cbor_buf_reader *r;
+	uint64_t val;
+
+	r = (struct senml_cbor_buf_reader *)d;
+	if (offset < 0 || offset > d->message_size - (int)sizeof(val)) {
+		return UINT64_MAX;
+	}
+
+	memcpy(&val, r->data + offset, sizeof(val));
+	return cbor_ntohll(val);
+}
+
+static uintptr_t senml_cbor_buf_cmp(struct cbor_decoder_reader *d, char *buf,
+				    int offset, size_t len)
+{
+	struct senml_cbor_buf_reader *r;
+
+	r = (struct senml_cbor_buf_reader *)d;
+	if (offset < 0 || offset > d->message_size - (int)len) {
+		return -1;
+	}
+
+	return memcmp(r->data + offset, buf, len);
+}
+
+static uintptr_t senml_cbor_buf_cpy(struct cbor_decoder_reader *d, char *dst,
+				    int offset, size_t len)
+{
+	struct senml_cbor_buf_reader *r;
+
+	r = (struct senml_cbor_buf_reader *)d;
+	if (offset < 0 || offset > d->message_size - (int)len) {
+		return -1;
+	}
+
+	return (uintptr_t)memcpy(dst, r->data + offset, len);
+}
+
+static uintptr_t senml_cbor_buf_get_string_chunk(struct cbor_decoder_reader *d,
+						 int offset, size_t *len)
+{
+	struct senml_cbor_buf_reader *r;
+
+	r = (struct senml_cbor_buf_reader *)d;
+	return (uintptr_t)r->data + offset;
+}
+
+static void senml_cbor_buf_reader_init(struct senml_cbor_buf_reader *r,
+				       struct lwm2m_input_context *in)
+{
+	r->r.get8 = &senml_cbor_buf_get8;
+	r->r.get16 = &senml_cbor_buf_get16;
+	r->r.get32 = &senml_cbor_buf_get32;
+	r->r.get64 = &senml_cbor_buf_get64;
+	r->r.cmp = &senml_cbor_buf_cmp;
+	r->r.cpy = &senml_cbor_buf_cpy;
+	r->r.get_string_chunk = &senml_cbor_buf_get_string_chunk;
+
+	r->data = in->in_cpkt->data + in->offset;
+	r->r.message_size = in->in_cpkt->offset - in->offset;
+}
+
+static size_t put_begin(struct lwm2m_output_context *out,
+			struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	int start;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	if (path->level >= 2U) {
+		snprintk(fd->base_name, sizeof(fd->base_name), "/%u/%u/",
+			 path->obj_id, path->obj_inst_id);
+	} else {
+		snprintk(fd->base_name, sizeof(fd->base_name), "/%u/",
+			 path->obj_id);
+	}
+
+	fd->base_name_sent = false;
+
+	start = fd->writer.enc.bytes_written;
+	if (cbor_encoder_create_array(&fd->encoder, &fd->array,
+				      CborIndefiniteLength) != CborNoError) {
+		/* TODO: Generate error? */
+		return 0;
+	}
+
+	return fd->writer.enc.bytes_written - start;
+}
+
+static size_t put_end(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	int start;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	start = fd->writer.enc.bytes_written;
+	if (cbor_encoder_close_container(&fd->encoder,
+					 &fd->array) != CborNoError) {
+		/* TODO: Generate error? */
+		return 0;
+	}
+
+	return fd->writer.enc.bytes_written - start;
+}
+
+static size_t put_begin_ri(struct lwm2m_output_context *out,
+			   struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags |= WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_end_ri(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags &= ~WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+/* Open the map of a record and encode everything up to the value label */
+static CborError put_record_begin(struct senml_cbor_out_formatter_data *fd,
+				  struct lwm2m_obj_path *path,
+				  CborEncoder *map, int label)
+{
+	char name[NAME_BUF_LEN];
+	CborError err;
+	int len;
+
+	if (fd->path_level >= 2U) {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			len = snprintk(name, sizeof(name), "%u/%u",
+				       path->res_id, path->res_inst_id);
+		} else {
+			len = snprintk(name, sizeof(name), "%u",
+				       path->res_id);
+		}
+	} else {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			len = snprintk(name, sizeof(name), "%u/%u/%u",
+				       path->obj_inst_id, path->res_id,
+				       path->res_inst_id);
+		} else {
+			len = snprintk(name, sizeof(name), "%u/%u",
+				       path->obj_inst_id, path->res_id);
+		}
+	}
+
+	err = cbor_encoder_create_map(&fd->array, map,
+				      fd->base_name_sent ? 2 : 3);
+	if (!fd->base_name_sent) {
+		err |= cbor_encode_int(map, SENML_LABEL_BN);
+		err |= cbor_encode_text_stringz(map, fd->base_name);
+		fd->base_name_sent = true;
+	}
+
+	err |= cbor_encode_int(map, SENML_LABEL_N);
+	err |= cbor_encode_text_string(map, name, len);
+	err |= cbor_encode_int(map, label);
+
+	return err;
+}
+
+static size_t put_record_end(struct senml_cbor_out_formatter_data *fd,
+			     CborEncoder *map, CborError err, int start)
+{
+	err |= cbor_encoder_close_container(&fd->array, map);
+	if (err != CborNoError) {
+		LOG_ERR("SenML-CBOR record encoding failed (%d)", err);
+		return 0;
+	}
+
+	return fd->writer.enc.bytes_written - start;
+}
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s64_t value)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	CborEncoder map;
+	CborError err;
+	int start;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	start = fd->writer.enc.bytes_written;
+	err = put_record_begin(fd, path, &map, SENML_LABEL_V);
+	err |= cbor_encode_int(&map, value);
+
+	return put_record_end(fd, &map, err, start);
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s32_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s16_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, s8_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	CborEncoder map;
+	CborError err;
+	int start;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	start = fd->writer.enc.bytes_written;
+	err = put_record_begin(fd, path, &map, SENML_LABEL_VS);
+	err |= cbor_encode_text_string(&map, buf, buflen);
+
+	return put_record_end(fd, &map, err, start);
+}
+
+static size_t put_double(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 s64_t val1, s64_t val2, s64_t dec_max)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	CborEncoder map;
+	CborError err;
+	int start;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	start = fd->writer.enc.bytes_written;
+	err = put_record_begin(fd, path, &map, SENML_LABEL_V);
+
+	/* whole numbers are shorter as CBOR integers */
+	if (val2 == 0) {
+		err |= cbor_encode_int(&map, val1);
+	} else {
+		err |= cbor_encode_double(&map, (double)val1 +
+					  (double)val2 / dec_max);
+	}
+
+	return put_record_end(fd, &map, err, start);
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	return put_double(out, path, value->val1, value->val2,
+			  LWM2M_FLOAT32_DEC_MAX);
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	return put_double(out, path, value->val1, value->val2,
+			  LWM2M_FLOAT64_DEC_MAX);
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	CborEncoder map;
+	CborError err;
+	int start;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	start = fd->writer.enc.bytes_written;
+	err = put_record_begin(fd, path, &map, SENML_LABEL_VB);
+	err |= cbor_encode_boolean(&map, value);
+
+	return put_record_end(fd, &map, err, start);
+}
+
+static size_t put_opaque(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	CborEncoder map;
+	CborError err;
+	int start;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	start = fd->writer.enc.bytes_written;
+	err = put_record_begin(fd, path, &map, SENML_LABEL_VD);
+	err |= cbor_encode_byte_string(&map, (const u8_t *)buf, buflen);
+
+	return put_record_end(fd, &map, err, start);
+}
+
+static size_t get_s64(struct lwm2m_input_context *in, s64_t *value)
+{
+	struct senml_cbor_in_formatter_data *fd;
+	int64_t tmp;
+	double d;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd) {
+		return 0;
+	}
+
+	if (cbor_value_is_integer(&fd->value)) {
+		if (cbor_value_get_int64(&fd->value, &tmp) != CborNoError) {
+			return 0;
+		}
+
+		*value = tmp;
+	} else if (cbor_value_is_double(&fd->value)) {
+		if (cbor_value_get_double(&fd->value, &d) != CborNoError) {
+			return 0;
+		}
+
+		*value = (s64_t)d;
+	} else {
+		return 0;
+	}
+
+	return sizeof(*value);
+}
+
+static size_t get_s32(struct lwm2m_input_context *in, s32_t *value)
+{
+	s64_t tmp = 0;
+	size_t len;
+
+	len = get_s64(in, &tmp);
+	if (len > 0) {
+		*value = (s32_t)tmp;
+	}
+
+	return len;
+}
+
+static size_t get_double(struct lwm2m_input_context *in,
+			 s64_t *val1, s64_t *val2, s64_t dec_max)
+{
+	struct senml_cbor_in_formatter_data *fd;
+	int64_t tmp;
+	float f;
+	double d;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd) {
+		return 0;
+	}
+
+	if (cbor_value_is_integer(&fd->value)) {
+		if (cbor_value_get_int64(&fd->value, &tmp) != CborNoError) {
+			return 0;
+		}
+
+		*val1 = tmp;
+		*val2 = 0;
+		return sizeof(*val1);
+	}
+
+	if (cbor_value_is_float(&fd->value)) {
+		if (cbor_value_get_float(&fd->value, &f) != CborNoError) {
+			return 0;
+		}
+
+		d = f;
+	} else if (cbor_value_is_double(&fd->value)) {
+		if (cbor_value_get_double(&fd->value, &d) != CborNoError) {
+			return 0;
+		}
+	} else {
+		return 0;
+	}
+
+	/* both parts carry the sign, as the fixed point values do */
+	*val1 = (s64_t)d;
+	*val2 = (s64_t)((d - (double)*val1) * dec_max);
+
+	return sizeof(d);
+}
+
+static size_t get_float32fix(struct lwm2m_input_context *in,
+			     float32_value_t *value)
+{
+	s64_t tmp1, tmp2;
+	size_t len;
+
+	len = get_double(in, &tmp1, &tmp2, LWM2M_FLOAT32_DEC_MAX);
+	if (len > 0) {
+		value->val1 = (s32_t)tmp1;
+		value->val2 = (s32_t)tmp2;
+	}
+
+	return len;
+}
+
+static size_t get_float64fix(struct lwm2m_input_context *in,
+			     float64_value_t *value)
+{
+	s64_t tmp1, tmp2;
+	size_t len;
+
+	len = get_double(in, &tmp1, &tmp2, LWM2M_FLOAT64_DEC_MAX);
+	if (len > 0) {
+		value->val1 = tmp1;
+		value->val2 = tmp2;
+	}
+
+	return len;
+}
+
+static size_t get_string(struct lwm2m_input_context *in,
+			 u8_t *buf, size_t buflen)
+{
+	struct senml_cbor_in_formatter_data *fd;
+	size_t len;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || buflen == 0 || !cbor_value_is_text_string(&fd->value)) {
+		return 0;
+	}
+
+	/* leave room for the terminator */
+	len = buflen - 1;
+	if (cbor_value_copy_text_string(&fd->value, (char *)buf, &len,
+					NULL) != CborNoError) {
+		/* TODO: generate warning? */
+		return 0;
+	}
+
+	buf[len] = '\0';
+	return len;
+}
+
+static size_t get_bool(struct lwm2m_input_context *in, bool *value)
+{
+	struct senml_cbor_in_formatter_data *fd;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || !cbor_value_is_boolean(&fd->value)) {
+		return 0;
+	}
+
+	if (cbor_value_get_boolean(&fd->value, value) != CborNoError) {
+		return 0;
+	}
+
+	return 1;
+}
+
+static size_t get_opaque(struct lwm2m_input_context *in,
+			 u8_t *value, size_t buflen, bool *last_block)
+{
+	struct senml_cbor_in_formatter_data *fd;
+	size_t len = buflen;
+
+	/* the whole value is copied at once */
+	*last_block = true;
+	in->opaque_len = 0U;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || !cbor_value_is_byte_string(&fd->value)) {
+		return 0;
+	}
+
+	if (cbor_value_copy_byte_string(&fd->value, value, &len,
+					NULL) != CborNoError) {
+		return 0;
+	}
+
+	return len;
+}
+
+const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
+	.put_end = put_end,
+	.put_begin_ri = put_begin_ri,
+	.put_end_ri = put_end_ri,
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+	.put_opaque = put_opaque,
+};
+
+const struct lwm2m_reader senml_cbor_reader = {
+	.get_s32 = get_s32,
+	.get_s64 = get_s64,
+	.get_string = get_string,
+	.get_float32fix = get_float32fix,
+	.get_float64fix = get_float64fix,
+	.get_bool = get_bool,
+	.get_opaque = get_opaque,
+};
+
+int do_read_op_senml_cbor(struct lwm2m_message *msg, int content_format)
+{
+	struct senml_cbor_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	fd.writer.enc.write = &senml_cbor_buf_write;
+	fd.writer.out = &msg->out;
+	cbor_encoder_init(&fd.encoder, &fd.writer.enc, 0);
+
+	engine_set_out_user_data(&msg->out, &fd);
+	/* save the level for output processing */
+	fd.path_level = msg->path.level;
+	ret = lwm2m_perform_read_op(msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+static int parse_path(const char *buf, struct lwm2m_obj_path *path)
+{
+	u16_t *ids[] = { &path->obj_id, &path->obj_inst_id,
+			 &path->res_id, &path->res_inst_id };
+	unsigned long val;
+	char *end;
+	int level = 0;
+
+	(void)memset(path, 0, sizeof(*path));
+	while (*buf) {
+		if (*buf == '/') {
+			buf++;
+			continue;
+		}
+
+		if (!isdigit((unsigned char)*buf) || level == ARRAY_SIZE(ids)) {
+			LOG_ERR("Error: illegal path '%s'", log_strdup(buf));
+			return -EINVAL;
+		}
+
+		val = strtoul(buf, &end, 10);
+		if (val > UINT16_MAX || (*end && *end != '/')) {
+			LOG_ERR("Error: illegal path '%s'", log_strdup(buf));
+			return -EINVAL;
+		}
+
+		*ids[level++] = (u16_t)val;
+		buf = end;
+	}
+
+	return level;
+}
+
+/* Look up the resource instance named by msg->path and write the value */
+static int write_record(struct lwm2m_message *msg)
+{
+	struct lwm2m_engine_obj_field *obj_field;
+	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_res *res;
+	struct lwm2m_engine_res_inst *res_inst = NULL;
+	u8_t created = 0U;
+	int ret, index;
+
+	ret = lwm2m_get_or_create_engine_obj(msg, &obj_inst, &created);
+	if (ret < 0) {
+		return ret;
+	}
+
+	obj_field = lwm2m_get_engine_obj_field(obj_inst->obj,
+					       msg->path.res_id);
+	if (!obj_field) {
+		return -ENOENT;
+	}
+
+	if (!LWM2M_HAS_PERM(obj_field, LWM2M_PERM_W)) {
+		return -EPERM;
+	}
+
+	res = lwm2m_get_engine_res(obj_inst, msg->path.res_id);
+	if (!res) {
+		return -ENOENT;
+	}
+
+	for (index = 0; index < res->res_inst_count; index++) {
+		if (res->res_instances[index].res_inst_id ==
+		    msg->path.res_inst_id) {
+			res_inst = &res->res_instances[index];
+			break;
+		}
+	}
+
+	if (!res_inst) {
+		return -ENOENT;
+	}
+
+	return lwm2m_write_handler(obj_inst, res, res_inst, obj_field, msg);
+}
+
+static int copy_name(CborValue *value, char *buf, size_t buflen)
+{
+	size_t len = buflen - 1;
+
+	if (!cbor_value_is_text_string(value) ||
+	    cbor_value_copy_text_string(value, buf, &len, NULL) !=
+	    CborNoError) {
+		return -EINVAL;
+	}
+
+	buf[len] = '\0';
+	return 0;
+}
+
+int do_write_op_senml_cbor(struct lwm2m_message *msg)
+{
+	struct senml_cbor_in_formatter_data fd;
+	struct senml_cbor_buf_reader reader;
+	CborParser parser;
+	CborValue array, record, field;
+	char base_name[BASE_NAME_BUF_LEN] = "";
+	char name[NAME_BUF_LEN];
+	char full_name[BASE_NAME_BUF_LEN + NAME_BUF_LEN];
+	bool has_value;
+	int key, ret = 0;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	senml_cbor_buf_reader_init(&reader, &msg->in);
+
+	if (cbor_parser_init(&reader.r, 0, &parser, &array) != CborNoError ||
+	    !cbor_value_is_array(&array) ||
+	    cbor_value_enter_container(&array, &record) != CborNoError) {
+		LOG_ERR("Error parsing SenML pack!");
+		return -EINVAL;
+	}
+
+	engine_set_in_user_data(&msg->in, &fd);
+
+	while (!cbor_value_at_end(&record)) {
+		if (!cbor_value_is_map(&record) ||
+		    cbor_value_enter_container(&record, &field) !=
+		    CborNoError) {
+			ret = -EINVAL;
+			break;
+		}
+
+		name[0] = '\0';
+		has_value = false;
+
+		while (!cbor_value_at_end(&field)) {
+			if (!cbor_value_is_integer(&field) ||
+			    cbor_value_get_int(&field, &key) != CborNoError ||
+			    cbor_value_advance_fixed(&field) != CborNoError) {
+				ret = -EINVAL;
+				break;
+			}
+
+			switch (key) {
+
+			case SENML_LABEL_BN:
+				ret = copy_name(&field, base_name,
+						sizeof(base_name));
+				break;
+
+			case SENML_LABEL_N:
+				ret = copy_name(&field, name, sizeof(name));
+				break;
+
+			case SENML_LABEL_V:
+			case SENML_LABEL_VS:
+			case SENML_LABEL_VB:
+			case SENML_LABEL_VD:
+				/* the value is decoded by the reader calls */
+				fd.value = field;
+				has_value = true;
+				break;
+
+			default:
+				/* ignore the other fields */
+				break;
+
+			}
+
+			if (ret < 0 ||
+			    cbor_value_advance(&field) != CborNoError) {
+				ret = -EINVAL;
+				break;
+			}
+		}
+
+		if (ret < 0 ||
+		    cbor_value_leave_container(&record, &field) !=
+		    CborNoError) {
+			ret = -EINVAL;
+			break;
+		}
+
+		if (!has_value) {
+			continue;
+		}
+
+		/* combine base_name + name */
+		snprintk(full_name, sizeof(full_name), "%s%s",
+			 base_name, name);
+
+		ret = parse_path(full_name, &msg->path);
+		if (ret < 0) {
+			break;
+		}
+
+		/* if valid, use the return value as level */
+		msg->path.level = ret;
+
+		ret = write_record(msg);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Error parsing SenML record (%d)", ret);
+	}
+
+	engine_clear_in_user_data(&msg->in);
+
+	return ret;
+}
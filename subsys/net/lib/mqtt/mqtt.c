@@ -30,7 +30,6 @@ static void client_reset(struct mqtt_client *client)
 /** @brief Initialize tx buffer. */
 static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 {
-	memset(client->tx_buf, 0, client->tx_buf_size);
 	buf->cur = client->tx_buf;
 	buf->end = client->tx_buf + client->tx_buf_size;
 }
@@ -124,7 +123,8 @@ static int client_read(struct mqtt_client *client)
 {
 	int err_code;
 
-	if (client->internal.remaining_payload > 0) {
+	if (!IS_ENABLED(CONFIG_MQTT_PAYLOAD_EVENTS) &&
+	    client->internal.remaining_payload > 0) {
 		return -EBUSY;
 	}
 
@@ -157,6 +157,190 @@ static int client_write(struct mqtt_client *client, const u8_t *data,
 	return 0;
 }
 
+static int client_write_msg(struct mqtt_client *client,
+			    const struct msghdr *message)
+{
+	int err_code;
+
+	MQTT_TRC("[%p]: Transport writing message.", client);
+
+	err_code = mqtt_transport_write_msg(client, message);
+	if (err_code < 0) {
+		MQTT_TRC("TCP write failed, errno = %d, "
+			 "closing connection", errno);
+		client_disconnect(client, err_code);
+		return err_code;
+	}
+
+	MQTT_TRC("[%p]: Transport write complete.", client);
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+static int inflight_find(const struct mqtt_client *client, u16_t message_id,
+			 u32_t *offset)
+{
+	const struct mqtt_internal *internal = &client->internal;
+	u32_t pos = 0U;
+	int i;
+
+	for (i = 0; i < internal->inflight_count; i++) {
+		if (internal->inflight[i].message_id == message_id) {
+			if (offset != NULL) {
+				*offset = pos;
+			}
+
+			return i;
+		}
+
+		pos += internal->inflight[i].len;
+	}
+
+	return -ENOENT;
+}
+
+/* Replace the packet of an in-flight entry by a packet of new_len bytes,
+ * not longer than the current one, moving the packets stored after it.
+ * A new_len of 0 removes the entry.
+ */
+static u8_t *inflight_resize(struct mqtt_client *client, int idx,
+			     u32_t offset, u32_t new_len)
+{
+	struct mqtt_internal *internal = &client->internal;
+	u32_t old_len = internal->inflight[idx].len;
+	u32_t tail = internal->inflight_buf_used - offset - old_len;
+
+	memmove(client->inflight_buf + offset + new_len,
+		client->inflight_buf + offset + old_len, tail);
+	internal->inflight_buf_used = internal->inflight_buf_used - old_len +
+				      new_len;
+
+	if (new_len == 0U) {
+		internal->inflight_count--;
+		memmove(&internal->inflight[idx], &internal->inflight[idx + 1],
+			(internal->inflight_count - idx) *
+			sizeof(internal->inflight[0]));
+	} else {
+		internal->inflight[idx].len = new_len;
+	}
+
+	return client->inflight_buf + offset;
+}
+
+static int inflight_publish(struct mqtt_client *client,
+			    const struct mqtt_publish_param *param)
+{
+	struct mqtt_internal *internal = &client->internal;
+	u32_t used = internal->inflight_buf_used;
+	struct buf_ctx packet;
+	u32_t header_len;
+	int err_code;
+	int idx;
+
+	if (internal->inflight_count == ARRAY_SIZE(internal->inflight)) {
+		return -EAGAIN;
+	}
+
+	if (inflight_find(client, param->message_id, NULL) >= 0) {
+		return -EALREADY;
+	}
+
+	/* Encode the header straight into the in-flight buffer, and append
+	 * the payload to it, so that the packet goes out with one write and
+	 * can be sent again as is.
+	 */
+	packet.cur = client->inflight_buf + used;
+	packet.end = client->inflight_buf + client->inflight_buf_size;
+
+	err_code = publish_encode(param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	header_len = packet.end - packet.cur;
+	if (header_len + param->message.payload.len >
+	    client->inflight_buf_size - used) {
+		return -ENOMEM;
+	}
+
+	memmove(client->inflight_buf + used, packet.cur, header_len);
+	memcpy(client->inflight_buf + used + header_len,
+	       param->message.payload.data, param->message.payload.len);
+
+	idx = internal->inflight_count++;
+	internal->inflight[idx].message_id = param->message_id;
+	internal->inflight[idx].len = header_len + param->message.payload.len;
+	internal->inflight_buf_used += internal->inflight[idx].len;
+
+	err_code = client_write(client, client->inflight_buf + used,
+				internal->inflight[idx].len);
+	if (err_code < 0) {
+		/* The application gets the error, do not send it again. */
+		(void)mqtt_inflight_remove(client, param->message_id);
+	}
+
+	return err_code;
+}
+
+int mqtt_inflight_remove(struct mqtt_client *client, u16_t message_id)
+{
+	u32_t offset;
+	int idx;
+
+	idx = inflight_find(client, message_id, &offset);
+	if (idx < 0) {
+		return idx;
+	}
+
+	(void)inflight_resize(client, idx, offset, 0U);
+
+	return 0;
+}
+
+int mqtt_inflight_resend(struct mqtt_client *client)
+{
+	struct mqtt_internal *internal = &client->internal;
+	u32_t offset = 0U;
+	u8_t *packet;
+	int err_code;
+	int i;
+
+	if (internal->inflight_count == 0U) {
+		return 0;
+	}
+
+	for (i = 0; i < internal->inflight_count; i++) {
+		packet = client->inflight_buf + offset;
+		if ((*packet & 0xF0) == MQTT_PKT_TYPE_PUBLISH) {
+			*packet |= MQTT_HEADER_DUP_MASK;
+		}
+
+		offset += internal->inflight[i].len;
+	}
+
+	MQTT_TRC("[CID %p]: Resending %d in-flight message(s)", client,
+		 internal->inflight_count);
+
+	err_code = mqtt_transport_write(client, client->inflight_buf,
+					internal->inflight_buf_used);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	internal->last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+void mqtt_inflight_clear(struct mqtt_client *client)
+{
+	client->internal.inflight_count = 0U;
+	client->internal.inflight_buf_used = 0U;
+}
+#endif /* CONFIG_MQTT_INFLIGHT */
+
 void mqtt_client_init(struct mqtt_client *client)
 {
 	NULL_PARAM_CHECK_VOID(client);
@@ -231,6 +415,8 @@ int mqtt_publish(struct mqtt_client *client,
 {
 	int err_code;
 	struct buf_ctx packet;
+	struct iovec io[2];
+	struct msghdr msg;
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -249,22 +435,108 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+	if (param->message.topic.qos && client->inflight_buf != NULL) {
+		err_code = inflight_publish(client, param);
+		goto error;
+	}
+#endif
+
 	err_code = publish_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = client_write(client, packet.cur, packet.end - packet.cur);
+	/* Send the header and the payload with a single write. */
+	io[0].iov_base = packet.cur;
+	io[0].iov_len = packet.end - packet.cur;
+	io[1].iov_base = param->message.payload.data;
+	io[1].iov_len = param->message.payload.len;
+
+	(void)memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io;
+	msg.msg_iovlen = ARRAY_SIZE(io);
+
+	err_code = client_write_msg(client, &msg);
+
+error:
+	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
+			 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_stream(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			mqtt_payload_cb_t cb, void *user_data)
+{
+	int err_code;
+	struct buf_ctx packet;
+	u32_t offset = 0U;
+	u32_t used;
+	u32_t len;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+	NULL_PARAM_CHECK(cb);
+
+	MQTT_TRC("[CID %p]:[State 0x%02x]: >> Topic size 0x%08x, "
+		 "Data size 0x%08x", client, client->internal.state,
+		 param->message.topic.topic.size,
+		 param->message.payload.len);
+
+	mqtt_mutex_lock(client);
+
+	tx_buf_init(client, &packet);
+
+	err_code = verify_tx_state(client);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = client_write(client, param->message.payload.data,
-				param->message.payload.len);
+	err_code = publish_encode(param, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	/* The payload is only counted by the encoder, so the header fits
+	 * even if the payload does not.
+	 */
+	used = packet.end - packet.cur;
+	memmove(client->tx_buf, packet.cur, used);
+
+	/* The first part of the payload goes out with the header. */
+	do {
+		len = MIN(client->tx_buf_size - used,
+			  param->message.payload.len - offset);
+		if (len > 0) {
+			err_code = cb(client, client->tx_buf + used, len,
+				      offset, user_data);
+			if (err_code <= 0 || err_code > len) {
+				MQTT_ERR("[CID %p]: Payload producer failed: %d",
+					 client, err_code);
+				err_code = (err_code < 0) ? err_code : -EIO;
+				client_disconnect(client, err_code);
+				goto error;
+			}
+
+			used += err_code;
+			offset += err_code;
+		}
+
+		err_code = client_write(client, client->tx_buf, used);
+		if (err_code < 0) {
+			goto error;
+		}
+
+		used = 0U;
+	} while (offset < param->message.payload.len);
 
 error:
 	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
-			 client, client->internal.state, err_code);
+		 client, client->internal.state, err_code);
 
 	mqtt_mutex_unlock(client);
 
@@ -350,6 +622,10 @@ int mqtt_publish_qos2_release(struct mqtt_client *client,
 {
 	int err_code;
 	struct buf_ctx packet;
+#if defined(CONFIG_MQTT_INFLIGHT)
+	u32_t offset;
+	int idx;
+#endif
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -371,6 +647,18 @@ int mqtt_publish_qos2_release(struct mqtt_client *client,
 		goto error;
 	}
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+	/* Keep the release instead of the publish until PUBCOMP. */
+	idx = inflight_find(client, param->message_id, &offset);
+	if (idx >= 0) {
+		u32_t len = packet.end - packet.cur;
+		u8_t *stored;
+
+		stored = inflight_resize(client, idx, offset, len);
+		memcpy(stored, packet.cur, len);
+	}
+#endif
+
 	err_code = client_write(client, packet.cur, packet.end - packet.cur);
 
 error:
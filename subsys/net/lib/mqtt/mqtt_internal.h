@@ -392,6 +392,32 @@ int subscribe_ack_decode(struct buf_ctx *buf,
 int unsubscribe_ack_decode(struct buf_ctx *buf,
 			   struct mqtt_unsuback_param *param);
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+/**@brief Drops an in-flight message once it was acknowledged.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] message_id Message id of the acknowledged message.
+ *
+ * @return 0 if the procedure is successful, -ENOENT if the message was not
+ *         in flight.
+ */
+int mqtt_inflight_remove(struct mqtt_client *client, u16_t message_id);
+
+/**@brief Sends all in-flight messages again, publishes with the DUP flag set.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_resend(struct mqtt_client *client);
+
+/**@brief Drops all in-flight messages.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ */
+void mqtt_inflight_clear(struct mqtt_client *client);
+#endif /* CONFIG_MQTT_INFLIGHT */
+
 #ifdef __cplusplus
 }
 #endif
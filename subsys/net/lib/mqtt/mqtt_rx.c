@@ -42,6 +42,17 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+				/* Messages the broker did not acknowledge
+				 * are only known to it if it kept the session.
+				 */
+				if (evt.param.connack.session_present_flag) {
+					err_code = mqtt_inflight_resend(client);
+				} else {
+					mqtt_inflight_clear(client);
+				}
+#endif
 			}
 
 			evt.result = evt.param.connack.return_code;
@@ -75,6 +86,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+		if (err_code == 0) {
+			(void)mqtt_inflight_remove(client,
+						   evt.param.puback.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -99,6 +117,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+		if (err_code == 0) {
+			(void)mqtt_inflight_remove(client,
+						   evt.param.pubcomp.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
@@ -240,6 +265,51 @@ static int mqtt_read_and_parse_fixed_header(struct mqtt_client *client,
 	return err_code;
 }
 
+#if defined(CONFIG_MQTT_PAYLOAD_EVENTS)
+static int mqtt_handle_publish_payload(struct mqtt_client *client)
+{
+	struct mqtt_evt evt;
+	int len;
+
+	/* The whole receive buffer is free while a payload is pending, the
+	 * fixed and variable headers were consumed already.
+	 */
+	while (client->internal.remaining_payload > 0) {
+		len = mqtt_transport_read(client, client->rx_buf,
+					  MIN(client->internal.remaining_payload,
+					      client->rx_buf_size),
+					  false);
+		if (len == -EAGAIN) {
+			return 0;
+		}
+
+		if (len < 0) {
+			MQTT_TRC("[CID %p]: Transport read error: %d", client,
+				 len);
+			return len;
+		}
+
+		if (len == 0) {
+			MQTT_TRC("[CID %p]: Connection closed.", client);
+			return -ENOTCONN;
+		}
+
+		client->internal.remaining_payload -= len;
+
+		evt.type = MQTT_EVT_PUBLISH_PAYLOAD;
+		evt.result = 0;
+		evt.param.payload.data = client->rx_buf;
+		evt.param.payload.len = len;
+		evt.param.payload.remaining =
+					client->internal.remaining_payload;
+
+		event_notify(client, &evt);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_PAYLOAD_EVENTS */
+
 int mqtt_handle_rx(struct mqtt_client *client)
 {
 	int err_code;
@@ -247,6 +317,12 @@ int mqtt_handle_rx(struct mqtt_client *client)
 	u32_t var_length;
 	struct buf_ctx buf;
 
+#if defined(CONFIG_MQTT_PAYLOAD_EVENTS)
+	if (client->internal.remaining_payload > 0) {
+		return mqtt_handle_publish_payload(client);
+	}
+#endif
+
 	buf.cur = client->rx_buf;
 	buf.end = client->rx_buf + client->internal.rx_buf_datalen;
 
@@ -275,5 +351,11 @@ int mqtt_handle_rx(struct mqtt_client *client)
 
 	client->internal.rx_buf_datalen = 0U;
 
+#if defined(CONFIG_MQTT_PAYLOAD_EVENTS)
+	if (client->internal.remaining_payload > 0) {
+		return mqtt_handle_publish_payload(client);
+	}
+#endif
+
 	return 0;
 }
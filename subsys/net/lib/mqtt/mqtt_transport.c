@@ -15,6 +15,8 @@
 extern int mqtt_client_tcp_connect(struct mqtt_client *client);
 extern int mqtt_client_tcp_write(struct mqtt_client *client, const u8_t *data,
 				 u32_t datalen);
+extern int mqtt_client_tcp_write_msg(struct mqtt_client *client,
+				     const struct msghdr *message);
 extern int mqtt_client_tcp_read(struct mqtt_client *client, u8_t *data,
 				u32_t buflen, bool shall_block);
 extern int mqtt_client_tcp_disconnect(struct mqtt_client *client);
@@ -24,6 +26,8 @@ extern int mqtt_client_tcp_disconnect(struct mqtt_client *client);
 extern int mqtt_client_tls_connect(struct mqtt_client *client);
 extern int mqtt_client_tls_write(struct mqtt_client *client, const u8_t *data,
 				 u32_t datalen);
+extern int mqtt_client_tls_write_msg(struct mqtt_client *client,
+				     const struct msghdr *message);
 extern int mqtt_client_tls_read(struct mqtt_client *client, u8_t *data,
 				u32_t buflen, bool shall_block);
 extern int mqtt_client_tls_disconnect(struct mqtt_client *client);
@@ -34,6 +38,7 @@ const struct transport_procedure transport_fn[MQTT_TRANSPORT_NUM] = {
 	{
 		mqtt_client_tcp_connect,
 		mqtt_client_tcp_write,
+		mqtt_client_tcp_write_msg,
 		mqtt_client_tcp_read,
 		mqtt_client_tcp_disconnect,
 	},
@@ -41,6 +46,7 @@ const struct transport_procedure transport_fn[MQTT_TRANSPORT_NUM] = {
 	{
 		mqtt_client_tls_connect,
 		mqtt_client_tls_write,
+		mqtt_client_tls_write_msg,
 		mqtt_client_tls_read,
 		mqtt_client_tls_disconnect,
 	},
@@ -59,6 +65,12 @@ int mqtt_transport_write(struct mqtt_client *client, const u8_t *data,
 							  datalen);
 }
 
+int mqtt_transport_write_msg(struct mqtt_client *client,
+			     const struct msghdr *message)
+{
+	return transport_fn[client->transport.type].write_msg(client, message);
+}
+
 int mqtt_transport_read(struct mqtt_client *client, u8_t *data, u32_t buflen,
 			bool shall_block)
 {
@@ -25,6 +25,10 @@ typedef int (*transport_connect_handler_t)(struct mqtt_client *client);
 typedef int (*transport_write_handler_t)(struct mqtt_client *client,
 					 const u8_t *data, u32_t datalen);
 
+/**@brief Transport write message handler. */
+typedef int (*transport_write_msg_handler_t)(struct mqtt_client *client,
+					     const struct msghdr *message);
+
 /**@brief Transport read handler. */
 typedef int (*transport_read_handler_t)(struct mqtt_client *client, u8_t *data,
 					u32_t buflen, bool shall_block);
@@ -44,6 +48,11 @@ struct transport_procedure {
 	 */
 	transport_write_handler_t write;
 
+	/** Transport write message handler. Handles transport write of
+	 *  scattered data based on type of transport.
+	 */
+	transport_write_msg_handler_t write_msg;
+
 	/** Transport read handler. Handles transport read based on type of
 	 *  transport.
 	 */
@@ -74,6 +83,17 @@ int mqtt_transport_connect(struct mqtt_client *client);
 int mqtt_transport_write(struct mqtt_client *client, const u8_t *data,
 			 u32_t datalen);
 
+/**@brief Handles write requests of scattered data on configured transport.
+ *
+ * @param[in] client Identifies the client on which the procedure is requested.
+ * @param[in] message Data to be written on the transport, as an array of
+ *                    buffers written in a row.
+ *
+ * @retval 0 or an error code indicating reason for failure.
+ */
+int mqtt_transport_write_msg(struct mqtt_client *client,
+			     const struct msghdr *message);
+
 /**@brief Handles read requests on configured transport.
  *
  * @param[in] client Identifies the client on which the procedure is requested.
@@ -93,6 +93,49 @@ int mqtt_client_tcp_write(struct mqtt_client *client, const u8_t *data,
 	return 0;
 }
 
+/**@brief Handles write requests of scattered data on TCP socket transport.
+ *
+ * @param[in] client Identifies the client on which the procedure is requested.
+ * @param[in] message Data to be written on the transport.
+ *
+ * @retval 0 or an error code indicating reason for failure.
+ */
+int mqtt_client_tcp_write_msg(struct mqtt_client *client,
+			      const struct msghdr *message)
+{
+	const struct iovec *iov;
+	size_t offset;
+	int ret, i;
+
+	/* All the buffers go in a single send in the common case. */
+	ret = sendmsg(client->transport.tcp.sock, message, 0);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	offset = ret;
+
+	for (i = 0; i < message->msg_iovlen; i++) {
+		iov = &message->msg_iov[i];
+
+		if (offset >= iov->iov_len) {
+			offset -= iov->iov_len;
+			continue;
+		}
+
+		ret = mqtt_client_tcp_write(client,
+					    (u8_t *)iov->iov_base + offset,
+					    iov->iov_len - offset);
+		if (ret < 0) {
+			return ret;
+		}
+
+		offset = 0;
+	}
+
+	return 0;
+}
+
 /**@brief Handles read requests on TCP socket transport.
  *
  * @param[in] client Identifies the client on which the procedure is requested.
@@ -84,6 +84,15 @@ int mqtt_client_tls_connect(struct mqtt_client *client)
 		}
 	}
 
+	if (tls_config->session_cache == TLS_SESSION_CACHE_ENABLED) {
+		ret = setsockopt(client->transport.tls.sock, SOL_TLS,
+				 TLS_SESSION_CACHE, &tls_config->session_cache,
+				 sizeof(tls_config->session_cache));
+		if (ret < 0) {
+			goto error;
+		}
+	}
+
 	size_t peer_addr_size = sizeof(struct sockaddr_in6);
 
 	if (broker->sa_family == AF_INET) {
@@ -131,6 +140,30 @@ int mqtt_client_tls_write(struct mqtt_client *client, const u8_t *data,
 	return 0;
 }
 
+/**@brief Handles write requests of scattered data on TLS socket transport.
+ *
+ * @param[in] client Identifies the client on which the procedure is requested.
+ * @param[in] message Data to be written on the transport.
+ *
+ * @retval 0 or an error code indicating reason for failure.
+ */
+int mqtt_client_tls_write_msg(struct mqtt_client *client,
+			      const struct msghdr *message)
+{
+	int ret, i;
+
+	/* TLS sockets do not implement sendmsg(). */
+	for (i = 0; i < message->msg_iovlen; i++) {
+		ret = mqtt_client_tls_write(client, message->msg_iov[i].iov_base,
+					    message->msg_iov[i].iov_len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
 /**@brief Handles read requests on TLS socket transport.
  *
  * @param[in] client Identifies the client on which the procedure is requested.
@@ -15,6 +15,10 @@ void otPlatReset(otInstance *aInstance)
 {
 	ARG_UNUSED(aInstance);
 
+#if defined(CONFIG_OPENTHREAD_SETTINGS_NVS)
+	platformSettingsFlush();
+#endif
+
 	/* This function does nothing on the Posix platform. */
 	sys_reboot(SYS_REBOOT_WARM);
 }
@@ -61,6 +61,12 @@ uint16_t platformRadioChannelGet(otInstance *aInstance);
  */
 void platformRandomInit(void);
 
+/**
+ * This function writes back the settings changes that are still
+ * pending to storage.
+ *
+ */
+void platformSettingsFlush(void);
 
 /**
  *  Initialize platform Shell driver.
@@ -39,6 +39,8 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define FCS_SIZE 2
 
+#define PHR_SIZE 1
+
 static otRadioState sState = OT_RADIO_STATE_DISABLED;
 
 static otRadioFrame sTransmitFrame;
@@ -60,6 +62,11 @@ static void dataInit(void)
 	tx_payload = net_pkt_get_reserve_tx_data(K_NO_WAIT);
 	__ASSERT_NO_MSG(tx_payload != NULL);
 
+	/* Leave room for the PHR so that the radio driver can send the
+	 * frame straight from tx_payload.
+	 */
+	net_buf_reserve(tx_payload, PHR_SIZE);
+
 	net_pkt_append_buffer(tx_pkt, tx_payload);
 
 	sTransmitFrame.mPsdu = tx_payload->data;
@@ -102,7 +109,10 @@ void platformRadioProcess(otInstance *aInstance)
 		radio_api->set_channel(radio_dev, sTransmitFrame.mChannel);
 		radio_api->set_txpower(radio_dev, tx_power);
 
-		if (sTransmitFrame.mInfo.mTxInfo.mCsmaCaEnabled) {
+		/* A radio with CSMA-CA support does the CCA as part of tx */
+		if (sTransmitFrame.mInfo.mTxInfo.mCsmaCaEnabled &&
+		    !(radio_api->get_capabilities(radio_dev) &
+		      IEEE802154_HW_CSMA)) {
 			if (radio_api->cca(radio_dev) ||
 			    radio_api->tx(radio_dev, tx_pkt, tx_payload)) {
 				result = OT_ERROR_CHANNEL_ACCESS_FAILURE;
@@ -270,9 +280,16 @@ int8_t otPlatRadioGetRssi(otInstance *aInstance)
 
 otRadioCaps otPlatRadioGetCaps(otInstance *aInstance)
 {
+	otRadioCaps caps = OT_RADIO_CAPS_NONE;
+
 	ARG_UNUSED(aInstance);
 
-	return OT_RADIO_CAPS_NONE;
+	/* Let OpenThread skip its own backoffs, the radio does them */
+	if (radio_api->get_capabilities(radio_dev) & IEEE802154_HW_CSMA) {
+		caps |= OT_RADIO_CAPS_CSMA_BACKOFF;
+	}
+
+	return caps;
 }
 
 bool otPlatRadioGetPromiscuous(otInstance *aInstance)
@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *   This file implements the OpenThread platform abstraction
+ *   for non-volatile storage of settings on top of the Zephyr
+ *   settings subsystem.
+ *
+ *   All values are kept in RAM, grouped by key, and every key is
+ *   stored as one settings item "ot/<key>" holding all its values.
+ *   Changes are written back after CONFIG_OPENTHREAD_SETTINGS_FLUSH_DELAY
+ *   so that bursts of updates, like the frame counters being bumped,
+ *   cost a single write per key.
+ */
+
+#define LOG_LEVEL CONFIG_OPENTHREAD_LOG_LEVEL
+#define LOG_MODULE_NAME net_otPlat_settings
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <kernel.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <settings/settings.h>
+
+#include <openthread/platform/settings.h>
+
+#include "platform-zephyr.h"
+
+#define SETTINGS_ROOT "ot"
+
+/* Highest key that can be stored, keys index the dirty bitmaps */
+#define MAX_KEY 31
+
+struct record_hdr {
+	u16_t key;
+	u16_t len;
+};
+
+/* Sequence of struct record_hdr followed by the value, sorted by key */
+static u8_t arena[CONFIG_OPENTHREAD_SETTINGS_RAM_SIZE];
+static size_t arena_used;
+
+/* Keys which differ from storage, and keys present in storage */
+static u32_t dirty;
+static u32_t stored;
+
+static bool flush_pending;
+static struct k_delayed_work flush_work;
+static K_MUTEX_DEFINE(settings_lock);
+
+static void record_get(size_t offset, struct record_hdr *hdr)
+{
+	memcpy(hdr, &arena[offset], sizeof(*hdr));
+}
+
+static size_t record_size(const struct record_hdr *hdr)
+{
+	return sizeof(*hdr) + hdr->len;
+}
+
+/* Find the [start, end) range of the values of the given key. If there
+ * are none, start == end is where they would be inserted.
+ */
+static void group_find(u16_t key, size_t *start, size_t *end)
+{
+	struct record_hdr hdr;
+	size_t offset = 0;
+
+	while (offset < arena_used) {
+		record_get(offset, &hdr);
+		if (hdr.key >= key) {
+			break;
+		}
+
+		offset += record_size(&hdr);
+	}
+
+	*start = offset;
+
+	while (offset < arena_used) {
+		record_get(offset, &hdr);
+		if (hdr.key != key) {
+			break;
+		}
+
+		offset += record_size(&hdr);
+	}
+
+	*end = offset;
+}
+
+/* Offset of the index-th value of key, or -1 */
+static ssize_t value_find(u16_t key, int index)
+{
+	struct record_hdr hdr;
+	size_t start, end;
+
+	group_find(key, &start, &end);
+
+	while (start < end) {
+		if (index-- == 0) {
+			return start;
+		}
+
+		record_get(start, &hdr);
+		start += record_size(&hdr);
+	}
+
+	return -1;
+}
+
+static void arena_remove(size_t offset, size_t len)
+{
+	memmove(&arena[offset], &arena[offset + len],
+		arena_used - offset - len);
+	arena_used -= len;
+}
+
+static int arena_insert(size_t offset, u16_t key, const u8_t *value,
+			u16_t len)
+{
+	struct record_hdr hdr = {
+		.key = key,
+		.len = len,
+	};
+
+	if (arena_used + record_size(&hdr) > sizeof(arena)) {
+		return -ENOMEM;
+	}
+
+	memmove(&arena[offset + record_size(&hdr)], &arena[offset],
+		arena_used - offset);
+	memcpy(&arena[offset], &hdr, sizeof(hdr));
+	memcpy(&arena[offset + sizeof(hdr)], value, len);
+	arena_used += record_size(&hdr);
+
+	return 0;
+}
+
+static void flush(void)
+{
+	char name[sizeof(SETTINGS_ROOT "/ff")];
+	size_t start, end;
+	int key, ret;
+
+	while (dirty) {
+		key = find_lsb_set(dirty) - 1;
+		dirty &= ~BIT(key);
+
+		snprintf(name, sizeof(name), SETTINGS_ROOT "/%x", key);
+		group_find(key, &start, &end);
+
+		if (start < end) {
+			ret = settings_save_one(name, &arena[start],
+						end - start);
+			if (!ret) {
+				stored |= BIT(key);
+			}
+		} else if (stored & BIT(key)) {
+			ret = settings_delete(name);
+			if (!ret) {
+				stored &= ~BIT(key);
+			}
+		} else {
+			ret = 0;
+		}
+
+		if (ret) {
+			LOG_ERR("Cannot store key %d (%d)", key, ret);
+		}
+	}
+}
+
+static void flush_handler(struct k_work *work)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	flush_pending = false;
+	flush();
+	k_mutex_unlock(&settings_lock);
+}
+
+static void mark_dirty(u16_t key)
+{
+	dirty |= BIT(key);
+
+	/* The timer is not restarted by further changes, so that a steady
+	 * stream of updates is still written back every flush delay.
+	 */
+	if (!flush_pending) {
+		flush_pending = true;
+		k_delayed_work_submit(&flush_work,
+				CONFIG_OPENTHREAD_SETTINGS_FLUSH_DELAY);
+	}
+}
+
+static int settings_load_handler(const char *key, size_t len,
+				 settings_read_cb read_cb, void *cb_arg)
+{
+	struct record_hdr hdr;
+	size_t start, end, offset;
+	unsigned long ot_key;
+	char *last;
+	ssize_t ret;
+
+	ot_key = strtoul(key, &last, 16);
+	if (*last != '\0' || ot_key > MAX_KEY) {
+		return -EINVAL;
+	}
+
+	group_find(ot_key, &start, &end);
+	if (start != end || arena_used + len > sizeof(arena)) {
+		return -ENOMEM;
+	}
+
+	memmove(&arena[start + len], &arena[start], arena_used - start);
+
+	ret = read_cb(cb_arg, &arena[start], len);
+	if (ret != len) {
+		memmove(&arena[start], &arena[start + len],
+			arena_used - start);
+		return ret < 0 ? ret : -EIO;
+	}
+
+	/* Drop what does not parse, there is no partial group to keep */
+	for (offset = start; offset < start + len;
+	     offset += record_size(&hdr)) {
+		if (start + len - offset < sizeof(hdr)) {
+			break;
+		}
+
+		record_get(offset, &hdr);
+		if (hdr.key != ot_key ||
+		    offset + record_size(&hdr) > start + len) {
+			break;
+		}
+	}
+
+	if (offset != start + len) {
+		memmove(&arena[start], &arena[start + len],
+			arena_used - start);
+		LOG_WRN("Dropping corrupted key %lu", ot_key);
+		return -EINVAL;
+	}
+
+	arena_used += len;
+	stored |= BIT(ot_key);
+
+	return 0;
+}
+
+static struct settings_handler ot_settings = {
+	.name = SETTINGS_ROOT,
+	.h_set = settings_load_handler,
+};
+
+void platformSettingsFlush(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	flush();
+	k_mutex_unlock(&settings_lock);
+}
+
+void otPlatSettingsInit(otInstance *aInstance)
+{
+	int ret;
+
+	ARG_UNUSED(aInstance);
+
+	k_delayed_work_init(&flush_work, flush_handler);
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Settings init failed (%d)", ret);
+		return;
+	}
+
+	ret = settings_register(&ot_settings);
+	if (ret) {
+		LOG_ERR("Settings register failed (%d)", ret);
+		return;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	arena_used = 0;
+	dirty = 0U;
+	stored = 0U;
+	(void)settings_load_subtree(SETTINGS_ROOT);
+	k_mutex_unlock(&settings_lock);
+}
+
+otError otPlatSettingsGet(otInstance *aInstance, uint16_t aKey, int aIndex,
+			  uint8_t *aValue, uint16_t *aValueLength)
+{
+	otError error = OT_ERROR_NONE;
+	struct record_hdr hdr;
+	ssize_t offset;
+
+	ARG_UNUSED(aInstance);
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	offset = value_find(aKey, aIndex);
+	if (offset < 0) {
+		error = OT_ERROR_NOT_FOUND;
+		goto out;
+	}
+
+	record_get(offset, &hdr);
+
+	if (aValueLength) {
+		if (aValue) {
+			memcpy(aValue, &arena[offset + sizeof(hdr)],
+			       MIN(*aValueLength, hdr.len));
+		}
+
+		*aValueLength = hdr.len;
+	}
+
+out:
+	k_mutex_unlock(&settings_lock);
+
+	return error;
+}
+
+otError otPlatSettingsSet(otInstance *aInstance, uint16_t aKey,
+			  const uint8_t *aValue, uint16_t aValueLength)
+{
+	otError error = OT_ERROR_NONE;
+	struct record_hdr hdr;
+	size_t start, end;
+
+	ARG_UNUSED(aInstance);
+
+	if (aKey > MAX_KEY) {
+		return OT_ERROR_INVALID_ARGS;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	group_find(aKey, &start, &end);
+
+	/* Rewriting the same value is common, e.g. on every attach */
+	if (start < end) {
+		record_get(start, &hdr);
+		if (start + record_size(&hdr) == end &&
+		    hdr.len == aValueLength &&
+		    !memcmp(&arena[start + sizeof(hdr)], aValue,
+			    aValueLength)) {
+			goto out;
+		}
+	}
+
+	if (arena_used - (end - start) + sizeof(hdr) + aValueLength >
+	    sizeof(arena)) {
+		error = OT_ERROR_NO_BUFS;
+		goto out;
+	}
+
+	arena_remove(start, end - start);
+	(void)arena_insert(start, aKey, aValue, aValueLength);
+	mark_dirty(aKey);
+
+out:
+	k_mutex_unlock(&settings_lock);
+
+	return error;
+}
+
+otError otPlatSettingsAdd(otInstance *aInstance, uint16_t aKey,
+			  const uint8_t *aValue, uint16_t aValueLength)
+{
+	otError error = OT_ERROR_NONE;
+	size_t start, end;
+
+	ARG_UNUSED(aInstance);
+
+	if (aKey > MAX_KEY) {
+		return OT_ERROR_INVALID_ARGS;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	group_find(aKey, &start, &end);
+
+	if (arena_insert(end, aKey, aValue, aValueLength)) {
+		error = OT_ERROR_NO_BUFS;
+	} else {
+		mark_dirty(aKey);
+	}
+
+	k_mutex_unlock(&settings_lock);
+
+	return error;
+}
+
+otError otPlatSettingsDelete(otInstance *aInstance, uint16_t aKey, int aIndex)
+{
+	otError error = OT_ERROR_NONE;
+	struct record_hdr hdr;
+	size_t start, end;
+	ssize_t offset;
+
+	ARG_UNUSED(aInstance);
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (aIndex < 0) {
+		group_find(aKey, &start, &end);
+		if (start == end) {
+			error = OT_ERROR_NOT_FOUND;
+			goto out;
+		}
+
+		arena_remove(start, end - start);
+	} else {
+		offset = value_find(aKey, aIndex);
+		if (offset < 0) {
+			error = OT_ERROR_NOT_FOUND;
+			goto out;
+		}
+
+		record_get(offset, &hdr);
+		arena_remove(offset, record_size(&hdr));
+	}
+
+	mark_dirty(aKey);
+
+out:
+	k_mutex_unlock(&settings_lock);
+
+	return error;
+}
+
+void otPlatSettingsWipe(otInstance *aInstance)
+{
+	ARG_UNUSED(aInstance);
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	arena_used = 0;
+	dirty = stored;
+
+	/* A wipe usually comes right before a reset, don't wait for it */
+	flush();
+
+	k_mutex_unlock(&settings_lock);
+}
@@ -43,11 +43,35 @@ static void sntp_pkt_dump(struct sntp_pkt *pkt)
 	NET_DBG("tx_tm_f:         %x", pkt->tx_tm_f);
 }
 
+static s32_t parse_time(u32_t ts, u32_t fraction, struct sntp_time *time)
+{
+	time->fraction = fraction;
+
+	/* Check if most significant bit is set */
+	if (ts & 0x80000000) {
+		/* UTC time is reckoned from 0h 0m 0s UTC
+		 * on 1 January 1900.
+		 */
+		if (ts >= OFFSET_1970_JAN_1) {
+			time->seconds = ts - OFFSET_1970_JAN_1;
+		} else {
+			return -EINVAL;
+		}
+	} else {
+		/* UTC time is reckoned from 6h 28m 16s UTC
+		 * on 7 February 2036.
+		 */
+		time->seconds = ts + 0x100000000ULL - OFFSET_1970_JAN_1;
+	}
+
+	return 0;
+}
+
 static s32_t parse_response(u8_t *data, u16_t len, u32_t orig_ts,
-			    struct sntp_time *time)
+			    struct sntp_time *rx_time,
+			    struct sntp_time *tx_time)
 {
 	struct sntp_pkt *pkt = (struct sntp_pkt *)data;
-	u32_t ts;
 
 	sntp_pkt_dump(pkt);
 
@@ -76,31 +100,17 @@ static s32_t parse_response(u8_t *data, u16_t len, u32_t orig_ts,
 		return -EINVAL;
 	}
 
-	time->fraction = ntohl(pkt->tx_tm_f);
-	ts = ntohl(pkt->tx_tm_s);
-
-	/* Check if most significant bit is set */
-	if (ts & 0x80000000) {
-		/* UTC time is reckoned from 0h 0m 0s UTC
-		 * on 1 January 1900.
-		 */
-		if (ts >= OFFSET_1970_JAN_1) {
-			time->seconds = ts - OFFSET_1970_JAN_1;
-		} else {
-			return -EINVAL;
-		}
-	} else {
-		/* UTC time is reckoned from 6h 28m 16s UTC
-		 * on 7 February 2036.
-		 */
-		time->seconds = ts + 0x100000000ULL - OFFSET_1970_JAN_1;
+	if (rx_time &&
+	    parse_time(ntohl(pkt->rx_tm_s), ntohl(pkt->rx_tm_f), rx_time)) {
+		return -EINVAL;
 	}
 
-	return 0;
+	return parse_time(ntohl(pkt->tx_tm_s), ntohl(pkt->tx_tm_f), tx_time);
 }
 
 static int sntp_recv_response(struct sntp_ctx *sntp, u32_t timeout,
-			      struct sntp_time *time)
+			      struct sntp_time *rx_time,
+			      struct sntp_time *tx_time)
 {
 	struct sntp_pkt buf = { 0 };
 	int status;
@@ -127,7 +137,7 @@ static int sntp_recv_response(struct sntp_ctx *sntp, u32_t timeout,
 
 	status = parse_response((u8_t *)&buf, sizeof(buf),
 				sntp->expected_orig_ts,
-				time);
+				rx_time, tx_time);
 	return status;
 }
 
@@ -180,11 +190,21 @@ int sntp_request(struct sntp_ctx *ctx, u32_t timeout, u64_t *epoch_time)
 }
 
 int sntp_query(struct sntp_ctx *ctx, u32_t timeout, struct sntp_time *time)
+{
+	if (!time) {
+		return -EFAULT;
+	}
+
+	return sntp_query_times(ctx, timeout, NULL, time);
+}
+
+int sntp_query_times(struct sntp_ctx *ctx, u32_t timeout,
+		     struct sntp_time *rx_time, struct sntp_time *tx_time)
 {
 	struct sntp_pkt tx_pkt = { 0 };
 	int ret = 0;
 
-	if (!ctx || !time) {
+	if (!ctx || !tx_time) {
 		return -EFAULT;
 	}
 
@@ -201,7 +221,7 @@ int sntp_query(struct sntp_ctx *ctx, u32_t timeout, struct sntp_time *time)
 		return ret;
 	}
 
-	return sntp_recv_response(ctx, timeout, time);
+	return sntp_recv_response(ctx, timeout, rx_time, tx_time);
 }
 
 void sntp_close(struct sntp_ctx *ctx)
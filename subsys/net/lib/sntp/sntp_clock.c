@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2019 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_sntp, CONFIG_SNTP_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+
+#include <net/sntp.h>
+#include <net/socketutils.h>
+#include <posix/time.h>
+#include <posix/sys/time.h>
+
+/* 123 is the standard SNTP port per RFC4330 */
+#define SNTP_PORT "123"
+
+#define MAX_SERVERS 4
+
+/* Servers rate limit their clients, do not query them back to back */
+#define SAMPLE_INTERVAL K_SECONDS(2)
+#define RETRY_INTERVAL K_SECONDS(10)
+
+static K_MUTEX_DEFINE(sync_lock);
+static bool synced;
+
+static s64_t timespec_nsecs(const struct timespec *ts)
+{
+	return (s64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+static s64_t sntp_time_nsecs(const struct sntp_time *time)
+{
+	return (s64_t)time->seconds * NSEC_PER_SEC +
+	       (s64_t)(((u64_t)time->fraction * NSEC_PER_SEC) >> 32);
+}
+
+/* Query a server CONFIG_SNTP_CLOCK_SAMPLES times, giving the offset of the
+ * sample of lowest round trip delay: the one least affected by queueing on
+ * the way, like the clock filter of NTP.
+ */
+static int query_server(const char *server, s64_t *offset)
+{
+	struct addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_DGRAM,
+	};
+	s64_t max_delay = (s64_t)CONFIG_SNTP_CLOCK_MAX_DELAY * NSEC_PER_USEC *
+			  USEC_PER_MSEC;
+	s64_t best_delay = max_delay;
+	struct addrinfo *addr;
+	struct sntp_ctx ctx;
+	int res, i;
+
+	res = net_getaddrinfo_addr_str(server, SNTP_PORT, &hints, &addr);
+	if (res < 0) {
+		NET_DBG("Cannot resolve %s (%d)", log_strdup(server), res);
+		return -EHOSTUNREACH;
+	}
+
+	res = sntp_init(&ctx, addr->ai_addr, addr->ai_addrlen);
+	freeaddrinfo(addr);
+	if (res < 0) {
+		return res;
+	}
+
+	res = -ENOENT;
+
+	for (i = 0; i < CONFIG_SNTP_CLOCK_SAMPLES; i++) {
+		struct sntp_time rx_time, tx_time;
+		struct timespec t1, t4;
+		s64_t t2, t3, delay;
+		int err;
+
+		if (i) {
+			k_sleep(SAMPLE_INTERVAL);
+		}
+
+		clock_gettime(CLOCK_REALTIME, &t1);
+		err = sntp_query_times(&ctx, CONFIG_SNTP_CLOCK_TIMEOUT,
+				       &rx_time, &tx_time);
+		clock_gettime(CLOCK_REALTIME, &t4);
+		if (err < 0) {
+			/* A late response would be taken for the one of a
+			 * next query, and a kiss-o'-death asks to stop.
+			 */
+			NET_DBG("%s: query failed (%d)", log_strdup(server),
+				err);
+			break;
+		}
+
+		t2 = sntp_time_nsecs(&rx_time);
+		t3 = sntp_time_nsecs(&tx_time);
+
+		delay = (timespec_nsecs(&t4) - timespec_nsecs(&t1)) - (t3 - t2);
+		if (delay > best_delay) {
+			continue;
+		}
+
+		best_delay = delay;
+		*offset = ((t2 - timespec_nsecs(&t1)) +
+			   (t3 - timespec_nsecs(&t4))) / 2;
+		res = 0;
+	}
+
+	sntp_close(&ctx);
+
+	if (res == 0) {
+		NET_DBG("%s: delay %d us", log_strdup(server),
+			(s32_t)(best_delay / NSEC_PER_USEC));
+	}
+
+	return res;
+}
+
+static void clock_correct(s64_t offset)
+{
+	s64_t step_threshold = (s64_t)CONFIG_SNTP_CLOCK_STEP_THRESHOLD *
+			       NSEC_PER_USEC * USEC_PER_MSEC;
+	s64_t usecs = offset / NSEC_PER_USEC;
+	struct timespec ts;
+	struct timeval delta;
+
+	if (!synced || offset > step_threshold || offset < -step_threshold) {
+		clock_gettime(CLOCK_REALTIME, &ts);
+		offset += timespec_nsecs(&ts);
+		ts.tv_sec = offset / NSEC_PER_SEC;
+		ts.tv_nsec = offset % NSEC_PER_SEC;
+		clock_settime(CLOCK_REALTIME, &ts);
+
+		NET_INFO("Clock set to %u s", (u32_t)ts.tv_sec);
+		return;
+	}
+
+	delta.tv_sec = usecs / USEC_PER_SEC;
+	delta.tv_usec = usecs % USEC_PER_SEC;
+	adjtime(&delta, NULL);
+
+	NET_DBG("Clock slewed by %d us", (s32_t)usecs);
+}
+
+int sntp_clock_sync(void)
+{
+	char servers[] = CONFIG_SNTP_CLOCK_SERVERS;
+	s64_t offsets[MAX_SERVERS];
+	char *server = servers;
+	int count = 0;
+	int i;
+
+	k_mutex_lock(&sync_lock, K_FOREVER);
+
+	while (*server && count < MAX_SERVERS) {
+		char *end = strchr(server, ' ');
+		s64_t offset;
+
+		if (end) {
+			*end = '\0';
+		}
+
+		if (*server && query_server(server, &offset) == 0) {
+			/* Keep the offsets sorted for the median */
+			for (i = count; i > 0 && offsets[i - 1] > offset; i--) {
+				offsets[i] = offsets[i - 1];
+			}
+			offsets[i] = offset;
+			count++;
+		}
+
+		if (!end) {
+			break;
+		}
+
+		server = end + 1;
+	}
+
+	if (!count) {
+		k_mutex_unlock(&sync_lock);
+		NET_WARN("No SNTP server answered");
+		return -ENOENT;
+	}
+
+	/* The median is not thrown off by a server giving a wrong time */
+	clock_correct(offsets[count / 2]);
+	synced = true;
+
+	k_mutex_unlock(&sync_lock);
+
+	return 0;
+}
+
+bool sntp_clock_is_synced(void)
+{
+	return synced;
+}
+
+static void sntp_clock_thread(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		if (sntp_clock_sync() == 0) {
+			k_sleep(K_SECONDS(CONFIG_SNTP_CLOCK_INTERVAL));
+		} else {
+			k_sleep(RETRY_INTERVAL);
+		}
+	}
+}
+
+K_THREAD_DEFINE(sntp_clock, CONFIG_SNTP_CLOCK_STACK_SIZE, sntp_clock_thread,
+		NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0,
+		K_NO_WAIT);
@@ -7,6 +7,7 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(net_socket_offload, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
+#include <errno.h>
 #include <net/socket_offload.h>
 
 /* Only one provider may register socket operations upon boot. */
@@ -20,6 +21,32 @@ void socket_offload_register(const struct socket_offload *ops)
 	socket_ops = ops;
 }
 
+ssize_t sendmsg(int sock, const struct msghdr *message, int flags)
+{
+	const struct iovec *iov = message->msg_iov;
+
+	__ASSERT_NO_MSG(socket_ops);
+
+	if (socket_ops->sendmsg) {
+		return socket_ops->sendmsg(sock, message, flags);
+	}
+
+	/* Without a provider implementation, the buffers can't be sent as
+	 * one message unless there is only one of them.
+	 */
+	if (message->msg_iovlen != 1) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (message->msg_name == NULL) {
+		return send(sock, iov->iov_base, iov->iov_len, flags);
+	}
+
+	return sendto(sock, iov->iov_base, iov->iov_len, flags,
+		      message->msg_name, message->msg_namelen);
+}
+
 int fcntl(int fd, int cmd, ...)
 {
 	__ASSERT_NO_MSG(socket_ops);
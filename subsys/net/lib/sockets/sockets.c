@@ -22,6 +22,12 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include "sockets_internal.h"
 
+#if defined(CONFIG_NET_STATISTICS_LATENCY)
+#include "net_stats.h"
+#else
+#define net_stats_update_rx_stage(pkt, stage)
+#endif
+
 #define SET_ERRNO(x) \
 	{ int _err = x; if (_err < 0) { errno = -_err; return -1; } }
 
@@ -29,7 +35,11 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 	do { \
 		const struct socket_op_vtable *vtable; \
 		void *ctx = get_sock_vtable(sock, &vtable); \
-		if (ctx == NULL || vtable->fn == NULL) { \
+		if (ctx == NULL) { \
+			return -1; \
+		} \
+		if (vtable->fn == NULL) { \
+			errno = EOPNOTSUPP; \
 			return -1; \
 		} \
 		return vtable->fn(ctx, __VA_ARGS__); \
@@ -104,6 +114,10 @@ int zsock_socket_internal(int family, int type, int proto)
 	/* recv_q and accept_q are in union */
 	k_fifo_init(&ctx->recv_q);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	sys_slist_init(&ctx->epoll_entries);
+#endif
+
 #ifdef CONFIG_USERSPACE
 	/* Set net context object as initialized and grant access to the
 	 * calling thread (and only the calling thread)
@@ -175,6 +189,7 @@ int zsock_close_ctx(struct net_context *ctx)
 		(void)net_context_recv(ctx, NULL, K_NO_WAIT, NULL);
 	}
 
+	zsock_epoll_forget(ctx);
 	zsock_flush_queue(ctx);
 
 	SET_ERRNO(net_context_put(ctx));
@@ -238,8 +253,12 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		(void)net_context_recv(new_ctx, zsock_received_cb, K_NO_WAIT,
 				       NULL);
 		k_fifo_init(&new_ctx->recv_q);
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+		sys_slist_init(&new_ctx->epoll_entries);
+#endif
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		zsock_epoll_notify(parent);
 	}
 }
 
@@ -264,6 +283,7 @@ static void zsock_received_cb(struct net_context *ctx,
 			 */
 			sock_set_eof(ctx);
 			k_fifo_cancel_wait(&ctx->recv_q);
+			zsock_epoll_notify(ctx);
 			NET_DBG("Marked socket %p as peer-closed", ctx);
 		} else {
 			net_pkt_set_eof(last_pkt, true);
@@ -279,7 +299,10 @@ static void zsock_received_cb(struct net_context *ctx,
 		net_context_update_recv_wnd(ctx, -net_pkt_remaining_data(pkt));
 	}
 
+	net_stats_update_rx_stage(pkt, NET_STATS_RX_CONN);
+
 	k_fifo_put(&ctx->recv_q, pkt);
+	zsock_epoll_notify(ctx);
 }
 
 int zsock_bind_ctx(struct net_context *ctx, const struct sockaddr *addr,
@@ -547,6 +570,9 @@ Z_SYSCALL_HANDLER(zsock_sendmsg, sock, msg, flags)
 {
 	/* TODO: Create a copy of msg_buf and copy the data there */
 
+	/* User memory can't be lent to the stack, send a copy instead */
+	flags &= ~ZSOCK_MSG_ZEROCOPY;
+
 	return z_impl_zsock_sendmsg(sock, (const struct msghdr *)msg, flags);
 }
 #endif /* CONFIG_USERSPACE */
@@ -652,22 +678,14 @@ error:
 	return ret;
 }
 
-static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+/* Take the next datagram from the receive queue, or only get a reference
+ * to it with MSG_PEEK. Sets errno if there is none.
+ */
+static struct net_pkt *dgram_pkt_get(struct net_context *ctx, int flags,
+				     s32_t timeout)
 {
-	s32_t timeout = K_FOREVER;
-	size_t recv_len = 0;
-	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
 
-	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
-		timeout = K_NO_WAIT;
-	}
-
 	if (flags & ZSOCK_MSG_PEEK) {
 		int res;
 
@@ -675,7 +693,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		/* EAGAIN when timeout expired, EINTR when cancelled */
 		if (res && res != -EAGAIN && res != -EINTR) {
 			errno = -res;
-			return -1;
+			return NULL;
 		}
 
 		pkt = k_fifo_peek_head(&ctx->recv_q);
@@ -685,6 +703,56 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	if (!pkt) {
 		errno = EAGAIN;
+	} else if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_stats_update_rx_stage(pkt, NET_STATS_RX_SOCKET);
+	}
+
+	return pkt;
+}
+
+static int dgram_src_addr_get(struct net_context *ctx, struct net_pkt *pkt,
+			      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int rv;
+
+	rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+				   src_addr, *addrlen);
+	if (rv < 0) {
+		return rv;
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       void *buf,
+				       size_t max_len,
+				       int flags,
+				       struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	s32_t timeout = K_FOREVER;
+	size_t recv_len = 0;
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	pkt = dgram_pkt_get(ctx, flags, timeout);
+	if (!pkt) {
 		return -1;
 	}
 
@@ -693,24 +761,11 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	if (src_addr && addrlen) {
 		int rv;
 
-		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-					   src_addr, *addrlen);
+		rv = dgram_src_addr_get(ctx, pkt, src_addr, addrlen);
 		if (rv < 0) {
 			errno = -rv;
 			return -1;
 		}
-
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
-			return -1;
-		}
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
@@ -724,6 +779,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	}
 
 	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_stats_update_rx_stage(pkt, NET_STATS_RX_APP);
 		net_pkt_unref(pkt);
 	} else {
 		net_pkt_cursor_restore(pkt, &backup);
@@ -800,6 +856,8 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 				 * the fifo. Drop it from there.
 				 */
 				k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+				net_stats_update_rx_stage(pkt,
+							  NET_STATS_RX_SOCKET);
 				if (net_pkt_eof(pkt)) {
 					sock_set_eof(ctx);
 				}
@@ -874,6 +932,421 @@ Z_SYSCALL_HANDLER(zsock_recvfrom, sock, buf, max_len, flags, src_addr,
 }
 #endif /* CONFIG_USERSPACE */
 
+static void dgram_cmsg_put(struct msghdr *msg, size_t *used, int level,
+			   int type, const void *data, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	if (*used + CMSG_SPACE(len) > msg->msg_controllen) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		return;
+	}
+
+	cmsg = (struct cmsghdr *)((u8_t *)msg->msg_control + *used);
+	cmsg->cmsg_len = CMSG_LEN(len);
+	cmsg->cmsg_level = level;
+	cmsg->cmsg_type = type;
+	memcpy(CMSG_DATA(cmsg), data, len);
+
+	*used += CMSG_SPACE(len);
+}
+
+/* Fill msg_control with the ancillary data of a datagram */
+static void dgram_cmsgs_put(struct net_pkt *pkt, struct msghdr *msg)
+{
+	int ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+	struct net_pkt_cursor backup;
+	size_t used = 0;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+		struct in_pktinfo info;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (ipv4_hdr) {
+			info.ipi_ifindex = ifindex;
+			net_ipaddr_copy(&info.ipi_spec_dst, &ipv4_hdr->dst);
+			net_ipaddr_copy(&info.ipi_addr, &ipv4_hdr->dst);
+			dgram_cmsg_put(msg, &used, IPPROTO_IP, IP_PKTINFO,
+				       &info, sizeof(info));
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+		struct in6_pktinfo info;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (ipv6_hdr) {
+			net_ipaddr_copy(&info.ipi6_addr, &ipv6_hdr->dst);
+			info.ipi6_ifindex = ifindex;
+			dgram_cmsg_put(msg, &used, IPPROTO_IPV6, IPV6_PKTINFO,
+				       &info, sizeof(info));
+		}
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP)
+	dgram_cmsg_put(msg, &used, SOL_SOCKET, SCM_TIMESTAMPING,
+		       net_pkt_timestamp(pkt), sizeof(struct net_ptp_time));
+#endif
+
+	msg->msg_controllen = used;
+}
+
+/* Scatter one datagram into msg, then release it unless MSG_PEEK */
+static ssize_t dgram_recvmsg(struct net_context *ctx, struct net_pkt *pkt,
+			     struct msghdr *msg, int flags)
+{
+	struct net_pkt_cursor backup;
+	ssize_t recv_len = 0;
+	int ret = 0;
+	size_t i;
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	msg->msg_flags = 0;
+
+	if (msg->msg_name) {
+		ret = dgram_src_addr_get(ctx, pkt, msg->msg_name,
+					 &msg->msg_namelen);
+		if (ret < 0) {
+			goto out;
+		}
+	}
+
+	if (msg->msg_control) {
+		dgram_cmsgs_put(pkt, msg);
+	} else {
+		msg->msg_controllen = 0;
+	}
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		size_t len = MIN(net_pkt_remaining_data(pkt),
+				 msg->msg_iov[i].iov_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		recv_len += len;
+	}
+
+	if (net_pkt_remaining_data(pkt)) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+out:
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_stats_update_rx_stage(pkt, NET_STATS_RX_APP);
+		net_pkt_unref(pkt);
+	} else {
+		net_pkt_cursor_restore(pkt, &backup);
+	}
+
+	return ret < 0 ? ret : recv_len;
+}
+
+static ssize_t stream_recvmsg(struct net_context *ctx, struct msghdr *msg,
+			      int flags)
+{
+	ssize_t recv_len = 0;
+	size_t i;
+
+	msg->msg_namelen = 0;
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		ssize_t len;
+
+		len = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base,
+					msg->msg_iov[i].iov_len, flags);
+		if (len < 0) {
+			return recv_len > 0 ? recv_len : -1;
+		}
+
+		recv_len += len;
+
+		/* Only wait for the first data, and peeking again would
+		 * return the same data
+		 */
+		if ((size_t)len < msg->msg_iov[i].iov_len ||
+		    (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return recv_len;
+}
+
+BUILD_ASSERT(SOF_TIMESTAMPING_TX_HARDWARE == NET_CONTEXT_TIMESTAMP_TX_HW);
+
+/* Read a TX timestamp, like a Linux socket error queue */
+static ssize_t errqueue_recvmsg(struct net_context *ctx, struct msghdr *msg)
+{
+	struct net_ptp_time ts;
+	size_t used = 0;
+	int ret;
+
+	ret = net_context_get_tx_timestamp(ctx, &ts);
+	if (ret < 0) {
+		errno = ret == -ENOTSUP ? EOPNOTSUPP : -ret;
+		return -1;
+	}
+
+	msg->msg_namelen = 0;
+	msg->msg_flags = ZSOCK_MSG_ERRQUEUE;
+
+	if (msg->msg_control) {
+		dgram_cmsg_put(msg, &used, SOL_SOCKET, SCM_TIMESTAMPING,
+			       &ts, sizeof(ts));
+	}
+
+	msg->msg_controllen = used;
+
+	return 0;
+}
+
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	s32_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	ssize_t ret;
+
+	if (flags & ZSOCK_MSG_ERRQUEUE) {
+		return errqueue_recvmsg(ctx, msg);
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		return stream_recvmsg(ctx, msg, flags);
+	}
+
+	__ASSERT(sock_type == SOCK_DGRAM, "Unknown socket type");
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	pkt = dgram_pkt_get(ctx, flags, timeout);
+	if (!pkt) {
+		return -1;
+	}
+
+	ret = dgram_recvmsg(ctx, pkt, msg, flags);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return ret;
+}
+
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	VTABLE_CALL(recvmsg, sock, msg, flags);
+}
+
+int zsock_recvmmsg_ctx(struct net_context *ctx, struct zsock_mmsghdr *msgvec,
+		       unsigned int vlen, int flags)
+{
+	s32_t timeout = K_FOREVER;
+	unsigned int i;
+
+	if (net_context_get_type(ctx) != SOCK_DGRAM ||
+	    (flags & ZSOCK_MSG_PEEK)) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (vlen == 0U) {
+		return 0;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	/* Only the first datagram is waited for, the rest of the batch is
+	 * whatever is already queued.
+	 */
+	for (i = 0U; i < vlen; i++) {
+		struct net_pkt *pkt;
+		ssize_t ret;
+
+		pkt = dgram_pkt_get(ctx, flags, i == 0U ? timeout : K_NO_WAIT);
+		if (!pkt) {
+			break;
+		}
+
+		ret = dgram_recvmsg(ctx, pkt, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			if (i == 0U) {
+				errno = -ret;
+				return -1;
+			}
+
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	return i > 0U ? i : -1;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	VTABLE_CALL(recvmmsg, sock, msgvec, vlen, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+#define RECVMMSG_USER_MAX 32
+
+/* Copy a user msghdr and its iovec array to the kernel, checking that
+ * all the memory it points to can be written by the caller. On success
+ * kmsg->msg_iov has to be released with k_free().
+ */
+static int user_msghdr_copy(struct msghdr *kmsg, const struct msghdr *umsg)
+{
+	struct iovec *iov = NULL;
+	size_t iov_size;
+	size_t i;
+
+	if (z_user_from_copy(kmsg, umsg, sizeof(*kmsg))) {
+		return -EFAULT;
+	}
+
+	if ((kmsg->msg_name &&
+	     Z_SYSCALL_MEMORY_WRITE(kmsg->msg_name, kmsg->msg_namelen)) ||
+	    (kmsg->msg_control &&
+	     Z_SYSCALL_MEMORY_WRITE(kmsg->msg_control,
+				    kmsg->msg_controllen))) {
+		return -EFAULT;
+	}
+
+	if (size_mul_overflow(kmsg->msg_iovlen, sizeof(struct iovec),
+			      &iov_size)) {
+		return -EFAULT;
+	}
+
+	if (iov_size) {
+		iov = z_user_alloc_from_copy(kmsg->msg_iov, iov_size);
+		if (!iov) {
+			return -EFAULT;
+		}
+	}
+
+	for (i = 0; i < kmsg->msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY_WRITE(iov[i].iov_base, iov[i].iov_len)) {
+			k_free(iov);
+			return -EFAULT;
+		}
+	}
+
+	kmsg->msg_iov = iov;
+
+	return 0;
+}
+
+/* Update the output fields of a user msghdr */
+static int user_msghdr_update(struct msghdr *umsg, const struct msghdr *kmsg)
+{
+	return z_user_to_copy(&umsg->msg_namelen, &kmsg->msg_namelen,
+			      sizeof(kmsg->msg_namelen)) ||
+	       z_user_to_copy(&umsg->msg_controllen,
+			      &kmsg->msg_controllen,
+			      sizeof(kmsg->msg_controllen)) ||
+	       z_user_to_copy(&umsg->msg_flags, &kmsg->msg_flags,
+			      sizeof(kmsg->msg_flags));
+}
+
+Z_SYSCALL_HANDLER(zsock_recvmsg, sock, msg, flags)
+{
+	struct msghdr *umsg = (struct msghdr *)msg;
+	struct msghdr kmsg;
+	ssize_t ret;
+
+	Z_OOPS(user_msghdr_copy(&kmsg, umsg));
+
+	ret = z_impl_zsock_recvmsg(sock, &kmsg, flags);
+
+	k_free(kmsg.msg_iov);
+
+	if (ret >= 0) {
+		Z_OOPS(user_msghdr_update(umsg, &kmsg));
+	}
+
+	return ret;
+}
+
+Z_SYSCALL_HANDLER(zsock_recvmmsg, sock, msgvec, vlen, flags)
+{
+	struct zsock_mmsghdr *umsgvec = (struct zsock_mmsghdr *)msgvec;
+	struct zsock_mmsghdr *kmsgvec;
+	unsigned int i, n;
+	bool fault = false;
+	int ret = 0;
+
+	vlen = MIN(vlen, RECVMMSG_USER_MAX);
+	if (vlen == 0U) {
+		return 0;
+	}
+
+	kmsgvec = z_thread_malloc(vlen * sizeof(*kmsgvec));
+	if (!kmsgvec) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (n = 0U; n < vlen; n++) {
+		if (user_msghdr_copy(&kmsgvec[n].msg_hdr,
+				     &umsgvec[n].msg_hdr)) {
+			fault = true;
+			break;
+		}
+	}
+
+	if (!fault) {
+		ret = z_impl_zsock_recvmmsg(sock, kmsgvec, vlen, flags);
+	}
+
+	for (i = 0U; i < n; i++) {
+		if (!fault && ret > 0 && i < ret) {
+			fault = user_msghdr_update(&umsgvec[i].msg_hdr,
+						   &kmsgvec[i].msg_hdr) ||
+				z_user_to_copy(&umsgvec[i].msg_len,
+					       &kmsgvec[i].msg_len,
+					       sizeof(kmsgvec[i].msg_len));
+		}
+
+		k_free(kmsgvec[i].msg_hdr.msg_iov);
+	}
+
+	k_free(kmsgvec);
+
+	Z_OOPS(fault);
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -961,6 +1434,8 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 	int i, remaining_time;
 	struct zsock_pollfd *pfd;
 	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
+	struct k_poll_event *ready[CONFIG_NET_SOCKETS_POLL_MAX];
+	struct k_poll_set poll_set;
 	struct k_poll_event *pev;
 	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
 	const struct fd_op_vtable *vtable;
@@ -1005,12 +1480,19 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 
 	remaining_time = timeout;
 
+	/* Keep the registrations across retries: a retry only re-registers
+	 * the events that fired, instead of the whole set.
+	 */
+	k_poll_set_init(&poll_set, poll_events, pev - poll_events);
+
 	do {
-		ret = k_poll(poll_events, pev - poll_events, remaining_time);
+		ret = k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      remaining_time);
 		/* EAGAIN when timeout expired, EINTR when cancelled (i.e. EOF) */
-		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
+		if (ret < 0 && ret != -EAGAIN && ret != -EINTR) {
 			errno = -ret;
-			return -1;
+			ret = -1;
+			goto out;
 		}
 
 		retry = false;
@@ -1040,7 +1522,8 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 					continue;
 				}
 
-				return -1;
+				ret = -1;
+				goto out;
 			}
 
 			if (pfd->revents != 0) {
@@ -1067,6 +1550,9 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 		}
 	} while (retry);
 
+out:
+	k_poll_set_cleanup(&poll_set);
+
 	return ret;
 }
 
@@ -1260,6 +1746,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_ZEROCOPY,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_SOCKS5:
 			if (IS_ENABLED(CONFIG_SOCKS)) {
 				ret = net_context_set_option(ctx,
@@ -1317,6 +1818,12 @@ Z_SYSCALL_HANDLER(zsock_setsockopt, sock, level, optname, optval, optlen)
 	void *kernel_optval;
 	int ret;
 
+	/* The completion callback would be called in supervisor mode */
+	if (level == SOL_SOCKET && optname == SO_ZEROCOPY) {
+		errno = EPERM;
+		return -1;
+	}
+
 	kernel_optval = z_user_alloc_from_copy((const void *)optval, optlen);
 	Z_OOPS(!kernel_optval);
 
@@ -1546,6 +2053,17 @@ static int sock_setsockopt_vmeth(void *obj, int level, int optname,
 	return zsock_setsockopt_ctx(obj, level, optname, optval, optlen);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
+static int sock_recvmmsg_vmeth(void *obj, struct zsock_mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg_ctx(obj, msgvec, vlen, flags);
+}
+
 
 const struct socket_op_vtable sock_fd_op_vtable = {
 	.fd_vtable = {
@@ -1562,4 +2080,6 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
+	.recvmmsg = sock_recvmmsg_vmeth,
 };
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2019 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Socket data buffers shared with user mode
+ *
+ * Each memory domain gets its own pool of buffers, whose data lives in a
+ * partition only that domain is given, so that the threads of a domain
+ * can't access the buffers of the other domains. The system calls taking
+ * a buffer only check that it is an allocated buffer of the pool of the
+ * domain of the caller, where the regular socket calls validate every byte
+ * of the user data they are given.
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <net/socket.h>
+#include <syscall_handler.h>
+
+/* Attached pools, pools are never detached */
+static sys_slist_t pools = SYS_SLIST_STATIC_INIT(&pools);
+
+static struct k_spinlock lock;
+
+static struct zsock_buf_pool *current_pool(void)
+{
+	struct k_mem_domain *domain =
+		k_current_get()->mem_domain_info.mem_domain;
+	struct zsock_buf_pool *pool;
+
+	if (domain == NULL) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&pools, pool, node) {
+		if (pool->domain == domain) {
+			return pool;
+		}
+	}
+
+	return NULL;
+}
+
+/* Index of an allocated buffer of the pool, or -1 */
+static int buf_index(struct zsock_buf_pool *pool, const void *buf)
+{
+	uintptr_t offset;
+	int i;
+
+	if (pool == NULL || (uintptr_t)buf < (uintptr_t)pool->data) {
+		return -1;
+	}
+
+	offset = (uintptr_t)buf - (uintptr_t)pool->data;
+	if (offset % ZSOCK_BUF_SIZE != 0U) {
+		return -1;
+	}
+
+	i = offset / ZSOCK_BUF_SIZE;
+	if (i >= ZSOCK_BUF_COUNT || !pool->in_use[i]) {
+		return -1;
+	}
+
+	return i;
+}
+
+static bool buf_is_owned(const void *buf)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool owned = buf_index(current_pool(), buf) >= 0;
+
+	k_spin_unlock(&lock, key);
+
+	return owned;
+}
+
+void zsock_buf_pool_attach(struct zsock_buf_pool *pool,
+			   struct k_mem_domain *domain)
+{
+	struct zsock_buf_pool *other;
+	k_spinlock_key_t key;
+
+	k_mem_domain_add_partition(domain, pool->partition);
+
+	key = k_spin_lock(&lock);
+
+	__ASSERT(pool->domain == NULL, "pool %p already attached", pool);
+	SYS_SLIST_FOR_EACH_CONTAINER(&pools, other, node) {
+		__ASSERT(other->domain != domain, "domain %p has a pool",
+			 domain);
+	}
+
+	pool->domain = domain;
+	sys_slist_append(&pools, &pool->node);
+
+	k_spin_unlock(&lock, key);
+}
+
+void *z_impl_zsock_buf_alloc(s32_t timeout)
+{
+	struct zsock_buf_pool *pool;
+	k_spinlock_key_t key;
+	int i;
+
+	key = k_spin_lock(&lock);
+	pool = current_pool();
+	k_spin_unlock(&lock, key);
+
+	if (pool == NULL) {
+		errno = EPERM;
+		return NULL;
+	}
+
+	if (k_sem_take(&pool->free_sem, timeout) != 0) {
+		errno = EAGAIN;
+		return NULL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (i = 0; pool->in_use[i]; i++) {
+	}
+
+	pool->in_use[i] = true;
+
+	k_spin_unlock(&lock, key);
+
+	return pool->data[i];
+}
+
+Z_SYSCALL_HANDLER(zsock_buf_alloc, timeout)
+{
+	return (u32_t)z_impl_zsock_buf_alloc(timeout);
+}
+
+int z_impl_zsock_buf_free(void *buf)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct zsock_buf_pool *pool = current_pool();
+	int i = buf_index(pool, buf);
+
+	if (i < 0) {
+		k_spin_unlock(&lock, key);
+		errno = EBADF;
+		return -1;
+	}
+
+	pool->in_use[i] = false;
+
+	k_spin_unlock(&lock, key);
+
+	k_sem_give(&pool->free_sem);
+
+	return 0;
+}
+
+Z_SYSCALL_HANDLER(zsock_buf_free, buf)
+{
+	return z_impl_zsock_buf_free((void *)buf);
+}
+
+ssize_t z_impl_zsock_sendto_buf(int sock, const void *buf, size_t len,
+				int flags, const struct sockaddr *dest_addr,
+				socklen_t addrlen)
+{
+	if (!buf_is_owned(buf)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (len > ZSOCK_BUF_SIZE) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return z_impl_zsock_sendto(sock, buf, len, flags, dest_addr, addrlen);
+}
+
+Z_SYSCALL_HANDLER(zsock_sendto_buf, sock, buf, len, flags, dest_addr,
+		  addrlen)
+{
+	struct sockaddr_storage dest_addr_copy;
+
+	if (dest_addr) {
+		Z_OOPS(Z_SYSCALL_VERIFY(addrlen <= sizeof(dest_addr_copy)));
+		Z_OOPS(z_user_from_copy(&dest_addr_copy, (void *)dest_addr,
+					addrlen));
+	}
+
+	return z_impl_zsock_sendto_buf(sock, (const void *)buf, len, flags,
+			dest_addr ? (struct sockaddr *)&dest_addr_copy : NULL,
+			addrlen);
+}
+
+ssize_t z_impl_zsock_recvfrom_buf(int sock, void *buf, int flags,
+				  struct sockaddr *src_addr,
+				  socklen_t *addrlen)
+{
+	if (!buf_is_owned(buf)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	return z_impl_zsock_recvfrom(sock, buf, ZSOCK_BUF_SIZE, flags,
+				     src_addr, addrlen);
+}
+
+Z_SYSCALL_HANDLER(zsock_recvfrom_buf, sock, buf, flags, src_addr,
+		  addrlen_param)
+{
+	socklen_t addrlen_copy;
+	socklen_t *addrlen_ptr = (socklen_t *)addrlen_param;
+	ssize_t ret;
+
+	if (addrlen_param) {
+		Z_OOPS(z_user_from_copy(&addrlen_copy,
+					(socklen_t *)addrlen_param,
+					sizeof(socklen_t)));
+	}
+	Z_OOPS(src_addr && Z_SYSCALL_MEMORY_WRITE(src_addr, addrlen_copy));
+
+	ret = z_impl_zsock_recvfrom_buf(sock, (void *)buf, flags,
+					(struct sockaddr *)src_addr,
+					addrlen_param ? &addrlen_copy : NULL);
+
+	if (addrlen_param) {
+		Z_OOPS(z_user_to_copy(addrlen_ptr, &addrlen_copy,
+				      sizeof(socklen_t)));
+	}
+
+	return ret;
+}
@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2019 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief epoll-like readiness notification for sockets
+ *
+ * Sockets added to an epoll instance are linked to it from their
+ * net_context. The receive and accept callbacks of the socket layer put
+ * them on the ready list of the instance, so that a wait only looks at
+ * the sockets which received something, instead of scanning all of them
+ * as poll() does.
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <sys/dlist.h>
+#include <sys/slist.h>
+#include <net/socket.h>
+
+#include "sockets_internal.h"
+
+struct epoll_entry {
+	/** Node in the list of entries of the socket */
+	sys_snode_t ctx_node;
+
+	/** Node in the ready list of the instance */
+	sys_dnode_t ready_node;
+
+	struct epoll_instance *ep;
+	struct net_context *ctx;
+	int fd;
+	u32_t events;
+	zsock_epoll_data_t data;
+	bool ready;
+};
+
+struct epoll_instance {
+	bool in_use;
+
+	/** Given when a socket becomes ready */
+	struct k_sem sem;
+
+	/** Entries which may be ready */
+	sys_dlist_t ready;
+
+	/** Entries in use have a net_context */
+	struct epoll_entry entries[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+};
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static struct epoll_instance instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+
+/* Protects the entries and ready lists, taken by the network stack */
+static struct k_spinlock lock;
+
+static u32_t entry_revents(struct epoll_entry *entry)
+{
+	struct net_context *ctx = entry->ctx;
+	u32_t revents = 0U;
+
+	if (sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLIN | ZSOCK_EPOLLHUP;
+	} else if (!k_fifo_is_empty(&ctx->recv_q)) {
+		revents |= ZSOCK_EPOLLIN;
+	}
+
+	/* For now, assume that socket is always writable */
+	revents |= ZSOCK_EPOLLOUT;
+
+	return revents & (entry->events | ZSOCK_EPOLLHUP | ZSOCK_EPOLLERR);
+}
+
+/* Must be called with the lock held */
+static bool entry_mark_ready(struct epoll_entry *entry)
+{
+	if (entry->ready || !(entry->events &
+			      (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT))) {
+		return false;
+	}
+
+	entry->ready = true;
+	sys_dlist_append(&entry->ep->ready, &entry->ready_node);
+
+	return true;
+}
+
+/* Must be called with the lock held */
+static void entry_free(struct epoll_entry *entry)
+{
+	if (entry->ready) {
+		sys_dlist_remove(&entry->ready_node);
+		entry->ready = false;
+	}
+
+	(void)sys_slist_find_and_remove(&entry->ctx->epoll_entries,
+					&entry->ctx_node);
+	entry->ctx = NULL;
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	struct epoll_entry *entry;
+	k_spinlock_key_t key;
+
+	if (sys_slist_is_empty(&ctx->epoll_entries)) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_entries, entry, ctx_node) {
+		if (entry_mark_ready(entry)) {
+			k_sem_give(&entry->ep->sem);
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void zsock_epoll_forget(struct net_context *ctx)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	sys_snode_t *node;
+
+	while ((node = sys_slist_peek_head(&ctx->epoll_entries)) != NULL) {
+		entry_free(CONTAINER_OF(node, struct epoll_entry, ctx_node));
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+int zsock_epoll_create(int size)
+{
+	struct epoll_instance *ep = NULL;
+	k_spinlock_key_t key;
+	int fd, i;
+
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (i = 0; i < ARRAY_SIZE(instances); i++) {
+		if (!instances[i].in_use) {
+			ep = &instances[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (!ep) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	k_sem_init(&ep->sem, 0, 1);
+	sys_dlist_init(&ep->ready);
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	return fd;
+}
+
+static struct epoll_entry *find_entry(struct epoll_instance *ep, int fd)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		if (ep->entries[i].ctx && ep->entries[i].fd == fd) {
+			return &ep->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct epoll_entry *find_free_entry(struct epoll_instance *ep)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		if (!ep->entries[i].ctx) {
+			return &ep->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep;
+	struct epoll_entry *entry;
+	struct net_context *ctx;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	/* Only sockets of the native stack notify the instance */
+	ctx = z_get_fd_obj(fd, (const struct fd_op_vtable *)&sock_fd_op_vtable,
+			   EPERM);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Closing a socket removes its entries, so a match is that socket */
+	entry = find_entry(ep, fd);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (entry) {
+			ret = -EEXIST;
+			break;
+		}
+
+		entry = find_free_entry(ep);
+		if (!entry) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		entry->ep = ep;
+		entry->ctx = ctx;
+		entry->fd = fd;
+		entry->ready = false;
+		sys_slist_append(&ctx->epoll_entries, &entry->ctx_node);
+		/* fall through */
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (!entry) {
+			ret = -ENOENT;
+			break;
+		}
+
+		entry->events = event->events;
+		entry->data = event->data;
+
+		/* Report the current state, the mask may have changed */
+		if (entry_mark_ready(entry)) {
+			k_sem_give(&ep->sem);
+		}
+
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (!entry) {
+			ret = -ENOENT;
+			break;
+		}
+
+		entry_free(entry);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Report the ready entries, or return 0 if there is none. Must be called
+ * with the lock held.
+ */
+static int collect_events(struct epoll_instance *ep,
+			  struct zsock_epoll_event *events, int maxevents)
+{
+	struct epoll_entry *entry, *next;
+	sys_dlist_t reported;
+	u32_t revents;
+	int count = 0;
+
+	sys_dlist_init(&reported);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->ready, entry, next,
+					  ready_node) {
+		if (count == maxevents) {
+			break;
+		}
+
+		sys_dlist_remove(&entry->ready_node);
+
+		revents = entry_revents(entry);
+		if (!revents) {
+			/* Consumed meanwhile, will be notified again */
+			entry->ready = false;
+			continue;
+		}
+
+		events[count].events = revents;
+		events[count].data = entry->data;
+		count++;
+
+		if (entry->events & ZSOCK_EPOLLONESHOT) {
+			/* Disabled until modified */
+			entry->events = 0U;
+			entry->ready = false;
+		} else if (entry->events & ZSOCK_EPOLLET) {
+			entry->ready = false;
+		} else {
+			/* Level triggered, checked again by the next wait */
+			sys_dlist_append(&reported, &entry->ready_node);
+		}
+	}
+
+	/* Put the reported entries after the others, so that all the ready
+	 * sockets get their turn
+	 */
+	while (!sys_dlist_is_empty(&reported)) {
+		sys_dnode_t *node = sys_dlist_get(&reported);
+
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	return count;
+}
+
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout)
+{
+	struct epoll_instance *ep;
+	u32_t entry_time = k_uptime_get_32();
+	k_spinlock_key_t key;
+	s32_t remaining;
+	int count;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout < 0) {
+		timeout = K_FOREVER;
+	}
+
+	while (true) {
+		key = k_spin_lock(&lock);
+		count = collect_events(ep, events, maxevents);
+		k_spin_unlock(&lock, key);
+
+		if (count > 0 || timeout == K_NO_WAIT) {
+			return count;
+		}
+
+		remaining = timeout;
+		if (timeout != K_FOREVER) {
+			remaining = timeout - (k_uptime_get_32() - entry_time);
+			if (remaining <= 0) {
+				return 0;
+			}
+		}
+
+		if (k_sem_take(&ep->sem, remaining) == -EAGAIN) {
+			return 0;
+		}
+	}
+}
+
+static ssize_t epoll_read_vmeth(void *obj, void *buf, size_t sz)
+{
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buf, size_t sz)
+{
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	struct epoll_instance *ep = obj;
+	k_spinlock_key_t key;
+	int i;
+
+	switch (request) {
+	case ZFD_IOCTL_CLOSE:
+		key = k_spin_lock(&lock);
+
+		for (i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+			if (ep->entries[i].ctx) {
+				entry_free(&ep->entries[i]);
+			}
+		}
+
+		ep->in_use = false;
+
+		k_spin_unlock(&lock, key);
+
+		return 0;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
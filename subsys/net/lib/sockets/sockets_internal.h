@@ -30,6 +30,21 @@ static inline u32_t sock_get_flag(struct net_context *ctx, u32_t mask)
 #define sock_set_eof(ctx) sock_set_flag(ctx, SOCK_EOF, SOCK_EOF)
 #define sock_is_nonblock(ctx) sock_get_flag(ctx, SOCK_NONBLOCK)
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+void zsock_epoll_notify(struct net_context *ctx);
+void zsock_epoll_forget(struct net_context *ctx);
+#else
+static inline void zsock_epoll_notify(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void zsock_epoll_forget(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif
+
 struct socket_op_vtable {
 	struct fd_op_vtable fd_vtable;
 	int (*bind)(void *obj, const struct sockaddr *addr, socklen_t addrlen);
@@ -46,6 +61,9 @@ struct socket_op_vtable {
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
+	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
+	int (*recvmmsg)(void *obj, struct zsock_mmsghdr *msgvec,
+			unsigned int vlen, int flags);
 };
 
 #endif /* _SOCKETS_INTERNAL_H_ */
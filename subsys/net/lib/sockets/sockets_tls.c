@@ -32,6 +32,12 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/x509_crt.h>
 #include <mbedtls/ssl.h>
 #include <mbedtls/ssl_cookie.h>
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include <mbedtls/ssl_cache.h>
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
 #endif /* CONFIG_MBEDTLS */
@@ -102,8 +108,24 @@ struct tls_context {
 
 		/** DTLS role, client by default. */
 		s8_t role;
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+		/** Information if the session cache is used. */
+		bool session_cache;
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS) && \
+	defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+		/** DTLS connection ID use, disabled by default. */
+		s8_t dtls_cid;
+#endif
 	} options;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	/** Information if a cached session was offered to the server. */
+	bool session_offered;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	/** Context information for DTLS timing. */
 	struct dtls_timing_context dtls_timing;
@@ -116,6 +138,19 @@ struct tls_context {
 
 	/** DTLS peer address length. */
 	socklen_t dtls_peer_addrlen;
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	/** Own DTLS connection ID. */
+	unsigned char dtls_cid[CONFIG_NET_SOCKETS_DTLS_CID_LEN];
+
+	/** Source address of the last datagram, if it was not the peer
+	 *  address.
+	 */
+	struct sockaddr dtls_rx_addr;
+
+	/** Length of dtls_rx_addr, 0 if unused. */
+	socklen_t dtls_rx_addrlen;
+#endif
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
 #if defined(CONFIG_MBEDTLS)
@@ -250,6 +285,305 @@ static int dtls_timing_get_delay(void *data)
 }
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+/** Client session, as negotiated with a server. */
+struct tls_session_cache_entry {
+	/** Information whether the entry is used. */
+	bool is_used;
+
+	/** Uptime when the session was last offered or stored. */
+	s64_t last_used;
+
+	/** Secure protocol version of the socket. */
+	enum net_ip_protocol_secure tls_version;
+
+	/** Credentials of the socket. */
+	struct sec_tag_list sec_tag_list;
+
+	/** Server hostname, empty if none was set. */
+	char hostname[CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_HOSTNAME_LEN + 1];
+
+	/** mbedTLS session, including the session ID and ticket. */
+	mbedtls_ssl_session session;
+};
+
+static struct tls_session_cache_entry
+		session_cache[CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE];
+static struct tls_session_cache_stats session_cache_stats;
+
+/* A mutex for protecting the session cache. It is also taken around the
+ * server session cache and ticket calls, as mbedTLS does not protect them
+ * without MBEDTLS_THREADING_C.
+ */
+static struct k_mutex session_cache_lock;
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static mbedtls_ssl_cache_context server_session_cache;
+
+static int server_session_cache_get(void *data, mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_get(data, session);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+
+static int server_session_cache_set(void *data,
+				    const mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_set(data, session);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+
+static void server_session_cache_init(void)
+{
+	mbedtls_ssl_cache_init(&server_session_cache);
+	mbedtls_ssl_cache_set_max_entries(&server_session_cache,
+				CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE);
+#if defined(MBEDTLS_HAVE_TIME)
+	mbedtls_ssl_cache_set_timeout(&server_session_cache,
+				CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_TIMEOUT);
+#endif
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+static mbedtls_ssl_ticket_context server_tickets;
+static bool server_tickets_ready;
+
+static int server_ticket_write(void *data, const mbedtls_ssl_session *session,
+			       unsigned char *start, const unsigned char *end,
+			       size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(data, session, start, end, tlen,
+				       lifetime);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+
+static int server_ticket_parse(void *data, mbedtls_ssl_session *session,
+			       unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(data, session, buf, len);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
+static void tls_session_cache_init(void)
+{
+	k_mutex_init(&session_cache_lock);
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	server_session_cache_init();
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&server_tickets);
+
+	server_tickets_ready = mbedtls_ssl_ticket_setup(&server_tickets,
+			mbedtls_ctr_drbg_random, &tls_ctr_drbg,
+			MBEDTLS_CIPHER_AES_128_GCM,
+			CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_TIMEOUT) == 0;
+	if (!server_tickets_ready) {
+		NET_WARN("TLS session tickets not available");
+	}
+#endif
+}
+
+/* Let a server resume the sessions of its clients. */
+static void tls_session_server_setup(struct tls_context *tls)
+{
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_conf_session_cache(&tls->config, &server_session_cache,
+				       server_session_cache_get,
+				       server_session_cache_set);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (server_tickets_ready) {
+		mbedtls_ssl_conf_session_tickets_cb(&tls->config,
+						    server_ticket_write,
+						    server_ticket_parse,
+						    &server_tickets);
+	}
+#endif
+}
+
+static const char *tls_session_hostname(struct tls_context *tls)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (tls->ssl.hostname != NULL) {
+		return tls->ssl.hostname;
+	}
+#endif
+
+	return "";
+}
+
+static struct tls_session_cache_entry *tls_session_find(
+						struct tls_context *tls)
+{
+	struct sec_tag_list *tags = &tls->options.sec_tag_list;
+	const char *hostname = tls_session_hostname(tls);
+	struct tls_session_cache_entry *entry;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(session_cache); i++) {
+		entry = &session_cache[i];
+
+		if (entry->is_used &&
+		    entry->tls_version == tls->tls_version &&
+		    entry->sec_tag_list.sec_tag_count == tags->sec_tag_count &&
+		    !memcmp(entry->sec_tag_list.sec_tags, tags->sec_tags,
+			    tags->sec_tag_count * sizeof(sec_tag_t)) &&
+		    !strcmp(entry->hostname, hostname)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void tls_session_remove(struct tls_session_cache_entry *entry)
+{
+	mbedtls_ssl_session_free(&entry->session);
+	entry->is_used = false;
+}
+
+/* Offer the cached session, if any, in the next client handshake. */
+static void tls_session_restore(struct tls_context *tls)
+{
+	struct tls_session_cache_entry *entry;
+
+	tls->session_offered = false;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(tls);
+	if (entry && mbedtls_ssl_set_session(&tls->ssl, &entry->session) == 0) {
+		entry->last_used = k_uptime_get();
+		tls->session_offered = true;
+	}
+
+	k_mutex_unlock(&session_cache_lock);
+}
+
+/* Update the cache once a client handshake is over. */
+static void tls_session_update(struct tls_context *tls, bool success)
+{
+	struct tls_session_cache_entry *entry;
+	const char *hostname;
+	bool resumed = false;
+	int i;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(tls);
+
+	if (!success) {
+		/* Do not offer a session the server failed on again. */
+		if (entry && tls->session_offered) {
+			tls_session_remove(entry);
+		}
+
+		goto out;
+	}
+
+	if (entry) {
+		/* A resumed session keeps its master secret, a full
+		 * handshake derives a new one.
+		 */
+		resumed = tls->session_offered &&
+			  !memcmp(entry->session.master, tls->ssl.session->master,
+				  sizeof(entry->session.master));
+	} else {
+		hostname = tls_session_hostname(tls);
+		if (strlen(hostname) >
+		    CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_HOSTNAME_LEN) {
+			goto count;
+		}
+
+		entry = &session_cache[0];
+		for (i = 1; i < ARRAY_SIZE(session_cache) && entry->is_used;
+		     i++) {
+			if (!session_cache[i].is_used ||
+			    session_cache[i].last_used < entry->last_used) {
+				entry = &session_cache[i];
+			}
+		}
+
+		if (entry->is_used) {
+			tls_session_remove(entry);
+		}
+
+		entry->tls_version = tls->tls_version;
+		memcpy(&entry->sec_tag_list, &tls->options.sec_tag_list,
+		       sizeof(entry->sec_tag_list));
+		strcpy(entry->hostname, hostname);
+	}
+
+	/* Store the session even if it was resumed, the server may have
+	 * issued a new ticket.
+	 */
+	mbedtls_ssl_session_free(&entry->session);
+	if (mbedtls_ssl_get_session(&tls->ssl, &entry->session) == 0) {
+		entry->is_used = true;
+		entry->last_used = k_uptime_get();
+	} else {
+		tls_session_remove(entry);
+	}
+
+count:
+	if (resumed) {
+		session_cache_stats.hits++;
+	} else {
+		session_cache_stats.misses++;
+	}
+
+out:
+	k_mutex_unlock(&session_cache_lock);
+
+	tls->session_offered = false;
+}
+
+static void tls_session_purge(void)
+{
+	int i;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(session_cache); i++) {
+		if (session_cache[i].is_used) {
+			tls_session_remove(&session_cache[i]);
+		}
+	}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_cache_free(&server_session_cache);
+	server_session_cache_init();
+#endif
+
+	k_mutex_unlock(&session_cache_lock);
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 /* Initialize TLS internals. */
 static int tls_init(struct device *unused)
 {
@@ -289,6 +623,10 @@ static int tls_init(struct device *unused)
 	mbedtls_debug_set_threshold(CONFIG_MBEDTLS_DEBUG_LEVEL);
 #endif
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	tls_session_cache_init();
+#endif
+
 	return 0;
 }
 
@@ -456,6 +794,82 @@ static void dtls_peer_address_get(struct net_context *context,
 	*addrlen = len;
 }
 
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+static size_t dtls_cid_len(struct tls_context *tls)
+{
+	/* The peer may use a connection ID of its own in any case, ours is
+	 * empty unless we ask the peer to use one.
+	 */
+	if (tls->options.dtls_cid == TLS_DTLS_CID_ENABLED) {
+		return sizeof(tls->dtls_cid);
+	}
+
+	return 0;
+}
+
+static int dtls_cid_setup(struct tls_context *tls)
+{
+	size_t len = dtls_cid_len(tls);
+
+	if (len > 0 &&
+	    mbedtls_ctr_drbg_random(&tls_ctr_drbg, tls->dtls_cid, len) != 0) {
+		return -EIO;
+	}
+
+	if (mbedtls_ssl_set_cid(&tls->ssl, MBEDTLS_SSL_CID_ENABLED,
+				tls->dtls_cid, len) != 0) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static bool dtls_cid_is_used(struct net_context *context)
+{
+	int enabled;
+
+	if (mbedtls_ssl_get_peer_cid(&context->tls->ssl, &enabled,
+				     NULL, NULL) != 0) {
+		return false;
+	}
+
+	return enabled == MBEDTLS_SSL_CID_ENABLED;
+}
+
+/* Let a DTLS server follow a client whose address changed. mbedTLS only
+ * accepts records from the new address if they carry our connection ID,
+ * the peer address is switched once such a record was read.
+ */
+static bool dtls_cid_peer_moved(struct net_context *context,
+				const struct sockaddr *addr, socklen_t addrlen)
+{
+	if (context->tls->options.role != MBEDTLS_SSL_IS_SERVER ||
+	    context->tls->options.dtls_cid != TLS_DTLS_CID_ENABLED ||
+	    addrlen > sizeof(context->tls->dtls_rx_addr) ||
+	    !dtls_cid_is_used(context)) {
+		return false;
+	}
+
+	memcpy(&context->tls->dtls_rx_addr, addr, addrlen);
+	context->tls->dtls_rx_addrlen = addrlen;
+
+	return true;
+}
+
+static void dtls_cid_peer_update(struct net_context *context)
+{
+	if (context->tls->dtls_rx_addrlen == 0) {
+		return;
+	}
+
+	NET_DBG("DTLS peer moved");
+
+	dtls_peer_address_set(context, &context->tls->dtls_rx_addr,
+			      context->tls->dtls_rx_addrlen);
+	context->tls->dtls_rx_addrlen = 0;
+}
+#endif /* MBEDTLS_SSL_DTLS_CONNECTION_ID */
+
 static int dtls_tx(void *ctx, const unsigned char *buf, size_t len)
 {
 	struct net_context *net_ctx = ctx;
@@ -492,6 +906,10 @@ static int dtls_rx(void *ctx, unsigned char *buf, size_t len, uint32_t timeout)
 	do {
 		retry = false;
 
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+		net_ctx->tls->dtls_rx_addrlen = 0;
+#endif
+
 		/* mbedtLS does not allow blocking rx for DTLS, therefore use
 		 * k_poll for timeout functionality.
 		 */
@@ -536,6 +954,12 @@ static int dtls_rx(void *ctx, unsigned char *buf, size_t len, uint32_t timeout)
 				return MBEDTLS_ERR_SSL_PEER_VERIFY_FAILED;
 			}
 		} else if (!dtls_is_peer_addr_valid(net_ctx, &addr, addrlen)) {
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+			if (dtls_cid_peer_moved(net_ctx, &addr, addrlen)) {
+				break;
+			}
+#endif
+
 			/* Received data from different peer, ignore it. */
 			retry = true;
 
@@ -768,6 +1192,9 @@ static int tls_mbedtls_reset(struct net_context *context)
 	(void)memset(&context->tls->dtls_peer_addr, 0,
 		     sizeof(context->tls->dtls_peer_addr));
 	context->tls->dtls_peer_addrlen = 0;
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	context->tls->dtls_rx_addrlen = 0;
+#endif
 #endif
 
 	return 0;
@@ -807,6 +1234,13 @@ static int tls_mbedtls_handshake(struct net_context *context, bool block)
 		k_sem_give(&context->tls->tls_established);
 	}
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	if (ret != -EAGAIN && context->tls->options.session_cache &&
+	    context->tls->config.endpoint == MBEDTLS_SSL_IS_CLIENT) {
+		tls_session_update(context->tls, ret == 0);
+	}
+#endif
+
 	return ret;
 }
 
@@ -868,6 +1302,17 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 					&context->tls->config,
 					CONFIG_NET_SOCKETS_DTLS_TIMEOUT);
 		}
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+		if (context->tls->options.dtls_cid != TLS_DTLS_CID_DISABLED) {
+			ret = mbedtls_ssl_conf_cid(&context->tls->config,
+					dtls_cid_len(context->tls),
+					MBEDTLS_SSL_UNEXPECTED_CID_IGNORE);
+			if (ret != 0) {
+				return -EINVAL;
+			}
+		}
+#endif
 	}
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
@@ -884,6 +1329,12 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 	/* If verification level was specified explicitly, set it. Otherwise,
 	 * use mbedTLS default values (required for client, none for server)
 	 */
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	if (is_server && context->tls->options.session_cache) {
+		tls_session_server_setup(context->tls);
+	}
+#endif
+
 #if defined(MBEDTLS_SSL_VERIFY_OPTIONAL_ENABLED)
 	mbedtls_ssl_conf_authmode(&context->tls->config,MBEDTLS_SSL_VERIFY_OPTIONAL);
 #else
@@ -911,6 +1362,23 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 		return -ENOMEM;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS) && \
+	defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	if (type == MBEDTLS_SSL_TRANSPORT_DATAGRAM &&
+	    context->tls->options.dtls_cid != TLS_DTLS_CID_DISABLED) {
+		ret = dtls_cid_setup(context->tls);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	if (!is_server && context->tls->options.session_cache) {
+		tls_session_restore(context->tls);
+	}
+#endif
+
 	context->tls->is_initialized = true;
 
 	return 0;
@@ -1104,6 +1572,148 @@ static int tls_opt_dtls_role_set(struct net_context *context,
 	return 0;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+static int tls_opt_session_cache_set(struct net_context *context,
+				     const void *optval, socklen_t optlen)
+{
+	int *session_cache;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	session_cache = (int *)optval;
+	if (*session_cache != TLS_SESSION_CACHE_DISABLED &&
+	    *session_cache != TLS_SESSION_CACHE_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->tls->options.session_cache =
+		*session_cache == TLS_SESSION_CACHE_ENABLED;
+
+	return 0;
+}
+
+static int tls_opt_session_cache_get(struct net_context *context,
+				     void *optval, socklen_t *optlen)
+{
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = context->tls->options.session_cache ?
+		TLS_SESSION_CACHE_ENABLED : TLS_SESSION_CACHE_DISABLED;
+
+	return 0;
+}
+
+static int tls_opt_session_cache_purge_set(struct net_context *context,
+					   const void *optval,
+					   socklen_t optlen)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(optval);
+	ARG_UNUSED(optlen);
+
+	tls_session_purge();
+
+	return 0;
+}
+
+static int tls_opt_session_cache_stats_get(struct net_context *context,
+					   void *optval, socklen_t *optlen)
+{
+	ARG_UNUSED(context);
+
+	if (*optlen != sizeof(struct tls_session_cache_stats)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	memcpy(optval, &session_cache_stats, sizeof(session_cache_stats));
+	k_mutex_unlock(&session_cache_lock);
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS) && \
+	defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+static int tls_opt_dtls_cid_set(struct net_context *context,
+				const void *optval, socklen_t optlen)
+{
+	int *dtls_cid;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	dtls_cid = (int *)optval;
+	if (*dtls_cid != TLS_DTLS_CID_DISABLED &&
+	    *dtls_cid != TLS_DTLS_CID_SUPPORTED &&
+	    *dtls_cid != TLS_DTLS_CID_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->tls->options.dtls_cid = *dtls_cid;
+
+	return 0;
+}
+
+static int tls_opt_dtls_cid_get(struct net_context *context,
+				void *optval, socklen_t *optlen)
+{
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = context->tls->options.dtls_cid;
+
+	return 0;
+}
+
+static int tls_opt_dtls_cid_status_get(struct net_context *context,
+				       void *optval, socklen_t *optlen)
+{
+	unsigned char peer_cid[MBEDTLS_SSL_CID_OUT_LEN_MAX];
+	int status = TLS_DTLS_CID_STATUS_DISABLED;
+	size_t peer_cid_len;
+	int enabled;
+
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	if (!is_handshake_complete(context) ||
+	    mbedtls_ssl_get_peer_cid(&context->tls->ssl, &enabled, peer_cid,
+				     &peer_cid_len) != 0) {
+		return -ENOTCONN;
+	}
+
+	if (enabled == MBEDTLS_SSL_CID_ENABLED) {
+		if (dtls_cid_len(context->tls) > 0) {
+			status |= TLS_DTLS_CID_STATUS_DOWNLINK;
+		}
+
+		if (peer_cid_len > 0) {
+			status |= TLS_DTLS_CID_STATUS_UPLINK;
+		}
+	}
+
+	*(int *)optval = status;
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS && MBEDTLS_SSL_DTLS_CONNECTION_ID */
+
 static int ztls_socket(int family, int type, int proto)
 {
 	enum net_ip_protocol_secure tls_proto = 0;
@@ -1582,6 +2192,9 @@ static ssize_t recvfrom_dtls_server(struct net_context *ctx, void *buf,
 
 		ret = mbedtls_ssl_read(&ctx->tls->ssl, buf, max_len);
 		if (ret >= 0) {
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+			dtls_cid_peer_update(ctx);
+#endif
 			if (src_addr && addrlen) {
 				dtls_peer_address_get(ctx, src_addr, addrlen);
 			}
@@ -1838,6 +2451,27 @@ int ztls_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_ciphersuite_used_get(ctx, optval, optlen);
 		break;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_get(ctx, optval, optlen);
+		break;
+
+	case TLS_SESSION_CACHE_STATS:
+		err = tls_opt_session_cache_stats_get(ctx, optval, optlen);
+		break;
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS) && \
+	defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	case TLS_DTLS_CID:
+		err = tls_opt_dtls_cid_get(ctx, optval, optlen);
+		break;
+
+	case TLS_DTLS_CID_STATUS:
+		err = tls_opt_dtls_cid_status_get(ctx, optval, optlen);
+		break;
+#endif
+
 	default:
 		/* Unknown or write-only option. */
 		err = -ENOPROTOOPT;
@@ -1888,6 +2522,23 @@ int ztls_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_dtls_role_set(ctx, optval, optlen);
 		break;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_set(ctx, optval, optlen);
+		break;
+
+	case TLS_SESSION_CACHE_PURGE:
+		err = tls_opt_session_cache_purge_set(ctx, optval, optlen);
+		break;
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS) && \
+	defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	case TLS_DTLS_CID:
+		err = tls_opt_dtls_cid_set(ctx, optval, optlen);
+		break;
+#endif
+
 	default:
 		/* Unknown or read-only option. */
 		err = -ENOPROTOOPT;
@@ -20,18 +20,48 @@ LOG_MODULE_DECLARE(power);
 static void device_pm_callback(struct device *dev,
 			       int retval, void *context, void *arg)
 {
+	struct device_pm *pm = dev->config->pm;
+
 	__ASSERT(retval == 0, "Device set power state failed");
 
 	/* Set the fsm_state */
 	if (*((u32_t *)context) == DEVICE_PM_ACTIVE_STATE) {
-		atomic_set(&dev->config->pm->fsm_state,
-				DEVICE_PM_FSM_STATE_ACTIVE);
+		atomic_set(&pm->fsm_state, DEVICE_PM_FSM_STATE_ACTIVE);
 	} else {
-		atomic_set(&dev->config->pm->fsm_state,
-				DEVICE_PM_FSM_STATE_SUSPENDED);
+		atomic_set(&pm->fsm_state, DEVICE_PM_FSM_STATE_SUSPENDED);
+
+		/* The parent is no longer needed */
+		if (pm->parent_held) {
+			pm->parent_held = false;
+			device_pm_put(pm->parent);
+		}
 	}
 
-	k_work_submit(&dev->config->pm->work);
+	k_work_submit(&pm->work);
+}
+
+/* Returns true once the parent, if any, is active. */
+static bool parent_ready(struct device_pm *pm)
+{
+	if (!pm->parent) {
+		return true;
+	}
+
+	if (!pm->parent_held) {
+		/* The parent work is queued first and runs before ours. */
+		pm->parent_held = true;
+		device_pm_get(pm->parent);
+		k_work_submit(&pm->work);
+		return false;
+	}
+
+	if (atomic_get(&pm->parent->config->pm->fsm_state) !=
+	    DEVICE_PM_FSM_STATE_ACTIVE) {
+		k_work_submit(&pm->work);
+		return false;
+	}
+
+	return true;
 }
 
 static void pm_work_handler(struct k_work *work)
@@ -59,6 +89,10 @@ static void pm_work_handler(struct k_work *work)
 	case DEVICE_PM_FSM_STATE_SUSPENDED:
 		if ((atomic_get(&dev->config->pm->usage) > 0) ||
 					!dev->config->pm->enable) {
+			if (!parent_ready(pm)) {
+				break;
+			}
+
 			atomic_set(&dev->config->pm->fsm_state,
 					DEVICE_PM_FSM_STATE_RESUMING);
 			ret = device_set_power_state(dev,
@@ -85,6 +119,16 @@ fsm_out:
 	k_poll_signal_raise(&dev->config->pm->signal, pm_state);
 }
 
+#ifdef CONFIG_DEVICE_IDLE_PM_AUTOSUSPEND
+static void pm_autosuspend_handler(struct k_work *work)
+{
+	struct device_pm *pm = CONTAINER_OF(work, struct device_pm,
+					    autosuspend_work.work);
+
+	k_work_submit(&pm->work);
+}
+#endif
+
 static int device_pm_request(struct device *dev,
 			     u32_t target_state, u32_t pm_flags)
 {
@@ -95,6 +139,10 @@ static int device_pm_request(struct device *dev,
 			"Invalid device PM state requested");
 
 	if (target_state == DEVICE_PM_ACTIVE_STATE) {
+#ifdef CONFIG_DEVICE_IDLE_PM_AUTOSUSPEND
+		/* Used again before the delay expired, stay active */
+		k_delayed_work_cancel(&dev->config->pm->autosuspend_work);
+#endif
 		if (atomic_inc(&dev->config->pm->usage) < 0) {
 			return 0;
 		}
@@ -102,6 +150,15 @@ static int device_pm_request(struct device *dev,
 		if (atomic_dec(&dev->config->pm->usage) > 1) {
 			return 0;
 		}
+
+#ifdef CONFIG_DEVICE_IDLE_PM_AUTOSUSPEND
+		if ((pm_flags & DEVICE_PM_ASYNC) &&
+		    dev->config->pm->autosuspend_delay) {
+			k_delayed_work_submit(&dev->config->pm->autosuspend_work,
+					      dev->config->pm->autosuspend_delay);
+			return 0;
+		}
+#endif
 	}
 
 	k_work_submit(&dev->config->pm->work);
@@ -161,6 +218,10 @@ void device_pm_enable(struct device *dev)
 		atomic_set(&dev->config->pm->fsm_state,
 					DEVICE_PM_FSM_STATE_SUSPENDED);
 		k_work_init(&dev->config->pm->work, pm_work_handler);
+#ifdef CONFIG_DEVICE_IDLE_PM_AUTOSUSPEND
+		k_delayed_work_init(&dev->config->pm->autosuspend_work,
+				    pm_autosuspend_handler);
+#endif
 	} else {
 		k_work_submit(&dev->config->pm->work);
 	}
@@ -175,3 +236,19 @@ void device_pm_disable(struct device *dev)
 	k_work_submit(&dev->config->pm->work);
 	k_sem_give(&dev->config->pm->lock);
 }
+
+void device_pm_parent_set(struct device *dev, struct device *parent)
+{
+	k_sem_take(&dev->config->pm->lock, K_FOREVER);
+	__ASSERT(!dev->config->pm->parent_held,
+		 "Parent changed while the device is active");
+	dev->config->pm->parent = parent;
+	k_sem_give(&dev->config->pm->lock);
+}
+
+#ifdef CONFIG_DEVICE_IDLE_PM_AUTOSUSPEND
+void device_pm_autosuspend_set(struct device *dev, s32_t delay_ms)
+{
+	dev->config->pm->autosuspend_delay = delay_ms;
+}
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/slist.h>
+#include <power/power.h>
+
+#define LOG_LEVEL CONFIG_SYS_PM_LOG_LEVEL /* From power module Kconfig */
+#include <logging/log.h>
+LOG_MODULE_DECLARE(power);
+
+static sys_slist_t latency_reqs;
+
+/* Kept up to date on changes, read by the policy on every idle entry */
+static u32_t latency_min = UINT32_MAX;
+
+static void latency_min_update(void)
+{
+	struct sys_pm_latency_req *req;
+	u32_t min = UINT32_MAX;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&latency_reqs, req, node) {
+		min = MIN(min, req->max_us);
+	}
+
+	latency_min = min;
+}
+
+void sys_pm_latency_request(struct sys_pm_latency_req *req, u32_t max_us)
+{
+	unsigned int key = irq_lock();
+
+	req->max_us = max_us;
+	sys_slist_append(&latency_reqs, &req->node);
+	latency_min = MIN(latency_min, max_us);
+	irq_unlock(key);
+
+	LOG_DBG("Latency %u us requested, limit %u us", max_us, latency_min);
+}
+
+void sys_pm_latency_update(struct sys_pm_latency_req *req, u32_t max_us)
+{
+	unsigned int key = irq_lock();
+
+	req->max_us = max_us;
+	latency_min_update();
+	irq_unlock(key);
+}
+
+void sys_pm_latency_release(struct sys_pm_latency_req *req)
+{
+	unsigned int key = irq_lock();
+
+	sys_slist_find_and_remove(&latency_reqs, &req->node);
+	latency_min_update();
+	irq_unlock(key);
+}
+
+u32_t sys_pm_latency_get(void)
+{
+	return latency_min;
+}
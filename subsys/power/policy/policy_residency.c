@@ -14,57 +14,136 @@ LOG_MODULE_DECLARE(power);
 
 #define SECS_TO_TICKS		CONFIG_SYS_CLOCK_TICKS_PER_SEC
 
+/* Exit latency rounded up to ticks */
+#define US_TO_TICKS(us) \
+	((u32_t)(((u64_t)(us) * SECS_TO_TICKS + USEC_PER_SEC - 1) / \
+		 USEC_PER_SEC))
+
+/* Time to resume from the state is idle time which must be paid for too */
+#define PM_STATE_INFO(residency_ms, latency_us)				 \
+	{								 \
+		.min_residency = (residency_ms) * SECS_TO_TICKS /	 \
+				 MSEC_PER_SEC + US_TO_TICKS(latency_us), \
+		.exit_latency = (latency_us),				 \
+	}
+
+struct pm_state_info {
+	/* Shortest idle period worth entering the state, in ticks */
+	u32_t min_residency;
+
+	/* Time to resume from the state, in microseconds */
+	u32_t exit_latency;
+};
+
 /* PM Policy based on SoC/Platform residency requirements */
-static const unsigned int pm_min_residency[] = {
+static const struct pm_state_info pm_states[] = {
 #ifdef CONFIG_SYS_POWER_SLEEP_STATES
 #ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_1
-	CONFIG_SYS_PM_MIN_RESIDENCY_SLEEP_1 * SECS_TO_TICKS / MSEC_PER_SEC,
+	PM_STATE_INFO(CONFIG_SYS_PM_MIN_RESIDENCY_SLEEP_1,
+		      CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_1),
 #endif
 
 #ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_2
-	CONFIG_SYS_PM_MIN_RESIDENCY_SLEEP_2 * SECS_TO_TICKS / MSEC_PER_SEC,
+	PM_STATE_INFO(CONFIG_SYS_PM_MIN_RESIDENCY_SLEEP_2,
+		      CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_2),
 #endif
 
 #ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_3
-	CONFIG_SYS_PM_MIN_RESIDENCY_SLEEP_3 * SECS_TO_TICKS / MSEC_PER_SEC,
+	PM_STATE_INFO(CONFIG_SYS_PM_MIN_RESIDENCY_SLEEP_3,
+		      CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_3),
 #endif
 #endif /* CONFIG_SYS_POWER_SLEEP_STATES */
 
 #ifdef CONFIG_SYS_POWER_DEEP_SLEEP_STATES
 #ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_1
-	CONFIG_SYS_PM_MIN_RESIDENCY_DEEP_SLEEP_1 * SECS_TO_TICKS / MSEC_PER_SEC,
+	PM_STATE_INFO(CONFIG_SYS_PM_MIN_RESIDENCY_DEEP_SLEEP_1,
+		      CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_1),
 #endif
 
 #ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_2
-	CONFIG_SYS_PM_MIN_RESIDENCY_DEEP_SLEEP_2 * SECS_TO_TICKS / MSEC_PER_SEC,
+	PM_STATE_INFO(CONFIG_SYS_PM_MIN_RESIDENCY_DEEP_SLEEP_2,
+		      CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_2),
 #endif
 
 #ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_3
-	CONFIG_SYS_PM_MIN_RESIDENCY_DEEP_SLEEP_3 * SECS_TO_TICKS / MSEC_PER_SEC,
+	PM_STATE_INFO(CONFIG_SYS_PM_MIN_RESIDENCY_DEEP_SLEEP_3,
+		      CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_3),
 #endif
 #endif /* CONFIG_SYS_POWER_DEEP_SLEEP_STATES */
 };
 
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICT
+#define PREDICT_SHIFT CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICT_SHIFT
+
+/* Moving average of the idle periods, in ticks scaled by 2^PREDICT_SHIFT */
+static u32_t idle_avg;
+static u32_t idle_start;
+static bool idle_pending;
+
+void sys_pm_policy_idle_exit(void)
+{
+	u32_t ticks;
+
+	if (!idle_pending) {
+		return;
+	}
+
+	idle_pending = false;
+	ticks = (k_cycle_get_32() - idle_start) /
+		sys_clock_hw_cycles_per_tick();
+
+	/* avg += (ticks - avg) / 2^shift, in the scaled domain */
+	idle_avg = idle_avg - (idle_avg >> PREDICT_SHIFT) + ticks;
+}
+
+static s32_t idle_predict(s32_t ticks)
+{
+	s32_t predicted = idle_avg >> PREDICT_SHIFT;
+
+	idle_start = k_cycle_get_32();
+	idle_pending = true;
+
+	/* The next timeout is a hard deadline, the average only a guess. */
+	if (ticks == K_FOREVER || predicted < ticks) {
+		return predicted;
+	}
+
+	return ticks;
+}
+#endif /* CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICT */
+
 enum power_states sys_pm_policy_next_state(s32_t ticks)
 {
+#ifdef CONFIG_SYS_PM_LATENCY
+	u32_t max_latency = sys_pm_latency_get();
+#endif
 	int i;
 
-	if ((ticks != K_FOREVER) && (ticks < pm_min_residency[0])) {
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICT
+	ticks = idle_predict(ticks);
+#endif
+
+	if ((ticks != K_FOREVER) && (ticks < pm_states[0].min_residency)) {
 		LOG_DBG("Not enough time for PM operations: %d", ticks);
 		return SYS_POWER_STATE_ACTIVE;
 	}
 
-	for (i = ARRAY_SIZE(pm_min_residency) - 1; i >= 0; i--) {
+	for (i = ARRAY_SIZE(pm_states) - 1; i >= 0; i--) {
 #ifdef CONFIG_SYS_PM_STATE_LOCK
 		if (!sys_pm_ctrl_is_state_enabled((enum power_states)(i))) {
 			continue;
 		}
+#endif
+#ifdef CONFIG_SYS_PM_LATENCY
+		if (pm_states[i].exit_latency > max_latency) {
+			continue;
+		}
 #endif
 		if ((ticks == K_FOREVER) ||
-		    (ticks >= pm_min_residency[i])) {
+		    (ticks >= pm_states[i].min_residency)) {
 			LOG_DBG("Selected power state %d "
 					"(ticks: %d, min_residency: %u)",
-					i, ticks, pm_min_residency[i]);
+					i, ticks, pm_states[i].min_residency);
 			return (enum power_states)(i);
 		}
 	}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CTR-DRBG seeded from the entropy driver.
+ *
+ * The generator is seeded at boot, busy-waiting on the entropy driver if
+ * needed. Afterwards a low priority thread collects entropy into a pool
+ * at the pace of the hardware and reseeds the generator when the pool is
+ * full. Requests are served from the generator only, with interrupts
+ * locked, so they never wait for the hardware.
+ */
+
+#include <init.h>
+#include <device.h>
+#include <drivers/entropy.h>
+#include <kernel.h>
+#include <string.h>
+#include <random/rand32.h>
+#include <tinycrypt/constants.h>
+#include <tinycrypt/ctr_prng.h>
+
+#define SEED_SIZE (TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE)
+
+/* Largest chunk produced with interrupts locked */
+#define CHUNK_SIZE 256
+
+static const u8_t personalization[] = "zephyr ctr_drbg";
+
+static TCCtrPrng_t drbg;
+static bool seeded;
+static struct device *entropy_dev;
+
+/* Called with interrupts locked */
+static int drbg_seed(const u8_t *seed)
+{
+	int rc;
+
+	if (!seeded) {
+		rc = tc_ctr_prng_init(&drbg, seed, SEED_SIZE,
+				      personalization,
+				      sizeof(personalization));
+	} else {
+		rc = tc_ctr_prng_reseed(&drbg, seed, SEED_SIZE, NULL, 0);
+	}
+
+	if (rc != TC_CRYPTO_SUCCESS) {
+		return -EIO;
+	}
+
+	seeded = true;
+
+	return 0;
+}
+
+static int ctr_drbg_initialize(struct device *dev)
+{
+	u8_t seed[SEED_SIZE];
+	unsigned int key;
+	int rc;
+
+	entropy_dev = device_get_binding(CONFIG_ENTROPY_NAME);
+	if (!entropy_dev) {
+		return -EINVAL;
+	}
+
+	rc = entropy_get_entropy_isr(entropy_dev, seed, sizeof(seed),
+				     ENTROPY_BUSYWAIT);
+	if (rc == -ENOTSUP) {
+		/* Driver does not provide an ISR-specific API, assume it can
+		 * be called from ISR context
+		 */
+		rc = entropy_get_entropy(entropy_dev, seed, sizeof(seed));
+	}
+
+	/* The harvesting thread seeds the generator later otherwise. */
+	if (rc < 0) {
+		return 0;
+	}
+
+	key = irq_lock();
+	rc = drbg_seed(seed);
+	irq_unlock(key);
+
+	(void)memset(seed, 0, sizeof(seed));
+
+	return rc;
+}
+
+int sys_csrand_get(void *dst, size_t len)
+{
+	u8_t *out = dst;
+	unsigned int key;
+	size_t chunk;
+	int rc = TC_CRYPTO_SUCCESS;
+
+	while (len && rc == TC_CRYPTO_SUCCESS) {
+		chunk = MIN(len, CHUNK_SIZE);
+
+		key = irq_lock();
+		if (!seeded) {
+			irq_unlock(key);
+			return -EAGAIN;
+		}
+
+		rc = tc_ctr_prng_generate(&drbg, NULL, 0, out, chunk);
+		irq_unlock(key);
+
+		out += chunk;
+		len -= chunk;
+	}
+
+	if (rc == TC_CTR_PRNG_RESEED_REQ) {
+		return -EAGAIN;
+	}
+
+	return (rc == TC_CRYPTO_SUCCESS) ? 0 : -EIO;
+}
+
+u32_t sys_rand32_get(void)
+{
+	u32_t ret;
+
+	if (sys_csrand_get(&ret, sizeof(ret)) < 0) {
+		/* Same fallback as the other generators before the first
+		 * seed, there is not much more that can be done.
+		 */
+		return k_cycle_get_32();
+	}
+
+	return ret;
+}
+
+static void ctr_drbg_harvest_thread(void)
+{
+	u8_t pool[SEED_SIZE];
+	unsigned int key;
+
+	while (true) {
+		/* Blocks while the hardware gathers the whole pool. */
+		if (!entropy_dev ||
+		    entropy_get_entropy(entropy_dev, pool, sizeof(pool)) < 0) {
+			k_sleep(CONFIG_CTR_DRBG_CSPRNG_RESEED_INTERVAL);
+			continue;
+		}
+
+		key = irq_lock();
+		(void)drbg_seed(pool);
+		irq_unlock(key);
+
+		(void)memset(pool, 0, sizeof(pool));
+
+		k_sleep(CONFIG_CTR_DRBG_CSPRNG_RESEED_INTERVAL);
+	}
+}
+
+K_THREAD_DEFINE(ctr_drbg_harvest, CONFIG_CTR_DRBG_CSPRNG_THREAD_STACK_SIZE,
+		ctr_drbg_harvest_thread, NULL, NULL, NULL,
+		CONFIG_CTR_DRBG_CSPRNG_THREAD_PRIO, 0, K_NO_WAIT);
+
+/* In-tree entropy drivers will initialize in PRE_KERNEL_1; ensure that they're
+ * initialized properly before initializing ourselves.
+ */
+SYS_INIT(ctr_drbg_initialize, PRE_KERNEL_2,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -33,11 +33,28 @@ extern "C" {
 #define NVS_NAMECNT_ID 0x8000
 #define NVS_NAME_ID_OFFSET 0x4000
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+/* In RAM directory entry of a name ID, both hashes are 0 when no name is
+ * stored at the ID.
+ */
+struct settings_nvs_dir_entry {
+	u16_t name_hash;	/* hash of the full name */
+	u16_t root_hash;	/* hash of the first name element */
+};
+#endif
+
 struct settings_nvs {
 	struct settings_store cf_store;
 	struct nvs_fs cf_nvs;
 	u16_t last_name_id;
 	const char *flash_dev_name;
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+	/* indexed by name ID - NVS_NAMECNT_ID - 1, only used when it
+	 * covers all the name IDs in use.
+	 */
+	struct settings_nvs_dir_entry dir[CONFIG_SETTINGS_NVS_NAME_DIR_SIZE];
+	bool dir_valid;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -200,7 +200,11 @@ int settings_commit_subtree(const char *subtree)
 	int rc;
 	int rc2;
 
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	rc = settings_wb_flush(subtree);
+#else
 	rc = 0;
+#endif
 
 	Z_STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (subtree && !settings_name_steq(ch->name, subtree, NULL)) {
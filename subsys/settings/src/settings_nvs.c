@@ -7,6 +7,7 @@
 
 #include <errno.h>
 #include <string.h>
+#include <sys/crc.h>
 
 #include "settings/settings.h"
 #include "settings/settings_nvs.h"
@@ -46,6 +47,84 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+static u16_t settings_nvs_name_hash(const char *name, size_t len)
+{
+	u16_t hash;
+
+	hash = crc16_ccitt(0xffff, (const u8_t *)name, len);
+
+	/* 0 is kept for the IDs without a name */
+	return hash ? hash : 1;
+}
+
+static struct settings_nvs_dir_entry *settings_nvs_dir_get(
+	struct settings_nvs *cf, u16_t name_id)
+{
+	u16_t idx = name_id - NVS_NAMECNT_ID - 1;
+
+	if (idx >= ARRAY_SIZE(cf->dir)) {
+		return NULL;
+	}
+
+	return &cf->dir[idx];
+}
+
+static void settings_nvs_dir_set(struct settings_nvs *cf, u16_t name_id,
+				 const char *name)
+{
+	struct settings_nvs_dir_entry *entry;
+
+	entry = settings_nvs_dir_get(cf, name_id);
+	if (!entry) {
+		/* the directory no longer covers all the names */
+		cf->dir_valid = false;
+		return;
+	}
+
+	if (!name) {
+		entry->name_hash = 0U;
+		entry->root_hash = 0U;
+		return;
+	}
+
+	entry->name_hash = settings_nvs_name_hash(name, strlen(name));
+	entry->root_hash = settings_nvs_name_hash(name,
+					settings_name_next(name, NULL));
+}
+
+/* Read all the names once, so that loads and saves only read the entries of
+ * the names they are looking for.
+ */
+static void settings_nvs_dir_init(struct settings_nvs *cf)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	u16_t name_id;
+	ssize_t rc;
+
+	(void)memset(cf->dir, 0, sizeof(cf->dir));
+
+	cf->dir_valid = (cf->last_name_id - NVS_NAMECNT_ID <=
+			 ARRAY_SIZE(cf->dir));
+	if (!cf->dir_valid) {
+		LOG_WRN("Name directory too small, %d names",
+			cf->last_name_id - NVS_NAMECNT_ID);
+		return;
+	}
+
+	for (name_id = NVS_NAMECNT_ID + 1; name_id <= cf->last_name_id;
+	     name_id++) {
+		rc = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name) - 1);
+		if (rc <= 0) {
+			continue;
+		}
+
+		name[MIN(rc, sizeof(name) - 1)] = '\0';
+		settings_nvs_dir_set(cf, name_id, name);
+	}
+}
+#endif
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -72,6 +151,15 @@ static int settings_nvs_load(struct settings_store *cs, const char *subtree)
 	const char *name_argv;
 	ssize_t rc1, rc2;
 	u16_t name_id = NVS_NAMECNT_ID;
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+	struct settings_nvs_dir_entry *entry;
+	u16_t root_hash = 0U;
+
+	if (subtree) {
+		root_hash = settings_nvs_name_hash(subtree,
+					settings_name_next(subtree, NULL));
+	}
+#endif
 
 	name_id = cf->last_name_id + 1;
 
@@ -82,6 +170,21 @@ static int settings_nvs_load(struct settings_store *cs, const char *subtree)
 			break;
 		}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+		/* skip the IDs without a name and the names outside of
+		 * the subtree without reading them.
+		 */
+		if (cf->dir_valid) {
+			entry = settings_nvs_dir_get(cf, name_id);
+			if (!entry->name_hash) {
+				continue;
+			}
+			if (subtree && (entry->root_hash != root_hash)) {
+				continue;
+			}
+		}
+#endif
+
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
 		 * setting's value.
@@ -107,6 +210,9 @@ static int settings_nvs_load(struct settings_store *cs, const char *subtree)
 			}
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+			settings_nvs_dir_set(cf, name_id, NULL);
+#endif
 			continue;
 		}
 
@@ -138,11 +244,19 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	u16_t name_id, write_name_id;
 	bool delete, write_name;
 	int rc = 0;
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+	struct settings_nvs_dir_entry *entry;
+	u16_t name_hash;
+#endif
 
 	if (!name) {
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+	name_hash = settings_nvs_name_hash(name, strlen(name));
+#endif
+
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
@@ -156,6 +270,20 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 			break;
 		}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+		/* only read the names with the same hash */
+		if (cf->dir_valid) {
+			entry = settings_nvs_dir_get(cf, name_id);
+			if (!entry->name_hash) {
+				write_name_id = name_id;
+				continue;
+			}
+			if (entry->name_hash != name_hash) {
+				continue;
+			}
+		}
+#endif
+
 		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
 
 		if (rc < 0) {
@@ -182,6 +310,9 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 			rc = nvs_delete(&cf->cf_nvs, name_id);
 			rc = nvs_delete(&cf->cf_nvs, name_id +
 					NVS_NAME_ID_OFFSET);
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+			settings_nvs_dir_set(cf, name_id, NULL);
+#endif
 
 			return 0;
 		}
@@ -206,6 +337,9 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	/* write the name if required */
 	if (write_name) {
 		rc = nvs_write(&cf->cf_nvs, write_name_id, name, strlen(name));
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+		settings_nvs_dir_set(cf, write_name_id, name);
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
@@ -241,6 +375,10 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_DIR)
+	settings_nvs_dir_init(cf);
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
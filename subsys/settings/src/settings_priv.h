@@ -10,6 +10,7 @@
 
 #include <sys/types.h>
 #include <errno.h>
+#include <stats/stats.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -123,6 +124,28 @@ extern sys_slist_t settings_load_srcs;
 extern sys_slist_t settings_handlers;
 extern struct settings_store *settings_save_dst;
 
+STATS_SECT_START(settings_stats)
+STATS_SECT_ENTRY32(writes)	/* items written to the destination */
+STATS_SECT_ENTRY32(bytes_written) /* value bytes written */
+STATS_SECT_ENTRY32(coalesced)	/* saves merged in a cached item */
+STATS_SECT_END;
+
+extern STATS_SECT_DECL(settings_stats) settings_stats;
+
+/* write an item to the destination store */
+int settings_dst_save(struct settings_store *cs, const char *name,
+		      const char *value, size_t val_len);
+
+#ifdef CONFIG_SETTINGS_WRITE_BACK
+void settings_wb_init(void);
+
+int settings_wb_save(struct settings_store *cs, const char *name,
+		     const char *value, size_t val_len);
+
+/* write the cached items of subtree, all of them if subtree is NULL */
+int settings_wb_flush(const char *subtree);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
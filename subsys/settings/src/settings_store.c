@@ -24,6 +24,13 @@ sys_slist_t settings_load_srcs;
 struct settings_store *settings_save_dst;
 extern struct k_mutex settings_lock;
 
+STATS_SECT_DECL(settings_stats) settings_stats;
+STATS_NAME_START(settings_stats)
+STATS_NAME(settings_stats, writes)
+STATS_NAME(settings_stats, bytes_written)
+STATS_NAME(settings_stats, coalesced)
+STATS_NAME_END(settings_stats);
+
 void settings_src_register(struct settings_store *cs)
 {
 	sys_snode_t *prev, *cur;
@@ -59,6 +66,10 @@ int settings_load_subtree(const char *subtree)
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	/* the sources must hold the cached values before they are loaded */
+	(void)settings_wb_flush(subtree);
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, subtree);
 	}
@@ -67,6 +78,15 @@ int settings_load_subtree(const char *subtree)
 	return rc;
 }
 
+int settings_dst_save(struct settings_store *cs, const char *name,
+		      const char *value, size_t val_len)
+{
+	STATS_INC(settings_stats, writes);
+	STATS_INCN(settings_stats, bytes_written, val_len);
+
+	return cs->cs_itf->csi_save(cs, name, value, val_len);
+}
+
 /*
  * Append a single value to persisted config. Don't store duplicate value.
  */
@@ -82,7 +102,11 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
-	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	rc = settings_wb_save(cs, name, (char *)value, val_len);
+#else
+	rc = settings_dst_save(cs, name, (char *)value, val_len);
+#endif
 
 	k_mutex_unlock(&settings_lock);
 
@@ -131,6 +155,13 @@ int settings_save(void)
 	}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	rc2 = settings_wb_flush(NULL);
+	if (!rc) {
+		rc = rc2;
+	}
+#endif
+
 	if (cs->cs_itf->csi_save_end) {
 		cs->cs_itf->csi_save_end(cs);
 	}
@@ -140,4 +171,9 @@ int settings_save(void)
 void settings_store_init(void)
 {
 	sys_slist_init(&settings_load_srcs);
+	(void)STATS_INIT_AND_REG(settings_stats, STATS_SIZE_32,
+				 "settings_stats");
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	settings_wb_init();
+#endif
 }
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <kernel.h>
+
+#include "settings/settings.h"
+#include "settings_priv.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+extern struct k_mutex settings_lock;
+
+/* A dirty settings item, waiting to be written to the destination */
+struct settings_wb_entry {
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	u8_t val[CONFIG_SETTINGS_WRITE_BACK_VAL_LEN];
+	u16_t val_len;
+	bool dirty;
+	s64_t deadline;	/* uptime at which the item has to be written */
+};
+
+struct settings_wb_policy {
+	const char *subtree;
+	s32_t delay;
+};
+
+static struct settings_wb_entry wb_entries[CONFIG_SETTINGS_WRITE_BACK_COUNT];
+static struct settings_wb_policy
+	wb_policies[CONFIG_SETTINGS_WRITE_BACK_POLICY_COUNT];
+static struct k_delayed_work wb_work;
+
+/* the policy of the longest subtree the name belongs to applies */
+static s32_t wb_delay_get(const char *name)
+{
+	s32_t delay = CONFIG_SETTINGS_WRITE_BACK_DELAY;
+	size_t len = 0;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(wb_policies); i++) {
+		if (!wb_policies[i].subtree ||
+		    !settings_name_steq(name, wb_policies[i].subtree, NULL)) {
+			continue;
+		}
+
+		if (strlen(wb_policies[i].subtree) >= len) {
+			len = strlen(wb_policies[i].subtree);
+			delay = wb_policies[i].delay;
+		}
+	}
+
+	return delay;
+}
+
+static struct settings_wb_entry *wb_entry_find(const char *name)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(wb_entries); i++) {
+		if (wb_entries[i].dirty && !strcmp(wb_entries[i].name, name)) {
+			return &wb_entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct settings_wb_entry *wb_entry_alloc(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(wb_entries); i++) {
+		if (!wb_entries[i].dirty) {
+			return &wb_entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void wb_schedule(void)
+{
+	s64_t deadline = 0;
+	s64_t now;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(wb_entries); i++) {
+		if (!wb_entries[i].dirty) {
+			continue;
+		}
+
+		if (!deadline || wb_entries[i].deadline < deadline) {
+			deadline = wb_entries[i].deadline;
+		}
+	}
+
+	if (!deadline) {
+		k_delayed_work_cancel(&wb_work);
+		return;
+	}
+
+	now = k_uptime_get();
+	k_delayed_work_submit(&wb_work,
+			      (deadline > now) ? (s32_t)(deadline - now) : 0);
+}
+
+/* write the dirty items of subtree, or only the expired ones */
+static int wb_flush(const char *subtree, bool expired)
+{
+	struct settings_wb_entry *entry;
+	s64_t now = k_uptime_get();
+	int rc = 0;
+	int rc2;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(wb_entries); i++) {
+		entry = &wb_entries[i];
+
+		if (!entry->dirty) {
+			continue;
+		}
+
+		if (expired && entry->deadline > now) {
+			continue;
+		}
+
+		if (subtree && !settings_name_steq(entry->name, subtree, NULL)) {
+			continue;
+		}
+
+		entry->dirty = false;
+
+		rc2 = settings_dst_save(settings_save_dst, entry->name,
+					entry->val_len ?
+					(const char *)entry->val : NULL,
+					entry->val_len);
+		if (rc2) {
+			LOG_ERR("Failed to write %s (err %d)", entry->name, rc2);
+			if (!rc) {
+				rc = rc2;
+			}
+		}
+	}
+
+	return rc;
+}
+
+static void wb_work_handler(struct k_work *work)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	(void)wb_flush(NULL, true);
+	wb_schedule();
+
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_wb_save(struct settings_store *cs, const char *name,
+		     const char *value, size_t val_len)
+{
+	struct settings_wb_entry *entry;
+	s64_t deadline;
+	s32_t delay;
+	int rc;
+
+	delay = wb_delay_get(name);
+	entry = wb_entry_find(name);
+
+	if ((delay == K_NO_WAIT) || (val_len > sizeof(entry->val)) ||
+	    (strlen(name) >= sizeof(entry->name))) {
+		/* the cached value would overwrite this one */
+		if (entry) {
+			entry->dirty = false;
+			wb_schedule();
+		}
+
+		return settings_dst_save(cs, name, value, val_len);
+	}
+
+	deadline = k_uptime_get() + delay;
+
+	if (entry) {
+		/* keep the first deadline, so a key updated all the time
+		 * still gets written.
+		 */
+		STATS_INC(settings_stats, coalesced);
+		deadline = MIN(deadline, entry->deadline);
+	} else {
+		entry = wb_entry_alloc();
+		if (!entry) {
+			rc = wb_flush(NULL, false);
+			if (rc) {
+				return rc;
+			}
+
+			entry = wb_entry_alloc();
+		}
+
+		strcpy(entry->name, name);
+	}
+
+	if (val_len) {
+		memcpy(entry->val, value, val_len);
+	}
+	entry->val_len = val_len;
+	entry->deadline = deadline;
+	entry->dirty = true;
+
+	wb_schedule();
+
+	return 0;
+}
+
+int settings_wb_flush(const char *subtree)
+{
+	int rc;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	rc = wb_flush(subtree, false);
+	wb_schedule();
+
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+int settings_flush(void)
+{
+	return settings_wb_flush(NULL);
+}
+
+int settings_write_back_policy_set(const char *subtree, s32_t delay)
+{
+	struct settings_wb_policy *policy = NULL;
+	int i;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(wb_policies); i++) {
+		if (wb_policies[i].subtree &&
+		    !strcmp(wb_policies[i].subtree, subtree)) {
+			policy = &wb_policies[i];
+			break;
+		}
+
+		if (!policy && !wb_policies[i].subtree) {
+			policy = &wb_policies[i];
+		}
+	}
+
+	if (policy) {
+		policy->subtree = subtree;
+		policy->delay = delay;
+	}
+
+	k_mutex_unlock(&settings_lock);
+
+	return policy ? 0 : -ENOMEM;
+}
+
+void settings_wb_init(void)
+{
+	k_delayed_work_init(&wb_work, wb_work_handler);
+}
@@ -94,10 +94,56 @@ static int cmd_device_list(const struct shell *shell,
 	return 0;
 }
 
+#if defined(CONFIG_DEVICE_INIT_PROFILE)
+static u32_t cycles_to_us(u32_t cycles)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) / NSEC_PER_USEC);
+}
+
+static int cmd_device_profile(const struct shell *shell,
+			      size_t argc, char **argv)
+{
+	static const char * const level_names[] = {
+		"PRE KERNEL 1", "PRE KERNEL 2", "POST_KERNEL", "APPLICATION",
+	};
+	struct device *info;
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (int level = 0; level < ARRAY_SIZE(level_names); level++) {
+		shell_fprintf(shell, SHELL_NORMAL, "%s: %u us\n",
+			      level_names[level],
+			      cycles_to_us(device_init_level_cycles_get(level)));
+
+		for (info = config_levels[level];
+		     info < config_levels[level+1]; info++) {
+			u32_t us = cycles_to_us(device_init_cycles_get(info));
+
+			if (info->config->name != NULL) {
+				shell_fprintf(shell, SHELL_NORMAL,
+					      "- %s: %u us%s\n",
+					      info->config->name, us,
+					      info->driver_api == NULL ?
+					      " (failed)" : "");
+			} else {
+				shell_fprintf(shell, SHELL_NORMAL,
+					      "- init %p: %u us\n",
+					      info->config->init, us);
+			}
+		}
+	}
+
+	return 0;
+}
+#endif
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_device,
 	SHELL_CMD(levels, NULL, "List configured devices by levels", cmd_device_levels),
 	SHELL_CMD(list, NULL, "List configured devices", cmd_device_list),
+#if defined(CONFIG_DEVICE_INIT_PROFILE)
+	SHELL_CMD(profile, NULL, "Show device initialization times",
+		  cmd_device_profile),
+#endif
 	SHELL_SUBCMD_SET_END /* Array terminated. */
 );
 
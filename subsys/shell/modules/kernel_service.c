@@ -13,6 +13,7 @@
 #include <debug/stack.h>
 #include <string.h>
 #include <device.h>
+#include <debug/tracing.h>
 
 static int cmd_kernel_version(const struct shell *shell,
 			      size_t argc, char **argv)
@@ -58,6 +59,9 @@ static void shell_tdata_dump(const struct k_thread *thread, void *user_data)
 	unsigned int pcnt, unused = 0U;
 	unsigned int size = thread->stack_info.size;
 	const char *tname;
+#if defined(CONFIG_TRACING_CPU_STATS_THREADS)
+	struct cpu_stats_thread stats;
+#endif
 
 	unused = stack_unused_space_get((char *)thread->stack_info.start,
 					size);
@@ -77,9 +81,17 @@ static void shell_tdata_dump(const struct k_thread *thread, void *user_data)
 		      thread->base.user_options,
 		      thread->base.prio);
 	shell_fprintf((const struct shell *)user_data, SHELL_NORMAL,
-		"\tstack size %u, unused %u, usage %u / %u (%u %%)\n\n",
+		"\tstack size %u, unused %u, usage %u / %u (%u %%)\n",
 		      size, unused, size - unused, size, pcnt);
-
+#if defined(CONFIG_TRACING_CPU_STATS_THREADS)
+	cpu_stats_thread_get(thread, &stats);
+	shell_fprintf((const struct shell *)user_data, SHELL_NORMAL,
+		      "\trun %llu cycles, ready %llu cycles, "
+		      "switches %u, preempted %u\n",
+		      stats.exec_cycles, stats.ready_cycles,
+		      stats.switches, stats.preemptions);
+#endif
+	shell_fprintf((const struct shell *)user_data, SHELL_NORMAL, "\n");
 }
 
 static int cmd_kernel_threads(const struct shell *shell,
@@ -123,6 +135,70 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_TRACING_CPU_STATS_LATENCY)
+static void shell_latency_thread_dump(const struct k_thread *thread,
+				      void *user_data)
+{
+	const char *tname = k_thread_name_get((struct k_thread *)thread);
+
+	shell_fprintf((const struct shell *)user_data, SHELL_NORMAL,
+		      "%p %-10s ready max %u cycles\n", thread,
+		      tname ? tname : "NA", thread->latency.ready_max);
+}
+
+static int cmd_kernel_latency(const struct shell *shell,
+			      size_t argc, char **argv)
+{
+	static const char *const names[CPU_STATS_LATENCY_COUNT] = {
+		[CPU_STATS_LATENCY_ISR] = "isr",
+		[CPU_STATS_LATENCY_SWAP] = "swap",
+		[CPU_STATS_LATENCY_READY] = "ready",
+	};
+	struct cpu_stats_histogram hist;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (int i = 0; i < CPU_STATS_LATENCY_COUNT; i++) {
+		cpu_stats_latency_get(i, &hist);
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "%s: count %u, max %u cycles\n",
+			      names[i], hist.count, hist.max);
+
+		for (int b = 0; b < ARRAY_SIZE(hist.bucket); b++) {
+			bool last = b == ARRAY_SIZE(hist.bucket) - 1;
+
+			if (hist.bucket[b] != 0U) {
+				shell_fprintf(shell, SHELL_NORMAL,
+					      "\t%s 2^%d: %u\n",
+					      last ? ">=" : "< ",
+					      last ? b - 1 : b,
+					      hist.bucket[b]);
+			}
+		}
+	}
+
+	k_thread_foreach(shell_latency_thread_dump, (void *)shell);
+	return 0;
+}
+
+static int cmd_kernel_latency_reset(const struct shell *shell,
+				    size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	cpu_stats_latency_reset();
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_latency,
+	SHELL_CMD(reset, NULL, "Reset latency histograms.",
+		  cmd_kernel_latency_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -151,6 +227,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_TRACING_CPU_STATS_LATENCY)
+	SHELL_CMD(latency, &sub_kernel_latency, "Latency histograms.",
+		  cmd_kernel_latency),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
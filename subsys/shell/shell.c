@@ -149,7 +149,7 @@ static void history_mode_exit(const struct shell *shell)
 
 static void history_put(const struct shell *shell, u8_t *line, size_t length)
 {
-	if (!IS_ENABLED(CONFIG_SHELL_HISTORY)) {
+	if (!IS_ENABLED(CONFIG_SHELL_HISTORY) || flag_batch_get(shell)) {
 		return;
 	}
 
@@ -299,9 +299,18 @@ static void find_completion_candidates(const struct shell *shell,
 	bool found = false;
 	size_t idx = 0;
 
+	bool sorted = shell_cmd_lvl_sorted(shell, cmd ? 1 : 0);
+
 	*longest = 0U;
 	*cnt = 0;
 
+	/* Candidates of a sorted level are contiguous, starting from the
+	 * first command not lower than the prefix.
+	 */
+	if (sorted) {
+		idx = shell_root_cmd_lower_bound(incompl_cmd, incompl_cmd_len);
+	}
+
 	while (true) {
 		bool is_empty;
 		bool is_candidate;
@@ -316,6 +325,10 @@ static void find_completion_candidates(const struct shell *shell,
 		is_empty = is_empty_cmd(candidate);
 		is_candidate = is_completion_candidate(candidate->syntax,
 						incompl_cmd, incompl_cmd_len);
+		if (sorted && !is_candidate) {
+			break;
+		}
+
 		if (!is_empty && is_candidate) {
 			size_t slen = strlen(candidate->syntax);
 
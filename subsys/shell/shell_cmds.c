@@ -40,6 +40,11 @@
 #define SHELL_HELP_ECHO_OFF	\
 	"Disable shell echo. Editing keys and meta-keys are not handled"
 
+#define SHELL_HELP_BATCH	"Non-interactive mode for scripts."
+#define SHELL_HELP_BATCH_ON	\
+	"Enter batch mode: no echo, prompt, colors nor command history"
+#define SHELL_HELP_BATCH_OFF	"Leave batch mode, enable echo and colors."
+
 #define SHELL_HELP_SELECT	"Selects new root command. In order for the " \
 	"command to be selected, it must meet the criteria:\n"		      \
 	" - it is a static command\n"					      \
@@ -273,6 +278,30 @@ static int cmd_echo(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_batch_on(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	flag_batch_set(shell, true);
+	flag_echo_set(shell, false);
+	flag_use_colors_set(shell, false);
+
+	return 0;
+}
+
+static int cmd_batch_off(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	flag_batch_set(shell, false);
+	flag_echo_set(shell, true);
+	flag_use_colors_set(shell, IS_ENABLED(CONFIG_SHELL_VT100_COLORS));
+
+	return 0;
+}
+
 static int cmd_help(const struct shell *shell, size_t argc, char **argv)
 {
 	ARG_UNUSED(argc);
@@ -407,6 +436,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_colors,
 	SHELL_SUBCMD_SET_END
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_batch,
+	SHELL_CMD_ARG(off, NULL, SHELL_HELP_BATCH_OFF, cmd_batch_off, 1, 0),
+	SHELL_CMD_ARG(on, NULL, SHELL_HELP_BATCH_ON, cmd_batch_on, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_echo,
 	SHELL_CMD_ARG(off, NULL, SHELL_HELP_ECHO_OFF, cmd_echo_off, 1, 0),
 	SHELL_CMD_ARG(on, NULL, SHELL_HELP_ECHO_ON, cmd_echo_on, 1, 0),
@@ -432,6 +467,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_backspace_mode,
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_shell,
 	SHELL_CMD(backspace_mode, &m_sub_backspace_mode,
 			SHELL_HELP_BACKSPACE_MODE, NULL),
+	SHELL_CMD(batch, &m_sub_batch, SHELL_HELP_BATCH, NULL),
 	SHELL_CMD(colors, &m_sub_colors, SHELL_HELP_COLORS, NULL),
 	SHELL_CMD_ARG(echo, &m_sub_echo, SHELL_HELP_ECHO, cmd_echo, 1, 1),
 	SHELL_COND_CMD(CONFIG_SHELL_STATS, stats, &m_sub_shell_stats,
@@ -62,6 +62,7 @@ static void flush_expired_messages(const struct shell *shell)
 	int err;
 	struct shell_log_backend_msg msg;
 	struct k_msgq *msgq = shell->log_backend->msgq;
+	atomic_t *dropped_cnt = &shell->log_backend->control_block->dropped_cnt;
 	u32_t timeout = shell->log_backend->timeout;
 	u32_t now = k_uptime_get_32();
 
@@ -72,6 +73,9 @@ static void flush_expired_messages(const struct shell *shell)
 			(void)k_msgq_get(msgq, &msg, K_NO_WAIT);
 			log_msg_put(msg.msg);
 
+			/* Reported with the messages the core dropped */
+			atomic_inc(dropped_cnt);
+
 			if (IS_ENABLED(CONFIG_SHELL_STATS)) {
 				shell->stats->log_lost_cnt++;
 			}
@@ -101,7 +105,7 @@ static void msg_to_fifo(const struct shell *shell,
 	{
 		flush_expired_messages(shell);
 
-		err = k_msgq_put(shell->log_backend->msgq, &msg, K_NO_WAIT);
+		err = k_msgq_put(shell->log_backend->msgq, &t_msg, K_NO_WAIT);
 		if (err) {
 			/* Unexpected case as we just freed one element and
 			 * there is no other context that puts into the msgq.
@@ -125,7 +129,7 @@ void shell_log_backend_disable(const struct shell_log_backend *backend)
 }
 
 static void msg_process(const struct log_output *log_output,
-			struct log_msg *msg, bool colors)
+			struct log_msg *msg, bool colors, bool flush)
 {
 	u32_t flags = LOG_OUTPUT_FLAG_LEVEL |
 		      LOG_OUTPUT_FLAG_TIMESTAMP |
@@ -135,6 +139,10 @@ static void msg_process(const struct log_output *log_output,
 		flags |= LOG_OUTPUT_FLAG_COLORS;
 	}
 
+	if (!flush) {
+		flags |= LOG_OUTPUT_FLAG_NO_FLUSH;
+	}
+
 	log_output_msg_process(log_output, msg, flags);
 	log_msg_put(msg);
 }
@@ -168,7 +176,21 @@ bool shell_log_backend_process(const struct shell_log_backend *backend)
 		}
 	}
 
-	msg_process(shell->log_backend->log_output, msg, colors);
+	/* Format up to a batch of messages before writing them to the
+	 * transport, the output buffer is only written when full meanwhile.
+	 */
+	for (int i = 1; i < CONFIG_SHELL_LOG_MSG_BATCH && msg; i++) {
+		struct log_msg *next = msg_from_fifo(backend);
+
+		msg_process(backend->log_output, msg, colors, false);
+		msg = next;
+	}
+
+	if (msg) {
+		msg_process(backend->log_output, msg, colors, true);
+	} else {
+		log_output_flush(backend->log_output);
+	}
 
 	return true;
 }
@@ -194,7 +216,7 @@ static void put(const struct log_backend *const backend, struct log_msg *msg)
 		break;
 	case SHELL_LOG_BACKEND_PANIC:
 		shell_cmd_line_erase(shell);
-		msg_process(shell->log_backend->log_output, msg, colors);
+		msg_process(shell->log_backend->log_output, msg, colors, true);
 
 		break;
 
@@ -336,6 +336,10 @@ void shell_cmd_line_erase(const struct shell *shell)
 
 static void print_prompt(const struct shell *shell)
 {
+	if (flag_batch_get(shell)) {
+		return;
+	}
+
 	shell_internal_fprintf(shell, SHELL_INFO, "%s", shell->ctx->prompt);
 }
 
@@ -99,6 +99,16 @@ static inline void flag_echo_set(const struct shell *shell, bool val)
 	shell->ctx->internal.flags.echo = val ? 1 : 0;
 }
 
+static inline bool flag_batch_get(const struct shell *shell)
+{
+	return shell->ctx->internal.flags.batch == 1 ? true : false;
+}
+
+static inline void flag_batch_set(const struct shell *shell, bool val)
+{
+	shell->ctx->internal.flags.batch = val ? 1 : 0;
+}
+
 static inline bool flag_processing_get(const struct shell *shell)
 {
 	return shell->ctx->internal.flags.processing == 1 ? true : false;
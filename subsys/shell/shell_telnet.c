@@ -107,9 +107,11 @@ static void telnet_reply_command(struct telnet_simple_command *cmd)
 	switch (cmd->op) {
 	case NVT_CMD_AO:
 		/* OK, no output then */
+		k_mutex_lock(&sh_telnet->lock, K_FOREVER);
 		sh_telnet->output_lock = true;
 		sh_telnet->line_out.len = 0;
 		k_timer_stop(&sh_telnet->send_timer);
+		k_mutex_unlock(&sh_telnet->lock);
 		break;
 	case NVT_CMD_AYT:
 		telnet_reply_ay_command();
@@ -123,36 +125,56 @@ static void telnet_reply_command(struct telnet_simple_command *cmd)
 	}
 }
 
-static int telnet_send(void)
+static int telnet_send_data(const u8_t *data, size_t len)
 {
 	int err;
 
-	if (sh_telnet->line_out.len == 0) {
-		return 0;
-	}
-
 	if (sh_telnet->client_ctx == NULL) {
 		return -ENOTCONN;
 	}
 
-	err = net_context_send(sh_telnet->client_ctx, sh_telnet->line_out.buf,
-			       sh_telnet->line_out.len, telnet_sent_cb,
-			       K_FOREVER, NULL);
+	err = net_context_send(sh_telnet->client_ctx, data, len,
+			       telnet_sent_cb, K_FOREVER, NULL);
 	if (err < 0) {
 		LOG_ERR("Failed to send %d, shutting down", err);
 		telnet_end_client_connection();
 		return err;
 	}
 
+	return 0;
+}
+
+static int telnet_send(void)
+{
+	int err;
+
+	if (sh_telnet->line_out.len == 0) {
+		return 0;
+	}
+
+	err = telnet_send_data(sh_telnet->line_out.buf,
+			       sh_telnet->line_out.len);
+	if (err < 0) {
+		return err;
+	}
+
 	/* We reinitialize the line buffer */
 	sh_telnet->line_out.len = 0;
 
 	return 0;
 }
 
-static void telnet_send_prematurely(struct k_timer *timer)
+static void telnet_send_prematurely(struct k_work *work)
 {
+	k_mutex_lock(&sh_telnet->lock, K_FOREVER);
 	(void)telnet_send();
+	k_mutex_unlock(&sh_telnet->lock);
+}
+
+static void telnet_send_timeout(struct k_timer *timer)
+{
+	/* Sending may block, leave it to the system work queue */
+	k_work_submit(&sh_telnet->send_work);
 }
 
 static inline bool telnet_handle_command(struct net_pkt *pkt)
@@ -341,7 +363,9 @@ static int init(const struct shell_transport *transport,
 	sh_telnet->shell_context = context;
 
 	k_fifo_init(&sh_telnet->rx_fifo);
-	k_timer_init(&sh_telnet->send_timer, telnet_send_prematurely, NULL);
+	k_timer_init(&sh_telnet->send_timer, telnet_send_timeout, NULL);
+	k_work_init(&sh_telnet->send_work, telnet_send_prematurely);
+	k_mutex_init(&sh_telnet->lock);
 
 	return 0;
 }
@@ -385,12 +409,29 @@ static int write(const struct shell_transport *transport,
 	*cnt = 0;
 	lb = &sh_telnet->line_out;
 
+	k_mutex_lock(&sh_telnet->lock, K_FOREVER);
+
 	/* Stop the transmission timer, so it does not interrupt the operation.
 	 */
 	timeout = k_timer_remaining_get(&sh_telnet->send_timer);
 	k_timer_stop(&sh_telnet->send_timer);
 
 	do {
+		/* Output filling a whole segment is sent as is, rather than
+		 * going through the line buffer.
+		 */
+		if (lb->len == 0 && length - *cnt >= TELNET_LINE_SIZE) {
+			err = telnet_send_data((u8_t *)data + *cnt,
+					       length - *cnt);
+			if (err != 0) {
+				*cnt = length;
+				goto error;
+			}
+
+			*cnt = length;
+			break;
+		}
+
 		if (lb->len + length - *cnt > TELNET_LINE_SIZE) {
 			copy_len = TELNET_LINE_SIZE - lb->len;
 		} else {
@@ -400,15 +441,14 @@ static int write(const struct shell_transport *transport,
 		memcpy(lb->buf + lb->len, (u8_t *)data + *cnt, copy_len);
 		lb->len += copy_len;
 
-		/* Send the data immediately if the buffer is full or line feed
-		 * is recognized.
+		/* Send the data immediately if the buffer is full, shorter
+		 * output is coalesced until the timer expires.
 		 */
-		if (lb->buf[lb->len - 1] == '\n' ||
-		    lb->len == TELNET_LINE_SIZE) {
+		if (lb->len == TELNET_LINE_SIZE) {
 			err = telnet_send();
 			if (err != 0) {
 				*cnt = length;
-				return err;
+				goto error;
 			}
 		}
 
@@ -417,16 +457,25 @@ static int write(const struct shell_transport *transport,
 
 	if (lb->len > 0) {
 		/* Check if the timer was already running, initialize otherwise.
+		 * It is not restarted by new output, which bounds the time
+		 * the first byte buffered waits.
 		 */
 		timeout = (timeout == 0) ? TELNET_TIMEOUT : timeout;
 
 		k_timer_start(&sh_telnet->send_timer, timeout, 0);
 	}
 
+	k_mutex_unlock(&sh_telnet->lock);
+
 	sh_telnet->shell_handler(SHELL_TRANSPORT_EVT_TX_RDY,
 				 sh_telnet->shell_context);
 
 	return 0;
+
+error:
+	k_mutex_unlock(&sh_telnet->lock);
+
+	return err;
 }
 
 static int read(const struct shell_transport *transport,
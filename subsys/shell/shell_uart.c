@@ -132,6 +132,126 @@ static void uart_callback(void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+static void async_rx_rdy(const struct shell_uart *sh_uart, const u8_t *data,
+			 size_t len)
+{
+#ifdef CONFIG_MCUMGR_SMP_SHELL
+	bool new_data = false;
+
+	for (size_t i = 0; i < len; i++) {
+		/* Divert bytes from shell handling if it is
+		 * part of an mcumgr frame.
+		 */
+		if (smp_shell_rx_byte(&sh_uart->ctrl_blk->smp, data[i])) {
+			continue;
+		}
+
+		if (ring_buf_put(sh_uart->rx_ringbuf, &data[i], 1) == 0U) {
+			LOG_WRN("RX ring buffer full.");
+		}
+
+		new_data = true;
+	}
+
+	if (!new_data) {
+		return;
+	}
+#else
+	if (ring_buf_put(sh_uart->rx_ringbuf, data, len) < len) {
+		LOG_WRN("RX ring buffer full.");
+	}
+#endif /* CONFIG_MCUMGR_SMP_SHELL */
+
+	sh_uart->ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY,
+				   sh_uart->ctrl_blk->context);
+}
+
+static void async_rx_enable(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	ctrl_blk->rx_buf_idx = 1U;
+	err = uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_buf[0],
+			     sizeof(ctrl_blk->rx_buf[0]),
+			     CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_TIMEOUT);
+	if (err) {
+		LOG_ERR("Failed to enable RX (err %d)", err);
+	}
+}
+
+/* Transmits the next chunk of the TX ring buffer, if any. Called by the
+ * owner of tx_busy.
+ */
+static void async_tx_start(const struct shell_uart *sh_uart)
+{
+	u8_t *data;
+	u32_t len;
+
+	do {
+		len = ring_buf_get_claim(sh_uart->tx_ringbuf, &data,
+					 sh_uart->tx_ringbuf->size);
+		if (len) {
+			(void)uart_tx(sh_uart->ctrl_blk->dev, data, len,
+				      K_FOREVER);
+			return;
+		}
+
+		atomic_clear(&sh_uart->ctrl_blk->tx_busy);
+
+		/* Data may have been put after the claim, before the flag
+		 * was cleared.
+		 */
+	} while (!ring_buf_is_empty(sh_uart->tx_ringbuf) &&
+		 atomic_set(&sh_uart->ctrl_blk->tx_busy, 1) == 0);
+}
+
+static void async_callback(struct uart_event *evt, void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		err = ring_buf_get_finish(sh_uart->tx_ringbuf,
+					  evt->data.tx.len);
+		__ASSERT_NO_MSG(err == 0);
+
+		/* Panic mode writes with polling from now on. */
+		if (!ctrl_blk->blocking_tx) {
+			async_tx_start(sh_uart);
+		}
+
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY,
+				  ctrl_blk->context);
+		break;
+	case UART_RX_RDY:
+		async_rx_rdy(sh_uart, &evt->data.rx.buf[evt->data.rx.offset],
+			     evt->data.rx.len);
+		break;
+	case UART_RX_BUF_REQUEST:
+		err = uart_rx_buf_rsp(ctrl_blk->dev,
+				      ctrl_blk->rx_buf[ctrl_blk->rx_buf_idx],
+				      sizeof(ctrl_blk->rx_buf[0]));
+		__ASSERT_NO_MSG(err == 0);
+		ctrl_blk->rx_buf_idx ^= 1U;
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("RX stopped (reason %d)", evt->data.rx_stop.reason);
+		break;
+	case UART_RX_DISABLED:
+		/* Restart after a line error. */
+		async_rx_enable(sh_uart);
+		break;
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -139,6 +259,10 @@ static void uart_irq_init(const struct shell_uart *sh_uart)
 
 	uart_irq_callback_user_data_set(dev, uart_callback, (void *)sh_uart);
 	uart_irq_rx_enable(dev);
+#elif defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
+	uart_callback_set(sh_uart->ctrl_blk->dev, async_callback,
+			  (void *)sh_uart);
+	async_rx_enable(sh_uart);
 #endif
 }
 
@@ -168,7 +292,8 @@ static int init(const struct shell_transport *transport,
 	sh_uart->ctrl_blk->handler = evt_handler;
 	sh_uart->ctrl_blk->context = context;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) ||
+	    IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
 		uart_irq_init(sh_uart);
 	} else {
 		k_timer_init(sh_uart->timer, timer_handler, NULL);
@@ -193,6 +318,8 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 	if (blocking_tx) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_disable(sh_uart->ctrl_blk->dev);
+#elif defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
+		(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
 #endif
 	}
 
@@ -207,6 +334,8 @@ static void irq_write(const struct shell_uart *sh_uart, const void *data,
 	if (atomic_set(&sh_uart->ctrl_blk->tx_busy, 1) == 0) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_enable(sh_uart->ctrl_blk->dev);
+#elif defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
+		async_tx_start(sh_uart);
 #endif
 	}
 }
@@ -217,7 +346,8 @@ static int write(const struct shell_transport *transport,
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 	const u8_t *data8 = (const u8_t *)data;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
+	if ((IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) ||
+	     IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
 	} else {
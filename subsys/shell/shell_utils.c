@@ -225,14 +225,46 @@ static inline u32_t shell_root_cmd_count(void)
 				sizeof(struct shell_cmd_entry);
 }
 
+/* Root commands are sorted by the linker, as their sections are named
+ * after the command syntax. Returns the index of the first root command
+ * whose first len characters do not compare lower than str.
+ */
+size_t shell_root_cmd_lower_bound(const char *str, size_t len)
+{
+	size_t lo = 0;
+	size_t hi = shell_root_cmd_count();
+	size_t mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+
+		if (strncmp(shell_root_cmd_get(mid)->u.entry->syntax,
+			    str, len) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+bool shell_cmd_lvl_sorted(const struct shell *shell, size_t lvl)
+{
+	return (lvl == SHELL_CMD_ROOT_LVL) &&
+	       !(IS_ENABLED(CONFIG_SHELL_CMDS_SELECT) &&
+		 shell_in_select_mode(shell));
+}
+
 /* Function returning pointer to root command matching requested syntax. */
 const struct shell_static_entry *shell_root_cmd_find(const char *syntax)
 {
-	const size_t cmd_count = shell_root_cmd_count();
+	/* Comparing the terminating NUL too makes it an exact match. */
+	size_t idx = shell_root_cmd_lower_bound(syntax, strlen(syntax) + 1);
 	const struct shell_cmd_entry *cmd;
 
-	for (size_t cmd_idx = 0; cmd_idx < cmd_count; ++cmd_idx) {
-		cmd = shell_root_cmd_get(cmd_idx);
+	if (idx < shell_root_cmd_count()) {
+		cmd = shell_root_cmd_get(idx);
 		if (strcmp(syntax, cmd->u.entry->syntax) == 0) {
 			return cmd->u.entry;
 		}
@@ -305,6 +337,10 @@ static const struct shell_static_entry *find_cmd(
 	const struct shell_static_entry *entry = NULL;
 	size_t idx = 0;
 
+	if (shell_cmd_lvl_sorted(shell, lvl)) {
+		return shell_root_cmd_find(cmd_str);
+	}
+
 	do {
 		shell_cmd_get(shell, cmd, lvl, idx++, &entry, d_entry);
 		if (entry && (strcmp(cmd_str, entry->syntax) == 0)) {
@@ -89,6 +89,17 @@ int shell_command_add(char *buff, u16_t *buff_len,
 
 const struct shell_static_entry *shell_root_cmd_find(const char *syntax);
 
+/* @brief Index of the first root command not lower than the first len
+ * characters of str, or the number of root commands.
+ */
+size_t shell_root_cmd_lower_bound(const char *str, size_t len);
+
+/* @brief Check if commands of a level are sorted, so they can be searched
+ * with @ref shell_root_cmd_lower_bound. Only root commands are, outside of
+ * select mode.
+ */
+bool shell_cmd_lvl_sorted(const struct shell *shell, size_t lvl);
+
 void shell_spaces_trim(char *str);
 
 static inline void transport_buffer_flush(const struct shell *shell)
@@ -9,13 +9,31 @@
 #include <stdio.h>
 #include <errno.h>
 #include <zephyr/types.h>
+#include <sys/byteorder.h>
 #include <stats/stats.h>
+#if CONFIG_MP_NUM_CPUS > 1
+#include <kernel_structs.h>
+#endif
 
 #define STATS_GEN_NAME_MAX_LEN  (sizeof("s255"))
 
+/* ID, type and size bytes, then the entry count */
+#define STATS_EXPORT_HDR_LEN 5
+
 /* The global list of registered statistic groups. */
 static struct stats_hdr *stats_list;
 
+/* The groups by ID, in registration order. */
+static struct stats_hdr *stats_ids[CONFIG_STATS_MAX_GROUPS];
+static u8_t stats_id_cnt;
+
+#if CONFIG_MP_NUM_CPUS > 1
+int z_stats_cpu_id(void)
+{
+	return _current_cpu->id;
+}
+#endif
+
 static const char *
 stats_get_name(const struct stats_hdr *hdr, int idx)
 {
@@ -47,6 +65,22 @@ stats_get_off(const struct stats_hdr *hdr, int idx)
 	return sizeof(*hdr) + idx * hdr->s_size;
 }
 
+/**
+ * Returns the distance between the per-CPU copies of a group, the size of
+ * the group structure including its trailing padding.
+ */
+static size_t
+stats_cpu_stride(const struct stats_hdr *hdr)
+{
+	size_t align;
+
+	align = (hdr->s_size == STATS_SIZE_64) ? __alignof__(u64_t) :
+						 hdr->s_size;
+	align = MAX(align, __alignof__(struct stats_hdr));
+
+	return ROUND_UP(sizeof(*hdr) + hdr->s_size * hdr->s_cnt, align);
+}
+
 /**
  * Creates a generic name for an unnamed stat.  The name has the form:
  *     s<idx>
@@ -130,12 +164,15 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
  * @param map The mapping of statistics name to statistic entry
  * @param map_cnt The number of items in the statistics map
  */
-void
-stats_init(struct stats_hdr *hdr, u8_t size, u16_t cnt,
-	   const struct stats_name_map *map, u16_t map_cnt)
+static void
+stats_init_type(struct stats_hdr *hdr, u8_t type, u8_t cpus, u8_t size,
+		u16_t cnt, const struct stats_name_map *map, u16_t map_cnt)
 {
 	hdr->s_size = size;
 	hdr->s_cnt = cnt;
+	hdr->s_type = type;
+	hdr->s_cpus = cpus;
+	hdr->s_id = STATS_ID_NONE;
 #ifdef CONFIG_STATS_NAMES
 	hdr->s_map = map;
 	hdr->s_map_cnt = map_cnt;
@@ -144,6 +181,13 @@ stats_init(struct stats_hdr *hdr, u8_t size, u16_t cnt,
 	stats_reset(hdr);
 }
 
+void
+stats_init(struct stats_hdr *hdr, u8_t size, u16_t cnt,
+	   const struct stats_name_map *map, u16_t map_cnt)
+{
+	stats_init_type(hdr, STATS_TYPE_COUNTER, 1, size, cnt, map, map_cnt);
+}
+
 /**
  * Walk the group of registered statistics and call walk_func() for
  * each element in the list.  This function _DOES NOT_ lock the statistics
@@ -183,6 +227,23 @@ stats_group_get_next(const struct stats_hdr *cur)
 	return cur->s_next;
 }
 
+/**
+ * Find a statistics structure by ID, in constant time.
+ *
+ * @param id The ID assigned to the statistic structure when registered
+ *
+ * @return statistic structure if found, NULL if not found.
+ */
+struct stats_hdr *
+stats_group_find_id(u8_t id)
+{
+	if (id >= stats_id_cnt) {
+		return NULL;
+	}
+
+	return stats_ids[id];
+}
+
 /**
  * Find a statistics structure by name, this is not thread-safe.
  * (assumption: all statistics are registered prior ot OS start.)
@@ -239,6 +300,14 @@ stats_register(const char *name, struct stats_hdr *hdr)
 	}
 	hdr->s_name = name;
 
+	/* Groups beyond the table are only reachable by name. */
+	if (stats_id_cnt < ARRAY_SIZE(stats_ids)) {
+		hdr->s_id = stats_id_cnt;
+		stats_ids[stats_id_cnt++] = hdr;
+	} else {
+		hdr->s_id = STATS_ID_NONE;
+	}
+
 	return 0;
 }
 
@@ -260,10 +329,38 @@ int
 stats_init_and_reg(struct stats_hdr *shdr, u8_t size, u16_t cnt,
 		   const struct stats_name_map *map, u16_t map_cnt,
 		   const char *name)
+{
+	return stats_init_and_reg_ext(shdr, STATS_TYPE_COUNTER, 1, size, cnt,
+				      map, map_cnt, name);
+}
+
+/**
+ * Initializes and registers the specified statistics section, of any type.
+ *
+ * @param shdr The statistics header to register, the one of the first copy
+ *             for a per-CPU section.
+ * @param type The type of the statistics, one of STATS_TYPE_*.
+ * @param cpus The number of per-CPU copies of the section, 1 if it is not
+ *             per-CPU.
+ * @param size The entry size of the statistics to register either 2 (16-bit),
+ *             4 (32-bit) or 8 (64-bit).
+ * @param cnt  The number of statistics entries in the statistics structure.
+ * @param map  The map of statistics entry to statistics name, only used when
+ *             STATS_NAMES is enabled.
+ * @param map_cnt The number of elements in the statistics name map.
+ * @param name The name of the statistics element to register with the system.
+ *
+ * @return 0 on success, non-zero error code on failure.
+ */
+int
+stats_init_and_reg_ext(struct stats_hdr *shdr, u8_t type, u8_t cpus,
+		       u8_t size, u16_t cnt,
+		       const struct stats_name_map *map, u16_t map_cnt,
+		       const char *name)
 {
 	int rc;
 
-	stats_init(shdr, size, cnt, map, map_cnt);
+	stats_init_type(shdr, type, cpus, size, cnt, map, map_cnt);
 
 	rc = stats_register(name, shdr);
 	if (rc != 0) {
@@ -274,12 +371,109 @@ stats_init_and_reg(struct stats_hdr *shdr, u8_t size, u16_t cnt,
 }
 
 /**
- * Resets and zeroes the specified statistics section.
+ * Resets and zeroes the specified statistics section, all of its copies
+ * if it is per-CPU.
  *
  * @param shdr The statistics header to zero
  */
 void
 stats_reset(struct stats_hdr *hdr)
 {
-	(void)memset((u8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+	size_t stride = stats_cpu_stride(hdr);
+	u8_t *data = (u8_t *)hdr + sizeof(*hdr);
+	int i;
+
+	for (i = 0; i < hdr->s_cpus; i++) {
+		(void)memset(data, 0, hdr->s_size * hdr->s_cnt);
+		data += stride;
+	}
+}
+
+/**
+ * Reads the entry at offset off of the specified statistics section, summed
+ * over its copies if it is per-CPU. The sum wraps at the entry size, so
+ * gauges decreased on another CPU than they were increased on are right.
+ *
+ * @param hdr The statistics header of the section
+ * @param off The offset of the entry, as passed to the walk function
+ *
+ * @return The value of the entry.
+ */
+u64_t
+stats_value_get(const struct stats_hdr *hdr, u16_t off)
+{
+	size_t stride = stats_cpu_stride(hdr);
+	const u8_t *ptr = (const u8_t *)hdr + off;
+	u64_t val = 0U;
+	int i;
+
+	for (i = 0; i < hdr->s_cpus; i++) {
+		switch (hdr->s_size) {
+		case STATS_SIZE_16:
+			val += *(const u16_t *)ptr;
+			break;
+		case STATS_SIZE_32:
+			val += *(const u32_t *)ptr;
+			break;
+		default:
+			val += *(const u64_t *)ptr;
+			break;
+		}
+
+		ptr += stride;
+	}
+
+	if (hdr->s_size < sizeof(val)) {
+		val &= (1ULL << (hdr->s_size * 8U)) - 1U;
+	}
+
+	return val;
+}
+
+/**
+ * Writes the specified statistics section to buf in the binary format
+ * described in stats.h, so collectors need no name lookup per value.
+ *
+ * @param hdr The statistics header of the section to export
+ * @param buf The destination buffer
+ * @param size The size of the destination buffer
+ *
+ * @return The number of bytes written, -ENOMEM if buf is too small.
+ */
+int
+stats_group_export(const struct stats_hdr *hdr, u8_t *buf, size_t size)
+{
+	size_t len = STATS_EXPORT_HDR_LEN + hdr->s_size * hdr->s_cnt;
+	u8_t *dst = &buf[STATS_EXPORT_HDR_LEN];
+	u64_t val;
+	int i;
+
+	if (size < len) {
+		return -ENOMEM;
+	}
+
+	buf[0] = hdr->s_id;
+	buf[1] = hdr->s_type;
+	buf[2] = hdr->s_size;
+	sys_put_le16(hdr->s_cnt, &buf[3]);
+
+	for (i = 0; i < hdr->s_cnt; i++) {
+		val = stats_value_get(hdr, stats_get_off(hdr, i));
+
+		switch (hdr->s_size) {
+		case STATS_SIZE_16:
+			sys_put_le16(val, dst);
+			break;
+		case STATS_SIZE_32:
+			sys_put_le32(val, dst);
+			break;
+		default:
+			sys_put_le64(val, dst);
+			break;
+		}
+
+		dst += hdr->s_size;
+	}
+
+	return len;
 }
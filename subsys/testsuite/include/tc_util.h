@@ -82,6 +82,20 @@ static inline const char *TC_RESULT_TO_STR(int result)
 #define TC_START(name) PRINT_DATA("starting test - %s\n", name)
 #define TC_END(result, fmt, ...) PRINT_DATA(fmt, ##__VA_ARGS__)
 
+/**
+ * @brief Record a performance measurement
+ *
+ * sanitycheck collects these records and compares them with the baseline
+ * of the platform, see scripts/sanity_chk/perf_baselines. Lower values are
+ * better, except for units ending with "/s" (throughputs).
+ *
+ * @param name Name of the measurement, unique in the test
+ * @param value Measured value, an unsigned integer
+ * @param unit Unit of the value, without spaces: "ns", "cycles", "B/s"...
+ */
+#define TC_PERF_RECORD(name, value, unit) \
+	PRINT_DATA("PERF: %u %s %s\n", (unsigned int)(value), unit, name)
+
 /* prints result and the function name */
 #define Z_TC_END_RESULT(result, func)					\
 	do {								\
@@ -7,6 +7,7 @@
  */
 
 #include <init.h>
+#include <string.h>
 #include <sys/byteorder.h>
 
 #include <usb/usb_device.h>
@@ -137,27 +138,104 @@ static struct usb_ep_cfg_data bluetooth_ep_data[] = {
 	},
 };
 
+#if defined(CONFIG_BLUETOOTH_BULK_AGGREGATE)
+#define HCI_IN_XFER_SIZE CONFIG_BLUETOOTH_AGGREGATE_SIZE
+#else
+#define HCI_IN_XFER_SIZE BT_BUF_RX_SIZE
+#endif
+
+BUILD_ASSERT(HCI_IN_XFER_SIZE >= BT_BUF_RX_SIZE);
+
+/* Transfers to the host on the interrupt or bulk IN endpoint: packets are
+ * gathered in one buffer while the other one is being transferred.
+ */
+struct hci_in_xfer {
+	u8_t ep_idx;
+	u8_t cur;
+	size_t len;
+	struct k_sem done;
+	u8_t buf[2][HCI_IN_XFER_SIZE];
+};
+
+static struct hci_in_xfer evt_xfer = {
+	.ep_idx = HCI_INT_EP_IDX,
+};
+
+static struct hci_in_xfer acl_xfer = {
+	.ep_idx = HCI_IN_EP_IDX,
+};
+
+static void hci_in_xfer_cb(u8_t ep, int size, void *priv)
+{
+	struct hci_in_xfer *xfer = priv;
+
+	k_sem_give(&xfer->done);
+}
+
+static void hci_in_xfer_flush(struct hci_in_xfer *xfer)
+{
+	int ret;
+
+	if (!xfer->len) {
+		return;
+	}
+
+	/* Wait for the transfer of the other buffer to complete */
+	k_sem_take(&xfer->done, K_FOREVER);
+
+	ret = usb_transfer(bluetooth_ep_data[xfer->ep_idx].ep_addr,
+			   xfer->buf[xfer->cur], xfer->len, USB_TRANS_WRITE,
+			   hci_in_xfer_cb, xfer);
+	if (ret < 0) {
+		LOG_ERR("Transfer failed: %d", ret);
+		k_sem_give(&xfer->done);
+	}
+
+	xfer->cur ^= 1U;
+	xfer->len = 0;
+}
+
+static void hci_in_xfer_add(struct hci_in_xfer *xfer, struct net_buf *buf)
+{
+	if (xfer->len + buf->len > HCI_IN_XFER_SIZE) {
+		hci_in_xfer_flush(xfer);
+	}
+
+	memcpy(&xfer->buf[xfer->cur][xfer->len], buf->data, buf->len);
+	xfer->len += buf->len;
+
+	if (!IS_ENABLED(CONFIG_BLUETOOTH_BULK_AGGREGATE)) {
+		hci_in_xfer_flush(xfer);
+	}
+}
+
 static void hci_rx_thread(void)
 {
 	LOG_DBG("Start USB Bluetooth thread");
 
+	k_sem_init(&evt_xfer.done, 1, 1);
+	k_sem_init(&acl_xfer.done, 1, 1);
+
 	while (true) {
 		struct net_buf *buf;
 
-		buf = net_buf_get(&rx_queue, K_FOREVER);
+		buf = net_buf_get(&rx_queue, K_NO_WAIT);
+		if (!buf) {
+			/* Nothing more to gather, send what the controller
+			 * queued so far.
+			 */
+			hci_in_xfer_flush(&evt_xfer);
+			hci_in_xfer_flush(&acl_xfer);
+
+			buf = net_buf_get(&rx_queue, K_FOREVER);
+		}
 
 		switch (bt_buf_get_type(buf)) {
 		case BT_BUF_EVT:
-			usb_transfer_sync(
-				bluetooth_ep_data[HCI_INT_EP_IDX].ep_addr,
-				buf->data, buf->len,
-				USB_TRANS_WRITE);
+			hci_in_xfer_add(&evt_xfer, buf);
 			break;
 		case BT_BUF_ACL_IN:
-			usb_transfer_sync(
-				bluetooth_ep_data[HCI_IN_EP_IDX].ep_addr,
-				buf->data, buf->len,
-				USB_TRANS_WRITE);
+			hci_in_xfer_add(&acl_xfer, buf);
 			break;
 		default:
 			LOG_ERR("Unknown type %u", bt_buf_get_type(buf));
@@ -182,9 +182,21 @@ struct cdc_acm_dev_data_t {
 	bool tx_irq_ena;			/* Tx interrupt enable status */
 	bool rx_irq_ena;			/* Rx interrupt enable status */
 	u8_t rx_buf[CDC_ACM_BUFFER_SIZE];	/* Internal RX buffer */
-	u8_t tx_buf[CDC_ACM_BUFFER_SIZE];	/* Internal TX buffer */
 	struct ring_buf *rx_ringbuf;
+	/* TX data is sent straight from the ring buffer */
 	struct ring_buf *tx_ringbuf;
+#ifdef CONFIG_UART_ASYNC_API
+	uart_callback_t async_cb;
+	void *async_cb_data;
+	struct k_delayed_work tx_timeout_work;
+	const u8_t *async_tx_buf;
+	size_t async_tx_len;
+	u8_t *async_rx_buf;
+	size_t async_rx_len;
+	size_t async_rx_offset;
+	u8_t *async_rx_next_buf;
+	size_t async_rx_next_len;
+#endif
 	/* Interface data buffer */
 	/* CDC ACM line coding properties. LE order */
 	struct cdc_acm_line_coding line_coding;
@@ -267,6 +279,9 @@ static void cdc_acm_write_cb(u8_t ep, int size, void *priv)
 
 	LOG_DBG("ep %x: written %d bytes dev_data %p", ep, size, dev_data);
 
+	/* release the ring buffer region the transfer was sent from */
+	ring_buf_get_finish(dev_data->tx_ringbuf, size);
+
 	dev_data->tx_ready = true;
 
 	k_sem_give(&poll_wait_sem);
@@ -291,22 +306,103 @@ static void tx_work_handler(struct k_work *work)
 	struct device *dev = dev_data->common.dev;
 	struct usb_cfg_data *cfg = (void *)dev->config->config_info;
 	u8_t ep = cfg->endpoint[ACM_IN_EP_IDX].ep_addr;
+	u8_t *data;
 	size_t len;
+	int key;
+
+	key = irq_lock();
 
 	if (usb_transfer_is_busy(ep)) {
 		LOG_DBG("Transfer is ongoing");
+		irq_unlock(key);
 		return;
 	}
 
-	len = ring_buf_get(dev_data->tx_ringbuf, dev_data->tx_buf,
-			   sizeof(dev_data->tx_buf));
+	/* Send everything contiguous in the ring buffer as one multi-packet
+	 * transfer, the region is kept claimed until it has been sent.
+	 */
+	len = ring_buf_get_claim(dev_data->tx_ringbuf, &data,
+				 ring_buf_capacity_get(dev_data->tx_ringbuf));
+	if (!len) {
+		irq_unlock(key);
+		return;
+	}
 
 	LOG_DBG("Got %d bytes from ringbuffer send to ep %x", len, ep);
 
-	usb_transfer(ep, dev_data->tx_buf, len, USB_TRANS_WRITE,
-		     cdc_acm_write_cb, dev_data);
+	if (usb_transfer(ep, data, len, USB_TRANS_WRITE,
+			 cdc_acm_write_cb, dev_data) < 0) {
+		LOG_ERR("Transfer failed");
+		ring_buf_get_finish(dev_data->tx_ringbuf, 0);
+	}
+
+	irq_unlock(key);
+}
+
+#ifdef CONFIG_UART_ASYNC_API
+static void cdc_acm_async_evt(struct cdc_acm_dev_data_t *dev_data,
+			      struct uart_event *evt)
+{
+	if (dev_data->async_cb) {
+		dev_data->async_cb(evt, dev_data->async_cb_data);
+	}
+}
+
+static void cdc_acm_async_rx_next(struct cdc_acm_dev_data_t *dev_data)
+{
+	struct uart_event evt = {
+		.type = UART_RX_BUF_RELEASED,
+		.data.rx_buf.buf = dev_data->async_rx_buf,
+	};
+
+	cdc_acm_async_evt(dev_data, &evt);
+
+	dev_data->async_rx_buf = dev_data->async_rx_next_buf;
+	dev_data->async_rx_len = dev_data->async_rx_next_len;
+	dev_data->async_rx_offset = 0;
+	dev_data->async_rx_next_buf = NULL;
+
+	evt.type = dev_data->async_rx_buf ? UART_RX_BUF_REQUEST :
+					    UART_RX_DISABLED;
+	cdc_acm_async_evt(dev_data, &evt);
 }
 
+/* Received data is reported as soon as a transfer completes, so there
+ * is no RX timeout to wait for.
+ */
+static void cdc_acm_async_rx_put(struct cdc_acm_dev_data_t *dev_data,
+				 const u8_t *data, size_t len)
+{
+	struct uart_event evt;
+	size_t n;
+
+	while (len && dev_data->async_rx_buf) {
+		n = MIN(len, dev_data->async_rx_len - dev_data->async_rx_offset);
+		memcpy(dev_data->async_rx_buf + dev_data->async_rx_offset,
+		       data, n);
+
+		evt.type = UART_RX_RDY;
+		evt.data.rx.buf = dev_data->async_rx_buf;
+		evt.data.rx.offset = dev_data->async_rx_offset;
+		evt.data.rx.len = n;
+
+		dev_data->async_rx_offset += n;
+		data += n;
+		len -= n;
+
+		cdc_acm_async_evt(dev_data, &evt);
+
+		if (dev_data->async_rx_offset == dev_data->async_rx_len) {
+			cdc_acm_async_rx_next(dev_data);
+		}
+	}
+
+	if (len) {
+		LOG_WRN("No RX buffer, drop %d bytes", len);
+	}
+}
+#endif /* CONFIG_UART_ASYNC_API */
+
 static void cdc_acm_read_cb(u8_t ep, int size, void *priv)
 {
 	struct cdc_acm_dev_data_t *dev_data = priv;
@@ -319,6 +415,13 @@ static void cdc_acm_read_cb(u8_t ep, int size, void *priv)
 		goto done;
 	}
 
+#ifdef CONFIG_UART_ASYNC_API
+	if (dev_data->async_rx_buf) {
+		cdc_acm_async_rx_put(dev_data, dev_data->rx_buf, size);
+		goto read;
+	}
+#endif
+
 	wrote = ring_buf_put(dev_data->rx_ringbuf, dev_data->rx_buf, size);
 	if (wrote < size) {
 		LOG_ERR("Ring buffer full, drop %d bytes", size - wrote);
@@ -332,6 +435,9 @@ done:
 		k_work_submit(&dev_data->cb_work);
 	}
 
+#ifdef CONFIG_UART_ASYNC_API
+read:
+#endif
 	usb_transfer(ep, dev_data->rx_buf, sizeof(dev_data->rx_buf),
 		     USB_TRANS_READ, cdc_acm_read_cb, dev_data);
 
@@ -376,6 +482,20 @@ static void cdc_acm_reset_port(struct cdc_acm_dev_data_t *dev_data)
 	dev_data->serial_state = 0;
 	dev_data->line_state = 0;
 	memset(&dev_data->rx_buf, 0, CDC_ACM_BUFFER_SIZE);
+	/* transfers are cancelled without completion, drop claimed data */
+	ring_buf_reset(dev_data->tx_ringbuf);
+#ifdef CONFIG_UART_ASYNC_API
+	if (dev_data->async_tx_buf) {
+		struct uart_event evt = {
+			.type = UART_TX_ABORTED,
+			.data.tx.buf = dev_data->async_tx_buf,
+		};
+
+		k_delayed_work_cancel(&dev_data->tx_timeout_work);
+		dev_data->async_tx_buf = NULL;
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+#endif
 }
 
 static void cdc_acm_do_cb(struct cdc_acm_dev_data_t *dev_data,
@@ -502,6 +622,10 @@ static void cdc_acm_irq_callback_work_handler(struct k_work *work)
 	dev_data->cb(dev_data->cb_data);
 }
 
+#ifdef CONFIG_UART_ASYNC_API
+static void cdc_acm_tx_timeout_handler(struct k_work *work);
+#endif
+
 /**
  * @brief Initialize UART channel
  *
@@ -526,6 +650,10 @@ static int cdc_acm_init(struct device *dev)
 	k_sem_init(&poll_wait_sem, 0, UINT_MAX);
 	k_work_init(&dev_data->cb_work, cdc_acm_irq_callback_work_handler);
 	k_work_init(&dev_data->tx_work, tx_work_handler);
+#ifdef CONFIG_UART_ASYNC_API
+	k_delayed_work_init(&dev_data->tx_timeout_work,
+			    cdc_acm_tx_timeout_handler);
+#endif
 
 	return ret;
 }
@@ -903,6 +1031,192 @@ static int cdc_acm_line_ctrl_get(struct device *dev,
 
 #endif /* CONFIG_UART_LINE_CTRL */
 
+#ifdef CONFIG_UART_ASYNC_API
+static int cdc_acm_callback_set(struct device *dev, uart_callback_t callback,
+				void *user_data)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	dev_data->async_cb = callback;
+	dev_data->async_cb_data = user_data;
+
+	return 0;
+}
+
+static void cdc_acm_async_tx_cb(u8_t ep, int size, void *priv)
+{
+	struct cdc_acm_dev_data_t *dev_data = priv;
+	struct uart_event evt;
+
+	k_delayed_work_cancel(&dev_data->tx_timeout_work);
+
+	if (!dev_data->async_tx_buf) {
+		return;
+	}
+
+	evt.type = (size == dev_data->async_tx_len) ? UART_TX_DONE :
+						      UART_TX_ABORTED;
+	evt.data.tx.buf = dev_data->async_tx_buf;
+	evt.data.tx.len = size;
+	dev_data->async_tx_buf = NULL;
+
+	k_sem_give(&poll_wait_sem);
+	cdc_acm_async_evt(dev_data, &evt);
+
+	/* the FIFO API may have queued data meanwhile */
+	if (!ring_buf_is_empty(dev_data->tx_ringbuf)) {
+		k_work_submit(&dev_data->tx_work);
+	}
+}
+
+/*
+ * The buffer is handed to the USB stack as is and sent as one
+ * multi-packet transfer, without going through the TX ring buffer.
+ */
+static int cdc_acm_tx(struct device *dev, const u8_t *buf, size_t len,
+		      u32_t timeout)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config->config_info;
+	u8_t ep = cfg->endpoint[ACM_IN_EP_IDX].ep_addr;
+	int key;
+	int ret;
+
+	if (dev_data->usb_status != USB_DC_CONFIGURED) {
+		return -EIO;
+	}
+
+	key = irq_lock();
+
+	if (dev_data->async_tx_buf || usb_transfer_is_busy(ep)) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	dev_data->async_tx_buf = buf;
+	dev_data->async_tx_len = len;
+
+	ret = usb_transfer(ep, (u8_t *)buf, len, USB_TRANS_WRITE,
+			   cdc_acm_async_tx_cb, dev_data);
+	if (ret < 0) {
+		dev_data->async_tx_buf = NULL;
+	}
+
+	irq_unlock(key);
+
+	if (!ret && timeout != K_FOREVER) {
+		k_delayed_work_submit(&dev_data->tx_timeout_work, timeout);
+	}
+
+	return ret;
+}
+
+static int cdc_acm_tx_abort(struct device *dev)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config->config_info;
+	struct uart_event evt = {
+		.type = UART_TX_ABORTED,
+	};
+
+	if (!dev_data->async_tx_buf) {
+		return -EFAULT;
+	}
+
+	/* a cancelled transfer does not complete, the amount of data
+	 * already sent is not known.
+	 */
+	usb_cancel_transfer(cfg->endpoint[ACM_IN_EP_IDX].ep_addr);
+	k_delayed_work_cancel(&dev_data->tx_timeout_work);
+
+	evt.data.tx.buf = dev_data->async_tx_buf;
+	dev_data->async_tx_buf = NULL;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	if (!ring_buf_is_empty(dev_data->tx_ringbuf)) {
+		k_work_submit(&dev_data->tx_work);
+	}
+
+	return 0;
+}
+
+static void cdc_acm_tx_timeout_handler(struct k_work *work)
+{
+	struct cdc_acm_dev_data_t *dev_data =
+		CONTAINER_OF(work, struct cdc_acm_dev_data_t, tx_timeout_work);
+
+	(void)cdc_acm_tx_abort(dev_data->common.dev);
+}
+
+static int cdc_acm_rx_enable(struct device *dev, u8_t *buf, size_t len,
+			     u32_t timeout)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+
+	ARG_UNUSED(timeout);
+
+	if (dev_data->async_rx_buf) {
+		return -EBUSY;
+	}
+
+	dev_data->async_rx_offset = 0;
+	dev_data->async_rx_len = len;
+	dev_data->async_rx_buf = buf;
+
+	cdc_acm_async_evt(dev_data, &evt);
+
+	return 0;
+}
+
+static int cdc_acm_rx_buf_rsp(struct device *dev, u8_t *buf, size_t len)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	if (!dev_data->async_rx_buf) {
+		return -EACCES;
+	}
+
+	if (dev_data->async_rx_next_buf) {
+		return -EBUSY;
+	}
+
+	dev_data->async_rx_next_len = len;
+	dev_data->async_rx_next_buf = buf;
+
+	return 0;
+}
+
+static int cdc_acm_rx_disable(struct device *dev)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct uart_event evt = {
+		.type = UART_RX_BUF_RELEASED,
+	};
+
+	if (!dev_data->async_rx_buf) {
+		return -EFAULT;
+	}
+
+	evt.data.rx_buf.buf = dev_data->async_rx_buf;
+	dev_data->async_rx_buf = NULL;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	if (dev_data->async_rx_next_buf) {
+		evt.data.rx_buf.buf = dev_data->async_rx_next_buf;
+		dev_data->async_rx_next_buf = NULL;
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+
+	evt.type = UART_RX_DISABLED;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	return 0;
+}
+#endif /* CONFIG_UART_ASYNC_API */
+
 /*
  * @brief Poll the device for input.
  *
@@ -933,6 +1247,14 @@ static void cdc_acm_poll_out(struct device *dev,
 }
 
 static const struct uart_driver_api cdc_acm_driver_api = {
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = cdc_acm_callback_set,
+	.tx = cdc_acm_tx,
+	.tx_abort = cdc_acm_tx_abort,
+	.rx_enable = cdc_acm_rx_enable,
+	.rx_buf_rsp = cdc_acm_rx_buf_rsp,
+	.rx_disable = cdc_acm_rx_disable,
+#endif /* CONFIG_UART_ASYNC_API */
 	.poll_in = cdc_acm_poll_in,
 	.poll_out = cdc_acm_poll_out,
 	.fifo_fill = cdc_acm_fifo_fill,
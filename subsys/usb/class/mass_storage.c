@@ -48,10 +48,8 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(usb_msc);
 
-/* max USB packet size */
-#define MAX_PACKET	CONFIG_MASS_STORAGE_BULK_EP_MPS
-
 #define BLOCK_SIZE	512
+#define BUF_SIZE	(BLOCK_SIZE * CONFIG_MASS_STORAGE_BUF_BLOCKS)
 #define DISK_THREAD_STACK_SZ	512
 #define DISK_THREAD_PRIO	-5
 
@@ -107,9 +105,11 @@ static volatile int thread_op;
 static K_THREAD_STACK_DEFINE(mass_thread_stack, DISK_THREAD_STACK_SZ);
 static struct k_thread mass_thread_data;
 static struct k_sem disk_wait_sem;
-static volatile u32_t defered_wr_sz;
+static struct k_sem xfer_done_sem;
+static volatile int xfer_tsize;
 
-static u8_t page[BLOCK_SIZE];
+/* the disk is accessed through one buffer while USB moves the other */
+static u8_t page[2][BUF_SIZE];
 
 /* Initialized during mass_storage_init() */
 static u32_t memory_size;
@@ -175,6 +175,9 @@ static bool memOK;
 static void msd_state_machine_reset(void)
 {
 	stage = MSC_READ_CBW;
+
+	/* a cancelled transfer does not complete, wake up the disk thread */
+	k_sem_give(&xfer_done_sem);
 }
 
 static void msd_init(void)
@@ -365,63 +368,27 @@ static bool readCapacity(void)
 	return write(capacity, sizeof(capacity));
 }
 
-static void thread_memory_read_done(void)
+static void memoryRead(void)
 {
-	u32_t n;
-
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
-		stage = MSC_ERROR;
-	}
-
-	if (usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		&page[addr % BLOCK_SIZE], n, NULL) != 0) {
-		LOG_ERR("Failed to write EP 0x%x",
-			mass_ep_data[MSD_IN_EP_IDX].ep_addr);
-	}
-	addr += n;
-	length -= n;
-
-	csw.DataResidue -= n;
-
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
-	}
+	thread_op = THREAD_OP_READ_QUEUED;
+	LOG_DBG("Signal thread for %d", (addr/BLOCK_SIZE));
+	k_sem_give(&disk_wait_sem);
 }
 
-
-static void memoryRead(void)
+static void memoryWrite(void)
 {
-	u32_t n;
-
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
+	if ((addr + length) > memory_size) {
 		stage = MSC_ERROR;
-	}
-
-	/* we read an entire block */
-	if (!(addr % BLOCK_SIZE)) {
-		thread_op = THREAD_OP_READ_QUEUED;
-		LOG_DBG("Signal thread for %d", (addr/BLOCK_SIZE));
-		k_sem_give(&disk_wait_sem);
+		usb_ep_set_stall(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+		LOG_WRN("Stall OUT endpoint");
+		csw.Status = CSW_FAILED;
+		sendCSW();
 		return;
 	}
-	usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		  &page[addr % BLOCK_SIZE], n, NULL);
-	addr += n;
-	length -= n;
 
-	csw.DataResidue -= n;
-
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
-	}
+	thread_op = THREAD_OP_WRITE_QUEUED;
+	LOG_DBG("Disk WRITE Qd %d", (addr/BLOCK_SIZE));
+	k_sem_give(&disk_wait_sem);
 }
 
 static bool infoTransfer(void)
@@ -550,6 +517,7 @@ static void CBWDecode(u8_t *buf, u16_t size)
 			if (infoTransfer()) {
 				if (!(cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
+					memoryWrite();
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_IN_EP_IDX].ep_addr);
@@ -607,14 +575,14 @@ static void memoryVerify(u8_t *buf, u16_t size)
 	/* beginning of a new block -> load a whole block in RAM */
 	if (!(addr % BLOCK_SIZE)) {
 		LOG_DBG("Disk READ sector %d", addr/BLOCK_SIZE);
-		if (disk_access_read(disk_pdrv, page, addr/BLOCK_SIZE, 1)) {
+		if (disk_access_read(disk_pdrv, page[0], addr/BLOCK_SIZE, 1)) {
 			LOG_ERR("---- Disk Read Error %d", addr/BLOCK_SIZE);
 		}
 	}
 
 	/* info are in RAM -> no need to re-read memory */
 	for (n = 0U; n < size; n++) {
-		if (page[addr%BLOCK_SIZE + n] != buf[n]) {
+		if (page[0][addr%BLOCK_SIZE + n] != buf[n]) {
 			LOG_DBG("Mismatch sector %d offset %d",
 				addr/BLOCK_SIZE, n);
 			memOK = false;
@@ -633,50 +601,17 @@ static void memoryVerify(u8_t *buf, u16_t size)
 	}
 }
 
-static void memoryWrite(u8_t *buf, u16_t size)
-{
-	if ((addr + size) > memory_size) {
-		size = memory_size - addr;
-		stage = MSC_ERROR;
-		usb_ep_set_stall(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
-		LOG_WRN("Stall OUT endpoint");
-	}
-
-	/* we fill an array in RAM of 1 block before writing it in memory */
-	for (int i = 0; i < size; i++) {
-		page[addr % BLOCK_SIZE + i] = buf[i];
-	}
-
-	/* if the array is filled, write it in memory */
-	if (!((addr + size) % BLOCK_SIZE)) {
-		if (!(disk_access_status(disk_pdrv) &
-					DISK_STATUS_WR_PROTECT)) {
-			LOG_DBG("Disk WRITE Qd %d", (addr/BLOCK_SIZE));
-			thread_op = THREAD_OP_WRITE_QUEUED;  /* write_queued */
-			defered_wr_sz = size;
-			k_sem_give(&disk_wait_sem);
-			return;
-		}
-	}
-
-	addr += size;
-	length -= size;
-	csw.DataResidue -= size;
-
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
-	}
-}
-
-
 static void mass_storage_bulk_out(u8_t ep,
 		enum usb_dc_ep_cb_status_code ep_status)
 {
 	u32_t bytes_read = 0U;
 	u8_t bo_buf[CONFIG_MASS_STORAGE_BULK_EP_MPS];
 
-	ARG_UNUSED(ep_status);
+	/* the data stage of WRITE10/12 is received by the transfer */
+	if (usb_transfer_is_busy(ep)) {
+		usb_transfer_ep_callback(ep, ep_status);
+		return;
+	}
 
 	usb_ep_read_wait(ep, bo_buf, CONFIG_MASS_STORAGE_BULK_EP_MPS,
 			 &bytes_read);
@@ -691,11 +626,6 @@ static void mass_storage_bulk_out(u8_t ep,
 	/*the device has to receive data from the host*/
 	case MSC_PROCESS_CBW:
 		switch (cbw.CB[0]) {
-		case WRITE10:
-		case WRITE12:
-			/* LOG_DBG("> BO - PROC_CBW WR");*/
-			memoryWrite(bo_buf, bytes_read);
-			break;
 		case VERIFY10:
 			LOG_DBG("> BO - PROC_CBW VER");
 			memoryVerify(bo_buf, bytes_read);
@@ -723,22 +653,155 @@ static void mass_storage_bulk_out(u8_t ep,
 
 }
 
-static void thread_memory_write_done(void)
+static void msd_xfer_done(u8_t ep, int tsize, void *priv)
 {
-	u32_t size = defered_wr_sz;
+	ARG_UNUSED(ep);
+	ARG_UNUSED(priv);
 
-	addr += size;
-	length -= size;
-	csw.DataResidue -= size;
+	xfer_tsize = tsize;
+	k_sem_give(&xfer_done_sem);
+}
 
+/* wait for the data stage transfer of len bytes, false if it fell short */
+static bool msd_xfer_wait(u32_t len)
+{
+	k_sem_take(&xfer_done_sem, K_FOREVER);
 
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
+	if (stage != MSC_PROCESS_CBW) {
+		return false;
+	}
+
+	addr += xfer_tsize;
+	length -= xfer_tsize;
+	csw.DataResidue -= xfer_tsize;
+
+	return xfer_tsize == len;
+}
+
+static void thread_memory_read(void)
+{
+	u32_t rd_addr = addr;
+	u32_t rd_left = length;
+	u32_t pending = 0U;
+	u32_t n;
+	int idx = 0;
+
+	k_sem_reset(&xfer_done_sem);
+
+	/* only the part within the disk is sent, the command fails */
+	if ((rd_addr + rd_left) > memory_size) {
+		rd_left = (rd_addr < memory_size) ? (memory_size - rd_addr) : 0;
+	}
+
+	while (rd_left) {
+		n = MIN(rd_left, BUF_SIZE);
+		if (disk_access_read(disk_pdrv, page[idx], rd_addr / BLOCK_SIZE,
+				     n / BLOCK_SIZE)) {
+			LOG_ERR("!! Disk Read Error %d !", rd_addr / BLOCK_SIZE);
+		}
+
+		/* this chunk was read while the previous one was sent */
+		if (pending && !msd_xfer_wait(pending)) {
+			pending = 0U;
+			break;
+		}
+
+		/* the CSW follows the data, no ZLP is needed */
+		pending = 0U;
+		if (usb_transfer(mass_ep_data[MSD_IN_EP_IDX].ep_addr, page[idx],
+				 n, USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+				 msd_xfer_done, NULL) < 0) {
+			LOG_ERR("Failed to write EP 0x%x",
+				mass_ep_data[MSD_IN_EP_IDX].ep_addr);
+			break;
+		}
+
+		pending = n;
+		rd_addr += n;
+		rd_left -= n;
+		idx ^= 1;
+	}
+
+	if (pending) {
+		(void)msd_xfer_wait(pending);
+	}
+
+	if (stage != MSC_PROCESS_CBW) {
+		/* reset in the middle of the command */
+		return;
+	}
+
+	csw.Status = length ? CSW_FAILED : CSW_PASSED;
+	sendCSW();
+}
+
+static bool msd_rx_start(u8_t *buf, u32_t len)
+{
+	if (usb_transfer(mass_ep_data[MSD_OUT_EP_IDX].ep_addr, buf, len,
+			 USB_TRANS_READ, msd_xfer_done, NULL) < 0) {
+		LOG_ERR("Failed to read EP 0x%x",
+			mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+		return false;
+	}
+
+	return true;
+}
+
+static void thread_memory_write(void)
+{
+	bool wr_protect = disk_access_status(disk_pdrv) &
+			  DISK_STATUS_WR_PROTECT;
+	u32_t wr_addr = addr;
+	u32_t next;
+	u32_t n;
+	int idx = 0;
+
+	k_sem_reset(&xfer_done_sem);
+
+	n = MIN(length, BUF_SIZE);
+	if (!msd_rx_start(page[idx], n)) {
+		n = 0U;
+	}
+
+	while (n) {
+		if (!msd_xfer_wait(n)) {
+			break;
+		}
+
+		/* receive the next chunk while this one is written */
+		next = MIN(length, BUF_SIZE);
+		if (next && !msd_rx_start(page[idx ^ 1], next)) {
+			next = 0U;
+		}
+
+		if (!wr_protect &&
+		    disk_access_write(disk_pdrv, page[idx], wr_addr / BLOCK_SIZE,
+				      n / BLOCK_SIZE)) {
+			LOG_ERR("!!!!! Disk Write Error %d !!!!!",
+				wr_addr / BLOCK_SIZE);
+		}
+
+		wr_addr += n;
+		n = next;
+		idx ^= 1;
 	}
 
 	thread_op = THREAD_OP_WRITE_DONE;
 
+	if (stage != MSC_PROCESS_CBW) {
+		/* reset in the middle of the command */
+		return;
+	}
+
+	/* the host may remove the medium once the command has completed */
+	if (disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL)) {
+		LOG_ERR("!!!!! Disk Sync Error !!!!!");
+	}
+
+	csw.Status = length ? CSW_FAILED : CSW_PASSED;
+	sendCSW();
+
+	/* the endpoint stays NAKed after a transfer, wait for the next CBW */
 	usb_ep_read_continue(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
 }
 
@@ -753,22 +816,16 @@ static void thread_memory_write_done(void)
 static void mass_storage_bulk_in(u8_t ep,
 				 enum usb_dc_ep_cb_status_code ep_status)
 {
-	ARG_UNUSED(ep_status);
-	ARG_UNUSED(ep);
+	/* the data stage of READ10/12 is sent by the transfer */
+	if (usb_transfer_is_busy(ep)) {
+		usb_transfer_ep_callback(ep, ep_status);
+		return;
+	}
 
 	switch (stage) {
 	/*the device has to send data to the host*/
 	case MSC_PROCESS_CBW:
-		switch (cbw.CB[0]) {
-		case READ10:
-		case READ12:
-			/* LOG_DBG("< BI - PROC_CBW  READ"); */
-			memoryRead();
-			break;
-		default:
-			LOG_ERR("< BI-PROC_CBW default <<ERROR!!>>");
-			break;
-		}
+		LOG_ERR("< BI-PROC_CBW default <<ERROR!!>>");
 		break;
 
 	/*the device has to send a CSW*/
@@ -878,21 +935,10 @@ static void mass_thread_main(int arg1, int unused)
 
 		switch (thread_op) {
 		case THREAD_OP_READ_QUEUED:
-			if (disk_access_read(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!! Disk Read Error %d !",
-					addr/BLOCK_SIZE);
-			}
-
-			thread_memory_read_done();
+			thread_memory_read();
 			break;
 		case THREAD_OP_WRITE_QUEUED:
-			if (disk_access_write(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!!!!! Disk Write Error %d !!!!!",
-					addr/BLOCK_SIZE);
-			}
-			thread_memory_write_done();
+			thread_memory_write();
 			break;
 		default:
 			LOG_ERR("XXXXXX thread_op  %d ! XXXXX", thread_op);
@@ -946,11 +992,12 @@ static int mass_storage_init(struct device *dev)
 	memory_size = block_count * BLOCK_SIZE;
 	LOG_INF("Memory Size %d", memory_size);
 
+	k_sem_init(&disk_wait_sem, 0, 1);
+	k_sem_init(&xfer_done_sem, 0, 1);
+
 	msd_state_machine_reset();
 	msd_init();
 
-	k_sem_init(&disk_wait_sem, 0, 1);
-
 	/* Start a thread to offload disk ops */
 	k_thread_create(&mass_thread_data, mass_thread_stack,
 			DISK_THREAD_STACK_SZ,
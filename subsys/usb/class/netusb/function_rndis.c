@@ -186,8 +186,16 @@ static struct __rndis {
 	} state;
 
 	struct net_pkt *in_pkt;	/* Pointer to pkt assembling at the moment */
-	int in_pkt_len;		/* Packet length to be assembled */
-	int skip_bytes;		/* In case of low memory, skip bytes */
+	/* Header of the message being received, messages may be
+	 * concatenated in one transfer so it can span USB packets.
+	 */
+	u8_t in_hdr[sizeof(struct rndis_payload_packet)];
+	u32_t in_hdr_len;
+	u32_t in_skip;		/* Bytes to skip before the payload */
+	u32_t in_payload_len;	/* Payload bytes left to assemble */
+	u32_t in_pad;		/* Bytes to skip after the payload */
+
+	u32_t host_max_transfer;	/* Largest transfer the host accepts */
 
 	u16_t mtu;
 	u16_t speed;		/* TODO: Calculate right speed */
@@ -206,15 +214,23 @@ static struct __rndis {
 	.mtu = 1500, /* Ethernet frame */
 	.media_status = RNDIS_OBJECT_ID_MEDIA_DISCONNECTED,
 	.state = UNINITIALIZED,
-	.skip_bytes = 0,
 	.speed = 0,
 };
 
 static u8_t manufacturer[] = CONFIG_USB_DEVICE_MANUFACTURER;
 static u32_t drv_version = 1U;
 
-static u8_t tx_buf[NET_ETH_MAX_FRAME_SIZE +
-				sizeof(struct rndis_payload_packet)];
+/* Frames are gathered in one buffer while the other one is sent */
+#define RNDIS_TX_BUF_SIZE	MAX(CONFIG_RNDIS_TX_BUF_SIZE,		\
+				    NET_ETH_MAX_FRAME_SIZE +		\
+				    sizeof(struct rndis_payload_packet))
+
+static u8_t tx_buf[2][RNDIS_TX_BUF_SIZE];
+static u32_t tx_len;		/* Bytes queued in tx_buf[tx_idx] */
+static u8_t tx_idx;
+static bool tx_busy;		/* Transfer of the other buffer ongoing */
+static bool tx_filling;		/* A frame is being copied to tx_buf[tx_idx] */
+static K_SEM_DEFINE(tx_sem, 0, 1);
 
 static u32_t object_id_supported[] = {
 	RNDIS_OBJECT_ID_GEN_SUPP_LIST,
@@ -316,120 +332,154 @@ void rndis_clean(void)
 		net_pkt_unref(rndis.in_pkt);
 
 		rndis.in_pkt = NULL;
-		rndis.in_pkt_len = 0;
 	}
 
-	rndis.skip_bytes = 0;
+	rndis.in_hdr_len = 0U;
+	rndis.in_skip = 0U;
+	rndis.in_payload_len = 0U;
+	rndis.in_pad = 0U;
 }
 
-static void rndis_bulk_out(u8_t ep, enum usb_dc_ep_cb_status_code ep_status)
+/* Start a new packet once its RNDIS header has been received */
+static int rndis_rx_start(void)
 {
-	u8_t buffer[CONFIG_RNDIS_BULK_EP_MPS];
-	u32_t hdr_offset = 0U;
-	u32_t len, read;
-
-	usb_read(ep, NULL, 0, &len);
+	struct rndis_payload_packet *hdr = (void *)rndis.in_hdr;
+	u32_t offset;
+	int len;
 
-	LOG_DBG("EP 0x%x status %d len %u", ep, ep_status, len);
-
-	if (len > CONFIG_RNDIS_BULK_EP_MPS) {
-		LOG_WRN("Limit read len %u to MPS %u", len,
-			CONFIG_RNDIS_BULK_EP_MPS);
-		len = CONFIG_RNDIS_BULK_EP_MPS;
+	len = parse_rndis_header(rndis.in_hdr, sizeof(rndis.in_hdr));
+	if (len < 0) {
+		return len;
 	}
 
-	usb_read(ep, buffer, len, &read);
-	if (len != read) {
-		LOG_ERR("Read %u instead of expected %u, skip the rest",
-			    read, len);
-		rndis.skip_bytes = len - read;
-		return;
+	/* payload_offset is calculated from the start of itself */
+	offset = sys_le32_to_cpu(hdr->payload_offset) +
+		 offsetof(struct rndis_payload_packet, payload_offset);
+	if (offset < sizeof(*hdr)) {
+		LOG_ERR("Payload offset %u inside the header", offset);
+		return -EINVAL;
 	}
 
-	/* We already use frame keeping with len, warn here about
-	 * receiving frame delimeter
-	 */
-	if (len == 1U && !buffer[0]) {
-		LOG_DBG("Got frame delimeter, skip");
-		return;
+	rndis.in_skip = offset - sizeof(*hdr);
+	rndis.in_payload_len = sys_le32_to_cpu(hdr->payload_len);
+	rndis.in_pad = len - offset - rndis.in_payload_len;
+
+	rndis.in_pkt = net_pkt_alloc_with_buffer(netusb_net_iface(),
+						 rndis.in_payload_len,
+						 AF_UNSPEC, 0, K_NO_WAIT);
+	if (!rndis.in_pkt) {
+		/* In case of low memory: skip the whole packet
+		 * hoping to get buffers for later ones
+		 */
+		rndis.rx_no_buf++;
+
+		LOG_ERR("Not enough pkt buffers, skip %u bytes", len);
 	}
 
-	/* Handle skip bytes */
-	if (rndis.skip_bytes) {
-		LOG_WRN("Skip %u bytes out of remaining %d bytes",
-			len, rndis.skip_bytes);
+	return 0;
+}
+
+static void rndis_rx(const u8_t *buffer, u32_t len)
+{
+	u32_t n;
 
-		rndis.skip_bytes -= len;
+	while (len) {
+		if (rndis.in_hdr_len < sizeof(rndis.in_hdr)) {
+			n = MIN(len, sizeof(rndis.in_hdr) - rndis.in_hdr_len);
+			memcpy(rndis.in_hdr + rndis.in_hdr_len, buffer, n);
+			rndis.in_hdr_len += n;
 
-		if (rndis.skip_bytes < 0) {
-			LOG_ERR("Error skipping bytes");
+			if (rndis.in_hdr_len == sizeof(rndis.in_hdr) &&
+			    rndis_rx_start() < 0) {
+				LOG_ERR("Error parsing RNDIS header");
 
-			rndis.skip_bytes = 0;
+				rndis.rx_err++;
+				rndis_clean();
+				return;
+			}
+		} else if (rndis.in_skip) {
+			n = MIN(len, rndis.in_skip);
+			rndis.in_skip -= n;
+		} else if (rndis.in_payload_len) {
+			n = MIN(len, rndis.in_payload_len);
+			rndis.in_payload_len -= n;
+
+			if (rndis.in_pkt &&
+			    net_pkt_write(rndis.in_pkt, buffer, n)) {
+				LOG_ERR("Error writing data to pkt: %p",
+					rndis.in_pkt);
+				net_pkt_unref(rndis.in_pkt);
+				rndis.in_pkt = NULL;
+				rndis.rx_err++;
+			}
+		} else {
+			n = MIN(len, rndis.in_pad);
+			rndis.in_pad -= n;
 		}
 
-		return;
-	}
+		buffer += n;
+		len -= n;
 
-	/* Start new packet */
-	if (!rndis.in_pkt) {
-		struct net_pkt *pkt;
+		if (rndis.in_hdr_len < sizeof(rndis.in_hdr) ||
+		    rndis.in_skip || rndis.in_payload_len || rndis.in_pad) {
+			continue;
+		}
 
-		/* Append data only, skipping RNDIS header */
-		hdr_offset = sizeof(struct rndis_payload_packet);
+		if (rndis.in_pkt) {
+			LOG_DBG("Assembled full RNDIS packet");
 
-		rndis.in_pkt_len = parse_rndis_header(buffer, len);
-		if (rndis.in_pkt_len < 0) {
-			LOG_ERR("Error parsing RNDIS header");
+			if (IS_ENABLED(VERBOSE_DEBUG)) {
+				net_pkt_hexdump(rndis.in_pkt, ">");
+			}
 
-			rndis.rx_err++;
-			return;
+			/* Queue data to iface */
+			netusb_recv(rndis.in_pkt);
+			rndis.in_pkt = NULL;
 		}
 
-		pkt = net_pkt_alloc_with_buffer(netusb_net_iface(),
-						rndis.in_pkt_len,
-						AF_UNSPEC, 0, K_NO_WAIT);
-		if (!pkt) {
-			/* In case of low memory: skip the whole packet
-			 * hoping to get buffers for later ones
-			 */
-			rndis.skip_bytes = rndis.in_pkt_len - len;
-			rndis.rx_no_buf++;
+		/* Start over for the next message */
+		rndis.in_hdr_len = 0U;
+	}
+}
 
-			LOG_ERR("Not enough pkt buffers, len %u, skip %u",
-				rndis.in_pkt_len, rndis.skip_bytes);
+static void rndis_bulk_out(u8_t ep, enum usb_dc_ep_cb_status_code ep_status)
+{
+	u8_t buffer[CONFIG_RNDIS_BULK_EP_MPS];
+	u32_t len, read;
 
-			return;
-		}
+	usb_read(ep, NULL, 0, &len);
 
-		rndis.in_pkt = pkt;
+	LOG_DBG("EP 0x%x status %d len %u", ep, ep_status, len);
+
+	if (len > CONFIG_RNDIS_BULK_EP_MPS) {
+		LOG_WRN("Limit read len %u to MPS %u", len,
+			CONFIG_RNDIS_BULK_EP_MPS);
+		len = CONFIG_RNDIS_BULK_EP_MPS;
 	}
 
-	if (net_pkt_write(rndis.in_pkt,
-			  buffer + hdr_offset, len - hdr_offset)) {
-		LOG_ERR("Error writing data to pkt: %p", rndis.in_pkt);
-		rndis_clean();
+	usb_read(ep, buffer, len, &read);
+	if (len != read) {
+		LOG_ERR("Read %u instead of expected %u, drop the message",
+			    read, len);
 		rndis.rx_err++;
+		rndis_clean();
 		return;
 	}
 
-	LOG_DBG("To asemble %d bytes, reading %u bytes",
-		rndis.in_pkt_len, len);
-
-	rndis.in_pkt_len -= len;
-	if (!rndis.in_pkt_len) {
-		LOG_DBG("Assembled full RNDIS packet");
-
-		if (IS_ENABLED(VERBOSE_DEBUG)) {
-			net_pkt_hexdump(rndis.in_pkt, ">");
-		}
+	/* We already use frame keeping with len, warn here about
+	 * receiving frame delimeter
+	 */
+	if (len == 1U && !buffer[0] && !rndis.in_hdr_len) {
+		LOG_DBG("Got frame delimeter, skip");
+		return;
+	}
 
-		/* Queue data to iface */
-		netusb_recv(rndis.in_pkt);
+	rndis_rx(buffer, len);
 
-		/* Start over for new packets */
-		rndis.in_pkt = NULL;
-	} else if (rndis.in_pkt_len < 0) {
-		LOG_ERR("Error assembling packet, drop and start over");
+	/* A short packet ends the transfer, messages do not span them */
+	if (len < CONFIG_RNDIS_BULK_EP_MPS && rndis.in_hdr_len) {
+		LOG_ERR("Truncated RNDIS message, drop");
+		rndis.rx_err++;
 		rndis_clean();
 	}
 }
@@ -488,6 +538,8 @@ static int rndis_init_handle(u8_t *data, u32_t len)
 
 	LOG_DBG("req_id 0x%x", cmd->req_id);
 
+	rndis.host_max_transfer = sys_le32_to_cpu(cmd->max_transfer_size);
+
 	buf = net_buf_alloc(&rndis_tx_pool, K_NO_WAIT);
 	if (!buf) {
 		LOG_ERR("Cannot get free buffer");
@@ -505,11 +557,12 @@ static int rndis_init_handle(u8_t *data, u32_t len)
 
 	rsp->flags = sys_cpu_to_le32(RNDIS_FLAG_CONNECTIONLESS);
 	rsp->medium = sys_cpu_to_le32(RNDIS_MEDIUM_WIRED_ETHERNET);
-	rsp->max_packets = sys_cpu_to_le32(1);
-	rsp->max_transfer_size = sys_cpu_to_le32(rndis.mtu +
-						 sizeof(struct net_eth_hdr) +
-						 sizeof(struct
-							rndis_payload_packet));
+	rsp->max_packets = sys_cpu_to_le32(CONFIG_RNDIS_RX_MAX_PACKETS);
+	rsp->max_transfer_size = sys_cpu_to_le32(CONFIG_RNDIS_RX_MAX_PACKETS *
+						 (rndis.mtu +
+						  sizeof(struct net_eth_hdr) +
+						  sizeof(struct
+							 rndis_payload_packet)));
 
 	rsp->pkt_align_factor = sys_cpu_to_le32(0);
 	(void)memset(rsp->__reserved, 0, sizeof(rsp->__reserved));
@@ -961,9 +1014,66 @@ static void rndis_hdr_add(u8_t *buf, u32_t len)
 		hdr->type, hdr->len, hdr->payload_offset, hdr->payload_len);
 }
 
+static void rndis_tx_cb(u8_t ep, int size, void *priv);
+
+/* Send the frames gathered so far, must be called with interrupts locked */
+static void rndis_tx_start(void)
+{
+	u8_t *buf = tx_buf[tx_idx];
+	u32_t len = tx_len;
+
+	tx_idx ^= 1U;
+	tx_len = 0U;
+	tx_busy = true;
+
+	if (usb_transfer(rndis_ep_data[RNDIS_IN_EP_IDX].ep_addr, buf, len,
+			 USB_TRANS_WRITE, rndis_tx_cb, NULL) < 0) {
+		LOG_ERR("Transfer failure");
+		rndis.tx_err++;
+		tx_busy = false;
+	}
+}
+
+static void rndis_tx_cb(u8_t ep, int size, void *priv)
+{
+	int key;
+
+	LOG_DBG("ep %x size %u", ep, size);
+
+	key = irq_lock();
+
+	tx_busy = false;
+
+	/* Frames queued meanwhile go out together */
+	if (tx_len && !tx_filling) {
+		rndis_tx_start();
+	}
+
+	irq_unlock(key);
+
+	k_sem_give(&tx_sem);
+}
+
+/* Transfers are cancelled without completion on reset */
+static void rndis_tx_reset(void)
+{
+	int key = irq_lock();
+
+	tx_len = 0U;
+	tx_busy = false;
+
+	irq_unlock(key);
+
+	k_sem_give(&tx_sem);
+}
+
 static int rndis_send(struct net_pkt *pkt)
 {
 	size_t len = net_pkt_get_len(pkt);
+	u32_t msg_len = len + sizeof(struct rndis_payload_packet);
+	u32_t max_len;
+	u8_t *buf;
+	int key;
 	int ret;
 
 	LOG_DBG("send pkt %p len %u", pkt, len);
@@ -977,29 +1087,51 @@ static int rndis_send(struct net_pkt *pkt)
 		net_pkt_hexdump(pkt, "<");
 	}
 
-	if (len + sizeof(struct rndis_payload_packet) > sizeof(tx_buf)) {
+	if (msg_len > RNDIS_TX_BUF_SIZE) {
 		LOG_WRN("Trying to send too large packet, drop");
 		return -ENOMEM;
 	}
 
-	rndis_hdr_add(tx_buf, len);
+	max_len = MIN(RNDIS_TX_BUF_SIZE, rndis.host_max_transfer);
 
-	ret = net_pkt_read(pkt,
-			   tx_buf + sizeof(struct rndis_payload_packet),
-			   len);
-	if (ret < 0) {
-		return ret;
+	key = irq_lock();
+
+	/* Wait for room behind the frames already queued */
+	while (tx_len && (tx_len + msg_len > max_len)) {
+		if (!tx_busy) {
+			rndis_tx_start();
+			continue;
+		}
+
+		irq_unlock(key);
+		k_sem_take(&tx_sem, K_FOREVER);
+		key = irq_lock();
 	}
 
-	ret = usb_transfer_sync(rndis_ep_data[RNDIS_IN_EP_IDX].ep_addr,	tx_buf,
-				len + sizeof(struct rndis_payload_packet),
-				USB_TRANS_WRITE);
-	if (ret != len + sizeof(struct rndis_payload_packet)) {
-		LOG_ERR("Transfer failure");
-		return ret;
+	buf = tx_buf[tx_idx] + tx_len;
+	tx_filling = true;
+
+	irq_unlock(key);
+
+	rndis_hdr_add(buf, len);
+
+	ret = net_pkt_read(pkt, buf + sizeof(struct rndis_payload_packet), len);
+
+	key = irq_lock();
+
+	tx_filling = false;
+
+	if (!ret) {
+		tx_len += msg_len;
 	}
 
-	return 0;
+	if (tx_len && !tx_busy) {
+		rndis_tx_start();
+	}
+
+	irq_unlock(key);
+
+	return ret;
 }
 
 #if defined(CONFIG_USB_DEVICE_OS_DESC)
@@ -1129,10 +1261,15 @@ static void rndis_status_cb(struct usb_cfg_data *cfg,
 	case USB_DC_DISCONNECTED:
 		LOG_DBG("USB device disconnected");
 		netusb_disable();
+		rndis_tx_reset();
 		break;
 
-	case USB_DC_ERROR:
 	case USB_DC_RESET:
+		LOG_DBG("USB device reset detected");
+		rndis_tx_reset();
+		break;
+
+	case USB_DC_ERROR:
 	case USB_DC_CONNECTED:
 	case USB_DC_SUSPEND:
 	case USB_DC_RESUME:
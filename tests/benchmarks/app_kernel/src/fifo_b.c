@@ -28,7 +28,7 @@ void queue_test(void)
 	}
 	et = TIME_STAMP_DELTA_GET(et);
 
-	PRINT_F(output_file, FORMAT, "enqueue 1 byte msg in FIFO",
+	PRINT_PERF("enqueue 1 byte msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	et = BENCH_START();
@@ -38,7 +38,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "dequeue 1 byte msg in FIFO",
+	PRINT_PERF("dequeue 1 byte msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	et = BENCH_START();
@@ -48,7 +48,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "enqueue 4 bytes msg in FIFO",
+	PRINT_PERF("enqueue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	et = BENCH_START();
@@ -58,7 +58,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
+	PRINT_PERF("dequeue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	k_sem_give(&STARTRCV);
@@ -70,7 +70,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
+	PRINT_PERF(
 			"enqueue 1 byte msg in FIFO to a waiting higher priority task",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
@@ -81,7 +81,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
+	PRINT_PERF(
 			"enqueue 4 bytes in FIFO to a waiting higher priority task",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 }
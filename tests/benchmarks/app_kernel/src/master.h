@@ -21,6 +21,8 @@
 
 #include <sys/util.h>
 
+#include <tc_util.h>
+
 
 /* uncomment the define below to use floating point arithmetic */
 /* #define FLOAT */
@@ -169,6 +171,15 @@ extern struct k_mem_pool DEMOPOOL;
 	PRINT_STRING(sline, stream);					\
 }
 
+/* PRINT_PERF
+ * Macro to print a measurement in the table, and as a performance record
+ */
+#define PRINT_PERF(name, ns)						\
+{									\
+	PRINT_F(output_file, FORMAT, name, ns);				\
+	TC_PERF_RECORD(name, ns, "ns");					\
+}
+
 #define PRINT_OVERFLOW_ERROR()						\
 	PRINT_F(output_file, __FILE__":%d Error: tick occurred\n", __LINE__)
 
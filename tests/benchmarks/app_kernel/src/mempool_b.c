@@ -38,7 +38,7 @@ void mempool_test(void)
 	if (return_value != 0) {
 		k_panic();
 	}
-	PRINT_F(output_file, FORMAT,
+	PRINT_PERF(
 		"average alloc and dealloc memory pool block",
 		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_POOL_RUNS)));
 }
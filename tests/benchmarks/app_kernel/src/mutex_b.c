@@ -30,7 +30,7 @@ void mutex_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "average lock and unlock mutex",
+	PRINT_PERF("average lock and unlock mutex",
 		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_MUTEX_RUNS)));
 }
 
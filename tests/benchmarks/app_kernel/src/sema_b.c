@@ -30,7 +30,7 @@ void sema_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "signal semaphore",
+	PRINT_PERF("signal semaphore",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_SEMA_RUNS));
 
 	k_sem_reset(&SEM1);
@@ -43,7 +43,7 @@ void sema_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "signal to waiting high pri task",
+	PRINT_PERF("signal to waiting high pri task",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_SEMA_RUNS));
 
 	et = BENCH_START();
@@ -53,7 +53,7 @@ void sema_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
+	PRINT_PERF(
 			"signal to waiting high pri task, with timeout",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_SEMA_RUNS));
 
@@ -17,6 +17,8 @@
  */
 
 #include <zephyr.h>
+#include <device.h>
+#include <init.h>
 
 #include <tc_util.h>
 
@@ -24,6 +26,8 @@
 extern u64_t __start_time_stamp;    /* timestamp when kernel begins executing */
 extern u64_t __main_time_stamp;     /* timestamp when main() begins executing */
 extern u64_t __idle_time_stamp;     /* timestamp when CPU went idle */
+extern struct device __device_init_start[];
+extern struct device __device_init_end[];
 
 void main(void)
 {
@@ -72,6 +76,21 @@ void main(void)
 		 (u32_t)(s_idle_time_stamp & 0xFFFFFFFFULL),
 		 (u32_t)  (idle_us  & 0xFFFFFFFFULL));
 
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	for (s32_t level = _SYS_INIT_LEVEL_PRE_KERNEL_1;
+	     level <= _SYS_INIT_LEVEL_APPLICATION; level++) {
+		TC_PRINT("init level %d  : %u cycles\n", level,
+			 device_init_level_cycles_get(level));
+	}
+
+	for (struct device *dev = __device_init_start;
+	     dev < __device_init_end; dev++) {
+		TC_PRINT("  %-12s: %u cycles\n",
+			 dev->config->name != NULL ? dev->config->name : "-",
+			 device_init_cycles_get(dev));
+	}
+#endif
+
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	/* for sanity regression test utility. */
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <cmsis_os2.h>
+#include <cmsis_types.h>
+
+/* Times the CMSIS-RTOS v2 calls ported stacks use in their hot paths, in
+ * the format of the application kernel benchmark so that the cost of the
+ * layer can be read against the native kernel services measured there.
+ */
+
+#define NR_OF_RUNS 1000
+
+#define STACKSZ CONFIG_CMSIS_V2_THREAD_MAX_STACK_SIZE
+
+#define FORMAT "| %-65s|%10u|\n"
+
+#define FLAG 0x1
+
+static const char dashline[] =
+	"|--------------------------------------"
+	"---------------------------------------|\n";
+
+static K_THREAD_STACK_DEFINE(receiver_stack, STACKSZ);
+static struct cv2_thread receiver_cb;
+
+static struct cv2_sem sem_cb;
+static struct cv2_mutex mutex_cb;
+static struct cv2_msgq msgq_cb;
+static struct cv2_event_flags event_flags_cb;
+
+static u32_t msgq_buf[16];
+
+static osSemaphoreId_t sem;
+static osMutexId_t mutex;
+static osMessageQueueId_t msgq;
+static osEventFlagsId_t event_flags;
+
+static u32_t bench_start(void)
+{
+	/* Start on a fresh tick so that it does not interfere */
+	k_sleep(1);
+
+	return k_cycle_get_32();
+}
+
+static void print_result(const char *name, u32_t start)
+{
+	u32_t cycles = k_cycle_get_32() - start;
+
+	printk(FORMAT, name,
+	       (u32_t)SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cycles, NR_OF_RUNS));
+}
+
+/* Runs fn at a priority above the benchmark, it starts right away */
+static void receiver_start(osThreadFunc_t fn)
+{
+	const osThreadAttr_t attr = {
+		.name = "Receiver",
+		.cb_mem = &receiver_cb,
+		.cb_size = sizeof(receiver_cb),
+		.stack_mem = &receiver_stack,
+		.stack_size = STACKSZ,
+		.priority = osPriorityRealtime,
+	};
+
+	osThreadNew(fn, NULL, &attr);
+}
+
+static void sem_receiver(void *arg)
+{
+	int i;
+
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osSemaphoreAcquire(sem, osWaitForever);
+	}
+}
+
+static void msgq_receiver(void *arg)
+{
+	u32_t msg;
+	int i;
+
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osMessageQueueGet(msgq, &msg, NULL, osWaitForever);
+	}
+}
+
+static void event_flags_receiver(void *arg)
+{
+	int i;
+
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osEventFlagsWait(event_flags, FLAG, osFlagsWaitAny,
+				 osWaitForever);
+	}
+}
+
+static void sem_bench(void)
+{
+	u32_t start;
+	int i;
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osSemaphoreRelease(sem);
+		osSemaphoreAcquire(sem, 0);
+	}
+	print_result("release and acquire semaphore", start);
+
+	receiver_start(sem_receiver);
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osSemaphoreRelease(sem);
+	}
+	print_result("release semaphore to waiting high pri thread", start);
+}
+
+static void mutex_bench(void)
+{
+	u32_t start;
+	int i;
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osMutexAcquire(mutex, osWaitForever);
+		osMutexRelease(mutex);
+	}
+	print_result("acquire and release mutex", start);
+}
+
+static void msgq_bench(void)
+{
+	u32_t msg = 0U;
+	u32_t start;
+	int i;
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osMessageQueuePut(msgq, &msg, 0, 0);
+		osMessageQueueGet(msgq, &msg, NULL, 0);
+	}
+	print_result("put and get 4 byte message", start);
+
+	receiver_start(msgq_receiver);
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osMessageQueuePut(msgq, &msg, 0, osWaitForever);
+	}
+	print_result("put 4 byte message to waiting high pri thread", start);
+}
+
+static void event_flags_bench(void)
+{
+	u32_t start;
+	int i;
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osEventFlagsSet(event_flags, FLAG);
+		osEventFlagsWait(event_flags, FLAG, osFlagsWaitAny, 0);
+	}
+	print_result("set and wait event flags", start);
+
+	receiver_start(event_flags_receiver);
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		osEventFlagsSet(event_flags, FLAG);
+	}
+	print_result("set event flags to waiting high pri thread", start);
+}
+
+static void create_bench(void)
+{
+	const osSemaphoreAttr_t static_attr = {
+		.cb_mem = &sem_cb,
+		.cb_size = sizeof(sem_cb),
+	};
+	osSemaphoreId_t id;
+	u32_t start;
+	int i;
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		id = osSemaphoreNew(1, 0, NULL);
+		osSemaphoreDelete(id);
+	}
+	print_result("create and delete semaphore", start);
+
+	start = bench_start();
+	for (i = 0; i < NR_OF_RUNS; i++) {
+		id = osSemaphoreNew(1, 0, &static_attr);
+		osSemaphoreDelete(id);
+	}
+	print_result("create and delete semaphore, caller cb_mem", start);
+}
+
+void main(void)
+{
+	const osMutexAttr_t mutex_attr = {
+		.attr_bits = osMutexPrioInherit,
+		.cb_mem = &mutex_cb,
+		.cb_size = sizeof(mutex_cb),
+	};
+	const osMessageQueueAttr_t msgq_attr = {
+		.cb_mem = &msgq_cb,
+		.cb_size = sizeof(msgq_cb),
+		.mq_mem = msgq_buf,
+		.mq_size = sizeof(msgq_buf),
+	};
+	const osEventFlagsAttr_t event_flags_attr = {
+		.cb_mem = &event_flags_cb,
+		.cb_size = sizeof(event_flags_cb),
+	};
+
+	sem = osSemaphoreNew(NR_OF_RUNS, 0, NULL);
+	mutex = osMutexNew(&mutex_attr);
+	msgq = osMessageQueueNew(ARRAY_SIZE(msgq_buf), sizeof(msgq_buf[0]),
+				 &msgq_attr);
+	event_flags = osEventFlagsNew(&event_flags_attr);
+
+	if (!sem || !mutex || !msgq || !event_flags) {
+		printk("PROJECT EXECUTION FAILED\n");
+		return;
+	}
+
+	printk("%s", dashline);
+	printk("| %-76s|\n", "CMSIS-RTOS v2 BENCHMARK");
+	printk("%s", dashline);
+	printk("| %-65s|%-10s|\n", "call", "nsec");
+	printk("%s", dashline);
+
+	sem_bench();
+	mutex_bench();
+	msgq_bench();
+	event_flags_bench();
+	create_bench();
+
+	printk("%s", dashline);
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+}
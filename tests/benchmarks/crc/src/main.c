@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/crc.h>
+
+/* Measures each CRC helper over a few buffer lengths, from the size of an
+ * NVS allocation table entry to that of a flash page, and prints the
+ * average cycles per call together with the result so that the
+ * implementations selected by the different scenarios can be compared.
+ */
+
+#define ITERATIONS 64
+
+#define BUF_SIZE 4096
+
+static u8_t buf[BUF_SIZE];
+
+static const size_t lengths[] = { 8, 64, 256, BUF_SIZE };
+
+enum algo {
+	CRC7_BE,
+	CRC8_CCITT,
+	CRC16_CCITT,
+	CRC16_ITU_T,
+	CRC16_ANSI,
+	CRC32_IEEE,
+};
+
+static const char *const names[] = {
+	[CRC7_BE] = "crc7_be",
+	[CRC8_CCITT] = "crc8_ccitt",
+	[CRC16_CCITT] = "crc16_ccitt",
+	[CRC16_ITU_T] = "crc16_itu_t",
+	[CRC16_ANSI] = "crc16_ansi",
+	[CRC32_IEEE] = "crc32_ieee",
+};
+
+static u32_t compute(enum algo a, size_t len)
+{
+	switch (a) {
+	case CRC7_BE:
+		return crc7_be(0, buf, len);
+	case CRC8_CCITT:
+		return crc8_ccitt(0xff, buf, len);
+	case CRC16_CCITT:
+		return crc16_ccitt(0xffff, buf, len);
+	case CRC16_ITU_T:
+		return crc16_itu_t(0xffff, buf, len);
+	case CRC16_ANSI:
+		return crc16_ansi(buf, len);
+	case CRC32_IEEE:
+		return crc32_ieee(buf, len);
+	}
+
+	return 0;
+}
+
+static u32_t measure(enum algo a, size_t len, u32_t *crc)
+{
+	u32_t start, cycles;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		*crc = compute(a, len);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return cycles / ITERATIONS;
+}
+
+void main(void)
+{
+	size_t i, l;
+	int a;
+
+	for (i = 0; i < sizeof(buf); i++) {
+		buf[i] = i * 131 + 7;
+	}
+
+	printk("CRC benchmark, crc32_ieee %s\n",
+	       IS_ENABLED(CONFIG_CRC32_IEEE_STM32) ? "STM32 CRC unit" :
+	       IS_ENABLED(CONFIG_CRC32_IEEE_SLICING_BY_8) ? "slicing-by-8" :
+	       IS_ENABLED(CONFIG_CRC32_IEEE_TABLE) ? "byte table" :
+	       "bitwise");
+
+	for (a = CRC7_BE; a <= CRC32_IEEE; a++) {
+		for (l = 0; l < ARRAY_SIZE(lengths); l++) {
+			u32_t crc, cycles;
+
+			cycles = measure(a, lengths[l], &crc);
+
+			printk("%-11s %4u bytes: %7u cycles, %08x\n",
+			       names[a], (unsigned int)lengths[l], cycles, crc);
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <tc_util.h>
+#include <drivers/gna.h>
+
+/* Measures how many inferences per second the GNA delivers on the model of
+ * the build: for one request at a time, each waited for, then with the
+ * request queue of the driver kept full, with single frame and batched
+ * requests. Completions are waited for with k_poll().
+ */
+
+/* Image of the model: its struct gna_model_header padded to 64 bytes,
+ * followed by its rw_region and ro_region.
+ */
+#define MODEL_OFFSET 64
+
+static u8_t __aligned(64) model_image[] = {
+#include "gna_model.inc"
+};
+
+#define BATCH_FRAMES 8
+#define MAX_DEPTH (CONFIG_INTEL_GNA_MAX_PENDING_REQUESTS + 1)
+#define BUF_SIZE 16384
+
+/* Long enough to span many ticks */
+#define DURATION_MS 2000
+
+/* The requests all read the same input and overwrite the same output */
+static u8_t input[BUF_SIZE];
+static u8_t output[BUF_SIZE];
+
+static struct gna_inference_req reqs[MAX_DEPTH];
+static struct k_poll_signal signals[MAX_DEPTH];
+static struct k_poll_event events[MAX_DEPTH];
+
+static int submit(struct device *gna, int i)
+{
+	k_poll_signal_reset(&signals[i]);
+	events[i].state = K_POLL_STATE_NOT_READY;
+
+	return gna_infer(gna, &reqs[i], NULL);
+}
+
+static void run(struct device *gna, void *model, const char *name,
+		int depth, u32_t frames)
+{
+	u32_t inferences = 0U;
+	int pending = 0;
+	s64_t start;
+	int i;
+
+	for (i = 0; i < depth; i++) {
+		reqs[i].model_handle = model;
+		reqs[i].input = input;
+		reqs[i].output = output;
+		reqs[i].frames = frames;
+		reqs[i].signal = &signals[i];
+		k_poll_signal_init(&signals[i]);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &signals[i]);
+	}
+
+	start = k_uptime_get();
+
+	for (i = 0; i < depth; i++) {
+		if (submit(gna, i)) {
+			TC_PRINT("%s: request not accepted\n", name);
+			events[i].type = K_POLL_TYPE_IGNORE;
+			continue;
+		}
+		pending++;
+	}
+
+	while (pending) {
+		k_poll(events, depth, K_FOREVER);
+
+		for (i = 0; i < depth; i++) {
+			unsigned int signaled;
+			int result;
+
+			if (events[i].type == K_POLL_TYPE_IGNORE) {
+				continue;
+			}
+
+			k_poll_signal_check(&signals[i], &signaled, &result);
+			if (!signaled) {
+				continue;
+			}
+
+			pending--;
+			if (result == GNA_RESULT_INFERENCE_COMPLETE) {
+				inferences += frames;
+			} else {
+				TC_PRINT("%s: inference failed (%d)\n", name,
+					 result);
+			}
+
+			if (result == GNA_RESULT_INFERENCE_COMPLETE &&
+			    k_uptime_get() - start < DURATION_MS &&
+			    submit(gna, i) == 0) {
+				pending++;
+			} else {
+				/* keep it out of the next k_poll() */
+				events[i].type = K_POLL_TYPE_IGNORE;
+			}
+		}
+	}
+
+	inferences = (u64_t)inferences * MSEC_PER_SEC /
+		     (k_uptime_get() - start);
+
+	TC_PRINT("%-40s %6u inferences/s\n", name, inferences);
+	TC_PERF_RECORD(name, inferences, "inferences/s");
+}
+
+void main(void)
+{
+	struct gna_model_header *header = (void *)model_image;
+	struct gna_model_info info = {
+		.header = header,
+		.rw_region = &model_image[MODEL_OFFSET],
+	};
+	struct gna_config config;
+	struct device *gna;
+	void *model;
+
+	TC_START("GNA benchmark");
+
+	if (header->bytes_per_input * header->num_input_nodes * BATCH_FRAMES >
+	    BUF_SIZE ||
+	    header->bytes_per_output * header->num_output_nodes *
+	    BATCH_FRAMES > BUF_SIZE) {
+		TC_PRINT("Frames of the model larger than %u bytes\n",
+			 BUF_SIZE / BATCH_FRAMES);
+		TC_END_REPORT(TC_FAIL);
+		return;
+	}
+
+	gna = device_get_binding(CONFIG_INTEL_GNA_NAME);
+	if (!gna || gna_configure(gna, &config) ||
+	    gna_register_model(gna, &info, &model)) {
+		TC_PRINT("Cannot register the model on %s\n",
+			 CONFIG_INTEL_GNA_NAME);
+		TC_END_REPORT(TC_FAIL);
+		return;
+	}
+
+	run(gna, model, "gna single frame, one request", 1, 1);
+	run(gna, model, "gna single frame, queued", MAX_DEPTH, 1);
+	run(gna, model, "gna batch of 8 frames, queued", MAX_DEPTH,
+	    BATCH_FRAMES);
+
+	gna_deregister_model(gna, model);
+
+	TC_END_REPORT(TC_PASS);
+}
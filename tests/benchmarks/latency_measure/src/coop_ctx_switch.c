@@ -115,6 +115,8 @@ int coop_ctx_switch(void)
 			     timestamp / ctx_switch_counter,
 			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(timestamp,
 							   ctx_switch_counter));
+		TC_PERF_RECORD("Cooperative context switch",
+			       timestamp / ctx_switch_counter, "cycles");
 	}
 
 	return 0;
@@ -75,6 +75,8 @@ int int_to_thread(void)
 	if (flag_var == 1) {
 		PRINT_FORMAT(" switching time is %u tcs = %u nsec",
 			     timestamp, SYS_CLOCK_HW_CYCLES_TO_NS(timestamp));
+		TC_PERF_RECORD("ISR to interrupted thread switch", timestamp,
+			       "cycles");
 	}
 	return 0;
 }
@@ -93,5 +93,6 @@ int int_to_thread_evt(void)
 
 	PRINT_FORMAT(" switch time is %u tcs = %u nsec",
 		     timestamp, SYS_CLOCK_HW_CYCLES_TO_NS(timestamp));
+	TC_PERF_RECORD("ISR to other thread switch", timestamp, "cycles");
 	return 0;
 }
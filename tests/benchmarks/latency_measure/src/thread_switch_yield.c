@@ -103,5 +103,8 @@ void thread_switch_yield(void)
 			     timestamp / (iterations + helper_thread_iterations),
 			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(timestamp,
 							   (iterations + helper_thread_iterations)));
+		TC_PERF_RECORD("Thread yield context switch",
+			       timestamp / (iterations + helper_thread_iterations),
+			       "cycles");
 	}
 }
@@ -19,6 +19,7 @@
 #include <sys/printk.h>
 #include <stdio.h>
 #include "timestamp.h"
+#include <tc_util.h>
 extern char tmp_string[];
 extern int error_count;
 
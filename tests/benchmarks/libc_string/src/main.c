@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+/* Measures the string and memory routines of the C library of the build,
+ * minimal libc or newlib, for a few lengths and alignments. Calls go
+ * through volatile pointers so the compiler cannot replace them with its
+ * builtins. Results are the average cycles per call.
+ */
+
+#define ITERATIONS 256
+
+#define BUF_SIZE 1024
+
+static char src[BUF_SIZE + 8] __aligned(8);
+static char dst[BUF_SIZE + 8] __aligned(8);
+
+static const size_t lengths[] = { 8, 32, 128, 1024 };
+
+static const struct {
+	size_t src;
+	size_t dst;
+} alignments[] = {
+	{ 0, 0 },
+	{ 1, 1 },
+	{ 1, 3 },
+};
+
+static size_t (*volatile strlen_fn)(const char *) = strlen;
+static char *(*volatile strchr_fn)(const char *, int) = strchr;
+static int (*volatile strcmp_fn)(const char *, const char *) = strcmp;
+static int (*volatile memcmp_fn)(const void *, const void *, size_t) = memcmp;
+static void *(*volatile memcpy_fn)(void *, const void *, size_t) = memcpy;
+static void *(*volatile memset_fn)(void *, int, size_t) = memset;
+
+enum routine {
+	STRLEN,
+	STRCHR,
+	STRCMP,
+	MEMCMP,
+	MEMCPY,
+	MEMSET,
+};
+
+static const char *const names[] = {
+	[STRLEN] = "strlen",
+	[STRCHR] = "strchr",
+	[STRCMP] = "strcmp",
+	[MEMCMP] = "memcmp",
+	[MEMCPY] = "memcpy",
+	[MEMSET] = "memset",
+};
+
+/* Strings of len characters, equal in both buffers */
+static void prepare(size_t s_off, size_t d_off, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		src[s_off + i] = 'a' + (i % 26);
+		dst[d_off + i] = 'a' + (i % 26);
+	}
+
+	src[s_off + len] = '\0';
+	dst[d_off + len] = '\0';
+}
+
+static u32_t measure(enum routine r, char *s, char *d, size_t len)
+{
+	u32_t start, cycles;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		switch (r) {
+		case STRLEN:
+			(void)strlen_fn(s);
+			break;
+		case STRCHR:
+			/* The byte is not in the string */
+			(void)strchr_fn(s, '#');
+			break;
+		case STRCMP:
+			(void)strcmp_fn(s, d);
+			break;
+		case MEMCMP:
+			(void)memcmp_fn(s, d, len);
+			break;
+		case MEMCPY:
+			(void)memcpy_fn(d, s, len);
+			break;
+		case MEMSET:
+			(void)memset_fn(d, 0x5a, len);
+			break;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return cycles / ITERATIONS;
+}
+
+void main(void)
+{
+	size_t a, l;
+	int r;
+
+	printk("libc string benchmark, %s\n",
+	       IS_ENABLED(CONFIG_NEWLIB_LIBC) ? "newlib" :
+	       IS_ENABLED(CONFIG_MINIMAL_LIBC_STRING_WORD_ACCESS) ?
+	       "minimal libc, word access" : "minimal libc");
+
+	for (r = STRLEN; r <= MEMSET; r++) {
+		for (l = 0; l < ARRAY_SIZE(lengths); l++) {
+			for (a = 0; a < ARRAY_SIZE(alignments); a++) {
+				size_t s_off = alignments[a].src;
+				size_t d_off = alignments[a].dst;
+				u32_t cycles;
+
+				prepare(s_off, d_off, lengths[l]);
+				cycles = measure(r, src + s_off, dst + d_off,
+						 lengths[l]);
+
+				printk("%-6s %4u bytes align %u/%u: %6u cycles\n",
+				       names[r], (unsigned int)lengths[l],
+				       (unsigned int)s_off,
+				       (unsigned int)d_off, cycles);
+			}
+		}
+	}
+
+	printk("fin\n");
+}
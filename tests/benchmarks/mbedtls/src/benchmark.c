@@ -71,6 +71,7 @@
 #include <sys/byteorder.h>
 
 #include "kernel.h"
+#include "handshake.h"
 
 #include <sys/printk.h>
 #define  MBEDTLS_PRINT ((int(*)(const char *, ...)) printk)
@@ -1061,6 +1062,9 @@ int main(int argc, char *argv[])
 		}
 	}
 #endif
+
+	handshake_benchmark();
+
 	mbedtls_printf("\n       Done\n");
 
 	return 0;
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Full TLS handshake between a client and a server context of the same
+ * image, connected back to back through memory buffers. Reports the time
+ * of a complete handshake and the peak heap taken by both contexts.
+ */
+
+#if !defined(CONFIG_MBEDTLS_CFG_FILE)
+#include "mbedtls/config.h"
+#else
+#include CONFIG_MBEDTLS_CFG_FILE
+#endif /* CONFIG_MBEDTLS_CFG_FILE */
+
+#include <zephyr.h>
+#include <string.h>
+#include <random/rand32.h>
+
+#include "handshake.h"
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include <mbedtls/platform.h>
+#else
+#include <stdio.h>
+#define mbedtls_printf     printf
+#endif
+
+#if defined(MBEDTLS_SSL_CLI_C) && defined(MBEDTLS_SSL_SRV_C) && \
+	defined(MBEDTLS_KEY_EXCHANGE_PSK_ENABLED)
+
+#include <mbedtls/ssl.h>
+#include <mbedtls/ssl_ciphersuites.h>
+
+#if defined(CONFIG_MBEDTLS_HEAP_POOL)
+#include <sys/mbedtls_heap_pool.h>
+#elif defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C) && defined(MBEDTLS_MEMORY_DEBUG)
+#include <mbedtls/memory_buffer_alloc.h>
+#endif
+
+#define HANDSHAKES 8
+
+/* Large enough for the whole server flight */
+#define PIPE_SIZE 2048
+
+struct pipe {
+	size_t len;
+	u8_t buf[PIPE_SIZE];
+};
+
+struct endpoint {
+	struct pipe *tx;
+	struct pipe *rx;
+};
+
+static struct pipe to_server;
+static struct pipe to_client;
+
+static struct endpoint client_end = { .tx = &to_server, .rx = &to_client };
+static struct endpoint server_end = { .tx = &to_client, .rx = &to_server };
+
+static const u8_t psk[16] = "zephyr-benchmark";
+static const char psk_id[] = "benchmark";
+
+static const struct {
+	const char *name;
+	int ciphersuite[2];
+} suites[] = {
+	{ "PSK-AES128-CBC-SHA256",
+	  { MBEDTLS_TLS_PSK_WITH_AES_128_CBC_SHA256, 0 } },
+#if defined(MBEDTLS_KEY_EXCHANGE_ECDHE_PSK_ENABLED)
+	{ "ECDHE-PSK-AES128-CBC-SHA256",
+	  { MBEDTLS_TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA256, 0 } },
+#endif
+};
+
+static int pipe_send(void *ctx, const unsigned char *buf, size_t len)
+{
+	struct pipe *pipe = ((struct endpoint *)ctx)->tx;
+
+	len = MIN(len, sizeof(pipe->buf) - pipe->len);
+	if (len == 0) {
+		return MBEDTLS_ERR_SSL_WANT_WRITE;
+	}
+
+	memcpy(pipe->buf + pipe->len, buf, len);
+	pipe->len += len;
+
+	return len;
+}
+
+static int pipe_recv(void *ctx, unsigned char *buf, size_t len)
+{
+	struct pipe *pipe = ((struct endpoint *)ctx)->rx;
+
+	len = MIN(len, pipe->len);
+	if (len == 0) {
+		return MBEDTLS_ERR_SSL_WANT_READ;
+	}
+
+	memcpy(buf, pipe->buf, len);
+	pipe->len -= len;
+	memmove(pipe->buf, pipe->buf + len, pipe->len);
+
+	return len;
+}
+
+static int rng(void *ctx, unsigned char *buf, size_t len)
+{
+	ARG_UNUSED(ctx);
+
+	while (len) {
+		u32_t rnd = sys_rand32_get();
+		size_t n = MIN(len, sizeof(rnd));
+
+		memcpy(buf, &rnd, n);
+		buf += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+static int conf_setup(mbedtls_ssl_config *conf, int endpoint,
+		      const int *ciphersuites)
+{
+	int ret;
+
+	ret = mbedtls_ssl_config_defaults(conf, endpoint,
+					  MBEDTLS_SSL_TRANSPORT_STREAM,
+					  MBEDTLS_SSL_PRESET_DEFAULT);
+	if (ret != 0) {
+		return ret;
+	}
+
+	mbedtls_ssl_conf_rng(conf, rng, NULL);
+	mbedtls_ssl_conf_ciphersuites(conf, ciphersuites);
+
+	return mbedtls_ssl_conf_psk(conf, psk, sizeof(psk),
+				    (const u8_t *)psk_id, strlen(psk_id));
+}
+
+static void heap_peak_reset(void)
+{
+#if defined(CONFIG_MBEDTLS_HEAP_POOL)
+	mbedtls_heap_pool_peak_reset();
+#elif defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C) && defined(MBEDTLS_MEMORY_DEBUG)
+	mbedtls_memory_buffer_alloc_max_reset();
+#endif
+}
+
+static size_t heap_peak_get(void)
+{
+#if defined(CONFIG_MBEDTLS_HEAP_POOL)
+	struct mbedtls_heap_pool_stats stats;
+
+	mbedtls_heap_pool_stats_get(&stats);
+
+	return stats.peak_bytes;
+#elif defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C) && defined(MBEDTLS_MEMORY_DEBUG)
+	size_t used, blocks;
+
+	mbedtls_memory_buffer_alloc_max_get(&used, &blocks);
+
+	return used;
+#else
+	return 0;
+#endif
+}
+
+/* Runs both sides in turn until each of them completed the handshake */
+static int handshake(mbedtls_ssl_context *client, mbedtls_ssl_context *server)
+{
+	int cli_ret, srv_ret;
+
+	do {
+		cli_ret = mbedtls_ssl_handshake(client);
+		if (cli_ret != 0 && cli_ret != MBEDTLS_ERR_SSL_WANT_READ &&
+		    cli_ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+			return cli_ret;
+		}
+
+		srv_ret = mbedtls_ssl_handshake(server);
+		if (srv_ret != 0 && srv_ret != MBEDTLS_ERR_SSL_WANT_READ &&
+		    srv_ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+			return srv_ret;
+		}
+	} while (cli_ret != 0 || srv_ret != 0);
+
+	return 0;
+}
+
+static int handshake_run(const int *ciphersuites, u32_t *cycles)
+{
+	mbedtls_ssl_config cli_conf, srv_conf;
+	mbedtls_ssl_context client, server;
+	u32_t start;
+	int ret;
+
+	mbedtls_ssl_config_init(&cli_conf);
+	mbedtls_ssl_config_init(&srv_conf);
+	mbedtls_ssl_init(&client);
+	mbedtls_ssl_init(&server);
+	to_server.len = 0;
+	to_client.len = 0;
+
+	start = k_cycle_get_32();
+
+	ret = conf_setup(&cli_conf, MBEDTLS_SSL_IS_CLIENT, ciphersuites);
+	if (ret == 0) {
+		ret = conf_setup(&srv_conf, MBEDTLS_SSL_IS_SERVER,
+				 ciphersuites);
+	}
+
+	if (ret == 0) {
+		ret = mbedtls_ssl_setup(&client, &cli_conf);
+	}
+
+	if (ret == 0) {
+		ret = mbedtls_ssl_setup(&server, &srv_conf);
+	}
+
+	if (ret == 0) {
+		mbedtls_ssl_set_bio(&client, &client_end, pipe_send,
+				    pipe_recv, NULL);
+		mbedtls_ssl_set_bio(&server, &server_end, pipe_send,
+				    pipe_recv, NULL);
+		ret = handshake(&client, &server);
+	}
+
+	*cycles = k_cycle_get_32() - start;
+
+	mbedtls_ssl_free(&client);
+	mbedtls_ssl_free(&server);
+	mbedtls_ssl_config_free(&cli_conf);
+	mbedtls_ssl_config_free(&srv_conf);
+
+	return ret;
+}
+
+void handshake_benchmark(void)
+{
+	u64_t total;
+	u32_t cycles;
+	size_t peak;
+	int i, j;
+	int ret;
+
+	for (i = 0; i < ARRAY_SIZE(suites); i++) {
+		mbedtls_printf("  %-28s :  ", suites[i].name);
+
+		heap_peak_reset();
+		total = 0U;
+		ret = 0;
+
+		for (j = 0; ret == 0 && j < HANDSHAKES; j++) {
+			ret = handshake_run(suites[i].ciphersuite, &cycles);
+			total += cycles;
+		}
+
+		if (ret != 0) {
+			mbedtls_printf("FAILED: -0x%04x\n", -ret);
+			continue;
+		}
+
+		peak = heap_peak_get();
+
+		mbedtls_printf("%9u us/handshake, %6u heap bytes\n",
+			       (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(total) /
+				       (NSEC_PER_USEC * HANDSHAKES)),
+			       (u32_t)peak);
+	}
+}
+
+#else
+
+void handshake_benchmark(void)
+{
+	mbedtls_printf("  TLS handshake benchmark needs PSK key exchange\n");
+}
+
+#endif
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __HANDSHAKE_H__
+#define __HANDSHAKE_H__
+
+/* Times full TLS handshakes and reports their peak heap usage */
+void handshake_benchmark(void);
+
+#endif /* __HANDSHAKE_H__ */
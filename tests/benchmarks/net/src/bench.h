@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_BENCH_H__
+#define __NET_BENCH_H__
+
+#include <zephyr.h>
+#include <net/net_ip.h>
+
+/* Per-operation timings, in hardware cycles */
+struct bench_timing {
+	u64_t total;
+	u32_t min;
+	u32_t max;
+	u32_t count;
+};
+
+static inline void bench_timing_init(struct bench_timing *timing)
+{
+	timing->total = 0U;
+	timing->min = 0xFFFFFFFFU;
+	timing->max = 0U;
+	timing->count = 0U;
+}
+
+static inline void bench_timing_add(struct bench_timing *timing,
+				    u32_t start)
+{
+	u32_t cycles = k_cycle_get_32() - start;
+
+	timing->total += cycles;
+	timing->min = MIN(timing->min, cycles);
+	timing->max = MAX(timing->max, cycles);
+	timing->count++;
+}
+
+/* Print one result as a JSON object on its own line */
+void bench_report(const char *name, u32_t value, const char *unit);
+
+/* Print the average, and the minimum and maximum if asked, in ns */
+void bench_report_timing(const char *name, struct bench_timing *timing,
+			 bool min_max);
+
+/* Rate of count events over ms milliseconds, 0 if no time elapsed */
+u32_t bench_rate(u64_t count, s64_t ms);
+
+extern struct in6_addr bench_addr;
+
+void bench_udp(void);
+void bench_tcp(void);
+void bench_stack(void);
+void bench_6lo(void);
+
+#endif /* __NET_BENCH_H__ */
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Network stack benchmarks: UDP rate and latency and TCP throughput
+ * through sockets over the loopback interface, per-layer cost of the
+ * receive path, and 6LoWPAN header compression rate.
+ *
+ * Each result is printed as a JSON object on its own line, such as
+ *
+ * {"suite":"net","name":"udp_pps","value":12345,"unit":"pkt/s"}
+ *
+ * so that results can be collected from the console output and compared
+ * across releases.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+#include "bench.h"
+
+struct in6_addr bench_addr;
+
+void bench_report(const char *name, u32_t value, const char *unit)
+{
+	printk("{\"suite\":\"net\",\"name\":\"%s\",\"value\":%u,"
+	       "\"unit\":\"%s\"}\n", name, value, unit);
+}
+
+void bench_report_timing(const char *name, struct bench_timing *timing,
+			 bool min_max)
+{
+	char metric[32];
+	u64_t avg = 0U;
+
+	if (timing->count) {
+		avg = timing->total / timing->count;
+	}
+
+	bench_report(name, SYS_CLOCK_HW_CYCLES_TO_NS(avg), "ns");
+
+	if (!min_max || !timing->count) {
+		return;
+	}
+
+	snprintk(metric, sizeof(metric), "%s_min", name);
+	bench_report(metric, SYS_CLOCK_HW_CYCLES_TO_NS(timing->min), "ns");
+
+	snprintk(metric, sizeof(metric), "%s_max", name);
+	bench_report(metric, SYS_CLOCK_HW_CYCLES_TO_NS(timing->max), "ns");
+}
+
+u32_t bench_rate(u64_t count, s64_t ms)
+{
+	if (ms <= 0) {
+		return 0U;
+	}
+
+	return (u32_t)(count * MSEC_PER_SEC / ms);
+}
+
+void main(void)
+{
+	int ret;
+
+	ret = inet_pton(AF_INET6, CONFIG_NET_CONFIG_MY_IPV6_ADDR, &bench_addr);
+	if (ret != 1) {
+		printk("Invalid address %s\n", CONFIG_NET_CONFIG_MY_IPV6_ADDR);
+		return;
+	}
+
+	printk("net benchmark start\n");
+
+	bench_stack();
+	bench_6lo();
+	bench_udp();
+	bench_tcp();
+
+	printk("net benchmark done\n");
+}
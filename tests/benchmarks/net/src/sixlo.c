@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* 6LoWPAN IPHC compression and uncompression of a link-local IPv6/UDP
+ * header, the common case for 802.15.4 and Bluetooth traffic.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_pkt.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+#include "6lo.h"
+
+#include "bench.h"
+
+#define SIXLO_PORT 4303
+#define SIXLO_PAYLOAD 32
+#define SIXLO_ROUNDS 1000
+
+#if defined(CONFIG_NET_6LO)
+
+static u8_t src_mac[8] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static u8_t dst_mac[8] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+static u8_t payload[SIXLO_PAYLOAD];
+
+static struct net_pkt *create_pkt(void)
+{
+	struct in6_addr src, dst;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(), sizeof(payload),
+					AF_INET6, IPPROTO_UDP, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	net_pkt_lladdr_src(pkt)->addr = src_mac;
+	net_pkt_lladdr_src(pkt)->len = sizeof(src_mac);
+	net_pkt_lladdr_dst(pkt)->addr = dst_mac;
+	net_pkt_lladdr_dst(pkt)->len = sizeof(dst_mac);
+
+	net_ipv6_addr_create_iid(&src, net_pkt_lladdr_src(pkt));
+	net_ipv6_addr_create_iid(&dst, net_pkt_lladdr_dst(pkt));
+
+	if (net_ipv6_create(pkt, &src, &dst) ||
+	    net_udp_create(pkt, htons(SIXLO_PORT), htons(SIXLO_PORT)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv6_finalize(pkt, IPPROTO_UDP)) {
+		goto fail;
+	}
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+void bench_6lo(void)
+{
+	struct bench_timing compress, uncompress;
+	struct net_pkt *pkt;
+	size_t len;
+	int saved = 0;
+	int ret;
+	int i;
+
+	pkt = create_pkt();
+	if (!pkt) {
+		printk("Cannot create 6lo packet\n");
+		return;
+	}
+
+	len = net_pkt_get_len(pkt);
+
+	bench_timing_init(&compress);
+	bench_timing_init(&uncompress);
+
+	/* Uncompressing restores the packet, so the same one is reused */
+	for (i = 0; i < SIXLO_ROUNDS; i++) {
+		u32_t t = k_cycle_get_32();
+
+		net_pkt_cursor_init(pkt);
+
+		ret = net_6lo_compress(pkt, true);
+		if (ret < 0) {
+			printk("Cannot compress (%d)\n", ret);
+			break;
+		}
+
+		bench_timing_add(&compress, t);
+
+		saved = len - net_pkt_get_len(pkt);
+
+		t = k_cycle_get_32();
+
+		if (!net_6lo_uncompress(pkt)) {
+			printk("Cannot uncompress\n");
+			break;
+		}
+
+		bench_timing_add(&uncompress, t);
+	}
+
+	bench_report_timing("6lo_compress", &compress, false);
+	bench_report_timing("6lo_uncompress", &uncompress, false);
+	bench_report("6lo_hdr_saved", saved, "B");
+
+	net_pkt_unref(pkt);
+}
+
+#else
+
+void bench_6lo(void)
+{
+}
+
+#endif /* CONFIG_NET_6LO */
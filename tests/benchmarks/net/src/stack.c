@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Cost of the layers a UDP packet goes through, measured by calling them
+ * directly instead of going through the loopback driver and RX thread.
+ * The figures nest: building a packet includes allocating it, and the
+ * input includes IPv6, UDP, connection demux and queueing to the socket.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_pkt.h>
+#include <net/socket.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+
+#include "bench.h"
+
+#define STACK_PORT 4302
+#define STACK_PAYLOAD 64
+#define STACK_ROUNDS 1000
+
+static u8_t payload[STACK_PAYLOAD];
+
+static struct net_pkt *build_pkt(struct net_if *iface, bool rx)
+{
+	struct net_pkt *pkt;
+
+	if (rx) {
+		pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(payload),
+						   AF_INET6, IPPROTO_UDP,
+						   K_NO_WAIT);
+	} else {
+		pkt = net_pkt_alloc_with_buffer(iface, sizeof(payload),
+						AF_INET6, IPPROTO_UDP,
+						K_NO_WAIT);
+	}
+
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_ipv6_create(pkt, &bench_addr, &bench_addr) ||
+	    net_udp_create(pkt, htons(STACK_PORT), htons(STACK_PORT)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv6_finalize(pkt, IPPROTO_UDP)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+static void bench_alloc(struct net_if *iface)
+{
+	struct bench_timing alloc, build;
+	struct net_pkt *pkt;
+	int i;
+
+	bench_timing_init(&alloc);
+	bench_timing_init(&build);
+
+	for (i = 0; i < STACK_ROUNDS; i++) {
+		u32_t t = k_cycle_get_32();
+
+		pkt = net_pkt_alloc_with_buffer(iface, sizeof(payload),
+						AF_INET6, IPPROTO_UDP,
+						K_NO_WAIT);
+		if (!pkt) {
+			continue;
+		}
+
+		net_pkt_unref(pkt);
+		bench_timing_add(&alloc, t);
+
+		t = k_cycle_get_32();
+
+		pkt = build_pkt(iface, false);
+		if (!pkt) {
+			continue;
+		}
+
+		net_pkt_unref(pkt);
+		bench_timing_add(&build, t);
+	}
+
+	bench_report_timing("pkt_alloc_free", &alloc, false);
+	bench_report_timing("ipv6_udp_build", &build, false);
+}
+
+static void bench_input(struct net_if *iface)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(STACK_PORT),
+		.sin6_addr = bench_addr,
+	};
+	struct bench_timing input, recv_time;
+	u8_t buf[STACK_PAYLOAD];
+	struct net_pkt *pkt;
+	u32_t t;
+	int sock;
+	int i;
+
+	sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		printk("Cannot create UDP socket (%d)\n", errno);
+		return;
+	}
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("Cannot bind (%d)\n", errno);
+		goto out;
+	}
+
+	bench_timing_init(&input);
+	bench_timing_init(&recv_time);
+
+	for (i = 0; i < STACK_ROUNDS; i++) {
+		pkt = build_pkt(iface, true);
+		if (!pkt) {
+			continue;
+		}
+
+		t = k_cycle_get_32();
+
+		if (net_ipv6_input(pkt, true) != NET_OK) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		bench_timing_add(&input, t);
+
+		t = k_cycle_get_32();
+
+		if (recv(sock, buf, sizeof(buf), MSG_DONTWAIT) !=
+		    sizeof(buf)) {
+			continue;
+		}
+
+		bench_timing_add(&recv_time, t);
+	}
+
+	bench_report_timing("ipv6_udp_input", &input, false);
+	bench_report_timing("socket_recv", &recv_time, false);
+
+out:
+	(void)close(sock);
+}
+
+void bench_stack(void)
+{
+	struct net_if *iface = net_if_get_default();
+
+	bench_alloc(iface);
+	bench_input(iface);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP bulk throughput through sockets, like zperf: a thread uploads a
+ * fixed amount of data which the main thread receives.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+#include "bench.h"
+
+#define TCP_PORT 4301
+#define TCP_CHUNK 1024
+#define TCP_TOTAL (256 * 1024)
+#define TCP_STACK_SIZE 2048
+/* Lower than main, so that the receiver drains as data arrives */
+#define TCP_PRIORITY 8
+
+/* Let the closed connections go through TIME_WAIT */
+#define TCP_TEARDOWN_TIMEOUT K_SECONDS(1)
+
+static K_THREAD_STACK_DEFINE(uploader_stack, TCP_STACK_SIZE);
+static struct k_thread uploader_thread;
+
+static u8_t tx_buf[TCP_CHUNK];
+static u8_t rx_buf[TCP_CHUNK];
+
+static struct sockaddr_in6 server_addr = {
+	.sin6_family = AF_INET6,
+	.sin6_port = htons(TCP_PORT),
+};
+
+static void uploader(void *p1, void *p2, void *p3)
+{
+	size_t sent = 0;
+	ssize_t ret;
+	int sock;
+
+	sock = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return;
+	}
+
+	if (connect(sock, (struct sockaddr *)&server_addr,
+		    sizeof(server_addr)) < 0) {
+		printk("Cannot connect (%d)\n", errno);
+		goto out;
+	}
+
+	while (sent < TCP_TOTAL) {
+		ret = send(sock, tx_buf, MIN(sizeof(tx_buf), TCP_TOTAL - sent),
+			   0);
+		if (ret < 0) {
+			printk("Cannot send (%d)\n", errno);
+			break;
+		}
+
+		sent += ret;
+	}
+
+out:
+	(void)close(sock);
+}
+
+void bench_tcp(void)
+{
+	struct sockaddr_in6 addr;
+	socklen_t addrlen = sizeof(addr);
+	size_t received = 0;
+	s64_t start;
+	ssize_t ret;
+	int sock, conn;
+
+	server_addr.sin6_addr = bench_addr;
+
+	sock = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		printk("Cannot create TCP socket (%d)\n", errno);
+		return;
+	}
+
+	if (bind(sock, (struct sockaddr *)&server_addr,
+		 sizeof(server_addr)) < 0 || listen(sock, 1) < 0) {
+		printk("Cannot listen (%d)\n", errno);
+		goto out;
+	}
+
+	k_thread_create(&uploader_thread, uploader_stack,
+			K_THREAD_STACK_SIZEOF(uploader_stack), uploader,
+			NULL, NULL, NULL, TCP_PRIORITY, 0, K_NO_WAIT);
+
+	conn = accept(sock, (struct sockaddr *)&addr, &addrlen);
+	if (conn < 0) {
+		printk("Cannot accept (%d)\n", errno);
+		goto out;
+	}
+
+	start = k_uptime_get();
+
+	do {
+		ret = recv(conn, rx_buf, sizeof(rx_buf), 0);
+		if (ret > 0) {
+			received += ret;
+		}
+	} while (ret > 0);
+
+	/* kbit/s from bytes per millisecond */
+	bench_report("tcp_throughput",
+		     bench_rate(received * 8U, k_uptime_get() - start) / 1000U,
+		     "kbit/s");
+	bench_report("tcp_received", received, "B");
+
+	/* The uploader has closed its end, its thread is done */
+	(void)close(conn);
+
+out:
+	(void)close(sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* UDP packet rate and round trip latency through sockets */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+#include "bench.h"
+
+#define UDP_PORT 4300
+#define UDP_PAYLOAD 64
+#define UDP_PACKETS 4000
+/* Datagrams sent before reading them back, fits the packet pools */
+#define UDP_BATCH 8
+#define UDP_ROUNDS 1000
+#define UDP_TIMEOUT MSEC_PER_SEC
+
+static u8_t payload[UDP_PAYLOAD];
+
+static int udp_pair(int *tx, int *rx)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(UDP_PORT),
+		.sin6_addr = bench_addr,
+	};
+
+	*rx = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	*tx = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (*rx < 0 || *tx < 0) {
+		return -errno;
+	}
+
+	if (bind(*rx, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    connect(*tx, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+/* Receive a datagram, false if none came in time */
+static bool udp_recv(int sock)
+{
+	struct pollfd fds = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+	u8_t buf[UDP_PAYLOAD];
+
+	if (poll(&fds, 1, UDP_TIMEOUT) <= 0) {
+		return false;
+	}
+
+	return recv(sock, buf, sizeof(buf), 0) == sizeof(buf);
+}
+
+void bench_udp(void)
+{
+	struct bench_timing rtt;
+	u32_t received = 0U;
+	s64_t start;
+	int tx, rx;
+	int i, j;
+
+	if (udp_pair(&tx, &rx) < 0) {
+		printk("Cannot create UDP sockets (%d)\n", errno);
+		goto out;
+	}
+
+	/* Packet rate, in bursts so that the queues do not overflow */
+	start = k_uptime_get();
+
+	for (i = 0; i < UDP_PACKETS; i += UDP_BATCH) {
+		for (j = 0; j < UDP_BATCH; j++) {
+			(void)send(tx, payload, sizeof(payload), 0);
+		}
+
+		for (j = 0; j < UDP_BATCH; j++) {
+			if (!udp_recv(rx)) {
+				break;
+			}
+
+			received++;
+		}
+	}
+
+	bench_report("udp_pps", bench_rate(received, k_uptime_get() - start),
+		     "pkt/s");
+	bench_report("udp_lost", UDP_PACKETS - received, "pkt");
+
+	/* Latency from send() to the end of recv() */
+	bench_timing_init(&rtt);
+
+	for (i = 0; i < UDP_ROUNDS; i++) {
+		u32_t t = k_cycle_get_32();
+
+		(void)send(tx, payload, sizeof(payload), 0);
+		if (!udp_recv(rx)) {
+			continue;
+		}
+
+		bench_timing_add(&rtt, t);
+	}
+
+	bench_report_timing("udp_latency", &rtt, true);
+
+out:
+	(void)close(tx);
+	(void)close(rx);
+}
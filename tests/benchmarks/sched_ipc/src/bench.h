@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_BENCHMARKS_SCHED_IPC_SRC_BENCH_H_
+#define ZEPHYR_TESTS_BENCHMARKS_SCHED_IPC_SRC_BENCH_H_
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define N_RUNS 100
+#define N_SETTLE 10
+
+#define STACK_SIZE 1024
+
+/* Threads of the benchmarks, relative to main at K_PRIO_COOP(2) */
+#define PARTNER_PRIO K_PRIO_COOP(1)
+#define PENDED_FILLER_PRIO K_PRIO_COOP(0)
+#define READY_FILLER_PRIO K_PRIO_PREEMPT(1)
+#define VICTIM_PRIO K_PRIO_PREEMPT(2)
+
+#define MAX_FILLERS 32
+
+static inline u32_t bench_stamp(void)
+{
+	return k_cycle_get_32();
+}
+
+/* Running average of the measurements after the settle runs */
+struct bench_avg {
+	u64_t tot;
+	u32_t runs;
+};
+
+static inline void bench_avg_add(struct bench_avg *avg, u32_t cycles)
+{
+	if (++avg->runs > N_SETTLE) {
+		avg->tot += cycles;
+	}
+}
+
+static inline u32_t bench_avg_get(struct bench_avg *avg)
+{
+	if (avg->runs <= N_SETTLE) {
+		return 0;
+	}
+
+	return avg->tot / (avg->runs - N_SETTLE);
+}
+
+static inline void bench_report(const char *name, struct bench_avg *avg)
+{
+	u32_t cycles = bench_avg_get(avg);
+
+	TC_PRINT("%-40s %6u cycles\n", name, cycles);
+	TC_PERF_RECORD(name, cycles, "cycles");
+}
+
+/* Bytes per second of len bytes moved in the given cycles */
+static inline void bench_report_rate(const char *name, u32_t len,
+				     u32_t cycles)
+{
+	u32_t rate = cycles ? ((u64_t)len * sys_clock_hw_cycles_per_sec()) /
+			      cycles : 0;
+
+	TC_PRINT("%-40s %6u B/s\n", name, rate);
+	TC_PERF_RECORD(name, rate, "B/s");
+}
+
+void bench_wakeup(void);
+void bench_timeout(void);
+void bench_poll(void);
+void bench_ipc(void);
+void bench_smp(void);
+
+#endif /* ZEPHYR_TESTS_BENCHMARKS_SCHED_IPC_SRC_BENCH_H_ */
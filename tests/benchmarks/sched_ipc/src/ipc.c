@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Throughput of message queues, pipes and FIFOs moving small messages
+ * from main to a consumer thread, and hand off of a contended mutex.
+ */
+
+#include "bench.h"
+
+#define MSG_SIZE 16
+#define MSG_COUNT 1000
+#define MSGQ_LEN 8
+#define PIPE_SIZE 64
+
+static struct k_thread consumer_thread;
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+K_MSGQ_DEFINE(data_msgq, MSG_SIZE, MSGQ_LEN, 4);
+K_PIPE_DEFINE(data_pipe, PIPE_SIZE, 4);
+K_FIFO_DEFINE(data_fifo);
+K_FIFO_DEFINE(free_fifo);
+
+struct fifo_msg {
+	void *fifo_reserved;
+	u8_t data[MSG_SIZE];
+};
+
+static struct fifo_msg fifo_msgs[MSGQ_LEN];
+
+static K_MUTEX_DEFINE(mutex);
+static K_SEM_DEFINE(contend_sem, 0, 1);
+static volatile u32_t locked;
+
+static void msgq_consumer(void *arg1, void *arg2, void *arg3)
+{
+	u8_t data[MSG_SIZE];
+
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < MSG_COUNT; i++) {
+		k_msgq_get(&data_msgq, data, K_FOREVER);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void pipe_consumer(void *arg1, void *arg2, void *arg3)
+{
+	u8_t data[MSG_SIZE];
+	size_t read;
+
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < MSG_COUNT; i++) {
+		k_pipe_get(&data_pipe, data, sizeof(data), &read, sizeof(data),
+			   K_FOREVER);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void fifo_consumer(void *arg1, void *arg2, void *arg3)
+{
+	struct fifo_msg *msg;
+
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < MSG_COUNT; i++) {
+		msg = k_fifo_get(&data_fifo, K_FOREVER);
+		k_fifo_put(&free_fifo, msg);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void consumer_start(k_thread_entry_t fn)
+{
+	k_thread_create(&consumer_thread, consumer_stack,
+			K_THREAD_STACK_SIZEOF(consumer_stack), fn,
+			NULL, NULL, NULL, PARTNER_PRIO, 0, K_NO_WAIT);
+
+	/* Let the consumer wait for the first message */
+	k_sleep(10);
+}
+
+static void bench_msgq(void)
+{
+	u8_t data[MSG_SIZE] = { 0 };
+	u32_t t0;
+
+	consumer_start(msgq_consumer);
+
+	t0 = bench_stamp();
+	for (int i = 0; i < MSG_COUNT; i++) {
+		k_msgq_put(&data_msgq, data, K_FOREVER);
+	}
+	k_sem_take(&done_sem, K_FOREVER);
+
+	bench_report_rate("msgq throughput", MSG_SIZE * MSG_COUNT,
+			  bench_stamp() - t0);
+}
+
+static void bench_pipe(void)
+{
+	u8_t data[MSG_SIZE] = { 0 };
+	size_t written;
+	u32_t t0;
+
+	consumer_start(pipe_consumer);
+
+	t0 = bench_stamp();
+	for (int i = 0; i < MSG_COUNT; i++) {
+		k_pipe_put(&data_pipe, data, sizeof(data), &written,
+			   sizeof(data), K_FOREVER);
+	}
+	k_sem_take(&done_sem, K_FOREVER);
+
+	bench_report_rate("pipe throughput", MSG_SIZE * MSG_COUNT,
+			  bench_stamp() - t0);
+}
+
+static void bench_fifo(void)
+{
+	struct fifo_msg *msg;
+	u32_t t0;
+
+	for (int i = 0; i < ARRAY_SIZE(fifo_msgs); i++) {
+		k_fifo_put(&free_fifo, &fifo_msgs[i]);
+	}
+
+	consumer_start(fifo_consumer);
+
+	t0 = bench_stamp();
+	for (int i = 0; i < MSG_COUNT; i++) {
+		msg = k_fifo_get(&free_fifo, K_FOREVER);
+		k_fifo_put(&data_fifo, msg);
+	}
+	k_sem_take(&done_sem, K_FOREVER);
+
+	bench_report_rate("fifo throughput", MSG_SIZE * MSG_COUNT,
+			  bench_stamp() - t0);
+
+	while (k_fifo_get(&free_fifo, K_NO_WAIT) != NULL) {
+	}
+}
+
+static void contender_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&contend_sem, K_FOREVER);
+		k_mutex_lock(&mutex, K_FOREVER);
+		locked = bench_stamp();
+		k_mutex_unlock(&mutex);
+	}
+}
+
+static void bench_mutex(void)
+{
+	struct bench_avg handoff = { 0 };
+	u32_t t0;
+
+	k_thread_create(&consumer_thread, consumer_stack,
+			K_THREAD_STACK_SIZEOF(consumer_stack), contender_fn,
+			NULL, NULL, NULL, PARTNER_PRIO, 0, K_NO_WAIT);
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		k_mutex_lock(&mutex, K_FOREVER);
+
+		/* The contender blocks on the mutex held by main */
+		k_sem_give(&contend_sem);
+		k_yield();
+
+		t0 = bench_stamp();
+		k_mutex_unlock(&mutex);
+		k_yield();
+		bench_avg_add(&handoff, locked - t0);
+	}
+
+	k_thread_abort(&consumer_thread);
+
+	bench_report("mutex handoff", &handoff);
+}
+
+void bench_ipc(void)
+{
+	bench_msgq();
+	bench_pipe();
+	bench_fifo();
+	bench_mutex();
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "bench.h"
+
+void main(void)
+{
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(2));
+
+	TC_START("Scheduler and IPC benchmarks");
+
+#if defined(CONFIG_SMP)
+	/* The other benchmarks expect the threads they wake to preempt
+	 * main on its own CPU, only the cross-CPU wakeup is measured.
+	 */
+	bench_smp();
+#else
+	bench_wakeup();
+	bench_timeout();
+	bench_poll();
+	bench_ipc();
+#endif
+
+	TC_END_REPORT(TC_PASS);
+}
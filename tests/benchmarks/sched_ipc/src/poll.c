@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* k_poll() on semaphores: cost of a call finding the last event ready,
+ * and latency from k_sem_give() to a waiting poller running.
+ */
+
+#include "bench.h"
+
+#define MAX_EVENTS 16
+
+static struct k_thread poller_thread;
+static K_THREAD_STACK_DEFINE(poller_stack, STACK_SIZE);
+
+static struct k_sem sems[MAX_EVENTS];
+static struct k_poll_event events[MAX_EVENTS];
+
+static volatile u32_t woken;
+
+static void poller_fn(void *arg1, void *arg2, void *arg3)
+{
+	int n = POINTER_TO_INT(arg1);
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_poll(events, n, K_FOREVER);
+		woken = bench_stamp();
+		events[n - 1].state = K_POLL_STATE_NOT_READY;
+		k_sem_take(&sems[n - 1], K_NO_WAIT);
+	}
+}
+
+static void poll_run(int n)
+{
+	struct bench_avg ready = { 0 }, wake = { 0 };
+	char buf[48];
+	u32_t t0, t1;
+
+	for (int i = 0; i < n; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+	}
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		k_sem_give(&sems[n - 1]);
+		t0 = bench_stamp();
+		k_poll(events, n, K_NO_WAIT);
+		t1 = bench_stamp();
+		bench_avg_add(&ready, t1 - t0);
+		events[n - 1].state = K_POLL_STATE_NOT_READY;
+		k_sem_take(&sems[n - 1], K_NO_WAIT);
+	}
+
+	k_thread_create(&poller_thread, poller_stack,
+			K_THREAD_STACK_SIZEOF(poller_stack), poller_fn,
+			INT_TO_POINTER(n), NULL, NULL, PARTNER_PRIO, 0,
+			K_NO_WAIT);
+	k_sleep(10);
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		t0 = bench_stamp();
+		k_sem_give(&sems[n - 1]);
+
+		/* Main is cooperative, the poller runs once it yields and
+		 * switches back when it polls again.
+		 */
+		k_yield();
+		bench_avg_add(&wake, woken - t0);
+	}
+
+	k_thread_abort(&poller_thread);
+
+	snprintk(buf, sizeof(buf), "poll ready %d", n);
+	bench_report(buf, &ready);
+	snprintk(buf, sizeof(buf), "poll wakeup %d", n);
+	bench_report(buf, &wake);
+}
+
+void bench_poll(void)
+{
+	static const int polled[] = { 1, 4, MAX_EVENTS };
+
+	for (int i = 0; i < ARRAY_SIZE(polled); i++) {
+		poll_run(polled[i]);
+	}
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Latency of waking a thread on another CPU: main, cooperative, gives a
+ * semaphore and spins until the woken thread has run, which can only
+ * happen on another CPU.
+ */
+
+#include <kernel_structs.h>
+#include "bench.h"
+
+static struct k_thread remote_thread;
+static K_THREAD_STACK_DEFINE(remote_stack, STACK_SIZE);
+
+static K_SEM_DEFINE(wake_sem, 0, 1);
+
+static volatile u32_t woken;
+static volatile int woken_cpu;
+static volatile bool done;
+
+static int cpu_id(void)
+{
+	unsigned int key = irq_lock();
+	int id = _current_cpu->id;
+
+	irq_unlock(key);
+
+	return id;
+}
+
+static void remote_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&wake_sem, K_FOREVER);
+		woken = bench_stamp();
+		woken_cpu = cpu_id();
+		done = true;
+	}
+}
+
+void bench_smp(void)
+{
+	struct bench_avg wake = { 0 };
+	int local = 0;
+	u32_t t0;
+
+	k_thread_create(&remote_thread, remote_stack,
+			K_THREAD_STACK_SIZEOF(remote_stack), remote_fn,
+			NULL, NULL, NULL, PARTNER_PRIO, 0, K_NO_WAIT);
+	k_sleep(10);
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		done = false;
+		t0 = bench_stamp();
+		k_sem_give(&wake_sem);
+
+		while (!done) {
+		}
+
+		/* Only keep wakeups which did cross CPUs */
+		if (woken_cpu != cpu_id()) {
+			bench_avg_add(&wake, woken - t0);
+		} else {
+			local++;
+		}
+
+		/* Let the remote thread go back to waiting */
+		k_sleep(1);
+	}
+
+	k_thread_abort(&remote_thread);
+
+	if (local != 0) {
+		TC_PRINT("%d wakeups ran on the waking CPU\n", local);
+	}
+
+	bench_report("smp wakeup", &wake);
+}
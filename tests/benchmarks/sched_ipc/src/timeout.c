@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Cost of arming and aborting a timeout expiring after all the others
+ * already armed, which takes the longest walk in a sorted timeout list.
+ */
+
+#include <timeout_q.h>
+#include "bench.h"
+
+#define MAX_TIMEOUTS 256
+
+/* Far enough not to expire while the benchmark runs */
+#define TIMEOUT_TICKS(i) (1000000 + (i) * 16)
+
+static struct _timeout timeouts[MAX_TIMEOUTS + 1];
+
+static void timeout_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void timeout_run(int n)
+{
+	struct bench_avg add = { 0 }, cancel = { 0 };
+	struct _timeout *t = &timeouts[MAX_TIMEOUTS];
+	char buf[48];
+	u32_t t0, t1, t2;
+
+	for (int i = 0; i < n; i++) {
+		z_add_timeout(&timeouts[i], timeout_fn, TIMEOUT_TICKS(i));
+	}
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		t0 = bench_stamp();
+		z_add_timeout(t, timeout_fn, TIMEOUT_TICKS(n));
+		t1 = bench_stamp();
+		z_abort_timeout(t);
+		t2 = bench_stamp();
+		bench_avg_add(&add, t1 - t0);
+		bench_avg_add(&cancel, t2 - t1);
+	}
+
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+
+	snprintk(buf, sizeof(buf), "timeout add %d", n);
+	bench_report(buf, &add);
+	snprintk(buf, sizeof(buf), "timeout abort %d", n);
+	bench_report(buf, &cancel);
+}
+
+void bench_timeout(void)
+{
+	static const int armed[] = { 16, 64, MAX_TIMEOUTS };
+
+	for (int i = 0; i < ARRAY_SIZE(timeouts); i++) {
+		z_init_timeout(&timeouts[i], timeout_fn);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(armed); i++) {
+		timeout_run(armed[i]);
+	}
+}
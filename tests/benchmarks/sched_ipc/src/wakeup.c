@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Wakeup cycle of tests/benchmarks/sched, with other threads in the way:
+ * main unpends and readies a partner thread, then yields to it until it
+ * pends again.  The fillers either sit ready in the run queue, which also
+ * loads k_thread_suspend()/k_thread_resume() of a low priority thread, or
+ * are pended on the wait queue ahead of the partner.
+ */
+
+#include <wait_q.h>
+#include <ksched.h>
+#include "bench.h"
+
+static struct k_thread partner_thread;
+static K_THREAD_STACK_DEFINE(partner_stack, STACK_SIZE);
+
+static struct k_thread victim_thread;
+static K_THREAD_STACK_DEFINE(victim_stack, STACK_SIZE);
+
+static struct k_thread filler_threads[MAX_FILLERS];
+static K_THREAD_STACK_ARRAY_DEFINE(filler_stacks, MAX_FILLERS, STACK_SIZE);
+
+static _wait_q_t waitq;
+
+static void pend_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		unsigned int key = irq_lock();
+
+		z_pend_curr_irqlock(key, &waitq, K_FOREVER);
+	}
+}
+
+/* Ready fillers and the victim never get to run under the coop main */
+static void idle_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+}
+
+static void fillers_start(int n, int prio)
+{
+	for (int i = 0; i < n; i++) {
+		k_thread_create(&filler_threads[i], filler_stacks[i],
+				K_THREAD_STACK_SIZEOF(filler_stacks[i]),
+				prio == PENDED_FILLER_PRIO ? pend_fn : idle_fn,
+				NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	/* Let the pended fillers pend, the ready ones would run and exit */
+	if (prio == PENDED_FILLER_PRIO) {
+		k_sleep(10);
+	}
+}
+
+static void fillers_stop(int n)
+{
+	for (int i = 0; i < n; i++) {
+		k_thread_abort(&filler_threads[i]);
+	}
+}
+
+static void wakeup_run(const char *name, int n, int filler_prio)
+{
+	struct bench_avg cycle = { 0 }, suspend = { 0 }, resume = { 0 };
+	char buf[48];
+	u32_t t0, t1, t2;
+
+	fillers_start(n, filler_prio);
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		t0 = bench_stamp();
+		z_unpend_thread(&partner_thread);
+		z_ready_thread(&partner_thread);
+
+		/* The partner preempts main here, and switches back once
+		 * it has pended again.
+		 */
+		k_yield();
+		t1 = bench_stamp();
+		bench_avg_add(&cycle, t1 - t0);
+
+		if (filler_prio == READY_FILLER_PRIO) {
+			t0 = bench_stamp();
+			k_thread_suspend(&victim_thread);
+			t1 = bench_stamp();
+			k_thread_resume(&victim_thread);
+			t2 = bench_stamp();
+			bench_avg_add(&suspend, t1 - t0);
+			bench_avg_add(&resume, t2 - t1);
+		}
+	}
+
+	fillers_stop(n);
+
+	snprintk(buf, sizeof(buf), "wakeup %s %d", name, n);
+	bench_report(buf, &cycle);
+
+	if (filler_prio == READY_FILLER_PRIO) {
+		snprintk(buf, sizeof(buf), "suspend %s %d", name, n);
+		bench_report(buf, &suspend);
+		snprintk(buf, sizeof(buf), "resume %s %d", name, n);
+		bench_report(buf, &resume);
+	}
+}
+
+void bench_wakeup(void)
+{
+	static const int fillers[] = { 0, 8, MAX_FILLERS };
+
+	z_waitq_init(&waitq);
+
+	k_thread_create(&partner_thread, partner_stack,
+			K_THREAD_STACK_SIZEOF(partner_stack), pend_fn,
+			NULL, NULL, NULL, PARTNER_PRIO, 0, K_NO_WAIT);
+
+	/* Let the partner pend */
+	k_sleep(10);
+
+	k_thread_create(&victim_thread, victim_stack,
+			K_THREAD_STACK_SIZEOF(victim_stack), idle_fn,
+			NULL, NULL, NULL, VICTIM_PRIO, 0, K_NO_WAIT);
+
+	for (int i = 0; i < ARRAY_SIZE(fillers); i++) {
+		wakeup_run("ready", fillers[i], READY_FILLER_PRIO);
+	}
+
+	for (int i = 1; i < ARRAY_SIZE(fillers); i++) {
+		wakeup_run("pended", fillers[i], PENDED_FILLER_PRIO);
+	}
+
+	k_thread_abort(&victim_thread);
+	k_thread_abort(&partner_thread);
+}
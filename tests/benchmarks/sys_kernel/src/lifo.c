@@ -146,8 +146,7 @@ int lifo_test(void)
 	k_fifo_init(&sync_fifo);
 
 	/* test get/wait & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"LIFO #1");
+	print_case_title("LIFO #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_lifo_init"
 			"\n\tk_lifo_get(K_FOREVER)"
@@ -176,8 +175,7 @@ int lifo_test(void)
 	}
 
 	/* test get/yield & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"LIFO #2");
+	print_case_title("LIFO #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_lifo_init"
 			"\n\tk_lifo_get(K_FOREVER)"
@@ -210,8 +208,7 @@ int lifo_test(void)
 	}
 
 	/* test get wait & put functions between co-op and premptive threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"LIFO #3");
+	print_case_title("LIFO #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_lifo_init"
 			"\n\tk_lifo_get(K_FOREVER)"
@@ -147,8 +147,7 @@ int fifo_test(void)
 	k_fifo_init(&sync_fifo);
 
 	/* test get wait & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"FIFO #1");
+	print_case_title("FIFO #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_fifo_init"
 			"\n\tk_fifo_get(K_FOREVER)"
@@ -176,8 +175,7 @@ int fifo_test(void)
 	}
 
 	/* test get/yield & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"FIFO #2");
+	print_case_title("FIFO #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_fifo_init"
 			"\n\tk_fifo_get(K_FOREVER)"
@@ -208,8 +206,7 @@ int fifo_test(void)
 	}
 
 	/* test get wait & put functions between co-op and premptive threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"FIFO #3");
+	print_case_title("FIFO #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_fifo_init"
 			"\n\tk_fifo_get(K_FOREVER)"
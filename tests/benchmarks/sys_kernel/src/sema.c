@@ -114,8 +114,7 @@ int sema_test(void)
 	int i = 0;
 	int return_value = 0;
 
-	fprintf(output_file, sz_test_case_fmt,
-			"Semaphore #1");
+	print_case_title("Semaphore #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_sem_init"
 			"\n\tk_sem_take(K_FOREVER)"
@@ -137,8 +136,7 @@ int sema_test(void)
 
 	return_value += check_result(i, t);
 
-	fprintf(output_file, sz_test_case_fmt,
-			"Semaphore #2");
+	print_case_title("Semaphore #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_sem_init"
 			"\n\tk_sem_take(TICKS_NONE)"
@@ -162,8 +160,7 @@ int sema_test(void)
 
 	return_value += check_result(i, t);
 
-	fprintf(output_file, sz_test_case_fmt,
-			"Semaphore #3");
+	print_case_title("Semaphore #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_sem_init"
 			"\n\tk_sem_take(K_FOREVER)"
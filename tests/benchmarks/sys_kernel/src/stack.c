@@ -148,8 +148,7 @@ int stack_test(void)
 	int return_value = 0;
 
 	/* test get wait & put stack functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"Stack #1");
+	print_case_title("Stack #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_stack_init"
 			"\n\tk_stack_pop(K_FOREVER)"
@@ -172,8 +171,7 @@ int stack_test(void)
 	return_value += check_result(i, t);
 
 	/* test get/yield & put stack functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"Stack #2");
+	print_case_title("Stack #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_stack_init"
 			"\n\tk_stack_pop(K_FOREVER)"
@@ -201,8 +199,7 @@ int stack_test(void)
 	/* test get wait & put stack functions across co-op and premptive
 	 * threads
 	 */
-	fprintf(output_file, sz_test_case_fmt,
-			"Stack #3");
+	print_case_title("Stack #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_stack_init"
 			"\n\tk_stack_pop(K_FOREVER)"
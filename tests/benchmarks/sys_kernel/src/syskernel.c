@@ -32,6 +32,23 @@ u32_t tm_off;
 /* Holds the loop count that need to be carried out. */
 u32_t number_of_loops;
 
+/* Title of the running test case, naming its performance record */
+static const char *case_title;
+
+/**
+ *
+ * @brief Print the title of a test case
+ *
+ * @return N/A
+ *
+ * @param title   Title of the test case.
+ */
+void print_case_title(const char *title)
+{
+	case_title = title;
+	fprintf(output_file, sz_test_case_fmt, title);
+}
+
 /**
  *
  * @brief Get the time ticks before test starts
@@ -83,6 +100,8 @@ int check_result(int i, u32_t t)
 			"Average time for 1 iteration: ");
 	fprintf(output_file, sz_case_timing_fmt,
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, number_of_loops));
+	TC_PERF_RECORD(case_title,
+		       SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, number_of_loops), "ns");
 
 	fprintf(output_file, sz_case_end_fmt);
 	return 1;
@@ -46,6 +46,7 @@ extern u32_t number_of_loops;
 #define sz_case_timing_fmt	"%u nSec"
 
 int check_result(int i, u32_t ticks);
+void print_case_title(const char *title);
 
 int sema_test(void);
 int lifo_test(void);
@@ -160,6 +160,7 @@ static inline u32_t get_core_freq_MHz(void)
 #endif
 #include <stdio.h>
 
+#define GET_1ST_ARG(first, ...) (first)
 #define GET_2ND_ARG(first, second, ...) (second)
 #define GET_3ND_ARG(first, second, third, ...) (third)
 
@@ -179,6 +180,9 @@ static inline u32_t get_core_freq_MHz(void)
 		    (GET_2ND_ARG(__VA_ARGS__) != 0)) {		     \
 			snprintf(sline, 254, FORMAT, ##__VA_ARGS__); \
 			TC_PRINT("%s", sline);			     \
+			TC_PERF_RECORD(GET_1ST_ARG(__VA_ARGS__),     \
+				       GET_2ND_ARG(__VA_ARGS__),     \
+				       "cycles");		     \
 		}						     \
 	}
 #else
@@ -187,6 +191,8 @@ static inline u32_t get_core_freq_MHz(void)
 	{							     \
 		snprintf(sline, 254, FORMAT, ##__VA_ARGS__); \
 		TC_PRINT("%s", sline);			     \
+		TC_PERF_RECORD(GET_1ST_ARG(__VA_ARGS__),     \
+			       GET_2ND_ARG(__VA_ARGS__), "cycles");  \
 	}
 
 #endif
@@ -49,6 +49,7 @@ Z_SYSCALL_HANDLER(userspace_read_timer_value)
 void drop_to_user_mode(void);
 void user_thread_creation(void);
 void syscall_overhead(void);
+void syscall_batch_overhead(void);
 void validation_overhead(void);
 
 void userspace_bench(void)
@@ -66,6 +67,8 @@ void userspace_bench(void)
 
 	syscall_overhead();
 
+	syscall_batch_overhead();
+
 	validation_overhead();
 }
 /******************************************************************************/
@@ -203,6 +206,58 @@ void syscall_overhead(void)
 
 }
 
+/******************************************************************************/
+#define BATCH_SIZE 3
+
+K_APP_BMEM(bench_ptn) u32_t syscall_separate_start_time,
+	syscall_separate_end_time, syscall_batch_start_time;
+K_APP_BMEM(bench_ptn) struct k_syscall_entry syscall_batch[BATCH_SIZE] = {
+	K_SYSCALL_ENTRY(K_SYSCALL_K_DUMMY_SYSCALL),
+	K_SYSCALL_ENTRY(K_SYSCALL_K_DUMMY_SYSCALL),
+	K_SYSCALL_ENTRY(K_SYSCALL_K_DUMMY_SYSCALL),
+};
+
+void syscall_batch_user_thread(void *p1, void *p2, void *p3)
+{
+	int val;
+
+	syscall_separate_start_time = userspace_read_timer_value();
+	for (int i = 0; i < BATCH_SIZE; i++) {
+		val = k_dummy_syscall();
+	}
+	syscall_separate_end_time = syscall_overhead_end_time;
+
+	syscall_batch_start_time = userspace_read_timer_value();
+	val = k_syscall_batch(syscall_batch, BATCH_SIZE);
+
+	val |= 0xFF;
+}
+
+static void print_batch_stats(const char *tag, u32_t start, u32_t end)
+{
+	u32_t total_cycles = (u32_t)
+		((SUBTRACT_CLOCK_CYCLES(end) - SUBTRACT_CLOCK_CYCLES(start)) &
+		 0xFFFFFFFFULL);
+	u32_t total_time = CYCLES_TO_NS(total_cycles);
+
+	PRINT_STATS(tag, total_cycles, (u32_t) (total_time & 0xFFFFFFFFULL));
+}
+
+void syscall_batch_overhead(void)
+{
+	k_thread_create(&my_thread_user, my_stack_area_0, STACK_SIZE,
+			syscall_batch_user_thread,
+			NULL, NULL, NULL,
+			-1 /*priority*/, K_INHERIT_PERMS | K_USER, 0);
+
+	print_batch_stats("Syscall overhead 3 separate calls",
+			  syscall_separate_start_time,
+			  syscall_separate_end_time);
+	print_batch_stats("Syscall overhead 3 batched calls",
+			  syscall_batch_start_time,
+			  syscall_overhead_end_time);
+}
+
 /******************************************************************************/
 K_SEM_DEFINE(test_sema, 1, 10);
 u32_t validation_overhead_obj_init_start_time;
@@ -7,6 +7,7 @@
 #include <ztest.h>
 #include <kernel.h>
 #include <cmsis_os2.h>
+#include <cmsis_types.h>
 
 #include <irq_offload.h>
 #include <kernel_structs.h>
@@ -214,3 +215,69 @@ void test_event_flags_isr(void)
 	zassert_true(osEventFlagsDelete(evt_id) == osOK,
 		     "EventFlagsDelete failed");
 }
+
+static struct cv2_event_flags event_flags_cb;
+static struct cv2_thread waiter_cb[2];
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, 2, STACKSZ);
+static u32_t waiter_results[2];
+
+static void waiter(void *arg)
+{
+	u32_t *result = arg;
+
+	*result = osEventFlagsWait(evt_id, FLAG1,
+				   osFlagsWaitAny | osFlagsNoClear,
+				   TIMEOUT_TICKS);
+}
+
+void test_event_flags_wake_all(void)
+{
+	osEventFlagsAttr_t attr = {
+		.name = "StaticEvent",
+		.cb_mem = &event_flags_cb,
+		.cb_size = sizeof(event_flags_cb),
+	};
+	osThreadAttr_t thread_attr = {
+		.name = "Waiter",
+		.cb_size = sizeof(struct cv2_thread),
+		.stack_size = STACKSZ,
+		.priority = osPriorityHigh,
+	};
+	osThreadId_t id;
+	int i;
+
+	/* A control block that is too small is refused */
+	attr.cb_size = sizeof(event_flags_cb) - 1;
+	zassert_is_null(osEventFlagsNew(&attr), "Too small cb_mem accepted");
+
+	attr.cb_size = sizeof(event_flags_cb);
+	evt_id = osEventFlagsNew(&attr);
+	zassert_equal_ptr(evt_id, &event_flags_cb, "cb_mem not used");
+
+	for (i = 0; i < ARRAY_SIZE(waiter_cb); i++) {
+		waiter_results[i] = 0U;
+		thread_attr.cb_mem = &waiter_cb[i];
+		thread_attr.stack_mem = waiter_stacks[i];
+
+		id = osThreadNew(waiter, &waiter_results[i], &thread_attr);
+		zassert_equal_ptr(id, &waiter_cb[i], "cb_mem not used");
+	}
+
+	/* Let both waiters block */
+	osDelay(2);
+
+	/* A single set wakes every waiter whose condition holds */
+	osEventFlagsSet(evt_id, FLAG1);
+	osDelay(2);
+
+	for (i = 0; i < ARRAY_SIZE(waiter_cb); i++) {
+		zassert_equal(waiter_results[i] & FLAG1, FLAG1,
+			      "waiter %d not woken", i);
+	}
+
+	zassert_equal(osEventFlagsGet(evt_id) & FLAG1, FLAG1,
+		      "osFlagsNoClear cleared the flags");
+
+	zassert_true(osEventFlagsDelete(evt_id) == osOK,
+		     "EventFlagsDelete failed");
+}
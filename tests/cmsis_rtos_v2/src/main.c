@@ -24,6 +24,7 @@ extern void test_messageq(void);
 extern void test_event_flags_no_wait_timeout(void);
 extern void test_event_flags_signalled(void);
 extern void test_event_flags_isr(void);
+extern void test_event_flags_wake_all(void);
 extern void test_thread_flags_no_wait_timeout(void);
 extern void test_thread_flags_signalled(void);
 extern void test_thread_flags_isr(void);
@@ -51,6 +52,7 @@ void test_main(void)
 			 ztest_unit_test(test_event_flags_no_wait_timeout),
 			 ztest_unit_test(test_event_flags_signalled),
 			 ztest_unit_test(test_event_flags_isr),
+			 ztest_unit_test(test_event_flags_wake_all),
 			 ztest_unit_test(test_thread_flags_no_wait_timeout),
 			 ztest_unit_test(test_thread_flags_signalled),
 			 ztest_unit_test(test_thread_flags_isr),
@@ -7,6 +7,9 @@
 #include <drivers/counter.h>
 #include <ztest.h>
 #include <kernel.h>
+#if defined(CONFIG_COUNTER_NRF_TRIGGER)
+#include <hal/nrf_egu.h>
+#endif
 
 static volatile u32_t top_cnt;
 static volatile u32_t alarm_cnt;
@@ -425,6 +428,88 @@ void test_all_channels(void)
 	test_all_instances(test_all_channels_instance);
 }
 
+#if defined(CONFIG_COUNTER_NRF_TRIGGER)
+/* The trigger drives the TRIGGER0 task of an EGU, whose event tells that it
+ * fired without any interrupt involved.
+ */
+static bool trigger_fired(void)
+{
+	bool fired = nrf_egu_event_check(NRF_EGU0, NRF_EGU_EVENT_TRIGGERED0);
+
+	nrf_egu_event_clear(NRF_EGU0, NRF_EGU_EVENT_TRIGGERED0);
+
+	return fired;
+}
+
+void test_trigger_instance(const char *dev_name)
+{
+	struct device *dev;
+	int err;
+	struct counter_top_cfg top_cfg = {
+		.callback = NULL,
+		.user_data = NULL,
+		.flags = 0
+	};
+	struct counter_trigger_cfg trigger_cfg;
+	struct counter_alarm_cfg alarm_cfg = {
+		.flags = 0,
+		.ticks = 1,
+		.callback = alarm_handler2,
+		.user_data = NULL
+	};
+
+	dev = device_get_binding(dev_name);
+	top_cfg.ticks = counter_us_to_ticks(dev, COUNTER_PERIOD_US);
+	trigger_cfg.ticks = top_cfg.ticks / 2;
+	trigger_cfg.task = nrf_egu_task_address_get(NRF_EGU0,
+						    NRF_EGU_TASK_TRIGGER0);
+
+	err = counter_start(dev);
+	zassert_equal(0, err, "%s: Counter failed to start", dev_name);
+
+	err = counter_set_top_value(dev, &top_cfg);
+	zassert_equal(0, err, "%s: Counter failed to set top value", dev_name);
+
+	err = counter_set_channel_trigger(dev, 0, &trigger_cfg);
+	if (err == -ENOTSUP) {
+		/* No hardware wrapping at the top value */
+		return;
+	}
+	zassert_equal(0, err, "%s: Counter failed to set trigger", dev_name);
+	(void)trigger_fired();
+
+	err = counter_set_channel_alarm(dev, 0, &alarm_cfg);
+	zassert_equal(-EBUSY, err, "%s: Expected channel to be busy",
+			dev_name);
+
+	for (int i = 0; i < 3; i++) {
+		k_busy_wait(COUNTER_PERIOD_US);
+		zassert_true(trigger_fired(), "%s: Expected trigger in period",
+				dev_name);
+	}
+
+	err = counter_cancel_channel_trigger(dev, 0);
+	zassert_equal(0, err, "%s: Counter failed to cancel trigger",
+			dev_name);
+
+	(void)trigger_fired();
+	k_busy_wait(1.5*COUNTER_PERIOD_US);
+	zassert_false(trigger_fired(), "%s: Unexpected trigger", dev_name);
+
+	err = counter_cancel_channel_trigger(dev, 0);
+	zassert_equal(-EALREADY, err, "%s: Expected no trigger", dev_name);
+}
+#endif
+
+void test_trigger(void)
+{
+#if defined(CONFIG_COUNTER_NRF_TRIGGER)
+	test_all_instances(test_trigger_instance);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_counter,
@@ -432,7 +517,8 @@ void test_main(void)
 		ztest_unit_test(test_single_shot_alarm_notop),
 		ztest_unit_test(test_single_shot_alarm_top),
 		ztest_unit_test(test_multiple_alarms),
-		ztest_unit_test(test_all_channels)
+		ztest_unit_test(test_all_channels),
+		ztest_unit_test(test_trigger)
 			 );
 	ztest_run_test_suite(test_counter);
 }
@@ -260,6 +260,58 @@ static void test_double_write(void)
 	zassert_equal(-EIO, rc, "Unexpected error code (%d)", rc);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+static void test_async(void)
+{
+	struct flash_async_req req = { 0 };
+	struct k_poll_signal signal;
+	struct k_poll_event event;
+	u32_t val32[4];
+	int result;
+	int rc;
+
+	k_poll_signal_init(&signal);
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &signal);
+	req.signal = &signal;
+
+	rc = flash_write_protection_set(flash_dev, false);
+	zassert_equal(0, rc, NULL);
+
+	rc = flash_erase_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			       FLASH_SIMULATOR_ERASE_UNIT, &req);
+	zassert_equal(0, rc, "flash_erase_async should succeed");
+
+	zassert_equal(0, k_poll(&event, 1, K_FOREVER), "k_poll failed");
+	k_poll_signal_check(&signal, &rc, &result);
+	zassert_equal(0, result, "async erase failed (%d)", result);
+
+	for (rc = 0; rc < ARRAY_SIZE(val32); rc++) {
+		val32[rc] = 0xA5A50000 + rc;
+	}
+
+	k_poll_signal_reset(&signal);
+	event.state = K_POLL_STATE_NOT_READY;
+
+	rc = flash_write_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, val32,
+			       sizeof(val32), &req);
+	zassert_equal(0, rc, "flash_write_async should succeed");
+
+	zassert_equal(0, k_poll(&event, 1, K_FOREVER), "k_poll failed");
+	k_poll_signal_check(&signal, &rc, &result);
+	zassert_equal(0, result, "async write failed (%d)", result);
+
+	pattern32_ini(0xA5A50000);
+	test_check_pattern32(FLASH_SIMULATOR_BASE_OFFSET, pattern32_inc,
+			     sizeof(val32));
+}
+#else
+static void test_async(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -269,7 +321,8 @@ void test_main(void)
 			 ztest_unit_test(test_access),
 			 ztest_unit_test(test_out_of_bounds),
 			 ztest_unit_test(test_align),
-			 ztest_unit_test(test_double_write));
+			 ztest_unit_test(test_double_write),
+			 ztest_unit_test(test_async));
 
 	ztest_run_test_suite(flash_sim_api);
 }
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define EV_A BIT(0)
+#define EV_B BIT(1)
+#define EV_C BIT(5)
+
+#define EVENT_TIMEOUT K_MSEC(100)
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_WAITERS 3
+
+struct waiter_info {
+	u32_t events;
+	bool all;
+	bool clear;
+	u32_t result;
+	int woken;
+};
+
+K_EVENT_DEFINE(event);
+K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, NUM_WAITERS, STACK_SIZE);
+static struct k_thread waiter_threads[NUM_WAITERS];
+static struct waiter_info waiters[NUM_WAITERS];
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	struct waiter_info *info = p1;
+
+	if (info->all) {
+		info->result = k_event_wait_all(&event, info->events,
+						info->clear, K_FOREVER);
+	} else {
+		info->result = k_event_wait(&event, info->events, info->clear,
+					    K_FOREVER);
+	}
+	info->woken++;
+}
+
+/* Starts the waiters at decreasing priority, so they pend in order */
+static void start_waiters(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		waiters[i].result = 0U;
+		waiters[i].woken = 0;
+		k_thread_create(&waiter_threads[i], waiter_stacks[i],
+				STACK_SIZE, waiter_entry, &waiters[i],
+				NULL, NULL, K_PRIO_PREEMPT(i + 1), 0,
+				K_NO_WAIT);
+	}
+
+	/* Let all of them pend */
+	k_sleep(K_MSEC(10));
+}
+
+static void stop_waiters(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		k_thread_abort(&waiter_threads[i]);
+	}
+}
+
+/**
+ * @brief Test waiting for events that were already posted
+ */
+void test_event_no_wait(void)
+{
+	k_event_init(&event);
+
+	zassert_equal(k_event_wait(&event, EV_A, false, K_NO_WAIT), 0U,
+		      "waited for events never posted");
+
+	zassert_equal(k_event_post(&event, EV_A | EV_C), EV_A | EV_C, NULL);
+
+	zassert_equal(k_event_wait(&event, EV_A | EV_B, false, K_NO_WAIT),
+		      EV_A | EV_C, "any wait not satisfied");
+	zassert_equal(k_event_wait_all(&event, EV_A | EV_B, false, K_NO_WAIT),
+		      0U, "all wait satisfied by a subset");
+
+	/* Clearing on a satisfied wait only clears the awaited events */
+	zassert_equal(k_event_wait_all(&event, EV_A | EV_C, true, K_NO_WAIT),
+		      EV_A | EV_C, "all wait not satisfied");
+	zassert_equal(k_event_wait(&event, EV_A | EV_C, false, K_NO_WAIT), 0U,
+		      "events not cleared");
+
+	zassert_equal(k_event_set(&event, EV_B), EV_B, NULL);
+	zassert_equal(k_event_clear(&event, EV_B | EV_C), EV_B, NULL);
+	zassert_equal(k_event_wait(&event, EV_B, false, K_NO_WAIT), 0U,
+		      "events not cleared");
+}
+
+/**
+ * @brief Test that a wait times out if its condition never holds
+ */
+void test_event_wait_timeout(void)
+{
+	k_event_init(&event);
+	k_event_post(&event, EV_A);
+
+	zassert_equal(k_event_wait(&event, EV_B, false, EVENT_TIMEOUT), 0U,
+		      "any wait did not time out");
+	zassert_equal(k_event_wait_all(&event, EV_A | EV_B, false,
+				       EVENT_TIMEOUT),
+		      0U, "all wait did not time out");
+}
+
+/**
+ * @brief Test that posting only wakes the waiters it satisfies
+ */
+void test_event_wake_matching(void)
+{
+	k_event_init(&event);
+
+	waiters[0] = (struct waiter_info){ .events = EV_A };
+	waiters[1] = (struct waiter_info){ .events = EV_B };
+	waiters[2] = (struct waiter_info){ .events = EV_A | EV_B,
+					   .all = true };
+	start_waiters(NUM_WAITERS);
+
+	k_event_post(&event, EV_A);
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(waiters[0].woken, 1, "any waiter not woken");
+	zassert_equal(waiters[0].result, EV_A, NULL);
+	zassert_equal(waiters[1].woken, 0, "unrelated waiter woken");
+	zassert_equal(waiters[2].woken, 0, "all waiter woken early");
+
+	/* A single post wakes every satisfied waiter */
+	k_event_post(&event, EV_B);
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(waiters[1].woken, 1, "any waiter not woken");
+	zassert_equal(waiters[2].woken, 1, "all waiter not woken");
+	zassert_equal(waiters[2].result, EV_A | EV_B, NULL);
+
+	stop_waiters(NUM_WAITERS);
+}
+
+/**
+ * @brief Test that a clearing waiter consumes the events of later ones
+ */
+void test_event_wake_clear(void)
+{
+	k_event_init(&event);
+
+	waiters[0] = (struct waiter_info){ .events = EV_A, .clear = true };
+	waiters[1] = (struct waiter_info){ .events = EV_A, .clear = true };
+	waiters[2] = (struct waiter_info){ .events = EV_A | EV_C };
+	start_waiters(NUM_WAITERS);
+
+	/* The first waiter takes EV_A, EV_C is left for the last one */
+	zassert_equal(k_event_post(&event, EV_A | EV_C), EV_C,
+		      "events left after wake up");
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(waiters[0].woken, 1, "first waiter not woken");
+	zassert_equal(waiters[0].result, EV_A | EV_C, NULL);
+	zassert_equal(waiters[1].woken, 0, "consumed events woke a waiter");
+	zassert_equal(waiters[2].woken, 1, "last waiter not woken");
+	zassert_equal(waiters[2].result, EV_C, NULL);
+
+	k_event_post(&event, EV_A);
+	k_sleep(K_MSEC(10));
+	zassert_equal(waiters[1].woken, 1, "second waiter not woken");
+
+	stop_waiters(NUM_WAITERS);
+}
+
+static void isr_event_post(void *arg)
+{
+	k_event_post((struct k_event *)arg, EV_C);
+}
+
+/**
+ * @brief Test posting events from an ISR
+ */
+void test_event_post_from_isr(void)
+{
+	k_event_init(&event);
+
+	waiters[0] = (struct waiter_info){ .events = EV_C, .clear = true };
+	start_waiters(1);
+
+	irq_offload(isr_event_post, &event);
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(waiters[0].woken, 1, "waiter not woken from ISR");
+	zassert_equal(waiters[0].result, EV_C, NULL);
+	zassert_equal(k_event_clear(&event, 0U), 0U, "events not cleared");
+
+	stop_waiters(1);
+}
+
+/* ztest main entry*/
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &event);
+
+	ztest_test_suite(test_events,
+			 ztest_user_unit_test(test_event_no_wait),
+			 ztest_user_unit_test(test_event_wait_timeout),
+			 ztest_unit_test(test_event_wake_matching),
+			 ztest_unit_test(test_event_wake_clear),
+			 ztest_unit_test(test_event_post_from_isr));
+	ztest_run_test_suite(test_events);
+}
@@ -15,6 +15,7 @@ struct k_fifo fifo;
 static fdata_t data[LIST_LEN];
 static fdata_t data_l[LIST_LEN];
 static fdata_t data_sl[LIST_LEN];
+static fdata_t data_b[LIST_LEN];
 
 static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
 static struct k_thread tdata;
@@ -41,6 +42,11 @@ static void tfifo_put(struct k_fifo *pfifo)
 	sys_slist_append(&slist, (sys_snode_t *)&(data_sl[0].snode));
 	sys_slist_append(&slist, (sys_snode_t *)&(data_sl[1].snode));
 	k_fifo_put_slist(pfifo, &slist);
+
+	/**TESTPOINT: fifo put batch*/
+	data_b[0].snode.next = (sys_snode_t *)&data_b[1];
+	data_b[1].snode.next = NULL;
+	k_fifo_put_batch(pfifo, (void *)&data_b[0], (void *)&data_b[1]);
 }
 
 static void tfifo_get(struct k_fifo *pfifo)
@@ -63,6 +69,11 @@ static void tfifo_get(struct k_fifo *pfifo)
 		rx_data = k_fifo_get(pfifo, K_NO_WAIT);
 		zassert_equal(rx_data, (void *)&data_sl[i], NULL);
 	}
+	/*get fifo data from "fifo_put_batch"*/
+	for (int i = 0; i < LIST_LEN; i++) {
+		rx_data = k_fifo_get(pfifo, K_NO_WAIT);
+		zassert_equal(rx_data, (void *)&data_b[i], NULL);
+	}
 }
 
 /*entry of contexts*/
@@ -26,6 +26,8 @@ extern void test_mbox_async_put_to_waiting_get(void);
 extern void test_mbox_get_waiting_put_incorrect_tid(void);
 extern void test_mbox_async_multiple_put(void);
 extern void test_mbox_multiple_waiting_get(void);
+extern void test_mbox_target_waiting_get(void);
+extern void test_mbox_block_handoff(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -53,6 +55,8 @@ void test_main(void)
 			 ztest_unit_test(
 				test_mbox_get_waiting_put_incorrect_tid),
 			 ztest_unit_test(test_mbox_async_multiple_put),
-			 ztest_unit_test(test_mbox_multiple_waiting_get));
+			 ztest_unit_test(test_mbox_multiple_waiting_get),
+			 ztest_unit_test(test_mbox_target_waiting_get),
+			 ztest_unit_test(test_mbox_block_handoff));
 	ztest_run_test_suite(mbox_api);
 }
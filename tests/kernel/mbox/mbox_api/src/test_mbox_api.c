@@ -29,6 +29,7 @@ static K_THREAD_STACK_ARRAY_DEFINE(waiting_get_stack, 5, STACK_SIZE);
 static struct k_thread tdata, async_tid, waiting_get_tid[5];
 
 static struct k_sem end_sema, sync_sema;
+static void *handoff_data;
 
 static enum mmsg_type {
 	PUT_GET_NULL = 0,
@@ -50,7 +51,9 @@ static enum mmsg_type {
 	ASYNC_PUT_TO_WAITING_GET,
 	GET_WAITING_PUT_INCORRECT_TID,
 	ASYNC_MULTIPLE_PUT,
-	MULTIPLE_WAITING_GET
+	MULTIPLE_WAITING_GET,
+	TARGET_WAITING_GET,
+	BLOCK_HANDOFF
 } info_type;
 
 static char data[MAX_INFO_TYPE][MAIL_LEN] = {
@@ -288,6 +291,36 @@ static void tmbox_put(struct k_mbox *pmbox)
 		mmsg.tx_target_thread = receiver_tid;
 		k_mbox_put(pmbox, &mmsg, K_NO_WAIT);
 
+		break;
+	case TARGET_WAITING_GET:
+		k_sem_take(&sync_sema, K_FOREVER);
+
+		/**TESTPOINT: targeted put skips the receivers queued ahead*/
+		mmsg.info = TARGET_WAITING_GET;
+		mmsg.size = sizeof(data[1]);
+		mmsg.tx_data = data[1];
+		mmsg.tx_target_thread = receiver_tid;
+		zassert_true(k_mbox_put(pmbox, &mmsg, K_NO_WAIT) == 0, NULL);
+
+		/* release the receiver waiting for any message */
+		mmsg.size = 0;
+		mmsg.tx_data = NULL;
+		mmsg.tx_target_thread = K_ANY;
+		zassert_true(k_mbox_put(pmbox, &mmsg, K_NO_WAIT) == 0, NULL);
+		break;
+	case BLOCK_HANDOFF:
+		/**TESTPOINT: mbox async put mem block handed off as is*/
+		mmsg.info = BLOCK_HANDOFF;
+		mmsg.size = MAIL_LEN;
+		mmsg.tx_data = NULL;
+		zassert_equal(k_mem_pool_alloc(&mpooltx, &mmsg.tx_block,
+					       MAIL_LEN, K_NO_WAIT), 0, NULL);
+		memcpy(mmsg.tx_block.data, data[ASYNC_PUT_GET_BLOCK], MAIL_LEN);
+		handoff_data = mmsg.tx_block.data;
+		mmsg.tx_target_thread = K_ANY;
+		k_mbox_async_put(pmbox, &mmsg, &sync_sema);
+		/*wait for msg being taken*/
+		k_sem_take(&sync_sema, K_FOREVER);
 		break;
 	default:
 		break;
@@ -512,6 +545,38 @@ static void tmbox_get(struct k_mbox *pmbox)
 				       async_put_sema_give, NULL, NULL, NULL,
 				       K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
 		break;
+	case TARGET_WAITING_GET:
+		/* Queue a receiver for any message ahead of this one */
+		k_thread_create(&waiting_get_tid[0], waiting_get_stack[0],
+				STACK_SIZE, mbox_get_waiting_thread,
+				INT_TO_POINTER(0), pmbox, NULL,
+				K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+		k_yield();
+
+		/* Start the put once this thread waits too */
+		k_thread_create(&async_tid, tstack_1, STACK_SIZE,
+				       async_put_sema_give, NULL, NULL, NULL,
+				       K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		mmsg.size = sizeof(rxdata);
+		mmsg.rx_source_thread = sender_tid;
+		zassert_true(k_mbox_get(pmbox, &mmsg, rxdata, K_FOREVER) == 0,
+			     NULL);
+		zassert_equal(mmsg.info, TARGET_WAITING_GET, NULL);
+		zassert_true(memcmp(rxdata, data[1], MAIL_LEN) == 0, NULL);
+		break;
+	case BLOCK_HANDOFF:
+		mmsg.size = MAIL_LEN;
+		mmsg.rx_source_thread = K_ANY;
+		zassert_true(k_mbox_get(pmbox, &mmsg, NULL, K_FOREVER) == 0,
+			     NULL);
+		zassert_true(k_mbox_data_block_get
+			     (&mmsg, &mpoolrx, &rxblock, K_NO_WAIT) == 0, NULL);
+		/*verify the sender's block was handed over, not copied*/
+		zassert_equal(rxblock.data, handoff_data, NULL);
+		zassert_true(memcmp(rxblock.data, data[ASYNC_PUT_GET_BLOCK],
+				    MAIL_LEN) == 0, NULL);
+		k_mem_pool_free(&rxblock);
+		break;
 
 	default:
 		break;
@@ -673,3 +738,16 @@ void test_mbox_multiple_waiting_get(void)
 	info_type = MULTIPLE_WAITING_GET;
 	tmbox(&mbox);
 }
+
+void test_mbox_target_waiting_get(void)
+{
+	/* mbox still has receivers left waiting by the tests above */
+	info_type = TARGET_WAITING_GET;
+	tmbox(&kmbox);
+}
+
+void test_mbox_block_handoff(void)
+{
+	info_type = BLOCK_HANDOFF;
+	tmbox(&kmbox);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define BLK_NUM CONFIG_HEAP_MEM_SLAB_CACHE_BLOCKS
+#define HDR_SIZE WB_UP(sizeof(struct k_mem_block_id))
+
+static struct k_malloc_slab_stats before, after;
+
+/**
+ * @brief Test that small requests are served by the matching size class
+ *
+ * @details Allocate one block below each size class limit and check
+ * that the hit counter and usage of exactly that class move, and that
+ * k_free() returns each block to the class it came from.
+ *
+ * @see k_malloc(), k_free(), k_malloc_slab_stats_get()
+ */
+void test_mheap_slab_class_hit(void)
+{
+	void *block[Z_HEAP_SLAB_CLASSES];
+
+	k_malloc_slab_stats_get(&before);
+
+	for (int i = 0; i < Z_HEAP_SLAB_CLASSES; i++) {
+		size_t size = before.classes[i].block_size - HDR_SIZE;
+
+		block[i] = k_malloc(size);
+		zassert_not_null(block[i], NULL);
+		/** TESTPOINT: the whole requested area is usable */
+		(void)memset(block[i], 0xa5, size);
+	}
+
+	k_malloc_slab_stats_get(&after);
+
+	for (int i = 0; i < Z_HEAP_SLAB_CLASSES; i++) {
+		zassert_equal(after.classes[i].hits,
+			      before.classes[i].hits + 1, NULL);
+		zassert_equal(after.classes[i].num_used,
+			      before.classes[i].num_used + 1, NULL);
+		zassert_equal(after.classes[i].granted_bytes -
+			      before.classes[i].granted_bytes,
+			      after.classes[i].block_size, NULL);
+	}
+	zassert_equal(after.pool_allocs, before.pool_allocs, NULL);
+
+	for (int i = 0; i < Z_HEAP_SLAB_CLASSES; i++) {
+		k_free(block[i]);
+	}
+
+	k_malloc_slab_stats_get(&after);
+
+	for (int i = 0; i < Z_HEAP_SLAB_CLASSES; i++) {
+		zassert_equal(after.classes[i].num_used,
+			      before.classes[i].num_used, NULL);
+	}
+}
+
+/**
+ * @brief Test that large requests fall through to the heap memory pool
+ *
+ * @see k_malloc(), k_free(), k_malloc_slab_stats_get()
+ */
+void test_mheap_slab_large(void)
+{
+	void *block;
+	size_t max = Z_HEAP_SLAB_CLASSES - 1;
+
+	k_malloc_slab_stats_get(&before);
+
+	block = k_malloc(before.classes[max].block_size);
+	zassert_not_null(block, NULL);
+
+	k_malloc_slab_stats_get(&after);
+	zassert_equal(after.pool_allocs, before.pool_allocs + 1, NULL);
+	zassert_true(after.pool_granted_bytes - before.pool_granted_bytes >=
+		     after.pool_requested_bytes - before.pool_requested_bytes,
+		     NULL);
+	zassert_equal(after.classes[max].hits, before.classes[max].hits,
+		      NULL);
+
+	k_free(block);
+}
+
+/**
+ * @brief Test that an exhausted class overflows into the pool
+ *
+ * @details Allocate one block more than the smallest class holds; the
+ * last one must come from the heap memory pool and be counted as an
+ * overflow. Freeing everything must leave the class empty again.
+ *
+ * @see k_malloc(), k_free(), k_malloc_slab_stats_get()
+ */
+void test_mheap_slab_overflow(void)
+{
+	void *block[BLK_NUM + 1];
+
+	k_malloc_slab_stats_get(&before);
+	zassert_equal(before.classes[0].num_used, 0, NULL);
+
+	for (int i = 0; i < BLK_NUM + 1; i++) {
+		block[i] = k_malloc(1);
+		zassert_not_null(block[i], NULL);
+	}
+
+	k_malloc_slab_stats_get(&after);
+	zassert_equal(after.classes[0].num_used, BLK_NUM, NULL);
+	zassert_equal(after.classes[0].overflows,
+		      before.classes[0].overflows + 1, NULL);
+	zassert_equal(after.pool_allocs, before.pool_allocs + 1, NULL);
+
+	for (int i = 0; i < BLK_NUM + 1; i++) {
+		k_free(block[i]);
+	}
+
+	k_malloc_slab_stats_get(&after);
+	zassert_equal(after.classes[0].num_used, 0, NULL);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	ztest_test_suite(mheap_slab_cache,
+			 ztest_unit_test(test_mheap_slab_class_hit),
+			 ztest_unit_test(test_mheap_slab_large),
+			 ztest_unit_test(test_mheap_slab_overflow));
+	ztest_run_test_suite(mheap_slab_cache);
+}
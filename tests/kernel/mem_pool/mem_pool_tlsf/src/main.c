@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/mempool.h>
+
+#define BLK_SIZE_MIN    64
+#define BLK_SIZE_MAX    1024
+#define BLK_NUM_MAX     4
+#define TOTAL_POOL_SIZE (BLK_SIZE_MAX * BLK_NUM_MAX)
+
+#define DESC_SIZE       WB_UP(sizeof(struct sys_mem_pool_block))
+#define NUM_SMALL       32
+
+SYS_MEM_POOL_DEFINE(pool, NULL, BLK_SIZE_MIN, BLK_SIZE_MAX,
+		    BLK_NUM_MAX, sizeof(void *), ZTEST_SECTION);
+
+K_MEM_POOL_DEFINE(kpool, BLK_SIZE_MIN, BLK_SIZE_MAX, BLK_NUM_MAX, 4);
+
+/**
+ * @brief Verify the pool still holds n_max blocks of the maximum size
+ *
+ * @ingroup kernel_memory_pool_tests
+ *
+ * @see sys_mem_pool_alloc(), sys_mem_pool_free()
+ */
+void test_tlsf_alloc_max_blocks(void)
+{
+	void *block[BLK_NUM_MAX];
+
+	for (int i = 0; i < BLK_NUM_MAX; i++) {
+		block[i] = sys_mem_pool_alloc(&pool, BLK_SIZE_MAX - DESC_SIZE);
+		zassert_not_null(block[i], NULL);
+		(void)memset(block[i], i, BLK_SIZE_MAX - DESC_SIZE);
+	}
+
+	for (int i = 0; i < BLK_NUM_MAX; i++) {
+		sys_mem_pool_free(block[i]);
+	}
+}
+
+/**
+ * @brief Verify odd sized blocks are not rounded up to buddy sizes
+ *
+ * @details Requests of a little more than the minimum block size would
+ * each take a quarter of a maximum sized block with the buddy
+ * allocator; here many more of them fit into the pool.
+ *
+ * @ingroup kernel_memory_pool_tests
+ *
+ * @see sys_mem_pool_alloc(), sys_mem_pool_free()
+ */
+void test_tlsf_alloc_odd_sizes(void)
+{
+	void *block[NUM_SMALL];
+
+	for (int i = 0; i < NUM_SMALL; i++) {
+		block[i] = sys_mem_pool_alloc(&pool, BLK_SIZE_MIN + 8);
+		zassert_not_null(block[i], NULL);
+		zassert_false((uintptr_t)block[i] % sizeof(void *), NULL);
+	}
+
+	for (int i = 0; i < NUM_SMALL; i++) {
+		sys_mem_pool_free(block[i]);
+	}
+}
+
+/**
+ * @brief Verify freed blocks are coalesced
+ *
+ * @details Fragment the pool with small blocks, free them in an
+ * interleaved order, then check the whole pool is one block again.
+ *
+ * @ingroup kernel_memory_pool_tests
+ *
+ * @see sys_mem_pool_alloc(), sys_mem_pool_free()
+ */
+void test_tlsf_coalesce(void)
+{
+	void *block[NUM_SMALL], *big;
+
+	for (int i = 0; i < NUM_SMALL; i++) {
+		block[i] = sys_mem_pool_alloc(&pool, 24 + i);
+		zassert_not_null(block[i], NULL);
+	}
+
+	for (int i = 0; i < NUM_SMALL; i += 2) {
+		sys_mem_pool_free(block[i]);
+	}
+
+	/** TESTPOINT: no hole is large enough while neighbours are used */
+	big = sys_mem_pool_alloc(&pool, TOTAL_POOL_SIZE - DESC_SIZE);
+	zassert_is_null(big, NULL);
+
+	for (int i = 1; i < NUM_SMALL; i += 2) {
+		sys_mem_pool_free(block[i]);
+	}
+
+	big = sys_mem_pool_alloc(&pool, TOTAL_POOL_SIZE - DESC_SIZE);
+	zassert_not_null(big, NULL);
+	sys_mem_pool_free(big);
+}
+
+/**
+ * @brief Verify in-place expansion into a free neighbour
+ *
+ * @ingroup kernel_memory_pool_tests
+ *
+ * @see sys_mem_pool_try_expand_inplace()
+ */
+void test_tlsf_expand_inplace(void)
+{
+	void *block[3];
+
+	for (int i = 0; i < 3; i++) {
+		block[i] = sys_mem_pool_alloc(&pool, 100);
+		zassert_not_null(block[i], NULL);
+	}
+
+	/** TESTPOINT: a used neighbour prevents growing */
+	zassert_not_equal(sys_mem_pool_try_expand_inplace(block[0], 300), 0,
+			  NULL);
+
+	/** TESTPOINT: a free neighbour is absorbed */
+	sys_mem_pool_free(block[1]);
+	zassert_equal(sys_mem_pool_try_expand_inplace(block[0], 200), 0,
+		      NULL);
+	(void)memset(block[0], 0xa5, 200);
+
+	for (int i = 0; i < 3; i++) {
+		if (i != 1) {
+			sys_mem_pool_free(block[i]);
+		}
+	}
+}
+
+/**
+ * @brief Verify k_mem_pool works on top of the TLSF backend
+ *
+ * @ingroup kernel_memory_pool_tests
+ *
+ * @see k_mem_pool_alloc(), k_mem_pool_free(), k_malloc(), k_free()
+ */
+void test_tlsf_k_mem_pool(void)
+{
+	struct k_mem_block block[BLK_NUM_MAX], fail;
+	void *heap;
+
+	for (int i = 0; i < BLK_NUM_MAX; i++) {
+		zassert_equal(k_mem_pool_alloc(&kpool, &block[i], BLK_SIZE_MAX,
+					       K_NO_WAIT), 0, NULL);
+	}
+	zassert_equal(k_mem_pool_alloc(&kpool, &fail, 2 * BLK_SIZE_MIN,
+				       K_NO_WAIT), -ENOMEM, NULL);
+
+	for (int i = 0; i < BLK_NUM_MAX; i++) {
+		k_mem_pool_free(&block[i]);
+	}
+
+	heap = k_malloc(CONFIG_HEAP_MEM_POOL_SIZE -
+			WB_UP(sizeof(struct k_mem_block_id)));
+	zassert_not_null(heap, NULL);
+	k_free(heap);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	sys_mem_pool_init(&pool);
+
+	ztest_test_suite(mem_pool_tlsf,
+			 ztest_unit_test(test_tlsf_alloc_max_blocks),
+			 ztest_unit_test(test_tlsf_alloc_odd_sizes),
+			 ztest_unit_test(test_tlsf_coalesce),
+			 ztest_unit_test(test_tlsf_expand_inplace),
+			 ztest_unit_test(test_tlsf_k_mem_pool));
+	ztest_run_test_suite(mem_pool_tlsf);
+}
@@ -26,6 +26,7 @@ extern void test_mem_domain_remove_partitions_simple(void);
 extern void test_mem_domain_remove_partitions(void);
 extern void test_mem_domain_remove_thread(void);
 extern void test_mem_domain_destroy(void);
+extern void test_mem_domain_merge_partitions(void);
 extern void test_kobject_access_grant(void);
 extern void test_syscall_invalid_kobject(void);
 extern void test_thread_without_kobject_permission(void);
@@ -67,6 +68,7 @@ void test_main(void)
 			 ztest_unit_test(test_mem_domain_remove_partitions),
 			 ztest_unit_test(test_mem_domain_remove_thread),
 			 ztest_unit_test(test_mem_domain_destroy),
+			 ztest_unit_test(test_mem_domain_merge_partitions),
 			 ztest_unit_test(test_kobject_access_grant),
 			 ztest_unit_test(test_syscall_invalid_kobject),
 			 ztest_unit_test(test_thread_without_kobject_permission),
@@ -605,3 +605,64 @@ void test_mem_domain_destroy(void)
 		zassert_unreachable("k_mem_domain_add_thread() failed");
 	}
 }
+
+/****************************************************************************/
+#define MERGE_PART_SIZE 64
+
+static u8_t __aligned(MERGE_PART_SIZE) merge_buf[3 * MERGE_PART_SIZE];
+struct k_mem_domain merge_domain;
+
+/**
+ * @brief Test merging of adjacent partitions
+ *
+ * @details Add the outer two of three adjacent partitions, then the
+ * middle one, which closes the gap so that the domain ends up with a
+ * single partition. Then remove them again in a different order.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_mem_domain_add_partition(), k_mem_domain_remove_partition()
+ */
+void test_mem_domain_merge_partitions(void)
+{
+	struct k_mem_partition part[3];
+
+	if (!IS_ENABLED(CONFIG_MEM_DOMAIN_MERGE_PARTITIONS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		part[i] = (struct k_mem_partition) {
+			(uintptr_t)&merge_buf[i * MERGE_PART_SIZE],
+			MERGE_PART_SIZE, K_MEM_PARTITION_P_RW_U_RW
+		};
+	}
+
+	k_mem_domain_init(&merge_domain, 0, NULL);
+
+	k_mem_domain_add_partition(&merge_domain, &part[0]);
+	k_mem_domain_add_partition(&merge_domain, &part[2]);
+	zassert_equal(merge_domain.num_partitions, 2, NULL);
+
+	/** TESTPOINT: the middle partition joins both neighbours */
+	k_mem_domain_add_partition(&merge_domain, &part[1]);
+	zassert_equal(merge_domain.num_partitions, 1, NULL);
+
+	for (int i = 0; i < CONFIG_MAX_DOMAIN_PARTITIONS; i++) {
+		if (merge_domain.partitions[i].size != 0U) {
+			zassert_equal(merge_domain.partitions[i].start,
+				      part[0].start, NULL);
+			zassert_equal(merge_domain.partitions[i].size,
+				      3 * MERGE_PART_SIZE, NULL);
+		}
+	}
+
+	/** TESTPOINT: pieces of a merged partition can be removed */
+	k_mem_domain_remove_partition(&merge_domain, &part[1]);
+	zassert_equal(merge_domain.num_partitions, 2, NULL);
+	k_mem_domain_remove_partition(&merge_domain, &part[0]);
+	zassert_equal(merge_domain.num_partitions, 1, NULL);
+	k_mem_domain_remove_partition(&merge_domain, &part[2]);
+	zassert_equal(merge_domain.num_partitions, 0, NULL);
+}
@@ -107,10 +107,48 @@ void test_generic_object(void)
 	}
 }
 
+/**
+ * @brief Test lookups of many dynamic objects
+ *
+ * @details Look every object up twice, so a second lookup may be
+ * served from the thread's lookup cache, then check that freeing an
+ * object makes it unknown even though it was cached.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_alloc(), k_object_free()
+ */
+void test_dyn_object_lookup(void)
+{
+	struct _k_object *ko;
+
+	for (int i = 0; i < SEM_ARRAY_SIZE; i++) {
+		dyn_sem[i] = k_object_alloc(K_OBJ_SEM);
+		zassert_not_null(dyn_sem[i], "couldn't allocate semaphore");
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < SEM_ARRAY_SIZE; i++) {
+			ko = z_object_find(dyn_sem[i]);
+			zassert_not_null(ko, NULL);
+			zassert_equal(ko->name, (void *)dyn_sem[i], NULL);
+			zassert_equal(ko->type, K_OBJ_SEM, NULL);
+		}
+	}
+
+	for (int i = SEM_ARRAY_SIZE - 1; i >= 0; i--) {
+		zassert_not_null(z_object_find(dyn_sem[i]), NULL);
+		k_object_free(dyn_sem[i]);
+		/** TESTPOINT: freed objects are not found, cached or not */
+		zassert_is_null(z_object_find(dyn_sem[i]), NULL);
+	}
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
 	ztest_test_suite(object_validation,
-			 ztest_unit_test(test_generic_object));
+			 ztest_unit_test(test_generic_object),
+			 ztest_unit_test(test_dyn_object_lookup));
 	ztest_run_test_suite(object_validation);
 }
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <string.h>
+
+K_SEM_DEFINE(batch_sem, 0, 2);
+K_SEM_DEFINE(barrier_sem, 0, 1);
+
+ZTEST_BMEM static volatile bool expect_fault;
+ZTEST_BMEM static struct k_syscall_entry entries[4];
+
+/*
+ * Make an arbitrary system call, so that expect_fault is seen updated by
+ * the fatal error handler.
+ */
+#define BARRIER() k_sem_give(&barrier_sem)
+
+void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *esf)
+{
+	printk("Caught system error -- reason %d\n", reason);
+
+	if (expect_fault && reason == K_ERR_KERNEL_OOPS) {
+		expect_fault = false;
+
+		/* The entries before the bad one were run */
+		zassert_equal(k_sem_count_get(&batch_sem), 1,
+			      "batch not run up to the bad entry");
+		k_sem_reset(&batch_sem);
+
+		ztest_test_pass();
+	} else {
+		printk("Unexpected fault during test");
+		k_fatal_halt(reason);
+	}
+}
+
+static void set_entry(int i, u32_t id, u32_t arg0, u32_t arg1)
+{
+	(void)memset(&entries[i], 0, sizeof(entries[i]));
+	entries[i].id = id;
+	entries[i].arg[0] = arg0;
+	entries[i].arg[1] = arg1;
+	entries[i].ret = 0xdeadbeef;
+}
+
+/**
+ * @brief Test that supervisor threads can't batch system calls
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_batch_supervisor(void)
+{
+	set_entry(0, K_SYSCALL_K_SEM_GIVE, (u32_t)&batch_sem, 0);
+
+	zassert_equal(k_syscall_batch(entries, 1), -EPERM,
+		      "batch allowed in supervisor mode");
+	zassert_equal(entries[0].ret, 0xdeadbeef, "entry run");
+	zassert_equal(k_sem_count_get(&batch_sem), 0, "semaphore given");
+}
+
+/**
+ * @brief Test that each entry of a batch is run with its own return value
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_batch_returns(void)
+{
+	set_entry(0, K_SYSCALL_K_SEM_GIVE, (u32_t)&batch_sem, 0);
+	set_entry(1, K_SYSCALL_K_SEM_COUNT_GET, (u32_t)&batch_sem, 0);
+	set_entry(2, K_SYSCALL_K_SEM_TAKE, (u32_t)&batch_sem, K_NO_WAIT);
+	set_entry(3, K_SYSCALL_K_SEM_TAKE, (u32_t)&batch_sem, K_NO_WAIT);
+
+	/**TESTPOINT: the entries run in order */
+	zassert_equal(k_syscall_batch(entries, 4), 0, "batch failed");
+	zassert_equal(entries[1].ret, 1, "bad count %u", entries[1].ret);
+	zassert_equal(entries[2].ret, 0, "take failed");
+	zassert_equal(entries[3].ret, (u32_t)-EBUSY, "take did not fail");
+	zassert_equal(k_sem_count_get(&batch_sem), 0, "semaphore not taken");
+
+	/**TESTPOINT: an empty batch does nothing */
+	zassert_equal(k_syscall_batch(entries, 0), 0, "empty batch failed");
+}
+
+/**
+ * @brief Test that a batch with an invalid system call ID faults
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_batch_bad_id(void)
+{
+	set_entry(0, K_SYSCALL_K_SEM_GIVE, (u32_t)&batch_sem, 0);
+	set_entry(1, K_SYSCALL_LIMIT, 0, 0);
+
+	expect_fault = true;
+	BARRIER();
+	k_syscall_batch(entries, 2);
+	zassert_unreachable("bad system call ID did not fault");
+}
+
+/**
+ * @brief Test that a batch can't contain another batch
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_batch_nested(void)
+{
+	set_entry(0, K_SYSCALL_K_SEM_GIVE, (u32_t)&batch_sem, 0);
+	set_entry(1, K_SYSCALL_K_SYSCALL_BATCH, (u32_t)entries, 1);
+
+	expect_fault = true;
+	BARRIER();
+	k_syscall_batch(entries, 2);
+	zassert_unreachable("nested batch did not fault");
+}
+
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &batch_sem, &barrier_sem);
+
+	ztest_test_suite(syscall_batch,
+			 ztest_unit_test(test_batch_supervisor),
+			 ztest_user_unit_test(test_batch_returns),
+			 ztest_user_unit_test(test_batch_bad_id),
+			 ztest_user_unit_test(test_batch_nested));
+	ztest_run_test_suite(syscall_batch);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 5
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static char __aligned(4) tbuffer[MSG_SIZE * BATCH_LEN];
+static u32_t data[2 * BATCH_LEN];
+static u32_t rx[2 * BATCH_LEN];
+static int thread_ret;
+
+static void fill_data(u32_t first)
+{
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		data[i] = first + i;
+	}
+}
+
+static void check_rx(int count, u32_t first)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_equal(rx[i], first + i, "message %d out of order", i);
+	}
+}
+
+static void get_n_entry(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_msgq_get_n(&msgq, rx, ARRAY_SIZE(rx), K_FOREVER);
+}
+
+static void put_n_entry(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_msgq_put_n(&msgq, data, 2, K_FOREVER);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test moving several messages per call, across the buffer end
+ * @see k_msgq_put_n(), k_msgq_get_n(), k_msgq_peek_n()
+ */
+void test_msgq_batch(void)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+	fill_data(0);
+
+	zassert_equal(k_msgq_get_n(&msgq, rx, 1, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_peek_n(&msgq, rx, 1), 0, NULL);
+
+	/**TESTPOINT: only the messages that fit are sent */
+	zassert_equal(k_msgq_put_n(&msgq, data, 3, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_msgq_put_n(&msgq, &data[3], 4, K_NO_WAIT), 2, NULL);
+	zassert_equal(k_msgq_put_n(&msgq, data, 1, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), BATCH_LEN, NULL);
+
+	/**TESTPOINT: peek leaves the messages in the queue */
+	zassert_equal(k_msgq_peek_n(&msgq, rx, ARRAY_SIZE(rx)), BATCH_LEN,
+		      NULL);
+	check_rx(BATCH_LEN, 0);
+
+	zassert_equal(k_msgq_get_n(&msgq, rx, 2, K_NO_WAIT), 2, NULL);
+	check_rx(2, 0);
+
+	/**TESTPOINT: batches wrap around the end of the buffer */
+	zassert_equal(k_msgq_put_n(&msgq, &data[5], 2, K_NO_WAIT), 2, NULL);
+	zassert_equal(k_msgq_peek_n(&msgq, rx, 4), 4, NULL);
+	check_rx(4, 2);
+	zassert_equal(k_msgq_get_n(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT),
+		      BATCH_LEN, NULL);
+	check_rx(BATCH_LEN, 2);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+}
+
+/**
+ * @brief Test batches with threads waiting on the queue
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+void test_msgq_batch_pend(void)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+	fill_data(100);
+	(void)memset(rx, 0, sizeof(rx));
+
+	/**TESTPOINT: a waiting receiver gets the whole batch */
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_n_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT >> 1);
+
+	zassert_equal(k_msgq_put_n(&msgq, data, 4, K_NO_WAIT), 4, NULL);
+	k_sleep(TIMEOUT >> 1);
+	zassert_equal(thread_ret, 4, "receiver got %d messages", thread_ret);
+	check_rx(4, 100);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	/**TESTPOINT: receiving makes room for a waiting sender */
+	fill_data(200);
+	zassert_equal(k_msgq_put_n(&msgq, &data[2], BATCH_LEN, K_NO_WAIT),
+		      BATCH_LEN, NULL);
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_n_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT >> 1);
+
+	zassert_equal(k_msgq_get_n(&msgq, rx, 3, K_NO_WAIT), 3, NULL);
+	check_rx(3, 202);
+	k_sleep(TIMEOUT >> 1);
+	zassert_equal(thread_ret, 1, "sender sent %d messages", thread_ret);
+
+	zassert_equal(k_msgq_get_n(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT), 3,
+		      NULL);
+	zassert_equal(rx[0], 205, NULL);
+	zassert_equal(rx[1], 206, NULL);
+	zassert_equal(rx[2], 200, "waiting sender's message not queued");
+}
+
+/**
+ * @}
+ */
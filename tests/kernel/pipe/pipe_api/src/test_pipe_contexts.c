@@ -18,6 +18,7 @@ K_PIPE_DEFINE(kpipe, PIPE_LEN, 4);
 K_PIPE_DEFINE(khalfpipe, (PIPE_LEN / 2), 4);
 K_PIPE_DEFINE(kpipe1, PIPE_LEN, 4);
 K_PIPE_DEFINE(pipe_test_alloc, PIPE_LEN, 4);
+K_PIPE_DEFINE(kpipe_claim, PIPE_LEN, 4);
 struct k_pipe pipe;
 
 K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
@@ -160,6 +161,52 @@ static void thread_for_block_put(void *p1, void *p2, void *p3)
 	tpipe_block_put((struct k_pipe *)p1, (struct k_sem *)p2, K_FOREVER);
 }
 
+static void tpipe_claim_put(struct k_pipe *ppipe, const unsigned char *src,
+			    size_t len)
+{
+	unsigned char *buf;
+	size_t claimed;
+
+	while (len > 0) {
+		/**TESTPOINT: pipe put claim*/
+		claimed = k_pipe_put_claim(ppipe, &buf, len);
+		zassert_true(claimed > 0, NULL);
+		memcpy(buf, src, claimed);
+		zassert_equal(k_pipe_put_finish(ppipe, claimed), 0, NULL);
+		src += claimed;
+		len -= claimed;
+	}
+}
+
+static void tpipe_claim_get(struct k_pipe *ppipe, const unsigned char *ref,
+			    size_t len)
+{
+	unsigned char *buf;
+	size_t claimed;
+
+	while (len > 0) {
+		/**TESTPOINT: pipe get claim*/
+		claimed = k_pipe_get_claim(ppipe, &buf, len);
+		zassert_true(claimed > 0, NULL);
+		zassert_equal(memcmp(buf, ref, claimed), 0, NULL);
+		zassert_equal(k_pipe_get_finish(ppipe, claimed), 0, NULL);
+		ref += claimed;
+		len -= claimed;
+	}
+}
+
+static void thread_for_get(void *p1, void *p2, void *p3)
+{
+	tpipe_get((struct k_pipe *)p1, K_FOREVER);
+	k_sem_give(&end_sema);
+}
+
+static void thread_for_put(void *p1, void *p2, void *p3)
+{
+	tpipe_put((struct k_pipe *)p1, K_FOREVER);
+	k_sem_give(&end_sema);
+}
+
 /**
  * @addtogroup kernel_pipe_tests
  * @{
@@ -394,6 +441,75 @@ void test_pipe_block_writer_wait(void)
 	k_thread_abort(tid1);
 }
 
+/**
+ * @brief Test in place pipe writing and reading
+ * @details Data committed through claims must wrap around the end of
+ * the pipe buffer and be read back unchanged, and the claimed sizes must
+ * be limited by the free space and available data.
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim_put_get(void)
+{
+	unsigned char *buf;
+
+	/* Move the indexes away from the start of the buffer */
+	tpipe_claim_put(&kpipe_claim, data, BYTES_TO_WRITE);
+	tpipe_claim_get(&kpipe_claim, data, BYTES_TO_WRITE);
+
+	/**TESTPOINT: claimed space ends at the end of the buffer*/
+	zassert_equal(k_pipe_put_claim(&kpipe_claim, &buf, PIPE_LEN),
+		      PIPE_LEN - BYTES_TO_WRITE, NULL);
+	/**TESTPOINT: committing more than claimed fails*/
+	zassert_equal(k_pipe_put_finish(&kpipe_claim, PIPE_LEN), -EINVAL,
+		      NULL);
+	zassert_equal(k_pipe_put_finish(&kpipe_claim, 0), 0, NULL);
+
+	tpipe_claim_put(&kpipe_claim, data, PIPE_LEN);
+
+	/**TESTPOINT: no space can be claimed in a full pipe*/
+	zassert_equal(k_pipe_put_claim(&kpipe_claim, &buf, 1), 0, NULL);
+	zassert_equal(k_pipe_put_finish(&kpipe_claim, 0), 0, NULL);
+
+	tpipe_claim_get(&kpipe_claim, data, PIPE_LEN);
+
+	/**TESTPOINT: no data can be claimed in an empty pipe*/
+	zassert_equal(k_pipe_get_claim(&kpipe_claim, &buf, 1), 0, NULL);
+	zassert_equal(k_pipe_get_finish(&kpipe_claim, 0), 0, NULL);
+}
+
+/**
+ * @brief Test in place pipe writing and reading with pending threads
+ * @details A commit must hand its data to a pending reader, and releasing
+ * claimed data must move the data of a pending writer into the pipe.
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim_waiters(void)
+{
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      thread_for_get, &kpipe_claim, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, 0);
+
+	/* Let the reader pend on the empty pipe */
+	k_sleep(1);
+	tpipe_claim_put(&kpipe_claim, data, PIPE_LEN);
+	k_sem_take(&end_sema, K_FOREVER);
+	k_thread_abort(tid);
+
+	tpipe_claim_put(&kpipe_claim, data, PIPE_LEN);
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      thread_for_put, &kpipe_claim, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, 0);
+
+	/* Let the writer pend on the full pipe */
+	k_sleep(1);
+	tpipe_claim_get(&kpipe_claim, data, PIPE_LEN);
+	k_sem_take(&end_sema, K_FOREVER);
+	tpipe_get(&kpipe_claim, K_NO_WAIT);
+	k_thread_abort(tid);
+}
+
 /**
  * @}
  */
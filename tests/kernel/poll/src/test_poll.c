@@ -608,6 +608,103 @@ void test_poll_threadstate(void)
 	k_thread_priority_set(k_current_get(), old_prio);
 }
 
+/* verify persistent poll sets */
+static K_SEM_DEFINE(set_sem, 0, 1);
+static K_FIFO_DEFINE(set_fifo);
+static struct k_poll_signal set_signal;
+static struct fifo_msg set_msg = { NULL, FIFO_MSG_VALUE };
+
+static void poll_set_helper(void *p1, void *p2, void *p3)
+{
+	(void)p1; (void)p2; (void)p3;
+
+	k_sleep(100);
+	k_fifo_put(&set_fifo, &set_msg);
+}
+
+/**
+ * @brief Test persistent poll sets
+ *
+ * @details Check that a poll set reports only the events that became
+ * ready, at most as many as asked for, that registrations survive
+ * between waits and that a wait blocks until an event fires.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_wait(), k_poll_set_cleanup()
+ */
+void test_poll_set(void)
+{
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &set_sem),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &set_fifo),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &set_signal),
+	};
+	struct k_poll_event *ready[ARRAY_SIZE(events)];
+	struct k_poll_set set;
+
+	k_poll_signal_init(&set_signal);
+	k_poll_set_init(&set, events, ARRAY_SIZE(events));
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/* registered events fire while nobody waits */
+	k_sem_give(&set_sem);
+	k_poll_signal_raise(&set_signal, SIGNAL_RESULT);
+
+	/** TESTPOINT: only as many events as asked for are reported */
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0], &events[0], NULL);
+	zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0, NULL);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0], &events[2], NULL);
+	zassert_equal(events[2].state, K_POLL_STATE_SIGNALED, NULL);
+	k_poll_signal_reset(&set_signal);
+
+	/** TESTPOINT: consumed events are not reported again */
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 50),
+		      -EAGAIN, NULL);
+
+	/** TESTPOINT: waiting blocks until an event fires */
+	k_thread_create(&test_thread, test_stack,
+			K_THREAD_STACK_SIZEOF(test_stack),
+			poll_set_helper, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 0);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_SECONDS(1)), 1, NULL);
+	zassert_equal(ready[0], &events[1], NULL);
+	zassert_equal(events[1].state, K_POLL_STATE_FIFO_DATA_AVAILABLE, NULL);
+	zassert_equal(k_fifo_get(&set_fifo, K_NO_WAIT), &set_msg, NULL);
+
+	/** TESTPOINT: cleanup drops all registrations */
+	k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	k_poll_set_cleanup(&set);
+	zassert_true(sys_dlist_is_empty(&set_sem.poll_events), NULL);
+	zassert_true(sys_dlist_is_empty(&set_fifo._queue.poll_events), NULL);
+	zassert_true(sys_dlist_is_empty(&set_signal.poll_events), NULL);
+
+	/** TESTPOINT: cleanup unlinks events that never registered */
+	events[0].type = K_POLL_TYPE_IGNORE;
+	k_poll_set_init(&set, events, ARRAY_SIZE(events));
+	k_poll_set_cleanup(&set);
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		zassert_false(sys_dnode_is_linked(&events[i]._node), NULL);
+	}
+}
+
 void test_poll_grant_access(void)
 {
 	k_thread_access_grant(k_current_get(), &no_wait_sem, &no_wait_fifo,
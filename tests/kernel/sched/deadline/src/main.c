@@ -90,9 +90,90 @@ void test_deadline(void)
 	}
 }
 
+/**
+ * @brief Test admission control of budget reservations
+ *
+ * @see k_thread_cbs_set()
+ */
+void test_cbs_admission(void)
+{
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	zassert_equal(k_thread_cbs_set(&worker_threads[0], 100, 200),
+		      -EINVAL, "budget above period accepted");
+	zassert_equal(k_thread_cbs_set(&worker_threads[0], 0, 0),
+		      -EINVAL, "zero period accepted");
+
+	zassert_equal(k_thread_cbs_set(&worker_threads[0], 100, 60), 0, "");
+	/** TESTPOINT: 120% of the CPU can't be reserved */
+	zassert_equal(k_thread_cbs_set(&worker_threads[1], 100, 60),
+		      -EBUSY, "CPU oversubscribed");
+	/** TESTPOINT: changing a reservation replaces the old one */
+	zassert_equal(k_thread_cbs_set(&worker_threads[0], 100, 40), 0, "");
+	zassert_equal(k_thread_cbs_set(&worker_threads[1], 100, 60), 0, "");
+
+	zassert_equal(k_thread_cbs_set(&worker_threads[0], 100, 0), 0, "");
+	zassert_equal(k_thread_cbs_set(&worker_threads[1], 100, 0), 0, "");
+#else
+	ztest_test_skip();
+#endif
+}
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+#define CBS_PERIOD 50
+#define CBS_BUDGET 10
+
+struct k_thread cbs_thread;
+K_THREAD_STACK_DEFINE(cbs_stack, STACK_SIZE);
+
+void cbs_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Way more than the budget */
+	k_busy_wait(3 * CBS_BUDGET * USEC_PER_MSEC);
+
+	while (1) {
+		k_sleep(1000000);
+	}
+}
+#endif
+
+/**
+ * @brief Test that exhausting the budget is counted as an overrun
+ *
+ * @see k_thread_cbs_set(), k_thread_cbs_overruns_get()
+ */
+void test_cbs_overrun(void)
+{
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	k_thread_create(&cbs_thread, cbs_stack, STACK_SIZE,
+			cbs_worker, NULL, NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_FOREVER);
+	zassert_equal(k_thread_cbs_set(&cbs_thread, CBS_PERIOD, CBS_BUDGET),
+		      0, "");
+	k_thread_start(&cbs_thread);
+
+	k_sleep(2 * CBS_PERIOD);
+
+	zassert_true(k_thread_cbs_overruns_get(&cbs_thread) > 0,
+		     "overrun not counted");
+
+	/** TESTPOINT: aborting the thread gives its reservation back */
+	k_thread_abort(&cbs_thread);
+	zassert_equal(k_thread_cbs_set(&worker_threads[0], 100, 100), 0, "");
+	zassert_equal(k_thread_cbs_set(&worker_threads[0], 100, 0), 0, "");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(suite_deadline,
-			 ztest_unit_test(test_deadline));
+			 ztest_unit_test(test_deadline),
+			 ztest_unit_test(test_cbs_admission),
+			 ztest_unit_test(test_cbs_overrun));
 	ztest_run_test_suite(suite_deadline);
 }
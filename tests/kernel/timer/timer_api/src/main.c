@@ -533,6 +533,61 @@ void test_timer_remaining_get(void)
 	zassert_true(remaining <= (DURATION / 2) + __ticks_to_ms(1), NULL);
 }
 
+#define HR_EXPIRE_TIMES 40
+
+static struct k_timer hr_timer;
+static u32_t hr_stamp[HR_EXPIRE_TIMES];
+static int hr_expire_cnt;
+
+static void hr_expire(struct k_timer *timer)
+{
+	hr_stamp[hr_expire_cnt++] = k_cycle_get_32();
+	if (hr_expire_cnt == HR_EXPIRE_TIMES) {
+		k_timer_stop(timer);
+	}
+}
+
+/**
+ * @brief Test periodic high-resolution timer below the tick period
+ *
+ * Starts a timer with a period of a quarter tick using
+ * k_timer_start_cycles() and checks that no expiry comes early and
+ * that all of them are done within one or two ticks of the ideal time,
+ * which tick based timeouts can not achieve.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start_cycles(), k_timer_stop(), k_cycle_get_32()
+ */
+void test_timer_start_cycles(void)
+{
+#ifdef CONFIG_SYS_CLOCK_HR_TIMEOUT
+	u32_t period = sys_clock_hw_cycles_per_tick() / 4;
+	u32_t start;
+
+	k_timer_init(&hr_timer, hr_expire, NULL);
+	hr_expire_cnt = 0;
+
+	start = k_cycle_get_32();
+	k_timer_start_cycles(&hr_timer, period, period);
+	k_sleep(__ticks_to_ms(HR_EXPIRE_TIMES) + 100);
+
+	zassert_equal(hr_expire_cnt, HR_EXPIRE_TIMES, NULL);
+
+	for (int i = 0; i < HR_EXPIRE_TIMES; i++) {
+		/** TESTPOINT: expiries are never early */
+		zassert_true(hr_stamp[i] - start >= (i + 1) * period, NULL);
+	}
+
+	/** TESTPOINT: periodic expiries don't wait for a tick each */
+	zassert_true(hr_stamp[HR_EXPIRE_TIMES - 1] - start <
+		     HR_EXPIRE_TIMES * period +
+		     2 * sys_clock_hw_cycles_per_tick(), NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -565,6 +620,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_status_sync),
 			 ztest_user_unit_test(test_timer_k_define),
 			 ztest_user_unit_test(test_timer_user_data),
-			 ztest_user_unit_test(test_timer_remaining_get));
+			 ztest_user_unit_test(test_timer_remaining_get),
+			 ztest_unit_test(test_timer_start_cycles));
 	ztest_run_test_suite(timer_api);
 }
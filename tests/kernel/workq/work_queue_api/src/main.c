@@ -23,6 +23,11 @@ static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
 static K_THREAD_STACK_DEFINE(user_tstack, STACK_SIZE);
 static struct k_work_q workq;
 static struct k_work_q user_workq;
+static K_THREAD_STACK_DEFINE(pool_tstack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(pool_worker_tstack, STACK_SIZE);
+static struct k_work_q pool_workq;
+static struct k_thread pool_worker;
+static struct k_work pool_work[NUM_OF_WORK];
 static ZTEST_BMEM struct k_work work[NUM_OF_WORK];
 static struct k_delayed_work new_work;
 static struct k_delayed_work delayed_work[NUM_OF_WORK], delayed_work_sleepy;
@@ -510,6 +515,73 @@ void test_delayed_work_cancel_isr(void)
 	}
 }
 
+/**
+ * @brief Test work queue with an additional worker thread
+ *
+ * @details Submit a sleeping work item followed by another one; the
+ * second worker thread must process the latter while the first one is
+ * still sleeping.
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_q_start(), k_work_q_worker_add()
+ */
+void test_workq_worker_add(void)
+{
+	k_work_q_start(&pool_workq, pool_tstack, STACK_SIZE,
+		       CONFIG_MAIN_THREAD_PRIORITY);
+
+	/**TESTPOINT: invalid CPU number is refused*/
+	zassert_equal(k_work_q_worker_add(&pool_workq, &pool_worker,
+					  pool_worker_tstack, STACK_SIZE,
+					  CONFIG_MAIN_THREAD_PRIORITY,
+					  CONFIG_MP_NUM_CPUS), -EINVAL, NULL);
+	zassert_equal(k_work_q_worker_add(&pool_workq, &pool_worker,
+					  pool_worker_tstack, STACK_SIZE,
+					  CONFIG_MAIN_THREAD_PRIORITY, -1),
+		      0, NULL);
+
+	k_sem_reset(&sync_sema);
+	k_work_init(&pool_work[0], work_sleepy);
+	k_work_init(&pool_work[1], work_handler);
+	k_work_submit_to_queue(&pool_workq, &pool_work[0]);
+	k_work_submit_to_queue(&pool_workq, &pool_work[1]);
+
+	/**TESTPOINT: second item is not held up by the sleeping one*/
+	zassert_equal(k_sem_take(&sync_sema, TIMEOUT / 2), 0, NULL);
+	zassert_equal(k_sem_take(&sync_sema, K_FOREVER), 0, NULL);
+}
+
+/**
+ * @brief Test work queue and work item statistics
+ *
+ * @details Runs after test_workq_worker_add(), check each item is
+ * accounted for once and the sleeping handler is reported as the slowest.
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_q_stats_get(), k_work_stats_get()
+ */
+void test_workq_stats(void)
+{
+#ifdef CONFIG_WORKQUEUE_STATS
+	struct k_work_q_stats q_stats;
+	struct k_work_stats stats;
+
+	k_work_q_stats_get(&pool_workq, &q_stats);
+	zassert_equal(q_stats.count, NUM_OF_WORK, NULL);
+	zassert_equal(q_stats.run_max_handler, work_sleepy, NULL);
+	zassert_true(q_stats.run_total >= q_stats.run_max, NULL);
+
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		k_work_stats_get(&pool_work[i], &stats);
+		zassert_equal(stats.count, 1, NULL);
+		zassert_true(stats.wait_max <= q_stats.wait_max, NULL);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
 
 void test_main(void)
 {
@@ -542,6 +614,8 @@ void test_main(void)
 			 ztest_unit_test(test_delayed_work_cancel_from_queue_thread),
 			 ztest_unit_test(test_delayed_work_cancel_from_queue_isr),
 			 ztest_unit_test(test_delayed_work_cancel_thread),
-			 ztest_unit_test(test_delayed_work_cancel_isr));
+			 ztest_unit_test(test_delayed_work_cancel_isr),
+			 ztest_unit_test(test_workq_worker_add),
+			 ztest_unit_test(test_workq_stats));
 	ztest_run_test_suite(workqueue_api);
 }
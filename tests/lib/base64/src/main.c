@@ -128,10 +128,101 @@ static void test_base64_codec(void)
 	zassert_equal(rc, -ENOMEM, "Error: dst NULL: decode test return value");
 }
 
+static const unsigned char base64url_test_enc[] =
+	"JEhuVodiWr2_F9mixBcaAZTtjx4Rs9cJDLbpEG8i7hPK"
+	"swcFdsn6MWwINP-Nwmw4AEPpVJevUEvRQbqVMVoLlw";
+
+static void test_base64url_codec(void)
+{
+	unsigned char buffer[128];
+	size_t len;
+	int rc;
+
+	rc = base64url_encode(buffer, sizeof(buffer), &len, base64_test_dec,
+			      64);
+	zassert_equal(rc, 0, "Encode test return value");
+	zassert_equal(len, 86, "Encode test length");
+	rc = memcmp(base64url_test_enc, buffer, 87);
+	zassert_equal(rc, 0, "Encode test comparison");
+
+	rc = base64url_decode(buffer, sizeof(buffer), &len, base64url_test_enc,
+			      86);
+	zassert_equal(rc, 0, "Decode test return value");
+	zassert_equal(len, 64, "Decode test length");
+	rc = memcmp(base64_test_dec, buffer, 64);
+	zassert_equal(rc, 0, "Decode test comparison");
+
+	rc = base64url_decode(buffer, sizeof(buffer), &len, base64_test_enc,
+			      88);
+	zassert_equal(rc, -EINVAL, "Error: alphabet: decode test return value");
+
+	rc = base64url_decode(buffer, sizeof(buffer), &len, base64url_test_enc,
+			      85);
+	zassert_equal(rc, -EINVAL, "Error: group: decode test return value");
+}
+
+static void test_base64_stream(void)
+{
+	struct base64_stream stream;
+	unsigned char buffer[128];
+	size_t len, total;
+	int rc;
+	int i;
+
+	/* Encode in chunks of 5 bytes, not a multiple of the group size */
+	base64_stream_init(&stream, false);
+	for (i = 0, total = 0; i < 64; i += 5) {
+		rc = base64_encode_update(&stream, buffer + total,
+					  sizeof(buffer) - total, &len,
+					  base64_test_dec + i, MIN(5, 64 - i));
+		zassert_equal(rc, 0, "Encode update return value");
+		total += len;
+	}
+
+	rc = base64_encode_finish(&stream, buffer + total,
+				  sizeof(buffer) - total, &len);
+	zassert_equal(rc, 0, "Encode finish return value");
+	total += len;
+	zassert_equal(total, 88, "Encode test length");
+	rc = memcmp(base64_test_enc, buffer, 88);
+	zassert_equal(rc, 0, "Encode test comparison");
+
+	/* Decode in chunks of 7 characters, with a line break */
+	base64_stream_init(&stream, false);
+	for (i = 0, total = 0; i < 88; i += 7) {
+		rc = base64_decode_update(&stream, buffer + total,
+					  sizeof(buffer) - total, &len,
+					  base64_test_enc5 + i, MIN(7, 88 - i));
+		zassert_equal(rc, 0, "Decode update return value");
+		total += len;
+	}
+
+	rc = base64_decode_finish(&stream);
+	zassert_equal(rc, 0, "Decode finish return value");
+
+	/* test error paths */
+	base64_stream_init(&stream, false);
+	rc = base64_encode_update(&stream, buffer, 3, &len, base64_test_dec, 6);
+	zassert_equal(rc, -ENOMEM, "Error: dlen: encode test return value");
+	zassert_equal(len, 8, "Error: dlen: length value");
+
+	rc = base64_decode_update(&stream, buffer, sizeof(buffer), &len,
+				  base64_test_enc4, 88);
+	zassert_equal(rc, -EINVAL, "Error: equal: decode test return value");
+
+	rc = base64_decode_update(&stream, buffer, sizeof(buffer), &len,
+				  base64_test_enc, 87);
+	zassert_equal(rc, 0, "Truncated: decode test return value");
+	rc = base64_decode_finish(&stream);
+	zassert_equal(rc, -EINVAL, "Error: truncated: decode finish value");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_base64_test,
-			 ztest_unit_test(test_base64_codec));
+			 ztest_unit_test(test_base64_codec),
+			 ztest_unit_test(test_base64url_codec),
+			 ztest_unit_test(test_base64_stream));
 
 	ztest_run_test_suite(lib_base64_test);
 }
@@ -519,6 +519,123 @@ static void test_json_escape_bounds_check(void)
 	zassert_equal(ret, -ENOMEM, "Bounds check OK");
 }
 
+struct stream_output {
+	char buf[256];
+	size_t len;
+};
+
+static int stream_append(const char *bytes, size_t len, void *data)
+{
+	struct stream_output *out = data;
+
+	if (len > sizeof(out->buf) - out->len - 1) {
+		return -ENOMEM;
+	}
+
+	memcpy(out->buf + out->len, bytes, len);
+	out->len += len;
+	out->buf[out->len] = '\0';
+
+	return 0;
+}
+
+static void test_json_encode_stream(void)
+{
+	struct test_nested nested = {
+		.nested_int = -1234,
+		.nested_bool = true,
+		.nested_string = "this should be escaped: \t",
+	};
+	const char *encoded = "{\"nested_int\":-1234,\"nested_bool\":true,"
+		"\"nested_string\":\"this should be escaped: \\t\"}";
+	struct stream_output out = { .len = 0 };
+	char buf[5];
+	int ret;
+
+	ret = json_obj_encode_stream(nested_descr, ARRAY_SIZE(nested_descr),
+				     &nested, buf, sizeof(buf), stream_append,
+				     &out);
+	zassert_equal(ret, 0, "Encoding function returned no errors");
+	zassert_true(!strcmp(out.buf, encoded), "Encoded contents consistent");
+}
+
+static int stream_record(enum json_tokens token, const char *key,
+			 const char *value, size_t len, void *data)
+{
+	char token_str[2] = { token, '\0' };
+	struct stream_output *out = data;
+
+	if (key) {
+		stream_append(key, strlen(key), out);
+		stream_append("=", 1, out);
+	}
+
+	stream_append(token_str, 1, out);
+	if (value) {
+		stream_append(value, len, out);
+	}
+
+	return stream_append(" ", 1, out);
+}
+
+static void test_json_stream_parse(void)
+{
+	const char *doc = "{\"some_string\": \"zephyr \\\"123\\u00e9\","
+		"\"some_array\":[11, -22.5,true,\tnull, {}],\n"
+		"\"nested\": {\"some_bool\" :false}} ";
+	const char *expected = "{ some_string=\"zephyr \\\"123\\u00e9 "
+		"some_array=[ 011 0-22.5 ttrue nnull { } ] "
+		"nested={ some_bool=ffalse } } ";
+	struct json_stream_parser parser;
+	struct stream_output out = { .len = 0 };
+	char buf[32];
+	size_t i;
+	int ret;
+
+	json_stream_parser_init(&parser, buf, sizeof(buf), stream_record,
+				&out);
+
+	/* Feed the document one byte at a time */
+	for (i = 0; i < strlen(doc); i++) {
+		ret = json_stream_parse(&parser, &doc[i], 1);
+		zassert_equal(ret, 0, "Chunk parsed");
+	}
+
+	ret = json_stream_parse_end(&parser);
+	zassert_equal(ret, 0, "Document complete");
+	zassert_true(!strcmp(out.buf, expected), "Tokens reported correctly");
+}
+
+static void test_json_stream_parse_invalid(void)
+{
+	const char *invalid[] = {
+		"{\"a\" 1}", "[1,]", "{,}", "[1 2]", "[}", "{\"a\":1}{",
+		"\"\\x\"", "tru", "[",
+	};
+	struct json_stream_parser parser;
+	struct stream_output out;
+	char buf[4];
+	size_t i;
+	int ret;
+
+	for (i = 0; i < ARRAY_SIZE(invalid); i++) {
+		json_stream_parser_init(&parser, buf, sizeof(buf),
+					stream_record, &out);
+		out.len = 0;
+
+		(void)json_stream_parse(&parser, invalid[i],
+					strlen(invalid[i]));
+		ret = json_stream_parse_end(&parser);
+		zassert_equal(ret, -EINVAL, "Invalid document rejected");
+	}
+
+	json_stream_parser_init(&parser, buf, sizeof(buf), stream_record,
+				&out);
+	out.len = 0;
+	ret = json_stream_parse(&parser, "\"abcd\"", 6);
+	zassert_equal(ret, -ENOMEM, "Token larger than buffer rejected");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
@@ -539,7 +656,10 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_one),
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
-			 ztest_unit_test(test_json_escape_bounds_check)
+			 ztest_unit_test(test_json_escape_bounds_check),
+			 ztest_unit_test(test_json_encode_stream),
+			 ztest_unit_test(test_json_stream_parse),
+			 ztest_unit_test(test_json_stream_parse_invalid)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
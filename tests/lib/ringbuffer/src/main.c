@@ -443,6 +443,67 @@ void test_reset(void)
 	zassert_true(granted == RINGBUFFER_SIZE - 1, NULL);
 }
 
+#define SPSC_BYTES 1000
+
+static u8_t spsc_next_put;
+static u32_t spsc_put_count;
+
+static void spsc_producer(struct k_timer *timer)
+{
+	u8_t data[7];
+	u32_t len = MIN(sizeof(data), SPSC_BYTES - spsc_put_count);
+
+	for (int i = 0; i < len; i++) {
+		data[i] = spsc_next_put + i;
+	}
+
+	len = ring_buf_put(&ringbuf_raw, data, len);
+	spsc_next_put += len;
+	spsc_put_count += len;
+
+	if (spsc_put_count == SPSC_BYTES) {
+		k_timer_stop(timer);
+	}
+}
+
+K_TIMER_DEFINE(spsc_timer, spsc_producer, NULL);
+
+/**
+ * @brief Test a producer ISR and a consumer thread sharing a ring buffer
+ * without any locking
+ *
+ * @details The timer ISR fills the buffer with a running byte counter
+ * while the test thread drains it; every byte must arrive exactly once
+ * and in order.
+ *
+ * @see ring_buf_put(), ring_buf_get()
+ */
+void test_ringbuffer_spsc(void)
+{
+	u8_t outdata[5];
+	u8_t expected = 0U;
+	u32_t received = 0U;
+	s64_t timeout = k_uptime_get() + 10 * MSEC_PER_SEC;
+
+	ring_buf_init(&ringbuf_raw, RINGBUFFER_SIZE, ringbuf_raw.buf.buf8);
+	k_timer_start(&spsc_timer, K_MSEC(1), K_MSEC(1));
+
+	while (received < SPSC_BYTES) {
+		u32_t len = ring_buf_get(&ringbuf_raw, outdata,
+					 sizeof(outdata));
+
+		for (int i = 0; i < len; i++) {
+			zassert_equal(outdata[i], expected++, NULL);
+		}
+		received += len;
+
+		zassert_true(k_uptime_get() < timeout, "producer stalled");
+	}
+
+	k_timer_stop(&spsc_timer);
+	zassert_true(ring_buf_is_empty(&ringbuf_raw), NULL);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -461,7 +522,8 @@ void test_main(void)
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_capacity),
-			 ztest_unit_test(test_reset)
+			 ztest_unit_test(test_reset),
+			 ztest_unit_test(test_ringbuffer_spsc)
 			 );
 	ztest_run_test_suite(test_ringbuffer_api);
 }
@@ -1160,9 +1160,32 @@ void test_loop(void)
 	net_pkt_print();
 }
 
+#if defined(CONFIG_NET_6LO_HDR_CACHE)
+/* Compress every flow twice in a row, the second packet gets its
+ * header from the cache and must uncompress to the same result.
+ */
+void test_loop_hdr_cache(void)
+{
+	int count;
+
+	for (count = 0; count < ARRAY_SIZE(tests); count++) {
+		TC_START(tests[count].name);
+
+		test_6lo(tests[count].data);
+		test_6lo(tests[count].data);
+	}
+}
+#else
+void test_loop_hdr_cache(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 /*test case main entry*/
 void test_main(void)
 {
-	ztest_test_suite(test_6lo, ztest_unit_test(test_loop));
+	ztest_test_suite(test_6lo, ztest_unit_test(test_loop),
+			 ztest_unit_test(test_loop_hdr_cache));
 	ztest_run_test_suite(test_6lo);
 }
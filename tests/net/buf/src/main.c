@@ -62,10 +62,13 @@ static int destroy_called;
 static void buf_destroy(struct net_buf *buf);
 static void fixed_destroy(struct net_buf *buf);
 static void var_destroy(struct net_buf *buf);
+static void slab_destroy(struct net_buf *buf);
 
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, 128, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, var_destroy);
+NET_BUF_POOL_SLAB_DEFINE(slab_pool, 10, 64, 4, 256, 2, 1024, 1,
+			 slab_destroy);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -94,6 +97,15 @@ static void var_destroy(struct net_buf *buf)
 	net_buf_destroy(buf);
 }
 
+static void slab_destroy(struct net_buf *buf)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+	destroy_called++;
+	zassert_equal(pool, &slab_pool, "Invalid free pointer in buffer");
+	net_buf_destroy(buf);
+}
+
 static const char example_data[] = "0123456789"
 				   "abcdefghijklmnopqrstuvxyz"
 				   "!#¤%&/()=?";
@@ -457,6 +469,77 @@ static void net_buf_test_var_pool(void)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+static void net_buf_test_slab_pool(void)
+{
+	struct net_buf *small[4], *buf1, *buf2, *buf3;
+	struct net_buf_slab_stats stats;
+	int i;
+
+	destroy_called = 0;
+
+	for (i = 0; i < ARRAY_SIZE(small); i++) {
+		small[i] = net_buf_alloc_len(&slab_pool, 20, K_NO_WAIT);
+		zassert_not_null(small[i], "Failed to get buffer");
+		zassert_equal(small[i]->size, 20, "Invalid buffer size");
+	}
+
+	/* Small class exhausted, served by the medium one */
+	buf1 = net_buf_alloc_len(&slab_pool, 20, K_NO_WAIT);
+	zassert_not_null(buf1, "Failed to get buffer");
+
+	/* Larger than the biggest class, truncated to it */
+	buf2 = net_buf_alloc_len(&slab_pool, 2000, K_NO_WAIT);
+	zassert_not_null(buf2, "Failed to get buffer");
+	zassert_equal(buf2->size, 1024, "Invalid buffer size");
+
+	buf3 = net_buf_clone(buf2, K_NO_WAIT);
+	zassert_not_null(buf3, "Failed to clone buffer");
+	zassert_equal(buf3->data, buf2->data, "Cloned data doesn't match");
+
+	zassert_equal(net_buf_pool_slab_stats(&slab_pool, 0, &stats), 0,
+		      "Failed to get stats");
+	zassert_equal(stats.data_size, 64, "Invalid class size");
+	zassert_equal(stats.used, 4, "Invalid used count");
+	zassert_equal(stats.allocs, 4, "Invalid alloc count");
+
+	zassert_equal(net_buf_pool_slab_stats(&slab_pool, 1, &stats), 0,
+		      "Failed to get stats");
+	zassert_equal(stats.used, 1, "Invalid used count");
+	zassert_equal(stats.fallbacks, 1, "Invalid fallback count");
+
+	zassert_equal(net_buf_pool_slab_stats(&slab_pool, 2, &stats), 0,
+		      "Failed to get stats");
+	zassert_equal(stats.used, 1, "Invalid used count");
+
+	zassert_equal(net_buf_pool_slab_stats(&slab_pool, 3, &stats), -EINVAL,
+		      "Invalid class accepted");
+	zassert_equal(net_buf_pool_slab_stats(&fixed_pool, 0, &stats),
+		      -EINVAL, "Non slab pool accepted");
+
+	/* All classes are full now */
+	zassert_is_null(net_buf_alloc_len(&slab_pool, 300, K_NO_WAIT),
+			"Got buffer from exhausted classes");
+
+	for (i = 0; i < ARRAY_SIZE(small); i++) {
+		net_buf_unref(small[i]);
+	}
+
+	net_buf_unref(buf1);
+	net_buf_unref(buf2);
+	net_buf_unref(buf3);
+
+	zassert_equal(destroy_called, 7, "Incorrect destroy callback count");
+
+	for (i = 0; i < 3; i++) {
+		zassert_equal(net_buf_pool_slab_stats(&slab_pool, i, &stats), 0,
+			      "Failed to get stats");
+		zassert_equal(stats.used, 0, "Data not returned to its class");
+	}
+
+	zassert_is_null(net_buf_alloc(&slab_pool, K_NO_WAIT),
+			"Fixed size allocation from a slab pool accepted");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_buf_test,
@@ -468,7 +551,8 @@ void test_main(void)
 			 ztest_unit_test(net_buf_test_multi_frags),
 			 ztest_unit_test(net_buf_test_clone),
 			 ztest_unit_test(net_buf_test_fixed_pool),
-			 ztest_unit_test(net_buf_test_var_pool)
+			 ztest_unit_test(net_buf_test_var_pool),
+			 ztest_unit_test(net_buf_test_slab_pool)
 			 );
 
 	ztest_run_test_suite(net_buf_test);
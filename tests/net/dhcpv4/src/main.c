@@ -155,6 +155,7 @@ struct dhcp_msg {
 };
 
 static struct k_sem test_lock;
+static int discover_count;
 
 #define WAIT_TIME K_SECONDS(CONFIG_NET_DHCPV4_INITIAL_DELAY_MAX + 1)
 
@@ -347,6 +348,8 @@ static int tester_send(struct device *dev, struct net_pkt *pkt)
 	parse_dhcp_message(pkt, &msg);
 
 	if (msg.type == DISCOVER) {
+		discover_count++;
+
 		/* Reply with DHCPv4 offer message */
 		rpkt = prepare_dhcp_offer(net_pkt_iface(pkt), msg.xid);
 		if (!rpkt) {
@@ -388,6 +391,7 @@ NET_DEVICE_INIT(net_dhcpv4_test, "net_dhcpv4_test",
 static struct net_mgmt_event_callback rx_cb;
 static struct net_mgmt_event_callback dns_cb;
 static int event_count;
+static int addr_add_count;
 
 static void receiver_cb(struct net_mgmt_event_callback *cb,
 			u32_t nm_event, struct net_if *iface)
@@ -401,6 +405,10 @@ static void receiver_cb(struct net_mgmt_event_callback *cb,
 
 	event_count++;
 
+	if (nm_event == NET_EVENT_IPV4_ADDR_ADD) {
+		addr_add_count++;
+	}
+
 	k_sem_give(&test_lock);
 }
 
@@ -435,10 +443,41 @@ void test_dhcp(void)
 	}
 }
 
+void test_dhcp_init_reboot(void)
+{
+	struct net_if *iface = net_if_get_default();
+	s64_t start;
+
+	if (!IS_ENABLED(CONFIG_NET_DHCPV4_INIT_REBOOT)) {
+		ztest_test_skip();
+	}
+
+	/* Restart the client bound by the previous test */
+	net_dhcpv4_stop(iface);
+
+	discover_count = 0;
+	addr_add_count = 0;
+
+	start = k_uptime_get();
+	net_dhcpv4_start(iface);
+
+	while (addr_add_count < 1) {
+		if (k_sem_take(&test_lock, WAIT_TIME)) {
+			zassert_true(false, "Timeout while waiting");
+		}
+	}
+
+	/**TESTPOINT: the previous address is requested right away */
+	zassert_equal(discover_count, 0, "Servers were discovered again");
+	zassert_true(k_uptime_get() - start < K_SECONDS(1),
+		     "Initial delay was not skipped");
+}
+
 /**test case main entry */
 void test_main(void)
 {
 	ztest_test_suite(test_dhcpv4,
-			ztest_unit_test(test_dhcp));
+			ztest_unit_test(test_dhcp),
+			ztest_unit_test(test_dhcp_init_reboot));
 	ztest_run_test_suite(test_dhcpv4);
 }
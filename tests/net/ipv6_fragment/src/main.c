@@ -1945,98 +1945,99 @@ static u8_t ipv6_reass_frag2[] = {
 0x3a, 0x00, 0x04, 0xd0, 0x7c, 0x8e, 0x53, 0x49
 };
 
-static void test_recv_ipv6_fragment(void)
+static enum net_verdict recv_reass_frag(const u8_t *frag, size_t frag_len,
+					u8_t data, u16_t payload_len)
 {
 	struct net_ipv6_hdr ipv6_hdr;
 	struct net_pkt_cursor backup;
-	struct net_pkt *pkt1;
-	struct net_pkt *pkt2;
-	u16_t total_payload_len;
-	u16_t payload1_len;
-	u16_t payload2_len;
-	u8_t data;
+	struct net_pkt *pkt;
 	int ret;
 
-	/* Fragment 1 */
-	data = 0U;
-	total_payload_len = 1300U;
-	payload1_len = NET_IPV6_MTU - sizeof(ipv6_reass_frag1);
-	payload2_len = total_payload_len - payload1_len;
-
-	pkt1 = net_pkt_alloc_with_buffer(iface1, NET_IPV6_MTU, AF_UNSPEC,
-					 0, ALLOC_TIMEOUT);
-	zassert_not_null(pkt1, "packet");
+	pkt = net_pkt_alloc_with_buffer(iface1, payload_len + frag_len,
+					AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
 
-	net_pkt_set_family(pkt1, AF_INET6);
-	net_pkt_set_ip_hdr_len(pkt1, sizeof(struct net_ipv6_hdr));
-	net_pkt_cursor_init(pkt1);
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_cursor_init(pkt);
 
-	memcpy(&ipv6_hdr, ipv6_reass_frag1, sizeof(struct net_ipv6_hdr));
+	memcpy(&ipv6_hdr, frag, sizeof(struct net_ipv6_hdr));
 
-	ret = net_pkt_write(pkt1, ipv6_reass_frag1,
-			    sizeof(struct net_ipv6_hdr) + 1);
+	ret = net_pkt_write(pkt, frag, sizeof(struct net_ipv6_hdr) + 1);
 	zassert_true(ret == 0, "IPv6 header append failed");
 
-	net_pkt_cursor_backup(pkt1, &backup);
+	net_pkt_cursor_backup(pkt, &backup);
 
-	ret = net_pkt_write(pkt1,
-			    ipv6_reass_frag1 + sizeof(struct net_ipv6_hdr) + 1,
-			    sizeof(ipv6_reass_frag1) -
-			    sizeof(struct net_ipv6_hdr) - 1);
+	ret = net_pkt_write(pkt, frag + sizeof(struct net_ipv6_hdr) + 1,
+			    frag_len - sizeof(struct net_ipv6_hdr) - 1);
 	zassert_true(ret == 0, "IPv6 fragment header append failed");
 
-	while (payload1_len--) {
-		ret = net_pkt_write_u8(pkt1, data++);
+	while (payload_len--) {
+		ret = net_pkt_write_u8(pkt, data++);
 		zassert_true(ret == 0, "IPv6 header append failed");
 	}
 
-	net_pkt_set_ipv6_fragment_start(pkt1, sizeof(struct net_ipv6_hdr));
-	net_pkt_set_overwrite(pkt1, true);
+	net_pkt_set_ipv6_fragment_start(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_overwrite(pkt, true);
 
-	net_pkt_cursor_restore(pkt1, &backup);
+	net_pkt_cursor_restore(pkt, &backup);
 
-	ret = net_ipv6_handle_fragment_hdr(pkt1, &ipv6_hdr,
-					   NET_IPV6_NEXTHDR_FRAG);
-	zassert_true(ret == NET_OK, "IPv6 frag1 reassembly failed");
+	return net_ipv6_handle_fragment_hdr(pkt, &ipv6_hdr,
+					    NET_IPV6_NEXTHDR_FRAG);
+}
 
-	/* Fragment 2 */
+static void count_pending(struct net_ipv6_reassembly *reass, void *user_data)
+{
+	(*(int *)user_data)++;
+}
 
-	pkt2 = net_pkt_alloc_with_buffer(iface1, payload2_len +
-					 sizeof(ipv6_reass_frag2),
-					 AF_UNSPEC, 0, ALLOC_TIMEOUT);
-	zassert_not_null(pkt2, "packet");
+static void test_recv_ipv6_fragment(void)
+{
+	u16_t total_payload_len;
+	u16_t payload1_len;
+	u16_t payload2_len;
+	int ret;
 
-	net_pkt_set_family(pkt2, AF_INET6);
-	net_pkt_set_ip_hdr_len(pkt2, sizeof(struct net_ipv6_hdr));
-	net_pkt_cursor_init(pkt2);
+	total_payload_len = 1300U;
+	payload1_len = NET_IPV6_MTU - sizeof(ipv6_reass_frag1);
+	payload2_len = total_payload_len - payload1_len;
 
-	memcpy(&ipv6_hdr, ipv6_reass_frag2, sizeof(struct net_ipv6_hdr));
+	ret = recv_reass_frag(ipv6_reass_frag1, sizeof(ipv6_reass_frag1),
+			      0U, payload1_len);
+	zassert_true(ret == NET_OK, "IPv6 frag1 reassembly failed");
 
-	ret = net_pkt_write(pkt2, ipv6_reass_frag2,
-			    sizeof(struct net_ipv6_hdr) + 1);
-	zassert_true(ret == 0, "IPv6 header append failed");
+	ret = recv_reass_frag(ipv6_reass_frag2, sizeof(ipv6_reass_frag2),
+			      (u8_t)payload1_len, payload2_len);
+	zassert_true(ret == NET_OK, "IPv6 frag2 reassembly failed");
+}
 
-	net_pkt_cursor_backup(pkt2, &backup);
+static void test_recv_ipv6_fragment_reverse(void)
+{
+	u16_t total_payload_len;
+	u16_t payload1_len;
+	u16_t payload2_len;
+	int pending = 0;
+	int ret;
 
-	ret = net_pkt_write(pkt2,
-			    ipv6_reass_frag2 + sizeof(struct net_ipv6_hdr) + 1,
-			    sizeof(ipv6_reass_frag2) -
-			    sizeof(struct net_ipv6_hdr) - 1);
-	zassert_true(ret == 0, "IPv6 fragment header append failed");
+	total_payload_len = 1300U;
+	payload1_len = NET_IPV6_MTU - sizeof(ipv6_reass_frag1);
+	payload2_len = total_payload_len - payload1_len;
 
-	while (payload2_len--) {
-		ret = net_pkt_write_u8(pkt2, data++);
-		zassert_true(ret == 0, "IPv6 header append failed");
-	}
+	/* The last fragment arriving first must not end the reassembly */
+	ret = recv_reass_frag(ipv6_reass_frag2, sizeof(ipv6_reass_frag2),
+			      (u8_t)payload1_len, payload2_len);
+	zassert_true(ret == NET_OK, "IPv6 frag2 reassembly failed");
 
-	net_pkt_set_ipv6_fragment_start(pkt2, sizeof(struct net_ipv6_hdr));
-	net_pkt_set_overwrite(pkt2, true);
+	net_ipv6_frag_foreach(count_pending, &pending);
+	zassert_equal(pending, 1, "Reassembly not pending");
 
-	net_pkt_cursor_restore(pkt2, &backup);
+	ret = recv_reass_frag(ipv6_reass_frag1, sizeof(ipv6_reass_frag1),
+			      0U, payload1_len);
+	zassert_true(ret == NET_OK, "IPv6 frag1 reassembly failed");
 
-	ret = net_ipv6_handle_fragment_hdr(pkt2, &ipv6_hdr,
-					   NET_IPV6_NEXTHDR_FRAG);
-	zassert_true(ret == NET_OK, "IPv6 frag2 reassembly failed");
+	pending = 0;
+	net_ipv6_frag_foreach(count_pending, &pending);
+	zassert_equal(pending, 0, "Reassembly not completed");
 }
 
 void test_main(void)
@@ -2055,7 +2056,8 @@ void test_main(void)
 			 ztest_unit_test(test_send_ipv6_fragment),
 			 ztest_unit_test(test_send_ipv6_fragment_large_hbho),
 			 ztest_unit_test(test_send_ipv6_fragment_without_hbho),
-			 ztest_unit_test(test_recv_ipv6_fragment)
+			 ztest_unit_test(test_recv_ipv6_fragment),
+			 ztest_unit_test(test_recv_ipv6_fragment_reverse)
 			 );
 
 	ztest_run_test_suite(net_ipv6_fragment_test);
@@ -1067,6 +1067,60 @@ done:
 	return result;
 }
 
+static int test_block2_option(void)
+{
+	struct coap_block_context rsp_ctx;
+	struct coap_packet rsp;
+	u8_t data[COAP_BUF_SIZE];
+	u32_t block_number;
+	bool has_more;
+	int result = TC_FAIL;
+	int r;
+
+	r = coap_packet_init(&rsp, data, sizeof(data), 1, COAP_TYPE_ACK,
+			     0, NULL, COAP_RESPONSE_CODE_CONTENT,
+			     coap_next_id());
+	if (r < 0) {
+		TC_PRINT("Unable to initialize response\n");
+		goto done;
+	}
+
+	r = coap_get_block2_option(&rsp, &has_more, &block_number);
+	if (r != -ENOENT) {
+		TC_PRINT("Found a block2 option in an empty response\n");
+		goto done;
+	}
+
+	/* Third block of a transfer of four, as sent out of order */
+	coap_block_transfer_init(&rsp_ctx, COAP_BLOCK_64,
+				 BLOCK2_WISE_TRANSFER_SIZE_GET);
+	rsp_ctx.current = coap_block_size_to_bytes(COAP_BLOCK_64) * 2;
+
+	r = coap_append_block2_option(&rsp, &rsp_ctx);
+	if (r < 0) {
+		TC_PRINT("Unable to append block2 option\n");
+		goto done;
+	}
+
+	r = coap_get_block2_option(&rsp, &has_more, &block_number);
+	if (r != coap_block_size_to_bytes(COAP_BLOCK_64)) {
+		TC_PRINT("Couldn't get block size\n");
+		goto done;
+	}
+
+	if (block_number != 2U || !has_more) {
+		TC_PRINT("Couldn't get block number and more flag\n");
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static int test_retransmit_second_round(void)
 {
 	struct coap_packet cpkt;
@@ -1475,6 +1529,7 @@ static const struct {
 	{ "Test match path uri", test_match_path_uri, },
 	{ "Test block sized 1 transfer", test_block1_size, },
 	{ "Test block sized 2 transfer", test_block2_size, },
+	{ "Test block2 option", test_block2_option, },
 	{ "Test retransmission", test_retransmit_second_round, },
 	{ "Test observer server", test_observer_server, },
 	{ "Test observer client", test_observer_client, },
@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
+#include "dns_cache.h"
 
 #if defined(CONFIG_DNS_RESOLVER_LOG_LEVEL_DBG)
 #define DBG(fmt, ...) printk(fmt, ##__VA_ARGS__)
@@ -36,6 +37,8 @@ LOG_MODULE_REGISTER(net_test, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #define NAME6 "6.zephyr.test"
 #define NAME_IPV4 "192.0.2.1"
 #define NAME_IPV6 "2001:db8::1"
+#define NAME_CACHED "cached.zephyr.test"
+#define NAME_NEGATIVE "negative.zephyr.test"
 
 #define DNS_TIMEOUT 500 /* ms */
 
@@ -750,6 +753,125 @@ static void dns_query_ipv6_numeric(void)
 }
 #endif
 
+static void verify_no_pending(void)
+{
+	struct dns_resolve_context *ctx = dns_resolve_get_default();
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		zassert_is_null(ctx->queries[i].cb, "Query was sent");
+	}
+}
+
+static void dns_query_ipv4_cached(void)
+{
+	struct expected_addr_status status = {
+		.status1 = DNS_EAI_INPROGRESS,
+		.status2 = DNS_EAI_ALLDONE,
+		.caller = __func__,
+	};
+	struct dns_addrinfo info = { 0 };
+	int ret;
+
+	dns_cache_flush();
+
+	info.ai_family = AF_INET;
+	info.ai_addr.sa_family = AF_INET;
+	info.ai_addrlen = sizeof(struct sockaddr_in);
+	net_ipaddr_copy(&net_sin(&info.ai_addr)->sin_addr, &my_addr2);
+
+	dns_cache_add(NAME_CACHED, DNS_QUERY_TYPE_A, &info, 1, 60);
+
+	timeout_query = true;
+
+	ret = dns_get_addr_info(NAME_CACHED,
+				DNS_QUERY_TYPE_A,
+				NULL,
+				dns_result_numeric_cb,
+				&status,
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create cached query");
+
+	/** TESTPOINT: the answer is given right away, from the cache */
+	zassert_equal(k_sem_count_get(&wait_data2), 2, "No cached answer");
+	k_sem_reset(&wait_data2);
+	verify_no_pending();
+
+	timeout_query = false;
+}
+
+static void dns_query_negative_cached(void)
+{
+	struct expected_status status = {
+		.status1 = DNS_EAI_NODATA,
+		.status2 = DNS_EAI_NODATA,
+		.caller = __func__,
+	};
+	int ret;
+
+	dns_cache_add(NAME_NEGATIVE, DNS_QUERY_TYPE_A, NULL, 0, 0);
+
+	timeout_query = true;
+
+	ret = dns_get_addr_info(NAME_NEGATIVE,
+				DNS_QUERY_TYPE_A,
+				NULL,
+				dns_result_cb,
+				&status,
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create cached query");
+
+	zassert_equal(k_sem_count_get(&wait_data2), 1, "No cached answer");
+	k_sem_reset(&wait_data2);
+	verify_no_pending();
+
+	timeout_query = false;
+}
+
+static void dns_cache_expiry(void)
+{
+	struct dns_addrinfo info = { 0 };
+	bool refresh;
+	int ret;
+
+	dns_cache_flush();
+
+	info.ai_family = AF_INET;
+	info.ai_addr.sa_family = AF_INET;
+	info.ai_addrlen = sizeof(struct sockaddr_in);
+
+	dns_cache_add(NAME_CACHED, DNS_QUERY_TYPE_A, &info, 1, 1);
+
+	ret = dns_cache_find(NAME_CACHED, DNS_QUERY_TYPE_A, &info, 1,
+			     &refresh);
+	zassert_equal(ret, 1, "Entry not found");
+	zassert_false(refresh, "Fresh entry to be refreshed");
+
+	/** TESTPOINT: the other query type is not answered */
+	ret = dns_cache_find(NAME_CACHED, DNS_QUERY_TYPE_AAAA, &info, 1,
+			     &refresh);
+	zassert_equal(ret, -ENOENT, "Wrong query type found");
+
+	/** TESTPOINT: refresh is asked for once when close to expiry */
+	k_sleep(K_MSEC(950));
+
+	ret = dns_cache_find(NAME_CACHED, DNS_QUERY_TYPE_A, &info, 1,
+			     &refresh);
+	zassert_equal(ret, 1, "Entry not found");
+	zassert_true(refresh, "Old entry not to be refreshed");
+
+	ret = dns_cache_find(NAME_CACHED, DNS_QUERY_TYPE_A, &info, 1,
+			     &refresh);
+	zassert_equal(ret, 1, "Entry not found");
+	zassert_false(refresh, "Refresh asked for twice");
+
+	k_sleep(K_MSEC(100));
+
+	ret = dns_cache_find(NAME_CACHED, DNS_QUERY_TYPE_A, &info, 1,
+			     &refresh);
+	zassert_equal(ret, -ENOENT, "Expired entry found");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(dns_tests,
@@ -767,7 +889,10 @@ void test_main(void)
 			 ztest_unit_test(dns_query_ipv4_cancel),
 			 ztest_unit_test(dns_query_ipv6_cancel),
 			 ztest_unit_test(dns_query_ipv4),
-			 ztest_unit_test(dns_query_ipv4_numeric));
+			 ztest_unit_test(dns_query_ipv4_numeric),
+			 ztest_unit_test(dns_query_ipv4_cached),
+			 ztest_unit_test(dns_query_negative_cached),
+			 ztest_unit_test(dns_cache_expiry));
 
 	ztest_run_test_suite(dns_tests);
 }
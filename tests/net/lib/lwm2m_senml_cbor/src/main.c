@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2019 Foundries.io
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <errno.h>
+
+#include <net/coap.h>
+#include <net/lwm2m.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_rw_senml_cbor.h"
+
+static struct lwm2m_message msg;
+static struct coap_packet in_cpkt;
+static u8_t in_data[128];
+
+static void setup_read(u16_t res_id)
+{
+	int ret;
+
+	(void)memset(&msg, 0, sizeof(msg));
+	ret = coap_packet_init(&msg.cpkt, msg.msg_data, sizeof(msg.msg_data),
+			       1, COAP_TYPE_ACK, 0, NULL,
+			       COAP_RESPONSE_CODE_CONTENT, 0);
+	zassert_equal(ret, 0, "Could not init the response");
+
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.out.writer = &senml_cbor_writer;
+
+	msg.path.obj_id = LWM2M_OBJECT_SERVER_ID;
+	msg.path.obj_inst_id = 0U;
+	msg.path.res_id = res_id;
+	msg.path.level = 3U;
+}
+
+static void check_payload(const u8_t *expected, u16_t expected_len)
+{
+	struct coap_packet cpkt;
+	const u8_t *payload;
+	u16_t len;
+	int ret;
+
+	ret = coap_packet_parse(&cpkt, msg.msg_data, msg.cpkt.offset,
+				NULL, 0);
+	zassert_equal(ret, 0, "Could not parse the response");
+
+	payload = coap_packet_get_payload(&cpkt, &len);
+	zassert_not_null(payload, "No payload");
+	zassert_equal(len, expected_len, "Wrong payload length %u", len);
+	zassert_mem_equal(payload, expected, expected_len, "Wrong payload");
+}
+
+static int write_pack(const u8_t *pack, u16_t pack_len)
+{
+	int ret;
+
+	(void)memset(&msg, 0, sizeof(msg));
+	ret = coap_packet_init(&in_cpkt, in_data, sizeof(in_data),
+			       1, COAP_TYPE_CON, 0, NULL, COAP_METHOD_PUT, 0);
+	zassert_equal(ret, 0, "Could not init the request");
+	zassert_equal(coap_packet_append_payload_marker(&in_cpkt), 0, NULL);
+
+	msg.in.in_cpkt = &in_cpkt;
+	msg.in.offset = in_cpkt.offset;
+	msg.in.reader = &senml_cbor_reader;
+
+	zassert_equal(coap_packet_append_payload(&in_cpkt, (u8_t *)pack,
+						 pack_len), 0, NULL);
+
+	return do_write_op_senml_cbor(&msg);
+}
+
+static void test_senml_cbor_put_int(void)
+{
+	/* [_ {-2: "/1/0/", 0: "1", 2: 86400}] */
+	static const u8_t expected[] = {
+		0x9f, 0xa3,
+		0x21, 0x65, '/', '1', '/', '0', '/',
+		0x00, 0x61, '1',
+		0x02, 0x1a, 0x00, 0x01, 0x51, 0x80,
+		0xff,
+	};
+
+	zassert_equal(lwm2m_engine_set_u32("1/0/1", 86400), 0, NULL);
+
+	setup_read(1);
+	zassert_equal(do_read_op_senml_cbor(&msg,
+					    LWM2M_FORMAT_APP_SENML_CBOR), 0,
+		      "Read failed");
+	check_payload(expected, sizeof(expected));
+}
+
+static void test_senml_cbor_put_string(void)
+{
+	/* [_ {-2: "/1/0/", 0: "7", 3: "UQ"}] */
+	static const u8_t expected[] = {
+		0x9f, 0xa3,
+		0x21, 0x65, '/', '1', '/', '0', '/',
+		0x00, 0x61, '7',
+		0x03, 0x62, 'U', 'Q',
+		0xff,
+	};
+
+	zassert_equal(lwm2m_engine_set_string("1/0/7", "UQ"), 0, NULL);
+
+	setup_read(7);
+	zassert_equal(do_read_op_senml_cbor(&msg,
+					    LWM2M_FORMAT_APP_SENML_CBOR), 0,
+		      "Read failed");
+	check_payload(expected, sizeof(expected));
+}
+
+static void test_senml_cbor_get(void)
+{
+	/* [{-2: "/1/0/", 0: "1", 2: 3600}, {0: "7", 3: "U"}] */
+	static const u8_t pack[] = {
+		0x82,
+		0xa3,
+		0x21, 0x65, '/', '1', '/', '0', '/',
+		0x00, 0x61, '1',
+		0x02, 0x19, 0x0e, 0x10,
+		0xa2,
+		0x00, 0x61, '7',
+		0x03, 0x61, 'U',
+	};
+	char binding[4];
+	u32_t lifetime;
+
+	/** TESTPOINT: the base name applies to the following records */
+	zassert_equal(write_pack(pack, sizeof(pack)), 0, "Write failed");
+
+	zassert_equal(lwm2m_engine_get_u32("1/0/1", &lifetime), 0, NULL);
+	zassert_equal(lifetime, 3600, "Wrong lifetime %u", lifetime);
+	zassert_equal(lwm2m_engine_get_string("1/0/7", binding,
+					      sizeof(binding)), 0, NULL);
+	zassert_true(strcmp(binding, "U") == 0, "Wrong binding %s", binding);
+}
+
+static void test_senml_cbor_get_invalid(void)
+{
+	/* {0: "1", 2: 60}, not a pack */
+	static const u8_t not_a_pack[] = {
+		0xa2,
+		0x00, 0x61, '1',
+		0x02, 0x18, 0x3c,
+	};
+	/* [{-2: "/1/0/", 0: "1/0/0/0", 2: 60}] */
+	static const u8_t bad_path[] = {
+		0x81,
+		0xa3,
+		0x21, 0x65, '/', '1', '/', '0', '/',
+		0x00, 0x67, '1', '/', '0', '/', '0', '/', '0',
+		0x02, 0x18, 0x3c,
+	};
+	u32_t lifetime;
+
+	zassert_equal(write_pack(not_a_pack, sizeof(not_a_pack)), -EINVAL,
+		      NULL);
+	zassert_equal(write_pack(bad_path, sizeof(bad_path)), -EINVAL, NULL);
+
+	zassert_equal(lwm2m_engine_get_u32("1/0/1", &lifetime), 0, NULL);
+	zassert_equal(lifetime, 3600, "Lifetime changed to %u", lifetime);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lwm2m_senml_cbor,
+			 ztest_unit_test(test_senml_cbor_put_int),
+			 ztest_unit_test(test_senml_cbor_put_string),
+			 ztest_unit_test(test_senml_cbor_get),
+			 ztest_unit_test(test_senml_cbor_get_invalid));
+	ztest_run_test_suite(lwm2m_senml_cbor);
+}
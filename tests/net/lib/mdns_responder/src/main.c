@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_MDNS_RESPONDER_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/byteorder.h>
+
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/dummy.h>
+#include <net/mdns_responder.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#include <ztest.h>
+
+#define MDNS_PORT 5353
+
+#define DNS_HEADER_LEN 12
+#define DNS_RR_A 1
+#define DNS_RR_PTR 12
+#define DNS_RR_TXT 16
+#define DNS_RR_SRV 33
+
+/* The responder multicasts a record at most once per second */
+#define RATE_LIMIT K_MSEC(1100)
+#define WAIT_TIME K_MSEC(500)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr mdns_addr = { { { 224, 0, 0, 251 } } };
+
+static struct net_if *iface;
+static struct k_sem response_sem;
+static u8_t response[512];
+static u16_t response_len;
+
+#define HOST_NAME 6, 'z', 'e', 'p', 'h', 'y', 'r', 5, 'l', 'o', 'c', 'a', \
+	'l', 0
+#define SERVICE_NAME 5, '_', 'h', 't', 't', 'p', 4, '_', 't', 'c', 'p', \
+	5, 'l', 'o', 'c', 'a', 'l', 0
+#define INSTANCE_NAME 7, 'P', 'r', 'i', 'n', 't', 'e', 'r', SERVICE_NAME
+
+static const u8_t query_host[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+	HOST_NAME, 0x00, DNS_RR_A, 0x00, 0x01,
+};
+
+static const u8_t query_other_host[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+	5, 'o', 't', 'h', 'e', 'r', 5, 'l', 'o', 'c', 'a', 'l', 0,
+	0x00, DNS_RR_A, 0x00, 0x01,
+};
+
+static const u8_t query_service[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+	SERVICE_NAME, 0x00, DNS_RR_PTR, 0x00, 0x01,
+};
+
+/* The PTR answer is known already, with its whole TTL left */
+static const u8_t query_service_known[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00,
+	SERVICE_NAME, 0x00, DNS_RR_PTR, 0x00, 0x01,
+	0xc0, 0x0c, 0x00, DNS_RR_PTR, 0x00, 0x01,
+	(CONFIG_MDNS_RESPONDER_TTL >> 24) & 0xff,
+	(CONFIG_MDNS_RESPONDER_TTL >> 16) & 0xff,
+	(CONFIG_MDNS_RESPONDER_TTL >> 8) & 0xff,
+	CONFIG_MDNS_RESPONDER_TTL & 0xff,
+	0x00, 0x0a, 7, 'P', 'r', 'i', 'n', 't', 'e', 'r', 0xc0, 0x0c,
+};
+
+static const u8_t query_service_types[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+	9, '_', 's', 'e', 'r', 'v', 'i', 'c', 'e', 's',
+	7, '_', 'd', 'n', 's', '-', 's', 'd',
+	4, '_', 'u', 'd', 'p', 5, 'l', 'o', 'c', 'a', 'l', 0,
+	0x00, DNS_RR_PTR, 0x00, 0x01,
+};
+
+static const u8_t host_name[] = { HOST_NAME };
+static const u8_t service_name[] = { SERVICE_NAME };
+static const u8_t instance_name[] = { INSTANCE_NAME };
+
+static const struct mdns_service service = {
+	.instance = "Printer",
+	.service = "_http",
+	.proto = "_tcp",
+	.txt = (const u8_t *)"\x09txtvers=1",
+	.txt_len = 10,
+	.port = 80,
+};
+
+static int tester_send(struct device *dev, struct net_pkt *pkt)
+{
+	static u8_t data[sizeof(response) + NET_IPV4UDPH_LEN];
+	size_t len = net_pkt_get_len(pkt);
+
+	if (!pkt->frags) {
+		return -ENODATA;
+	}
+
+	if (len > sizeof(data) || len < NET_IPV4UDPH_LEN) {
+		return -EMSGSIZE;
+	}
+
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_read(pkt, data, len) < 0) {
+		return -EIO;
+	}
+
+	/* Only keep the multicast mDNS responses */
+	if (memcmp(&data[16], &mdns_addr, sizeof(mdns_addr)) ||
+	    sys_get_be16(&data[NET_IPV4H_LEN + 2]) != MDNS_PORT) {
+		return 0;
+	}
+
+	response_len = len - NET_IPV4UDPH_LEN;
+	memcpy(response, &data[NET_IPV4UDPH_LEN], response_len);
+
+	k_sem_give(&response_sem);
+
+	return 0;
+}
+
+static int tester_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static void tester_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static struct dummy_api tester_if_api = {
+	.iface_api.init = tester_iface_init,
+	.send = tester_send,
+};
+
+NET_DEVICE_INIT(mdns_responder_test, "mdns_responder_test",
+		tester_dev_init, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&tester_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* Returns true if the query got a response */
+static bool query(const u8_t *data, size_t len)
+{
+	struct net_pkt *pkt;
+
+	k_sem_reset(&response_sem);
+
+	pkt = net_pkt_alloc_with_buffer(iface, len, AF_INET, IPPROTO_UDP,
+					K_SECONDS(1));
+	zassert_not_null(pkt, "Out of mem");
+
+	net_pkt_set_ipv4_ttl(pkt, 255);
+
+	zassert_equal(net_ipv4_create(pkt, &peer_addr, &mdns_addr), 0,
+		      "Cannot create IPv4 packet");
+	zassert_equal(net_udp_create(pkt, htons(MDNS_PORT), htons(MDNS_PORT)),
+		      0, "Cannot create UDP packet");
+	zassert_equal(net_pkt_write(pkt, data, len), 0, "Cannot write query");
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	zassert_equal(net_recv_data(iface, pkt), 0, "Cannot receive query");
+
+	return k_sem_take(&response_sem, WAIT_TIME) == 0;
+}
+
+/* Offset of the nth record of the response, which has no question and
+ * no compressed names.
+ */
+static u16_t record_offset(int n)
+{
+	u16_t pos = DNS_HEADER_LEN;
+
+	while (true) {
+		while (pos < response_len && response[pos]) {
+			pos += response[pos] + 1;
+		}
+
+		if (n-- == 0) {
+			break;
+		}
+
+		pos += 1 + 8;
+		pos += 2 + sys_get_be16(&response[pos]);
+	}
+
+	zassert_true(pos < response_len, "Truncated response");
+
+	return pos;
+}
+
+static void check_counts(u16_t answers, u16_t additional)
+{
+	zassert_true(response_len >= DNS_HEADER_LEN, "Response too short");
+	zassert_equal(sys_get_be16(&response[2]), 0x8400, "Wrong flags");
+	zassert_equal(sys_get_be16(&response[4]), 0, "Questions echoed");
+	zassert_equal(sys_get_be16(&response[6]), answers,
+		      "Wrong answer count");
+	zassert_equal(sys_get_be16(&response[10]), additional,
+		      "Wrong additional record count");
+}
+
+static void check_record(int n, u16_t type, const void *rdata,
+			 u16_t rdata_len)
+{
+	u16_t pos = record_offset(n) + 1;
+
+	zassert_equal(sys_get_be16(&response[pos]), type, "Wrong type");
+
+	if (rdata) {
+		zassert_equal(sys_get_be16(&response[pos + 8]), rdata_len,
+			      "Wrong data length");
+		zassert_mem_equal(&response[pos + 10], rdata, rdata_len,
+				  "Wrong data");
+	}
+}
+
+static void test_setup(void)
+{
+	struct net_if_addr *ifaddr;
+
+	k_sem_init(&response_sem, 0, 1);
+
+	iface = net_if_get_default();
+	zassert_not_null(iface, "No interface");
+
+	ifaddr = net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+}
+
+static void test_query_host(void)
+{
+	const u8_t class_flush[] = { 0x80, 0x01 };
+	u16_t pos;
+
+	zassert_true(query(query_host, sizeof(query_host)), "No response");
+
+	check_counts(1, 0);
+	check_record(0, DNS_RR_A, &my_addr, sizeof(my_addr));
+
+	pos = DNS_HEADER_LEN;
+	zassert_mem_equal(&response[pos], host_name, sizeof(host_name),
+			  "Wrong name");
+	zassert_mem_equal(&response[pos + sizeof(host_name) + 2],
+			  class_flush, sizeof(class_flush), "Wrong class");
+}
+
+static void test_query_rate_limit(void)
+{
+	/** TESTPOINT: a record is multicast at most once per second */
+	zassert_false(query(query_host, sizeof(query_host)),
+		      "Response sent again");
+
+	k_sleep(RATE_LIMIT);
+	zassert_true(query(query_host, sizeof(query_host)), "No response");
+}
+
+static void test_query_unknown(void)
+{
+	zassert_false(query(query_other_host, sizeof(query_other_host)),
+		      "Response to another host");
+}
+
+static void test_service_add(void)
+{
+	struct mdns_service invalid = service;
+
+	invalid.instance = "";
+	zassert_equal(mdns_responder_service_add(&invalid), -EINVAL, NULL);
+
+	zassert_equal(mdns_responder_service_add(&service), 0, NULL);
+	zassert_equal(mdns_responder_service_add(&service), -EALREADY, NULL);
+}
+
+static void test_known_answer(void)
+{
+	/** TESTPOINT: known answers are not sent again */
+	zassert_false(query(query_service_known,
+			    sizeof(query_service_known)),
+		      "Known answer sent");
+}
+
+static void test_query_service(void)
+{
+	/* send the host record again as additional record */
+	k_sleep(RATE_LIMIT);
+
+	zassert_true(query(query_service, sizeof(query_service)),
+		     "No response");
+
+	/** TESTPOINT: the host, SRV and TXT records come along */
+	check_counts(1, 3);
+	check_record(0, DNS_RR_PTR, instance_name, sizeof(instance_name));
+	check_record(1, DNS_RR_A, &my_addr, sizeof(my_addr));
+	check_record(2, DNS_RR_SRV, NULL, 0);
+	check_record(3, DNS_RR_TXT, service.txt, service.txt_len);
+}
+
+static void test_query_service_types(void)
+{
+	zassert_true(query(query_service_types, sizeof(query_service_types)),
+		     "No response");
+
+	check_counts(1, 0);
+	check_record(0, DNS_RR_PTR, service_name, sizeof(service_name));
+}
+
+static void test_service_remove(void)
+{
+	zassert_equal(mdns_responder_service_remove(&service), 0, NULL);
+	zassert_equal(mdns_responder_service_remove(&service), -ENOENT, NULL);
+
+	k_sleep(RATE_LIMIT);
+	zassert_false(query(query_service, sizeof(query_service)),
+		      "Removed service answered");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(mdns_responder,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_query_host),
+			 ztest_unit_test(test_query_rate_limit),
+			 ztest_unit_test(test_query_unknown),
+			 ztest_unit_test(test_service_add),
+			 ztest_unit_test(test_known_answer),
+			 ztest_unit_test(test_query_service),
+			 ztest_unit_test(test_query_service_types),
+			 ztest_unit_test(test_service_remove));
+	ztest_run_test_suite(mdns_responder);
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, LOG_LEVEL_WRN);
+
+#include <ztest.h>
+#include <net/socket.h>
+#include <net/mqtt.h>
+#include <sys/byteorder.h>
+
+#include <string.h>
+#include <errno.h>
+
+#define BROKER_ADDR "192.0.2.1"
+#define BROKER_PORT 1883
+
+#define TOPIC "sensors"
+#define PAYLOAD "data"
+
+/* Fixed header, topic length and name, message id and payload */
+#define PUBLISH_LEN (2 + 2 + sizeof(TOPIC) - 1 + 2 + sizeof(PAYLOAD) - 1)
+#define PUBREL_LEN 4
+
+#define BUFFER_SIZE 64
+#define INFLIGHT_SIZE 48
+
+#define WAIT_TIMEOUT 1000
+
+static u8_t rx_buffer[BUFFER_SIZE];
+static u8_t tx_buffer[BUFFER_SIZE];
+static u8_t inflight_buffer[INFLIGHT_SIZE];
+static u8_t peer_buffer[BUFFER_SIZE];
+static u8_t large_payload[INFLIGHT_SIZE];
+static struct mqtt_client client_ctx;
+static struct sockaddr broker;
+static int listen_sock = -1;
+static int peer_sock = -1;
+static bool connected;
+static enum mqtt_evt_type last_evt;
+
+static void mqtt_evt_handler(struct mqtt_client *const client,
+			     const struct mqtt_evt *evt)
+{
+	last_evt = evt->type;
+
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		connected = (evt->result == 0);
+		break;
+
+	case MQTT_EVT_DISCONNECT:
+		connected = false;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/* Reads one packet sent by the client, returns its length. */
+static int peer_recv_packet(void)
+{
+	int len = 0;
+	int total = 2;
+	int ret;
+
+	while (len < total) {
+		ret = recv(peer_sock, peer_buffer + len, total - len, 0);
+		zassert_true(ret > 0, "recv failed");
+
+		if (len < 2 && len + ret >= 2) {
+			/* All the packets of the test are shorter than 128
+			 * bytes, their remaining length fits in one byte.
+			 */
+			zassert_true(peer_buffer[1] < 0x80, "packet too long");
+			total += peer_buffer[1];
+		}
+
+		len += ret;
+	}
+
+	return len;
+}
+
+static void peer_send(const u8_t *data, size_t len)
+{
+	zassert_equal(send(peer_sock, data, len, 0), len, "send failed");
+}
+
+/* Processes the packet the peer sent, once it reached the client. */
+static void client_input(void)
+{
+	struct pollfd fds = {
+		.fd = client_ctx.transport.tcp.sock,
+		.events = POLLIN,
+	};
+
+	zassert_equal(poll(&fds, 1, WAIT_TIMEOUT), 1, "no input");
+	zassert_equal(mqtt_input(&client_ctx), 0, "input failed");
+}
+
+static void broker_connect(bool session_present)
+{
+	const u8_t connack[] = { 0x20, 0x02, session_present, 0x00 };
+
+	zassert_equal(mqtt_connect(&client_ctx), 0, "connect failed");
+
+	peer_sock = accept(listen_sock, NULL, NULL);
+	zassert_true(peer_sock >= 0, "accept failed");
+
+	peer_recv_packet();
+	zassert_equal(peer_buffer[0], 0x10, "CONNECT expected");
+
+	peer_send(connack, sizeof(connack));
+	client_input();
+	zassert_true(connected, "not connected");
+}
+
+static void broker_disconnect(void)
+{
+	zassert_equal(mqtt_abort(&client_ctx), 0, "abort failed");
+	zassert_false(connected, "still connected");
+
+	zassert_equal(close(peer_sock), 0, "close failed");
+	peer_sock = -1;
+}
+
+static int publish(u16_t message_id, u8_t qos, const u8_t *payload,
+		   u32_t len)
+{
+	struct mqtt_publish_param param;
+
+	(void)memset(&param, 0, sizeof(param));
+	param.message.topic.qos = qos;
+	param.message.topic.topic.utf8 = (u8_t *)TOPIC;
+	param.message.topic.topic.size = strlen(TOPIC);
+	param.message.payload.data = (u8_t *)payload;
+	param.message.payload.len = len;
+	param.message_id = message_id;
+
+	return mqtt_publish(&client_ctx, &param);
+}
+
+static int publish_short(u16_t message_id, u8_t qos)
+{
+	return publish(message_id, qos, (const u8_t *)PAYLOAD,
+		       strlen(PAYLOAD));
+}
+
+static void check_publish(u8_t type_and_flags, u16_t message_id)
+{
+	zassert_equal(peer_recv_packet(), PUBLISH_LEN, "bad PUBLISH length");
+	zassert_equal(peer_buffer[0], type_and_flags, "bad PUBLISH flags");
+	zassert_equal(sys_get_be16(&peer_buffer[4 + strlen(TOPIC)]),
+		      message_id, "bad PUBLISH id");
+}
+
+static void check_pubrel(u16_t message_id)
+{
+	zassert_equal(peer_recv_packet(), PUBREL_LEN, "bad PUBREL length");
+	zassert_equal(peer_buffer[0], 0x62, "PUBREL expected");
+	zassert_equal(sys_get_be16(&peer_buffer[2]), message_id,
+		      "bad PUBREL id");
+}
+
+static void peer_ack(u8_t type, u16_t message_id)
+{
+	u8_t ack[] = { type, 0x02, message_id >> 8, message_id & 0xFF };
+
+	peer_send(ack, sizeof(ack));
+	client_input();
+}
+
+static void test_inflight_setup(void)
+{
+	struct sockaddr_in *broker4 = net_sin(&broker);
+
+	broker4->sin_family = AF_INET;
+	broker4->sin_port = htons(BROKER_PORT);
+	inet_pton(AF_INET, BROKER_ADDR, &broker4->sin_addr);
+
+	listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listen_sock >= 0, "socket failed");
+	zassert_equal(bind(listen_sock, &broker, sizeof(*broker4)), 0,
+		      "bind failed");
+	zassert_equal(listen(listen_sock, 1), 0, "listen failed");
+
+	mqtt_client_init(&client_ctx);
+
+	client_ctx.broker = &broker;
+	client_ctx.evt_cb = mqtt_evt_handler;
+	client_ctx.client_id.utf8 = (u8_t *)"zephyr";
+	client_ctx.client_id.size = strlen("zephyr");
+	client_ctx.clean_session = 0U;
+	client_ctx.transport.type = MQTT_TRANSPORT_NON_SECURE;
+
+	client_ctx.rx_buf = rx_buffer;
+	client_ctx.rx_buf_size = sizeof(rx_buffer);
+	client_ctx.tx_buf = tx_buffer;
+	client_ctx.tx_buf_size = sizeof(tx_buffer);
+	client_ctx.inflight_buf = inflight_buffer;
+	client_ctx.inflight_buf_size = sizeof(inflight_buffer);
+
+	broker_connect(false);
+}
+
+static void test_inflight_window(void)
+{
+	/** TESTPOINT: publishes do not wait for the previous ack */
+	zassert_equal(publish_short(1, MQTT_QOS_1_AT_LEAST_ONCE), 0, NULL);
+	zassert_equal(publish_short(1, MQTT_QOS_1_AT_LEAST_ONCE), -EALREADY,
+		      NULL);
+	zassert_equal(publish_short(2, MQTT_QOS_2_EXACTLY_ONCE), 0, NULL);
+
+	/** TESTPOINT: the window is full */
+	zassert_equal(publish_short(3, MQTT_QOS_1_AT_LEAST_ONCE), -EAGAIN,
+		      NULL);
+	zassert_equal(client_ctx.internal.inflight_count, 2, NULL);
+
+	/** TESTPOINT: QoS 0 publishes are not tracked */
+	zassert_equal(publish_short(0, MQTT_QOS_0_AT_MOST_ONCE), 0, NULL);
+	zassert_equal(client_ctx.internal.inflight_count, 2, NULL);
+
+	check_publish(0x32, 1);
+	check_publish(0x34, 2);
+	zassert_equal(peer_recv_packet(), PUBLISH_LEN - 2, NULL);
+	zassert_equal(peer_buffer[0], 0x30, NULL);
+
+	/** TESTPOINT: an ack frees its slot in the window */
+	peer_ack(0x40, 1);
+	zassert_equal(last_evt, MQTT_EVT_PUBACK, NULL);
+	zassert_equal(client_ctx.internal.inflight_count, 1, NULL);
+	zassert_equal(client_ctx.internal.inflight_buf_used, PUBLISH_LEN,
+		      NULL);
+
+	/** TESTPOINT: the message must fit in the in-flight buffer */
+	zassert_equal(publish(3, MQTT_QOS_1_AT_LEAST_ONCE, large_payload,
+			      sizeof(large_payload)), -ENOMEM, NULL);
+	zassert_equal(client_ctx.internal.inflight_count, 1, NULL);
+}
+
+static void test_inflight_resend(void)
+{
+	const struct mqtt_pubrel_param rel_param = {
+		.message_id = 2
+	};
+
+	/** TESTPOINT: a released message keeps its PUBREL */
+	peer_ack(0x50, 2);
+	zassert_equal(last_evt, MQTT_EVT_PUBREC, NULL);
+	zassert_equal(mqtt_publish_qos2_release(&client_ctx, &rel_param), 0,
+		      NULL);
+	check_pubrel(2);
+	zassert_equal(client_ctx.internal.inflight_buf_used, PUBREL_LEN,
+		      NULL);
+
+	zassert_equal(publish_short(3, MQTT_QOS_1_AT_LEAST_ONCE), 0, NULL);
+	check_publish(0x32, 3);
+
+	/** TESTPOINT: in-flight packets go out again, publishes as DUP */
+	broker_disconnect();
+	broker_connect(true);
+
+	check_pubrel(2);
+	check_publish(0x3A, 3);
+	zassert_equal(client_ctx.internal.inflight_count, 2, NULL);
+
+	peer_ack(0x70, 2);
+	zassert_equal(last_evt, MQTT_EVT_PUBCOMP, NULL);
+	peer_ack(0x40, 3);
+	zassert_equal(client_ctx.internal.inflight_count, 0, NULL);
+	zassert_equal(client_ctx.internal.inflight_buf_used, 0, NULL);
+}
+
+static void test_inflight_clear(void)
+{
+	zassert_equal(publish_short(4, MQTT_QOS_1_AT_LEAST_ONCE), 0, NULL);
+	check_publish(0x32, 4);
+
+	/** TESTPOINT: in-flight packets are dropped with the session */
+	broker_disconnect();
+	broker_connect(false);
+
+	zassert_equal(client_ctx.internal.inflight_count, 0, NULL);
+	zassert_equal(publish_short(4, MQTT_QOS_1_AT_LEAST_ONCE), 0, NULL);
+	check_publish(0x32, 4);
+
+	broker_disconnect();
+	zassert_equal(close(listen_sock), 0, "close failed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(mqtt_inflight,
+			 ztest_unit_test(test_inflight_setup),
+			 ztest_unit_test(test_inflight_window),
+			 ztest_unit_test(test_inflight_resend),
+			 ztest_unit_test(test_inflight_clear));
+	ztest_run_test_suite(mqtt_inflight);
+}
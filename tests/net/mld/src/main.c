@@ -54,6 +54,8 @@ static bool is_leave_msg_ok;
 static bool is_query_received;
 static bool is_report_sent;
 static bool ignore_already;
+static int report_count;
+static int record_count;
 K_SEM_DEFINE(wait_data, 0, UINT_MAX);
 
 #define WAIT_TIME 500
@@ -121,6 +123,10 @@ static int tester_send(struct device *dev, struct net_pkt *pkt)
 		/* FIXME, add more checks here */
 
 		NET_DBG("Received something....");
+		report_count++;
+		/* Number of records after the reserved field */
+		record_count = ntohs(UNALIGNED_GET((u16_t *)
+						   ((u8_t *)icmp + 6)));
 		is_join_msg_ok = true;
 		is_leave_msg_ok = true;
 		is_report_sent = true;
@@ -449,6 +455,37 @@ static void verify_send_report(void)
 	}
 }
 
+static void verify_join_aggregated(void)
+{
+	struct in6_addr addr[2];
+	int i;
+
+	report_count = 0;
+	record_count = 0;
+
+	for (i = 0; i < ARRAY_SIZE(addr); i++) {
+		net_ipv6_addr_create(&addr[i], 0xff10, 0, 0, 0, 0, 0, 0,
+				     0x0010 + i);
+		zassert_equal(net_ipv6_mld_join(iface, &addr[i]), 0,
+			      "Cannot join IPv6 multicast group");
+	}
+
+	k_sleep(WAIT_TIME);
+
+	/**TESTPOINT: both joins are reported in one message */
+	zassert_equal(report_count, 1, "%d reports sent", report_count);
+	zassert_equal(record_count, ARRAY_SIZE(addr), "%d records sent",
+		      record_count);
+
+	for (i = 0; i < ARRAY_SIZE(addr); i++) {
+		zassert_equal(net_ipv6_mld_leave(iface, &addr[i]), 0,
+			      "Cannot leave IPv6 multicast group");
+	}
+
+	k_sleep(WAIT_TIME);
+	k_sem_reset(&wait_data);
+}
+
 /* This value should be longer that the one in net_if.c when DAD timeouts */
 #define DAD_TIMEOUT (MSEC_PER_SEC / 5U)
 
@@ -495,6 +532,7 @@ void test_main(void)
 			 ztest_unit_test(verify_leave_group),
 			 ztest_unit_test(catch_query),
 			 ztest_unit_test(verify_send_report),
+			 ztest_unit_test(verify_join_aggregated),
 			 ztest_unit_test(test_allnodes),
 			 ztest_unit_test(test_solicit_node)
 			 );
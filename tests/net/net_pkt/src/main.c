@@ -629,6 +629,78 @@ void test_net_pkt_copy(void)
 		     "Pkt not properly unreferenced");
 }
 
+void test_net_pkt_watermarks(void)
+{
+	struct net_pkt *pkts[CONFIG_NET_PKT_RX_COUNT];
+	int i, count;
+
+	if (!IS_ENABLED(CONFIG_NET_PKT_WATERMARKS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	zassert_false(net_pkt_rx_pool_is_low(), "RX pool low at start");
+
+	for (count = 0; count < ARRAY_SIZE(pkts); count++) {
+		pkts[count] = net_pkt_rx_alloc(K_NO_WAIT);
+		if (!pkts[count]) {
+			break;
+		}
+	}
+
+	/* An exhausted pool is below any low watermark */
+	zassert_true(net_pkt_rx_pool_is_low(), "RX pool not low");
+	zassert_false(net_pkt_tx_pool_is_low(), "TX pool low");
+
+	for (i = 0; i < count; i++) {
+		net_pkt_unref(pkts[i]);
+	}
+
+	zassert_false(net_pkt_rx_pool_is_low(), "RX pool still low");
+}
+
+void test_net_pkt_headroom(void)
+{
+	struct net_pkt *pkt;
+
+	if (!IS_ENABLED(CONFIG_NET_L2_ETHERNET_RESERVE_HEADER)) {
+		ztest_test_skip();
+		return;
+	}
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, 100, AF_INET,
+					IPPROTO_UDP, K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+
+	/* Headroom does not count as packet space */
+	zassert_equal(net_buf_headroom(pkt->buffer), L2_HDR_SIZE,
+		      "No headroom reserved");
+	zassert_true(pkt_is_of_size(pkt, 100 + NET_IPV4UDPH_LEN),
+		     "Pkt size is not right");
+
+	zassert_equal(net_pkt_memset(pkt, 0xaa, 100 + NET_IPV4UDPH_LEN), 0,
+		      "Pkt not written");
+
+	/* The L2 header fits in front of the written data */
+	net_buf_push(pkt->buffer, L2_HDR_SIZE);
+	zassert_equal(pkt->buffer->data[L2_HDR_SIZE], 0xaa,
+		      "Data moved by header push");
+	zassert_equal(net_pkt_get_len(pkt),
+		      100 + NET_IPV4UDPH_LEN + L2_HDR_SIZE,
+		      "Header not in the packet");
+
+	net_pkt_unref(pkt);
+
+	/* Received packets are written from the start of the buffer */
+	pkt = net_pkt_rx_alloc_with_buffer(eth_if, 100, AF_INET,
+					   IPPROTO_UDP, K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+	zassert_equal(net_buf_headroom(pkt->buffer), 0,
+		      "Headroom reserved on RX");
+
+	net_pkt_unref(pkt);
+}
+
 void test_main(void)
 {
 	eth_if = net_if_get_default();
@@ -639,7 +711,9 @@ void test_main(void)
 			 ztest_unit_test(test_net_pkt_basics_of_rw),
 			 ztest_unit_test(test_net_pkt_advanced_basics),
 			 ztest_unit_test(test_net_pkt_easier_rw_usage),
-			 ztest_unit_test(test_net_pkt_copy)
+			 ztest_unit_test(test_net_pkt_copy),
+			 ztest_unit_test(test_net_pkt_watermarks),
+			 ztest_unit_test(test_net_pkt_headroom)
 		);
 
 	ztest_run_test_suite(net_pkt_tests);
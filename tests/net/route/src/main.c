@@ -29,8 +29,10 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_ROUTE_LOG_LEVEL);
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
+#include "net_stats.h"
 #include "icmpv6.h"
 #include "ipv6.h"
+#include "udp_internal.h"
 #include "nbr.h"
 #include "route.h"
 
@@ -59,6 +61,10 @@ static struct in6_addr ll_addr = { { { 0xfe, 0x80, 0x43, 0xb8, 0, 0, 0, 0,
 				       0, 0, 0, 0xf2, 0xaa, 0x29, 0x02,
 				       0x04 } } };
 
+/* Host behind the peer interface, sending to dest_addr */
+static struct in6_addr remote_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0xc, 0xa, 0xf, 0xe } } };
+
 static struct in6_addr in6addr_mcast = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
 					     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
 
@@ -82,6 +88,7 @@ static bool data_failure;
 static bool feed_data; /* feed data back to IP stack */
 
 static int msg_sending;
+static u8_t sent_hop_limit;
 
 K_SEM_DEFINE(wait_data, 0, UINT_MAX);
 
@@ -156,6 +163,7 @@ static int tester_send(struct device *dev, struct net_pkt *pkt)
 		test_failed = true;
 	}
 
+	sent_hop_limit = NET_IPV6_HDR(pkt)->hop_limit;
 	msg_sending = 0;
 out:
 	k_sem_give(&wait_data);
@@ -468,6 +476,120 @@ static void route_del_many(void)
 	}
 }
 
+static void route_lookup_longest_prefix(void)
+{
+	struct in6_addr prefix64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr prefix32 = { { { 0x20, 0x01, 0x0d, 0xb8, 0xff, 0xff,
+					 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr in64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0x12, 0x34 } } };
+	struct in6_addr in32 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 1, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr outside = { { { 0x20, 0x01, 0x0d, 0xb9, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct net_route_entry *host, *route64, *route32;
+
+	/* Longest first, adding a route updates any route covering it */
+	host = net_route_add(my_iface, &dest_addr, 128, &peer_addr);
+	zassert_not_null(host, "Route add failed");
+	route64 = net_route_add(my_iface, &prefix64, 64, &peer_addr);
+	zassert_not_null(route64, "Route add failed");
+	route32 = net_route_add(my_iface, &prefix32, 32, &peer_addr);
+	zassert_not_null(route32, "Route add failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), host,
+			  "Host route not found");
+	zassert_equal_ptr(net_route_lookup(NULL, &dest_addr), host,
+			  "Host route not found on any interface");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in64), route64,
+			  "/64 route not found");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in32), route32,
+			  "/32 route not found");
+	zassert_is_null(net_route_lookup(my_iface, &outside),
+			"Route found outside of all prefixes");
+	zassert_is_null(net_route_lookup(peer_iface, &dest_addr),
+			"Route found on wrong interface");
+
+	/** TESTPOINT: the next shorter prefix takes over after removal */
+	zassert_false(net_route_del(route64), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in64), route32,
+			  "/32 route not found after /64 removal");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), host,
+			  "Host route not found after /64 removal");
+
+	zassert_false(net_route_del(host), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route32,
+			  "/32 route not found after host route removal");
+
+	zassert_false(net_route_del(route32), "Route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Route found after removing all");
+}
+
+#if defined(CONFIG_NET_ROUTING_FLOW_CACHE) && defined(CONFIG_NET_STATISTICS_IPV6)
+/* Inject a packet from remote_addr to dest_addr at the peer interface */
+static bool forward_pkt(void)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(peer_iface, sizeof(struct net_udp_hdr),
+					AF_INET6, IPPROTO_UDP, K_SECONDS(1));
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	ret = net_ipv6_create(pkt, &remote_addr, &dest_addr);
+	zassert_equal(ret, 0, "Cannot create IPv6 header");
+
+	ret = net_udp_create(pkt, htons(4242), htons(4242));
+	zassert_equal(ret, 0, "Cannot create UDP header");
+
+	net_pkt_cursor_init(pkt);
+	net_ipv6_finalize(pkt, IPPROTO_UDP);
+	net_pkt_cursor_init(pkt);
+
+	sent_hop_limit = 0U;
+
+	ret = net_recv_data(peer_iface, pkt);
+	zassert_equal(ret, 0, "Cannot receive pkt");
+
+	return k_sem_take(&wait_data, WAIT_TIME) == 0;
+}
+#endif
+
+static void route_forward_flow(void)
+{
+#if defined(CONFIG_NET_ROUTING_FLOW_CACHE) && defined(CONFIG_NET_STATISTICS_IPV6)
+	u8_t hop_limit = net_if_ipv6_get_hop_limit(peer_iface) - 1;
+	u32_t recv = GET_STAT(peer_iface, ipv6.recv);
+
+	entry = net_route_add(my_iface, &dest_addr, 128, &peer_addr);
+	zassert_not_null(entry, "Route add failed");
+
+	feed_data = false;
+
+	/* The first packet goes through the IPv6 input processing */
+	zassert_true(forward_pkt(), "First pkt not forwarded");
+	zassert_equal(sent_hop_limit, hop_limit, "Hop limit not decremented");
+	zassert_equal(GET_STAT(peer_iface, ipv6.recv), recv + 1,
+		      "First pkt did not go through IPv6 input");
+
+	/** TESTPOINT: the next ones take the fast path */
+	zassert_true(forward_pkt(), "Second pkt not forwarded");
+	zassert_equal(sent_hop_limit, hop_limit, "Hop limit not decremented");
+	zassert_equal(GET_STAT(peer_iface, ipv6.recv), recv + 1,
+		      "Second pkt went through IPv6 input");
+
+	/** TESTPOINT: the flow is forgotten with the route */
+	zassert_false(net_route_del(entry), "Route del failed");
+	zassert_false(forward_pkt(), "Pkt forwarded without a route");
+	zassert_equal(GET_STAT(peer_iface, ipv6.recv), recv + 2,
+		      "Pkt without route did not go through IPv6 input");
+#else
+	ztest_test_skip();
+#endif
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -487,6 +609,8 @@ void test_main(void)
 			ztest_unit_test(route_del_nexthop_again),
 			ztest_unit_test(populate_nbr_cache),
 			ztest_unit_test(route_add_many),
-			ztest_unit_test(route_del_many));
+			ztest_unit_test(route_del_many),
+			ztest_unit_test(route_lookup_longest_prefix),
+			ztest_unit_test(route_forward_flow));
 	ztest_run_test_suite(test_route);
 }
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <ztest_assert.h>
 
 #include <net/socket.h>
+#include <net/net_context.h>
 #include <net/ethernet.h>
 
 #include "ipv6.h"
@@ -906,10 +907,308 @@ void test_v6_sendmsg_with_txtime(void)
 	test_started = false;
 }
 
+static int zerocopy_done;
+static size_t zerocopy_len;
+
+static void zerocopy_cb(const void *data, size_t len, void *user_data)
+{
+	zassert_equal_ptr(user_data, &zerocopy_done, "wrong user data");
+
+	zerocopy_done++;
+	zerocopy_len += len;
+}
+
+void test_v4_sendmsg_zerocopy(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	struct msghdr msg;
+	struct iovec io_vector[2];
+	struct net_context_zerocopy zc = {
+		.cb = zerocopy_cb,
+		.user_data = &zerocopy_done,
+	};
+	static char tx_buf[] = TEST_STR_SMALL;
+	static char rx_buf[400];
+	ssize_t sent, recved;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = setsockopt(client_sock, SOL_SOCKET, SO_ZEROCOPY, &zc, sizeof(zc));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	io_vector[0].iov_base = tx_buf;
+	io_vector[0].iov_len = 2;
+	io_vector[1].iov_base = tx_buf + 2;
+	io_vector[1].iov_len = STRLEN(TEST_STR_SMALL) - 2;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 2;
+	msg.msg_name = &server_addr;
+	msg.msg_namelen = sizeof(server_addr);
+
+	zerocopy_done = 0;
+	zerocopy_len = 0;
+
+	sent = sendmsg(client_sock, &msg, MSG_ZEROCOPY);
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendmsg failed (%d)",
+		      -errno);
+
+	addrlen = sizeof(addr);
+	clear_buf(rx_buf);
+	recved = recvfrom(server_sock, rx_buf, sizeof(rx_buf), 0,
+			  &addr, &addrlen);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "recvfrom fail");
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR_SMALL), "wrong data");
+
+	/** TESTPOINT: both iovecs have been released after reception */
+	zassert_equal(zerocopy_done, 2, "completion not reported");
+	zassert_equal(zerocopy_len, STRLEN(TEST_STR_SMALL), "wrong length");
+
+	/** TESTPOINT: without the flag the data is copied */
+	sent = sendmsg(client_sock, &msg, 0);
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendmsg failed (%d)",
+		      -errno);
+	zassert_equal(zerocopy_done, 2, "copied send reported");
+
+	addrlen = sizeof(addr);
+	recved = recvfrom(server_sock, rx_buf, sizeof(rx_buf), 0,
+			  &addr, &addrlen);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "recvfrom fail");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_recvmsg_recvmmsg(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr[3];
+	static char rx_buf[3][8];
+	struct iovec io_vector[3][2];
+	struct mmsghdr msgvec[3];
+	struct in_pktinfo *info;
+	struct cmsghdr *cmsg;
+	union {
+		struct cmsghdr hdr;
+		unsigned char  buf[CMSG_SPACE(sizeof(struct in_pktinfo)) +
+				   CMSG_SPACE(32)];
+	} cmsgbuf;
+	ssize_t recved;
+	int i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(client_sock,
+		  (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	memset(msgvec, 0, sizeof(msgvec));
+	for (i = 0; i < 3; i++) {
+		/* Split every datagram over two buffers */
+		io_vector[i][0].iov_base = rx_buf[i];
+		io_vector[i][0].iov_len = 2;
+		io_vector[i][1].iov_base = rx_buf[i] + 2;
+		io_vector[i][1].iov_len = sizeof(rx_buf[i]) - 2;
+
+		msgvec[i].msg_hdr.msg_iov = io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 2;
+		msgvec[i].msg_hdr.msg_name = &addr[i];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+
+		rv = sendto(client_sock, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL),
+			    0, (struct sockaddr *)&server_addr,
+			    sizeof(server_addr));
+		zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+	}
+
+	/** TESTPOINT: recvmsg() with the source address and pktinfo */
+	msgvec[0].msg_hdr.msg_control = &cmsgbuf.buf;
+	msgvec[0].msg_hdr.msg_controllen = sizeof(cmsgbuf.buf);
+	clear_buf(rx_buf[0]);
+
+	recved = recvmsg(server_sock, &msgvec[0].msg_hdr, 0);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "recvmsg failed (%d)",
+		      -errno);
+	zassert_mem_equal(rx_buf[0], BUF_AND_SIZE(TEST_STR_SMALL),
+			  "wrong data");
+	zassert_equal(msgvec[0].msg_hdr.msg_namelen, sizeof(addr[0]),
+		      "unexpected addrlen");
+	zassert_equal(addr[0].sin_port, client_addr.sin_port,
+		      "unexpected client port");
+	zassert_false(msgvec[0].msg_hdr.msg_flags & MSG_TRUNC,
+		      "unexpected truncation");
+
+	cmsg = CMSG_FIRSTHDR(&msgvec[0].msg_hdr);
+	zassert_not_null(cmsg, "no ancillary data");
+	zassert_equal(cmsg->cmsg_level, IPPROTO_IP, "wrong cmsg level");
+	zassert_equal(cmsg->cmsg_type, IP_PKTINFO, "wrong cmsg type");
+	info = (struct in_pktinfo *)CMSG_DATA(cmsg);
+	zassert_true(net_ipv4_addr_cmp(&info->ipi_addr,
+				       &server_addr.sin_addr),
+		     "wrong destination address");
+	zassert_true(info->ipi_ifindex > 0, "no interface index");
+
+	/** TESTPOINT: recvmmsg() returns the two remaining datagrams */
+	msgvec[0].msg_hdr.msg_control = NULL;
+	for (i = 0; i < 3; i++) {
+		clear_buf(rx_buf[i]);
+	}
+
+	rv = recvmmsg(server_sock, msgvec, 3, 0);
+	zassert_equal(rv, 2, "recvmmsg failed (%d)", rv < 0 ? -errno : rv);
+
+	for (i = 0; i < 2; i++) {
+		zassert_equal(msgvec[i].msg_len, STRLEN(TEST_STR_SMALL),
+			      "unexpected received bytes");
+		zassert_mem_equal(rx_buf[i], BUF_AND_SIZE(TEST_STR_SMALL),
+				  "wrong data");
+		zassert_equal(addr[i].sin_port, client_addr.sin_port,
+			      "unexpected client port");
+	}
+
+	/** TESTPOINT: an empty queue does not block with MSG_DONTWAIT */
+	rv = recvmmsg(server_sock, msgvec, 3, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZSOCK_BUF_POOL_DEFINE(test_bufs);
+
+void test_v4_sendto_recvfrom_buf(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	u8_t *tx_buf;
+	u8_t *rx_buf;
+	void *bufs[ZSOCK_BUF_COUNT];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	ssize_t ret;
+	int i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	tx_buf = zsock_buf_alloc(K_NO_WAIT);
+	zassert_not_null(tx_buf, "buf alloc failed");
+	rx_buf = zsock_buf_alloc(K_NO_WAIT);
+	zassert_not_null(rx_buf, "buf alloc failed");
+	zassert_not_equal(tx_buf, rx_buf, "same buf allocated twice");
+
+	memcpy(tx_buf, BUF_AND_SIZE(TEST_STR2));
+
+	ret = zsock_sendto_buf(client_sock, tx_buf, STRLEN(TEST_STR2), 0,
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr));
+	zassert_equal(ret, STRLEN(TEST_STR2), "sendto_buf failed");
+
+	addrlen = sizeof(addr);
+	ret = zsock_recvfrom_buf(server_sock, rx_buf, 0, &addr, &addrlen);
+	zassert_equal(ret, STRLEN(TEST_STR2), "unexpected received bytes");
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2),
+			  "wrong data");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in),
+		      "unexpected addrlen");
+
+	/**TESTPOINT: only allocated buffers can be used */
+	ret = zsock_sendto_buf(client_sock, tx_buf + 1, 1, 0,
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr));
+	zassert_equal(ret, -1, "sendto_buf with a bad buf should fail");
+	zassert_equal(errno, EBADF, "unexpected errno (%d)", errno);
+
+	ret = zsock_sendto_buf(client_sock, TEST_STR2, 1, 0,
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr));
+	zassert_equal(ret, -1, "sendto_buf with user data should fail");
+	zassert_equal(errno, EBADF, "unexpected errno (%d)", errno);
+
+	ret = zsock_sendto_buf(client_sock, tx_buf, ZSOCK_BUF_SIZE + 1, 0,
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr));
+	zassert_equal(ret, -1, "sendto_buf past the buf should fail");
+	zassert_equal(errno, EINVAL, "unexpected errno (%d)", errno);
+
+	zassert_equal(zsock_buf_free(tx_buf), 0, "buf free failed");
+	zassert_equal(zsock_buf_free(rx_buf), 0, "buf free failed");
+	zassert_equal(zsock_buf_free(rx_buf), -1, "double free should fail");
+	zassert_equal(errno, EBADF, "unexpected errno (%d)", errno);
+
+	ret = zsock_recvfrom_buf(server_sock, rx_buf, ZSOCK_MSG_DONTWAIT,
+				 NULL, NULL);
+	zassert_equal(ret, -1, "recvfrom_buf with a freed buf should fail");
+	zassert_equal(errno, EBADF, "unexpected errno (%d)", errno);
+
+	/**TESTPOINT: allocation fails once all buffers are in use */
+	for (i = 0; i < ARRAY_SIZE(bufs); i++) {
+		bufs[i] = zsock_buf_alloc(K_NO_WAIT);
+		zassert_not_null(bufs[i], "buf alloc failed");
+	}
+
+	zassert_is_null(zsock_buf_alloc(K_NO_WAIT), "buf alloc should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	for (i = 0; i < ARRAY_SIZE(bufs); i++) {
+		zassert_equal(zsock_buf_free(bufs[i]), 0, "buf free failed");
+	}
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
 
+	/* Give the user mode tests their socket buffers */
+	zsock_buf_pool_attach(&test_bufs, &ztest_mem_domain);
+
 	ztest_test_suite(socket_udp,
 			 ztest_unit_test(test_send_recv_2_sock),
 			 ztest_unit_test(test_v4_sendto_recvfrom),
@@ -922,9 +1221,12 @@ void test_main(void)
 			 ztest_unit_test(test_v6_sendmsg_recvfrom),
 			 ztest_unit_test(test_v4_sendmsg_recvfrom_connected),
 			 ztest_unit_test(test_v6_sendmsg_recvfrom_connected),
+			 ztest_unit_test(test_v4_sendmsg_zerocopy),
+			 ztest_unit_test(test_v4_recvmsg_recvmmsg),
 			 ztest_unit_test(setup_eth),
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
-			 ztest_user_unit_test(test_v6_sendmsg_with_txtime)
+			 ztest_user_unit_test(test_v6_sendmsg_with_txtime),
+			 ztest_user_unit_test(test_v4_sendto_recvfrom_buf)
 		);
 
 	ztest_run_test_suite(socket_udp);
@@ -1719,6 +1719,89 @@ static bool test_init_tcp_connect(void)
 }
 #endif
 
+static int parse_opts(const u8_t *data, size_t len,
+		      struct net_tcp_options *opts)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(my_iface, len, AF_UNSPEC, 0,
+					K_NO_WAIT);
+	if (!pkt) {
+		return -ENOMEM;
+	}
+
+	if (net_pkt_write(pkt, data, len)) {
+		net_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	(void)memset(opts, 0, sizeof(*opts));
+	ret = net_tcp_parse_opts(pkt, len, opts);
+
+	net_pkt_unref(pkt);
+
+	return ret;
+}
+
+static bool test_parse_opts(void)
+{
+	static const u8_t syn_opts[] = {
+		/* MSS 1460, window scale 7, SACK permitted */
+		NET_TCP_MSS_OPT, 4, 0x05, 0xb4,
+		NET_TCP_NOP_OPT, NET_TCP_WINDOW_SCALE_OPT, 3, 7,
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_SACK_PERM_OPT, 2,
+		/* Timestamps 0x01020304 / 0x0a0b0c0d */
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_TIMESTAMP_OPT, 10,
+		0x01, 0x02, 0x03, 0x04, 0x0a, 0x0b, 0x0c, 0x0d,
+	};
+	static const u8_t ack_opts[] = {
+		/* Two SACK blocks: 1000-2000 and 3000-4000 */
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_SACK_OPT, 18,
+		0x00, 0x00, 0x03, 0xe8, 0x00, 0x00, 0x07, 0xd0,
+		0x00, 0x00, 0x0b, 0xb8, 0x00, 0x00, 0x0f, 0xa0,
+	};
+	static const u8_t bad_opts[] = {
+		/* Window scale with a wrong length */
+		NET_TCP_WINDOW_SCALE_OPT, 4, 7, 0,
+	};
+	struct net_tcp_options opts;
+
+	if (parse_opts(syn_opts, sizeof(syn_opts), &opts) < 0) {
+		TC_ERROR("Cannot parse SYN options\n");
+		return false;
+	}
+
+	if (opts.mss != 1460 || !opts.wscale_set || opts.wscale != 7 ||
+	    !opts.sack_perm || !opts.ts_set || opts.tsval != 0x01020304 ||
+	    opts.tsecr != 0x0a0b0c0d || opts.sack_count) {
+		TC_ERROR("Invalid SYN options parsed\n");
+		return false;
+	}
+
+	if (parse_opts(ack_opts, sizeof(ack_opts), &opts) < 0) {
+		TC_ERROR("Cannot parse SACK option\n");
+		return false;
+	}
+
+	if (opts.sack_count != 2 ||
+	    opts.sack[0].left != 1000 || opts.sack[0].right != 2000 ||
+	    opts.sack[1].left != 3000 || opts.sack[1].right != 4000 ||
+	    opts.wscale_set || opts.ts_set) {
+		TC_ERROR("Invalid SACK blocks parsed\n");
+		return false;
+	}
+
+	if (parse_opts(bad_opts, sizeof(bad_opts), &opts) != -EINVAL) {
+		TC_ERROR("Invalid window scale option accepted\n");
+		return false;
+	}
+
+	return true;
+}
+
 static bool test_init(void)
 {
 	struct net_if *iface = net_if_get_default();
@@ -1819,6 +1902,7 @@ static const struct {
 	{ "test TCP seq validity", test_tcp_seq_validity },
 	{ "test TCP reply context init", test_init_tcp_reply_context },
 	{ "test TCP accept init", test_init_tcp_accept },
+	{ "test TCP option parsing", test_parse_opts },
 #if 0
 	/* TBD: more tests are needed */
 	{ "test TCP connect init", test_init_tcp_connect },
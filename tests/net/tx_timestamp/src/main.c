@@ -173,8 +173,12 @@ static void timestamp_callback(struct net_pkt *pkt)
 			     pkt->timestamp.nanosecond, pkt->timestamp.second);
 	}
 
-	/* The pkt was ref'ed in send_some_data()() */
-	net_pkt_unref(pkt);
+	/* Packets timestamped by the driver are referenced by the TX
+	 * timestamp thread, the others were allocated by the test.
+	 */
+	if (!do_timestamp) {
+		net_pkt_unref(pkt);
+	}
 
 	if (do_timestamp) {
 		k_sem_give(&wait_data);
@@ -219,8 +223,12 @@ static void timestamp_callback_2(struct net_pkt *pkt)
 	zassert_equal(eth_interfaces[1], net_pkt_iface(pkt),
 		      "Invalid interface");
 
-	/* The pkt was ref'ed in send_some_data()() */
-	net_pkt_unref(pkt);
+	/* Packets timestamped by the driver are referenced by the TX
+	 * timestamp thread, the others were allocated by the test.
+	 */
+	if (!do_timestamp) {
+		net_pkt_unref(pkt);
+	}
 
 	if (do_timestamp) {
 		k_sem_give(&wait_data);
@@ -489,6 +497,70 @@ static void check_timestamp_after_enabling(void)
 	}
 }
 
+static void check_context_tx_timestamp(void)
+{
+	struct sockaddr_in6 dst_addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PORT),
+	};
+	struct sockaddr_in6 src_addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = 0,
+	};
+	int flags = NET_CONTEXT_TIMESTAMP_TX_HW;
+	struct net_ptp_time ts;
+	int ret, i;
+
+	ret = net_context_get(AF_INET6, SOCK_DGRAM, IPPROTO_UDP,
+			      &udp_v6_ctx);
+	zassert_equal(ret, 0, "Create IPv6 UDP context failed\n");
+
+	memcpy(&src_addr6.sin6_addr, &my_addr1, sizeof(struct in6_addr));
+	memcpy(&dst_addr6.sin6_addr, &dst_addr, sizeof(struct in6_addr));
+
+	ret = net_context_bind(udp_v6_ctx, (struct sockaddr *)&src_addr6,
+			       sizeof(struct sockaddr_in6));
+	zassert_equal(ret, 0, "Context bind failure test failed\n");
+
+	ret = net_context_set_option(udp_v6_ctx, NET_OPT_TIMESTAMP,
+				     &flags, sizeof(flags));
+	zassert_equal(ret, 0, "Cannot enable TX timestamps\n");
+
+	zassert_equal(net_context_get_tx_timestamp(udp_v6_ctx, &ts), -EAGAIN,
+		      "Timestamp before sending\n");
+
+	test_started = true;
+	do_timestamp = true;
+
+	ret = net_context_sendto(udp_v6_ctx, test_data, strlen(test_data),
+				 (struct sockaddr *)&dst_addr6,
+				 sizeof(struct sockaddr_in6),
+				 NULL, K_NO_WAIT, NULL);
+	zassert_true(ret > 0, "Send UDP pkt failed\n");
+
+	/* The timestamp is queued from the TX timestamp thread */
+	for (i = 0; i < 10; i++) {
+		ret = net_context_get_tx_timestamp(udp_v6_ctx, &ts);
+		if (ret != -EAGAIN) {
+			break;
+		}
+
+		k_sleep(K_MSEC(10));
+	}
+
+	zassert_equal(ret, 0, "No TX timestamp queued\n");
+	zassert_equal(ts.nanosecond, ts.second + 1,
+		      "Not the driver timestamp\n");
+
+	/** TESTPOINT: each timestamp is reported once */
+	zassert_equal(net_context_get_tx_timestamp(udp_v6_ctx, &ts), -EAGAIN,
+		      "Timestamp reported twice\n");
+
+	do_timestamp = false;
+
+	net_context_unref(udp_v6_ctx);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_tx_timestamp_test,
@@ -498,7 +570,8 @@ void test_main(void)
 			 ztest_unit_test(timestamp_setup_2nd_iface),
 			 ztest_unit_test(timestamp_setup_all),
 			 ztest_unit_test(check_timestamp_after_enabling),
-			 ztest_unit_test(timestamp_cleanup)
+			 ztest_unit_test(timestamp_cleanup),
+			 ztest_unit_test(check_context_tx_timestamp)
 			 );
 
 	ztest_run_test_suite(net_tx_timestamp_test);
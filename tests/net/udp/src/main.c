@@ -426,7 +426,7 @@ void test_udp(void)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface = net_if_get_default();
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *ud2;
 	int ret, i = 0;
 	bool st;
 
@@ -618,6 +618,15 @@ void test_udp(void)
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4242);
 	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1234, 4243);
 
+	/* A listener registered later on the same port does not take over
+	 * the packets of the connected handler, only the other ones.
+	 */
+	ud2 = REGISTER(AF_INET, &any_addr4, &any_addr4, 0, 4242);
+	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4242);
+	TEST_IPV4_OK(ud2, &in4addr_peer, &in4addr_my, 1235, 4242);
+	UNREGISTER(ud2);
+	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1235, 4242);
+
 	ud = REGISTER(AF_UNSPEC, NULL, NULL, 1234, 42423);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 42423);
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 42423);
@@ -135,3 +135,60 @@ void test_posix_realtime(void)
 
 	printk("POSIX clock set APIs test done\n");
 }
+
+void test_posix_adjtime(void)
+{
+	struct timespec nts, ts, last;
+	struct timeval delta, olddelta;
+	int ret;
+
+	printk("POSIX clock adjust APIs\n");
+
+	nts.tv_sec = 1514821501;
+	nts.tv_nsec = 0;
+	ret = clock_settime(CLOCK_REALTIME, &nts);
+	zassert_equal(ret, 0, "Fail to set realtime clock");
+
+	delta.tv_sec = 0;
+	delta.tv_usec = 100000;
+	ret = adjtime(&delta, &olddelta);
+	zassert_equal(ret, 0, "Fail to adjust realtime clock");
+	zassert_true(olddelta.tv_sec == 0 && olddelta.tv_usec == 0,
+		     "Correction pending after clock_settime");
+
+	usleep(USEC_PER_MSEC * 200U);
+
+	/* TESTPOINT: the correction is applied at 500 ppm, 100 us in
+	 * 200 ms
+	 */
+	ret = adjtime(NULL, &olddelta);
+	zassert_equal(ret, 0, NULL);
+	zassert_equal(olddelta.tv_sec, 0, NULL);
+	zassert_true(olddelta.tv_usec < 100000 && olddelta.tv_usec >= 99800,
+		     "Correction not applied gradually: %d us left",
+		     (int)olddelta.tv_usec);
+
+	/* TESTPOINT: the clock does not go backward while slowed down */
+	delta.tv_sec = -1;
+	delta.tv_usec = 0;
+	ret = adjtime(&delta, NULL);
+	zassert_equal(ret, 0, NULL);
+
+	clock_gettime(CLOCK_REALTIME, &last);
+	for (int i = 0; i < 10; i++) {
+		usleep(USEC_PER_MSEC * 10U);
+		clock_gettime(CLOCK_REALTIME, &ts);
+
+		zassert_true(ts.tv_sec > last.tv_sec ||
+			     (ts.tv_sec == last.tv_sec &&
+			      ts.tv_nsec >= last.tv_nsec),
+			     "Clock moved backward");
+		last = ts;
+	}
+
+	delta.tv_sec = 0;
+	delta.tv_usec = 0;
+	adjtime(&delta, NULL);
+
+	printk("POSIX clock adjust APIs test done\n");
+}
@@ -14,9 +14,12 @@ extern void test_posix_recursive_mutex(void);
 extern void test_posix_semaphore(void);
 extern void test_posix_rw_lock(void);
 extern void test_posix_realtime(void);
+extern void test_posix_adjtime(void);
 extern void test_posix_timer(void);
 extern void test_posix_pthread_execution(void);
 extern void test_posix_pthread_termination(void);
+extern void test_posix_pthread_stack_pool(void);
+extern void test_posix_pthread_workqueue(void);
 extern void test_posix_multiple_threads_single_key(void);
 extern void test_posix_single_thread_multiple_keys(void);
 
@@ -25,6 +28,8 @@ void test_main(void)
 	ztest_test_suite(posix_apis,
 			ztest_unit_test(test_posix_pthread_execution),
 			ztest_unit_test(test_posix_pthread_termination),
+			ztest_unit_test(test_posix_pthread_stack_pool),
+			ztest_unit_test(test_posix_pthread_workqueue),
 			ztest_unit_test(test_posix_multiple_threads_single_key),
 			ztest_unit_test(test_posix_single_thread_multiple_keys),
 			ztest_unit_test(test_posix_clock),
@@ -33,6 +38,7 @@ void test_main(void)
 			ztest_unit_test(test_posix_recursive_mutex),
 			ztest_unit_test(test_posix_mqueue),
 			ztest_unit_test(test_posix_realtime),
+			ztest_unit_test(test_posix_adjtime),
 			ztest_unit_test(test_posix_timer),
 			ztest_unit_test(test_posix_rw_lock)
 			);
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#define N_WORK 8
+
+#ifdef CONFIG_PTHREAD_STACK_POOL
+static sem_t pool_sem;
+
+static void *pool_thread(void *arg)
+{
+	sem_wait(&pool_sem);
+	pthread_exit(arg);
+	return NULL;
+}
+#endif
+
+void test_posix_pthread_stack_pool(void)
+{
+#ifdef CONFIG_PTHREAD_STACK_POOL
+	pthread_t threads[CONFIG_MAX_PTHREAD_COUNT];
+	pthread_attr_t attr;
+	pthread_t extra;
+	void *retval;
+	int ret;
+	int i;
+
+	sem_init(&pool_sem, 0, 0);
+
+	/* Let the detached threads of the previous tests exit */
+	k_sleep(100);
+
+	/* TESTPOINT: Threads run on pooled stacks, without attributes */
+	for (i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		ret = pthread_create(&threads[i], NULL, pool_thread,
+				     INT_TO_POINTER(i));
+		zassert_false(ret, "Thread %d not created", i);
+	}
+
+	/* TESTPOINT: All the slots are in use */
+	ret = pthread_create(&extra, NULL, pool_thread, NULL);
+	zassert_equal(ret, EAGAIN, "Thread created past the pool");
+
+	for (i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		sem_post(&pool_sem);
+	}
+
+	for (i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		ret = pthread_join(threads[i], &retval);
+		zassert_false(ret, "Thread %d not joined", i);
+		zassert_equal(POINTER_TO_INT(retval), i, "Wrong exit status");
+	}
+
+	/* TESTPOINT: Detached threads give their slots back on exit */
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	for (i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		ret = pthread_create(&threads[i], &attr, pool_thread, NULL);
+		zassert_false(ret, "Detached thread %d not created", i);
+		sem_post(&pool_sem);
+	}
+
+	k_sleep(100);
+
+	/* TESTPOINT: Joined and exited slots are all reused */
+	for (i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		ret = pthread_create(&threads[i], NULL, pool_thread, NULL);
+		zassert_false(ret, "Slot %d not reused", i);
+	}
+
+	for (i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		sem_post(&pool_sem);
+	}
+
+	for (i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		pthread_join(threads[i], &retval);
+	}
+
+	/* TESTPOINT: Larger stacks than the pooled ones must be provided */
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_PTHREAD_STACK_POOL_SIZE + 1);
+	ret = pthread_create(&extra, &attr, pool_thread, NULL);
+	zassert_equal(ret, EAGAIN, "Thread created with too large a stack");
+#else
+	ztest_test_skip();
+#endif
+}
+
+#ifdef CONFIG_PTHREAD_WORKQUEUE
+static struct pthread_work works[N_WORK];
+static K_SEM_DEFINE(work_start, 0, N_WORK);
+static K_SEM_DEFINE(work_done, 0, N_WORK);
+static atomic_t work_sum;
+
+static void *work_routine(void *arg)
+{
+	k_sem_give(&work_start);
+	/* Hold the worker so that the next items go to the other ones */
+	k_sleep(50);
+	atomic_add(&work_sum, POINTER_TO_INT(arg));
+	k_sem_give(&work_done);
+
+	return NULL;
+}
+#endif
+
+void test_posix_pthread_workqueue(void)
+{
+#ifdef CONFIG_PTHREAD_WORKQUEUE
+	int ret;
+	int i;
+
+	for (i = 0; i < N_WORK; i++) {
+		ret = pthread_work_submit(&works[i], work_routine,
+					  INT_TO_POINTER(i + 1));
+		zassert_false(ret, "Work %d not submitted", i);
+	}
+
+	/* TESTPOINT: A queued item cannot be submitted again */
+	if (N_WORK > CONFIG_PTHREAD_WORKQUEUE_THREADS) {
+		ret = pthread_work_submit(&works[N_WORK - 1], work_routine,
+					  NULL);
+		zassert_equal(ret, EBUSY, "Queued work submitted again");
+	}
+
+	/* TESTPOINT: Every worker is busy at once */
+	for (i = 0; i < CONFIG_PTHREAD_WORKQUEUE_THREADS; i++) {
+		ret = k_sem_take(&work_start, 40);
+		zassert_false(ret, "Worker %d did not start", i);
+	}
+
+	for (i = 0; i < N_WORK; i++) {
+		ret = k_sem_take(&work_done, K_SECONDS(1));
+		zassert_false(ret, "Work %d not done", i);
+	}
+
+	zassert_equal(atomic_get(&work_sum), N_WORK * (N_WORK + 1) / 2,
+		      "Work items lost or run twice");
+#else
+	ztest_test_skip();
+#endif
+}
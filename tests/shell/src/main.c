@@ -76,6 +76,16 @@ static void test_cmd_shell(void)
 	test_shell_execute_cmd("shell backspace_mode delete dummy dummy",
 				-EINVAL);
 
+	/* subcommand: batch */
+	test_shell_execute_cmd("shell batch -h", 1);
+	test_shell_execute_cmd("shell batch --help", 1);
+	test_shell_execute_cmd("shell batch dummy", 1);
+
+	test_shell_execute_cmd("shell batch on", 0);
+	test_shell_execute_cmd("shell batch on dummy", -EINVAL);
+	test_shell_execute_cmd("shell batch off", 0);
+	test_shell_execute_cmd("shell batch off dummy", -EINVAL);
+
 	/* subcommand: colors */
 	test_shell_execute_cmd("shell colors -h", 1);
 	test_shell_execute_cmd("shell colors --help", 1);
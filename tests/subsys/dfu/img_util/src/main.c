@@ -8,6 +8,12 @@
 #include <storage/flash_map.h>
 #include <dfu/flash_img.h>
 
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+#include <sys/byteorder.h>
+#include <tinycrypt/sha256.h>
+#include <tinycrypt/constants.h>
+#endif
+
 void test_collecting(void)
 {
 	const struct flash_area *fa;
@@ -51,9 +57,151 @@ void test_collecting(void)
 	}
 }
 
+#ifdef CONFIG_IMG_ENABLE_HASH_CHECK
+#define TEST_IMG_HDR_SIZE 32
+#define TEST_IMG_SIZE 1000
+#define TEST_IMG_TLV_SIZE (4 + 4 + TC_SHA256_DIGEST_SIZE)
+
+static u8_t test_img[TEST_IMG_HDR_SIZE + TEST_IMG_SIZE + TEST_IMG_TLV_SIZE];
+
+static void test_img_build(void)
+{
+	struct tc_sha256_state_struct sha;
+	u8_t *tlv = &test_img[TEST_IMG_HDR_SIZE + TEST_IMG_SIZE];
+	u32_t i;
+
+	memset(test_img, 0, sizeof(test_img));
+	sys_put_le32(0x96f3b83d, &test_img[0]);
+	sys_put_le16(TEST_IMG_HDR_SIZE, &test_img[8]);
+	sys_put_le32(TEST_IMG_SIZE, &test_img[12]);
+
+	for (i = 0U; i < TEST_IMG_SIZE; i++) {
+		test_img[TEST_IMG_HDR_SIZE + i] = i;
+	}
+
+	sys_put_le16(0x6907, &tlv[0]);
+	sys_put_le16(TEST_IMG_TLV_SIZE, &tlv[2]);
+	tlv[4] = 0x10;
+	sys_put_le16(TC_SHA256_DIGEST_SIZE, &tlv[6]);
+
+	zassert_equal(tc_sha256_init(&sha), TC_CRYPTO_SUCCESS, "sha init");
+	zassert_equal(tc_sha256_update(&sha, test_img,
+				       TEST_IMG_HDR_SIZE + TEST_IMG_SIZE),
+		      TC_CRYPTO_SUCCESS, "sha update");
+	zassert_equal(tc_sha256_final(&tlv[8], &sha), TC_CRYPTO_SUCCESS,
+		      "sha final");
+}
+
+static int test_img_write(void)
+{
+	struct flash_img_context ctx;
+	u32_t i;
+	int ret;
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase");
+
+	/* odd chunks, so the header and TLVs span several writes */
+	for (i = 0U; i < sizeof(test_img); i += 7) {
+		ret = flash_img_buffered_write(&ctx, &test_img[i],
+					       MIN(7, sizeof(test_img) - i),
+					       false);
+		zassert_true(ret == 0, "Flash img write");
+	}
+
+	ret = flash_img_buffered_write(&ctx, test_img, 0, true);
+	zassert_true(ret == 0, "Flash img flush");
+
+	return flash_img_check(&ctx);
+}
+
+void test_check(void)
+{
+	test_img_build();
+	zassert_equal(test_img_write(), 0, "Good image rejected");
+
+	test_img[TEST_IMG_HDR_SIZE + 10] ^= 0x01;
+	zassert_equal(test_img_write(), -EBADMSG, "Bad image accepted");
+}
+#else
+void test_check(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_IMG_ENABLE_HASH_CHECK */
+
+#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+#define TEST_RESUME_SIZE 10000
+#define TEST_RESUME_OFFSET 6000
+
+static void test_resume_write(struct flash_img_context *ctx, size_t off,
+			      size_t end)
+{
+	u8_t data[100];
+	size_t i, len;
+
+	for (; off < end; off += len) {
+		len = MIN(sizeof(data), end - off);
+		for (i = 0; i < len; i++) {
+			data[i] = (off + i) ^ ((off + i) >> 8);
+		}
+
+		zassert_true(flash_img_buffered_write(ctx, data, len,
+						      false) == 0,
+			     "Flash img write");
+	}
+}
+
+void test_resume(void)
+{
+	const struct flash_area *fa;
+	struct flash_img_context ctx;
+	size_t off;
+	u8_t temp;
+	int ret;
+
+	/* Interrupted writer, past the offset it reported */
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	test_resume_write(&ctx, 0, TEST_RESUME_OFFSET + 2000);
+
+	ret = flash_img_resume(&ctx, TEST_RESUME_OFFSET);
+	zassert_true(ret == 0, "Flash img resume");
+
+	off = flash_img_bytes_written(&ctx);
+	zassert_true(off <= TEST_RESUME_OFFSET, "Resumed past the offset");
+	zassert_true(off % CONFIG_IMG_BLOCK_BUF_SIZE == 0,
+		     "Resumed at an unaligned offset");
+
+	test_resume_write(&ctx, off, TEST_RESUME_SIZE);
+	ret = flash_img_buffered_write(&ctx, &temp, 0, true);
+	zassert_true(ret == 0, "Flash img flush");
+
+	ret = flash_area_open(DT_FLASH_AREA_IMAGE_1_ID, &fa);
+	zassert_true(ret == 0, "Flash area open");
+
+	for (off = 0; off < TEST_RESUME_SIZE; off++) {
+		zassert_true(flash_area_read(fa, off, &temp, 1) == 0,
+			     "Flash read");
+		zassert_equal(temp, (u8_t)(off ^ (off >> 8)),
+			      "Bad byte at %zu", off);
+	}
+}
+#else
+void test_resume(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_IMG_ERASE_PROGRESSIVELY */
+
 void test_main(void)
 {
 	ztest_test_suite(test_util,
-			ztest_unit_test(test_collecting));
+			ztest_unit_test(test_collecting),
+			ztest_unit_test(test_check),
+			ztest_unit_test(test_resume));
 	ztest_run_test_suite(test_util);
 }
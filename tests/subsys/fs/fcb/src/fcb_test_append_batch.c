@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+void fcb_test_append_batch(void)
+{
+	int rc;
+	struct fcb *fcb;
+	u8_t test_data[16][16];
+	const void *data[16];
+	u16_t len[16];
+	int i;
+	int j;
+	int var_cnt;
+
+	fcb = &test_fcb;
+
+	for (i = 0; i < ARRAY_SIZE(test_data); i++) {
+		for (j = 0; j < i; j++) {
+			test_data[i][j] = fcb_test_append_data(i, j);
+		}
+		data[i] = test_data[i];
+		len[i] = i;
+	}
+
+	rc = fcb_append_batch(fcb, data, len, ARRAY_SIZE(test_data));
+	zassert_true(rc == ARRAY_SIZE(test_data),
+		     "fcb_append_batch call failure");
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_true(var_cnt == ARRAY_SIZE(test_data),
+		     "fetched data size not match to wrote data size");
+}
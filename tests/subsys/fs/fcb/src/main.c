@@ -138,6 +138,7 @@ void fcb_test_empty_walk(void);
 void fcb_test_append(void);
 void fcb_test_append_too_big(void);
 void fcb_test_append_fill(void);
+void fcb_test_append_batch(void);
 void fcb_test_reset(void);
 void fcb_test_rotate(void);
 void fcb_test_multi_scratch(void);
@@ -156,6 +157,9 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(fcb_test_append,
 							fcb_pretest_2_sectors,
 							teardown_nothing),
+			 ztest_unit_test_setup_teardown(fcb_test_append_batch,
+							fcb_pretest_2_sectors,
+							teardown_nothing),
 			 ztest_unit_test_setup_teardown(fcb_test_append_too_big,
 							fcb_pretest_2_sectors,
 							teardown_nothing),
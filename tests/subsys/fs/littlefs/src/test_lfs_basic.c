@@ -26,6 +26,7 @@
 
 #define HELLO "hello"
 #define GOODBYE "goodbye"
+#define DEFERRED "deferred"
 
 static int mount(struct fs_mount_t *mp)
 {
@@ -409,6 +410,57 @@ static int verify_goodbye(const struct fs_mount_t *mp)
 	return TC_PASS;
 }
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+#define SYNC_DELAY_MS 100
+
+static int sync_deferred(const struct fs_mount_t *mp)
+{
+	struct fs_littlefs *fs = mp->fs_data;
+	struct testfs_path path;
+	struct fs_file_t file;
+	struct fs_dirent stat;
+
+	TC_PRINT("sync deferred\n");
+
+	fs->sync_delay = SYNC_DELAY_MS;
+
+	zassert_equal(fs_open(&file,
+			      testfs_path_init(&path, mp,
+					       DEFERRED,
+					       TESTFS_PATH_END)),
+		      0,
+		      "open deferred failed");
+
+	zassert_equal(testfs_write_incrementing(&file, 0, TESTFS_BUFFER_SIZE),
+		      TESTFS_BUFFER_SIZE,
+		      "write deferred failed");
+
+	zassert_equal(fs_sync(&file), 0,
+		      "sync deferred failed");
+
+	zassert_equal(fs_stat(path.path, &stat),
+		      0,
+		      "stat deferred failed");
+	zassert_equal(stat.size, 0,
+		      "deferred sync committed immediately");
+
+	k_sleep(K_MSEC(2 * SYNC_DELAY_MS));
+
+	zassert_equal(fs_stat(path.path, &stat),
+		      0,
+		      "stat deferred failed");
+	zassert_equal(stat.size, TESTFS_BUFFER_SIZE,
+		      "deferred sync not committed");
+
+	zassert_equal(fs_close(&file), 0,
+		      "close deferred failed");
+
+	fs->sync_delay = 0;
+
+	return TC_PASS;
+}
+#endif /* CONFIG_FS_LITTLEFS_DEFERRED_SYNC */
+
 static int check_medium(void)
 {
 	struct fs_mount_t *mp = &testfs_medium_mnt;
@@ -519,6 +571,11 @@ void test_lfs_basic(void)
 	zassert_equal(verify_goodbye(mp), TC_PASS,
 		      "verify goodbye failed");
 
+#if defined(CONFIG_FS_LITTLEFS_DEFERRED_SYNC)
+	zassert_equal(sync_deferred(mp), TC_PASS,
+		      "sync deferred failed");
+#endif
+
 	zassert_equal(fs_unmount(mp), 0,
 		      "unmount2 small failed");
 
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <drivers/ipm.h>
+#include <ipc/ipc_ring.h>
+
+/* Both sides of the ring are this core: messages sent come back */
+#define RING_SIZE (sizeof(struct ipc_ring_shm) + 64)
+
+static u32_t shm[RING_SIZE / sizeof(u32_t)];
+static struct ipc_ring ring;
+
+static ipm_callback_t loop_cb;
+static void *loop_context;
+static int notifications;
+
+static const void *rx_data[8];
+static size_t rx_len[8];
+static int rx_count;
+
+/* Loopback IPM device, counting the notifications sent */
+static int loop_send(struct device *dev, int wait, u32_t id,
+		     const void *data, int size)
+{
+	notifications++;
+	loop_cb(loop_context, id, NULL);
+
+	return 0;
+}
+
+static void loop_register_callback(struct device *dev, ipm_callback_t cb,
+				   void *context)
+{
+	loop_cb = cb;
+	loop_context = context;
+}
+
+static int loop_max_data_size_get(struct device *dev)
+{
+	return sizeof(u32_t);
+}
+
+static u32_t loop_max_id_val_get(struct device *dev)
+{
+	return 0;
+}
+
+static int loop_set_enabled(struct device *dev, int enable)
+{
+	return 0;
+}
+
+static const struct ipm_driver_api loop_api = {
+	.send = loop_send,
+	.register_callback = loop_register_callback,
+	.max_data_size_get = loop_max_data_size_get,
+	.max_id_val_get = loop_max_id_val_get,
+	.set_enabled = loop_set_enabled,
+};
+
+static int loop_init(struct device *dev)
+{
+	return 0;
+}
+
+DEVICE_AND_API_INIT(ipm_loop, "ipm_loop", loop_init, NULL, NULL,
+		    POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		    &loop_api);
+
+static void recv_cb(struct ipc_ring *ring, const void *data, size_t len,
+		    void *user_data)
+{
+	zassert_true(rx_count < ARRAY_SIZE(rx_data), "too many messages");
+
+	rx_data[rx_count] = data;
+	rx_len[rx_count] = len;
+	rx_count++;
+}
+
+static void ring_setup(void)
+{
+	zassert_equal(ipc_ring_init(&ring, device_get_binding("ipm_loop"),
+				    shm, sizeof(shm), shm, sizeof(shm),
+				    recv_cb, NULL), 0, NULL);
+	notifications = 0;
+	rx_count = 0;
+}
+
+/**
+ * @brief Test that messages are received where they were written
+ */
+void test_ipc_ring_zero_copy(void)
+{
+	u8_t *buf;
+
+	ring_setup();
+
+	buf = ipc_ring_alloc(&ring, 10);
+	zassert_not_null(buf, NULL);
+	zassert_true((buf >= (u8_t *)shm) &&
+		     (buf + 10 <= (u8_t *)shm + sizeof(shm)),
+		     "message not in shared memory");
+	(void)memset(buf, 0xa5, 10);
+
+	/**TESTPOINT: a message can be shorter than allocated */
+	zassert_equal(ipc_ring_commit(&ring, 7), 0, NULL);
+
+	zassert_equal(ipc_ring_process(&ring, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(rx_data[0], buf, "message was copied");
+	zassert_equal(rx_len[0], 7, NULL);
+
+	zassert_equal(ipc_ring_process(&ring, K_NO_WAIT), -EAGAIN, NULL);
+}
+
+/**
+ * @brief Test that the peer is only notified when its ring was empty
+ */
+void test_ipc_ring_coalesce(void)
+{
+	static const u32_t msg[3] = { 1, 2, 3 };
+	int i;
+
+	ring_setup();
+
+	for (i = 0; i < ARRAY_SIZE(msg); i++) {
+		zassert_equal(ipc_ring_send(&ring, &msg[i], sizeof(msg[i])),
+			      0, NULL);
+	}
+	zassert_equal(notifications, 1, "notified %d times", notifications);
+
+	zassert_equal(ipc_ring_process(&ring, K_NO_WAIT), ARRAY_SIZE(msg),
+		      NULL);
+	for (i = 0; i < ARRAY_SIZE(msg); i++) {
+		zassert_equal(*(const u32_t *)rx_data[i], msg[i], NULL);
+	}
+
+	zassert_equal(ipc_ring_send(&ring, &msg[0], sizeof(msg[0])), 0, NULL);
+	zassert_equal(notifications, 2, "drained ring not notified");
+}
+
+/**
+ * @brief Test a full ring and messages wrapping around its end
+ */
+void test_ipc_ring_wrap(void)
+{
+	static const u8_t msg[20] = { 1 };
+
+	ring_setup();
+
+	/* Each message takes 24 bytes of the 64 in the ring */
+	zassert_equal(ipc_ring_send(&ring, msg, sizeof(msg)), 0, NULL);
+	zassert_equal(ipc_ring_send(&ring, msg, sizeof(msg)), 0, NULL);
+	zassert_equal(ipc_ring_send(&ring, msg, sizeof(msg)), -ENOMEM,
+		      "ring overflowed");
+
+	zassert_equal(ipc_ring_process(&ring, K_NO_WAIT), 2, NULL);
+
+	/**TESTPOINT: a message not fitting before the end goes first */
+	rx_count = 0;
+	zassert_equal(ipc_ring_send(&ring, msg, sizeof(msg)), 0, NULL);
+	zassert_equal(ipc_ring_process(&ring, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(rx_data[0], (u8_t *)ring.tx->data +
+			  IPC_RING_MSG_HDR_SIZE, "message did not wrap");
+	zassert_equal(rx_len[0], sizeof(msg), NULL);
+	zassert_mem_equal(rx_data[0], msg, sizeof(msg), NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(ipc_ring,
+			 ztest_unit_test(test_ipc_ring_zero_copy),
+			 ztest_unit_test(test_ipc_ring_coalesce),
+			 ztest_unit_test(test_ipc_ring_wrap));
+	ztest_run_test_suite(ipc_ring);
+}